@@ -46,6 +46,31 @@ ArcDelayCalc::gateDelay(const TimingArc *arc,
   drvr_slew = dcalc_result.drvrSlew();
 }
 
+void
+ArcDelayCalc::findDelaysBegin()
+{
+}
+
+void
+ArcDelayCalc::findDelaysEnd()
+{
+}
+
+ArcDcalcResultSeq
+ArcDelayCalc::gateDelayBatch(const Pin *drvr_pin,
+                             const ArcDcalcBatchArgSeq &args,
+                             const LoadPinIndexMap &load_pin_index_map)
+{
+  ArcDcalcResultSeq dcalc_results;
+  dcalc_results.reserve(args.size());
+  for (const ArcDcalcBatchArg &arg : args)
+    dcalc_results.push_back(gateDelay(drvr_pin, arg.arc(), arg.inSlew(),
+                                      arg.loadCap(), arg.parasitic(),
+                                      load_pin_index_map,
+                                      arg.dcalcAnalysisPt()));
+  return dcalc_results;
+}
+
 ////////////////////////////////////////////////////////////////
 
 ArcDcalcArg::ArcDcalcArg() :
@@ -150,6 +175,21 @@ ArcDcalcArg::setParasitic(const Parasitic *parasitic)
 
 ////////////////////////////////////////////////////////////////
 
+ArcDcalcBatchArg::ArcDcalcBatchArg(const TimingArc *arc,
+                                   const Slew in_slew,
+                                   float load_cap,
+                                   const Parasitic *parasitic,
+                                   const DcalcAnalysisPt *dcalc_ap) :
+  arc_(arc),
+  in_slew_(in_slew),
+  load_cap_(load_cap),
+  parasitic_(parasitic),
+  dcalc_ap_(dcalc_ap)
+{
+}
+
+////////////////////////////////////////////////////////////////
+
 ArcDcalcResult::ArcDcalcResult() :
   gate_delay_(0.0),
   drvr_slew_(0.0)
@@ -66,6 +66,7 @@ public:
   virtual float capacitance() const;
   virtual PinSet unannotatedLoads(const Pin *drvr_pin,
                                   const Parasitics *parasitics) const;
+  virtual size_t memoryBytes() const;
 
   const Pin **pinV; // [n]
 };
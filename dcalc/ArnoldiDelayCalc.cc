@@ -22,6 +22,8 @@
 
 #include <cstdio>
 #include <cmath> // abs
+#include <algorithm>
+#include <memory>
 
 #include "Report.hh"
 #include "Debug.hh"
@@ -35,6 +37,7 @@
 #include "Graph.hh"
 #include "Parasitics.hh"
 #include "Sdc.hh"
+#include "Corner.hh"
 #include "DcalcAnalysisPt.hh"
 #include "DelayCalc.hh"
 #include "ArcDelayCalc.hh"
@@ -42,6 +45,8 @@
 #include "GraphDelayCalc.hh"
 #include "Arnoldi.hh"
 #include "ArnoldiReduce.hh"
+#include "DispatchQueue.hh"
+#include "UnorderedMap.hh"
 
 namespace sta {
 
@@ -109,10 +114,47 @@ struct delay_work
 
 ////////////////////////////////////////////////////////////////
 
+// Driver rcmodels indexed by dcalc ap index * RiseFall::index_count + rf index.
+typedef UnorderedMap<const Pin*, vector<rcmodel*>> ArnoldiDrvrModels;
+
+// Detailed parasitic networks reduced before a full delay calculation.
+// Shared by the thread copies of the delay calculator.
+class ArnoldiReductions
+{
+public:
+  ArnoldiReductions() {}
+  ~ArnoldiReductions();
+  void deleteModels();
+
+  ArnoldiDrvrModels drvr_models_;
+  // Reduce workspaces for each thread reused between delay calcs.
+  vector<ArnoldiReduce*> reduces_;
+};
+
+ArnoldiReductions::~ArnoldiReductions()
+{
+  deleteModels();
+  for (ArnoldiReduce *reduce : reduces_)
+    delete reduce;
+}
+
+void
+ArnoldiReductions::deleteModels()
+{
+  for (auto &drvr_models : drvr_models_) {
+    for (rcmodel *model : drvr_models.second)
+      delete model;
+  }
+  drvr_models_.clear();
+}
+
+////////////////////////////////////////////////////////////////
+
 class ArnoldiDelayCalc : public LumpedCapDelayCalc
 {
 public:
   ArnoldiDelayCalc(StaState *sta);
+  ArnoldiDelayCalc(ArnoldiDelayCalc *calc);
   virtual ~ArnoldiDelayCalc();
   ArcDelayCalc *copy() override;
   Parasitic *findParasitic(const Pin *drvr_pin,
@@ -145,6 +187,8 @@ public:
                          const DcalcAnalysisPt *dcalc_ap,
                          int digits) override;
   void finishDrvrPin() override;
+  void findDelaysBegin() override;
+  void findDelaysEnd() override;
   void delay_work_set_thresholds(delay_work *D,
 				 double lo,
 				 double hi,
@@ -152,6 +196,12 @@ public:
 				 double derate);
 
 private:
+  void reduceDrvr(const Pin *drvr_pin,
+                  ArnoldiReduce *reduce,
+                  vector<rcmodel*> &models);
+  rcmodel *takeReduction(const Pin *drvr_pin,
+                         const RiseFall *rf,
+                         const DcalcAnalysisPt *dcalc_ap);
   ArcDcalcResult gateDelaySlew(const LibertyCell *drvr_cell,
                                const TimingArc *arc,
                                const GateTableModel *table_model,
@@ -225,6 +275,7 @@ private:
   ArnoldiReduce *reduce_;
   delay_work *delay_work_;
   vector<rcmodel*> unsaved_parasitics_;
+  std::shared_ptr<ArnoldiReductions> reductions_;
 };
 
 ArcDelayCalc *
@@ -236,7 +287,20 @@ makeArnoldiDelayCalc(StaState *sta)
 ArnoldiDelayCalc::ArnoldiDelayCalc(StaState *sta) :
   LumpedCapDelayCalc(sta),
   reduce_(new ArnoldiReduce(sta)),
-  delay_work_(delay_work_create())
+  delay_work_(delay_work_create()),
+  reductions_(std::make_shared<ArnoldiReductions>())
+{
+  _pinNmax = 1024;
+  _delayV = (double*)malloc(_pinNmax * sizeof(double));
+  _slewV = (double*)malloc(_pinNmax * sizeof(double));
+}
+
+// Thread copies share the reductions of calc.
+ArnoldiDelayCalc::ArnoldiDelayCalc(ArnoldiDelayCalc *calc) :
+  LumpedCapDelayCalc(calc),
+  reduce_(new ArnoldiReduce(calc)),
+  delay_work_(delay_work_create()),
+  reductions_(calc->reductions_)
 {
   _pinNmax = 1024;
   _delayV = (double*)malloc(_pinNmax * sizeof(double));
@@ -286,9 +350,11 @@ ArnoldiDelayCalc::findParasitic(const Pin *drvr_pin,
   }
     
   if (parasitic_network) {
-    rcmodel *rcmodel = reduce_->reduceToArnoldi(parasitic_network, drvr_pin,
-                                                parasitic_ap->couplingCapFactor(),
-                                                drvr_rf, corner, min_max, parasitic_ap);
+    rcmodel *rcmodel = takeReduction(drvr_pin, drvr_rf, dcalc_ap);
+    if (rcmodel == nullptr)
+      rcmodel = reduce_->reduceToArnoldi(parasitic_network, drvr_pin,
+                                         parasitic_ap->couplingCapFactor(),
+                                         drvr_rf, corner, min_max, parasitic_ap);
     // Arnoldi parasitics are their own class that are not saved in the parasitic db.
     unsaved_parasitics_.push_back(rcmodel);
     parasitic = rcmodel;
@@ -314,6 +380,121 @@ ArnoldiDelayCalc::finishDrvrPin()
   unsaved_parasitics_.clear();
 }
 
+// Drivers reduced by a thread at a time.
+static const size_t arnoldi_reduce_chunk_size = 64;
+
+// Reduce the detailed parasitic networks of all drivers in parallel
+// so the delay calc search does not wait on reductions.
+void
+ArnoldiDelayCalc::findDelaysBegin()
+{
+  reductions_->deleteModels();
+  // Without threads the search reduces each driver when it is reached.
+  if (dispatch_queue_ == nullptr
+      || thread_count_ <= 1
+      || !parasitics_->haveParasitics())
+    return;
+  ArnoldiDrvrModels &drvr_models = reductions_->drvr_models_;
+  size_t model_count = corners_->dcalcAnalysisPtCount() * RiseFall::index_count;
+  // Make the map entries before reducing so the threads only write
+  // their own entries.
+  vector<const Pin*> drvrs;
+  vector<vector<rcmodel*>*> models;
+  VertexIterator vertex_iter(graph_);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    const Pin *pin = vertex->pin();
+    if (vertex->isDriver(network_)
+        && !network_->direction(pin)->isInternal()
+        && drvr_models.find(pin) == drvr_models.end()) {
+      for (const DcalcAnalysisPt *dcalc_ap : corners_->dcalcAnalysisPts()) {
+        if (parasitics_->findParasiticNetwork(pin,
+                                              dcalc_ap->parasiticAnalysisPt())) {
+          vector<rcmodel*> &pin_models = drvr_models[pin];
+          pin_models.resize(model_count, nullptr);
+          drvrs.push_back(pin);
+          break;
+        }
+      }
+    }
+  }
+  for (const Pin *drvr : drvrs)
+    models.push_back(&drvr_models[drvr]);
+
+  size_t drvr_count = drvrs.size();
+  if (drvr_count < arnoldi_reduce_chunk_size * 2) {
+    for (size_t i = 0; i < drvr_count; i++)
+      reduceDrvr(drvrs[i], reduce_, *models[i]);
+  }
+  else {
+    vector<ArnoldiReduce*> &reduces = reductions_->reduces_;
+    while (reduces.size() < static_cast<size_t>(thread_count_))
+      reduces.push_back(new ArnoldiReduce(this));
+    for (ArnoldiReduce *reduce : reduces)
+      reduce->copyState(this);
+    size_t chunk_size = std::max(arnoldi_reduce_chunk_size,
+                                 drvr_count / (thread_count_ * 4) + 1);
+    for (size_t from = 0; from < drvr_count; from += chunk_size) {
+      size_t to = std::min(from + chunk_size, drvr_count);
+      dispatch_queue_->dispatch([=, &drvrs, &models, &reduces] (int thread) {
+        for (size_t i = from; i < to; i++)
+          reduceDrvr(drvrs[i], reduces[thread], *models[i]);
+      });
+    }
+    dispatch_queue_->finishTasks();
+  }
+}
+
+void
+ArnoldiDelayCalc::findDelaysEnd()
+{
+  // Delete the reductions of drivers the search did not reach.
+  reductions_->deleteModels();
+}
+
+void
+ArnoldiDelayCalc::reduceDrvr(const Pin *drvr_pin,
+                             ArnoldiReduce *reduce,
+                             vector<rcmodel*> &models)
+{
+  for (const DcalcAnalysisPt *dcalc_ap : corners_->dcalcAnalysisPts()) {
+    const Corner *corner = dcalc_ap->corner();
+    // set_load net has precedence over parasitics.
+    if (!sdc_->drvrPinHasWireCap(drvr_pin, corner)) {
+      const ParasiticAnalysisPt *parasitic_ap = dcalc_ap->parasiticAnalysisPt();
+      Parasitic *parasitic_network =
+        parasitics_->findParasiticNetwork(drvr_pin, parasitic_ap);
+      if (parasitic_network) {
+        const MinMax *min_max = dcalc_ap->constraintMinMax();
+        for (const RiseFall *rf : RiseFall::range()) {
+          size_t index = dcalc_ap->index() * RiseFall::index_count + rf->index();
+          models[index] =
+            reduce->reduceToArnoldi(parasitic_network, drvr_pin,
+                                    parasitic_ap->couplingCapFactor(),
+                                    rf, corner, min_max, parasitic_ap);
+        }
+      }
+    }
+  }
+}
+
+// Return the reduction made by findDelaysBegin, which the caller owns.
+rcmodel *
+ArnoldiDelayCalc::takeReduction(const Pin *drvr_pin,
+                                const RiseFall *rf,
+                                const DcalcAnalysisPt *dcalc_ap)
+{
+  ArnoldiDrvrModels &drvr_models = reductions_->drvr_models_;
+  auto itr = drvr_models.find(drvr_pin);
+  if (itr != drvr_models.end()) {
+    size_t index = dcalc_ap->index() * RiseFall::index_count + rf->index();
+    rcmodel *model = itr->second[index];
+    itr->second[index] = nullptr;
+    return model;
+  }
+  return nullptr;
+}
+
 ArcDcalcResult
 ArnoldiDelayCalc::inputPortDelay(const Pin *,
                                  float in_slew,
@@ -54,6 +54,14 @@ rcmodel::unannotatedLoads(const Pin *,
   return PinSet();
 }
 
+size_t
+rcmodel::memoryBytes() const
+{
+  return sizeof(*this)
+    + order * (2 + n) * sizeof(double)
+    + n * sizeof(const Pin*);
+}
+
 struct ts_point
 {
   ParasiticNode *node_;
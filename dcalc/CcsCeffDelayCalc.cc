@@ -278,10 +278,10 @@ void
 CcsCeffDelayCalc::findCsmWaveform()
 {
   for (size_t i = 0; i < region_count_; i++) {
-    double t1 = output_waveforms_->voltageTime(in_slew_, region_ceff_[i],
-                                               region_volts_[i]);
-    double t2 = output_waveforms_->voltageTime(in_slew_, region_ceff_[i],
-                                               region_volts_[i + 1]);
+    double t1, t2;
+    output_waveforms_->voltageTimes(in_slew_, region_ceff_[i],
+                                    region_volts_[i], region_volts_[i + 1],
+                                    t1, t2);
     region_begin_times_[i] = t1;
     region_end_times_[i] = t2;
     double time_offset = (i == 0)
@@ -16,9 +16,11 @@
 
 #include "CcsSimDelayCalc.hh"
 
+#include <algorithm>
 #include <cmath> // abs
 
 #include "Debug.hh"
+#include "SearchStats.hh"
 #include "Units.hh"
 #include "TimingArc.hh"
 #include "Liberty.hh"
@@ -51,6 +53,8 @@ CcsSimDelayCalc::CcsSimDelayCalc(StaState *sta) :
   load_pin_index_map_(network_),
   dcalc_failed_(false),
   pin_node_map_(network_),
+  solver_(nullptr),
+  factored_time_step_(0.0),
   make_waveforms_(false),
   waveform_drvr_pin_(nullptr),
   waveform_load_pin_(nullptr),
@@ -278,15 +282,10 @@ CcsSimDelayCalc::simulate(ArcDcalcArgSeq &dcalc_args)
   drive_resistance_ = drvr_port->driveResistance(drvr_rf_, min_max);
 
   initSim();
-  stampConductances();
-
   // The conductance matrix does not change as long as the time step is constant.
   // Factor stamping and LU decomposition of the conductance matrix
   // outside of the simulation loop.
-  // Prevent copying of matrix.
-  conductances_.makeCompressed();
-  // LU factor conductances.
-  solver_.compute(conductances_);
+  factorConductances();
 
   for (size_t drvr_idx = 0; drvr_idx < dcalc_args.size(); drvr_idx++) {
     ArcDcalcArg &dcalc_arg = dcalc_args[drvr_idx];
@@ -300,7 +299,7 @@ CcsSimDelayCalc::simulate(ArcDcalcArgSeq &dcalc_args)
   // Initial time depends on ceff which impact delay, so use a sim step
   // to find an initial ceff.
   setCurrents();
-  voltages_ = solver_.solve(currents_);
+  voltages_ = solver_->solve(currents_);
   updateCeffIdrvr();
   initNodeVoltages();
 
@@ -314,11 +313,10 @@ CcsSimDelayCalc::simulate(ArcDcalcArgSeq &dcalc_args)
     recordWaveformStep(time_begin);
 
   for (double time = time_begin; time <= time_end; time += time_step_) {
-    stampConductances();
-    conductances_.makeCompressed();
-    solver_.compute(conductances_);
+    if (time_step_ != factored_time_step_)
+      factorConductances();
     setCurrents();
-    voltages_ = solver_.solve(currents_);
+    voltages_ = solver_->solve(currents_);
 
     debugPrint(debug_, "ccs_dcalc", 3, "%s ceff %s VDrvr %.4f Idrvr %s",
                delayAsString(time, this),
@@ -478,7 +476,23 @@ void
 CcsSimDelayCalc::simulateStep()
 {
   setCurrents();
-  voltages_ = solver_.solve(currents_);
+  voltages_ = solver_->solve(currents_);
+}
+
+void
+CcsSimDelayCalc::factorConductances()
+{
+  stampConductances();
+  // Prevent copying of matrix.
+  conductances_.makeCompressed();
+  // LU factor conductances.
+  size_t factor_count = factor_cache_.factorCount();
+  solver_ = factor_cache_.factor(conductances_);
+  SearchStats *stats = debug_->searchStats();
+  stats->incr(SearchStats::ccs_sim_factor_lookups);
+  if (factor_cache_.factorCount() == factor_count)
+    stats->incr(SearchStats::ccs_sim_factor_reuses);
+  factored_time_step_ = time_step_;
 }
 
 void
@@ -899,4 +913,70 @@ CcsSimDelayCalc::reportVector(vector<double> &matrix)
   report_->reportLineString(line);
 }
 
+////////////////////////////////////////////////////////////////
+
+CcsSimFactorCache::CcsSimFactorCache() :
+  next_entry_(0),
+  analyze_count_(0),
+  factor_count_(0)
+{
+}
+
+SparseLU<MatrixSd> *
+CcsSimFactorCache::factor(const MatrixSd &matrix)
+{
+  Entry *entry = findEntry(matrix);
+  if (entry == nullptr) {
+    // Replace entries round robin when the cache is full.
+    if (entries_.size() < entry_count_) {
+      entries_.emplace_back(new Entry);
+      entry = entries_.back().get();
+    }
+    else {
+      entry = entries_[next_entry_].get();
+      next_entry_ = (next_entry_ + 1) % entry_count_;
+    }
+    const MatrixSd::StorageIndex *outer = matrix.outerIndexPtr();
+    const MatrixSd::StorageIndex *inner = matrix.innerIndexPtr();
+    entry->outer_.assign(outer, outer + matrix.outerSize() + 1);
+    entry->inner_.assign(inner, inner + matrix.nonZeros());
+    entry->solver_.analyzePattern(matrix);
+    entry->factored_ = false;
+    analyze_count_++;
+  }
+  if (!(entry->factored_ && entry->sameValues(matrix))) {
+    const double *values = matrix.valuePtr();
+    entry->values_.assign(values, values + matrix.nonZeros());
+    entry->solver_.factorize(matrix);
+    entry->factored_ = true;
+    factor_count_++;
+  }
+  return &entry->solver_;
+}
+
+CcsSimFactorCache::Entry *
+CcsSimFactorCache::findEntry(const MatrixSd &matrix)
+{
+  for (std::unique_ptr<Entry> &entry : entries_) {
+    if (entry->samePattern(matrix))
+      return entry.get();
+  }
+  return nullptr;
+}
+
+bool
+CcsSimFactorCache::Entry::samePattern(const MatrixSd &matrix) const
+{
+  return outer_.size() == static_cast<size_t>(matrix.outerSize() + 1)
+    && inner_.size() == static_cast<size_t>(matrix.nonZeros())
+    && std::equal(outer_.begin(), outer_.end(), matrix.outerIndexPtr())
+    && std::equal(inner_.begin(), inner_.end(), matrix.innerIndexPtr());
+}
+
+bool
+CcsSimFactorCache::Entry::sameValues(const MatrixSd &matrix) const
+{
+  return std::equal(values_.begin(), values_.end(), matrix.valuePtr());
+}
+
 } // namespace
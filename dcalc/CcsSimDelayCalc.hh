@@ -17,6 +17,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include <Eigen/SparseCore>
 #include <Eigen/SparseLU>
 
@@ -46,6 +47,43 @@ typedef SparseMatrix<double> MatrixSd;
 ArcDelayCalc *
 makeCcsSimDelayCalc(StaState *sta);
 
+// LU factorizations of conductance matrices cached by sparsity pattern.
+// Nets with the same topology (node count and connections) share the
+// symbolic analysis and identical matrices share the numeric
+// factorization.
+class CcsSimFactorCache
+{
+public:
+  CcsSimFactorCache();
+  // Solver with the LU factorization of compressed matrix.
+  // The solver is valid until the next call.
+  SparseLU<MatrixSd> *factor(const MatrixSd &matrix);
+  size_t analyzeCount() const { return analyze_count_; }
+  size_t factorCount() const { return factor_count_; }
+
+protected:
+  class Entry
+  {
+  public:
+    bool samePattern(const MatrixSd &matrix) const;
+    bool sameValues(const MatrixSd &matrix) const;
+
+    vector<MatrixSd::StorageIndex> outer_;
+    vector<MatrixSd::StorageIndex> inner_;
+    vector<double> values_;
+    bool factored_;
+    SparseLU<MatrixSd> solver_;
+  };
+
+  Entry *findEntry(const MatrixSd &matrix);
+
+  vector<std::unique_ptr<Entry>> entries_;
+  size_t next_entry_;
+  size_t analyze_count_;
+  size_t factor_count_;
+  static constexpr size_t entry_count_ = 16;
+};
+
 class CcsSimDelayCalc : public DelayCalcBase, public ArcDcalcWaveforms
 {
 public:
@@ -114,6 +152,7 @@ protected:
   void setOrder();
   void initNodeVoltages();
   void simulateStep();
+  void factorConductances();
   virtual void stampConductances();
   void stampConductance(size_t n1,
                         double g);
@@ -202,7 +241,10 @@ protected:
   VectorXd voltages_;
   VectorXd voltages_prev1_;
   VectorXd voltages_prev2_;
-  SparseLU<MatrixSd> solver_;
+  CcsSimFactorCache factor_cache_;
+  SparseLU<MatrixSd> *solver_;
+  // Time step of the factored conductance matrix.
+  double factored_time_step_;
 
   // Waveform recording.
   bool make_waveforms_;
@@ -29,7 +29,8 @@ DcalcAnalysisPt::DcalcAnalysisPt(Corner *corner,
   index_(index),
   op_cond_(op_cond),
   min_max_(min_max),
-  check_clk_slew_min_max_(check_clk_slew_min_max)
+  check_clk_slew_min_max_(check_clk_slew_min_max),
+  liberty_index_(corner->libertyIndex(min_max))
 {
 }
 
@@ -51,10 +52,4 @@ DcalcAnalysisPt::setCheckClkSlewIndex(DcalcAPIndex index)
   check_clk_slew_index_ = index;
 }
 
-int 
-DcalcAnalysisPt::libertyIndex() const
-{
-  return corner_->libertyIndex(min_max_);
-}
-
 } // namespace
@@ -21,6 +21,7 @@
 #include "Sta.hh"
 #include "ArcDelayCalc.hh"
 #include "dcalc/ArcDcalcWaveforms.hh"
+#include "dcalc/DelayCalcBench.hh"
 
 %}
 
@@ -50,6 +51,22 @@ set_delay_calc_incremental_tolerance(float tol)
   sta::Sta::sta()->setIncrementalDelayTolerance(tol);
 }
 
+void
+bench_delay_calc_cmd(StringSeq *calc_names,
+                     const char *reference_name,
+                     int max_arcs,
+                     const Corner *corner,
+                     const MinMax *min_max)
+{
+  cmdLinkedNetwork();
+  Sta *sta = Sta::sta();
+  sta->findDelays();
+  DelayCalcBench bench(sta);
+  bench.record(corner, min_max, max_arcs);
+  bench.report(*calc_names, reference_name);
+  delete calc_names;
+}
+
 string
 report_delay_calc_cmd(Edge *edge,
 		      TimingArc *arc,
@@ -127,6 +127,39 @@ proc set_delay_calculator { alg } {
   }
 }
 
+define_hidden_cmd_args "bench_delay_calc" \
+  {[-calculators calcs] [-reference calc] [-max_arcs count]\
+     [-corner corner] [-min] [-max]}
+
+# Compare delay calculator throughput and delays/slews on the gate
+# arcs of the current design.
+proc_redirect bench_delay_calc {
+  parse_key_args "bench_delay_calc" args \
+    keys {-calculators -reference -max_arcs -corner} flags {-min -max}
+  check_argc_eq0 "bench_delay_calc" $args
+  set corner [parse_corner keys]
+  set min_max [parse_min_max_flags flags]
+  set calcs {dmp_ceff_elmore dmp_ceff_two_pole arnoldi ccs_ceff ccs_sim}
+  if { [info exists keys(-calculators)] } {
+    set calcs $keys(-calculators)
+  }
+  set reference "ccs_sim"
+  if { [info exists keys(-reference)] } {
+    set reference $keys(-reference)
+  }
+  foreach calc [concat $calcs $reference] {
+    if { ![is_delay_calc_name $calc] } {
+      sta_error 120 "delay calculator $calc not found."
+    }
+  }
+  set max_arcs 0
+  if { [info exists keys(-max_arcs)] } {
+    set max_arcs $keys(-max_arcs)
+    check_positive_integer "-max_arcs" $max_arcs
+  }
+  bench_delay_calc_cmd $calcs $reference $max_arcs $corner $min_max
+}
+
 define_cmd_args "set_pocv_sigma_factor" { factor }
 
 ################################################################
@@ -0,0 +1,198 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "DelayCalcBench.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Machine.hh"
+#include "Report.hh"
+#include "Units.hh"
+#include "TimingRole.hh"
+#include "Graph.hh"
+#include "Corner.hh"
+#include "DcalcAnalysisPt.hh"
+#include "GraphDelayCalc.hh"
+#include "DelayCalc.hh"
+#include "StringUtil.hh"
+
+namespace sta {
+
+DelayCalcBench::DelayCalcBench(StaState *sta) :
+  StaState(sta),
+  dcalc_ap_(nullptr),
+  arc_count_(0)
+{
+}
+
+void
+DelayCalcBench::record(const Corner *corner,
+                       const MinMax *min_max,
+                       size_t max_arcs)
+{
+  dcalc_ap_ = corner->findDcalcAnalysisPt(min_max);
+  drvrs_.clear();
+  arc_count_ = 0;
+  VertexIterator vertex_iter(graph_);
+  while (vertex_iter.hasNext()
+         && (max_arcs == 0 || arc_count_ < max_arcs)) {
+    Vertex *drvr_vertex = vertex_iter.next();
+    if (drvr_vertex->isDriver(network_)) {
+      BenchArcSeq arcs;
+      VertexInEdgeIterator edge_iter(drvr_vertex, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        const TimingRole *role = edge->role();
+        if (!role->isWire()
+            && !role->isTimingCheck()
+            && !role->isLatchDtoQ()) {
+          Vertex *from_vertex = edge->from(graph_);
+          for (const TimingArc *arc : edge->timingArcSet()->arcs()) {
+            const RiseFall *from_rf = arc->fromEdge()->asRiseFall();
+            const RiseFall *drvr_rf = arc->toEdge()->asRiseFall();
+            if (from_rf && drvr_rf) {
+              BenchArc bench_arc;
+              bench_arc.arc_ = arc;
+              bench_arc.in_slew_ = graph_delay_calc_->edgeFromSlew(from_vertex,
+                                                                   from_rf, edge,
+                                                                   dcalc_ap_);
+              arcs.push_back(bench_arc);
+              arc_count_++;
+            }
+          }
+        }
+      }
+      if (!arcs.empty())
+        drvrs_.emplace_back(drvr_vertex->pin(),
+                            graph_delay_calc_->makeLoadPinIndexMap(drvr_vertex),
+                            std::move(arcs));
+    }
+  }
+}
+
+DelayCalcBench::BenchDrvr::BenchDrvr(const Pin *drvr_pin,
+                                     LoadPinIndexMap &&load_pin_index_map,
+                                     BenchArcSeq &&arcs) :
+  drvr_pin_(drvr_pin),
+  load_pin_index_map_(std::move(load_pin_index_map)),
+  arcs_(std::move(arcs))
+{
+}
+
+// Parasitic reduction and gate delays are timed separately because
+// calculators reduce parasitic networks on demand.
+void
+DelayCalcBench::run(const char *calc_name,
+                    // Return value.
+                    BenchResult &result)
+{
+  ArcDelayCalc *arc_delay_calc = makeDelayCalc(calc_name, this);
+  result.reduce_time_ = 0.0;
+  result.delay_time_ = 0.0;
+  result.delays_.clear();
+  result.slews_.clear();
+  result.delays_.reserve(arc_count_);
+  result.slews_.reserve(arc_count_);
+  for (const BenchDrvr &drvr : drvrs_) {
+    const Pin *drvr_pin = drvr.drvr_pin_;
+    double start = elapsedRunTime();
+    float load_caps[RiseFall::index_count];
+    const Parasitic *parasitics[RiseFall::index_count];
+    for (const RiseFall *rf : RiseFall::range()) {
+      int rf_index = rf->index();
+      graph_delay_calc_->parasiticLoad(drvr_pin, rf, dcalc_ap_, nullptr,
+                                       arc_delay_calc, load_caps[rf_index],
+                                       parasitics[rf_index]);
+    }
+    double reduced = elapsedRunTime();
+    for (const BenchArc &bench_arc : drvr.arcs_) {
+      const TimingArc *arc = bench_arc.arc_;
+      int rf_index = arc->toEdge()->asRiseFall()->index();
+      ArcDcalcResult dcalc_result =
+        arc_delay_calc->gateDelay(drvr_pin, arc, bench_arc.in_slew_,
+                                  load_caps[rf_index], parasitics[rf_index],
+                                  drvr.load_pin_index_map_, dcalc_ap_);
+      result.delays_.push_back(delayAsFloat(dcalc_result.gateDelay()));
+      result.slews_.push_back(delayAsFloat(dcalc_result.drvrSlew()));
+    }
+    arc_delay_calc->finishDrvrPin();
+    double finished = elapsedRunTime();
+    result.reduce_time_ += reduced - start;
+    result.delay_time_ += finished - reduced;
+  }
+  delete arc_delay_calc;
+}
+
+static void
+deltas(const std::vector<float> &values,
+       const std::vector<float> &ref_values,
+       // Return values.
+       float &avg_delta,
+       float &max_delta)
+{
+  double sum = 0.0;
+  max_delta = 0.0;
+  for (size_t i = 0; i < values.size(); i++) {
+    float delta = std::abs(values[i] - ref_values[i]);
+    sum += delta;
+    max_delta = std::max(max_delta, delta);
+  }
+  avg_delta = values.empty() ? 0.0 : sum / values.size();
+}
+
+void
+DelayCalcBench::report(const StringSeq &calc_names,
+                       const char *reference_name)
+{
+  BenchResult ref_result;
+  run(reference_name, ref_result);
+  const Unit *time_unit = units_->timeUnit();
+  report_->reportLine("Delay calculators %zu arcs %zu drivers reference %s",
+                      arc_count_, drvrs_.size(), reference_name);
+  report_->reportLine("%-18s %12s %10s %10s %10s %10s %10s %10s",
+                      "Calculator",
+                      "arcs/s",
+                      "reduce(s)",
+                      "delay(s)",
+                      "delay avg",
+                      "delay max",
+                      "slew avg",
+                      "slew max");
+  for (const char *calc_name : calc_names) {
+    BenchResult result;
+    if (stringEq(calc_name, reference_name))
+      result = ref_result;
+    else
+      run(calc_name, result);
+    double time = result.reduce_time_ + result.delay_time_;
+    double arcs_per_sec = (time > 0.0) ? arc_count_ / time : 0.0;
+    float delay_avg, delay_max, slew_avg, slew_max;
+    deltas(result.delays_, ref_result.delays_, delay_avg, delay_max);
+    deltas(result.slews_, ref_result.slews_, slew_avg, slew_max);
+    report_->reportLine("%-18s %12.0f %10.3f %10.3f %10s %10s %10s %10s",
+                        calc_name,
+                        arcs_per_sec,
+                        result.reduce_time_,
+                        result.delay_time_,
+                        time_unit->asString(delay_avg, 3),
+                        time_unit->asString(delay_max, 3),
+                        time_unit->asString(slew_avg, 3),
+                        time_unit->asString(slew_max, 3));
+  }
+}
+
+} // namespace
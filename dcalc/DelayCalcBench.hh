@@ -0,0 +1,87 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <vector>
+
+#include "StringSeq.hh"
+#include "ArcDelayCalc.hh"
+
+namespace sta {
+
+class Corner;
+
+// Replay the gate delay calculations of the current design through
+// several delay calculators to compare their throughput and their
+// delays and slews against a reference calculator.
+// The driver arcs and input slews are recorded once so every
+// calculator sees the same inputs.
+class DelayCalcBench : public StaState
+{
+public:
+  explicit DelayCalcBench(StaState *sta);
+  // Record up to max_arcs driver arcs (0 for all).
+  void record(const Corner *corner,
+              const MinMax *min_max,
+              size_t max_arcs);
+  size_t arcCount() const { return arc_count_; }
+  // Report throughput and deltas for each calculator.
+  void report(const StringSeq &calc_names,
+              const char *reference_name);
+
+protected:
+  class BenchArc
+  {
+  public:
+    const TimingArc *arc_;
+    Slew in_slew_;
+  };
+
+  typedef std::vector<BenchArc> BenchArcSeq;
+
+  class BenchDrvr
+  {
+  public:
+    BenchDrvr(const Pin *drvr_pin,
+              LoadPinIndexMap &&load_pin_index_map,
+              BenchArcSeq &&arcs);
+
+    const Pin *drvr_pin_;
+    LoadPinIndexMap load_pin_index_map_;
+    BenchArcSeq arcs_;
+  };
+
+  class BenchResult
+  {
+  public:
+    double reduce_time_;
+    double delay_time_;
+    // Gate delay and driver slew per recorded arc.
+    std::vector<float> delays_;
+    std::vector<float> slews_;
+  };
+
+  void run(const char *calc_name,
+           // Return value.
+           BenchResult &result);
+
+  const DcalcAnalysisPt *dcalc_ap_;
+  std::vector<BenchDrvr> drvrs_;
+  size_t arc_count_;
+};
+
+} // namespace
@@ -26,9 +26,11 @@
 
 #include <algorithm> // abs, min
 #include <cmath>    // sqrt, log
+#include <unordered_map>
 
 #include "Report.hh"
 #include "Debug.hh"
+#include "SearchStats.hh"
 #include "Units.hh"
 #include "TimingArc.hh"
 #include "TableModel.hh"
@@ -39,6 +41,8 @@
 #include "DcalcAnalysisPt.hh"
 #include "ArcDelayCalc.hh"
 #include "FindRoot.hh"
+#include "Hash.hh"
+#include "GraphDelayCalc.hh"
 
 namespace sta {
 
@@ -146,6 +150,27 @@ public:
 			     ArcDelay &delay,
 			     Slew &slew);
   double ceff() { return ceff_; }
+  double t0() const { return t0_; }
+  double dt() const { return dt_; }
+  // Ceff found by the Newton-Raphson iteration.
+  double paramCeff() const;
+  // True if the last gateDelaySlew found the driver parameters.
+  bool driverParamsFound() const { return driver_params_found_; }
+  // True if the driver parameters were reused from the warm start.
+  bool driverParamsReused() const { return driver_params_reused_; }
+  const GateTableModel *gateModel() const { return gate_model_; }
+  const Pvt *pvt() const { return pvt_; }
+  void inputs(// Return values.
+              double &in_slew,
+              double &c2,
+              double &rpi,
+              double &c1) const;
+  // Start the next driver parameter solve from t0/dt/ceff.
+  // If reuse is true skip the solve and use them as the solution.
+  void setWarmStart(double t0,
+                    double dt,
+                    double ceff,
+                    bool reuse);
 
   // Given x_ as a vector of input parameters, fill fvec_ with the
   // equations evaluated at x_ and fjac_ with the jabobian evaluated at x_.
@@ -250,6 +275,15 @@ protected:
   double t0_;
   double dt_;
   double ceff_;
+  bool driver_params_found_;
+  bool driver_params_reused_;
+
+  // Warm start driver parameters.
+  bool warm_start_;
+  bool warm_start_reuse_;
+  double warm_start_t0_;
+  double warm_start_dt_;
+  double warm_start_ceff_;
 
   // Driver parameter Newton-Raphson state.
   int nr_order_;
@@ -276,6 +310,10 @@ DmpAlg::DmpAlg(int nr_order,
   c2_(0.0),
   rpi_(0.0),
   c1_(0.0),
+  driver_params_found_(false),
+  driver_params_reused_(false),
+  warm_start_(false),
+  warm_start_reuse_(false),
   nr_order_(nr_order)
 {
   x_ = new double[nr_order_];
@@ -323,16 +361,77 @@ DmpAlg::init(const LibertyLibrary *drvr_library,
   rpi_ = rpi;
   c1_ = c1;
   driver_valid_ = false;
+  driver_params_found_ = false;
+  driver_params_reused_ = false;
+  warm_start_ = false;
   vth_ = drvr_library->outputThreshold(rf);
   vl_ = drvr_library->slewLowerThreshold(rf);
   vh_ = drvr_library->slewUpperThreshold(rf);
   slew_derate_ = drvr_library->slewDerateFromLibrary();
 }
 
+void
+DmpAlg::setWarmStart(double t0,
+                     double dt,
+                     double ceff,
+                     bool reuse)
+{
+  warm_start_ = true;
+  warm_start_reuse_ = reuse;
+  warm_start_t0_ = t0;
+  warm_start_dt_ = dt;
+  warm_start_ceff_ = ceff;
+}
+
+void
+DmpAlg::inputs(// Return values.
+               double &in_slew,
+               double &c2,
+               double &rpi,
+               double &c1) const
+{
+  in_slew = in_slew_;
+  c2 = c2_;
+  rpi = rpi_;
+  c1 = c1_;
+}
+
+double
+DmpAlg::paramCeff() const
+{
+  return (nr_order_ == 3) ? x_[DmpParam::ceff] : ceff_;
+}
+
 // Find Ceff, delta_t and t0 for the driver.
 void
 DmpAlg::findDriverParams(double ceff)
 {
+  if (warm_start_) {
+    // Only the first solve for these inputs is warm started.
+    warm_start_ = false;
+    x_[DmpParam::t0] = warm_start_t0_;
+    x_[DmpParam::dt] = warm_start_dt_;
+    if (nr_order_ == 3)
+      x_[DmpParam::ceff] = warm_start_ceff_;
+    try {
+      if (!warm_start_reuse_)
+        newtonRaphson(100, x_, nr_order_, driver_param_tol,
+                      [=] () { evalDmpEqns(); },
+                      fvec_, fjac_, index_, p_, scale_);
+      t0_ = x_[DmpParam::t0];
+      dt_ = x_[DmpParam::dt];
+      driver_params_found_ = true;
+      driver_params_reused_ = warm_start_reuse_;
+      debugPrintHot(debug_, "dmp_ceff", 3, "    warm %s t0 = %s dt = %s",
+                    warm_start_reuse_ ? "reuse" : "start",
+                    units_->timeUnit()->asString(t0_),
+                    units_->timeUnit()->asString(dt_));
+      return;
+    }
+    catch (DmpError &) {
+      // Fall back to a cold start.
+    }
+  }
   if (nr_order_ == 3)
     x_[DmpParam::ceff] = ceff;
   double t_vth, t_vl, slew;
@@ -347,10 +446,11 @@ DmpAlg::findDriverParams(double ceff)
 		fvec_, fjac_, index_, p_, scale_);
   t0_ = x_[DmpParam::t0];
   dt_ = x_[DmpParam::dt];
-  debugPrint(debug_, "dmp_ceff", 3, "    t0 = %s dt = %s ceff = %s",
-             units_->timeUnit()->asString(t0_),
-             units_->timeUnit()->asString(dt_),
-             units_->capacitanceUnit()->asString(x_[DmpParam::ceff]));
+  driver_params_found_ = true;
+  debugPrintHot(debug_, "dmp_ceff", 3, "    t0 = %s dt = %s ceff = %s",
+                units_->timeUnit()->asString(t0_),
+                units_->timeUnit()->asString(dt_),
+                units_->capacitanceUnit()->asString(x_[DmpParam::ceff]));
   if (debug_->check("dmp_ceff", 4))
     showVo();
 }
@@ -756,8 +856,8 @@ DmpCap::gateDelaySlew(// Return values.
                       double &delay,
 		      double &slew)
 {
-  debugPrint(debug_, "dmp_ceff", 3, "    ceff = %s",
-             units_->capacitanceUnit()->asString(ceff_));
+  debugPrintHot(debug_, "dmp_ceff", 3, "    ceff = %s",
+                units_->capacitanceUnit()->asString(ceff_));
   gateCapDelaySlew(ceff_, delay, slew);
   drvr_slew_ = slew;
 }
@@ -1470,6 +1570,67 @@ testLuDecomp2()
 
 ////////////////////////////////////////////////////////////////
 
+// Driver parameters of a converged solve and the inputs they were
+// found for.
+class DmpCeffSolution
+{
+public:
+  const DmpAlg *alg;
+  const GateTableModel *gate_model;
+  const Pvt *pvt;
+  double in_slew;
+  double c2;
+  double rpi;
+  double c1;
+  double t0;
+  double dt;
+  double ceff;
+};
+
+class DmpCeffKey
+{
+public:
+  bool operator==(const DmpCeffKey &key) const
+  {
+    return pin_id == key.pin_id
+      && arc == key.arc
+      && ap_index == key.ap_index;
+  }
+
+  ObjectId pin_id;
+  const TimingArc *arc;
+  DcalcAPIndex ap_index;
+};
+
+class DmpCeffKeyHash
+{
+public:
+  size_t operator()(const DmpCeffKey &key) const
+  {
+    size_t hash = hash_init_value;
+    hashIncr(hash, key.pin_id);
+    hashIncr(hash, key.arc->index());
+    hashIncr(hash, key.ap_index);
+    return hash;
+  }
+};
+
+class DmpCeffCache : public std::unordered_map<DmpCeffKey, DmpCeffSolution,
+                                               DmpCeffKeyHash>
+{
+};
+
+// Relative difference of x1 and x2 within tol.
+static bool
+withinTolerance(double x1,
+                double x2,
+                double tol)
+{
+  return abs(x1 - x2) <= tol * max(abs(x1), abs(x2));
+}
+
+////////////////////////////////////////////////////////////////
+
 bool DmpCeffDelayCalc::unsuppored_model_warned_ = false;
 
 DmpCeffDelayCalc::DmpCeffDelayCalc(StaState *sta) :
@@ -1477,7 +1638,8 @@ DmpCeffDelayCalc::DmpCeffDelayCalc(StaState *sta) :
   dmp_cap_(new DmpCap(sta)),
   dmp_pi_(new DmpPi(sta)),
   dmp_zero_c2_(new DmpZeroC2(sta)),
-  dmp_alg_(nullptr)
+  dmp_alg_(nullptr),
+  ceff_cache_(new DmpCeffCache)
 {
 }
 
@@ -1486,6 +1648,7 @@ DmpCeffDelayCalc::~DmpCeffDelayCalc()
   delete dmp_cap_;
   delete dmp_pi_;
   delete dmp_zero_c2_;
+  delete ceff_cache_;
 }
 
 ArcDcalcResult
@@ -1510,8 +1673,10 @@ DmpCeffDelayCalc::gateDelay(const Pin *drvr_pin,
       report_->error(1040, "parasitic Pi model has NaNs.");
     setCeffAlgorithm(drvr_library, drvr_cell, pinPvt(drvr_pin, dcalc_ap),
                      table_model, rf, in_slew1, c2, rpi, c1);
+    warmStartDriverParams(drvr_pin, arc, dcalc_ap);
     double gate_delay, drvr_slew;
     gateDelaySlew(gate_delay, drvr_slew);
+    saveDriverParams(drvr_pin, arc, dcalc_ap);
     ArcDcalcResult dcalc_result(load_pin_index_map.size());
     dcalc_result.setGateDelay(gate_delay);
     dcalc_result.setDrvrSlew(drvr_slew);
@@ -1584,6 +1749,66 @@ DmpCeffDelayCalc::setCeffAlgorithm(const LibertyLibrary *drvr_library,
              dmp_alg_->name());
 }
 
+// Incremental delay calc with a non-zero tolerance accepts delay
+// changes within the tolerance, so the driver parameters of a previous
+// solve are reused if the inputs are within the tolerance and used to
+// seed the solve otherwise.
+void
+DmpCeffDelayCalc::warmStartDriverParams(const Pin *drvr_pin,
+                                        const TimingArc *arc,
+                                        const DcalcAnalysisPt *dcalc_ap)
+{
+  float tol = graph_delay_calc_->incrementalDelayTolerance();
+  if (tol > 0.0
+      && dmp_alg_ != dmp_cap_) {
+    SearchStats *stats = debug_->searchStats();
+    stats->incr(SearchStats::dmp_ceff_cache_lookups);
+    DmpCeffKey key = {network_->id(drvr_pin), arc, dcalc_ap->index()};
+    auto itr = ceff_cache_->find(key);
+    if (itr != ceff_cache_->end()) {
+      const DmpCeffSolution &solution = itr->second;
+      double in_slew, c2, rpi, c1;
+      dmp_alg_->inputs(in_slew, c2, rpi, c1);
+      if (solution.alg == dmp_alg_
+          && solution.gate_model == dmp_alg_->gateModel()
+          && solution.pvt == dmp_alg_->pvt()) {
+        bool reuse = withinTolerance(in_slew, solution.in_slew, tol)
+          && withinTolerance(c2, solution.c2, tol)
+          && withinTolerance(rpi, solution.rpi, tol)
+          && withinTolerance(c1, solution.c1, tol);
+        if (reuse)
+          stats->incr(SearchStats::dmp_ceff_cache_reuses);
+        dmp_alg_->setWarmStart(solution.t0, solution.dt, solution.ceff, reuse);
+      }
+    }
+  }
+}
+
+// Save the inputs and driver parameters of a solve. Reused solutions
+// are not saved so the cached inputs do not drift from the inputs
+// the parameters were found for.
+void
+DmpCeffDelayCalc::saveDriverParams(const Pin *drvr_pin,
+                                   const TimingArc *arc,
+                                   const DcalcAnalysisPt *dcalc_ap)
+{
+  float tol = graph_delay_calc_->incrementalDelayTolerance();
+  if (tol > 0.0
+      && dmp_alg_ != dmp_cap_
+      && dmp_alg_->driverParamsFound()
+      && !dmp_alg_->driverParamsReused()) {
+    DmpCeffKey key = {network_->id(drvr_pin), arc, dcalc_ap->index()};
+    DmpCeffSolution &solution = (*ceff_cache_)[key];
+    solution.alg = dmp_alg_;
+    solution.gate_model = dmp_alg_->gateModel();
+    solution.pvt = dmp_alg_->pvt();
+    dmp_alg_->inputs(solution.in_slew, solution.c2, solution.rpi, solution.c1);
+    solution.t0 = dmp_alg_->t0();
+    solution.dt = dmp_alg_->dt();
+    solution.ceff = dmp_alg_->paramCeff();
+  }
+}
+
 string
 DmpCeffDelayCalc::reportGateDelay(const Pin *drvr_pin,
                                   const TimingArc *arc,
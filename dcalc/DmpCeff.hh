@@ -25,6 +25,7 @@ class DmpAlg;
 class DmpCap;
 class DmpPi;
 class DmpZeroC2;
+class DmpCeffCache;
 class GateTableModel;
 
 // Delay calculator using Dartu/Menezes/Pileggi effective capacitance
@@ -78,6 +79,15 @@ protected:
 			double rpi,
 			double c1);
 
+  // Seed or reuse the driver parameters of a previous solve with
+  // close inputs.
+  void warmStartDriverParams(const Pin *drvr_pin,
+                             const TimingArc *arc,
+                             const DcalcAnalysisPt *dcalc_ap);
+  void saveDriverParams(const Pin *drvr_pin,
+                        const TimingArc *arc,
+                        const DcalcAnalysisPt *dcalc_ap);
+
   static bool unsuppored_model_warned_;
 
 private:
@@ -87,6 +97,8 @@ private:
   DmpPi *dmp_pi_;
   DmpZeroC2 *dmp_zero_c2_;
   DmpAlg *dmp_alg_;
+  // Converged driver parameters by driver pin/arc/analysis point.
+  DmpCeffCache *ceff_cache_;
 };
 
 } // namespace
@@ -232,6 +232,9 @@ DmpCeffTwoPoleDelayCalc::findParasitic(const Pin *drvr_pin,
       return parasitic;
   }
   const MinMax *cnst_min_max = dcalc_ap->constraintMinMax();
+  parasitic = parasitics_->estimatePiElmore(drvr_pin, rf, corner, cnst_min_max);
+  if (parasitic)
+    return parasitic;
   Wireload *wireload = sdc_->wireload(cnst_min_max);
   if (wireload) {
     float pin_cap, wire_cap, fanout;
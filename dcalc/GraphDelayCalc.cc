@@ -32,11 +32,13 @@
 #include "search/Levelize.hh"
 #include "Corner.hh"
 #include "SearchPred.hh"
+#include "SearchStats.hh"
 #include "Bfs.hh"
 #include "ArcDelayCalc.hh"
 #include "DcalcAnalysisPt.hh"
 #include "NetCaps.hh"
 #include "ClkNetwork.hh"
+#include "ConcurrentIdSet.hh"
 
 namespace sta {
 
@@ -55,11 +57,14 @@ GraphDelayCalc::GraphDelayCalc(StaState *sta) :
   incremental_(false),
   delays_exist_(false),
   invalid_delays_(new VertexSet(graph_)),
+  seeded_delays_(new ConcurrentIdSet),
+  unchanged_load_slews_(new ConcurrentIdSet),
   search_pred_(new SearchPred1(sta)),
   search_non_latch_pred_(new SearchPredNonLatch2(sta)),
   clk_pred_(new ClkTreeSearchPred(sta)),
   iter_(new BfsFwdIterator(BfsIndex::dcalc, search_non_latch_pred_, sta)),
-  incremental_delay_tolerance_(0.0)
+  incremental_delay_tolerance_(0.0),
+  invalid_count_(0)
 {
 }
 
@@ -67,6 +72,8 @@ GraphDelayCalc::~GraphDelayCalc()
 {
   delete search_pred_;
   delete invalid_delays_;
+  delete seeded_delays_;
+  delete unchanged_load_slews_;
   delete search_non_latch_pred_;
   delete clk_pred_;
   delete iter_;
@@ -102,6 +109,7 @@ GraphDelayCalc::clear()
 {
   delaysInvalid();
   deleteMultiDrvrNets();
+  drive_cell_from_ports_.clear();
 }
 
 float
@@ -127,19 +135,37 @@ void
 GraphDelayCalc::delaysInvalid()
 {
   debugPrint(debug_, "delay_calc", 1, "delays invalid");
+  invalid_count_++;
   delays_exist_ = false;
   delays_seeded_ = false;
   incremental_ = false;
   iter_->clear();
+  // Library, operating condition and delay calculator changes all
+  // invalidate every delay.
+  input_intrinsic_delays_.clear();
   // No need to keep track of incremental updates any more.
   invalid_delays_->clear();
   invalid_check_edges_.clear();
   invalid_latch_edges_.clear();
 }
 
+void
+GraphDelayCalc::delaysRestored()
+{
+  debugPrint(debug_, "delay_calc", 1, "delays restored");
+  iter_->clear();
+  invalid_delays_->clear();
+  invalid_check_edges_.clear();
+  invalid_latch_edges_.clear();
+  delays_seeded_ = true;
+  delays_exist_ = true;
+  incremental_ = true;
+}
+
 void
 GraphDelayCalc::delayInvalid(const Pin *pin)
 {
+  invalid_count_++;
   if (graph_ && incremental_) {
     if (network_->isHierarchical(pin)) {
       EdgesThruHierPinIterator edge_iter(pin, network_, graph_);
@@ -164,6 +190,7 @@ GraphDelayCalc::delayInvalid(Vertex *vertex)
 {
   debugPrint(debug_, "delay_calc", 2, "delay invalid %s",
              vertex->name(sdc_network_));
+  invalid_count_++;
   if (graph_ && incremental_) {
     invalid_delays_->insert(vertex);
     // Invalidate driver that triggers dcalc for multi-driver nets.
@@ -246,11 +273,20 @@ GraphDelayCalc::findDelays(Level level)
     }
     else
       iter_->ensureSize();
-    if (incremental_)
+    bool incremental = incremental_;
+    seeded_delays_->clear();
+    unchanged_load_slews_->clear();
+    if (incremental)
       seedInvalidDelays();
+    else {
+      makeMultiDrvrNets();
+      arc_delay_calc_->findDelaysBegin();
+    }
 
     FindVertexDelays visitor(this);
     dcalc_count += iter_->visitParallel(level, &visitor);
+    if (!incremental)
+      arc_delay_calc_->findDelaysEnd();
 
     // Timing checks require slews at both ends of the arc,
     // so find their delays after all slews are known.
@@ -276,8 +312,18 @@ GraphDelayCalc::seedInvalidDelays()
     if (vertex->isRoot())
       seedRootSlew(vertex, arc_delay_calc_);
     else {
-      if (search_non_latch_pred_->searchFrom(vertex))
+      if (search_non_latch_pred_->searchFrom(vertex)) {
 	iter_->enqueue(vertex);
+	seeded_delays_->insert(graph_->id(vertex));
+      }
+      // Drivers connected since the last delay calculation may have
+      // made a multiple driver net.
+      MultiDrvrNet *multi_drvr = ensureMultiDrvrNet(vertex);
+      if (multi_drvr) {
+        Vertex *dcalc_drvr = multi_drvr->dcalcDrvr();
+        if (search_non_latch_pred_->searchFrom(dcalc_drvr))
+          iter_->enqueue(dcalc_drvr);
+      }
     }
   }
   invalid_delays_->clear();
@@ -450,6 +496,13 @@ LibertyPort *
 GraphDelayCalc::driveCellDefaultFromPort(const LibertyCell *cell,
                                          const LibertyPort *to_port)
 {
+  std::pair<const LibertyCell*, const LibertyPort*> key(cell, to_port);
+  {
+    std::lock_guard<std::mutex> lock(input_drive_lock_);
+    auto itr = drive_cell_from_ports_.find(key);
+    if (itr != drive_cell_from_ports_.end())
+      return itr->second;
+  }
   LibertyPort *from_port = 0;
   int from_port_index = 0;
   for (TimingArcSet *arc_set : cell->timingArcSets(nullptr, to_port)) {
@@ -461,6 +514,8 @@ GraphDelayCalc::driveCellDefaultFromPort(const LibertyCell *cell,
       from_port_index = set_from_port_index;
     }
   }
+  std::lock_guard<std::mutex> lock(input_drive_lock_);
+  drive_cell_from_ports_[key] = from_port;
   return from_port;
 }
 
@@ -530,10 +585,9 @@ GraphDelayCalc::findInputArcDelay(const Pin *drvr_pin,
                   load_cap, parasitic);
 
     LoadPinIndexMap load_pin_index_map = makeLoadPinIndexMap(drvr_vertex);
-    ArcDcalcResult intrinsic_result =
-      arc_delay_calc_->gateDelay(drvr_pin, arc, Slew(from_slew), 0.0, nullptr,
-                                 load_pin_index_map, dcalc_ap);
-    ArcDelay intrinsic_delay = intrinsic_result.gateDelay();
+    ArcDelay intrinsic_delay = inputIntrinsicDelay(drvr_pin, arc, from_slew,
+                                                   load_pin_index_map,
+                                                   dcalc_ap);
 
     ArcDcalcResult gate_result = arc_delay_calc_->gateDelay(drvr_pin, arc,
                                                             Slew(from_slew), load_cap,
@@ -556,9 +610,47 @@ GraphDelayCalc::findInputArcDelay(const Pin *drvr_pin,
   }
 }
 
+// The unloaded driving cell delay only depends on the arc and input
+// slew, so ports with the same driving cell share it.
+ArcDelay
+GraphDelayCalc::inputIntrinsicDelay(const Pin *drvr_pin,
+                                    const TimingArc *arc,
+                                    float from_slew,
+                                    const LoadPinIndexMap &load_pin_index_map,
+                                    const DcalcAnalysisPt *dcalc_ap)
+{
+  InputIntrinsicKey key{arc, from_slew, dcalc_ap->index()};
+  {
+    std::lock_guard<std::mutex> lock(input_drive_lock_);
+    auto itr = input_intrinsic_delays_.find(key);
+    if (itr != input_intrinsic_delays_.end())
+      return itr->second;
+  }
+  ArcDcalcResult intrinsic_result =
+    arc_delay_calc_->gateDelay(drvr_pin, arc, Slew(from_slew), 0.0, nullptr,
+                               load_pin_index_map, dcalc_ap);
+  ArcDelay intrinsic_delay = intrinsic_result.gateDelay();
+  std::lock_guard<std::mutex> lock(input_drive_lock_);
+  input_intrinsic_delays_[key] = intrinsic_delay;
+  return intrinsic_delay;
+}
+
+bool
+InputIntrinsicKey::operator<(const InputIntrinsicKey &key) const
+{
+  if (arc_ != key.arc_)
+    return arc_ < key.arc_;
+  if (from_slew_ != key.from_slew_)
+    return from_slew_ < key.from_slew_;
+  return ap_index_ < key.ap_index_;
+}
+
+////////////////////////////////////////////////////////////////
+
 void
 GraphDelayCalc::findDelays(Vertex *drvr_vertex)
 {
+  ensureMultiDrvrNet(drvr_vertex);
   findVertexDelay(drvr_vertex, arc_delay_calc_, true);
 }
 
@@ -568,13 +660,15 @@ GraphDelayCalc::findVertexDelay(Vertex *vertex,
                                 bool propagate)
 {
   const Pin *pin = vertex->pin();
-  debugPrint(debug_, "delay_calc", 2, "find delays %s (%s)",
-             vertex->name(sdc_network_),
-             network_->cellName(network_->instance(pin)));
+  // Bind the iter_ predicate calls for the enqueue edge loops.
+  BoundSearchPred<SearchPredNonLatch2> adj_pred(search_non_latch_pred_);
+  debugPrintHot(debug_, "delay_calc", 2, "find delays %s (%s)",
+                vertex->name(sdc_network_),
+                network_->cellName(network_->instance(pin)));
   if (vertex->isRoot()) {
     seedRootSlew(vertex, arc_delay_calc);
     if (propagate)
-      iter_->enqueueAdjacentVertices(vertex);
+      iter_->enqueueAdjacentVertices(vertex, adj_pred);
   }
   else {
     if (network_->isLeaf(pin)) {
@@ -586,15 +680,19 @@ GraphDelayCalc::findVertexDelay(Vertex *vertex,
 	  // Enqueue adjacent vertices even if the delays did not
 	  // change when non-incremental to stride past annotations.
 	  if (delay_changed || !incremental_)
-	    iter_->enqueueAdjacentVertices(vertex);
+	    iter_->enqueueAdjacentVertices(vertex, adj_pred);
 	}
       }
       else {
 	// Load vertex.
 	enqueueTimingChecksEdges(vertex);
 	// Enqueue driver vertices from this input load.
-	if (propagate)
-	  iter_->enqueueAdjacentVertices(vertex);
+	if (propagate) {
+	  if (loadSlewsChanged(vertex))
+	    iter_->enqueueAdjacentVertices(vertex, adj_pred);
+	  else
+	    countSkippedDrvrs(vertex);
+	}
       }
     }
     // Bidirect port drivers are enqueued by their load vertex in
@@ -644,28 +742,125 @@ GraphDelayCalc::findDriverDelays(Vertex *drvr_vertex,
                                  ArcDelayCalc *arc_delay_calc)
 {
   bool delay_changed = false;
-  MultiDrvrNet *multi_drvr = findMultiDrvrNet(drvr_vertex);
+  MultiDrvrNet *multi_drvr = multiDrvrNet(drvr_vertex);
   if (multi_drvr == nullptr
       || (multi_drvr
           && (!multi_drvr->parallelGates(network_)
               || drvr_vertex == multi_drvr->dcalcDrvr()))) {
+    // Loads of multiple driver nets are always propagated.
+    bool track_load_slews = incremental_ && multi_drvr == nullptr;
+    vector<float> prev_load_slews;
+    if (track_load_slews)
+      saveLoadSlews(drvr_vertex, prev_load_slews);
     initLoadSlews(drvr_vertex);
     delay_changed |= findDriverDelays1(drvr_vertex, multi_drvr, arc_delay_calc);
+    if (track_load_slews)
+      findUnchangedLoadSlews(drvr_vertex, prev_load_slews);
   }
   arc_delay_calc_->finishDrvrPin();
   return delay_changed;
 }
 
+// Load slews in wire edge, analysis point, rise/fall order.
+void
+GraphDelayCalc::saveLoadSlews(Vertex *drvr_vertex,
+                              vector<float> &slews)
+{
+  VertexOutEdgeIterator edge_iter(drvr_vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *wire_edge = edge_iter.next();
+    if (wire_edge->isWire()) {
+      Vertex *load_vertex = wire_edge->to(graph_);
+      for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
+        DcalcAPIndex ap_index = dcalc_ap->index();
+        for (auto rf : RiseFall::range())
+          slews.push_back(delayAsFloat(graph_->slew(load_vertex, rf, ap_index)));
+      }
+    }
+  }
+}
+
+// Compare the load slews to the slews before the driver delays were
+// found. Loads with slews within the incremental delay tolerance do
+// not change the delays of the drivers they fan out to.
+void
+GraphDelayCalc::findUnchangedLoadSlews(Vertex *drvr_vertex,
+                                       const vector<float> &prev_slews)
+{
+  size_t slew_index = 0;
+  VertexOutEdgeIterator edge_iter(drvr_vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *wire_edge = edge_iter.next();
+    if (wire_edge->isWire()) {
+      Vertex *load_vertex = wire_edge->to(graph_);
+      bool slew_changed = false;
+      for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
+        DcalcAPIndex ap_index = dcalc_ap->index();
+        for (auto rf : RiseFall::range()) {
+          float slew = delayAsFloat(graph_->slew(load_vertex, rf, ap_index));
+          float prev_slew = prev_slews[slew_index++];
+          if (prev_slew == 0.0
+              ? slew != 0.0
+              : (abs(slew - prev_slew) / prev_slew
+                 > incremental_delay_tolerance_))
+            slew_changed = true;
+        }
+      }
+      VertexId load_id = graph_->id(load_vertex);
+      if (slew_changed)
+        unchanged_load_slews_->erase(load_id);
+      else
+        unchanged_load_slews_->insert(load_id);
+    }
+  }
+}
+
+// Load vertices seeded as invalid are always propagated because the
+// drivers they fan out to may have changed.
+bool
+GraphDelayCalc::loadSlewsChanged(Vertex *load_vertex)
+{
+  VertexId load_id = graph_->id(load_vertex);
+  return !incremental_
+    || !unchanged_load_slews_->hasKey(load_id)
+    || seeded_delays_->hasKey(load_id);
+}
+
+void
+GraphDelayCalc::countSkippedDrvrs(Vertex *load_vertex)
+{
+  SearchStats *stats = debug_->searchStats();
+  if (stats->enabled()) {
+    stats->incr(SearchStats::dcalc_loads_unchanged);
+    VertexOutEdgeIterator edge_iter(load_vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      if (search_non_latch_pred_->searchThru(edge))
+        stats->incr(SearchStats::dcalc_drvrs_skipped);
+    }
+  }
+}
+
+// Multiple driver nets are made before the vertices are visited so
+// the parallel delay calculation only looks them up.
+void
+GraphDelayCalc::makeMultiDrvrNets()
+{
+  VertexIterator vertex_iter(graph_);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    ensureMultiDrvrNet(vertex);
+  }
+}
+
 MultiDrvrNet *
-GraphDelayCalc::findMultiDrvrNet(Vertex *drvr_vertex)
+GraphDelayCalc::ensureMultiDrvrNet(Vertex *drvr_vertex)
 {
-  // Avoid locking for single driver nets.
-  if (hasMultiDrvrs(drvr_vertex)) {
-    UniqueLock lock(multi_drvr_lock_);
+  if (isLeafDriver(drvr_vertex->pin(), network_)) {
     MultiDrvrNet *multi_drvr = multiDrvrNet(drvr_vertex);
-    if (multi_drvr)
-      return multi_drvr;
-    multi_drvr = makeMultiDrvrNet(drvr_vertex);
+    if (multi_drvr == nullptr
+        && hasMultiDrvrs(drvr_vertex))
+      multi_drvr = makeMultiDrvrNet(drvr_vertex);
     return multi_drvr;
   }
   return nullptr;
@@ -784,6 +979,7 @@ GraphDelayCalc::findDriverDelays1(Vertex *drvr_vertex,
                                   MultiDrvrNet *multi_drvr,
                                   ArcDelayCalc *arc_delay_calc)
 {
+  debug_->searchStats()->incr(SearchStats::dcalc_drvr_vertices);
   initSlew(drvr_vertex);
   if (multi_drvr
       && multi_drvr->parallelGates(network_)) {
@@ -797,6 +993,9 @@ GraphDelayCalc::findDriverDelays1(Vertex *drvr_vertex,
     initWireDelays(drvr_vertex);
   bool delay_changed = false;
   bool has_delays = false;
+  // The loads are shared by all of the driver in-edges.
+  LoadPinIndexMap load_pin_index_map = makeLoadPinIndexMap(drvr_vertex);
+  DrvrLoadSeq drvr_loads;
   VertexInEdgeIterator edge_iter(drvr_vertex, graph_);
   while (edge_iter.hasNext()) {
     Edge *edge = edge_iter.next();
@@ -806,10 +1005,13 @@ GraphDelayCalc::findDriverDelays1(Vertex *drvr_vertex,
 	&& search_pred_->searchThru(edge)
         && !edge->role()->isLatchDtoQ()) {
       delay_changed |= findDriverEdgeDelays(drvr_vertex, multi_drvr, edge,
+                                            load_pin_index_map, drvr_loads,
                                             arc_delay_calc);
       has_delays = true;
     }
   }
+  // Parasitics in drvr_loads are valid until finishDrvrPin.
+  arc_delay_calc->finishDrvrPin();
   if (!has_delays)
     zeroSlewAndWireDelays(drvr_vertex);
   if (delay_changed && observer_)
@@ -851,17 +1053,40 @@ GraphDelayCalc::findDriverEdgeDelays(Vertex *drvr_vertex,
                                      const MultiDrvrNet *multi_drvr,
                                      Edge *edge,
                                      ArcDelayCalc *arc_delay_calc)
+{
+  LoadPinIndexMap load_pin_index_map = makeLoadPinIndexMap(drvr_vertex);
+  DrvrLoadSeq drvr_loads;
+  bool delay_changed = findDriverEdgeDelays(drvr_vertex, multi_drvr, edge,
+                                            load_pin_index_map, drvr_loads,
+                                            arc_delay_calc);
+  arc_delay_calc->finishDrvrPin();
+  return delay_changed;
+}
+
+bool
+GraphDelayCalc::findDriverEdgeDelays(Vertex *drvr_vertex,
+                                     const MultiDrvrNet *multi_drvr,
+                                     Edge *edge,
+                                     LoadPinIndexMap &load_pin_index_map,
+                                     DrvrLoadSeq &drvr_loads,
+                                     ArcDelayCalc *arc_delay_calc)
 {
   Vertex *from_vertex = edge->from(graph_);
   const TimingArcSet *arc_set = edge->timingArcSet();
   bool delay_changed = false;
-  LoadPinIndexMap load_pin_index_map = makeLoadPinIndexMap(drvr_vertex);
-  for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
-    for (const TimingArc *arc : arc_set->arcs())
-      delay_changed |= findDriverArcDelays(drvr_vertex, multi_drvr, edge, arc,
-                                           load_pin_index_map, dcalc_ap,
-                                           arc_delay_calc);
+  if (multi_drvr
+      && multi_drvr->parallelGates(network_)) {
+    for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
+      for (const TimingArc *arc : arc_set->arcs())
+        delay_changed |= findDriverArcDelays(drvr_vertex, multi_drvr, edge, arc,
+                                             load_pin_index_map, dcalc_ap,
+                                             arc_delay_calc);
+    }
   }
+  else
+    delay_changed = findDriverEdgeDelaysBatch(drvr_vertex, multi_drvr, edge,
+                                              load_pin_index_map, drvr_loads,
+                                              arc_delay_calc);
   if (delay_changed && observer_) {
     observer_->delayChangedFrom(from_vertex);
     observer_->delayChangedFrom(drvr_vertex);
@@ -869,6 +1094,71 @@ GraphDelayCalc::findDriverEdgeDelays(Vertex *drvr_vertex,
   return delay_changed;
 }
 
+// Find the delays of all edge arcs at all delay calc analysis points
+// with one batch call to the delay calculator. The parasitic and load
+// cap are found once per driver rise/fall and analysis point and shared
+// by the driver edges in drvr_loads.
+bool
+GraphDelayCalc::findDriverEdgeDelaysBatch(Vertex *drvr_vertex,
+                                          const MultiDrvrNet *multi_drvr,
+                                          Edge *edge,
+                                          LoadPinIndexMap &load_pin_index_map,
+                                          DrvrLoadSeq &drvr_loads,
+                                          ArcDelayCalc *arc_delay_calc)
+{
+  Vertex *from_vertex = edge->from(graph_);
+  const Pin *drvr_pin = drvr_vertex->pin();
+  const TimingArcSet *arc_set = edge->timingArcSet();
+  ArcDcalcBatchArgSeq batch_args;
+  for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
+    for (const TimingArc *arc : arc_set->arcs()) {
+      const RiseFall *from_rf = arc->fromEdge()->asRiseFall();
+      const RiseFall *drvr_rf = arc->toEdge()->asRiseFall();
+      if (from_rf && drvr_rf) {
+        const DrvrLoad &drvr_load = drvrLoad(drvr_pin, drvr_rf, dcalc_ap,
+                                             multi_drvr, arc_delay_calc,
+                                             drvr_loads);
+        const Slew in_slew = edgeFromSlew(from_vertex, from_rf, edge, dcalc_ap);
+        batch_args.emplace_back(arc, in_slew, drvr_load.load_cap_,
+                                drvr_load.parasitic_, dcalc_ap);
+      }
+    }
+  }
+  bool delay_changed = false;
+  if (!batch_args.empty()) {
+    ArcDcalcResultSeq dcalc_results =
+      arc_delay_calc->gateDelayBatch(drvr_pin, batch_args, load_pin_index_map);
+    for (size_t i = 0; i < batch_args.size(); i++) {
+      const ArcDcalcBatchArg &batch_arg = batch_args[i];
+      delay_changed |= annotateDelaysSlews(edge, batch_arg.arc(),
+                                           dcalc_results[i], load_pin_index_map,
+                                           batch_arg.dcalcAnalysisPt());
+    }
+  }
+  return delay_changed;
+}
+
+const DrvrLoad &
+GraphDelayCalc::drvrLoad(const Pin *drvr_pin,
+                         const RiseFall *drvr_rf,
+                         const DcalcAnalysisPt *dcalc_ap,
+                         const MultiDrvrNet *multi_drvr,
+                         ArcDelayCalc *arc_delay_calc,
+                         DrvrLoadSeq &drvr_loads) const
+{
+  if (drvr_loads.empty())
+    drvr_loads.resize(corners_->dcalcAnalysisPtCount() * RiseFall::index_count,
+                      DrvrLoad{false, 0.0, nullptr});
+  DrvrLoad &drvr_load = drvr_loads[dcalc_ap->index() * RiseFall::index_count
+                                   + drvr_rf->index()];
+  if (!drvr_load.found_) {
+    parasiticLoad(drvr_pin, drvr_rf, dcalc_ap, multi_drvr, arc_delay_calc,
+                  drvr_load.load_cap_, drvr_load.parasitic_);
+    drvr_load.found_ = true;
+  }
+  return drvr_load;
+}
+
 void
 GraphDelayCalc::findDriverArcDelays(Vertex *drvr_vertex,
                                     Edge *edge,
@@ -910,6 +1200,10 @@ GraphDelayCalc::findDriverArcDelays(Vertex *drvr_vertex,
       ArcDcalcResultSeq dcalc_results =
         arc_delay_calc->gateDelays(dcalc_args, load_cap, load_pin_index_map,
                                    dcalc_ap);
+      SearchStats *stats = debug_->searchStats();
+      stats->incr(SearchStats::dcalc_gate_delays, dcalc_args.size());
+      stats->incr(SearchStats::dcalc_load_delays,
+                  dcalc_args.size() * load_pin_index_map.size());
       for (size_t drvr_idx = 0; drvr_idx < dcalc_args.size(); drvr_idx++) {
         ArcDcalcArg &dcalc_arg = dcalc_args[drvr_idx];
         ArcDcalcResult &dcalc_result = dcalc_results[drvr_idx];
@@ -925,6 +1219,9 @@ GraphDelayCalc::findDriverArcDelays(Vertex *drvr_vertex,
                                                               load_cap, parasitic,
                                                               load_pin_index_map,
                                                               dcalc_ap);
+      SearchStats *stats = debug_->searchStats();
+      stats->incr(SearchStats::dcalc_gate_delays);
+      stats->incr(SearchStats::dcalc_load_delays, load_pin_index_map.size());
       delay_changed |= annotateDelaysSlews(edge, arc, dcalc_result,
                                            load_pin_index_map, dcalc_ap);
     }
@@ -1095,11 +1392,11 @@ GraphDelayCalc::annotateLoadDelays(Vertex *drvr_vertex,
       size_t load_idx = load_pin_index_map[load_pin];
       ArcDelay wire_delay = dcalc_result.wireDelay(load_idx);
       Slew load_slew = dcalc_result.loadSlew(load_idx);
-      debugPrint(debug_, "delay_calc", 3,
-                 "    %s load delay = %s slew = %s",
-                 load_vertex->name(sdc_network_),
-                 delayAsString(wire_delay, this),
-                 delayAsString(load_slew, this));
+      debugPrintHot(debug_, "delay_calc", 3,
+                    "    %s load delay = %s slew = %s",
+                    load_vertex->name(sdc_network_),
+                    delayAsString(wire_delay, this),
+                    delayAsString(load_slew, this));
       if (!load_vertex->slewAnnotated(drvr_rf, slew_min_max)) {
 	if (drvr_vertex->slewAnnotated(drvr_rf, slew_min_max)) {
 	  // Copy the driver slew to the load if it is annotated.
@@ -1157,13 +1454,29 @@ float
 GraphDelayCalc::loadCap(const Pin *drvr_pin,
                         const DcalcAnalysisPt *dcalc_ap) const
 {
+  return loadCap(drvr_pin, dcalc_ap, arc_delay_calc_);
+}
+
+float
+GraphDelayCalc::loadCap(const Pin *drvr_pin,
+                        const DcalcAnalysisPt *dcalc_ap,
+                        ArcDelayCalc *arc_delay_calc) const
+{
+  MultiDrvrNet *multi_drvr = nullptr;
+  if (graph_) {
+    Vertex *drvr_vertex = graph_->pinDrvrVertex(drvr_pin);
+    multi_drvr = multiDrvrNet(drvr_vertex);
+  }
   const MinMax *min_max = dcalc_ap->constraintMinMax();
   float load_cap = min_max->initValue();
   for (auto drvr_rf : RiseFall::range()) {
-    float cap = loadCap(drvr_pin, drvr_rf, dcalc_ap);
-    load_cap = min_max->minMax(cap, load_cap);
+    float pin_cap, wire_cap;
+    const Parasitic *parasitic;
+    parasiticLoad(drvr_pin, drvr_rf, dcalc_ap, multi_drvr, arc_delay_calc,
+                  pin_cap, wire_cap, parasitic);
+    load_cap = min_max->minMax(pin_cap + wire_cap, load_cap);
   }
-  arc_delay_calc_->finishDrvrPin();
+  arc_delay_calc->finishDrvrPin();
   return load_cap;
 }
 
@@ -1387,15 +1700,18 @@ void
 GraphDelayCalc::findCheckEdgeDelays(Edge *edge,
                                     ArcDelayCalc *arc_delay_calc)
 {
+  // Skip checks with every arc annotated.
+  if (graph_->delayAnnotated(edge))
+    return;
   Vertex *from_vertex = edge->from(graph_);
   Vertex *to_vertex = edge->to(graph_);
   TimingArcSet *arc_set = edge->timingArcSet();
   const Pin *to_pin = to_vertex->pin();
   Instance *inst = network_->instance(to_pin);
-  debugPrint(debug_, "delay_calc", 2, "find check %s %s -> %s",
-             sdc_network_->pathName(inst),
-             network_->portName(from_vertex->pin()),
-             network_->portName(to_pin));
+  debugPrintHot(debug_, "delay_calc", 2, "find check %s %s -> %s",
+                sdc_network_->pathName(inst),
+                network_->portName(from_vertex->pin()),
+                network_->portName(to_pin));
   bool delay_changed = false;
   for (TimingArc *arc : arc_set->arcs()) {
     RiseFall *from_rf = arc->fromEdge()->asRiseFall();
@@ -1412,28 +1728,28 @@ GraphDelayCalc::findCheckEdgeDelays(Edge *edge,
 						   dcalc_ap);
 	  int slew_index = dcalc_ap->checkDataSlewIndex();
 	  const Slew &to_slew = graph_->slew(to_vertex, to_rf, slew_index);
-	  debugPrint(debug_, "delay_calc", 3,
-                     "  %s %s -> %s %s (%s) corner:%s/%s",
-                     arc_set->from()->name(),
-                     arc->fromEdge()->asString(),
-                     arc_set->to()->name(),
-                     arc->toEdge()->asString(),
-                     arc_set->role()->asString(),
-                     dcalc_ap->corner()->name(),
-                     dcalc_ap->delayMinMax()->asString());
-	  debugPrint(debug_, "delay_calc", 3,
-                     "    from_slew = %s to_slew = %s",
-                     delayAsString(from_slew, this),
-                     delayAsString(to_slew, this));
+	  debugPrintHot(debug_, "delay_calc", 3,
+                        "  %s %s -> %s %s (%s) corner:%s/%s",
+                        arc_set->from()->name(),
+                        arc->fromEdge()->asString(),
+                        arc_set->to()->name(),
+                        arc->toEdge()->asString(),
+                        arc_set->role()->asString(),
+                        dcalc_ap->corner()->name(),
+                        dcalc_ap->delayMinMax()->asString());
+	  debugPrintHot(debug_, "delay_calc", 3,
+                        "    from_slew = %s to_slew = %s",
+                        delayAsString(from_slew, this),
+                        delayAsString(to_slew, this));
 	  float related_out_cap = 0.0;
 	  if (related_out_pin)
 	    related_out_cap = loadCap(related_out_pin, to_rf,dcalc_ap,arc_delay_calc);
           ArcDelay check_delay = arc_delay_calc->checkDelay(to_pin, arc, from_slew,
                                                             to_slew, related_out_cap,
                                                             dcalc_ap);
-	  debugPrint(debug_, "delay_calc", 3,
-                     "    check_delay = %s",
-                     delayAsString(check_delay, this));
+	  debugPrintHot(debug_, "delay_calc", 3,
+                        "    check_delay = %s",
+                        delayAsString(check_delay, this));
 	  graph_->setArcDelay(edge, arc, ap_index, check_delay);
 	  delay_changed = true;
           arc_delay_calc_->finishDrvrPin();
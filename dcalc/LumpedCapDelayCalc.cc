@@ -75,6 +75,9 @@ LumpedCapDelayCalc::findParasitic(const Pin *drvr_pin,
       return parasitic;
   }
   const MinMax *min_max = dcalc_ap->constraintMinMax();
+  parasitic = parasitics_->estimatePiElmore(drvr_pin, rf, corner, min_max);
+  if (parasitic)
+    return parasitic;
   Wireload *wireload = sdc_->wireload(min_max);
   if (wireload) {
     float pin_cap, wire_cap, fanout;
@@ -18,16 +18,33 @@ exec tclsh $0 ${1+"$@"}
 # You should have received a copy of the GNU General Public License
 # along with this program. If not, see <https://www.gnu.org/licenses/>.
 
-# Usage: TclEncode encoded_filename var_name tcl_init_dir tcl_filename...
+# Usage: TclEncode encoded_filename var_name tcl_filename... [-lazy tcl_filename...]
 # Encode the contents of tcl_filenames into a C character array
 # named var_name in the file encoded_filename.
 # Each TCL file is encoded as a separate string of three digit decimal numbers
 # that is unencoded and evaled on startup of the application.  
 # The init variable character array is terminated with a NULL pointer.
+#
+# The files after -lazy are each encoded into a separate array
+# that is evaled the first time one of its commands is used.
+# var_name_lazy is the NULL terminated array of the lazy arrays.
+# The commands and procs of the lazy files are registered with
+# sta::define_lazy_tcl_init at the end of var_name.
 
 set encoded_filename [lindex $argv 0]
 set init_var [lindex $argv 1]
-set init_filenames [lrange $argv 2 end]
+set init_filenames {}
+set lazy_filenames {}
+set lazy 0
+foreach arg [lrange $argv 2 end] {
+  if { $arg == "-lazy" } {
+    set lazy 1
+  } elseif { $lazy } {
+    lappend lazy_filenames $arg
+  } else {
+    lappend init_filenames $arg
+  }
+}
 
 # Microcruft Visual C-- ridiculously short max string constant length.
 set max_string_length 2000
@@ -35,8 +52,6 @@ set max_string_length 2000
 set out_stream [open $encoded_filename w]
 puts $out_stream "// TCL init file encoded by TclEncode.tcl"
 puts $out_stream "namespace sta {"
-puts $out_stream "const char *$init_var\[\] = {"
-puts -nonewline $out_stream "\""
 set encoded_length 0
 
 binary scan "\n" c newline_enc
@@ -72,13 +87,72 @@ proc encode_file { filename } {
   close $in_stream
 }
 
+proc begin_var { var } {
+  global out_stream encoded_length
+
+  puts $out_stream "const char *$var\[\] = \{"
+  puts -nonewline $out_stream "\""
+  set encoded_length 0
+}
+
+proc end_var {} {
+  global out_stream
+
+  puts $out_stream "\","
+  # NULL string to terminate char* array.
+  puts $out_stream "0"
+  puts $out_stream "\};"
+}
+
+# Commands defined with define_cmd_args/define_hidden_cmd_args and
+# procs defined with proc/proc_redirect in the sta namespace of filename.
+proc lazy_file_names { filename cmds_var procs_var } {
+  upvar 1 $cmds_var cmds
+  upvar 1 $procs_var procs
+
+  set cmds {}
+  set procs {}
+  set in_stream [open $filename r]
+  while {![eof $in_stream]} {
+    gets $in_stream line
+    if { [regexp {^\s*define_(hidden_)?cmd_args\s+"?([A-Za-z0-9_]+)} \
+            $line ignore hidden cmd] } {
+      lappend cmds $cmd
+    } elseif { [regexp {^\s*proc(_redirect)?\s+([A-Za-z0-9_]+)} \
+                  $line ignore redirect proc_name] } {
+      lappend procs $proc_name
+    }
+  }
+  close $in_stream
+}
+
+begin_var $init_var
 foreach filename $init_filenames {
   encode_file $filename
 }
+set index 0
+foreach filename $lazy_filenames {
+  lazy_file_names $filename cmds procs
+  encode_line [list sta::define_lazy_tcl_init $index $cmds $procs]
+  incr index
+}
+end_var
 
-puts $out_stream "\","
-# NULL string to terminate char* array.
-puts $out_stream "0"
+set index 0
+foreach filename $lazy_filenames {
+  begin_var "${init_var}_lazy_$index"
+  encode_file $filename
+  end_var
+  incr index
+}
+
+puts $out_stream "const char **${init_var}_lazy\[\] = {"
+set index 0
+foreach filename $lazy_filenames {
+  puts $out_stream "  ${init_var}_lazy_$index,"
+  incr index
+}
+puts $out_stream "  0"
 puts $out_stream "};"
 puts $out_stream "} // namespace"
 close $out_stream
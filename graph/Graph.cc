@@ -16,7 +16,13 @@
 
 #include "Graph.hh"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Machine.hh"
 #include "Debug.hh"
+#include "DispatchQueue.hh"
 #include "Stats.hh"
 #include "MinMax.hh"
 #include "Mutex.hh"
@@ -27,9 +33,15 @@
 #include "PortDirection.hh"
 #include "Network.hh"
 #include "DcalcAnalysisPt.hh"
+#include "MemoryStats.hh"
 
 namespace sta {
 
+using std::max;
+
+// Instances made per thread at a time.
+static const size_t graph_make_chunk_size = 256;
+
 ////////////////////////////////////////////////////////////////
 //
 // Graph
@@ -47,8 +59,12 @@ Graph::Graph(StaState *sta,
   slew_rf_count_(slew_rf_count),
   have_arc_delays_(have_arc_delays),
   ap_count_(ap_count),
+  delay_mismatches_(nullptr),
+  delays_mismatched_(false),
   period_check_annotations_(nullptr),
-  reg_clk_vertices_(new VertexSet(graph_))
+  reg_clk_vertices_(new VertexSet(graph_)),
+  adjacency_valid_(false),
+  edit_count_(0)
 {
   // For the benifit of reg_clk_vertices_ that references graph_.
   graph_ = this;
@@ -61,15 +77,27 @@ Graph::~Graph()
   delete reg_clk_vertices_;
   deleteSlewTables();
   deleteArcDelayTables();
+  delete [] delay_mismatches_;
   removePeriodCheckAnnotations();
 }
 
 void
 Graph::makeGraph()
+{
+  InstanceSeq insts;
+  LeafInstanceIterator *leaf_iter = network_->leafInstanceIterator();
+  while (leaf_iter->hasNext())
+    insts.push_back(leaf_iter->next());
+  delete leaf_iter;
+  makeGraph(insts);
+}
+
+void
+Graph::makeGraph(const InstanceSeq &insts)
 {
   Stats stats(debug_, report_);
-  makeVerticesAndEdges();
-  makeWireEdges();
+  makeVerticesAndEdges(insts);
+  makeWireEdges(insts);
   stats.report("Make graph");
 }
 
@@ -78,23 +106,175 @@ Graph::makeGraph()
 // because network may not connect floating pins to a net
 // (ie, Intime occurence tree bleachery).
 void
-Graph::makeVerticesAndEdges()
+Graph::makeVerticesAndEdges(const InstanceSeq &insts)
 {
   vertices_ = new VertexTable;
   edges_ = new EdgeTable;
+  makeDelayTableAps(ap_count_);
   makeSlewTables(ap_count_);
   makeArcDelayTables(ap_count_);
 
-  LeafInstanceIterator *leaf_iter = network_->leafInstanceIterator();
-  while (leaf_iter->hasNext()) {
-    const Instance *inst = leaf_iter->next();
-    makePinVertices(inst);
-    makeInstanceEdges(inst);
+  if (dispatch_queue_ && thread_count_ > 1
+      && insts.size() >= graph_make_chunk_size * 2)
+    makeVerticesAndEdgesParallel(insts);
+  else {
+    for (const Instance *inst : insts) {
+      makePinVertices(inst);
+      makeInstanceEdges(inst);
+    }
   }
-  delete leaf_iter;
   makePinVertices(network_->topInstance());
 }
 
+// Instance vertices and edges are made in the same order with the
+// same ids as the serial loop above. Vertex and edge ids for each
+// chunk of instances are reserved from counts found first, so the
+// chunks are filled in independently. Instance edges only connect
+// the vertices of one instance. Arc delay ids are allocated serially
+// in edge id order once the edges are linked.
+void
+Graph::makeVerticesAndEdgesParallel(const InstanceSeq &insts)
+{
+  size_t inst_count = insts.size();
+  size_t chunk_size = max(graph_make_chunk_size,
+                          inst_count / (thread_count_ * 4) + 1);
+  size_t chunk_count = (inst_count + chunk_size - 1) / chunk_size;
+
+  // Count vertices.
+  std::vector<size_t> vertex_counts(chunk_count, 0);
+  for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+    size_t from = chunk * chunk_size;
+    size_t to = std::min(from + chunk_size, inst_count);
+    dispatch_queue_->dispatch([=, &insts, &vertex_counts] (int) {
+      size_t count = 0;
+      for (size_t i = from; i < to; i++) {
+        InstancePinIterator *pin_iter = network_->pinIterator(insts[i]);
+        while (pin_iter->hasNext()) {
+          PortDirection *dir = network_->direction(pin_iter->next());
+          if (!dir->isPowerGround())
+            count += dir->isBidirect() ? 2 : 1;
+        }
+        delete pin_iter;
+      }
+      vertex_counts[chunk] = count;
+    });
+  }
+  dispatch_queue_->finishTasks();
+
+  size_t vertex_count = 0;
+  for (size_t count : vertex_counts)
+    vertex_count += count;
+  VertexId vertex_id = vertices_->makeSequential(vertex_count);
+  if (vertex_count > 0)
+    // Size the slew tables for all of the vertices.
+    makeVertexSlews(vertices_->pointer(vertex_id + vertex_count - 1));
+
+  // Make vertices.
+  std::vector<std::vector<std::pair<const Pin*, Vertex*>>>
+    bidirect_drvrs(chunk_count);
+  std::vector<std::vector<Vertex*>> reg_clks(chunk_count);
+  for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+    size_t from = chunk * chunk_size;
+    size_t to = std::min(from + chunk_size, inst_count);
+    dispatch_queue_->dispatch([=, &insts, &bidirect_drvrs, &reg_clks] (int) {
+      VertexId next_id = vertex_id;
+      for (size_t i = from; i < to; i++) {
+        InstancePinIterator *pin_iter = network_->pinIterator(insts[i]);
+        while (pin_iter->hasNext()) {
+          Pin *pin = pin_iter->next();
+          PortDirection *dir = network_->direction(pin);
+          if (!dir->isPowerGround()) {
+            bool is_reg_clk = network_->isRegClkPin(pin);
+            Vertex *vertex = vertices_->pointer(next_id++);
+            vertex->init(pin, false, is_reg_clk);
+            makeVertexSlews(vertex);
+            network_->setVertexId(pin, id(vertex));
+            if (is_reg_clk)
+              reg_clks[chunk].push_back(vertex);
+            if (dir->isBidirect()) {
+              Vertex *bidir_drvr_vertex = vertices_->pointer(next_id++);
+              bidir_drvr_vertex->init(pin, true, is_reg_clk);
+              makeVertexSlews(bidir_drvr_vertex);
+              bidirect_drvrs[chunk].push_back({pin, bidir_drvr_vertex});
+              if (is_reg_clk)
+                reg_clks[chunk].push_back(bidir_drvr_vertex);
+            }
+          }
+        }
+        delete pin_iter;
+      }
+    });
+    vertex_id += vertex_counts[chunk];
+  }
+  dispatch_queue_->finishTasks();
+  for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+    for (auto &pin_vertex : bidirect_drvrs[chunk])
+      pin_bidirect_drvr_vertex_map_[pin_vertex.first] = pin_vertex.second;
+    for (Vertex *vertex : reg_clks[chunk])
+      reg_clk_vertices_->insert(vertex);
+  }
+
+  // Count edges.
+  std::vector<size_t> edge_counts(chunk_count, 0);
+  for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+    size_t from = chunk * chunk_size;
+    size_t to = std::min(from + chunk_size, inst_count);
+    dispatch_queue_->dispatch([=, &insts, &edge_counts] (int) {
+      size_t count = 0;
+      for (size_t i = from; i < to; i++) {
+        const Instance *inst = insts[i];
+        LibertyCell *cell = network_->libertyCell(inst);
+        if (cell)
+          visitPortInstanceEdges(inst, cell, nullptr,
+                                 [&] (Vertex *, Vertex *, TimingArcSet *) {
+                                   count++;
+                                   return static_cast<Edge*>(nullptr);
+                                 });
+      }
+      edge_counts[chunk] = count;
+    });
+  }
+  dispatch_queue_->finishTasks();
+
+  size_t edge_count = 0;
+  for (size_t count : edge_counts)
+    edge_count += count;
+  EdgeId first_edge_id = edges_->makeSequential(edge_count);
+
+  // Make edges.
+  EdgeId edge_id = first_edge_id;
+  for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+    size_t from = chunk * chunk_size;
+    size_t to = std::min(from + chunk_size, inst_count);
+    dispatch_queue_->dispatch([=, &insts] (int) {
+      EdgeId next_id = edge_id;
+      for (size_t i = from; i < to; i++) {
+        const Instance *inst = insts[i];
+        LibertyCell *cell = network_->libertyCell(inst);
+        if (cell)
+          visitPortInstanceEdges(inst, cell, nullptr,
+                                 [&] (Vertex *from_vertex,
+                                      Vertex *to_vertex,
+                                      TimingArcSet *arc_set) {
+                                   Edge *edge = edges_->pointer(next_id++);
+                                   linkEdge(edge, from_vertex, to_vertex,
+                                            arc_set);
+                                   return edge;
+                                 });
+      }
+    });
+    edge_id += edge_counts[chunk];
+  }
+  dispatch_queue_->finishTasks();
+
+  for (size_t i = 0; i < edge_count; i++) {
+    Edge *edge = edges_->pointer(first_edge_id + i);
+    makeEdgeArcDelays(edge);
+    arc_count_ += edge->timingArcSet()->arcCount();
+  }
+  graphEdited();
+}
+
 class FindNetDrvrLoadCounts : public PinVisitor
 {
 public:
@@ -182,6 +362,21 @@ void
 Graph::makePortInstanceEdges(const Instance *inst,
 			     LibertyCell *cell,
 			     LibertyPort *from_to_port)
+{
+  visitPortInstanceEdges(inst, cell, from_to_port,
+                         [this] (Vertex *from_vertex,
+                                 Vertex *to_vertex,
+                                 TimingArcSet *arc_set) {
+                           return makeEdge(from_vertex, to_vertex, arc_set);
+                         });
+}
+
+template <class MAKE_EDGE>
+void
+Graph::visitPortInstanceEdges(const Instance *inst,
+                              LibertyCell *cell,
+                              LibertyPort *from_to_port,
+                              MAKE_EDGE make_edge)
 {
   for (TimingArcSet *arc_set : cell->timingArcSets()) {
     LibertyPort *from_port = arc_set->from();
@@ -206,10 +401,10 @@ Graph::makePortInstanceEdges(const Instance *inst,
           TimingRole *role = arc_set->role();
   	  bool is_check = role->isTimingCheckBetween();
 	  if (to_bidirect_drvr_vertex && !is_check)
-	    makeEdge(from_vertex, to_bidirect_drvr_vertex, arc_set);
+	    make_edge(from_vertex, to_bidirect_drvr_vertex, arc_set);
 	  else if (to_vertex) {
-	    makeEdge(from_vertex, to_vertex, arc_set);
-	    if (is_check) {
+	    Edge *edge = make_edge(from_vertex, to_vertex, arc_set);
+	    if (is_check && edge) {
 	      to_vertex->setHasChecks(true);
 	      from_vertex->setIsCheckClk(true);
 	    }
@@ -217,9 +412,10 @@ Graph::makePortInstanceEdges(const Instance *inst,
 	  if (from_bidirect_drvr_vertex && to_vertex) {
 	    // Internal path from bidirect output back into the
 	    // instance.
-	    Edge *edge = makeEdge(from_bidirect_drvr_vertex, to_vertex,
-				  arc_set);
-	    edge->setIsBidirectInstPath(true);
+	    Edge *edge = make_edge(from_bidirect_drvr_vertex, to_vertex,
+				   arc_set);
+	    if (edge)
+	      edge->setIsBidirectInstPath(true);
 	  }
 	}
       }
@@ -228,18 +424,103 @@ Graph::makePortInstanceEdges(const Instance *inst,
 }
 
 void
-Graph::makeWireEdges()
+Graph::makeWireEdges(const InstanceSeq &insts)
 {
   PinSet visited_drvrs(network_);
-  LeafInstanceIterator *inst_iter = network_->leafInstanceIterator();
-  while (inst_iter->hasNext()) {
-    Instance *inst = inst_iter->next();
+  for (const Instance *inst : insts)
     makeInstDrvrWireEdges(inst, visited_drvrs);
-  }
-  delete inst_iter;
   makeInstDrvrWireEdges(network_->topInstance(), visited_drvrs);
 }
 
+InstanceSeq
+Graph::levelOrderInstances()
+{
+  // Longest path levels from the roots with Kahn's algorithm.
+  VertexSeq vertices;
+  VertexIterator vertex_iter(this);
+  while (vertex_iter.hasNext())
+    vertices.push_back(vertex_iter.next());
+  VertexId vertex_bound = vertexIdBound();
+  std::vector<int> levels(vertex_bound, 0);
+  std::vector<int> fanin_counts(vertex_bound, 0);
+  std::vector<bool> visited(vertex_bound, false);
+  for (Vertex *vertex : vertices) {
+    VertexOutEdgeIterator edge_iter(vertex, this);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      if (!edge->role()->isTimingCheck())
+        fanin_counts[id(edge->to(this))]++;
+    }
+  }
+  VertexSeq queue;
+  for (Vertex *vertex : vertices) {
+    if (fanin_counts[id(vertex)] == 0)
+      queue.push_back(vertex);
+  }
+  // Vertices left when the queue is empty are in loops, so restart
+  // from the first of them.
+  size_t loop_index = 0;
+  while (true) {
+    while (!queue.empty()) {
+      Vertex *vertex = queue.back();
+      queue.pop_back();
+      VertexId vertex_id = id(vertex);
+      if (!visited[vertex_id]) {
+        visited[vertex_id] = true;
+        VertexOutEdgeIterator edge_iter(vertex, this);
+        while (edge_iter.hasNext()) {
+          Edge *edge = edge_iter.next();
+          if (!edge->role()->isTimingCheck()) {
+            Vertex *to_vertex = edge->to(this);
+            VertexId to_id = id(to_vertex);
+            levels[to_id] = max(levels[to_id], levels[vertex_id] + 1);
+            if (--fanin_counts[to_id] == 0)
+              queue.push_back(to_vertex);
+          }
+        }
+      }
+    }
+    while (loop_index < vertices.size()
+           && visited[id(vertices[loop_index])])
+      loop_index++;
+    if (loop_index == vertices.size())
+      break;
+    queue.push_back(vertices[loop_index]);
+  }
+
+  // Sort instances by the highest level of their vertices so the
+  // vertices of a search level get neighboring ids.
+  std::vector<std::pair<int, const Instance*>> inst_levels;
+  LeafInstanceIterator *leaf_iter = network_->leafInstanceIterator();
+  while (leaf_iter->hasNext()) {
+    const Instance *inst = leaf_iter->next();
+    int inst_level = 0;
+    InstancePinIterator *pin_iter = network_->pinIterator(inst);
+    while (pin_iter->hasNext()) {
+      const Pin *pin = pin_iter->next();
+      Vertex *vertex, *bidirect_drvr_vertex;
+      pinVertices(pin, vertex, bidirect_drvr_vertex);
+      if (vertex)
+        inst_level = max(inst_level, levels[id(vertex)]);
+      if (bidirect_drvr_vertex)
+        inst_level = max(inst_level, levels[id(bidirect_drvr_vertex)]);
+    }
+    delete pin_iter;
+    inst_levels.push_back({inst_level, inst});
+  }
+  delete leaf_iter;
+  std::stable_sort(inst_levels.begin(), inst_levels.end(),
+                   [] (const std::pair<int, const Instance*> &inst_level1,
+                       const std::pair<int, const Instance*> &inst_level2) {
+                     return inst_level1.first < inst_level2.first;
+                   });
+  InstanceSeq insts;
+  insts.reserve(inst_levels.size());
+  for (auto &inst_level : inst_levels)
+    insts.push_back(inst_level.second);
+  return insts;
+}
+
 void
 Graph::makeInstDrvrWireEdges(const Instance *inst,
 			     PinSet &visited_drvrs)
@@ -432,6 +713,7 @@ Graph::makeVertex(Pin *pin,
 {
   Vertex *vertex = vertices_->make();
   vertex->init(pin, is_bidirect_drvr, is_reg_clk);
+  graphEdited();
   makeVertexSlews(vertex);
   if (is_reg_clk)
     reg_clk_vertices_->insert(vertex);
@@ -508,6 +790,7 @@ void
 Graph::deleteInEdge(Vertex *vertex,
 		    Edge *edge)
 {
+  graphEdited();
   EdgeId edge_id = id(edge);
   EdgeId prev = 0;
   for (EdgeId i = vertex->in_edges_;
@@ -524,6 +807,7 @@ void
 Graph::deleteOutEdge(Vertex *vertex,
 		     Edge *edge)
 {
+  graphEdited();
   EdgeId next = edge->vertex_out_next_;
   EdgeId prev = edge->vertex_out_prev_;
   if (prev)
@@ -660,15 +944,271 @@ Graph::prevPaths(Vertex *vertex) const
   return prev_paths_.pointer(vertex->prevPaths());
 }
 
+void
+Graph::prefetchVertexData(const Vertex *vertex) const
+{
+  if (vertex->in_edges_ != edge_id_null)
+    prefetchRead(edges_->pointer(vertex->in_edges_));
+  if (vertex->out_edges_ != edge_id_null)
+    prefetchRead(edges_->pointer(vertex->out_edges_));
+  if (vertex->arrivals() != arrival_null)
+    prefetchRead(arrivals_.pointer(vertex->arrivals()));
+  if (vertex->prevPaths() != prev_path_null)
+    prefetchRead(prev_paths_.pointer(vertex->prevPaths()));
+}
+
+void
+Graph::deletePrevPaths(Vertex *vertex,
+                       uint32_t count)
+{
+  if (vertex->prevPaths() != prev_path_null) {
+    {
+      UniqueLock lock(prev_paths_lock_);
+      prev_paths_.destroy(vertex->prevPaths(), count);
+    }
+    vertex->setPrevPaths(prev_path_null);
+  }
+}
+
 void
 Graph::clearPrevPaths()
 {
   prev_paths_.clear();
 }
 
+void
+Graph::deletePaths(Vertex *vertex,
+                   uint32_t count)
+{
+  if (vertex->arrivals() != arrival_null)
+    deleteArrivals(vertex, count);
+  if (vertex->hasRequireds())
+    deleteRequireds(vertex, count);
+  deletePrevPaths(vertex, count);
+  vertex->deletePaths();
+}
+
+// Compacting copies every live array, so wait until deleted arrays
+// hold more of the blocks than the live ones.
+static constexpr size_t compact_paths_min = 1 << 20;
+
+template <class TYPE>
+static bool
+arrayTableFragmented(const ArrayTable<TYPE> &table)
+{
+  size_t dead = table.capacity() - table.size();
+  return dead > compact_paths_min
+    && dead > table.size();
+}
+
+bool
+Graph::pathsFragmented() const
+{
+  return arrayTableFragmented(arrivals_)
+    || arrayTableFragmented(requireds_)
+    || arrayTableFragmented(prev_paths_);
+}
+
+template <class TYPE>
+static ObjectId
+copyArray(ArrayTable<TYPE> &from,
+          ArrayTable<TYPE> &to,
+          ObjectId id,
+          uint32_t count)
+{
+  if (id == object_id_null || count == 0)
+    return object_id_null;
+  else {
+    TYPE *to_array;
+    ObjectId to_id;
+    to.make(count, to_array, to_id);
+    TYPE *from_array = from.pointer(id);
+    std::copy(from_array, from_array + count, to_array);
+    return to_id;
+  }
+}
+
+void
+Graph::compactPaths(const std::function<uint32_t (Vertex *vertex)> &arrival_count)
+{
+  Stats stats(debug_, report_);
+  ArrivalsTable arrivals;
+  RequiredsTable requireds;
+  PrevPathsTable prev_paths;
+  // Vertex order keeps the arrays of nearby vertices together.
+  VertexIterator vertex_iter(this);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    uint32_t count = arrival_count(vertex);
+    vertex->setArrivals(copyArray(arrivals_, arrivals,
+                                  vertex->arrivals(), count));
+    vertex->setRequireds(copyArray(requireds_, requireds,
+                                   vertex->requireds(), count));
+    vertex->setPrevPaths(copyArray(prev_paths_, prev_paths,
+                                   vertex->prevPaths(), count));
+  }
+  arrivals_.swap(arrivals);
+  requireds_.swap(requireds);
+  prev_paths_.swap(prev_paths);
+  stats.report("Compact paths");
+}
+
+GraphModeTiming::~GraphModeTiming()
+{
+  for (size_t i = 0; i < slew_tables_.size(); i++) {
+    DcalcAPIndex ap_index = i / slew_rf_count_;
+    if (delay_table_aps_[ap_index] == ap_index)
+      delete slew_tables_[i];
+  }
+  for (size_t i = 0; i < arc_delays_.size(); i++) {
+    if (delay_table_aps_[i] == DcalcAPIndex(i))
+      delete arc_delays_[i];
+  }
+}
+
+GraphModeTiming *
+Graph::saveModeTiming()
+{
+  Stats stats(debug_, report_);
+  GraphModeTiming *timing = new GraphModeTiming;
+  timing->vertices_.resize(vertexIdBound());
+  VertexIterator vertex_iter(this);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    VertexModeTiming &vertex_timing = timing->vertices_[id(vertex)];
+    vertex_timing.arrivals_ = vertex->arrivals();
+    vertex_timing.requireds_ = vertex->requireds();
+    vertex_timing.prev_paths_ = vertex->prevPaths();
+    vertex_timing.tag_group_index_ = vertex->tagGroupIndex();
+    vertex_timing.level_ = vertex->level();
+    vertex_timing.crpr_path_pruning_disabled_ = vertex->crprPathPruningDisabled();
+    vertex_timing.requireds_pruned_ = vertex->requiredsPruned();
+    vertex->deletePaths();
+  }
+  arrivals_.swap(timing->arrivals_);
+  requireds_.swap(timing->requireds_);
+  prev_paths_.swap(timing->prev_paths_);
+  // Copy the slews and arc delays so the ids of the graph tables
+  // stay the same.
+  timing->delay_table_aps_ = delay_table_aps_;
+  timing->slew_rf_count_ = slew_rf_count_;
+  copyDelayTables(slew_tables_, slew_rf_count_, timing->slew_tables_);
+  copyDelayTables(arc_delays_, 1, timing->arc_delays_);
+  timing->edit_count_ = edit_count_;
+  stats.report("Save mode timing");
+  return timing;
+}
+
+// Copy the tables owned by their analysis point and share the rest.
+void
+Graph::copyDelayTables(const DelayTableSeq &from,
+                       int tables_per_ap,
+                       DelayTableSeq &to) const
+{
+  to.resize(from.size());
+  for (size_t i = 0; i < from.size(); i++) {
+    DcalcAPIndex ap_index = i / tables_per_ap;
+    if (!delaysShared(ap_index)) {
+      DelayTable *table = new DelayTable(from[i]->meansOnly());
+      table->copy(*from[i]);
+      to[i] = table;
+    }
+  }
+  for (size_t i = 0; i < from.size(); i++) {
+    DcalcAPIndex ap_index = i / tables_per_ap;
+    DcalcAPIndex table_ap = delay_table_aps_[ap_index];
+    if (table_ap != ap_index)
+      to[i] = to[table_ap * tables_per_ap + i % tables_per_ap];
+  }
+}
+
+bool
+Graph::modeTimingValid(const GraphModeTiming *timing) const
+{
+  const DelayTable *table = slew_tables_.empty() ? nullptr : slew_tables_[0];
+  const DelayTable *saved_table = timing->slew_tables_.empty()
+    ? nullptr
+    : timing->slew_tables_[0];
+  return timing->edit_count_ == edit_count_
+    && timing->delay_table_aps_ == delay_table_aps_
+    && timing->slew_tables_.size() == slew_tables_.size()
+    && timing->arc_delays_.size() == arc_delays_.size()
+    && (table == nullptr
+        || table->meansOnly() == saved_table->meansOnly());
+}
+
+void
+Graph::restoreModeTiming(GraphModeTiming *timing,
+                         VertexSeq &level_changes)
+{
+  Stats stats(debug_, report_);
+  VertexIterator vertex_iter(this);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    keepAnnotatedDelays(vertex, timing);
+    const VertexModeTiming &vertex_timing = timing->vertices_[id(vertex)];
+    vertex->setArrivals(vertex_timing.arrivals_);
+    vertex->setRequireds(vertex_timing.requireds_);
+    vertex->setPrevPaths(vertex_timing.prev_paths_);
+    vertex->setTagGroupIndex(vertex_timing.tag_group_index_);
+    vertex->setCrprPathPruningDisabled(vertex_timing.crpr_path_pruning_disabled_);
+    vertex->setRequiredsPruned(vertex_timing.requireds_pruned_);
+    if (vertex->level() != vertex_timing.level_)
+      level_changes.push_back(vertex);
+  }
+  arrivals_.swap(timing->arrivals_);
+  requireds_.swap(timing->requireds_);
+  prev_paths_.swap(timing->prev_paths_);
+  for (size_t i = 0; i < slew_tables_.size(); i++) {
+    if (!delaysShared(i / slew_rf_count_))
+      slew_tables_[i]->copy(*timing->slew_tables_[i]);
+  }
+  for (size_t i = 0; i < arc_delays_.size(); i++) {
+    if (!delaysShared(i))
+      arc_delays_[i]->copy(*timing->arc_delays_[i]);
+  }
+  delete timing;
+  stats.report("Restore mode timing");
+}
+
+// Sdf and set_annotated_delay annotations apply to every mode, so
+// copy the current annotated values to the saved tables.
+void
+Graph::keepAnnotatedDelays(Vertex *vertex,
+                           GraphModeTiming *timing)
+{
+  if (vertex->slewAnnotated()) {
+    VertexId vertex_id = id(vertex);
+    for (size_t i = 0; i < slew_tables_.size(); i++) {
+      if (!delaysShared(i / slew_rf_count_))
+        timing->slew_tables_[i]->setValue(vertex_id, 0,
+                                          slew_tables_[i]->value(vertex_id, 0));
+    }
+  }
+  if (have_arc_delays_ && !arc_delay_annotated_.empty()) {
+    VertexOutEdgeIterator edge_iter(vertex, this);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      ArcId arc_id = edge->arcDelays();
+      size_t begin = arc_id * ap_count_;
+      size_t end = begin + edge->timingArcSet()->arcCount() * ap_count_;
+      if (arc_delay_annotated_.anySet(begin, end)) {
+        for (const TimingArc *arc : edge->timingArcSet()->arcs()) {
+          for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
+            if (!delaysShared(ap_index)
+                && arcDelayAnnotated(edge, arc, ap_index))
+              timing->arc_delays_[ap_index]->setValue(arc_id, arc->index(),
+                                                      arcDelay(edge, arc, ap_index));
+          }
+        }
+      }
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////
 
-const Slew &
+Slew
 Graph::slew(const Vertex *vertex,
 	    const RiseFall *rf,
 	    DcalcAPIndex ap_index)
@@ -678,12 +1218,10 @@ Graph::slew(const Vertex *vertex,
       (slew_rf_count_ == 1) ? ap_index : ap_index*slew_rf_count_+rf->index();
     DelayTable *table = slew_tables_[table_index];
     VertexId vertex_id = id(vertex);
-    return table->ref(vertex_id);
-  }
-  else {
-    static Slew slew(0.0);
-    return slew;
+    return table->value(vertex_id, 0);
   }
+  else
+    return 0.0;
 }
 
 void
@@ -697,8 +1235,10 @@ Graph::setSlew(Vertex *vertex,
       (slew_rf_count_ == 1) ? ap_index : ap_index*slew_rf_count_+rf->index();
     DelayTable *table = slew_tables_[table_index];
     VertexId vertex_id = id(vertex);
-    Slew &vertex_slew = table->ref(vertex_id);
-    vertex_slew = slew;
+    if (delay_table_aps_[ap_index] == ap_index)
+      table->setValue(vertex_id, 0, slew);
+    else if (!table->valueEqual(vertex_id, 0, slew))
+      delaysMismatch(ap_index);
   }
 }
 
@@ -722,9 +1262,20 @@ Graph::makeEdge(Vertex *from,
 		TimingArcSet *arc_set)
 {
   Edge *edge = edges_->make();
-  edge->init(id(from), id(to), arc_set);
+  linkEdge(edge, from, to, arc_set);
   makeEdgeArcDelays(edge);
   arc_count_ += arc_set->arcCount();
+  graphEdited();
+  return edge;
+}
+
+void
+Graph::linkEdge(Edge *edge,
+                Vertex *from,
+                Vertex *to,
+                TimingArcSet *arc_set)
+{
+  edge->init(id(from), id(to), arc_set);
   // Add out edge to from vertex.
   EdgeId next = from->out_edges_;
   edge->vertex_out_next_ = next;
@@ -737,8 +1288,41 @@ Graph::makeEdge(Vertex *from,
   // Add in edge to to vertex.
   edge->vertex_in_link_ = to->in_edges_;
   to->in_edges_ = edge_id;
+}
 
-  return edge;
+void
+Graph::graphEdited()
+{
+  adjacencySnapshotInvalid();
+  edit_count_++;
+}
+
+void
+Graph::makeAdjacencySnapshot()
+{
+  VertexId id_bound = vertexIdBound();
+  adjacency_in_offsets_.resize(id_bound + 1);
+  adjacency_out_offsets_.resize(id_bound + 1);
+  adjacency_in_edges_.clear();
+  adjacency_out_edges_.clear();
+  adjacency_in_edges_.reserve(edges_->size());
+  adjacency_out_edges_.reserve(edges_->size());
+  // Keep the edge link order so iteration order does not change.
+  for (VertexId vertex_id = 0; vertex_id < id_bound; vertex_id++) {
+    adjacency_in_offsets_[vertex_id] = adjacency_in_edges_.size();
+    adjacency_out_offsets_[vertex_id] = adjacency_out_edges_.size();
+    Vertex *vertex = vertices_->pointer(vertex_id);
+    // Deleted vertices have no edges.
+    if (vertex) {
+      for (EdgeId i = vertex->in_edges_; i; i = edge(i)->vertex_in_link_)
+        adjacency_in_edges_.push_back(edge(i));
+      for (EdgeId i = vertex->out_edges_; i; i = edge(i)->vertex_out_next_)
+        adjacency_out_edges_.push_back(edge(i));
+    }
+  }
+  adjacency_in_offsets_[id_bound] = adjacency_in_edges_.size();
+  adjacency_out_offsets_[id_bound] = adjacency_out_edges_.size();
+  adjacency_valid_ = true;
 }
 
 void
@@ -758,7 +1342,7 @@ Graph::makeArcDelayTables(DcalcAPIndex ap_count)
   if (have_arc_delays_) {
     arc_delays_.resize(ap_count);
     for (DcalcAPIndex i = 0; i < ap_count; i++) {
-      DelayTable *table = new DelayTable();
+      DelayTable *table = new DelayTable(delaysMeansOnly());
       arc_delays_[i] = table;
     }
   }
@@ -767,9 +1351,152 @@ Graph::makeArcDelayTables(DcalcAPIndex ap_count)
 void
 Graph::deleteArcDelayTables()
 {
-  arc_delays_.deleteContentsClear();
+  for (size_t i = 0; i < arc_delays_.size(); i++) {
+    if (!delaysShared(i))
+      delete arc_delays_[i];
+  }
+  arc_delays_.clear();
+}
+
+////////////////////////////////////////////////////////////////
+
+// Every analysis point owns its tables.
+void
+Graph::makeDelayTableAps(DcalcAPIndex ap_count)
+{
+  delay_table_aps_.resize(ap_count);
+  for (DcalcAPIndex i = 0; i < ap_count; i++)
+    delay_table_aps_[i] = i;
+  delays_unshared_.assign(ap_count, false);
+  delete [] delay_mismatches_;
+  delay_mismatches_ = new std::atomic<bool>[ap_count];
+  for (DcalcAPIndex i = 0; i < ap_count; i++)
+    delay_mismatches_[i] = false;
+  delays_mismatched_ = false;
+}
+
+void
+Graph::shareDelays(const std::vector<DcalcAPIndex> &table_aps)
+{
+  for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
+    DcalcAPIndex table_ap = table_aps[ap_index];
+    if (table_ap != ap_index
+        && !delays_unshared_[ap_index]
+        && !delays_unshared_[table_ap]
+        && delay_table_aps_[ap_index] == ap_index
+        && delay_table_aps_[table_ap] == table_ap) {
+      for (int rf_index = 0; rf_index < slew_rf_count_; rf_index++) {
+        int table_index = ap_index * slew_rf_count_ + rf_index;
+        delete slew_tables_[table_index];
+        slew_tables_[table_index] = slew_tables_[table_ap * slew_rf_count_
+                                                 + rf_index];
+      }
+      if (have_arc_delays_) {
+        delete arc_delays_[ap_index];
+        arc_delays_[ap_index] = arc_delays_[table_ap];
+      }
+      delay_table_aps_[ap_index] = table_ap;
+    }
+  }
+}
+
+bool
+Graph::delaysShared(DcalcAPIndex ap_index) const
+{
+  return delay_table_aps_[ap_index] != ap_index;
+}
+
+void
+Graph::delaysMismatch(DcalcAPIndex ap_index)
+{
+  if (!delay_mismatches_[ap_index].load(std::memory_order_relaxed)) {
+    delay_mismatches_[ap_index] = true;
+    delays_mismatched_ = true;
+  }
+}
+
+bool
+Graph::sharedDelaysMismatched() const
+{
+  return delays_mismatched_;
+}
+
+void
+Graph::unshareMismatchedDelays()
+{
+  for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
+    if (delay_mismatches_[ap_index]) {
+      debugPrint(debug_, "graph", 1, "unshare delays ap %d", ap_index);
+      unshareDelays(ap_index);
+      delay_mismatches_[ap_index] = false;
+    }
+  }
+  delays_mismatched_ = false;
+}
+
+void
+Graph::unshareDelays()
+{
+  for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
+    unshareDelays(ap_index);
+    delay_mismatches_[ap_index] = false;
+  }
+  delays_mismatched_ = false;
+}
+
+void
+Graph::unshareDelays(DcalcAPIndex ap_index)
+{
+  DcalcAPIndex table_ap = delay_table_aps_[ap_index];
+  if (table_ap != ap_index) {
+    // Copies keep the arc delay ids of the shared tables.
+    for (int rf_index = 0; rf_index < slew_rf_count_; rf_index++) {
+      int table_index = ap_index * slew_rf_count_ + rf_index;
+      DelayTable *table = new DelayTable(delaysMeansOnly());
+      table->copy(*slew_tables_[table_index]);
+      slew_tables_[table_index] = table;
+    }
+    if (have_arc_delays_) {
+      DelayTable *table = new DelayTable(delaysMeansOnly());
+      table->copy(*arc_delays_[ap_index]);
+      arc_delays_[ap_index] = table;
+    }
+    delay_table_aps_[ap_index] = ap_index;
+  }
+  delays_unshared_[ap_index] = true;
+}
+
+bool
+Graph::delaysMeansOnly() const
+{
+#if SSTA
+  return !pocv_enabled_;
+#else
+  return false;
+#endif
 }
 
+void
+Graph::pocvEnabledChanged()
+{
+  DelayTable *table = nullptr;
+  if (!slew_tables_.empty())
+    table = slew_tables_[0];
+  else if (!arc_delays_.empty())
+    table = arc_delays_[0];
+  if (table && table->meansOnly() != delaysMeansOnly()) {
+    // Discard any existing delays.
+    deleteSlewTables();
+    deleteArcDelayTables();
+    makeDelayTableAps(ap_count_);
+    makeSlewTables(ap_count_);
+    makeArcDelayTables(ap_count_);
+    removeDelays();
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
 void
 Graph::makeEdgeArcDelays(Edge *edge)
 {
@@ -777,11 +1504,12 @@ Graph::makeEdgeArcDelays(Edge *edge)
     int arc_count = edge->timingArcSet()->arcCount();
     ArcId arc_id = 0;
     for (DcalcAPIndex i = 0; i < ap_count_; i++) {
+      // Shared tables have the same ids as the tables of other
+      // analysis points.
+      if (delaysShared(i))
+        continue;
       DelayTable *table = arc_delays_[i];
-      ArcDelay *arc_delays;
-      table->make(arc_count, arc_delays, arc_id);
-      for (int j = 0; j < arc_count; j++)
-	arc_delays[j] = 0.0;
+      table->make(arc_count, arc_id);
     }
     edge->setArcDelays(arc_id);
     // Make sure there is room for delay_annotated flags.
@@ -801,9 +1529,7 @@ Graph::arcDelay(const Edge *edge,
 {
   if (have_arc_delays_) {
     DelayTable *table = arc_delays_[ap_index];
-    ArcDelay *arc_delays = table->pointer(edge->arcDelays());
-    ArcDelay &arc_delay = arc_delays[arc->index()];
-    return arc_delay;
+    return table->value(edge->arcDelays(), arc->index());
   }
   else
     return delay_zero;
@@ -817,20 +1543,21 @@ Graph::setArcDelay(Edge *edge,
 {
   if (have_arc_delays_) {
     DelayTable *table = arc_delays_[ap_index];
-    ArcDelay *arc_delays = table->pointer(edge->arcDelays());
-    arc_delays[arc->index()] = delay;
+    if (delay_table_aps_[ap_index] == ap_index)
+      table->setValue(edge->arcDelays(), arc->index(), delay);
+    else if (!table->valueEqual(edge->arcDelays(), arc->index(), delay))
+      delaysMismatch(ap_index);
   }
 }
 
-const ArcDelay &
+ArcDelay
 Graph::wireArcDelay(const Edge *edge,
 		    const RiseFall *rf,
 		    DcalcAPIndex ap_index)
 {
   if (have_arc_delays_) {
     DelayTable *table = arc_delays_[ap_index];
-    ArcDelay *arc_delays = table->pointer(edge->arcDelays());
-    return arc_delays[rf->index()];
+    return table->value(edge->arcDelays(), rf->index());
   }
   else
     return delay_zero;
@@ -844,8 +1571,10 @@ Graph::setWireArcDelay(Edge *edge,
 {
   if (have_arc_delays_) {
     DelayTable *table = arc_delays_[ap_index];
-    ArcDelay *arc_delays = table->pointer(edge->arcDelays());
-    arc_delays[rf->index()] = delay;
+    if (delay_table_aps_[ap_index] == ap_index)
+      table->setValue(edge->arcDelays(), rf->index(), delay);
+    else if (!table->valueEqual(edge->arcDelays(), rf->index(), delay))
+      delaysMismatch(ap_index);
   }
 }
 
@@ -858,7 +1587,7 @@ Graph::arcDelayAnnotated(const Edge *edge,
     size_t index = (edge->arcDelays() + arc->index()) * ap_count_ + ap_index;
     if (index >= arc_delay_annotated_.size())
       report_->critical(1080, "arc_delay_annotated array bounds exceeded");
-    return arc_delay_annotated_[index];
+    return arc_delay_annotated_.bit(index);
   }
   else
     return false;
@@ -873,7 +1602,7 @@ Graph::setArcDelayAnnotated(Edge *edge,
   size_t index = (edge->arcDelays() + arc->index()) * ap_count_ + ap_index;
   if (index >= arc_delay_annotated_.size())
     report_->critical(1081, "arc_delay_annotated array bounds exceeded");
-  arc_delay_annotated_[index] = annotated;
+  arc_delay_annotated_.setBit(index, annotated);
 }
 
 bool
@@ -885,7 +1614,7 @@ Graph::wireDelayAnnotated(Edge *edge,
     + ap_index;
   if (index >= arc_delay_annotated_.size())
     report_->critical(1082, "arc_delay_annotated array bounds exceeded");
-  return arc_delay_annotated_[index];
+  return arc_delay_annotated_.bit(index);
 }
 
 void
@@ -898,7 +1627,7 @@ Graph::setWireDelayAnnotated(Edge *edge,
     + ap_index;
   if (index >= arc_delay_annotated_.size())
     report_->critical(1083, "arc_delay_annotated array bounds exceeded");
-  arc_delay_annotated_[index] = annotated;
+  arc_delay_annotated_.setBit(index, annotated);
 }
 
 // This only gets called if the analysis type changes from single
@@ -911,6 +1640,7 @@ Graph::setDelayCount(DcalcAPIndex ap_count)
     deleteSlewTables();
     deleteArcDelayTables();
     removePeriodCheckAnnotations();
+    makeDelayTableAps(ap_count);
     makeSlewTables(ap_count);
     makeArcDelayTables(ap_count);
     ap_count_ = ap_count;
@@ -934,29 +1664,29 @@ Graph::removeDelays()
   }
 }
 
+// The annotated flags of an edge are contiguous:
+// [arcDelays * ap_count, (arcDelays + arc_count) * ap_count).
 void
 Graph::removeDelayAnnotated(Edge *edge)
 {
   edge->setDelayAnnotationIsIncremental(false);
-  TimingArcSet *arc_set = edge->timingArcSet();
-  for (TimingArc *arc : arc_set->arcs()) {
-    for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
-      setArcDelayAnnotated(edge, arc, ap_index, false);
-    }
-  }
+  size_t begin = edge->arcDelays() * ap_count_;
+  size_t end = begin + edge->timingArcSet()->arcCount() * ap_count_;
+  if (end > arc_delay_annotated_.size())
+    report_->critical(1691, "arc_delay_annotated array bounds exceeded");
+  arc_delay_annotated_.clearRange(begin, end);
 }
 
 bool
 Graph::delayAnnotated(Edge *edge)
 {
-  TimingArcSet *arc_set = edge->timingArcSet();
-  for (TimingArc *arc : arc_set->arcs()) {
-    for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
-      if (!arcDelayAnnotated(edge, arc, ap_index))
-	return false;
-    }
-  }
-  return true;
+  if (arc_delay_annotated_.empty())
+    return false;
+  size_t begin = edge->arcDelays() * ap_count_;
+  size_t end = begin + edge->timingArcSet()->arcCount() * ap_count_;
+  if (end > arc_delay_annotated_.size())
+    report_->critical(1690, "arc_delay_annotated array bounds exceeded");
+  return arc_delay_annotated_.allSet(begin, end);
 }
 
 void
@@ -965,7 +1695,7 @@ Graph::makeSlewTables(DcalcAPIndex ap_count)
   DcalcAPIndex tr_ap_count = slew_rf_count_ * ap_count;
   slew_tables_.resize(tr_ap_count);
   for (DcalcAPIndex i = 0; i < tr_ap_count; i++) {
-    DelayTable *table = new DelayTable;
+    DelayTable *table = new DelayTable(delaysMeansOnly());
     slew_tables_[i] = table;
   }
 }
@@ -973,7 +1703,11 @@ Graph::makeSlewTables(DcalcAPIndex ap_count)
 void
 Graph::deleteSlewTables()
 {
-  slew_tables_.deleteContentsClear();
+  for (size_t i = 0; i < slew_tables_.size(); i++) {
+    if (!delaysShared(i / slew_rf_count_))
+      delete slew_tables_[i];
+  }
+  slew_tables_.clear();
 }
 
 void
@@ -981,10 +1715,11 @@ Graph::makeVertexSlews(Vertex *vertex)
 {
   DcalcAPIndex tr_ap_count = slew_rf_count_ * ap_count_;
   for (DcalcAPIndex i = 0; i < tr_ap_count; i++) {
+    if (delaysShared(i / slew_rf_count_))
+      continue;
     DelayTable *table = slew_tables_[i];
     // Slews are 1:1 with vertices and use the same object id.
-    Slew *slew = table->ensureId(vertices_->objectId(vertex));
-    *slew = 0.0;
+    table->makeZero(vertices_->objectId(vertex));
   }
 }
 
@@ -1066,6 +1801,42 @@ Graph::removePeriodCheckAnnotations()
   }
 }
 
+void
+Graph::memoryStats(MemoryStats &stats) const
+{
+  stats.add("graph", "vertices", vertices_->size(), vertices_->bytes());
+  stats.add("graph", "edges", edges_->size(), edges_->bytes());
+  size_t slew_count = 0;
+  size_t slew_bytes = 0;
+  // Shared tables are counted once.
+  for (size_t i = 0; i < slew_tables_.size(); i++) {
+    if (!delaysShared(i / slew_rf_count_)) {
+      slew_count += slew_tables_[i]->size();
+      slew_bytes += slew_tables_[i]->bytes();
+    }
+  }
+  stats.add("graph", "slews", slew_count, slew_bytes);
+  size_t delay_count = 0;
+  size_t delay_bytes = 0;
+  for (size_t i = 0; i < arc_delays_.size(); i++) {
+    if (!delaysShared(i)) {
+      delay_count += arc_delays_[i]->size();
+      delay_bytes += arc_delays_[i]->bytes();
+    }
+  }
+  stats.add("graph", "arc delays", delay_count,
+            delay_bytes + arc_delay_annotated_.bytes());
+  stats.add("graph", "arrivals", arrivals_.size(), arrivals_.bytes());
+  stats.add("graph", "requireds", requireds_.size(), requireds_.bytes());
+  stats.add("graph", "prev paths", prev_paths_.size(), prev_paths_.bytes());
+  stats.add("graph", "adjacency",
+            adjacency_in_edges_.size() + adjacency_out_edges_.size(),
+            (adjacency_in_offsets_.capacity() + adjacency_out_offsets_.capacity())
+            * sizeof(uint32_t)
+            + (adjacency_in_edges_.capacity() + adjacency_out_edges_.capacity())
+            * sizeof(Edge*));
+}
+
 void
 Graph::removeDelaySlewAnnotations()
 {
@@ -1090,7 +1861,8 @@ Graph::removeDelaySlewAnnotations()
 
 Vertex::Vertex()
 {
-  init(nullptr, false, false);
+  // The block arrays are initialized when the vertex is made.
+  initFields(nullptr, false, false);
   object_idx_ = object_idx_null;
 }
 
@@ -1098,16 +1870,27 @@ void
 Vertex::init(Pin *pin,
 	     bool is_bidirect_drvr,
 	     bool is_reg_clk)
+{
+  initFields(pin, is_bidirect_drvr, is_reg_clk);
+  ObjectTableHot<Vertex> &hot_fields = hot();
+  hot_fields.level_[object_idx_] = 0;
+  hot_fields.arrivals_[object_idx_] = arrival_null;
+  hot_fields.tag_group_index_[object_idx_] = tag_group_index_max;
+  hot_fields.bfs_in_queue_[object_idx_] = 0;
+}
+
+void
+Vertex::initFields(Pin *pin,
+                   bool is_bidirect_drvr,
+                   bool is_reg_clk)
 {
   pin_ = pin;
   is_reg_clk_ = is_reg_clk;
   is_bidirect_drvr_ = is_bidirect_drvr;
   in_edges_ = edge_id_null;
   out_edges_ = edge_id_null;
-  arrivals_ = arrival_null;
   requireds_ = arrival_null;
   prev_paths_ = prev_path_null;
-  tag_group_index_ = tag_group_index_max;
   slew_annotated_ = false;
   sim_value_ = unsigned(LogicValue::unknown);
   is_disabled_constraint_ = false;
@@ -1117,8 +1900,6 @@ Vertex::init(Pin *pin,
   is_constrained_ = false;
   has_downstream_clk_pin_ = false;
   color_ = unsigned(LevelColor::white);
-  level_ = 0;
-  bfs_in_queue_ = 0;
   crpr_path_pruning_disabled_ = false;
   requireds_pruned_ = false;
 }
@@ -1162,7 +1943,7 @@ Vertex::isDriver(const Network *network) const
 void
 Vertex::setLevel(Level level)
 {
-  level_ = level;
+  hot().level_[object_idx_] = level;
 }
 
 void
@@ -1219,22 +2000,16 @@ Vertex::setRequiredsPruned(bool pruned)
   requireds_pruned_ = pruned;
 }
 
-TagGroupIndex
-Vertex::tagGroupIndex() const
-{
-  return tag_group_index_;
-}
-
 void
 Vertex::setTagGroupIndex(TagGroupIndex tag_index)
 {
-  tag_group_index_ = tag_index;
+  hot().tag_group_index_[object_idx_] = tag_index;
 }
 
 void
 Vertex::setArrivals(ArrivalId id)
 {
-  arrivals_ = id;
+  hot().arrivals_[object_idx_] = id;
 }
 
 void
@@ -1252,10 +2027,11 @@ Vertex::setPrevPaths(PrevPathId prev_paths)
 void
 Vertex::deletePaths()
 {
-  arrivals_ = arrival_null;
+  ObjectTableHot<Vertex> &hot_fields = hot();
+  hot_fields.arrivals_[object_idx_] = arrival_null;
   requireds_ = arrival_null;
   prev_paths_ = prev_path_null;
-  tag_group_index_ = tag_group_index_max;
+  hot_fields.tag_group_index_[object_idx_] = tag_group_index_max;
   crpr_path_pruning_disabled_ = false;
 }
 
@@ -1327,20 +2103,15 @@ Vertex::setHasDownstreamClkPin(bool has_clk_pin)
   has_downstream_clk_pin_ = has_clk_pin;
 }
 
-bool
-Vertex::bfsInQueue(BfsIndex index) const
-{
-  return (bfs_in_queue_ >> unsigned(index)) & 1;
-}
-
 void
 Vertex::setBfsInQueue(BfsIndex index,
 		      bool value)
 {
+  unsigned char &in_queue = hot().bfs_in_queue_[object_idx_];
   if (value)
-    bfs_in_queue_ |= 1 << int(index);
+    in_queue |= 1 << int(index);
   else
-    bfs_in_queue_ &= ~(1 << int(index));
+    in_queue &= ~(1 << int(index));
 }
 
 ////////////////////////////////////////////////////////////////
@@ -1560,39 +2331,73 @@ VertexIterator::findNext()
 
 VertexInEdgeIterator::VertexInEdgeIterator(Vertex *vertex,
 					   const Graph *graph) :
-  next_(graph->edge(vertex->in_edges_)),
   graph_(graph)
 {
+  init(vertex);
 }
 
 VertexInEdgeIterator::VertexInEdgeIterator(VertexId vertex_id,
 					   const Graph *graph) :
-  next_(graph->edge(graph->vertex(vertex_id)->in_edges_)),
   graph_(graph)
 {
+  init(graph->vertex(vertex_id));
+}
+
+void
+VertexInEdgeIterator::init(Vertex *vertex)
+{
+  if (graph_->adjacency_valid_) {
+    VertexId vertex_id = graph_->id(vertex);
+    snapshot_next_ = graph_->adjacency_in_edges_.data()
+      + graph_->adjacency_in_offsets_[vertex_id];
+    snapshot_end_ = graph_->adjacency_in_edges_.data()
+      + graph_->adjacency_in_offsets_[vertex_id + 1];
+    next_ = (snapshot_next_ == snapshot_end_) ? nullptr : *snapshot_next_++;
+  }
+  else {
+    next_ = graph_->edge(vertex->in_edges_);
+    snapshot_next_ = nullptr;
+    snapshot_end_ = nullptr;
+  }
 }
 
 Edge *
 VertexInEdgeIterator::next()
 {
   Edge *next = next_;
-  if (next_)
+  if (snapshot_end_)
+    next_ = (snapshot_next_ == snapshot_end_) ? nullptr : *snapshot_next_++;
+  else if (next_)
     next_ = graph_->edge(next_->vertex_in_link_);
   return next;
 }
 
 VertexOutEdgeIterator::VertexOutEdgeIterator(Vertex *vertex,
 					     const Graph *graph) :
-  next_(graph->edge(vertex->out_edges_)),
   graph_(graph)
 {
+  if (graph->adjacency_valid_) {
+    VertexId vertex_id = graph->id(vertex);
+    snapshot_next_ = graph->adjacency_out_edges_.data()
+      + graph->adjacency_out_offsets_[vertex_id];
+    snapshot_end_ = graph->adjacency_out_edges_.data()
+      + graph->adjacency_out_offsets_[vertex_id + 1];
+    next_ = (snapshot_next_ == snapshot_end_) ? nullptr : *snapshot_next_++;
+  }
+  else {
+    next_ = graph->edge(vertex->out_edges_);
+    snapshot_next_ = nullptr;
+    snapshot_end_ = nullptr;
+  }
 }
 
 Edge *
 VertexOutEdgeIterator::next()
 {
   Edge *next = next_;
-  if (next_)
+  if (snapshot_end_)
+    next_ = (snapshot_next_ == snapshot_end_) ? nullptr : *snapshot_next_++;
+  else if (next_)
     next_ = graph_->edge(next_->vertex_out_next_);
   return next;
 }
@@ -1663,4 +2468,104 @@ VertexSet::VertexSet(Graph *&graph) :
 {
 }
 
+VertexIdHash::VertexIdHash(Graph *&graph) :
+  graph_(graph)
+{
+}
+
+size_t
+VertexIdHash::operator()(const Vertex *vertex) const
+{
+  return graph_->id(vertex);
+}
+
+VertexUnorderedSet::VertexUnorderedSet(Graph *&graph) :
+  UnorderedSet<Vertex*, VertexIdHash>(0, VertexIdHash(graph),
+                                      std::equal_to<Vertex*>())
+{
+}
+
+////////////////////////////////////////////////////////////////
+
+DelayTable::DelayTable(bool means_only) :
+  means_only_(means_only)
+{
+}
+
+void
+DelayTable::make(uint32_t count,
+                 ObjectId &id)
+{
+#if SSTA
+  if (means_only_) {
+    float *means;
+    means_.make(count, means, id);
+    for (uint32_t i = 0; i < count; i++)
+      means[i] = 0.0;
+    return;
+  }
+#endif
+  DelayStore *delays;
+  delays_.make(count, delays, id);
+  for (uint32_t i = 0; i < count; i++)
+    delays[i] = 0.0;
+}
+
+void
+DelayTable::makeZero(ObjectId id)
+{
+#if SSTA
+  if (means_only_) {
+    *means_.ensureId(id) = 0.0;
+    return;
+  }
+#endif
+  *delays_.ensureId(id) = 0.0;
+}
+
+bool
+DelayTable::valueEqual(ObjectId id,
+                       int index,
+                       const Delay &delay) const
+{
+#if SSTA
+  if (means_only_)
+    return means_.pointer(id)[index] == delay.mean();
+#endif
+  return delayEqual(delays_.pointer(id)[index], DelayStore(delay));
+}
+
+size_t
+DelayTable::size() const
+{
+#if SSTA
+  if (means_only_)
+    return means_.size();
+#endif
+  return delays_.size();
+}
+
+size_t
+DelayTable::bytes() const
+{
+#if SSTA
+  return delays_.bytes() + means_.bytes();
+#else
+  return delays_.bytes();
+#endif
+}
+
+void
+DelayTable::copy(const DelayTable &table)
+{
+  means_only_ = table.means_only_;
+#if SSTA
+  if (means_only_) {
+    means_.copy(table.means_);
+    return;
+  }
+#endif
+  delays_.copy(table.delays_);
+}
+
 } // namespace
@@ -114,8 +114,33 @@ protected:
   vector<Slew> load_slews_;
 };
 
+// Arguments for one gate delay in a batch of gate delays for
+// the arcs of one driver pin at one or more delay calc analysis points.
+class ArcDcalcBatchArg
+{
+public:
+  ArcDcalcBatchArg(const TimingArc *arc,
+                   const Slew in_slew,
+                   float load_cap,
+                   const Parasitic *parasitic,
+                   const DcalcAnalysisPt *dcalc_ap);
+  const TimingArc *arc() const { return arc_; }
+  Slew inSlew() const { return in_slew_; }
+  float loadCap() const { return load_cap_; }
+  const Parasitic *parasitic() const { return parasitic_; }
+  const DcalcAnalysisPt *dcalcAnalysisPt() const { return dcalc_ap_; }
+
+protected:
+  const TimingArc *arc_;
+  Slew in_slew_;
+  float load_cap_;
+  const Parasitic *parasitic_;
+  const DcalcAnalysisPt *dcalc_ap_;
+};
+
 typedef vector<ArcDcalcArg> ArcDcalcArgSeq;
 typedef vector<ArcDcalcResult> ArcDcalcResultSeq;
+typedef vector<ArcDcalcBatchArg> ArcDcalcBatchArgSeq;
 
 // Delay calculator class hierarchy.
 //  ArcDelayCalc
@@ -188,6 +213,14 @@ public:
                                        float load_cap,
                                        const LoadPinIndexMap &load_pin_index_map,
                                        const DcalcAnalysisPt *dcalc_ap) = 0;
+  // Find the delays and slews for a batch of arcs driving drvr_pin
+  // at one or more delay calc analysis points (one result per arg).
+  // Calculators can override this to share work across the batch.
+  // Parasitics in args must stay valid until finishDrvrPin().
+  // The default calls gateDelay for each arg.
+  virtual ArcDcalcResultSeq gateDelayBatch(const Pin *drvr_pin,
+                                           const ArcDcalcBatchArgSeq &args,
+                                           const LoadPinIndexMap &load_pin_index_map);
 
   // Find the delay for a timing check arc given the arc's
   // from/clock, to/data slews and related output pin parasitic.
@@ -216,6 +249,11 @@ public:
                                   const DcalcAnalysisPt *dcalc_ap,
                                   int digits) = 0;
   virtual void finishDrvrPin() = 0;
+  // Called before and after GraphDelayCalc finds the delays of every
+  // driver (not incremental) so calculators can prepare the parasitics
+  // of all drivers up front. The defaults do nothing.
+  virtual void findDelaysBegin();
+  virtual void findDelaysEnd();
 };
 
 } // namespace
@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include <algorithm> // copy
 #include <cstring> // memcpy
+#include <new>
+#include <utility> // swap
 #include <vector>
 
+#include "StaConfig.hh"  // STA_ARRAY_TABLE_BITS
 #include "ObjectId.hh"
+#include "TableBlockPool.hh"
 #include "Error.hh"
 
 namespace sta {
@@ -31,8 +36,10 @@ class ArrayBlock;
 // reference the array. Paging performance is improved by allocating
 // blocks instead of individual arrays, and object sizes are reduced
 // by using 32 bit references instead of 64 bit pointers.
-// They are similar to ObjectTables but do not support delete/destroy or
-// reclaiming deleted arrays.
+// Array sizes are rounded up to size classes and destroyed arrays are
+// kept on a free list per size class for reuse by arrays of nearby
+// sizes. Blocks are only deleted by clear, so owners that delete many
+// arrays re-pack the live arrays into a new table and swap it in.
 
 template <class TYPE>
 class ArrayTable
@@ -49,10 +56,25 @@ public:
   TYPE *ensureId(ObjectId id);
   TYPE *pointer(ObjectId id) const;
   TYPE &ref(ObjectId id) const;
+  // Objects in live arrays.
   size_t size() const { return size_; }
+  // Objects in the allocated blocks.
+  size_t capacity() const { return capacity_; }
+  // Bytes of the allocated blocks.
+  size_t bytes() const;
   void clear();
+  void swap(ArrayTable<TYPE> &table);
+  // Replace the contents with a copy of table.
+  // Array ids of table are valid in the copy.
+  void copy(const ArrayTable<TYPE> &table);
+  // Array size rounded up to its size class.
+  static uint32_t sizeClass(uint32_t count);
 
+#ifdef STA_ARRAY_TABLE_BITS
+  static constexpr int idx_bits = STA_ARRAY_TABLE_BITS;
+#else
   static constexpr int idx_bits = 7;
+#endif
   static constexpr int block_size = (1 << idx_bits);
   static constexpr int block_id_max = 1 << (object_id_bits - idx_bits);
 
@@ -62,6 +84,7 @@ private:
   void deleteBlocks();
 
   size_t size_;
+  size_t capacity_;
   // Block index of free block (blocks_[size - 1]).
   BlockIdx free_block_idx_;
   // Index of next free object in free_block_idx_.
@@ -71,7 +94,7 @@ private:
   size_t blocks_capacity_;
   ArrayBlock<TYPE>* *blocks_;
   ArrayBlock<TYPE>* *prev_blocks_;
-  // Linked list of free arrays indexed by array size.
+  // Linked list of free arrays indexed by size class.
   std::vector<ObjectId> free_list_;
   static constexpr ObjectId idx_mask_ = block_size - 1;
 };
@@ -79,6 +102,7 @@ private:
 template <class TYPE>
 ArrayTable<TYPE>::ArrayTable() :
   size_(0),
+  capacity_(0),
   free_block_idx_(block_idx_null),
   free_idx_(object_idx_null),
   blocks_size_(0),
@@ -96,6 +120,16 @@ ArrayTable<TYPE>::~ArrayTable()
   delete [] prev_blocks_;
 }
 
+template <class TYPE>
+size_t
+ArrayTable<TYPE>::bytes() const
+{
+  size_t bytes = blocks_capacity_ * sizeof(ArrayBlock<TYPE>*);
+  for (size_t i = 0; i < blocks_size_; i++)
+    bytes += sizeof(ArrayBlock<TYPE>) + blocks_[i]->size() * sizeof(TYPE);
+  return bytes;
+}
+
 template <class TYPE>
 void
 ArrayTable<TYPE>::deleteBlocks()
@@ -104,22 +138,41 @@ ArrayTable<TYPE>::deleteBlocks()
     delete blocks_[i];
 }
 
+// Sizes up to 8 are exact. Larger sizes are split into 4 classes
+// between powers of 2, so rounding wastes at most 1/4 of an array.
+template <class TYPE>
+uint32_t
+ArrayTable<TYPE>::sizeClass(uint32_t count)
+{
+  if (count <= 8)
+    return count;
+  else {
+    uint32_t power2 = 8;
+    while (power2 * 2 < count)
+      power2 *= 2;
+    uint32_t step = power2 / 4;
+    return (count + step - 1) / step * step;
+  }
+}
+
 template <class TYPE>
 void
 ArrayTable<TYPE>::make(uint32_t count,
 		       TYPE *&array,
 		       ObjectId &id)
 {
-  // Check the free list for a previously destroyed array with the right size.
-  if (count < free_list_.size()
-      && free_list_[count] != object_id_null) {
-    id = free_list_[count];
+  uint32_t size_class = sizeClass(count);
+  // Check the free list for a previously destroyed array in the size class.
+  if (size_class < free_list_.size()
+      && free_list_[size_class] != object_id_null) {
+    id = free_list_[size_class];
     array = pointer(id);
 
     ObjectId *head = reinterpret_cast<ObjectId*>(array);
-    free_list_[count] = *head;
+    free_list_[size_class] = *head;
   }
   else {
+    count = size_class;
     ArrayBlock<TYPE> *block = blocks_size_ ? blocks_[free_block_idx_] : nullptr;
     if ((free_idx_ == object_idx_null
          && free_block_idx_ == block_idx_null)
@@ -138,7 +191,7 @@ ArrayTable<TYPE>::make(uint32_t count,
     array = block->pointer(free_idx_);
     free_idx_ += count;
   }
-  size_ += count;
+  size_ += size_class;
 }
 
 template <class TYPE>
@@ -148,6 +201,7 @@ ArrayTable<TYPE>::makeBlock(uint32_t size)
   BlockIdx block_idx = blocks_size_;
   ArrayBlock<TYPE> *block = new ArrayBlock<TYPE>(size);
   pushBlock(block); 
+  capacity_ += size;
   free_block_idx_ = block_idx;
   // ObjectId zero is reserved for object_id_null.
   free_idx_ = (block_idx > 0) ? 0 : 1;
@@ -179,14 +233,15 @@ void
 ArrayTable<TYPE>::destroy(ObjectId id,
                           uint32_t count)
 {
-  if (count >= free_list_.size())
-    free_list_.resize(count + 1);
+  uint32_t size_class = sizeClass(count);
+  if (size_class >= free_list_.size())
+    free_list_.resize(size_class + 1, object_id_null);
   TYPE *array = pointer(id);
   // Prepend id to the free list.
   ObjectId *head = reinterpret_cast<ObjectId*>(array);
-  *head = free_list_[count];
-  free_list_[count] = id;
-  size_ -= count;
+  *head = free_list_[size_class];
+  free_list_[size_class] = id;
+  size_ -= size_class;
 }
 
 template <class TYPE>
@@ -212,6 +267,7 @@ ArrayTable<TYPE>::ensureId(ObjectId id)
   for (BlockIdx i = blocks_size_; i <= blk_idx; i++) {
     ArrayBlock<TYPE> *block = new ArrayBlock<TYPE>(block_size);
     pushBlock(block);
+    capacity_ += block_size;
   }
   return blocks_[blk_idx]->pointer(obj_idx);
 }
@@ -235,11 +291,52 @@ ArrayTable<TYPE>::clear()
   deleteBlocks();
   blocks_size_ = 0;
   size_ = 0;
+  capacity_ = 0;
   free_block_idx_ = block_idx_null;
   free_idx_ = object_idx_null;
   free_list_.clear();
 }
 
+template <class TYPE>
+void
+ArrayTable<TYPE>::swap(ArrayTable<TYPE> &table)
+{
+  std::swap(size_, table.size_);
+  std::swap(capacity_, table.capacity_);
+  std::swap(free_block_idx_, table.free_block_idx_);
+  std::swap(free_idx_, table.free_idx_);
+  std::swap(blocks_size_, table.blocks_size_);
+  std::swap(blocks_capacity_, table.blocks_capacity_);
+  std::swap(blocks_, table.blocks_);
+  std::swap(prev_blocks_, table.prev_blocks_);
+  free_list_.swap(table.free_list_);
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::copy(const ArrayTable<TYPE> &table)
+{
+  clear();
+  if (blocks_capacity_ < table.blocks_capacity_) {
+    delete [] blocks_;
+    blocks_capacity_ = table.blocks_capacity_;
+    blocks_ = new ArrayBlock<TYPE>*[blocks_capacity_];
+  }
+  for (size_t i = 0; i < table.blocks_size_; i++) {
+    ArrayBlock<TYPE> *from = table.blocks_[i];
+    ArrayBlock<TYPE> *block = new ArrayBlock<TYPE>(from->size());
+    std::copy(from->pointer(0), from->pointer(0) + from->size(),
+              block->pointer(0));
+    blocks_[i] = block;
+  }
+  blocks_size_ = table.blocks_size_;
+  size_ = table.size_;
+  capacity_ = table.capacity_;
+  free_block_idx_ = table.free_block_idx_;
+  free_idx_ = table.free_idx_;
+  free_list_ = table.free_list_;
+}
+
 ////////////////////////////////////////////////////////////////
 
 template <class TYPE>
@@ -260,14 +357,18 @@ private:
 template <class TYPE>
 ArrayBlock<TYPE>::ArrayBlock(uint32_t size) :
   size_(size),
-  objects_(new TYPE[size])
+  objects_(static_cast<TYPE*>(tableBlockAlloc(size * sizeof(TYPE))))
 {
+  for (uint32_t i = 0; i < size; i++)
+    new (&objects_[i]) TYPE;
 }
 
 template <class TYPE>
 ArrayBlock<TYPE>::~ArrayBlock()
 {
-  delete [] objects_;
+  for (uint32_t i = 0; i < size_; i++)
+    objects_[i].~TYPE();
+  tableBlockFree(objects_, size_ * sizeof(TYPE));
 }
 
 } // Namespace
@@ -0,0 +1,168 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace sta {
+
+// Dense array of bits that are set and cleared with atomic word
+// operations, so threads can update different bits in the same word
+// without locking. Range queries test a word at a time.
+// resize must not run concurrently with other operations.
+class AtomicBitSet
+{
+public:
+  AtomicBitSet();
+  ~AtomicBitSet();
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  // Grow to size bits. New bits are cleared.
+  void resize(size_t size);
+  bool bit(size_t index) const;
+  void setBit(size_t index,
+              bool value);
+  // Clear bits [begin, end).
+  void clearRange(size_t begin,
+                  size_t end);
+  // True if all bits [begin, end) are set.
+  bool allSet(size_t begin,
+              size_t end) const;
+  // True if any bit in [begin, end) is set.
+  bool anySet(size_t begin,
+              size_t end) const;
+  size_t bytes() const { return word_count_ * sizeof(uint64_t); }
+
+  // Deleted operations
+  AtomicBitSet(const AtomicBitSet &bits) = delete;
+  AtomicBitSet &operator=(const AtomicBitSet &bits) = delete;
+
+private:
+  static uint64_t rangeMask(size_t begin,
+                            size_t end,
+                            size_t word);
+
+  std::atomic<uint64_t> *words_;
+  size_t word_count_;
+  size_t size_;
+};
+
+inline
+AtomicBitSet::AtomicBitSet() :
+  words_(nullptr),
+  word_count_(0),
+  size_(0)
+{
+}
+
+inline
+AtomicBitSet::~AtomicBitSet()
+{
+  delete [] words_;
+}
+
+inline void
+AtomicBitSet::resize(size_t size)
+{
+  size_t word_count = (size + 63) / 64;
+  if (word_count > word_count_) {
+    std::atomic<uint64_t> *words = new std::atomic<uint64_t>[word_count];
+    for (size_t i = 0; i < word_count_; i++)
+      words[i].store(words_[i].load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    for (size_t i = word_count_; i < word_count; i++)
+      words[i].store(0, std::memory_order_relaxed);
+    delete [] words_;
+    words_ = words;
+    word_count_ = word_count;
+  }
+  size_ = size;
+}
+
+inline bool
+AtomicBitSet::bit(size_t index) const
+{
+  uint64_t word = words_[index / 64].load(std::memory_order_relaxed);
+  return (word >> (index % 64)) & 1;
+}
+
+inline void
+AtomicBitSet::setBit(size_t index,
+                     bool value)
+{
+  uint64_t mask = uint64_t(1) << (index % 64);
+  if (value)
+    words_[index / 64].fetch_or(mask, std::memory_order_relaxed);
+  else
+    words_[index / 64].fetch_and(~mask, std::memory_order_relaxed);
+}
+
+// Mask of the bits of word that are in [begin, end).
+inline uint64_t
+AtomicBitSet::rangeMask(size_t begin,
+                        size_t end,
+                        size_t word)
+{
+  size_t word_begin = word * 64;
+  size_t lo = begin > word_begin ? begin - word_begin : 0;
+  size_t hi = end < word_begin + 64 ? end - word_begin : 64;
+  uint64_t hi_mask = (hi == 64) ? ~uint64_t(0) : (uint64_t(1) << hi) - 1;
+  return hi_mask & ~((uint64_t(1) << lo) - 1);
+}
+
+inline void
+AtomicBitSet::clearRange(size_t begin,
+                         size_t end)
+{
+  if (begin < end) {
+    for (size_t word = begin / 64; word <= (end - 1) / 64; word++)
+      words_[word].fetch_and(~rangeMask(begin, end, word),
+                             std::memory_order_relaxed);
+  }
+}
+
+inline bool
+AtomicBitSet::allSet(size_t begin,
+                     size_t end) const
+{
+  if (begin < end) {
+    for (size_t word = begin / 64; word <= (end - 1) / 64; word++) {
+      uint64_t mask = rangeMask(begin, end, word);
+      if ((words_[word].load(std::memory_order_relaxed) & mask) != mask)
+        return false;
+    }
+  }
+  return true;
+}
+
+inline bool
+AtomicBitSet::anySet(size_t begin,
+                     size_t end) const
+{
+  if (begin < end) {
+    for (size_t word = begin / 64; word <= (end - 1) / 64; word++) {
+      if (words_[word].load(std::memory_order_relaxed)
+          & rangeMask(begin, end, word))
+        return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
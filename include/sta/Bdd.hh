@@ -32,12 +32,18 @@ namespace sta {
 
 typedef std::map<const LibertyPort*, DdNode*> BddPortVarMap;
 typedef std::map<unsigned, const LibertyPort*> BddVarIdxPortMap;
+typedef std::map<const FuncExpr*, DdNode*> BddFuncMap;
 
+// Port variables and function BDDs persist in one cudd manager so
+// repeated evaluations of a cell function do not rebuild the BDD.
+// Function BDDs are cached with a reference held by the cache, so the
+// cache can be flushed while callers still hold their own references.
 class Bdd : public StaState
 {
 public:
   Bdd(const StaState *sta);
   ~Bdd();
+  // Referenced BDD for expr. The caller derefs it.
   DdNode *funcBdd(const FuncExpr *expr);
   DdNode *findNode(const LibertyPort *port);
   const LibertyPort *nodePort(DdNode *node);
@@ -45,13 +51,24 @@ public:
   const LibertyPort *varIndexPort(int var_index);
   BddPortVarMap &portVarMap() { return bdd_port_var_map_; }
 
+  // Deref the cached function BDDs.
+  void clearFuncCache();
+  size_t funcCacheSize() const { return func_bdd_map_.size(); }
+  // Deref the port variables and cached function BDDs.
   void clearVarMap();
   DdManager *cuddMgr() const { return cudd_mgr_; }
 
+  // The function cache is flushed before it exceeds either limit.
+  static constexpr size_t func_cache_max = 4096;
+  static constexpr long func_cache_node_max = 1 << 20;
+
 private:
+  DdNode *makeFuncBdd(const FuncExpr *expr);
+
   DdManager *cudd_mgr_;
   BddPortVarMap bdd_port_var_map_;
   BddVarIdxPortMap bdd_var_idx_port_map_;
+  BddFuncMap func_bdd_map_;
 };
 
 } // namespace
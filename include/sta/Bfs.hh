@@ -17,16 +17,21 @@
 #pragma once
 
 #include <mutex>
+#include <vector>
+#include <atomic>
+#include <memory>
 
 #include "Iterator.hh"
 #include "Set.hh"
 #include "GraphClass.hh"
+#include "Graph.hh"
+#include "SearchPred.hh"
 #include "VertexVisitor.hh"
 #include "StaState.hh"
 
 namespace sta {
 
-class SearchPred;
+class TimingProgress;
 class BfsFwdIterator;
 class BfsBkwdIterator;
 
@@ -68,6 +73,12 @@ public:
   void deleteVertexBefore(Vertex *vertex);
   void remove(Vertex *vertex);
   void reportEntries(const Network *network);
+  // Count the visited levels and vertices in progress. With cancelable
+  // the visits stop at the next level when progress has a cancel
+  // request.
+  void setProgress(TimingProgress *progress,
+                   bool cancelable);
+  bool canceled() const;
 
   virtual bool hasNext();
   bool hasNext(Level to_level);
@@ -79,6 +90,11 @@ public:
 		    VertexVisitor *visitor);
   // Apply visitor to all vertices in the queue in level order,
   // using threads to parallelize the visits. visitor must be thread safe.
+  // With bfsDependencyDriven() a vertex is visited as soon as all of
+  // its predecessors in the search cone are visited, so vertices on
+  // different levels are visited concurrently. Finding the cone
+  // walks the full structural fanout (fanin) of the queued vertices,
+  // so it is best suited to full timing updates.
   // Returns the number of vertices that are visited.
   int visitParallel(Level to_level,
 		    VertexVisitor *visitor);
@@ -96,6 +112,24 @@ protected:
   virtual bool levelLessOrEqual(Level level1,
 				Level level2) const = 0;
   virtual void incrLevel(Level &level) = 0;
+  int visitLevelChunks(VertexSeq &level_vertices,
+                       std::vector<VertexVisitor*> &visitors);
+  int visitLevelStealing(VertexSeq &level_vertices,
+                         std::vector<VertexVisitor*> &visitors);
+  void prefetchLevelVertex(const VertexSeq &level_vertices,
+                           size_t index,
+                           size_t end) const;
+  int visitDependent(Level to_level,
+                     std::vector<VertexVisitor*> &visitors);
+  void findDependentCone(Level to_level,
+                         VertexSeq &cone);
+  void ensureDependentCounts();
+  void removeVisitedEntries(Level to_level);
+  // Vertices that cannot be visited until vertex is visited.
+  virtual void findDependents(Vertex *vertex,
+                              Level to_level,
+                              // Return value.
+                              VertexSeq &dependents) = 0;
   void findNext(Level to_level);
   void deleteEntries();
 
@@ -109,6 +143,12 @@ protected:
   Level first_level_;
   // Max (min) level of queued vertices.
   Level last_level_;
+  // Unvisited predecessor count indexed by VertexId for dependency
+  // driven visits. -1 for vertices outside of the search cone.
+  std::unique_ptr<std::atomic<int>[]> dependent_counts_;
+  size_t dependent_counts_size_;
+  TimingProgress *progress_;
+  bool progress_cancelable_;
 
   friend class BfsFwdIterator;
   friend class BfsBkwdIterator;
@@ -124,14 +164,29 @@ public:
   virtual void enqueueAdjacentVertices(Vertex *vertex,
 				       SearchPred *search_pred,
 				       Level to_level);
+  // Enqueue with the predicate calls bound at compile time.
+  template <class PRED>
+  void enqueueAdjacentVertices(Vertex *vertex,
+                               BoundSearchPred<PRED> search_pred,
+                               Level to_level);
+  template <class PRED>
+  void enqueueAdjacentVertices(Vertex *vertex,
+                               BoundSearchPred<PRED> search_pred);
   using BfsIterator::enqueueAdjacentVertices;
 
 protected:
+  template <class PRED>
+  void enqueueAdjacent(Vertex *vertex,
+                       PRED &search_pred,
+                       Level to_level);
   virtual bool levelLessOrEqual(Level level1,
 				Level level2) const;
   virtual bool levelLess(Level level1,
 			 Level level2) const;
   virtual void incrLevel(Level &level);
+  virtual void findDependents(Vertex *vertex,
+                              Level to_level,
+                              VertexSeq &dependents);
 };
 
 class BfsBkwdIterator : public BfsIterator
@@ -144,14 +199,101 @@ public:
   virtual void enqueueAdjacentVertices(Vertex *vertex,
 				       SearchPred *search_pred,
 				       Level to_level);
+  // Enqueue with the predicate calls bound at compile time.
+  template <class PRED>
+  void enqueueAdjacentVertices(Vertex *vertex,
+                               BoundSearchPred<PRED> search_pred,
+                               Level to_level);
+  template <class PRED>
+  void enqueueAdjacentVertices(Vertex *vertex,
+                               BoundSearchPred<PRED> search_pred);
   using BfsIterator::enqueueAdjacentVertices;
 
 protected:
+  template <class PRED>
+  void enqueueAdjacent(Vertex *vertex,
+                       PRED &search_pred,
+                       Level to_level);
   virtual bool levelLessOrEqual(Level level1,
 				Level level2) const;
   virtual bool levelLess(Level level1,
 			 Level level2) const;
   virtual void incrLevel(Level &level);
+  virtual void findDependents(Vertex *vertex,
+                              Level to_level,
+                              VertexSeq &dependents);
 };
 
+template <class PRED>
+void
+BfsFwdIterator::enqueueAdjacentVertices(Vertex *vertex,
+                                        BoundSearchPred<PRED> search_pred,
+                                        Level to_level)
+{
+  enqueueAdjacent(vertex, search_pred, to_level);
+}
+
+template <class PRED>
+void
+BfsFwdIterator::enqueueAdjacentVertices(Vertex *vertex,
+                                        BoundSearchPred<PRED> search_pred)
+{
+  enqueueAdjacent(vertex, search_pred, level_max_);
+}
+
+template <class PRED>
+void
+BfsFwdIterator::enqueueAdjacent(Vertex *vertex,
+                                PRED &search_pred,
+                                Level to_level)
+{
+  if (search_pred.searchFrom(vertex)) {
+    VertexOutEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *to_vertex = edge->to(graph_);
+      if (to_vertex->level() <= to_level
+          && search_pred.searchThru(edge)
+          && search_pred.searchTo(to_vertex))
+        enqueue(to_vertex);
+    }
+  }
+}
+
+template <class PRED>
+void
+BfsBkwdIterator::enqueueAdjacentVertices(Vertex *vertex,
+                                         BoundSearchPred<PRED> search_pred,
+                                         Level to_level)
+{
+  enqueueAdjacent(vertex, search_pred, to_level);
+}
+
+template <class PRED>
+void
+BfsBkwdIterator::enqueueAdjacentVertices(Vertex *vertex,
+                                         BoundSearchPred<PRED> search_pred)
+{
+  enqueueAdjacent(vertex, search_pred, level_max_);
+}
+
+template <class PRED>
+void
+BfsBkwdIterator::enqueueAdjacent(Vertex *vertex,
+                                 PRED &search_pred,
+                                 Level to_level)
+{
+  if (search_pred.searchTo(vertex)) {
+    VertexInEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *from_vertex = edge->from(graph_);
+      if (from_vertex->level() >= to_level
+          && search_pred.searchFrom(from_vertex)
+          && search_pred.searchThru(edge))
+        enqueue(from_vertex);
+    }
+  }
+}
+
 } // namespace
@@ -0,0 +1,58 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdarg>
+#include <functional>
+#include <string>
+
+namespace sta {
+
+// Formatted text buffer for the file writers.
+// The text is passed to the write function in blocks of about
+// flush_size bytes to avoid a stream call per print.
+// Without a write function the text is only buffered, so writers on
+// other threads can format blocks for the caller to write in order.
+class BufferedWriter
+{
+public:
+  typedef std::function<void (const std::string &text)> WriteFunc;
+
+  BufferedWriter();
+  explicit BufferedWriter(WriteFunc write);
+  void setWriteFunc(WriteFunc write);
+  void print(const char *fmt,
+             ...) __attribute__((format (printf, 2, 3)));
+  void vprint(const char *fmt,
+              va_list args);
+  void append(const std::string &text);
+  // Pass the buffered text to the write function and clear it.
+  void flush();
+  // Buffered text for writers without a write function.
+  std::string &text() { return text_; }
+  void clear() { text_.clear(); }
+
+  static constexpr size_t flush_size = 1 << 20;
+
+private:
+  void flushIfFull();
+
+  WriteFunc write_;
+  std::string text_;
+};
+
+} // namespace
@@ -0,0 +1,45 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+
+#include "NetworkClass.hh"
+#include "StaState.hh"
+
+namespace sta {
+
+// Leaf/top level pins and nets of the netlist in hierarchy order
+// and a checksum of their names and ids for binary cache files that
+// refer to them by network object ids.
+class CacheNetlist : public StaState
+{
+public:
+  CacheNetlist(StaState *sta);
+  const PinSeq &pins() const { return pins_; }
+  const NetSeq &nets() const { return nets_; }
+  uint64_t checksum() const { return checksum_; }
+
+private:
+  void findObjects(const Instance *inst);
+
+  PinSeq pins_;
+  NetSeq nets_;
+  size_t checksum_;
+};
+
+} // namespace
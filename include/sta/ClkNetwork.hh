@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "Map.hh"
 #include "Set.hh"
 #include "StaState.hh"
@@ -25,10 +29,17 @@
 
 namespace sta {
 
-typedef Map<const Pin*, ClockSet> PinClksMap;
+// Index of an interned clock set. Zero is the empty set.
+typedef uint32_t ClkSetId;
+// Bit per clock index.
+typedef std::vector<uint64_t> ClkBits;
+typedef std::vector<ClkSetId> ClkSetIdSeq;
+typedef Map<ClkBits, ClkSetId> ClkBitsSetIdMap;
+typedef Map<std::pair<ClkSetId, int>, ClkSetId> ClkSetAddMap;
 typedef Map<const Clock *, PinSet*> ClkPinsMap;
 
 class Sta;
+class SearchPred;
 
 // Find clock network pins.
 // This is not as reliable as Search::isClock but is much cheaper.
@@ -60,13 +71,34 @@ protected:
 private:
   void findClkPins();
   void findClkPins(bool ideal_only,
-		   PinClksMap &clk_pin_map);
+		   ClkSetIdSeq &pin_clk_sets);
+  ClkSetId pinClkSet(const ClkSetIdSeq &pin_clk_sets,
+                     const Pin *pin) const;
+  void setPinClkSet(ClkSetIdSeq &pin_clk_sets,
+                    const Pin *pin,
+                    ClkSetId clk_set);
+  // Intern the set of clocks with bits.
+  ClkSetId findClkSet(const ClkBits &bits);
+  ClkSetId addClk(ClkSetId clk_set,
+                  const Clock *clk);
+  ClkSetId unionClkSets(ClkSetId clk_set1,
+                        ClkSetId clk_set2);
+  void findFaninClks(Vertex *vertex,
+                     SearchPred *pred);
+  void addPinClks(const Pin *pin,
+                  ClkSetId clk_set);
 
   bool clk_pins_valid_;
-  // pin -> clks
-  PinClksMap pin_clks_map_;
-  // pin -> ideal clks
-  PinClksMap pin_ideal_clks_map_;
+  // Clock sets [ClkSetId].
+  std::vector<ClkBits> clk_set_bits_;
+  std::vector<ClockSet*> clk_sets_;
+  ClkBitsSetIdMap clk_bits_set_ids_;
+  // (clock set, clock index) -> clock set with the clock added.
+  ClkSetAddMap clk_set_adds_;
+  // Clock sets of pins [network vertex id].
+  ClkSetIdSeq pin_clk_sets_;
+  // Ideal clock sets of pins [network vertex id].
+  ClkSetIdSeq pin_ideal_clk_sets_;
   // clock -> pins
   ClkPinsMap clk_pins_map_;
 };
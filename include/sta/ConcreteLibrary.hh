@@ -31,6 +31,7 @@ namespace sta {
 
 class ConcreteLibrary;
 class ConcreteCell;
+class ConcreteCellLoader;
 class ConcretePort;
 class ConcreteCellPortBitIterator;
 class PatternMatch;
@@ -65,6 +66,12 @@ public:
   ConcreteLibraryCellIterator *cellIterator() const;
   ConcreteCell *findCell(const char *name) const;
   CellSeq findCellsMatching(const PatternMatch *pattern) const;
+  // Make cells on demand when they are first found.
+  // The library owns the loader.
+  void setCellLoader(ConcreteCellLoader *loader);
+  // Make the cells that have not been loaded yet.
+  void loadCells() const;
+  void loadCellsMatching(const PatternMatch *pattern) const;
   char busBrktLeft() const { return bus_brkt_left_; }
   char busBrktRight() const { return bus_brkt_right_; }
   void setBusBrkts(char left,
@@ -81,11 +88,24 @@ protected:
   char bus_brkt_left_;
   char bus_brkt_right_;
   ConcreteCellMap cell_map_;
+  ConcreteCellLoader *cell_loader_;
 
 private:
   friend class ConcreteCell;
 };
 
+// Library readers that defer making cells until they are referenced.
+class ConcreteCellLoader
+{
+public:
+  virtual ~ConcreteCellLoader() {}
+  // Return nullptr if the library does not have a deferred cell
+  // named name.
+  virtual ConcreteCell *loadCell(const char *name) = 0;
+  virtual void loadCellsMatching(const PatternMatch *pattern) = 0;
+  virtual void loadCells() = 0;
+};
+
 class ConcreteCell
 {
 public:
@@ -109,6 +129,7 @@ public:
   void setAttribute(const string &key,
                     const string &value);
   string getAttribute(const string &key) const;
+  const AttributeMap &attributeMap() const { return attribute_map_; }
 
   // Cell acts as port factory.
   ConcretePort *makePort(const char *name);
@@ -17,12 +17,16 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
 #include "Map.hh"
 #include "Set.hh"
+#include "UnorderedMap.hh"
+#include "UnorderedSet.hh"
 #include "StringUtil.hh"
 #include "Network.hh"
 #include "LibertyClass.hh"
+#include "ObjectPool.hh"
 
 namespace  sta {
 
@@ -41,9 +45,18 @@ typedef Vector<ConcreteLibrary*> ConcreteLibrarySeq;
 typedef Map<string, string> AttributeMap;
 typedef Map<const char*, ConcreteLibrary*, CharPtrLess> ConcreteLibraryMap;
 typedef ConcreteLibrarySeq::ConstIterator ConcreteLibraryIterator;
-typedef Map<const char *, ConcreteInstance*,
-	    CharPtrLess> ConcreteInstanceChildMap;
-typedef Map<const char *, ConcreteNet*, CharPtrLess> ConcreteInstanceNetMap;
+typedef UnorderedMap<const char *, ConcreteInstance*,
+		     CharPtrHash, CharPtrEqual> ConcreteInstanceChildMap;
+typedef UnorderedMap<const char *, ConcreteNet*,
+		     CharPtrHash, CharPtrEqual> ConcreteInstanceNetMap;
+typedef UnorderedSet<const char *, CharPtrHash, CharPtrEqual> ConcreteNameSet;
+// Name sorted children/nets used to iterate over them in name order
+// and to find the matches of glob patterns with a literal prefix
+// without testing every name.
+typedef Vector<std::pair<const char *, ConcreteInstance*>> ConcreteInstanceChildIndex;
+typedef Vector<std::pair<const char *, ConcreteNet*>> ConcreteInstanceNetIndex;
+typedef std::shared_ptr<ConcreteInstanceChildIndex> ConcreteInstanceChildIndexPtr;
+typedef std::shared_ptr<ConcreteInstanceNetIndex> ConcreteInstanceNetIndexPtr;
 typedef Vector<ConcreteNet*> ConcreteNetSeq;
 typedef Vector<ConcretePin*> ConcretePinSeq;
 typedef Map<Cell*, Instance*> CellNetworkViewMap;
@@ -51,6 +64,37 @@ typedef Set<const ConcreteNet*> ConcreteNetSet;
 
 // This adapter implements the network api for the concrete network.
 // A superset of the Network api methods are implemented in the interface.
+// Interned instance and net names.
+// Names are packed into large blocks instead of being allocated one
+// at a time, and a name used by many objects (the local names of
+// every instance of a hierarchical module) is stored once.
+// Names are only freed when the pool is cleared.
+class ConcreteNamePool
+{
+public:
+  ConcreteNamePool();
+  ~ConcreteNamePool();
+  // Return the pool copy of name.
+  const char *intern(const char *name);
+  void clear();
+  size_t size() const { return names_.size(); }
+  // Bytes of the name blocks.
+  size_t bytes() const { return bytes_; }
+
+  // Deleted operations
+  ConcreteNamePool(const ConcreteNamePool &pool) = delete;
+  ConcreteNamePool &operator=(const ConcreteNamePool &pool) = delete;
+
+private:
+  char *makeName(size_t length);
+
+  ConcreteNameSet names_;
+  Vector<char*> blocks_;
+  char *block_next_;
+  size_t block_free_;
+  size_t bytes_;
+};
+
 class ConcreteNetwork : public NetworkReader
 {
 public:
@@ -61,6 +105,7 @@ public:
                    bool make_black_boxes,
                    Report *report) override;
   Instance *topInstance() const override;
+  void memoryStats(MemoryStats &stats) const override;
 
   const char *name(const Library *library) const override;
   ObjectId id(const Library *library) const override;
@@ -119,6 +164,10 @@ public:
   bool isLeaf(const Instance *instance) const override;
   Instance *findChild(const Instance *parent,
                       const char *name) const override;
+  void findChildrenMatching(const Instance *parent,
+                            const PatternMatch *pattern,
+                            // Return value.
+                            InstanceSeq &matches) const override;
   Pin *findPin(const Instance *instance,
                const char *port_name) const override;
   Pin *findPin(const Instance *instance,
@@ -229,6 +278,11 @@ public:
   Pin *makePin(Instance *inst,
                Port *port,
                Net *net) override;
+  // The instance and pin objects are made by the dispatch_queue threads
+  // and then linked into parent and the nets in defs order.
+  void makeLeafInstances(LeafInstanceDefSeq &defs,
+                         Instance *parent,
+                         DispatchQueue *dispatch_queue) override;
 
   // Instance is the network view for cell.
   void setCellNetworkView(Cell *cell,
@@ -239,10 +293,27 @@ public:
   void readNetlistBefore() override;
   void setLinkFunc(LinkNetworkFunc *link) override;
   static ObjectId nextObjectId();
+  // Reserve count consecutive object ids and return the first one.
+  static ObjectId reserveObjectIds(ObjectId count);
+
+  // Attributes and constant nets for netlist writers.
+  const AttributeMap &attributeMap(const Cell *cell) const;
+  const AttributeMap &attributeMap(const Instance *inst) const;
+  const NetSet &constantNets(LogicValue value) const;
 
   // Used by external tools.
   void setTopInstance(Instance *top_inst);
   void deleteTopInstance();
+  // All of the top instance children are leaf instances.
+  // Connected pins of flat netlists are found without the
+  // hierarchical net traversal.
+  bool isFlat() const { return is_flat_; }
+  PinConnectedPinIterator *connectedPinIterator(const Pin *pin) const override;
+  void visitConnectedPins(const Pin *pin,
+                          PinVisitor &visitor) const override;
+  NetConnectedPinIterator *connectedPinIterator(const Net *net) const override;
+  void visitConnectedPins(const Net *net,
+                          PinVisitor &visitor) const override;
 
   using Network::netIterator;
   using Network::findPin;
@@ -260,13 +331,31 @@ protected:
   void visitConnectedPins(const Net *net,
                           PinVisitor &visitor,
                           NetSet &visited_nets) const override;
+  void visitFlatConnectedPins(const ConcreteNet *net,
+                              PinVisitor &visitor) const;
+  void findIsFlat();
   Instance *makeConcreteInstance(ConcreteCell *cell,
 				 const char *name,
 				 Instance *parent);
+  // Make the instance and pins of def with ids starting at id
+  // without linking them into the parent or nets.
+  // name is the interned instance name.
+  void makeLeafInstance(LeafInstanceDef &def,
+                        const char *name,
+                        ConcreteInstance *parent,
+                        ObjectId id);
   void disconnectNetPin(ConcreteNet *cnet,
 			ConcretePin *cpin);
   void connectNetPin(ConcreteNet *cnet,
 		     ConcretePin *cpin);
+  void instanceMemoryStats(const ConcreteInstance *inst,
+                           // Return values.
+                           size_t &inst_count,
+                           size_t &inst_bytes,
+                           size_t &pin_count,
+                           size_t &term_count,
+                           size_t &net_count,
+                           size_t &net_bytes) const;
 
   // Cell lookup search order sequence.
   ConcreteLibrarySeq library_seq_;
@@ -275,6 +364,9 @@ protected:
   NetSet constant_nets_[2];  // LogicValue::zero/one
   LinkNetworkFunc *link_func_;
   CellNetworkViewMap cell_network_view_map_;
+  bool is_flat_;
+  // Instance and net names.
+  ConcreteNamePool name_pool_;
   static ObjectId object_id_;
 
 private:
@@ -295,10 +387,13 @@ public:
                         NetSeq &matches) const;
   InstanceNetIterator *netIterator() const;
   Instance *findChild(const char *name) const;
+  void findChildrenMatching(const PatternMatch *pattern,
+                            InstanceSeq &matches) const;
   InstanceChildIterator *childIterator() const;
   void setAttribute(const string &key,
                     const string &value);
   string getAttribute(const string &key) const;
+  const AttributeMap &attributeMap() const { return attribute_map_; }
   void addChild(ConcreteInstance *child);
   void deleteChild(ConcreteInstance *child);
   void addPin(ConcretePin *pin);
@@ -311,11 +406,21 @@ public:
   void initPins();
 
 protected:
+  ConcreteInstanceChildIndexPtr childIndex() const;
+  ConcreteInstanceNetIndexPtr netIndex() const;
+  void deleteChildIndex();
+  void deleteNetIndex();
+
   ConcreteInstance(const char *name,
 		   ConcreteCell *cell,
                    ConcreteInstance *parent);
+  ConcreteInstance(const char *name,
+		   ConcreteCell *cell,
+                   ConcreteInstance *parent,
+                   ObjectId id);
   ~ConcreteInstance();
 
+  // Owned by the network name pool.
   const char *name_;
   ObjectId id_;
   ConcreteCell *cell_;
@@ -324,6 +429,10 @@ protected:
   ConcretePinSeq pins_;
   ConcreteInstanceChildMap *children_;
   ConcreteInstanceNetMap *nets_;
+  // Built by the first iterator or prefix pattern match, released by
+  // edits. Iterators share them so edits during an iteration are safe.
+  mutable ConcreteInstanceChildIndexPtr child_index_;
+  mutable ConcreteInstanceNetIndexPtr net_index_;
   AttributeMap attribute_map_;
 
 private:
@@ -342,12 +451,19 @@ public:
   ObjectId id() const { return id_; }
   VertexId vertexId() const { return vertex_id_; }
   void setVertexId(VertexId id);
+  static void *operator new(size_t size) { return objectPoolAlloc(size); }
+  static void operator delete(void *pin,
+                              size_t size) { objectPoolFree(pin, size); }
 
 protected:
   ~ConcretePin() {}
   ConcretePin(ConcreteInstance *instance,
 	      ConcretePort *port,
 	      ConcreteNet *net);
+  ConcretePin(ConcreteInstance *instance,
+	      ConcretePort *port,
+	      ConcreteNet *net,
+              ObjectId id);
 
   ConcreteInstance *instance_;
   ConcretePort *port_;
@@ -363,6 +479,7 @@ private:
   friend class ConcreteNetwork;
   friend class ConcreteNet;
   friend class ConcreteNetPinIterator;
+  friend class ConcreteFlatConnectedPinIterator;
 };
 
 class ConcreteTerm
@@ -388,6 +505,7 @@ private:
   friend class ConcreteNetwork;
   friend class ConcreteNet;
   friend class ConcreteNetTermIterator;
+  friend class ConcreteFlatConnectedPinIterator;
 };
 
 class ConcreteNet
@@ -407,6 +525,7 @@ protected:
   ConcreteNet(const char *name,
 	      ConcreteInstance *instance);
   ~ConcreteNet();
+  // Owned by the network name pool.
   const char *name_;
   ObjectId id_;
   ConcreteInstance *instance_;
@@ -421,6 +540,7 @@ protected:
   friend class ConcreteNetwork;
   friend class ConcreteNetTermIterator;
   friend class ConcreteNetPinIterator;
+  friend class ConcreteFlatConnectedPinIterator;
 };
 
 } // namespace
@@ -0,0 +1,288 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sta {
+
+// Open addressed (linear probing) hash set of object pointers for
+// interning objects that are found far more often than they are made.
+// findKey is lock free and safe while another thread inserts.
+// Inserts must be serialized by the caller.
+// erase, clear and deleteContentsClear are not thread safe.
+// Tables replaced by growing the set are kept until the next
+// erase/clear so that concurrent readers never see freed memory.
+template <class KEY, class HASH, class EQUAL>
+class ConcurrentHashSet
+{
+public:
+  explicit ConcurrentHashSet(size_t capacity);
+  ~ConcurrentHashSet();
+  KEY *findKey(const KEY *key) const;
+  // Caller serializes inserts.
+  void insert(KEY *key);
+  void erase(const KEY *key);
+  void reserve(size_t capacity);
+  void clear();
+  void deleteContentsClear();
+  size_t size() const { return size_; }
+  size_t capacity() const;
+  // Longest run of probes to find a key (hash quality diagnostic).
+  size_t maxProbeLength() const;
+
+private:
+  class Table
+  {
+  public:
+    explicit Table(size_t capacity);
+    ~Table();
+    size_t capacity_;
+    size_t mask_;
+    std::atomic<KEY*> *keys_;
+  };
+
+  void insert(Table *table,
+              KEY *key);
+  size_t home(const KEY *key,
+              const Table *table) const;
+  void grow(size_t capacity);
+  void deleteRetired();
+
+  std::atomic<Table*> table_;
+  std::vector<Table*> retired_;
+  size_t size_;
+  HASH hash_;
+  EQUAL equal_;
+};
+
+template <class KEY, class HASH, class EQUAL>
+ConcurrentHashSet<KEY, HASH, EQUAL>::Table::Table(size_t capacity) :
+  capacity_(capacity),
+  mask_(capacity - 1),
+  keys_(new std::atomic<KEY*>[capacity])
+{
+  for (size_t i = 0; i < capacity; i++)
+    keys_[i].store(nullptr, std::memory_order_relaxed);
+}
+
+template <class KEY, class HASH, class EQUAL>
+ConcurrentHashSet<KEY, HASH, EQUAL>::Table::~Table()
+{
+  delete [] keys_;
+}
+
+// Power of 2 table capacity at least twice the key capacity.
+static inline size_t
+concurrentHashSetCapacity(size_t key_capacity)
+{
+  size_t capacity = 16;
+  while (capacity < key_capacity * 2)
+    capacity *= 2;
+  return capacity;
+}
+
+template <class KEY, class HASH, class EQUAL>
+ConcurrentHashSet<KEY, HASH, EQUAL>::ConcurrentHashSet(size_t capacity) :
+  table_(new Table(concurrentHashSetCapacity(capacity))),
+  size_(0)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+ConcurrentHashSet<KEY, HASH, EQUAL>::~ConcurrentHashSet()
+{
+  deleteRetired();
+  delete table_.load();
+}
+
+template <class KEY, class HASH, class EQUAL>
+KEY *
+ConcurrentHashSet<KEY, HASH, EQUAL>::findKey(const KEY *key) const
+{
+  Table *table = table_.load(std::memory_order_acquire);
+  size_t i = home(key, table);
+  for (;;) {
+    KEY *key1 = table->keys_[i].load(std::memory_order_acquire);
+    if (key1 == nullptr)
+      return nullptr;
+    if (equal_(key1, key))
+      return key1;
+    i = (i + 1) & table->mask_;
+  }
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::insert(KEY *key)
+{
+  Table *table = table_.load(std::memory_order_relaxed);
+  // Keep the load factor at or below 1/2.
+  if ((size_ + 1) * 2 > table->capacity_) {
+    grow(table->capacity_ * 2);
+    table = table_.load(std::memory_order_relaxed);
+  }
+  insert(table, key);
+  size_++;
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::insert(Table *table,
+                                            KEY *key)
+{
+  size_t i = home(key, table);
+  while (table->keys_[i].load(std::memory_order_relaxed))
+    i = (i + 1) & table->mask_;
+  // Release so readers see the key contents before the key.
+  table->keys_[i].store(key, std::memory_order_release);
+}
+
+// Mix the hash bits so the low bits used to index the table depend
+// on all of them (murmur3 finalizer).
+template <class KEY, class HASH, class EQUAL>
+size_t
+ConcurrentHashSet<KEY, HASH, EQUAL>::home(const KEY *key,
+                                          const Table *table) const
+{
+  uint64_t hash = hash_(key);
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return static_cast<size_t>(hash) & table->mask_;
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::reserve(size_t capacity)
+{
+  size_t table_capacity = concurrentHashSetCapacity(capacity);
+  if (table_capacity > table_.load(std::memory_order_relaxed)->capacity_)
+    grow(table_capacity);
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::grow(size_t capacity)
+{
+  Table *table = table_.load(std::memory_order_relaxed);
+  Table *new_table = new Table(capacity);
+  for (size_t i = 0; i < table->capacity_; i++) {
+    KEY *key = table->keys_[i].load(std::memory_order_relaxed);
+    if (key)
+      insert(new_table, key);
+  }
+  table_.store(new_table, std::memory_order_release);
+  retired_.push_back(table);
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::erase(const KEY *key)
+{
+  deleteRetired();
+  Table *table = table_.load(std::memory_order_relaxed);
+  size_t mask = table->mask_;
+  size_t i = home(key, table);
+  for (;;) {
+    KEY *key1 = table->keys_[i].load(std::memory_order_relaxed);
+    if (key1 == nullptr)
+      return;
+    if (key1 == key)
+      break;
+    i = (i + 1) & mask;
+  }
+  // Shift following keys in the probe run back into the hole.
+  size_t hole = i;
+  size_t j = i;
+  for (;;) {
+    j = (j + 1) & mask;
+    KEY *key1 = table->keys_[j].load(std::memory_order_relaxed);
+    if (key1 == nullptr)
+      break;
+    size_t home1 = home(key1, table);
+    // Move key1 if its home is not cyclically in (hole, j].
+    bool in_range = (hole <= j)
+      ? (hole < home1 && home1 <= j)
+      : (hole < home1 || home1 <= j);
+    if (!in_range) {
+      table->keys_[hole].store(key1, std::memory_order_relaxed);
+      hole = j;
+    }
+  }
+  table->keys_[hole].store(nullptr, std::memory_order_relaxed);
+  size_--;
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::clear()
+{
+  deleteRetired();
+  Table *table = table_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < table->capacity_; i++)
+    table->keys_[i].store(nullptr, std::memory_order_relaxed);
+  size_ = 0;
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::deleteContentsClear()
+{
+  Table *table = table_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < table->capacity_; i++)
+    delete table->keys_[i].load(std::memory_order_relaxed);
+  clear();
+}
+
+template <class KEY, class HASH, class EQUAL>
+void
+ConcurrentHashSet<KEY, HASH, EQUAL>::deleteRetired()
+{
+  for (Table *table : retired_)
+    delete table;
+  retired_.clear();
+}
+
+template <class KEY, class HASH, class EQUAL>
+size_t
+ConcurrentHashSet<KEY, HASH, EQUAL>::capacity() const
+{
+  return table_.load(std::memory_order_relaxed)->capacity_;
+}
+
+template <class KEY, class HASH, class EQUAL>
+size_t
+ConcurrentHashSet<KEY, HASH, EQUAL>::maxProbeLength() const
+{
+  Table *table = table_.load(std::memory_order_relaxed);
+  size_t max_length = 0;
+  for (size_t i = 0; i < table->capacity_; i++) {
+    KEY *key = table->keys_[i].load(std::memory_order_relaxed);
+    if (key) {
+      size_t length = ((i - home(key, table)) & table->mask_) + 1;
+      if (length > max_length)
+        max_length = length;
+    }
+  }
+  return max_length;
+}
+
+} // namespace
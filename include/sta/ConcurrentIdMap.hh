@@ -0,0 +1,206 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "ObjectId.hh"
+
+namespace sta {
+
+// Map from object id to a pointer stored in blocks of slots allocated
+// on demand. findKey is a lock free load, and insert and erase publish
+// the value with a release store, so readers on other threads see a
+// fully built value. Writers of the same id must be serialized by the
+// caller. visit and clear must not run concurrently with inserts.
+template <class VALUE>
+class ConcurrentIdMap
+{
+public:
+  ConcurrentIdMap();
+  ~ConcurrentIdMap();
+  // Null if id is not in the map.
+  VALUE findKey(ObjectId id) const;
+  void insert(ObjectId id,
+              VALUE value);
+  void erase(ObjectId id) { insert(id, nullptr); }
+  bool empty() const { return size() == 0; }
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+  void clear();
+  // Not thread safe.
+  void swap(ConcurrentIdMap &map);
+  // Call visit(id, value) for each id in the map in increasing id order.
+  template <class VISIT>
+  void visit(VISIT visit) const;
+  size_t bytes() const;
+
+  // Deleted operations
+  ConcurrentIdMap(const ConcurrentIdMap &map) = delete;
+  ConcurrentIdMap &operator=(const ConcurrentIdMap &map) = delete;
+
+private:
+  static constexpr int block_id_bits = 16;
+  static constexpr size_t block_id_count = size_t(1) << block_id_bits;
+  static constexpr size_t block_count =
+    size_t(1) << (object_id_bits - block_id_bits);
+
+  class Block
+  {
+  public:
+    Block();
+    std::atomic<VALUE> values_[block_id_count];
+  };
+
+  Block *ensureBlock(size_t block_index);
+
+  std::atomic<Block*> *blocks_;
+  std::atomic<size_t> size_;
+};
+
+template <class VALUE>
+ConcurrentIdMap<VALUE>::Block::Block()
+{
+  for (size_t i = 0; i < block_id_count; i++)
+    values_[i].store(nullptr, std::memory_order_relaxed);
+}
+
+template <class VALUE>
+ConcurrentIdMap<VALUE>::ConcurrentIdMap() :
+  blocks_(new std::atomic<Block*>[block_count]),
+  size_(0)
+{
+  for (size_t i = 0; i < block_count; i++)
+    blocks_[i].store(nullptr, std::memory_order_relaxed);
+}
+
+template <class VALUE>
+ConcurrentIdMap<VALUE>::~ConcurrentIdMap()
+{
+  for (size_t i = 0; i < block_count; i++)
+    delete blocks_[i].load(std::memory_order_relaxed);
+  delete [] blocks_;
+}
+
+template <class VALUE>
+typename ConcurrentIdMap<VALUE>::Block *
+ConcurrentIdMap<VALUE>::ensureBlock(size_t block_index)
+{
+  Block *block = blocks_[block_index].load(std::memory_order_acquire);
+  if (block == nullptr) {
+    Block *new_block = new Block;
+    if (blocks_[block_index].compare_exchange_strong(block, new_block,
+                                                     std::memory_order_acq_rel))
+      block = new_block;
+    else
+      // Another thread made the block first.
+      delete new_block;
+  }
+  return block;
+}
+
+template <class VALUE>
+VALUE
+ConcurrentIdMap<VALUE>::findKey(ObjectId id) const
+{
+  Block *block = blocks_[id >> block_id_bits].load(std::memory_order_acquire);
+  if (block)
+    return block->values_[id & (block_id_count - 1)].load(std::memory_order_acquire);
+  else
+    return nullptr;
+}
+
+template <class VALUE>
+void
+ConcurrentIdMap<VALUE>::insert(ObjectId id,
+                               VALUE value)
+{
+  Block *block = value
+    ? ensureBlock(id >> block_id_bits)
+    : blocks_[id >> block_id_bits].load(std::memory_order_acquire);
+  if (block) {
+    VALUE prev = block->values_[id & (block_id_count - 1)]
+      .exchange(value, std::memory_order_acq_rel);
+    if (prev == nullptr && value)
+      size_.fetch_add(1, std::memory_order_relaxed);
+    else if (prev && value == nullptr)
+      size_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+template <class VALUE>
+void
+ConcurrentIdMap<VALUE>::clear()
+{
+  if (size() > 0) {
+    for (size_t b = 0; b < block_count; b++) {
+      Block *block = blocks_[b].load(std::memory_order_relaxed);
+      if (block) {
+        for (size_t i = 0; i < block_id_count; i++)
+          block->values_[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    size_.store(0, std::memory_order_relaxed);
+  }
+}
+
+template <class VALUE>
+void
+ConcurrentIdMap<VALUE>::swap(ConcurrentIdMap &map)
+{
+  std::atomic<Block*> *blocks = blocks_;
+  blocks_ = map.blocks_;
+  map.blocks_ = blocks;
+  size_t size = size_.load(std::memory_order_relaxed);
+  size_.store(map.size_.load(std::memory_order_relaxed),
+              std::memory_order_relaxed);
+  map.size_.store(size, std::memory_order_relaxed);
+}
+
+template <class VALUE>
+template <class VISIT>
+void
+ConcurrentIdMap<VALUE>::visit(VISIT visit) const
+{
+  if (size() > 0) {
+    for (size_t b = 0; b < block_count; b++) {
+      Block *block = blocks_[b].load(std::memory_order_acquire);
+      if (block) {
+        ObjectId block_id = ObjectId(b << block_id_bits);
+        for (size_t i = 0; i < block_id_count; i++) {
+          VALUE value = block->values_[i].load(std::memory_order_acquire);
+          if (value)
+            visit(block_id + ObjectId(i), value);
+        }
+      }
+    }
+  }
+}
+
+template <class VALUE>
+size_t
+ConcurrentIdMap<VALUE>::bytes() const
+{
+  size_t bytes = block_count * sizeof(std::atomic<Block*>);
+  for (size_t b = 0; b < block_count; b++) {
+    if (blocks_[b].load(std::memory_order_relaxed))
+      bytes += sizeof(Block);
+  }
+  return bytes;
+}
+
+} // namespace
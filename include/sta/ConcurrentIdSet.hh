@@ -0,0 +1,229 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ObjectId.hh"
+
+namespace sta {
+
+// Set of object ids stored as bits in blocks allocated on demand.
+// insert, erase and hasKey are lock free and safe to call from
+// multiple threads. Each block has a summary bit per word of ids so
+// visit and clear only look at words that have been set, and ids are
+// visited in increasing order.
+// visit and clear must not run concurrently with inserts.
+class ConcurrentIdSet
+{
+public:
+  ConcurrentIdSet();
+  ~ConcurrentIdSet();
+  // Return true if id was not already in the set.
+  bool insert(ObjectId id);
+  void erase(ObjectId id);
+  bool hasKey(ObjectId id) const;
+  bool empty() const { return size() == 0; }
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+  void clear();
+  // Call visit(id) for each id in the set in increasing id order.
+  template <class VISIT>
+  void visit(VISIT visit) const;
+
+  // Deleted operations
+  ConcurrentIdSet(const ConcurrentIdSet &set) = delete;
+  ConcurrentIdSet &operator=(const ConcurrentIdSet &set) = delete;
+
+private:
+  static constexpr int block_id_bits = 20;
+  static constexpr size_t block_id_count = size_t(1) << block_id_bits;
+  static constexpr size_t block_word_count = block_id_count / 64;
+  static constexpr size_t summary_word_count = block_word_count / 64;
+  static constexpr size_t block_count =
+    size_t(1) << (object_id_bits - block_id_bits);
+
+  class Block
+  {
+  public:
+    Block();
+    std::atomic<uint64_t> words_[block_word_count];
+    // Bit i is set if words_[i] may be non-zero.
+    std::atomic<uint64_t> summary_[summary_word_count];
+  };
+
+  Block *ensureBlock(size_t block_index);
+  static int lowestBit(uint64_t bits);
+
+  std::atomic<Block*> *blocks_;
+  std::atomic<size_t> size_;
+};
+
+inline
+ConcurrentIdSet::Block::Block()
+{
+  for (size_t i = 0; i < block_word_count; i++)
+    words_[i].store(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < summary_word_count; i++)
+    summary_[i].store(0, std::memory_order_relaxed);
+}
+
+inline
+ConcurrentIdSet::ConcurrentIdSet() :
+  blocks_(new std::atomic<Block*>[block_count]),
+  size_(0)
+{
+  for (size_t i = 0; i < block_count; i++)
+    blocks_[i].store(nullptr, std::memory_order_relaxed);
+}
+
+inline
+ConcurrentIdSet::~ConcurrentIdSet()
+{
+  for (size_t i = 0; i < block_count; i++)
+    delete blocks_[i].load(std::memory_order_relaxed);
+  delete [] blocks_;
+}
+
+inline ConcurrentIdSet::Block *
+ConcurrentIdSet::ensureBlock(size_t block_index)
+{
+  Block *block = blocks_[block_index].load(std::memory_order_acquire);
+  if (block == nullptr) {
+    Block *new_block = new Block;
+    if (blocks_[block_index].compare_exchange_strong(block, new_block,
+                                                     std::memory_order_acq_rel))
+      block = new_block;
+    else
+      // Another thread made the block first.
+      delete new_block;
+  }
+  return block;
+}
+
+inline bool
+ConcurrentIdSet::insert(ObjectId id)
+{
+  Block *block = ensureBlock(id >> block_id_bits);
+  size_t bit = id & (block_id_count - 1);
+  size_t word = bit / 64;
+  uint64_t mask = uint64_t(1) << (bit % 64);
+  uint64_t prev = block->words_[word].fetch_or(mask, std::memory_order_relaxed);
+  if (prev & mask)
+    return false;
+  if (prev == 0)
+    block->summary_[word / 64].fetch_or(uint64_t(1) << (word % 64),
+                                        std::memory_order_relaxed);
+  size_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+inline void
+ConcurrentIdSet::erase(ObjectId id)
+{
+  Block *block = blocks_[id >> block_id_bits].load(std::memory_order_acquire);
+  if (block) {
+    size_t bit = id & (block_id_count - 1);
+    uint64_t mask = uint64_t(1) << (bit % 64);
+    // The summary bit is left set; visit skips zero words.
+    uint64_t prev = block->words_[bit / 64].fetch_and(~mask,
+                                                      std::memory_order_relaxed);
+    if (prev & mask)
+      size_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+inline bool
+ConcurrentIdSet::hasKey(ObjectId id) const
+{
+  Block *block = blocks_[id >> block_id_bits].load(std::memory_order_acquire);
+  if (block) {
+    size_t bit = id & (block_id_count - 1);
+    uint64_t mask = uint64_t(1) << (bit % 64);
+    return block->words_[bit / 64].load(std::memory_order_relaxed) & mask;
+  }
+  else
+    return false;
+}
+
+inline void
+ConcurrentIdSet::clear()
+{
+  if (size() > 0) {
+    for (size_t b = 0; b < block_count; b++) {
+      Block *block = blocks_[b].load(std::memory_order_relaxed);
+      if (block) {
+        for (size_t s = 0; s < summary_word_count; s++) {
+          uint64_t summary = block->summary_[s].load(std::memory_order_relaxed);
+          while (summary) {
+            int i = lowestBit(summary);
+            summary &= summary - 1;
+            block->words_[s * 64 + i].store(0, std::memory_order_relaxed);
+          }
+          block->summary_[s].store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+    size_.store(0, std::memory_order_relaxed);
+  }
+}
+
+template <class VISIT>
+void
+ConcurrentIdSet::visit(VISIT visit) const
+{
+  if (size() > 0) {
+    for (size_t b = 0; b < block_count; b++) {
+      Block *block = blocks_[b].load(std::memory_order_acquire);
+      if (block) {
+        ObjectId block_id = ObjectId(b << block_id_bits);
+        for (size_t s = 0; s < summary_word_count; s++) {
+          uint64_t summary = block->summary_[s].load(std::memory_order_relaxed);
+          while (summary) {
+            size_t word = s * 64 + lowestBit(summary);
+            summary &= summary - 1;
+            uint64_t bits = block->words_[word].load(std::memory_order_relaxed);
+            while (bits) {
+              int bit = lowestBit(bits);
+              bits &= bits - 1;
+              visit(block_id + ObjectId(word * 64 + bit));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Index of the lowest set bit of a non-zero word.
+inline int
+ConcurrentIdSet::lowestBit(uint64_t bits)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(bits);
+#else
+  int index = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+} // namespace
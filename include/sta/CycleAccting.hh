@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "UnorderedSet.hh"
 #include "MinMax.hh"
 #include "TimingRole.hh"
@@ -54,13 +57,29 @@ public:
   void clear();
   // Find the cycle accounting info for paths that start at src clock
   // edge and end at target clock edge.
+  // Thread safe. Lookups of acctings that have already been found are
+  // lock free.
   CycleAccting *cycleAccting(const ClockEdge *src,
 			     const ClockEdge *tgt);
   void reportClkToClkMaxCycleWarnings(Report *report);
 
 private:
+  typedef std::atomic<CycleAccting*> CycleAcctingRow;
+
+  CycleAccting *findCycleAccting(const ClockEdge *src,
+                                 const ClockEdge *tgt);
+  void setTableAccting(const ClockEdge *src,
+                       const ClockEdge *tgt,
+                       CycleAccting *acct);
+  void deleteTable();
+
   Sdc *sdc_;
   CycleAcctingSet cycle_acctings_;
+  // Table of acctings indexed by src and tgt clock edge index.
+  // Src rows are made when the first accting from the src edge is found.
+  std::atomic<std::atomic<CycleAcctingRow*>*> table_;
+  size_t table_edge_count_;
+  std::mutex lock_;
 };
 
 class CycleAccting
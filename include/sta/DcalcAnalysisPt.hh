@@ -59,7 +59,8 @@ public:
   const MinMax *slewMinMax() const { return min_max_; }
   ParasiticAnalysisPt *parasiticAnalysisPt() const;
   void setCheckClkSlewIndex(DcalcAPIndex index);
-  int libertyIndex() const;
+  // Index of the corner liberty cells, ports and arcs.
+  int libertyIndex() const { return liberty_index_; }
 
 private:
   Corner *corner_;
@@ -68,6 +69,8 @@ private:
   const OperatingConditions *op_cond_;
   const MinMax *min_max_;
   const MinMax *check_clk_slew_min_max_;
+  // Corner::libertyIndex(min_max_)
+  int liberty_index_;
 };
 
 } // namespace
@@ -18,6 +18,7 @@
 
 #include <cstdarg>
 
+#include "StaConfig.hh"  // STA_HOT_DEBUG
 #include "Map.hh"
 #include "StringUtil.hh"
 
@@ -25,6 +26,9 @@ namespace sta {
 
 class Report;
 class Pin;
+class Profiler;
+class SearchStats;
+class Tracer;
 
 typedef Map<const char *, int, CharPtrLess> DebugMap;
 
@@ -36,19 +40,32 @@ public:
   int level(const char *what);
   void setLevel(const char *what,
 		int level);
+  // Inline so probes cost one load when no debugging is enabled.
   bool check(const char *what,
-	     int level) const;
+	     int level) const { return debug_on_ && checkMap(what, level); }
   int statsLevel() const { return stats_level_; }
+  // Profile of the phases timed by Stats.
+  Profiler *profiler() const { return profiler_; }
+  // Search and delay calculation counters.
+  SearchStats *searchStats() const { return search_stats_; }
+  // Per thread timeline of tasks and BFS levels.
+  Tracer *tracer() const { return tracer_; }
   void reportLine(const char *what,
                   const char *fmt,
                   ...) const
     __attribute__((format (printf, 3, 4)));
 
 protected:
+  bool checkMap(const char *what,
+                int level) const;
+
   Report *report_;
   bool debug_on_;
   DebugMap *debug_map_;
   int stats_level_;
+  Profiler *profiler_;
+  SearchStats *search_stats_;
+  Tracer *tracer_;
 };
 
 // Inlining a varargs function would eval the args, which can
@@ -61,4 +78,15 @@ protected:
     debug->reportLine(what, ##__VA_ARGS__); \
   }
 
+// Probes in the search and delay calculation inner loops.
+// These compile out of builds configured with STA_HOT_DEBUG=OFF.
+#ifndef STA_HOT_DEBUG
+#define STA_HOT_DEBUG 1
+#endif
+
+#define debugPrintHot(debug, what, level, ...) \
+  if (STA_HOT_DEBUG && debug->check(what, level)) {  \
+    debug->reportLine(what, ##__VA_ARGS__); \
+  }
+
 } // namespace
@@ -0,0 +1,109 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace sta {
+
+// Half precision (IEEE 754 binary16) delay in picoseconds for graph
+// slew and arc delay storage when STA_COMPACT_DELAYS is set.
+// Values keep 11 significant bits (0.05% relative error) and are
+// limited to +-65504ps; larger magnitudes saturate.
+class DelayHalf
+{
+public:
+  DelayHalf() = default;
+  DelayHalf(float delay) : bits_(toHalf(delay * 1e12F)) {}
+  operator float() const { return toFloat(bits_) * 1e-12F; }
+
+  static uint16_t toHalf(float value);
+  static float toFloat(uint16_t half);
+
+private:
+  uint16_t bits_;
+};
+
+// Round to nearest even.
+inline uint16_t
+DelayHalf::toHalf(float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint16_t sign = (bits >> 16) & 0x8000;
+  uint32_t float_exp = (bits >> 23) & 0xff;
+  uint32_t mant = bits & 0x7fffff;
+  if (float_exp == 0xff)
+    // Inf/NaN
+    return sign | 0x7c00 | (mant ? 0x200 : 0);
+  int exp = static_cast<int>(float_exp) - 127 + 15;
+  if (exp >= 31)
+    return sign | 0x7bff;
+  if (exp <= 0) {
+    // Subnormal or zero.
+    if (exp < -10)
+      return sign;
+    mant |= 0x800000;
+    int shift = 14 - exp;
+    uint32_t half_mant = mant >> shift;
+    uint32_t rem = mant & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (rem > halfway || (rem == halfway && (half_mant & 1)))
+      half_mant++;
+    return sign | half_mant;
+  }
+  uint32_t half = (exp << 10) | (mant >> 13);
+  uint32_t rem = mant & 0x1fff;
+  if (rem > 0x1000 || (rem == 0x1000 && (half & 1)))
+    half++;
+  if (half >= 0x7c00)
+    half = 0x7bff;
+  return sign | half;
+}
+
+inline float
+DelayHalf::toFloat(uint16_t half)
+{
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exp = (half >> 10) & 0x1f;
+  uint32_t mant = half & 0x3ff;
+  uint32_t bits;
+  if (exp == 0) {
+    if (mant == 0)
+      bits = sign;
+    else {
+      // Normalize the subnormal.
+      int exp1 = 1;
+      while ((mant & 0x400) == 0) {
+        mant <<= 1;
+        exp1--;
+      }
+      mant &= 0x3ff;
+      bits = sign | ((exp1 + 127 - 15) << 23) | (mant << 13);
+    }
+  }
+  else if (exp == 31)
+    bits = sign | 0x7f800000 | (mant << 13);
+  else
+    bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // namespace
@@ -9,13 +9,37 @@
 #include <functional>
 #include <vector>
 #include <cstdint>
-#include <queue>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 
 namespace sta {
 
+class Tracer;
+
+// Queue slot with inline storage for the task callable.
+// Callables that do not fit are stored on the heap.
+class DispatchTask
+{
+public:
+  static constexpr size_t storage_size = 128;
+
+  std::atomic<size_t> sequence_;
+  // Call the task and destroy the callable.
+  void (*run_)(void *storage,
+               int thread);
+  alignas(std::max_align_t) char storage_[storage_size];
+};
+
+// Thread pool fed by a bounded lock-free multiple producer/multiple
+// consumer ring of tasks (Dmitry Vyukov's bounded MPMC queue).
+// Dispatching a task does not allocate unless the callable is larger
+// than DispatchTask::storage_size. Idle workers spin briefly before
+// parking on a condition variable.
 class DispatchQueue
 {
   typedef std::function<void(int thread)> fp_t;
@@ -24,11 +48,23 @@ public:
   DispatchQueue(size_t thread_cnt);
   ~DispatchQueue();
   void setThreadCount(size_t thread_count);
+  size_t threadCount() const { return threads_.size(); }
   // Dispatch and copy.
   void dispatch(const fp_t& op);
   // Dispatch and move.
   void dispatch(fp_t&& op);
+  // Dispatch any callable taking the thread index without
+  // converting it to a std::function.
+  template <class FUNC>
+  void dispatch(FUNC &&op);
   void finishTasks();
+  // Record task begin/end events per worker when the tracer is enabled.
+  void setTracer(Tracer *tracer);
+  // Bind each worker to a processor. Consecutive workers are spread
+  // over the NUMA nodes in equal contiguous ranges so work split into
+  // contiguous chunks by thread index stays on one node.
+  bool threadPinning() const { return thread_pinning_; }
+  void setThreadPinning(bool enabled);
 
   // Deleted operations
   DispatchQueue(const DispatchQueue& rhs) = delete;
@@ -38,14 +74,108 @@ public:
 
 private:
   void dispatch_thread_handler(size_t i);
+  void startThreads(size_t thread_count);
   void terminateThreads();
+  // Claim a slot for a new task and return its queue position.
+  size_t claimTask();
+  void publishTask(size_t pos);
+  // Run one queued task. Returns false if the queue is empty.
+  bool runTask(int thread);
+  void runTask(DispatchTask &task,
+               int thread);
+  bool empty() const;
+
+  template <class FUNC>
+  static void runInline(void *storage,
+                        int thread);
+  template <class FUNC>
+  static void runHeap(void *storage,
+                      int thread);
+  template <class FUNC, class ARG>
+  static void storeTask(DispatchTask &task,
+                        ARG &&op,
+                        std::true_type fits);
+  template <class FUNC, class ARG>
+  static void storeTask(DispatchTask &task,
+                        ARG &&op,
+                        std::false_type fits);
+
+  static constexpr size_t task_count_ = 1024;
+  static constexpr size_t task_mask_ = task_count_ - 1;
+  // Tries to find a task before parking.
+  static constexpr int spin_count_ = 64;
 
-  std::mutex lock_;
   std::vector<std::thread> threads_;
-  std::queue<fp_t> q_;
-  std::condition_variable cv_;
+  bool thread_pinning_;
+  // Processor of each worker when thread_pinning_.
+  std::vector<int> thread_processors_;
+  DispatchTask *tasks_;
+  // Padding keeps the producer and consumer positions on separate
+  // cache lines.
+  std::atomic<size_t> enqueue_pos_;
+  char enqueue_pad_[64 - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> dequeue_pos_;
+  char dequeue_pad_[64 - sizeof(std::atomic<size_t>)];
   std::atomic<size_t> pending_task_count_;
-  bool quit_ = false;
+  std::atomic<size_t> parked_count_;
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::atomic<bool> quit_;
+  Tracer *tracer_;
 };
 
+template <class FUNC>
+void
+DispatchQueue::dispatch(FUNC &&op)
+{
+  typedef typename std::decay<FUNC>::type Func;
+  typedef std::integral_constant<bool,
+    sizeof(Func) <= DispatchTask::storage_size
+    && alignof(Func) <= alignof(std::max_align_t)> Fits;
+  pending_task_count_++;
+  size_t pos = claimTask();
+  storeTask<Func>(tasks_[pos & task_mask_], std::forward<FUNC>(op), Fits());
+  publishTask(pos);
+}
+
+template <class FUNC, class ARG>
+void
+DispatchQueue::storeTask(DispatchTask &task,
+                         ARG &&op,
+                         std::true_type)
+{
+  new (task.storage_) FUNC(std::forward<ARG>(op));
+  task.run_ = &runInline<FUNC>;
+}
+
+template <class FUNC, class ARG>
+void
+DispatchQueue::storeTask(DispatchTask &task,
+                         ARG &&op,
+                         std::false_type)
+{
+  *reinterpret_cast<FUNC**>(task.storage_) = new FUNC(std::forward<ARG>(op));
+  task.run_ = &runHeap<FUNC>;
+}
+
+template <class FUNC>
+void
+DispatchQueue::runInline(void *storage,
+                         int thread)
+{
+  FUNC *op = reinterpret_cast<FUNC*>(storage);
+  (*op)(thread);
+  op->~FUNC();
+}
+
+template <class FUNC>
+void
+DispatchQueue::runHeap(void *storage,
+                       int thread)
+{
+  FUNC *op = *reinterpret_cast<FUNC**>(storage);
+  (*op)(thread);
+  delete op;
+}
+
 } // namespace
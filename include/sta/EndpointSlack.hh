@@ -0,0 +1,44 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <vector>
+
+#include "Delay.hh"
+#include "GraphClass.hh"
+#include "SearchClass.hh"
+
+namespace sta {
+
+// Worst path end at an endpoint for one path analysis point
+// (corner and min/max).
+class EndpointSlack
+{
+public:
+  Vertex *vertex_;
+  const PathAnalysisPt *path_ap_;
+  Slack slack_;
+  Arrival arrival_;
+  Required required_;
+  // Path group name.
+  const char *group_;
+};
+
+typedef std::vector<EndpointSlack> EndpointSlackSeq;
+
+} // namespace
@@ -23,29 +23,58 @@
 
 namespace sta {
 
+class EquivCellKey;
+
 typedef Map<LibertyCell*, LibertyCellSeq*> EquivCellMap;
 typedef UnorderedMap<unsigned, LibertyCellSeq*> LibertyCellHashMap;
+typedef UnorderedMap<const LibertyCell*, EquivCellKey*> EquivCellKeyMap;
+
+// Cell properties used to order sizing candidates.
+// They are found once when the equivalent cells are made so resizing
+// loops do not look at the liberty cells.
+class EquivCellKey
+{
+public:
+  // Output port drive resistance.
+  float drive_resistance_;
+  // Sum of the input port capacitances.
+  float input_cap_;
+  float leakage_;
+  float area_;
+  // Drive resistance of the corner cells indexed by liberty analysis
+  // point index.
+  Vector<float> corner_drive_resistances_;
+};
 
 class EquivCells
 {
 public:
   // Find equivalent cells in equiv_libs.
   // Optionally add mappings for cells in map_libs.
+  // Sizing keys have corner drive resistances for liberty analysis
+  // point indices less than liberty_ap_count.
   EquivCells(LibertyLibrarySeq *equiv_libs,
-	     LibertyLibrarySeq *map_libs);
+	     LibertyLibrarySeq *map_libs,
+             int liberty_ap_count = 0);
   ~EquivCells();
   // Find equivalents for cell (member of from_libs) in to_libs.
+  // The equivalents are sorted by decreasing drive resistance.
   LibertyCellSeq *equivs(LibertyCell *cell);
+  // Sizing key of a cell with equivalents.
+  const EquivCellKey *key(const LibertyCell *cell) const;
   
 protected:
   void findEquivCells(const LibertyLibrary *library,
 		      LibertyCellHashMap &hash_matches);
   void mapEquivCells(const LibertyLibrary *library,
 		     LibertyCellHashMap &hash_matches);
+  void makeKey(const LibertyCell *cell);
 
   EquivCellMap equiv_cells_;
   // Unique cell for each equiv cell group.
   LibertyCellSeq unique_equiv_cells_;
+  int liberty_ap_count_;
+  EquivCellKeyMap cell_keys_;
 };
 
 // Predicate that is true when the ports, functions, sequentials and
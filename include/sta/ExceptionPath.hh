@@ -20,6 +20,7 @@
 #include "Set.hh"
 #include "SdcCmdComment.hh"
 #include "SdcClass.hh"
+#include "ObjectPool.hh"
 
 namespace sta {
 
@@ -628,6 +629,9 @@ public:
   ExceptionState(ExceptionPath *exception,
 		 ExceptionThru *next_thru,
 		 int index);
+  static void *operator new(size_t size) { return objectPoolAlloc(size); }
+  static void operator delete(void *state,
+                              size_t size) { objectPoolFree(state, size); }
   ExceptionPath *exception() { return exception_; }
   const ExceptionPath *exception() const { return exception_; }
   bool matchesNextThru(const Pin *from_pin,
@@ -16,12 +16,16 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "Set.hh"
 #include "NetworkClass.hh"
 #include "LibertyClass.hh"
 
 namespace sta {
 
+class FuncExprEval;
+
 class FuncExpr
 {
 public:
@@ -38,6 +42,7 @@ public:
 	   FuncExpr *left,
 	   FuncExpr *right,
 	   LibertyPort *port);
+  ~FuncExpr();
   static FuncExpr *makePort(LibertyPort *port);
   static FuncExpr *makeNot(FuncExpr *expr);
   static FuncExpr *makeAnd(FuncExpr *left,
@@ -65,6 +70,9 @@ public:
   // nullptr when op == op_not
   FuncExpr *right() const { return right_; }
   TimingSense portTimingSense(const LibertyPort *port) const;
+  // Compiled evaluator for the expression. Liberty cell functions are
+  // compiled when the cell is read; other expressions on first use.
+  const FuncExprEval *eval() const;
   // Return true if expression has port as an input.
   bool hasPort(const LibertyPort *port) const;
   const char *asString() const;
@@ -76,6 +84,7 @@ public:
   bool checkSize(LibertyPort *port);
 
 private:
+  TimingSense portTimingSenseExpr(const LibertyPort *port) const;
   const char *asString(bool with_parens) const;
   const char *asStringSubexpr(bool with_parens,
 			      char op) const;
@@ -84,6 +93,7 @@ private:
   FuncExpr *left_;
   FuncExpr *right_;
   LibertyPort *port_;
+  mutable std::atomic<FuncExprEval*> eval_;
 };
 
 // Negate an expression.
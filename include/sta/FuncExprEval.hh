@@ -0,0 +1,91 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "NetworkClass.hh"
+#include "LibertyClass.hh"
+#include "FuncExpr.hh"
+
+namespace sta {
+
+// Function expression compiled for evaluation without walking the
+// expression tree. Functions of up to truth_table_port_max ports have
+// a 64 bit truth table; bit i of the table is the function value when
+// each port k has the value of bit k of i. All functions have a
+// postfix program of the expression operators.
+class FuncExprEval
+{
+public:
+  explicit FuncExprEval(const FuncExpr *expr);
+  // Expression ports in the order they are first used.
+  size_t portCount() const { return ports_.size(); }
+  LibertyPort *port(size_t index) const { return ports_[index]; }
+  // Index of port in the expression ports, -1 if it is not used.
+  int portIndex(const LibertyPort *port) const;
+
+  bool hasTruthTable() const { return ports_.size() <= truth_table_port_max; }
+  uint64_t truthTable() const { return truth_table_; }
+  // Truth table of the boolean difference wrt port(index), ie the
+  // rows where the function is sensitive to the port.
+  uint64_t diffTable(size_t index) const { return diff_tables_[index]; }
+  // Valid bits of the tables.
+  uint64_t tableMask() const;
+  // Table bits where port(index) is one.
+  static uint64_t portTable(size_t index);
+
+  // Value of the function with port_values[i] the value of port(i).
+  // Truth tables are evaluated exactly (a function that does not
+  // depend on the unknown ports is 0 or 1); the postfix program uses
+  // three valued logic on each operator.
+  LogicValue eval(const LogicValue *port_values) const;
+  // Sense of the function wrt port from the truth table.
+  // Returns unknown if there is no truth table or the function does
+  // not depend on a port it uses.
+  TimingSense portTimingSense(const LibertyPort *port) const;
+
+  class Op
+  {
+  public:
+    FuncExpr::Operator op_;
+    int port_index_;
+  };
+  // Postfix expression operators.
+  const std::vector<Op> &ops() const { return ops_; }
+  // Operator stack depth needed to evaluate ops.
+  size_t stackSize() const { return stack_size_; }
+
+  static constexpr size_t truth_table_port_max = 6;
+
+private:
+  size_t compile(const FuncExpr *expr,
+                 size_t depth);
+  uint64_t evalTruthTable() const;
+  LogicValue evalTable(const LogicValue *port_values) const;
+  LogicValue evalOps(const LogicValue *port_values) const;
+
+  std::vector<LibertyPort*> ports_;
+  std::vector<Op> ops_;
+  size_t stack_size_;
+  uint64_t truth_table_;
+  std::vector<uint64_t> diff_tables_;
+};
+
+} // namespace
@@ -16,16 +16,23 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <mutex>
+#include <vector>
 
 #include "Iterator.hh"
 #include "Map.hh"
+#include "UnorderedMap.hh"
+#include "UnorderedSet.hh"
 #include "Vector.hh"
 #include "ObjectTable.hh"
 #include "ArrayTable.hh"
+#include "AtomicBitSet.hh"
 #include "LibertyClass.hh"
 #include "NetworkClass.hh"
 #include "Delay.hh"
+#include "DelayHalf.hh"
 #include "GraphClass.hh"
 #include "VertexId.hh"
 #include "PathVertexRep.hh"
@@ -35,16 +42,61 @@ namespace sta {
 
 class MinMax;
 class Sdc;
+class MemoryStats;
+class GraphModeTiming;
 
 enum class LevelColor { white, gray, black };
 
-typedef ArrayTable<Delay> DelayTable;
+#if STA_COMPACT_DELAYS
+  #if SSTA
+    #error "STA_COMPACT_DELAYS requires SSTA=0"
+  #endif
+// Slews and arc delays stored in half the space of floats.
+typedef DelayHalf DelayStore;
+#else
+typedef Delay DelayStore;
+#endif
+
+// Slew or arc delay arrays referenced by 32 bit ids.
+// SSTA builds store only the means of the delays when pocv is
+// disabled so nominal analysis does not pay for the sigmas.
+class DelayTable
+{
+public:
+  explicit DelayTable(bool means_only);
+  bool meansOnly() const { return means_only_; }
+  // Make count zero delays.
+  void make(uint32_t count,
+            ObjectId &id);
+  // Zero the delay of id, growing the table as necessary.
+  void makeZero(ObjectId id);
+  Delay value(ObjectId id,
+              int index) const;
+  void setValue(ObjectId id,
+                int index,
+                const Delay &delay);
+  bool valueEqual(ObjectId id,
+                  int index,
+                  const Delay &delay) const;
+  size_t size() const;
+  size_t bytes() const;
+  // Array ids of table are valid in the copy.
+  void copy(const DelayTable &table);
+
+private:
+  ArrayTable<DelayStore> delays_;
+#if SSTA
+  ArrayTable<float> means_;
+#endif
+  bool means_only_;
+};
+
 typedef ObjectTable<Vertex> VertexTable;
 typedef ObjectTable<Edge> EdgeTable;
 typedef ArrayTable<Arrival> ArrivalsTable;
 typedef ArrayTable<Required> RequiredsTable;
 typedef ArrayTable<PathVertexRep> PrevPathsTable;
-typedef Map<const Pin*, Vertex*> PinVertexMap;
+typedef UnorderedMap<const Pin*, Vertex*> PinVertexMap;
 typedef Iterator<Edge*> VertexEdgeIterator;
 typedef Map<const Pin*, float*> PeriodCheckAnnotations;
 typedef Vector<DelayTable*> DelayTableSeq;
@@ -72,10 +124,16 @@ public:
 	bool have_arc_delays,
 	DcalcAPIndex ap_count);
   void makeGraph();
+  // Make the graph with the leaf instance vertices and edges in the
+  // order of insts.
+  void makeGraph(const InstanceSeq &insts);
   virtual ~Graph();
 
   // Number of arc delays and slews from sdf or delay calculation.
   virtual void setDelayCount(DcalcAPIndex ap_count);
+  // Remake the slew and arc delay tables after pocv is enabled or
+  // disabled.
+  void pocvEnabledChanged();
 
   // Vertex functions.
   // Bidirect pins have two vertices.
@@ -97,6 +155,16 @@ public:
   virtual void deleteVertex(Vertex *vertex);
   bool hasFaninOne(Vertex *vertex) const;
   VertexId vertexCount() { return vertices_->size(); }
+  // All vertex IDs are less than vertexIdBound().
+  VertexId vertexIdBound() const { return vertices_->idBound(); }
+  // Compressed sparse row snapshot of the vertex in/out edges that
+  // the edge iterators use instead of following the edge links.
+  // Making or deleting vertices or edges invalidates the snapshot.
+  void makeAdjacencySnapshot();
+  bool adjacencySnapshotValid() const { return adjacency_valid_; }
+  void adjacencySnapshotInvalid() { adjacency_valid_ = false; }
+  // Number of vertex and edge makes and deletes.
+  size_t editCount() const { return edit_count_; }
   Arrival *makeArrivals(Vertex *vertex,
 			uint32_t count);
   Arrival *arrivals(Vertex *vertex);
@@ -113,17 +181,57 @@ public:
   PathVertexRep *makePrevPaths(Vertex *vertex,
 			       uint32_t count);
   PathVertexRep *prevPaths(Vertex *vertex) const;
+  void deletePrevPaths(Vertex *vertex,
+                       uint32_t count);
   void clearPrevPaths();
+  // Prefetch the first in/out edges and the arrival and prev path
+  // arrays of vertex.
+  void prefetchVertexData(const Vertex *vertex) const;
+  // Delete the arrival, required and prev path arrays of vertex.
+  void deletePaths(Vertex *vertex,
+                   uint32_t count);
+  // Most of the path array blocks are held by deleted arrays.
+  bool pathsFragmented() const;
+  // Copy the path arrays of every vertex into new blocks and delete
+  // the old blocks. arrival_count returns the size of the vertex arrays.
+  void compactPaths(const std::function<uint32_t (Vertex *vertex)> &arrival_count);
+  // Move the vertex path arrays and copy the slews and arc delays
+  // to a GraphModeTiming for a search that is no longer current.
+  GraphModeTiming *saveModeTiming();
+  // True if timing was saved with the current delay tables and no
+  // vertices or edges have been made or deleted since.
+  bool modeTimingValid(const GraphModeTiming *timing) const;
+  // Return the saved path arrays, slews and arc delays to the graph
+  // and delete timing. The graph must not have any path arrays.
+  // Annotated slews and arc delays keep their current values.
+  // level_changes returns the vertices with levels that differ
+  // from the saved levels.
+  void restoreModeTiming(GraphModeTiming *timing,
+                         VertexSeq &level_changes);
   // Reported slew are the same as those in the liberty tables.
   //  reported_slews = measured_slews / slew_derate_from_library
   // Measured slews are between slew_lower_threshold and slew_upper_threshold.
-  virtual const Slew &slew(const Vertex *vertex,
-			   const RiseFall *rf,
-			   DcalcAPIndex ap_index);
+  virtual Slew slew(const Vertex *vertex,
+		    const RiseFall *rf,
+		    DcalcAPIndex ap_index);
   virtual void setSlew(Vertex *vertex,
 		       const RiseFall *rf,
 		       DcalcAPIndex ap_index,
 		       const Slew &slew);
+  // Analysis points expected to have the same slews and arc delays
+  // use the tables of the analysis point table_aps[ap_index].
+  // Writes to a shared table by another analysis point are only
+  // compared to the shared values; mismatches are recorded for
+  // unshareMismatchedDelays. Analysis points that have been unshared
+  // keep their own tables until the tables are made again.
+  void shareDelays(const std::vector<DcalcAPIndex> &table_aps);
+  bool delaysShared(DcalcAPIndex ap_index) const;
+  bool sharedDelaysMismatched() const;
+  // Give the analysis points with mismatched values their own tables.
+  // Their delays need to be found again.
+  void unshareMismatchedDelays();
+  // Give every analysis point its own tables (before annotating delays).
+  void unshareDelays();
 
   // Edge functions.
   virtual Edge *edge(EdgeId edge_index) const;
@@ -156,9 +264,9 @@ public:
 			   DcalcAPIndex ap_index,
 			   ArcDelay delay);
   // Alias for arcDelays using library wire arcs.
-  virtual const ArcDelay &wireArcDelay(const Edge *edge,
-				       const RiseFall *rf,
-				       DcalcAPIndex ap_index);
+  virtual ArcDelay wireArcDelay(const Edge *edge,
+				const RiseFall *rf,
+				DcalcAPIndex ap_index);
   virtual void setWireArcDelay(Edge *edge,
 			       const RiseFall *rf,
 			       DcalcAPIndex ap_index,
@@ -199,31 +307,53 @@ public:
 				float period);
   // Remove all delay and slew annotations.
   void removeDelaySlewAnnotations();
+  // Add the memory used by the graph tables to stats.
+  void memoryStats(MemoryStats &stats) const;
   VertexSet *regClkVertices() { return reg_clk_vertices_; }
+  // Leaf instances sorted by the topological level of their vertices
+  // ignoring timing checks. Loops are broken arbitrarily.
+  InstanceSeq levelOrderInstances();
 
   static const int vertex_level_bits = 24;
   static const int vertex_level_max = (1<<vertex_level_bits)-1;
 
 protected:
-  void makeVerticesAndEdges();
+  void makeVerticesAndEdges(const InstanceSeq &insts);
+  void makeVerticesAndEdgesParallel(const InstanceSeq &insts);
   Vertex *makeVertex(Pin *pin,
 		     bool is_bidirect_drvr,
 		     bool is_reg_clk);
   virtual void makeEdgeArcDelays(Edge *edge);
+  // Link edge into the from/to vertex edge lists.
+  void linkEdge(Edge *edge,
+                Vertex *from,
+                Vertex *to,
+                TimingArcSet *arc_set);
   void makePinVertices(const Instance *inst);
   void makeWireEdgesFromPin(const Pin *drvr_pin,
 			    PinSet &visited_drvrs);
   bool isIsolatedNet(PinSeq &drvrs,
                      PinSeq &loads) const;
-  void makeWireEdges();
+  void makeWireEdges(const InstanceSeq &insts);
   virtual void makeInstDrvrWireEdges(const Instance *inst,
 				     PinSet &visited_drvrs);
   virtual void makePortInstanceEdges(const Instance *inst,
 				     LibertyCell *cell,
                                      LibertyPort *from_to_port);
+  // Call make_edge(from_vertex, to_vertex, arc_set) for each instance
+  // edge. make_edge returns nullptr if it only counts the edges.
+  template <class MAKE_EDGE>
+  void visitPortInstanceEdges(const Instance *inst,
+                              LibertyCell *cell,
+                              LibertyPort *from_to_port,
+                              MAKE_EDGE make_edge);
   void removePeriodCheckAnnotations();
   void makeSlewTables(DcalcAPIndex count);
   void deleteSlewTables();
+  void makeDelayTableAps(DcalcAPIndex ap_count);
+  void unshareDelays(DcalcAPIndex ap_index);
+  void delaysMismatch(DcalcAPIndex ap_index);
+  bool delaysMeansOnly() const;
   void makeVertexSlews(Vertex *vertex);
   void makeArcDelayTables(DcalcAPIndex ap_count);
   void deleteArcDelayTables();
@@ -233,6 +363,12 @@ protected:
 		     Edge *edge);
   void removeDelays();
   void removeDelayAnnotated(Edge *edge);
+  void graphEdited();
+  void copyDelayTables(const DelayTableSeq &from,
+                       int tables_per_ap,
+                       DelayTableSeq &to) const;
+  void keepAnnotatedDelays(Vertex *vertex,
+                           GraphModeTiming *timing);
 
   VertexTable *vertices_;
   EdgeTable *edges_;
@@ -248,17 +384,35 @@ protected:
   std::mutex requireds_lock_;
   PrevPathsTable prev_paths_;
   std::mutex prev_paths_lock_;
-  Vector<bool> arc_delay_annotated_;
+  // Bit per edge arc and delay analysis point.
+  AtomicBitSet arc_delay_annotated_;
   int slew_rf_count_;
   bool have_arc_delays_;
   DcalcAPIndex ap_count_;
   DelayTableSeq slew_tables_;	      // [ap_index][tr_index][vertex_id]
   VertexId slew_count_;
   DelayTableSeq arc_delays_;	      // [ap_index][edge_arc_index]
+  // Analysis point that owns the slew and arc delay tables [ap_index].
+  std::vector<DcalcAPIndex> delay_table_aps_;
+  // Analysis points given their own tables by unshareDelays for
+  // annotation or mismatches are never shared again [ap_index].
+  std::vector<bool> delays_unshared_;
+  // Shared table writes that did not match [ap_index].
+  std::atomic<bool> *delay_mismatches_;
+  std::atomic<bool> delays_mismatched_;
   // Sdf period check annotations.
   PeriodCheckAnnotations *period_check_annotations_;
   // Register/latch clock vertices to search from.
   VertexSet *reg_clk_vertices_;
+  // Adjacency snapshot edges of vertex id are
+  // [adjacency_*_offsets_[id], adjacency_*_offsets_[id + 1])
+  // in adjacency_*_edges_.
+  bool adjacency_valid_;
+  std::vector<uint32_t> adjacency_in_offsets_;
+  std::vector<Edge*> adjacency_in_edges_;
+  std::vector<uint32_t> adjacency_out_offsets_;
+  std::vector<Edge*> adjacency_out_edges_;
+  size_t edit_count_;
 
   friend class Vertex;
   friend class VertexIterator;
@@ -267,6 +421,56 @@ protected:
   friend class MakeEdgesThruHierPin;
 };
 
+// Search fields of a vertex saved by Graph::saveModeTiming.
+class VertexModeTiming
+{
+public:
+  ArrivalId arrivals_;
+  ArrivalId requireds_;
+  PrevPathId prev_paths_;
+  TagGroupIndex tag_group_index_;
+  Level level_;
+  bool crpr_path_pruning_disabled_;
+  bool requireds_pruned_;
+};
+
+// Vertex path arrays, slews and arc delays of a search that is not
+// current, indexed the same as the graph tables.
+class GraphModeTiming
+{
+public:
+  ~GraphModeTiming();
+
+private:
+  GraphModeTiming() {}
+
+  ArrivalsTable arrivals_;
+  RequiredsTable requireds_;
+  PrevPathsTable prev_paths_;
+  // [vertex_id]
+  std::vector<VertexModeTiming> vertices_;
+  DelayTableSeq slew_tables_;
+  DelayTableSeq arc_delays_;
+  std::vector<DcalcAPIndex> delay_table_aps_;
+  int slew_rf_count_;
+  size_t edit_count_;
+
+  friend class Graph;
+};
+
+// Vertex fields read by the bfs and search inner loops are stored
+// in parallel arrays in each vertex table block.
+template <>
+class ObjectTableHot<Vertex>
+{
+public:
+  Level level_[VertexTable::block_object_count];
+  ArrivalId arrivals_[VertexTable::block_object_count];
+  TagGroupIndex tag_group_index_[VertexTable::block_object_count];
+  // Each bit corresponds to a different BFS queue.
+  unsigned char bfs_in_queue_[VertexTable::block_object_count];
+};
+
 // Each Vertex corresponds to one network pin.
 class Vertex
 {
@@ -277,14 +481,14 @@ public:
   const char *name(const Network *network) const;
   bool isBidirectDriver() const { return is_bidirect_drvr_; }
   bool isDriver(const Network *network) const;
-  Level level() const { return level_; }
+  Level level() const;
   void setLevel(Level level);
-  bool isRoot() const{ return level_ == 0; }
+  bool isRoot() const{ return level() == 0; }
   bool hasFanin() const;
   bool hasFanout() const;
   LevelColor color() const { return static_cast<LevelColor>(color_); }
   void setColor(LevelColor color);
-  ArrivalId arrivals() { return arrivals_; }
+  ArrivalId arrivals() const;
   ArrivalId requireds() { return requireds_; }
   bool hasRequireds() const { return requireds_ != arrival_null; }
   PrevPathId prevPaths() const { return prev_paths_; }
@@ -342,24 +546,25 @@ protected:
   void init(Pin *pin,
 	    bool is_bidirect_drvr,
 	    bool is_reg_clk);
+  // Initialize fields stored in the vertex (not the block arrays).
+  void initFields(Pin *pin,
+                  bool is_bidirect_drvr,
+                  bool is_reg_clk);
   void setArrivals(ArrivalId id);
   void setRequireds(ArrivalId id);
+  ObjectTableHot<Vertex> &hot() { return VertexTable::hot(this); }
+  const ObjectTableHot<Vertex> &hot() const { return VertexTable::hot(this); }
 
   Pin *pin_;
-  ArrivalId arrivals_;
+  // arrivals, tag group index, level and bfs in queue bits are
+  // in ObjectTableHot<Vertex>.
   ArrivalId requireds_;
   PrevPathId prev_paths_;
   EdgeId in_edges_;		// Edges to this vertex.
   EdgeId out_edges_;		// Edges from this vertex.
 
-  // 4 bytes
-  unsigned int tag_group_index_:tag_group_index_bits; // 24
-  // Each bit corresponds to a different BFS queue.
-  unsigned int bfs_in_queue_:int(BfsIndex::bits); // 4
-  unsigned int slew_annotated_:slew_annotated_bits;
-
   // 4 bytes (32 bits)
-  unsigned int level_:Graph::vertex_level_bits;
+  unsigned int slew_annotated_:slew_annotated_bits;
   // Levelization search state.
   // LevelColor gcc barfs if this is dcl'd.
   unsigned color_:2;
@@ -389,6 +594,30 @@ private:
   friend class VertexOutEdgeIterator;
 };
 
+inline Level
+Vertex::level() const
+{
+  return hot().level_[object_idx_];
+}
+
+inline ArrivalId
+Vertex::arrivals() const
+{
+  return hot().arrivals_[object_idx_];
+}
+
+inline TagGroupIndex
+Vertex::tagGroupIndex() const
+{
+  return hot().tag_group_index_[object_idx_];
+}
+
+inline bool
+Vertex::bfsInQueue(BfsIndex index) const
+{
+  return (hot().bfs_in_queue_[object_idx_] >> unsigned(index)) & 1;
+}
+
 // There is one Edge between each pair of pins that has a timing
 // path between them.
 class Edge
@@ -493,8 +722,13 @@ public:
   Edge *next();
 
 private:
+  void init(Vertex *vertex);
+
   Edge *next_;
   const Graph *graph_;
+  // Adjacency snapshot range (null when following edge links).
+  Edge *const *snapshot_next_;
+  Edge *const *snapshot_end_;
 };
 
 class VertexOutEdgeIterator : public VertexEdgeIterator
@@ -508,6 +742,9 @@ public:
 private:
   Edge *next_;
   const Graph *graph_;
+  // Adjacency snapshot range (null when following edge links).
+  Edge *const *snapshot_next_;
+  Edge *const *snapshot_end_;
 };
 
 // Iterate over the edges through a hierarchical pin.
@@ -542,4 +779,50 @@ public:
   VertexSet(Graph *&graph);
 };
 
+class VertexIdHash
+{
+public:
+  VertexIdHash(Graph *&graph);
+  size_t operator()(const Vertex *vertex) const;
+
+private:
+  Graph *&graph_;
+};
+
+// Hashed vertex set for large, frequently updated sets that are not
+// iterated in vertex order. Iteration order only depends on the
+// vertex ids and the insertion order.
+class VertexUnorderedSet : public UnorderedSet<Vertex*, VertexIdHash>
+{
+public:
+  VertexUnorderedSet(Graph *&graph);
+};
+
+////////////////////////////////////////////////////////////////
+
+inline Delay
+DelayTable::value(ObjectId id,
+                  int index) const
+{
+#if SSTA
+  if (means_only_)
+    return means_.pointer(id)[index];
+#endif
+  return delays_.pointer(id)[index];
+}
+
+inline void
+DelayTable::setValue(ObjectId id,
+                     int index,
+                     const Delay &delay)
+{
+#if SSTA
+  if (means_only_) {
+    means_.pointer(id)[index] = delay.mean();
+    return;
+  }
+#endif
+  delays_.pointer(id)[index] = delay;
+}
+
 } // namespace
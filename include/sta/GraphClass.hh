@@ -35,6 +35,7 @@ class VertexInEdgeIterator;
 class VertexOutEdgeIterator;
 class GraphLoop;
 class VertexSet;
+class VertexUnorderedSet;
 
 typedef ObjectId VertexId;
 typedef ObjectId EdgeId;
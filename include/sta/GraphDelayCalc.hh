@@ -36,10 +36,39 @@ using std::map;
 class DelayCalcObserver;
 class MultiDrvrNet;
 class FindVertexDelays;
+class SearchPredNonLatch2;
 class NetCaps;
+class ConcurrentIdSet;
 
 typedef Map<const Vertex*, MultiDrvrNet*> MultiDrvrNetMap;
 
+// Driver load cap and parasitic for an analysis point and rise/fall.
+class DrvrLoad
+{
+public:
+  bool found_;
+  float load_cap_;
+  const Parasitic *parasitic_;
+};
+// Indexed by ap_index * RiseFall::index_count + rf_index.
+typedef vector<DrvrLoad> DrvrLoadSeq;
+
+// Driving cell arc, input slew and analysis point of an unloaded
+// (intrinsic) input port driver delay.
+class InputIntrinsicKey
+{
+public:
+  bool operator<(const InputIntrinsicKey &key) const;
+
+  const TimingArc *arc_;
+  float from_slew_;
+  DcalcAPIndex ap_index_;
+};
+
+typedef map<InputIntrinsicKey, ArcDelay> InputIntrinsicDelayMap;
+typedef map<std::pair<const LibertyCell*, const LibertyPort*>,
+            LibertyPort*> DriveCellFromPortMap;
+
 // This class traverses the graph calling the arc delay calculator and
 // annotating delays on graph edges.
 class GraphDelayCalc : public StaState
@@ -52,9 +81,15 @@ public:
   virtual void setObserver(DelayCalcObserver *observer);
   // Invalidate all delays/slews.
   virtual void delaysInvalid();
+  // All delays/slews were set without delay calculation
+  // (read_timing_snapshot).
+  void delaysRestored();
   // Invalidate vertex and downstream delays/slews.
   virtual void delayInvalid(Vertex *vertex);
   virtual void delayInvalid(const Pin *pin);
+  // Number of delaysInvalid and delayInvalid calls, so clients can
+  // tell if delays may have changed since they looked.
+  size_t invalidCount() const { return invalid_count_; }
   virtual void deleteVertexBefore(Vertex *vertex);
   // Reset to virgin state.
   virtual void clear();
@@ -75,6 +110,10 @@ public:
 
   float loadCap(const Pin *drvr_pin,
                 const DcalcAnalysisPt *dcalc_ap) const;
+  // Thread safe given an arc delay calculator per thread.
+  float loadCap(const Pin *drvr_pin,
+                const DcalcAnalysisPt *dcalc_ap,
+                ArcDelayCalc *arc_delay_calc) const;
   float loadCap(const Pin *drvr_pin,
                 const RiseFall *rf,
                 const DcalcAnalysisPt *dcalc_ap) const;
@@ -118,6 +157,7 @@ public:
 		    const RiseFall *from_rf,
 		    const Edge *edge,
 		    const DcalcAnalysisPt *dcalc_ap);
+  BfsFwdIterator *iterator() const { return iter_; }
 
 protected:
   void seedInvalidDelays();
@@ -152,6 +192,11 @@ protected:
 					const LibertyPort *to_port);
   int findPortIndex(const LibertyCell *cell,
 		    const LibertyPort *port);
+  ArcDelay inputIntrinsicDelay(const Pin *drvr_pin,
+                               const TimingArc *arc,
+                               float from_slew,
+                               const LoadPinIndexMap &load_pin_index_map,
+                               const DcalcAnalysisPt *dcalc_ap);
   void findInputArcDelay(const Pin *drvr_pin,
 			 Vertex *drvr_vertex,
 			 const TimingArc *arc,
@@ -160,7 +205,8 @@ protected:
   bool findDriverDelays(Vertex *drvr_vertex,
 			ArcDelayCalc *arc_delay_calc);
   MultiDrvrNet *multiDrvrNet(const Vertex *drvr_vertex) const;
-  MultiDrvrNet *findMultiDrvrNet(Vertex *drvr_pin);
+  void makeMultiDrvrNets();
+  MultiDrvrNet *ensureMultiDrvrNet(Vertex *drvr_vertex);
   MultiDrvrNet *makeMultiDrvrNet(Vertex *drvr_vertex);
   bool hasMultiDrvrs(Vertex *drvr_vertex);
   Vertex *firstLoad(Vertex *drvr_vertex);
@@ -168,10 +214,34 @@ protected:
 			 MultiDrvrNet *multi_drvr,
 			 ArcDelayCalc *arc_delay_calc);
   void initLoadSlews(Vertex *drvr_vertex);
+  void saveLoadSlews(Vertex *drvr_vertex,
+                     std::vector<float> &slews);
+  void findUnchangedLoadSlews(Vertex *drvr_vertex,
+                              const std::vector<float> &prev_slews);
+  bool loadSlewsChanged(Vertex *load_vertex);
+  void countSkippedDrvrs(Vertex *load_vertex);
   bool findDriverEdgeDelays(Vertex *drvr_vertex,
 			    const MultiDrvrNet *multi_drvr,
 			    Edge *edge,
 			    ArcDelayCalc *arc_delay_calc);
+  bool findDriverEdgeDelays(Vertex *drvr_vertex,
+			    const MultiDrvrNet *multi_drvr,
+			    Edge *edge,
+			    LoadPinIndexMap &load_pin_index_map,
+			    DrvrLoadSeq &drvr_loads,
+			    ArcDelayCalc *arc_delay_calc);
+  bool findDriverEdgeDelaysBatch(Vertex *drvr_vertex,
+                                 const MultiDrvrNet *multi_drvr,
+                                 Edge *edge,
+                                 LoadPinIndexMap &load_pin_index_map,
+                                 DrvrLoadSeq &drvr_loads,
+                                 ArcDelayCalc *arc_delay_calc);
+  const DrvrLoad &drvrLoad(const Pin *drvr_pin,
+                           const RiseFall *drvr_rf,
+                           const DcalcAnalysisPt *dcalc_ap,
+                           const MultiDrvrNet *multi_drvr,
+                           ArcDelayCalc *arc_delay_calc,
+                           DrvrLoadSeq &drvr_loads) const;
   bool findDriverArcDelays(Vertex *drvr_vertex,
                            const MultiDrvrNet *multi_drvr,
                            Edge *edge,
@@ -254,6 +324,12 @@ protected:
   bool delays_exist_;
   // Vertices with invalid -to delays.
   VertexSet *invalid_delays_;
+  // Vertices seeded from invalid_delays_ by the current findDelays.
+  ConcurrentIdSet *seeded_delays_;
+  // Load vertices whose slews did not change when their driver delays
+  // were found by the current findDelays, so the drivers they fan out
+  // to do not need to be recomputed.
+  ConcurrentIdSet *unchanged_load_slews_;
   // Timing check edges with invalid delays.
   EdgeSet invalid_check_edges_;
   // Latch D->Q edges with invalid delays.
@@ -261,14 +337,21 @@ protected:
   // shared by invalid_check_edges_ and invalid_latch_edges_
   std::mutex invalid_edge_lock_;
   SearchPred *search_pred_;
-  SearchPred *search_non_latch_pred_;
+  SearchPredNonLatch2 *search_non_latch_pred_;
   SearchPred *clk_pred_;
   BfsFwdIterator *iter_;
+  // Made before the parallel vertex visits so they are read only there.
   MultiDrvrNetMap multi_drvr_net_map_;
-  std::mutex multi_drvr_lock_;
   // Percentage (0.0:1.0) change in delay that causes downstream
   // delays to be recomputed during incremental delay calculation.
   float incremental_delay_tolerance_;
+  size_t invalid_count_;
+  // Driving cell -from_pin defaults. Only depend on the liberty cell.
+  DriveCellFromPortMap drive_cell_from_ports_;
+  // Driving cell delays with no load, shared by the input ports with
+  // the same driving cell and input slew.
+  InputIntrinsicDelayMap input_intrinsic_delays_;
+  std::mutex input_drive_lock_;
 
   friend class FindVertexDelays;
   friend class MultiDrvrNet;
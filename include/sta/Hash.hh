@@ -18,6 +18,9 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <string>
+
+#include "Vector.hh"
 
 namespace sta {
 
@@ -52,6 +55,13 @@ nextMersenne(size_t n)
 size_t
 hashString(const char *str);
 
+// 64 bit FNV-1a hash of key and the contents of the files as 16 hex
+// digits, for naming files cached from the files.
+// Throws FileNotReadable.
+std::string
+fileContentsHash(const char *key,
+                 const Vector<const char*> &filenames);
+
 // Pointer hashing is strongly discouraged because it causes results to change
 // from run to run. Use Network::id functions instead.
 #if __WORDSIZE == 64
@@ -0,0 +1,100 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+
+#include "Zlib.hh"
+
+namespace sta {
+
+class InputFileReadAhead;
+
+// Input file for the flex lexers (YY_INPUT) and hand written readers.
+// Uncompressed files are memory mapped and read in large blocks
+// straight from the mapped pages. Compressed files (gzip, zstd when
+// it is found by cmake) and platforms without mmap are decompressed
+// by a read ahead thread while the reader consumes earlier blocks.
+class InputFile
+{
+public:
+  InputFile();
+  ~InputFile();
+  // Return true if the file is opened.
+  bool open(const char *filename);
+  // Read from a buffer owned by the caller.
+  void openBuffer(const char *buffer,
+                  size_t size);
+  void close();
+  bool isOpen() const;
+  bool isMapped() const { return map_ != nullptr; }
+  // Mapped file contents.
+  const char *mapData() const { return map_; }
+  size_t mapSize() const { return map_size_; }
+  // Copy up to max_size chars to buf.
+  // Return the number of chars copied, 0 at the end of the file.
+  size_t read(char *buf,
+              size_t max_size);
+  // Return the next char or EOF.
+  int getc();
+  // flex YY_INPUT yy_n_chars arg changed definition from int to size_t,
+  // so provide both forms.
+  void getChars(char *buf,
+                size_t &result,
+                size_t max_size);
+  void getChars(char *buf,
+                int &result,
+                size_t max_size);
+
+  // Deleted operations
+  InputFile(const InputFile &file) = delete;
+  InputFile &operator=(const InputFile &file) = delete;
+
+private:
+  bool openMapped(const char *filename);
+  bool nextBlock();
+  int getcNextBlock();
+
+  InputFileReadAhead *read_ahead_;
+  // Decompressed block being read.
+  const char *block_;
+  size_t block_size_;
+  size_t block_pos_;
+  const char *map_;
+  size_t map_size_;
+  size_t map_pos_;
+  // map_ is a caller buffer.
+  bool is_buffer_;
+  // Mapped file is empty.
+  bool empty_;
+};
+
+inline int
+InputFile::getc()
+{
+  if (map_)
+    return (map_pos_ < map_size_)
+      ? static_cast<unsigned char>(map_[map_pos_++])
+      : EOF;
+  else if (block_pos_ < block_size_)
+    return static_cast<unsigned char>(block_[block_pos_++]);
+  else
+    return getcNextBlock();
+}
+
+} // namespace
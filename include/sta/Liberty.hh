@@ -38,6 +38,7 @@ class TestCell;
 class PatternMatch;
 class LatchEnable;
 class Report;
+class MemoryStats;
 class Debug;
 class LibertyBuilder;
 class LibertyReader;
@@ -275,6 +276,9 @@ public:
   void addOperatingConditions(OperatingConditions *op_cond);
   void setDefaultOperatingConditions(OperatingConditions *op_cond);
 
+  // Add the memory used by the library cells to stats.
+  void memoryStats(MemoryStats &stats) const;
+
   // AOCV
   // Zero means the ocv depth is not specified.
   float ocvArcDepth() const;
@@ -305,6 +309,12 @@ public:
 		LibertyCell *map_cell,
 		int ap_index,
 		Report *report);
+  // Map a cell made by a cell loader after its library was added
+  // to corners.
+  static void
+  makeCornerMap(LibertyCell *cell,
+		Network *network,
+		Report *report);
   static void
   makeCornerMap(LibertyCell *cell1,
 		LibertyCell *cell2,
@@ -370,6 +380,8 @@ protected:
   DriverWaveformMap driver_waveform_map_;
   // Unnamed driver waveform.
   DriverWaveform *driver_waveform_default_;
+  // Corner liberty indices (analysis points) of the library.
+  Vector<int> corner_indices_;
 
   static constexpr float input_threshold_default_ = .5;
   static constexpr float output_threshold_default_ = .5;
@@ -483,6 +495,9 @@ public:
                           const MinMax *min_max);
   LibertyCell *cornerCell(const DcalcAnalysisPt *dcalc_ap);
   LibertyCell *cornerCell(int ap_index);
+  // True if corner_cell is mapped to the cell at ap_index.
+  bool hasCornerCell(const LibertyCell *corner_cell,
+                     int ap_index) const;
 
   // AOCV
   float ocvArcDepth() const;
@@ -549,6 +564,7 @@ protected:
 			       TimingArcSet *setup_check,
 			       Debug *debug);
   void findDefaultCondArcs();
+  void compileFuncExprs();
   void translatePresetClrCheckRoles();
   void inferLatchRoles(Debug *debug);
   void deleteInternalPowerAttrs();
@@ -1127,4 +1143,37 @@ private:
 string
 portLibertyToSta(const char *port_name);
 
+inline LibertyCell *
+LibertyCell::cornerCell(int ap_index)
+{
+  if (corner_cells_.empty())
+    return this;
+  else if (ap_index < static_cast<int>(corner_cells_.size()))
+    return corner_cells_[ap_index];
+  else
+    return nullptr;
+}
+
+inline LibertyPort *
+LibertyPort::cornerPort(int ap_index)
+{
+  if (corner_ports_.empty())
+    return this;
+  else if (ap_index < static_cast<int>(corner_ports_.size()))
+    return corner_ports_[ap_index];
+  else
+    return nullptr;
+}
+
+inline const LibertyPort *
+LibertyPort::cornerPort(int ap_index) const
+{
+  if (corner_ports_.empty())
+    return this;
+  else if (ap_index < static_cast<int>(corner_ports_.size()))
+    return corner_ports_[ap_index];
+  else
+    return nullptr;
+}
+
 } // namespace
@@ -0,0 +1,43 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "LibertyClass.hh"
+
+namespace sta {
+
+class Network;
+class Report;
+
+// Parse a liberty file and write its groups and attributes to a
+// binary file that readLibertyDb reads without lexing or parsing the
+// liberty text.
+// Throws FileNotReadable, FileNotWritable.
+void
+writeLibertyDb(const char *liberty_filename,
+               const char *filename,
+               Report *report);
+
+// Read a file written by writeLibertyDb.
+// Return the library, or null if the file is not a liberty db.
+// Throws FileNotReadable.
+LibertyLibrary *
+readLibertyDb(const char *filename,
+              bool infer_latches,
+              Network *network);
+
+} // namespace
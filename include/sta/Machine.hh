@@ -65,6 +65,7 @@
 #endif
 
 #include <cstddef>		// size_t
+#include <vector>
 
 namespace sta {
 
@@ -90,5 +91,36 @@ systemRunTime();
 // Memory usage in bytes.
 size_t
 memoryUsage();
+// Peak memory usage in bytes.
+size_t
+memoryPeakUsage();
+
+// Processors of each NUMA node. One node with all of the processors
+// if the topology is unknown.
+std::vector<std::vector<int>>
+numaNodeProcessors();
+// Bind the calling thread to processor.
+// Return false if the thread could not be bound.
+bool
+bindThreadToProcessor(int processor);
+
+// Allocate size bytes aligned to 2MB and backed by huge pages, which
+// are reserved huge pages (MAP_HUGETLB) if explicit_pages or else
+// transparent huge pages. size must be a multiple of 2MB.
+// Return nullptr if the memory could not be allocated that way.
+void *
+allocHugePages(size_t size,
+               bool explicit_pages);
+
+// Hint that the memory at addr will be read soon.
+inline void
+prefetchRead(const void *addr)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(addr, 0, 3);
+#else
+  (void) addr;
+#endif
+}
 
 } // namespace sta
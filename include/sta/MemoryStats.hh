@@ -0,0 +1,63 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sta {
+
+class Report;
+
+// Memory accounting by subsystem for report_memory.
+// Subsystems add the object counts and bytes of their tables and
+// containers. Container node sizes are estimates because the
+// standard containers do not expose their allocations.
+class MemoryStats
+{
+public:
+  // Add count objects of a subsystem category using bytes.
+  void add(const char *subsystem,
+           const char *category,
+           size_t count,
+           size_t bytes);
+  size_t bytes() const;
+  size_t bytes(const char *subsystem) const;
+  // Report the categories of each subsystem and the process memory
+  // the subsystems do not account for.
+  void report(size_t process_memory,
+              Report *report) const;
+
+  // Estimated bytes of each element of node based containers.
+  static constexpr size_t tree_node_bytes = 4 * sizeof(void*);
+  static constexpr size_t hash_node_bytes = 2 * sizeof(void*);
+
+private:
+  class Entry
+  {
+  public:
+    std::string subsystem_;
+    std::string category_;
+    size_t count_;
+    size_t bytes_;
+  };
+
+  std::vector<Entry> entries_;
+};
+
+} // namespace
@@ -0,0 +1,46 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace sta {
+
+class ConcreteNetwork;
+class NetworkReader;
+class DispatchQueue;
+
+// Write the linked network (module cells, instances, nets, pins,
+// attributes and constant nets) to a binary file that readNetlistDb
+// loads without parsing verilog. Liberty cells are referenced by name.
+// Throws FileNotWritable.
+void
+writeNetlistDb(const char *filename,
+               ConcreteNetwork *network);
+
+// Read a file written by writeNetlistDb and make it the network link
+// function. Liberty cells are found and the instances made when the
+// network is linked. Leaf instances are made with the dispatch_queue
+// threads (may be null).
+// Return the top cell name, or null if the file is not a netlist db.
+// Throws FileNotReadable.
+const char *
+readNetlistDb(const char *filename,
+              NetworkReader *network,
+              DispatchQueue *dispatch_queue);
+void
+deleteNetlistDbReader();
+
+} // namespace
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
 #include "Map.hh"
 #include "StringUtil.hh"
@@ -30,6 +31,8 @@ namespace sta {
 class Report;
 class PatternMatch;
 class PinVisitor;
+class DispatchQueue;
+class MemoryStats;
 
 typedef Map<const char*, LibertyLibrary*, CharPtrLess> LibertyLibraryMap;
 // Link network function returns top level instance.
@@ -99,6 +102,8 @@ public:
 			   Report *report) = 0;
   virtual bool isLinked() const;
   virtual bool isEditable() const { return false; }
+  // Add the memory used by the network to stats.
+  virtual void memoryStats(MemoryStats &stats) const;
 
   ////////////////////////////////////////////////////////////////
   // Library functions.
@@ -213,6 +218,11 @@ public:
                               const string &key) const = 0;
   // Hierarchical path name.
   virtual const char *pathName(const Instance *instance) const;
+  // Append the path name to path_name without using temporary strings
+  // so it is safe to call from multiple threads. Reusing path_name
+  // (clear it between names) avoids allocating.
+  virtual void appendPathName(const Instance *instance,
+                              string &path_name) const;
   bool pathNameLess(const Instance *inst1,
 		    const Instance *inst2) const;
   int pathNameCmp(const Instance *inst1,
@@ -284,6 +294,8 @@ public:
   virtual const char *portName(const Pin *pin) const;
   // Path name is instance_name/port_name.
   virtual const char *pathName(const Pin *pin) const;
+  virtual void appendPathName(const Pin *pin,
+                              string &path_name) const;
   bool pathNameLess(const Pin *pin1,
 		    const Pin *pin2) const;
   int pathNameCmp(const Pin *pin1,
@@ -371,6 +383,8 @@ public:
                                     const PatternMatch *pattern,
                                     NetSeq &matches) const = 0;
   virtual const char *pathName(const Net *net) const;
+  virtual void appendPathName(const Net *net,
+                              string &path_name) const;
   bool pathNameLess(const Net *net1,
 		    const Net *net2) const;
   int pathNameCmp(const Net *net1,
@@ -527,6 +541,25 @@ public:
   virtual Net *mergedInto(Net *net) = 0;
 };
 
+// Leaf instance made by NetworkReader::makeLeafInstances.
+class LeafInstanceDef
+{
+public:
+  LeafInstanceDef(LibertyCell *cell,
+                  const char *name,
+                  Net **nets);
+
+  LibertyCell *cell_;
+  const char *name_;
+  // Nets connected to the cell port bits indexed by port pin index.
+  // Pins of ports with null nets are unconnected.
+  Net **nets_;
+  // The instance made by makeLeafInstances.
+  Instance *inst_;
+};
+
+typedef std::vector<LeafInstanceDef> LeafInstanceDefSeq;
+
 // Network API to support the Parallax readers.
 class NetworkReader : public NetworkEdit
 {
@@ -583,6 +616,14 @@ public:
   virtual void deleteCellNetworkViews() = 0;
   virtual void addConstantNet(Net *net,
 			      LogicValue const_value) = 0;
+  // Make the instances of defs under parent with pins for every port
+  // bit of their cells, in defs order.
+  // Readers use this to elaborate large flat modules.
+  // Implementations may use the dispatch_queue threads (may be null)
+  // to make the objects.
+  virtual void makeLeafInstances(LeafInstanceDefSeq &defs,
+                                 Instance *parent,
+                                 DispatchQueue *dispatch_queue);
 
   using NetworkEdit::makeInstance;
 };
@@ -0,0 +1,48 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+
+namespace sta {
+
+class MemoryStats;
+
+// Allocator for small objects that are made and deleted in large
+// numbers (path ends, enumerated paths, tags, clock infos, pins,
+// liberty attributes). Objects are carved out of
+// large blocks and deleted objects are kept on per thread free lists
+// by size, so making and deleting them does not go through malloc.
+// Threads move surplus free objects to free lists shared by all
+// threads in batches and return all of them when they exit.
+// Pool memory is reused but never returned to the system.
+// Objects larger than objectPoolSizeMax use operator new.
+void *
+objectPoolAlloc(size_t size);
+// size must be the size passed to objectPoolAlloc.
+void
+objectPoolFree(void *object,
+               size_t size);
+
+// Add the pool memory that is not used by live objects to stats.
+// Live objects are accounted by the subsystems that own them.
+void
+objectPoolMemoryStats(MemoryStats &stats);
+
+static constexpr size_t objectPoolSizeMax = 512;
+
+} // namespace
@@ -19,12 +19,23 @@
 #include "Vector.hh"
 #include "Error.hh"
 #include "ObjectId.hh"
+#include "TableBlockPool.hh"
 
 namespace sta {
 
 template <class OBJECT>
 class TableBlock;
 
+// Object fields kept in parallel arrays beside the objects in each
+// block (structure of arrays) so passes that only read those fields
+// do not pull whole objects into cache. Specialize for TYPE with
+// arrays of ObjectTable<TYPE>::block_object_count elements indexed
+// by the object's objectIdx().
+template <class TYPE>
+class ObjectTableHot
+{
+};
+
 // Object tables allocate objects in blocks and use 32 bit IDs to
 // reference an object. Paging performance is improved by allocating
 // blocks instead of individual objects, and object sizes are reduced
@@ -43,11 +54,23 @@ public:
   ObjectTable();
   ~ObjectTable();
   TYPE *make();
+  // Reserve count objects with consecutive IDs and return the first ID.
+  // The objects are not constructed; call setObjectIdx/init on each
+  // (possibly from several threads) before using them.
+  // Only valid before any objects have been destroyed.
+  ObjectId makeSequential(size_t count);
   void destroy(TYPE *object);
   TYPE *pointer(ObjectId id) const;
   TYPE &ref(ObjectId id) const;
   ObjectId objectId(const TYPE *object);
+  // Parallel field arrays of the block holding object.
+  static ObjectTableHot<TYPE> &hot(TYPE *object);
+  static const ObjectTableHot<TYPE> &hot(const TYPE *object);
   size_t size() const { return size_; }
+  // All object IDs are less than idBound().
+  ObjectId idBound() const { return blocks_.size() << idx_bits; }
+  // Bytes of the allocated blocks.
+  size_t bytes() const { return blocks_.size() * sizeof(TableBlock<TYPE>); }
   void clear();
 
   // Objects are allocated in blocks of 128.
@@ -57,6 +80,7 @@ public:
 
 private:
   void makeBlock();
+  void deleteBlocks();
   void freePush(TYPE *object,
 		ObjectId id);
 
@@ -77,7 +101,18 @@ ObjectTable<TYPE>::ObjectTable() :
 template <class TYPE>
 ObjectTable<TYPE>::~ObjectTable()
 {
-  blocks_.deleteContents();
+  deleteBlocks();
+}
+
+template <class TYPE>
+void
+ObjectTable<TYPE>::deleteBlocks()
+{
+  for (TableBlock<TYPE> *block : blocks_) {
+    block->~TableBlock<TYPE>();
+    tableBlockFree(block, sizeof(TableBlock<TYPE>));
+  }
+  blocks_.clear();
 }
 
 template <class TYPE>
@@ -95,6 +130,31 @@ ObjectTable<TYPE>::make()
   return object;
 }
 
+template <class TYPE>
+ObjectId
+ObjectTable<TYPE>::makeSequential(size_t count)
+{
+  // Without destroyed objects the free list is the IDs following
+  // the live objects in order (ObjectId zero is reserved).
+  ObjectId first = size_ + 1;
+  if (free_ != object_id_null && free_ != first)
+    criticalError(227, "object table sequential make after destroy.");
+  if (count == 0)
+    return first;
+  ObjectId last = first + count - 1;
+  while (idBound() <= last)
+    makeBlock();
+  for (ObjectId id = first; id <= last; id++)
+    pointer(id)->setObjectIdx(id & idx_mask_);
+  // makeBlock pushes new blocks on the front of the free list,
+  // so relink the objects after last in ID order.
+  free_ = object_id_null;
+  for (ObjectId id = idBound() - 1; id > last; id--)
+    freePush(pointer(id), id);
+  size_ += count;
+  return first;
+}
+
 template <class TYPE>
 void
 ObjectTable<TYPE>::freePush(TYPE *object,
@@ -111,7 +171,8 @@ void
 ObjectTable<TYPE>::makeBlock()
 {
   BlockIdx block_index = blocks_.size();
-  TableBlock<TYPE> *block = new TableBlock<TYPE>(block_index, this);
+  void *memory = tableBlockAlloc(sizeof(TableBlock<TYPE>));
+  TableBlock<TYPE> *block = new (memory) TableBlock<TYPE>(block_index, this);
   blocks_.push_back(block);
   if (blocks_.size() >= block_id_max)
     criticalError(224, "max object table block count exceeded.");
@@ -160,6 +221,24 @@ ObjectTable<TYPE>::objectId(const TYPE *object)
   return (blk->index() << idx_bits) + idx;
 }
 
+template <class TYPE>
+ObjectTableHot<TYPE> &
+ObjectTable<TYPE>::hot(TYPE *object)
+{
+  TableBlock<TYPE> *blk =
+    reinterpret_cast<TableBlock<TYPE>*>(object - object->objectIdx());
+  return blk->hot();
+}
+
+template <class TYPE>
+const ObjectTableHot<TYPE> &
+ObjectTable<TYPE>::hot(const TYPE *object)
+{
+  const TableBlock<TYPE> *blk =
+    reinterpret_cast<const TableBlock<TYPE>*>(object - object->objectIdx());
+  return blk->hot();
+}
+
 template <class TYPE>
 void
 ObjectTable<TYPE>::destroy(TYPE *object)
@@ -174,7 +253,7 @@ template <class TYPE>
 void
 ObjectTable<TYPE>::clear()
 {
-  blocks_.deleteContentsClear();
+  deleteBlocks();
   size_ = 0;
 }
 
@@ -189,9 +268,14 @@ public:
   BlockIdx index() const { return block_idx_; }
   TYPE &ref(ObjectIdx idx) { return objects_[idx]; }
   TYPE *pointer(ObjectIdx idx) { return &objects_[idx]; }
+  ObjectTableHot<TYPE> &hot() { return hot_; }
+  const ObjectTableHot<TYPE> &hot() const { return hot_; }
 
 private:
+  // objects_ must be first so an object's block is found from
+  // the object pointer and index.
   TYPE objects_[ObjectTable<TYPE>::block_object_count];
+  ObjectTableHot<TYPE> hot_;
   BlockIdx block_idx_;
   ObjectTable<TYPE> *table_;
 };
@@ -30,6 +30,7 @@ namespace sta {
 
 class Wireload;
 class Corner;
+class MemoryStats;
 
 typedef std::complex<float> ComplexFloat;
 typedef Vector<ComplexFloat> ComplexFloatSeq;
@@ -39,6 +40,32 @@ typedef std::vector<ParasiticCapacitor*> ParasiticCapacitorSeq;
 typedef std::map<ParasiticNode *, ParasiticResistorSeq> ParasiticNodeResistorMap;
 typedef std::map<ParasiticNode *, ParasiticCapacitorSeq> ParasiticNodeCapacitorMap;
 
+// Pluggable parasitic estimates for drivers without parasitics,
+// for example from placed pin locations. Estimates are made into pi
+// elmore models that are kept until the driver's reduced parasitics
+// are deleted, like wireload estimates.
+// Estimators are called by the delay calculation threads.
+class ParasiticEstimator
+{
+public:
+  virtual ~ParasiticEstimator() {}
+  // Return false if there is no estimate for drvr_pin.
+  virtual bool estimatePiElmore(const Pin *drvr_pin,
+                                const RiseFall *rf,
+                                const Corner *corner,
+                                const MinMax *min_max,
+                                // Return values.
+                                float &c2,
+                                float &rpi,
+                                float &c1) = 0;
+  // Elmore delay from drvr_pin to load_pin.
+  virtual float loadElmore(const Pin *drvr_pin,
+                           const Pin *load_pin,
+                           const RiseFall *rf,
+                           const Corner *corner,
+                           const MinMax *min_max) = 0;
+};
+
 // Parasitics API.
 // All parasitic parameters can have multiple values, each corresponding
 // to an analysis point.
@@ -48,13 +75,15 @@ class Parasitics : public StaState
 {
 public:
   Parasitics(StaState *sta);
-  virtual ~Parasitics() {}
+  virtual ~Parasitics();
   virtual bool haveParasitics() = 0;
   // Clear all state.
   virtual void clear() = 0;
 
   // Delete all parasitics.
   virtual void deleteParasitics() = 0;
+  // Add the memory used by the parasitics to stats.
+  virtual void memoryStats(MemoryStats &stats) const;
   // Delete all parasitics on net at analysis point.
   virtual void deleteParasitics(const Net *net,
 				const ParasiticAnalysisPt *ap) = 0;
@@ -185,6 +214,8 @@ public:
   virtual void incrCap(ParasiticNode *node,
 		       float cap) = 0;
   virtual const char *name(const ParasiticNode *node) const = 0;
+  // Subnode number of net:number nodes, 0 for pin nodes.
+  virtual int id(const ParasiticNode *node) const = 0;
   virtual const Pin *pin(const ParasiticNode *node) const = 0;
   virtual const Net *net(const ParasiticNode *node,
                          const Network *network) const = 0;
@@ -261,6 +292,15 @@ public:
 				 float fanout,
                                  const MinMax *min_max,
 				 const ParasiticAnalysisPt *ap);
+  ParasiticEstimator *estimator() const { return estimator_; }
+  // Parasitics takes ownership of estimator (may be null).
+  void setEstimator(ParasiticEstimator *estimator);
+  // Estimate parasitic as pi elmore using the estimator.
+  // Return null if there is no estimator or estimate.
+  Parasitic *estimatePiElmore(const Pin *drvr_pin,
+                              const RiseFall *rf,
+                              const Corner *corner,
+                              const MinMax *min_max);
   // Network edit before/after methods.
   virtual void disconnectPinBefore(const Pin *pin,
                                    const Network *network) = 0;
@@ -284,6 +324,8 @@ protected:
 				   float fanout);
 
   const Net *findParasiticNet(const Pin *pin) const;
+
+  ParasiticEstimator *estimator_;
 };
 
 // Managed by the Corner class.
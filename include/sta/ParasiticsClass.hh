@@ -19,6 +19,7 @@
 namespace sta {
 
 class Parasitics;
+class ParasiticEstimator;
 class Parasitic;
 class ParasiticNode;
 class ParasiticAnalysisPt;
@@ -24,6 +24,7 @@
 #include "SearchClass.hh"
 #include "PathRef.hh"
 #include "StaState.hh"
+#include "ObjectPool.hh"
 
 namespace sta {
 
@@ -64,6 +65,11 @@ public:
 
   virtual PathEnd *copy() = 0;
   virtual ~PathEnd();
+  // Path ends are made and deleted in large numbers, so they are
+  // allocated from the object pool.
+  static void *operator new(size_t size) { return objectPoolAlloc(size); }
+  static void operator delete(void *path_end,
+                              size_t size) { objectPoolFree(path_end, size); }
   void deletePath();
   Path *path() { return &path_; }
   const Path *path() const { return &path_; }
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
+#include "UnorderedMap.hh"
 #include "TimingArc.hh"
 #include "GraphClass.hh"
 #include "SearchClass.hh"
@@ -72,4 +76,63 @@ protected:
   const StaState *sta_;
 };
 
+// Paths and prev arcs from a clock path back to the clock source
+// in PathExpanded (reversed) order.
+class ClkPathExpansion
+{
+public:
+  PathRefSeq paths_;
+  TimingArcSeq prev_arcs_;
+};
+
+// Key is (vertex id, tag index) of the expanded clock path.
+typedef UnorderedMap<uint64_t, ClkPathExpansion> ClkPathExpansionMap;
+
+class ClkPathExpansionShard
+{
+public:
+  ClkPathExpansionShard();
+
+  std::mutex lock_;
+  ClkPathExpansionMap expansions_;
+  // ClkPathExpansions::epoch_ of expansions_.
+  unsigned epoch_;
+};
+
+// Clock path expansions shared by the PathExpanded of paths launched
+// from the same register clock pin paths so the clock tree is only
+// walked once. Only vertex paths are cached because their prev paths
+// are found from the graph.
+class ClkPathExpansions
+{
+public:
+  ClkPathExpansions();
+  // Forget the expansions of clock paths found before arrivals changed.
+  void clear();
+  // Append the expansion of clk_path to paths/prev_arcs.
+  // Return false if clk_path has not been expanded.
+  bool find(const PathRef &clk_path,
+	    const StaState *sta,
+	    // Return values.
+	    PathRefSeq &paths,
+	    TimingArcSeq &prev_arcs);
+  // Remember paths/prev_arcs from index begin as the expansion of
+  // clk_path.
+  void insert(const PathRef &clk_path,
+	      const PathRefSeq &paths,
+	      const TimingArcSeq &prev_arcs,
+	      size_t begin,
+	      const StaState *sta);
+
+protected:
+  ClkPathExpansionShard &shard(uint64_t key);
+  static uint64_t expansionKey(const PathRef &clk_path,
+			       const StaState *sta);
+
+  static constexpr int shard_count_ = 16;
+  static constexpr size_t shard_size_max_ = 1 << 14;
+  ClkPathExpansionShard shards_[shard_count_];
+  std::atomic<unsigned> epoch_;
+};
+
 } // namespace
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include "Map.hh"
@@ -28,6 +29,7 @@ namespace sta {
 
 class MinMax;
 class PathEndVisitor;
+class PathGroupsEndVisitor;
 
 typedef PathEndSeq::Iterator PathGroupIterator;
 typedef Map<const Clock*, PathGroup*> PathGroupClkMap;
@@ -57,6 +59,11 @@ public:
   const MinMax *minMax() const { return min_max_;}
   const PathEndSeq &pathEnds() const { return path_ends_; }
   void insert(PathEnd *path_end);
+  // Make an empty group with the same limits to collect path ends
+  // on one thread without sharing the group lock.
+  PathGroup *makeThreadGroup() const;
+  // Move the path ends of a group made by makeThreadGroup to this group.
+  void mergeThreadGroup(PathGroup *thread_group);
   // Push group_count into path_ends.
   void pushEnds(PathEndSeq &path_ends);
   // Predicates to determine if a PathEnd is worth saving.
@@ -77,8 +84,12 @@ protected:
 	    bool cmp_slack,
 	    const MinMax *min_max,
 	    const StaState *sta);
-  void ensureSortedMaxPaths();
-  void prune();
+  void insert1(PathEnd *path_end);
+  void replaceVertexEnd(PathEnd *path_end,
+                        Vertex *vertex);
+  void setThreshold(PathEnd *path_end);
+  float threshold() const;
+  void shareThreshold(float threshold) const;
   void sort();
 
   const char *name_;
@@ -87,10 +98,21 @@ protected:
   bool unique_pins_;
   float slack_min_;
   float slack_max_;
+  // Bounded heap of the group_count most critical path ends
+  // until the group is sorted.
   PathEndSeq path_ends_;
+  // Path ends in path_ends_ per vertex when endpoint_count limits them.
+  VertexPathCountMap path_counts_;
   const MinMax *min_max_;
   bool compare_slack_;
   float threshold_;
+  // Group of a copy made by makeThreadGroup.
+  const PathGroup *parent_;
+  // Most critical threshold reached by the group or its thread groups.
+  // Thread groups prune with it so path ends that cannot make the
+  // merged group are not copied.
+  mutable std::atomic<float> shared_threshold_;
+  bool sorted_;
   std::mutex lock_;
   const StaState *sta_;
 };
@@ -127,6 +149,17 @@ public:
   PathGroup *pathGroup(const PathEnd *path_end) const;
   static bool isGroupPathName(const char *group_name);
   static const char *asyncPathGroupName() { return async_group_name_; }
+  // Name of the group pathGroup finds for path_end without making the
+  // groups. Thread safe.
+  static const char *pathGroupName(const PathEnd *path_end,
+                                   const StaState *sta);
+  PathGroup *unconstrainedGroup(const MinMax *min_max) const
+  { return unconstrained_[min_max->index()]; }
+  // Unconstrained path ends are only reported when there are no
+  // constrained path ends, so stop collecting them once a constrained
+  // path end is in a group. Thread safe.
+  bool haveConstrainedEnds() const { return have_constrained_ends_; }
+  void setHaveConstrainedEnds() { have_constrained_ends_ = true; }
 
 protected:
   void makeGroupPathEnds(ExceptionTo *to,
@@ -138,11 +171,11 @@ protected:
   void makeGroupPathEnds(ExceptionTo *to,
 			 const Corner *corner,
 			 const MinMaxAll *min_max,
-			 PathEndVisitor *visitor);
-  void makeGroupPathEnds(VertexSet *endpoints,
+			 PathGroupsEndVisitor *visitor);
+  void makeGroupPathEnds(const VertexSeq &endpoints,
 			 const Corner *corner,
 			 const MinMaxAll *min_max,
-			 PathEndVisitor *visitor);
+			 PathGroupsEndVisitor *visitor);
   void enumPathEnds(PathGroup *group,
 		    int group_count,
 		    int endpoint_count,
@@ -166,7 +199,8 @@ protected:
 		  const MinMax *min_max);
   bool reportGroup(const char *group_name,
 		   PathGroupNameSet *group_names) const;
-  GroupPath *groupPathTo(const PathEnd *path_end) const;
+  static GroupPath *groupPathTo(const PathEnd *path_end,
+                                const StaState *sta);
 
   int group_count_;
   int endpoint_count_;
@@ -187,6 +221,7 @@ protected:
   PathGroup *async_[MinMax::index_count];
   // Unconstrained paths.
   PathGroup *unconstrained_[MinMax::index_count];
+  std::atomic<bool> have_constrained_ends_;
 
   static const char *path_delay_group_name_;
   static const char *gated_clk_group_name_;
@@ -47,6 +47,7 @@ public:
   void init(PathEnumed *path);
   virtual void setRef(PathRef *ref) const;
   virtual bool isNull() const;
+  bool isEnum() const { return path_enumed_ != nullptr; }
   virtual Vertex *vertex(const StaState *sta) const;
   virtual VertexId vertexId(const StaState *sta) const;
   virtual Tag *tag(const StaState *sta) const;
@@ -23,7 +23,8 @@ namespace sta {
 
 // Path representation that references a vertex arrival via a tag.
 // This does not implement the Path API which uses virtual functions
-// that would make it larger.
+// that would make it larger. Graph prev path arrays have one per
+// arrival, so it is kept to a vertex id and tag index (8 bytes).
 class PathVertexRep
 {
 public:
@@ -35,8 +36,7 @@ public:
   explicit PathVertexRep(const PathVertex &path,
 			 const StaState *sta);
   explicit PathVertexRep(VertexId vertex_id,
-			 TagIndex tag_index,
-			 bool is_enum);
+			 TagIndex tag_index);
   void init();
   void init(const PathVertexRep *path);
   void init(const PathVertexRep &path);
@@ -67,7 +67,6 @@ public:
 protected:
   VertexId vertex_id_;
   TagIndex tag_index_;
-  bool is_enum_:1;
 };
 
 } // namespace
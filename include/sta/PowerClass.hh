@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace sta {
 
 class Power;
@@ -26,6 +28,7 @@ enum class PwrActivityOrigin
  input,
  user,
  vcd,
+ saif,
  propagated,
  clock,
  constant,
@@ -80,4 +83,6 @@ private:
   float leakage_;
 };
 
+typedef std::vector<PowerResult> PowerResultSeq;
+
 } // namespace
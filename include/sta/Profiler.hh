@@ -0,0 +1,105 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sta {
+
+class Report;
+
+// Totals for a named profile scope and the scopes nested inside it.
+class ProfileScope
+{
+public:
+  explicit ProfileScope(const char *name);
+  ~ProfileScope();
+  const std::string &name() const { return name_; }
+  // Number of times the scope ran.
+  size_t count() const { return count_; }
+  // Run times in seconds.
+  double elapsed() const { return elapsed_; }
+  double user() const { return user_; }
+  double system() const { return system_; }
+  // Memory change over the scope runs and the peak memory
+  // at the end of a run in bytes.
+  double memoryDelta() const { return memory_delta_; }
+  size_t memoryPeak() const { return memory_peak_; }
+  const std::vector<ProfileScope*> &children() const { return children_; }
+
+protected:
+  ProfileScope *findChild(const std::string &name) const;
+  // Add the totals and children of scope to this and delete scope.
+  void merge(ProfileScope *scope);
+
+  std::string name_;
+  size_t count_;
+  double elapsed_;
+  double user_;
+  double system_;
+  double memory_delta_;
+  size_t memory_peak_;
+  std::vector<ProfileScope*> children_;
+
+  friend class Profiler;
+};
+
+// Hierarchical run time and memory profile of the phases timed by
+// sta::Stats. Scopes are named when they end, so scopes that end
+// inside another scope are nested under it. Runs of a scope with the
+// same name under the same parent are summed.
+// Scopes are begun and ended by the main thread.
+class Profiler
+{
+public:
+  Profiler();
+  ~Profiler();
+  bool enabled() const { return enabled_; }
+  void setEnabled(bool enabled);
+  void clear();
+  void begin();
+  // End the innermost scope and record it as name.
+  void end(const char *name);
+  // End the innermost scope without recording it.
+  // Scopes nested inside it move to its parent.
+  void discard();
+  const ProfileScope *root() const { return root_; }
+  void report(Report *report) const;
+  // Throws FileNotWritable.
+  void writeJson(const char *filename) const;
+
+private:
+  class Frame
+  {
+  public:
+    ProfileScope *scope_;
+    double elapsed_begin_;
+    double user_begin_;
+    double system_begin_;
+    size_t memory_begin_;
+  };
+
+  ProfileScope *parentScope() const;
+
+  bool enabled_;
+  ProfileScope *root_;
+  std::vector<Frame> frames_;
+};
+
+} // namespace
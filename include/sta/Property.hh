@@ -136,6 +136,13 @@ getProperty(const Pin *pin,
 	    const char *property,
 	    Sta *sta);
 
+// Values of the arrival_*, slack_* or slew_* property of each pin
+// found with the dispatch queue threads.
+FloatSeq
+getPropertyFloats(const PinSeq &pins,
+                  const char *property,
+                  Sta *sta);
+
 PropertyValue
 getProperty(const Net *net,
 	    const char *property,
@@ -112,9 +112,16 @@ public:
   virtual const char *redirectStringEnd();
   virtual void setTclInterp(Tcl_Interp *) {}
 
+  // Buffer console output until the matching bufferEnd so large
+  // reports are not written to the console a line at a time.
+  // Calls nest; the buffer is written by the outermost bufferEnd.
+  virtual void bufferBegin();
+  virtual void bufferEnd();
+
   // Primitive to print output.
   // Return the number of characters written.
   // public for use by ReportTcl encapsulated channel functions.
+  // Safe to call from multiple threads.
   virtual size_t printString(const char *buffer,
                              size_t length);
   static Report *defaultReport() { return default_; }
@@ -138,6 +145,10 @@ protected:
   void printToBufferAppend(const char *fmt,
                            va_list args);
   void printBufferLine();
+  // printString with print_lock_ held.
+  size_t printString1(const char *buffer,
+                      size_t length);
+  void flushConsoleBuffer();
   void redirectStringPrint(const char *buffer,
                            size_t length);
 
@@ -151,9 +162,33 @@ protected:
   // Length of string in buffer.
   size_t buffer_length_;
   std::mutex buffer_lock_;
+  // Console output between bufferBegin/bufferEnd.
+  int console_buffer_depth_;
+  string console_buffer_;
+  std::mutex print_lock_;
   static Report *default_;
 
   friend class Debug;
 };
 
+// Report that collects its lines in a string so reports can be
+// formatted on threads and printed in order by default_report.
+class ReportLines : public Report
+{
+public:
+  ReportLines(Report *default_report);
+  string &lines() { return redirect_string_; }
+};
+
+// Buffer console output for the lifetime of the object.
+class ReportBuffer
+{
+public:
+  ReportBuffer(Report *report);
+  ~ReportBuffer();
+
+private:
+  Report *report_;
+};
+
 } // namespace
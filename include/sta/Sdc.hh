@@ -22,6 +22,7 @@
 #include "StringSet.hh"
 #include "Map.hh"
 #include "UnorderedMap.hh"
+#include "ConcurrentIdMap.hh"
 #include "MinMax.hh"
 #include "StaState.hh"
 #include "NetworkClass.hh"
@@ -37,6 +38,7 @@
 namespace sta {
 
 class OperatingConditions;
+class MemoryStats;
 class PortExtCap;
 class ClockGatingCheck;
 class InputDriveCell;
@@ -120,13 +122,15 @@ typedef Set<OutputDelay*> OutputDelaySet;
 typedef Map<const Pin*,OutputDelaySet*, PinIdLess> OutputDelaysPinMap;
 typedef UnorderedMap<const Pin*,ExceptionPathSet*> PinExceptionsMap;
 typedef Map<const Clock*,ExceptionPathSet*> ClockExceptionsMap;
-typedef Map<const Instance*,ExceptionPathSet*> InstanceExceptionsMap;
-typedef Map<const Net*,ExceptionPathSet*> NetExceptionsMap;
+// Exception point maps are probed for every edge the search crosses,
+// so they are hashed.
+typedef UnorderedMap<const Instance*,ExceptionPathSet*> InstanceExceptionsMap;
+typedef UnorderedMap<const Net*,ExceptionPathSet*> NetExceptionsMap;
 typedef UnorderedMap<EdgePins, ExceptionPathSet*,
 		     PinPairHash, PinPairEqual> EdgeExceptionsMap;
 typedef Vector<ExceptionThru*> ExceptionThruSeq;
 typedef Map<const Port*,InputDrive*> InputDriveMap;
-typedef Map<int, ExceptionPathSet*, std::less<int> > ExceptionPathPtHash;
+typedef UnorderedMap<size_t, ExceptionPathSet*> ExceptionPathPtHash;
 typedef Set<ClockLatency*, ClockLatencyLess> ClockLatencies;
 typedef Map<const Pin*, ClockUncertainties*> PinClockUncertaintyMap;
 typedef Set<InterClockUncertainty*, InterClockUncertaintyLess> InterClockUncertaintySet;
@@ -183,6 +187,8 @@ class Sdc : public StaState
 public:
   explicit Sdc(StaState *sta);
   ~Sdc();
+  // Keep sdc_ pointing at this sdc when it is not the current mode.
+  virtual void copyState(const StaState *sta);
   // Note that Search may reference a Filter exception removed by clear().
   void clear();
   void makeCornersBefore();
@@ -241,6 +247,17 @@ public:
   void unsetTimingDerate();
   static void swapDeratingFactors(Sdc *sdc1,
                                   Sdc *sdc2);
+  const DeratingFactorsGlobal *deratingFactors() const { return derating_factors_; }
+  // Incremented when any derating factor changes.
+  int deratingFactorsVersion() const { return derating_factors_version_; }
+  // True if there are instance, cell or net derating factors.
+  bool hasLocalDeratingFactors() const;
+  // Instance, cell and net derating factors that apply to pin (null if none).
+  void pinDeratingFactors(const Pin *pin,
+                          // Return values.
+                          const DeratingFactorsCell *&inst_factors,
+                          const DeratingFactorsCell *&cell_factors,
+                          const DeratingFactorsNet *&net_factors) const;
 
   void setInputSlew(const Port *port,
                     const RiseFallBoth *rf,
@@ -1028,12 +1045,18 @@ public:
   const PinSet &pathDelayInternalStartpoints() const;
   bool isPathDelayInternalEndpoint(const Pin *pin) const;
   ExceptionPathSet *exceptions() { return &exceptions_; }
+  // Add the memory used by exceptions to stats.
+  void memoryStats(MemoryStats &stats) const;
   void deleteExceptions();
   void deleteException(ExceptionPath *exception);
   void recordException(ExceptionPath *exception);
   void unrecordException(ExceptionPath *exception);
   void annotateGraph();
   void removeGraphAnnotations();
+  // set_disable_timing on library cells and ports marks the shared
+  // liberty objects, so modes swap these annotations when they switch.
+  void annotateLiberty();
+  void removeLibertyAnnotations();
 
   // Network edit before/after methods.
   void disconnectPinBefore(const Pin *pin);
@@ -1048,7 +1071,7 @@ public:
 protected:
   void initVariables();
   void clearCycleAcctings();
-  void removeLibertyAnnotations();
+  void setLibertyAnnotations(bool disabled);
   void deleteExceptionsReferencing(Clock *clk);
   void deleteClkPinMappings(Clock *clk);
   void deleteExceptionPtHashMapSets(ExceptionPathPtHash &map);
@@ -1102,6 +1125,8 @@ protected:
   void recordExceptionFirstFrom(ExceptionPath *exception);
   void recordExceptionFirstThru(ExceptionPath *exception);
   void recordExceptionFirstTo(ExceptionPath *exception);
+  void recordMergedFirstPt(ExceptionPath *exception,
+			   ExceptionPt *merged_pt);
   void recordExceptionClks(ExceptionPath *exception,
 			   ClockSet *clks,
 			   ClockExceptionsMap &exception_map);
@@ -1285,6 +1310,7 @@ protected:
   NetDeratingFactorsMap net_derating_factors_;
   InstDeratingFactorsMap inst_derating_factors_;
   CellDeratingFactorsMap cell_derating_factors_;
+  int derating_factors_version_;
   // Clock sequence retains clock definition order.
   // This is important for getting consistent regression results,
   // which iterating over the name map can't provide.
@@ -1317,7 +1343,6 @@ protected:
   InstanceClockGatingCheckMap inst_clk_gating_check_map_;
   PinClockGatingCheckMap pin_clk_gating_check_map_;
   CycleAcctings cycle_acctings_;
-  std::mutex cycle_acctings_lock_;
   DataChecksMap data_checks_from_map_;
   DataChecksMap data_checks_to_map_;
 
@@ -1326,6 +1351,8 @@ protected:
   InputDelaysPinMap input_delay_ref_pin_map_;
   // Input delays on hierarchical pins are indexed by the load pins.
   InputDelaysPinMap input_delay_leaf_pin_map_;
+  // input_delay_leaf_pin_map_ indexed by pin id for search lookups.
+  ConcurrentIdMap<InputDelaySet*> input_delay_leaf_pin_index_;
   InputDelaysPinMap input_delay_internal_pin_map_;
   int input_delay_index_;
 
@@ -1334,6 +1361,8 @@ protected:
   OutputDelaysPinMap output_delay_ref_pin_map_;
   // Output delays on hierarchical pins are indexed by the load pins.
   OutputDelaysPinMap output_delay_leaf_pin_map_;
+  // output_delay_leaf_pin_map_ indexed by pin id for search lookups.
+  ConcurrentIdMap<OutputDelaySet*> output_delay_leaf_pin_index_;
 
   PortSlewLimitMap port_slew_limit_map_;
   CellSlewLimitMap cell_slew_limit_map_;
@@ -1390,6 +1419,8 @@ protected:
   // Group path exception names.
   GroupPathMap group_path_map_;
   InputDriveMap input_drive_map_;
+  // input_drive_map_ indexed by port id for delay calc lookups.
+  ConcurrentIdMap<InputDrive*> input_drive_index_;
   // set_LogicValue::one/zero/dc
   LogicValueMap logic_value_map_;
   // set_case_analysis
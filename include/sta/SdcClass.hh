@@ -83,6 +83,8 @@ typedef Vector<PinSet*> PinSetSeq;
 typedef MinMax SetupHold;
 typedef MinMaxAll SetupHoldAll;
 typedef Vector<ExceptionThru*> ExceptionThruSeq;
+typedef Vector<ExceptionFrom*> ExceptionFromSeq;
+typedef Vector<FilterPath*> FilterPathSeq;
 typedef Set<LibertyPortPair, LibertyPortPairLess> LibertyPortPairSet;
 typedef Map<const Instance*, DisabledInstancePorts*> DisabledInstancePortsMap;
 typedef Map<const LibertyCell*, DisabledCellPorts*> DisabledCellPortsMap;
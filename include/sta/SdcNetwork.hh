@@ -192,11 +192,17 @@ public:
 
   const char *name(const Instance *instance) const override;
   const char *pathName(const Instance *instance) const override;
+  void appendPathName(const Instance *instance,
+                      string &path_name) const override;
   const char *pathName(const Pin *pin) const override;
+  void appendPathName(const Pin *pin,
+                      string &path_name) const override;
   const char *portName(const Pin *pin) const override;
 
   const char *name(const Net *net) const override;
   const char *pathName(const Net *net) const override;
+  void appendPathName(const Net *net,
+                      string &path_name) const override;
 
   Instance *findInstance(const char *path_name) const override;
   InstanceSeq findInstancesMatching(const Instance *context,
@@ -260,6 +266,9 @@ protected:
                               InstanceSeq &matches) const;
 
   const char *staToSdc(const char *sta_name) const;
+  // Translate path_name from index start in place.
+  void staToSdc(string &path_name,
+                size_t start) const;
 };
 
 // Encapsulate a network to map names to/from the sdc namespace.
@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
+#include <set>
+#include <utility>
 
 #include "MinMax.hh"
 #include "UnorderedSet.hh"
+#include "ConcurrentHashSet.hh"
+#include "ConcurrentIdSet.hh"
 #include "Transition.hh"
 #include "LibertyClass.hh"
 #include "NetworkClass.hh"
@@ -51,14 +56,36 @@ class DcalcAnalysisPt;
 class VisitPathEnds;
 class GatedClk;
 class CheckCrpr;
+class ClkLatencyIndex;
+class DerateIndex;
+class ClkPathExpansions;
 class Genclks;
 class Corner;
+class MemoryStats;
+
+class ExceptionStateSetHash
+{
+public:
+  size_t operator()(const ExceptionStateSet *states) const;
+};
+
+class ExceptionStateSetEqual
+{
+public:
+  bool operator()(const ExceptionStateSet *states1,
+                  const ExceptionStateSet *states2) const;
+};
 
 typedef Set<ClkInfo*, ClkInfoLess> ClkInfoSet;
-typedef UnorderedSet<Tag*, TagHash, TagEqual> TagSet;
-typedef UnorderedSet<TagGroup*, TagGroupHash, TagGroupEqual> TagGroupSet;
+typedef UnorderedSet<ExceptionStateSet*, ExceptionStateSetHash,
+                     ExceptionStateSetEqual> ExceptionStateSetPool;
+typedef ConcurrentHashSet<Tag, TagHash, TagEqual> TagSet;
+typedef ConcurrentHashSet<TagGroup, TagGroupHash, TagGroupEqual> TagGroupSet;
 typedef Map<Vertex*, Slack> VertexSlackMap;
 typedef Vector<VertexSlackMap> VertexSlackMapSeq;
+// Negative slack endpoints ordered by slack (worst first) and vertex id.
+typedef std::set<std::pair<float, VertexId>> SlackVertexIdSet;
+typedef Vector<SlackVertexIdSet> SlackVertexIdSetSeq;
 typedef Vector<WorstSlacks> WorstSlacksSeq;
 
 class Search : public StaState
@@ -78,6 +105,24 @@ public:
   // disables additional search to returns approximate required times.
   bool crprApproxMissingRequireds() const;
   void setCrprApproxMissingRequireds(bool enabled);
+  // Path pruning also prunes arrivals within margin of being pruned.
+  // Slacks are optimistic by at most the margin.
+  float crprPruneMargin() const { return crpr_prune_margin_; }
+  void setCrprPruneMargin(float margin);
+  // Incremental required time updates stop at vertices whose required
+  // times change by no more than the tolerance; the previous required
+  // times are kept. Zero only stops at unchanged required times.
+  float requiredTolerance() const { return required_tolerance_; }
+  void setRequiredTolerance(float tolerance);
+  // Copy the options above from search. Arrivals are invalid if the
+  // path pruning options differ.
+  void copyOptions(const Search *search);
+  // No arrivals or requireds are queued and there is no filter, so the
+  // search can be put aside and used again later.
+  bool isIdle() const;
+  // The vertex path arrays were moved out of the graph and are
+  // deleted separately, so deleting the search leaves them alone.
+  void pathsReleased();
 
   bool unconstrainedPaths() const { return unconstrained_paths_; }
   // from/thrus/to are owned and deleted by Search.
@@ -105,12 +150,22 @@ public:
   bool arrivalsValid();
   // Invalidate all arrival and required times.
   void arrivalsInvalid();
+  // Number of arrivalsInvalid calls, which constraint changes make,
+  // so that clients can tell when their own results are stale.
+  int arrivalsInvalidCount() const { return arrivals_invalid_count_; }
+  // Number of arrival, required and endpoint invalidations of any kind,
+  // so that clients can tell when any search result is stale.
+  size_t invalidCount() const { return invalid_count_; }
   // Invalidate vertex arrival time.
   void arrivalInvalid(Vertex *vertex);
   void arrivalInvalidDelete(Vertex *vertex);
   void arrivalInvalid(const Pin *pin);
   // Invalidate all required times.
   void requiredsInvalid();
+  // Re-pack the vertex path arrays and delete the blocks of deleted
+  // arrays. Pointers to arrivals, requireds and prev paths are invalid
+  // after compacting.
+  void compactPaths();
   // Invalidate vertex required time.
   void requiredInvalid(Vertex *vertex);
   void requiredInvalid(const Instance *inst);
@@ -133,6 +188,15 @@ public:
   Slack totalNegativeSlack(const MinMax *min_max);
   Slack totalNegativeSlack(const Corner *corner,
 			   const MinMax *min_max);
+  // Number of endpoints with negative slack for corner (all corners
+  // if corner is null). Incrementally updated with the tns.
+  int negativeSlackEndpointCount(const Corner *corner,
+                                 const MinMax *min_max);
+  // Up to count endpoints with negative slack, worst first.
+  // Incrementally updated with the tns.
+  VertexSeq worstNegativeSlackEndpoints(const Corner *corner,
+                                        const MinMax *min_max,
+                                        int count);
   // Worst endpoint slack and vertex.
   // Incrementally updated.
   void worstSlack(const MinMax *min_max,
@@ -166,9 +230,20 @@ public:
 				     bool require_to_pin) const;
   FilterPath *filter() const { return filter_; }
   void deleteFilter();
+  // True unless the filtered search is bounded by the fanin cone of
+  // the -to pins and vertex is outside of it.
+  bool inFilterToCone(const Vertex *vertex) const;
   void deleteFilteredArrivals();
+  // Delete the filtered arrivals unless the last filter has the same
+  // -from/-through so they can be reused for a different -to.
+  void deleteFilteredArrivals(ExceptionFrom *from,
+                              ExceptionThruSeq *thrus,
+                              bool unconstrained);
 
   VertexSet *endpoints();
+  // Endpoints in vertex id order in a dense array for visiting
+  // all endpoints.
+  const VertexSeq &endpointSeq();
   void endpointsInvalid();
 
   // Clock tree vertices between the clock source pin and register clk pins.
@@ -207,6 +282,8 @@ public:
   void reportTagGroups() const;
   void reportArrivalCountHistogram() const;
   virtual int clkInfoCount() const;
+  // Add the memory used by tags, tag groups and clk infos to stats.
+  void memoryStats(MemoryStats &stats) const;
   virtual bool isEndpoint(Vertex *vertex) const;
   virtual bool isEndpoint(Vertex *vertex,
 			  SearchPred *pred) const;
@@ -301,6 +378,9 @@ public:
 	       ExceptionStateSet *states,
 	       bool own_states);
   void reportTags() const;
+  // Tag counts by clock edge, exception, crpr clock pin and input delay
+  // reference pin, max_count largest of each.
+  void reportTagSummary(size_t max_count) const;
   void reportClkInfos() const;
   virtual ClkInfo *findClkInfo(const ClockEdge *clk_edge,
 			       const Pin *clk_src,
@@ -341,6 +421,10 @@ public:
   bool matchesFilter(Path *path,
 		     const ClockEdge *to_clk_edge);
   CheckCrpr *checkCrpr() { return check_crpr_; }
+  ClkLatencyIndex *clkLatencyIndex() { return clk_latency_index_; }
+  // Network changed so the derate index is rebuilt before the next search.
+  void deratesInvalid();
+  ClkPathExpansions *clkPathExpansions() const { return clk_path_expansions_; }
   VisitPathEnds *visitPathEnds() { return visit_path_ends_; }
   GatedClk *gatedClk() { return gated_clk_; }
   Genclks *genclks() { return genclks_; }
@@ -350,6 +434,12 @@ public:
                             ExceptionTo *to,
                             bool unconstrained,
                             bool thru_latches);
+  // Find the arrivals of paths from each of froms (pins) in one search.
+  // Paths from each from are tagged with a separate filter exception so
+  // they are not merged with paths from the other froms.
+  // Returns the filters in froms order.
+  const FilterPathSeq &findFilteredArrivals(const ExceptionFromSeq &froms,
+                                            bool thru_latches);
   VertexSeq filteredEndpoints();
 
 protected:
@@ -478,6 +568,11 @@ protected:
   void findFilteredArrivals(bool thru_latches);
   void findArrivalsSeed();
   void seedFilterStarts();
+  void findFilterToCone();
+  bool filterMatches(ExceptionFrom *from,
+                     ExceptionThruSeq *thrus,
+                     bool unconstrained) const;
+  void seedFilterStarts(FilterPath *filter);
   bool hasEnabledChecks(Vertex *vertex) const;
   virtual float timingDerate(Vertex *from_vertex,
 			     TimingArc *arc,
@@ -486,10 +581,16 @@ protected:
 			     const PathAnalysisPt *path_ap);
   void deletePaths();
   void deletePaths(Vertex *vertex);
+  void deleteVertexPaths(Vertex *vertex);
   TagGroup *findTagGroup(TagGroupBldr *group_bldr);
   void deleteFilterTags();
+  ExceptionStateSet *internStates(ExceptionStateSet *states,
+                                  bool own_states);
   void deleteFilterTagGroups();
   void deleteFilterClkInfos();
+  int clkInfoShard(const ClockEdge *clk_edge,
+                   const Pin *clk_src,
+                   const PathAnalysisPt *path_ap) const;
 
   void tnsPreamble();
   void findTotalNegativeSlacks();
@@ -539,6 +640,8 @@ protected:
   bool unconstrained_paths_;
   bool crpr_path_pruning_enabled_;
   bool crpr_approx_missing_requireds_;
+  float crpr_prune_margin_;
+  float required_tolerance_;
   // Search predicates.
   SearchPred *search_adj_;
   SearchPred *search_clk_;
@@ -548,6 +651,9 @@ protected:
   bool clk_arrivals_valid_;
   // Some arrivals exist.
   bool arrivals_exist_;
+  int arrivals_invalid_count_;
+  // Incremented by delay calc threads through StaDelayCalcObserver.
+  std::atomic<size_t> invalid_count_;
   // Arrivals at end points exist (but may be invalid).
   bool arrivals_at_endpoints_exist_;
   // Arrivals at start points have been initialized.
@@ -556,12 +662,14 @@ protected:
   bool requireds_exist_;
   // Requireds have been seeded by searching arrivals to all endpoints.
   bool requireds_seeded_;
-  // Vertices with invalid arrival times to update and search from.
-  VertexSet *invalid_arrivals_;
+  // Ids of vertices with invalid arrival times to update and search
+  // from. Lock free for StaDelayCalcObserver called by delay calc threads.
+  ConcurrentIdSet *invalid_arrivals_;
+  // Guards invalid_requireds_.
   std::mutex invalid_arrivals_lock_;
   BfsFwdIterator *arrival_iter_;
   // Vertices with invalid required times to update and search from.
-  VertexSet *invalid_requireds_;
+  VertexUnorderedSet *invalid_requireds_;
   BfsBkwdIterator *required_iter_;
   bool tns_exists_;
   // Endpoint vertices with slacks that have changed since tns was found.
@@ -570,13 +678,21 @@ protected:
   SlackSeq tns_;
   // Indexed by path_ap->index().
   VertexSlackMapSeq tns_slacks_;
+  // Indexed by path_ap->index().
+  SlackVertexIdSetSeq tns_slack_order_;
   std::mutex tns_lock_;
   // Indexed by path_ap->index().
   WorstSlacks *worst_slacks_;
   // Use pointer to clk_info set so Tag.hh does not need to be included.
-  ClkInfoSet *clk_info_set_;
-  std::mutex clk_info_lock_;
+  // Clk infos are sharded by clock edge, path analysis point and clock
+  // source so threads finding clk infos for different clocks do not
+  // contend for the same lock.
+  static constexpr int clk_info_shard_count_ = 16;
+  ClkInfoSet *clk_info_sets_[clk_info_shard_count_];
+  std::mutex clk_info_locks_[clk_info_shard_count_];
   // Use pointer to tag set so Tag.hh does not need to be included.
+  // Tags and tag groups are found without locking; tag_lock_ and
+  // tag_group_lock_ serialize making new ones.
   TagSet *tag_set_;
   // Entries in tags_ may be missing where previous filter tags were deleted.
   TagIndex tag_capacity_;
@@ -585,6 +701,9 @@ protected:
   // Holes in tags_ left by deleting filter tags.
   std::vector<TagIndex> tag_free_indices_;
   std::mutex tag_lock_;
+  // Tag exception state sets shared by tags with the same states.
+  // Protected by tag_lock_.
+  ExceptionStateSetPool tag_states_;
   TagGroupSet *tag_group_set_;
   TagGroup **tag_groups_;
   TagGroupIndex tag_group_next_;
@@ -594,10 +713,13 @@ protected:
   TagGroupIndex tag_group_capacity_;
   std::mutex tag_group_lock_;
   // Latches data outputs to queue on the next search pass.
-  VertexSet *pending_latch_outputs_;
-  std::mutex pending_latch_outputs_lock_;
+  // Latch outputs to search on the next pass.
+  ConcurrentIdSet *pending_latch_outputs_;
   VertexSet *endpoints_;
   VertexSet *invalid_endpoints_;
+  // endpoints_ in id order; rebuilt when endpoints are added or removed.
+  VertexSeq endpoint_seq_;
+  bool endpoint_seq_valid_;
   // Filter exception to tag arrivals for
   // report_timing -from pin|inst -through.
   // -to is always nullptr.
@@ -605,12 +727,25 @@ protected:
   // filter_from_ is owned by filter_ if it exists.
   ExceptionFrom *filter_from_;
   ExceptionTo *filter_to_;
-  VertexSet *filtered_arrivals_;
+  // Filter exceptions for each from searched in one pass.
+  FilterPathSeq filters_;
+  VertexUnorderedSet *filtered_arrivals_;
+  // Fanin cone of the -to pins that bounds the filtered search.
+  // Empty when the search is not bounded.
+  ConcurrentIdSet *filter_to_cone_;
+  // The last filtered search was bounded by the -to cone.
+  bool filter_bounded_;
+  // The filter has the same -from/-through as the last one, so do not
+  // bound the search and keep the arrivals for the next query.
+  bool filter_repeated_;
   bool found_downstream_clk_pins_;
   PathGroups *path_groups_;
   VisitPathEnds *visit_path_ends_;
   GatedClk *gated_clk_;
   CheckCrpr *check_crpr_;
+  ClkLatencyIndex *clk_latency_index_;
+  DerateIndex *derate_index_;
+  ClkPathExpansions *clk_path_expansions_;
   Genclks *genclks_;
 };
 
@@ -652,6 +787,14 @@ public:
   virtual void visitFanoutPaths(Vertex *from_vertex);
 
 protected:
+  // Edge loops of visitFaninPaths/visitFanoutPaths. PRED is SearchPred
+  // for virtual predicate calls or a BoundSearchPred.
+  template <class PRED>
+  void visitFaninEdges(Vertex *to_vertex,
+                       PRED &pred);
+  template <class PRED>
+  void visitFanoutEdges(Vertex *from_vertex,
+                        PRED &pred);
   // Return false to stop visiting.
   virtual bool visitEdge(const Pin *from_pin, Vertex *from_vertex,
 			 Edge *edge, const Pin *to_pin, Vertex *to_vertex);
@@ -710,6 +853,8 @@ public:
   void init(bool always_to_endpoints,
 	    SearchPred *pred);
   virtual void visit(Vertex *vertex);
+  // Find the fanin arrivals of each path analysis point in parallel.
+  virtual void visitNarrow(Vertex *vertex);
   virtual VertexVisitor *copy() const;
   // Return false to stop visiting.
   virtual bool visitFromToPath(const Pin *from_pin,
@@ -734,6 +879,20 @@ protected:
 		 SearchPred *pred,
 		 const StaState *sta);
   void init0();
+  void findFaninArrivals(Vertex *vertex);
+  void findFaninArrivalsParallel(Vertex *vertex);
+  void saveArrivals(Vertex *vertex);
+  virtual bool visitFromPath(const Pin *from_pin,
+			     Vertex *from_vertex,
+			     const RiseFall *from_rf,
+			     PathVertex *from_path,
+			     Edge *edge,
+			     TimingArc *arc,
+			     const Pin *to_pin,
+			     Vertex *to_vertex,
+			     const RiseFall *to_rf,
+			     const MinMax *min_max,
+			     const PathAnalysisPt *path_ap);
   void enqueueRefPinInputDelays(const Pin *ref_pin);
   void seedInputDelayArrival(const Pin *pin,
 			     Vertex *vertex,
@@ -747,6 +906,10 @@ protected:
   SearchPred *adj_pred_;
   bool crpr_active_;
   bool has_fanin_one_;
+  // Only visit paths of this path analysis point unless negative.
+  int path_ap_index_;
+  // Visitors for each path analysis point used by visitNarrow.
+  std::vector<ArrivalVisitor*> path_ap_visitors_;
 };
 
 class RequiredCmp
@@ -62,6 +62,7 @@ class CharPtrLess;
 class SearchPred;
 class BfsFwdIterator;
 class ClkDelays;
+class ClkLatencyStats;
 
 // Tag compare using tag matching (tagMatch) critera.
 class TagMatchLess
@@ -51,6 +51,25 @@ public:
   virtual bool searchTo(const Vertex *to_vertex) = 0;
 };
 
+// Search predicate with the calls bound to PRED instead of dispatched
+// virtually so the templated edge loops (BfsFwdIterator, PathVisitor)
+// can inline them. pred must not be an instance of a PRED subclass
+// that overrides its functions.
+template <class PRED>
+class BoundSearchPred
+{
+public:
+  explicit BoundSearchPred(PRED *pred) : pred_(pred) {}
+  bool searchFrom(const Vertex *from_vertex)
+  { return pred_->PRED::searchFrom(from_vertex); }
+  bool searchThru(Edge *edge) { return pred_->PRED::searchThru(edge); }
+  bool searchTo(const Vertex *to_vertex)
+  { return pred_->PRED::searchTo(to_vertex); }
+
+private:
+  PRED *pred_;
+};
+
 class SearchPred0 : public SearchPred
 {
 public:
@@ -0,0 +1,85 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace sta {
+
+class Report;
+
+// Counters for tuning search and delay calculation.
+// Counting is off until enabled so uncounted updates only test a flag.
+// Counters are relaxed atomics so threads count without locks.
+class SearchStats
+{
+public:
+  enum Counter {
+    bfs_passes,
+    bfs_vertices,
+    bfs_parallel_levels,
+    bfs_parallel_level_vertices,
+    bfs_serial_levels,
+    bfs_serial_level_vertices,
+    arrival_visits,
+    arrivals_changed,
+    latch_passes,
+    latch_outputs_pending,
+    tag_lookups,
+    tags_made,
+    tag_group_lookups,
+    tag_groups_made,
+    clk_info_lookups,
+    clk_infos_made,
+    dcalc_drvr_vertices,
+    dcalc_gate_delays,
+    dcalc_load_delays,
+    dcalc_loads_unchanged,
+    dcalc_drvrs_skipped,
+    dmp_ceff_cache_lookups,
+    dmp_ceff_cache_reuses,
+    ccs_sim_factor_lookups,
+    ccs_sim_factor_reuses,
+    counter_count
+  };
+
+  SearchStats();
+  bool enabled() const { return enabled_; }
+  void setEnabled(bool enabled);
+  void clear();
+  void incr(Counter counter)
+  {
+    if (enabled_)
+      counts_[counter].fetch_add(1, std::memory_order_relaxed);
+  }
+  void incr(Counter counter,
+            uint64_t count)
+  {
+    if (enabled_)
+      counts_[counter].fetch_add(count, std::memory_order_relaxed);
+  }
+  uint64_t count(Counter counter) const;
+  void report(int thread_count,
+              Report *report) const;
+
+private:
+  bool enabled_;
+  std::atomic<uint64_t> counts_[counter_count];
+};
+
+} // namespace
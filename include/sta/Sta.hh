@@ -17,6 +17,7 @@
 #pragma once
 
 #include <string>
+#include <thread>
 
 #include "StringSeq.hh"
 #include "LibertyClass.hh"
@@ -27,6 +28,7 @@
 #include "StaState.hh"
 #include "VertexVisitor.hh"
 #include "SearchClass.hh"
+#include "EndpointSlack.hh"
 #include "PowerClass.hh"
 
 struct Tcl_Interp;
@@ -56,13 +58,21 @@ class LibertyReader;
 class SearchPred;
 class Corner;
 class ClkSkews;
+class RegClkPinCache;
 class ReportField;
 class EquivCells;
+class EquivCellKey;
+class WhatIfEdits;
+class TimingProgress;
+class ModeTiming;
 
 typedef InstanceSeq::Iterator SlowDrvrIterator;
 typedef Vector<const char*> CheckError;
 typedef Vector<CheckError*> CheckErrorSeq;
 typedef Vector<Corner*> CornerSeq;
+typedef Map<const char*, Sdc*, CharPtrLess> ModeSdcMap;
+typedef Map<const Sdc*, ModeTiming*> ModeTimingMap;
+typedef Vector<Sdc*> SdcSeq;
 
 enum class CmdNamespace { sta, sdc };
 
@@ -103,11 +113,107 @@ public:
   // Default number of threads to use.
   virtual int defaultThreadCount() const;
   void setThreadCount(int thread_count);
+  // TCL variable sta_thread_pinning.
+  // Bind the worker threads to processors spread over the NUMA nodes.
+  bool threadPinning() const;
+  void setThreadPinning(bool enabled);
+  // TCL variable sta_bfs_work_stealing.
+  // Threads visiting a BFS level take small chunks of vertices and
+  // steal chunks from other threads when their own share is done.
+  bool bfsWorkStealing() const;
+  void setBfsWorkStealing(bool enabled);
+  // TCL variable sta_bfs_dependency_driven.
+  // Parallel BFS visits release each vertex to the thread pool as soon
+  // as all of its predecessors have been visited rather than waiting
+  // for the whole previous level to finish.
+  bool bfsDependencyDriven() const;
+  void setBfsDependencyDriven(bool enabled);
+  // TCL variable sta_bfs_prefetch_distance.
+  // Parallel BFS level walks prefetch the vertices this many positions
+  // ahead of the visit and the path visitors prefetch the fanin/fanout
+  // paths. 0 disables prefetching.
+  int bfsPrefetchDistance() const;
+  void setBfsPrefetchDistance(int distance);
+  // TCL variable sta_levelize_parallel.
+  // Levelize with a parallel topological sort when thread count > 1.
+  bool levelizeParallel() const;
+  void setLevelizeParallel(bool enabled);
+  // TCL variable sta_levelize_scc.
+  // Find all combinational loops with a strongly connected component
+  // search and break each component with a small set of feedback edges
+  // instead of breaking loops one at a time as levelization finds them.
+  bool levelizeScc() const;
+  void setLevelizeScc(bool enabled);
+  // TCL variable sta_sim_parallel.
+  // Propagate logic constants one wave of instances at a time with the
+  // instances in a wave evaluated in parallel when thread count > 1.
+  bool simParallel() const;
+  void setSimParallel(bool enabled);
+  // TCL variable sta_search_path_ap_parallel.
+  // Arrivals of vertices in search levels narrower than the thread
+  // count are found with a thread for each path analysis point
+  // (corner and min/max), which helps designs with many corners.
+  bool searchPathApParallel() const;
+  void setSearchPathApParallel(bool enabled);
+  // TCL variable sta_graph_adjacency_snapshot.
+  // Keep a contiguous snapshot of the graph edges that edge iterators
+  // use while the netlist is unchanged. Netlist edits invalidate the
+  // snapshot and it is rebuilt by the next command that uses the graph.
+  bool graphAdjacencySnapshot() const;
+  void setGraphAdjacencySnapshot(bool enabled);
+  // TCL variable sta_graph_level_order.
+  // Number the graph vertices and edges in level order so searches
+  // visit them in id order. The graph is made twice, once to find the
+  // levels. Applies to graphs made after it is set.
+  bool graphLevelOrder() const;
+  void setGraphLevelOrder(bool enabled);
+  // TCL variable sta_keep_mode_timing.
+  // Keep the arrivals, required times and delays of a mode when
+  // switching to another mode so switching back does not search
+  // again. Netlist edits discard the kept timing.
+  bool keepModeTiming() const;
+  void setKeepModeTiming(bool keep);
+  // TCL variable sta_spef_read_parallel.
+  // Build SPEF D_NET parasitic networks with worker threads when
+  // thread count > 1.
+  bool spefReadParallel() const;
+  void setSpefReadParallel(bool enabled);
+  // TCL variable sta_verilog_link_parallel.
+  // Make the leaf instances of verilog modules with worker threads
+  // when linking and thread count > 1.
+  bool verilogLinkParallel() const;
+  void setVerilogLinkParallel(bool enabled);
+  // TCL variable sta_liberty_lazy_load.
+  // Read liberty cells when they are first referenced instead of
+  // when the library is read.
+  bool libertyLazyLoad() const;
+  void setLibertyLazyLoad(bool enabled);
+  // TCL variable sta_liberty_read_parallel.
+  // Build liberty cells, timing arcs and models with worker threads
+  // while the library is parsed when thread count > 1.
+  bool libertyReadParallel() const;
+  void setLibertyReadParallel(bool enabled);
 
   virtual LibertyLibrary *readLiberty(const char *filename,
 				      Corner *corner,
 				      const MinMaxAll *min_max,
 				      bool infer_latches);
+  // Read liberty files in order. File text is read ahead by worker
+  // threads while the libraries are parsed, mapped to corners and
+  // registered serially.
+  LibertyLibrarySeq readLiberty(const StringSeq &filenames,
+                                Corner *corner,
+                                const MinMaxAll *min_max,
+                                bool infer_latches);
+  // Parse liberty_filename and write it to a binary liberty db file
+  // that readLibertyDb reads without parsing the liberty text.
+  void writeLibertyDb(const char *liberty_filename,
+                      const char *filename);
+  // Read a liberty db file written by writeLibertyDb.
+  LibertyLibrary *readLibertyDb(const char *filename,
+                                Corner *corner,
+                                const MinMaxAll *min_max,
+                                bool infer_latches);
   bool setMinLibrary(const char *min_filename,
 		     const char *max_filename);
   // Network readers call this to notify the Sta to delete any previously
@@ -115,10 +221,23 @@ public:
   void readNetlistBefore();
   // Return true if successful.
   bool linkDesign(const char *top_cell_name);
+  // Write the linked network to a binary netlist db file.
+  void writeNetlistDb(const char *filename);
+  // Read and link a netlist db file written by writeNetlistDb.
+  // Return true if successful.
+  bool readNetlistDb(const char *filename);
   bool linkMakeBlackBoxes() const;
   void setLinkMakeBlackBoxes(bool make);
 
   // SDC Swig API.
+  // SDC batch.
+  // Commands inside a batch record the vertices they invalidate instead
+  // of invalidating them. The recorded vertices are invalidated once at
+  // the end of the outermost batch, or before delays are found inside
+  // the batch.
+  void sdcBatchBegin();
+  void sdcBatchEnd();
+  bool sdcBatchActive() const { return sdc_batch_depth_ > 0; }
   Instance *currentInstance() const;
   void setCurrentInstance(Instance *inst);
   virtual void setAnalysisType(AnalysisType analysis_type);
@@ -755,6 +874,16 @@ public:
   // Notify the sta that the constraints have changed directly rather
   // than thru this sta API.
   virtual void constraintsChanged();
+  // Modes are sets of constraints that share the network, liberty,
+  // graph and parasitics. Constraint commands and timing reports
+  // apply to the current mode. The initial mode is "default".
+  void makeMode(const char *mode_name);
+  // Switching modes finds constants, delays and arrivals from scratch
+  // unless the mode timing is kept.
+  void setCurrentMode(const char *mode_name);
+  const char *currentMode() const { return mode_name_; }
+  StringSeq modeNames() const;
+  void deleteMode(const char *mode_name);
   // Namespace used by command interpreter.
   CmdNamespace cmdNamespace();
   void setCmdNamespace(CmdNamespace namespc);
@@ -766,6 +895,9 @@ public:
 		   const Corner *corner,
 		   const MinMaxAll *min_max,
 		   ArcDelay delay);
+  // Invalidate the timing of edges whose delays were annotated by
+  // a reader (incremental read_sdf).
+  void delaysAnnotated(const EdgeSet &edges);
   // Set annotated slew on a vertex for delay calculation.
   void setAnnotatedSlew(Vertex *vertex,
 			const Corner *corner,
@@ -791,6 +923,16 @@ public:
   // TCL variable sta_crpr_mode.
   CrprMode crprMode() const;
   void setCrprMode(CrprMode mode);
+  // TCL variable sta_required_tolerance.
+  // Incremental required time updates do not propagate required time
+  // changes smaller than tolerance to the fanin.
+  float requiredTolerance() const;
+  void setRequiredTolerance(float tolerance);
+  // TCL variable sta_crpr_prune_margin.
+  // Approximate path pruning also prunes arrivals within margin of
+  // being pruned. Slacks are optimistic by at most the margin.
+  float crprPruneMargin() const;
+  void setCrprPruneMargin(float margin);
   // TCL variable sta_pocv_enabled.
   // Parametric on chip variation (statisical sta).
   bool pocvEnabled() const;
@@ -907,6 +1049,28 @@ public:
 		     PathEnd *prev_end);
   void reportPathEnd(PathEnd *end);
   void reportPathEnds(PathEndSeq *ends);
+  // reportPathEndHeader, reportPathEnd for each end and
+  // reportPathEndFooter with the ends formatted in parallel.
+  void reportPathEndSeq(PathEndSeq *ends);
+  // Write ends and their expanded path stages to a binary columnar
+  // file for downstream tools.
+  void writePathReport(PathEndSeq *ends,
+                       const char *filename);
+  // Worst slack, arrival, required and path group of every endpoint
+  // for each corner and min/max, found with the dispatch queue threads
+  // without making path groups. Use corner nullptr for all corners.
+  EndpointSlackSeq endpointSlacks(const Corner *corner,
+                                  const MinMaxAll *min_max);
+  // Write endpointSlacks to a csv file.
+  void writeEndpointSlacks(const char *filename,
+                           const Corner *corner,
+                           const MinMaxAll *min_max);
+  // Write SDC with the boundary clocks, arrivals, requireds, slews and
+  // loads of the hierarchical instance inst so it can be timed as a
+  // partition in a separate process (see writeTimingContext).
+  void writeTimingContext(const Instance *inst,
+                          const char *filename,
+                          int digits);
   ReportPath *reportPath() { return report_path_; }
   void reportPath(Path *path);
 
@@ -926,6 +1090,19 @@ public:
   // Find min/max/rise/fall delays for clk.
   ClkDelays findClkDelays(const Clock *clk,
                           bool include_internal_latency);
+  // Register clock pin latency statistics and histogram with
+  // bucket_count buckets. The sink latencies are kept between calls
+  // and only sinks with clock arrival changes are updated.
+  ClkLatencyStats clkLatencyStats(const Clock *clk,
+                                  const Corner *corner,
+                                  const MinMax *min_max,
+                                  bool include_internal_latency,
+                                  int bucket_count);
+  void reportClkLatencyHistogram(ConstClockSeq clks,
+                                 const Corner *corner,
+                                 bool include_internal_latency,
+                                 int bucket_count,
+                                 int digits);
 
   // Update arrival times for all pins.
   // If necessary updateTiming propagates arrivals around latch
@@ -937,6 +1114,33 @@ public:
   // If you are calling this function you are either very confused or there is
   // bug that should be reported.
   void updateTiming(bool full);
+  // Run updateTiming in a background thread that uses the dispatch
+  // queue threads for the parallel searches. A running update is
+  // canceled first. Queries and updateTiming wait for the background
+  // update to finish. Edits through Sta and TCL commands other than
+  // the update progress commands cancel the update.
+  void updateTimingAsync(bool full);
+  // Stop a background update and wait for it. Delay calculation
+  // finishes; the arrival search stops at the next level with the
+  // unvisited vertices queued so the next update continues it.
+  void cancelTimingUpdate();
+  // Wait for a background update.
+  // Return false if it was canceled.
+  bool waitTimingUpdate();
+  bool timingUpdateRunning() const;
+  // Levels and vertices visited by the delay calculation and arrival
+  // searches. Safe to read while a background update is running.
+  const TimingProgress *timingProgress() const { return timing_progress_; }
+  // Update delays, arrivals and all required times (including pruned
+  // requireds) and freeze them. While frozen the vertex and pin
+  // arrival, required, slack and slew queries and the min_max
+  // worstSlack and totalNegativeSlack do not update timing or caches,
+  // so they can be called from multiple threads without locks.
+  // Other queries are not thread safe. Edits that invalidate delays
+  // or arrivals thaw the timing.
+  void freezeTiming();
+  void thawTiming();
+  bool timingFrozen() const;
   // Invalidate all delay calculations. Arrivals also invalidated.
   void delaysInvalid();
   // Invalidate all arrival and required times.
@@ -968,6 +1172,15 @@ public:
   Slack totalNegativeSlack(const MinMax *min_max);
   Slack totalNegativeSlack(const Corner *corner,
 			   const MinMax *min_max);
+  // Number of endpoints with negative slack (all corners if corner
+  // is null). Incrementally updated.
+  int negativeSlackEndpointCount(const Corner *corner,
+                                 const MinMax *min_max);
+  // Up to count endpoints with negative slack, worst first.
+  // Incrementally updated.
+  VertexSeq worstNegativeSlackEndpoints(const Corner *corner,
+                                        const MinMax *min_max,
+                                        int count);
   // Worst endpoint slack and vertex.
   // Incrementally updated.
   Slack worstSlack(const MinMax *min_max);
@@ -1047,6 +1260,18 @@ public:
 		 const MinMax *min_max);
   Slack pinSlack(const Pin *pin,
 		 const MinMax *min_max);
+  // Batch versions of pinSlack, pinArrival and the pin slew_* properties
+  // for bulk timing extraction. The values of the pins are found with
+  // the dispatch queue threads. rf=nullptr is the worst of rise/fall.
+  FloatSeq pinSlacks(const PinSeq &pins,
+                     const RiseFall *rf,
+                     const MinMax *min_max);
+  FloatSeq pinArrivals(const PinSeq &pins,
+                       const RiseFall *rf,
+                       const MinMax *min_max);
+  FloatSeq pinSlews(const PinSeq &pins,
+                    const RiseFall *rf,
+                    const MinMax *min_max);
   Slack vertexSlack(Vertex *vertex,
 		    const MinMax *min_max);
   Slack vertexSlack(Vertex *vertex,
@@ -1098,6 +1323,9 @@ public:
   TagIndex tagCount() const;
   TagGroupIndex tagGroupCount() const;
   int clkInfoCount() const;
+  // Report the memory used by the network, libraries, parasitics,
+  // graph, search tags and exceptions.
+  void reportMemory() const;
   int arrivalCount() const;
   int requiredCount() const;
   int vertexArrivalCount(Vertex  *vertex) const;
@@ -1123,7 +1351,10 @@ public:
   // The parasitic analysis point is ap_name.
   // The parasitic memory footprint is much smaller if parasitic
   // networks (dspf) are reduced and deleted after reading each net
-  // with reduce_to and delete_after_reduce.
+  // with reduce. Nets in keep_detailed_nets (may be null) keep their
+  // parasitic networks with reduce.
+  // With incremental only the delays of the nets in the file are
+  // invalidated, for reading the nets changed by an ECO.
   // Return true if successful.
   bool readSpef(const char *filename,
 		Instance *instance,
@@ -1132,7 +1363,27 @@ public:
 		bool pin_cap_included,
 		bool keep_coupling_caps,
 		float coupling_cap_factor,
-		bool reduce);
+		bool reduce,
+                const NetSet *keep_detailed_nets = nullptr,
+                bool incremental = false);
+  // Write the parasitics of all parasitic analysis points to a binary
+  // file that readParasiticsCache loads without parsing SPEF.
+  void writeParasiticsCache(const char *filename);
+  // Replace the parasitics with a cache written for the same netlist.
+  // Return true if successful.
+  bool readParasiticsCache(const char *filename);
+  // Reduce the parasitic networks of every driver with the delay
+  // calculator on the dispatch queue threads.
+  // Null corner reduces all corners.
+  void reduceParasitics(const Corner *corner,
+                        const MinMaxAll *min_max);
+  // Write the graph slews and arc delays to a binary file that
+  // readTimingSnapshot loads without delay calculation.
+  void writeTimingSnapshot(const char *filename);
+  // Replace the slews and arc delays with a snapshot written for the
+  // same netlist and corners. Arrivals are found by the next update.
+  // Return true if successful.
+  bool readTimingSnapshot(const char *filename);
   void reportParasiticAnnotation(bool report_unannotated,
                                  const Corner *corner);
   // Parasitics.
@@ -1164,6 +1415,17 @@ public:
   Parasitic *makeParasiticNetwork(const Net *net,
                                   bool includes_pin_caps,
                                   const ParasiticAnalysisPt *ap);
+  // Estimate the parasitics of drivers without parasitic networks or
+  // pi models with estimator (may be null). Sta takes ownership.
+  // Previous estimates of drivers without parasitic networks are deleted.
+  void setParasiticEstimator(ParasiticEstimator *estimator);
+  // Estimate parasitics from pin locations with wire resistance and
+  // capacitance per distance.
+  void setWireRcEstimate(float res_per_distance,
+                         float cap_per_distance);
+  // Forget the estimated parasitics of net's drivers,
+  // for example after its pins move.
+  void parasiticEstimatesInvalid(const Net *net);
 
   // TCL network edit function support.
   virtual Instance *makeInstance(const char *name,
@@ -1189,6 +1451,26 @@ public:
   virtual void disconnectPin(Pin *pin);
   virtual void makePortPin(const char *port_name,
                            const char *direction);
+  // What-if network edit session.
+  // makeInstance, makeNet, replaceCell, connectPin and disconnectPin
+  // edits made during the session are logged so whatIfDiscard can undo
+  // them and incrementally return timing to the state at whatIfBegin.
+  // Deleting instances and nets is not supported inside a session.
+  void whatIfBegin();
+  // Keep the session edits.
+  void whatIfCommit();
+  // Undo the session edits in reverse order.
+  void whatIfDiscard();
+  bool whatIfActive() const { return what_if_edits_ != nullptr; }
+  // Netlist edit transaction.
+  // Edits inside a transaction make and delete graph vertices and edges
+  // immediately but only record the driver and load vertices they
+  // connect. The fanin/fanout invalidation, relevelization and clock
+  // network update run once per recorded vertex at the end of the
+  // outermost transaction, or before the graph is levelized inside it.
+  void netlistEditBegin();
+  void netlistEditEnd();
+  bool netlistEditActive() const { return netlist_edit_depth_ > 0; }
   // Notify STA of network change.
   void networkChanged();
   void deleteLeafInstanceBefore(const Instance *inst);
@@ -1212,6 +1494,9 @@ public:
   virtual void deleteNetBefore(const Net *net);
   virtual void deleteInstanceBefore(const Instance *inst);
   virtual void deletePinBefore(const Pin *pin);
+  // Pin slew, load cap or fanout changed so the slew, capacitance and
+  // fanout limit violators need to check it again. Thread safe.
+  void limitPinChanged(const Pin *pin);
 
   ////////////////////////////////////////////////////////////////
 
@@ -1249,6 +1534,9 @@ public:
   void setIncrementalDelayTolerance(float tol);
   // Make graph and find delays.
   void searchPreamble();
+  void searchPreamble(ExceptionFrom *from,
+                      ExceptionThruSeq *thrus,
+                      bool unconstrained);
 
   // Define the delay calculator implementation.
   void setArcDelayCalc(const char *delay_calc_name);
@@ -1266,6 +1554,7 @@ public:
   void delaysInvalidFromFanin(const Net *net);
   void delaysInvalidFromFanin(const Pin *pin);
   void delaysInvalidFromFanin(Vertex *vertex);
+  void delayAnnotated(Edge *edge);
   void replaceCellPinInvalidate(const LibertyPort *from_port,
 				Vertex *vertex,
 				const LibertyCell *to_cell);
@@ -1283,18 +1572,27 @@ public:
 	     PowerResult &pad);
   PowerResult power(const Instance *inst,
                     const Corner *corner);
+  // Leaf and hierarchical instance powers found with one pass over
+  // the leaf instances.
+  PowerResultSeq power(const InstanceSeq &insts,
+                       const Corner *corner);
   PwrActivity findClkedActivity(const Pin *pin);
 
+  // one_pass searches the paths from all inputs at once, which is
+  // faster for blocks with many inputs but uses more memory.
   void writeTimingModel(const char *lib_name,
                         const char *cell_name,
                         const char *filename,
-                        const Corner *corner);
+                        const Corner *corner,
+                        bool one_pass);
 
   // Find equivalent cells in equiv_libs.
   // Optionally add mappings for cells in map_libs.
   void makeEquivCells(LibertyLibrarySeq *equiv_libs,
 		      LibertyLibrarySeq *map_libs);
   LibertyCellSeq *equivCells(LibertyCell *cell);
+  // Sizing key of a cell with equivalent cells (null if none).
+  const EquivCellKey *equivCellKey(const LibertyCell *cell);
 
 protected:
   // Default constructors that are called by makeComponents in the Sta
@@ -1335,7 +1633,11 @@ protected:
   // Allow external Liberty reader to parse forms not used by Sta.
   virtual LibertyLibrary *readLibertyFile(const char *filename,
 					  bool infer_latches);
+  DispatchQueue *libertyCellDispatchQueue() const;
   void delayCalcPreamble();
+  void shareGraphDelays();
+  bool delaysEquivalent(const DcalcAnalysisPt *dcalc_ap1,
+                        const DcalcAnalysisPt *dcalc_ap2) const;
   void delaysInvalidFrom(const Port *port);
   void delaysInvalidFromFanin(const Port *port);
   void deleteEdge(Edge *edge);
@@ -1352,6 +1654,17 @@ protected:
 		     const RiseFall *rf,
 		     const ClockEdge *clk_edge,
 		     const PathAnalysisPt *path_ap);
+  Slack vertexSlack1(Vertex *vertex,
+                     const RiseFall *rf,
+                     const MinMax *min_max);
+  Arrival vertexArrival1(Vertex *vertex,
+                         const RiseFall *rf,
+                         const ClockEdge *clk_edge,
+                         const PathAnalysisPt *path_ap,
+                         const MinMax *min_max);
+  Slew vertexSlew1(Vertex *vertex,
+                   const RiseFall *rf,
+                   const MinMax *min_max);
   void findRequired(Vertex *vertex);
   Required vertexRequired(Vertex *vertex,
                           const RiseFall *rf,
@@ -1360,6 +1673,23 @@ protected:
                           const MinMax *min_max);
   void connectDrvrPinAfter(Vertex *vertex);
   void connectLoadPinAfter(Vertex *vertex);
+  void connectDrvrPinAfter1(Vertex *vertex);
+  void connectLoadPinAfter1(Vertex *vertex);
+  void netlistEditFlush();
+  void netlistEditDeleteVertexBefore(Vertex *vertex);
+  void limitInstPinsChanged(const Instance *inst);
+  void limitPinDeleted(const Pin *pin);
+  void limitViolatorsClear();
+  void constraintValueChanged(const Pin *pin);
+  void makeDefaultMode();
+  void deleteModes();
+  ModeTiming *saveModeTiming();
+  void restoreModeTiming(bool search_saved,
+                         size_t delay_invalid_count);
+  void deleteModeTiming(const Sdc *sdc);
+  void deleteModeTimings();
+  // Sdcs of the modes that are not current with updated state.
+  SdcSeq otherModeSdcs();
   Path *latchEnablePath(Path *q_path,
 			Edge *d_q_edge,
 			const ClockEdge *en_clk_edge);
@@ -1369,6 +1699,11 @@ protected:
   void maxSkewPreamble();
   bool idealClockMode();
   void disableAfter();
+  void findFaninPins(VertexSeq &roots,
+                     bool flat,
+                     bool startpoints_only,
+                     PinSet &fanin,
+                     SearchPred &pred);
   void findFaninPins(Vertex *vertex,
 		     bool flat,
 		     bool startpoints_only,
@@ -1384,6 +1719,11 @@ protected:
 		     SearchPred *pred,
 		     int inst_level,
 		     int pin_level);
+  void findFanoutPins(VertexSeq &roots,
+                      bool flat,
+                      bool endpoints_only,
+                      PinSet &fanout,
+                      SearchPred &pred);
   void findFanoutPins(Vertex *vertex,
 		      bool flat,
 		      bool endpoints_only,
@@ -1400,10 +1740,14 @@ protected:
 		      int inst_level,
 		      int pin_level);
   void findRegisterPreamble();
+  void regClkPinsInvalid();
   bool crossesHierarchy(Edge *edge) const;
   void readLibertyAfter(LibertyLibrary *liberty,
 			Corner *corner,
 			const MinMax *min_max);
+  void readLibertyAfter(LibertyLibrary *liberty,
+			Corner *corner,
+			const MinMaxAll *min_max);
   void powerPreamble();
   void disableFanoutCrprPruning(Vertex *vertex,
 				int &fanou);
@@ -1412,9 +1756,15 @@ protected:
                            LibertyCell *to_lib_cell);
   void sdcChangedGraph();
   void ensureGraphSdcAnnotated();
+  // Return true if inside an SDC batch and record the vertex to
+  // invalidate at the end of the batch.
+  bool sdcBatchDefer(Vertex *vertex,
+                     VertexSet *vertices);
+  void sdcBatchInvalidate();
   CornerSeq makeCornerSeq(Corner *corner) const;
   void makeParasiticAnalysisPts();
   void clkSkewPreamble();
+  void resurrectPrunedRequireds();
   void setCmdNamespace1(CmdNamespace namespc);
   void setThreadCount1(int thread_count);
 
@@ -1429,6 +1779,7 @@ protected:
   CheckMinPeriods *check_min_periods_;
   CheckMaxSkews *check_max_skews_;
   ClkSkews *clk_skews_;
+  RegClkPinCache *reg_clk_pins_;
   ReportPath *report_path_;
   Power *power_;
   Tcl_Interp *tcl_interp_;
@@ -1436,8 +1787,46 @@ protected:
   bool update_genclks_;
   EquivCells *equiv_cells_;
   bool graph_sdc_annotated_;
+  bool graph_adjacency_snapshot_;
+  bool graph_level_order_;
+  bool thread_pinning_;
+  bool spef_read_parallel_;
+  bool verilog_link_parallel_;
+  bool liberty_lazy_load_;
+  bool liberty_read_parallel_;
   bool parasitics_per_corner_;
   bool parasitics_per_min_max_;
+  // Sdc of every mode including sdc_.
+  ModeSdcMap mode_sdcs_;
+  const char *mode_name_;
+  bool keep_mode_timing_;
+  // Search state of the modes that are not current.
+  ModeTimingMap mode_timings_;
+  // Edits of the active what-if session.
+  WhatIfEdits *what_if_edits_;
+  // Nesting depth of sdcBatchBegin.
+  int sdc_batch_depth_;
+  // Vertices to invalidate delays from at the end of the batch.
+  VertexSet *sdc_batch_from_;
+  // Vertices to invalidate the fanin delays of at the end of the batch.
+  VertexSet *sdc_batch_fanin_;
+  // Nesting depth of netlistEditBegin.
+  int netlist_edit_depth_;
+  // Vertices connected inside the netlist edit transaction.
+  VertexSet *netlist_edit_drvrs_;
+  VertexSet *netlist_edit_loads_;
+  TimingProgress *timing_progress_;
+  // Background updateTimingAsync.
+  std::thread *timing_update_thread_;
+  bool timing_update_completed_;
+  bool timing_frozen_;
+  // Found by freezeTiming, indexed by MinMax::index().
+  Slack frozen_worst_slacks_[MinMax::index_count];
+  Vertex *frozen_worst_vertices_[MinMax::index_count];
+  Slack frozen_tns_[MinMax::index_count];
+  // Delay calc and search invalidation counts when timing was frozen.
+  size_t frozen_delay_invalid_count_;
+  size_t frozen_search_invalid_count_;
 
   // Singleton sta used by tcl command interpreter.
   static Sta *sta_;
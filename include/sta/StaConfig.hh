@@ -0,0 +1,19 @@
+#define STA_VERSION "2.5.0"
+
+#define STA_GIT_SHA1 "c55a7b10cd1f901665a0ab8113ef4bd5024dcffb"
+
+#define ZLIB_FOUND
+
+/* #undef ZSTD_FOUND */
+
+#define CUDD 0
+
+#define SSTA 0
+
+#define STA_COMPACT_DELAYS 0
+
+#define STA_ARRAY_TABLE_BITS 7
+
+#define STA_HOT_DEBUG 1
+
+#define TCL_READLINE 0
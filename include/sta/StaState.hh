@@ -94,6 +94,24 @@ public:
   ClkNetwork *clkNetwork() { return clk_network_; }
   ClkNetwork *clkNetwork() const { return clk_network_; }
   unsigned threadCount() const { return thread_count_; }
+  DispatchQueue *dispatchQueue() const { return dispatch_queue_; }
+  // Parallel BFS visits steal work between threads within a level.
+  bool bfsWorkStealing() const { return bfs_work_stealing_; }
+  // Parallel BFS visits release vertices when their predecessors are
+  // visited instead of visiting one level at a time.
+  bool bfsDependencyDriven() const { return bfs_dependency_driven_; }
+  // Vertices ahead of the visit that parallel BFS level walks
+  // prefetch (0 is off).
+  int bfsPrefetchDistance() const { return bfs_prefetch_distance_; }
+  // Levelize with multiple threads.
+  bool levelizeParallel() const { return levelize_parallel_; }
+  // Break loops with strongly connected components before levelizing.
+  bool levelizeScc() const { return levelize_scc_; }
+  // Propagate logic constants with multiple threads.
+  bool simParallel() const { return sim_parallel_; }
+  // Find the arrivals of vertices in narrow search levels with a
+  // thread for each path analysis point.
+  bool searchPathApParallel() const { return search_path_ap_parallel_; }
   bool pocvEnabled() const { return pocv_enabled_; }
   float sigmaFactor() const { return sigma_factor_; }
 
@@ -118,6 +136,13 @@ protected:
   ClkNetwork *clk_network_;
   int thread_count_;
   DispatchQueue *dispatch_queue_;
+  bool bfs_work_stealing_;
+  bool bfs_dependency_driven_;
+  int bfs_prefetch_distance_;
+  bool levelize_parallel_;
+  bool levelize_scc_;
+  bool sim_parallel_;
+  bool search_path_ap_parallel_;
   bool pocv_enabled_;
   float sigma_factor_;
 };
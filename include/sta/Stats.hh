@@ -23,12 +23,14 @@ namespace sta {
 class Debug;
 class Report;
 
-// Show run time and memory statistics if the "stats" debug flag is on.
+// Show run time and memory statistics if the "stats" debug flag is on
+// and record them in the debug profiler when it is enabled.
 class Stats
 {
 public:
   explicit Stats(Debug *debug,
                  Report *report);
+  ~Stats();
   void report(const char *step);
 
 private:
@@ -38,6 +40,7 @@ private:
   size_t memory_begin_;
   Debug *debug_;
   Report *report_;
+  bool profiling_;
 };
 
 } // namespace
@@ -22,6 +22,7 @@
 
 #include "Machine.hh" // __attribute__
 #include "Vector.hh"
+#include "Hash.hh"
 
 namespace sta {
 
@@ -108,6 +109,25 @@ public:
   }
 };
 
+class CharPtrHash
+{
+public:
+  size_t operator()(const char *string) const
+  {
+    return hashString(string);
+  }
+};
+
+class CharPtrEqual
+{
+public:
+  bool operator()(const char *string1,
+		  const char *string2) const
+  {
+    return strcmp(string1, string2) == 0;
+  }
+};
+
 // Case insensitive comparision.
 class CharPtrCaseLess
 {
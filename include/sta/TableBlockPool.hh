@@ -0,0 +1,59 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+
+namespace sta {
+
+class MemoryStats;
+
+enum class TablePagePolicy { normal, transparent_huge, explicit_huge };
+
+// Allocator for the blocks of ObjectTable and ArrayTable.
+// With the normal policy blocks use operator new. With a huge page
+// policy blocks are carved out of large regions backed by transparent
+// (madvise) or explicit (MAP_HUGETLB) huge pages, so walking the graph
+// and search tables takes fewer TLB misses. Explicit huge pages fall
+// back to transparent ones if none are reserved.
+// Deleted region blocks are reused by blocks of the same size, but
+// regions are never returned. Thread safe.
+void *
+tableBlockAlloc(size_t size);
+// size must be the size passed to tableBlockAlloc.
+void
+tableBlockFree(void *block,
+               size_t size);
+TablePagePolicy
+tablePagePolicy();
+// Applies to blocks allocated after the policy is set.
+void
+setTablePagePolicy(TablePagePolicy policy);
+const char *
+tablePagePolicyName(TablePagePolicy policy);
+// Return false if name is not a policy name.
+bool
+findTablePagePolicy(const char *name,
+                    // Return value.
+                    TablePagePolicy &policy);
+
+// Add the page policy, the regions and the region space that is not
+// used by live blocks to stats.
+void
+tableBlockMemoryStats(MemoryStats &stats);
+
+} // namespace
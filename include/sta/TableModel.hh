@@ -18,6 +18,10 @@
 
 #include <string>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
 
 #include "MinMax.hh"
 #include "Vector.hh"
@@ -35,6 +39,7 @@ class Report;
 class Table;
 class OutputWaveforms;
 class Table1;
+class TableLookup;
 
 typedef Vector<float> FloatSeq;
 typedef Vector<FloatSeq*> FloatTable;
@@ -104,6 +109,16 @@ protected:
 		  float in_slew,
 		  float load_cap,
 		  float related_out_cap) const;
+  // Find the values of models at one point, sharing the axis search
+  // and interpolation weights between models with the same axes.
+  void findValues(const Pvt *pvt,
+                  const TableModel *const *models,
+                  size_t model_count,
+                  float in_slew,
+                  float load_cap,
+                  float related_out_cap,
+                  // Return values.
+                  float *values) const;
   string reportTableLookup(const char *result_name,
                            const Pvt *pvt,
                            const TableModel *model,
@@ -161,6 +176,14 @@ protected:
 		  float from_slew,
 		  float to_slew,
 		  float related_out_cap) const;
+  void findValues(const Pvt *pvt,
+                  const TableModel *const *models,
+                  size_t model_count,
+                  float from_slew,
+                  float to_slew,
+                  float related_out_cap,
+                  // Return values.
+                  float *values) const;
   void findAxisValues(float from_slew,
 		      float to_slew,
 		      float related_out_cap,
@@ -214,6 +237,18 @@ public:
 		  float value1,
 		  float value2,
 		  float value3) const;
+  // Find the interpolation point for value1/2/3.
+  // Return false if the table does not support lookups.
+  bool findLookup(float value1,
+                  float value2,
+                  float value3,
+                  // Return value.
+                  TableLookup &lookup) const;
+  // Interpolated value at a lookup point with scale factor.
+  float lookupValue(const LibertyCell *cell,
+                    const Pvt *pvt,
+                    const TableLookup &lookup) const;
+  bool sameAxes(const TableModel *model) const;
   string reportValue(const char *result_name,
                      const LibertyCell *cell,
                      const Pvt *pvt,
@@ -241,6 +276,20 @@ protected:
   bool is_scaled_:1;
 };
 
+// Interpolation point in a 2 or 3 dimension table.
+// The value is the weighted sum of the values at the corners of
+// the table cell containing the point, so tables with the same axes
+// can share one lookup.
+class TableLookup
+{
+public:
+  static constexpr int corner_count_max = 8;
+  int corner_count;
+  // Offsets of the cell corners in the table values.
+  size_t offsets[corner_count_max];
+  double weights[corner_count_max];
+};
+
 // Abstract base class for 0, 1, 2, or 3 dimesnion float tables.
 class Table
 {
@@ -267,6 +316,16 @@ public:
 		  float axis_value1,
 		  float axis_value2,
 		  float axis_value3) const;
+  // Find the interpolation point for axis_value1/2/3.
+  // Return false if the table does not support lookups.
+  virtual bool findLookup(float,
+                          float,
+                          float,
+                          // Return value.
+                          TableLookup &) const { return false; }
+  virtual float lookupValue(const TableLookup &) const { return 0.0; }
+  // Same axis variables and values.
+  bool sameAxes(const Table *table) const;
   virtual string reportValue(const char *result_name,
                              const LibertyCell *cell,
                              const Pvt *pvt,
@@ -364,7 +423,7 @@ public:
   Table2(FloatTable *values,
 	 TableAxisPtr axis1,
 	 TableAxisPtr axis2);
-  virtual ~Table2();
+  virtual ~Table2() {}
   int order() const override { return 2; }
   const TableAxis *axis1() const override { return axis1_.get(); }
   const TableAxis *axis2() const override { return axis2_.get(); }
@@ -374,6 +433,11 @@ public:
   float findValue(float value1,
                   float value2,
                   float value3) const override;
+  bool findLookup(float axis_value1,
+                  float axis_value2,
+                  float axis_value3,
+                  TableLookup &lookup) const override;
+  float lookupValue(const TableLookup &lookup) const override;
   string reportValue(const char *result_name,
                      const LibertyCell *cell,
                      const Pvt *pvt,
@@ -389,12 +453,28 @@ public:
   // Table2 specific functions.
   float value(size_t axis_index1,
               size_t axis_index2) const;
-  FloatTable *values3() { return values_; }
+  // Row major values.
+  const FloatSeq &values() const { return values_; }
 
   using Table::findValue;
 
 protected:
-  FloatTable *values_;
+  // Values are set by the derived class.
+  Table2(TableAxisPtr axis1,
+         TableAxisPtr axis2);
+  // Copy the first rows of values to values_ and delete them.
+  void setValues(FloatTable *values,
+                 size_t rows,
+                 size_t cols);
+  void findAxisLookup(const TableAxis *axis,
+                      float axis_value,
+                      // Return values.
+                      size_t &index,
+                      size_t &next_index,
+                      double &dx) const;
+
+  // Values in one contiguous row major array.
+  FloatSeq values_;
   // Row.
   TableAxisPtr axis1_;
   // Column.
@@ -420,6 +500,10 @@ public:
   float findValue(float value1,
                   float value2,
                   float value3) const override;
+  bool findLookup(float axis_value1,
+                  float axis_value2,
+                  float axis_value3,
+                  TableLookup &lookup) const override;
   string reportValue(const char *result_name,
                      const LibertyCell *cell,
                      const Pvt *pvt,
@@ -464,6 +548,21 @@ private:
   FloatSeq *values_;
 };
 
+// Content hashed pool of table axes and tables shared by all libraries.
+// Corner libraries and cell variants repeat the same index templates
+// and often the same tables, so readers return the pooled copy of
+// an axis or table that has the same contents. Tables are compared
+// by axis pointers, so axes should be pooled before their tables.
+// The pool does not keep its entries alive.
+class TablePool
+{
+public:
+  // Return the pooled axis equal to axis, or add axis to the pool.
+  static TableAxisPtr findAxis(const TableAxisPtr &axis);
+  // Return the pooled table equal to table, or add table to the pool.
+  static TablePtr findTable(const TablePtr &table);
+};
+
 ////////////////////////////////////////////////////////////////
 
 class ReceiverModel
@@ -481,6 +580,29 @@ private:
 };
 
 // Two dimensional (slew/cap) table of one dimensional time/current tables.
+// Output current waveform with the currents stored as 16 bit
+// fractions of the peak current. The time axis is shared.
+class CurrentWaveform
+{
+public:
+  CurrentWaveform();
+  explicit CurrentWaveform(const Table1 *waveform);
+  const TableAxis *timeAxis() const { return time_axis_.get(); }
+  TableAxisPtr timeAxisPtr() const { return time_axis_; }
+  size_t size() const { return currents_.size(); }
+  float current(size_t index) const { return currents_[index] * scale_; }
+  // Same as Table1::findValueClip.
+  float findValueClip(float time) const;
+  Table1 table() const;
+
+private:
+  TableAxisPtr time_axis_;
+  float scale_;
+  std::vector<int16_t> currents_;
+};
+
+// Voltage waveforms are made from the current waveforms the first time
+// a slew/cap point is used.
 class OutputWaveforms
 {
 public:
@@ -498,8 +620,17 @@ public:
   float voltageTime(float in_slew,
                     float load_cap,
                     float voltage);
-  const Table1 *currentWaveform(float slew,
-                                float cap);
+  // voltageTime of two voltages at one slew/cap sharing the axis
+  // searches and interpolation weights.
+  void voltageTimes(float in_slew,
+                    float load_cap,
+                    float voltage1,
+                    float voltage2,
+                    // Return values.
+                    double &time1,
+                    double &time2);
+  Table1 currentWaveform(float slew,
+                         float cap);
   float timeCurrent(float slew,
                     float cap,
                     float time);
@@ -510,10 +641,18 @@ public:
                        float cap,
                        float volt);
   float referenceTime(float slew);
-  void makeVoltageWaveforms(float vdd);
+  // Set the supply voltage used to make the voltage waveforms.
+  void setVdd(float vdd);
   static bool checkAxes(const TableTemplate *tbl_template);
 
 private:
+  void findWaveIndices(float slew,
+                       float cap,
+                       // Return values.
+                       size_t wave_indices[4],
+                       double &dx1,
+                       double &dx2);
+  void ensureVoltages(const size_t wave_indices[4]);
   void findVoltages(size_t wave_index,
                     float cap);
   float waveformValue(float slew,
@@ -522,6 +661,10 @@ private:
                       Table1Seq &waveforms);
   float voltageTime1(float voltage,
                      size_t wave_index);
+  double voltageTime2(float voltage,
+                      const size_t wave_indices[4],
+                      double dx1,
+                      double dx2);
   void waveformMinMaxTime(float slew,
                           float cap,
                           Table1Seq &waveforms,
@@ -534,10 +677,13 @@ private:
   // Column.
   TableAxisPtr cap_axis_;
   const RiseFall *rf_;
-  Table1Seq current_waveforms_;
+  std::vector<CurrentWaveform> current_waveforms_;
   Table1Seq voltage_waveforms_;
   Table1Seq voltage_currents_;
   FloatTable voltage_times_;
+  // True when the voltage tables of a wave index have been made.
+  std::unique_ptr<std::atomic<bool>[]> have_voltages_;
+  std::mutex voltages_lock_;
   Table1 *ref_times_;
   float vdd_;
   static constexpr size_t voltage_waveform_step_count_ = 20;
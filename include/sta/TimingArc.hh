@@ -237,6 +237,7 @@ public:
   unsigned index() const { return index_; }
   TimingModel *model(const OperatingConditions *op_cond) const;
   TimingModel *model() const { return model_; }
+  // Inline because delay calculation maps every arc to its corner arc.
   const TimingArc *cornerArc(int ap_index) const;
   void setCornerArc(TimingArc *corner_arc,
 		    int ap_index);
@@ -265,4 +266,15 @@ private:
   friend class TimingArcSet;
 };
 
+inline const TimingArc *
+TimingArc::cornerArc(int ap_index) const
+{
+  if (ap_index < static_cast<int>(corner_arcs_.size())) {
+    TimingArc *corner_arc = corner_arcs_[ap_index];
+    if (corner_arc)
+      return corner_arc;
+  }
+  return this;
+}
+
 } // namespace
@@ -0,0 +1,91 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace sta {
+
+// Progress of a timing update that may be running in another thread.
+// The bfs level loops count the levels and vertices they visit.
+// Iterators that honor cancels stop at the next level when a cancel
+// is requested, leaving the unvisited vertices in the queue.
+class TimingProgress
+{
+public:
+  TimingProgress();
+  void reset();
+  size_t levels() const { return levels_.load(std::memory_order_relaxed); }
+  size_t vertices() const { return vertices_.load(std::memory_order_relaxed); }
+  void addVisits(size_t levels,
+                 size_t vertices);
+  bool running() const { return running_.load(std::memory_order_acquire); }
+  void setRunning(bool running);
+  bool cancelRequested() const;
+  void setCancelRequested(bool cancel);
+
+private:
+  std::atomic<size_t> levels_;
+  std::atomic<size_t> vertices_;
+  std::atomic<bool> running_;
+  std::atomic<bool> cancel_requested_;
+};
+
+inline
+TimingProgress::TimingProgress() :
+  levels_(0),
+  vertices_(0),
+  running_(false),
+  cancel_requested_(false)
+{
+}
+
+inline void
+TimingProgress::reset()
+{
+  levels_.store(0, std::memory_order_relaxed);
+  vertices_.store(0, std::memory_order_relaxed);
+}
+
+inline void
+TimingProgress::addVisits(size_t levels,
+                          size_t vertices)
+{
+  levels_.fetch_add(levels, std::memory_order_relaxed);
+  vertices_.fetch_add(vertices, std::memory_order_relaxed);
+}
+
+inline void
+TimingProgress::setRunning(bool running)
+{
+  running_.store(running, std::memory_order_release);
+}
+
+inline bool
+TimingProgress::cancelRequested() const
+{
+  return cancel_requested_.load(std::memory_order_relaxed);
+}
+
+inline void
+TimingProgress::setCancelRequested(bool cancel)
+{
+  cancel_requested_.store(cancel, std::memory_order_relaxed);
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sta {
+
+// Timeline of begin/end events per thread written in the Chrome trace
+// event format (chrome://tracing, ui.perfetto.dev).
+// Thread 0 is the main thread and thread i+1 is dispatch queue worker i.
+// Each thread appends to its own event buffer, so recording does not
+// lock. Enabling and resizing is done by the main thread while the
+// workers are idle.
+class Tracer
+{
+public:
+  Tracer();
+  bool enabled() const { return enabled_; }
+  void setEnabled(bool enabled);
+  // Buffers for the main thread and thread_count workers.
+  void setThreadCount(size_t thread_count);
+  void clear();
+  // Microseconds since the tracer was made.
+  int64_t now() const;
+  // name must be a string constant.
+  // arg is reported with the event unless it is negative.
+  void record(int thread,
+              const char *name,
+              int64_t begin,
+              int64_t end,
+              int64_t arg = -1);
+  size_t eventCount() const;
+  // Throws FileNotWritable.
+  void writeJson(const char *filename) const;
+
+private:
+  class Event
+  {
+  public:
+    const char *name_;
+    int64_t begin_;
+    int64_t end_;
+    int64_t arg_;
+  };
+
+  class ThreadEvents
+  {
+  public:
+    std::vector<Event> events_;
+    // Keep the buffers of different threads on separate cache lines.
+    char pad_[64 - sizeof(std::vector<Event>)];
+  };
+
+  bool enabled_;
+  std::chrono::steady_clock::time_point start_;
+  std::vector<ThreadEvents> threads_;
+};
+
+// Record the main thread event for a scope when tracing is enabled.
+class TraceScope
+{
+public:
+  TraceScope(Tracer *tracer,
+             const char *name,
+             int64_t arg = -1);
+  ~TraceScope();
+
+private:
+  Tracer *tracer_;
+  const char *name_;
+  int64_t arg_;
+  int64_t begin_;
+};
+
+} // namespace
@@ -19,6 +19,7 @@
 namespace sta {
 
 class NetworkReader;
+class DispatchQueue;
 
 // Return true if successful.
 bool
@@ -28,5 +29,10 @@ readVerilogFile(const char *filename,
 void
 deleteVerilogReader();
 
+// Linking makes the leaf instances of module bodies with the
+// dispatch_queue threads when it is not null.
+void
+setVerilogLinkDispatchQueue(DispatchQueue *dispatch_queue);
+
 } // namespace sta
 
@@ -20,11 +20,17 @@
 
 namespace sta {
 
+class DispatchQueue;
+
+// With a dispatch queue the instances of each module are formatted
+// by thread_count threads.
 void
 writeVerilog(const char *filename,
 	     bool sort,
 	     bool include_pwr_gnd,
 	     CellSeq *remove_cells,
-	     Network *network);
+	     Network *network,
+             int thread_count = 1,
+             DispatchQueue *dispatch_queue = nullptr);
 
 } // namespace
@@ -30,6 +30,9 @@ public:
   virtual VertexVisitor *copy() const = 0;
   virtual void visit(Vertex *vertex) = 0;
   void operator()(Vertex *vertex) { visit(vertex); }
+  // Visit a vertex in a level with too few vertices to visit the level
+  // in parallel. Visitors can split the work of the visit across threads.
+  virtual void visitNarrow(Vertex *vertex) { visit(vertex); }
   virtual void levelFinished() {}
 };
 
@@ -145,6 +145,9 @@ public:
   virtual void vertexBegin(Vertex *) {}
   // Visit a path end.  path_end is only valid during the call.
   virtual void visit(PathEnd *path_end) = 0;
+  // Return false if the visitor will not keep an unconstrained path_end,
+  // so its exception checks are skipped.
+  virtual bool unconstrainedSavable(PathEnd *) { return true; }
   // End visiting the path ends for a vertex / path_index.
   virtual void vertexEnd(Vertex *) {}
 };
@@ -18,6 +18,7 @@
 
 #include "StringSet.hh"
 #include "CircuitSim.hh"
+#include "SearchClass.hh"
 
 namespace sta {
 
@@ -41,4 +42,19 @@ writePathSpice(Path *path,
                CircuitSim ckt_sim,
 	       StaState *sta);
 
+// Write spice decks for path_ends to spice_directory/path_<n>.sp with
+// the subckts each deck uses in path_<n>.subckt, n counting from 1.
+// The library subckt file is read once for all of the decks and the
+// decks are written by the dispatch queue threads.
+// Throws FileNotReadable, FileNotWritable, SubcktEndsMissing
+void
+writePathSpices(PathEndSeq *path_ends,
+                const char *spice_directory,
+                const char *lib_subckt_filename,
+                const char *model_filename,
+                const char *power_name,
+                const char *gnd_name,
+                CircuitSim ckt_sim,
+                StaState *sta);
+
 } // namespace
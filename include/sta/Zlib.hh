@@ -33,7 +33,9 @@
 #define gzopen fopen
 #define gzclose fclose
 #define gzgets(stream,s,size) fgets(s,size,stream)
+#define gzread(stream,buf,len) fread(buf,1,len,stream)
 #define gzprintf fprintf
+#define gzwrite(stream,buf,len) fwrite(buf,1,len,stream)
 #define Z_NULL nullptr
 
 #endif // ZLIB_FOUND
@@ -62,26 +62,24 @@ cellDriveResistance(const LibertyCell *cell)
   return 0.0;
 }
 
-class CellDriveResistanceGreater
-{
-public:
-  bool operator()(const LibertyCell *cell1,
-		  const LibertyCell *cell2) const
-  {
-    return cellDriveResistance(cell1) > cellDriveResistance(cell2);
-  }
-};
-
 EquivCells::EquivCells(LibertyLibrarySeq *equiv_libs,
-		       LibertyLibrarySeq *map_libs)
+		       LibertyLibrarySeq *map_libs,
+                       int liberty_ap_count) :
+  liberty_ap_count_(liberty_ap_count)
 {
   LibertyCellHashMap hash_matches;
   for (auto lib : *equiv_libs)
     findEquivCells(lib, hash_matches);
-  // Sort the equiv sets by drive resistance.
   for (auto cell : unique_equiv_cells_) {
     auto equivs = equiv_cells_.findKey(cell);
-    sort(equivs, CellDriveResistanceGreater());
+    for (LibertyCell *equiv : *equivs)
+      makeKey(equiv);
+    // Sort the equiv sets by drive resistance using the keys.
+    sort(equivs, [this] (const LibertyCell *cell1,
+                         const LibertyCell *cell2) {
+      return cell_keys_.findKey(cell1)->drive_resistance_
+        > cell_keys_.findKey(cell2)->drive_resistance_;
+    });
   }
   if (map_libs) {
     for (auto lib : *map_libs)
@@ -94,6 +92,7 @@ EquivCells::~EquivCells()
 {
   for (auto cell : unique_equiv_cells_)
     delete equiv_cells_.findKey(cell);
+  cell_keys_.deleteContents();
 }
 
 LibertyCellSeq *
@@ -102,6 +101,42 @@ EquivCells::equivs(LibertyCell *cell)
   return equiv_cells_.findKey(cell);
 }
 
+const EquivCellKey *
+EquivCells::key(const LibertyCell *cell) const
+{
+  return cell_keys_.findKey(cell);
+}
+
+void
+EquivCells::makeKey(const LibertyCell *cell)
+{
+  if (!cell_keys_.hasKey(cell)) {
+    EquivCellKey *key = new EquivCellKey;
+    key->drive_resistance_ = cellDriveResistance(cell);
+    key->input_cap_ = 0.0;
+    LibertyCellPortBitIterator port_iter(cell);
+    while (port_iter.hasNext()) {
+      LibertyPort *port = port_iter.next();
+      if (port->direction()->isAnyInput())
+        key->input_cap_ += port->capacitance();
+    }
+    bool exists;
+    cell->leakagePower(key->leakage_, exists);
+    if (!exists)
+      key->leakage_ = 0.0;
+    key->area_ = cell->area();
+    for (int ap_index = 0; ap_index < liberty_ap_count_; ap_index++) {
+      // cornerCell is not const.
+      LibertyCell *corner_cell =
+        const_cast<LibertyCell*>(cell)->cornerCell(ap_index);
+      key->corner_drive_resistances_.push_back(corner_cell
+                                               ? cellDriveResistance(corner_cell)
+                                               : key->drive_resistance_);
+    }
+    cell_keys_[cell] = key;
+  }
+}
+
 // Use a comprehensive hash on cell properties to segregate
 // cells into groups of potential matches.
 void
@@ -161,6 +196,7 @@ EquivCells::mapEquivCells(const LibertyLibrary *library,
 	  if (equivCells(match, cell)) {
 	    LibertyCellSeq *equivs = equiv_cells_.findKey(match);
 	    equiv_cells_[cell] = equivs;
+            makeKey(cell);
 	    break;
 	  }
 	}
@@ -17,6 +17,7 @@
 #include "FuncExpr.hh"
 
 #include "StringUtil.hh"
+#include "FuncExprEval.hh"
 #include "Liberty.hh"
 #include "Network.hh"
 
@@ -75,10 +76,32 @@ FuncExpr::FuncExpr(Operator op,
   op_(op),
   left_(left),
   right_(right),
-  port_(port)
+  port_(port),
+  eval_(nullptr)
 {
 }
 
+FuncExpr::~FuncExpr()
+{
+  delete eval_.load(std::memory_order_relaxed);
+}
+
+const FuncExprEval *
+FuncExpr::eval() const
+{
+  FuncExprEval *eval = eval_.load(std::memory_order_acquire);
+  if (eval == nullptr) {
+    FuncExprEval *new_eval = new FuncExprEval(this);
+    if (eval_.compare_exchange_strong(eval, new_eval,
+                                      std::memory_order_acq_rel))
+      eval = new_eval;
+    else
+      // Another thread compiled the expression first.
+      delete new_eval;
+  }
+  return eval;
+}
+
 void
 FuncExpr::deleteSubexprs()
 {
@@ -107,8 +130,19 @@ FuncExpr::port() const
 }
 
 // Protect against null sub-expressions caused by unknown port refs.
+// The truth table sense is exact; the expression sense is used for
+// larger functions and those that do not depend on a port they use.
 TimingSense
 FuncExpr::portTimingSense(const LibertyPort *port) const
+{
+  TimingSense sense = eval()->portTimingSense(port);
+  if (sense == TimingSense::unknown)
+    sense = portTimingSenseExpr(port);
+  return sense;
+}
+
+TimingSense
+FuncExpr::portTimingSenseExpr(const LibertyPort *port) const
 {
   TimingSense left_sense, right_sense;
 
@@ -120,7 +154,7 @@ FuncExpr::portTimingSense(const LibertyPort *port) const
       return TimingSense::none;
   case op_not:
     if (left_) {
-      switch (left_->portTimingSense(port)) {
+      switch (left_->portTimingSenseExpr(port)) {
       case TimingSense::positive_unate:
 	return TimingSense::negative_unate;
       case TimingSense::negative_unate:
@@ -139,9 +173,9 @@ FuncExpr::portTimingSense(const LibertyPort *port) const
     left_sense = TimingSense::unknown;
     right_sense = TimingSense::unknown;
     if (left_)
-      left_sense = left_->portTimingSense(port);
+      left_sense = left_->portTimingSenseExpr(port);
     if (right_)
-      right_sense = right_->portTimingSense(port);
+      right_sense = right_->portTimingSenseExpr(port);
 
     if (left_sense == right_sense)
       return left_sense;
@@ -164,9 +198,9 @@ FuncExpr::portTimingSense(const LibertyPort *port) const
     left_sense = TimingSense::unknown;
     right_sense = TimingSense::unknown;
     if (left_)
-      left_sense = left_->portTimingSense(port);
+      left_sense = left_->portTimingSenseExpr(port);
     if (right_)
-      right_sense = right_->portTimingSense(port);
+      right_sense = right_->portTimingSenseExpr(port);
     if (left_sense == TimingSense::positive_unate
 	|| left_sense == TimingSense::negative_unate
 	|| left_sense == TimingSense::non_unate
@@ -0,0 +1,301 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "FuncExprEval.hh"
+
+#include <algorithm>
+
+namespace sta {
+
+static const uint64_t port_truth_tables[FuncExprEval::truth_table_port_max] = {
+  0xaaaaaaaaaaaaaaaaULL,
+  0xccccccccccccccccULL,
+  0xf0f0f0f0f0f0f0f0ULL,
+  0xff00ff00ff00ff00ULL,
+  0xffff0000ffff0000ULL,
+  0xffffffff00000000ULL
+};
+
+// Operator values are kept on the stack for small functions.
+static constexpr size_t eval_stack_buffer_size = 16;
+
+FuncExprEval::FuncExprEval(const FuncExpr *expr) :
+  stack_size_(0),
+  truth_table_(0)
+{
+  stack_size_ = compile(expr, 1);
+  if (hasTruthTable()) {
+    uint64_t table_mask = tableMask();
+    truth_table_ = evalTruthTable() & table_mask;
+    for (size_t i = 0; i < ports_.size(); i++) {
+      // Swap the entries for port i = 0 and port i = 1.
+      uint64_t port_table = port_truth_tables[i];
+      size_t shift = size_t(1) << i;
+      uint64_t swapped = ((truth_table_ & port_table) >> shift)
+        | ((truth_table_ & ~port_table) << shift);
+      diff_tables_.push_back((truth_table_ ^ swapped) & table_mask);
+    }
+  }
+}
+
+// Append the postfix operators for expr.
+// Return the stack depth needed to evaluate it.
+size_t
+FuncExprEval::compile(const FuncExpr *expr,
+                      size_t depth)
+{
+  FuncExpr::Operator op = expr->op();
+  switch (op) {
+  case FuncExpr::op_port: {
+    LibertyPort *port = expr->port();
+    int port_index = portIndex(port);
+    if (port_index < 0) {
+      port_index = ports_.size();
+      ports_.push_back(port);
+    }
+    ops_.push_back({op, port_index});
+    return depth;
+  }
+  case FuncExpr::op_not: {
+    size_t left_depth = compile(expr->left(), depth);
+    ops_.push_back({op, -1});
+    return left_depth;
+  }
+  case FuncExpr::op_or:
+  case FuncExpr::op_and:
+  case FuncExpr::op_xor: {
+    size_t left_depth = compile(expr->left(), depth);
+    size_t right_depth = compile(expr->right(), depth + 1);
+    ops_.push_back({op, -1});
+    return std::max(left_depth, right_depth);
+  }
+  case FuncExpr::op_one:
+  case FuncExpr::op_zero:
+    ops_.push_back({op, -1});
+    return depth;
+  }
+  return depth;
+}
+
+int
+FuncExprEval::portIndex(const LibertyPort *port) const
+{
+  for (size_t i = 0; i < ports_.size(); i++) {
+    if (ports_[i] == port)
+      return i;
+  }
+  return -1;
+}
+
+uint64_t
+FuncExprEval::tableMask() const
+{
+  size_t port_count = ports_.size();
+  return (port_count == truth_table_port_max)
+    ? ~uint64_t(0)
+    : (uint64_t(1) << (size_t(1) << port_count)) - 1;
+}
+
+uint64_t
+FuncExprEval::portTable(size_t index)
+{
+  return port_truth_tables[index];
+}
+
+// Evaluate the operators on the port truth tables 64 entries at a time.
+uint64_t
+FuncExprEval::evalTruthTable() const
+{
+  uint64_t stack_buffer[eval_stack_buffer_size] = {};
+  std::vector<uint64_t> stack_vector;
+  uint64_t *stack = stack_buffer;
+  if (stack_size_ > eval_stack_buffer_size) {
+    stack_vector.resize(stack_size_);
+    stack = stack_vector.data();
+  }
+  size_t top = 0;
+  for (const Op &op : ops_) {
+    switch (op.op_) {
+    case FuncExpr::op_port:
+      stack[top++] = port_truth_tables[op.port_index_];
+      break;
+    case FuncExpr::op_not:
+      stack[top - 1] = ~stack[top - 1];
+      break;
+    case FuncExpr::op_or:
+      stack[top - 2] |= stack[top - 1];
+      top--;
+      break;
+    case FuncExpr::op_and:
+      stack[top - 2] &= stack[top - 1];
+      top--;
+      break;
+    case FuncExpr::op_xor:
+      stack[top - 2] ^= stack[top - 1];
+      top--;
+      break;
+    case FuncExpr::op_one:
+      stack[top++] = ~uint64_t(0);
+      break;
+    case FuncExpr::op_zero:
+      stack[top++] = 0;
+      break;
+    }
+  }
+  return stack[0];
+}
+
+LogicValue
+FuncExprEval::eval(const LogicValue *port_values) const
+{
+  if (hasTruthTable())
+    return evalTable(port_values);
+  else
+    return evalOps(port_values);
+}
+
+// The function is constant if it has the same value in every row of
+// the table that agrees with the ports that are 0 or 1.
+LogicValue
+FuncExprEval::evalTable(const LogicValue *port_values) const
+{
+  uint64_t care = tableMask();
+  for (size_t i = 0; i < ports_.size(); i++) {
+    LogicValue value = port_values[i];
+    if (value == LogicValue::zero)
+      care &= ~port_truth_tables[i];
+    else if (value == LogicValue::one)
+      care &= port_truth_tables[i];
+  }
+  if ((truth_table_ & care) == 0)
+    return LogicValue::zero;
+  else if ((~truth_table_ & care) == 0)
+    return LogicValue::one;
+  else
+    return LogicValue::unknown;
+}
+
+static LogicValue
+evalNot(LogicValue value)
+{
+  switch (value) {
+  case LogicValue::zero:
+    return LogicValue::one;
+  case LogicValue::one:
+    return LogicValue::zero;
+  default:
+    return LogicValue::unknown;
+  }
+}
+
+static bool
+isConstant(LogicValue value)
+{
+  return value == LogicValue::zero
+    || value == LogicValue::one;
+}
+
+LogicValue
+FuncExprEval::evalOps(const LogicValue *port_values) const
+{
+  LogicValue stack_buffer[eval_stack_buffer_size] = {};
+  std::vector<LogicValue> stack_vector;
+  LogicValue *stack = stack_buffer;
+  if (stack_size_ > eval_stack_buffer_size) {
+    stack_vector.resize(stack_size_);
+    stack = stack_vector.data();
+  }
+  size_t top = 0;
+  for (const Op &op : ops_) {
+    switch (op.op_) {
+    case FuncExpr::op_port: {
+      LogicValue value = port_values[op.port_index_];
+      stack[top++] = isConstant(value) ? value : LogicValue::unknown;
+      break;
+    }
+    case FuncExpr::op_not:
+      stack[top - 1] = evalNot(stack[top - 1]);
+      break;
+    case FuncExpr::op_or: {
+      LogicValue value1 = stack[top - 2];
+      LogicValue value2 = stack[top - 1];
+      if (value1 == LogicValue::one || value2 == LogicValue::one)
+        stack[top - 2] = LogicValue::one;
+      else if (value1 == LogicValue::zero && value2 == LogicValue::zero)
+        stack[top - 2] = LogicValue::zero;
+      else
+        stack[top - 2] = LogicValue::unknown;
+      top--;
+      break;
+    }
+    case FuncExpr::op_and: {
+      LogicValue value1 = stack[top - 2];
+      LogicValue value2 = stack[top - 1];
+      if (value1 == LogicValue::zero || value2 == LogicValue::zero)
+        stack[top - 2] = LogicValue::zero;
+      else if (value1 == LogicValue::one && value2 == LogicValue::one)
+        stack[top - 2] = LogicValue::one;
+      else
+        stack[top - 2] = LogicValue::unknown;
+      top--;
+      break;
+    }
+    case FuncExpr::op_xor: {
+      LogicValue value1 = stack[top - 2];
+      LogicValue value2 = stack[top - 1];
+      if (isConstant(value1) && isConstant(value2))
+        stack[top - 2] = (value1 == value2) ? LogicValue::zero : LogicValue::one;
+      else
+        stack[top - 2] = LogicValue::unknown;
+      top--;
+      break;
+    }
+    case FuncExpr::op_one:
+      stack[top++] = LogicValue::one;
+      break;
+    case FuncExpr::op_zero:
+      stack[top++] = LogicValue::zero;
+      break;
+    }
+  }
+  return stack[0];
+}
+
+TimingSense
+FuncExprEval::portTimingSense(const LibertyPort *port) const
+{
+  if (hasTruthTable()) {
+    int index = portIndex(port);
+    if (index < 0)
+      return TimingSense::none;
+    uint64_t port_table = port_truth_tables[index];
+    size_t shift = size_t(1) << index;
+    // Rows with the port one and the function value with the port zero.
+    uint64_t ones = truth_table_ & port_table;
+    uint64_t zeros = (truth_table_ & ~port_table) << shift;
+    bool increasing = (zeros & ~ones) == 0;
+    bool decreasing = (ones & ~zeros) == 0;
+    if (increasing && !decreasing)
+      return TimingSense::positive_unate;
+    else if (decreasing && !increasing)
+      return TimingSense::negative_unate;
+    else if (!increasing && !decreasing)
+      return TimingSense::non_unate;
+  }
+  return TimingSense::unknown;
+}
+
+} // namespace
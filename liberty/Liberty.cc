@@ -38,6 +38,7 @@
 #include "PortDirection.hh"
 #include "Corner.hh"
 #include "DcalcAnalysisPt.hh"
+#include "MemoryStats.hh"
 
 namespace sta {
 
@@ -140,10 +141,11 @@ LibertyLibrary::findLibertyCell(const char *name) const
 LibertyCellSeq
 LibertyLibrary::findLibertyCellsMatching(PatternMatch *pattern)
 {
+  loadCellsMatching(pattern);
   LibertyCellSeq matches;
-  LibertyCellIterator cell_iter(this);
+  ConcreteLibraryCellIterator cell_iter(cell_map_);
   while (cell_iter.hasNext()) {
-    LibertyCell *cell = cell_iter.next();
+    LibertyCell *cell = static_cast<LibertyCell*>(cell_iter.next());
     if (pattern->match(cell->name()))
       matches.push_back(cell);
   }
@@ -722,12 +724,16 @@ LibertyLibrary::makeCornerMap(LibertyLibrary *lib,
 			      Network *network,
 			      Report *report)
 {
-  LibertyCellIterator cell_iter(lib);
+  lib->corner_indices_.push_back(ap_index);
+  // Cells that have not been loaded are mapped when they are loaded.
+  ConcreteLibraryCellIterator cell_iter(lib->cell_map_);
   while (cell_iter.hasNext()) {
-    LibertyCell *cell = cell_iter.next();
+    LibertyCell *cell = static_cast<LibertyCell*>(cell_iter.next());
     const char *name = cell->name();
     LibertyCell *link_cell = network->findLibertyCell(name);
-    if (link_cell)
+    // Loading the link cell may have mapped the cell.
+    if (link_cell
+        && !link_cell->hasCornerCell(cell, ap_index))
       makeCornerMap(link_cell, cell, ap_index, report);
   }
 }
@@ -746,6 +752,40 @@ LibertyLibrary::makeCornerMap(LibertyCell *link_cell,
   makeCornerMap(corner_cell, link_cell, false, ap_index, report);
 }
 
+void
+LibertyLibrary::makeCornerMap(LibertyCell *cell,
+			      Network *network,
+			      Report *report)
+{
+  const char *name = cell->name();
+  LibertyCell *link_cell = network->findLibertyCell(name);
+  if (link_cell == cell) {
+    // Map the cells with the same name in the corner libraries,
+    // loading them if necessary.
+    LibertyLibraryIterator *lib_iter = network->libertyLibraryIterator();
+    while (lib_iter->hasNext()) {
+      LibertyLibrary *lib = lib_iter->next();
+      if (!lib->corner_indices_.empty()) {
+        LibertyCell *corner_cell = lib->findLibertyCell(name);
+        if (corner_cell) {
+          for (int ap_index : lib->corner_indices_) {
+            if (!link_cell->hasCornerCell(corner_cell, ap_index))
+              makeCornerMap(link_cell, corner_cell, ap_index, report);
+          }
+        }
+      }
+    }
+    delete lib_iter;
+  }
+  else if (link_cell) {
+    LibertyLibrary *lib = cell->libertyLibrary();
+    for (int ap_index : lib->corner_indices_) {
+      if (!link_cell->hasCornerCell(cell, ap_index))
+        makeCornerMap(link_cell, cell, ap_index, report);
+    }
+  }
+}
+
 void
 LibertyLibrary::makeCornerMap(LibertyCell *cell1,
 			      LibertyCell *cell2,
@@ -843,6 +883,73 @@ LibertyLibrary::setDefaultOcvDerate(OcvDerate *derate)
   default_ocv_derate_ = derate;
 }
 
+static size_t
+tableModelBytes(const TableModel *model)
+{
+  if (model == nullptr)
+    return 0;
+  size_t value_count = 1;
+  size_t axis_bytes = 0;
+  const TableAxis *axes[3] = {model->axis1(), model->axis2(), model->axis3()};
+  for (const TableAxis *axis : axes) {
+    if (axis) {
+      value_count *= axis->size();
+      axis_bytes += sizeof(TableAxis) + axis->size() * sizeof(float);
+    }
+  }
+  return sizeof(TableModel) + sizeof(Table3) + axis_bytes
+    + value_count * sizeof(float);
+}
+
+void
+LibertyLibrary::memoryStats(MemoryStats &stats) const
+{
+  size_t cell_count = 0;
+  size_t port_count = 0;
+  size_t arc_set_count = 0;
+  size_t arc_count = 0;
+  size_t table_count = 0;
+  size_t table_bytes = 0;
+  LibertyCellIterator cell_iter(this);
+  while (cell_iter.hasNext()) {
+    LibertyCell *cell = cell_iter.next();
+    cell_count++;
+    LibertyCellPortBitIterator port_iter(cell);
+    while (port_iter.hasNext()) {
+      port_iter.next();
+      port_count++;
+    }
+    for (const TimingArcSet *arc_set : cell->timingArcSets()) {
+      arc_set_count++;
+      for (const TimingArc *arc : arc_set->arcs()) {
+        arc_count++;
+        TimingModel *model = arc->model();
+        GateTableModel *gate_model = dynamic_cast<GateTableModel*>(model);
+        if (gate_model) {
+          for (const TableModel *table : {gate_model->delayModel(),
+                                          gate_model->slewModel()}) {
+            if (table) {
+              table_count++;
+              table_bytes += tableModelBytes(table);
+            }
+          }
+        }
+        CheckTableModel *check_model = dynamic_cast<CheckTableModel*>(model);
+        if (check_model && check_model->model()) {
+          table_count++;
+          table_bytes += tableModelBytes(check_model->model());
+        }
+      }
+    }
+  }
+  stats.add("liberty", "cells", cell_count, cell_count * sizeof(LibertyCell));
+  stats.add("liberty", "ports", port_count, port_count * sizeof(LibertyPort));
+  stats.add("liberty", "timing arc sets", arc_set_count,
+            arc_set_count * sizeof(TimingArcSet));
+  stats.add("liberty", "timing arcs", arc_count, arc_count * sizeof(TimingArc));
+  stats.add("liberty", "delay/slew tables", table_count, table_bytes);
+}
+
 OcvDerate *
 LibertyLibrary::findOcvDerate(const char *derate_name)
 {
@@ -896,9 +1003,10 @@ LibertyLibrary::addDriverWaveform(DriverWaveform *driver_waveform)
 
 ////////////////////////////////////////////////////////////////
 
-LibertyCellIterator::LibertyCellIterator(const LibertyLibrary *library) :
-  iter_(library->cell_map_)
+LibertyCellIterator::LibertyCellIterator(const LibertyLibrary *library)
 {
+  library->loadCells();
+  iter_.init(library->cell_map_);
 }
 
 bool
@@ -1307,6 +1415,33 @@ LibertyCell::finish(bool infer_latches,
   makeLatchEnables(report, debug);
   if (infer_latches)
     inferLatchRoles(debug);
+  compileFuncExprs();
+}
+
+// Compile the functions evaluated by simulation, power and latch
+// analysis so they are not compiled while searching.
+void
+LibertyCell::compileFuncExprs()
+{
+  LibertyCellPortBitIterator port_iter(this);
+  while (port_iter.hasNext()) {
+    LibertyPort *port = port_iter.next();
+    if (port->function())
+      port->function()->eval();
+    if (port->tristateEnable())
+      port->tristateEnable()->eval();
+  }
+  for (Sequential *seq : sequentials_) {
+    for (FuncExpr *expr : {seq->clock(), seq->data(),
+                           seq->clear(), seq->preset()}) {
+      if (expr)
+        expr->eval();
+    }
+  }
+  for (TimingArcSet *arc_set : timing_arc_sets_) {
+    if (arc_set->cond())
+      arc_set->cond()->eval();
+  }
 }
 
 void
@@ -1596,17 +1731,6 @@ LibertyCell::cornerCell(const DcalcAnalysisPt *dcalc_ap)
   return cornerCell(dcalc_ap->libertyIndex());
 }
 
-LibertyCell *
-LibertyCell::cornerCell(int ap_index)
-{
-  if (corner_cells_.empty())
-    return this;
-  else if (ap_index < static_cast<int>(corner_cells_.size()))
-    return corner_cells_[ap_index];
-  else
-    return nullptr;
-}
-
 bool
 LibertyCell::checkCornerCell(const Corner *corner,
                              const MinMax *min_max) const
@@ -1617,6 +1741,14 @@ LibertyCell::checkCornerCell(const Corner *corner,
         && corner_cells_[lib_index]);
 }
 
+bool
+LibertyCell::hasCornerCell(const LibertyCell *corner_cell,
+                           int ap_index) const
+{
+  return ap_index < static_cast<int>(corner_cells_.size())
+    && corner_cells_[ap_index] == corner_cell;
+}
+
 void
 LibertyCell::setCornerCell(LibertyCell *corner_cell,
 			   int ap_index)
@@ -1907,7 +2039,7 @@ LibertyCell::ensureVoltageWaveforms()
         if (model) {
           OutputWaveforms *output_waveforms = model->outputWaveforms();
           if (output_waveforms)
-            output_waveforms->makeVoltageWaveforms(vdd);
+            output_waveforms->setVdd(vdd);
         }
       }
     }
@@ -2498,28 +2630,6 @@ LibertyPort::cornerPort(const DcalcAnalysisPt *dcalc_ap) const
   return cornerPort(dcalc_ap->libertyIndex());
 }
 
-LibertyPort *
-LibertyPort::cornerPort(int ap_index)
-{
-  if (corner_ports_.empty())
-    return this;
-  else if (ap_index < static_cast<int>(corner_ports_.size()))
-    return corner_ports_[ap_index];
-  else
-    return nullptr;
-}
-
-const LibertyPort *
-LibertyPort::cornerPort(int ap_index) const
-{
-  if (corner_ports_.empty())
-    return this;
-  else if (ap_index < static_cast<int>(corner_ports_.size()))
-    return corner_ports_[ap_index];
-  else
-    return nullptr;
-}
-
 void
 LibertyPort::setCornerPort(LibertyPort *corner_port,
 			   int ap_index)
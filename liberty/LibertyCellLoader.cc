@@ -0,0 +1,364 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "LibertyCellLoader.hh"
+
+#include <cctype>
+#include <cstring>
+#include <vector>
+
+#include "Error.hh"
+#include "PatternMatch.hh"
+#include "Network.hh"
+#include "Liberty.hh"
+#include "LibertyParser.hh"
+
+namespace sta {
+
+using std::string;
+
+LibertyCellLoader::LibertyCellLoader(const char *filename,
+                                     bool infer_latches,
+                                     bool lazy,
+                                     Network *network) :
+  filename_(stringCopy(filename)),
+  infer_latches_(infer_latches),
+  lazy_(lazy),
+  network_(network),
+  cell_dispatch_queue_(nullptr),
+  library_(nullptr),
+  text_read_(false),
+  text_(nullptr),
+  text_size_(0)
+{
+}
+
+LibertyCellLoader::~LibertyCellLoader()
+{
+  stringDelete(filename_);
+}
+
+void
+LibertyCellLoader::setCellDispatchQueue(DispatchQueue *dispatch_queue)
+{
+  cell_dispatch_queue_ = dispatch_queue;
+}
+
+LibertyLibrary *
+LibertyCellLoader::readLibrary()
+{
+  if (!text_read_ && !readText())
+    throw FileNotReadable(filename_);
+  Report *report = network_->report();
+  reader_.init(filename_, infer_latches_, network_);
+  reader_.setCellDispatchQueue(cell_dispatch_queue_);
+  string library_text;
+  if (lazy_ && indexCells(library_text))
+    parseLibertyBuffer(library_text.c_str(), library_text.size(),
+                       filename_, 1, &reader_, report);
+  else {
+    // Read all of the cells.
+    cells_.clear();
+    parseLibertyBuffer(text_, text_size_, filename_, 1, &reader_, report);
+  }
+  // Cells read lazily are built by the thread that finds them.
+  reader_.setCellDispatchQueue(nullptr);
+  library_ = reader_.library();
+  if (cells_.empty())
+    releaseText();
+  return library_;
+}
+
+bool
+LibertyCellLoader::readText()
+{
+  if (!file_.open(filename_))
+    return false;
+  text_read_ = true;
+  if (file_.isMapped()) {
+    text_ = file_.mapData();
+    text_size_ = file_.mapSize();
+  }
+  else {
+    // Keep the uncompressed text to read cells from.
+    const size_t buffer_size = 1 << 16;
+    char buffer[buffer_size];
+    size_t length;
+    while ((length = file_.read(buffer, buffer_size)) > 0)
+      file_text_.append(buffer, length);
+    file_.close();
+    text_ = file_text_.c_str();
+    text_size_ = file_text_.size();
+  }
+  return true;
+}
+
+void
+LibertyCellLoader::releaseText()
+{
+  file_.close();
+  string().swap(file_text_);
+  text_ = nullptr;
+  text_size_ = 0;
+}
+
+// Index the cell groups in the library group and copy the rest of the
+// text to library_text. Cell groups are replaced by their newlines so
+// the library text line numbers match the file.
+// Return false if the cells cannot be read lazily.
+bool
+LibertyCellLoader::indexCells(string &library_text)
+{
+  int depth = 0;
+  int line = 1;
+  size_t copy_begin = 0;
+  size_t i = 0;
+  while (i < text_size_) {
+    char ch = text_[i];
+    if (ch == '\n') {
+      line++;
+      i++;
+    }
+    else if (ch == '"')
+      i = skipString(i, line);
+    else if (ch == '/' && i + 1 < text_size_ && text_[i + 1] == '*')
+      i = skipComment(i, line);
+    else if (ch == '{') {
+      depth++;
+      i++;
+    }
+    else if (ch == '}') {
+      depth--;
+      i++;
+    }
+    else if (isalnum(ch) || ch == '_') {
+      size_t token_begin = i;
+      while (i < text_size_
+             && (isalnum(text_[i]) || text_[i] == '_' || text_[i] == '.'))
+        i++;
+      if (depth == 1) {
+        size_t token_length = i - token_begin;
+        const char *token = &text_[token_begin];
+        if (token_length == strlen("scaled_cell")
+            && strncmp(token, "scaled_cell", token_length) == 0)
+          // Scaled cells reference cells while the library is read.
+          return false;
+        int cell_line = line;
+        string name;
+        if (token_length == strlen("cell")
+            && strncmp(token, "cell", token_length) == 0
+            && findCellGroup(i, line, name)) {
+          LibertyCellText &cell_text = cells_[name];
+          cell_text.begin_ = token_begin;
+          cell_text.end_ = i;
+          cell_text.line_ = cell_line;
+          library_text.append(&text_[copy_begin], token_begin - copy_begin);
+          library_text.append(line - cell_line, '\n');
+          copy_begin = i;
+        }
+      }
+    }
+    else
+      i++;
+  }
+  library_text.append(&text_[copy_begin], text_size_ - copy_begin);
+  return true;
+}
+
+// Find the rest of a cell group after the cell keyword.
+// index is set to the end of the group.
+bool
+LibertyCellLoader::findCellGroup(size_t &index,
+                                 int &line,
+                                 string &name)
+{
+  int line1 = line;
+  size_t i = skipBlanks(index, line1);
+  if (i < text_size_ && text_[i] == '(') {
+    i = skipBlanks(i + 1, line1);
+    if (i < text_size_ && text_[i] == '"') {
+      size_t name_begin = i + 1;
+      i = skipString(i, line1);
+      name.assign(&text_[name_begin], i - 1 - name_begin);
+    }
+    else {
+      size_t name_begin = i;
+      while (i < text_size_
+             && !isspace(text_[i])
+             && text_[i] != ')'
+             && text_[i] != ',')
+        i++;
+      name.assign(&text_[name_begin], i - name_begin);
+    }
+    i = skipBlanks(i, line1);
+    if (!name.empty()
+        && i < text_size_ && text_[i] == ')') {
+      i = skipBlanks(i + 1, line1);
+      if (i < text_size_ && text_[i] == '{') {
+        i = skipGroup(i, line1);
+        // Optional semicolon after the group.
+        int line2 = line1;
+        size_t j = skipBlanks(i, line2);
+        if (j < text_size_ && text_[j] == ';') {
+          i = j + 1;
+          line1 = line2;
+        }
+        index = i;
+        line = line1;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Return the index after the '}' matching the '{' at index.
+size_t
+LibertyCellLoader::skipGroup(size_t index,
+                             int &line) const
+{
+  int depth = 0;
+  size_t i = index;
+  while (i < text_size_) {
+    char ch = text_[i];
+    if (ch == '\n') {
+      line++;
+      i++;
+    }
+    else if (ch == '"')
+      i = skipString(i, line);
+    else if (ch == '/' && i + 1 < text_size_ && text_[i + 1] == '*')
+      i = skipComment(i, line);
+    else if (ch == '{') {
+      depth++;
+      i++;
+    }
+    else if (ch == '}') {
+      depth--;
+      i++;
+      if (depth == 0)
+        break;
+    }
+    else
+      i++;
+  }
+  return i;
+}
+
+// Return the index after the string starting at index.
+// Strings end at an unescaped newline like the lexer.
+size_t
+LibertyCellLoader::skipString(size_t index,
+                              int &line) const
+{
+  size_t i = index + 1;
+  while (i < text_size_) {
+    char ch = text_[i];
+    if (ch == '"')
+      return i + 1;
+    else if (ch == '\n')
+      return i;
+    else if (ch == '\\' && i + 1 < text_size_) {
+      if (text_[i + 1] == '\n')
+        line++;
+      i += 2;
+    }
+    else
+      i++;
+  }
+  return i;
+}
+
+size_t
+LibertyCellLoader::skipComment(size_t index,
+                               int &line) const
+{
+  size_t i = index + 2;
+  while (i < text_size_) {
+    if (text_[i] == '\n')
+      line++;
+    else if (text_[i] == '*'
+             && i + 1 < text_size_
+             && text_[i + 1] == '/')
+      return i + 2;
+    i++;
+  }
+  return i;
+}
+
+size_t
+LibertyCellLoader::skipBlanks(size_t index,
+                              int &line) const
+{
+  size_t i = index;
+  while (i < text_size_) {
+    char ch = text_[i];
+    if (ch == '\n')
+      line++;
+    else if (!(isspace(ch) || ch == '\\'))
+      break;
+    i++;
+  }
+  return i;
+}
+
+ConcreteCell *
+LibertyCellLoader::loadCell(const char *name)
+{
+  auto cell_iter = cells_.find(name);
+  if (cell_iter == cells_.end())
+    return nullptr;
+  else {
+    LibertyCellText cell_text = cell_iter->second;
+    // Erase the cell first so a failed read is not repeated.
+    cells_.erase(cell_iter);
+    Report *report = network_->report();
+    parseLibertyBuffer(&text_[cell_text.begin_],
+                       cell_text.end_ - cell_text.begin_,
+                       filename_, cell_text.line_, &reader_, report);
+    LibertyCell *cell = library_->findLibertyCell(name);
+    if (cells_.empty())
+      releaseText();
+    if (cell)
+      LibertyLibrary::makeCornerMap(cell, network_, report);
+    return cell;
+  }
+}
+
+void
+LibertyCellLoader::loadCellsMatching(const PatternMatch *pattern)
+{
+  std::vector<string> names;
+  for (auto &name_text : cells_) {
+    const string &name = name_text.first;
+    if (pattern->match(name.c_str()))
+      names.push_back(name);
+  }
+  for (const string &name : names)
+    loadCell(name.c_str());
+}
+
+void
+LibertyCellLoader::loadCells()
+{
+  std::vector<string> names;
+  for (auto &name_text : cells_)
+    names.push_back(name_text.first);
+  for (const string &name : names)
+    loadCell(name.c_str());
+}
+
+} // namespace
@@ -0,0 +1,101 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+
+#include "Map.hh"
+#include "InputFile.hh"
+#include "ConcreteLibrary.hh"
+#include "TableModel.hh"
+#include "LibertyBuilder.hh"
+#include "LibertyReaderPvt.hh"
+
+namespace sta {
+
+class Network;
+class LibertyLibrary;
+class DispatchQueue;
+
+// Location of a cell group in the liberty file text.
+class LibertyCellText
+{
+public:
+  size_t begin_;
+  size_t end_;
+  int line_;
+};
+
+typedef Map<std::string, LibertyCellText> LibertyCellTextMap;
+
+// Liberty reader that parses the file text from memory.
+// With lazy, the library is read without its cell groups, which are
+// indexed by their location in the file text. Cells are read when they
+// are first found in the library.
+class LibertyCellLoader : public ConcreteCellLoader
+{
+public:
+  LibertyCellLoader(const char *filename,
+                    bool infer_latches,
+                    bool lazy,
+                    Network *network);
+  virtual ~LibertyCellLoader();
+  // Map or uncompress the file text.
+  // Does not reference the network so it can be called by threads.
+  // Return true if the file is readable.
+  bool readText();
+  // Build the cells read with the library with the dispatch queue threads.
+  void setCellDispatchQueue(DispatchQueue *dispatch_queue);
+  LibertyLibrary *readLibrary();
+  bool hasCells() const { return !cells_.empty(); }
+  ConcreteCell *loadCell(const char *name) override;
+  void loadCellsMatching(const PatternMatch *pattern) override;
+  void loadCells() override;
+
+private:
+  bool indexCells(std::string &library_text);
+  bool findCellGroup(size_t &index,
+                     int &line,
+                     std::string &name);
+  size_t skipGroup(size_t index,
+                   int &line) const;
+  size_t skipString(size_t index,
+                    int &line) const;
+  size_t skipComment(size_t index,
+                     int &line) const;
+  size_t skipBlanks(size_t index,
+                    int &line) const;
+  void releaseText();
+
+  const char *filename_;
+  bool infer_latches_;
+  bool lazy_;
+  Network *network_;
+  LibertyReader reader_;
+  DispatchQueue *cell_dispatch_queue_;
+  LibertyLibrary *library_;
+  // Uncompressed files are mapped.
+  InputFile file_;
+  // Compressed file text.
+  std::string file_text_;
+  bool text_read_;
+  const char *text_;
+  size_t text_size_;
+  LibertyCellTextMap cells_;
+};
+
+} // namespace
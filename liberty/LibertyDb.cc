@@ -0,0 +1,522 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "LibertyDb.hh"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Error.hh"
+#include "Report.hh"
+#include "StringUtil.hh"
+#include "Network.hh"
+#include "TableModel.hh"
+#include "LibertyParser.hh"
+#include "LibertyBuilder.hh"
+#include "LibertyReaderPvt.hh"
+
+namespace sta {
+
+using std::string;
+
+// File layout (host byte order):
+//  header       magic[8] version byte_order liberty_filename
+//  statements   {record ...}
+//   group_begin type line param_count value[param_count]
+//   group_end
+//   simple_attr name line value
+//   complex_attr name line value_count value[value_count]
+//   variable    name line float
+//  end          record_end
+//  value        kind (0 float, 1 string) float|string
+//  string       id {length chars[length] null}
+// Strings are numbered in file order and the chars follow the first
+// use of each id, so repeated names are only written once.
+// The statements are in liberty text order so reading them visits the
+// liberty reader the same way parsing the text does. Define statements
+// are not used by the reader and are not written.
+static const char liberty_db_magic[8] = {'S', 'T', 'A', 'L', 'I', 'B', 'D', 'B'};
+static const uint32_t liberty_db_version = 1;
+static const uint32_t liberty_db_byte_order = 0x01020304;
+
+enum class LibertyDbRecord : uint8_t {
+  end,
+  group_begin,
+  group_end,
+  simple_attr,
+  complex_attr,
+  variable
+};
+
+enum class LibertyDbValue : uint8_t {
+  float_value,
+  string_value
+};
+
+class LibertyDbWriter : public LibertyGroupVisitor
+{
+public:
+  LibertyDbWriter(const char *filename);
+  virtual ~LibertyDbWriter();
+  void write(const char *liberty_filename,
+             Report *report);
+
+  virtual void begin(LibertyGroup *group);
+  virtual void end(LibertyGroup *group);
+  virtual void visitAttr(LibertyAttr *attr);
+  virtual void visitVariable(LibertyVariable *variable);
+  virtual bool save(LibertyGroup *) { return false; }
+  virtual bool save(LibertyAttr *) { return false; }
+  virtual bool save(LibertyVariable *) { return false; }
+
+private:
+  void writeAttrValues(LibertyAttrValueSeq *values);
+  void writeAttrValue(LibertyAttrValue *value);
+  void writeString(const char *str);
+  template <class VALUE>
+  void writeValue(VALUE value);
+  void writeBytes(const void *bytes,
+                  size_t size);
+
+  const char *filename_;
+  FILE *stream_;
+  std::unordered_map<string, uint32_t> string_ids_;
+};
+
+void
+writeLibertyDb(const char *liberty_filename,
+               const char *filename,
+               Report *report)
+{
+  LibertyDbWriter writer(filename);
+  writer.write(liberty_filename, report);
+}
+
+LibertyDbWriter::LibertyDbWriter(const char *filename) :
+  LibertyGroupVisitor(),
+  filename_(filename),
+  stream_(nullptr)
+{
+}
+
+LibertyDbWriter::~LibertyDbWriter()
+{
+  if (stream_)
+    fclose(stream_);
+}
+
+void
+LibertyDbWriter::write(const char *liberty_filename,
+                       Report *report)
+{
+  stream_ = fopen(filename_, "wb");
+  if (stream_ == nullptr)
+    throw FileNotWritable(filename_);
+  writeBytes(liberty_db_magic, sizeof(liberty_db_magic));
+  writeValue(liberty_db_version);
+  writeValue(liberty_db_byte_order);
+  writeString(liberty_filename);
+  // The statements are written as they are parsed.
+  parseLibertyFile(liberty_filename, this, report);
+  writeValue(LibertyDbRecord::end);
+}
+
+void
+LibertyDbWriter::begin(LibertyGroup *group)
+{
+  writeValue(LibertyDbRecord::group_begin);
+  writeString(group->type());
+  writeValue(static_cast<int32_t>(group->line()));
+  writeAttrValues(group->params());
+}
+
+void
+LibertyDbWriter::end(LibertyGroup *)
+{
+  writeValue(LibertyDbRecord::group_end);
+}
+
+void
+LibertyDbWriter::visitAttr(LibertyAttr *attr)
+{
+  if (attr->isSimple()) {
+    writeValue(LibertyDbRecord::simple_attr);
+    writeString(attr->name());
+    writeValue(static_cast<int32_t>(attr->line()));
+    writeAttrValue(attr->firstValue());
+  }
+  else {
+    writeValue(LibertyDbRecord::complex_attr);
+    writeString(attr->name());
+    writeValue(static_cast<int32_t>(attr->line()));
+    writeAttrValues(attr->values());
+  }
+}
+
+void
+LibertyDbWriter::visitVariable(LibertyVariable *variable)
+{
+  writeValue(LibertyDbRecord::variable);
+  writeString(variable->variable());
+  writeValue(static_cast<int32_t>(variable->line()));
+  writeValue(variable->value());
+}
+
+void
+LibertyDbWriter::writeAttrValues(LibertyAttrValueSeq *values)
+{
+  if (values) {
+    writeValue(static_cast<uint32_t>(values->size()));
+    for (LibertyAttrValue *value : *values)
+      writeAttrValue(value);
+  }
+  else
+    writeValue(static_cast<uint32_t>(0));
+}
+
+void
+LibertyDbWriter::writeAttrValue(LibertyAttrValue *value)
+{
+  if (value->isFloat()) {
+    writeValue(LibertyDbValue::float_value);
+    writeValue(value->floatValue());
+  }
+  else {
+    writeValue(LibertyDbValue::string_value);
+    writeString(value->stringValue());
+  }
+}
+
+void
+LibertyDbWriter::writeString(const char *str)
+{
+  auto itr = string_ids_.find(str);
+  if (itr == string_ids_.end()) {
+    uint32_t id = string_ids_.size();
+    string_ids_[str] = id;
+    size_t length = strlen(str);
+    writeValue(id);
+    writeValue(static_cast<uint32_t>(length));
+    writeBytes(str, length + 1);
+  }
+  else
+    writeValue(itr->second);
+}
+
+template <class VALUE>
+void
+LibertyDbWriter::writeValue(VALUE value)
+{
+  writeBytes(&value, sizeof(VALUE));
+}
+
+void
+LibertyDbWriter::writeBytes(const void *bytes,
+                            size_t size)
+{
+  if (size > 0)
+    fwrite(bytes, size, 1, stream_);
+}
+
+////////////////////////////////////////////////////////////////
+
+class LibertyDbReader
+{
+public:
+  LibertyDbReader(const char *filename,
+                  Report *report);
+  LibertyLibrary *read(bool infer_latches,
+                       Network *network);
+
+private:
+  bool readFile();
+  bool readHeader();
+  bool readStmts();
+  LibertyAttrValueSeq *readAttrValues();
+  LibertyAttrValue *readAttrValue();
+  const char *readString();
+  template <class VALUE>
+  VALUE readValue();
+  bool readBytes(void *bytes,
+                 size_t size);
+
+  const char *filename_;
+  Report *report_;
+  std::vector<char> data_;
+  size_t pos_;
+  bool corrupt_;
+  // Indexed by string id; the chars are in data_.
+  std::vector<const char*> strings_;
+  string liberty_filename_;
+};
+
+LibertyLibrary *
+readLibertyDb(const char *filename,
+              bool infer_latches,
+              Network *network)
+{
+  LibertyDbReader reader(filename, network->report());
+  return reader.read(infer_latches, network);
+}
+
+LibertyDbReader::LibertyDbReader(const char *filename,
+                                 Report *report) :
+  filename_(filename),
+  report_(report),
+  pos_(0),
+  corrupt_(false)
+{
+}
+
+LibertyLibrary *
+LibertyDbReader::read(bool infer_latches,
+                      Network *network)
+{
+  if (!readFile())
+    throw FileNotReadable(filename_);
+  if (!readHeader())
+    return nullptr;
+  // Warnings reference the lines of the liberty file the db was
+  // written from.
+  LibertyReader reader;
+  reader.init(liberty_filename_.c_str(), infer_latches, network);
+  libertyVisitBegin(liberty_filename_.c_str(), &reader, report_);
+  bool success;
+  try {
+    success = readStmts();
+  }
+  catch (...) {
+    libertyVisitEnd();
+    throw;
+  }
+  libertyVisitEnd();
+  if (!success) {
+    report_->warn(1679, "liberty db %s is corrupt.", filename_);
+    return nullptr;
+  }
+  return reader.library();
+}
+
+// The whole file is read with one fread and decoded from memory.
+bool
+LibertyDbReader::readFile()
+{
+  FILE *stream = fopen(filename_, "rb");
+  if (stream == nullptr)
+    return false;
+  bool success = false;
+  if (fseek(stream, 0, SEEK_END) == 0) {
+    long size = ftell(stream);
+    if (size >= 0
+        && fseek(stream, 0, SEEK_SET) == 0) {
+      data_.resize(size);
+      success = fread(data_.data(), 1, size, stream) == static_cast<size_t>(size);
+    }
+  }
+  fclose(stream);
+  return success;
+}
+
+bool
+LibertyDbReader::readHeader()
+{
+  char magic[sizeof(liberty_db_magic)];
+  if (!readBytes(magic, sizeof(magic))
+      || memcmp(magic, liberty_db_magic, sizeof(magic)) != 0) {
+    report_->warn(1677, "%s is not a liberty db file.", filename_);
+    return false;
+  }
+  uint32_t version = readValue<uint32_t>();
+  uint32_t byte_order = readValue<uint32_t>();
+  if (version != liberty_db_version
+      || byte_order != liberty_db_byte_order) {
+    report_->warn(1678, "liberty db %s version or byte order not supported.",
+                  filename_);
+    return false;
+  }
+  const char *liberty_filename = readString();
+  if (liberty_filename == nullptr) {
+    report_->warn(1680, "liberty db %s is corrupt.", filename_);
+    return false;
+  }
+  liberty_filename_ = liberty_filename;
+  return true;
+}
+
+bool
+LibertyDbReader::readStmts()
+{
+  int depth = 0;
+  for (;;) {
+    LibertyDbRecord record = readValue<LibertyDbRecord>();
+    if (corrupt_)
+      return false;
+    switch (record) {
+    case LibertyDbRecord::end:
+      return depth == 0;
+    case LibertyDbRecord::group_begin: {
+      const char *type = readString();
+      int line = readValue<int32_t>();
+      LibertyAttrValueSeq *params = readAttrValues();
+      if (corrupt_)
+        return false;
+      libertyGroupBegin(stringCopy(type), params, line);
+      depth++;
+      break;
+    }
+    case LibertyDbRecord::group_end:
+      if (depth == 0)
+        return false;
+      libertyGroupEnd();
+      depth--;
+      break;
+    case LibertyDbRecord::simple_attr: {
+      const char *name = readString();
+      int line = readValue<int32_t>();
+      LibertyAttrValue *value = readAttrValue();
+      if (corrupt_ || depth == 0) {
+        delete value;
+        return false;
+      }
+      makeLibertySimpleAttr(stringCopy(name), value, line);
+      break;
+    }
+    case LibertyDbRecord::complex_attr: {
+      const char *name = readString();
+      int line = readValue<int32_t>();
+      LibertyAttrValueSeq *values = readAttrValues();
+      if (corrupt_ || depth == 0) {
+        if (values) {
+          values->deleteContents();
+          delete values;
+        }
+        return false;
+      }
+      makeLibertyComplexAttr(stringCopy(name), values, line);
+      break;
+    }
+    case LibertyDbRecord::variable: {
+      const char *name = readString();
+      int line = readValue<int32_t>();
+      float value = readValue<float>();
+      if (corrupt_)
+        return false;
+      makeLibertyVariable(stringCopy(name), value, line);
+      break;
+    }
+    default:
+      return false;
+    }
+  }
+}
+
+// Return null for no values like the parser.
+LibertyAttrValueSeq *
+LibertyDbReader::readAttrValues()
+{
+  uint32_t count = readValue<uint32_t>();
+  if (corrupt_ || count == 0)
+    return nullptr;
+  LibertyAttrValueSeq *values = new LibertyAttrValueSeq;
+  for (uint32_t i = 0; i < count; i++) {
+    LibertyAttrValue *value = readAttrValue();
+    if (value == nullptr) {
+      values->deleteContents();
+      delete values;
+      return nullptr;
+    }
+    values->push_back(value);
+  }
+  return values;
+}
+
+LibertyAttrValue *
+LibertyDbReader::readAttrValue()
+{
+  LibertyDbValue kind = readValue<LibertyDbValue>();
+  if (!corrupt_) {
+    if (kind == LibertyDbValue::float_value) {
+      float value = readValue<float>();
+      if (!corrupt_)
+        return makeLibertyFloatAttrValue(value);
+    }
+    else if (kind == LibertyDbValue::string_value) {
+      const char *value = readString();
+      if (value)
+        return makeLibertyStringAttrValue(stringCopy(value));
+    }
+    else
+      corrupt_ = true;
+  }
+  return nullptr;
+}
+
+const char *
+LibertyDbReader::readString()
+{
+  uint32_t id = readValue<uint32_t>();
+  if (corrupt_)
+    return nullptr;
+  if (id < strings_.size())
+    return strings_[id];
+  else if (id == strings_.size()) {
+    uint32_t length = readValue<uint32_t>();
+    if (corrupt_
+        || length >= data_.size() - pos_
+        || data_[pos_ + length] != '\0') {
+      corrupt_ = true;
+      return nullptr;
+    }
+    const char *str = data_.data() + pos_;
+    pos_ += length + 1;
+    strings_.push_back(str);
+    return str;
+  }
+  else {
+    corrupt_ = true;
+    return nullptr;
+  }
+}
+
+template <class VALUE>
+VALUE
+LibertyDbReader::readValue()
+{
+  VALUE value{};
+  readBytes(&value, sizeof(VALUE));
+  return value;
+}
+
+bool
+LibertyDbReader::readBytes(void *bytes,
+                           size_t size)
+{
+  if (size > data_.size() - pos_) {
+    corrupt_ = true;
+    pos_ = data_.size();
+    return false;
+  }
+  if (size > 0)
+    memcpy(bytes, data_.data() + pos_, size);
+  pos_ += size;
+  return true;
+}
+
+} // namespace
@@ -17,6 +17,8 @@
 #include "FuncExpr.hh"
 
 #include <algorithm> // min
+#include <mutex>
+
 #include "Report.hh"
 #include "StringUtil.hh"
 #include "Liberty.hh"
@@ -28,6 +30,9 @@ LibertyExprParse_parse();
 namespace sta {
 
 LibExprParser *libexpr_parser;
+// The bison parser and flex lexer state is global, so liberty cell
+// builder threads take turns parsing functions.
+static std::mutex libexpr_lock;
 
 FuncExpr *
 parseFuncExpr(const char *func,
@@ -36,6 +41,7 @@ parseFuncExpr(const char *func,
 	      Report *report)
 {
   if (func != nullptr && func[0] != '\0') {
+    std::lock_guard<std::mutex> lock(libexpr_lock);
     LibExprParser parser(func, cell, error_msg, report);
     libexpr_parser = &parser;
     LibertyExprParse_parse();
@@ -18,6 +18,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <utility>
 
 #include "Report.hh"
 #include "Error.hh"
@@ -27,18 +28,20 @@
 
 int
 LibertyParse_parse();
+void
+libertyParseFlushBuffer();
 
 namespace sta {
 
 typedef Vector<LibertyGroup*> LibertyGroupSeq;
 
 static const char *liberty_filename;
-static gzFile liberty_stream;
+static InputFile *liberty_stream;
 static int liberty_line;
 // Previous lex reader state for include files.
 static const char *liberty_filename_prev;
 static int liberty_line_prev;
-static gzFile liberty_stream_prev;
+static InputFile *liberty_stream_prev;
 
 static LibertyGroupVisitor *liberty_group_visitor;
 static LibertyGroupSeq liberty_group_stack;
@@ -54,37 +57,88 @@ groupType(const char *group_type_name);
 
 ////////////////////////////////////////////////////////////////
 
+static void
+parseLibertyStream(InputFile *stream,
+                   const char *filename,
+                   int line,
+                   LibertyGroupVisitor *library_visitor,
+                   Report *report);
+
 void
 parseLibertyFile(const char *filename,
 		 LibertyGroupVisitor *library_visitor,
 		 Report *report)
 {
-  liberty_stream = gzopen(filename, "r");
-  if (liberty_stream) {
-    liberty_group_visitor = library_visitor;
-    liberty_group_stack.clear();
-    liberty_filename = filename;
-    liberty_filename_prev = nullptr;
-    liberty_stream_prev = nullptr;
-    liberty_line = 1;
-    liberty_report = report;
-    LibertyParse_parse();
-    gzclose(liberty_stream);
-  }
+  InputFile stream;
+  if (stream.open(filename))
+    parseLibertyStream(&stream, filename, 1, library_visitor, report);
   else
     throw FileNotReadable(filename);
 }
 
+void
+parseLibertyBuffer(const char *buffer,
+                   size_t size,
+                   const char *filename,
+                   int line,
+                   LibertyGroupVisitor *library_visitor,
+                   Report *report)
+{
+  InputFile stream;
+  stream.openBuffer(buffer, size);
+  // Discard input left from a previous parse that did not finish.
+  ::libertyParseFlushBuffer();
+  parseLibertyStream(&stream, filename, line, library_visitor, report);
+}
+
+static void
+parseLibertyStream(InputFile *stream,
+                   const char *filename,
+                   int line,
+                   LibertyGroupVisitor *library_visitor,
+                   Report *report)
+{
+  liberty_stream = stream;
+  liberty_group_visitor = library_visitor;
+  liberty_group_stack.clear();
+  liberty_filename = filename;
+  liberty_filename_prev = nullptr;
+  liberty_stream_prev = nullptr;
+  liberty_line = line;
+  liberty_report = report;
+  LibertyParse_parse();
+  liberty_stream = nullptr;
+}
+
+void
+libertyVisitBegin(const char *filename,
+                  LibertyGroupVisitor *library_visitor,
+                  Report *report)
+{
+  liberty_stream = nullptr;
+  liberty_group_visitor = library_visitor;
+  liberty_group_stack.clear();
+  liberty_filename = filename;
+  liberty_filename_prev = nullptr;
+  liberty_stream_prev = nullptr;
+  liberty_line = 1;
+  liberty_report = report;
+}
+
+void
+libertyVisitEnd()
+{
+  // Groups left open by a truncated visit.
+  liberty_group_stack.deleteContentsClear();
+  liberty_group_visitor = nullptr;
+}
+
 void
 libertyGetChars(char *buf,
                 int &result,
                 size_t max_size)
 {
-  char *status = gzgets(liberty_stream, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = strlen(buf);
+  liberty_stream->getChars(buf, result, max_size);
 }
 
 void
@@ -92,11 +146,7 @@ libertyGetChars(char *buf,
                 size_t &result,
                 size_t max_size)
 {
-  char *status = gzgets(liberty_stream, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = strlen(buf);
+  liberty_stream->getChars(buf, result, max_size);
 }
 
 void
@@ -261,28 +311,37 @@ LibertyAttr::LibertyAttr(const char *name,
 {
 }
 
+LibertyAttr::LibertyAttr(LibertyAttr &&attr) :
+  LibertyStmt(attr.line_),
+  name_(attr.name_)
+{
+  attr.name_ = nullptr;
+}
+
 LibertyAttr::~LibertyAttr()
 {
   stringDelete(name_);
 }
 
+// Statements are visited as they are parsed. Only the statements saved
+// by the visitor are copied to the heap.
+
 LibertyStmt *
 makeLibertySimpleAttr(const char *name,
 		      LibertyAttrValue *value,
 		      int line)
 {
-  LibertyAttr *attr = new LibertySimpleAttr(name, value, line);
+  LibertySimpleAttr attr(name, value, line);
   if (liberty_group_visitor)
-    liberty_group_visitor->visitAttr(attr);
+    liberty_group_visitor->visitAttr(&attr);
   LibertyGroup *group = libertyGroup();
-  if (group && liberty_group_visitor->save(attr)) {
-    group->addAttribute(attr);
-    return attr;
+  if (group && liberty_group_visitor->save(&attr)) {
+    LibertyAttr *saved_attr = new LibertySimpleAttr(std::move(attr));
+    group->addAttribute(saved_attr);
+    return saved_attr;
   }
-  else {
-    delete attr;
+  else
     return nullptr;
-  }
 }
 
 LibertyGroup *
@@ -299,6 +358,13 @@ LibertySimpleAttr::LibertySimpleAttr(const char *name,
 {
 }
 
+LibertySimpleAttr::LibertySimpleAttr(LibertySimpleAttr &&attr) :
+  LibertyAttr(std::move(attr)),
+  value_(attr.value_)
+{
+  attr.value_ = nullptr;
+}
+
 LibertySimpleAttr::~LibertySimpleAttr()
 {
   delete value_;
@@ -328,16 +394,16 @@ makeLibertyComplexAttr(const char *name,
     return define;
   }
   else {
-    LibertyAttr *attr = new LibertyComplexAttr(name, values, line);
+    LibertyComplexAttr attr(name, values, line);
     if (liberty_group_visitor) {
-      liberty_group_visitor->visitAttr(attr);
-      if (liberty_group_visitor->save(attr)) {
+      liberty_group_visitor->visitAttr(&attr);
+      if (liberty_group_visitor->save(&attr)) {
+        LibertyAttr *saved_attr = new LibertyComplexAttr(std::move(attr));
         LibertyGroup *group = libertyGroup();
-        group->addAttribute(attr);
-        return attr;
+        group->addAttribute(saved_attr);
+        return saved_attr;
       }
     }
-    delete attr;
     return nullptr;
   }
 }
@@ -350,6 +416,13 @@ LibertyComplexAttr::LibertyComplexAttr(const char *name,
 {
 }
 
+LibertyComplexAttr::LibertyComplexAttr(LibertyComplexAttr &&attr) :
+  LibertyAttr(std::move(attr)),
+  values_(attr.values_)
+{
+  attr.values_ = nullptr;
+}
+
 LibertyComplexAttr::~LibertyComplexAttr()
 {
   if (values_) {
@@ -501,14 +574,12 @@ makeLibertyVariable(char *var,
 		    float value,
 		    int line)
 {
-  LibertyVariable *variable = new LibertyVariable(var, value, line);
-  liberty_group_visitor->visitVariable(variable);
-  if (liberty_group_visitor->save(variable))
-    return variable;
-  else {
-    delete variable;
+  LibertyVariable variable(var, value, line);
+  liberty_group_visitor->visitVariable(&variable);
+  if (liberty_group_visitor->save(&variable))
+    return new LibertyVariable(std::move(variable));
+  else
     return nullptr;
-  }
 }
 
 LibertyVariable::LibertyVariable(const char *var,
@@ -520,6 +591,14 @@ LibertyVariable::LibertyVariable(const char *var,
 {
 }
 
+LibertyVariable::LibertyVariable(LibertyVariable &&variable) :
+  LibertyStmt(variable.line_),
+  var_(variable.var_),
+  value_(variable.value_)
+{
+  variable.var_ = nullptr;
+}
+
 LibertyVariable::~LibertyVariable()
 {
   stringDelete(var_);
@@ -536,8 +615,8 @@ libertyInInclude()
 void
 libertyIncludeBegin(const char *filename)
 {
-  gzFile stream = gzopen(filename, "r" );
-  if (stream) {
+  InputFile *stream = new InputFile;
+  if (stream->open(filename)) {
     liberty_stream_prev = liberty_stream;
     liberty_filename_prev = liberty_filename;
     liberty_line_prev = liberty_line;
@@ -546,15 +625,17 @@ libertyIncludeBegin(const char *filename)
     liberty_filename = filename;
     liberty_line = 1;
   }
-  else
+  else {
+    delete stream;
     liberty_report->fileWarn(25, sta::liberty_filename, sta::liberty_line,
                              "cannot open include file %s.", filename);
+  }
 }
 
 void
 libertyIncludeEnd()
 {
-  gzclose(liberty_stream);
+  delete liberty_stream;
   liberty_stream = liberty_stream_prev;
   liberty_filename = liberty_filename_prev;
   liberty_line = liberty_line_prev;
@@ -596,8 +677,6 @@ deleteLibertyGroups()
 ////////////////////////////////////////////////////////////////
 // Global namespace
 
-void libertyParseFlushBuffer();
-
 int
 LibertyParse_error(const char *msg)
 {
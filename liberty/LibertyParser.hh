@@ -16,11 +16,12 @@
 
 #pragma once
 
-#include "Zlib.hh"
+#include "InputFile.hh"
 #include "Vector.hh"
 #include "Map.hh"
 #include "Set.hh"
 #include "StringUtil.hh"
+#include "ObjectPool.hh"
 
 namespace sta {
 
@@ -135,7 +136,11 @@ class LibertyAttr : public LibertyStmt
 public:
   LibertyAttr(const char *name,
 	      int line);
+  LibertyAttr(LibertyAttr &&attr);
   virtual ~LibertyAttr();
+  static void *operator new(size_t size) { return objectPoolAlloc(size); }
+  static void operator delete(void *attr,
+                              size_t size) { objectPoolFree(attr, size); }
   const char *name() const { return name_; }
   virtual bool isAttribute() const { return true; }
   virtual bool isSimple() const = 0;
@@ -155,6 +160,7 @@ public:
   LibertySimpleAttr(const char *name,
 		    LibertyAttrValue *value,
 		    int line);
+  LibertySimpleAttr(LibertySimpleAttr &&attr);
   virtual ~LibertySimpleAttr();
   virtual bool isSimple() const { return true; }
   virtual bool isComplex() const { return false; }
@@ -173,6 +179,7 @@ public:
   LibertyComplexAttr(const char *name,
 		     LibertyAttrValueSeq *values,
 		     int line);
+  LibertyComplexAttr(LibertyComplexAttr &&attr);
   virtual ~LibertyComplexAttr();
   virtual bool isSimple() const { return false; }
   virtual bool isComplex() const { return true; }
@@ -254,6 +261,7 @@ public:
   LibertyVariable(const char *var,
 		  float value,
 		  int line);
+  LibertyVariable(LibertyVariable &&variable);
   // var_ is NOT deleted by ~LibertyVariable because the group
   // variable map ref's it.
   virtual ~LibertyVariable();
@@ -299,6 +307,22 @@ void
 parseLibertyFile(const char *filename,
 		 LibertyGroupVisitor *library_visitor,
 		 Report *report);
+// Parse liberty text in a buffer starting at line in filename.
+void
+parseLibertyBuffer(const char *buffer,
+                   size_t size,
+                   const char *filename,
+                   int line,
+                   LibertyGroupVisitor *library_visitor,
+                   Report *report);
+// Visit statements that are not parsed from liberty text (liberty db
+// files) with the libertyGroupBegin/End and makeLiberty* functions.
+void
+libertyVisitBegin(const char *filename,
+                  LibertyGroupVisitor *library_visitor,
+                  Report *report);
+void
+libertyVisitEnd();
 void
 libertyGroupBegin(const char *type,
 		  LibertyAttrValueSeq *params,
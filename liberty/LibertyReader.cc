@@ -18,6 +18,10 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 
 #include "Report.hh"
 #include "Debug.hh"
@@ -36,9 +40,11 @@
 #include "Liberty.hh"
 #include "LibertyBuilder.hh"
 #include "LibertyReaderPvt.hh"
+#include "LibertyCellLoader.hh"
 #include "PortDirection.hh"
 #include "ParseBus.hh"
 #include "Network.hh"
+#include "DispatchQueue.hh"
 
 extern int LibertyParse_debug;
 
@@ -59,14 +65,108 @@ readLibertyFile(const char *filename,
   return reader.readLibertyFile(filename, infer_latches, network);
 }
 
+LibertyLibrary *
+readLibertyFile(const char *filename,
+		bool infer_latches,
+		bool lazy,
+		Network *network,
+                DispatchQueue *cell_dispatch_queue)
+{
+  if (lazy) {
+    std::unique_ptr<LibertyCellLoader>
+      loader(new LibertyCellLoader(filename, infer_latches, true, network));
+    loader->setCellDispatchQueue(cell_dispatch_queue);
+    LibertyLibrary *library = loader->readLibrary();
+    if (library && loader->hasCells())
+      library->setCellLoader(loader.release());
+    return library;
+  }
+  else {
+    LibertyReader reader;
+    reader.setCellDispatchQueue(cell_dispatch_queue);
+    return reader.readLibertyFile(filename, infer_latches, network);
+  }
+}
+
+LibertyLibrarySeq
+readLibertyFiles(const StringSeq &filenames,
+                 bool infer_latches,
+                 bool lazy,
+                 bool parallel_cells,
+                 Network *network,
+                 int thread_count,
+                 DispatchQueue *dispatch_queue)
+{
+  LibertyLibrarySeq libraries;
+  size_t file_count = filenames.size();
+  std::vector<std::unique_ptr<LibertyCellLoader>> loaders;
+  for (const char *filename : filenames) {
+    LibertyCellLoader *loader = new LibertyCellLoader(filename, infer_latches,
+                                                      lazy, network);
+    if (parallel_cells && thread_count > 1)
+      loader->setCellDispatchQueue(dispatch_queue);
+    loaders.emplace_back(loader);
+  }
+  // The threads read the file text ahead while the libraries are
+  // parsed in order. Parsing and library registration are serial.
+  std::vector<char> text_read(file_count, false);
+  std::mutex text_lock;
+  std::condition_variable text_cond;
+  size_t read_ahead = std::max(thread_count, 1);
+  size_t dispatch_count = 0;
+  try {
+    for (size_t i = 0; i < file_count; i++) {
+      if (dispatch_queue) {
+        while (dispatch_count < file_count
+               && dispatch_count <= i + read_ahead) {
+          size_t j = dispatch_count++;
+          dispatch_queue->dispatch([&, j] (int) {
+            loaders[j]->readText();
+            std::unique_lock<std::mutex> lock(text_lock);
+            text_read[j] = true;
+            text_cond.notify_all();
+          });
+        }
+        std::unique_lock<std::mutex> lock(text_lock);
+        text_cond.wait(lock, [&] () { return text_read[i] != 0; });
+      }
+      LibertyCellLoader *loader = loaders[i].get();
+      LibertyLibrary *library = loader->readLibrary();
+      if (library && loader->hasCells())
+        library->setCellLoader(loaders[i].release());
+      else
+        // Release the file text.
+        loaders[i].reset();
+      libraries.push_back(library);
+    }
+  }
+  catch (...) {
+    // Wait for the reads that reference the loaders.
+    if (dispatch_queue)
+      dispatch_queue->finishTasks();
+    throw;
+  }
+  if (dispatch_queue)
+    dispatch_queue->finishTasks();
+  return libraries;
+}
+
 LibertyReader::LibertyReader() :
-  LibertyGroupVisitor()
+  LibertyGroupVisitor(),
+  cell_dispatch_queue_(nullptr),
+  cell_builds_pending_(false)
 {
   defineVisitors();
 }
 
 LibertyReader::~LibertyReader()
 {
+  if (cell_builds_pending_)
+    // Builds left by an exception reference the reader.
+    cell_dispatch_queue_->finishTasks();
+  for (LibertyReader *builder : cell_builders_)
+    delete builder;
+
   if (var_map_) {
     LibertyVariableMap::Iterator iter(var_map_);
     while (iter.hasNext()) {
@@ -92,6 +192,25 @@ LibertyLibrary *
 LibertyReader::readLibertyFile(const char *filename,
 			       bool infer_latches,
 			       Network *network)
+{
+  init(filename, infer_latches, network);
+  //::LibertyParse_debug = 1;
+  parseLibertyFile(filename, this, report_);
+  finishCellBuilds();
+  return library_;
+}
+
+void
+LibertyReader::setCellDispatchQueue(DispatchQueue *dispatch_queue)
+{
+  finishCellBuilds();
+  cell_dispatch_queue_ = dispatch_queue;
+}
+
+void
+LibertyReader::init(const char *filename,
+                    bool infer_latches,
+                    Network *network)
 {
   filename_ = filename;
   infer_latches_ = infer_latches;
@@ -143,10 +262,6 @@ LibertyReader::readLibertyFile(const char *filename,
     have_slew_lower_threshold_[rf_index] = false;
     have_slew_upper_threshold_[rf_index] = false;
   }
-
-  //::LibertyParse_debug = 1;
-  parseLibertyFile(filename, this, report_);
-  return library_;
 }
 
 void
@@ -567,6 +682,10 @@ LibertyReader::defineScalingFactorVisitors()
 void
 LibertyReader::visitAttr(LibertyAttr *attr)
 {
+  if (cell_builds_pending_
+      && cell_ == nullptr
+      && test_cell_ == nullptr)
+    finishCellBuilds();
   LibraryAttrVisitor visitor = attr_visitor_map_.findKey(attr->name());
   if (visitor)
     (this->*visitor)(attr);
@@ -575,6 +694,12 @@ LibertyReader::visitAttr(LibertyAttr *attr)
 void
 LibertyReader::begin(LibertyGroup *group)
 {
+  if (cell_builds_pending_
+      && cell_ == nullptr
+      && test_cell_ == nullptr
+      && !stringEq(group->type(), "cell"))
+    // Library groups may change state the cell builders read.
+    finishCellBuilds();
   LibraryGroupVisitor visitor = group_begin_map_.findKey(group->type());
   if (visitor)
     (this->*visitor)(group);
@@ -642,6 +767,7 @@ LibertyReader::setEnergyScale()
 void
 LibertyReader::endLibrary(LibertyGroup *group)
 {
+  finishCellBuilds();
   endLibraryAttrs(group);
 }
 
@@ -1370,7 +1496,11 @@ LibertyReader::makeAxis(int index,
       float scale = tableVariableUnit(axis_var, units)->scale();
       scaleFloats(axis_values, scale);
     }
-    return make_shared<TableAxis>(axis_var, axis_values);
+    TableAxisPtr axis =
+      TablePool::findAxis(make_shared<TableAxis>(axis_var, axis_values));
+    // The pooled axis may own different (equal) values.
+    axis_values_[index] = axis->values();
+    return axis;
   }
   else if (axis_values) {
     libWarn(1176, group, "missing variable_%d attribute.", index + 1);
@@ -1889,6 +2019,17 @@ LibertyReader::beginCell(LibertyGroup *group)
 
 void
 LibertyReader::endCell(LibertyGroup *group)
+{
+  if (cell_) {
+    if (cell_dispatch_queue_)
+      dispatchCellBuild(group->line());
+    else
+      finishCell(group->line());
+  }
+}
+
+void
+LibertyReader::finishCell(int line)
 {
   if (cell_) {
     // Sequentials and leakage powers reference expressions outside of port definitions
@@ -1907,7 +2048,7 @@ LibertyReader::endCell(LibertyGroup *group)
       if (derate)
 	cell_->setOcvDerate(derate);
       else
-	libWarn(1194, group, "cell %s ocv_derate_group %s not found.",
+	libWarn(1194, line, "cell %s ocv_derate_group %s not found.",
 		cell_->name(), ocv_derate_name_);
       stringDelete(ocv_derate_name_);
       ocv_derate_name_ = nullptr;
@@ -1917,6 +2058,87 @@ LibertyReader::endCell(LibertyGroup *group)
   }
 }
 
+// Hand the parsed cell groups to a cell builder thread.
+void
+LibertyReader::dispatchCellBuild(int line)
+{
+  if (!cell_builds_pending_) {
+    // Copy the library state that may have changed since the last builds.
+    size_t thread_count = cell_dispatch_queue_->threadCount();
+    while (cell_builders_.size() < thread_count)
+      cell_builders_.push_back(new LibertyReader);
+    for (LibertyReader *builder : cell_builders_)
+      builder->initCellBuilder(this);
+    cell_build_exceptions_.assign(cell_builders_.size(), nullptr);
+    cell_builds_pending_ = true;
+  }
+  LibertyCellBuild *build = new LibertyCellBuild;
+  build->cell_ = cell_;
+  build->port_groups_.swap(cell_port_groups_);
+  build->sequentials_.swap(cell_sequentials_);
+  build->funcs_.swap(cell_funcs_);
+  build->leakage_powers_.swap(leakage_powers_);
+  build->ocv_derate_name_ = ocv_derate_name_;
+  build->line_ = line;
+  ocv_derate_name_ = nullptr;
+  cell_ = nullptr;
+  cell_dispatch_queue_->dispatch([this, build] (int thread) {
+    // Skip the builds after an exception.
+    if (cell_build_exceptions_[thread] == nullptr) {
+      try {
+        cell_builders_[thread]->buildCell(build);
+      }
+      catch (...) {
+        cell_build_exceptions_[thread] = std::current_exception();
+      }
+    }
+    delete build;
+  });
+}
+
+void
+LibertyReader::buildCell(LibertyCellBuild *build)
+{
+  cell_ = build->cell_;
+  cell_port_groups_.swap(build->port_groups_);
+  cell_sequentials_.swap(build->sequentials_);
+  cell_funcs_.swap(build->funcs_);
+  leakage_powers_.swap(build->leakage_powers_);
+  ocv_derate_name_ = build->ocv_derate_name_;
+  finishCell(build->line_);
+}
+
+void
+LibertyReader::initCellBuilder(const LibertyReader *reader)
+{
+  init(reader->filename_, reader->infer_latches_, reader->network_);
+  library_ = reader->library_;
+  time_scale_ = reader->time_scale_;
+  cap_scale_ = reader->cap_scale_;
+  res_scale_ = reader->res_scale_;
+  volt_scale_ = reader->volt_scale_;
+  current_scale_ = reader->current_scale_;
+  power_scale_ = reader->power_scale_;
+  energy_scale_ = reader->energy_scale_;
+  distance_scale_ = reader->distance_scale_;
+}
+
+void
+LibertyReader::finishCellBuilds()
+{
+  if (cell_builds_pending_) {
+    cell_dispatch_queue_->finishTasks();
+    cell_builds_pending_ = false;
+    for (std::exception_ptr &exception : cell_build_exceptions_) {
+      if (exception) {
+        std::exception_ptr first = exception;
+        cell_build_exceptions_.clear();
+        std::rethrow_exception(first);
+      }
+    }
+  }
+}
+
 void
 LibertyReader::finishPortGroups()
 {
@@ -2639,10 +2861,7 @@ LibertyReader::endVector(LibertyGroup *group)
       float slew = (*slew_values)[0];
       float cap = (*cap_values)[0];
       Table3 *table3 = dynamic_cast<Table3*>(table_.get());
-      FloatTable *values3 = table3->values3();
-      // Steal the values.
-      FloatSeq *values = (*values3)[0];
-      (*values3)[0] = nullptr;
+      FloatSeq *values = new FloatSeq(table3->values());
       Table1 *table1 = new Table1(values, axis_[2]);
       OutputWaveform *waveform = new OutputWaveform(slew, cap, table1, reference_time_);
       output_currents_.push_back(waveform);
@@ -4358,6 +4577,7 @@ LibertyReader::makeTable(LibertyAttr *attr,
       delete table;
       table_ = make_shared<Table0>(value);
     }
+    table_ = TablePool::findTable(table_);
   }
   else
     libWarn(1257, attr, "%s is missing values.", attr->name());
@@ -4420,7 +4640,9 @@ LibertyReader::makeTableAxis(int index)
     const Units *units = library_->units();
     float scale = tableVariableUnit(var, units)->scale();
     scaleFloats(values, scale);
-    axis_[index] = make_shared<TableAxis>(var, values);
+    axis_[index] = TablePool::findAxis(make_shared<TableAxis>(var, values));
+    // The pooled axis may own different (equal) values.
+    axis_values_[index] = axis_[index]->values();
   }
 }
 
@@ -16,14 +16,38 @@
 
 #pragma once
 
+#include "StringSeq.hh"
+#include "LibertyClass.hh"
+
 namespace sta {
 
 class Network;
 class LibertyLibrary;
+class DispatchQueue;
 
 LibertyLibrary *
 readLibertyFile(const char *filename,
 		bool infer_latches,
 		Network *network);
+// With lazy, cells are read when they are first found in the library.
+// With cell_dispatch_queue, its threads build the cells while the
+// library is parsed.
+LibertyLibrary *
+readLibertyFile(const char *filename,
+		bool infer_latches,
+		bool lazy,
+		Network *network,
+                DispatchQueue *cell_dispatch_queue);
+// Read liberty files in filename order. The dispatch queue threads
+// read and uncompress the file text ahead of the parser.
+// With parallel_cells they also build the cells of each library.
+LibertyLibrarySeq
+readLibertyFiles(const StringSeq &filenames,
+                 bool infer_latches,
+                 bool lazy,
+                 bool parallel_cells,
+                 Network *network,
+                 int thread_count,
+                 DispatchQueue *dispatch_queue);
 
 } // namespace
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <exception>
 #include <functional>
+#include <vector>
 
 #include "Vector.hh"
 #include "Map.hh"
@@ -46,6 +48,8 @@ class PortNameBitIterator;
 class TimingArcBuilder;
 class LibertyAttr;
 class OutputWaveform;
+class LibertyCellBuild;
+class DispatchQueue;
 
 typedef void (LibertyReader::*LibraryAttrVisitor)(LibertyAttr *attr);
 typedef void (LibertyReader::*LibraryGroupVisitor)(LibertyGroup *group);
@@ -59,6 +63,8 @@ typedef Vector<InternalPowerGroup*> InternalPowerGroupSeq;
 typedef Vector<LeakagePowerGroup*> LeakagePowerGroupSeq;
 typedef void (LibertyPort::*LibertyPortBoolSetter)(bool value);
 typedef Vector<OutputWaveform*> OutputWaveformSeq;
+typedef std::vector<LibertyReader*> LibertyReaderSeq;
+typedef std::vector<std::exception_ptr> ExceptionPtrSeq;
 
 class LibertyReader : public LibertyGroupVisitor
 {
@@ -68,7 +74,15 @@ public:
   virtual LibertyLibrary *readLibertyFile(const char *filename,
 					  bool infer_latches,
 					  Network *network);
+  // Initialize the reader state before parsing.
+  void init(const char *filename,
+            bool infer_latches,
+            Network *network);
   LibertyLibrary *library() const { return library_; }
+  // Build cells with the dispatch queue threads while the library is
+  // parsed. Library statements after a cell wait for the cells to be
+  // built, so the library is read only while the threads build cells.
+  void setCellDispatchQueue(DispatchQueue *dispatch_queue);
   virtual bool save(LibertyGroup *) { return false; }
   virtual bool save(LibertyAttr *) { return false; }
   virtual bool save(LibertyVariable *) { return false; }
@@ -154,6 +168,8 @@ public:
 
   virtual void beginCell(LibertyGroup *group);
   virtual void endCell(LibertyGroup *group);
+  // Make the cell sequentials, functions, timing arcs and powers.
+  void finishCell(int line);
   virtual void beginScaledCell(LibertyGroup *group);
   virtual void endScaledCell(LibertyGroup *group);
   virtual void checkScaledCell(LibertyGroup *group);
@@ -485,6 +501,11 @@ protected:
   void makeMinPulseWidthArcs(LibertyPort *port,
                              int line);
   void setEnergyScale();
+  void dispatchCellBuild(int line);
+  void buildCell(LibertyCellBuild *build);
+  void initCellBuilder(const LibertyReader *reader);
+  // Wait for the cell builds and rethrow the first build exception.
+  void finishCellBuilds();
   void defineVisitors();
   virtual void begin(LibertyGroup *group);
   virtual void end(LibertyGroup *group);
@@ -640,6 +661,12 @@ protected:
   float reference_time_;
   bool reference_time_exists_;
   const char *driver_waveform_name_;
+  DispatchQueue *cell_dispatch_queue_;
+  // Reader for each dispatch thread that builds cells.
+  LibertyReaderSeq cell_builders_;
+  // First exception thrown by each cell builder.
+  ExceptionPtrSeq cell_build_exceptions_;
+  bool cell_builds_pending_;
 
   static constexpr char escape_ = '\\';
 
@@ -648,6 +675,19 @@ private:
   friend class TimingGroup;
 };
 
+// Parsed cell groups handed to a cell builder.
+class LibertyCellBuild
+{
+public:
+  LibertyCell *cell_;
+  PortGroupSeq port_groups_;
+  SequentialGroupSeq sequentials_;
+  LibertyFuncSeq funcs_;
+  LeakagePowerGroupSeq leakage_powers_;
+  const char *ocv_derate_name_;
+  int line_;
+};
+
 // Reference to a function that will be parsed at the end of the cell
 // definition when all of the ports are defined.
 class LibertyFunc
@@ -16,12 +16,17 @@
 
 #include "TableModel.hh"
 
+#include <cmath>
+#include <cstring>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "Error.hh"
 #include "EnumNameMap.hh"
 #include "Units.hh"
 #include "Liberty.hh"
+#include "Hash.hh"
 
 namespace sta {
 
@@ -109,27 +114,26 @@ GateTableModel::gateDelay(const Pvt *pvt,
 			  ArcDelay &gate_delay,
 			  Slew &drvr_slew) const
 {
-  float delay = findValue(pvt, delay_model_, in_slew, load_cap, 0.0);
-  float sigma_early = 0.0;
-  float sigma_late = 0.0;
-  if (pocv_enabled && delay_sigma_models_[EarlyLate::earlyIndex()])
-    sigma_early = findValue(pvt, delay_sigma_models_[EarlyLate::earlyIndex()],
-			    in_slew, load_cap, 0.0);
-  if (pocv_enabled && delay_sigma_models_[EarlyLate::lateIndex()])
-    sigma_late = findValue(pvt, delay_sigma_models_[EarlyLate::lateIndex()],
-			   in_slew, load_cap, 0.0);
-  gate_delay = makeDelay(delay, sigma_early, sigma_late);
+  // Delay and slew tables usually share axes, so look them up together.
+  const TableModel *models[6] = {
+    delay_model_,
+    pocv_enabled ? delay_sigma_models_[EarlyLate::earlyIndex()] : nullptr,
+    pocv_enabled ? delay_sigma_models_[EarlyLate::lateIndex()] : nullptr,
+    slew_model_,
+    pocv_enabled ? slew_sigma_models_[EarlyLate::earlyIndex()] : nullptr,
+    pocv_enabled ? slew_sigma_models_[EarlyLate::lateIndex()] : nullptr
+  };
+  float values[6];
+  findValues(pvt, models, pocv_enabled ? 6 : 4, in_slew, load_cap, 0.0, values);
+  gate_delay = makeDelay(values[0], values[1], values[2]);
 
-  float slew = findValue(pvt, slew_model_, in_slew, load_cap, 0.0);
-  if (pocv_enabled && slew_sigma_models_[EarlyLate::earlyIndex()])
-    sigma_early = findValue(pvt, slew_sigma_models_[EarlyLate::earlyIndex()],
-			    in_slew, load_cap, 0.0);
-  if (pocv_enabled && slew_sigma_models_[EarlyLate::lateIndex()])
-    sigma_late = findValue(pvt, slew_sigma_models_[EarlyLate::lateIndex()],
-			   in_slew, load_cap, 0.0);
+  float slew = values[3];
   // Clip negative slews to zero.
   if (slew < 0.0)
     slew = 0.0;
+  // Missing slew sigma models use the delay sigmas.
+  float sigma_early = models[4] ? values[4] : values[1];
+  float sigma_late = models[5] ? values[5] : values[2];
   drvr_slew = makeDelay(slew, sigma_early, sigma_late);
 }
 
@@ -218,6 +222,39 @@ GateTableModel::findValue(const Pvt *pvt,
     return 0.0;
 }
 
+void
+GateTableModel::findValues(const Pvt *pvt,
+                           const TableModel *const *models,
+                           size_t model_count,
+                           float in_slew,
+                           float load_cap,
+                           float related_out_cap,
+                           // Return values.
+                           float *values) const
+{
+  TableLookup lookup;
+  const TableModel *lookup_model = nullptr;
+  for (size_t i = 0; i < model_count; i++) {
+    const TableModel *model = models[i];
+    if (model == nullptr)
+      values[i] = 0.0;
+    else if (lookup_model && model->sameAxes(lookup_model))
+      values[i] = model->lookupValue(cell_, pvt, lookup);
+    else {
+      float axis_value1, axis_value2, axis_value3;
+      findAxisValues(model, in_slew, load_cap, related_out_cap,
+                     axis_value1, axis_value2, axis_value3);
+      if (model->findLookup(axis_value1, axis_value2, axis_value3, lookup)) {
+        lookup_model = model;
+        values[i] = model->lookupValue(cell_, pvt, lookup);
+      }
+      else
+        values[i] = model->findValue(cell_, pvt, axis_value1, axis_value2,
+                                     axis_value3);
+    }
+  }
+}
+
 void
 GateTableModel::findAxisValues(const TableModel *model,
 			       float in_slew,
@@ -425,16 +462,20 @@ CheckTableModel::checkDelay(const Pvt *pvt,
 			    bool pocv_enabled) const
 {
   if (model_) {
-    float mean = findValue(pvt, model_, from_slew, to_slew, related_out_cap);
-    float sigma_early = 0.0;
-    float sigma_late = 0.0;
-    if (pocv_enabled && sigma_models_[EarlyLate::earlyIndex()])
-      sigma_early = findValue(pvt, sigma_models_[EarlyLate::earlyIndex()],
-			      from_slew, to_slew, related_out_cap);
-    if (pocv_enabled && sigma_models_[EarlyLate::lateIndex()])
-      sigma_late = findValue(pvt, sigma_models_[EarlyLate::lateIndex()],
-			     from_slew, to_slew, related_out_cap);
-    return makeDelay(mean, sigma_early, sigma_late);  
+    if (pocv_enabled) {
+      const TableModel *models[3] = {
+        model_,
+        sigma_models_[EarlyLate::earlyIndex()],
+        sigma_models_[EarlyLate::lateIndex()]
+      };
+      float values[3];
+      findValues(pvt, models, 3, from_slew, to_slew, related_out_cap, values);
+      return makeDelay(values[0], values[1], values[2]);
+    }
+    else {
+      float mean = findValue(pvt, model_, from_slew, to_slew, related_out_cap);
+      return makeDelay(mean, 0.0, 0.0);
+    }
   }
   else
     return 0.0;
@@ -457,6 +498,37 @@ CheckTableModel::findValue(const Pvt *pvt,
     return 0.0;
 }
 
+void
+CheckTableModel::findValues(const Pvt *pvt,
+                            const TableModel *const *models,
+                            size_t model_count,
+                            float from_slew,
+                            float to_slew,
+                            float related_out_cap,
+                            // Return values.
+                            float *values) const
+{
+  float axis_value1, axis_value2, axis_value3;
+  findAxisValues(from_slew, to_slew, related_out_cap,
+                 axis_value1, axis_value2, axis_value3);
+  TableLookup lookup;
+  const TableModel *lookup_model = nullptr;
+  for (size_t i = 0; i < model_count; i++) {
+    const TableModel *model = models[i];
+    if (model == nullptr)
+      values[i] = 0.0;
+    else if (lookup_model && model->sameAxes(lookup_model))
+      values[i] = model->lookupValue(cell_, pvt, lookup);
+    else if (model->findLookup(axis_value1, axis_value2, axis_value3, lookup)) {
+      lookup_model = model;
+      values[i] = model->lookupValue(cell_, pvt, lookup);
+    }
+    else
+      values[i] = model->findValue(cell_, pvt, axis_value1, axis_value2,
+                                   axis_value3);
+  }
+}
+
 string
 CheckTableModel::reportCheckDelay(const Pvt *pvt,
 				  float from_slew,
@@ -668,6 +740,29 @@ TableModel::findValue(const LibertyCell *cell,
     * scaleFactor(cell, pvt);
 }
 
+bool
+TableModel::findLookup(float axis_value1,
+                       float axis_value2,
+                       float axis_value3,
+                       TableLookup &lookup) const
+{
+  return table_->findLookup(axis_value1, axis_value2, axis_value3, lookup);
+}
+
+float
+TableModel::lookupValue(const LibertyCell *cell,
+                        const Pvt *pvt,
+                        const TableLookup &lookup) const
+{
+  return table_->lookupValue(lookup) * scaleFactor(cell, pvt);
+}
+
+bool
+TableModel::sameAxes(const TableModel *model) const
+{
+  return table_->sameAxes(model->table_.get());
+}
+
 float
 TableModel::scaleFactor(const LibertyCell *cell,
 			const Pvt *pvt) const
@@ -742,6 +837,28 @@ TableModel::reportPvtScaleFactor(const LibertyCell *cell,
 
 ////////////////////////////////////////////////////////////////
 
+static bool
+sameAxis(const TableAxis *axis1,
+         const TableAxis *axis2)
+{
+  return axis1 == axis2
+    || (axis1 && axis2
+        && axis1->variable() == axis2->variable()
+        && *axis1->values() == *axis2->values());
+}
+
+bool
+Table::sameAxes(const Table *table) const
+{
+  return table == this
+    || (table->order() == order()
+        && sameAxis(table->axis1(), axis1())
+        && sameAxis(table->axis2(), axis2())
+        && sameAxis(table->axis3(), axis3()));
+}
+
+////////////////////////////////////////////////////////////////
+
 Table0::Table0(float value) :
   Table(),
   value_(value)
@@ -979,16 +1096,33 @@ Table2::Table2(FloatTable *values,
 	       TableAxisPtr axis1,
 	       TableAxisPtr axis2) :
   Table(),
-  values_(values),
   axis1_(axis1),
   axis2_(axis2)
 {
+  setValues(values, axis1_->size(), axis2_->size());
 }
 
-Table2::~Table2()
+Table2::Table2(TableAxisPtr axis1,
+               TableAxisPtr axis2) :
+  Table(),
+  axis1_(axis1),
+  axis2_(axis2)
 {
-  values_->deleteContents();
-  delete values_;
+}
+
+void
+Table2::setValues(FloatTable *values,
+                  size_t rows,
+                  size_t cols)
+{
+  values_.reserve(rows * cols);
+  for (size_t r = 0; r < rows; r++) {
+    FloatSeq *row = (r < values->size()) ? (*values)[r] : nullptr;
+    for (size_t c = 0; c < cols; c++)
+      values_.push_back((row && c < row->size()) ? (*row)[c] : 0.0);
+  }
+  values->deleteContents();
+  delete values;
 }
 
 float
@@ -1003,72 +1137,79 @@ float
 Table2::value(size_t axis_index1,
               size_t axis_index2) const
 {
-  FloatSeq *row = (*values_)[axis_index1];
-  return (*row)[axis_index2];
+  return values_[axis_index1 * axis2_->size() + axis_index2];
 }
 
 // Bilinear Interpolation.
 float
 Table2::findValue(float axis_value1,
 		  float axis_value2,
-		  float) const
+		  float axis_value3) const
 {
-  size_t size1 = axis1_->size();
-  size_t size2 = axis2_->size();
-  if (size1 == 1) {
-    if (size2 == 1)
-      return value(0, 0);
-    else {
-      size_t axis_index2 = axis2_->findAxisIndex(axis_value2);
-      double x2 = axis_value2;
-      double y00 = value(0, axis_index2);
-      double x2l = axis2_->axisValue(axis_index2);
-      double x2u = axis2_->axisValue(axis_index2 + 1);
-      double dx2 = (x2 - x2l) / (x2u - x2l);
-      double y01 = value(0, axis_index2 + 1);
-      double tbl_value
-	= (1 - dx2) * y00
-	+      dx2  * y01;
-      return tbl_value;
-    }
-  }
-  else if (size2 == 1) {
-    size_t axis_index1 = axis1_->findAxisIndex(axis_value1);
-    double x1 = axis_value1;
-    double y00 = value(axis_index1, 0);
-    double x1l = axis1_->axisValue(axis_index1);
-    double x1u = axis1_->axisValue(axis_index1 + 1);
-    double dx1 = (x1 - x1l) / (x1u - x1l);
-    double y10 = value(axis_index1 + 1, 0);
-    double tbl_value
-      = (1 - dx1) * y00
-      +      dx1  * y10;
-    return tbl_value;
+  TableLookup lookup;
+  findLookup(axis_value1, axis_value2, axis_value3, lookup);
+  return lookupValue(lookup);
+}
+
+// Axis index of the cell containing axis_value and the fraction of
+// the distance across it. Size 1 axes use index 0 with fraction 0.
+void
+Table2::findAxisLookup(const TableAxis *axis,
+                       float axis_value,
+                       // Return values.
+                       size_t &index,
+                       size_t &next_index,
+                       double &dx) const
+{
+  if (axis->size() == 1) {
+    index = 0;
+    next_index = 0;
+    dx = 0.0;
   }
   else {
-    size_t axis_index1 = axis1_->findAxisIndex(axis_value1);
-    size_t axis_index2 = axis2_->findAxisIndex(axis_value2);
-    double x1 = axis_value1;
-    double x2 = axis_value2;
-    double y00 = value(axis_index1, axis_index2);
-    double x1l = axis1_->axisValue(axis_index1);
-    double x1u = axis1_->axisValue(axis_index1 + 1);
-    double dx1 = (x1 - x1l) / (x1u - x1l);
-    double y10 = value(axis_index1 + 1, axis_index2);
-    double y11 = value(axis_index1 + 1, axis_index2 + 1);
-    double x2l = axis2_->axisValue(axis_index2);
-    double x2u = axis2_->axisValue(axis_index2 + 1);
-    double dx2 = (x2 - x2l) / (x2u - x2l);
-    double y01 = value(axis_index1, axis_index2 + 1);
-    double tbl_value
-      = (1 - dx1) * (1 - dx2) * y00
-      +      dx1  * (1 - dx2) * y10
-      +      dx1  *      dx2  * y11
-      + (1 - dx1) *      dx2  * y01;
-    return tbl_value;
+    index = axis->findAxisIndex(axis_value);
+    next_index = index + 1;
+    double x = axis_value;
+    double xl = axis->axisValue(index);
+    double xu = axis->axisValue(next_index);
+    dx = (x - xl) / (xu - xl);
   }
 }
 
+bool
+Table2::findLookup(float axis_value1,
+                   float axis_value2,
+                   float,
+                   TableLookup &lookup) const
+{
+  size_t index1, next_index1, index2, next_index2;
+  double dx1, dx2;
+  findAxisLookup(axis1_.get(), axis_value1, index1, next_index1, dx1);
+  findAxisLookup(axis2_.get(), axis_value2, index2, next_index2, dx2);
+  size_t size2 = axis2_->size();
+  lookup.corner_count = 4;
+  lookup.offsets[0] = index1 * size2 + index2;
+  lookup.offsets[1] = next_index1 * size2 + index2;
+  lookup.offsets[2] = next_index1 * size2 + next_index2;
+  lookup.offsets[3] = index1 * size2 + next_index2;
+  lookup.weights[0] = (1 - dx1) * (1 - dx2);
+  lookup.weights[1] =      dx1  * (1 - dx2);
+  lookup.weights[2] =      dx1  *      dx2;
+  lookup.weights[3] = (1 - dx1) *      dx2;
+  return true;
+}
+
+// Weighted sum of the cell corner values.
+float
+Table2::lookupValue(const TableLookup &lookup) const
+{
+  const float *values = values_.data();
+  double tbl_value = 0.0;
+  for (int i = 0; i < lookup.corner_count; i++)
+    tbl_value += lookup.weights[i] * values[lookup.offsets[i]];
+  return tbl_value;
+}
+
 string
 Table2::reportValue(const char *result_name,
 		    const LibertyCell *cell,
@@ -1170,9 +1311,10 @@ Table3::Table3(FloatTable *values,
 	       TableAxisPtr axis1,
 	       TableAxisPtr axis2,
 	       TableAxisPtr axis3) :
-  Table2(values, axis1, axis2),
+  Table2(axis1, axis2),
   axis3_(axis3)
 {
+  setValues(values, axis1_->size() * axis2_->size(), axis3_->size());
 }
 
 float
@@ -1181,71 +1323,55 @@ Table3::value(size_t axis_index1,
               size_t axis_index3) const
 {
   size_t row = axis_index1 * axis2_->size() + axis_index2;
-  return values_->operator[](row)->operator[](axis_index3);
+  return values_[row * axis3_->size() + axis_index3];
 }
 
-// Bilinear Interpolation.
+// Trilinear Interpolation.
 float
 Table3::findValue(float axis_value1,
 		  float axis_value2,
 		  float axis_value3) const
 {
-  size_t axis_index1 = axis1_->findAxisIndex(axis_value1);
-  size_t axis_index2 = axis2_->findAxisIndex(axis_value2);
-  size_t axis_index3 = axis3_->findAxisIndex(axis_value3);
-  double x1 = axis_value1;
-  double x2 = axis_value2;
-  double x3 = axis_value3;
-  double dx1 = 0.0;
-  double dx2 = 0.0;
-  double dx3 = 0.0;
-  double y000 = value(axis_index1, axis_index2, axis_index3);
-  double y001 = 0.0;
-  double y010 = 0.0;
-  double y011 = 0.0;
-  double y100 = 0.0;
-  double y101 = 0.0;
-  double y110 = 0.0;
-  double y111 = 0.0;
-
-  if (axis1_->size() != 1) {
-    double x1l = axis1_->axisValue(axis_index1);
-    double x1u = axis1_->axisValue(axis_index1 + 1);
-    dx1 = (x1 - x1l) / (x1u - x1l);
-    y100 = value(axis_index1 + 1, axis_index2, axis_index3);
-    if (axis3_->size() != 1)
-      y101 = value(axis_index1 + 1, axis_index2, axis_index3 + 1);
-    if (axis2_->size() != 1) {
-      y110 = value(axis_index1 + 1, axis_index2 + 1, axis_index3);
-      if (axis3_->size() != 1)
-	y111 = value(axis_index1 + 1, axis_index2 + 1, axis_index3 + 1);
-    }
-  }
-  if (axis2_->size() != 1) {
-    double x2l = axis2_->axisValue(axis_index2);
-    double x2u = axis2_->axisValue(axis_index2 + 1);
-    dx2 = (x2 - x2l) / (x2u - x2l);
-    y010 = value(axis_index1, axis_index2 + 1, axis_index3);
-    if (axis3_->size() != 1)
-      y011 = value(axis_index1, axis_index2 + 1, axis_index3 + 1);
-  }
-  if (axis3_->size() != 1) {
-    double x3l = axis3_->axisValue(axis_index3);
-    double x3u = axis3_->axisValue(axis_index3 + 1);
-    dx3 = (x3 - x3l) / (x3u - x3l);
-    y001 = value(axis_index1, axis_index2, axis_index3 + 1);
-  }
+  TableLookup lookup;
+  findLookup(axis_value1, axis_value2, axis_value3, lookup);
+  return lookupValue(lookup);
+}
 
-  double tbl_value
-    = (1 - dx1) * (1 - dx2) * (1 - dx3) * y000
-    + (1 - dx1) * (1 - dx2) *      dx3  * y001
-    + (1 - dx1) *      dx2  * (1 - dx3) * y010
-    + (1 - dx1) *      dx2  *      dx3  * y011
-    +      dx1  * (1 - dx2) * (1 - dx3) * y100
-    +      dx1  * (1 - dx2) *      dx3  * y101
-    +      dx1  *      dx2  * (1 - dx3) * y110
-    +      dx1  *      dx2  *      dx3  * y111;
-  return tbl_value;
+bool
+Table3::findLookup(float axis_value1,
+                   float axis_value2,
+                   float axis_value3,
+                   TableLookup &lookup) const
+{
+  size_t index1, next_index1, index2, next_index2, index3, next_index3;
+  double dx1, dx2, dx3;
+  findAxisLookup(axis1_.get(), axis_value1, index1, next_index1, dx1);
+  findAxisLookup(axis2_.get(), axis_value2, index2, next_index2, dx2);
+  findAxisLookup(axis3_.get(), axis_value3, index3, next_index3, dx3);
+  size_t size2 = axis2_->size();
+  size_t size3 = axis3_->size();
+  size_t row00 = (index1 * size2 + index2) * size3;
+  size_t row01 = (index1 * size2 + next_index2) * size3;
+  size_t row10 = (next_index1 * size2 + index2) * size3;
+  size_t row11 = (next_index1 * size2 + next_index2) * size3;
+  lookup.corner_count = 8;
+  lookup.offsets[0] = row00 + index3;
+  lookup.offsets[1] = row00 + next_index3;
+  lookup.offsets[2] = row01 + index3;
+  lookup.offsets[3] = row01 + next_index3;
+  lookup.offsets[4] = row10 + index3;
+  lookup.offsets[5] = row10 + next_index3;
+  lookup.offsets[6] = row11 + index3;
+  lookup.offsets[7] = row11 + next_index3;
+  lookup.weights[0] = (1 - dx1) * (1 - dx2) * (1 - dx3);
+  lookup.weights[1] = (1 - dx1) * (1 - dx2) *      dx3;
+  lookup.weights[2] = (1 - dx1) *      dx2  * (1 - dx3);
+  lookup.weights[3] = (1 - dx1) *      dx2  *      dx3;
+  lookup.weights[4] =      dx1  * (1 - dx2) * (1 - dx3);
+  lookup.weights[5] =      dx1  * (1 - dx2) *      dx3;
+  lookup.weights[6] =      dx1  *      dx2  * (1 - dx3);
+  lookup.weights[7] =      dx1  *      dx2  *      dx3;
+  return true;
 }
 
 // Sample output.
@@ -1439,6 +1565,15 @@ TableAxis::inBounds(float value) const
 }
 
 // Bisection search.
+struct AxisIndexHint
+{
+  const TableAxis *axis;
+  size_t index;
+};
+
+static constexpr size_t axis_index_hint_count = 16;
+static thread_local AxisIndexHint axis_index_hints[axis_index_hint_count];
+
 size_t
 TableAxis::findAxisIndex(float value) const
 {
@@ -1449,6 +1584,18 @@ TableAxis::findAxisIndex(float value) const
     // Return max_index-1 for value too large so interpolation pts are index,index+1.
     return size - 2;
   else {
+    // Delay calc looks up the same slews and loads in the tables of many
+    // arcs that share (pooled) axes, so check the interval last found
+    // for this axis by the thread before searching. The interval is
+    // checked against the values, so a stale entry is only a miss.
+    AxisIndexHint &hint = axis_index_hints[hashPtr(this) % axis_index_hint_count];
+    if (hint.axis == this) {
+      size_t index = hint.index;
+      if (index + 1 < size
+          && value >= (*values_)[index]
+          && value < (*values_)[index + 1])
+        return index;
+    }
     int lower = -1;
     int upper = size;
     while (upper - lower > 1) {
@@ -1458,6 +1605,8 @@ TableAxis::findAxisIndex(float value) const
       else
 	upper = mid;
     }
+    hint.axis = this;
+    hint.index = lower;
     return lower;
   }
 }
@@ -1504,6 +1653,137 @@ TableAxis::unit(const Units *units)
 
 ////////////////////////////////////////////////////////////////
 
+template <class OBJ>
+class TablePoolMap
+{
+public:
+  TablePoolMap() : purge_size_(1024) {}
+  template <class EQUAL>
+  std::shared_ptr<OBJ> find(size_t hash,
+                            const std::shared_ptr<OBJ> &obj,
+                            const EQUAL &equal);
+
+private:
+  void purge();
+
+  std::unordered_multimap<size_t, std::weak_ptr<OBJ>> map_;
+  // Expired entries are removed when the map grows to this size.
+  size_t purge_size_;
+};
+
+template <class OBJ>
+template <class EQUAL>
+std::shared_ptr<OBJ>
+TablePoolMap<OBJ>::find(size_t hash,
+                        const std::shared_ptr<OBJ> &obj,
+                        const EQUAL &equal)
+{
+  auto range = map_.equal_range(hash);
+  for (auto itr = range.first; itr != range.second; itr++) {
+    std::shared_ptr<OBJ> obj1 = itr->second.lock();
+    if (obj1 && equal(obj.get(), obj1.get()))
+      return obj1;
+  }
+  if (map_.size() >= purge_size_)
+    purge();
+  map_.emplace(hash, obj);
+  return obj;
+}
+
+template <class OBJ>
+void
+TablePoolMap<OBJ>::purge()
+{
+  for (auto itr = map_.begin(); itr != map_.end(); ) {
+    if (itr->second.expired())
+      itr = map_.erase(itr);
+    else
+      itr++;
+  }
+  purge_size_ = max(purge_size_, map_.size() * 2);
+}
+
+static std::mutex table_pool_lock;
+static TablePoolMap<TableAxis> table_pool_axes;
+static TablePoolMap<Table> table_pool_tables;
+
+static size_t
+hashFloat(size_t hash,
+          float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return hashSum(hash, bits);
+}
+
+static size_t
+tableSize(const TableAxis *axis)
+{
+  return axis ? axis->size() : 1;
+}
+
+TableAxisPtr
+TablePool::findAxis(const TableAxisPtr &axis)
+{
+  const FloatSeq *values = axis ? axis->values() : nullptr;
+  if (values == nullptr)
+    return axis;
+  size_t hash = hashSum(hash_init_value, int(axis->variable()));
+  for (float value : *values)
+    hash = hashFloat(hash, value);
+  std::lock_guard<std::mutex> lock(table_pool_lock);
+  return table_pool_axes.find(hash, axis,
+                              [] (const TableAxis *axis1,
+                                  const TableAxis *axis2) {
+                                return axis1->variable() == axis2->variable()
+                                  && *axis1->values() == *axis2->values();
+                              });
+}
+
+TablePtr
+TablePool::findTable(const TablePtr &table)
+{
+  if (table == nullptr)
+    return table;
+  const TableAxis *axis1 = table->axis1();
+  const TableAxis *axis2 = table->axis2();
+  const TableAxis *axis3 = table->axis3();
+  size_t size1 = tableSize(axis1);
+  size_t size2 = tableSize(axis2);
+  size_t size3 = tableSize(axis3);
+  size_t hash = hashSum(hash_init_value, table->order());
+  hashIncr(hash, hashPtr(axis1));
+  hashIncr(hash, hashPtr(axis2));
+  hashIncr(hash, hashPtr(axis3));
+  for (size_t i = 0; i < size1; i++) {
+    for (size_t j = 0; j < size2; j++) {
+      for (size_t k = 0; k < size3; k++)
+        hash = hashFloat(hash, table->value(i, j, k));
+    }
+  }
+  std::lock_guard<std::mutex> lock(table_pool_lock);
+  return table_pool_tables.find(hash, table,
+                                [=] (const Table *table1,
+                                     const Table *table2) {
+      if (table1->order() != table2->order()
+          || table1->axis1() != table2->axis1()
+          || table1->axis2() != table2->axis2()
+          || table1->axis3() != table2->axis3())
+        return false;
+      for (size_t i = 0; i < size1; i++) {
+        for (size_t j = 0; j < size2; j++) {
+          for (size_t k = 0; k < size3; k++) {
+            if (table1->value(i, j, k) != table2->value(i, j, k))
+              return false;
+          }
+        }
+      }
+      return true;
+    });
+}
+
+////////////////////////////////////////////////////////////////
+
 static EnumNameMap<TableAxisVariable> table_axis_variable_map =
   {{TableAxisVariable::total_output_net_capacitance, "total_output_net_capacitance"},
    {TableAxisVariable::equal_or_opposite_output_net_capacitance, "equal_or_opposite_output_net_capacitance"},
@@ -1573,6 +1853,64 @@ tableVariableUnit(TableAxisVariable variable,
 
 ////////////////////////////////////////////////////////////////
 
+CurrentWaveform::CurrentWaveform() :
+  scale_(0.0)
+{
+}
+
+CurrentWaveform::CurrentWaveform(const Table1 *waveform) :
+  scale_(0.0)
+{
+  if (waveform) {
+    time_axis_ = waveform->axis1ptr();
+    const FloatSeq *values = waveform->values();
+    float peak = 0.0;
+    for (float current : *values)
+      peak = max(peak, abs(current));
+    scale_ = peak / INT16_MAX;
+    currents_.reserve(values->size());
+    for (float current : *values)
+      currents_.push_back((scale_ > 0.0)
+                          ? static_cast<int16_t>(std::lround(current / scale_))
+                          : 0);
+  }
+}
+
+float
+CurrentWaveform::findValueClip(float time) const
+{
+  if (currents_.size() == 1)
+    return current(0);
+  else {
+    size_t index = time_axis_->findAxisIndex(time);
+    double x1 = time;
+    double x1l = time_axis_->axisValue(index);
+    double x1u = time_axis_->axisValue(index + 1);
+    if (x1 < x1l)
+      return 0.0;
+    else if (x1 > x1u)
+      return current(currents_.size() - 1);
+    else {
+      double y1 = current(index);
+      double y2 = current(index + 1);
+      double dx1 = (x1 - x1l) / (x1u - x1l);
+      return (1 - dx1) * y1 + dx1 * y2;
+    }
+  }
+}
+
+Table1
+CurrentWaveform::table() const
+{
+  FloatSeq *currents = new FloatSeq;
+  currents->reserve(currents_.size());
+  for (size_t i = 0; i < currents_.size(); i++)
+    currents->push_back(current(i));
+  return Table1(currents, time_axis_);
+}
+
+////////////////////////////////////////////////////////////////
+
 OutputWaveforms::OutputWaveforms(TableAxisPtr slew_axis,
                                  TableAxisPtr cap_axis,
                                  const RiseFall *rf,
@@ -1581,15 +1919,26 @@ OutputWaveforms::OutputWaveforms(TableAxisPtr slew_axis,
   slew_axis_(slew_axis),
   cap_axis_(cap_axis),
   rf_(rf),
-  current_waveforms_(current_waveforms),
+  have_voltages_(new std::atomic<bool>[current_waveforms.size()]),
   ref_times_(ref_times),
   vdd_(0.0)
 {
+  size_t size = current_waveforms.size();
+  current_waveforms_.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    Table1 *waveform = current_waveforms[i];
+    current_waveforms_.emplace_back(waveform);
+    delete waveform;
+    have_voltages_[i].store(false, std::memory_order_relaxed);
+  }
+  current_waveforms.clear();
+  voltage_waveforms_.resize(size, nullptr);
+  voltage_currents_.resize(size, nullptr);
+  voltage_times_.resize(size, nullptr);
 }
 
 OutputWaveforms::~OutputWaveforms()
 {
-  current_waveforms_.deleteContents();
   voltage_waveforms_.deleteContents();
   voltage_currents_.deleteContents();
   voltage_times_.deleteContents();
@@ -1614,18 +1963,51 @@ OutputWaveforms::checkAxes(const TableTemplate *tbl_template)
 }
 
 void
-OutputWaveforms::makeVoltageWaveforms(float vdd)
+OutputWaveforms::setVdd(float vdd)
 {
   vdd_ = vdd;
-  size_t size = current_waveforms_.size();
-  voltage_waveforms_.resize(size);
-  voltage_currents_.resize(size);
-  voltage_times_.resize(size);
+}
+
+// Find the waveforms around slew/cap and the interpolation fractions.
+void
+OutputWaveforms::findWaveIndices(float slew,
+                                 float cap,
+                                 // Return values.
+                                 size_t wave_indices[4],
+                                 double &dx1,
+                                 double &dx2)
+{
+  size_t slew_index = slew_axis_->findAxisIndex(slew);
+  size_t cap_index = cap_axis_->findAxisIndex(cap);
+  size_t cap_count = cap_axis_->size();
+  // 00, 01, 10, 11
+  wave_indices[0] = slew_index * cap_count + cap_index;
+  wave_indices[1] = slew_index * cap_count + (cap_index + 1);
+  wave_indices[2] = (slew_index + 1) * cap_count + cap_index;
+  wave_indices[3] = (slew_index + 1) * cap_count + (cap_index + 1);
+
+  double x1 = slew;
+  double x2 = cap;
+  double x1l = slew_axis_->axisValue(slew_index);
+  double x1u = slew_axis_->axisValue(slew_index + 1);
+  dx1 = (x1 - x1l) / (x1u - x1l);
+  double x2l = cap_axis_->axisValue(cap_index);
+  double x2u = cap_axis_->axisValue(cap_index + 1);
+  dx2 = (x2 - x2l) / (x2u - x2l);
+}
+
+void
+OutputWaveforms::ensureVoltages(const size_t wave_indices[4])
+{
   size_t cap_count = cap_axis_->size();
-  for (size_t slew_index = 0; slew_index < slew_axis_->size(); slew_index++) {
-    for (size_t cap_index = 0; cap_index < cap_axis_->size(); cap_index++) {
-      size_t wave_index = slew_index * cap_count + cap_index;
-      findVoltages(wave_index, cap_axis_->axisValue(cap_index));
+  for (size_t i = 0; i < 4; i++) {
+    size_t wave_index = wave_indices[i];
+    if (!have_voltages_[wave_index].load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(voltages_lock_);
+      if (!have_voltages_[wave_index].load(std::memory_order_relaxed)) {
+        findVoltages(wave_index, cap_axis_->axisValue(wave_index % cap_count));
+        have_voltages_[wave_index].store(true, std::memory_order_release);
+      }
     }
   }
 }
@@ -1637,31 +2019,34 @@ OutputWaveforms::findVoltages(size_t wave_index,
   // Integrate current waveform to find voltage waveform.
   // i = C dv/dt
   FloatSeq *volts = new FloatSeq;
-  Table1 *currents = current_waveforms_[wave_index];
-  const TableAxis *time_axis = currents->axis1();
+  const CurrentWaveform &currents = current_waveforms_[wave_index];
+  const TableAxis *time_axis = currents.timeAxis();
   float prev_time = time_axis->axisValue(0);
-  float prev_current = currents->value(0);
+  float prev_current = currents.current(0);
   float voltage = 0.0;
   volts->push_back(voltage);
   bool always_rise = true;
   bool invert = (always_rise && rf_ == RiseFall::fall());
   for (size_t i = 1; i < time_axis->size(); i++) {
     float time = time_axis->axisValue(i);
-    float current = currents->value(i);
+    float current = currents.current(i);
     float dv = (current + prev_current) / 2.0 * (time - prev_time) / cap;
     voltage += invert ? -dv : dv;
     volts->push_back(voltage);
     prev_time = time;
     prev_current = current;
   }
-  Table1 *volt_table = new Table1(volts, currents->axis1ptr());
+  Table1 *volt_table = new Table1(volts, currents.timeAxisPtr());
   voltage_waveforms_[wave_index] = volt_table;
 
   // Make voltage -> current table.
   FloatSeq *axis_volts = new FloatSeq(*volts);
   TableAxisPtr volt_axis =
     make_shared<TableAxis>(TableAxisVariable::input_voltage, axis_volts);
-  FloatSeq *currents1 = new FloatSeq(*currents->values());
+  FloatSeq *currents1 = new FloatSeq;
+  currents1->reserve(currents.size());
+  for (size_t i = 0; i < currents.size(); i++)
+    currents1->push_back(currents.current(i));
   Table1 *volt_currents = new Table1(currents1, volt_axis);
   voltage_currents_[wave_index] = volt_currents;
 
@@ -1690,14 +2075,14 @@ OutputWaveforms::findVoltages(size_t wave_index,
   voltage_times_[wave_index] = voltage_times;
 }
 
-const Table1 *
+Table1
 OutputWaveforms::currentWaveform(float slew,
                                  float cap)
 {
   size_t slew_index = slew_axis_->findAxisIndex(slew);
   size_t cap_index = cap_axis_->findAxisIndex(cap);
   size_t wave_index = slew_index * cap_axis_->size() + cap_index;
-  return current_waveforms_[wave_index];
+  return current_waveforms_[wave_index].table();
 }
 
 float
@@ -1705,7 +2090,19 @@ OutputWaveforms::timeCurrent(float slew,
                              float cap,
                              float time)
 {
-  return waveformValue(slew, cap, time, current_waveforms_);
+  size_t wave_indices[4];
+  double dx1, dx2;
+  findWaveIndices(slew, cap, wave_indices, dx1, dx2);
+  double y00 = current_waveforms_[wave_indices[0]].findValueClip(time);
+  double y01 = current_waveforms_[wave_indices[1]].findValueClip(time);
+  double y10 = current_waveforms_[wave_indices[2]].findValueClip(time);
+  double y11 = current_waveforms_[wave_indices[3]].findValueClip(time);
+  double current
+    =   (1 - dx1) * (1 - dx2) * y00
+      +      dx1  * (1 - dx2) * y10
+      +      dx1  *      dx2  * y11
+      + (1 - dx1) *      dx2  * y01;
+  return current;
 }
 
 float
@@ -1724,36 +2121,22 @@ OutputWaveforms::voltageCurrent(float slew,
   return waveformValue(slew, cap, volt, voltage_currents_);
 }
 
+// Interpolate voltage_waveforms_ or voltage_currents_.
 float
 OutputWaveforms::waveformValue(float slew,
                                float cap,
                                float axis_value,
                                Table1Seq &waveforms)
 {
-  size_t slew_index = slew_axis_->findAxisIndex(slew);
-  size_t cap_index = cap_axis_->findAxisIndex(cap);
-  size_t cap_count = cap_axis_->size();
-  size_t wave_index00 = slew_index * cap_count + cap_index;
-  size_t wave_index01 = slew_index * cap_count + (cap_index + 1);
-  size_t wave_index10 = (slew_index + 1) * cap_count + cap_index;
-  size_t wave_index11 = (slew_index + 1) * cap_count + (cap_index + 1);
-
-  const Table1 *waveform00 = waveforms[wave_index00];
-  const Table1 *waveform01 = waveforms[wave_index01];
-  const Table1 *waveform10 = waveforms[wave_index10];
-  const Table1 *waveform11 = waveforms[wave_index11];
-
-  // Interpolate waveform samples at voltage steps.
-  size_t index1 = slew_index;
-  size_t index2 = cap_index;
-  double x1 = slew;
-  double x2 = cap;
-  double x1l = slew_axis_->axisValue(index1);
-  double x1u = slew_axis_->axisValue(index1 + 1);
-  double dx1 = (x1 - x1l) / (x1u - x1l);
-  double x2l = cap_axis_->axisValue(index2);
-  double x2u = cap_axis_->axisValue(index2 + 1);
-  double dx2 = (x2 - x2l) / (x2u - x2l);
+  size_t wave_indices[4];
+  double dx1, dx2;
+  findWaveIndices(slew, cap, wave_indices, dx1, dx2);
+  ensureVoltages(wave_indices);
+
+  const Table1 *waveform00 = waveforms[wave_indices[0]];
+  const Table1 *waveform01 = waveforms[wave_indices[1]];
+  const Table1 *waveform10 = waveforms[wave_indices[2]];
+  const Table1 *waveform11 = waveforms[wave_indices[3]];
 
   double y00 = waveform00->findValueClip(axis_value);
   double y01 = waveform01->findValueClip(axis_value);
@@ -1800,18 +2183,15 @@ OutputWaveforms::waveformMinMaxTime(float slew,
                                     float &min_time,
                                     float &max_time)
 {
-  size_t slew_index = slew_axis_->findAxisIndex(slew);
-  size_t cap_index = cap_axis_->findAxisIndex(cap);
-  size_t cap_count = cap_axis_->size();
-  size_t wave_index00 = slew_index * cap_count + cap_index;
-  size_t wave_index01 = slew_index * cap_count + (cap_index + 1);
-  size_t wave_index10 = (slew_index + 1) * cap_count + cap_index;
-  size_t wave_index11 = (slew_index + 1) * cap_count + (cap_index + 1);
+  size_t wave_indices[4];
+  double dx1, dx2;
+  findWaveIndices(slew, cap, wave_indices, dx1, dx2);
+  ensureVoltages(wave_indices);
 
-  const Table1 *waveform00 = waveforms[wave_index00];
-  const Table1 *waveform01 = waveforms[wave_index01];
-  const Table1 *waveform10 = waveforms[wave_index10];
-  const Table1 *waveform11 = waveforms[wave_index11];
+  const Table1 *waveform00 = waveforms[wave_indices[0]];
+  const Table1 *waveform01 = waveforms[wave_indices[1]];
+  const Table1 *waveform10 = waveforms[wave_indices[2]];
+  const Table1 *waveform11 = waveforms[wave_indices[3]];
 
   min_time = waveform00->axis1()->min();
   min_time = min(min_time, waveform01->axis1()->min());
@@ -1829,30 +2209,41 @@ OutputWaveforms::voltageTime(float slew,
                              float cap,
                              float volt)
 {
-  size_t slew_index = slew_axis_->findAxisIndex(slew);
-  size_t cap_index = cap_axis_->findAxisIndex(cap);
-  size_t cap_count = cap_axis_->size();
-  size_t wave_index00 = slew_index * cap_count + cap_index;
-  size_t wave_index01 = slew_index * cap_count + (cap_index + 1);
-  size_t wave_index10 = (slew_index + 1) * cap_count + cap_index;
-  size_t wave_index11 = (slew_index + 1) * cap_count + (cap_index + 1);
-
-  // Interpolate waveform samples at voltage steps.
-  size_t index1 = slew_index;
-  size_t index2 = cap_index;
-  double x1 = slew;
-  double x2 = cap;
-  double x1l = slew_axis_->axisValue(index1);
-  double x1u = slew_axis_->axisValue(index1 + 1);
-  double dx1 = (x1 - x1l) / (x1u - x1l);
-  double x2l = cap_axis_->axisValue(index2);
-  double x2u = cap_axis_->axisValue(index2 + 1);
-  double dx2 = (x2 - x2l) / (x2u - x2l);
-
-  double y00 = voltageTime1(volt, wave_index00);
-  double y01 = voltageTime1(volt, wave_index01);
-  double y10 = voltageTime1(volt, wave_index10);
-  double y11 = voltageTime1(volt, wave_index11);
+  size_t wave_indices[4];
+  double dx1, dx2;
+  findWaveIndices(slew, cap, wave_indices, dx1, dx2);
+  ensureVoltages(wave_indices);
+  return voltageTime2(volt, wave_indices, dx1, dx2);
+}
+
+void
+OutputWaveforms::voltageTimes(float slew,
+                              float cap,
+                              float volt1,
+                              float volt2,
+                              // Return values.
+                              double &time1,
+                              double &time2)
+{
+  size_t wave_indices[4];
+  double dx1, dx2;
+  findWaveIndices(slew, cap, wave_indices, dx1, dx2);
+  ensureVoltages(wave_indices);
+  time1 = voltageTime2(volt1, wave_indices, dx1, dx2);
+  time2 = voltageTime2(volt2, wave_indices, dx1, dx2);
+}
+
+// Interpolate waveform samples at voltage steps.
+double
+OutputWaveforms::voltageTime2(float volt,
+                              const size_t wave_indices[4],
+                              double dx1,
+                              double dx2)
+{
+  double y00 = voltageTime1(volt, wave_indices[0]);
+  double y01 = voltageTime1(volt, wave_indices[1]);
+  double y10 = voltageTime1(volt, wave_indices[2]);
+  double y11 = voltageTime1(volt, wave_indices[3]);
   double time
     =   (1 - dx1) * (1 - dx2) * y00
       +      dx1  * (1 - dx2) * y10
@@ -582,17 +582,6 @@ TimingArc::setIndex(unsigned index)
   index_ = index;
 }
 
-const TimingArc *
-TimingArc::cornerArc(int ap_index) const
-{
-  if (ap_index < static_cast<int>(corner_arcs_.size())) {
-    TimingArc *corner_arc = corner_arcs_[ap_index];
-    if (corner_arc)
-      return corner_arc;
-  }
-  return this;
-}
-
 void
 TimingArc::setCornerArc(TimingArc *corner_arc,
 			int ap_index)
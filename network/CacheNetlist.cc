@@ -0,0 +1,65 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "CacheNetlist.hh"
+
+#include "Hash.hh"
+#include "Network.hh"
+
+namespace sta {
+
+CacheNetlist::CacheNetlist(StaState *sta) :
+  StaState(sta),
+  checksum_(hash_init_value)
+{
+  findObjects(network_->topInstance());
+}
+
+void
+CacheNetlist::findObjects(const Instance *inst)
+{
+  hashIncr(checksum_, hashString(network_->name(inst)));
+  if (network_->isLeaf(inst)
+      || inst == network_->topInstance()) {
+    InstancePinIterator *pin_iter = network_->pinIterator(inst);
+    while (pin_iter->hasNext()) {
+      const Pin *pin = pin_iter->next();
+      pins_.push_back(pin);
+      hashIncr(checksum_, network_->id(pin));
+      hashIncr(checksum_, hashString(network_->portName(pin)));
+    }
+    delete pin_iter;
+  }
+  InstanceNetIterator *net_iter = network_->netIterator(inst);
+  while (net_iter->hasNext()) {
+    const Net *net = net_iter->next();
+    // Skip nets of the parent that the iterator may include.
+    if (network_->instance(net) == inst) {
+      nets_.push_back(net);
+      hashIncr(checksum_, network_->id(net));
+      hashIncr(checksum_, hashString(network_->name(net)));
+    }
+  }
+  delete net_iter;
+  InstanceChildIterator *child_iter = network_->childIterator(inst);
+  while (child_iter->hasNext()) {
+    const Instance *child = child_iter->next();
+    findObjects(child);
+  }
+  delete child_iter;
+}
+
+} // namespace
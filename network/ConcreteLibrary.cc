@@ -42,12 +42,14 @@ ConcreteLibrary::ConcreteLibrary(const char *name,
   filename_(stringCopy(filename)),
   is_liberty_(is_liberty),
   bus_brkt_left_('['),
-  bus_brkt_right_(']')
+  bus_brkt_right_(']'),
+  cell_loader_(nullptr)
 {
 }
 
 ConcreteLibrary::~ConcreteLibrary()
 {
+  delete cell_loader_;
   stringDelete(name_);
   stringDelete(filename_);
   cell_map_.deleteContents();
@@ -87,18 +89,23 @@ ConcreteLibrary::deleteCell(ConcreteCell *cell)
 ConcreteLibraryCellIterator *
 ConcreteLibrary::cellIterator() const
 {
+  loadCells();
   return new ConcreteLibraryCellIterator(cell_map_);
 }
 
 ConcreteCell *
 ConcreteLibrary::findCell(const char *name) const
 {
-  return cell_map_.findKey(name);
+  ConcreteCell *cell = cell_map_.findKey(name);
+  if (cell == nullptr && cell_loader_)
+    cell = cell_loader_->loadCell(name);
+  return cell;
 }
 
 CellSeq
 ConcreteLibrary::findCellsMatching(const PatternMatch *pattern) const
 {
+  loadCellsMatching(pattern);
   CellSeq matches;
   ConcreteLibraryCellIterator cell_iter=ConcreteLibraryCellIterator(cell_map_);
   while (cell_iter.hasNext()) {
@@ -109,6 +116,27 @@ ConcreteLibrary::findCellsMatching(const PatternMatch *pattern) const
   return matches;
 }
 
+void
+ConcreteLibrary::setCellLoader(ConcreteCellLoader *loader)
+{
+  delete cell_loader_;
+  cell_loader_ = loader;
+}
+
+void
+ConcreteLibrary::loadCells() const
+{
+  if (cell_loader_)
+    cell_loader_->loadCells();
+}
+
+void
+ConcreteLibrary::loadCellsMatching(const PatternMatch *pattern) const
+{
+  if (cell_loader_)
+    cell_loader_->loadCellsMatching(pattern);
+}
+
 void
 ConcreteLibrary::setBusBrkts(char left,
 			     char right)
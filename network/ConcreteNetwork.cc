@@ -16,12 +16,18 @@
 
 #include "ConcreteNetwork.hh"
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
 #include "PatternMatch.hh"
 #include "Report.hh"
 #include "Liberty.hh"
 #include "PortDirection.hh"
 #include "ConcreteLibrary.hh"
+#include "DispatchQueue.hh"
 #include "Network.hh"
+#include "MemoryStats.hh"
 
 namespace sta {
 
@@ -48,52 +54,58 @@ makeConcreteNetwork()
   return new ConcreteNetwork;
 }
 
+// Children in name order.
 class ConcreteInstanceChildIterator : public InstanceChildIterator
 {
 public:
-  explicit ConcreteInstanceChildIterator(ConcreteInstanceChildMap *map);
+  explicit ConcreteInstanceChildIterator(ConcreteInstanceChildIndexPtr index);
   bool hasNext();
   Instance *next();
 
 private:
-  ConcreteInstanceChildMap::ConstIterator iter_;
+  ConcreteInstanceChildIndexPtr index_;
+  size_t next_;
 };
 
 ConcreteInstanceChildIterator::
-ConcreteInstanceChildIterator(ConcreteInstanceChildMap *map) :
-  iter_(map)
+ConcreteInstanceChildIterator(ConcreteInstanceChildIndexPtr index) :
+  index_(index),
+  next_(0)
 {
 }
 
 bool
 ConcreteInstanceChildIterator::hasNext()
 {
-  return iter_.hasNext();
+  return index_ && next_ < index_->size();
 }
 
 Instance *
 ConcreteInstanceChildIterator::next()
 {
-  return reinterpret_cast<Instance*>(iter_.next());
+  return reinterpret_cast<Instance*>((*index_)[next_++].second);
 }
 
+// Nets in name order.
 class ConcreteInstanceNetIterator : public InstanceNetIterator
 {
 public:
-  explicit ConcreteInstanceNetIterator(ConcreteInstanceNetMap *nets);
+  explicit ConcreteInstanceNetIterator(ConcreteInstanceNetIndexPtr index);
   bool hasNext();
   Net *next();
 
 private:
   void findNext();
 
-  ConcreteInstanceNetMap::Iterator iter_;
+  ConcreteInstanceNetIndexPtr index_;
+  size_t index_next_;
   ConcreteNet *next_;
 };
 
 ConcreteInstanceNetIterator::
-ConcreteInstanceNetIterator(ConcreteInstanceNetMap *nets):
-  iter_(nets),
+ConcreteInstanceNetIterator(ConcreteInstanceNetIndexPtr index):
+  index_(index),
+  index_next_(0),
   next_(nullptr)
 {
   findNext();
@@ -109,8 +121,8 @@ ConcreteInstanceNetIterator::hasNext()
 void
 ConcreteInstanceNetIterator::findNext()
 {
-  while (iter_.hasNext()) {
-    next_ = iter_.next();
+  while (index_ && index_next_ < index_->size()) {
+    next_ = (*index_)[index_next_++].second;
     if (next_->mergedInto() == nullptr)
       return;
   }
@@ -252,7 +264,8 @@ ConcreteNetwork::ConcreteNetwork() :
   NetworkReader(),
   top_instance_(nullptr),
   constant_nets_{NetSet(this), NetSet(this)},
-  link_func_(nullptr)
+  link_func_(nullptr),
+  is_flat_(false)
 {
 }
 
@@ -268,9 +281,83 @@ ConcreteNetwork::clear()
   deleteCellNetworkViews();
   library_seq_.deleteContentsClear();
   library_map_.clear();
+  name_pool_.clear();
   Network::clear();
 }
 
+void
+ConcreteNetwork::memoryStats(MemoryStats &stats) const
+{
+  size_t inst_count = 0;
+  size_t inst_bytes = 0;
+  size_t pin_count = 0;
+  size_t term_count = 0;
+  size_t net_count = 0;
+  size_t net_bytes = 0;
+  if (top_instance_)
+    instanceMemoryStats(reinterpret_cast<const ConcreteInstance*>(top_instance_),
+                        inst_count, inst_bytes, pin_count, term_count,
+                        net_count, net_bytes);
+  stats.add("network", "instances", inst_count, inst_bytes);
+  stats.add("network", "pins", pin_count, pin_count * sizeof(ConcretePin));
+  stats.add("network", "terms", term_count, term_count * sizeof(ConcreteTerm));
+  stats.add("network", "nets", net_count, net_bytes);
+  stats.add("network", "names", name_pool_.size(),
+            name_pool_.bytes()
+            + name_pool_.size() * MemoryStats::hash_node_bytes);
+  size_t cell_count = 0;
+  for (const ConcreteLibrary *lib : library_seq_) {
+    if (!lib->isLiberty()) {
+      ConcreteLibraryCellIterator *cell_iter = lib->cellIterator();
+      while (cell_iter->hasNext()) {
+        cell_iter->next();
+        cell_count++;
+      }
+      delete cell_iter;
+    }
+  }
+  stats.add("network", "cells", cell_count, cell_count * sizeof(ConcreteCell));
+}
+
+void
+ConcreteNetwork::instanceMemoryStats(const ConcreteInstance *inst,
+                                     // Return values.
+                                     size_t &inst_count,
+                                     size_t &inst_bytes,
+                                     size_t &pin_count,
+                                     size_t &term_count,
+                                     size_t &net_count,
+                                     size_t &net_bytes) const
+{
+  inst_count++;
+  inst_bytes += sizeof(ConcreteInstance)
+    + inst->pins_.capacity() * sizeof(ConcretePin*);
+  for (const ConcretePin *pin : inst->pins_) {
+    if (pin) {
+      pin_count++;
+      if (pin->term_)
+        term_count++;
+    }
+  }
+  if (inst->nets_) {
+    net_count += inst->nets_->size();
+    net_bytes += inst->nets_->size()
+      * (sizeof(ConcreteNet) + MemoryStats::hash_node_bytes);
+  }
+  if (inst->net_index_)
+    net_bytes += inst->net_index_->capacity()
+      * sizeof(ConcreteInstanceNetIndex::value_type);
+  if (inst->child_index_)
+    inst_bytes += inst->child_index_->capacity()
+      * sizeof(ConcreteInstanceChildIndex::value_type);
+  if (inst->children_) {
+    inst_bytes += inst->children_->size() * MemoryStats::hash_node_bytes;
+    for (const auto &name_child : *inst->children_)
+      instanceMemoryStats(name_child.second, inst_count, inst_bytes,
+                          pin_count, term_count, net_count, net_bytes);
+  }
+}
+
 void
 ConcreteNetwork::deleteTopInstance()
 {
@@ -278,6 +365,7 @@ ConcreteNetwork::deleteTopInstance()
     deleteInstance(top_instance_);
     top_instance_ = nullptr;
   }
+  is_flat_ = false;
 }
 
 void
@@ -614,6 +702,13 @@ ConcreteNetwork::getAttribute(const Cell *cell,
   return ccell->getAttribute(key);
 }
 
+const AttributeMap &
+ConcreteNetwork::attributeMap(const Cell *cell) const
+{
+  const ConcreteCell *ccell = reinterpret_cast<const ConcreteCell*>(cell);
+  return ccell->attributeMap();
+}
+
 Port *
 ConcreteNetwork::findPort(const Cell *cell,
 			  const char *name) const
@@ -685,6 +780,14 @@ ConcreteNetwork::nextObjectId()
   return object_id_++;
 }
 
+ObjectId
+ConcreteNetwork::reserveObjectIds(ObjectId count)
+{
+  ObjectId id = object_id_;
+  object_id_ += count;
+  return id;
+}
+
 ////////////////////////////////////////////////////////////////
 
 class ConcreteCellPortIterator1 : public CellPortIterator
@@ -946,6 +1049,13 @@ ConcreteNetwork::getAttribute(const Instance *inst,
   return cinst->getAttribute(key);
 }
 
+const AttributeMap &
+ConcreteNetwork::attributeMap(const Instance *inst) const
+{
+  const ConcreteInstance *cinst = reinterpret_cast<const ConcreteInstance*>(inst);
+  return cinst->attributeMap();
+}
+
 Cell *
 ConcreteNetwork::cell(const Instance *instance) const
 {
@@ -1017,6 +1127,16 @@ ConcreteNetwork::findInstNetsMatching(const Instance *instance,
   return inst->findNetsMatching(pattern, matches);
 }
 
+void
+ConcreteNetwork::findChildrenMatching(const Instance *parent,
+                                      const PatternMatch *pattern,
+                                      InstanceSeq &matches) const
+{
+  const ConcreteInstance *inst =
+    reinterpret_cast<const ConcreteInstance*>(parent);
+  inst->findChildrenMatching(pattern, matches);
+}
+
 ////////////////////////////////////////////////////////////////
 
 InstanceChildIterator *
@@ -1226,12 +1346,85 @@ ConcreteNetwork::makeConcreteInstance(ConcreteCell *cell,
 {
   ConcreteInstance *cparent =
     reinterpret_cast<ConcreteInstance*>(parent);
-  ConcreteInstance *inst = new ConcreteInstance(name, cell, cparent);
-  if (parent)
+  ConcreteInstance *inst = new ConcreteInstance(name_pool_.intern(name),
+                                                cell, cparent);
+  if (parent) {
     cparent->addChild(inst);
+    if (is_flat_
+        && (parent != top_instance_
+            || !cell->isLeaf()))
+      is_flat_ = false;
+  }
   return reinterpret_cast<Instance*>(inst);
 }
 
+// Leaf instances made by a task.
+static const size_t leaf_instance_chunk_size = 1024;
+
+void
+ConcreteNetwork::makeLeafInstances(LeafInstanceDefSeq &defs,
+                                   Instance *parent,
+                                   DispatchQueue *dispatch_queue)
+{
+  if (dispatch_queue == nullptr
+      || defs.size() <= leaf_instance_chunk_size) {
+    NetworkReader::makeLeafInstances(defs, parent, dispatch_queue);
+    return;
+  }
+  ConcreteInstance *cparent = reinterpret_cast<ConcreteInstance*>(parent);
+  // Reserve the ids of every instance and its pins in defs order so
+  // they do not depend on thread timing.
+  size_t def_count = defs.size();
+  // The name pool is not thread safe so intern the names here too.
+  std::vector<ObjectId> ids(def_count);
+  std::vector<const char*> names(def_count);
+  ObjectId id_count = 0;
+  for (size_t i = 0; i < def_count; i++) {
+    ids[i] = id_count;
+    id_count += 1 + defs[i].cell_->portBitCount();
+    names[i] = name_pool_.intern(defs[i].name_);
+  }
+  ObjectId first_id = reserveObjectIds(id_count);
+
+  for (size_t from = 0; from < def_count; from += leaf_instance_chunk_size) {
+    size_t to = std::min(from + leaf_instance_chunk_size, def_count);
+    dispatch_queue->dispatch([this, &defs, &ids, &names, cparent, first_id,
+                              from, to] (int) {
+      for (size_t i = from; i < to; i++)
+        makeLeafInstance(defs[i], names[i], cparent, first_id + ids[i]);
+    });
+  }
+  dispatch_queue->finishTasks();
+
+  // Link serially so child maps and net pin lists match serial linking.
+  for (LeafInstanceDef &def : defs) {
+    ConcreteInstance *cinst = reinterpret_cast<ConcreteInstance*>(def.inst_);
+    cparent->addChild(cinst);
+    for (ConcretePin *cpin : cinst->pins_) {
+      if (cpin && cpin->net_)
+        connectNetPin(cpin->net_, cpin);
+    }
+  }
+}
+
+void
+ConcreteNetwork::makeLeafInstance(LeafInstanceDef &def,
+                                  const char *name,
+                                  ConcreteInstance *parent,
+                                  ObjectId id)
+{
+  ConcreteInstance *cinst = new ConcreteInstance(name, def.cell_,
+                                                 parent, id++);
+  LibertyCellPortBitIterator port_iter(def.cell_);
+  while (port_iter.hasNext()) {
+    LibertyPort *port = port_iter.next();
+    ConcreteNet *cnet = reinterpret_cast<ConcreteNet*>(def.nets_[port->pinIndex()]);
+    ConcretePin *cpin = new ConcretePin(cinst, port, cnet, id++);
+    cinst->addPin(cpin);
+  }
+  def.inst_ = reinterpret_cast<Instance*>(cinst);
+}
+
 void
 ConcreteNetwork::makePins(Instance *inst)
 {
@@ -1478,7 +1671,7 @@ ConcreteNetwork::makeNet(const char *name,
 			 Instance *parent)
 {
   ConcreteInstance *cparent = reinterpret_cast<ConcreteInstance*>(parent);
-  ConcreteNet *net = new ConcreteNet(name, cparent);
+  ConcreteNet *net = new ConcreteNet(name_pool_.intern(name), cparent);
   cparent->addNet(net);
   return reinterpret_cast<Net*>(net);
 }
@@ -1525,6 +1718,12 @@ ConcreteNetwork::addConstantNet(Net *net,
     constant_nets_[int(value)].insert(net);
 }
 
+const NetSet &
+ConcreteNetwork::constantNets(LogicValue value) const
+{
+  return constant_nets_[int(value)];
+}
+
 ConstantPinIterator *
 ConcreteNetwork::constantPinIterator()
 {
@@ -1571,12 +1770,214 @@ ConcreteNetwork::visitConnectedPins(const Net *net,
   }
 }
 
+// Flat nets have no terms below them and their terms are top level
+// port pins, so the pins connected to a net are the pins of the net
+// and the pins of its terms.
+void
+ConcreteNetwork::visitFlatConnectedPins(const ConcreteNet *net,
+                                        PinVisitor &visitor) const
+{
+  for (ConcreteTerm *term = net->terms_; term; term = term->net_next_) {
+    ConcretePin *above_pin = term->pin_;
+    if (above_pin)
+      visitor(reinterpret_cast<Pin*>(above_pin));
+  }
+  for (ConcretePin *pin = net->pins_; pin; pin = pin->net_next_)
+    visitor(reinterpret_cast<Pin*>(pin));
+}
+
+void
+ConcreteNetwork::visitConnectedPins(const Net *net,
+                                    PinVisitor &visitor) const
+{
+  if (is_flat_)
+    visitFlatConnectedPins(reinterpret_cast<const ConcreteNet*>(net),
+                           visitor);
+  else
+    Network::visitConnectedPins(net, visitor);
+}
+
+void
+ConcreteNetwork::visitConnectedPins(const Pin *pin,
+                                    PinVisitor &visitor) const
+{
+  if (is_flat_) {
+    const ConcretePin *cpin = reinterpret_cast<const ConcretePin*>(pin);
+    ConcreteTerm *term = cpin->term_;
+    if (cpin->net_)
+      visitFlatConnectedPins(cpin->net_, visitor);
+    else if (term == nullptr)
+      // Unconnected pin.
+      visitor(pin);
+    if (term && term->net_)
+      visitFlatConnectedPins(term->net_, visitor);
+  }
+  else
+    Network::visitConnectedPins(pin, visitor);
+}
+
+// Iterate over the term pins and pins of a flat net without
+// collecting them in a set.
+class ConcreteFlatConnectedPinIterator : public ConnectedPinIterator
+{
+public:
+  ConcreteFlatConnectedPinIterator(const ConcreteNet *net,
+                                   const Pin *pin);
+  bool hasNext() override;
+  const Pin *next() override;
+
+private:
+  void findNext();
+
+  ConcreteTerm *term_next_;
+  ConcretePin *pin_next_;
+  // Pin returned when there is no net.
+  const Pin *pin_;
+  const Pin *next_;
+};
+
+ConcreteFlatConnectedPinIterator::
+ConcreteFlatConnectedPinIterator(const ConcreteNet *net,
+                                 const Pin *pin) :
+  term_next_(net ? net->terms_ : nullptr),
+  pin_next_(net ? net->pins_ : nullptr),
+  pin_(pin)
+{
+  findNext();
+}
+
+void
+ConcreteFlatConnectedPinIterator::findNext()
+{
+  next_ = nullptr;
+  while (term_next_) {
+    ConcretePin *above_pin = term_next_->pin_;
+    term_next_ = term_next_->net_next_;
+    if (above_pin) {
+      next_ = reinterpret_cast<Pin*>(above_pin);
+      return;
+    }
+  }
+  if (pin_next_) {
+    next_ = reinterpret_cast<Pin*>(pin_next_);
+    pin_next_ = pin_next_->net_next_;
+  }
+  else if (pin_) {
+    next_ = pin_;
+    pin_ = nullptr;
+  }
+}
+
+bool
+ConcreteFlatConnectedPinIterator::hasNext()
+{
+  return next_ != nullptr;
+}
+
+const Pin *
+ConcreteFlatConnectedPinIterator::next()
+{
+  const Pin *next = next_;
+  findNext();
+  return next;
+}
+
+NetConnectedPinIterator *
+ConcreteNetwork::connectedPinIterator(const Net *net) const
+{
+  if (is_flat_)
+    return new ConcreteFlatConnectedPinIterator(
+      reinterpret_cast<const ConcreteNet*>(net), nullptr);
+  else
+    return Network::connectedPinIterator(net);
+}
+
+PinConnectedPinIterator *
+ConcreteNetwork::connectedPinIterator(const Pin *pin) const
+{
+  if (is_flat_) {
+    const ConcretePin *cpin = reinterpret_cast<const ConcretePin*>(pin);
+    const ConcreteNet *net = cpin->net_;
+    if (net == nullptr && cpin->term_)
+      net = cpin->term_->net_;
+    // The pin is one of the net (or term) pins.
+    return new ConcreteFlatConnectedPinIterator(net, net ? nullptr : pin);
+  }
+  else
+    return Network::connectedPinIterator(pin);
+}
+
+////////////////////////////////////////////////////////////////
+
+// Name characters per pool block.
+static const size_t name_pool_block_size = 64 * 1024;
+
+ConcreteNamePool::ConcreteNamePool() :
+  block_next_(nullptr),
+  block_free_(0),
+  bytes_(0)
+{
+}
+
+ConcreteNamePool::~ConcreteNamePool()
+{
+  clear();
+}
+
+const char *
+ConcreteNamePool::intern(const char *name)
+{
+  auto name_iter = names_.find(name);
+  if (name_iter != names_.end())
+    return *name_iter;
+  size_t length = strlen(name);
+  char *pool_name = makeName(length);
+  memcpy(pool_name, name, length + 1);
+  names_.insert(pool_name);
+  return pool_name;
+}
+
+char *
+ConcreteNamePool::makeName(size_t length)
+{
+  size_t size = length + 1;
+  // Names too big to share a block get their own.
+  if (size > name_pool_block_size / 4) {
+    char *name = new char[size];
+    blocks_.push_back(name);
+    bytes_ += size;
+    return name;
+  }
+  if (size > block_free_) {
+    block_next_ = new char[name_pool_block_size];
+    block_free_ = name_pool_block_size;
+    blocks_.push_back(block_next_);
+    bytes_ += name_pool_block_size;
+  }
+  char *name = block_next_;
+  block_next_ += size;
+  block_free_ -= size;
+  return name;
+}
+
+void
+ConcreteNamePool::clear()
+{
+  names_.clear();
+  for (char *block : blocks_)
+    delete [] block;
+  blocks_.clear();
+  block_next_ = nullptr;
+  block_free_ = 0;
+  bytes_ = 0;
+}
+
 ////////////////////////////////////////////////////////////////
 
 ConcreteInstance::ConcreteInstance(const char *name,
 				   ConcreteCell *cell,
                                    ConcreteInstance *parent) :
-  name_(stringCopy(name)),
+  name_(name),
   id_(ConcreteNetwork::nextObjectId()),
   cell_(cell),
   parent_(parent),
@@ -1586,6 +1987,20 @@ ConcreteInstance::ConcreteInstance(const char *name,
   initPins();
 }
 
+ConcreteInstance::ConcreteInstance(const char *name,
+				   ConcreteCell *cell,
+                                   ConcreteInstance *parent,
+                                   ObjectId id) :
+  name_(name),
+  id_(id),
+  cell_(cell),
+  parent_(parent),
+  children_(nullptr),
+  nets_(nullptr)
+{
+  initPins();
+}
+
 void
 ConcreteInstance::initPins()
 {
@@ -1595,7 +2010,6 @@ ConcreteInstance::initPins()
 
 ConcreteInstance::~ConcreteInstance()
 {
-  stringDelete(name_);
   delete children_;
   delete nets_;
 }
@@ -1648,19 +2062,139 @@ ConcreteInstance::findNet(const char *net_name) const
   return net;
 }
 
+// Maps smaller than this are matched by testing every name.
+static const size_t name_index_min_size = 64;
+
+// Length of the literal prefix of a glob pattern.
+// The index cannot look up the prefixes of regexp and nocase patterns.
+static size_t
+patternPrefixLength(const PatternMatch *pattern)
+{
+  if (pattern->isRegexp() || pattern->nocase())
+    return 0;
+  else
+    return strcspn(pattern->pattern(), "*?");
+}
+
+template <class INDEX>
+static void
+sortNameIndex(INDEX &index)
+{
+  sort(index.begin(), index.end(),
+       [] (const typename INDEX::value_type &entry1,
+           const typename INDEX::value_type &entry2) {
+         return strcmp(entry1.first, entry2.first) < 0;
+       });
+}
+
+// Locks the lazy index builds because iterators can be made on
+// several threads.
+static std::mutex name_index_lock;
+
+template <class MAP, class INDEX>
+static std::shared_ptr<INDEX>
+ensureNameIndex(const MAP *map,
+                std::shared_ptr<INDEX> &index)
+{
+  if (map == nullptr)
+    return nullptr;
+  std::lock_guard<std::mutex> lock(name_index_lock);
+  if (index == nullptr) {
+    index = std::make_shared<INDEX>();
+    index->reserve(map->size());
+    for (const auto &entry : *map)
+      index->push_back(entry);
+    sortNameIndex(*index);
+  }
+  return index;
+}
+
+// Match every map entry. The matches are sorted by name so they are
+// in the same order as the index matches.
+template <class MAP, class INDEX, class OBJ, class SEQ>
+static void
+findMapMatches(const MAP *map,
+               const PatternMatch *pattern,
+               SEQ &matches)
+{
+  INDEX entries;
+  for (const auto &entry : *map) {
+    if (pattern->match(entry.first))
+      entries.push_back(entry);
+  }
+  sortNameIndex(entries);
+  for (const auto &entry : entries)
+    matches.push_back(reinterpret_cast<OBJ*>(entry.second));
+}
+
+// Visit the index entries with names that start with the literal
+// prefix of pattern.
+template <class INDEX, class OBJ, class SEQ>
+static void
+findIndexMatches(const INDEX *index,
+                 const PatternMatch *pattern,
+                 size_t prefix_length,
+                 SEQ &matches)
+{
+  const char *prefix = pattern->pattern();
+  auto entry_iter = lower_bound(index->begin(), index->end(), prefix,
+                                [=] (const typename INDEX::value_type &entry,
+                                     const char *prefix) {
+                                  return strncmp(entry.first, prefix,
+                                                 prefix_length) < 0;
+                                });
+  for (; entry_iter != index->end()
+         && strncmp(entry_iter->first, prefix, prefix_length) == 0;
+       entry_iter++) {
+    if (pattern->match(entry_iter->first))
+      matches.push_back(reinterpret_cast<OBJ*>(entry_iter->second));
+  }
+}
+
+void
+ConcreteInstance::findChildrenMatching(const PatternMatch *pattern,
+                                       InstanceSeq &matches) const
+{
+  if (children_ == nullptr)
+    return;
+  if (pattern->hasWildcards()) {
+    size_t prefix_length = patternPrefixLength(pattern);
+    if (prefix_length > 0
+        && children_->size() >= name_index_min_size) {
+      ConcreteInstanceChildIndexPtr index = childIndex();
+      findIndexMatches<ConcreteInstanceChildIndex, Instance>(index.get(),
+                                                             pattern,
+                                                             prefix_length,
+                                                             matches);
+    }
+    else
+      findMapMatches<ConcreteInstanceChildMap, ConcreteInstanceChildIndex,
+                     Instance>(children_, pattern, matches);
+  }
+  else {
+    Instance *child = findChild(pattern->pattern());
+    if (child)
+      matches.push_back(child);
+  }
+}
+
 void
 ConcreteInstance::findNetsMatching(const PatternMatch *pattern,
                                    NetSeq &matches) const
 {
   if (pattern->hasWildcards()) {
-    ConcreteInstanceNetMap::Iterator net_iter(nets_);
-    while (net_iter.hasNext()) {
-      const char *net_name;
-      ConcreteNet *cnet;
-      net_iter.next(net_name, cnet);
-      if (pattern->match(net_name))
-	matches.push_back(reinterpret_cast<Net*>(cnet));
+    size_t prefix_length = patternPrefixLength(pattern);
+    if (prefix_length > 0
+        && nets_
+        && nets_->size() >= name_index_min_size) {
+      ConcreteInstanceNetIndexPtr index = netIndex();
+      findIndexMatches<ConcreteInstanceNetIndex, Net>(index.get(), pattern,
+                                                      prefix_length,
+                                                      matches);
     }
+    else if (nets_)
+      findMapMatches<ConcreteInstanceNetMap, ConcreteInstanceNetIndex,
+                     Net>(nets_, pattern, matches);
   }
   else {
     ConcreteNet *cnet = findNet(pattern->pattern());
@@ -1673,13 +2207,25 @@ InstanceNetIterator *
 ConcreteInstance::netIterator() const
 {
   return reinterpret_cast<InstanceNetIterator*>
-    (new ConcreteInstanceNetIterator(nets_));
+    (new ConcreteInstanceNetIterator(netIndex()));
 }
 
 InstanceChildIterator *
 ConcreteInstance::childIterator() const
 {
-  return new ConcreteInstanceChildIterator(children_);
+  return new ConcreteInstanceChildIterator(childIndex());
+}
+
+ConcreteInstanceChildIndexPtr
+ConcreteInstance::childIndex() const
+{
+  return ensureNameIndex(children_, child_index_);
+}
+
+ConcreteInstanceNetIndexPtr
+ConcreteInstance::netIndex() const
+{
+  return ensureNameIndex(nets_, net_index_);
 }
 
 void
@@ -1704,12 +2250,21 @@ ConcreteInstance::addChild(ConcreteInstance *child)
   if (children_ == nullptr)
     children_ = new ConcreteInstanceChildMap;
   (*children_)[child->name()] = child;
+  deleteChildIndex();
 }
 
 void
 ConcreteInstance::deleteChild(ConcreteInstance *child)
 {
   children_->erase(child->name());
+  deleteChildIndex();
+}
+
+void
+ConcreteInstance::deleteChildIndex()
+{
+  std::lock_guard<std::mutex> lock(name_index_lock);
+  child_index_.reset();
 }
 
 void
@@ -1735,6 +2290,7 @@ ConcreteInstance::addNet(ConcreteNet *net)
   if (nets_ == nullptr)
     nets_ = new ConcreteInstanceNetMap;
   (*nets_)[net->name()] = net;
+  deleteNetIndex();
 }
 
 void
@@ -1744,12 +2300,21 @@ ConcreteInstance::addNet(const char *name,
   if (nets_ == nullptr)
     nets_ = new ConcreteInstanceNetMap;
   (*nets_)[name] = net;
+  deleteNetIndex();
 }
 
 void
 ConcreteInstance::deleteNet(ConcreteNet *net)
 {
   nets_->erase(net->name());
+  deleteNetIndex();
+}
+
+void
+ConcreteInstance::deleteNetIndex()
+{
+  std::lock_guard<std::mutex> lock(name_index_lock);
+  net_index_.reset();
 }
 
 void
@@ -1774,6 +2339,21 @@ ConcretePin::ConcretePin(ConcreteInstance *instance,
 {
 }
 
+ConcretePin::ConcretePin(ConcreteInstance *instance,
+			 ConcretePort *port,
+			 ConcreteNet *net,
+                         ObjectId id) :
+  instance_(instance),
+  port_(port),
+  net_(net),
+  term_(nullptr),
+  id_(id),
+  net_next_(nullptr),
+  net_prev_(nullptr),
+  vertex_id_(vertex_id_null)
+{
+}
+
 const char *
 ConcretePin::name() const
 {
@@ -1810,7 +2390,7 @@ ConcreteTerm::ConcreteTerm(ConcretePin *pin,
 
 ConcreteNet::ConcreteNet(const char *name,
 			 ConcreteInstance *instance) :
-  name_(stringCopy(name)),
+  name_(name),
   id_(ConcreteNetwork::nextObjectId()),
   instance_(instance),
   pins_(nullptr),
@@ -1821,7 +2401,6 @@ ConcreteNet::ConcreteNet(const char *name,
 
 ConcreteNet::~ConcreteNet()
 {
-  stringDelete(name_);
 }
 
 // Merged nets are kept around to serve as name aliases.
@@ -1948,6 +2527,25 @@ ConcreteNetwork::setTopInstance(Instance *top_inst)
     clearNetDrvrPinMap();
   }
   top_instance_ = top_inst;
+  findIsFlat();
+}
+
+void
+ConcreteNetwork::findIsFlat()
+{
+  is_flat_ = false;
+  if (top_instance_) {
+    InstanceChildIterator *child_iter = childIterator(top_instance_);
+    is_flat_ = true;
+    while (child_iter->hasNext()) {
+      const Instance *child = child_iter->next();
+      if (!isLeaf(child)) {
+        is_flat_ = false;
+        break;
+      }
+    }
+    delete child_iter;
+  }
 }
 
 void
@@ -1965,6 +2563,7 @@ ConcreteNetwork::linkNetwork(const char *top_cell_name,
     clearConstantNets();
     deleteTopInstance();
     top_instance_ = link_func_(top_cell_name, make_black_boxes, report, this);
+    findIsFlat();
     if (top_instance_)
       checkNetworkLibertyCorners();
     return top_instance_ != nullptr;
@@ -0,0 +1,899 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "NetlistDb.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "Error.hh"
+#include "Report.hh"
+#include "StringUtil.hh"
+#include "PortDirection.hh"
+#include "Liberty.hh"
+#include "ConcreteNetwork.hh"
+
+namespace sta {
+
+using std::string;
+
+// File layout (host byte order):
+//  header     magic[8] version byte_order top_cell_name
+//  cells      count cell[count]
+//   cell      name kind
+//             liberty: bit_count bit_name[bit_count]
+//             module:  is_leaf port_count port[port_count] attributes
+//   port      name direction is_bus from_index to_index
+//  top        instance
+//   instance  name cell
+//             net_count net_name[net_count]
+//             pin_count pin[pin_count]
+//             attributes
+//             liberty_count liberty_inst[liberty_count]
+//             child_count instance[child_count]
+//   pin       bit net has_term term_net
+//   liberty_inst name cell attributes net[cell bit_count]
+//   attributes count {key value}[count]
+//  constants  count {net value}[count]
+//  end        end_marker
+// Strings are a length followed by the chars and a null so the reader
+// uses them in place. Cells are numbered in file order. Nets are
+// numbered in file order starting at 1; net 0 is no net. Pin bits are
+// indices into the cell port bits in port bit iterator order.
+static const char netlist_db_magic[8] = {'S', 'T', 'A', 'N', 'E', 'T', 'D', 'B'};
+static const uint32_t netlist_db_version = 1;
+static const uint32_t netlist_db_byte_order = 0x01020304;
+static const uint32_t netlist_db_end = 0x454e4421;
+
+enum class NetlistDbCellKind : uint8_t {
+  liberty,
+  module
+};
+
+// Max liberty instances made as one batch.
+static const size_t netlist_db_liberty_batch_size = 65536;
+
+class NetlistDbWriter
+{
+public:
+  NetlistDbWriter(const char *filename,
+                  ConcreteNetwork *network);
+  ~NetlistDbWriter();
+  void write();
+
+private:
+  void findCells(const Instance *inst);
+  uint32_t addCell(const Cell *cell);
+  void writeCells();
+  void writeInstance(const Instance *inst);
+  void writeLibertyInst(const Instance *inst);
+  void writeAttributes(const AttributeMap &attributes);
+  void writeConstants();
+  uint32_t netIndex(const Net *net) const;
+  void writeString(const char *str);
+  void writeString(const string &str);
+  template <class VALUE>
+  void writeValue(VALUE value);
+  void writeBytes(const void *bytes,
+                  size_t size);
+
+  const char *filename_;
+  ConcreteNetwork *network_;
+  FILE *stream_;
+  std::vector<const Cell*> cells_;
+  std::unordered_map<const Cell*, uint32_t> cell_indices_;
+  std::vector<uint32_t> cell_bit_counts_;
+  // Port bit index in the cell port bit iterator order.
+  std::unordered_map<const Port*, uint32_t> port_bits_;
+  std::unordered_map<const Net*, uint32_t> net_indices_;
+  uint32_t net_count_;
+  std::vector<uint32_t> bit_nets_;
+};
+
+void
+writeNetlistDb(const char *filename,
+               ConcreteNetwork *network)
+{
+  NetlistDbWriter writer(filename, network);
+  writer.write();
+}
+
+NetlistDbWriter::NetlistDbWriter(const char *filename,
+                                 ConcreteNetwork *network) :
+  filename_(filename),
+  network_(network),
+  stream_(nullptr),
+  net_count_(0)
+{
+}
+
+NetlistDbWriter::~NetlistDbWriter()
+{
+  if (stream_)
+    fclose(stream_);
+}
+
+void
+NetlistDbWriter::write()
+{
+  const Instance *top_inst = network_->topInstance();
+  findCells(top_inst);
+  stream_ = fopen(filename_, "wb");
+  if (stream_ == nullptr)
+    throw FileNotWritable(filename_);
+  writeBytes(netlist_db_magic, sizeof(netlist_db_magic));
+  writeValue(netlist_db_version);
+  writeValue(netlist_db_byte_order);
+  writeString(network_->name(network_->cell(top_inst)));
+  writeCells();
+  writeInstance(top_inst);
+  writeConstants();
+  writeValue(netlist_db_end);
+}
+
+void
+NetlistDbWriter::findCells(const Instance *inst)
+{
+  addCell(network_->cell(inst));
+  InstanceChildIterator *child_iter = network_->childIterator(inst);
+  while (child_iter->hasNext()) {
+    const Instance *child = child_iter->next();
+    if (network_->libertyCell(network_->cell(child)))
+      addCell(network_->cell(child));
+    else
+      findCells(child);
+  }
+  delete child_iter;
+}
+
+uint32_t
+NetlistDbWriter::addCell(const Cell *cell)
+{
+  auto itr = cell_indices_.find(cell);
+  if (itr != cell_indices_.end())
+    return itr->second;
+  if (network_->libertyCell(cell) == nullptr) {
+    CellPortIterator *port_iter = network_->portIterator(cell);
+    while (port_iter->hasNext()) {
+      const Port *port = port_iter->next();
+      if (network_->isBundle(port)) {
+        delete port_iter;
+        network_->report()->error(1661, "netlist db does not support bundle port %s of cell %s.",
+                                  network_->name(port),
+                                  network_->name(cell));
+      }
+    }
+    delete port_iter;
+  }
+  uint32_t index = cells_.size();
+  cells_.push_back(cell);
+  cell_indices_[cell] = index;
+  uint32_t bit = 0;
+  CellPortBitIterator *bit_iter = network_->portBitIterator(cell);
+  while (bit_iter->hasNext()) {
+    const Port *port = bit_iter->next();
+    port_bits_[port] = bit++;
+  }
+  delete bit_iter;
+  cell_bit_counts_.push_back(bit);
+  return index;
+}
+
+void
+NetlistDbWriter::writeCells()
+{
+  writeValue(static_cast<uint32_t>(cells_.size()));
+  for (const Cell *cell : cells_) {
+    writeString(network_->name(cell));
+    if (network_->libertyCell(cell)) {
+      writeValue(NetlistDbCellKind::liberty);
+      std::vector<const Port*> bits;
+      CellPortBitIterator *bit_iter = network_->portBitIterator(cell);
+      while (bit_iter->hasNext())
+        bits.push_back(bit_iter->next());
+      delete bit_iter;
+      writeValue(static_cast<uint32_t>(bits.size()));
+      for (const Port *bit : bits)
+        writeString(network_->name(bit));
+    }
+    else {
+      writeValue(NetlistDbCellKind::module);
+      writeValue(static_cast<uint8_t>(network_->isLeaf(cell)));
+      std::vector<const Port*> ports;
+      CellPortIterator *port_iter = network_->portIterator(cell);
+      while (port_iter->hasNext())
+        ports.push_back(port_iter->next());
+      delete port_iter;
+      writeValue(static_cast<uint32_t>(ports.size()));
+      for (const Port *port : ports) {
+        writeString(network_->name(port));
+        writeString(network_->direction(port)->name());
+        bool is_bus = network_->isBus(port);
+        writeValue(static_cast<uint8_t>(is_bus));
+        writeValue(static_cast<int32_t>(is_bus ? network_->fromIndex(port) : 0));
+        writeValue(static_cast<int32_t>(is_bus ? network_->toIndex(port) : 0));
+      }
+      writeAttributes(network_->attributeMap(cell));
+    }
+  }
+}
+
+void
+NetlistDbWriter::writeInstance(const Instance *inst)
+{
+  writeString(network_->name(inst));
+  writeValue(cell_indices_[network_->cell(inst)]);
+
+  NetSeq nets;
+  InstanceNetIterator *net_iter = network_->netIterator(inst);
+  while (net_iter->hasNext())
+    nets.push_back(net_iter->next());
+  delete net_iter;
+  writeValue(static_cast<uint32_t>(nets.size()));
+  for (const Net *net : nets) {
+    net_indices_[net] = ++net_count_;
+    writeString(network_->name(net));
+  }
+
+  PinSeq pins;
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext())
+    pins.push_back(pin_iter->next());
+  delete pin_iter;
+  writeValue(static_cast<uint32_t>(pins.size()));
+  for (const Pin *pin : pins) {
+    writeValue(port_bits_[network_->port(pin)]);
+    writeValue(netIndex(network_->net(pin)));
+    Term *term = network_->term(pin);
+    writeValue(static_cast<uint8_t>(term != nullptr));
+    writeValue(term ? netIndex(network_->net(term)) : 0U);
+  }
+  writeAttributes(network_->attributeMap(inst));
+
+  InstanceSeq liberty_insts;
+  InstanceSeq children;
+  InstanceChildIterator *child_iter = network_->childIterator(inst);
+  while (child_iter->hasNext()) {
+    const Instance *child = child_iter->next();
+    if (network_->libertyCell(network_->cell(child)))
+      liberty_insts.push_back(child);
+    else
+      children.push_back(child);
+  }
+  delete child_iter;
+  writeValue(static_cast<uint32_t>(liberty_insts.size()));
+  for (const Instance *liberty_inst : liberty_insts)
+    writeLibertyInst(liberty_inst);
+  writeValue(static_cast<uint32_t>(children.size()));
+  for (const Instance *child : children)
+    writeInstance(child);
+}
+
+void
+NetlistDbWriter::writeLibertyInst(const Instance *inst)
+{
+  uint32_t cell_index = cell_indices_[network_->cell(inst)];
+  writeString(network_->name(inst));
+  writeValue(cell_index);
+  writeAttributes(network_->attributeMap(inst));
+  bit_nets_.assign(cell_bit_counts_[cell_index], 0);
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin *pin = pin_iter->next();
+    bit_nets_[port_bits_[network_->port(pin)]] = netIndex(network_->net(pin));
+  }
+  delete pin_iter;
+  writeBytes(bit_nets_.data(), bit_nets_.size() * sizeof(uint32_t));
+}
+
+void
+NetlistDbWriter::writeAttributes(const AttributeMap &attributes)
+{
+  writeValue(static_cast<uint32_t>(attributes.size()));
+  for (const auto &key_value : attributes) {
+    writeString(key_value.first);
+    writeString(key_value.second);
+  }
+}
+
+void
+NetlistDbWriter::writeConstants()
+{
+  std::vector<std::pair<uint32_t, uint8_t>> constants;
+  for (LogicValue value : {LogicValue::zero, LogicValue::one}) {
+    for (const Net *net : network_->constantNets(value)) {
+      uint32_t index = netIndex(net);
+      if (index)
+        constants.push_back({index, static_cast<uint8_t>(value)});
+    }
+  }
+  writeValue(static_cast<uint32_t>(constants.size()));
+  for (auto &constant : constants) {
+    writeValue(constant.first);
+    writeValue(constant.second);
+  }
+}
+
+uint32_t
+NetlistDbWriter::netIndex(const Net *net) const
+{
+  if (net) {
+    auto itr = net_indices_.find(net);
+    if (itr != net_indices_.end())
+      return itr->second;
+  }
+  return 0;
+}
+
+void
+NetlistDbWriter::writeString(const char *str)
+{
+  uint32_t length = strlen(str);
+  writeValue(length);
+  // Include the terminating null.
+  writeBytes(str, length + 1);
+}
+
+void
+NetlistDbWriter::writeString(const string &str)
+{
+  writeString(str.c_str());
+}
+
+template <class VALUE>
+void
+NetlistDbWriter::writeValue(VALUE value)
+{
+  writeBytes(&value, sizeof(VALUE));
+}
+
+void
+NetlistDbWriter::writeBytes(const void *bytes,
+                            size_t size)
+{
+  if (size > 0)
+    fwrite(bytes, size, 1, stream_);
+}
+
+////////////////////////////////////////////////////////////////
+
+class NetlistDbCell
+{
+public:
+  Cell *cell_;
+  LibertyCell *liberty_cell_;
+  // Module cell port bits indexed by file bit.
+  std::vector<Port*> bits_;
+  // Liberty port pin indices indexed by file bit.
+  std::vector<int> bit_pin_indices_;
+};
+
+class NetlistDbReader
+{
+public:
+  NetlistDbReader(NetworkReader *network);
+  const char *read(const char *filename,
+                   DispatchQueue *dispatch_queue);
+  Instance *link(const char *top_cell_name,
+                 Report *report);
+
+private:
+  bool readFile();
+  bool readHeader();
+  bool readCells();
+  bool readLibertyCell(NetlistDbCell &db_cell,
+                       const char *name);
+  bool readModuleCell(NetlistDbCell &db_cell,
+                      const char *name);
+  // inst is set as soon as it is made so it can be deleted when
+  // the rest of the file is corrupt.
+  bool readInstance(Instance *parent,
+                    Instance *&inst);
+  bool readLibertyInsts(Instance *parent);
+  bool readCellAttributes(Cell *cell);
+  bool readInstAttributes(Instance *inst);
+  bool readConstants();
+  const char *readString();
+  Net *readNet();
+  template <class VALUE>
+  VALUE readValue();
+  bool readBytes(void *bytes,
+                 size_t size);
+  void clear();
+
+  NetworkReader *network_;
+  Report *report_;
+  DispatchQueue *dispatch_queue_;
+  string filename_;
+  std::vector<char> data_;
+  size_t pos_;
+  size_t header_end_;
+  bool truncated_;
+  // Errors other than corruption have been reported.
+  bool error_reported_;
+  const char *top_cell_name_;
+  Library *library_;
+  std::vector<NetlistDbCell> cells_;
+  // Indexed by file net number.
+  std::vector<Net*> nets_;
+};
+
+static NetlistDbReader *netlist_db_reader = nullptr;
+
+static Instance *
+linkNetlistDb(const char *top_cell_name,
+              bool,
+              Report *report,
+              NetworkReader *)
+{
+  return netlist_db_reader->link(top_cell_name, report);
+}
+
+const char *
+readNetlistDb(const char *filename,
+              NetworkReader *network,
+              DispatchQueue *dispatch_queue)
+{
+  if (netlist_db_reader == nullptr)
+    netlist_db_reader = new NetlistDbReader(network);
+  const char *top_cell_name = netlist_db_reader->read(filename,
+                                                      dispatch_queue);
+  if (top_cell_name)
+    network->setLinkFunc(linkNetlistDb);
+  return top_cell_name;
+}
+
+void
+deleteNetlistDbReader()
+{
+  delete netlist_db_reader;
+  netlist_db_reader = nullptr;
+}
+
+NetlistDbReader::NetlistDbReader(NetworkReader *network) :
+  network_(network),
+  report_(network->report()),
+  dispatch_queue_(nullptr),
+  pos_(0),
+  header_end_(0),
+  truncated_(false),
+  error_reported_(false),
+  top_cell_name_(nullptr),
+  library_(nullptr)
+{
+}
+
+const char *
+NetlistDbReader::read(const char *filename,
+                      DispatchQueue *dispatch_queue)
+{
+  clear();
+  filename_ = filename;
+  dispatch_queue_ = dispatch_queue;
+  if (!readFile())
+    throw FileNotReadable(filename);
+  if (readHeader())
+    return top_cell_name_;
+  else {
+    clear();
+    return nullptr;
+  }
+}
+
+// The whole file is read with one fread and decoded from memory.
+bool
+NetlistDbReader::readFile()
+{
+  FILE *stream = fopen(filename_.c_str(), "rb");
+  if (stream == nullptr)
+    return false;
+  bool success = false;
+  if (fseek(stream, 0, SEEK_END) == 0) {
+    long size = ftell(stream);
+    if (size >= 0
+        && fseek(stream, 0, SEEK_SET) == 0) {
+      data_.resize(size);
+      success = fread(data_.data(), 1, size, stream) == static_cast<size_t>(size);
+    }
+  }
+  fclose(stream);
+  return success;
+}
+
+bool
+NetlistDbReader::readHeader()
+{
+  char magic[sizeof(netlist_db_magic)];
+  if (!readBytes(magic, sizeof(magic))
+      || memcmp(magic, netlist_db_magic, sizeof(magic)) != 0) {
+    report_->warn(1662, "%s is not a netlist db file.", filename_.c_str());
+    return false;
+  }
+  uint32_t version = readValue<uint32_t>();
+  uint32_t byte_order = readValue<uint32_t>();
+  if (version != netlist_db_version
+      || byte_order != netlist_db_byte_order) {
+    report_->warn(1663, "netlist db %s version or byte order not supported.",
+                  filename_.c_str());
+    return false;
+  }
+  top_cell_name_ = readString();
+  if (top_cell_name_ == nullptr) {
+    report_->warn(1669, "netlist db %s is corrupt.", filename_.c_str());
+    return false;
+  }
+  header_end_ = pos_;
+  return true;
+}
+
+Instance *
+NetlistDbReader::link(const char *top_cell_name,
+                      Report *report)
+{
+  if (data_.empty()) {
+    report->warn(1665, "netlist db has already been linked; read it again to relink.");
+    return nullptr;
+  }
+  if (!stringEq(top_cell_name, top_cell_name_)) {
+    report->warn(1666, "netlist db %s top cell is %s, not %s.",
+                 filename_.c_str(), top_cell_name_, top_cell_name);
+    return nullptr;
+  }
+  pos_ = header_end_;
+  truncated_ = false;
+  error_reported_ = false;
+  // The previous db network was deleted before linking.
+  if (library_)
+    network_->deleteLibrary(library_);
+  library_ = network_->makeLibrary("netlist_db", filename_.c_str());
+  nets_.push_back(nullptr);
+
+  Instance *top_inst = nullptr;
+  bool success = readCells()
+    && readInstance(nullptr, top_inst)
+    && readConstants()
+    && readValue<uint32_t>() == netlist_db_end
+    && !truncated_;
+  if (!success) {
+    if (!error_reported_)
+      report->warn(1664, "netlist db %s is corrupt.", filename_.c_str());
+    if (top_inst)
+      network_->deleteInstance(top_inst);
+    top_inst = nullptr;
+  }
+  clear();
+  return top_inst;
+}
+
+bool
+NetlistDbReader::readCells()
+{
+  uint32_t cell_count = readValue<uint32_t>();
+  if (truncated_)
+    return false;
+  cells_.resize(cell_count);
+  for (NetlistDbCell &db_cell : cells_) {
+    const char *name = readString();
+    NetlistDbCellKind kind = readValue<NetlistDbCellKind>();
+    if (name == nullptr)
+      return false;
+    bool success;
+    switch (kind) {
+    case NetlistDbCellKind::liberty:
+      success = readLibertyCell(db_cell, name);
+      break;
+    case NetlistDbCellKind::module:
+      success = readModuleCell(db_cell, name);
+      break;
+    default:
+      success = false;
+      break;
+    }
+    if (!success || truncated_)
+      return false;
+  }
+  return true;
+}
+
+bool
+NetlistDbReader::readLibertyCell(NetlistDbCell &db_cell,
+                                 const char *name)
+{
+  LibertyCell *liberty_cell = network_->findLibertyCell(name);
+  if (liberty_cell == nullptr) {
+    report_->warn(1667, "netlist db %s liberty cell %s not found.",
+                  filename_.c_str(), name);
+    error_reported_ = true;
+    return false;
+  }
+  db_cell.cell_ = network_->cell(liberty_cell);
+  db_cell.liberty_cell_ = liberty_cell;
+  std::unordered_map<string, int> pin_indices;
+  LibertyCellPortBitIterator port_iter(liberty_cell);
+  while (port_iter.hasNext()) {
+    LibertyPort *port = port_iter.next();
+    pin_indices[port->name()] = port->pinIndex();
+  }
+  uint32_t bit_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < bit_count && !truncated_; i++) {
+    const char *bit_name = readString();
+    if (bit_name == nullptr)
+      return false;
+    auto itr = pin_indices.find(bit_name);
+    if (itr == pin_indices.end()) {
+      report_->warn(1668, "netlist db %s liberty cell %s port %s not found.",
+                    filename_.c_str(), name, bit_name);
+      error_reported_ = true;
+      return false;
+    }
+    db_cell.bit_pin_indices_.push_back(itr->second);
+  }
+  return true;
+}
+
+bool
+NetlistDbReader::readModuleCell(NetlistDbCell &db_cell,
+                                const char *name)
+{
+  bool is_leaf = readValue<uint8_t>();
+  Cell *cell = network_->makeCell(library_, name, is_leaf,
+                                  filename_.c_str());
+  db_cell.cell_ = cell;
+  db_cell.liberty_cell_ = nullptr;
+  uint32_t port_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < port_count && !truncated_; i++) {
+    const char *port_name = readString();
+    const char *dir_name = readString();
+    bool is_bus = readValue<uint8_t>();
+    int from_index = readValue<int32_t>();
+    int to_index = readValue<int32_t>();
+    if (port_name == nullptr
+        || dir_name == nullptr)
+      return false;
+    PortDirection *dir = PortDirection::find(dir_name);
+    if (dir == nullptr)
+      return false;
+    Port *port = is_bus
+      ? network_->makeBusPort(cell, port_name, from_index, to_index)
+      : network_->makePort(cell, port_name);
+    network_->setDirection(port, dir);
+  }
+  CellPortBitIterator *bit_iter = network_->portBitIterator(cell);
+  while (bit_iter->hasNext())
+    db_cell.bits_.push_back(bit_iter->next());
+  delete bit_iter;
+  return readCellAttributes(cell);
+}
+
+bool
+NetlistDbReader::readInstance(Instance *parent,
+                              Instance *&inst)
+{
+  const char *name = readString();
+  uint32_t cell_index = readValue<uint32_t>();
+  if (name == nullptr
+      || cell_index >= cells_.size()
+      || cells_[cell_index].liberty_cell_)
+    return false;
+  NetlistDbCell &db_cell = cells_[cell_index];
+  inst = network_->makeInstance(db_cell.cell_, name, parent);
+
+  uint32_t net_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < net_count && !truncated_; i++) {
+    const char *net_name = readString();
+    if (net_name == nullptr)
+      return false;
+    nets_.push_back(network_->makeNet(net_name, inst));
+  }
+
+  uint32_t pin_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < pin_count && !truncated_; i++) {
+    uint32_t bit = readValue<uint32_t>();
+    uint32_t net_index = readValue<uint32_t>();
+    bool has_term = readValue<uint8_t>();
+    uint32_t term_net_index = readValue<uint32_t>();
+    if (bit >= db_cell.bits_.size()
+        || net_index >= nets_.size()
+        || term_net_index >= nets_.size())
+      return false;
+    Pin *pin = network_->makePin(inst, db_cell.bits_[bit], nets_[net_index]);
+    if (has_term)
+      network_->makeTerm(pin, nets_[term_net_index]);
+  }
+  if (!readInstAttributes(inst)
+      || !readLibertyInsts(inst))
+    return false;
+
+  uint32_t child_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < child_count && !truncated_; i++) {
+    Instance *child;
+    if (!readInstance(inst, child))
+      return false;
+  }
+  return !truncated_;
+}
+
+// Liberty instances are made in batches with makeLeafInstances.
+bool
+NetlistDbReader::readLibertyInsts(Instance *parent)
+{
+  uint32_t inst_count = readValue<uint32_t>();
+  if (truncated_)
+    return false;
+  LeafInstanceDefSeq defs;
+  std::vector<size_t> net_offsets;
+  std::vector<Net*> nets;
+  std::vector<uint32_t> bit_nets;
+  // Instance index in the batch, key, value.
+  std::vector<std::tuple<size_t, const char*, const char*>> attributes;
+  for (size_t begin = 0; begin < inst_count;
+       begin += netlist_db_liberty_batch_size) {
+    size_t end = std::min(begin + netlist_db_liberty_batch_size,
+                          static_cast<size_t>(inst_count));
+    defs.clear();
+    net_offsets.clear();
+    nets.clear();
+    attributes.clear();
+    for (size_t i = begin; i < end; i++) {
+      const char *name = readString();
+      uint32_t cell_index = readValue<uint32_t>();
+      if (name == nullptr
+          || cell_index >= cells_.size()
+          || cells_[cell_index].liberty_cell_ == nullptr)
+        return false;
+      NetlistDbCell &db_cell = cells_[cell_index];
+      uint32_t attribute_count = readValue<uint32_t>();
+      for (uint32_t j = 0; j < attribute_count && !truncated_; j++) {
+        const char *key = readString();
+        const char *value = readString();
+        if (key == nullptr
+            || value == nullptr)
+          return false;
+        attributes.emplace_back(i - begin, key, value);
+      }
+      size_t offset = nets.size();
+      nets.resize(offset + db_cell.liberty_cell_->portBitCount(), nullptr);
+      size_t bit_count = db_cell.bit_pin_indices_.size();
+      bit_nets.resize(bit_count);
+      if (!readBytes(bit_nets.data(), bit_count * sizeof(uint32_t)))
+        return false;
+      for (size_t bit = 0; bit < bit_count; bit++) {
+        uint32_t net_index = bit_nets[bit];
+        if (net_index >= nets_.size())
+          return false;
+        nets[offset + db_cell.bit_pin_indices_[bit]] = nets_[net_index];
+      }
+      net_offsets.push_back(offset);
+      defs.emplace_back(db_cell.liberty_cell_, name, nullptr);
+    }
+    // The nets are complete so their addresses are stable.
+    for (size_t i = 0; i < defs.size(); i++)
+      defs[i].nets_ = &nets[net_offsets[i]];
+    network_->makeLeafInstances(defs, parent, dispatch_queue_);
+    for (auto &attribute : attributes)
+      network_->setAttribute(defs[std::get<0>(attribute)].inst_,
+                             std::get<1>(attribute),
+                             std::get<2>(attribute));
+  }
+  return true;
+}
+
+bool
+NetlistDbReader::readCellAttributes(Cell *cell)
+{
+  uint32_t count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < count && !truncated_; i++) {
+    const char *key = readString();
+    const char *value = readString();
+    if (key == nullptr
+        || value == nullptr)
+      return false;
+    network_->setAttribute(cell, key, value);
+  }
+  return !truncated_;
+}
+
+bool
+NetlistDbReader::readInstAttributes(Instance *inst)
+{
+  uint32_t count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < count && !truncated_; i++) {
+    const char *key = readString();
+    const char *value = readString();
+    if (key == nullptr
+        || value == nullptr)
+      return false;
+    network_->setAttribute(inst, key, value);
+  }
+  return !truncated_;
+}
+
+bool
+NetlistDbReader::readConstants()
+{
+  uint32_t count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < count && !truncated_; i++) {
+    uint32_t net_index = readValue<uint32_t>();
+    uint8_t value = readValue<uint8_t>();
+    if (net_index == 0
+        || net_index >= nets_.size()
+        || value > static_cast<uint8_t>(LogicValue::one))
+      return false;
+    network_->addConstantNet(nets_[net_index], static_cast<LogicValue>(value));
+  }
+  return !truncated_;
+}
+
+// Return a pointer to the null terminated string in the file data.
+const char *
+NetlistDbReader::readString()
+{
+  uint32_t length = readValue<uint32_t>();
+  if (truncated_
+      || length >= data_.size() - pos_
+      || data_[pos_ + length] != '\0') {
+    truncated_ = true;
+    return nullptr;
+  }
+  const char *str = data_.data() + pos_;
+  pos_ += length + 1;
+  return str;
+}
+
+template <class VALUE>
+VALUE
+NetlistDbReader::readValue()
+{
+  VALUE value{};
+  readBytes(&value, sizeof(VALUE));
+  return value;
+}
+
+bool
+NetlistDbReader::readBytes(void *bytes,
+                           size_t size)
+{
+  if (size > data_.size() - pos_) {
+    truncated_ = true;
+    pos_ = data_.size();
+    return false;
+  }
+  if (size > 0)
+    memcpy(bytes, data_.data() + pos_, size);
+  pos_ += size;
+  return true;
+}
+
+void
+NetlistDbReader::clear()
+{
+  // Release the file data.
+  std::vector<char>().swap(data_);
+  pos_ = 0;
+  header_end_ = 0;
+  truncated_ = false;
+  top_cell_name_ = nullptr;
+  cells_.clear();
+  std::vector<Net*>().swap(nets_);
+}
+
+} // namespace
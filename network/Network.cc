@@ -45,6 +45,11 @@ Network::clear()
   clearNetDrvrPinMap();
 }
 
+void
+Network::memoryStats(MemoryStats &) const
+{
+}
+
 bool
 Network::isLinked() const
 {
@@ -250,31 +255,48 @@ Network::hasMembers(const Port *port) const
 const char *
 Network::pathName(const Instance *instance) const
 {
-  InstanceSeq inst_path;
-  path(instance, inst_path);
+  // Size the name walking up the parents, then fill it in from the end
+  // walking up again so no instance path is built.
   size_t name_length = 0;
-  InstanceSeq::Iterator path_iter1(inst_path);
-  while (path_iter1.hasNext()) {
-    const Instance *inst = path_iter1.next();
+  for (const Instance *inst = instance;
+       !isTopInstance(inst);
+       inst = parent(inst))
     name_length += strlen(name(inst)) + 1;
-  }
-  char *path_name = makeTmpString(name_length);
-  char *path_ptr = path_name;
-  // Top instance has null string name, so terminate the string here.
-  *path_name = '\0';
-  while (inst_path.size()) {
-    const Instance *inst = inst_path.back();
-    const char *inst_name = name(inst);
-    strcpy(path_ptr, inst_name);
-    path_ptr += strlen(inst_name);
-    inst_path.pop_back();
-    if (inst_path.size())
-      *path_ptr++ = pathDivider();
+  // Top instance has null string name.
+  char *path_name = makeTmpString(name_length + 1);
+  if (name_length == 0)
+    *path_name = '\0';
+  else {
+    char *path_ptr = path_name + name_length - 1;
     *path_ptr = '\0';
+    for (const Instance *inst = instance;
+         !isTopInstance(inst);
+         inst = parent(inst)) {
+      const char *inst_name = name(inst);
+      size_t inst_name_length = strlen(inst_name);
+      path_ptr -= inst_name_length;
+      memcpy(path_ptr, inst_name, inst_name_length);
+      if (path_ptr != path_name)
+        *--path_ptr = pathDivider();
+    }
   }
   return path_name;
 }
 
+void
+Network::appendPathName(const Instance *instance,
+                        string &path_name) const
+{
+  if (!isTopInstance(instance)) {
+    const Instance *parent = this->parent(instance);
+    if (!isTopInstance(parent)) {
+      appendPathName(parent, path_name);
+      path_name += pathDivider();
+    }
+    path_name += name(instance);
+  }
+}
+
 bool
 Network::pathNameLess(const Instance *inst1,
 		      const Instance *inst2) const
@@ -386,6 +408,18 @@ Network::pathName(const Pin *pin) const
     return portName(pin);
 }
 
+void
+Network::appendPathName(const Pin *pin,
+                        string &path_name) const
+{
+  const Instance *inst = instance(pin);
+  if (inst && inst != topInstance()) {
+    appendPathName(inst, path_name);
+    path_name += pathDivider();
+  }
+  path_name += portName(pin);
+}
+
 bool
 Network::pathNameLess(const Pin *pin1,
 		      const Pin *pin2) const
@@ -474,6 +508,18 @@ Network::pathName(const Net *net) const
     return name(net);
 }
 
+void
+Network::appendPathName(const Net *net,
+                        string &path_name) const
+{
+  const Instance *inst = instance(net);
+  if (inst && inst != topInstance()) {
+    appendPathName(inst, path_name);
+    path_name += pathDivider();
+  }
+  path_name += name(net);
+}
+
 bool
 Network::pathNameLess(const Net *net1,
 		      const Net *net2) const
@@ -1703,6 +1749,35 @@ NetworkEdit::connectPin(Pin *pin,
 
 ////////////////////////////////////////////////////////////////
 
+LeafInstanceDef::LeafInstanceDef(LibertyCell *cell,
+                                 const char *name,
+                                 Net **nets) :
+  cell_(cell),
+  name_(name),
+  nets_(nets),
+  inst_(nullptr)
+{
+}
+
+void
+NetworkReader::makeLeafInstances(LeafInstanceDefSeq &defs,
+                                 Instance *parent,
+                                 DispatchQueue *)
+{
+  for (LeafInstanceDef &def : defs) {
+    Instance *inst = makeInstance(def.cell_, def.name_, parent);
+    LibertyCellPortBitIterator port_iter(def.cell_);
+    while (port_iter.hasNext()) {
+      LibertyPort *port = port_iter.next();
+      makePin(inst, reinterpret_cast<Port*>(port),
+              def.nets_[port->pinIndex()]);
+    }
+    def.inst_ = inst;
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
 NetworkConstantPinIterator::
 NetworkConstantPinIterator(const Network *network,
 			   NetSet &zero_nets,
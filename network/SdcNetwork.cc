@@ -640,6 +640,30 @@ SdcNetwork::staToSdc(const char *sta_name) const
   return sdc_name;
 }
 
+void
+SdcNetwork::staToSdc(string &path_name,
+                     size_t start) const
+{
+  char escape = pathEscape();
+  size_t d = start;
+  for (size_t s = start; s < path_name.size(); s++) {
+    char ch = path_name[s];
+    if (ch == escape) {
+      // Escaped escape.
+      if (s + 1 < path_name.size()
+          && path_name[s + 1] == escape) {
+        path_name[d++] = ch;
+        path_name[d++] = ch;
+        s++;
+      }
+    }
+    else
+      // Non escape.
+      path_name[d++] = ch;
+  }
+  path_name.resize(d);
+}
+
 Port *
 SdcNetwork::findPort(const Cell *cell,
 		     const char *name) const
@@ -722,12 +746,30 @@ SdcNetwork::pathName(const Instance *instance) const
   return staToSdc(network_->pathName(instance));
 }
 
+void
+SdcNetwork::appendPathName(const Instance *instance,
+                           string &path_name) const
+{
+  size_t start = path_name.size();
+  network_->appendPathName(instance, path_name);
+  staToSdc(path_name, start);
+}
+
 const char *
 SdcNetwork::pathName(const Pin *pin) const
 {
   return staToSdc(network_->pathName(pin));
 }
 
+void
+SdcNetwork::appendPathName(const Pin *pin,
+                           string &path_name) const
+{
+  size_t start = path_name.size();
+  network_->appendPathName(pin, path_name);
+  staToSdc(path_name, start);
+}
+
 const char *
 SdcNetwork::portName(const Pin *pin) const
 {
@@ -746,6 +788,15 @@ SdcNetwork::pathName(const Net *net) const
   return staToSdc(network_->pathName(net));
 }
 
+void
+SdcNetwork::appendPathName(const Net *net,
+                           string &path_name) const
+{
+  size_t start = path_name.size();
+  network_->appendPathName(net, path_name);
+  staToSdc(path_name, start);
+}
+
 ////////////////////////////////////////////////////////////////
 
 Instance *
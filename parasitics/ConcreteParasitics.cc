@@ -32,6 +32,7 @@
 #include "MakeConcreteParasitics.hh"
 #include "ConcreteParasiticsPvt.hh"
 #include "Corner.hh"
+#include "MemoryStats.hh"
 
 // Multiple inheritance is used to share elmore and pi model base
 // classes, but care is taken to make sure there are no loops in the
@@ -235,6 +236,14 @@ ConcretePiElmore::setElmore(const Pin *load_pin,
   loads_[load_pin] = elmore;
 }
 
+size_t
+ConcretePiElmore::memoryBytes() const
+{
+  return sizeof(*this)
+    + loads_.size() * (MemoryStats::tree_node_bytes
+                       + sizeof(ConcreteElmoreLoadMap::value_type));
+}
+
 void
 ConcretePiElmore::deleteLoad(const Pin *load_pin)
 {
@@ -274,6 +283,17 @@ ConcretePoleResidue::poleResidueCount() const
   return poles_->size();
 }
 
+size_t
+ConcretePoleResidue::memoryBytes() const
+{
+  size_t bytes = sizeof(*this);
+  if (poles_)
+    bytes += sizeof(*poles_) + poles_->capacity() * sizeof(ComplexFloat);
+  if (residues_)
+    bytes += sizeof(*residues_) + residues_->capacity() * sizeof(ComplexFloat);
+  return bytes;
+}
+
 void
 ConcretePoleResidue::poleResidue(int index,
 				 ComplexFloat &pole,
@@ -360,6 +380,17 @@ ConcretePiPoleResidue::setPoleResidue(const Pin *load_pin,
   pole_residue.setPoleResidue(poles, residues);
 }
 
+size_t
+ConcretePiPoleResidue::memoryBytes() const
+{
+  size_t bytes = sizeof(*this);
+  for (const auto &load_pole_residue : load_pole_residue_)
+    // The map value holds the pole residue object itself.
+    bytes += MemoryStats::tree_node_bytes + sizeof(const Pin*)
+      + load_pole_residue.second.memoryBytes();
+  return bytes;
+}
+
 void
 ConcretePiPoleResidue::deleteLoad(const Pin *load_pin)
 {
@@ -395,6 +426,7 @@ ConcreteParasiticNode::ConcreteParasiticNode(const Pin *pin,
                                              bool is_external) :
   is_net_(false),
   is_external_(is_external),
+  id_(0),
   cap_(0.0)
 {
   net_pin_.pin_ = pin;
@@ -490,8 +522,8 @@ ConcreteParasiticNetwork::ConcreteParasiticNetwork(const Net *net,
                                                    bool includes_pin_caps,
                                                    const Network *network) :
   net_(net),
-  sub_nodes_(network),
-  pin_nodes_(network),
+  sub_nodes_(0, NetIdPairHash(network)),
+  pin_nodes_(0, PinIdHash(network)),
   max_node_id_(0),
   includes_pin_caps_(includes_pin_caps)
 {
@@ -499,86 +531,111 @@ ConcreteParasiticNetwork::ConcreteParasiticNetwork(const Net *net,
 
 ConcreteParasiticNetwork::~ConcreteParasiticNetwork()
 {
-  deleteDevices();
-  deleteNodes();
 }
 
 void
-ConcreteParasiticNetwork::deleteNodes()
+ConcreteParasiticNetwork::makeResistor(size_t id,
+                                       float value,
+                                       ConcreteParasiticNode *node1,
+                                       ConcreteParasiticNode *node2)
 {
-  for (auto id_node : sub_nodes_) {
-    ConcreteParasiticNode *node = id_node.second;
-    delete node;
-  }
-  for (auto pin_node : pin_nodes_) {
-    ConcreteParasiticNode *node = pin_node.second;
-    delete node;
-  }
+  resistors_.make(id, value, node1, node2);
 }
 
 void
-ConcreteParasiticNetwork::deleteDevices()
+ConcreteParasiticNetwork::makeCapacitor(size_t id,
+                                        float value,
+                                        ConcreteParasiticNode *node1,
+                                        ConcreteParasiticNode *node2)
 {
-  for (ParasiticResistor *resistor : resistors_) {
-    ConcreteParasiticResistor *cresistor =
-      reinterpret_cast<ConcreteParasiticResistor*>(resistor);
-    delete cresistor;
-  }
-  for (ParasiticCapacitor *capacitor : capacitors_) {
-    ConcreteParasiticCapacitor *ccapacitor =
-      reinterpret_cast<ConcreteParasiticCapacitor*>(capacitor);
-    delete ccapacitor;
-  }
+  capacitors_.make(id, value, node1, node2);
 }
 
-void
-ConcreteParasiticNetwork::addResistor(ParasiticResistor *resistor)
+ParasiticResistorSeq
+ConcreteParasiticNetwork::resistors() const
 {
-  resistors_.push_back(resistor);
+  ParasiticResistorSeq resistors;
+  resistors.reserve(resistors_.size());
+  resistors_.forEach([&] (ConcreteParasiticResistor *resistor) {
+    resistors.push_back(resistor);
+  });
+  return resistors;
 }
 
-void
-ConcreteParasiticNetwork::addCapacitor(ParasiticCapacitor *capacitor)
+ParasiticCapacitorSeq
+ConcreteParasiticNetwork::capacitors() const
 {
-  capacitors_.push_back(capacitor);
+  ParasiticCapacitorSeq capacitors;
+  capacitors.reserve(capacitors_.size());
+  capacitors_.forEach([&] (ConcreteParasiticCapacitor *capacitor) {
+    capacitors.push_back(capacitor);
+  });
+  return capacitors;
 }
 
 ParasiticNodeSeq
-ConcreteParasiticNetwork::nodes() const
-{
+ConcreteParasiticNetwork::nodes(const Network *network) const
+{
+  // The maps are hashed so sort the nodes to keep the order
+  // independent of the hash table layout.
+  typedef std::pair<const Pin*, ParasiticArenaIndex> PinNode;
+  std::vector<PinNode> pin_nodes(pin_nodes_.begin(), pin_nodes_.end());
+  PinIdLess pin_less(network);
+  std::sort(pin_nodes.begin(), pin_nodes.end(),
+            [&] (const PinNode &pin_node1,
+                 const PinNode &pin_node2) {
+              return pin_less(pin_node1.first, pin_node2.first);
+            });
+  typedef std::pair<NetIdPair, ParasiticArenaIndex> IdNode;
+  std::vector<IdNode> sub_nodes(sub_nodes_.begin(), sub_nodes_.end());
+  NetIdPairLess net_id_less(network);
+  std::sort(sub_nodes.begin(), sub_nodes.end(),
+            [&] (const IdNode &id_node1,
+                 const IdNode &id_node2) {
+              return net_id_less(id_node1.first, id_node2.first);
+            });
+
   ParasiticNodeSeq nodes;
-  for (auto pin_node : pin_nodes_) {
-    ParasiticNode *node = pin_node.second;
-    nodes.push_back(node);
-  }
-  for (auto id_node : sub_nodes_) {
-    ParasiticNode *node = id_node.second;
-    nodes.push_back(node);
-  }
+  nodes.reserve(pin_nodes.size() + sub_nodes.size());
+  for (auto pin_node : pin_nodes)
+    nodes.push_back(nodes_.find(pin_node.second));
+  for (auto id_node : sub_nodes)
+    nodes.push_back(nodes_.find(id_node.second));
   return nodes;
 }
 
+size_t
+ConcreteParasiticNetwork::memoryBytes() const
+{
+  return sizeof(*this)
+    + nodes_.bytes()
+    + resistors_.bytes()
+    + capacitors_.bytes()
+    + sub_nodes_.size() * (MemoryStats::hash_node_bytes
+                           + sizeof(ConcreteParasiticSubNodeMap::value_type))
+    + pin_nodes_.size() * (MemoryStats::hash_node_bytes
+                           + sizeof(ConcreteParasiticPinNodeMap::value_type));
+}
+
 float
 ConcreteParasiticNetwork::capacitance() const
 {
   float cap = 0.0;
   for (auto id_node : sub_nodes_) {
-    ConcreteParasiticNode *node = id_node.second;
+    ConcreteParasiticNode *node = nodes_.find(id_node.second);
     if (!node->isExternal())
       cap += node->capacitance();
   }
 
   for (auto pin_node : pin_nodes_) {
-    ConcreteParasiticNode *node = pin_node.second;
+    ConcreteParasiticNode *node = nodes_.find(pin_node.second);
     if (!node->isExternal())
       cap += node->capacitance();
   }
 
-  for (ParasiticCapacitor *capacitor : capacitors_) {
-    ConcreteParasiticCapacitor *ccap =
-      static_cast<ConcreteParasiticCapacitor*>(capacitor);
-    cap += ccap->value();
-  }
+  capacitors_.forEach([&] (ConcreteParasiticCapacitor *capacitor) {
+    cap += capacitor->value();
+  });
 
   return cap;
 }
@@ -593,7 +650,7 @@ ConcreteParasiticNetwork::findParasiticNode(const Net *net,
   if (id_node == sub_nodes_.end()) 
     return nullptr;
   else
-    return id_node->second;
+    return nodes_.find(id_node->second);
 }
 
 ConcreteParasiticNode *
@@ -603,7 +660,7 @@ ConcreteParasiticNetwork::findParasiticNode(const Pin *pin) const
   if (pin_node == pin_nodes_.end())
     return nullptr;
   else
-    return pin_node->second;
+    return nodes_.find(pin_node->second);
 }
 
 ConcreteParasiticNode *
@@ -615,12 +672,12 @@ ConcreteParasiticNetwork::ensureParasiticNode(const Net *net,
   NetIdPair net_id(net, id);
   auto id_node = sub_nodes_.find(net_id);
   if (id_node == sub_nodes_.end()) {
-    node = new ConcreteParasiticNode(net, id, net != net_);
-    sub_nodes_[net_id] = node;
+    sub_nodes_[net_id] = nodes_.size();
+    node = nodes_.make(net, id, net != net_);
     max_node_id_ = max((int) max_node_id_, id);
   }
   else
-    node = id_node->second;
+    node = nodes_.find(id_node->second);
   return node;
 }
 
@@ -641,11 +698,11 @@ ConcreteParasiticNetwork::ensureParasiticNode(const Pin *pin,
     }
     else if (net)
       net = network->highestNetAbove(net);
-    node = new ConcreteParasiticNode(pin, net != net_);
-    pin_nodes_[pin] = node;
+    pin_nodes_[pin] = nodes_.size();
+    node = nodes_.make(pin, net != net_);
   }
   else
-    node = pin_node->second;
+    node = nodes_.find(pin_node->second);
   return node;
 }
 
@@ -708,24 +765,20 @@ ConcreteParasiticNetwork::disconnectPin(const Pin *pin,
 {
   auto pin_node = pin_nodes_.find(pin);
   if (pin_node != pin_nodes_.end()) {
-    ConcreteParasiticNode *node = pin_node->second;
+    ConcreteParasiticNode *node = nodes_.find(pin_node->second);
     // Make a subnode to replace the pin node.
     ConcreteParasiticNode *subnode = ensureParasiticNode(net,max_node_id_+1,
                                                          network);
     // Hand over the devices.
-    for (ParasiticResistor *resistor : resistors_) {
-      ConcreteParasiticResistor *cresistor =
-        reinterpret_cast<ConcreteParasiticResistor*>(resistor);
-      cresistor->replaceNode(node, subnode);
-    }
-    for (ParasiticCapacitor *capacitor : capacitors_) {
-      ConcreteParasiticCapacitor *ccapacitor =
-        reinterpret_cast<ConcreteParasiticCapacitor*>(capacitor);
-      ccapacitor->replaceNode(node, subnode);
-    }
-
+    resistors_.forEach([&] (ConcreteParasiticResistor *resistor) {
+      resistor->replaceNode(node, subnode);
+    });
+    capacitors_.forEach([&] (ConcreteParasiticCapacitor *capacitor) {
+      capacitor->replaceNode(node, subnode);
+    });
+
+    // The pin node stays in the arena until the network is deleted.
     pin_nodes_.erase(pin);
-    delete node;
   }
 }
 
@@ -747,6 +800,17 @@ NetIdPairLess::operator()(const NetIdPair &net_id1,
 	&& id1 < id2);
 }
 
+NetIdPairHash::NetIdPairHash(const Network *network) :
+  network_(network)
+{
+}
+
+size_t
+NetIdPairHash::operator()(const NetIdPair &net_id) const
+{
+  return hashSum(network_->id(net_id.first), net_id.second);
+}
+
 ////////////////////////////////////////////////////////////////
 
 Parasitics *
@@ -790,32 +854,71 @@ ConcreteParasitics::deleteParasitics()
 {
   int ap_count = corners_->parasiticAnalysisPtCount();
   int ap_rf_count = ap_count * RiseFall::index_count;
-  for (auto drvr_parasitics : drvr_parasitic_map_) {
-    ConcreteParasitic **parasitics = drvr_parasitics.second;
-    if (parasitics) {
-      for (int i = 0; i < ap_rf_count; i++)
-	delete parasitics[i];
-      delete [] parasitics;
-    }
-  }
+  drvr_parasitic_map_.visit([=] (ObjectId,
+                                  ConcreteParasiticSlot *parasitics) {
+    for (int i = 0; i < ap_rf_count; i++)
+      delete parasitics[i];
+    delete [] parasitics;
+  });
   drvr_parasitic_map_.clear();
 
-  for (auto net_parasitics : parasitic_network_map_) {
-    ConcreteParasiticNetwork **parasitics = net_parasitics.second;
-    if (parasitics) {
-      for (int i = 0; i < ap_count; i++)
-	delete parasitics[i];
-      delete [] parasitics;
-    }
-  }
+  parasitic_network_map_.visit([=] (ObjectId,
+                                    ConcreteParasiticNetwork **parasitics) {
+    for (int i = 0; i < ap_count; i++)
+      delete parasitics[i];
+    delete [] parasitics;
+  });
   parasitic_network_map_.clear();
 }
 
+void
+ConcreteParasitics::memoryStats(MemoryStats &stats) const
+{
+  int ap_count = corners_->parasiticAnalysisPtCount();
+  int ap_rf_count = ap_count * RiseFall::index_count;
+  size_t network_count = 0;
+  size_t network_bytes = parasitic_network_map_.bytes();
+  size_t node_count = 0;
+  size_t device_count = 0;
+  parasitic_network_map_.visit([&] (ObjectId,
+                                    ConcreteParasiticNetwork **parasitics) {
+    network_bytes += ap_count * sizeof(ConcreteParasiticNetwork*);
+    for (int i = 0; i < ap_count; i++) {
+      ConcreteParasiticNetwork *parasitic = parasitics[i];
+      if (parasitic) {
+        network_count++;
+        node_count += parasitic->nodeCount();
+        device_count += parasitic->deviceCount();
+        network_bytes += parasitic->memoryBytes();
+      }
+    }
+  });
+  stats.add("parasitics", "networks", network_count, network_bytes);
+  stats.add("parasitics", "network nodes", node_count, 0);
+  stats.add("parasitics", "network devices", device_count, 0);
+
+  size_t reduced_count = 0;
+  size_t reduced_bytes = drvr_parasitic_map_.bytes();
+  drvr_parasitic_map_.visit([&] (ObjectId,
+                                 ConcreteParasiticSlot *parasitics) {
+    reduced_bytes += ap_rf_count * sizeof(ConcreteParasiticSlot);
+    for (int i = 0; i < ap_rf_count; i++) {
+      ConcreteParasitic *parasitic = parasitics[i];
+      if (parasitic) {
+        reduced_count++;
+        reduced_bytes += parasitic->memoryBytes();
+      }
+    }
+  });
+  stats.add("parasitics", "reduced", reduced_count, reduced_bytes);
+}
+
 void
 ConcreteParasitics::deleteParasitics(const Pin *drvr_pin,
 				     const ParasiticAnalysisPt *ap)
 {
-  ConcreteParasitic **parasitics = drvr_parasitic_map_[drvr_pin];
+  ConcreteParasiticSlot *parasitics =
+    drvr_parasitic_map_.findKey(network_->id(drvr_pin));
   if (parasitics) {
     for (auto tr : RiseFall::range()) {
       int ap_rf_index = parasiticAnalysisPtIndex(ap, tr);
@@ -833,7 +936,8 @@ ConcreteParasitics::deleteParasitics(const Net *net,
   for (auto drvr_pin : *drivers)
     deleteParasitics(drvr_pin, ap);
 
-  ConcreteParasiticNetwork **parasitics = parasitic_network_map_[net];
+  ConcreteParasiticNetwork **parasitics =
+    parasitic_network_map_.findKey(network_->id(net));
   if (parasitics) {
     delete parasitics[ap->index()];
     parasitics[ap->index()] = nullptr;
@@ -871,7 +975,8 @@ ConcreteParasitics::disconnectPinBefore(const Pin *pin,
 
     const Net *net = findParasiticNet(pin);
     if (net) {
-      ConcreteParasiticNetwork **parasitics = parasitic_network_map_[net];
+      ConcreteParasiticNetwork **parasitics =
+        parasitic_network_map_.findKey(network_->id(net));
       if (parasitics) {
         int ap_count = corners_->parasiticAnalysisPtCount();
 	for (int i = 0; i < ap_count; i++) {
@@ -921,15 +1026,16 @@ void
 ConcreteParasitics::deleteDrvrReducedParasitics(const Pin *drvr_pin)
 {
   UniqueLock lock(lock_);
-  ConcreteParasitic **parasitics = drvr_parasitic_map_[drvr_pin];
+  ObjectId drvr_id = network_->id(drvr_pin);
+  ConcreteParasiticSlot *parasitics = drvr_parasitic_map_.findKey(drvr_id);
   if (parasitics) {
+    drvr_parasitic_map_.erase(drvr_id);
     int ap_count = corners_->parasiticAnalysisPtCount();
     int ap_rf_count = ap_count * RiseFall::index_count;
     for (int i = 0; i < ap_rf_count; i++)
       delete parasitics[i];
     delete [] parasitics;
   }
-  drvr_parasitic_map_[drvr_pin] = nullptr;
 }
 
 void
@@ -937,7 +1043,8 @@ ConcreteParasitics::deleteDrvrReducedParasitics(const Pin *drvr_pin,
                                                 const ParasiticAnalysisPt *ap)
 {
   UniqueLock lock(lock_);
-  ConcreteParasitic **parasitics = drvr_parasitic_map_[drvr_pin];
+  ConcreteParasiticSlot *parasitics =
+    drvr_parasitic_map_.findKey(network_->id(drvr_pin));
   if (parasitics) {
     int ap_index = ap->index();
     delete parasitics[ap_index];
@@ -961,8 +1068,8 @@ ConcreteParasitics::findPiElmore(const Pin *drvr_pin,
 {
   if (!drvr_parasitic_map_.empty()) {
     int ap_rf_index = parasiticAnalysisPtIndex(ap, rf);
-    UniqueLock lock(lock_);
-    ConcreteParasitic **parasitics = drvr_parasitic_map_.findKey(drvr_pin);
+    ConcreteParasiticSlot *parasitics =
+      drvr_parasitic_map_.findKey(network_->id(drvr_pin));
     if (parasitics) {
       ConcreteParasitic *parasitic = parasitics[ap_rf_index];
       if (parasitic && parasitic->isPiElmore())
@@ -972,6 +1079,23 @@ ConcreteParasitics::findPiElmore(const Pin *drvr_pin,
   return nullptr;
 }
 
+// Caller holds lock_.
+ConcreteParasiticSlot *
+ConcreteParasitics::ensureDrvrParasitics(const Pin *drvr_pin)
+{
+  ObjectId drvr_id = network_->id(drvr_pin);
+  ConcreteParasiticSlot *parasitics = drvr_parasitic_map_.findKey(drvr_id);
+  if (parasitics == nullptr) {
+    int ap_count = corners_->parasiticAnalysisPtCount();
+    int ap_rf_count = ap_count * RiseFall::index_count;
+    parasitics = new ConcreteParasiticSlot[ap_rf_count];
+    for (int i = 0; i < ap_rf_count; i++)
+      parasitics[i].store(nullptr, std::memory_order_relaxed);
+    drvr_parasitic_map_.insert(drvr_id, parasitics);
+  }
+  return parasitics;
+}
+
 Parasitic *
 ConcreteParasitics::makePiElmore(const Pin *drvr_pin,
 				 const RiseFall *rf,
@@ -981,15 +1105,7 @@ ConcreteParasitics::makePiElmore(const Pin *drvr_pin,
 				 float c1)
 {
   UniqueLock lock(lock_);
-  ConcreteParasitic **parasitics = drvr_parasitic_map_.findKey(drvr_pin);
-  if (parasitics == nullptr) {
-    int ap_count = corners_->parasiticAnalysisPtCount();
-    int ap_rf_count = ap_count * RiseFall::index_count;
-    parasitics = new ConcreteParasitic*[ap_rf_count];
-    for (int i = 0; i < ap_rf_count; i++)
-      parasitics[i] = nullptr;
-    drvr_parasitic_map_[drvr_pin] = parasitics;
-  }
+  ConcreteParasiticSlot *parasitics = ensureDrvrParasitics(drvr_pin);
   int ap_rf_index = parasiticAnalysisPtIndex(ap, rf);
   ConcreteParasitic *parasitic = parasitics[ap_rf_index];
   ConcretePiElmore *pi_elmore = nullptr;
@@ -1077,8 +1193,8 @@ ConcreteParasitics::findPiPoleResidue(const Pin *drvr_pin,
 {
   if (!drvr_parasitic_map_.empty()) {
     int ap_rf_index = parasiticAnalysisPtIndex(ap, rf);
-    UniqueLock lock(lock_);
-    ConcreteParasitic **parasitics = drvr_parasitic_map_.findKey(drvr_pin);
+    ConcreteParasiticSlot *parasitics =
+      drvr_parasitic_map_.findKey(network_->id(drvr_pin));
     if (parasitics) {
       ConcreteParasitic *parasitic = parasitics[ap_rf_index];
       if (parasitic == nullptr && rf == RiseFall::fall()) {
@@ -1101,15 +1217,7 @@ ConcreteParasitics::makePiPoleResidue(const Pin *drvr_pin,
 				      float c1)
 {
   UniqueLock lock(lock_);
-  ConcreteParasitic **parasitics = drvr_parasitic_map_.findKey(drvr_pin);
-  if (parasitics == nullptr) {
-    int ap_count = corners_->parasiticAnalysisPtCount();
-    int ap_rf_count = ap_count * RiseFall::index_count;
-    parasitics = new ConcreteParasitic*[ap_rf_count];
-    for (int i = 0; i < ap_rf_count; i++)
-      parasitics[i] = nullptr;
-    drvr_parasitic_map_[drvr_pin] = parasitics;
-  }
+  ConcreteParasiticSlot *parasitics = ensureDrvrParasitics(drvr_pin);
   int ap_rf_index = parasiticAnalysisPtIndex(ap, rf);
   ConcreteParasitic *parasitic = parasitics[ap_rf_index];
   ConcretePiPoleResidue *pi_pole_residue = nullptr;
@@ -1194,15 +1302,13 @@ ConcreteParasitics::findParasiticNetwork(const Net *net,
 					 const ParasiticAnalysisPt *ap) const
 {
   if (!parasitic_network_map_.empty()) {
-    UniqueLock lock(lock_);
-    if (!parasitic_network_map_.empty()) {
-      ConcreteParasiticNetwork **parasitics=parasitic_network_map_.findKey(net);
-      if (parasitics) {
-        ConcreteParasiticNetwork *parasitic = parasitics[ap->index()];
-        if (parasitic == nullptr)
-          parasitic = parasitics[ap->indexMax()];
-	return parasitic;
-      }
+    ConcreteParasiticNetwork **parasitics =
+      parasitic_network_map_.findKey(network_->id(net));
+    if (parasitics) {
+      ConcreteParasiticNetwork *parasitic = parasitics[ap->index()];
+      if (parasitic == nullptr)
+        parasitic = parasitics[ap->indexMax()];
+      return parasitic;
     }
   }
   return nullptr;
@@ -1213,16 +1319,16 @@ ConcreteParasitics::findParasiticNetwork(const Pin *pin,
 					 const ParasiticAnalysisPt *ap) const
 {
   if (!parasitic_network_map_.empty()) {
-    UniqueLock lock(lock_);
-    if (!parasitic_network_map_.empty()) {
-      // Only call findParasiticNet if parasitics exist.
-      const Net *net = findParasiticNet(pin);
-      ConcreteParasiticNetwork **parasitics=parasitic_network_map_.findKey(net);
+    // Only call findParasiticNet if parasitics exist.
+    const Net *net = findParasiticNet(pin);
+    if (net) {
+      ConcreteParasiticNetwork **parasitics =
+        parasitic_network_map_.findKey(network_->id(net));
       if (parasitics) {
         ConcreteParasiticNetwork *parasitic = parasitics[ap->index()];
         if (parasitic == nullptr)
           parasitic = parasitics[ap->indexMax()];
-	return parasitic;
+        return parasitic;
       }
     }
   }
@@ -1235,13 +1341,14 @@ ConcreteParasitics::makeParasiticNetwork(const Net *net,
 					 const ParasiticAnalysisPt *ap)
 {
   UniqueLock lock(lock_);
-  ConcreteParasiticNetwork **parasitics = parasitic_network_map_.findKey(net);
+  ObjectId net_id = network_->id(net);
+  ConcreteParasiticNetwork **parasitics = parasitic_network_map_.findKey(net_id);
   if (parasitics == nullptr) {
     int ap_count = corners_->parasiticAnalysisPtCount();
     parasitics = new ConcreteParasiticNetwork*[ap_count];
     for (int i = 0; i < ap_count; i++)
       parasitics[i] = nullptr;
-    parasitic_network_map_[net] = parasitics;
+    parasitic_network_map_.insert(net_id, parasitics);
   }
   int ap_index = ap->index();
   ConcreteParasiticNetwork *parasitic = parasitics[ap_index];
@@ -1261,7 +1368,9 @@ ConcreteParasitics::deleteParasiticNetwork(const Net *net,
 {
   if (!parasitic_network_map_.empty()) {
     UniqueLock lock(lock_);
-    ConcreteParasiticNetwork **parasitics = parasitic_network_map_.findKey(net);
+    ObjectId net_id = network_->id(net);
+    ConcreteParasiticNetwork **parasitics =
+      parasitic_network_map_.findKey(net_id);
     if (parasitics) {
       int ap_index = ap->index();
       delete parasitics[ap_index];
@@ -1276,8 +1385,8 @@ ConcreteParasitics::deleteParasiticNetwork(const Net *net,
         }
       }
       if (!have_parasitics) {
+        parasitic_network_map_.erase(net_id);
         delete [] parasitics;
-        parasitic_network_map_.erase(net);
       }
     }
   }
@@ -1288,13 +1397,15 @@ ConcreteParasitics::deleteParasiticNetworks(const Net *net)
 {
   if (!parasitic_network_map_.empty()) {
     UniqueLock lock(lock_);
-    ConcreteParasiticNetwork **parasitics = parasitic_network_map_.findKey(net);
+    ObjectId net_id = network_->id(net);
+    ConcreteParasiticNetwork **parasitics =
+      parasitic_network_map_.findKey(net_id);
     if (parasitics) {
+      parasitic_network_map_.erase(net_id);
       int ap_count = corners_->parasiticAnalysisPtCount();
       for (int i = 0; i < ap_count; i++)
 	delete parasitics[i];
       delete [] parasitics;
-      parasitic_network_map_.erase(net);
     }
   }
 }
@@ -1365,11 +1476,9 @@ ConcreteParasitics::makeCapacitor(Parasitic *parasitic,
 {
   ConcreteParasiticNode *cnode1 = static_cast<ConcreteParasiticNode*>(node1);
   ConcreteParasiticNode *cnode2 = static_cast<ConcreteParasiticNode*>(node2);
-  ConcreteParasiticCapacitor *capacitor =
-    new ConcreteParasiticCapacitor(index, cap, cnode1, cnode2);
   ConcreteParasiticNetwork *cparasitic =
     static_cast<ConcreteParasiticNetwork*>(parasitic);
-  cparasitic->addCapacitor(capacitor);
+  cparasitic->makeCapacitor(index, cap, cnode1, cnode2);
 }
 
 void
@@ -1381,11 +1490,9 @@ ConcreteParasitics::makeResistor(Parasitic *parasitic,
 {
   ConcreteParasiticNode *cnode1 = static_cast<ConcreteParasiticNode*>(node1);
   ConcreteParasiticNode *cnode2 = static_cast<ConcreteParasiticNode*>(node2);
-  ParasiticResistor *resistor = new ConcreteParasiticResistor(index, res,
-                                                              cnode1, cnode2);
   ConcreteParasiticNetwork *cparasitic =
     static_cast<ConcreteParasiticNetwork*>(parasitic);
-  cparasitic->addResistor(resistor);
+  cparasitic->makeResistor(index, res, cnode1, cnode2);
 }
 
 ParasiticNodeSeq
@@ -1393,7 +1500,7 @@ ConcreteParasitics::nodes(const Parasitic *parasitic) const
 {
   const ConcreteParasiticNetwork *cparasitic =
     static_cast<const ConcreteParasiticNetwork*>(parasitic);
-  return cparasitic->nodes();
+  return cparasitic->nodes(network_);
 }
 
 ParasiticResistorSeq
@@ -1421,6 +1528,14 @@ ConcreteParasitics::name(const ParasiticNode *node) const
   return cnode->name(network_);
 }
 
+int
+ConcreteParasitics::id(const ParasiticNode *node) const
+{
+  const ConcreteParasiticNode *cnode =
+    static_cast<const ConcreteParasiticNode*>(node);
+  return cnode->id();
+}
+
 float
 ConcreteParasitics::nodeGndCap(const ParasiticNode *node) const
 {
@@ -16,10 +16,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
-#include "Map.hh"
 #include "Set.hh"
+#include "ConcurrentIdMap.hh"
 #include "MinMax.hh"
 #include "Parasitics.hh"
 
@@ -28,8 +29,13 @@ namespace sta {
 class ConcreteParasitic;
 class ConcreteParasiticNetwork;
 
-typedef Map<const Pin*, ConcreteParasitic**> ConcreteParasiticMap;
-typedef Map<const Net*, ConcreteParasiticNetwork**> ConcreteParasiticNetworkMap;
+// Reduced parasitics are published while other threads find them.
+typedef std::atomic<ConcreteParasitic*> ConcreteParasiticSlot;
+
+// Looked up for every driver by delay calculation, so they are
+// indexed by pin/net id and found without locking.
+typedef ConcurrentIdMap<ConcreteParasiticSlot*> ConcreteParasiticMap;
+typedef ConcurrentIdMap<ConcreteParasiticNetwork**> ConcreteParasiticNetworkMap;
 
 // This class acts as a BUILDER for parasitics.
 class ConcreteParasitics : public Parasitics
@@ -41,6 +47,7 @@ public:
   void clear() override;
 
   void deleteParasitics() override;
+  void memoryStats(MemoryStats &stats) const override;
   void deleteParasitics(const Net *net,
                         const ParasiticAnalysisPt *ap) override;
   void deleteParasitics(const Pin *drvr_pin,
@@ -130,6 +137,7 @@ public:
   void incrCap(ParasiticNode *node,
                float cap) override;
   const char *name(const ParasiticNode *node) const override;
+  int id(const ParasiticNode *node) const override;
   const Pin *pin(const ParasiticNode *node) const override;
   const Net *net(const ParasiticNode *node,
                  const Network *network) const override;
@@ -177,11 +185,15 @@ protected:
   void deleteDrvrReducedParasitics(const Pin *drvr_pin,
                                    const ParasiticAnalysisPt *ap);
 
-  // Driver pin to array of parasitics indexed by analysis pt index
+  ConcreteParasiticSlot *ensureDrvrParasitics(const Pin *drvr_pin);
+
+  // Driver pin id to array of parasitics indexed by analysis pt index
   // and transition.
   ConcreteParasiticMap drvr_parasitic_map_;
+  // Net id to array of parasitic networks indexed by analysis pt index.
   ConcreteParasiticNetworkMap parasitic_network_map_;
-  mutable std::mutex lock_;
+  // Serializes writers. Finds do not lock.
+  std::mutex lock_;
 
   friend class ConcretePiElmore;
   friend class ConcreteParasiticNode;
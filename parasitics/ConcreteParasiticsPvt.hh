@@ -16,8 +16,14 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <new>
 #include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Parasitics.hh"
 
@@ -26,6 +32,8 @@ namespace sta {
 class ConcretePoleResidue;
 class ConcreteParasiticDevice;
 class ConcreteParasiticNode;
+class ConcreteParasiticResistor;
+class ConcreteParasiticCapacitor;
 
 typedef std::pair<const Net*, int> NetIdPair;
 class NetIdPairLess
@@ -39,15 +47,62 @@ private:
   const NetIdLess net_less_;
 };
 
+class NetIdPairHash
+{
+public:
+  NetIdPairHash(const Network *network);
+  size_t operator()(const NetIdPair &net_id) const;
+
+private:
+  const Network *network_;
+};
+
+// Parasitic network objects are allocated from per network arenas and
+// referenced by 32 bit arena indices.
+typedef uint32_t ParasiticArenaIndex;
+
 typedef std::map<const Pin*, float> ConcreteElmoreLoadMap;
 typedef std::map<const Pin*, ConcretePoleResidue> ConcretePoleResidueMap;
-typedef std::map<NetIdPair,ConcreteParasiticNode*,
-                 NetIdPairLess> ConcreteParasiticSubNodeMap;
-typedef std::map<const Pin*, ConcreteParasiticNode*, PinIdLess> ConcreteParasiticPinNodeMap;
+typedef std::unordered_map<NetIdPair, ParasiticArenaIndex,
+                           NetIdPairHash> ConcreteParasiticSubNodeMap;
+typedef std::unordered_map<const Pin*, ParasiticArenaIndex,
+                           PinIdHash> ConcreteParasiticPinNodeMap;
 typedef std::set<ParasiticNode*> ParasiticNodeSet;
 typedef std::set<ParasiticResistor*> ParasiticResistorSet;
 typedef std::vector<ParasiticResistor*> ParasiticResistorSeq;
 
+// Contiguous storage for parasitic network nodes and devices.
+// Objects are allocated in blocks that double in size so small
+// networks stay small and objects never move, so pointers to them
+// remain valid. The blocks are freed together with the arena.
+template <class OBJ>
+class ConcreteParasiticArena
+{
+public:
+  ConcreteParasiticArena();
+  ~ConcreteParasiticArena();
+  template <class... ARGS>
+  OBJ *make(ARGS&&... args);
+  OBJ *find(ParasiticArenaIndex index) const;
+  ParasiticArenaIndex size() const { return size_; }
+  // Bytes of the allocated blocks.
+  size_t bytes() const { return blockStart(blocks_.size()) * sizeof(OBJ); }
+  template <class FUNC>
+  void forEach(FUNC func) const;
+
+  // Deleted operations
+  ConcreteParasiticArena(const ConcreteParasiticArena &arena) = delete;
+  ConcreteParasiticArena &operator=(const ConcreteParasiticArena &arena) = delete;
+
+private:
+  static ParasiticArenaIndex blockSize(size_t block);
+  static ParasiticArenaIndex blockStart(size_t block);
+
+  static constexpr ParasiticArenaIndex first_block_size_ = 4;
+  std::vector<OBJ*> blocks_;
+  ParasiticArenaIndex size_;
+};
+
 // Empty base class definitions so casts are not required on returned
 // objects.
 class Parasitic {};
@@ -86,6 +141,8 @@ public:
 			      ComplexFloatSeq *residues);
   virtual PinSet unannotatedLoads(const Pin *drvr_pin,
                                   const Parasitics *parasitics) const = 0;
+  // Bytes used by the parasitic for report_memory.
+  virtual size_t memoryBytes() const = 0;
 };
 
 // Pi model for a driver pin.
@@ -138,6 +195,7 @@ public:
                  float elmore) override;
   PinSet unannotatedLoads(const Pin *drvr_pin,
                           const Parasitics *parasitics) const override;
+  size_t memoryBytes() const override;
   void deleteLoad(const Pin *load_pin);
 
 private:
@@ -160,6 +218,7 @@ public:
                    ComplexFloat &pole,
                    ComplexFloat &residue) const;
   size_t poleResidueCount() const;
+  size_t memoryBytes() const override;
   using ConcreteParasitic::setPoleResidue;
 
 private:
@@ -192,6 +251,7 @@ public:
 			      ComplexFloatSeq *residues) override;
   virtual PinSet unannotatedLoads(const Pin *drvr_pin,
                                   const Parasitics *parasitics) const override;
+  size_t memoryBytes() const override;
   void deleteLoad(const Pin *load_pin);
 
 private:
@@ -219,16 +279,26 @@ public:
   ConcreteParasiticNode *ensureParasiticNode(const Pin *pin,
                                              const Network *network);
   virtual float capacitance() const;
-  ParasiticNodeSeq nodes() const;
+  // Pin nodes in pin id order followed by subnodes in net id/id order.
+  ParasiticNodeSeq nodes(const Network *network) const;
   void disconnectPin(const Pin *pin,
 		     const Net *net,
                      const Network *network);
-  ParasiticResistorSeq resistors() const { return resistors_; }
-  void addResistor(ParasiticResistor *resistor);
-  ParasiticCapacitorSeq capacitors() const { return capacitors_; }
-  void addCapacitor(ParasiticCapacitor *capacitor);
+  ParasiticResistorSeq resistors() const;
+  void makeResistor(size_t id,
+                    float value,
+                    ConcreteParasiticNode *node1,
+                    ConcreteParasiticNode *node2);
+  ParasiticCapacitorSeq capacitors() const;
+  void makeCapacitor(size_t id,
+                     float value,
+                     ConcreteParasiticNode *node1,
+                     ConcreteParasiticNode *node2);
   virtual PinSet unannotatedLoads(const Pin *drvr_pin,
                                   const Parasitics *parasitics) const;
+  size_t memoryBytes() const override;
+  size_t nodeCount() const { return nodes_.size(); }
+  size_t deviceCount() const { return resistors_.size() + capacitors_.size(); }
 
 private:
   void unannotatedLoads(ParasiticNode *node,
@@ -239,14 +309,14 @@ private:
                         ParasiticNodeResistorMap &resistor_map,
                         const Parasitics *parasitics) const;
 
-  void deleteNodes();
-  void deleteDevices();
-
   const Net *net_;
+  ConcreteParasiticArena<ConcreteParasiticNode> nodes_;
+  ConcreteParasiticArena<ConcreteParasiticResistor> resistors_;
+  ConcreteParasiticArena<ConcreteParasiticCapacitor> capacitors_;
+  // Map net/id and pin to node arena index.
+  // Nodes replaced by disconnectPin stay in the arena unreferenced.
   ConcreteParasiticSubNodeMap sub_nodes_;
   ConcreteParasiticPinNodeMap pin_nodes_;
-  ParasiticResistorSeq resistors_;
-  ParasiticCapacitorSeq capacitors_;
   unsigned max_node_id_:31;
   bool includes_pin_caps_:1;
 };
@@ -261,6 +331,7 @@ public:
                         bool is_external);
   float capacitance() const { return cap_; }
   const char *name(const Network *network) const;
+  int id() const { return id_; }
   const Net *net(const Network *network) const;
   bool isExternal() const { return is_external_; }
   const Pin *pin() const;
@@ -322,4 +393,79 @@ public:
                              ConcreteParasiticNode *node2);
 };
 
+////////////////////////////////////////////////////////////////
+
+template <class OBJ>
+ConcreteParasiticArena<OBJ>::ConcreteParasiticArena() :
+  size_(0)
+{
+  static_assert(std::is_trivially_destructible<OBJ>::value,
+                "arena objects are not destroyed");
+}
+
+template <class OBJ>
+ConcreteParasiticArena<OBJ>::~ConcreteParasiticArena()
+{
+  for (OBJ *block : blocks_)
+    ::operator delete(block);
+}
+
+template <class OBJ>
+ParasiticArenaIndex
+ConcreteParasiticArena<OBJ>::blockSize(size_t block)
+{
+  return first_block_size_ << block;
+}
+
+template <class OBJ>
+ParasiticArenaIndex
+ConcreteParasiticArena<OBJ>::blockStart(size_t block)
+{
+  return first_block_size_ * ((ParasiticArenaIndex(1) << block) - 1);
+}
+
+template <class OBJ>
+template <class... ARGS>
+OBJ *
+ConcreteParasiticArena<OBJ>::make(ARGS&&... args)
+{
+  size_t block = blocks_.size();
+  if (size_ == blockStart(block)) {
+    blocks_.push_back(static_cast<OBJ*>(::operator new(sizeof(OBJ)
+                                                       * blockSize(block))));
+    block++;
+  }
+  block--;
+  OBJ *obj = blocks_[block] + (size_ - blockStart(block));
+  new (obj) OBJ(std::forward<ARGS>(args)...);
+  size_++;
+  return obj;
+}
+
+template <class OBJ>
+OBJ *
+ConcreteParasiticArena<OBJ>::find(ParasiticArenaIndex index) const
+{
+  // Block b holds indices [blockStart(b), blockStart(b + 1)).
+  ParasiticArenaIndex n = index / first_block_size_ + 1;
+  size_t block = 0;
+  while (n >>= 1)
+    block++;
+  return blocks_[block] + (index - blockStart(block));
+}
+
+template <class OBJ>
+template <class FUNC>
+void
+ConcreteParasiticArena<OBJ>::forEach(FUNC func) const
+{
+  ParasiticArenaIndex index = 0;
+  for (size_t block = 0; block < blocks_.size(); block++) {
+    OBJ *objs = blocks_[block];
+    ParasiticArenaIndex block_size = blockSize(block);
+    for (ParasiticArenaIndex i = 0; i < block_size && index < size_; i++, index++)
+      func(&objs[i]);
+  }
+}
+
 } // namespace
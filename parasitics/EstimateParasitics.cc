@@ -16,6 +16,8 @@
 
 #include "EstimateParasitics.hh"
 
+#include <cmath>
+
 #include "Wireload.hh"
 #include "Liberty.hh"
 #include "Network.hh"
@@ -204,6 +206,108 @@ EstimateParasitics::estimatePiElmoreBalanced(const Pin *drvr_pin,
   }
 }
 
+////////////////////////////////////////////////////////////////
+
+WireRcEstimator::WireRcEstimator(float res_per_distance,
+                                 float cap_per_distance,
+                                 StaState *sta) :
+  StaState(sta),
+  res_per_distance_(res_per_distance),
+  cap_per_distance_(cap_per_distance)
+{
+}
+
+// Same admittance moment reduction as estimatePiElmoreBalanced with
+// the wire capacitance split between the ends of each load wire.
+bool
+WireRcEstimator::estimatePiElmore(const Pin *drvr_pin,
+                                  const RiseFall *rf,
+                                  const Corner *corner,
+                                  const MinMax *min_max,
+                                  float &c2,
+                                  float &rpi,
+                                  float &c1)
+{
+  double x, y;
+  bool exists;
+  network_->location(drvr_pin, x, y, exists);
+  if (!exists)
+    return false;
+  double y1 = sdc_->pinCapacitance(drvr_pin, rf, corner, min_max);
+  double y2 = 0.0;
+  double y3 = 0.0;
+  PinConnectedPinIterator *load_iter = network_->connectedPinIterator(drvr_pin);
+  while (load_iter->hasNext()) {
+    const Pin *load_pin = load_iter->next();
+    // Bidirects don't count themselves as loads.
+    if (load_pin != drvr_pin && network_->isLoad(load_pin)) {
+      double length = wireLength(drvr_pin, load_pin);
+      double wire_res = res_per_distance_ * length;
+      double wire_cap = cap_per_distance_ * length;
+      double cap = loadCap(load_pin, rf, corner, min_max) + wire_cap / 2.0;
+      double y2_ = wire_res * cap * cap;
+      y1 += wire_cap / 2.0 + cap;
+      y2 += -y2_;
+      y3 += y2_ * wire_res * cap;
+    }
+  }
+  delete load_iter;
+
+  if (y3 == 0.0) {
+    // No resistance, so load is capacitance only.
+    c2 = static_cast<float>(y1);
+    rpi = 0.0;
+    c1 = 0.0;
+  }
+  else {
+    c1 = static_cast<float>(y2 * y2 / y3);
+    c2 = static_cast<float>(y1 - y2 * y2 / y3);
+    rpi = static_cast<float>(-y3 * y3 / (y2 * y2 * y2));
+  }
+  return true;
+}
+
+float
+WireRcEstimator::loadElmore(const Pin *drvr_pin,
+                            const Pin *load_pin,
+                            const RiseFall *rf,
+                            const Corner *corner,
+                            const MinMax *min_max)
+{
+  double length = wireLength(drvr_pin, load_pin);
+  double wire_res = res_per_distance_ * length;
+  double wire_cap = cap_per_distance_ * length;
+  return static_cast<float>(wire_res * (wire_cap / 2.0
+                                        + loadCap(load_pin, rf, corner,
+                                                  min_max)));
+}
+
+double
+WireRcEstimator::wireLength(const Pin *drvr_pin,
+                            const Pin *load_pin) const
+{
+  double drvr_x, drvr_y, load_x, load_y;
+  bool drvr_exists, load_exists;
+  network_->location(drvr_pin, drvr_x, drvr_y, drvr_exists);
+  network_->location(load_pin, load_x, load_y, load_exists);
+  if (drvr_exists && load_exists)
+    return std::abs(drvr_x - load_x) + std::abs(drvr_y - load_y);
+  else
+    return 0.0;
+}
+
+double
+WireRcEstimator::loadCap(const Pin *load_pin,
+                         const RiseFall *rf,
+                         const Corner *corner,
+                         const MinMax *min_max) const
+{
+  if (network_->isTopLevelPort(load_pin))
+    return sdc_->portExtCap(network_->port(load_pin), rf, corner, min_max);
+  else
+    return sdc_->pinCapacitance(load_pin, rf, corner, min_max);
+}
+
 #if 0
 static void
 selectWireload(Network *network)
@@ -21,6 +21,7 @@
 #include "NetworkClass.hh"
 #include "SdcClass.hh"
 #include "ParasiticsClass.hh"
+#include "Parasitics.hh"
 
 namespace sta {
 
@@ -87,4 +88,42 @@ protected:
 				bool &elmore_use_load_cap);
 };
 
+// Estimate parasitics from pin locations with a wire resistance and
+// capacitance per distance. Each load is connected to the driver by a
+// wire the manhattan distance between them long (star topology) and
+// the star is reduced to a pi elmore model. Loads without locations
+// only add their pin capacitance.
+class WireRcEstimator : public ParasiticEstimator, public StaState
+{
+public:
+  WireRcEstimator(float res_per_distance,
+                  float cap_per_distance,
+                  StaState *sta);
+  bool estimatePiElmore(const Pin *drvr_pin,
+                        const RiseFall *rf,
+                        const Corner *corner,
+                        const MinMax *min_max,
+                        // Return values.
+                        float &c2,
+                        float &rpi,
+                        float &c1) override;
+  float loadElmore(const Pin *drvr_pin,
+                   const Pin *load_pin,
+                   const RiseFall *rf,
+                   const Corner *corner,
+                   const MinMax *min_max) override;
+
+protected:
+  // Manhattan distance between the pins, 0.0 without locations.
+  double wireLength(const Pin *drvr_pin,
+                    const Pin *load_pin) const;
+  double loadCap(const Pin *load_pin,
+                 const RiseFall *rf,
+                 const Corner *corner,
+                 const MinMax *min_max) const;
+
+  float res_per_distance_;
+  float cap_per_distance_;
+};
+
 } // namespace
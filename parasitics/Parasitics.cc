@@ -30,7 +30,18 @@
 namespace sta {
 
 Parasitics::Parasitics(StaState *sta) :
-  StaState(sta)
+  StaState(sta),
+  estimator_(nullptr)
+{
+}
+
+Parasitics::~Parasitics()
+{
+  delete estimator_;
+}
+
+void
+Parasitics::memoryStats(MemoryStats &) const
 {
 }
 
@@ -194,6 +205,40 @@ Parasitics::estimatePiElmore(const Pin *drvr_pin,
     return nullptr;
 }
 
+void
+Parasitics::setEstimator(ParasiticEstimator *estimator)
+{
+  delete estimator_;
+  estimator_ = estimator;
+}
+
+Parasitic *
+Parasitics::estimatePiElmore(const Pin *drvr_pin,
+                             const RiseFall *rf,
+                             const Corner *corner,
+                             const MinMax *min_max)
+{
+  float c2, rpi, c1;
+  if (estimator_
+      && estimator_->estimatePiElmore(drvr_pin, rf, corner, min_max,
+                                      c2, rpi, c1)
+      && (c1 > 0.0 || c2 > 0.0)) {
+    ParasiticAnalysisPt *ap = corner->findParasiticAnalysisPt(min_max);
+    Parasitic *parasitic = makePiElmore(drvr_pin, rf, ap, c2, rpi, c1);
+    NetConnectedPinIterator *pin_iter = network_->connectedPinIterator(drvr_pin);
+    while (pin_iter->hasNext()) {
+      const Pin *pin = pin_iter->next();
+      if (pin != drvr_pin && network_->isLoad(pin))
+        setElmore(parasitic, pin,
+                  estimator_->loadElmore(drvr_pin, pin, rf, corner, min_max));
+    }
+    delete pin_iter;
+    return parasitic;
+  }
+  else
+    return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////
 
 Parasitic *
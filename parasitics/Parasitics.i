@@ -39,12 +39,58 @@ read_spef_cmd(const char *filename,
 	      bool pin_cap_included,
 	      bool keep_coupling_caps,
 	      float coupling_cap_factor,
-	      bool reduce)
+	      bool reduce,
+              NetSet *keep_detailed_nets,
+              bool incremental)
 {
   cmdLinkedNetwork();
-  return Sta::sta()->readSpef(filename, instance, corner, min_max,
-			      pin_cap_included, keep_coupling_caps,
-                              coupling_cap_factor, reduce);
+  bool success = Sta::sta()->readSpef(filename, instance, corner, min_max,
+                                      pin_cap_included, keep_coupling_caps,
+                                      coupling_cap_factor, reduce,
+                                      keep_detailed_nets, incremental);
+  delete keep_detailed_nets;
+  return success;
+}
+
+void
+reduce_parasitics_cmd(const Corner *corner,
+                      const MinMaxAll *min_max)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->reduceParasitics(corner, min_max);
+}
+
+void
+set_wire_rc_estimate_cmd(float res_per_distance,
+                         float cap_per_distance)
+{
+  Sta::sta()->setWireRcEstimate(res_per_distance, cap_per_distance);
+}
+
+void
+unset_parasitic_estimate_cmd()
+{
+  Sta::sta()->setParasiticEstimator(nullptr);
+}
+
+void
+parasitic_estimates_invalid(const Net *net)
+{
+  Sta::sta()->parasiticEstimatesInvalid(net);
+}
+
+void
+write_parasitics_cache_cmd(const char *filename)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->writeParasiticsCache(filename);
+}
+
+bool
+read_parasitics_cache_cmd(const char *filename)
+{
+  cmdLinkedNetwork();
+  return Sta::sta()->readParasiticsCache(filename);
 }
 
 void
@@ -24,15 +24,19 @@ define_cmd_args "read_spef" \
      [-pin_cap_included]\
      [-keep_capacitive_coupling]\
      [-coupling_reduction_factor factor]\
+     [-reduce]\
+     [-keep_detailed_nets nets]\
      [-reduce_to pi_elmore|pi_pole_residue2]\
      [-delete_after_reduce]\
+     [-incremental]\
      filename}
 
 proc_redirect read_spef {
   parse_key_args "read_spef" args \
-    keys {-path -coupling_reduction_factor -reduce_to -corner} \
+    keys {-path -coupling_reduction_factor -reduce_to -corner \
+            -keep_detailed_nets} \
     flags {-min -max -increment -pin_cap_included -keep_capacitive_coupling \
-	     -reduce -delete_after_reduce -quiet -save}
+	     -reduce -delete_after_reduce -quiet -save -incremental}
   check_argc_eq1 "read_spef" $args
 
   set reduce [info exists flags(-reduce)]
@@ -67,11 +71,70 @@ proc_redirect read_spef {
   }
   set keep_coupling_caps [info exists flags(-keep_capacitive_coupling)]
   set pin_cap_included [info exists flags(-pin_cap_included)]
+  set keep_detailed_nets {}
+  if [info exists keys(-keep_detailed_nets)] {
+    set keep_detailed_nets [parse_net_arg $keys(-keep_detailed_nets)]
+  }
+
+  set incremental [info exists flags(-incremental)]
 
   set filename [file nativename [lindex $args 0]]
   return [read_spef_cmd $filename $instance $corner $min_max \
 	    $pin_cap_included $keep_coupling_caps \
-            $coupling_reduction_factor $reduce]
+            $coupling_reduction_factor $reduce $keep_detailed_nets \
+            $incremental]
+}
+
+define_cmd_args "reduce_parasitics" {[-corner corner] [-min] [-max]}
+
+proc reduce_parasitics { args } {
+  parse_key_args "reduce_parasitics" args keys {-corner} flags {-min -max}
+  check_argc_eq0 "reduce_parasitics" $args
+  set corner [parse_corner_or_all keys]
+  set min_max [parse_min_max_all_flags flags]
+  reduce_parasitics_cmd $corner $min_max
+}
+
+define_cmd_args "set_wire_rc_estimate" \
+  {-resistance res_per_distance -capacitance cap_per_distance}
+
+proc set_wire_rc_estimate { args } {
+  parse_key_args "set_wire_rc_estimate" args \
+    keys {-resistance -capacitance} flags {}
+  check_argc_eq0 "set_wire_rc_estimate" $args
+  if { ![info exists keys(-resistance)] \
+         || ![info exists keys(-capacitance)] } {
+    sta_error 277 "set_wire_rc_estimate requires -resistance and -capacitance."
+  }
+  set res $keys(-resistance)
+  check_positive_float "-resistance" $res
+  set cap $keys(-capacitance)
+  check_positive_float "-capacitance" $cap
+  # Values are per user distance unit.
+  set distance [distance_ui_sta 1.0]
+  set_wire_rc_estimate_cmd [expr [resistance_ui_sta $res] / $distance] \
+    [expr [capacitance_ui_sta $cap] / $distance]
+}
+
+define_cmd_args "unset_parasitic_estimate" {}
+
+proc unset_parasitic_estimate { args } {
+  check_argc_eq0 "unset_parasitic_estimate" $args
+  unset_parasitic_estimate_cmd
+}
+
+define_cmd_args "write_parasitics_cache" {filename}
+
+proc write_parasitics_cache { args } {
+  check_argc_eq1 "write_parasitics_cache" $args
+  write_parasitics_cache_cmd [file nativename [lindex $args 0]]
+}
+
+define_cmd_args "read_parasitics_cache" {filename}
+
+proc read_parasitics_cache { args } {
+  check_argc_eq1 "read_parasitics_cache" $args
+  return [read_parasitics_cache_cmd [file nativename [lindex $args 0]]]
 }
 
 define_cmd_args "report_parasitic_annotation" {-report_unannotated}
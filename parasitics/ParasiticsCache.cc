@@ -0,0 +1,661 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "ParasiticsCache.hh"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "Error.hh"
+#include "Report.hh"
+#include "Transition.hh"
+#include "Network.hh"
+#include "Corner.hh"
+#include "Parasitics.hh"
+#include "CacheNetlist.hh"
+
+namespace sta {
+
+// File layout (host byte order):
+//  header    magic[8] version byte_order netlist_checksum ap_count
+//            coupling_cap_factor[ap_count]
+//  records   type ...
+//  end       record_end
+// Pins and nets are written as network object ids.
+static const char cache_magic[8] = {'S', 'T', 'A', 'P', 'A', 'R', 'A', 'S'};
+static const uint32_t cache_version = 1;
+static const uint32_t cache_byte_order = 0x01020304;
+
+enum class CacheRecord : uint8_t {
+  end,
+  pi_elmore,
+  pi_pole_residue,
+  network
+};
+
+enum class CacheNode : uint8_t {
+  pin,
+  subnode
+};
+
+////////////////////////////////////////////////////////////////
+
+class ParasiticsCacheWriter : public StaState
+{
+public:
+  ParasiticsCacheWriter(const char *filename,
+                        StaState *sta);
+  ~ParasiticsCacheWriter();
+  void write();
+
+private:
+  void writeHeader();
+  void writePiElmore(const Pin *drvr_pin,
+                     const RiseFall *rf,
+                     const ParasiticAnalysisPt *ap,
+                     const Parasitic *parasitic);
+  void writePiPoleResidue(const Pin *drvr_pin,
+                          const RiseFall *rf,
+                          const ParasiticAnalysisPt *ap,
+                          const Parasitic *parasitic);
+  void writePiModel(const Pin *drvr_pin,
+                    const RiseFall *rf,
+                    const ParasiticAnalysisPt *ap,
+                    const Parasitic *parasitic);
+  void writeNetwork(const Net *net,
+                    const ParasiticAnalysisPt *ap,
+                    const Parasitic *parasitic);
+  template <class VALUE>
+  void writeValue(VALUE value);
+  void writeBytes(const void *bytes,
+                  size_t size);
+
+  const char *filename_;
+  FILE *stream_;
+  CacheNetlist netlist_;
+};
+
+void
+writeParasiticsCache(const char *filename,
+                     StaState *sta)
+{
+  ParasiticsCacheWriter writer(filename, sta);
+  writer.write();
+}
+
+ParasiticsCacheWriter::ParasiticsCacheWriter(const char *filename,
+                                             StaState *sta) :
+  StaState(sta),
+  filename_(filename),
+  stream_(nullptr),
+  netlist_(sta)
+{
+}
+
+ParasiticsCacheWriter::~ParasiticsCacheWriter()
+{
+  if (stream_)
+    fclose(stream_);
+}
+
+void
+ParasiticsCacheWriter::write()
+{
+  stream_ = fopen(filename_, "wb");
+  if (stream_ == nullptr)
+    throw FileNotWritable(filename_);
+  writeHeader();
+  for (const ParasiticAnalysisPt *ap : corners_->parasiticAnalysisPts()) {
+    for (const Pin *pin : netlist_.pins()) {
+      if (network_->isDriver(pin)) {
+        for (const RiseFall *rf : RiseFall::range()) {
+          Parasitic *parasitic = parasitics_->findPiElmore(pin, rf, ap);
+          if (parasitic)
+            writePiElmore(pin, rf, ap, parasitic);
+          parasitic = parasitics_->findPiPoleResidue(pin, rf, ap);
+          if (parasitic)
+            writePiPoleResidue(pin, rf, ap, parasitic);
+        }
+      }
+    }
+    for (const Net *net : netlist_.nets()) {
+      Parasitic *parasitic = parasitics_->findParasiticNetwork(net, ap);
+      if (parasitic)
+        writeNetwork(net, ap, parasitic);
+    }
+  }
+  writeValue(CacheRecord::end);
+  bool failed = ferror(stream_);
+  if (fclose(stream_) != 0)
+    failed = true;
+  stream_ = nullptr;
+  if (failed)
+    report_->error(1670, "write_parasitics_cache %s failed.", filename_);
+}
+
+void
+ParasiticsCacheWriter::writeHeader()
+{
+  writeBytes(cache_magic, sizeof(cache_magic));
+  writeValue(cache_version);
+  writeValue(cache_byte_order);
+  writeValue(netlist_.checksum());
+  ParasiticAnalysisPtSeq &aps = corners_->parasiticAnalysisPts();
+  writeValue(static_cast<uint32_t>(aps.size()));
+  for (const ParasiticAnalysisPt *ap : aps)
+    writeValue(ap->couplingCapFactor());
+}
+
+void
+ParasiticsCacheWriter::writePiModel(const Pin *drvr_pin,
+                                    const RiseFall *rf,
+                                    const ParasiticAnalysisPt *ap,
+                                    const Parasitic *parasitic)
+{
+  writeValue(static_cast<uint32_t>(ap->index()));
+  writeValue(network_->id(drvr_pin));
+  writeValue(static_cast<uint8_t>(rf->index()));
+  float c2, rpi, c1;
+  parasitics_->piModel(parasitic, c2, rpi, c1);
+  writeValue(c2);
+  writeValue(rpi);
+  writeValue(c1);
+  writeValue(static_cast<uint8_t>(parasitics_->isReducedParasiticNetwork(parasitic)));
+}
+
+void
+ParasiticsCacheWriter::writePiElmore(const Pin *drvr_pin,
+                                     const RiseFall *rf,
+                                     const ParasiticAnalysisPt *ap,
+                                     const Parasitic *parasitic)
+{
+  writeValue(CacheRecord::pi_elmore);
+  writePiModel(drvr_pin, rf, ap, parasitic);
+  std::vector<std::pair<const Pin*, float>> load_elmores;
+  for (const Pin *load_pin : parasitics_->loads(drvr_pin)) {
+    float elmore;
+    bool exists;
+    parasitics_->findElmore(parasitic, load_pin, elmore, exists);
+    if (exists)
+      load_elmores.push_back({load_pin, elmore});
+  }
+  writeValue(static_cast<uint32_t>(load_elmores.size()));
+  for (auto load_elmore : load_elmores) {
+    writeValue(network_->id(load_elmore.first));
+    writeValue(load_elmore.second);
+  }
+}
+
+void
+ParasiticsCacheWriter::writePiPoleResidue(const Pin *drvr_pin,
+                                          const RiseFall *rf,
+                                          const ParasiticAnalysisPt *ap,
+                                          const Parasitic *parasitic)
+{
+  writeValue(CacheRecord::pi_pole_residue);
+  writePiModel(drvr_pin, rf, ap, parasitic);
+  std::vector<std::pair<const Pin*, const Parasitic*>> load_pole_residues;
+  for (const Pin *load_pin : parasitics_->loads(drvr_pin)) {
+    const Parasitic *pole_residue =
+      parasitics_->findPoleResidue(parasitic, load_pin);
+    if (pole_residue)
+      load_pole_residues.push_back({load_pin, pole_residue});
+  }
+  writeValue(static_cast<uint32_t>(load_pole_residues.size()));
+  for (auto load_pole_residue : load_pole_residues) {
+    const Parasitic *pole_residue = load_pole_residue.second;
+    size_t pole_count = parasitics_->poleResidueCount(pole_residue);
+    writeValue(network_->id(load_pole_residue.first));
+    writeValue(static_cast<uint32_t>(pole_count));
+    for (size_t i = 0; i < pole_count; i++) {
+      ComplexFloat pole, residue;
+      parasitics_->poleResidue(pole_residue, i, pole, residue);
+      writeValue(pole.real());
+      writeValue(pole.imag());
+      writeValue(residue.real());
+      writeValue(residue.imag());
+    }
+  }
+}
+
+void
+ParasiticsCacheWriter::writeNetwork(const Net *net,
+                                    const ParasiticAnalysisPt *ap,
+                                    const Parasitic *parasitic)
+{
+  writeValue(CacheRecord::network);
+  writeValue(static_cast<uint32_t>(ap->index()));
+  writeValue(network_->id(net));
+  writeValue(static_cast<uint8_t>(parasitics_->includesPinCaps(parasitic)));
+
+  ParasiticNodeSeq nodes = parasitics_->nodes(parasitic);
+  // Devices refer to nodes by their index in nodes.
+  std::unordered_map<const ParasiticNode*, uint32_t> node_index_map;
+  writeValue(static_cast<uint32_t>(nodes.size()));
+  uint32_t node_index = 0;
+  for (const ParasiticNode *node : nodes) {
+    node_index_map[node] = node_index++;
+    const Pin *pin = parasitics_->pin(node);
+    if (pin) {
+      writeValue(CacheNode::pin);
+      writeValue(network_->id(pin));
+    }
+    else {
+      writeValue(CacheNode::subnode);
+      writeValue(network_->id(parasitics_->net(node, network_)));
+      writeValue(static_cast<int32_t>(parasitics_->id(node)));
+    }
+    writeValue(parasitics_->nodeGndCap(node));
+  }
+
+  ParasiticResistorSeq resistors = parasitics_->resistors(parasitic);
+  writeValue(static_cast<uint32_t>(resistors.size()));
+  for (const ParasiticResistor *resistor : resistors) {
+    writeValue(static_cast<uint64_t>(parasitics_->id(resistor)));
+    writeValue(parasitics_->value(resistor));
+    writeValue(node_index_map[parasitics_->node1(resistor)]);
+    writeValue(node_index_map[parasitics_->node2(resistor)]);
+  }
+
+  ParasiticCapacitorSeq capacitors = parasitics_->capacitors(parasitic);
+  writeValue(static_cast<uint32_t>(capacitors.size()));
+  for (const ParasiticCapacitor *capacitor : capacitors) {
+    writeValue(static_cast<uint64_t>(parasitics_->id(capacitor)));
+    writeValue(parasitics_->value(capacitor));
+    writeValue(node_index_map[parasitics_->node1(capacitor)]);
+    writeValue(node_index_map[parasitics_->node2(capacitor)]);
+  }
+}
+
+template <class VALUE>
+void
+ParasiticsCacheWriter::writeValue(VALUE value)
+{
+  writeBytes(&value, sizeof(VALUE));
+}
+
+void
+ParasiticsCacheWriter::writeBytes(const void *bytes,
+                                  size_t size)
+{
+  fwrite(bytes, size, 1, stream_);
+}
+
+////////////////////////////////////////////////////////////////
+
+class ParasiticsCacheReader : public StaState
+{
+public:
+  ParasiticsCacheReader(const char *filename,
+                        StaState *sta);
+  bool read();
+
+private:
+  bool readFile();
+  bool readHeader();
+  bool readRecords();
+  bool readPiElmore();
+  bool readPiPoleResidue();
+  bool readPiModel(const Pin *&drvr_pin,
+                   const RiseFall *&rf,
+                   const ParasiticAnalysisPt *&ap,
+                   float &c2,
+                   float &rpi,
+                   float &c1,
+                   bool &is_reduced);
+  bool readNetwork();
+  const ParasiticAnalysisPt *readAnalysisPt();
+  const Pin *readPin();
+  const Net *readNet();
+  template <class VALUE>
+  VALUE readValue();
+  bool readBytes(void *bytes,
+                 size_t size);
+  bool corrupt();
+
+  const char *filename_;
+  std::vector<char> data_;
+  size_t pos_;
+  bool truncated_;
+  CacheNetlist netlist_;
+  std::unordered_map<ObjectId, const Pin*> pin_id_map_;
+  std::unordered_map<ObjectId, const Net*> net_id_map_;
+};
+
+bool
+readParasiticsCache(const char *filename,
+                    StaState *sta)
+{
+  ParasiticsCacheReader reader(filename, sta);
+  return reader.read();
+}
+
+ParasiticsCacheReader::ParasiticsCacheReader(const char *filename,
+                                             StaState *sta) :
+  StaState(sta),
+  filename_(filename),
+  pos_(0),
+  truncated_(false),
+  netlist_(sta)
+{
+}
+
+bool
+ParasiticsCacheReader::read()
+{
+  if (!readFile())
+    throw FileNotReadable(filename_);
+  if (!readHeader())
+    return false;
+  for (const Pin *pin : netlist_.pins())
+    pin_id_map_[network_->id(pin)] = pin;
+  for (const Net *net : netlist_.nets())
+    net_id_map_[network_->id(net)] = net;
+  parasitics_->deleteParasitics();
+  return readRecords();
+}
+
+// The whole file is read with one fread and decoded from memory.
+bool
+ParasiticsCacheReader::readFile()
+{
+  FILE *stream = fopen(filename_, "rb");
+  if (stream == nullptr)
+    return false;
+  bool success = false;
+  if (fseek(stream, 0, SEEK_END) == 0) {
+    long size = ftell(stream);
+    if (size >= 0
+        && fseek(stream, 0, SEEK_SET) == 0) {
+      data_.resize(size);
+      success = fread(data_.data(), 1, size, stream) == static_cast<size_t>(size);
+    }
+  }
+  fclose(stream);
+  return success;
+}
+
+bool
+ParasiticsCacheReader::readHeader()
+{
+  char magic[sizeof(cache_magic)];
+  if (!readBytes(magic, sizeof(magic))
+      || memcmp(magic, cache_magic, sizeof(magic)) != 0) {
+    report_->warn(1671, "%s is not a parasitics cache file.", filename_);
+    return false;
+  }
+  uint32_t version = readValue<uint32_t>();
+  uint32_t byte_order = readValue<uint32_t>();
+  if (version != cache_version
+      || byte_order != cache_byte_order) {
+    report_->warn(1672, "parasitics cache %s version or byte order not supported.",
+                  filename_);
+    return false;
+  }
+  uint64_t checksum = readValue<uint64_t>();
+  if (checksum != netlist_.checksum()) {
+    report_->warn(1673, "parasitics cache %s was written for a different netlist.",
+                  filename_);
+    return false;
+  }
+  ParasiticAnalysisPtSeq &aps = corners_->parasiticAnalysisPts();
+  uint32_t ap_count = readValue<uint32_t>();
+  if (ap_count != aps.size()) {
+    report_->warn(1674, "parasitics cache %s parasitic analysis points do not match the corners.",
+                  filename_);
+    return false;
+  }
+  for (ParasiticAnalysisPt *ap : aps)
+    ap->setCouplingCapFactor(readValue<float>());
+  return !truncated_ || corrupt();
+}
+
+bool
+ParasiticsCacheReader::readRecords()
+{
+  for (;;) {
+    CacheRecord record = readValue<CacheRecord>();
+    if (truncated_)
+      return corrupt();
+    bool success;
+    switch (record) {
+    case CacheRecord::end:
+      return true;
+    case CacheRecord::pi_elmore:
+      success = readPiElmore();
+      break;
+    case CacheRecord::pi_pole_residue:
+      success = readPiPoleResidue();
+      break;
+    case CacheRecord::network:
+      success = readNetwork();
+      break;
+    default:
+      success = false;
+      break;
+    }
+    if (!success || truncated_)
+      return corrupt();
+  }
+}
+
+bool
+ParasiticsCacheReader::readPiModel(const Pin *&drvr_pin,
+                                   const RiseFall *&rf,
+                                   const ParasiticAnalysisPt *&ap,
+                                   float &c2,
+                                   float &rpi,
+                                   float &c1,
+                                   bool &is_reduced)
+{
+  ap = readAnalysisPt();
+  drvr_pin = readPin();
+  uint8_t rf_index = readValue<uint8_t>();
+  rf = (rf_index < RiseFall::index_count) ? RiseFall::find(rf_index) : nullptr;
+  c2 = readValue<float>();
+  rpi = readValue<float>();
+  c1 = readValue<float>();
+  is_reduced = readValue<uint8_t>();
+  return ap && drvr_pin && rf;
+}
+
+bool
+ParasiticsCacheReader::readPiElmore()
+{
+  const Pin *drvr_pin;
+  const RiseFall *rf;
+  const ParasiticAnalysisPt *ap;
+  float c2, rpi, c1;
+  bool is_reduced;
+  if (!readPiModel(drvr_pin, rf, ap, c2, rpi, c1, is_reduced))
+    return false;
+  Parasitic *parasitic = parasitics_->makePiElmore(drvr_pin, rf, ap,
+                                                   c2, rpi, c1);
+  parasitics_->setIsReducedParasiticNetwork(parasitic, is_reduced);
+  uint32_t load_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < load_count && !truncated_; i++) {
+    const Pin *load_pin = readPin();
+    float elmore = readValue<float>();
+    if (load_pin == nullptr)
+      return false;
+    parasitics_->setElmore(parasitic, load_pin, elmore);
+  }
+  return true;
+}
+
+bool
+ParasiticsCacheReader::readPiPoleResidue()
+{
+  const Pin *drvr_pin;
+  const RiseFall *rf;
+  const ParasiticAnalysisPt *ap;
+  float c2, rpi, c1;
+  bool is_reduced;
+  if (!readPiModel(drvr_pin, rf, ap, c2, rpi, c1, is_reduced))
+    return false;
+  Parasitic *parasitic = parasitics_->makePiPoleResidue(drvr_pin, rf, ap,
+                                                        c2, rpi, c1);
+  parasitics_->setIsReducedParasiticNetwork(parasitic, is_reduced);
+  uint32_t load_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < load_count && !truncated_; i++) {
+    const Pin *load_pin = readPin();
+    uint32_t pole_count = readValue<uint32_t>();
+    if (load_pin == nullptr
+        // Each pole takes 16 bytes.
+        || pole_count > (data_.size() - pos_) / 16)
+      return false;
+    ComplexFloatSeq *poles = new ComplexFloatSeq(pole_count);
+    ComplexFloatSeq *residues = new ComplexFloatSeq(pole_count);
+    for (uint32_t j = 0; j < pole_count; j++) {
+      float pole_real = readValue<float>();
+      float pole_imag = readValue<float>();
+      float residue_real = readValue<float>();
+      float residue_imag = readValue<float>();
+      (*poles)[j] = ComplexFloat(pole_real, pole_imag);
+      (*residues)[j] = ComplexFloat(residue_real, residue_imag);
+    }
+    parasitics_->setPoleResidue(parasitic, load_pin, poles, residues);
+  }
+  return true;
+}
+
+bool
+ParasiticsCacheReader::readNetwork()
+{
+  const ParasiticAnalysisPt *ap = readAnalysisPt();
+  const Net *net = readNet();
+  bool includes_pin_caps = readValue<uint8_t>();
+  if (ap == nullptr || net == nullptr)
+    return false;
+  Parasitic *parasitic = parasitics_->makeParasiticNetwork(net,
+                                                           includes_pin_caps,
+                                                           ap);
+  uint32_t node_count = readValue<uint32_t>();
+  std::vector<ParasiticNode*> nodes;
+  for (uint32_t i = 0; i < node_count && !truncated_; i++) {
+    CacheNode node_type = readValue<CacheNode>();
+    ParasiticNode *node = nullptr;
+    if (node_type == CacheNode::pin) {
+      const Pin *pin = readPin();
+      if (pin)
+        node = parasitics_->ensureParasiticNode(parasitic, pin, network_);
+    }
+    else if (node_type == CacheNode::subnode) {
+      const Net *node_net = readNet();
+      int id = readValue<int32_t>();
+      if (node_net)
+        node = parasitics_->ensureParasiticNode(parasitic, node_net, id,
+                                                network_);
+    }
+    float cap = readValue<float>();
+    if (node == nullptr)
+      return false;
+    parasitics_->incrCap(node, cap);
+    nodes.push_back(node);
+  }
+
+  uint32_t resistor_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < resistor_count && !truncated_; i++) {
+    size_t id = readValue<uint64_t>();
+    float res = readValue<float>();
+    uint32_t node1 = readValue<uint32_t>();
+    uint32_t node2 = readValue<uint32_t>();
+    if (node1 >= nodes.size() || node2 >= nodes.size())
+      return false;
+    parasitics_->makeResistor(parasitic, id, res, nodes[node1], nodes[node2]);
+  }
+
+  uint32_t capacitor_count = readValue<uint32_t>();
+  for (uint32_t i = 0; i < capacitor_count && !truncated_; i++) {
+    size_t id = readValue<uint64_t>();
+    float cap = readValue<float>();
+    uint32_t node1 = readValue<uint32_t>();
+    uint32_t node2 = readValue<uint32_t>();
+    if (node1 >= nodes.size() || node2 >= nodes.size())
+      return false;
+    parasitics_->makeCapacitor(parasitic, id, cap, nodes[node1], nodes[node2]);
+  }
+  return true;
+}
+
+const ParasiticAnalysisPt *
+ParasiticsCacheReader::readAnalysisPt()
+{
+  ParasiticAnalysisPtSeq &aps = corners_->parasiticAnalysisPts();
+  uint32_t ap_index = readValue<uint32_t>();
+  if (ap_index < aps.size())
+    return aps[ap_index];
+  else
+    return nullptr;
+}
+
+const Pin *
+ParasiticsCacheReader::readPin()
+{
+  ObjectId id = readValue<ObjectId>();
+  auto id_pin = pin_id_map_.find(id);
+  if (id_pin == pin_id_map_.end())
+    return nullptr;
+  else
+    return id_pin->second;
+}
+
+const Net *
+ParasiticsCacheReader::readNet()
+{
+  ObjectId id = readValue<ObjectId>();
+  auto id_net = net_id_map_.find(id);
+  if (id_net == net_id_map_.end())
+    return nullptr;
+  else
+    return id_net->second;
+}
+
+template <class VALUE>
+VALUE
+ParasiticsCacheReader::readValue()
+{
+  VALUE value{};
+  readBytes(&value, sizeof(VALUE));
+  return value;
+}
+
+bool
+ParasiticsCacheReader::readBytes(void *bytes,
+                                 size_t size)
+{
+  if (size > data_.size() - pos_) {
+    truncated_ = true;
+    pos_ = data_.size();
+    return false;
+  }
+  memcpy(bytes, data_.data() + pos_, size);
+  pos_ += size;
+  return true;
+}
+
+bool
+ParasiticsCacheReader::corrupt()
+{
+  report_->warn(1675, "parasitics cache %s is corrupt.", filename_);
+  parasitics_->deleteParasitics();
+  return false;
+}
+
+} // namespace
@@ -0,0 +1,39 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace sta {
+
+class StaState;
+
+// Write the parasitics of every parasitic analysis point (detailed
+// networks and reduced pi/elmore and pi/pole residue models) to a
+// binary file. Pins and nets are keyed by network object ids and the
+// file carries a checksum of the netlist they refer to.
+void
+writeParasiticsCache(const char *filename,
+                     StaState *sta);
+
+// Replace the parasitics with the contents of a file written by
+// writeParasiticsCache for the same netlist and parasitic analysis
+// points.
+// Return true if successful.
+bool
+readParasiticsCache(const char *filename,
+                    StaState *sta);
+
+} // namespace
@@ -16,6 +16,10 @@
 
 #include "ReportParasiticAnnotation.hh"
 
+#include <algorithm>
+#include <vector>
+
+#include "DispatchQueue.hh"
 #include "Report.hh"
 #include "Network.hh"
 #include "NetworkCmp.hh"
@@ -28,6 +32,8 @@
 
 namespace sta {
 
+static const size_t parasitic_annotation_chunk_size = 1024;
+
 class ReportParasiticAnnotation : public StaState
 {
 public:
@@ -41,6 +47,10 @@ private:
   void findCounts();
   void findCounts(Instance *inst);
   void findCounts(Net *net);
+  enum class Annotation { full, partial, none };
+  Annotation drvrAnnotation(const Pin *drvr_pin,
+                            const DcalcAnalysisPt *dcalc_ap,
+                            ArcDelayCalc *arc_delay_calc);
 
   bool report_unannotated_;
   const Corner *corner_;
@@ -108,25 +118,69 @@ void
 ReportParasiticAnnotation::findCounts()
 {
   DcalcAnalysisPt *dcalc_ap = corner_->findDcalcAnalysisPt(min_max_);
+  PinSeq drvrs;
   VertexIterator vertex_iter(graph_);
   while (vertex_iter.hasNext()) {
     Vertex *vertex = vertex_iter.next();
     Pin *pin = vertex->pin();
     PortDirection *dir = network_->direction(pin);
     if (vertex->isDriver(network_)
-        && !dir->isInternal()) {
-      Parasitic *parasitic = parasitics_->findParasiticNetwork(pin, parasitic_ap_);
-      if (parasitic == nullptr)
-        parasitic = arc_delay_calc_->findParasitic(pin, RiseFall::rise(), dcalc_ap);
-      if (parasitic) {
-        PinSet unannotated_loads = parasitics_->unannotatedLoads(parasitic, pin);
-        if (unannotated_loads.size() > 0)
-          partially_annotated_.push_back(pin);
-      }
-      else 
-        unannotated_.push_back(pin);
+        && !dir->isInternal())
+      drvrs.push_back(pin);
+  }
+
+  size_t count = drvrs.size();
+  std::vector<Annotation> annotations(count);
+  if (dispatch_queue_ == nullptr
+      || thread_count_ <= 1
+      || count < parasitic_annotation_chunk_size * 2) {
+    for (size_t i = 0; i < count; i++)
+      annotations[i] = drvrAnnotation(drvrs[i], dcalc_ap, arc_delay_calc_);
+  }
+  else {
+    // Delay calculators keep state per call so each thread uses a copy.
+    std::vector<ArcDelayCalc*> arc_delay_calcs;
+    for (int i = 0; i < thread_count_; i++)
+      arc_delay_calcs.push_back(arc_delay_calc_->copy());
+    for (size_t from = 0; from < count; from += parasitic_annotation_chunk_size) {
+      size_t to = std::min(from + parasitic_annotation_chunk_size, count);
+      dispatch_queue_->dispatch([=, &drvrs, &annotations,
+                                 &arc_delay_calcs] (int thread) {
+        for (size_t i = from; i < to; i++)
+          annotations[i] = drvrAnnotation(drvrs[i], dcalc_ap,
+                                          arc_delay_calcs[thread]);
+      });
     }
+    dispatch_queue_->finishTasks();
+    for (ArcDelayCalc *arc_delay_calc : arc_delay_calcs)
+      delete arc_delay_calc;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    if (annotations[i] == Annotation::partial)
+      partially_annotated_.push_back(drvrs[i]);
+    else if (annotations[i] == Annotation::none)
+      unannotated_.push_back(drvrs[i]);
+  }
+}
+
+ReportParasiticAnnotation::Annotation
+ReportParasiticAnnotation::drvrAnnotation(const Pin *drvr_pin,
+                                          const DcalcAnalysisPt *dcalc_ap,
+                                          ArcDelayCalc *arc_delay_calc)
+{
+  Parasitic *parasitic = parasitics_->findParasiticNetwork(drvr_pin, parasitic_ap_);
+  if (parasitic == nullptr)
+    parasitic = arc_delay_calc->findParasitic(drvr_pin, RiseFall::rise(), dcalc_ap);
+  if (parasitic) {
+    PinSet unannotated_loads = parasitics_->unannotatedLoads(parasitic, drvr_pin);
+    if (unannotated_loads.size() > 0)
+      return Annotation::partial;
+    else
+      return Annotation::full;
   }
+  else
+    return Annotation::none;
 }
 
 } // namespace
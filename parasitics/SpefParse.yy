@@ -250,6 +250,7 @@ induc_scale:
 name_map:
 	/* empty */
 |	NAME_MAP name_map_entries
+	{ sta::spef_reader->resolveNameMap(); }
 ;
 
 name_map_entries:
@@ -16,6 +16,9 @@
 
 #include "SpefReader.hh"
 
+#include <algorithm>
+#include <atomic>
+
 #include "Zlib.hh"
 #include "Report.hh"
 #include "Debug.hh"
@@ -29,6 +32,7 @@
 #include "Parasitics.hh"
 #include "Corner.hh"
 #include "ArcDelayCalc.hh"
+#include "DispatchQueue.hh"
 #include "SpefReaderPvt.hh"
 #include "SpefNamespace.hh"
 
@@ -42,6 +46,12 @@ namespace sta {
 // Referenced by parser.
 SpefReader *spef_reader;
 
+// Capacitors and resistors recorded before building a batch of
+// D_NET parasitic networks in parallel mode.
+static const size_t dnet_batch_elem_count = 100000;
+// D_NETs claimed by a worker at a time.
+static const size_t dnet_chunk_size = 16;
+
 bool
 readSpefFile(const char *filename,
 	     Instance *instance,
@@ -50,22 +60,26 @@ readSpefFile(const char *filename,
 	     bool keep_coupling_caps,
 	     float coupling_cap_factor,
 	     bool reduce,
+             const NetSet *keep_detailed_nets,
 	     const Corner *corner,
 	     const MinMaxAll *min_max,
+             bool parallel,
+             NetSet *read_nets,
              StaState *sta)
 {
   bool success = false;
-  // Use zlib to uncompress gzip'd files automagically.
-  gzFile stream = gzopen(filename, "rb");
-  if (stream) {
-    SpefReader reader(filename, stream, instance, ap,
+  InputFile stream;
+  if (stream.open(filename)) {
+    SpefReader reader(filename, &stream, instance, ap,
 		      pin_cap_included, keep_coupling_caps, coupling_cap_factor,
-		      reduce, corner, min_max, sta);
+		      reduce, keep_detailed_nets, corner, min_max,
+                      parallel, read_nets, sta);
     spef_reader = &reader;
     ::spefResetScanner();
     // yyparse returns 0 on success.
     success = (::SpefParse_parse() == 0);
-    gzclose(stream);
+    reader.finish();
+    stream.close();
     spef_reader = nullptr;
   }
   else
@@ -74,15 +88,18 @@ readSpefFile(const char *filename,
 }
 
 SpefReader::SpefReader(const char *filename,
-		       gzFile stream,
+		       InputFile *stream,
 		       Instance *instance,
 		       ParasiticAnalysisPt *ap,
 		       bool pin_cap_included,
 		       bool keep_coupling_caps,
 		       float coupling_cap_factor,
 		       bool reduce,
+                       const NetSet *keep_detailed_nets,
 		       const Corner *corner,
 		       const MinMaxAll *min_max,
+                       bool parallel,
+                       NetSet *read_nets,
 		       StaState *sta) :
   StaState(sta),
   filename_(filename),
@@ -91,6 +108,8 @@ SpefReader::SpefReader(const char *filename,
   pin_cap_included_(pin_cap_included),
   keep_coupling_caps_(keep_coupling_caps),
   reduce_(reduce),
+  keep_detailed_nets_(keep_detailed_nets),
+  read_nets_(read_nets),
   corner_(corner),
   min_max_(min_max),
   stream_(stream),
@@ -107,7 +126,15 @@ SpefReader::SpefReader(const char *filename,
   res_scale_(1.0),
   induct_scale_(1.0),
   design_flow_(nullptr),
-  parasitic_(nullptr)
+  parasitic_(nullptr),
+  // Parasitic networks of hierarchical instances are shared by the
+  // nets below them, so they are built serially.
+  parallel_(parallel
+            && thread_count_ > 1
+            && network_->isTopInstance(instance)),
+  dnet_(nullptr),
+  dnet_elem_count_(0),
+  dnet_nets_(network_)
 {
   ap->setCouplingCapFactor(coupling_cap_factor);
 }
@@ -124,6 +151,19 @@ SpefReader::~SpefReader()
     char *name = index_name.second;
     stringDelete(name);
   }
+
+  // Left over from a parse error.
+  delete dnet_;
+  for (SpefDnet *dnet : dnets_)
+    delete dnet;
+  for (ArcDelayCalc *arc_delay_calc : arc_delay_calcs_)
+    delete arc_delay_calc;
+}
+
+void
+SpefReader::finish()
+{
+  makeDnetParasitics();
 }
 
 void
@@ -181,11 +221,7 @@ SpefReader::getChars(char *buf,
 		     int &result,
 		     size_t max_size)
 {
-  char *status = gzgets(stream_, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = static_cast<int>(strlen(buf));
+  stream_->getChars(buf, result, max_size);
 }
 
 void
@@ -193,11 +229,7 @@ SpefReader::getChars(char *buf,
 		     size_t &result,
 		     size_t max_size)
 {
-  char *status = gzgets(stream_, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = strlen(buf);
+  stream_->getChars(buf, result, max_size);
 }
 
 char *
@@ -218,10 +250,33 @@ SpefReader::warn(int id, const char *fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  report_->vfileWarn(id, filename_, line_, fmt, args);
+  vwarn(id, line_, fmt, args);
   va_end(args);
 }
 
+void
+SpefReader::warn(int id,
+                 int line,
+                 const char *fmt,
+                 ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  vwarn(id, line, fmt, args);
+  va_end(args);
+}
+
+void
+SpefReader::vwarn(int id,
+                  int line,
+                  const char *fmt,
+                  va_list args)
+{
+  // Workers report warnings concurrently.
+  std::lock_guard<std::mutex> lock(warn_lock_);
+  report_->vfileWarn(id, filename_, line, fmt, args);
+}
+
 void
 SpefReader::setTimeScale(float scale,
 			 const char *units)
@@ -284,8 +339,53 @@ SpefReader::makeNameMapEntry(char *index,
   name_map_[i] = name;
 }
 
+void
+SpefReader::resolveNameMap()
+{
+  if (!name_map_.empty()) {
+    size_t max_index = name_map_.rbegin()->first;
+    // Indices are normally dense. Leave a sparse name map to lookups
+    // by name.
+    if (name_map_.begin()->first >= 0
+        && max_index < name_map_.size() * 2 + 1024) {
+      name_map_entries_.resize(max_index + 1, {nullptr, nullptr,
+                                               nullptr, nullptr});
+      for (auto index_name : name_map_) {
+        char *name = index_name.second;
+        SpefNameMapEntry &entry = name_map_entries_[index_name.first];
+        entry.name = name;
+        entry.instance = findInstanceRelative(name);
+        entry.net = findNetRelative(name);
+        entry.port_pin = findPortPinRelative(name);
+      }
+    }
+  }
+}
+
+const SpefNameMapEntry *
+SpefReader::resolvedNameMapEntry(const char *name) const
+{
+  if (name && name[0] == '*' && !name_map_entries_.empty()) {
+    int index = atoi(name + 1);
+    if (index >= 0
+        && static_cast<size_t>(index) < name_map_entries_.size()) {
+      const SpefNameMapEntry &entry = name_map_entries_[index];
+      if (entry.name)
+        return &entry;
+    }
+  }
+  return nullptr;
+}
+
 char *
 SpefReader::nameMapLookup(char *name)
+{
+  return nameMapLookup(name, line_);
+}
+
+char *
+SpefReader::nameMapLookup(char *name,
+                          int line)
 {
   if (name && name[0] == '*') {
     int index = atoi(name + 1);
@@ -293,7 +393,7 @@ SpefReader::nameMapLookup(char *name)
     if (itr != name_map_.end())
       return itr->second;
     else {
-      warn(1645, "no name map entry for %d.", index);
+      warn(1645, line, "no name map entry for %d.", index);
       return nullptr;
     }
   }
@@ -324,31 +424,55 @@ SpefReader::setDesignFlow(StringSeq *flow)
 
 Pin *
 SpefReader::findPin(char *name)
+{
+  if (dnet_) {
+    // The D_NET connection pins are only checked, so leave it
+    // to the worker building the parasitic network.
+    if (name)
+      dnet_->conn_pins.push_back({stringCopy(name), line_});
+    return nullptr;
+  }
+  else
+    return findPin(name, line_);
+}
+
+Pin *
+SpefReader::findPin(char *name,
+                    int line)
 {
   Pin *pin = nullptr;
   if (name) {
     char *delim = strrchr(name, delimiter_);
     if (delim) {
       *delim = '\0';
-      name = nameMapLookup(name);
+      const SpefNameMapEntry *entry = resolvedNameMapEntry(name);
+      Instance *inst = nullptr;
+      if (entry) {
+        name = entry->name;
+        inst = entry->instance;
+      }
+      else {
+        name = nameMapLookup(name, line);
+        if (name)
+          inst = findInstanceRelative(name);
+      }
       if (name) {
-        Instance *inst = findInstanceRelative(name);
         // Replace delimiter for error messages.
         *delim = delimiter_;
         const char *port_name = delim + 1;
         if (inst) {
           pin = network_->findPin(inst, port_name);
           if (pin == nullptr)
-            warn(1647, "pin %s not found.", name);
+            warn(1647, line, "pin %s not found.", name);
         }
         else
-          warn(1648, "instance %s not found.", name);
+          warn(1648, line, "instance %s not found.", name);
       }
     }
     else {
       pin = findPortPinRelative(name);
       if (pin == nullptr)
-	warn(1649, "pin %s not found.", name);
+	warn(1649, line, "pin %s not found.", name);
     }
   }
   return pin;
@@ -356,13 +480,28 @@ SpefReader::findPin(char *name)
 
 Net *
 SpefReader::findNet(char *name)
+{
+  return findNet(name, line_);
+}
+
+Net *
+SpefReader::findNet(char *name,
+                    int line)
 {
   Net *net = nullptr;
-  name = nameMapLookup(name);
+  const SpefNameMapEntry *entry = resolvedNameMapEntry(name);
+  if (entry) {
+    name = entry->name;
+    net = entry->net;
+  }
+  else {
+    name = nameMapLookup(name, line);
+    if (name)
+      net = findNetRelative(name);
+  }
   if (name) {
-    net = findNetRelative(name);
     if (net == nullptr)
-      warn(1650, "net %s not found.", name);
+      warn(1650, line, "net %s not found.", name);
   }
   return net;
 }
@@ -371,8 +510,13 @@ void
 SpefReader::rspfBegin(Net *net,
 		      SpefTriple *total_cap)
 {
-  if (net)
+  if (net) {
+    if (read_nets_)
+      read_nets_->insert(net);
+    if (dnet_nets_.hasKey(net))
+      makeDnetParasitics();
     parasitics_->deleteParasitics(net, ap_);
+  }
   // Net total capacitance is ignored.
   delete total_cap;
 }
@@ -419,7 +563,20 @@ void
 SpefReader::dspfBegin(Net *net,
 		      SpefTriple *total_cap)
 {
-  if (net) {
+  if (net && read_nets_)
+    read_nets_->insert(net);
+  if (net && parallel_) {
+    // Finish the parasitic network of an earlier D_NET for the same
+    // net before replacing it.
+    if (dnet_nets_.hasKey(net))
+      makeDnetParasitics();
+    parasitics_->deleteReducedParasitics(net, ap_);
+    parasitic_ = parasitics_->makeParasiticNetwork(net, pin_cap_included_, ap_);
+    net_ = net;
+    dnet_ = new SpefDnet(net, parasitic_);
+    dnet_nets_.insert(net);
+  }
+  else if (net) {
     if (network_->isTopInstance(instance_)) {
       parasitics_->deleteReducedParasitics(net, ap_);
       parasitic_ = parasitics_->makeParasiticNetwork(net, pin_cap_included_, ap_);
@@ -450,7 +607,14 @@ SpefReader::dspfBegin(Net *net,
 void
 SpefReader::dspfFinish()
 {
-  if (parasitic_ && reduce_) {
+  if (dnet_) {
+    dnets_.push_back(dnet_);
+    dnet_elem_count_ += dnet_->elems.size() + 1;
+    dnet_ = nullptr;
+    if (dnet_elem_count_ >= dnet_batch_elem_count)
+      makeDnetParasitics();
+  }
+  else if (parasitic_ && reduceNet(net_)) {
     arc_delay_calc_->reduceParasitic(parasitic_, net_, corner_, min_max_);
     parasitics_->deleteParasiticNetwork(net_, ap_);
   }
@@ -459,80 +623,121 @@ SpefReader::dspfFinish()
 }
 
 ParasiticNode *
-SpefReader::findParasiticNode(char *name,
-			      bool local_only)
+SpefReader::findParasiticNode(Parasitic *parasitic,
+                              const Net *net,
+                              char *name,
+			      bool local_only,
+                              int line)
 {
-  if (name && parasitic_) {
+  if (name && parasitic) {
     char *delim = strrchr(name, delimiter_);
     if (delim) {
       *delim = '\0';
       char *name2 = delim + 1;
-      name = nameMapLookup(name);
+      const SpefNameMapEntry *entry = resolvedNameMapEntry(name);
+      Instance *inst = nullptr;
+      if (entry) {
+        name = entry->name;
+        inst = entry->instance;
+      }
+      else {
+        name = nameMapLookup(name, line);
+        if (name)
+          inst = findInstanceRelative(name);
+      }
       if (name) {
-        Instance *inst = findInstanceRelative(name);
         if (inst) {
           // <instance>:<port>
           Pin *pin = network_->findPin(inst, name2);
           if (pin) {
             if (local_only
-                && !network_->isConnected(net_, pin))
-              warn(1651, "%s not connected to net %s.", name, network_->pathName(net_));
-            return parasitics_->ensureParasiticNode(parasitic_, pin, network_);
+                && !network_->isConnected(net, pin))
+              warn(1651, line, "%s not connected to net %s.",
+                   name, network_->pathName(net));
+            return parasitics_->ensureParasiticNode(parasitic, pin, network_);
           }
           else {
             // Replace delimiter for error message.
             *delim = delimiter_;
-            warn(1652, "pin %s not found.", name);
+            warn(1652, line, "pin %s not found.", name);
           }
         }
         else {
-          Net *net = findNet(name);
+          Net *net1 = entry ? entry->net : nullptr;
+          if (net1 == nullptr)
+            net1 = findNet(name, line);
           // Replace delimiter for error messages.
           *delim = delimiter_;
-          if (net) {
+          if (net1) {
             // <net>:<subnode_id>
             const char *id_str = delim + 1;
             if (isDigits(id_str)) {
               int id = atoi(id_str);
               if (local_only
-                  && !network_->isConnected(net, net_))
-                warn(1653, "%s not connected to net %s.", name, network_->pathName(net_));
-              return parasitics_->ensureParasiticNode(parasitic_, net, id, network_);
+                  && !network_->isConnected(net1, net))
+                warn(1653, line, "%s not connected to net %s.",
+                     name, network_->pathName(net));
+              return parasitics_->ensureParasiticNode(parasitic, net1, id,
+                                                      network_);
             }
             else
-              warn(1654, "node %s not a pin or net:number", name);
+              warn(1654, line, "node %s not a pin or net:number", name);
           }
         }
       }
     }
     else {
       // <top_level_port>
-      name = nameMapLookup(name);
-      Pin *pin = findPortPinRelative(name);
+      const SpefNameMapEntry *entry = resolvedNameMapEntry(name);
+      Pin *pin = nullptr;
+      if (entry) {
+        name = entry->name;
+        pin = entry->port_pin;
+      }
+      else {
+        name = nameMapLookup(name, line);
+        pin = findPortPinRelative(name);
+      }
       if (pin) {
         if (local_only
-            && !network_->isConnected(net_, pin))
-          warn(1655, "%s not connected to net %s.", name, network_->pathName(net_));
-        return parasitics_->ensureParasiticNode(parasitic_, pin, network_);
+            && !network_->isConnected(net, pin))
+          warn(1655, line, "%s not connected to net %s.",
+               name, network_->pathName(net));
+        return parasitics_->ensureParasiticNode(parasitic, pin, network_);
       }
       else
-        warn(1656, "pin %s not found.", name);
+        warn(1656, line, "pin %s not found.", name);
     }
   }
   return nullptr;
 }
 
 void
-SpefReader::makeCapacitor(int, char *node_name,
+SpefReader::makeCapacitor(int id,
+                          char *node_name,
 			  SpefTriple *cap)
 {
-  ParasiticNode *node = findParasiticNode(node_name, true);
-  if (node) {
-    float cap1 = cap->value(triple_index_) * cap_scale_;
-    parasitics_->incrCap(node, cap1);
-  }
+  float cap1 = cap->value(triple_index_) * cap_scale_;
   delete cap;
-  stringDelete(node_name);
+  if (dnet_)
+    dnet_->elems.emplace_back(SpefDnetElem::Type::cap, id, line_,
+                              node_name, nullptr, cap1);
+  else {
+    makeCapacitor(parasitic_, net_, line_, node_name, cap1);
+    stringDelete(node_name);
+  }
+}
+
+void
+SpefReader::makeCapacitor(Parasitic *parasitic,
+                          const Net *net,
+                          int line,
+                          char *node_name,
+                          float cap)
+{
+  ParasiticNode *node = findParasiticNode(parasitic, net, node_name, true, line);
+  if (node)
+    parasitics_->incrCap(node, cap);
 }
 
 void
@@ -541,23 +746,42 @@ SpefReader::makeCapacitor(int id,
 			  char *node_name2,
 			  SpefTriple *cap)
 {
-  ParasiticNode *node1 = findParasiticNode(node_name1, false);
-  ParasiticNode *node2 = findParasiticNode(node_name2, false);
   float cap1 = cap->value(triple_index_) * cap_scale_;
-  if (cap1 > 0.0) {
+  delete cap;
+  if (dnet_)
+    dnet_->elems.emplace_back(SpefDnetElem::Type::coupling_cap, id, line_,
+                              node_name1, node_name2, cap1);
+  else {
+    makeCapacitor(parasitic_, net_, line_, id, node_name1, node_name2, cap1);
+    stringDelete(node_name1);
+    stringDelete(node_name2);
+  }
+}
+
+void
+SpefReader::makeCapacitor(Parasitic *parasitic,
+                          const Net *net,
+                          int line,
+                          int id,
+                          char *node_name1,
+                          char *node_name2,
+                          float cap)
+{
+  ParasiticNode *node1 = findParasiticNode(parasitic, net, node_name1,
+                                           false, line);
+  ParasiticNode *node2 = findParasiticNode(parasitic, net, node_name2,
+                                           false, line);
+  if (cap > 0.0) {
     if (keep_coupling_caps_)
-      parasitics_->makeCapacitor(parasitic_, id, cap1, node1, node2);
+      parasitics_->makeCapacitor(parasitic, id, cap, node1, node2);
     else {
-      float scaled_cap = cap1 * ap_->couplingCapFactor();
-      if (node1 && parasitics_->net(node1, network_) == net_)
+      float scaled_cap = cap * ap_->couplingCapFactor();
+      if (node1 && parasitics_->net(node1, network_) == net)
         parasitics_->incrCap(node1, scaled_cap);
-      if (node2 && parasitics_->net(node2, network_) == net_)
+      if (node2 && parasitics_->net(node2, network_) == net)
         parasitics_->incrCap(node2, scaled_cap);
     }
   }
-  delete cap;
-  stringDelete(node_name1);
-  stringDelete(node_name2);
 }
 
 void
@@ -566,15 +790,142 @@ SpefReader::makeResistor(int id,
 			 char *node_name2,
 			 SpefTriple *res)
 {
-  ParasiticNode *node1 = findParasiticNode(node_name1, true);
-  ParasiticNode *node2 = findParasiticNode(node_name2, true);
-  if (node1 && node2) {
-    float res1 = res->value(triple_index_) * res_scale_;
-    parasitics_->makeResistor(parasitic_, id, res1, node1, node2);
-  }
+  float res1 = res->value(triple_index_) * res_scale_;
   delete res;
-  stringDelete(node_name1);
-  stringDelete(node_name2);
+  if (dnet_)
+    dnet_->elems.emplace_back(SpefDnetElem::Type::res, id, line_,
+                              node_name1, node_name2, res1);
+  else {
+    makeResistor(parasitic_, net_, line_, id, node_name1, node_name2, res1);
+    stringDelete(node_name1);
+    stringDelete(node_name2);
+  }
+}
+
+void
+SpefReader::makeResistor(Parasitic *parasitic,
+                         const Net *net,
+                         int line,
+                         int id,
+                         char *node_name1,
+                         char *node_name2,
+                         float res)
+{
+  ParasiticNode *node1 = findParasiticNode(parasitic, net, node_name1, true, line);
+  ParasiticNode *node2 = findParasiticNode(parasitic, net, node_name2, true, line);
+  if (node1 && node2)
+    parasitics_->makeResistor(parasitic, id, res, node1, node2);
+}
+
+////////////////////////////////////////////////////////////////
+
+// Build the parasitic networks of the recorded D_NETs in parallel.
+// Each worker only touches the parasitic networks of its own D_NETs
+// and reads the network, so name lookups need no locking.
+void
+SpefReader::makeDnetParasitics()
+{
+  if (!dnets_.empty()) {
+    if (reduce_ && arc_delay_calcs_.empty()) {
+      // Reduction needs a delay calculator for each thread.
+      for (int i = 0; i < thread_count_; i++)
+        arc_delay_calcs_.push_back(arc_delay_calc_->copy());
+    }
+    std::atomic<size_t> next_dnet(0);
+    size_t dnet_count = dnets_.size();
+    for (int i = 0; i < thread_count_; i++) {
+      dispatch_queue_->dispatch([this, &next_dnet, dnet_count] (int thread) {
+        ArcDelayCalc *arc_delay_calc = reduce_
+          ? arc_delay_calcs_[thread]
+          : nullptr;
+        for (;;) {
+          size_t from = next_dnet.fetch_add(dnet_chunk_size);
+          if (from >= dnet_count)
+            break;
+          size_t to = std::min(from + dnet_chunk_size, dnet_count);
+          for (size_t j = from; j < to; j++)
+            makeDnetParasitic(dnets_[j], arc_delay_calc);
+        }
+      });
+    }
+    dispatch_queue_->finishTasks();
+
+    for (SpefDnet *dnet : dnets_) {
+      if (reduceNet(dnet->net))
+        parasitics_->deleteParasiticNetwork(dnet->net, ap_);
+      delete dnet;
+    }
+    dnets_.clear();
+    dnet_nets_.clear();
+    dnet_elem_count_ = 0;
+  }
+}
+
+bool
+SpefReader::reduceNet(const Net *net) const
+{
+  return reduce_
+    && !(keep_detailed_nets_
+         && keep_detailed_nets_->hasKey(net));
+}
+
+void
+SpefReader::makeDnetParasitic(const SpefDnet *dnet,
+                              ArcDelayCalc *arc_delay_calc)
+{
+  for (auto &name_line : dnet->conn_pins)
+    findPin(name_line.first, name_line.second);
+  for (const SpefDnetElem &elem : dnet->elems) {
+    switch (elem.type) {
+    case SpefDnetElem::Type::cap:
+      makeCapacitor(dnet->parasitic, dnet->net, elem.line,
+                    elem.node_name1, elem.value);
+      break;
+    case SpefDnetElem::Type::coupling_cap:
+      makeCapacitor(dnet->parasitic, dnet->net, elem.line, elem.id,
+                    elem.node_name1, elem.node_name2, elem.value);
+      break;
+    case SpefDnetElem::Type::res:
+      makeResistor(dnet->parasitic, dnet->net, elem.line, elem.id,
+                   elem.node_name1, elem.node_name2, elem.value);
+      break;
+    }
+  }
+  if (reduceNet(dnet->net))
+    arc_delay_calc->reduceParasitic(dnet->parasitic, dnet->net,
+                                    corner_, min_max_);
+}
+
+SpefDnetElem::SpefDnetElem(Type type,
+                           int id,
+                           int line,
+                           char *node_name1,
+                           char *node_name2,
+                           float value) :
+  type(type),
+  id(id),
+  line(line),
+  node_name1(node_name1),
+  node_name2(node_name2),
+  value(value)
+{
+}
+
+SpefDnet::SpefDnet(const Net *net,
+                   Parasitic *parasitic) :
+  net(net),
+  parasitic(parasitic)
+{
+}
+
+SpefDnet::~SpefDnet()
+{
+  for (auto &name_line : conn_pins)
+    stringDelete(name_line.first);
+  for (SpefDnetElem &elem : elems) {
+    stringDelete(elem.node_name1);
+    stringDelete(elem.node_name2);
+  }
 }
 
 ////////////////////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 
 #include "Zlib.hh"
 #include "MinMax.hh"
+#include "NetworkClass.hh"
 #include "ParasiticsClass.hh"
 
 namespace sta {
@@ -32,6 +33,11 @@ class StaState;
 // In a Spef file with triplet values the first value is used.
 // Constraint min/max cnst_min_max and operating condition op_cond
 // are used for parasitic network reduction.
+// With reduce, each parasitic network is reduced and deleted as soon
+// as it is read unless the net is in keep_detailed_nets (may be null).
+// If parallel is true and there are multiple threads the D_NET
+// parasitic networks are built by worker threads.
+// If read_nets is not null the nets in the file are added to it.
 // Return true if successful.
 bool
 readSpefFile(const char *filename,
@@ -41,8 +47,11 @@ readSpefFile(const char *filename,
 	     bool keep_coupling_caps,
 	     float coupling_cap_factor,
 	     bool reduce,
+             const NetSet *keep_detailed_nets,
 	     const Corner *corner,
 	     const MinMaxAll *min_max,
+             bool parallel,
+             NetSet *read_nets,
 	     StaState *sta);
 
 } // namespace
@@ -17,8 +17,11 @@
 #pragma once
 
 #include <map>
+#include <mutex>
+#include <vector>
+#include <cstdarg>
 
-#include "Zlib.hh"
+#include "InputFile.hh"
 #include "StringSeq.hh"
 #include "NetworkClass.hh"
 #include "ParasiticsClass.hh"
@@ -39,25 +42,45 @@ class Report;
 class MinMaxAll;
 class SpefRspfPi;
 class SpefTriple;
+class SpefDnet;
 class Corner;
+class ArcDelayCalc;
+
+// Name map entry resolved to the netlist objects with its name.
+class SpefNameMapEntry
+{
+public:
+  char *name;
+  Instance *instance;
+  Net *net;
+  Pin *port_pin;
+};
 
 typedef std::map<int, char*, std::less<int>> SpefNameMap;
+typedef std::vector<SpefNameMapEntry> SpefNameMapEntrySeq;
+typedef std::vector<SpefDnet*> SpefDnetSeq;
+typedef std::vector<ArcDelayCalc*> ArcDelayCalcSeq;
 
 class SpefReader : public StaState
 {
 public:
   SpefReader(const char *filename,
-	     gzFile stream,
+	     InputFile *stream,
 	     Instance *instance,
 	     ParasiticAnalysisPt *ap,
 	     bool pin_cap_included,
 	     bool keep_coupling_caps,
 	     float coupling_cap_factor,
 	     bool reduce,
+             const NetSet *keep_detailed_nets,
 	     const Corner *corner,
 	     const MinMaxAll *min_max,
+             bool parallel,
+             NetSet *read_nets,
              StaState *sta);
   virtual ~SpefReader();
+  // Build the parasitic networks of D_NETs that are not finished.
+  void finish();
   char divider() const { return divider_; }
   void setDivider(char divider);
   char delimiter() const { return delimiter_; }
@@ -92,6 +115,9 @@ public:
   void makeNameMapEntry(char *index,
 			char *name);
   char *nameMapLookup(char *index);
+  // Resolve the name map entries to netlist objects after the
+  // name map is read.
+  void resolveNameMap();
   void setDesignFlow(StringSeq *flow_keys);
   Pin *findPin(char *name);
   Net *findNet(char *name);
@@ -124,8 +150,54 @@ private:
   Pin *findPortPinRelative(const char *name);
   Net *findNetRelative(const char *name);
   Instance *findInstanceRelative(const char *name);
-  ParasiticNode *findParasiticNode(char *name,
-                                   bool local_only);
+  // Functions with a line argument are called by workers building
+  // parasitic networks in parallel. They only read the network.
+  void vwarn(int id,
+             int line,
+             const char *fmt,
+             va_list args);
+  void warn(int id,
+            int line,
+            const char *fmt,
+            ...)
+    __attribute__((format (printf, 4, 5)));
+  char *nameMapLookup(char *index,
+                      int line);
+  // Null if name is not a name map index or the name map is not resolved.
+  const SpefNameMapEntry *resolvedNameMapEntry(const char *name) const;
+  Pin *findPin(char *name,
+               int line);
+  Net *findNet(char *name,
+               int line);
+  ParasiticNode *findParasiticNode(Parasitic *parasitic,
+                                   const Net *net,
+                                   char *name,
+                                   bool local_only,
+                                   int line);
+  void makeCapacitor(Parasitic *parasitic,
+                     const Net *net,
+                     int line,
+                     char *node_name,
+                     float cap);
+  void makeCapacitor(Parasitic *parasitic,
+                     const Net *net,
+                     int line,
+                     int id,
+                     char *node_name1,
+                     char *node_name2,
+                     float cap);
+  void makeResistor(Parasitic *parasitic,
+                    const Net *net,
+                    int line,
+                    int id,
+                    char *node_name1,
+                    char *node_name2,
+                    float res);
+  void makeDnetParasitic(const SpefDnet *dnet,
+                         ArcDelayCalc *arc_delay_calc);
+  void makeDnetParasitics();
+  // Reduce the parasitic network of net after it is read.
+  bool reduceNet(const Net *net) const;
 
   const char *filename_;
   Instance *instance_;
@@ -133,10 +205,14 @@ private:
   bool pin_cap_included_;
   bool keep_coupling_caps_;
   bool reduce_;
+  // Nets that keep their detailed parasitic network with reduce_.
+  const NetSet *keep_detailed_nets_;
+  // Nets in the file (may be null).
+  NetSet *read_nets_;
   const Corner *corner_;
   const MinMaxAll *min_max_;
   // Normally no need to keep device names.
-  gzFile stream_;
+  InputFile *stream_;
   int line_;
   char divider_;
   char delimiter_;
@@ -150,8 +226,60 @@ private:
   float res_scale_;
   float induct_scale_;
   SpefNameMap name_map_;
+  // Indexed by name map index.
+  SpefNameMapEntrySeq name_map_entries_;
   StringSeq *design_flow_;
   Parasitic *parasitic_;
+
+  // Parallel mode records D_NET sections while parsing and workers
+  // build their parasitic networks a batch at a time.
+  bool parallel_;
+  // D_NET being recorded.
+  SpefDnet *dnet_;
+  SpefDnetSeq dnets_;
+  size_t dnet_elem_count_;
+  // Nets of dnets_.
+  NetSet dnet_nets_;
+  // Delay calculator for each thread to reduce parasitic networks.
+  ArcDelayCalcSeq arc_delay_calcs_;
+  std::mutex warn_lock_;
+};
+
+// Capacitor or resistor of a recorded D_NET.
+class SpefDnetElem
+{
+public:
+  enum class Type { cap, coupling_cap, res };
+
+  SpefDnetElem(Type type,
+               int id,
+               int line,
+               char *node_name1,
+               char *node_name2,
+               float value);
+
+  Type type;
+  int id;
+  int line;
+  char *node_name1;
+  char *node_name2;
+  // Scaled capacitance or resistance.
+  float value;
+};
+
+// D_NET recorded by the parser in parallel mode.
+class SpefDnet
+{
+public:
+  SpefDnet(const Net *net,
+           Parasitic *parasitic);
+  ~SpefDnet();
+
+  const Net *net;
+  Parasitic *parasitic;
+  // *I connection pin names and lines.
+  std::vector<std::pair<char*, int>> conn_pins;
+  std::vector<SpefDnetElem> elems;
 };
 
 class SpefTriple
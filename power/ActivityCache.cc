@@ -0,0 +1,155 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "ActivityCache.hh"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+#include "Error.hh"
+#include "Report.hh"
+#include "Network.hh"
+#include "CacheNetlist.hh"
+#include "Power.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+// File layout (host byte order):
+//  header    magic[8] version byte_order netlist_checksum activity_count
+//  activity  pin_id activity duty origin
+static const char cache_magic[8] = {'S', 'T', 'A', 'A', 'C', 'T', 'I', 'V'};
+static const uint32_t cache_version = 1;
+static const uint32_t cache_byte_order = 0x01020304;
+
+void
+writeActivityCache(const char *filename,
+                   Sta *sta)
+{
+  Network *network = sta->network();
+  Power *power = sta->power();
+  CacheNetlist netlist(sta);
+  PinSeq pins;
+  for (const Pin *pin : netlist.pins()) {
+    if (power->hasUserActivity(pin))
+      pins.push_back(pin);
+  }
+
+  FILE *stream = fopen(filename, "wb");
+  if (stream == nullptr)
+    throw FileNotWritable(filename);
+  fwrite(cache_magic, sizeof(cache_magic), 1, stream);
+  fwrite(&cache_version, sizeof(cache_version), 1, stream);
+  fwrite(&cache_byte_order, sizeof(cache_byte_order), 1, stream);
+  uint64_t checksum = netlist.checksum();
+  fwrite(&checksum, sizeof(checksum), 1, stream);
+  uint32_t count = pins.size();
+  fwrite(&count, sizeof(count), 1, stream);
+  for (const Pin *pin : pins) {
+    PwrActivity &activity = power->userActivity(pin);
+    ObjectId pin_id = network->id(pin);
+    float value = activity.activity();
+    float duty = activity.duty();
+    uint8_t origin = static_cast<uint8_t>(activity.origin());
+    fwrite(&pin_id, sizeof(pin_id), 1, stream);
+    fwrite(&value, sizeof(value), 1, stream);
+    fwrite(&duty, sizeof(duty), 1, stream);
+    fwrite(&origin, sizeof(origin), 1, stream);
+  }
+  bool failed = ferror(stream);
+  if (fclose(stream) != 0)
+    failed = true;
+  if (failed)
+    sta->report()->error(1684, "write_activity_cache %s failed.", filename);
+}
+
+template <class VALUE>
+static bool
+readValue(FILE *stream,
+          VALUE &value)
+{
+  return fread(&value, sizeof(VALUE), 1, stream) == 1;
+}
+
+bool
+readActivityCache(const char *filename,
+                  Sta *sta)
+{
+  Network *network = sta->network();
+  Report *report = sta->report();
+  Power *power = sta->power();
+  FILE *stream = fopen(filename, "rb");
+  if (stream == nullptr)
+    throw FileNotReadable(filename);
+  char magic[sizeof(cache_magic)];
+  uint32_t version, byte_order, count;
+  uint64_t checksum;
+  if (fread(magic, sizeof(magic), 1, stream) != 1
+      || memcmp(magic, cache_magic, sizeof(magic)) != 0) {
+    fclose(stream);
+    report->warn(1685, "%s is not an activity cache file.", filename);
+    return false;
+  }
+  if (!readValue(stream, version)
+      || !readValue(stream, byte_order)
+      || version != cache_version
+      || byte_order != cache_byte_order) {
+    fclose(stream);
+    report->warn(1686, "activity cache %s version or byte order not supported.",
+                 filename);
+    return false;
+  }
+  CacheNetlist netlist(sta);
+  if (!readValue(stream, checksum)
+      || checksum != netlist.checksum()) {
+    fclose(stream);
+    report->warn(1687, "activity cache %s was written for a different netlist.",
+                 filename);
+    return false;
+  }
+  std::unordered_map<ObjectId, const Pin*> pin_id_map;
+  for (const Pin *pin : netlist.pins())
+    pin_id_map[network->id(pin)] = pin;
+  bool success = readValue(stream, count);
+  for (uint32_t i = 0; success && i < count; i++) {
+    ObjectId pin_id;
+    float activity, duty;
+    uint8_t origin;
+    success = readValue(stream, pin_id)
+      && readValue(stream, activity)
+      && readValue(stream, duty)
+      && readValue(stream, origin)
+      && origin <= static_cast<uint8_t>(PwrActivityOrigin::unknown);
+    if (success) {
+      auto pin_iter = pin_id_map.find(pin_id);
+      if (pin_iter == pin_id_map.end())
+        success = false;
+      else
+        power->setUserActivity(pin_iter->second, activity, duty,
+                               static_cast<PwrActivityOrigin>(origin));
+    }
+  }
+  fclose(stream);
+  if (!success)
+    report->warn(1688, "activity cache %s is corrupt.", filename);
+  else
+    report->reportLine("Annotated %u pin activities.", count);
+  return success;
+}
+
+} // namespace
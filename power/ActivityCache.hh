@@ -0,0 +1,37 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace sta {
+
+class Sta;
+
+// Write the pin activities annotated by read_power_activities and
+// set_power_activity to a binary file keyed by network object ids.
+// The file carries a checksum of the netlist the pins belong to.
+void
+writeActivityCache(const char *filename,
+                   Sta *sta);
+
+// Annotate the pin activities of a file written by writeActivityCache
+// for the same netlist.
+// Return true if successful.
+bool
+readActivityCache(const char *filename,
+                  Sta *sta);
+
+} // namespace
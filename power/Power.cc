@@ -18,10 +18,13 @@
 
 #include <algorithm> // max
 #include <cmath>     // abs
+#include <cstdlib>   // free
 
 #include "Debug.hh"
+#include "DispatchQueue.hh"
 #include "EnumNameMap.hh"
 #include "Hash.hh"
+#include "Mutex.hh"
 #include "MinMax.hh"
 #include "Units.hh"
 #include "Transition.hh"
@@ -76,6 +79,7 @@ static EnumNameMap<PwrActivityOrigin> pwr_activity_origin_map =
    {PwrActivityOrigin::input, "input"},
    {PwrActivityOrigin::user, "user"},
    {PwrActivityOrigin::vcd, "vcd"},
+   {PwrActivityOrigin::saif, "saif"},
    {PwrActivityOrigin::propagated, "propagated"},
    {PwrActivityOrigin::clock, "clock"},
    {PwrActivityOrigin::constant, "constant"},
@@ -86,12 +90,21 @@ Power::Power(StaState *sta) :
   StaState(sta),
   global_activity_{0.0, 0.0, PwrActivityOrigin::unknown},
   input_activity_{0.1, 0.5, PwrActivityOrigin::input},
+  activity_window_(0.0),
+  activity_window_count_(0),
   seq_activity_map_(100, SeqPinHash(network_), SeqPinEqual()),
   activities_valid_(false),
-  bdd_(sta)
+  invalid_activity_pins_(network_),
+  func_evals_(64),
+  bdd_(sim_->bdd())
 {
 }
 
+Power::~Power()
+{
+  func_evals_.deleteContentsClear();
+}
+
 void
 Power::setGlobalActivity(float activity,
 			 float duty)
@@ -117,7 +130,7 @@ Power::setInputPortActivity(const Port *input_port,
   const Pin *pin = network_->findPin(top_inst, input_port);
   if (pin) {
     user_activity_map_[pin] = {activity, duty, PwrActivityOrigin::user};
-    activities_valid_ = false;
+    activityInvalid(pin);
   }
 }
 
@@ -128,7 +141,48 @@ Power::setUserActivity(const Pin *pin,
                        PwrActivityOrigin origin)
 {
   user_activity_map_[pin] = {activity, duty, origin};
-  activities_valid_ = false;
+  activityInvalid(pin);
+}
+
+void
+Power::setActivityWindows(float window,
+                          size_t window_count)
+{
+  activity_window_ = window;
+  activity_window_count_ = window_count;
+  window_activity_map_.clear();
+}
+
+void
+Power::setWindowActivities(const Pin *pin,
+                           const PwrActivity &activity,
+                           PwrActivitySeq &windows)
+{
+  PwrWindowActivities &window_activities = window_activity_map_[pin];
+  window_activities.activity_ = activity;
+  window_activities.windows_.swap(windows);
+  user_activity_map_[pin] = activity;
+  activityInvalid(pin);
+}
+
+void
+Power::selectActivityWindow(int window_index)
+{
+  for (auto &pin_activities : window_activity_map_) {
+    const Pin *pin = pin_activities.first;
+    PwrWindowActivities &window_activities = pin_activities.second;
+    const PwrActivity &activity =
+      (window_index >= 0
+       && static_cast<size_t>(window_index) < window_activities.windows_.size())
+      ? window_activities.windows_[window_index]
+      : window_activities.activity_;
+    PwrActivity &user_activity = user_activity_map_[pin];
+    if (user_activity.activity() != activity.activity()
+        || user_activity.duty() != activity.duty()) {
+      user_activity = activity;
+      activityInvalid(pin);
+    }
+  }
 }
 
 PwrActivity &
@@ -192,6 +246,109 @@ Power::seqActivity(const Instance *reg,
   return seq_activity_map_[SeqPin(reg, output)];
 }
 
+void
+Power::activitiesInvalid()
+{
+  activities_valid_ = false;
+  invalid_activity_pins_.clear();
+  powerInvalid();
+}
+
+void
+Power::powerInvalid()
+{
+  inst_power_caches_.clear();
+}
+
+// Re-propagate activities from pin the next time they are needed.
+void
+Power::activityInvalid(const Pin *pin)
+{
+  if (activities_valid_)
+    invalid_activity_pins_.insert(pin);
+}
+
+// Invalidate pin and the loads it drives.
+void
+Power::wireActivitiesInvalid(const Pin *pin)
+{
+  if (activities_valid_ && graph_) {
+    if (network_->isHierarchical(pin)) {
+      EdgesThruHierPinIterator edge_iter(pin, network_, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        if (edge->isWire())
+          activityInvalid(edge->to(graph_)->pin());
+      }
+    }
+    else {
+      activityInvalid(pin);
+      if (network_->isDriver(pin)) {
+        Vertex *vertex = graph_->pinDrvrVertex(pin);
+        if (vertex) {
+          VertexOutEdgeIterator edge_iter(vertex, graph_);
+          while (edge_iter.hasNext()) {
+            Edge *edge = edge_iter.next();
+            if (edge->isWire())
+              activityInvalid(edge->to(graph_)->pin());
+          }
+        }
+      }
+    }
+  }
+}
+
+void
+Power::connectPinAfter(const Pin *pin)
+{
+  wireActivitiesInvalid(pin);
+}
+
+void
+Power::disconnectPinBefore(const Pin *pin)
+{
+  wireActivitiesInvalid(pin);
+}
+
+void
+Power::deletePinBefore(const Pin *pin)
+{
+  wireActivitiesInvalid(pin);
+  invalid_activity_pins_.erase(pin);
+  activity_map_.erase(pin);
+  user_activity_map_.erase(pin);
+  window_activity_map_.erase(pin);
+}
+
+void
+Power::deleteInstanceBefore(const Instance *inst)
+{
+  instPowerCacheErase(inst);
+  LibertyCell *cell = network_->libertyCell(inst);
+  if (cell) {
+    for (Sequential *seq : cell->sequentials()) {
+      seq_activity_map_.erase(SeqPin(inst, seq->output()));
+      seq_activity_map_.erase(SeqPin(inst, seq->outputInv()));
+    }
+  }
+}
+
+void
+Power::replaceCellAfter(const Instance *inst)
+{
+  instPowerCacheErase(inst);
+  if (activities_valid_) {
+    InstancePinIterator *pin_iter = network_->pinIterator(inst);
+    while (pin_iter->hasNext()) {
+      const Pin *pin = pin_iter->next();
+      activityInvalid(pin);
+    }
+    delete pin_iter;
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
 SeqPinHash::SeqPinHash(const Network *network) :
   network_(network)
 {
@@ -213,6 +370,21 @@ SeqPinEqual::operator()(const SeqPin &pin1,
 
 ////////////////////////////////////////////////////////////////
 
+// Instance power sums by instance type.
+class PowerTypeSums
+{
+public:
+  PowerResult total_;
+  PowerResult sequential_;
+  PowerResult combinational_;
+  PowerResult clock_;
+  PowerResult macro_;
+  PowerResult pad_;
+};
+
+// Instances per power task.
+static const size_t power_inst_chunk_size = 1024;
+
 void
 Power::power(const Corner *corner,
 	     // Return values.
@@ -231,28 +403,73 @@ Power::power(const Corner *corner,
   pad.clear();
 
   ensureActivities();
+  InstanceSeq insts;
   LeafInstanceIterator *inst_iter = network_->leafInstanceIterator();
   while (inst_iter->hasNext()) {
     Instance *inst = inst_iter->next();
-    LibertyCell *cell = network_->libertyCell(inst);
-    if (cell) {
-      PowerResult inst_power = power(inst, cell, corner);
+    if (network_->libertyCell(inst))
+      insts.push_back(inst);
+  }
+  delete inst_iter;
+
+  // Make the cache entries before the threads look them up.
+  InstPowerCacheMap &cache_map = instPowerCache(corner);
+  std::vector<InstPowerCache*> caches;
+  caches.reserve(insts.size());
+  for (const Instance *inst : insts)
+    caches.push_back(&cache_map[inst]);
+
+  // Each chunk of instances is summed separately and the chunk sums
+  // are reduced in order so the results do not depend on the threads.
+  size_t inst_count = insts.size();
+  size_t chunk_count = (inst_count + power_inst_chunk_size - 1)
+    / power_inst_chunk_size;
+  std::vector<PowerTypeSums> chunk_sums(chunk_count);
+  auto sum_chunk = [&] (size_t chunk_index) {
+    PowerTypeSums &sums = chunk_sums[chunk_index];
+    size_t from = chunk_index * power_inst_chunk_size;
+    size_t to = std::min(from + power_inst_chunk_size, inst_count);
+    for (size_t i = from; i < to; i++) {
+      const Instance *inst = insts[i];
+      LibertyCell *cell = network_->libertyCell(inst);
+      PowerResult inst_power = cachedPower(inst, cell, corner, *caches[i]);
       if (cell->isMacro()
 	  || cell->isMemory()
           || cell->interfaceTiming())
-	macro.incr(inst_power);
+	sums.macro_.incr(inst_power);
       else if (cell->isPad())
-	pad.incr(inst_power);
+	sums.pad_.incr(inst_power);
       else if (cell->hasSequentials())
-	sequential.incr(inst_power);
+	sums.sequential_.incr(inst_power);
       else if (inClockNetwork(inst))
-	clock.incr(inst_power);
+	sums.clock_.incr(inst_power);
       else
-	combinational.incr(inst_power);
-      total.incr(inst_power);
+	sums.combinational_.incr(inst_power);
+      sums.total_.incr(inst_power);
     }
+  };
+  // The BDD package is not thread safe.
+  bool parallel = !CUDD && thread_count_ > 1 && chunk_count > 1;
+  if (parallel) {
+    for (size_t chunk_index = 0; chunk_index < chunk_count; chunk_index++)
+      dispatch_queue_->dispatch([&sum_chunk, chunk_index] (int) {
+        sum_chunk(chunk_index);
+      });
+    dispatch_queue_->finishTasks();
+  }
+  else {
+    for (size_t chunk_index = 0; chunk_index < chunk_count; chunk_index++)
+      sum_chunk(chunk_index);
+  }
+
+  for (PowerTypeSums &sums : chunk_sums) {
+    total.incr(sums.total_);
+    sequential.incr(sums.sequential_);
+    combinational.incr(sums.combinational_);
+    clock.incr(sums.clock_);
+    macro.incr(sums.macro_);
+    pad.incr(sums.pad_);
   }
-  delete inst_iter;
 }
 
 bool
@@ -276,37 +493,124 @@ Power::power(const Instance *inst,
 	     const Corner *corner)
 {
   if (network_->isHierarchical(inst)) {
-    PowerResult result;
-    powerInside(inst, corner, result);
-    return result;
+    InstanceSeq insts;
+    insts.push_back(inst);
+    return power(insts, corner)[0];
   }
   LibertyCell *cell = network_->libertyCell(inst);
   if (cell) {
     ensureActivities();
-    return power(inst, cell, corner);
+    return cachedPower(inst, cell, corner, instPowerCache(corner)[inst]);
   }
   return PowerResult();
 }
 
-void
-Power::powerInside(const Instance *hinst,
-                   const Corner *corner,
-                   PowerResult &result)
+PowerResultSeq
+Power::power(const InstanceSeq &insts,
+             const Corner *corner)
 {
-  InstanceChildIterator *child_iter = network_->childIterator(hinst);
-  while (child_iter->hasNext()) {
-    Instance *child = child_iter->next();
-    if (network_->isHierarchical(child))
-      powerInside(child, corner, result);
-    else {
-      LibertyCell *cell = network_->libertyCell(child);
-      if (cell) {
-        PowerResult inst_power = power(child, cell, corner);
-        result.incr(inst_power);
+  ensureActivities();
+  InstanceSeq leafs;
+  std::unordered_set<const Instance*> visited;
+  for (const Instance *inst : insts)
+    findLeafInsts(inst, visited, leafs);
+  PowerResultSeq leaf_powers;
+  leafPowers(leafs, corner, leaf_powers);
+
+  InstPowerMap inst_powers;
+  for (size_t i = 0; i < leafs.size(); i++)
+    inst_powers[leafs[i]] = leaf_powers[i];
+  PowerResultSeq powers;
+  powers.reserve(insts.size());
+  for (const Instance *inst : insts)
+    powers.push_back(rollupPower(inst, inst_powers));
+  return powers;
+}
+
+// Liberty leaf instances at or below inst that have not been visited.
+void
+Power::findLeafInsts(const Instance *inst,
+                     std::unordered_set<const Instance*> &visited,
+                     // Return value.
+                     InstanceSeq &leafs)
+{
+  if (visited.insert(inst).second) {
+    if (network_->isHierarchical(inst)) {
+      InstanceChildIterator *child_iter = network_->childIterator(inst);
+      while (child_iter->hasNext()) {
+        Instance *child = child_iter->next();
+        findLeafInsts(child, visited, leafs);
       }
+      delete child_iter;
     }
+    else if (network_->libertyCell(inst))
+      leafs.push_back(inst);
   }
-  delete child_iter;
+}
+
+// Leaf instance powers found in parallel chunks.
+void
+Power::leafPowers(const InstanceSeq &leafs,
+                  const Corner *corner,
+                  // Return value.
+                  PowerResultSeq &powers)
+{
+  // Make the cache entries before the threads look them up.
+  InstPowerCacheMap &cache_map = instPowerCache(corner);
+  std::vector<InstPowerCache*> caches;
+  caches.reserve(leafs.size());
+  for (const Instance *inst : leafs)
+    caches.push_back(&cache_map[inst]);
+
+  size_t inst_count = leafs.size();
+  powers.resize(inst_count);
+  size_t chunk_count = (inst_count + power_inst_chunk_size - 1)
+    / power_inst_chunk_size;
+  auto power_chunk = [&] (size_t chunk_index) {
+    size_t from = chunk_index * power_inst_chunk_size;
+    size_t to = std::min(from + power_inst_chunk_size, inst_count);
+    for (size_t i = from; i < to; i++) {
+      const Instance *inst = leafs[i];
+      LibertyCell *cell = network_->libertyCell(inst);
+      powers[i] = cachedPower(inst, cell, corner, *caches[i]);
+    }
+  };
+  // The BDD package is not thread safe.
+  bool parallel = !CUDD && thread_count_ > 1 && chunk_count > 1;
+  if (parallel) {
+    for (size_t chunk_index = 0; chunk_index < chunk_count; chunk_index++)
+      dispatch_queue_->dispatch([&power_chunk, chunk_index] (int) {
+        power_chunk(chunk_index);
+      });
+    dispatch_queue_->finishTasks();
+  }
+  else {
+    for (size_t chunk_index = 0; chunk_index < chunk_count; chunk_index++)
+      power_chunk(chunk_index);
+  }
+}
+
+// Sum the power of a hierarchical instance from its children.
+// inst_powers holds the leaf powers and the sums found so far.
+PowerResult
+Power::rollupPower(const Instance *inst,
+                   InstPowerMap &inst_powers)
+{
+  auto itr = inst_powers.find(inst);
+  if (itr != inst_powers.end())
+    return itr->second;
+  PowerResult result;
+  if (network_->isHierarchical(inst)) {
+    InstanceChildIterator *child_iter = network_->childIterator(inst);
+    while (child_iter->hasNext()) {
+      Instance *child = child_iter->next();
+      PowerResult child_power = rollupPower(child, inst_powers);
+      result.incr(child_power);
+    }
+    delete child_iter;
+  }
+  inst_powers[inst] = result;
+  return result;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -337,7 +641,8 @@ class PropActivityVisitor : public VertexVisitor, StaState
 {
 public:
   PropActivityVisitor(Power *power,
-		      BfsFwdIterator *bfs);
+		      BfsFwdIterator *bfs,
+                      ActivitySrchPred *pred);
   virtual VertexVisitor *copy() const;
   virtual void visit(Vertex *vertex);
   InstanceSet &visitedRegs() { return visited_regs_; }
@@ -353,22 +658,26 @@ private:
   float max_change_;
   Power *power_;
   BfsFwdIterator *bfs_;
+  // The bfs_ search predicate.
+  ActivitySrchPred *pred_;
 };
 
 PropActivityVisitor::PropActivityVisitor(Power *power,
-					 BfsFwdIterator *bfs) :
+					 BfsFwdIterator *bfs,
+                                         ActivitySrchPred *pred) :
   StaState(power),
   visited_regs_(network_),
   max_change_(0.0),
   power_(power),
-  bfs_(bfs)
+  bfs_(bfs),
+  pred_(pred)
 {
 }
 
 VertexVisitor *
 PropActivityVisitor::copy() const
 {
-  return new PropActivityVisitor(power_, bfs_);
+  return new PropActivityVisitor(power_, bfs_, pred_);
 }
 
 void
@@ -452,7 +761,7 @@ PropActivityVisitor::visit(Vertex *vertex)
         }
       }
     }
-    bfs_->enqueueAdjacentVertices(vertex);
+    bfs_->enqueueAdjacentVertices(vertex, BoundSearchPred<ActivitySrchPred>(pred_));
   }
 }
 
@@ -512,13 +821,38 @@ Power::evalActivity(FuncExpr *expr,
   if (func_port &&  func_port->direction()->isInternal())
     return findSeqActivity(inst, func_port);
   else {
-    DdNode *bdd = bdd_.funcBdd(expr);
-    float duty = evalBddDuty(bdd, inst);
-    float activity = evalBddActivity(bdd, inst);
+    const PwrFuncEval *eval = findFuncEval(expr, inst);
+    if (eval->hasTruthTable()) {
+      float duties[PwrFuncEval::truth_table_port_max];
+      findPortDuties(eval, inst, duties);
+      float duty = eval->duty(duties);
+      float activity = 0.0;
+      for (size_t i = 0; i < eval->portCount(); i++) {
+        const Pin *pin = findLinkPin(inst, eval, i);
+        if (pin) {
+          PwrActivity var_activity = findActivity(pin);
+          float diff_duty = eval->diffDuty(i, duties);
+          float var_act = var_activity.activity() * diff_duty;
+          activity += var_act;
+          const Clock *clk = findClk(pin);
+          float clk_period = clk ? clk->period() : 1.0;
+          debugPrint(debug_, "power_activity", 3, "var %s %.3e * %.3f = %.3e",
+                     eval->port(i)->name(),
+                     var_activity.activity() / clk_period,
+                     diff_duty,
+                     var_act / clk_period);
+        }
+      }
+      return PwrActivity(activity, duty, PwrActivityOrigin::propagated);
+    }
+    else {
+      DdNode *bdd = bdd_->funcBdd(expr);
+      float duty = evalBddDuty(bdd, inst);
+      float activity = evalBddActivity(bdd, inst);
 
-    Cudd_RecursiveDeref(bdd_.cuddMgr(), bdd);
-    bdd_.clearVarMap();
-    return PwrActivity(activity, duty, PwrActivityOrigin::propagated);
+      Cudd_RecursiveDeref(bdd_->cuddMgr(), bdd);
+      return PwrActivity(activity, duty, PwrActivityOrigin::propagated);
+    }
   }
 }
 
@@ -528,19 +862,51 @@ Power::evalDiffDuty(FuncExpr *expr,
                     LibertyPort *from_port,
                     const Instance *inst)
 {
-  DdNode *bdd = bdd_.funcBdd(expr);
-  DdNode *var_node = bdd_.findNode(from_port);
-  unsigned var_index = Cudd_NodeReadIndex(var_node);
-  DdNode *diff = Cudd_bddBooleanDiff(bdd_.cuddMgr(), bdd, var_index);
-  Cudd_Ref(diff);
-  float duty = evalBddDuty(diff, inst);
+  const PwrFuncEval *eval = findFuncEval(expr, inst);
+  if (eval->hasTruthTable()) {
+    int port_index = eval->portIndex(from_port);
+    if (port_index < 0)
+      return 0.0;
+    float duties[PwrFuncEval::truth_table_port_max];
+    findPortDuties(eval, inst, duties);
+    return eval->diffDuty(port_index, duties);
+  }
+  else {
+    DdNode *bdd = bdd_->funcBdd(expr);
+    DdNode *var_node = bdd_->findNode(from_port);
+    if (var_node == nullptr) {
+      Cudd_RecursiveDeref(bdd_->cuddMgr(), bdd);
+      return 0.0;
+    }
+    unsigned var_index = Cudd_NodeReadIndex(var_node);
+    DdNode *diff = Cudd_bddBooleanDiff(bdd_->cuddMgr(), bdd, var_index);
+    Cudd_Ref(diff);
+    float duty = evalBddDuty(diff, inst);
 
-  Cudd_RecursiveDeref(bdd_.cuddMgr(), diff);
-  Cudd_RecursiveDeref(bdd_.cuddMgr(), bdd);
-  bdd_.clearVarMap();
-  return duty;
+    Cudd_RecursiveDeref(bdd_->cuddMgr(), diff);
+    Cudd_RecursiveDeref(bdd_->cuddMgr(), bdd);
+    return duty;
+  }
 }
 
+void
+Power::findPortDuties(const PwrFuncEval *eval,
+                      const Instance *inst,
+                      // Return value.
+                      float *duties)
+{
+  for (size_t i = 0; i < eval->portCount(); i++) {
+    LibertyPort *port = eval->port(i);
+    if (port->direction()->isInternal())
+      duties[i] = findSeqActivity(inst, port).duty();
+    else {
+      const Pin *pin = findLinkPin(inst, eval, i);
+      duties[i] = pin ? findActivity(pin).duty() : 0.0;
+    }
+  }
+}
+
+// Functions with too many ports for a truth table use BDDs.
 // As suggested by
 // https://stackoverflow.com/questions/63326728/cudd-printminterm-accessing-the-individual-minterms-in-the-sum-of-products
 float
@@ -548,9 +914,9 @@ Power::evalBddDuty(DdNode *bdd,
                    const Instance *inst)
 {
   if (Cudd_IsConstant(bdd)) {
-    if (bdd == Cudd_ReadOne(bdd_.cuddMgr()))
+    if (bdd == Cudd_ReadOne(bdd_->cuddMgr()))
       return 1.0;
-    else if (bdd == Cudd_ReadLogicZero(bdd_.cuddMgr()))
+    else if (bdd == Cudd_ReadLogicZero(bdd_->cuddMgr()))
       return 0.0;
     else
       criticalError(1100, "unknown cudd constant");
@@ -559,8 +925,8 @@ Power::evalBddDuty(DdNode *bdd,
     float duty0 = evalBddDuty(Cudd_E(bdd), inst);
     float duty1 = evalBddDuty(Cudd_T(bdd), inst);
     unsigned int index = Cudd_NodeReadIndex(bdd);
-    int var_index = Cudd_ReadPerm(bdd_.cuddMgr(), index);
-    const LibertyPort *port = bdd_.varIndexPort(var_index);
+    int var_index = Cudd_ReadPerm(bdd_->cuddMgr(), index);
+    const LibertyPort *port = bdd_->varIndexPort(var_index);
     if (port->direction()->isInternal())
       return findSeqActivity(inst, const_cast<LibertyPort*>(port)).duty();
     else {
@@ -586,17 +952,20 @@ Power::evalBddActivity(DdNode *bdd,
                        const Instance *inst)
 {
   float activity = 0.0;
-  for (auto port_var : bdd_.portVarMap()) {
-    const LibertyPort *port = port_var.first;
-    const Pin *pin = findLinkPin(inst, port);
+  // The var map holds the ports of every cached function, so only
+  // visit the variables in the support of bdd.
+  int *support = nullptr;
+  int support_size = Cudd_SupportIndices(bdd_->cuddMgr(), bdd, &support);
+  for (int i = 0; i < support_size; i++) {
+    int var_index = support[i];
+    const LibertyPort *port = bdd_->varIndexPort(var_index);
+    const Pin *pin = port ? findLinkPin(inst, port) : nullptr;
     if (pin) {
       PwrActivity var_activity = findActivity(pin);
-      DdNode *var_node = port_var.second;
-      unsigned int var_index = Cudd_NodeReadIndex(var_node);
-      DdNode *diff = Cudd_bddBooleanDiff(bdd_.cuddMgr(), bdd, var_index);
+      DdNode *diff = Cudd_bddBooleanDiff(bdd_->cuddMgr(), bdd, var_index);
       Cudd_Ref(diff);
       float diff_duty = evalBddDuty(diff, inst);
-      Cudd_RecursiveDeref(bdd_.cuddMgr(), diff);
+      Cudd_RecursiveDeref(bdd_->cuddMgr(), diff);
       float var_act = var_activity.activity() * diff_duty;
       activity += var_act;
       const Clock *clk = findClk(pin);
@@ -608,6 +977,7 @@ Power::evalBddActivity(DdNode *bdd,
                  var_act / clk_period);
     }
   }
+  free(support);
   return activity;
 }
 
@@ -617,87 +987,10 @@ PwrActivity
 Power::evalActivity(FuncExpr *expr,
 		    const Instance *inst)
 {
-  return evalActivity(expr, inst, nullptr, true);
-}
-
-// Eval activity thru expr.
-// With cofactor_port eval the positive/negative cofactor of expr wrt cofactor_port.
-PwrActivity
-Power::evalActivity(FuncExpr *expr,
-		    const Instance *inst,
-		    const LibertyPort *cofactor_port,
-		    bool cofactor_positive)
-{
-  switch (expr->op()) {
-  case FuncExpr::op_port: {
-    LibertyPort *port = expr->port();
-    if (port == cofactor_port) {
-      if (cofactor_positive)
-	return PwrActivity(0.0, 1.0, PwrActivityOrigin::constant);
-      else
-	return PwrActivity(0.0, 0.0, PwrActivityOrigin::constant);
-    }
-    if (port->direction()->isInternal())
-      return findSeqActivity(inst, port);
-    else {
-      Pin *pin = findLinkPin(inst, port);
-      if (pin) {
-        PwrActivity activity = findActivity(pin);
-        activity.setOrigin(PwrActivityOrigin::propagated);
-	return activity;
-      }
-    }
-    return PwrActivity(0.0, 0.0, PwrActivityOrigin::constant);
-  }
-  case FuncExpr::op_not: {
-    PwrActivity activity1 = evalActivity(expr->left(), inst,
-					 cofactor_port, cofactor_positive);
-    return PwrActivity(activity1.activity(),
-		       1.0 - activity1.duty(),
-		       PwrActivityOrigin::propagated);
-  }
-  case FuncExpr::op_or: {
-    PwrActivity activity1 = evalActivity(expr->left(), inst,
-					 cofactor_port, cofactor_positive);
-    PwrActivity activity2 = evalActivity(expr->right(), inst,
-					 cofactor_port, cofactor_positive);
-    float p1 = 1.0 - activity1.duty();
-    float p2 = 1.0 - activity2.duty();
-    return PwrActivity(activity1.activity() * p2 + activity2.activity() * p1,
-		       // d1 + d2 - d1 * d2
-                       1.0 - p1 * p2,
-		       PwrActivityOrigin::propagated);
-  }
-  case FuncExpr::op_and: {
-    PwrActivity activity1 = evalActivity(expr->left(), inst,
-					 cofactor_port, cofactor_positive);
-    PwrActivity activity2 = evalActivity(expr->right(), inst,
-					 cofactor_port, cofactor_positive);
-    float p1 = activity1.duty();
-    float p2 = activity2.duty();
-    return PwrActivity(activity1.activity() * p2 + activity2.activity() * p1,
-		       p1 * p2,
-		       PwrActivityOrigin::propagated);
-  }
-  case FuncExpr::op_xor: {
-    PwrActivity activity1 = evalActivity(expr->left(), inst,
-					 cofactor_port, cofactor_positive);
-    PwrActivity activity2 = evalActivity(expr->right(), inst,
-					 cofactor_port, cofactor_positive);
-    float d1 = activity1.duty();
-    float d2 = activity2.duty();
-    float p1 = d1 * (1.0 - d2);
-    float p2 = (1.0 - d1) * d2;
-    return PwrActivity(activity1.activity() + activity2.activity(),
-		       p1 + p2,
-		       PwrActivityOrigin::propagated);
-  }
-  case FuncExpr::op_one:
-    return PwrActivity(0.0, 1.0, PwrActivityOrigin::constant);
-  case FuncExpr::op_zero:
-    return PwrActivity(0.0, 0.0, PwrActivityOrigin::constant);
-  }
-  return PwrActivity();
+  const PwrFuncEval *eval = findFuncEval(expr, inst);
+  PwrFuncValues<PwrActivity> activities(eval->portCount());
+  findPortActivities(eval, inst, activities.values());
+  return eval->activity(activities.values(), -1, true);
 }
 
 // Eval activity of difference(expr) wrt cofactor port.
@@ -706,15 +999,42 @@ Power::evalDiffDuty(FuncExpr *expr,
                     LibertyPort *cofactor_port,
                     const Instance *inst)
 {
+  const PwrFuncEval *eval = findFuncEval(expr, inst);
+  PwrFuncValues<PwrActivity> activities(eval->portCount());
+  findPortActivities(eval, inst, activities.values());
+  int cofactor_index = eval->portIndex(cofactor_port);
   // Activity of positive/negative cofactors.
-  PwrActivity pos = evalActivity(expr, inst, cofactor_port, true);
-  PwrActivity neg = evalActivity(expr, inst, cofactor_port, false);
+  PwrActivity pos = eval->activity(activities.values(), cofactor_index, true);
+  PwrActivity neg = eval->activity(activities.values(), cofactor_index, false);
   // difference = xor(pos, neg).
   float p1 = pos.duty() * (1.0 - neg.duty());
   float p2 = neg.duty() * (1.0 - pos.duty());
   return p1 + p2;
 }
 
+void
+Power::findPortActivities(const PwrFuncEval *eval,
+                          const Instance *inst,
+                          // Return value.
+                          PwrActivity *activities)
+{
+  for (size_t i = 0; i < eval->portCount(); i++) {
+    LibertyPort *port = eval->port(i);
+    if (port->direction()->isInternal())
+      activities[i] = findSeqActivity(inst, port);
+    else {
+      const Pin *pin = findLinkPin(inst, eval, i);
+      if (pin) {
+        PwrActivity activity = findActivity(pin);
+        activity.setOrigin(PwrActivityOrigin::propagated);
+        activities[i] = activity;
+      }
+      else
+        activities[i] = PwrActivity(0.0, 0.0, PwrActivityOrigin::constant);
+    }
+  }
+}
+
 #endif // CUDD
 
 ////////////////////////////////////////////////////////////////
@@ -728,56 +1048,108 @@ Power::ensureActivities()
       // Clear existing activities.
       activity_map_.clear();
       seq_activity_map_.clear();
+      invalid_activity_pins_.clear();
 
       ActivitySrchPred activity_srch_pred(this);
       BfsFwdIterator bfs(BfsIndex::other, &activity_srch_pred, this);
       seedActivities(bfs);
-      PropActivityVisitor visitor(this, &bfs);
-      // Propagate activities through combinational logic.
-      bfs.visit(levelize_->maxLevel(), &visitor);
-      // Propagate activiities through registers.
-      InstanceSet regs = std::move(visitor.visitedRegs());
-      int pass = 1;
-      while (!regs.empty() && pass < max_activity_passes_) {
-        visitor.init();
-        InstanceSet::Iterator reg_iter(regs);
-	while (reg_iter.hasNext()) {
-	  const Instance *reg = reg_iter.next();
-	  // Propagate activiities across register D->Q.
-	  seedRegOutputActivities(reg, bfs);
-	}
-	// Propagate register output activities through
-	// combinational logic.
-	bfs.visit(levelize_->maxLevel(), &visitor);
-        regs = std::move(visitor.visitedRegs());
-        debugPrint(debug_, "power_activity", 1, "Pass %d change %.2f",
-                   pass, visitor.maxChange());
-        pass++;
-      }
+      PropActivityVisitor visitor(this, &bfs, &activity_srch_pred);
+      propagateActivities(bfs, visitor);
+      activities_valid_ = true;
+    }
+    else if (!invalid_activity_pins_.empty()) {
+      // Only propagate the fanout of pins changed since the last
+      // propagation. Propagation stops at pins where the activity
+      // changes less than the visitor change tolerance.
+      debugPrint(debug_, "power_activity", 1, "Incremental %zu pins",
+                 invalid_activity_pins_.size());
+      ActivitySrchPred activity_srch_pred(this);
+      BfsFwdIterator bfs(BfsIndex::other, &activity_srch_pred, this);
+      seedInvalidActivities(bfs);
+      PropActivityVisitor visitor(this, &bfs, &activity_srch_pred);
+      propagateActivities(bfs, visitor);
+      // setSeqActivity invalidates the activities.
       activities_valid_ = true;
     }
   }
 }
 
+void
+Power::propagateActivities(BfsFwdIterator &bfs,
+                           PropActivityVisitor &visitor)
+{
+  // Propagate activities through combinational logic.
+  bfs.visit(levelize_->maxLevel(), &visitor);
+  // Propagate activiities through registers.
+  InstanceSet regs = std::move(visitor.visitedRegs());
+  int pass = 1;
+  while (!regs.empty() && pass < max_activity_passes_) {
+    visitor.init();
+    InstanceSet::Iterator reg_iter(regs);
+    while (reg_iter.hasNext()) {
+      const Instance *reg = reg_iter.next();
+      // Propagate activiities across register D->Q.
+      seedRegOutputActivities(reg, bfs);
+    }
+    // Propagate register output activities through
+    // combinational logic.
+    bfs.visit(levelize_->maxLevel(), &visitor);
+    regs = std::move(visitor.visitedRegs());
+    debugPrint(debug_, "power_activity", 1, "Pass %d change %.2f",
+               pass, visitor.maxChange());
+    pass++;
+  }
+}
+
 void
 Power::seedActivities(BfsFwdIterator &bfs)
 {
-  for (Vertex *vertex : *levelize_->roots()) {
-    const Pin *pin = vertex->pin();
-    // Clock activities are baked in.
-    if (!sdc_->isLeafPinClock(pin)
-	&& !network_->direction(pin)->isInternal()) {
-      debugPrint(debug_, "power_activity", 3, "seed %s",
+  for (Vertex *vertex : *levelize_->roots())
+    seedActivity(vertex, bfs);
+}
+
+void
+Power::seedActivity(Vertex *vertex,
+                    BfsFwdIterator &bfs)
+{
+  const Pin *pin = vertex->pin();
+  // Clock activities are baked in.
+  if (!sdc_->isLeafPinClock(pin)
+      && !network_->direction(pin)->isInternal()) {
+    debugPrint(debug_, "power_activity", 3, "seed %s",
+               vertex->name(network_));
+    if (hasUserActivity(pin))
+      setActivity(pin, userActivity(pin));
+    else
+      // Default inputs without explicit activities to the input default.
+      setActivity(pin, input_activity_);
+    Vertex *vertex = graph_->pinDrvrVertex(pin);
+    bfs.enqueueAdjacentVertices(vertex);
+  }
+}
+
+void
+Power::seedInvalidActivities(BfsFwdIterator &bfs)
+{
+  for (const Pin *pin : invalid_activity_pins_) {
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    if (vertex) {
+      debugPrint(debug_, "power_activity", 3, "seed invalid %s",
                  vertex->name(network_));
-      if (hasUserActivity(pin))
-	setActivity(pin, userActivity(pin));
-      else
-	// Default inputs without explicit activities to the input default.
-	setActivity(pin, input_activity_);
-      Vertex *vertex = graph_->pinDrvrVertex(pin);
-      bfs.enqueueAdjacentVertices(vertex);
+      // Forget the previous activity so the visitor always sees
+      // a change on the invalid pin and visits its fanout.
+      activity_map_.erase(pin);
+      if (levelize_->isRoot(vertex))
+        seedActivity(vertex, bfs);
+      else {
+        bfs.enqueue(vertex);
+        if (bidirect_drvr_vertex)
+          bfs.enqueue(bidirect_drvr_vertex);
+      }
     }
   }
+  invalid_activity_pins_.clear();
 }
 
 void
@@ -839,14 +1211,108 @@ Power::power(const Instance *inst,
 	     LibertyCell *cell,
 	     const Corner *corner)
 {
-  PowerResult result;
   const Clock *inst_clk = findInstClk(inst);
+  return power(inst, cell, corner, inst_clk);
+}
+
+PowerResult
+Power::power(const Instance *inst,
+	     LibertyCell *cell,
+	     const Corner *corner,
+             const Clock *inst_clk)
+{
+  PowerResult result;
   findInternalPower(inst, cell, corner, inst_clk, result);
   findSwitchingPower(inst, cell, corner, inst_clk, result);
   findLeakagePower(inst, cell, corner, result);
   return result;
 }
 
+// Only look up the liberty power tables when the activities, slews,
+// loads or voltages of the instance change.
+PowerResult
+Power::cachedPower(const Instance *inst,
+                   LibertyCell *cell,
+                   const Corner *corner,
+                   InstPowerCache &cache)
+{
+  const Clock *inst_clk = findInstClk(inst);
+  FloatSeq inputs;
+  inputs.reserve(cache.inputs_.size());
+  findPowerInputs(inst, cell, corner, inst_clk, inputs);
+  if (cache.cell_ != cell
+      || cache.clk_ != inst_clk
+      || cache.inputs_ != inputs) {
+    cache.result_ = power(inst, cell, corner, inst_clk);
+    cache.cell_ = cell;
+    cache.clk_ = inst_clk;
+    cache.inputs_ = std::move(inputs);
+  }
+  return cache.result_;
+}
+
+// Everything the instance power depends on that changes without
+// changing the instance cell.
+void
+Power::findPowerInputs(const Instance *inst,
+                       LibertyCell *cell,
+                       const Corner *corner,
+                       const Clock *inst_clk,
+                       // Return value.
+                       FloatSeq &inputs)
+{
+  const DcalcAnalysisPt *dcalc_ap = corner->findDcalcAnalysisPt(MinMax::max());
+  LibertyCell *corner_cell = cell->cornerCell(dcalc_ap);
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin *pin = pin_iter->next();
+    const LibertyPort *port = network_->libertyPort(pin);
+    if (port) {
+      PwrActivity activity = findActivity(pin);
+      PwrActivity clked_activity = findClkedActivity(pin, inst_clk);
+      inputs.push_back(activity.activity());
+      inputs.push_back(activity.duty());
+      inputs.push_back(clked_activity.activity());
+      if (port->direction()->isAnyOutput()) {
+        inputs.push_back(graph_delay_calc_->loadCap(pin, dcalc_ap));
+        inputs.push_back(portVoltage(corner_cell, port, dcalc_ap));
+      }
+      if (port->direction()->isAnyInput()) {
+        Vertex *vertex = graph_->pinLoadVertex(pin);
+        if (vertex) {
+          for (RiseFall *rf : RiseFall::range())
+            inputs.push_back(getSlew(vertex, rf, corner));
+        }
+      }
+    }
+  }
+  delete pin_iter;
+  for (Sequential *seq : cell->sequentials()) {
+    PwrActivity activity = findSeqActivity(inst, seq->output());
+    PwrActivity activity_inv = findSeqActivity(inst, seq->outputInv());
+    inputs.push_back(activity.activity());
+    inputs.push_back(activity.duty());
+    inputs.push_back(activity_inv.activity());
+    inputs.push_back(activity_inv.duty());
+  }
+}
+
+InstPowerCacheMap &
+Power::instPowerCache(const Corner *corner)
+{
+  size_t index = corner->index();
+  if (index >= inst_power_caches_.size())
+    inst_power_caches_.resize(index + 1);
+  return inst_power_caches_[index];
+}
+
+void
+Power::instPowerCacheErase(const Instance *inst)
+{
+  for (InstPowerCacheMap &cache_map : inst_power_caches_)
+    cache_map.erase(inst);
+}
+
 const Clock *
 Power::findInstClk(const Instance *inst)
 {
@@ -1147,6 +1613,35 @@ Power::findLinkPin(const Instance *inst,
   return network_->findPin(inst, port);
 }
 
+const Pin *
+Power::findLinkPin(const Instance *inst,
+                   const PwrFuncEval *eval,
+                   size_t port_index)
+{
+  LibertyPort *link_port = eval->linkPort(port_index);
+  return link_port ? network_->findPin(inst, link_port) : nullptr;
+}
+
+// Functions are compiled once for each instance cell.
+const PwrFuncEval *
+Power::findFuncEval(const FuncExpr *expr,
+                    const Instance *inst)
+{
+  PwrFuncEval probe(expr, network_->libertyCell(inst));
+  // Lock free lookup for existing evaluators.
+  PwrFuncEval *eval = func_evals_.findKey(&probe);
+  if (eval == nullptr) {
+    UniqueLock lock(func_eval_lock_);
+    eval = func_evals_.findKey(&probe);
+    if (eval == nullptr) {
+      eval = new PwrFuncEval(expr, probe.linkCell());
+      eval->compile();
+      func_evals_.insert(eval);
+    }
+  }
+  return eval;
+}
+
 static bool
 isPositiveUnate(const LibertyCell *cell,
 		const LibertyPort *from,
@@ -1405,6 +1900,14 @@ Power::findClk(const Pin *to_pin)
 
 ////////////////////////////////////////////////////////////////
 
+InstPowerCache::InstPowerCache() :
+  cell_(nullptr),
+  clk_(nullptr)
+{
+}
+
+////////////////////////////////////////////////////////////////
+
 PowerResult::PowerResult() :
   internal_(0.0),
   switching_(0.0),
@@ -16,15 +16,20 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "StaConfig.hh"  // CUDD
 #include "UnorderedMap.hh"
+#include "ConcurrentHashSet.hh"
 #include "Network.hh"
 #include "SdcClass.hh"
 #include "PowerClass.hh"
 #include "StaState.hh"
 #include "Bdd.hh"
+#include "PwrFuncEval.hh"
 
 struct DdNode;
 struct DdManager;
@@ -57,9 +62,38 @@ public:
 		  const SeqPin &pin2) const;
 };
 
+// Instance power and the activities, slews, loads and voltages it
+// was found with.
+class InstPowerCache
+{
+public:
+  InstPowerCache();
+
+  const LibertyCell *cell_;
+  const Clock *clk_;
+  FloatSeq inputs_;
+  PowerResult result_;
+};
+
 typedef UnorderedMap<const Pin*, PwrActivity> PwrActivityMap;
+typedef std::vector<PwrActivity> PwrActivitySeq;
+
+// Activities of a pin over the whole simulation and for each time
+// window of it.
+class PwrWindowActivities
+{
+public:
+  PwrActivity activity_;
+  PwrActivitySeq windows_;
+};
+
+typedef UnorderedMap<const Pin*, PwrWindowActivities> PwrWindowActivityMap;
 typedef UnorderedMap<SeqPin, PwrActivity,
 		     SeqPinHash, SeqPinEqual> PwrSeqActivityMap;
+typedef UnorderedMap<const Instance*, InstPowerCache> InstPowerCacheMap;
+typedef UnorderedMap<const Instance*, PowerResult> InstPowerMap;
+typedef ConcurrentHashSet<PwrFuncEval, PwrFuncEvalHash,
+                          PwrFuncEvalEqual> PwrFuncEvalSet;
 
 // The Power class has access to Sta components directly for
 // convenience but also requires access to the Sta class member functions.
@@ -67,6 +101,7 @@ class Power : public StaState
 {
 public:
   Power(StaState *sta);
+  ~Power();
   void power(const Corner *corner,
 	     // Return values.
 	     PowerResult &total,
@@ -77,6 +112,11 @@ public:
 	     PowerResult &pad);
   PowerResult power(const Instance *inst,
                     const Corner *corner);
+  // Powers of leaf or hierarchical instances. Each leaf instance below
+  // insts is found once and the hierarchical instance powers are
+  // summed bottom up from their children.
+  PowerResultSeq power(const InstanceSeq &insts,
+                       const Corner *corner);
   void setGlobalActivity(float activity,
 			 float duty);
   void setInputActivity(float activity,
@@ -89,17 +129,54 @@ public:
 		       float activity,
 		       float duty,
 		       PwrActivityOrigin origin);
+  bool hasUserActivity(const Pin *pin);
+  PwrActivity &userActivity(const Pin *pin);
   // Activity is toggles per second.
   PwrActivity findClkedActivity(const Pin *pin);
+  // Activities for each time window of window seconds of a simulation.
+  // Clears the window activities of all pins.
+  void setActivityWindows(float window,
+                          size_t window_count);
+  float activityWindow() const { return activity_window_; }
+  size_t activityWindowCount() const { return activity_window_count_; }
+  // set_pin_activity for pin with the whole simulation activity and
+  // the activity for each window.
+  void setWindowActivities(const Pin *pin,
+                           const PwrActivity &activity,
+                           PwrActivitySeq &windows);
+  // Make the activities of window_index the user activities of the
+  // pins with window activities, or the whole simulation activities
+  // when window_index is negative. Only the changed pins are
+  // re-propagated and the instance powers they change recomputed.
+  void selectActivityWindow(int window_index);
+  // Propagate all activities the next time they are needed.
+  void activitiesInvalid();
+  // Find all instance powers the next time they are needed.
+  void powerInvalid();
+  // Network edits only re-propagate activities from the edited pins.
+  void connectPinAfter(const Pin *pin);
+  void disconnectPinBefore(const Pin *pin);
+  void deletePinBefore(const Pin *pin);
+  void deleteInstanceBefore(const Instance *inst);
+  void replaceCellAfter(const Instance *inst);
 
 protected:
   bool inClockNetwork(const Instance *inst);
-  void powerInside(const Instance *hinst,
-                   const Corner *corner,
-                   PowerResult &result);
+  void findLeafInsts(const Instance *inst,
+                     std::unordered_set<const Instance*> &visited,
+                     // Return value.
+                     InstanceSeq &leafs);
+  void leafPowers(const InstanceSeq &leafs,
+                  const Corner *corner,
+                  // Return value.
+                  PowerResultSeq &powers);
+  PowerResult rollupPower(const Instance *inst,
+                          InstPowerMap &inst_powers);
   void ensureActivities();
-  bool hasUserActivity(const Pin *pin);
-  PwrActivity &userActivity(const Pin *pin);
+  void propagateActivities(BfsFwdIterator &bfs,
+                           PropActivityVisitor &visitor);
+  void activityInvalid(const Pin *pin);
+  void wireActivitiesInvalid(const Pin *pin);
   void setSeqActivity(const Instance *reg,
 		      LibertyPort *output,
 		      PwrActivity &activity);
@@ -114,6 +191,22 @@ protected:
   PowerResult power(const Instance *inst,
                     LibertyCell *cell,
                     const Corner *corner);
+  PowerResult power(const Instance *inst,
+                    LibertyCell *cell,
+                    const Corner *corner,
+                    const Clock *inst_clk);
+  PowerResult cachedPower(const Instance *inst,
+                          LibertyCell *cell,
+                          const Corner *corner,
+                          InstPowerCache &cache);
+  void findPowerInputs(const Instance *inst,
+                       LibertyCell *cell,
+                       const Corner *corner,
+                       const Clock *inst_clk,
+                       // Return value.
+                       FloatSeq &inputs);
+  InstPowerCacheMap &instPowerCache(const Corner *corner);
+  void instPowerCacheErase(const Instance *inst);
   void findInternalPower(const Instance *inst,
                          LibertyCell *cell,
                          const Corner *corner,
@@ -166,6 +259,9 @@ protected:
 		      const char *pg_port_name,
 		      const DcalcAnalysisPt *dcalc_ap);
   void seedActivities(BfsFwdIterator &bfs);
+  void seedActivity(Vertex *vertex,
+                    BfsFwdIterator &bfs);
+  void seedInvalidActivities(BfsFwdIterator &bfs);
   void seedRegOutputActivities(const Instance *reg,
 			       Sequential *seq,
 			       LibertyPort *output,
@@ -174,10 +270,16 @@ protected:
 			       BfsFwdIterator &bfs);
   PwrActivity evalActivity(FuncExpr *expr,
 			   const Instance *inst);
-  PwrActivity evalActivity(FuncExpr *expr,
-			   const Instance *inst,
-			   const LibertyPort *cofactor_port,
-			   bool cofactor_positive);
+  const PwrFuncEval *findFuncEval(const FuncExpr *expr,
+                                  const Instance *inst);
+  void findPortActivities(const PwrFuncEval *eval,
+                          const Instance *inst,
+                          // Return value.
+                          PwrActivity *activities);
+  void findPortDuties(const PwrFuncEval *eval,
+                      const Instance *inst,
+                      // Return value.
+                      float *duties);
   LibertyPort *findExprOutPort(FuncExpr *expr);
   float findInputDuty(const Instance *inst,
 		      FuncExpr *func,
@@ -189,6 +291,9 @@ protected:
 			    const LibertyPort *corner_port);
   Pin *findLinkPin(const Instance *inst,
 		   const LibertyPort *corner_port);
+  const Pin *findLinkPin(const Instance *inst,
+                         const PwrFuncEval *eval,
+                         size_t port_index);
   void clockGatePins(const Instance *inst,
                      // Return values.
                      const Pin *&enable,
@@ -207,11 +312,24 @@ private:
   PwrActivity input_activity_;
   // set_pin_activity -input_ports -pins
   PwrActivityMap user_activity_map_;
+  // read_power_activities -window
+  PwrWindowActivityMap window_activity_map_;
+  float activity_window_;
+  size_t activity_window_count_;
   // Propagated activities.
   PwrActivityMap activity_map_;
   PwrSeqActivityMap seq_activity_map_;
   bool activities_valid_;
-  Bdd bdd_;
+  // Pins to propagate activities from incrementally.
+  PinSet invalid_activity_pins_;
+  // Instance powers indexed by corner.
+  std::vector<InstPowerCacheMap> inst_power_caches_;
+  // Compiled functions found without locking; func_eval_lock_
+  // serializes making them.
+  PwrFuncEvalSet func_evals_;
+  std::mutex func_eval_lock_;
+  // Owned by sim_ so function BDDs are shared.
+  Bdd *bdd_;
 
   static constexpr int max_activity_passes_ = 100;
 
@@ -22,6 +22,8 @@
 #include "power/Power.hh"
 #include "power/VcdReader.hh"
 #include "power/ReadVcdActivities.hh"
+#include "power/SaifReader.hh"
+#include "power/ActivityCache.hh"
 
 using namespace sta;
 
@@ -69,6 +71,25 @@ instance_power(Instance *inst,
   return powers;
 }
 
+// Internal, switching, leakage and total power for each instance.
+FloatSeq
+instance_powers(InstanceSeq *insts,
+                const Corner *corner)
+{
+  cmdLinkedNetwork();
+  PowerResultSeq inst_powers = Sta::sta()->power(*insts, corner);
+  delete insts;
+  FloatSeq powers;
+  powers.reserve(inst_powers.size() * 4);
+  for (PowerResult &power : inst_powers) {
+    powers.push_back(power.internal());
+    powers.push_back(power.switching());
+    powers.push_back(power.leakage());
+    powers.push_back(power.total());
+  }
+  return powers;
+}
+
 void
 set_power_global_activity(float activity,
 			  float duty)
@@ -102,9 +123,49 @@ set_power_pin_activity(const Pin *pin,
 
 void
 read_vcd_activities(const char *filename,
-                    const char *scope)
+                    const char *scope,
+                    float window)
+{
+  readVcdActivities(filename, scope, window, Sta::sta());
+}
+
+int
+power_activity_window_count()
+{
+  return Sta::sta()->power()->activityWindowCount();
+}
+
+float
+power_activity_window()
+{
+  return Sta::sta()->power()->activityWindow();
+}
+
+void
+select_power_activity_window(int window_index)
+{
+  Sta::sta()->power()->selectActivityWindow(window_index);
+}
+
+void
+read_saif_activities(const char *filename,
+                     const char *scope)
 {
-  readVcdActivities(filename, scope, Sta::sta());
+  readSaifActivities(filename, scope, Sta::sta());
+}
+
+void
+write_activity_cache_cmd(const char *filename)
+{
+  cmdLinkedNetwork();
+  writeActivityCache(filename, Sta::sta());
+}
+
+bool
+read_activity_cache_cmd(const char *filename)
+{
+  cmdLinkedNetwork();
+  return readActivityCache(filename, Sta::sta());
 }
 
 void
@@ -24,6 +24,7 @@ namespace eval sta {
 
 define_cmd_args "report_power" \
   { [-instances instances]\
+      [-windows]\
       [-corner corner]\
       [-digits digits]\
       [> filename] [>> filename] }
@@ -32,7 +33,7 @@ proc_redirect report_power {
   global sta_report_default_digits
 
   parse_key_args "report_power" args \
-    keys {-instances -corner -digits} flags {}
+    keys {-instances -corner -digits} flags {-windows}
 
   check_argc_eq0 "report_power" $args
   if { [info exists keys(-digits)] } {
@@ -46,6 +47,8 @@ proc_redirect report_power {
   if { [info exists keys(-instances)] } {
     set insts [get_instances_error "-instances" $keys(-instances)]
     report_power_insts $insts $corner $digits
+  } elseif { [info exists flags(-windows)] } {
+    report_power_windows $corner $digits
   } else {
     report_power_design $corner $digits
   }
@@ -159,9 +162,12 @@ proc report_power_line { type pwr digits } {
 
 proc report_power_insts { insts corner digits } {
   set inst_pwrs {}
+  set powers [instance_powers $insts $corner]
+  set i 0
   foreach inst $insts {
-    set power_result [instance_power $inst $corner]
+    set power_result [lrange $powers $i [expr $i + 3]]
     lappend inst_pwrs [list $inst $power_result]
+    incr i 4
   }
   set inst_pwrs [lsort -command inst_pwr_cmp $inst_pwrs]
 
@@ -178,6 +184,29 @@ proc report_power_insts { insts corner digits } {
   }
 }
 
+# Design power for each time window of read_power_activities -window.
+# Each row ends with the window start time.
+proc report_power_windows { corner digits } {
+  set window_count [power_activity_window_count]
+  if { $window_count == 0 } {
+    sta_error 493 "report_power -windows requires read_power_activities -window."
+  }
+  set window [power_activity_window]
+  set field_width [max [expr $digits + 6] 10]
+
+  report_power_title4       "Internal" "Switching" "Leakage" "Total" $field_width
+  report_power_title4_units "Power"    "Power"     "Power"   "Power" "(Watts)" $field_width
+  report_title_dashes4 $field_width
+
+  for { set i 0 } { $i < $window_count } { incr i } {
+    select_power_activity_window $i
+    set power_result [design_power $corner]
+    lassign $power_result internal switching leakage total
+    report_line "[power_col $internal $field_width $digits][power_col $switching $field_width $digits][power_col $leakage $field_width $digits][power_col $total $field_width $digits] [format_time [expr $i * $window] $digits]"
+  }
+  select_power_activity_window -1
+}
+
 proc inst_pwr_cmp { inst_pwr1 inst_pwr2 } {
   set pwr1 [lindex $inst_pwr1 1]
   set pwr2 [lindex $inst_pwr2 1]
@@ -257,11 +286,12 @@ proc set_power_activity { args } {
 
 ################################################################
 
-define_cmd_args "read_power_activities" { [-scope scope] -vcd filename }
+define_cmd_args "read_power_activities" { [-scope scope] [-vcd|-saif]\
+                                              [-window window] filename }
 
 proc read_power_activities { args } {
   parse_key_args "read_power_activities" args \
-    keys {-scope} flags {-vcd}
+    keys {-scope -window} flags {-vcd -saif}
 
   check_argc_eq1 "set_power_activity" $args
   set filename [file nativename [lindex $args 0]]
@@ -269,7 +299,31 @@ proc read_power_activities { args } {
   if { [info exists keys(-scope)] } {
     set scope $keys(-scope)
   }
-  read_vcd_activities $filename $scope
+  set window 0.0
+  if { [info exists keys(-window)] } {
+    set window $keys(-window)
+    check_positive_float "-window" $window
+    set window [time_ui_sta $window]
+  }
+  if { [info exists flags(-saif)] } {
+    read_saif_activities $filename $scope
+  } else {
+    read_vcd_activities $filename $scope $window
+  }
+}
+
+define_cmd_args "write_activity_cache" {filename}
+
+proc write_activity_cache { args } {
+  check_argc_eq1 "write_activity_cache" $args
+  write_activity_cache_cmd [file nativename [lindex $args 0]]
+}
+
+define_cmd_args "read_activity_cache" {filename}
+
+proc read_activity_cache { args } {
+  check_argc_eq1 "read_activity_cache" $args
+  return [read_activity_cache_cmd [file nativename [lindex $args 0]]]
 }
 
 ################################################################
@@ -0,0 +1,169 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "PwrFuncEval.hh"
+
+#include "Hash.hh"
+#include "PortDirection.hh"
+#include "Liberty.hh"
+
+namespace sta {
+
+PwrFuncEval::PwrFuncEval(const FuncExpr *expr,
+                         const LibertyCell *link_cell) :
+  expr_(expr),
+  link_cell_(link_cell),
+  func_eval_(nullptr)
+{
+}
+
+void
+PwrFuncEval::compile()
+{
+  func_eval_ = expr_->eval();
+  for (size_t i = 0; i < func_eval_->portCount(); i++) {
+    LibertyPort *port = func_eval_->port(i);
+    LibertyPort *link_port = nullptr;
+    if (!port->direction()->isInternal() && link_cell_)
+      link_port = link_cell_->findLibertyPort(port->name());
+    link_ports_.push_back(link_port);
+  }
+}
+
+// Same expressions as evaluating the activity recursively on the
+// expression tree.
+PwrActivity
+PwrFuncEval::activity(const PwrActivity *port_activities,
+                      int cofactor_index,
+                      bool cofactor_positive) const
+{
+  PwrFuncValues<PwrActivity> stack(func_eval_->stackSize());
+  size_t top = 0;
+  for (const FuncExprEval::Op &op : func_eval_->ops()) {
+    switch (op.op_) {
+    case FuncExpr::op_port:
+      if (op.port_index_ == cofactor_index)
+        stack[top++] = PwrActivity(0.0, cofactor_positive ? 1.0 : 0.0,
+                                   PwrActivityOrigin::constant);
+      else
+        stack[top++] = port_activities[op.port_index_];
+      break;
+    case FuncExpr::op_not: {
+      PwrActivity &activity1 = stack[top - 1];
+      activity1 = PwrActivity(activity1.activity(),
+                              1.0 - activity1.duty(),
+                              PwrActivityOrigin::propagated);
+      break;
+    }
+    case FuncExpr::op_or: {
+      PwrActivity &activity1 = stack[top - 2];
+      PwrActivity &activity2 = stack[top - 1];
+      float p1 = 1.0 - activity1.duty();
+      float p2 = 1.0 - activity2.duty();
+      activity1 = PwrActivity(activity1.activity() * p2 + activity2.activity() * p1,
+                              // d1 + d2 - d1 * d2
+                              1.0 - p1 * p2,
+                              PwrActivityOrigin::propagated);
+      top--;
+      break;
+    }
+    case FuncExpr::op_and: {
+      PwrActivity &activity1 = stack[top - 2];
+      PwrActivity &activity2 = stack[top - 1];
+      float p1 = activity1.duty();
+      float p2 = activity2.duty();
+      activity1 = PwrActivity(activity1.activity() * p2 + activity2.activity() * p1,
+                              p1 * p2,
+                              PwrActivityOrigin::propagated);
+      top--;
+      break;
+    }
+    case FuncExpr::op_xor: {
+      PwrActivity &activity1 = stack[top - 2];
+      PwrActivity &activity2 = stack[top - 1];
+      float d1 = activity1.duty();
+      float d2 = activity2.duty();
+      float p1 = d1 * (1.0 - d2);
+      float p2 = (1.0 - d1) * d2;
+      activity1 = PwrActivity(activity1.activity() + activity2.activity(),
+                              p1 + p2,
+                              PwrActivityOrigin::propagated);
+      top--;
+      break;
+    }
+    case FuncExpr::op_one:
+      stack[top++] = PwrActivity(0.0, 1.0, PwrActivityOrigin::constant);
+      break;
+    case FuncExpr::op_zero:
+      stack[top++] = PwrActivity(0.0, 0.0, PwrActivityOrigin::constant);
+      break;
+    }
+  }
+  return stack[0];
+}
+
+float
+PwrFuncEval::duty(const float *port_duties) const
+{
+  return tableDuty(func_eval_->truthTable(), port_duties);
+}
+
+float
+PwrFuncEval::diffDuty(size_t index,
+                      const float *port_duties) const
+{
+  return tableDuty(func_eval_->diffTable(index), port_duties);
+}
+
+// Sum the probabilities of the true table entries by removing one port
+// at a time (Shannon expansion).
+float
+PwrFuncEval::tableDuty(uint64_t table,
+                       const float *port_duties) const
+{
+  size_t port_count = func_eval_->portCount();
+  size_t size = size_t(1) << port_count;
+  float probs[size_t(1) << truth_table_port_max];
+  for (size_t i = 0; i < size; i++)
+    probs[i] = (table >> i) & 1;
+  for (size_t port_index = 0; port_index < port_count; port_index++) {
+    float duty = port_duties[port_index];
+    size /= 2;
+    for (size_t i = 0; i < size; i++)
+      probs[i] = probs[2 * i] * (1.0 - duty) + probs[2 * i + 1] * duty;
+  }
+  return probs[0];
+}
+
+////////////////////////////////////////////////////////////////
+
+// The set is only used to find evaluators so pointer hashing does not
+// change any results.
+size_t
+PwrFuncEvalHash::operator()(const PwrFuncEval *eval) const
+{
+  return hashSum(hashPtr(eval->expr()), hashPtr(eval->linkCell()));
+}
+
+bool
+PwrFuncEvalEqual::operator()(const PwrFuncEval *eval1,
+                             const PwrFuncEval *eval2) const
+{
+  return eval1->expr() == eval2->expr()
+    && eval1->linkCell() == eval2->linkCell();
+}
+
+} // namespace
@@ -0,0 +1,118 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "LibertyClass.hh"
+#include "FuncExpr.hh"
+#include "FuncExprEval.hh"
+#include "PowerClass.hh"
+
+namespace sta {
+
+// Compiled function expression (FuncExprEval) with the ports of the
+// link cell for evaluating the activities and duties of its instances.
+class PwrFuncEval
+{
+public:
+  // The key is set by the constructor; call compile before using it.
+  PwrFuncEval(const FuncExpr *expr,
+              const LibertyCell *link_cell);
+  void compile();
+  const FuncExpr *expr() const { return expr_; }
+  const LibertyCell *linkCell() const { return link_cell_; }
+  // Expression ports in the order they are first used.
+  size_t portCount() const { return func_eval_->portCount(); }
+  LibertyPort *port(size_t index) const { return func_eval_->port(index); }
+  // Link cell port for port(index); nullptr for internal ports.
+  LibertyPort *linkPort(size_t index) const { return link_ports_[index]; }
+  // Index of port in the expression ports, -1 if it is not used.
+  int portIndex(const LibertyPort *port) const
+  { return func_eval_->portIndex(port); }
+
+  // Activity of the expression from the activities of its ports
+  // assuming the inputs of each operator are independent.
+  // The port at cofactor_index (if >= 0) is held at cofactor_positive.
+  PwrActivity activity(const PwrActivity *port_activities,
+                       int cofactor_index,
+                       bool cofactor_positive) const;
+
+  // Exact probabilities found from the expression truth table.
+  bool hasTruthTable() const { return func_eval_->hasTruthTable(); }
+  float duty(const float *port_duties) const;
+  // Duty of the boolean difference of the expression wrt port(index),
+  // ie the probability that the expression is sensitive to the port.
+  float diffDuty(size_t index,
+                 const float *port_duties) const;
+
+  static constexpr size_t truth_table_port_max =
+    FuncExprEval::truth_table_port_max;
+
+private:
+  float tableDuty(uint64_t table,
+                  const float *port_duties) const;
+
+  const FuncExpr *expr_;
+  const LibertyCell *link_cell_;
+  const FuncExprEval *func_eval_;
+  std::vector<LibertyPort*> link_ports_;
+};
+
+class PwrFuncEvalHash
+{
+public:
+  size_t operator()(const PwrFuncEval *eval) const;
+};
+
+class PwrFuncEvalEqual
+{
+public:
+  bool operator()(const PwrFuncEval *eval1,
+                  const PwrFuncEval *eval2) const;
+};
+
+// Values indexed by function port or operator stack depth that are
+// kept on the stack for small functions.
+template <class VALUE>
+class PwrFuncValues
+{
+public:
+  explicit PwrFuncValues(size_t size) :
+    values_(buffer_)
+  {
+    if (size > buffer_size_) {
+      vector_.resize(size);
+      values_ = vector_.data();
+    }
+  }
+  VALUE *values() { return values_; }
+  VALUE &operator[](size_t index) { return values_[index]; }
+
+  // Deleted operations
+  PwrFuncValues(const PwrFuncValues &values) = delete;
+  PwrFuncValues &operator=(const PwrFuncValues &values) = delete;
+
+private:
+  static constexpr size_t buffer_size_ = 16;
+  VALUE buffer_[buffer_size_];
+  std::vector<VALUE> vector_;
+  VALUE *values_;
+};
+
+} // namespace
@@ -16,8 +16,6 @@
 
 #include "ReadVcdActivities.hh"
 
-#include <inttypes.h>
-
 #include "VcdReader.hh"
 #include "Debug.hh"
 #include "Network.hh"
@@ -39,6 +37,7 @@ class ReadVcdActivities : public StaState
 public:
   ReadVcdActivities(const char *filename,
                     const char *scope,
+                    float window,
                     Sta *sta);
   void readActivities();
 
@@ -46,21 +45,24 @@ private:
   void setActivities();
   void setVarActivity(VcdVar *var,
                       string &var_name,
-                      const VcdValues &var_value);
+                      const VcdBitActivities &bit_activities);
   void setVarActivity(const char *pin_name,
-                      const VcdValues &var_values,
-                      int value_bit);
-  void findVarActivity(const VcdValues &var_values,
-                       int value_bit,
+                      const VcdBitActivity &bit_activity);
+  void findVarActivity(const VcdBitActivity &bit_activity,
                        // Return values.
                        double &transition_count,
                        double &activity,
                        double &duty);
+  void findWindowActivities(const VcdBitActivity &bit_activity,
+                            // Return value.
+                            PwrActivitySeq &windows);
   void checkClkPeriod(const Pin *pin,
                       double transition_count);
 
   const char *filename_;
   const char *scope_;
+  float window_;
+  size_t window_count_;
   Vcd vcd_;
   double clk_period_;
   Sta *sta_;
@@ -73,18 +75,22 @@ private:
 void
 readVcdActivities(const char *filename,
                   const char *scope,
+                  float window,
                   Sta *sta)
 {
-  ReadVcdActivities reader(filename, scope, sta);
+  ReadVcdActivities reader(filename, scope, window, sta);
   reader.readActivities();
 }
 
 ReadVcdActivities::ReadVcdActivities(const char *filename,
                                      const char *scope,
+                                     float window,
                                      Sta *sta) :
   StaState(sta),
   filename_(filename),
   scope_(scope),
+  window_(window),
+  window_count_(0),
   vcd_(sta),
   clk_period_(0.0),
   sta_(sta),
@@ -95,14 +101,21 @@ ReadVcdActivities::ReadVcdActivities(const char *filename,
 void
 ReadVcdActivities::readActivities()
 {
-  vcd_ = readVcdFile(filename_, sta_);
+  // Only the activities are needed so do not keep the value history.
+  vcd_ = readVcdFile(filename_, false, sta_, window_);
 
   clk_period_ = INF;
   for (Clock *clk : *sta_->sdc()->clocks())
     clk_period_ = min(static_cast<double>(clk->period()), clk_period_);
 
-  if (vcd_.timeMax() > 0)
+  if (vcd_.timeMax() > 0) {
+    if (vcd_.window()) {
+      window_count_ = (vcd_.timeMax() + vcd_.window() - 1) / vcd_.window();
+      power_->setActivityWindows(vcd_.window() * vcd_.timeScale(),
+                                 window_count_);
+    }
     setActivities();
+  }
   else
     report_->warn(1450, "VCD max time is zero.");
   report_->reportLine("Annotated %lu pin activities.", annotated_pins_.size());
@@ -113,8 +126,9 @@ ReadVcdActivities::setActivities()
 {
   size_t scope_length = strlen(scope_);
   for (VcdVar *var : vcd_.vars()) {
-    const VcdValues &var_values = vcd_.values(var);
-    if (!var_values.empty()
+    const VcdBitActivities &bit_activities = vcd_.bitActivities(var);
+    if (!bit_activities.empty()
+        && bit_activities[0].hasValue()
         && (var->type() == VcdVarType::wire
             || var->type() == VcdVarType::reg)) {
       string var_name = var->name();
@@ -122,11 +136,11 @@ ReadVcdActivities::setActivities()
       if (scope_length) {
         if (var_name.substr(0, scope_length) == scope_) {
           var_name = var_name.substr(scope_length + 1);
-          setVarActivity(var, var_name, var_values);
+          setVarActivity(var, var_name, bit_activities);
         }
       }
       else
-        setVarActivity(var, var_name, var_values);
+        setVarActivity(var, var_name, bit_activities);
     }
   }
 }
@@ -134,11 +148,11 @@ ReadVcdActivities::setActivities()
 void
 ReadVcdActivities::setVarActivity(VcdVar *var,
                                   string &var_name,
-                                  const VcdValues &var_values)
+                                  const VcdBitActivities &bit_activities)
 {
   if (var->width() == 1) {
     string sta_name = netVerilogToSta(var_name.c_str());
-    setVarActivity(sta_name.c_str(), var_values, 0);
+    setVarActivity(sta_name.c_str(), bit_activities[0]);
   }
   else {
     bool is_bus, is_range, subscript_wild;
@@ -148,24 +162,29 @@ ReadVcdActivities::setVarActivity(VcdVar *var,
                  is_bus, is_range, bus_name, from, to, subscript_wild);
     if (is_bus) {
       string sta_bus_name = netVerilogToSta(bus_name.c_str());
+      int bit_count = bit_activities.size();
       int value_bit = 0;
       if (to < from) {
-        for (int bus_bit = to; bus_bit <= from; bus_bit++) {
+        for (int bus_bit = to;
+             bus_bit <= from && value_bit < bit_count;
+             bus_bit++) {
           string pin_name = sta_bus_name;
           pin_name += '[';
           pin_name += to_string(bus_bit);
           pin_name += ']';
-          setVarActivity(pin_name.c_str(), var_values, value_bit);
+          setVarActivity(pin_name.c_str(), bit_activities[value_bit]);
           value_bit++;
         }
       }
       else {
-        for (int bus_bit = to; bus_bit >= from; bus_bit--) {
+        for (int bus_bit = to;
+             bus_bit >= from && value_bit < bit_count;
+             bus_bit--) {
           string pin_name = sta_bus_name;
           pin_name += '[';
           pin_name += to_string(bus_bit);
           pin_name += ']';
-          setVarActivity(pin_name.c_str(), var_values, value_bit);
+          setVarActivity(pin_name.c_str(), bit_activities[value_bit]);
           value_bit++;
         }
       }
@@ -177,15 +196,12 @@ ReadVcdActivities::setVarActivity(VcdVar *var,
 
 void
 ReadVcdActivities::setVarActivity(const char *pin_name,
-                                  const VcdValues &var_values,
-                                  int value_bit)
+                                  const VcdBitActivity &bit_activity)
 {
   const Pin *pin = sdc_network_->findPin(pin_name);
   if (pin) {
-    debugPrint(debug_, "read_vcd_activities", 3, "%s values", pin_name);
     double transition_count, activity, duty;
-    findVarActivity(var_values, value_bit,
-                    transition_count, activity, duty);
+    findVarActivity(bit_activity, transition_count, activity, duty);
     debugPrint(debug_, "read_vcd_activities", 1,
                "%s transitions %.1f activity %.2f duty %.2f",
                pin_name,
@@ -194,46 +210,53 @@ ReadVcdActivities::setVarActivity(const char *pin_name,
                duty);
     if (sdc_->isLeafPinClock(pin))
       checkClkPeriod(pin, transition_count);
-    power_->setUserActivity(pin, activity, duty, PwrActivityOrigin::vcd);
+    if (window_count_ > 0) {
+      PwrActivitySeq windows;
+      findWindowActivities(bit_activity, windows);
+      power_->setWindowActivities(pin, PwrActivity(activity, duty,
+                                                   PwrActivityOrigin::vcd),
+                                  windows);
+    }
+    else
+      power_->setUserActivity(pin, activity, duty, PwrActivityOrigin::vcd);
     annotated_pins_.insert(pin);
   }
 }
 
 void
-ReadVcdActivities::findVarActivity(const VcdValues &var_values,
-                                   int value_bit,
+ReadVcdActivities::findVarActivity(const VcdBitActivity &bit_activity,
                                    // Return values.
                                    double &transition_count,
                                    double &activity,
                                    double &duty)
 {
-  transition_count = 0.0;
-  char prev_value = var_values[0].value(value_bit);
-  VcdTime prev_time = var_values[0].time();
-  VcdTime high_time = 0;
-  for (const VcdValue &var_value : var_values) {
-    VcdTime time = var_value.time();
-    char value = var_value.value(value_bit);
-    debugPrint(debug_, "read_vcd_activities", 3, " %" PRId64 " %c", time, value);
-    if (prev_value == '1')
-      high_time += time - prev_time;
-    if (value != prev_value)
-      transition_count += (value == 'X'
-                           || value == 'Z'
-                           || prev_value == 'X'
-                           || prev_value == 'Z')
-        ? .5
-        : 1.0;
-    prev_time = time;
-    prev_value = value;
-  }
+  transition_count = bit_activity.transitionCount();
   VcdTime time_max = vcd_.timeMax();
-  if (prev_value == '1')
-    high_time += time_max - prev_time;
+  VcdTime high_time = bit_activity.highTime(time_max);
   duty = static_cast<double>(high_time) / time_max;
   activity = transition_count / (time_max * vcd_.timeScale() / clk_period_);
 }
 
+void
+ReadVcdActivities::findWindowActivities(const VcdBitActivity &bit_activity,
+                                        // Return value.
+                                        PwrActivitySeq &windows)
+{
+  VcdTime time_max = vcd_.timeMax();
+  VcdTime window = vcd_.window();
+  windows.reserve(window_count_);
+  for (size_t i = 0; i < window_count_; i++) {
+    // The last window ends at time_max.
+    VcdTime window_time = min(window, time_max - static_cast<VcdTime>(i * window));
+    double transition_count = bit_activity.windowTransitionCount(i);
+    VcdTime high_time = bit_activity.windowHighTime(i, time_max, window);
+    double duty = static_cast<double>(high_time) / window_time;
+    double activity = transition_count
+      / (window_time * vcd_.timeScale() / clk_period_);
+    windows.emplace_back(activity, duty, PwrActivityOrigin::vcd);
+  }
+}
+
 void
 ReadVcdActivities::checkClkPeriod(const Pin *pin,
                                   double transition_count)
@@ -20,9 +20,12 @@ namespace sta {
 
 class Sta;
 
+// With a non-zero window (seconds) the activities are also found for
+// each time window of the simulation (see Power::setWindowActivities).
 void
 readVcdActivities(const char *filename,
                   const char *scope,
+                  float window,
                   Sta *sta);
 
 } // namespace
@@ -0,0 +1,405 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "SaifReader.hh"
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "InputFile.hh"
+#include "Error.hh"
+#include "Report.hh"
+#include "Debug.hh"
+#include "Network.hh"
+#include "Sdc.hh"
+#include "Power.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+using std::string;
+using std::vector;
+using std::isspace;
+
+typedef Set<const Pin*> ConstPinSet;
+
+// Recursive descent parser for the parenthesized SAIF syntax.
+// Only the state durations of NET and PORT signals are used.
+// https://web.archive.org/web/20080323074842/http://www.cadence.com/whitepapers/saif.pdf
+class SaifReader : public StaState
+{
+public:
+  SaifReader(const char *filename,
+             const char *scope,
+             Sta *sta);
+  ~SaifReader();
+  void read();
+
+private:
+  void parseStmt();
+  void parseTimescale();
+  void parseDuration();
+  void parseInstance();
+  void parseSignals();
+  void parseSignal(const string &name);
+  void skipList();
+  void setPinActivity(const string &name,
+                      double t1,
+                      double tc);
+  string getToken();
+  string getListToken();
+  void checkToken(const string &token,
+                  const char *expected);
+  double parseNumber(const string &token);
+  static string unescaped(const string &name);
+
+  const char *filename_;
+  string scope_;
+  InputFile stream_;
+  int ch_;
+  int line_;
+  // Instance path of the current SAIF scope.
+  vector<string> path_;
+  double timescale_;
+  double duration_;
+  double clk_period_;
+  Power *power_;
+  ConstPinSet annotated_pins_;
+};
+
+void
+readSaifActivities(const char *filename,
+                   const char *scope,
+                   Sta *sta)
+{
+  SaifReader reader(filename, scope, sta);
+  reader.read();
+}
+
+SaifReader::SaifReader(const char *filename,
+                       const char *scope,
+                       Sta *sta) :
+  StaState(sta),
+  filename_(filename),
+  scope_(scope),
+  ch_(' '),
+  line_(1),
+  timescale_(1e-9),
+  duration_(0.0),
+  clk_period_(INF),
+  power_(sta->power())
+{
+}
+
+SaifReader::~SaifReader()
+{
+}
+
+void
+SaifReader::read()
+{
+  if (!stream_.open(filename_))
+    throw FileNotReadable(filename_);
+  for (Clock *clk : *sdc_->clocks())
+    clk_period_ = std::min(static_cast<double>(clk->period()), clk_period_);
+
+  checkToken(getToken(), "(");
+  if (getToken() != "SAIFILE")
+    report_->fileError(1460, filename_, line_, "not a SAIF file.");
+  string token = getListToken();
+  while (token != ")") {
+    checkToken(token, "(");
+    parseStmt();
+    token = getListToken();
+  }
+  stream_.close();
+
+  if (duration_ <= 0.0)
+    report_->warn(1461, "SAIF duration is zero.");
+  report_->reportLine("Annotated %lu pin activities.", annotated_pins_.size());
+}
+
+// Statement after its opening paren.
+void
+SaifReader::parseStmt()
+{
+  string keyword = getListToken();
+  if (keyword == "TIMESCALE")
+    parseTimescale();
+  else if (keyword == "DURATION")
+    parseDuration();
+  else if (keyword == "INSTANCE")
+    parseInstance();
+  else
+    skipList();
+}
+
+void
+SaifReader::parseTimescale()
+{
+  string value;
+  string token = getListToken();
+  while (token != ")") {
+    value += token;
+    token = getListToken();
+  }
+  size_t unit_pos = 0;
+  double scale = 0.0;
+  try {
+    scale = std::stod(value, &unit_pos);
+  }
+  catch (std::exception &) {
+    report_->fileError(1462, filename_, line_, "timescale syntax error.");
+  }
+  string unit = value.substr(unit_pos);
+  double unit_scale;
+  if (unit == "fs")
+    unit_scale = 1e-15;
+  else if (unit == "ps")
+    unit_scale = 1e-12;
+  else if (unit == "ns")
+    unit_scale = 1e-9;
+  else if (unit == "us")
+    unit_scale = 1e-6;
+  else if (unit == "ms")
+    unit_scale = 1e-3;
+  else if (unit == "s")
+    unit_scale = 1.0;
+  else {
+    report_->fileError(1463, filename_, line_, "unknown timescale unit %s.",
+                       unit.c_str());
+    unit_scale = 1.0;
+  }
+  timescale_ = scale * unit_scale;
+}
+
+void
+SaifReader::parseDuration()
+{
+  duration_ = parseNumber(getListToken());
+  checkToken(getListToken(), ")");
+}
+
+// (INSTANCE ["cell"] name stmts...)
+void
+SaifReader::parseInstance()
+{
+  string name = getListToken();
+  if (name[0] == '"')
+    name = getListToken();
+  path_.push_back(unescaped(name));
+  string token = getListToken();
+  while (token != ")") {
+    checkToken(token, "(");
+    string keyword = getListToken();
+    if (keyword == "NET"
+        || keyword == "PORT")
+      parseSignals();
+    else if (keyword == "INSTANCE")
+      parseInstance();
+    else
+      skipList();
+    token = getListToken();
+  }
+  path_.pop_back();
+}
+
+// (NET|PORT (name durations...)...)
+void
+SaifReader::parseSignals()
+{
+  string token = getListToken();
+  while (token != ")") {
+    checkToken(token, "(");
+    parseSignal(getListToken());
+    token = getListToken();
+  }
+}
+
+// (name (T0 value) (T1 value) (TC value) ...)
+void
+SaifReader::parseSignal(const string &name)
+{
+  double t1 = 0.0;
+  double tc = 0.0;
+  string token = getListToken();
+  while (token != ")") {
+    checkToken(token, "(");
+    string keyword = getListToken();
+    if (keyword == "T1") {
+      t1 = parseNumber(getListToken());
+      checkToken(getListToken(), ")");
+    }
+    else if (keyword == "TC") {
+      tc = parseNumber(getListToken());
+      checkToken(getListToken(), ")");
+    }
+    else
+      // T0, TX, TZ, TB, IG, COND ...
+      skipList();
+    token = getListToken();
+  }
+  setPinActivity(unescaped(name), t1, tc);
+}
+
+// Skip to the close paren matching the already read open paren.
+void
+SaifReader::skipList()
+{
+  int depth = 1;
+  while (depth > 0) {
+    string token = getListToken();
+    if (token == "(")
+      depth++;
+    else if (token == ")")
+      depth--;
+  }
+}
+
+void
+SaifReader::setPinActivity(const string &name,
+                           double t1,
+                           double tc)
+{
+  if (duration_ <= 0.0 || path_.empty())
+    return;
+  // Path of the instance relative to the top instance.
+  string inst_path;
+  if (scope_.empty()) {
+    for (size_t i = 1; i < path_.size(); i++) {
+      inst_path += path_[i];
+      inst_path += '/';
+    }
+  }
+  else {
+    string path;
+    for (const string &inst_name : path_) {
+      path += inst_name;
+      path += '/';
+    }
+    size_t scope_length = scope_.size();
+    // string::starts_with in c++20
+    if (path.size() <= scope_length
+        || path.compare(0, scope_length, scope_) != 0
+        || path[scope_length] != '/')
+      return;
+    inst_path = path.substr(scope_length + 1);
+  }
+  string pin_name = inst_path + name;
+  const Pin *pin = sdc_network_->findPin(pin_name.c_str());
+  if (pin) {
+    double duty = t1 / duration_;
+    double activity = tc / (duration_ * timescale_ / clk_period_);
+    debugPrint(debug_, "read_saif_activities", 1,
+               "%s transitions %.1f activity %.2f duty %.2f",
+               pin_name.c_str(),
+               tc,
+               activity,
+               duty);
+    power_->setUserActivity(pin, activity, duty, PwrActivityOrigin::saif);
+    annotated_pins_.insert(pin);
+  }
+}
+
+// Remove the escapes of escaped characters.
+string
+SaifReader::unescaped(const string &name)
+{
+  string result;
+  for (size_t i = 0; i < name.size(); i++) {
+    if (name[i] == '\\' && i + 1 < name.size())
+      i++;
+    result += name[i];
+  }
+  return result;
+}
+
+double
+SaifReader::parseNumber(const string &token)
+{
+  char *end;
+  double value = strtod(token.c_str(), &end);
+  if (*end != '\0')
+    report_->fileError(1464, filename_, line_, "%s is not a number.",
+                       token.c_str());
+  return value;
+}
+
+void
+SaifReader::checkToken(const string &token,
+                       const char *expected)
+{
+  if (token != expected)
+    report_->fileError(1465, filename_, line_, "syntax error, expected %s.",
+                       expected);
+}
+
+// Token inside a list, which cannot be the end of the file.
+string
+SaifReader::getListToken()
+{
+  string token = getToken();
+  if (token.empty())
+    report_->fileError(1466, filename_, line_, "unexpected end of file.");
+  return token;
+}
+
+// Return a paren, a quoted string or a name/number.
+// Return an empty string at the end of the file.
+string
+SaifReader::getToken()
+{
+  while (ch_ != EOF && isspace(ch_)) {
+    if (ch_ == '\n')
+      line_++;
+    ch_ = stream_.getc();
+  }
+  string token;
+  if (ch_ == EOF)
+    return token;
+  if (ch_ == '(' || ch_ == ')') {
+    token.push_back(ch_);
+    ch_ = stream_.getc();
+  }
+  else if (ch_ == '"') {
+    do {
+      token.push_back(ch_);
+      ch_ = stream_.getc();
+    } while (ch_ != EOF && ch_ != '"');
+    token.push_back('"');
+    ch_ = stream_.getc();
+  }
+  else {
+    while (ch_ != EOF
+           && !isspace(ch_)
+           && ch_ != '('
+           && ch_ != ')') {
+      token.push_back(ch_);
+      if (ch_ == '\\') {
+        // Escaped character.
+        ch_ = stream_.getc();
+        if (ch_ == EOF)
+          break;
+        token.push_back(ch_);
+      }
+      ch_ = stream_.getc();
+    }
+  }
+  return token;
+}
+
+} // namespace
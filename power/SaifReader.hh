@@ -0,0 +1,32 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace sta {
+
+class Sta;
+
+// Annotate the pin activities of a SAIF (switching activity
+// interchange format) file with Power::setUserActivity.
+// scope is the SAIF instance path of the top instance. If it is empty
+// the outermost SAIF instance is the top instance.
+void
+readSaifActivities(const char *filename,
+                   const char *scope,
+                   Sta *sta);
+
+} // namespace
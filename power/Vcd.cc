@@ -26,6 +26,8 @@ Vcd::Vcd(StaState *sta) :
   time_unit_scale_(1.0),
   max_var_name_length_(0),
   max_var_width_(0),
+  keep_values_(true),
+  window_(0),
   min_delta_time_(0),
   time_max_(0)
 {
@@ -44,6 +46,9 @@ Vcd::Vcd(const Vcd &vcd) :
   max_var_name_length_(vcd.max_var_name_length_),
   max_var_width_(vcd.max_var_width_),
   id_values_map_(vcd.id_values_map_),
+  keep_values_(vcd.keep_values_),
+  id_activities_map_(vcd.id_activities_map_),
+  window_(vcd.window_),
   min_delta_time_(vcd.min_delta_time_),
   time_max_(vcd.time_max_)
 {
@@ -63,6 +68,9 @@ Vcd::operator=(Vcd &&vcd1)
   max_var_name_length_ = vcd1.max_var_name_length_;
   max_var_width_ = vcd1.max_var_width_;
   id_values_map_ = vcd1.id_values_map_;
+  keep_values_ = vcd1.keep_values_;
+  id_activities_map_ = vcd1.id_activities_map_;
+  window_ = vcd1.window_;
   min_delta_time_ = vcd1.min_delta_time_;
   time_max_ = vcd1.time_max_;
 
@@ -108,6 +116,18 @@ Vcd::setTimeScale(double time_scale)
   time_scale_ = time_scale;
 }
 
+void
+Vcd::setKeepValues(bool keep_values)
+{
+  keep_values_ = keep_values;
+}
+
+void
+Vcd::setWindow(VcdTime window)
+{
+  window_ = window;
+}
+
 void
 Vcd::setMinDeltaTime(VcdTime min_delta_time)
 {
@@ -133,6 +153,11 @@ Vcd::makeVar(string &name,
   max_var_width_ = std::max(max_var_width_, width);
   // Make entry for var ID.
   id_values_map_[id].clear();
+  if (!keep_values_) {
+    VcdBitActivities &activities = id_activities_map_[id];
+    if (activities.size() < static_cast<size_t>(width))
+      activities.resize(width);
+  }
 }
 
 VcdVar *
@@ -152,8 +177,14 @@ Vcd::varAppendValue(string &id,
                     VcdTime time,
                     char value)
 {
-  VcdValues &values = id_values_map_[id];
-  values.emplace_back(time, value, 0);
+  if (keep_values_) {
+    VcdValues &values = id_values_map_[id];
+    values.emplace_back(time, value, 0);
+  }
+  else {
+    for (VcdBitActivity &activity : id_activities_map_[id])
+      activity.setValue(time, value, window_);
+  }
 }
 
 void
@@ -161,8 +192,17 @@ Vcd::varAppendBusValue(string &id,
                        VcdTime time,
                        int64_t bus_value)
 {
-  VcdValues &values = id_values_map_[id];
-  values.emplace_back(time, '\0', bus_value);
+  if (keep_values_) {
+    VcdValues &values = id_values_map_[id];
+    values.emplace_back(time, '\0', bus_value);
+  }
+  else {
+    VcdBitActivities &activities = id_activities_map_[id];
+    for (size_t value_bit = 0; value_bit < activities.size(); value_bit++) {
+      char value = ((bus_value >> value_bit) & 0x1) ? '1' : '0';
+      activities[value_bit].setValue(time, value, window_);
+    }
+  }
 }
 
 VcdValues &
@@ -179,6 +219,28 @@ Vcd::values(VcdVar *var)
     return id_values_map_[var->id()];
 }
 
+const VcdBitActivities &
+Vcd::bitActivities(VcdVar *var)
+{
+  auto activities_iter = id_activities_map_.find(var->id());
+  if (activities_iter == id_activities_map_.end()) {
+    static VcdBitActivities empty;
+    return empty;
+  }
+  else
+    return activities_iter->second;
+}
+
+VcdBitActivities *
+Vcd::idBitActivities(const string &id)
+{
+  auto activities_iter = id_activities_map_.find(id);
+  if (activities_iter == id_activities_map_.end())
+    return nullptr;
+  else
+    return &activities_iter->second;
+}
+
 ////////////////////////////////////////////////////////////////
 
 VcdVar::VcdVar(string name,
@@ -210,4 +272,166 @@ VcdValue::value(int value_bit) const
     return value_;
 }
 
+////////////////////////////////////////////////////////////////
+
+VcdBitActivity::VcdBitActivity() :
+  transition_count_(0.0),
+  high_time_(0),
+  first_time_(0),
+  prev_time_(0),
+  first_value_('\0'),
+  prev_value_('\0')
+{
+}
+
+static double
+vcdTransitionCount(char from_value,
+                   char to_value)
+{
+  if (to_value == from_value)
+    return 0.0;
+  else if (to_value == 'X'
+           || to_value == 'Z'
+           || from_value == 'X'
+           || from_value == 'Z')
+    return .5;
+  else
+    return 1.0;
+}
+
+void
+VcdBitActivity::setValue(VcdTime time,
+                         char value,
+                         VcdTime window)
+{
+  if (prev_value_ == '\0') {
+    first_time_ = time;
+    first_value_ = value;
+  }
+  else {
+    if (prev_value_ == '1') {
+      high_time_ += time - prev_time_;
+      if (window)
+        addWindowHighTime(prev_time_, time, window);
+    }
+    double transition_count = vcdTransitionCount(prev_value_, value);
+    transition_count_ += transition_count;
+    if (window)
+      addWindowTransitions(time, transition_count, window);
+  }
+  prev_time_ = time;
+  prev_value_ = value;
+}
+
+void
+VcdBitActivity::merge(const VcdBitActivity &next,
+                      VcdTime window)
+{
+  if (next.hasValue()) {
+    if (prev_value_ == '\0') {
+      first_time_ = next.first_time_;
+      first_value_ = next.first_value_;
+    }
+    else {
+      if (prev_value_ == '1') {
+        high_time_ += next.first_time_ - prev_time_;
+        if (window)
+          addWindowHighTime(prev_time_, next.first_time_, window);
+      }
+      double transition_count = vcdTransitionCount(prev_value_,
+                                                   next.first_value_);
+      transition_count_ += transition_count;
+      if (window)
+        addWindowTransitions(next.first_time_, transition_count, window);
+    }
+    transition_count_ += next.transition_count_;
+    high_time_ += next.high_time_;
+    if (window) {
+      size_t window_count = next.windowCount();
+      if (window_count > 0)
+        ensureWindow(window_count - 1);
+      for (size_t i = 0; i < window_count; i++) {
+        window_transition_counts_[i] += next.window_transition_counts_[i];
+        window_high_times_[i] += next.window_high_times_[i];
+      }
+    }
+    prev_time_ = next.prev_time_;
+    prev_value_ = next.prev_value_;
+  }
+}
+
+VcdTime
+VcdBitActivity::highTime(VcdTime time_max) const
+{
+  if (prev_value_ == '1')
+    return high_time_ + time_max - prev_time_;
+  else
+    return high_time_;
+}
+
+double
+VcdBitActivity::windowTransitionCount(size_t index) const
+{
+  if (index < window_transition_counts_.size())
+    return window_transition_counts_[index];
+  else
+    return 0.0;
+}
+
+VcdTime
+VcdBitActivity::windowHighTime(size_t index,
+                               VcdTime time_max,
+                               VcdTime window) const
+{
+  VcdTime high_time = (index < window_high_times_.size())
+    ? window_high_times_[index]
+    : 0;
+  if (prev_value_ == '1') {
+    // High from the last value change to time_max.
+    VcdTime begin = max(prev_time_, static_cast<VcdTime>(index * window));
+    VcdTime end = min(time_max, static_cast<VcdTime>((index + 1) * window));
+    if (end > begin)
+      high_time += end - begin;
+  }
+  return high_time;
+}
+
+void
+VcdBitActivity::ensureWindow(size_t index)
+{
+  if (index >= window_high_times_.size()) {
+    window_transition_counts_.resize(index + 1, 0.0);
+    window_high_times_.resize(index + 1, 0);
+  }
+}
+
+void
+VcdBitActivity::addWindowTransitions(VcdTime time,
+                                     double transition_count,
+                                     VcdTime window)
+{
+  if (transition_count > 0.0) {
+    size_t index = time / window;
+    ensureWindow(index);
+    window_transition_counts_[index] += transition_count;
+  }
+}
+
+// Split the high time from..to over the windows it spans.
+void
+VcdBitActivity::addWindowHighTime(VcdTime from,
+                                  VcdTime to,
+                                  VcdTime window)
+{
+  if (to > from) {
+    size_t last = (to - 1) / window;
+    ensureWindow(last);
+    for (size_t index = from / window; index <= last; index++) {
+      VcdTime begin = max(from, static_cast<VcdTime>(index * window));
+      VcdTime end = min(to, static_cast<VcdTime>((index + 1) * window));
+      window_high_times_[index] += end - begin;
+    }
+  }
+}
+
 }
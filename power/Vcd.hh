@@ -34,7 +34,9 @@ using std::min;
 
 class VcdVar;
 class VcdValue;
+class VcdBitActivity;
 typedef vector<VcdValue> VcdValues;
+typedef vector<VcdBitActivity> VcdBitActivities;
 typedef int64_t VcdTime;
 typedef vector<string> VcdScope;
 typedef map<string, VcdVar*> VcdNameMap;
@@ -69,6 +71,19 @@ public:
   ~Vcd();
   VcdVar *var(const string name);
   VcdValues &values(VcdVar *var);
+  // When values are not kept only the running activity of each var
+  // bit is updated as values are appended, so memory does not grow
+  // with the length of the dump.
+  bool keepValues() const { return keep_values_; }
+  void setKeepValues(bool keep_values);
+  // Length of the time windows the bit activities are also kept for,
+  // or 0 for the whole dump only (without keepValues).
+  VcdTime window() const { return window_; }
+  void setWindow(VcdTime window);
+  // Bit activities of var indexed by value bit (without keepValues).
+  const VcdBitActivities &bitActivities(VcdVar *var);
+  // Bit activities of var ID, nullptr if the ID is unknown.
+  VcdBitActivities *idBitActivities(const string &id);
 
   const string &date() const { return date_; }
   void setDate(const string &date);
@@ -114,6 +129,9 @@ private:
   size_t max_var_name_length_;
   int max_var_width_;
   map<string, VcdValues> id_values_map_;
+  bool keep_values_;
+  map<string, VcdBitActivities> id_activities_map_;
+  VcdTime window_;
   VcdTime min_delta_time_;
   VcdTime time_max_;
 };
@@ -155,4 +173,50 @@ private:
   uint64_t bus_value_;
 };
 
+// Transition count and high time of one bit of a var.
+// With a non-zero window they are also counted for each window of
+// that length starting at time zero.
+class VcdBitActivity
+{
+public:
+  VcdBitActivity();
+  void setValue(VcdTime time,
+                char value,
+                VcdTime window = 0);
+  // Append the activity of a later stretch of the dump.
+  void merge(const VcdBitActivity &next,
+             VcdTime window = 0);
+  bool hasValue() const { return prev_value_ != '\0'; }
+  double transitionCount() const { return transition_count_; }
+  // Time the bit is high up to time_max.
+  VcdTime highTime(VcdTime time_max) const;
+  // Windows with a transition or high time so far.
+  size_t windowCount() const { return window_high_times_.size(); }
+  double windowTransitionCount(size_t index) const;
+  VcdTime windowHighTime(size_t index,
+                         VcdTime time_max,
+                         VcdTime window) const;
+
+private:
+  void ensureWindow(size_t index);
+  void addWindowTransitions(VcdTime time,
+                            double transition_count,
+                            VcdTime window);
+  void addWindowHighTime(VcdTime from,
+                         VcdTime to,
+                         VcdTime window);
+
+  // Transitions to or from X/Z count as half a transition.
+  double transition_count_;
+  VcdTime high_time_;
+  VcdTime first_time_;
+  VcdTime prev_time_;
+  // 01XUZ or '\0' before the first value.
+  char first_value_;
+  char prev_value_;
+  // Indexed by window.
+  vector<double> window_transition_counts_;
+  vector<VcdTime> window_high_times_;
+};
+
 } // namespace
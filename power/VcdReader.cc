@@ -15,20 +15,35 @@
 // along with this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <cctype>
+#include <cmath>
 #include <cinttypes>
+#include <unordered_map>
 
 #include "VcdReader.hh"
 
-#include "Zlib.hh"
+#include "InputFile.hh"
 #include "Report.hh"
 #include "Error.hh"
 #include "StringUtil.hh"
 #include "EnumNameMap.hh"
+#include "DispatchQueue.hh"
 
 namespace sta {
 
 using std::isspace;
 
+class VcdBlock;
+
+// First bit index and width of a var ID.
+class VcdIdBits
+{
+public:
+  size_t first_bit_;
+  size_t width_;
+};
+
+typedef std::unordered_map<string, VcdIdBits> VcdIdBitsMap;
+
 // Very imprecise syntax definition
 // https://en.wikipedia.org/wiki/Value_change_dump#Structure.2FSyntax
 // Much better syntax definition
@@ -38,7 +53,9 @@ class VcdReader : public StaState
 {
 public:
   VcdReader(StaState *sta);
-  Vcd read(const char *filename);
+  Vcd read(const char *filename,
+           bool keep_values,
+           double window);
 
 private:
   void parseTimescale();
@@ -47,11 +64,16 @@ private:
   void parseScope();
   void parseUpscope();
   void parseVarValues();
+  void parseVarValuesParallel();
+  void makeIdBits(VcdIdBitsMap &id_bits,
+                  vector<VcdBitActivity*> &bit_activities);
+  void mergeBlock(VcdBlock &block,
+                  vector<VcdBitActivity*> &bit_activities);
   string getToken();
   string readStmtString();
   vector<string> readStmtTokens();
 
-  gzFile stream_;
+  InputFile stream_;
   string token_;
   const char *filename_;
   int file_line_;
@@ -65,20 +87,24 @@ private:
 
 Vcd
 readVcdFile(const char *filename,
-            StaState *sta)
+            bool keep_values,
+            StaState *sta,
+            double window)
 
 {
   VcdReader reader(sta);
-  return reader.read(filename);
+  return reader.read(filename, keep_values, window);
 }
 
 Vcd
-VcdReader::read(const char *filename)
+VcdReader::read(const char *filename,
+                bool keep_values,
+                double window)
 {
   Vcd vcd(this);
+  vcd.setKeepValues(keep_values);
   vcd_ = &vcd;
-  stream_ = gzopen(filename, "r");
-  if (stream_) {
+  if (stream_.open(filename)) {
     filename_ = filename;
     file_line_ = 1;
     stmt_line_ = 1;
@@ -98,9 +124,16 @@ VcdReader::read(const char *filename)
         parseScope();
       else if (token == "$upscope")
         parseUpscope();
-      else if (token == "$enddefinitions")
+      else if (token == "$enddefinitions") {
         // empty body
         readStmtString();
+        if (window > 0.0) {
+          VcdTime window_time = std::llround(window / vcd_->timeScale());
+          vcd_->setWindow(std::max(window_time, static_cast<VcdTime>(1)));
+        }
+        if (!keep_values && thread_count_ > 1)
+          parseVarValuesParallel();
+      }
       else if (token == "$dumpall")
         parseVarValues();
       else if (token == "$dumpvars")
@@ -112,7 +145,7 @@ VcdReader::read(const char *filename)
         parseVarValues();
       token = getToken();
     }
-    gzclose(stream_);
+    stream_.close();
   }
   else
     throw FileNotReadable(filename);
@@ -286,6 +319,360 @@ VcdReader::parseVarValues()
   vcd_->setTimeMax(time_);
 }
 
+////////////////////////////////////////////////////////////////
+
+// Value change text between #time boundaries parsed by a dispatch
+// queue thread into the activity of each var bit it changes.
+class VcdBlock
+{
+public:
+  VcdBlock(size_t bit_count,
+           VcdTime window);
+  void parse(const char *begin,
+             const char *end,
+             VcdTime time,
+             const VcdIdBitsMap &id_bits);
+  void clear();
+
+  // Summaries of the bits changed by the block.
+  vector<size_t> bits_;
+  vector<VcdBitActivity> summaries_;
+  // First #time of the block.
+  VcdTime first_time_;
+  bool has_first_time_;
+  // Time at the end of the block.
+  VcdTime time_;
+  // Min time between the #times after the first one.
+  VcdTime min_delta_time_;
+  bool has_min_delta_time_;
+  int line_count_;
+  // Unknown var id error.
+  int error_id_;
+  int error_line_;
+  string error_var_id_;
+
+private:
+  VcdBitActivity &summary(size_t bit);
+  void setValue(const VcdIdBits &bits,
+                VcdTime time,
+                char value);
+  void setBusValue(const VcdIdBits &bits,
+                   VcdTime time,
+                   uint64_t bus_value);
+  bool nextToken(const char *&token,
+                 size_t &length);
+  void setError(int error_id,
+                const char *var_id,
+                size_t length);
+
+  // Index of bit summaries by bit, -1 if unchanged.
+  vector<int> summary_index_;
+  VcdTime window_;
+  const char *next_;
+  const char *end_;
+};
+
+VcdBlock::VcdBlock(size_t bit_count,
+                   VcdTime window) :
+  summary_index_(bit_count, -1),
+  window_(window),
+  next_(nullptr),
+  end_(nullptr)
+{
+  clear();
+}
+
+void
+VcdBlock::clear()
+{
+  for (size_t bit : bits_)
+    summary_index_[bit] = -1;
+  bits_.clear();
+  summaries_.clear();
+  first_time_ = 0;
+  has_first_time_ = false;
+  time_ = 0;
+  min_delta_time_ = 0;
+  has_min_delta_time_ = false;
+  line_count_ = 0;
+  error_id_ = 0;
+  error_line_ = 0;
+  error_var_id_.clear();
+}
+
+// Same syntax as VcdReader::parseVarValues.
+void
+VcdBlock::parse(const char *begin,
+                const char *end,
+                VcdTime time,
+                const VcdIdBitsMap &id_bits)
+{
+  next_ = begin;
+  end_ = end;
+  time_ = time;
+  const char *token;
+  size_t length;
+  while (error_id_ == 0
+         && nextToken(token, length)) {
+    char char0 = toupper(token[0]);
+    if (char0 == '#' && length > 1) {
+      VcdTime prev_time = time_;
+      time_ = strtoll(string(token + 1, length - 1).c_str(), nullptr, 10);
+      if (!has_first_time_) {
+        first_time_ = time_;
+        has_first_time_ = true;
+      }
+      else if (time_ > prev_time) {
+        VcdTime delta = time_ - prev_time;
+        if (!has_min_delta_time_ || delta < min_delta_time_)
+          min_delta_time_ = delta;
+        has_min_delta_time_ = true;
+      }
+    }
+    else if (char0 == '0'
+             || char0 == '1'
+             || char0 == 'X'
+             || char0 == 'U'
+             || char0 == 'Z') {
+      auto bits_iter = id_bits.find(string(token + 1, length - 1));
+      if (bits_iter == id_bits.end())
+        setError(805, token + 1, length - 1);
+      else
+        setValue(bits_iter->second, time_, char0);
+    }
+    else if (char0 == 'B') {
+      char char1 = (length > 1) ? toupper(token[1]) : '\0';
+      const char *bin = token + 1;
+      size_t bin_length = length - 1;
+      const char *id;
+      size_t id_length;
+      if (!nextToken(id, id_length))
+        break;
+      auto bits_iter = id_bits.find(string(id, id_length));
+      if (char1 == 'X'
+          || char1 == 'U'
+          || char1 == 'Z') {
+        if (bits_iter == id_bits.end())
+          setError(806, id, id_length);
+        else
+          // Bus mixed 0/1/X/U not supported.
+          setValue(bits_iter->second, time_, char1);
+      }
+      else {
+        if (bits_iter == id_bits.end())
+          setError(807, id, id_length);
+        else {
+          uint64_t bus_value = strtol(string(bin, bin_length).c_str(),
+                                      nullptr, 2);
+          setBusValue(bits_iter->second, time_, bus_value);
+        }
+      }
+    }
+  }
+}
+
+bool
+VcdBlock::nextToken(const char *&token,
+                    size_t &length)
+{
+  while (next_ < end_ && isspace(*next_)) {
+    if (*next_ == '\n')
+      line_count_++;
+    next_++;
+  }
+  if (next_ == end_)
+    return false;
+  token = next_;
+  while (next_ < end_ && !isspace(*next_))
+    next_++;
+  length = next_ - token;
+  return true;
+}
+
+void
+VcdBlock::setError(int error_id,
+                   const char *var_id,
+                   size_t length)
+{
+  error_id_ = error_id;
+  error_line_ = line_count_;
+  error_var_id_ = string(var_id, length);
+}
+
+VcdBitActivity &
+VcdBlock::summary(size_t bit)
+{
+  int index = summary_index_[bit];
+  if (index < 0) {
+    index = summaries_.size();
+    summary_index_[bit] = index;
+    bits_.push_back(bit);
+    summaries_.emplace_back();
+  }
+  return summaries_[index];
+}
+
+void
+VcdBlock::setValue(const VcdIdBits &bits,
+                   VcdTime time,
+                   char value)
+{
+  for (size_t i = 0; i < bits.width_; i++)
+    summary(bits.first_bit_ + i).setValue(time, value, window_);
+}
+
+void
+VcdBlock::setBusValue(const VcdIdBits &bits,
+                      VcdTime time,
+                      uint64_t bus_value)
+{
+  for (size_t value_bit = 0; value_bit < bits.width_; value_bit++) {
+    char value = ((bus_value >> value_bit) & 0x1) ? '1' : '0';
+    summary(bits.first_bit_ + value_bit).setValue(time, value, window_);
+  }
+}
+
+// Bytes of value change text per block.
+static const size_t vcd_block_size = 4 * 1024 * 1024;
+
+// Return the index of the first #time token in [from, to), or to.
+static size_t
+findTimeToken(const vector<char> &text,
+              size_t from,
+              size_t to)
+{
+  for (size_t i = from; i < to; i++) {
+    if (text[i] == '#'
+        && i > 0
+        && isspace(text[i - 1]))
+      return i;
+  }
+  return to;
+}
+
+// Return the index of the last #time token in (0, to), or 0.
+static size_t
+findLastTimeToken(const vector<char> &text,
+                  size_t to)
+{
+  for (size_t i = to; i > 1; i--) {
+    if (text[i - 1] == '#'
+        && isspace(text[i - 2]))
+      return i - 1;
+  }
+  return 0;
+}
+
+// Parse the value changes following $enddefinitions in blocks that
+// start at #time tokens with the dispatch queue threads. The blocks
+// of each pass over the file are summarized in parallel and merged
+// into the var activities in file order.
+// Only used when values are not kept.
+void
+VcdReader::parseVarValuesParallel()
+{
+  VcdIdBitsMap id_bits;
+  vector<VcdBitActivity*> bit_activities;
+  makeIdBits(id_bits, bit_activities);
+
+  size_t block_count = thread_count_;
+  vector<VcdBlock> blocks(block_count, VcdBlock(bit_activities.size(),
+                                                vcd_->window()));
+  vector<char> text;
+  size_t text_size = 0;
+  size_t read_size = block_count * vcd_block_size;
+  bool eof = false;
+  while (!eof || text_size > 0) {
+    if (text.size() < read_size)
+      text.resize(read_size);
+    while (!eof && text_size < read_size) {
+      size_t length = stream_.read(&text[text_size], read_size - text_size);
+      if (length == 0)
+        eof = true;
+      else
+        text_size += length;
+    }
+    // Blocks end before a #time token so the text after the last one
+    // is parsed by the next pass.
+    size_t parse_size = eof ? text_size : findLastTimeToken(text, text_size);
+    if (parse_size == 0) {
+      // No #time token to split at.
+      read_size *= 2;
+      continue;
+    }
+    size_t block_size = (parse_size + block_count - 1) / block_count;
+    size_t begin = 0;
+    size_t used_count = 0;
+    for (size_t i = 0; i < block_count && begin < parse_size; i++) {
+      size_t end = (i == block_count - 1)
+        ? parse_size
+        : findTimeToken(text, std::max(begin + block_size, begin + 1),
+                        parse_size);
+      VcdBlock &block = blocks[i];
+      const char *block_begin = &text[begin];
+      const char *block_end = &text[0] + end;
+      dispatch_queue_->dispatch([&block, block_begin, block_end, &id_bits,
+                                 this] (int) {
+        block.parse(block_begin, block_end, time_, id_bits);
+      });
+      begin = end;
+      used_count++;
+    }
+    dispatch_queue_->finishTasks();
+    for (size_t i = 0; i < used_count; i++)
+      mergeBlock(blocks[i], bit_activities);
+
+    std::copy(text.begin() + parse_size, text.begin() + text_size,
+              text.begin());
+    text_size -= parse_size;
+  }
+  vcd_->setTimeMax(time_);
+}
+
+// Number the bits of each var ID.
+void
+VcdReader::makeIdBits(VcdIdBitsMap &id_bits,
+                      vector<VcdBitActivity*> &bit_activities)
+{
+  for (VcdVar *var : vcd_->vars()) {
+    const string &id = var->id();
+    if (id_bits.find(id) == id_bits.end()) {
+      VcdBitActivities *activities = vcd_->idBitActivities(id);
+      if (activities) {
+        VcdIdBits &bits = id_bits[id];
+        bits.first_bit_ = bit_activities.size();
+        bits.width_ = activities->size();
+        for (VcdBitActivity &activity : *activities)
+          bit_activities.push_back(&activity);
+      }
+    }
+  }
+}
+
+void
+VcdReader::mergeBlock(VcdBlock &block,
+                      vector<VcdBitActivity*> &bit_activities)
+{
+  if (block.error_id_)
+    report_->fileError(block.error_id_, filename_,
+                       file_line_ + block.error_line_,
+                       "unknown variable %s", block.error_var_id_.c_str());
+  if (block.has_first_time_) {
+    prev_time_ = time_;
+    time_ = block.first_time_;
+    if (time_ > prev_time_)
+      vcd_->setMinDeltaTime(min(time_ - prev_time_, vcd_->minDeltaTime()));
+  }
+  if (block.has_min_delta_time_)
+    vcd_->setMinDeltaTime(min(block.min_delta_time_, vcd_->minDeltaTime()));
+  time_ = block.time_;
+  size_t bit_count = block.bits_.size();
+  for (size_t i = 0; i < bit_count; i++)
+    bit_activities[block.bits_[i]]->merge(block.summaries_[i], vcd_->window());
+  file_line_ += block.line_count_;
+  block.clear();
+}
+
 string
 VcdReader::readStmtString()
 {
@@ -318,18 +705,18 @@ string
 VcdReader::getToken()
 {
   string token;
-  int ch = gzgetc(stream_);
+  int ch = stream_.getc();
   if (ch == '\n')
     file_line_++;
   // skip whitespace
   while (ch != EOF && isspace(ch)) {
-    ch = gzgetc(stream_);
+    ch = stream_.getc();
     if (ch == '\n')
       file_line_++;
   }
   while (ch != EOF && !isspace(ch)) {
     token.push_back(ch);
-    ch = gzgetc(stream_);
+    ch = stream_.getc();
     if (ch == '\n')
       file_line_++;
   }
@@ -350,7 +737,7 @@ reportVcdWaveforms(const char *filename,
                    StaState *sta)
 
 {
-  Vcd vcd = readVcdFile(filename, sta);
+  Vcd vcd = readVcdFile(filename, true, sta);
   reportWaveforms(vcd, sta->report());
 }
 
@@ -430,7 +817,7 @@ reportVcdVarValues(const char *filename,
                    const char *var_name,
                    StaState *sta)
 {
-  Vcd vcd = readVcdFile(filename, sta);
+  Vcd vcd = readVcdFile(filename, true, sta);
   VcdVar *var = vcd.var(var_name);
   if (var) {
     Report *report = sta->report();
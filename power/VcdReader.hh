@@ -22,9 +22,14 @@ namespace sta {
 
 class StaState;
 
+// Without keep_values only the running activity of each var bit is
+// kept (see Vcd::keepValues), also for each time window of window
+// seconds when window is non-zero (see Vcd::window).
 Vcd
 readVcdFile(const char *filename,
-            StaState *sta);
+            bool keep_values,
+            StaState *sta,
+            double window = 0.0);
 
 void
 reportVcdWaveforms(const char *filename,
@@ -0,0 +1,415 @@
+%module stapy
+
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+// Python module for bulk timing queries.
+//
+//  import numpy, stapy
+//  stapy.init(8)
+//  stapy.tcl("read_liberty lib.lib; read_verilog top.v; link_design top")
+//  stapy.tcl("read_sdc top.sdc")
+//  pins = stapy.graph_pins()
+//  slacks = numpy.asarray(stapy.pin_slacks(pins, "max"))
+//
+// init makes the sta and a tcl interpreter with the sta commands, so
+// tcl() runs any command. Pin lists are kept in C++ as PinArray
+// objects so repeated queries do not convert pin names. The query
+// functions return FloatArray objects that own the values and export
+// them with the python buffer protocol, so numpy views them without a
+// copy. Times are in seconds.
+// After freeze_timing the query functions release the GIL, so they can
+// be called from multiple python threads.
+
+%include <std_string.i>
+
+%{
+#include <tcl.h>
+#include <stdexcept>
+#include <string>
+
+#include "StaMain.hh"
+#include "MinMax.hh"
+#include "Transition.hh"
+#include "Network.hh"
+#include "Graph.hh"
+#include "Sta.hh"
+
+// Swig uses C linkage for init functions.
+extern "C" {
+extern int Sta_Init(Tcl_Interp *interp);
+}
+
+namespace sta {
+
+extern const char *tcl_inits[];
+
+class PinArray
+{
+public:
+  size_t size() const { return pins_.size(); }
+
+  PinSeq pins_;
+};
+
+// Python object that owns a FloatSeq and exports it as a read only
+// 1-D float32 buffer.
+struct FloatArrayObject
+{
+  PyObject_HEAD
+  FloatSeq *values;
+  Py_ssize_t shape[1];
+  Py_ssize_t strides[1];
+};
+
+static void
+floatArrayDealloc(PyObject *obj)
+{
+  FloatArrayObject *array = reinterpret_cast<FloatArrayObject*>(obj);
+  delete array->values;
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+static Py_ssize_t
+floatArrayLength(PyObject *obj)
+{
+  return reinterpret_cast<FloatArrayObject*>(obj)->shape[0];
+}
+
+static int
+floatArrayGetBuffer(PyObject *obj,
+                    Py_buffer *view,
+                    int flags)
+{
+  if (flags & PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "FloatArray is read only.");
+    view->obj = nullptr;
+    return -1;
+  }
+  FloatArrayObject *array = reinterpret_cast<FloatArrayObject*>(obj);
+  view->obj = obj;
+  Py_INCREF(obj);
+  view->buf = array->values->data();
+  view->len = array->shape[0] * sizeof(float);
+  view->readonly = 1;
+  view->itemsize = sizeof(float);
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("f") : nullptr;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) ? array->shape : nullptr;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES)
+    ? array->strides
+    : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+static PySequenceMethods float_array_sequence_methods;
+static PyBufferProcs float_array_buffer_procs;
+static PyTypeObject float_array_type = {
+  PyVarObject_HEAD_INIT(nullptr, 0)
+};
+
+static bool
+initFloatArrayType()
+{
+  float_array_sequence_methods.sq_length = floatArrayLength;
+  float_array_buffer_procs.bf_getbuffer = floatArrayGetBuffer;
+  float_array_type.tp_name = "stapy.FloatArray";
+  float_array_type.tp_basicsize = sizeof(FloatArrayObject);
+  float_array_type.tp_dealloc = floatArrayDealloc;
+  float_array_type.tp_as_sequence = &float_array_sequence_methods;
+  float_array_type.tp_as_buffer = &float_array_buffer_procs;
+  float_array_type.tp_flags = Py_TPFLAGS_DEFAULT;
+  float_array_type.tp_doc = "Float values exported with the buffer protocol.";
+  return PyType_Ready(&float_array_type) == 0;
+}
+
+// Take the values without copying them.
+static PyObject *
+makeFloatArray(FloatSeq &values)
+{
+  FloatArrayObject *array = PyObject_New(FloatArrayObject, &float_array_type);
+  if (array) {
+    array->values = new FloatSeq;
+    array->values->swap(values);
+    array->shape[0] = array->values->size();
+    array->strides[0] = sizeof(float);
+  }
+  return reinterpret_cast<PyObject*>(array);
+}
+
+static Sta *
+pythonSta()
+{
+  Sta *sta = Sta::sta();
+  if (sta == nullptr)
+    throw std::runtime_error("stapy.init has not been called.");
+  return sta;
+}
+
+static Tcl_Interp *python_interp = nullptr;
+
+// Release the GIL while a frozen timing query runs so python threads
+// can query concurrently.
+class AllowThreads
+{
+public:
+  AllowThreads(bool allow) :
+    state_(allow ? PyEval_SaveThread() : nullptr)
+  {
+  }
+  ~AllowThreads()
+  {
+    if (state_)
+      PyEval_RestoreThread(state_);
+  }
+
+private:
+  PyThreadState *state_;
+};
+
+} // namespace
+
+using namespace sta;
+
+%}
+
+%init %{
+  if (!sta::initFloatArrayType())
+    return NULL;
+%}
+
+%exception {
+  try { $function }
+  catch (std::bad_alloc &) {
+    fprintf(stderr, "Error: out of memory.\n");
+    exit(1);
+  }
+  catch (std::invalid_argument &excp) {
+    PyErr_SetString(PyExc_ValueError, excp.what());
+    SWIG_fail;
+  }
+  catch (std::exception &excp) {
+    PyErr_SetString(PyExc_RuntimeError, excp.what());
+    SWIG_fail;
+  }
+}
+
+////////////////////////////////////////////////////////////////
+//
+// Typemaps
+//
+////////////////////////////////////////////////////////////////
+
+%typemap(out) FloatSeq {
+  $result = makeFloatArray(static_cast<FloatSeq&>($1));
+  if ($result == nullptr)
+    SWIG_fail;
+}
+
+%typemap(in) const MinMax* {
+  const char *arg = PyUnicode_Check($input) ? PyUnicode_AsUTF8($input) : nullptr;
+  const MinMax *min_max = arg ? MinMax::find(arg) : nullptr;
+  if (min_max == nullptr) {
+    PyErr_SetString(PyExc_ValueError, "min_max must be min or max.");
+    SWIG_fail;
+  }
+  $1 = const_cast<MinMax*>(min_max);
+}
+
+// None is the worst of rise/fall.
+%typemap(in) const RiseFall* {
+  if ($input == Py_None)
+    $1 = nullptr;
+  else {
+    const char *arg = PyUnicode_Check($input) ? PyUnicode_AsUTF8($input) : nullptr;
+    const RiseFall *rf = arg ? RiseFall::find(arg) : nullptr;
+    if (rf == nullptr) {
+      PyErr_SetString(PyExc_ValueError, "rf must be rise, fall or None.");
+      SWIG_fail;
+    }
+    $1 = const_cast<RiseFall*>(rf);
+  }
+}
+
+%newobject find_pins;
+%newobject graph_pins;
+
+// Opaque to python; PinArray holds the pins in C++.
+class PinArray
+{
+public:
+  size_t size() const;
+};
+
+%inline %{
+
+// Make the sta components and a tcl interpreter with the sta commands.
+void
+init(int thread_count)
+{
+  if (Sta::sta() == nullptr) {
+    Tcl_Interp *interp = Tcl_CreateInterp();
+    if (Tcl_Init(interp) == TCL_ERROR)
+      throw std::runtime_error(Tcl_GetStringResult(interp));
+    initSta();
+    Sta *sta = new Sta;
+    Sta::setSta(sta);
+    sta->makeComponents();
+    sta->setTclInterp(interp);
+    sta->setThreadCount(thread_count);
+    // Define swig TCL commands.
+    Sta_Init(interp);
+    // Eval encoded sta TCL sources.
+    evalTclInit(interp, tcl_inits);
+    Tcl_Eval(interp, "init_sta_cmds");
+    python_interp = interp;
+  }
+}
+
+// Evaluate tcl commands and return the result.
+std::string
+tcl(const char *cmd)
+{
+  pythonSta();
+  if (Tcl_Eval(python_interp, cmd) != TCL_OK)
+    throw std::runtime_error(Tcl_GetStringResult(python_interp));
+  return Tcl_GetStringResult(python_interp);
+}
+
+// Find pins from a sequence of hierarchical pin path names.
+PinArray *
+find_pins(PyObject *names)
+{
+  Network *network = pythonSta()->cmdNetwork();
+  PyObject *seq = PySequence_Fast(names, "");
+  if (seq == nullptr) {
+    PyErr_Clear();
+    throw std::invalid_argument("names must be a sequence.");
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+  PinArray *pins = new PinArray;
+  pins->pins_.reserve(count);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject *name = PySequence_Fast_GET_ITEM(seq, i);
+    const char *path_name = PyUnicode_Check(name) ? PyUnicode_AsUTF8(name) : nullptr;
+    const Pin *pin = path_name ? network->findPin(path_name) : nullptr;
+    if (pin == nullptr) {
+      std::string msg = path_name
+        ? std::string("pin ") + path_name + " not found."
+        : std::string("pin names must be strings.");
+      PyErr_Clear();
+      Py_DECREF(seq);
+      delete pins;
+      throw std::invalid_argument(msg);
+    }
+    pins->pins_.push_back(pin);
+  }
+  Py_DECREF(seq);
+  return pins;
+}
+
+// Pins of the timing graph vertices in vertex order.
+PinArray *
+graph_pins()
+{
+  Graph *graph = pythonSta()->ensureGraph();
+  PinArray *pins = new PinArray;
+  pins->pins_.reserve(graph->vertexCount());
+  VertexIterator vertex_iter(graph);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    if (!vertex->isBidirectDriver())
+      pins->pins_.push_back(vertex->pin());
+  }
+  return pins;
+}
+
+PyObject *
+pin_names(PinArray *pins)
+{
+  Network *network = pythonSta()->cmdNetwork();
+  PyObject *names = PyList_New(pins->size());
+  if (names == nullptr)
+    throw std::bad_alloc();
+  for (size_t i = 0; i < pins->size(); i++)
+    PyList_SET_ITEM(names, i,
+                    PyUnicode_FromString(network->pathName(pins->pins_[i])));
+  return names;
+}
+
+FloatSeq
+pin_slacks(PinArray *pins,
+           const MinMax *min_max,
+           const RiseFall *rf = nullptr)
+{
+  Sta *sta = pythonSta();
+  AllowThreads allow(sta->timingFrozen());
+  return sta->pinSlacks(pins->pins_, rf, min_max);
+}
+
+FloatSeq
+pin_arrivals(PinArray *pins,
+             const MinMax *min_max,
+             const RiseFall *rf = nullptr)
+{
+  Sta *sta = pythonSta();
+  AllowThreads allow(sta->timingFrozen());
+  return sta->pinArrivals(pins->pins_, rf, min_max);
+}
+
+FloatSeq
+pin_slews(PinArray *pins,
+          const MinMax *min_max,
+          const RiseFall *rf = nullptr)
+{
+  Sta *sta = pythonSta();
+  AllowThreads allow(sta->timingFrozen());
+  return sta->pinSlews(pins->pins_, rf, min_max);
+}
+
+float
+worst_slack(const MinMax *min_max)
+{
+  Sta *sta = pythonSta();
+  AllowThreads allow(sta->timingFrozen());
+  return delayAsFloat(sta->worstSlack(min_max));
+}
+
+float
+total_negative_slack(const MinMax *min_max)
+{
+  Sta *sta = pythonSta();
+  AllowThreads allow(sta->timingFrozen());
+  return delayAsFloat(sta->totalNegativeSlack(min_max));
+}
+
+// Update and freeze timing so the query functions can be called from
+// multiple python threads.
+void
+freeze_timing()
+{
+  pythonSta()->freezeTiming();
+}
+
+void
+thaw_timing()
+{
+  pythonSta()->thawTiming();
+}
+
+%} // inline
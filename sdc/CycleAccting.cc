@@ -20,6 +20,7 @@
 #include <algorithm> // max
 
 #include "Debug.hh"
+#include "Mutex.hh"
 #include "Fuzzy.hh"
 #include "Units.hh"
 #include "TimingRole.hh"
@@ -29,7 +30,9 @@
 namespace sta {
 
 CycleAcctings::CycleAcctings(Sdc *sdc) :
-  sdc_(sdc)
+  sdc_(sdc),
+  table_(nullptr),
+  table_edge_count_(0)
 {
 }
 
@@ -41,9 +44,23 @@ CycleAcctings::~CycleAcctings()
 void
 CycleAcctings::clear()
 {
+  deleteTable();
   cycle_acctings_.deleteContentsClear();
 }
 
+void
+CycleAcctings::deleteTable()
+{
+  std::atomic<CycleAcctingRow*> *table = table_.load(std::memory_order_relaxed);
+  if (table) {
+    for (size_t i = 0; i < table_edge_count_; i++)
+      delete [] table[i].load(std::memory_order_relaxed);
+    delete [] table;
+    table_.store(nullptr, std::memory_order_relaxed);
+    table_edge_count_ = 0;
+  }
+}
+
 // Determine cycle accounting "on demand".
 CycleAccting *
 CycleAcctings::cycleAccting(const ClockEdge *src,
@@ -51,6 +68,30 @@ CycleAcctings::cycleAccting(const ClockEdge *src,
 {
   if (src == nullptr)
     src = tgt;
+  std::atomic<CycleAcctingRow*> *table = table_.load(std::memory_order_acquire);
+  if (table) {
+    size_t src_index = src->index();
+    size_t tgt_index = tgt->index();
+    if (src_index < table_edge_count_
+        && tgt_index < table_edge_count_) {
+      CycleAcctingRow *row = table[src_index].load(std::memory_order_acquire);
+      if (row) {
+        CycleAccting *acct = row[tgt_index].load(std::memory_order_acquire);
+        if (acct)
+          return acct;
+      }
+    }
+  }
+  UniqueLock lock(lock_);
+  CycleAccting *acct = findCycleAccting(src, tgt);
+  setTableAccting(src, tgt, acct);
+  return acct;
+}
+
+CycleAccting *
+CycleAcctings::findCycleAccting(const ClockEdge *src,
+                                const ClockEdge *tgt)
+{
   CycleAccting probe(src, tgt);
   CycleAccting *acct = cycle_acctings_.findKey(&probe);
   if (acct == nullptr) {
@@ -64,6 +105,42 @@ CycleAcctings::cycleAccting(const ClockEdge *src,
   return acct;
 }
 
+// Caller holds lock_.
+void
+CycleAcctings::setTableAccting(const ClockEdge *src,
+                               const ClockEdge *tgt,
+                               CycleAccting *acct)
+{
+  std::atomic<CycleAcctingRow*> *table = table_.load(std::memory_order_relaxed);
+  if (table == nullptr) {
+    // Clocks are not added or deleted without clearing the acctings,
+    // so the edge count is fixed until the next clear.
+    size_t edge_count = (sdc_->defaultArrivalClock()->index() + 1)
+      * RiseFall::index_count;
+    for (const Clock *clk : *sdc_->clocks())
+      edge_count = std::max(edge_count,
+                            size_t(clk->index() + 1) * RiseFall::index_count);
+    table = new std::atomic<CycleAcctingRow*>[edge_count];
+    for (size_t i = 0; i < edge_count; i++)
+      table[i].store(nullptr, std::memory_order_relaxed);
+    table_edge_count_ = edge_count;
+    table_.store(table, std::memory_order_release);
+  }
+  size_t src_index = src->index();
+  size_t tgt_index = tgt->index();
+  if (src_index < table_edge_count_
+      && tgt_index < table_edge_count_) {
+    CycleAcctingRow *row = table[src_index].load(std::memory_order_relaxed);
+    if (row == nullptr) {
+      row = new CycleAcctingRow[table_edge_count_];
+      for (size_t i = 0; i < table_edge_count_; i++)
+        row[i].store(nullptr, std::memory_order_relaxed);
+      table[src_index].store(row, std::memory_order_release);
+    }
+    row[tgt_index].store(acct, std::memory_order_release);
+  }
+}
+
 void
 CycleAcctings::reportClkToClkMaxCycleWarnings(Report *report)
 {
@@ -48,6 +48,7 @@
 #include "search/Levelize.hh"
 #include "Corner.hh"
 #include "Graph.hh"
+#include "MemoryStats.hh"
 
 namespace sta {
 
@@ -84,6 +85,7 @@ clone(ExceptionThruSeq *thrus,
 Sdc::Sdc(StaState *sta) :
   StaState(sta),
   derating_factors_(nullptr),
+  derating_factors_version_(0),
   clk_index_(0),
   clock_pin_map_(PinIdHash(network_)),
   clock_leaf_pin_map_(PinIdHash(network_)),
@@ -140,6 +142,13 @@ Sdc::~Sdc()
   deleteConstraints();
 }
 
+void
+Sdc::copyState(const StaState *sta)
+{
+  StaState::copyState(sta);
+  sdc_ = this;
+}
+
 // This does NOT call initVariables() because those variable values
 // survive linking a new design.
 void
@@ -173,11 +182,13 @@ Sdc::clear()
   input_delay_index_ = 0;
   input_delay_ref_pin_map_.clear();
   input_delay_leaf_pin_map_.clear();
+  input_delay_leaf_pin_index_.clear();
   input_delay_internal_pin_map_.clear();
 
   output_delays_.clear();
   output_delay_pin_map_.clear();
   output_delay_leaf_pin_map_.clear();
+  output_delay_leaf_pin_index_.clear();
 
   port_slew_limit_map_.clear();
   cell_slew_limit_map_.clear();
@@ -201,6 +212,7 @@ Sdc::clear()
   disabled_clk_gating_checks_pin_.clear();
 
   input_drive_map_.clear();
+  input_drive_index_.clear();
   logic_value_map_.clear();
   case_value_map_.clear();
 
@@ -265,6 +277,7 @@ Sdc::deleteConstraints()
   inst_clk_gating_check_map_.deleteContents();
   pin_clk_gating_check_map_.deleteContents();
   input_drive_map_.deleteContents();
+  input_drive_index_.clear();
   disabled_cell_ports_.deleteContents();
   disabled_inst_ports_.deleteContents();
   pin_min_pulse_width_map_.deleteContentsClear();
@@ -284,6 +297,7 @@ Sdc::deleteConstraints()
   input_delays_.deleteContents();
   input_delay_pin_map_.deleteContents();
   input_delay_leaf_pin_map_.deleteContents();
+  input_delay_leaf_pin_index_.clear();
   input_delay_ref_pin_map_.deleteContents();
   input_delay_internal_pin_map_.deleteContents();
 
@@ -291,6 +305,7 @@ Sdc::deleteConstraints()
   output_delay_pin_map_.deleteContents();
   output_delay_ref_pin_map_.deleteContents();
   output_delay_leaf_pin_map_.deleteContents();
+  output_delay_leaf_pin_index_.clear();
 
   clk_hpin_disables_.deleteContentsClear();
   clk_hpin_disables_valid_ = false;
@@ -322,26 +337,38 @@ Sdc::removeNetLoadCaps()
 
 void
 Sdc::removeLibertyAnnotations()
+{
+  setLibertyAnnotations(false);
+}
+
+void
+Sdc::annotateLiberty()
+{
+  setLibertyAnnotations(true);
+}
+
+void
+Sdc::setLibertyAnnotations(bool disabled)
 {
   for (auto cell_port : disabled_cell_ports_) {
     DisabledCellPorts *disable = cell_port.second;
     LibertyCell *cell = disable->cell();
     if (disable->all())
-      cell->setIsDisabledConstraint(false);
+      cell->setIsDisabledConstraint(disabled);
 
     if (disable->from()) {
       for (LibertyPort *from : *disable->from())
-        from->setIsDisabledConstraint(false);
+        from->setIsDisabledConstraint(disabled);
     }
 
     if (disable->to()) {
       for (LibertyPort *to : *disable->to())
-        to->setIsDisabledConstraint(false);
+        to->setIsDisabledConstraint(disabled);
     }
 
     if (disable->timingArcSets()) {
       for (TimingArcSet *arc_set : *disable->timingArcSets()) 
-	arc_set->setIsDisabledConstraint(false);
+	arc_set->setIsDisabledConstraint(disabled);
     }
 
     
@@ -350,13 +377,13 @@ Sdc::removeLibertyAnnotations()
         const LibertyPort *from = pair.first;
         const LibertyPort *to = pair.second;
         for (TimingArcSet *arc_set : cell->timingArcSets(from, to))
-          arc_set->setIsDisabledConstraint(false);
+          arc_set->setIsDisabledConstraint(disabled);
       }
     }
   }
 
   for (LibertyPort *port : disabled_lib_ports_)
-    port->setIsDisabledConstraint(false);
+    port->setIsDisabledConstraint(disabled);
 }
 
 void
@@ -540,6 +567,7 @@ Sdc::setTimingDerate(TimingDerateType type,
   if (derating_factors_ == nullptr)
     derating_factors_ = new DeratingFactorsGlobal;
   derating_factors_->setFactor(type, clk_data, rf, early_late, derate);
+  derating_factors_version_++;
 }
 
 void
@@ -555,6 +583,7 @@ Sdc::setTimingDerate(const Net *net,
     net_derating_factors_[net] = factors;
   }
   factors->setFactor(clk_data, rf, early_late, derate);
+  derating_factors_version_++;
 }
 
 void
@@ -571,6 +600,7 @@ Sdc::setTimingDerate(const Instance *inst,
     inst_derating_factors_[inst] = factors;
   }
   factors->setFactor(type, clk_data, rf, early_late, derate);
+  derating_factors_version_++;
 }
 
 void
@@ -587,6 +617,7 @@ Sdc::setTimingDerate(const LibertyCell *cell,
     cell_derating_factors_[cell] = factors;
   }
   factors->setFactor(type, clk_data, rf, early_late, derate);
+  derating_factors_version_++;
 }
 
 float
@@ -655,6 +686,29 @@ Sdc::timingDerateNet(const Pin *pin,
   return 1.0;
 }
 
+bool
+Sdc::hasLocalDeratingFactors() const
+{
+  return !inst_derating_factors_.empty()
+    || !cell_derating_factors_.empty()
+    || !net_derating_factors_.empty();
+}
+
+void
+Sdc::pinDeratingFactors(const Pin *pin,
+                        // Return values.
+                        const DeratingFactorsCell *&inst_factors,
+                        const DeratingFactorsCell *&cell_factors,
+                        const DeratingFactorsNet *&net_factors) const
+{
+  const Instance *inst = network_->instance(pin);
+  inst_factors = inst_derating_factors_.findKey(inst);
+  const LibertyCell *cell = network_->libertyCell(inst);
+  cell_factors = cell ? cell_derating_factors_.findKey(cell) : nullptr;
+  const Net *net = network_->net(pin);
+  net_factors = net ? net_derating_factors_.findKey(net) : nullptr;
+}
+
 void
 Sdc::unsetTimingDerate()
 {
@@ -669,6 +723,8 @@ Sdc::swapDeratingFactors(Sdc *sdc1,
   swap(sdc1->net_derating_factors_, sdc2->net_derating_factors_);
   swap(sdc1->inst_derating_factors_, sdc2->inst_derating_factors_);
   swap(sdc1->cell_derating_factors_, sdc2->cell_derating_factors_);
+  sdc1->derating_factors_version_++;
+  sdc2->derating_factors_version_++;
 }
 
 void
@@ -680,6 +736,7 @@ Sdc::deleteDeratingFactors()
 
   delete derating_factors_;
   derating_factors_ = nullptr;
+  derating_factors_version_++;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -723,6 +780,7 @@ Sdc::ensureInputDrive(const Port *port)
   if (drive == nullptr) {
     drive = new InputDrive;
     input_drive_map_[port] = drive;
+    input_drive_index_.insert(network_->id(port), drive);
   }
   return drive;
 }
@@ -2338,7 +2396,6 @@ CycleAccting *
 Sdc::cycleAccting(const ClockEdge *src,
 		  const ClockEdge *tgt)
 {
-  UniqueLock lock(cycle_acctings_lock_);
   return cycle_acctings_.cycleAccting(src, tgt);
 }
 
@@ -2565,7 +2622,7 @@ Sdc::deleteMinPulseWidthReferencing(Clock *clk)
 InputDrive *
 Sdc::findInputDrive(Port *port)
 {
-  return input_drive_map_.findKey(port);
+  return input_drive_index_.findKey(network_->id(port));
 }
 
 void
@@ -2627,6 +2684,7 @@ Sdc::makeInputDelay(const Pin *pin,
     if (leaf_inputs == nullptr) {
       leaf_inputs = new InputDelaySet;
       input_delay_leaf_pin_map_[lpin] = leaf_inputs;
+      input_delay_leaf_pin_index_.insert(network_->id(lpin), leaf_inputs);
     }
     leaf_inputs->insert(input_delay);
 
@@ -2695,13 +2753,14 @@ Sdc::refPinInputDelays(const Pin *ref_pin) const
 InputDelaySet *
 Sdc::inputDelaysLeafPin(const Pin *leaf_pin)
 {
-  return input_delay_leaf_pin_map_.findKey(leaf_pin);
+  return input_delay_leaf_pin_index_.findKey(network_->id(leaf_pin));
 }
 
 bool
 Sdc::hasInputDelay(const Pin *leaf_pin) const
 {
-  InputDelaySet *input_delays = input_delay_leaf_pin_map_.findKey(leaf_pin);
+  InputDelaySet *input_delays =
+    input_delay_leaf_pin_index_.findKey(network_->id(leaf_pin));
   return input_delays && !input_delays->empty();
 }
 
@@ -2747,6 +2806,7 @@ Sdc::swapPortDelays(Sdc *sdc1,
   swap(sdc1->input_delay_pin_map_, sdc2->input_delay_pin_map_);
   swap(sdc1->input_delay_ref_pin_map_, sdc2->input_delay_ref_pin_map_);
   swap(sdc1->input_delay_leaf_pin_map_, sdc2->input_delay_leaf_pin_map_);
+  sdc1->input_delay_leaf_pin_index_.swap(sdc2->input_delay_leaf_pin_index_);
   swap(sdc1->input_delay_internal_pin_map_, sdc2->input_delay_internal_pin_map_);
   swap(sdc1->input_delay_index_, sdc2->input_delay_index_);
 
@@ -2754,6 +2814,7 @@ Sdc::swapPortDelays(Sdc *sdc1,
   swap(sdc1->output_delay_pin_map_, sdc2->output_delay_pin_map_);
   swap(sdc1->output_delay_ref_pin_map_, sdc2->output_delay_ref_pin_map_);
   swap(sdc1->output_delay_leaf_pin_map_, sdc2->output_delay_leaf_pin_map_);
+  sdc1->output_delay_leaf_pin_index_.swap(sdc2->output_delay_leaf_pin_index_);
 }
 
 ////////////////////////////////////////////////////////////////
@@ -2830,6 +2891,7 @@ Sdc::makeOutputDelay(const Pin *pin,
     if (leaf_outputs == nullptr) {
       leaf_outputs = new OutputDelaySet;
       output_delay_leaf_pin_map_[lpin] = leaf_outputs;
+      output_delay_leaf_pin_index_.insert(network_->id(lpin), leaf_outputs);
     }
     leaf_outputs->insert(output_delay);
   }
@@ -2867,13 +2929,13 @@ Sdc::deleteOutputDelays(const Pin *pin,
 OutputDelaySet *
 Sdc::outputDelaysLeafPin(const Pin *leaf_pin)
 {
-  return output_delay_leaf_pin_map_.findKey(leaf_pin);
+  return output_delay_leaf_pin_index_.findKey(network_->id(leaf_pin));
 }
 
 bool
 Sdc::hasOutputDelay(const Pin *leaf_pin) const
 {
-  return output_delay_leaf_pin_map_.hasKey(leaf_pin);
+  return output_delay_leaf_pin_index_.findKey(network_->id(leaf_pin)) != nullptr;
 }
 
 void
@@ -4606,6 +4668,40 @@ Sdc::recordExceptionFirstTo(ExceptionPath *exception)
   recordExceptionClks(exception, to->clks(), first_to_clk_exceptions_);
 }
 
+// Record the objects of merged_pt that are merged into the first
+// exception point of exception. Re-recording all of the first point
+// objects on every merge is quadratic when many exceptions merge into one.
+void
+Sdc::recordMergedFirstPt(ExceptionPath *exception,
+			 ExceptionPt *merged_pt)
+{
+  if (merged_pt->isFrom()) {
+    recordExceptionPins(exception, merged_pt->pins(),
+			first_from_pin_exceptions_);
+    recordExceptionInsts(exception, merged_pt->instances(),
+			 first_from_inst_exceptions_);
+    recordExceptionClks(exception, merged_pt->clks(),
+			first_from_clk_exceptions_);
+  }
+  else if (merged_pt->isThru()) {
+    ExceptionThru *thru = dynamic_cast<ExceptionThru*>(merged_pt);
+    recordExceptionPins(exception, thru->pins(), first_thru_pin_exceptions_);
+    recordExceptionInsts(exception, thru->instances(),
+			 first_thru_inst_exceptions_);
+    recordExceptionEdges(exception, thru->edges(),
+			 first_thru_edge_exceptions_);
+    recordExceptionNets(exception, thru->nets(), first_thru_net_exceptions_);
+  }
+  else if (merged_pt->isTo()) {
+    recordExceptionPins(exception, merged_pt->pins(),
+			first_to_pin_exceptions_);
+    recordExceptionInsts(exception, merged_pt->instances(),
+			 first_to_inst_exceptions_);
+    recordExceptionClks(exception, merged_pt->clks(),
+			first_to_clk_exceptions_);
+  }
+}
+
 void
 Sdc::recordExceptionClks(ExceptionPath *exception,
 			 ClockSet *clks,
@@ -4750,12 +4846,13 @@ Sdc::findMergeMatch(ExceptionPath *exception)
 	  // Unrecord the exception that is being merged away.
 	  unrecordException(exception);
 	  unrecordMergeHashes(match);
-	  missing_pt->mergeInto(match_missing_pt, network_);
-	  recordMergeHashes(match);
 	  // First point maps only change if the exception point that
 	  // is being merged is the first exception point.
+	  // Record the merged objects before mergeInto steals the edges.
 	  if (first_pt)
-	    recordExceptionFirstPts(match);
+	    recordMergedFirstPt(match, missing_pt);
+	  missing_pt->mergeInto(match_missing_pt, network_);
+	  recordMergeHashes(match);
           // Have to wait until after exception point merge to delete
           // the exception.
 	  delete exception;
@@ -4770,6 +4867,74 @@ Sdc::findMergeMatch(ExceptionPath *exception)
 
 ////////////////////////////////////////////////////////////////
 
+// Exception point index map entries and their exception sets.
+template <class MAP>
+static size_t
+exceptionsMapBytes(const MAP &exceptions_map)
+{
+  size_t bytes = 0;
+  for (const auto &obj_exceptions : exceptions_map) {
+    bytes += MemoryStats::hash_node_bytes + sizeof(obj_exceptions);
+    const ExceptionPathSet *exceptions = obj_exceptions.second;
+    if (exceptions)
+      bytes += sizeof(ExceptionPathSet) + exceptions->size()
+        * (MemoryStats::tree_node_bytes + sizeof(ExceptionPath*));
+  }
+  return bytes;
+}
+
+void
+Sdc::memoryStats(MemoryStats &stats) const
+{
+  size_t exception_bytes = 0;
+  size_t point_count = 0;
+  for (const ExceptionPath *exception : exceptions_) {
+    exception_bytes += sizeof(FalsePath) + MemoryStats::tree_node_bytes
+      + sizeof(ExceptionPath*);
+    size_t object_count = 0;
+    if (exception->from()) {
+      exception_bytes += sizeof(ExceptionFrom);
+      object_count += exception->from()->objectCount();
+    }
+    if (exception->thrus()) {
+      for (const ExceptionThru *thru : *exception->thrus()) {
+        exception_bytes += sizeof(ExceptionThru);
+        object_count += thru->objectCount();
+      }
+    }
+    if (exception->to()) {
+      exception_bytes += sizeof(ExceptionTo);
+      object_count += exception->to()->objectCount();
+    }
+    point_count += object_count;
+    exception_bytes += object_count
+      * (MemoryStats::tree_node_bytes + sizeof(void*));
+  }
+  stats.add("sdc", "exceptions", exceptions_.size(), exception_bytes);
+  stats.add("sdc", "exception objects", point_count, 0);
+  size_t index_bytes = exceptionsMapBytes(first_from_pin_exceptions_)
+    + exceptionsMapBytes(first_from_clk_exceptions_)
+    + exceptionsMapBytes(first_from_inst_exceptions_)
+    + exceptionsMapBytes(first_thru_pin_exceptions_)
+    + exceptionsMapBytes(first_thru_inst_exceptions_)
+    + exceptionsMapBytes(first_thru_net_exceptions_)
+    + exceptionsMapBytes(first_to_pin_exceptions_)
+    + exceptionsMapBytes(first_to_clk_exceptions_)
+    + exceptionsMapBytes(first_to_inst_exceptions_)
+    + exceptionsMapBytes(first_thru_edge_exceptions_);
+  size_t index_count = first_from_pin_exceptions_.size()
+    + first_from_clk_exceptions_.size()
+    + first_from_inst_exceptions_.size()
+    + first_thru_pin_exceptions_.size()
+    + first_thru_inst_exceptions_.size()
+    + first_thru_net_exceptions_.size()
+    + first_to_pin_exceptions_.size()
+    + first_to_clk_exceptions_.size()
+    + first_to_inst_exceptions_.size()
+    + first_thru_edge_exceptions_.size();
+  stats.add("sdc", "exception index", index_count, index_bytes);
+}
+
 void
 Sdc::deleteExceptions()
 {
@@ -5234,8 +5399,9 @@ Sdc::exceptionThruStates(const Pin *from_pin,
 			 const MinMax *min_max) const
 {
   ExceptionStateSet *states = nullptr;
-  exceptionThruStates(first_thru_pin_exceptions_.findKey(to_pin),
-                      to_rf, min_max, states);
+  if (!first_thru_pin_exceptions_.empty())
+    exceptionThruStates(first_thru_pin_exceptions_.findKey(to_pin),
+                        to_rf, min_max, states);
   if (!first_thru_edge_exceptions_.empty()) {
     EdgePins edge_pins(from_pin, to_pin);
     exceptionThruStates(first_thru_edge_exceptions_.findKey(edge_pins),
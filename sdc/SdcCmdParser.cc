@@ -0,0 +1,1187 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "SdcCmdParser.hh"
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <tcl.h>
+
+#include "StringUtil.hh"
+#include "PatternMatch.hh"
+#include "PortDirection.hh"
+#include "Network.hh"
+#include "Units.hh"
+#include "Transition.hh"
+#include "MinMax.hh"
+#include "Clock.hh"
+#include "ExceptionPath.hh"
+#include "Sdc.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+using std::string;
+
+// Word of an SDC command. Words made by [get_*] command substitution
+// hold the objects that were found instead of text.
+class SdcCmdWord
+{
+public:
+  SdcCmdWord();
+  bool isKeyword() const;
+  bool hasObjects() const;
+
+  string text_;
+  bool is_objects_;
+  PortSeq ports_;
+  PinSeq pins_;
+  InstanceSeq insts_;
+  NetSeq nets_;
+  ClockSeq clks_;
+};
+
+typedef std::vector<SdcCmdWord> SdcCmdWordSeq;
+typedef std::vector<std::pair<string, const SdcCmdWord*>> SdcCmdKeyWordSeq;
+typedef std::initializer_list<const char*> SdcCmdKeywords;
+
+// Keyword arguments of a command split the way parse_key_args does.
+class SdcCmdArgs
+{
+public:
+  // Return false for keywords that are not in keys, flags or
+  // repeat_keys (abbreviations are left to Tcl).
+  bool parse(const SdcCmdWordSeq &words,
+             SdcCmdKeywords keys,
+             SdcCmdKeywords flags,
+             SdcCmdKeywords repeat_keys);
+  const SdcCmdWord *key(const char *key) const;
+  bool flag(const char *flag) const;
+
+  std::vector<const SdcCmdWord*> args_;
+  // Repeated keys (-through) in command order.
+  SdcCmdKeyWordSeq repeat_keys_;
+
+private:
+  std::map<string, const SdcCmdWord*> keys_;
+  std::set<string> flags_;
+};
+
+class SdcCmdParser
+{
+public:
+  SdcCmdParser(const char *filename,
+               int line,
+               Sta *sta);
+  bool eval(const char *cmd);
+
+private:
+  bool parseWords(const char *&s,
+                  bool nested,
+                  SdcCmdWordSeq &words);
+  bool evalQuery(const SdcCmdWordSeq &words,
+                 SdcCmdWord &result);
+  void allPorts(bool inputs,
+                PortSeq &ports) const;
+  void expandBus(const Port *port,
+                 PortSeq &ports) const;
+  const Pin *topPin(const Port *port) const;
+  bool portPins(const SdcCmdWord *word,
+                PinSeq &pins) const;
+  bool findClock(const SdcCmdWord *word,
+                 Clock *&clk) const;
+  bool exceptionFromTo(const SdcCmdWord *word,
+                       PinSet *&pins,
+                       ClockSet *&clks,
+                       InstanceSet *&insts) const;
+  bool exceptionThru(const SdcCmdWord *word,
+                     PinSet *&pins,
+                     NetSet *&nets,
+                     InstanceSet *&insts) const;
+  bool exceptionPts(const SdcCmdArgs &args,
+                    ExceptionFrom *&from,
+                    ExceptionThruSeq *&thrus,
+                    ExceptionTo *&to);
+  bool createClock(const SdcCmdWordSeq &words);
+  bool setPortDelay(const SdcCmdWordSeq &words,
+                    bool input);
+  bool setFalsePath(const SdcCmdWordSeq &words);
+  bool setMulticyclePath(const SdcCmdWordSeq &words);
+  bool setLoad(const SdcCmdWordSeq &words);
+  bool setMaxTransition(const SdcCmdWordSeq &words);
+
+  const char *filename_;
+  int line_;
+  Sta *sta_;
+  Network *network_;
+  Sdc *sdc_;
+  Units *units_;
+  Tcl_Interp *interp_;
+};
+
+bool
+evalSdcCmdNative(const char *cmd,
+                 const char *filename,
+                 int line,
+                 Sta *sta)
+{
+  SdcCmdParser parser(filename, line, sta);
+  return parser.eval(cmd);
+}
+
+////////////////////////////////////////////////////////////////
+
+static bool
+isSpace(char ch)
+{
+  return ch == ' '
+    || ch == '\t'
+    || ch == '\r'
+    || ch == '\f'
+    || ch == '\v';
+}
+
+static bool
+isWordEnd(char ch,
+          bool nested)
+{
+  return isSpace(ch)
+    || ch == '\n'
+    || ch == '\0'
+    || (nested && ch == ']');
+}
+
+static bool
+keywordIn(const string &keyword,
+          SdcCmdKeywords keywords)
+{
+  for (const char *keyword1 : keywords) {
+    if (keyword == keyword1)
+      return true;
+  }
+  return false;
+}
+
+// Split a Tcl list of simple elements.
+static bool
+splitList(const string &text,
+          std::vector<string> &elements)
+{
+  const char *s = text.c_str();
+  for (;;) {
+    while (isSpace(*s) || *s == '\n')
+      s++;
+    if (*s == '\0')
+      return true;
+    const char *start = s;
+    while (!isWordEnd(*s, false)) {
+      if (*s == '{' || *s == '}' || *s == '"')
+        return false;
+      s++;
+    }
+    elements.push_back(string(start, s - start));
+  }
+}
+
+static bool
+isEmptyList(const SdcCmdWord *word)
+{
+  if (word->hasObjects())
+    return false;
+  for (char ch : word->text_) {
+    if (!(isSpace(ch) || ch == '\n'))
+      return false;
+  }
+  return true;
+}
+
+// string is double
+static bool
+parseFloat(const SdcCmdWord *word,
+           double &value)
+{
+  if (word->is_objects_
+      || word->text_.empty())
+    return false;
+  const char *str = word->text_.c_str();
+  char *end;
+  value = strtod(str, &end);
+  return *end == '\0'
+    && std::isfinite(value);
+}
+
+// string is integer
+static bool
+parseInt(const SdcCmdWord *word,
+         int &value)
+{
+  if (word->is_objects_
+      || word->text_.empty())
+    return false;
+  const char *str = word->text_.c_str();
+  char *end;
+  errno = 0;
+  long value1 = strtol(str, &end, 10);
+  value = static_cast<int>(value1);
+  return *end == '\0'
+    && errno == 0
+    && value1 == value;
+}
+
+static const RiseFallBoth *
+riseFallFlags(const SdcCmdArgs &args)
+{
+  bool rise = args.flag("-rise");
+  bool fall = args.flag("-fall");
+  if (rise && !fall)
+    return RiseFallBoth::rise();
+  else if (fall && !rise)
+    return RiseFallBoth::fall();
+  else
+    return RiseFallBoth::riseFall();
+}
+
+static const MinMaxAll *
+minMaxAllFlags(const SdcCmdArgs &args)
+{
+  bool min = args.flag("-min");
+  bool max = args.flag("-max");
+  if (min && !max)
+    return MinMaxAll::min();
+  else if (max && !min)
+    return MinMaxAll::max();
+  else
+    return MinMaxAll::all();
+}
+
+static const MinMaxAll *
+setupHoldFlags(const SdcCmdArgs &args)
+{
+  bool setup = args.flag("-setup");
+  bool hold = args.flag("-hold");
+  if (setup && !hold)
+    return MinMaxAll::max();
+  else if (hold && !setup)
+    return MinMaxAll::min();
+  else
+    return MinMaxAll::all();
+}
+
+static const char *
+commentKey(const SdcCmdArgs &args)
+{
+  const SdcCmdWord *comment = args.key("-comment");
+  return comment ? comment->text_.c_str() : "";
+}
+
+////////////////////////////////////////////////////////////////
+
+SdcCmdWord::SdcCmdWord() :
+  is_objects_(false)
+{
+}
+
+bool
+SdcCmdWord::isKeyword() const
+{
+  return !is_objects_
+    && text_.size() >= 2
+    && text_[0] == '-'
+    && isalpha(static_cast<unsigned char>(text_[1]));
+}
+
+bool
+SdcCmdWord::hasObjects() const
+{
+  return !(ports_.empty()
+           && pins_.empty()
+           && insts_.empty()
+           && nets_.empty()
+           && clks_.empty());
+}
+
+////////////////////////////////////////////////////////////////
+
+bool
+SdcCmdArgs::parse(const SdcCmdWordSeq &words,
+                  SdcCmdKeywords keys,
+                  SdcCmdKeywords flags,
+                  SdcCmdKeywords repeat_keys)
+{
+  for (size_t i = 1; i < words.size(); i++) {
+    const SdcCmdWord &word = words[i];
+    if (word.isKeyword()) {
+      const string &keyword = word.text_;
+      if (keywordIn(keyword, flags))
+        flags_.insert(keyword);
+      else if (i + 1 < words.size()) {
+        if (keywordIn(keyword, keys))
+          keys_[keyword] = &words[++i];
+        else if (keywordIn(keyword, repeat_keys))
+          repeat_keys_.push_back({keyword, &words[++i]});
+        else
+          return false;
+      }
+      else
+        return false;
+    }
+    else
+      args_.push_back(&word);
+  }
+  return true;
+}
+
+const SdcCmdWord *
+SdcCmdArgs::key(const char *key) const
+{
+  auto itr = keys_.find(key);
+  if (itr == keys_.end())
+    return nullptr;
+  else
+    return itr->second;
+}
+
+bool
+SdcCmdArgs::flag(const char *flag) const
+{
+  return flags_.find(flag) != flags_.end();
+}
+
+////////////////////////////////////////////////////////////////
+
+SdcCmdParser::SdcCmdParser(const char *filename,
+                           int line,
+                           Sta *sta) :
+  filename_(filename),
+  line_(line),
+  sta_(sta),
+  network_(sta->cmdNetwork()),
+  sdc_(sta->sdc()),
+  units_(sta->units()),
+  interp_(sta->tclInterp())
+{
+}
+
+bool
+SdcCmdParser::eval(const char *cmd)
+{
+  const char *s = cmd;
+  while (isSpace(*s) || *s == '\n')
+    s++;
+  if (*s == '\0')
+    return true;
+  if (*s == '#') {
+    // Comment that is not continued and is not followed by commands.
+    if (strchr(s, '\\'))
+      return false;
+    const char *eol = strchr(s, '\n');
+    if (eol) {
+      for (s = eol; *s; s++) {
+        if (!(isSpace(*s) || *s == '\n'))
+          return false;
+      }
+    }
+    return true;
+  }
+  if (interp_ == nullptr
+      || !network_->isLinked())
+    return false;
+
+  SdcCmdWordSeq words;
+  if (!parseWords(s, false, words)
+      || words.empty()
+      || words[0].is_objects_)
+    return false;
+  const char *cmd_name = words[0].text_.c_str();
+  if (stringEq(cmd_name, "create_clock"))
+    return createClock(words);
+  else if (stringEq(cmd_name, "set_input_delay"))
+    return setPortDelay(words, true);
+  else if (stringEq(cmd_name, "set_output_delay"))
+    return setPortDelay(words, false);
+  else if (stringEq(cmd_name, "set_false_path"))
+    return setFalsePath(words);
+  else if (stringEq(cmd_name, "set_multicycle_path"))
+    return setMulticyclePath(words);
+  else if (stringEq(cmd_name, "set_load"))
+    return setLoad(words);
+  else if (stringEq(cmd_name, "set_max_transition"))
+    return setMaxTransition(words);
+  else
+    return false;
+}
+
+// Parse words up to the end of the command (or the closing bracket of
+// a nested command). Variable substitution, backslashes, command
+// separators and anything else that needs the Tcl parser fail.
+bool
+SdcCmdParser::parseWords(const char *&s,
+                         bool nested,
+                         SdcCmdWordSeq &words)
+{
+  for (;;) {
+    while (isSpace(*s))
+      s++;
+    char ch = *s;
+    if (ch == '\0')
+      return !nested;
+    else if (ch == '\n') {
+      if (nested)
+        return false;
+      // Only one command.
+      while (isSpace(*s) || *s == '\n')
+        s++;
+      return *s == '\0';
+    }
+    else if (ch == ']') {
+      if (nested) {
+        s++;
+        return true;
+      }
+      return false;
+    }
+
+    SdcCmdWord word;
+    if (ch == '{') {
+      const char *start = ++s;
+      int depth = 1;
+      while (depth > 0) {
+        ch = *s++;
+        if (ch == '\0' || ch == '\\')
+          return false;
+        else if (ch == '{')
+          depth++;
+        else if (ch == '}')
+          depth--;
+      }
+      word.text_.assign(start, s - 1 - start);
+    }
+    else if (ch == '"') {
+      const char *start = ++s;
+      while (*s != '"') {
+        ch = *s;
+        if (ch == '\0' || ch == '$' || ch == '[' || ch == '\\')
+          return false;
+        s++;
+      }
+      word.text_.assign(start, s - start);
+      s++;
+    }
+    else if (ch == '[') {
+      s++;
+      SdcCmdWordSeq query;
+      if (!parseWords(s, true, query)
+          || !evalQuery(query, word))
+        return false;
+    }
+    else {
+      const char *start = s;
+      while (!isWordEnd(*s, nested)) {
+        ch = *s;
+        if (ch == '$' || ch == '[' || ch == '\\' || ch == ';'
+            || ch == '{' || ch == '"')
+          return false;
+        s++;
+      }
+      word.text_.assign(start, s - start);
+    }
+    if (!isWordEnd(*s, nested))
+      return false;
+    words.push_back(std::move(word));
+  }
+}
+
+// Object queries with glob patterns.
+// Queries that would warn about missing objects fail.
+bool
+SdcCmdParser::evalQuery(const SdcCmdWordSeq &words,
+                        SdcCmdWord &result)
+{
+  if (words.empty()
+      || words[0].is_objects_)
+    return false;
+  const char *cmd_name = words[0].text_.c_str();
+  result.is_objects_ = true;
+  if (stringEq(cmd_name, "all_inputs")
+      || stringEq(cmd_name, "all_outputs")) {
+    if (words.size() != 1)
+      return false;
+    allPorts(stringEq(cmd_name, "all_inputs"), result.ports_);
+    return true;
+  }
+  else if (stringEq(cmd_name, "all_clocks")) {
+    if (words.size() != 1)
+      return false;
+    PatternMatch matcher("*");
+    result.clks_ = sdc_->findClocksMatching(&matcher);
+    return true;
+  }
+
+  bool get_ports = stringEq(cmd_name, "get_ports");
+  bool get_pins = stringEq(cmd_name, "get_pins");
+  bool get_cells = stringEq(cmd_name, "get_cells");
+  bool get_nets = stringEq(cmd_name, "get_nets");
+  bool get_clocks = stringEq(cmd_name, "get_clocks");
+  if (!(get_ports || get_pins || get_cells || get_nets || get_clocks))
+    return false;
+  bool quiet = false;
+  bool hierarchical = false;
+  const SdcCmdWord *patterns = nullptr;
+  for (size_t i = 1; i < words.size(); i++) {
+    const SdcCmdWord &word = words[i];
+    if (word.isKeyword()) {
+      if (word.text_ == "-quiet")
+        quiet = true;
+      else if (word.text_ == "-hierarchical"
+               && (get_pins || get_cells || get_nets))
+        hierarchical = true;
+      else
+        return false;
+    }
+    else if (patterns == nullptr
+             && !word.is_objects_)
+      patterns = &word;
+    else
+      return false;
+  }
+  std::vector<string> pattern_seq;
+  if (patterns == nullptr
+      || !splitList(patterns->text_, pattern_seq))
+    return false;
+
+  Instance *current_inst = sta_->currentInstance();
+  for (const string &pattern : pattern_seq) {
+    PatternMatch matcher(pattern.c_str(), false, false, interp_);
+    bool found = false;
+    if (get_ports) {
+      Cell *top_cell = network_->cell(network_->topInstance());
+      PortSeq matches = network_->findPortsMatching(top_cell, &matcher);
+      for (const Port *port : matches)
+        expandBus(port, result.ports_);
+      found = !matches.empty();
+    }
+    else if (get_pins) {
+      PinSeq matches = hierarchical
+        ? network_->findPinsHierMatching(current_inst, &matcher)
+        : network_->findPinsMatching(current_inst, &matcher);
+      result.pins_.insert(result.pins_.end(), matches.begin(), matches.end());
+      found = !matches.empty();
+    }
+    else if (get_cells) {
+      InstanceSeq matches = hierarchical
+        ? network_->findInstancesHierMatching(current_inst, &matcher)
+        : network_->findInstancesMatching(current_inst, &matcher);
+      result.insts_.insert(result.insts_.end(), matches.begin(), matches.end());
+      found = !matches.empty();
+    }
+    else if (get_nets) {
+      NetSeq matches = hierarchical
+        ? network_->findNetsHierMatching(current_inst, &matcher)
+        : network_->findNetsMatching(current_inst, &matcher);
+      result.nets_.insert(result.nets_.end(), matches.begin(), matches.end());
+      found = !matches.empty();
+    }
+    else if (get_clocks) {
+      ClockSeq matches = sdc_->findClocksMatching(&matcher);
+      result.clks_.insert(result.clks_.end(), matches.begin(), matches.end());
+      found = !matches.empty();
+    }
+    if (!found && !quiet)
+      return false;
+  }
+  return true;
+}
+
+// all_ports_for_direction
+void
+SdcCmdParser::allPorts(bool inputs,
+                       PortSeq &ports) const
+{
+  Cell *top_cell = network_->cell(network_->topInstance());
+  CellPortIterator *port_iter = network_->portIterator(top_cell);
+  while (port_iter->hasNext()) {
+    const Port *port = port_iter->next();
+    PortDirection *dir = network_->direction(port);
+    if ((inputs ? dir->isInput() : dir->isOutput())
+        || dir->isBidirect()) {
+      if (network_->isBus(port)) {
+        PortMemberIterator *member_iter = network_->memberIterator(port);
+        while (member_iter->hasNext())
+          ports.push_back(member_iter->next());
+        delete member_iter;
+      }
+      else
+        ports.push_back(port);
+    }
+  }
+  delete port_iter;
+}
+
+// find_ports_matching
+void
+SdcCmdParser::expandBus(const Port *port,
+                        PortSeq &ports) const
+{
+  if (network_->isBus(port)
+      || network_->isBundle(port)) {
+    PortMemberIterator *member_iter = network_->memberIterator(port);
+    while (member_iter->hasNext())
+      ports.push_back(member_iter->next());
+    delete member_iter;
+  }
+  else
+    ports.push_back(port);
+}
+
+const Pin *
+SdcCmdParser::topPin(const Port *port) const
+{
+  return network_->findPin(network_->topInstance(), port);
+}
+
+// get_port_pins_error
+bool
+SdcCmdParser::portPins(const SdcCmdWord *word,
+                       PinSeq &pins) const
+{
+  if (!word->is_objects_)
+    return isEmptyList(word);
+  if (!(word->insts_.empty()
+        && word->nets_.empty()
+        && word->clks_.empty()))
+    return false;
+  for (const Port *port : word->ports_) {
+    const Pin *pin = topPin(port);
+    if (pin == nullptr)
+      return false;
+    pins.push_back(pin);
+  }
+  pins.insert(pins.end(), word->pins_.begin(), word->pins_.end());
+  return true;
+}
+
+// get_clock_warn with a clock name or a single clock.
+bool
+SdcCmdParser::findClock(const SdcCmdWord *word,
+                        Clock *&clk) const
+{
+  if (word->is_objects_) {
+    if (word->clks_.size() == 1
+        && word->ports_.empty()
+        && word->pins_.empty()
+        && word->insts_.empty()
+        && word->nets_.empty()) {
+      clk = word->clks_[0];
+      return true;
+    }
+    return false;
+  }
+  clk = sdc_->findClock(word->text_.c_str());
+  return clk != nullptr;
+}
+
+// parse_clk_inst_port_pin_arg
+// Literal names are only looked up as clock names.
+bool
+SdcCmdParser::exceptionFromTo(const SdcCmdWord *word,
+                              PinSet *&pins,
+                              ClockSet *&clks,
+                              InstanceSet *&insts) const
+{
+  pins = nullptr;
+  clks = nullptr;
+  insts = nullptr;
+  if (word->is_objects_) {
+    if (!word->nets_.empty()
+        || !word->hasObjects())
+      return false;
+    for (const Port *port : word->ports_) {
+      if (topPin(port) == nullptr)
+        return false;
+    }
+    if (!(word->ports_.empty() && word->pins_.empty())) {
+      pins = new PinSet(network_);
+      for (const Port *port : word->ports_)
+        pins->insert(topPin(port));
+      for (const Pin *pin : word->pins_)
+        pins->insert(pin);
+    }
+    if (!word->clks_.empty()) {
+      clks = new ClockSet;
+      for (Clock *clk : word->clks_)
+        clks->insert(clk);
+    }
+    if (!word->insts_.empty()) {
+      insts = new InstanceSet(network_);
+      for (const Instance *inst : word->insts_)
+        insts->insert(inst);
+    }
+    return true;
+  }
+  else {
+    Clock *clk = sdc_->findClock(word->text_.c_str());
+    if (clk) {
+      clks = new ClockSet;
+      clks->insert(clk);
+      return true;
+    }
+    return false;
+  }
+}
+
+// parse_inst_port_pin_net_arg
+bool
+SdcCmdParser::exceptionThru(const SdcCmdWord *word,
+                            PinSet *&pins,
+                            NetSet *&nets,
+                            InstanceSet *&insts) const
+{
+  pins = nullptr;
+  nets = nullptr;
+  insts = nullptr;
+  if (!word->is_objects_
+      || !word->clks_.empty()
+      || !word->hasObjects())
+    return false;
+  for (const Port *port : word->ports_) {
+    if (topPin(port) == nullptr)
+      return false;
+  }
+  if (!(word->ports_.empty() && word->pins_.empty())) {
+    pins = new PinSet(network_);
+    for (const Port *port : word->ports_)
+      pins->insert(topPin(port));
+    for (const Pin *pin : word->pins_)
+      pins->insert(pin);
+  }
+  if (!word->nets_.empty()) {
+    nets = new NetSet(network_);
+    for (const Net *net : word->nets_)
+      nets->insert(net);
+  }
+  if (!word->insts_.empty()) {
+    insts = new InstanceSet(network_);
+    for (const Instance *inst : word->insts_)
+      insts->insert(inst);
+  }
+  return true;
+}
+
+static const SdcCmdWord *
+fromToKey(const SdcCmdArgs &args,
+          const char *key,
+          const char *rise_key,
+          const char *fall_key,
+          const RiseFallBoth *&rf,
+          int &key_count)
+{
+  const SdcCmdWord *word = nullptr;
+  key_count = 0;
+  const SdcCmdWord *fall_word = args.key(fall_key);
+  if (fall_word) {
+    word = fall_word;
+    rf = RiseFallBoth::fall();
+    key_count++;
+  }
+  const SdcCmdWord *rise_word = args.key(rise_key);
+  if (rise_word) {
+    word = rise_word;
+    rf = RiseFallBoth::rise();
+    key_count++;
+  }
+  const SdcCmdWord *rise_fall_word = args.key(key);
+  if (rise_fall_word) {
+    word = rise_fall_word;
+    rf = RiseFallBoth::riseFall();
+    key_count++;
+  }
+  return word;
+}
+
+// parse_from_arg, parse_thrus_arg, parse_to_arg
+// Returns false before making anything if an argument has no objects.
+bool
+SdcCmdParser::exceptionPts(const SdcCmdArgs &args,
+                           ExceptionFrom *&from,
+                           ExceptionThruSeq *&thrus,
+                           ExceptionTo *&to)
+{
+  const RiseFallBoth *from_rf = RiseFallBoth::riseFall();
+  const RiseFallBoth *to_rf = RiseFallBoth::riseFall();
+  int from_count, to_count;
+  const SdcCmdWord *from_word = fromToKey(args, "-from", "-rise_from",
+                                          "-fall_from", from_rf, from_count);
+  const SdcCmdWord *to_word = fromToKey(args, "-to", "-rise_to",
+                                        "-fall_to", to_rf, to_count);
+  const RiseFallBoth *end_rf = riseFallFlags(args);
+  if (from_count > 1
+      || to_count > 1
+      || (from_word == nullptr
+          && args.repeat_keys_.empty()
+          && to_word == nullptr
+          && end_rf == RiseFallBoth::riseFall()))
+    return false;
+
+  // Check every argument before making any exception points.
+  PinSet *pins;
+  ClockSet *clks;
+  InstanceSet *insts;
+  NetSet *nets;
+  if (from_word) {
+    if (!exceptionFromTo(from_word, pins, clks, insts))
+      return false;
+    delete pins;
+    delete clks;
+    delete insts;
+  }
+  for (auto &key_word : args.repeat_keys_) {
+    if (!exceptionThru(key_word.second, pins, nets, insts))
+      return false;
+    delete pins;
+    delete nets;
+    delete insts;
+  }
+  if (to_word) {
+    if (!exceptionFromTo(to_word, pins, clks, insts))
+      return false;
+    delete pins;
+    delete clks;
+    delete insts;
+  }
+
+  from = nullptr;
+  if (from_word) {
+    exceptionFromTo(from_word, pins, clks, insts);
+    from = sta_->makeExceptionFrom(pins, clks, insts, from_rf);
+  }
+  thrus = nullptr;
+  for (auto &key_word : args.repeat_keys_) {
+    const string &key = key_word.first;
+    const RiseFallBoth *rf = RiseFallBoth::riseFall();
+    if (key == "-rise_through")
+      rf = RiseFallBoth::rise();
+    else if (key == "-fall_through")
+      rf = RiseFallBoth::fall();
+    exceptionThru(key_word.second, pins, nets, insts);
+    if (thrus == nullptr)
+      thrus = new ExceptionThruSeq;
+    thrus->push_back(sta_->makeExceptionThru(pins, nets, insts, rf));
+  }
+  RiseFallBoth *end_rf1 = const_cast<RiseFallBoth*>(end_rf);
+  if (to_word) {
+    exceptionFromTo(to_word, pins, clks, insts);
+    to = sta_->makeExceptionTo(pins, clks, insts, to_rf, end_rf1);
+  }
+  else if (end_rf != RiseFallBoth::riseFall())
+    to = sta_->makeExceptionTo(nullptr, nullptr, nullptr,
+                               RiseFallBoth::riseFall(), end_rf1);
+  else
+    to = nullptr;
+  // check_exception_pins
+  sta_->checkExceptionFromPins(from, filename_, line_);
+  sta_->checkExceptionToPins(to, filename_, line_);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////
+
+bool
+SdcCmdParser::createClock(const SdcCmdWordSeq &words)
+{
+  SdcCmdArgs args;
+  if (!args.parse(words, {"-name", "-period", "-waveform", "-comment"},
+                  {"-add"}, {})
+      || args.args_.size() > 1)
+    return false;
+  PinSeq pins;
+  if (args.args_.size() == 1
+      && !portPins(args.args_[0], pins))
+    return false;
+
+  bool add = args.flag("-add");
+  string name;
+  const SdcCmdWord *name_word = args.key("-name");
+  if (name_word) {
+    if (name_word->is_objects_)
+      return false;
+    name = name_word->text_;
+  }
+  else if (!pins.empty() && !add)
+    // Default clock name is the first pin name.
+    name = network_->pathName(pins[0]);
+  else
+    return false;
+
+  const SdcCmdWord *period_word = args.key("-period");
+  double period;
+  if (period_word == nullptr
+      || !parseFloat(period_word, period)
+      || period < 0.0)
+    return false;
+  period = units_->timeUnit()->userToSta(period);
+
+  std::vector<float> edges;
+  const SdcCmdWord *waveform_word = args.key("-waveform");
+  if (waveform_word) {
+    std::vector<string> edge_strs;
+    if (waveform_word->is_objects_
+        || !splitList(waveform_word->text_, edge_strs)
+        || edge_strs.size() % 2 != 0)
+      return false;
+    double prev_edge = 0.0;
+    for (const string &edge_str : edge_strs) {
+      SdcCmdWord edge_word;
+      edge_word.text_ = edge_str;
+      double edge;
+      if (!parseFloat(&edge_word, edge))
+        return false;
+      edge = units_->timeUnit()->userToSta(edge);
+      if ((!edges.empty() && edge < prev_edge)
+          || edge > period * 2)
+        return false;
+      edges.push_back(edge);
+      prev_edge = edge;
+    }
+  }
+  else {
+    edges.push_back(0.0);
+    edges.push_back(period / 2.0);
+  }
+
+  PinSet *pin_set = nullptr;
+  if (!pins.empty()) {
+    pin_set = new PinSet(network_);
+    for (const Pin *pin : pins)
+      pin_set->insert(pin);
+  }
+  FloatSeq *waveform = nullptr;
+  if (!edges.empty()) {
+    waveform = new FloatSeq;
+    for (float edge : edges)
+      waveform->push_back(edge);
+  }
+  sta_->makeClock(name.c_str(), pin_set, add, period, waveform,
+                  const_cast<char*>(commentKey(args)));
+  return true;
+}
+
+// set_port_delay
+bool
+SdcCmdParser::setPortDelay(const SdcCmdWordSeq &words,
+                           bool input)
+{
+  SdcCmdArgs args;
+  if (!args.parse(words, {"-clock", "-reference_pin"},
+                  {"-rise", "-fall", "-max", "-min", "-clock_fall",
+                   "-add_delay", "-source_latency_included",
+                   "-network_latency_included"}, {})
+      || args.key("-reference_pin")
+      || args.args_.size() != 2
+      || (args.flag("-min") && args.flag("-max")))
+    return false;
+
+  double delay;
+  if (!parseFloat(args.args_[0], delay))
+    return false;
+  delay = units_->timeUnit()->userToSta(delay);
+  PinSeq pins;
+  if (!portPins(args.args_[1], pins))
+    return false;
+  Clock *clk = nullptr;
+  const SdcCmdWord *clk_word = args.key("-clock");
+  if (clk_word
+      && !findClock(clk_word, clk))
+    return false;
+  for (const Pin *pin : pins) {
+    if (network_->isTopLevelPort(pin)) {
+      PortDirection *dir = network_->direction(pin);
+      bool dir_ok = input
+        ? (dir->isInput() || dir->isBidirect())
+        : (dir->isOutput() || dir->isTristate() || dir->isBidirect());
+      if (!dir_ok)
+        return false;
+    }
+    if (clk && clk->pins().hasKey(pin))
+      return false;
+  }
+
+  const RiseFall *clk_rf = args.flag("-clock_fall")
+    ? RiseFall::fall()
+    : RiseFall::rise();
+  const RiseFallBoth *rf = riseFallFlags(args);
+  const MinMaxAll *min_max = minMaxAllFlags(args);
+  bool add = args.flag("-add_delay");
+  bool source_latency_included = args.flag("-source_latency_included");
+  bool network_latency_included = args.flag("-network_latency_included");
+  for (const Pin *pin : pins) {
+    if (input)
+      sta_->setInputDelay(pin, rf, clk, clk_rf, nullptr,
+                          source_latency_included, network_latency_included,
+                          min_max, add, delay);
+    else
+      sta_->setOutputDelay(pin, rf, clk, clk_rf, nullptr,
+                           source_latency_included, network_latency_included,
+                           min_max, add, delay);
+  }
+  return true;
+}
+
+bool
+SdcCmdParser::setFalsePath(const SdcCmdWordSeq &words)
+{
+  SdcCmdArgs args;
+  if (!args.parse(words, {"-from", "-rise_from", "-fall_from",
+                          "-to", "-rise_to", "-fall_to", "-comment"},
+                  {"-setup", "-hold", "-rise", "-fall", "-reset_path"},
+                  {"-through", "-rise_through", "-fall_through"})
+      || !args.args_.empty()
+      || args.flag("-reset_path"))
+    return false;
+  ExceptionFrom *from;
+  ExceptionThruSeq *thrus;
+  ExceptionTo *to;
+  if (!exceptionPts(args, from, thrus, to))
+    return false;
+  sta_->makeFalsePath(from, thrus, to, setupHoldFlags(args),
+                      commentKey(args));
+  return true;
+}
+
+bool
+SdcCmdParser::setMulticyclePath(const SdcCmdWordSeq &words)
+{
+  SdcCmdArgs args;
+  int path_multiplier;
+  if (!args.parse(words, {"-from", "-rise_from", "-fall_from",
+                          "-to", "-rise_to", "-fall_to", "-comment"},
+                  {"-setup", "-hold", "-rise", "-fall",
+                   "-start", "-end", "-reset_path"},
+                  {"-through", "-rise_through", "-fall_through"})
+      || args.args_.size() != 1
+      || !parseInt(args.args_[0], path_multiplier)
+      || args.flag("-reset_path")
+      || (args.flag("-start") && args.flag("-end")))
+    return false;
+
+  const MinMaxAll *min_max = setupHoldFlags(args);
+  bool use_end_clk = (min_max != MinMaxAll::min());
+  if (args.flag("-start"))
+    use_end_clk = false;
+  else if (args.flag("-end"))
+    use_end_clk = true;
+  ExceptionFrom *from;
+  ExceptionThruSeq *thrus;
+  ExceptionTo *to;
+  if (!exceptionPts(args, from, thrus, to))
+    return false;
+  sta_->makeMulticyclePath(from, thrus, to, min_max, use_end_clk,
+                           path_multiplier, commentKey(args));
+  return true;
+}
+
+bool
+SdcCmdParser::setLoad(const SdcCmdWordSeq &words)
+{
+  SdcCmdArgs args;
+  if (!args.parse(words, {"-corner"},
+                  {"-rise", "-fall", "-min", "-max", "-subtract_pin_load",
+                   "-pin_load", "-wire_load"}, {})
+      || args.key("-corner")
+      || args.args_.size() != 2)
+    return false;
+  double cap;
+  if (!parseFloat(args.args_[0], cap)
+      || cap < 0.0)
+    return false;
+  cap = units_->capacitanceUnit()->userToSta(cap);
+  const SdcCmdWord *objects = args.args_[1];
+  if (!objects->is_objects_
+      || !objects->pins_.empty()
+      || !objects->insts_.empty()
+      || !objects->clks_.empty())
+    return false;
+
+  bool pin_load = args.flag("-pin_load");
+  bool wire_load = args.flag("-wire_load");
+  bool subtract_pin_load = args.flag("-subtract_pin_load");
+  const RiseFallBoth *rf = riseFallFlags(args);
+  const MinMaxAll *min_max = minMaxAllFlags(args);
+  if (!objects->nets_.empty()
+      && (pin_load || wire_load || rf != RiseFallBoth::riseFall()))
+    return false;
+  for (const Port *port : objects->ports_) {
+    // -pin_load is the default.
+    if (pin_load || !wire_load)
+      sta_->setPortExtPinCap(port, rf, nullptr, min_max, cap);
+    else
+      sta_->setPortExtWireCap(port, subtract_pin_load, rf, nullptr,
+                              min_max, cap);
+  }
+  for (const Net *net : objects->nets_)
+    sta_->setNetWireCap(net, subtract_pin_load, nullptr, min_max, cap);
+  return true;
+}
+
+bool
+SdcCmdParser::setMaxTransition(const SdcCmdWordSeq &words)
+{
+  SdcCmdArgs args;
+  if (!args.parse(words, {},
+                  {"-clock_path", "-data_path", "-rise", "-fall"}, {})
+      || args.args_.size() != 2)
+    return false;
+  double slew;
+  if (!parseFloat(args.args_[0], slew)
+      || slew < 0.0)
+    return false;
+  slew = units_->timeUnit()->userToSta(slew);
+  const SdcCmdWord *objects = args.args_[1];
+  bool clock_path = args.flag("-clock_path");
+  bool data_path = args.flag("-data_path");
+  const RiseFallBoth *rf = riseFallFlags(args);
+  if (!objects->is_objects_
+      || !objects->pins_.empty()
+      || !objects->insts_.empty()
+      || !objects->nets_.empty()
+      || (!objects->ports_.empty()
+          && (clock_path || data_path || args.flag("-rise")
+              || args.flag("-fall"))))
+    return false;
+
+  // Derate clk and data if neither -clock_path or -data_path.
+  if (clock_path || !data_path) {
+    for (Clock *clk : objects->clks_)
+      sta_->setSlewLimit(clk, rf, PathClkOrData::clk, MinMax::max(), slew);
+  }
+  if (data_path || !clock_path) {
+    for (Clock *clk : objects->clks_)
+      sta_->setSlewLimit(clk, rf, PathClkOrData::data, MinMax::max(), slew);
+  }
+  for (const Port *port : objects->ports_)
+    sta_->setSlewLimit(const_cast<Port*>(port), MinMax::max(), slew);
+  return true;
+}
+
+} // namespace
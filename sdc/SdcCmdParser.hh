@@ -0,0 +1,38 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace sta {
+
+class Sta;
+
+// Evaluate an SDC command without the Tcl interpreter.
+// The common commands (create_clock, set_input_delay, set_output_delay,
+// set_false_path, set_multicycle_path, set_load, set_max_transition)
+// with literal arguments and get_* object queries are parsed and applied
+// directly to the constraints.
+// Return false without changing anything if the command has to be
+// evaluated by Tcl instead. Commands that would warn or error are left
+// to Tcl so messages are the same either way.
+// The caller checks that the commands have not been redefined.
+bool
+evalSdcCmdNative(const char *cmd,
+                 const char *filename,
+                 int line,
+                 Sta *sta);
+
+} // namespace
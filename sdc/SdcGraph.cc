@@ -14,7 +14,10 @@
 // You should have received a copy of the GNU General Public License
 // along with this program. If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
+
 #include "Stats.hh"
+#include "DispatchQueue.hh"
 #include "PortDirection.hh"
 #include "Network.hh"
 #include "Graph.hh"
@@ -30,6 +33,61 @@ annotateGraphDisabledWireEdge(const Pin *from_pin,
 			      const Pin *to_pin,
 			      Graph *graph);
 
+static const size_t annotate_chunk_size = 1024;
+
+template <class VISIT>
+static void
+visitInstVertices(const Instance *inst,
+                  const Network *network,
+                  Graph *graph,
+                  VISIT &visit)
+{
+  InstancePinIterator *pin_iter = network->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    const Pin *pin = pin_iter->next();
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    if (vertex)
+      visit(vertex);
+    if (bidirect_drvr_vertex)
+      visit(bidirect_drvr_vertex);
+  }
+  delete pin_iter;
+}
+
+// Call visit(vertex) for every graph vertex. Chunks of leaf instances
+// are visited in parallel when there are threads. The vertices of an
+// instance and their out edges are only visited by one thread, so
+// visit can set vertex and edge flags without locking.
+template <class VISIT>
+static void
+visitGraphVertices(const StaState *sta,
+                   VISIT visit)
+{
+  Network *network = sta->network();
+  Graph *graph = sta->graph();
+  DispatchQueue *dispatch_queue = sta->dispatchQueue();
+  InstanceSeq insts = network->leafInstances();
+  size_t inst_count = insts.size();
+  if (dispatch_queue
+      && sta->threadCount() > 1
+      && inst_count >= annotate_chunk_size * 2) {
+    for (size_t from = 0; from < inst_count; from += annotate_chunk_size) {
+      size_t to = std::min(from + annotate_chunk_size, inst_count);
+      dispatch_queue->dispatch([=, &insts, &visit] (int) {
+        for (size_t i = from; i < to; i++)
+          visitInstVertices(insts[i], network, graph, visit);
+      });
+    }
+    dispatch_queue->finishTasks();
+  }
+  else {
+    for (const Instance *inst : insts)
+      visitInstVertices(inst, network, graph, visit);
+  }
+  visitInstVertices(network->topInstance(), network, graph, visit);
+}
+
 // Annotate constraints to the timing graph.
 void
 Sdc::annotateGraph()
@@ -69,14 +127,11 @@ Sdc::annotateDisables()
   }
 
   if (!disabled_lib_ports_.empty()) {
-    VertexIterator vertex_iter(graph_);
-    while (vertex_iter.hasNext()) {
-      Vertex *vertex = vertex_iter.next();
-      Pin *pin = vertex->pin();
-      LibertyPort *port = network_->libertyPort(pin);
+    visitGraphVertices(this, [this] (Vertex *vertex) {
+      LibertyPort *port = network_->libertyPort(vertex->pin());
       if (disabled_lib_ports_.hasKey(port))
-	annotateGraphDisabled(pin);
-    }
+        vertex->setIsDisabledConstraint(true);
+    });
   }
 
   Instance *top_inst = network_->topInstance();
@@ -363,9 +418,7 @@ Sdc::clockLatency(Edge *edge,
 void
 Sdc::removeGraphAnnotations()
 {
-  VertexIterator vertex_iter(graph_);
-  while (vertex_iter.hasNext()) {
-    Vertex *vertex = vertex_iter.next();
+  visitGraphVertices(this, [this] (Vertex *vertex) {
     vertex->setIsDisabledConstraint(false);
     vertex->setIsConstrained(false);
 
@@ -374,7 +427,7 @@ Sdc::removeGraphAnnotations()
       Edge *edge = edge_iter.next();
       edge->setIsDisabledConstraint(false);
     }
-  }
+  });
   edge_clk_latency_.clear();
 }
 
@@ -17,6 +17,7 @@
 #include "WriteSdc.hh"
 
 #include <cstdio>
+#include <cstdarg>
 #include <algorithm>
 #include <ctime>
 
@@ -135,7 +136,7 @@ void
 WriteGetPinAndClkKey::write() const
 {
   writer_->writeClockKey(clk_);
-  gzprintf(writer_->stream(), " ");
+  writer_->print(" ");
   writer_->writeGetPin(pin_, map_hpin_to_drvr_);
 }
 
@@ -302,7 +303,11 @@ WriteSdc::WriteSdc(Instance *instance,
   no_timestamp_(no_timestamp),
   top_instance_(instance == sdc_network_->topInstance()),
   instance_name_length_(strlen(sdc_network_->pathName(instance))),
-  cell_(sdc_network_->cell(instance))
+  cell_(sdc_network_->cell(instance)),
+  stream_(nullptr),
+  buffer_([this] (const string &text) {
+    gzwrite(stream_, text.data(), static_cast<unsigned>(text.size()));
+  })
 {
 }
 
@@ -323,6 +328,22 @@ WriteSdc::write(const char *filename,
   closeFile();
 }
 
+void
+WriteSdc::print(const char *fmt,
+                ...) const
+{
+  va_list args;
+  va_start(args, fmt);
+  buffer_.vprint(fmt, args);
+  va_end(args);
+}
+
+void
+WriteSdc::flushBuffer() const
+{
+  buffer_.flush();
+}
+
 void
 WriteSdc::openFile(const char *filename,
                    bool gzip)
@@ -335,6 +356,7 @@ WriteSdc::openFile(const char *filename,
 void
 WriteSdc::closeFile()
 {
+  flushBuffer();
   gzclose(stream_);
 }
 
@@ -342,18 +364,18 @@ void
 WriteSdc::writeHeader() const
 {
   writeCommentSeparator();
-  gzprintf(stream_, "# Created by %s\n", creator_);
+  print("# Created by %s\n", creator_);
   if (!no_timestamp_) {
     time_t now;
     time(&now);
     char *time_str = ctime(&now);
     // Remove trailing \n.
     time_str[strlen(time_str) - 1] = '\0';
-    gzprintf(stream_, "# %s\n", time_str);
+    print("# %s\n", time_str);
   }
   writeCommentSeparator();
 
-  gzprintf(stream_, "current_design %s\n", sdc_network_->name(cell_));
+  print("current_design %s\n", sdc_network_->name(cell_));
 }
 
 ////////////////////////////////////////////////////////////////
@@ -390,9 +412,9 @@ WriteSdc::writeClocks() const
     writeClockSlews(clk);
     writeClockUncertainty(clk);
     if (clk->isPropagated()) {
-      gzprintf(stream_, "set_propagated_clock ");
+      print("set_propagated_clock ");
       writeGetClock(clk);
-      gzprintf(stream_, "\n");
+      print("\n");
     }
   }
 }
@@ -400,69 +422,69 @@ WriteSdc::writeClocks() const
 void
 WriteSdc::writeClock(Clock *clk) const
 {
-  gzprintf(stream_, "create_clock -name %s",
-	  clk->name());
+  print("create_clock -name %s",
+        clk->name());
   if (clk->addToPins())
-    gzprintf(stream_, " -add");
-  gzprintf(stream_, " -period ");
+    print(" -add");
+  print(" -period ");
   float period = clk->period();
   writeTime(period);
   FloatSeq *waveform = clk->waveform();
   if (!(waveform->size() == 2
         && (*waveform)[0] == 0.0
         && fuzzyEqual((*waveform)[1], period / 2.0))) {
-    gzprintf(stream_, " -waveform ");
+    print(" -waveform ");
     writeFloatSeq(waveform, scaleTime(1.0));
   }
   writeCmdComment(clk);
-  gzprintf(stream_, " ");
+  print(" ");
   writeClockPins(clk);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
 WriteSdc::writeGeneratedClock(Clock *clk) const
 {
-  gzprintf(stream_, "create_generated_clock -name %s",
-	  clk->name());
+  print("create_generated_clock -name %s",
+        clk->name());
   if (clk->addToPins())
-    gzprintf(stream_, " -add");
-  gzprintf(stream_, " -source ");
+    print(" -add");
+  print(" -source ");
   writeGetPin(clk->srcPin(), true);
   Clock *master = clk->masterClk();
   if (master && !clk->masterClkInfered()) {
-    gzprintf(stream_, " -master_clock ");
+    print(" -master_clock ");
     writeGetClock(master);
   }
   if (clk->combinational())
-    gzprintf(stream_, " -combinational");
+    print(" -combinational");
   int divide_by = clk->divideBy();
   if (divide_by != 0)
-    gzprintf(stream_, " -divide_by %d", divide_by);
+    print(" -divide_by %d", divide_by);
   int multiply_by = clk->multiplyBy();
   if (multiply_by != 0)
-    gzprintf(stream_, " -multiply_by %d", multiply_by);
+    print(" -multiply_by %d", multiply_by);
   float duty_cycle = clk->dutyCycle();
   if (duty_cycle != 0.0) {
-    gzprintf(stream_, " -duty_cycle ");
+    print(" -duty_cycle ");
     writeFloat(duty_cycle);
   }
   if (clk->invert())
-    gzprintf(stream_, " -invert");
+    print(" -invert");
   IntSeq *edges = clk->edges();
   if (edges && !edges->empty()) {
-    gzprintf(stream_, " -edges ");
+    print(" -edges ");
     writeIntSeq(edges);
     FloatSeq *edge_shifts = clk->edgeShifts();
     if (edge_shifts && !edge_shifts->empty()) {
-      gzprintf(stream_, " -edge_shift ");
+      print(" -edge_shift ");
       writeFloatSeq(edge_shifts, scaleTime(1.0));
     }
   }
   writeCmdComment(clk);
-  gzprintf(stream_, " ");
+  print(" ");
   writeClockPins(clk);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
@@ -471,7 +493,7 @@ WriteSdc::writeClockPins(const Clock *clk) const
   const PinSet &pins = clk->pins();
   if (!pins.empty()) {
     if (pins.size() > 1)
-      gzprintf(stream_, "\\\n    ");
+      print("\\\n    ");
     writeGetPins(&pins, true);
   }
 }
@@ -509,9 +531,9 @@ WriteSdc::writeClockUncertainty(const Clock *clk,
 				const char *setup_hold,
 				float value) const
 {
-  gzprintf(stream_, "set_clock_uncertainty %s", setup_hold);
+  print("set_clock_uncertainty %s", setup_hold);
   writeTime(value);
-  gzprintf(stream_, " %s\n", clk->name());
+  print(" %s\n", clk->name());
 }
 
 void
@@ -551,11 +573,11 @@ WriteSdc::writeClockUncertaintyPin(const Pin *pin,
 				   const char *setup_hold,
 				   float value) const
 {
-  gzprintf(stream_, "set_clock_uncertainty %s", setup_hold);
+  print("set_clock_uncertainty %s", setup_hold);
   writeTime(value);
-  gzprintf(stream_, " ");
+  print(" ");
   writeGetPin(pin, true);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
@@ -628,9 +650,9 @@ WriteSdc::writePropagatedClkPins() const
   PinSet::Iterator pin_iter(sdc_->propagated_clk_pins_);
   while (pin_iter.hasNext()) {
     const Pin *pin = pin_iter.next();
-    gzprintf(stream_, "set_propagated_clock ");
+    print("set_propagated_clock ");
     writeGetPin(pin, true);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 }
 
@@ -658,13 +680,13 @@ writeInterClockUncertainty(InterClockUncertainty *uncertainty) const
   float value;
   if (src_rise->equal(src_fall)
       && src_rise->isOneValue(value)) {
-    gzprintf(stream_, "set_clock_uncertainty -from ");
+    print("set_clock_uncertainty -from ");
     writeGetClock(src_clk);
-    gzprintf(stream_, " -to ");
+    print(" -to ");
     writeGetClock(tgt_clk);
-    gzprintf(stream_, " ");
+    print(" ");
     writeTime(value);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
   else {
     for (auto src_rf : RiseFall::range()) {
@@ -675,16 +697,16 @@ writeInterClockUncertainty(InterClockUncertainty *uncertainty) const
 	  sdc_->clockUncertainty(src_clk, src_rf, tgt_clk, tgt_rf,
 					 setup_hold, value, exists);
 	  if (exists) {
-	    gzprintf(stream_, "set_clock_uncertainty -%s_from ",
-		    src_rf == RiseFall::rise() ? "rise" : "fall");
+	    print("set_clock_uncertainty -%s_from ",
+           src_rf == RiseFall::rise() ? "rise" : "fall");
 	    writeGetClock(uncertainty->src());
-	    gzprintf(stream_, " -%s_to ",
-		    tgt_rf == RiseFall::rise() ? "rise" : "fall");
+	    print(" -%s_to ",
+           tgt_rf == RiseFall::rise() ? "rise" : "fall");
 	    writeGetClock(uncertainty->target());
-	    gzprintf(stream_, " %s ",
-		    setupHoldFlag(setup_hold));
+	    print(" %s ",
+           setupHoldFlag(setup_hold));
 	    writeTime(value);
-	    gzprintf(stream_, "\n");
+	    print("\n");
 	  }
 	}
       }
@@ -796,25 +818,25 @@ WriteSdc::writePortDelay(PortDelay *port_delay,
 			 const MinMaxAll *min_max,
 			 const char *sdc_cmd) const
 {
-  gzprintf(stream_, "%s ", sdc_cmd);
+  print("%s ", sdc_cmd);
   writeTime(delay);
   const ClockEdge *clk_edge = port_delay->clkEdge();
   if (clk_edge) {
     writeClockKey(clk_edge->clock());
     if (clk_edge->transition() == RiseFall::fall())
-      gzprintf(stream_, " -clock_fall");
+      print(" -clock_fall");
   }
-  gzprintf(stream_, "%s%s -add_delay ",
-	  transRiseFallFlag(rf),
-	  minMaxFlag(min_max));
+  print("%s%s -add_delay ",
+        transRiseFallFlag(rf),
+        minMaxFlag(min_max));
   const Pin *ref_pin = port_delay->refPin();
   if (ref_pin) {
-    gzprintf(stream_, "-reference_pin ");
+    print("-reference_pin ");
     writeGetPin(ref_pin, true);
-    gzprintf(stream_, " ");
+    print(" ");
   }
   writeGetPin(port_delay->pin(), is_input_delay);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 class PinClockPairNameLess
@@ -878,15 +900,15 @@ WriteSdc::writeClockSense(PinClockPair &pin_clk,
     flag = "-negative";
   else if (sense == ClockSense::stop)
     flag = "-stop_propagation";
-  gzprintf(stream_, "set_sense -type clock %s ", flag);
+  print("set_sense -type clock %s ", flag);
   const Clock *clk = pin_clk.second;
   if (clk) {
-    gzprintf(stream_, "-clock ");
+    print("-clock ");
     writeGetClock(clk);
-    gzprintf(stream_, " ");
+    print(" ");
   }
   writeGetPin(pin_clk.first, true);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 class ClockGroupLess
@@ -946,15 +968,15 @@ WriteSdc::writeClockGroups() const
 void
 WriteSdc::writeClockGroups(ClockGroups *clk_groups) const
 {
-  gzprintf(stream_, "set_clock_groups -name %s ", clk_groups->name());
+  print("set_clock_groups -name %s ", clk_groups->name());
   if (clk_groups->logicallyExclusive())
-    gzprintf(stream_, "-logically_exclusive \\\n");
+    print("-logically_exclusive \\\n");
   else if (clk_groups->physicallyExclusive())
-    gzprintf(stream_, "-physically_exclusive \\\n");
+    print("-physically_exclusive \\\n");
   else if (clk_groups->asynchronous())
-    gzprintf(stream_, "-asynchronous \\\n");
+    print("-asynchronous \\\n");
   if (clk_groups->allowPaths())
-    gzprintf(stream_, "-allow_paths \\\n");
+    print("-allow_paths \\\n");
   Vector<ClockGroup*> groups;
   ClockGroupSet::Iterator group_iter1(clk_groups->groups());
   while (group_iter1.hasNext()) {
@@ -967,13 +989,13 @@ WriteSdc::writeClockGroups(ClockGroups *clk_groups) const
   while (group_iter2.hasNext()) {
     ClockGroup *clk_group = group_iter2.next();
     if (!first)
-      gzprintf(stream_, "\\\n");
-    gzprintf(stream_, " -group ");
+      print("\\\n");
+    print(" -group ");
     writeGetClocks(clk_group);
     first = false;
   }
   writeCmdComment(clk_groups);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 ////////////////////////////////////////////////////////////////
@@ -996,46 +1018,46 @@ WriteSdc::writeDisabledCells() const
   for (const DisabledCellPorts *disable : disables) {
     const LibertyCell *cell = disable->cell();
     if (disable->all()) {
-      gzprintf(stream_, "set_disable_timing ");
+      print("set_disable_timing ");
       writeGetLibCell(cell);
-      gzprintf(stream_, "\n");
+      print("\n");
     }
     if (disable->fromTo()) {
       LibertyPortPairSeq from_tos = sortByName(disable->fromTo());
       for (const LibertyPortPair &from_to : from_tos) {
 	const LibertyPort *from = from_to.first;
 	const LibertyPort *to = from_to.second;
-	gzprintf(stream_, "set_disable_timing -from {%s} -to {%s} ",
-		from->name(),
-		to->name());
+	print("set_disable_timing -from {%s} -to {%s} ",
+       from->name(),
+       to->name());
 	writeGetLibCell(cell);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
     if (disable->from()) {
       LibertyPortSeq from = sortByName(disable->from());
       for (const LibertyPort *from_port : from) {
-	gzprintf(stream_, "set_disable_timing -from {%s} ",
-		from_port->name());
+	print("set_disable_timing -from {%s} ",
+       from_port->name());
 	writeGetLibCell(cell);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
     if (disable->to()) {
       LibertyPortSeq to = sortByName(disable->to());
       for (const LibertyPort *to_port : to) {
-	gzprintf(stream_, "set_disable_timing -to {%s} ",
-		to_port->name());
+	print("set_disable_timing -to {%s} ",
+       to_port->name());
 	writeGetLibCell(cell);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
     if (disable->timingArcSets()) {
       // The only syntax to disable timing arc sets disables all of the
       // cell's timing arc sets.
-      gzprintf(stream_, "set_disable_timing ");
+      print("set_disable_timing ");
       writeGetTimingArcsOfOjbects(cell);
-      gzprintf(stream_, "\n");
+      print("\n");
     }
   }
 }
@@ -1045,9 +1067,9 @@ WriteSdc::writeDisabledPorts() const
 {
   const PortSeq ports = sortByName(sdc_->disabledPorts(), sdc_network_);
   for (const Port *port : ports) {
-    gzprintf(stream_, "set_disable_timing ");
+    print("set_disable_timing ");
     writeGetPort(port);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 }
 
@@ -1056,9 +1078,9 @@ WriteSdc::writeDisabledLibPorts() const
 {
   LibertyPortSeq ports = sortByName(sdc_->disabledLibPorts());
   for (LibertyPort *port : ports) {
-    gzprintf(stream_, "set_disable_timing ");
+    print("set_disable_timing ");
     writeGetLibPin(port);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 }
 
@@ -1070,38 +1092,38 @@ WriteSdc::writeDisabledInstances() const
   for (DisabledInstancePorts *disable : disables) {
     Instance *inst = disable->instance();
     if (disable->all()) {
-      gzprintf(stream_, "set_disable_timing ");
+      print("set_disable_timing ");
       writeGetInstance(inst);
-      gzprintf(stream_, "\n");
+      print("\n");
     }
     else if (disable->fromTo()) {
       LibertyPortPairSeq from_tos = sortByName(disable->fromTo());
       for (LibertyPortPair &from_to : from_tos) {
 	const LibertyPort *from_port = from_to.first;
 	const LibertyPort *to_port = from_to.second;
-	gzprintf(stream_, "set_disable_timing -from {%s} -to {%s} ",
-		from_port->name(),
-		to_port->name());
+	print("set_disable_timing -from {%s} -to {%s} ",
+       from_port->name(),
+       to_port->name());
 	writeGetInstance(inst);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
     if (disable->from()) {
       LibertyPortSeq from = sortByName(disable->from());
       for (const LibertyPort *from_port : from) {
-	gzprintf(stream_, "set_disable_timing -from {%s} ",
-		from_port->name());
+	print("set_disable_timing -from {%s} ",
+       from_port->name());
 	writeGetInstance(inst);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
     if (disable->to()) {
       LibertyPortSeq to = sortByName(disable->to());
       for (const LibertyPort *to_port : to) {
-	gzprintf(stream_, "set_disable_timing -to {%s} ",
-		to_port->name());
+	print("set_disable_timing -to {%s} ",
+       to_port->name());
 	writeGetInstance(inst);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
   }
@@ -1112,9 +1134,9 @@ WriteSdc::writeDisabledPins() const
 {
   PinSeq pins = sortByPathName(sdc_->disabledPins(), sdc_network_);
   for (const Pin *pin : pins) {
-    gzprintf(stream_, "set_disable_timing ");
+    print("set_disable_timing ");
     writeGetPin(pin, false);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 }
 
@@ -1165,20 +1187,20 @@ WriteSdc::edgeSenseIsUnique(Edge *edge,
 void
 WriteSdc::writeDisabledEdge(Edge *edge) const
 {
-  gzprintf(stream_, "set_disable_timing ");
+  print("set_disable_timing ");
   writeGetTimingArcs(edge);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
 WriteSdc::writeDisabledEdgeSense(Edge *edge) const
 {
-  gzprintf(stream_, "set_disable_timing ");
+  print("set_disable_timing ");
   const char *sense = timingSenseString(edge->sense());
   string filter;
   stringPrint(filter, "sense == %s", sense);
   writeGetTimingArcs(edge, filter.c_str());
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 ////////////////////////////////////////////////////////////////
@@ -1211,44 +1233,44 @@ WriteSdc::writeException(ExceptionPath *exception) const
     writeExceptionTo(exception->to());
   writeExceptionValue(exception);
   writeCmdComment(exception);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
 WriteSdc::writeExceptionCmd(ExceptionPath *exception) const
 {
   if (exception->isFalse()) {
-    gzprintf(stream_, "set_false_path");
+    print("set_false_path");
     writeSetupHoldFlag(exception->minMax());
   }
   else if (exception->isMultiCycle()) {
-    gzprintf(stream_, "set_multicycle_path");
+    print("set_multicycle_path");
     const MinMaxAll *min_max = exception->minMax();
     writeSetupHoldFlag(min_max);
     if (min_max == MinMaxAll::min()) {
       // For hold MCPs default is -start.
       if (exception->useEndClk())
-	gzprintf(stream_, " -end");
+	print(" -end");
     }
     else {
       // For setup MCPs default is -end.
       if (!exception->useEndClk())
-	gzprintf(stream_, " -start");
+	print(" -start");
     }
   }
   else if (exception->isPathDelay()) {
     if (exception->minMax() == MinMaxAll::max())
-      gzprintf(stream_, "set_max_delay");
+      print("set_max_delay");
     else
-      gzprintf(stream_, "set_min_delay");
+      print("set_min_delay");
     if (exception->ignoreClkLatency())
-      gzprintf(stream_, " -ignore_clock_latency");
+      print(" -ignore_clock_latency");
   }
   else if (exception->isGroupPath()) {
     if (exception->isDefault())
-      gzprintf(stream_, "group_path -default");
+      print("group_path -default");
     else
-      gzprintf(stream_, "group_path -name %s", exception->name());
+      print("group_path -name %s", exception->name());
   }
   else
     report_->critical(1620, "unknown exception type");
@@ -1258,10 +1280,10 @@ void
 WriteSdc::writeExceptionValue(ExceptionPath *exception) const
 {
   if (exception->isMultiCycle())
-    gzprintf(stream_, " %d",
-	    exception->pathMultiplier());
+    print(" %d",
+          exception->pathMultiplier());
   else if (exception->isPathDelay()) {
-    gzprintf(stream_, " ");
+    print(" ");
     writeTime(exception->delay());
   }
 }
@@ -1277,7 +1299,7 @@ WriteSdc::writeExceptionTo(ExceptionTo *to) const
 {
   const RiseFallBoth *end_rf = to->endTransition();
   if (end_rf != RiseFallBoth::riseFall())
-    gzprintf(stream_, "%s ", transRiseFallFlag(end_rf));
+    print("%s ", transRiseFallFlag(end_rf));
   if (to->hasObjects())
     writeExceptionFromTo(to, "to", false);
 }
@@ -1293,19 +1315,19 @@ WriteSdc::writeExceptionFromTo(ExceptionFromTo *from_to,
     rf_prefix = "-rise_";
   else if (rf == RiseFallBoth::fall())
     rf_prefix = "-fall_";
-  gzprintf(stream_, "\\\n    %s%s ", rf_prefix, from_to_key);
+  print("\\\n    %s%s ", rf_prefix, from_to_key);
   bool multi_objs =
     ((from_to->pins() ? from_to->pins()->size() : 0)
      + (from_to->clks() ? from_to->clks()->size() : 0)
      + (from_to->instances() ? from_to->instances()->size() : 0)) > 1;
   if (multi_objs)
-    gzprintf(stream_, "[list ");
+    print("[list ");
   bool first = true;
   if (from_to->pins()) {
     PinSeq pins = sortByPathName(from_to->pins(), sdc_network_);
     for (const Pin *pin : pins) {
       if (multi_objs && !first)
-	gzprintf(stream_, "\\\n           ");
+	print("\\\n           ");
       writeGetPin(pin, map_hpin_to_drvr);
       first = false;
     }
@@ -1316,13 +1338,13 @@ WriteSdc::writeExceptionFromTo(ExceptionFromTo *from_to,
     InstanceSeq insts = sortByPathName(from_to->instances(), sdc_network_);
     for (const Instance *inst : insts) {
       if (multi_objs && !first)
-	gzprintf(stream_, "\\\n           ");
+	print("\\\n           ");
       writeGetInstance(inst);
       first = false;
     }
   }
   if (multi_objs)
-    gzprintf(stream_, "]");
+    print("]");
 }
 
 void
@@ -1334,7 +1356,7 @@ WriteSdc::writeExceptionThru(ExceptionThru *thru) const
     rf_prefix = "-rise_";
   else if (rf == RiseFallBoth::fall())
     rf_prefix = "-fall_";
-  gzprintf(stream_, "\\\n    %sthrough ", rf_prefix);
+  print("\\\n    %sthrough ", rf_prefix);
   PinSeq pins;
   mapThruHpins(thru, pins);
   bool multi_objs =
@@ -1342,12 +1364,12 @@ WriteSdc::writeExceptionThru(ExceptionThru *thru) const
      + (thru->nets() ? thru->nets()->size() : 0)
      + (thru->instances() ? thru->instances()->size() : 0)) > 1;
   if (multi_objs)
-    gzprintf(stream_, "[list ");
+    print("[list ");
   bool first = true;
   sort(pins, PinPathNameLess(network_));
   for (const Pin *pin : pins) {
     if (multi_objs && !first)
-      gzprintf(stream_, "\\\n           ");
+      print("\\\n           ");
     writeGetPin(pin);
     first = false;
   }
@@ -1356,7 +1378,7 @@ WriteSdc::writeExceptionThru(ExceptionThru *thru) const
     NetSeq nets = sortByPathName(thru->nets(), sdc_network_);
     for (const Net *net : nets) {
       if (multi_objs && !first)
-	gzprintf(stream_, "\\\n           ");
+	print("\\\n           ");
       writeGetNet(net);
       first = false;
     }
@@ -1365,13 +1387,13 @@ WriteSdc::writeExceptionThru(ExceptionThru *thru) const
     InstanceSeq insts = sortByPathName(thru->instances(), sdc_network_);
     for (const Instance *inst : insts) {
       if (multi_objs && !first)
-	gzprintf(stream_, "\\\n           ");
+	print("\\\n           ");
       writeGetInstance(inst);
       first = false;
     }
   }
   if (multi_objs)
-    gzprintf(stream_, "]");
+    print("]");
 }
 
 void
@@ -1456,19 +1478,19 @@ WriteSdc::writeDataCheck(DataCheck *check,
     from_key = "-rise_from";
   else if (from_rf == RiseFallBoth::fall())
     from_key = "-fall_from";
-  gzprintf(stream_, "set_data_check %s ", from_key);
+  print("set_data_check %s ", from_key);
   writeGetPin(check->from(), true);
   const char *to_key = "-to";
   if (to_rf == RiseFallBoth::rise())
     to_key = "-rise_to";
   else if (to_rf == RiseFallBoth::fall())
     to_key = "-fall_to";
-  gzprintf(stream_, " %s ", to_key);
+  print(" %s ", to_key);
   writeGetPin(check->to(), false);
-  gzprintf(stream_, "%s ",
-	  setupHoldFlag(setup_hold));
+  print("%s ",
+        setupHoldFlag(setup_hold));
   writeTime(margin);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 ////////////////////////////////////////////////////////////////
@@ -1496,7 +1518,7 @@ WriteSdc::writeOperatingConditions() const
 {
   OperatingConditions *cond = sdc_->operatingConditions(MinMax::max());
   if (cond)
-    gzprintf(stream_, "set_operating_conditions %s\n", cond->name());
+    print("set_operating_conditions %s\n", cond->name());
 }
 
 void
@@ -1504,8 +1526,8 @@ WriteSdc::writeWireload() const
 {
   WireloadMode wireload_mode = sdc_->wireloadMode();
   if (wireload_mode != WireloadMode::unknown)
-    gzprintf(stream_, "set_wire_load_mode \"%s\"\n",
-	    wireloadModeString(wireload_mode));
+    print("set_wire_load_mode \"%s\"\n",
+          wireloadModeString(wireload_mode));
 }
 
 void
@@ -1536,12 +1558,12 @@ WriteSdc::writeNetLoad(const Net *net,
 		       const MinMaxAll *min_max,
 		       float cap) const
 {
-  gzprintf(stream_, "set_load ");
-  gzprintf(stream_, "%s ", minMaxFlag(min_max));
+  print("set_load ");
+  print("%s ", minMaxFlag(min_max));
   writeCapacitance(cap);
-  gzprintf(stream_, " ");
+  print(" ");
   writeGetNet(net);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
@@ -1586,12 +1608,12 @@ WriteSdc::writeDriveResistances() const
 	  float res;
 	  bool exists;
 	  drive->driveResistance(rf, MinMax::max(), res, exists);
-	  gzprintf(stream_, "set_drive %s ",
-		  transRiseFallFlag(rf));
+	  print("set_drive %s ",
+         transRiseFallFlag(rf));
 	  writeResistance(res);
-	  gzprintf(stream_, " ");
+	  print(" ");
 	  writeGetPort(port);
-	  gzprintf(stream_, "\n");
+	  print("\n");
 	}
 	else {
 	  for (auto min_max : MinMax::range()) {
@@ -1599,13 +1621,13 @@ WriteSdc::writeDriveResistances() const
 	    bool exists;
 	    drive->driveResistance(rf, min_max, res, exists);
 	    if (exists) {
-	      gzprintf(stream_, "set_drive %s %s ",
-		      transRiseFallFlag(rf),
-		      minMaxFlag(min_max));
+	      print("set_drive %s %s ",
+             transRiseFallFlag(rf),
+             minMaxFlag(min_max));
 	      writeResistance(res);
-	      gzprintf(stream_, " ");
+	      print(" ");
 	      writeGetPort(port);
-	      gzprintf(stream_, "\n");
+	      print("\n");
 	    }
 	  }
 	}
@@ -1682,27 +1704,26 @@ WriteSdc::writeDrivingCell(Port *port,
   const LibertyPort *to_port = drive_cell->toPort();
   float *from_slews = drive_cell->fromSlews();
   const LibertyLibrary *lib = drive_cell->library();
-  gzprintf(stream_, "set_driving_cell");
+  print("set_driving_cell");
   if (rf)
-    gzprintf(stream_, " %s", transRiseFallFlag(rf));
+    print(" %s", transRiseFallFlag(rf));
   if (min_max)
-    gzprintf(stream_, " %s", minMaxFlag(min_max));
+    print(" %s", minMaxFlag(min_max));
   // Only write -library if it was specified in the sdc.
   if (lib)
-    gzprintf(stream_, " -library %s", lib->name());
-  gzprintf(stream_, " -lib_cell %s", cell->name());
+    print(" -library %s", lib->name());
+  print(" -lib_cell %s", cell->name());
   if (from_port)
-    gzprintf(stream_, " -from_pin {%s}",
-	    from_port->name());
-  gzprintf(stream_,
-	  " -pin {%s} -input_transition_rise ",
-	  to_port->name());
+    print(" -from_pin {%s}",
+          from_port->name());
+  print(" -pin {%s} -input_transition_rise ",
+        to_port->name());
   writeTime(from_slews[RiseFall::riseIndex()]);
-  gzprintf(stream_, " -input_transition_fall ");
+  print(" -input_transition_fall ");
   writeTime(from_slews[RiseFall::fallIndex()]);
-  gzprintf(stream_, " ");
+  print(" ");
   writeGetPort(port);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
@@ -1752,11 +1773,11 @@ WriteSdc::writeNetResistance(const Net *net,
 			     const MinMaxAll *min_max,
 			     float res) const
 {
-  gzprintf(stream_, "set_resistance ");
+  print("set_resistance ");
   writeResistance(res);
-  gzprintf(stream_, "%s ", minMaxFlag(min_max));
+  print("%s ", minMaxFlag(min_max));
   writeGetNet(net);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
@@ -1772,9 +1793,9 @@ void
 WriteSdc::writeConstant(const Pin *pin) const
 {
   const char *cmd = setConstantCmd(pin);
-  gzprintf(stream_, "%s ", cmd);
+  print("%s ", cmd);
   writeGetPin(pin, false);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 const char *
@@ -1812,9 +1833,9 @@ void
 WriteSdc::writeCaseAnalysis(const Pin *pin) const
 {
   const char *value_str = caseAnalysisValueStr(pin);
-  gzprintf(stream_, "set_case_analysis %s ", value_str);
+  print("set_case_analysis %s ", value_str);
   writeGetPin(pin, false);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 const char *
@@ -1906,9 +1927,9 @@ WriteSdc::writeDerating(DeratingFactorsGlobal *factors) const
 	&& (!cell_check_factors->hasValue()
 	    || (check_is_one_value && check_value == 1.0))) {
       if (delay_value != 1.0) {
-	gzprintf(stream_, "set_timing_derate %s ", earlyLateFlag(early_late));
+	print("set_timing_derate %s ", earlyLateFlag(early_late));
 	writeFloat(delay_value);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
     else {
@@ -1947,15 +1968,15 @@ WriteSdc::writeDerating(DeratingFactors *factors,
   factors->isOneValue(early_late, is_one_value, value);
   if (is_one_value) {
     if (value != 1.0) {
-      gzprintf(stream_, "set_timing_derate %s %s ",
-	      type_key,
-	      earlyLateFlag(early_late));
+      print("set_timing_derate %s %s ",
+            type_key,
+            earlyLateFlag(early_late));
       writeFloat(value);
       if (write_obj) {
-	gzprintf(stream_, " ");
+	print(" ");
 	write_obj->write();
       }
-      gzprintf(stream_, "\n");
+      print("\n");
     }
   }
   else {
@@ -1968,16 +1989,16 @@ WriteSdc::writeDerating(DeratingFactors *factors,
       factors->isOneValue(clk_data, early_late, is_one_value, value);
       if (is_one_value) {
 	if (value != 1.0) {
-	  gzprintf(stream_, "set_timing_derate %s %s %s ",
-		  type_key,
-		  earlyLateFlag(early_late),
-		  clk_data_key);
+	  print("set_timing_derate %s %s %s ",
+         type_key,
+         earlyLateFlag(early_late),
+         clk_data_key);
 	  writeFloat(value);
 	  if (write_obj) {
-	    gzprintf(stream_, " ");
+	    print(" ");
 	    write_obj->write();
 	  }
-	  gzprintf(stream_, "\n");
+	  print("\n");
 	}
       }
       else {
@@ -1986,17 +2007,17 @@ WriteSdc::writeDerating(DeratingFactors *factors,
 	  bool exists;
 	  factors->factor(clk_data, rf, early_late, factor, exists);
 	  if (exists) {
-	    gzprintf(stream_, "set_timing_derate %s %s %s %s ",
-		    type_key,
-		    clk_data_key,
-		    transRiseFallFlag(rf),
-		    earlyLateFlag(early_late));
+	    print("set_timing_derate %s %s %s %s ",
+           type_key,
+           clk_data_key,
+           transRiseFallFlag(rf),
+           earlyLateFlag(early_late));
 	    writeFloat(factor);
 	    if (write_obj) {
-	      gzprintf(stream_, " ");
+	      print(" ");
 	      write_obj->write();
 	    }
-	    gzprintf(stream_, "\n");
+	    print("\n");
 	  }
 	}
       }
@@ -2022,11 +2043,11 @@ WriteSdc::writeVoltages() const
   if (exists_max) {
     sdc_->voltage(MinMax::min(), voltage_min, exists_min);
     if (exists_min)
-      gzprintf(stream_, "set_voltage -min %.3f %.3f\n",
-               voltage_min,
-               voltage_max);
+      print("set_voltage -min %.3f %.3f\n",
+            voltage_min,
+            voltage_max);
     else
-      gzprintf(stream_, "set_voltage %.3f\n", voltage_max);
+      print("set_voltage %.3f\n", voltage_max);
   }
 
   for (auto net_volt : sdc_->net_voltage_map_) {
@@ -2036,14 +2057,14 @@ WriteSdc::writeVoltages() const
     if (exists_max) {
       values.value(MinMax::min(), voltage_min, exists_min);
       if (exists_min)
-        gzprintf(stream_, "set_voltage -object_list %s -min %.3f %.3f\n",
-                 sdc_network_->pathName(net),
-                 voltage_min,
-                 voltage_max);
+        print("set_voltage -object_list %s -min %.3f %.3f\n",
+              sdc_network_->pathName(net),
+              voltage_min,
+              voltage_max);
       else
-        gzprintf(stream_, "set_voltage -object_list %s %.3f\n",
-                 sdc_network_->pathName(net),
-                 voltage_max);
+        print("set_voltage -object_list %s %.3f\n",
+              sdc_network_->pathName(net),
+              voltage_max);
     }
   }
 }
@@ -2111,11 +2132,11 @@ WriteSdc::writeMinPulseWidth(const char *hi_low,
 			     float value,
 			     WriteSdcObject &write_obj) const
 {
-  gzprintf(stream_, "set_min_pulse_width %s", hi_low);
+  print("set_min_pulse_width %s", hi_low);
   writeTime(value);
-  gzprintf(stream_, " ");
+  print(" ");
   write_obj.write();
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 ////////////////////////////////////////////////////////////////
@@ -2126,31 +2147,31 @@ WriteSdc::writeLatchBorowLimits() const
   for (auto pin_borrow : sdc_->pin_latch_borrow_limit_map_) {
     const Pin *pin = pin_borrow.first;
     float limit = pin_borrow.second;
-    gzprintf(stream_, "set_max_time_borrow ");
+    print("set_max_time_borrow ");
     writeTime(limit);
-    gzprintf(stream_, " ");
+    print(" ");
     writeGetPin(pin, false);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 
   for (auto inst_borrow : sdc_->inst_latch_borrow_limit_map_) {
     const Instance *inst = inst_borrow.first;
     float limit = inst_borrow.second;
-    gzprintf(stream_, "set_max_time_borrow ");
+    print("set_max_time_borrow ");
     writeTime(limit);
-    gzprintf(stream_, " ");
+    print(" ");
     writeGetInstance(inst);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 
   for (auto clk_borrow : sdc_->clk_latch_borrow_limit_map_) {
     const Clock *clk = clk_borrow.first;
     float limit = clk_borrow.second;
-    gzprintf(stream_, "set_max_time_borrow ");
+    print("set_max_time_borrow ");
     writeTime(limit);
-    gzprintf(stream_, " ");
+    print(" ");
     writeGetClock(clk);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 }
 
@@ -2164,9 +2185,9 @@ WriteSdc::writeSlewLimits() const
   bool exists;
   sdc_->slewLimit(cell_, min_max, slew, exists);
   if (exists) {
-    gzprintf(stream_, "set_max_transition ");
+    print("set_max_transition ");
     writeTime(slew);
-    gzprintf(stream_, " [current_design]\n");
+    print(" [current_design]\n");
   }
 
   CellPortBitIterator *port_iter = sdc_network_->portBitIterator(cell_);
@@ -2174,11 +2195,11 @@ WriteSdc::writeSlewLimits() const
     Port *port = port_iter->next();
     sdc_->slewLimit(port, min_max, slew, exists);
     if (exists) {
-      gzprintf(stream_, "set_max_transition ");
+      print("set_max_transition ");
       writeTime(slew);
-      gzprintf(stream_, " ");
+      print(" ");
       writeGetPort(port);
-      gzprintf(stream_, "\n");
+      print("\n");
     }
   }
   delete port_iter;
@@ -2239,11 +2260,11 @@ WriteSdc::writeClkSlewLimit(const char *clk_data,
 			    const Clock *clk,
 			    float limit) const
 {
-  gzprintf(stream_, "set_max_transition %s%s", clk_data, rise_fall);
+  print("set_max_transition %s%s", clk_data, rise_fall);
   writeTime(limit);
-  gzprintf(stream_, " ");
+  print(" ");
   writeGetClock(clk);
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
@@ -2261,9 +2282,9 @@ WriteSdc::writeCapLimits(const MinMax *min_max,
   bool exists;
   sdc_->capacitanceLimit(cell_, min_max, cap, exists);
   if (exists) {
-    gzprintf(stream_, "%s ", cmd);
+    print("%s ", cmd);
     writeCapacitance(cap);
-    gzprintf(stream_, " [current_design]\n");
+    print(" [current_design]\n");
   }
 
   for (auto port_limit : sdc_->port_cap_limit_map_) {
@@ -2273,11 +2294,11 @@ WriteSdc::writeCapLimits(const MinMax *min_max,
     bool exists;
     values.value(min_max, cap, exists);
     if (exists) {
-      gzprintf(stream_, "%s ", cmd);
+      print("%s ", cmd);
       writeCapacitance(cap);
-      gzprintf(stream_, " ");
+      print(" ");
       writeGetPort(port);
-      gzprintf(stream_, "\n");
+      print("\n");
     }
   }
 
@@ -2288,11 +2309,11 @@ WriteSdc::writeCapLimits(const MinMax *min_max,
     bool exists;
     values.value(min_max, cap, exists);
     if (exists) {
-      gzprintf(stream_, "%s ", cmd);
+      print("%s ", cmd);
       writeCapacitance(cap);
-      gzprintf(stream_, " ");
+      print(" ");
       writeGetPin(pin, false);
-      gzprintf(stream_, "\n");
+      print("\n");
     }
   }
 }
@@ -2302,9 +2323,9 @@ WriteSdc::writeMaxArea() const
 {
   float max_area = sdc_->maxArea();
   if (max_area > 0.0) {
-    gzprintf(stream_, "set_max_area ");
+    print("set_max_area ");
     writeFloat(max_area);
-    gzprintf(stream_, "\n");
+    print("\n");
   }
 }
 
@@ -2323,9 +2344,9 @@ WriteSdc::writeFanoutLimits(const MinMax *min_max,
   bool exists;
   sdc_->fanoutLimit(cell_, min_max, fanout, exists);
   if (exists) {
-    gzprintf(stream_, "%s ", cmd);
+    print("%s ", cmd);
     writeFloat(fanout);
-    gzprintf(stream_, " [current_design]\n");
+    print(" [current_design]\n");
   }
   else {
     CellPortBitIterator *port_iter = sdc_network_->portBitIterator(cell_);
@@ -2333,11 +2354,11 @@ WriteSdc::writeFanoutLimits(const MinMax *min_max,
       Port *port = port_iter->next();
       sdc_->fanoutLimit(port, min_max, fanout, exists);
       if (exists) {
-	gzprintf(stream_, "%s ", cmd);
+	print("%s ", cmd);
 	writeFloat(fanout);
-	gzprintf(stream_, " ");
+	print(" ");
 	writeGetPort(port);
-	gzprintf(stream_, "\n");
+	print("\n");
       }
     }
     delete port_iter;
@@ -2351,15 +2372,15 @@ WriteSdc::writeVariables() const
 {
   if (sdc_->propagateAllClocks()) {
     if (native_)
-      gzprintf(stream_, "set sta_propagate_all_clocks 1\n");
+      print("set sta_propagate_all_clocks 1\n");
     else
-      gzprintf(stream_, "set timing_all_clocks_propagated true\n");
+      print("set timing_all_clocks_propagated true\n");
   }
   if (sdc_->presetClrArcsEnabled()) {
     if (native_)
-      gzprintf(stream_, "set sta_preset_clear_arcs_enabled 1\n");
+      print("set sta_preset_clear_arcs_enabled 1\n");
     else
-      gzprintf(stream_, "set timing_enable_preset_clear_arcs true\n");
+      print("set timing_enable_preset_clear_arcs true\n");
   }
 }
 
@@ -2368,9 +2389,9 @@ WriteSdc::writeVariables() const
 void
 WriteSdc::writeGetTimingArcsOfOjbects(const LibertyCell *cell) const
 {
-  gzprintf(stream_, "[%s -of_objects ", getTimingArcsCmd());
+  print("[%s -of_objects ", getTimingArcsCmd());
   writeGetLibCell(cell);
-  gzprintf(stream_, "]");
+  print("]");
 }
 
 void
@@ -2383,15 +2404,15 @@ void
 WriteSdc::writeGetTimingArcs(Edge *edge,
 			     const char *filter) const
 {
-  gzprintf(stream_, "[%s -from ", getTimingArcsCmd());
+  print("[%s -from ", getTimingArcsCmd());
   Vertex *from_vertex = edge->from(graph_);
   writeGetPin(from_vertex->pin(), true);
-  gzprintf(stream_, " -to ");
+  print(" -to ");
   Vertex *to_vertex = edge->to(graph_);
   writeGetPin(to_vertex->pin(), false);
   if (filter)
-    gzprintf(stream_, " -filter {%s}", filter);
-  gzprintf(stream_, "]");
+    print(" -filter {%s}", filter);
+  print("]");
 }
 
 const char *
@@ -2405,9 +2426,9 @@ WriteSdc::getTimingArcsCmd() const
 void
 WriteSdc::writeGetLibCell(const LibertyCell *cell) const
 {
-  gzprintf(stream_, "[get_lib_cells {%s/%s}]",
-	  cell->libertyLibrary()->name(),
-	  cell->name());
+  print("[get_lib_cells {%s/%s}]",
+        cell->libertyLibrary()->name(),
+        cell->name());
 }
 
 void
@@ -2415,10 +2436,10 @@ WriteSdc::writeGetLibPin(const LibertyPort *port) const
 {
   LibertyCell *cell = port->libertyCell();
   LibertyLibrary *lib = cell->libertyLibrary();
-  gzprintf(stream_, "[get_lib_pins {%s/%s/%s}]",
-	  lib->name(),
-	  cell->name(),
-	  port->name());
+  print("[get_lib_pins {%s/%s/%s}]",
+        lib->name(),
+        cell->name(),
+        port->name());
 }
 
 void
@@ -2427,10 +2448,10 @@ WriteSdc::writeGetClocks(ClockSet *clks) const
   bool first = true;
   bool multiple = clks->size() > 1;
   if (multiple)
-    gzprintf(stream_, "[list ");
+    print("[list ");
   writeGetClocks(clks, multiple, first);
   if (multiple)
-    gzprintf(stream_, "]");
+    print("]");
 }
 
 void
@@ -2441,7 +2462,7 @@ WriteSdc::writeGetClocks(ClockSet *clks,
   ClockSeq clks1 = sortByName(clks);
   for (const Clock *clk : clks1) {
     if (multiple && !first)
-      gzprintf(stream_, "\\\n           ");
+      print("\\\n           ");
     writeGetClock(clk);
     first = false;
   }
@@ -2450,14 +2471,14 @@ WriteSdc::writeGetClocks(ClockSet *clks,
 void
 WriteSdc::writeGetClock(const Clock *clk) const
 {
-  gzprintf(stream_, "[get_clocks {%s}]",
-	  clk->name());
+  print("[get_clocks {%s}]",
+        clk->name());
 }
 
 void
 WriteSdc::writeGetPort(const Port *port) const
 {
-  gzprintf(stream_, "[get_ports {%s}]", sdc_network_->name(port));
+  print("[get_ports {%s}]", sdc_network_->name(port));
 }
 
 void
@@ -2490,25 +2511,25 @@ WriteSdc::writeGetPins1(PinSeq *pins) const
 {
   bool multiple = pins->size() > 1;
   if (multiple)
-    gzprintf(stream_, "[list ");
+    print("[list ");
   bool first = true;
   for (const Pin *pin : *pins) {
     if (multiple && !first)
-      gzprintf(stream_, "\\\n          ");
+      print("\\\n          ");
     writeGetPin(pin);
     first = false;
   }
   if (multiple)
-    gzprintf(stream_, "]");
+    print("]");
 }
 
 void
 WriteSdc::writeGetPin(const Pin *pin) const
 {
   if (sdc_network_->instance(pin) == instance_)
-    gzprintf(stream_, "[get_ports {%s}]", sdc_network_->portName(pin));
+    print("[get_ports {%s}]", sdc_network_->portName(pin));
   else
-    gzprintf(stream_, "[get_pins {%s}]", pathName(pin));
+    print("[get_pins {%s}]", pathName(pin));
 }
 
 void
@@ -2527,13 +2548,13 @@ WriteSdc::writeGetPin(const Pin *pin,
 void
 WriteSdc::writeGetNet(const Net *net) const
 {
-  gzprintf(stream_, "[get_nets {%s}]", pathName(net));
+  print("[get_nets {%s}]", pathName(net));
 }
 
 void
 WriteSdc::writeGetInstance(const Instance *inst) const
 {
-  gzprintf(stream_, "[get_cells {%s}]", pathName(inst));
+  print("[get_cells {%s}]", pathName(inst));
 }
 
 const char *
@@ -2570,14 +2591,14 @@ void
 WriteSdc::writeCommentSection(const char *line) const
 {
   writeCommentSeparator();
-  gzprintf(stream_, "# %s\n", line);
+  print("# %s\n", line);
   writeCommentSeparator();
 }
 
 void
 WriteSdc::writeCommentSeparator() const
 {
-  gzprintf(stream_, "###############################################################################\n");
+  print("###############################################################################\n");
 }
 
 ////////////////////////////////////////////////////////////////
@@ -2675,20 +2696,20 @@ WriteSdc::writeRiseFallMinMaxCmd(const char *sdc_cmd,
 				 const MinMaxAll *min_max,
 				 WriteSdcObject &write_object) const
 {
-  gzprintf(stream_, "%s%s%s ",
-	  sdc_cmd,
-	  transRiseFallFlag(rf),
-	  minMaxFlag(min_max));
+  print("%s%s%s ",
+        sdc_cmd,
+        transRiseFallFlag(rf),
+        minMaxFlag(min_max));
   writeFloat(value / scale);
-  gzprintf(stream_, " ");
+  print(" ");
   write_object.write();
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
 WriteSdc::writeClockKey(const Clock *clk) const
 {
-  gzprintf(stream_, " -clock ");
+  print(" -clock ");
   writeGetClock(clk);
 }
 
@@ -2724,13 +2745,13 @@ WriteSdc::writeMinMaxFloatCmd(const char *sdc_cmd,
 			      const MinMaxAll *min_max,
 			      WriteSdcObject &write_object) const
 {
-  gzprintf(stream_, "%s%s ",
-	  sdc_cmd,
-	  minMaxFlag(min_max));
+  print("%s%s ",
+        sdc_cmd,
+        minMaxFlag(min_max));
   writeFloat(value / scale);
-  gzprintf(stream_, " ");
+  print(" ");
   write_object.write();
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 void
@@ -2761,12 +2782,12 @@ WriteSdc::writeMinMaxIntCmd(const char *sdc_cmd,
 			    const MinMaxAll *min_max,
 			    WriteSdcObject &write_object) const
 {
-  gzprintf(stream_, "%s%s ",
-	  sdc_cmd,
-	  minMaxFlag(min_max));
-  gzprintf(stream_, "%d ", value);
+  print("%s%s ",
+        sdc_cmd,
+        minMaxFlag(min_max));
+  print("%d ", value);
   write_object.write();
-  gzprintf(stream_, "\n");
+  print("\n");
 }
 
 ////////////////////////////////////////////////////////////////
@@ -2792,54 +2813,54 @@ WriteSdc::scaleResistance(float res) const
 void
 WriteSdc::writeFloat(float value) const
 {
-  gzprintf(stream_, "%.*f", digits_, value);
+  print("%.*f", digits_, value);
 }
 
 void
 WriteSdc::writeTime(float time) const
 {
-  gzprintf(stream_, "%.*f", digits_, scaleTime(time));
+  print("%.*f", digits_, scaleTime(time));
 }
 
 void
 WriteSdc::writeCapacitance(float cap) const
 {
-  gzprintf(stream_, "%.*f", digits_, scaleCapacitance(cap));
+  print("%.*f", digits_, scaleCapacitance(cap));
 }
 
 void
 WriteSdc::writeResistance(float res) const
 {
-  gzprintf(stream_, "%.*f", digits_, scaleResistance(res));
+  print("%.*f", digits_, scaleResistance(res));
 }
 
 void
 WriteSdc::writeFloatSeq(FloatSeq *floats,
 			float scale) const
 {
-  gzprintf(stream_, "{");
+  print("{");
   bool first = true;
   for (float flt : *floats) {
     if (!first)
-      gzprintf(stream_, " ");
+      print(" ");
     writeFloat(flt * scale);
     first = false;
   }
-  gzprintf(stream_, "}");
+  print("}");
 }
 
 void
 WriteSdc::writeIntSeq(IntSeq *ints) const
 {
-  gzprintf(stream_, "{");
+  print("{");
   bool first = true;
   for (int i : *ints) {
     if (!first)
-      gzprintf(stream_, " ");
-    gzprintf(stream_, "%d", i);
+      print(" ");
+    print("%d", i);
     first = false;
   }
-  gzprintf(stream_, "}");
+  print("}");
 }
 
 
@@ -2889,9 +2910,9 @@ void
 WriteSdc::writeSetupHoldFlag(const MinMaxAll *min_max) const
 {
   if (min_max == MinMaxAll::min())
-    gzprintf(stream_,  " -hold");
+    print( " -hold");
   else if (min_max == MinMaxAll::max())
-    gzprintf(stream_,  " -setup");
+    print( " -setup");
 }
 
 static const char *
@@ -2905,7 +2926,7 @@ WriteSdc::writeCmdComment(SdcCmdComment *cmd) const
 {
   const char *comment = cmd->comment();
   if (comment) {
-    gzprintf(stream_,  " -comment {%s}", comment);
+    print( " -comment {%s}", comment);
   }
 }
 
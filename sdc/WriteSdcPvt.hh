@@ -17,6 +17,7 @@
 #pragma once
 
 #include "Zlib.hh"
+#include "BufferedWriter.hh"
 #include "NetworkClass.hh"
 #include "GraphClass.hh"
 #include "Sdc.hh"
@@ -250,6 +251,11 @@ public:
   void writeCmdComment(SdcCmdComment *cmd) const;
 
   gzFile stream() const { return stream_; }
+  // Write to the output buffer.
+  void print(const char *fmt,
+             ...) const;
+  // Write the buffered output to stream().
+  void flushBuffer() const;
 
 protected:
   Instance *instance_;
@@ -262,6 +268,8 @@ protected:
   size_t instance_name_length_;
   Cell *cell_;
   gzFile stream_;
+  // Formatted text waiting to be written to stream_.
+  mutable BufferedWriter buffer_;
 };
 
 } // namespace
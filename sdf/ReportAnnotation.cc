@@ -16,6 +16,9 @@
 
 #include "sdf/ReportAnnotation.hh"
 
+#include <algorithm>
+
+#include "DispatchQueue.hh"
 #include "StringUtil.hh"
 #include "Report.hh"
 #include "TimingRole.hh"
@@ -29,6 +32,8 @@
 
 namespace sta {
 
+static const size_t annotation_chunk_size = 4096;
+
 class ReportAnnotated : public StaState
 {
 public:
@@ -66,9 +71,27 @@ protected:
   };
   static int count_delay;
 
+  // Counts and pins found by one thread.
+  class AnnotationCounts
+  {
+  public:
+    AnnotationCounts(const Network *network);
+
+    int edge_count_[count_index_max];
+    int edge_annotated_count_[count_index_max];
+    int edge_constant_count_[count_index_max];
+    int edge_constant_annotated_count_[count_index_max];
+    PinSet unannotated_pins_;
+    PinSet annotated_pins_;
+  };
+
   void init();
   void findCounts();
-  void findPeriodCount(Pin *pin);
+  void findCounts(Vertex *from_vertex,
+                  AnnotationCounts &counts);
+  void findPeriodCount(Pin *pin,
+                       AnnotationCounts &counts);
+  void mergeCounts(const AnnotationCounts &counts);
   void reportDelayCounts();
   void reportCheckCounts();
   void reportArcs();
@@ -303,49 +326,108 @@ ReportAnnotated::init()
   }
 }
 
+ReportAnnotated::AnnotationCounts::AnnotationCounts(const Network *network) :
+  unannotated_pins_(network),
+  annotated_pins_(network)
+{
+  for (int i = 0; i < count_index_max; i++) {
+    edge_count_[i] = 0;
+    edge_annotated_count_[i] = 0;
+    edge_constant_count_[i] = 0;
+    edge_constant_annotated_count_[i] = 0;
+  }
+}
+
+// Vertices are counted in parallel chunks with counts per thread
+// that are summed after the chunks are done.
 void
 ReportAnnotated::findCounts()
 {
+  VertexSeq vertices;
+  vertices.reserve(graph_->vertexCount());
   VertexIterator vertex_iter(graph_);
-  while (vertex_iter.hasNext()) {
-    Vertex *from_vertex = vertex_iter.next();
-    Pin *from_pin = from_vertex->pin();
-    LogicValue from_logic_value;
-    bool from_logic_value_exists;
-    sdc_->logicValue(from_pin, from_logic_value,
-		     from_logic_value_exists);
-    VertexOutEdgeIterator edge_iter(from_vertex, graph_);
-    while (edge_iter.hasNext()) {
-      Edge *edge = edge_iter.next();
-      const TimingRole *role = edge->role();
-      Vertex *to_vertex = edge->to(graph_);
-      Pin *to_pin = to_vertex->pin();
-      int index = roleIndex(role, from_pin, to_pin);
-      LogicValue to_logic_value;
-      bool to_logic_value_exists;
-      sdc_->logicValue(to_pin, to_logic_value,
-		       to_logic_value_exists);
-
-      edge_count_[index]++;
-
-      if (from_logic_value_exists || to_logic_value_exists)
-	edge_constant_count_[index]++;
-      if (report_role_[index]) {
-	if (graph_->delayAnnotated(edge)) {
-	  edge_annotated_count_[index]++;
-	  if (from_logic_value_exists || to_logic_value_exists)
-	    edge_constant_annotated_count_[index]++;
-	  if (list_annotated_)
-	    annotated_pins_.insert(from_pin);
-	}
-	else {
-	  if (list_unannotated_)
-	    unannotated_pins_.insert(from_pin);
-	}
+  while (vertex_iter.hasNext())
+    vertices.push_back(vertex_iter.next());
+
+  size_t count = vertices.size();
+  if (dispatch_queue_ == nullptr
+      || thread_count_ <= 1
+      || count < annotation_chunk_size * 2) {
+    AnnotationCounts counts(network_);
+    for (Vertex *vertex : vertices)
+      findCounts(vertex, counts);
+    mergeCounts(counts);
+  }
+  else {
+    std::vector<AnnotationCounts> thread_counts(thread_count_,
+                                                AnnotationCounts(network_));
+    for (size_t from = 0; from < count; from += annotation_chunk_size) {
+      size_t to = std::min(from + annotation_chunk_size, count);
+      dispatch_queue_->dispatch([=, &vertices, &thread_counts] (int thread) {
+        for (size_t i = from; i < to; i++)
+          findCounts(vertices[i], thread_counts[thread]);
+      });
+    }
+    dispatch_queue_->finishTasks();
+    for (const AnnotationCounts &counts : thread_counts)
+      mergeCounts(counts);
+  }
+}
+
+void
+ReportAnnotated::findCounts(Vertex *from_vertex,
+                            AnnotationCounts &counts)
+{
+  Pin *from_pin = from_vertex->pin();
+  LogicValue from_logic_value;
+  bool from_logic_value_exists;
+  sdc_->logicValue(from_pin, from_logic_value,
+                   from_logic_value_exists);
+  VertexOutEdgeIterator edge_iter(from_vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *edge = edge_iter.next();
+    const TimingRole *role = edge->role();
+    Vertex *to_vertex = edge->to(graph_);
+    Pin *to_pin = to_vertex->pin();
+    int index = roleIndex(role, from_pin, to_pin);
+    LogicValue to_logic_value;
+    bool to_logic_value_exists;
+    sdc_->logicValue(to_pin, to_logic_value,
+                     to_logic_value_exists);
+
+    counts.edge_count_[index]++;
+    if (from_logic_value_exists || to_logic_value_exists)
+      counts.edge_constant_count_[index]++;
+    if (report_role_[index]) {
+      if (graph_->delayAnnotated(edge)) {
+        counts.edge_annotated_count_[index]++;
+        if (from_logic_value_exists || to_logic_value_exists)
+          counts.edge_constant_annotated_count_[index]++;
+        if (list_annotated_)
+          counts.annotated_pins_.insert(from_pin);
+      }
+      else {
+        if (list_unannotated_)
+          counts.unannotated_pins_.insert(from_pin);
       }
     }
-    findPeriodCount(from_pin);
   }
+  findPeriodCount(from_pin, counts);
+}
+
+void
+ReportAnnotated::mergeCounts(const AnnotationCounts &counts)
+{
+  for (int i = 0; i < count_index_max; i++) {
+    edge_count_[i] += counts.edge_count_[i];
+    edge_annotated_count_[i] += counts.edge_annotated_count_[i];
+    edge_constant_count_[i] += counts.edge_constant_count_[i];
+    edge_constant_annotated_count_[i] += counts.edge_constant_annotated_count_[i];
+  }
+  for (const Pin *pin : counts.unannotated_pins_)
+    unannotated_pins_.insert(pin);
+  for (const Pin *pin : counts.annotated_pins_)
+    annotated_pins_.insert(pin);
 }
 
 int
@@ -375,7 +457,8 @@ ReportAnnotated::roleIndex(const TimingRole *role,
 // Width and period checks are not edges in the graph so
 // they require special handling.
 void
-ReportAnnotated::findPeriodCount(Pin *pin)
+ReportAnnotated::findPeriodCount(Pin *pin,
+                                 AnnotationCounts &counts)
 {
   LibertyPort *port = network_->libertyPort(pin);
   if (port) {
@@ -386,16 +469,16 @@ ReportAnnotated::findPeriodCount(Pin *pin)
     if (report_role_[period_index]) {
       port->minPeriod(value, exists);
       if (exists) {
-	edge_count_[period_index]++;
+	counts.edge_count_[period_index]++;
 	graph_->periodCheckAnnotation(pin, ap_index, value, annotated);
 	if (annotated) {
-	  edge_annotated_count_[period_index]++;
+	  counts.edge_annotated_count_[period_index]++;
 	  if (list_annotated_)
-	    annotated_pins_.insert(pin);
+	    counts.annotated_pins_.insert(pin);
 	}
 	else {
 	  if (list_unannotated_)
-	    unannotated_pins_.insert(pin);
+	    counts.unannotated_pins_.insert(pin);
 	}
       }
     }
@@ -50,16 +50,27 @@ read_sdf_file(const char *filename,
               Corner *corner,
               bool unescaped_dividers,
               bool incremental_only,
-              MinMaxAllNull *cond_use)
+              MinMaxAllNull *cond_use,
+              bool incremental)
 {
   cmdLinkedNetwork();
   Sta *sta = Sta::sta();
   sta->ensureGraph();
   if (stringEq(path, ""))
     path = NULL;
-  bool success = readSdf(filename, path, corner, unescaped_dividers, incremental_only,
-                         cond_use, sta);
-  sta->search()->arrivalsInvalid();
+  bool success;
+  if (incremental) {
+    // Only invalidate the timing of the edges in the (ECO) file.
+    EdgeSet annotated_edges;
+    success = readSdf(filename, path, corner, unescaped_dividers,
+                      incremental_only, cond_use, sta, &annotated_edges);
+    sta->delaysAnnotated(annotated_edges);
+  }
+  else {
+    success = readSdf(filename, path, corner, unescaped_dividers,
+                      incremental_only, cond_use, sta);
+    sta->search()->arrivalsInvalid();
+  }
   return success;
 }
 
@@ -19,12 +19,12 @@ namespace eval sta {
 define_cmd_args "read_sdf" \
   {[-path path] [-corner corner]\
      [-cond_use min|max|min_max]\
-     [-unescaped_dividers] filename}
+     [-unescaped_dividers] [-incremental] filename}
 
 proc_redirect read_sdf {
   parse_key_args "read_sdf" args \
     keys {-path -corner -cond_use -analysis_type} \
-    flags {-unescaped_dividers -incremental_only}
+    flags {-unescaped_dividers -incremental_only -incremental}
 
   check_argc_eq1 "read_sdf" $args
   set filename [file nativename [lindex $args 0]]
@@ -49,8 +49,9 @@ proc_redirect read_sdf {
 
   set unescaped_dividers [info exists flags(-unescaped_dividers)]
   set incremental_only [info exists flags(-incremental_only)]
+  set incremental [info exists flags(-incremental)]
   read_sdf_file $filename $path $corner $unescaped_dividers \
-    $incremental_only $cond_use
+    $incremental_only $cond_use $incremental
 }
 
 ################################################################
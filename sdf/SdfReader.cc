@@ -78,7 +78,8 @@ readSdf(const char *filename,
         bool unescaped_dividers,
         bool incremental_only,
         MinMaxAll *cond_use,
-        StaState *sta)
+        StaState *sta,
+        EdgeSet *annotated_edges)
 {
   int arc_min_index = corner->findDcalcAnalysisPt(MinMax::min())->index();
   int arc_max_index = corner->findDcalcAnalysisPt(MinMax::max())->index();
@@ -86,7 +87,7 @@ readSdf(const char *filename,
 		   arc_min_index, arc_max_index, 
 		   sta->sdc()->analysisType(),
                    unescaped_dividers, incremental_only,
-		   cond_use, sta);
+		   cond_use, annotated_edges, sta);
   sdf_reader = &reader;
   bool success = reader.read();
   sdf_reader = nullptr;
@@ -101,6 +102,7 @@ SdfReader::SdfReader(const char *filename,
 		     bool unescaped_dividers,
 		     bool is_incremental_only,
                      MinMaxAll *cond_use,
+                     EdgeSet *annotated_edges,
 		     StaState *sta) :
   StaState(sta),
   filename_(filename),
@@ -113,6 +115,7 @@ SdfReader::SdfReader(const char *filename,
   unescaped_dividers_(unescaped_dividers),
   is_incremental_only_(is_incremental_only),
   cond_use_(cond_use),
+  annotated_edges_(annotated_edges),
   line_(1),
   divider_('/'),
   escape_('\\'),
@@ -135,13 +138,14 @@ SdfReader::~SdfReader()
 bool
 SdfReader::read()
 {
-  // Use zlib to uncompress gzip'd files automagically.
-  stream_ = gzopen(filename_, "rb");
   //::SdfParse_debug = 1;
-  if (stream_) {
+  if (stream_.open(filename_)) {
+    // Annotated delays can differ between analysis points that
+    // share delays.
+    graph_->unshareDelays();
     // yyparse returns 0 on success.
     bool success = (::SdfParse_parse() == 0);
-    gzclose(stream_);
+    stream_.close();
     return success;
   }
   else
@@ -730,6 +734,8 @@ SdfReader::setEdgeArcDelays(Edge *edge,
       graph_->setArcDelay(edge, arc, arc_delay_index, delay);
       graph_->setArcDelayAnnotated(edge, arc, arc_delay_index, true);
       edge->setDelayAnnotationIsIncremental(is_incremental_only_);
+      if (annotated_edges_)
+        annotated_edges_->insert(edge);
     }
   }
 }
@@ -782,6 +788,8 @@ SdfReader::setEdgeArcDelaysCondUse(Edge *edge,
     graph_->setArcDelay(edge, arc, arc_delay_index, delay);
     graph_->setArcDelayAnnotated(edge, arc, arc_delay_index, true);
     edge->setDelayAnnotationIsIncremental(is_incremental_only_);
+    if (annotated_edges_)
+      annotated_edges_->insert(edge);
   }
 }
 
@@ -981,11 +989,7 @@ SdfReader::getChars(char *buf,
 		    size_t &result,
 		    size_t max_size)
 {
-  char *status = gzgets(stream_, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = strlen(buf);
+  stream_.getChars(buf, result, max_size);
 }
 
 void
@@ -993,11 +997,7 @@ SdfReader::getChars(char *buf,
 		    int &result,
 		    size_t max_size)
 {
-  char *status = gzgets(stream_, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = strlen(buf);
+  stream_.getChars(buf, result, max_size);
 }
 
 void
@@ -1029,14 +1029,22 @@ SdfReader::sdfError(int id,
 Pin *
 SdfReader::findPin(const char *name)
 {
-  if (path_) {
-    string path_name;
+  string path_name = name;
+  if (path_)
     stringPrint(path_name, "%s%c%s", path_, divider_, name);
-    Pin *pin = network_->findPin(path_name.c_str());
-    return pin;
+  char *inst_path, *port_name;
+  network_->pathNameLast(path_name.c_str(), inst_path, port_name);
+  Pin *pin = nullptr;
+  if (inst_path) {
+    Instance *inst = findInstancePath(inst_path);
+    if (inst)
+      pin = network_->findPin(inst, port_name);
+    stringDelete(inst_path);
+    stringDelete(port_name);
   }
-  else
-    return network_->findPin(name);
+  if (pin == nullptr)
+    pin = network_->findPin(path_name.c_str());
+  return pin;
 }
 
 Instance *
@@ -1045,12 +1053,38 @@ SdfReader::findInstance(const char *name)
   string inst_name = name;
   if (path_)
     stringPrint(inst_name, "%s%c%s", path_, divider_, name);
-  Instance *inst = network_->findInstance(inst_name.c_str());
+  Instance *inst = findInstancePath(inst_name);
   if (inst == nullptr)
     sdfWarn(195, "instance %s not found.", inst_name.c_str());
   return inst;
 }
 
+// Find the parent instance through the cache and the leaf under it.
+// Fall back to the network search from the top for paths the parent
+// and child names do not resolve.
+Instance *
+SdfReader::findInstancePath(const string &path_name)
+{
+  auto itr = instance_cache_.find(path_name);
+  if (itr != instance_cache_.end())
+    return itr->second;
+  Instance *inst = nullptr;
+  char *parent_path, *child_name;
+  network_->pathNameLast(path_name.c_str(), parent_path, child_name);
+  if (parent_path) {
+    Instance *parent = findInstancePath(parent_path);
+    if (parent)
+      inst = network_->findChild(parent, child_name);
+    stringDelete(parent_path);
+    stringDelete(child_name);
+  }
+  if (inst == nullptr)
+    inst = network_->findInstance(path_name.c_str());
+  if (inst)
+    instance_cache_[path_name] = inst;
+  return inst;
+}
+
 ////////////////////////////////////////////////////////////////
 
 SdfPortSpec::SdfPortSpec(Transition *tr,
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "SdcClass.hh"
+#include "GraphClass.hh"
 
 namespace sta {
 
@@ -36,6 +37,9 @@ class StaState;
 //
 // If incremental_only is true non-incremental annoatations are ignored.
 //
+// If annotated_edges is not null the edges with annotated delays are
+// added to it so the caller can invalidate only their timing.
+//
 // path is a hierararchial path prefix for instances and pins in the
 // sdf file.  Pass 0 (nullptr) to specify no path.
 //
@@ -55,6 +59,7 @@ readSdf(const char *filename,
         bool unescaped_dividers,
         bool incremental_only,
         MinMaxAll *cond_use,
-        StaState *sta);
+        StaState *sta,
+        EdgeSet *annotated_edges = nullptr);
 
 } // namespace
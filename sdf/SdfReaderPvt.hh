@@ -16,7 +16,10 @@
 
 #pragma once
 
-#include "Zlib.hh"
+#include <string>
+#include <unordered_map>
+
+#include "InputFile.hh"
 #include "Vector.hh"
 #include "TimingRole.hh"
 #include "Transition.hh"
@@ -42,6 +45,7 @@ class SdfTriple;
 class SdfPortSpec;
 
 typedef Vector<SdfTriple*> SdfTripleSeq;
+typedef std::unordered_map<std::string, Instance*> SdfInstanceCache;
 
 class SdfReader : public StaState
 {
@@ -54,6 +58,7 @@ public:
 	    bool unescaped_dividers,
 	    bool is_incremental_only,
             MinMaxAll *cond_use,
+            EdgeSet *annotated_edges,
 	    StaState *sta);
   ~SdfReader();
   bool read();
@@ -192,6 +197,7 @@ private:
   void deletePortSpec(SdfPortSpec *edge);
   Pin *findPin(const char *name);
   Instance *findInstance(const char *name);
+  Instance *findInstancePath(const std::string &path_name);
   void setEdgeDelays(Edge *edge,
 		     SdfTripleSeq *triples,
 		     const char *sdf_cmd);
@@ -212,12 +218,18 @@ private:
   bool unescaped_dividers_;
   bool is_incremental_only_;
   MinMaxAll *cond_use_;
+  // Edges with annotated delays (may be null).
+  EdgeSet *annotated_edges_;
 
   int line_;
-  gzFile stream_;
+  InputFile stream_;
   char divider_;
   char escape_;
   Instance *instance_;
+  // Instances found by path name. SDF files name the cells of each
+  // hierarchical instance together, so parents are found once rather
+  // than walking the hierarchy from the top for every INSTANCE.
+  SdfInstanceCache instance_cache_;
   const char *cell_name_;
   bool in_timing_check_;
   bool in_incremental_;
@@ -16,8 +16,11 @@
 
 #include "sdf/SdfWriter.hh"
 
+#include <algorithm>
 #include <cstdio>
+#include <cstdarg>
 #include <ctime>
+#include <functional>
 
 #include "Zlib.hh"
 #include "StaConfig.hh"  // STA_VERSION
@@ -36,6 +39,8 @@
 #include "StaState.hh"
 #include "Corner.hh"
 #include "PathAnalysisPt.hh"
+#include "DispatchQueue.hh"
+#include "BufferedWriter.hh"
 
 namespace sta {
 
@@ -43,6 +48,8 @@ class SdfWriter : public StaState
 {
 public:
   SdfWriter(StaState *sta);
+  // Copy the settings of writer for formatting on another thread.
+  SdfWriter(const SdfWriter *writer);
   ~SdfWriter();
   void write(const char *filename,
 	     Corner *corner,
@@ -63,6 +70,17 @@ protected:
   void writeInterconnectFromPin(Pin *drvr_pin);
 
   void writeInstances();
+  void writeInstance(const Instance *inst);
+  void writeInstancesParallel(std::function<void (SdfWriter *writer,
+                                                  const Instance *inst)> write_inst,
+                              bool include_top);
+  void print(const char *fmt,
+             ...);
+  void flushBuffer();
+  void writeText(const string &text);
+  void writeBlock(const string &block);
+  void compressBlock(const string &block,
+                     string &compressed);
   void writeInstHeader(const Instance *inst);
   void writeInstTrailer();
   void writeIopaths(const Instance *inst,
@@ -115,6 +133,12 @@ private:
   char *delay_format_;
 
   gzFile stream_;
+  // Formatted text waiting to be written to stream_.
+  // Writers on other threads only buffer.
+  BufferedWriter buffer_;
+  // Compress blocks to gzip members instead of writing them to a
+  // compressing stream_.
+  bool compress_blocks_;
   const Corner *corner_;
   int arc_delay_min_index_;
   int arc_delay_max_index_;
@@ -140,7 +164,26 @@ SdfWriter::SdfWriter(StaState *sta) :
   StaState(sta),
   sdf_escape_('\\'),
   network_escape_(network_->pathEscape()),
-  delay_format_(nullptr)
+  delay_format_(nullptr),
+  stream_(nullptr),
+  buffer_([this] (const string &text) { writeText(text); }),
+  compress_blocks_(false)
+{
+}
+
+SdfWriter::SdfWriter(const SdfWriter *writer) :
+  StaState(writer),
+  sdf_divider_(writer->sdf_divider_),
+  include_typ_(writer->include_typ_),
+  timescale_(writer->timescale_),
+  sdf_escape_(writer->sdf_escape_),
+  network_escape_(writer->network_escape_),
+  delay_format_(stringCopy(writer->delay_format_)),
+  stream_(nullptr),
+  compress_blocks_(writer->compress_blocks_),
+  corner_(writer->corner_),
+  arc_delay_min_index_(writer->arc_delay_min_index_),
+  arc_delay_max_index_(writer->arc_delay_max_index_)
 {
 }
 
@@ -177,7 +220,12 @@ SdfWriter::write(const char *filename,
   dcalc_ap = corner_->findDcalcAnalysisPt(min_max);
   arc_delay_max_index_ = dcalc_ap->index();
 
-  stream_ = gzopen(filename, gzip ? "wb" : "wT");
+#ifdef ZLIB_FOUND
+  // Threads compress their blocks to gzip members that are written
+  // uncompressed. Concatenated members are a valid gzip file.
+  compress_blocks_ = gzip && thread_count_ > 1;
+#endif
+  stream_ = gzopen(filename, (gzip && !compress_blocks_) ? "wb" : "wT");
   if (stream_ == nullptr)
     throw FileNotWritable(filename);
 
@@ -185,20 +233,135 @@ SdfWriter::write(const char *filename,
   writeInterconnects();
   writeInstances();
   writeTrailer();
+  flushBuffer();
 
   gzclose(stream_);
   stream_ = nullptr;
 }
 
+void
+SdfWriter::print(const char *fmt,
+                 ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  buffer_.vprint(fmt, args);
+  va_end(args);
+}
+
+void
+SdfWriter::flushBuffer()
+{
+  buffer_.flush();
+}
+
+// Write function of buffer_.
+void
+SdfWriter::writeText(const string &text)
+{
+  if (compress_blocks_) {
+    string compressed;
+    compressBlock(text, compressed);
+    writeBlock(compressed);
+  }
+  else
+    writeBlock(text);
+}
+
+void
+SdfWriter::writeBlock(const string &block)
+{
+  if (!block.empty())
+    gzwrite(stream_, block.data(), static_cast<unsigned>(block.size()));
+}
+
+void
+SdfWriter::compressBlock(const string &block,
+                         string &compressed)
+{
+#ifdef ZLIB_FOUND
+  z_stream zstream;
+  zstream.zalloc = Z_NULL;
+  zstream.zfree = Z_NULL;
+  zstream.opaque = Z_NULL;
+  // 16 + max window bits for a gzip header and trailer.
+  deflateInit2(&zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS,
+               8, Z_DEFAULT_STRATEGY);
+  compressed.resize(deflateBound(&zstream, block.size()));
+  zstream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(block.data()));
+  zstream.avail_in = static_cast<uInt>(block.size());
+  zstream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+  zstream.avail_out = static_cast<uInt>(compressed.size());
+  deflate(&zstream, Z_FINISH);
+  compressed.resize(zstream.total_out);
+  deflateEnd(&zstream);
+#else
+  compressed = block;
+#endif
+}
+
+// Format the instances in blocks on the dispatch queue threads and
+// write the blocks in leaf instance order.
+void
+SdfWriter::writeInstancesParallel(std::function<void (SdfWriter *writer,
+                                                      const Instance *inst)> write_inst,
+                                  bool include_top)
+{
+  InstanceSeq insts;
+  if (include_top)
+    insts.push_back(network_->topInstance());
+  LeafInstanceIterator *leaf_iter = network_->leafInstanceIterator();
+  while (leaf_iter->hasNext())
+    insts.push_back(leaf_iter->next());
+  delete leaf_iter;
+
+  flushBuffer();
+  Vector<SdfWriter*> writers;
+  for (int i = 0; i < thread_count_; i++)
+    writers.push_back(new SdfWriter(this));
+  constexpr size_t block_inst_count = 1024;
+  size_t block_count = (insts.size() + block_inst_count - 1) / block_inst_count;
+  // Blocks formatted before writing them out.
+  size_t wave_block_count = thread_count_ * 4;
+  std::vector<string> blocks(wave_block_count);
+  for (size_t wave_start = 0;
+       wave_start < block_count;
+       wave_start += wave_block_count) {
+    size_t wave_end = std::min(wave_start + wave_block_count, block_count);
+    for (size_t b = wave_start; b < wave_end; b++) {
+      dispatch_queue_->dispatch([=, &insts, &writers, &blocks] (int i) {
+        SdfWriter *writer = writers[i];
+        size_t inst_start = b * block_inst_count;
+        size_t inst_end = std::min(inst_start + block_inst_count, insts.size());
+        for (size_t k = inst_start; k < inst_end; k++)
+          write_inst(writer, insts[k]);
+        string &block = blocks[b - wave_start];
+        if (compress_blocks_)
+          compressBlock(writer->buffer_.text(), block);
+        else
+          block.swap(writer->buffer_.text());
+        writer->buffer_.clear();
+      });
+    }
+    dispatch_queue_->finishTasks();
+    for (size_t b = wave_start; b < wave_end; b++) {
+      string &block = blocks[b - wave_start];
+      writeBlock(block);
+      block.clear();
+    }
+  }
+  writers.deleteContentsClear();
+}
+
 void
 SdfWriter::writeHeader(LibertyLibrary *default_lib,
 		       bool no_timestamp,
 		       bool no_version)
 {
-  gzprintf(stream_, "(DELAYFILE\n");
-  gzprintf(stream_, " (SDFVERSION \"3.0\")\n");
-  gzprintf(stream_, " (DESIGN \"%s\")\n", 
-	   network_->cellName(network_->topInstance()));
+  print("(DELAYFILE\n");
+  print(" (SDFVERSION \"3.0\")\n");
+  print(" (DESIGN \"%s\")\n",
+        network_->cellName(network_->topInstance()));
   
   if (!no_timestamp) {
     time_t now;
@@ -206,14 +369,14 @@ SdfWriter::writeHeader(LibertyLibrary *default_lib,
     char *time_str = ctime(&now);
     // Remove trailing \n.
     time_str[strlen(time_str) - 1] = '\0';
-    gzprintf(stream_, " (DATE \"%s\")\n", time_str);
+    print(" (DATE \"%s\")\n", time_str);
   }
 
-  gzprintf(stream_, " (VENDOR \"Parallax\")\n");
-  gzprintf(stream_, " (PROGRAM \"STA\")\n");
+  print(" (VENDOR \"Parallax\")\n");
+  print(" (PROGRAM \"STA\")\n");
   if (!no_version)
-    gzprintf(stream_, " (VERSION \"%s\")\n", STA_VERSION);
-  gzprintf(stream_, " (DIVIDER %c)\n", sdf_divider_);
+    print(" (VERSION \"%s\")\n", STA_VERSION);
+  print(" (DIVIDER %c)\n", sdf_divider_);
 
   LibertyLibrary *lib_min = default_lib;
   const LibertySeq &libs_min = corner_->libertyLibraries(MinMax::min());
@@ -227,15 +390,15 @@ SdfWriter::writeHeader(LibertyLibrary *default_lib,
   OperatingConditions *cond_min = lib_min->defaultOperatingConditions();
   OperatingConditions *cond_max = lib_max->defaultOperatingConditions();
   if (cond_min && cond_max) {
-    gzprintf(stream_, " (VOLTAGE %.3f::%.3f)\n",
-             cond_min->voltage(),
-             cond_max->voltage());
-    gzprintf(stream_, " (PROCESS \"%.3f::%.3f\")\n",
-             cond_min->process(),
-             cond_max->process());
-    gzprintf(stream_, " (TEMPERATURE %.3f::%.3f)\n",
-             cond_min->temperature(),
-             cond_max->temperature());
+    print(" (VOLTAGE %.3f::%.3f)\n",
+          cond_min->voltage(),
+          cond_max->voltage());
+    print(" (PROCESS \"%.3f::%.3f\")\n",
+          cond_min->process(),
+          cond_max->process());
+    print(" (TEMPERATURE %.3f::%.3f)\n",
+          cond_min->temperature(),
+          cond_max->temperature());
   }
 
   const char *sdf_timescale = nullptr;
@@ -258,37 +421,44 @@ SdfWriter::writeHeader(LibertyLibrary *default_lib,
   else if (fuzzyEqual(timescale_, 100e-12))
     sdf_timescale = "100ps";
   if (sdf_timescale)
-    gzprintf(stream_, " (TIMESCALE %s)\n", sdf_timescale);
+    print(" (TIMESCALE %s)\n", sdf_timescale);
 }
 
 void
 SdfWriter::writeTrailer()
 {
-  gzprintf(stream_, ")\n");
+  print(")\n");
 }
 
 void
 SdfWriter::writeInterconnects()
 {
-  gzprintf(stream_, " (CELL\n");
-  gzprintf(stream_, "  (CELLTYPE \"%s\")\n",
-	   network_->cellName(network_->topInstance()));
-  gzprintf(stream_, "  (INSTANCE)\n");
-  gzprintf(stream_, "  (DELAY\n");
-  gzprintf(stream_, "   (ABSOLUTE\n");
-
-  writeInstInterconnects(network_->topInstance());
+  print(" (CELL\n");
+  print("  (CELLTYPE \"%s\")\n",
+        network_->cellName(network_->topInstance()));
+  print("  (INSTANCE)\n");
+  print("  (DELAY\n");
+  print("   (ABSOLUTE\n");
+
+  if (thread_count_ > 1)
+    writeInstancesParallel([] (SdfWriter *writer,
+                               const Instance *inst) {
+      writer->writeInstInterconnects(const_cast<Instance*>(inst));
+    }, true);
+  else {
+    writeInstInterconnects(network_->topInstance());
 
-  LeafInstanceIterator *inst_iter = network_->leafInstanceIterator();
-  while (inst_iter->hasNext()) {
-    Instance *inst = inst_iter->next();
-    writeInstInterconnects(inst);
+    LeafInstanceIterator *inst_iter = network_->leafInstanceIterator();
+    while (inst_iter->hasNext()) {
+      Instance *inst = inst_iter->next();
+      writeInstInterconnects(inst);
+    }
+    delete inst_iter;
   }
-  delete inst_iter;
 
-  gzprintf(stream_, "   )\n");
-  gzprintf(stream_, "  )\n");
-  gzprintf(stream_, " )\n");
+  print("   )\n");
+  print("  )\n");
+  print(" )\n");
 }
 
 void
@@ -315,11 +485,11 @@ SdfWriter::writeInterconnectFromPin(Pin *drvr_pin)
         Pin *load_pin = edge->to(graph_)->pin();
         string drvr_pin_name = sdfPathName(drvr_pin);
         string load_pin_name = sdfPathName(load_pin);
-        gzprintf(stream_, "    (INTERCONNECT %s %s ",
-                 drvr_pin_name.c_str(),
-                 load_pin_name.c_str());
+        print("    (INTERCONNECT %s %s ",
+              drvr_pin_name.c_str(),
+              load_pin_name.c_str());
         writeArcDelays(edge);
-        gzprintf(stream_, ")\n");
+        print(")\n");
       }
     }
   }
@@ -328,31 +498,44 @@ SdfWriter::writeInterconnectFromPin(Pin *drvr_pin)
 void
 SdfWriter::writeInstances()
 {
-  LeafInstanceIterator *leaf_iter = network_->leafInstanceIterator();
-  while (leaf_iter->hasNext()) {
-    const Instance *inst = leaf_iter->next();
-    bool inst_header = false;
-    writeIopaths(inst, inst_header);
-    writeTimingChecks(inst, inst_header);
-    if (inst_header)
-      writeInstTrailer();
+  if (thread_count_ > 1)
+    writeInstancesParallel([] (SdfWriter *writer,
+                               const Instance *inst) {
+      writer->writeInstance(inst);
+    }, false);
+  else {
+    LeafInstanceIterator *leaf_iter = network_->leafInstanceIterator();
+    while (leaf_iter->hasNext()) {
+      const Instance *inst = leaf_iter->next();
+      writeInstance(inst);
+    }
+    delete leaf_iter;
   }
-  delete leaf_iter;
+}
+
+void
+SdfWriter::writeInstance(const Instance *inst)
+{
+  bool inst_header = false;
+  writeIopaths(inst, inst_header);
+  writeTimingChecks(inst, inst_header);
+  if (inst_header)
+    writeInstTrailer();
 }
 
 void
 SdfWriter::writeInstHeader(const Instance *inst)
 {
-  gzprintf(stream_, " (CELL\n");
-  gzprintf(stream_, "  (CELLTYPE \"%s\")\n", network_->cellName(inst));
+  print(" (CELL\n");
+  print("  (CELLTYPE \"%s\")\n", network_->cellName(inst));
   string inst_name = sdfPathName(inst);
-  gzprintf(stream_, "  (INSTANCE %s)\n", inst_name.c_str());
+  print("  (INSTANCE %s)\n", inst_name.c_str());
 }
 
 void
 SdfWriter::writeInstTrailer()
 {
-  gzprintf(stream_, " )\n");
+  print(" )\n");
 }
 
 void
@@ -387,18 +570,18 @@ SdfWriter::writeIopaths(const Instance *inst,
 	  }
 	  const char *sdf_cond = edge->timingArcSet()->sdfCond();
 	  if (sdf_cond) {
-	    gzprintf(stream_, "    (COND %s\n", sdf_cond);
-	    gzprintf(stream_, " ");
+	    print("    (COND %s\n", sdf_cond);
+	    print(" ");
 	  }
 	  string from_pin_name = sdfPortName(from_pin);
 	  string to_pin_name = sdfPortName(to_pin);
-          gzprintf(stream_, "    (IOPATH %s %s ",
-		   from_pin_name.c_str(),
-		   to_pin_name.c_str());
+          print("    (IOPATH %s %s ",
+                from_pin_name.c_str(),
+                to_pin_name.c_str());
 	  writeArcDelays(edge);
 	  if (sdf_cond)
-	    gzprintf(stream_, ")");
-	  gzprintf(stream_, ")\n");
+	    print(")");
+	  print(")\n");
 	}
       }
     }
@@ -412,15 +595,15 @@ SdfWriter::writeIopaths(const Instance *inst,
 void
 SdfWriter::writeIopathHeader()
 {
-  gzprintf(stream_, "  (DELAY\n");
-  gzprintf(stream_, "   (ABSOLUTE\n");
+  print("  (DELAY\n");
+  print("   (ABSOLUTE\n");
 }
 
 void
 SdfWriter::writeIopathTrailer()
 {
-  gzprintf(stream_, "   )\n");
-  gzprintf(stream_, "  )\n");
+  print("   )\n");
+  print("  )\n");
 }
 
 void
@@ -446,7 +629,7 @@ SdfWriter::writeArcDelays(Edge *edge)
 		     delays.value(RiseFall::fall(), MinMax::min()))
 	  && fuzzyEqual(delays.value(RiseFall::rise(), MinMax::max()),
 			delays.value(RiseFall::fall(),MinMax::max())))) {
-      gzprintf(stream_, " ");
+      print(" ");
       writeSdfTriple(delays, RiseFall::fall());
     }
   }
@@ -455,7 +638,7 @@ SdfWriter::writeArcDelays(Edge *edge)
     writeSdfTriple(delays, RiseFall::rise());
   else if (delays.hasValue(RiseFall::fall(), MinMax::min())) {
     // Fall only.
-    gzprintf(stream_, "() ");
+    print("() ");
     writeSdfTriple(delays, RiseFall::fall());
   }
 }
@@ -473,23 +656,23 @@ void
 SdfWriter::writeSdfTriple(float min,
                           float max)
 {
-  gzprintf(stream_, "(");
+  print("(");
   writeSdfDelay(min);
   if (include_typ_) {
-    gzprintf(stream_, ":");
+    print(":");
     writeSdfDelay((min + max) / 2.0);
-    gzprintf(stream_, ":");
+    print(":");
   }
   else
-    gzprintf(stream_, "::");
+    print("::");
   writeSdfDelay(max);
-  gzprintf(stream_, ")");
+  print(")");
 }
 
 void
 SdfWriter::writeSdfDelay(double delay)
 {
-  gzprintf(stream_, delay_format_, delay / timescale_);
+  print(delay_format_, delay / timescale_);
 }
 
 void
@@ -564,13 +747,13 @@ SdfWriter::ensureTimingCheckheaders(bool &check_header,
 void
 SdfWriter::writeTimingCheckHeader()
 {
-  gzprintf(stream_, "  (TIMINGCHECK\n");
+  print("  (TIMINGCHECK\n");
 }
 
 void
 SdfWriter::writeTimingCheckTrailer()
 {
-  gzprintf(stream_, "  )\n");
+  print("  )\n");
 }
 
 void
@@ -652,46 +835,46 @@ SdfWriter::writeCheck(Edge *edge,
   const char *sdf_cond_start = arc_set->sdfCondStart();
   const char *sdf_cond_end = arc_set->sdfCondEnd();
 
-  gzprintf(stream_, "    (%s ", sdf_check);
+  print("    (%s ", sdf_check);
 
   if (sdf_cond_start)
-    gzprintf(stream_, "(COND %s ", sdf_cond_start);
+    print("(COND %s ", sdf_cond_start);
 
   string to_pin_name = sdfPortName(to_pin);
   if (use_data_edge) {
-    gzprintf(stream_, "(%s %s)",
-	     sdfEdge(arc->toEdge()),
-	     to_pin_name.c_str());
+    print("(%s %s)",
+          sdfEdge(arc->toEdge()),
+          to_pin_name.c_str());
   }
   else
-    gzprintf(stream_, "%s", to_pin_name.c_str());
+    print("%s", to_pin_name.c_str());
 
   if (sdf_cond_start)
-    gzprintf(stream_, ")");
+    print(")");
 
-  gzprintf(stream_, " ");
+  print(" ");
 
   if (sdf_cond_end)
-    gzprintf(stream_, "(COND %s ", sdf_cond_end);
+    print("(COND %s ", sdf_cond_end);
 
   string from_pin_name = sdfPortName(from_pin);
   if (use_clk_edge)
-    gzprintf(stream_, "(%s %s)",
-	     sdfEdge(arc->fromEdge()),
-	     from_pin_name.c_str());
+    print("(%s %s)",
+          sdfEdge(arc->fromEdge()),
+          from_pin_name.c_str());
   else
-    gzprintf(stream_, "%s", from_pin_name.c_str());
+    print("%s", from_pin_name.c_str());
 
   if (sdf_cond_end)
-    gzprintf(stream_, ")");
+    print(")");
 
-  gzprintf(stream_, " ");
+  print(" ");
 
   ArcDelay min_delay = graph_->arcDelay(edge, arc, arc_delay_min_index_);
   ArcDelay max_delay = graph_->arcDelay(edge, arc, arc_delay_max_index_);
   writeSdfTriple(delayAsFloat(min_delay), delayAsFloat(max_delay));
 
-  gzprintf(stream_, ")\n");
+  print(")\n");
 }
 
 void
@@ -701,11 +884,11 @@ SdfWriter::writeWidthCheck(const Pin *pin,
 			   float max_width)
 {
   string pin_name = sdfPortName(pin);
-  gzprintf(stream_, "    (WIDTH (%s %s) ",
-	   sdfEdge(hi_low->asTransition()),
-	   pin_name.c_str());
+  print("    (WIDTH (%s %s) ",
+        sdfEdge(hi_low->asTransition()),
+        pin_name.c_str());
   writeSdfTriple(min_width, max_width);
-  gzprintf(stream_, ")\n");
+  print(")\n");
 }
 
 void
@@ -713,9 +896,9 @@ SdfWriter::writePeriodCheck(const Pin *pin,
 			    float min_period)
 {
   string pin_name = sdfPortName(pin);
-  gzprintf(stream_, "    (PERIOD %s ", pin_name.c_str());
+  print("    (PERIOD %s ", pin_name.c_str());
   writeSdfTriple(min_period, min_period);
-  gzprintf(stream_, ")\n");
+  print(")\n");
 }
 
 const char *
@@ -35,6 +35,7 @@ DdNode *Cudd_bddXor(void *, void *, void *) { return nullptr; }
 DdNode *Cudd_ReadOne(void *) { return nullptr; }
 DdNode *Cudd_ReadLogicZero(void *) { return nullptr; }
 DdNode *Cudd_bddNewVar(void *) { return nullptr; }
+long Cudd_ReadNodeCount(void *) { return 0; }
 int Cudd_NodeReadIndex(void *) { return 0;}
 void Cudd_Ref(void *) {}   
 void Cudd_RecursiveDeref(void *, void *) {}
@@ -50,11 +51,44 @@ Bdd::Bdd(const StaState *sta) :
 
 Bdd::~Bdd()
 {
+  clearVarMap();
   Cudd_Quit(cudd_mgr_);
 }
 
 DdNode *
 Bdd::funcBdd(const FuncExpr *expr)
+{
+  auto expr_bdd = func_bdd_map_.find(expr);
+  if (expr_bdd != func_bdd_map_.end()) {
+    DdNode *bdd = expr_bdd->second;
+    Cudd_Ref(bdd);
+    return bdd;
+  }
+  // Callers hold references to the BDDs they are using, so flushing
+  // only drops the cache references. Port variables are never freed
+  // by cudd so they stay in the var map.
+  if (func_bdd_map_.size() >= func_cache_max
+      || Cudd_ReadNodeCount(cudd_mgr_) >= func_cache_node_max)
+    clearFuncCache();
+  DdNode *bdd = makeFuncBdd(expr);
+  if (bdd) {
+    // Reference for the cache.
+    Cudd_Ref(bdd);
+    func_bdd_map_[expr] = bdd;
+  }
+  return bdd;
+}
+
+void
+Bdd::clearFuncCache()
+{
+  for (auto expr_bdd : func_bdd_map_)
+    Cudd_RecursiveDeref(cudd_mgr_, expr_bdd.second);
+  func_bdd_map_.clear();
+}
+
+DdNode *
+Bdd::makeFuncBdd(const FuncExpr *expr)
 {
   DdNode *left = nullptr;
   DdNode *right = nullptr;
@@ -66,13 +100,13 @@ Bdd::funcBdd(const FuncExpr *expr)
     break;
   }
   case FuncExpr::op_not:
-    left = funcBdd(expr->left());
+    left = makeFuncBdd(expr->left());
     if (left)
       result = Cudd_Not(left);
     break;
   case FuncExpr::op_or:
-    left = funcBdd(expr->left());
-    right = funcBdd(expr->right());
+    left = makeFuncBdd(expr->left());
+    right = makeFuncBdd(expr->right());
     if (left && right)
       result = Cudd_bddOr(cudd_mgr_, left, right);
     else if (left)
@@ -81,8 +115,8 @@ Bdd::funcBdd(const FuncExpr *expr)
       result = right;
     break;
   case FuncExpr::op_and:
-    left = funcBdd(expr->left());
-    right = funcBdd(expr->right());
+    left = makeFuncBdd(expr->left());
+    right = makeFuncBdd(expr->right());
     if (left && right)
       result = Cudd_bddAnd(cudd_mgr_, left, right);
     else if (left)
@@ -91,8 +125,8 @@ Bdd::funcBdd(const FuncExpr *expr)
       result = right;
     break;
   case FuncExpr::op_xor:
-    left = funcBdd(expr->left());
-    right = funcBdd(expr->right());
+    left = makeFuncBdd(expr->left());
+    right = makeFuncBdd(expr->right());
     if (left && right)
       result = Cudd_bddXor(cudd_mgr_, left, right);
     else if (left)
@@ -168,6 +202,7 @@ Bdd::varIndexPort(int var_index)
 void
 Bdd::clearVarMap()
 {
+  clearFuncCache();
   for (auto port_node : bdd_port_var_map_) {
     DdNode *var_node = port_node.second;
     Cudd_RecursiveDeref(cudd_mgr_, var_node);
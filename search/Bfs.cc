@@ -16,6 +16,12 @@
 
 #include "Bfs.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "Machine.hh"
 #include "Report.hh"
 #include "Debug.hh"
 #include "Mutex.hh"
@@ -25,6 +31,9 @@
 #include "Sdc.hh"
 #include "Levelize.hh"
 #include "SearchPred.hh"
+#include "SearchStats.hh"
+#include "Tracer.hh"
+#include "TimingProgress.hh"
 
 namespace sta {
 
@@ -37,7 +46,10 @@ BfsIterator::BfsIterator(BfsIndex bfs_index,
   bfs_index_(bfs_index),
   level_min_(level_min),
   level_max_(level_max),
-  search_pred_(search_pred)
+  search_pred_(search_pred),
+  dependent_counts_size_(0),
+  progress_(nullptr),
+  progress_cancelable_(false)
 {
   init();
 }
@@ -108,6 +120,22 @@ BfsIterator::deleteEntries(Level level)
   level_vertices.clear();
 }
 
+void
+BfsIterator::setProgress(TimingProgress *progress,
+                         bool cancelable)
+{
+  progress_ = progress;
+  progress_cancelable_ = cancelable;
+}
+
+bool
+BfsIterator::canceled() const
+{
+  return progress_
+    && progress_cancelable_
+    && progress_->cancelRequested();
+}
+
 bool
 BfsIterator::empty() const
 {
@@ -140,9 +168,11 @@ BfsIterator::visit(Level to_level,
 {
   int visit_count = 0;
   while (levelLessOrEqual(first_level_, last_level_)
-	 && levelLessOrEqual(first_level_, to_level)) {
+	 && levelLessOrEqual(first_level_, to_level)
+         && !canceled()) {
     VertexSeq &level_vertices = queue_[first_level_];
     incrLevel(first_level_);
+    int level_count = 0;
     // Note that ArrivalVisitor::enqueueRefPinInputDelays may enqueue
     // vertices at this level so range iteration fails if the vector grows.
     while (!level_vertices.empty()) {
@@ -151,12 +181,18 @@ BfsIterator::visit(Level to_level,
       if (vertex) {
         vertex->setBfsInQueue(bfs_index_, false);
         visitor->visit(vertex);
-        visit_count++;
+        level_count++;
       }
     }
     level_vertices.clear();
     visitor->levelFinished();
+    visit_count += level_count;
+    if (progress_)
+      progress_->addVisits(1, level_count);
   }
+  SearchStats *stats = debug_->searchStats();
+  stats->incr(SearchStats::bfs_passes);
+  stats->incr(SearchStats::bfs_vertices, visit_count);
   return visit_count;
 }
 
@@ -170,53 +206,373 @@ BfsIterator::visitParallel(Level to_level,
     if (thread_count == 1)
       visit_count = visit(to_level, visitor);
     else {
+      SearchStats *stats = debug_->searchStats();
+      Tracer *tracer = debug_->tracer();
+      TraceScope pass_trace(tracer, "bfs");
       std::vector<VertexVisitor*> visitors;
       for (int k = 0; k < thread_count_; k++)
 	visitors.push_back(visitor->copy());
+      if (bfs_dependency_driven_) {
+        // The cone is visited without stopping for cancels.
+        int dependent_count = visitDependent(to_level, visitors);
+        visit_count += dependent_count;
+        if (progress_)
+          progress_->addVisits(0, dependent_count);
+      }
+      // Vertices enqueued by a dependency driven visit after their
+      // position in the cone was passed are visited in level order.
       while (levelLessOrEqual(first_level_, last_level_)
-	     && levelLessOrEqual(first_level_, to_level)) {
+	     && levelLessOrEqual(first_level_, to_level)
+             && !canceled()) {
 	VertexSeq &level_vertices = queue_[first_level_];
+        Level level = first_level_;
 	incrLevel(first_level_);
 	if (!level_vertices.empty()) {
+          TraceScope level_trace(tracer, "level", level);
           size_t vertex_count = level_vertices.size();
+          int level_begin_count = visit_count;
           if (vertex_count < thread_count) {
+            stats->incr(SearchStats::bfs_serial_levels);
+            stats->incr(SearchStats::bfs_serial_level_vertices, vertex_count);
             for (Vertex *vertex : level_vertices) {
               if (vertex) {
                 vertex->setBfsInQueue(bfs_index_, false);
-                visitor->visit(vertex);
+                visitor->visitNarrow(vertex);
+                visit_count++;
               }
             }
           }
           else {
-            size_t from = 0;
-            size_t chunk_size = vertex_count / thread_count;
-            for (size_t k = 0; k < thread_count; k++) {
-              // Last thread gets the left overs.
-              size_t to = (k == thread_count - 1) ? vertex_count : from + chunk_size;
-              dispatch_queue_->dispatch( [=](int) {
-                for (size_t i = from; i < to; i++) {
-                  Vertex *vertex = level_vertices[i];
-                  if (vertex) {
-                    vertex->setBfsInQueue(bfs_index_, false);
-                    visitors[k]->visit(vertex);
-                  }
-                }
-              });
-              from = to;
-            }
-            dispatch_queue_->finishTasks();
+            stats->incr(SearchStats::bfs_parallel_levels);
+            stats->incr(SearchStats::bfs_parallel_level_vertices, vertex_count);
+            if (bfs_work_stealing_)
+              visit_count += visitLevelStealing(level_vertices, visitors);
+            else
+              visit_count += visitLevelChunks(level_vertices, visitors);
           }
 	  visitor->levelFinished();
 	  level_vertices.clear();
+          if (progress_)
+            progress_->addVisits(1, visit_count - level_begin_count);
 	}
       }
       for (VertexVisitor *visitor : visitors)
 	delete visitor;
+      stats->incr(SearchStats::bfs_passes);
+      stats->incr(SearchStats::bfs_vertices, visit_count);
+    }
+  }
+  return visit_count;
+}
+
+// Claim the chunk with the index of the worker thread if it is free
+// and otherwise the first free chunk. With one task per chunk each
+// task finds a chunk. Workers visit the same part of every level, so
+// the paths they make stay on the NUMA node of pinned workers.
+static size_t
+claimThreadChunk(std::atomic<bool> *claimed,
+                 size_t chunk_count,
+                 int thread)
+{
+  size_t chunk = thread;
+  if (chunk < chunk_count
+      && !claimed[chunk].exchange(true, std::memory_order_relaxed))
+    return chunk;
+  for (chunk = 0; chunk < chunk_count; chunk++) {
+    if (!claimed[chunk].exchange(true, std::memory_order_relaxed))
+      return chunk;
+  }
+  // Not reached.
+  return 0;
+}
+
+// Split the level vertices into one contiguous chunk per thread.
+int
+BfsIterator::visitLevelChunks(VertexSeq &level_vertices,
+                              std::vector<VertexVisitor*> &visitors)
+{
+  size_t thread_count = visitors.size();
+  size_t vertex_count = level_vertices.size();
+  std::atomic<int> visit_count(0);
+  size_t chunk_size = vertex_count / thread_count;
+  std::unique_ptr<std::atomic<bool>[]> claimed(new std::atomic<bool>[thread_count]);
+  for (size_t k = 0; k < thread_count; k++)
+    claimed[k].store(false, std::memory_order_relaxed);
+  std::atomic<bool> *claimed1 = claimed.get();
+  for (size_t t = 0; t < thread_count; t++) {
+    dispatch_queue_->dispatch( [=, &level_vertices, &visitors, &visit_count](int thread) {
+      size_t k = claimThreadChunk(claimed1, thread_count, thread);
+      size_t from = k * chunk_size;
+      // Last chunk gets the left overs.
+      size_t to = (k == thread_count - 1) ? vertex_count : from + chunk_size;
+      int count = 0;
+      for (size_t i = from; i < to; i++) {
+        prefetchLevelVertex(level_vertices, i, to);
+        Vertex *vertex = level_vertices[i];
+        if (vertex) {
+          vertex->setBfsInQueue(bfs_index_, false);
+          visitors[k]->visit(vertex);
+          count++;
+        }
+      }
+      visit_count += count;
+    });
+  }
+  dispatch_queue_->finishTasks();
+  return visit_count;
+}
+
+// Prefetch the Vertex twice the prefetch distance ahead of index, and
+// the edges and path arrays of the vertex the distance ahead, whose
+// Vertex was prefetched earlier.
+void
+BfsIterator::prefetchLevelVertex(const VertexSeq &level_vertices,
+                                 size_t index,
+                                 size_t end) const
+{
+  size_t distance = bfs_prefetch_distance_;
+  if (distance > 0) {
+    if (index + distance * 2 < end) {
+      Vertex *vertex = level_vertices[index + distance * 2];
+      if (vertex)
+        prefetchRead(vertex);
+    }
+    if (index + distance < end) {
+      Vertex *vertex = level_vertices[index + distance];
+      if (vertex)
+        graph_->prefetchVertexData(vertex);
     }
   }
+}
+
+// Range of level vertex indices owned by one thread.
+// Owners and thieves both claim chunks with fetch_add on next_ so
+// every vertex is visited exactly once without locking.
+class BfsStealRange
+{
+public:
+  std::atomic<size_t> next_;
+  size_t end_;
+  // Keep ranges on separate cache lines.
+  char pad_[64 - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+};
+
+// Vertices claimed at a time from a thread range.
+static const size_t bfs_steal_chunk_size = 16;
+
+// Each thread owns an equal share of the level vertices but visits
+// it in small chunks. When a thread exhausts its own range it steals
+// chunks from the ranges of the other threads, so a few expensive
+// vertices (high fanout drivers, many tags) do not leave the other
+// threads idle at the level barrier.
+int
+BfsIterator::visitLevelStealing(VertexSeq &level_vertices,
+                                std::vector<VertexVisitor*> &visitors)
+{
+  size_t thread_count = visitors.size();
+  size_t vertex_count = level_vertices.size();
+  std::vector<BfsStealRange> ranges(thread_count);
+  size_t from = 0;
+  size_t share = vertex_count / thread_count;
+  for (size_t k = 0; k < thread_count; k++) {
+    size_t to = (k == thread_count - 1) ? vertex_count : from + share;
+    ranges[k].next_ = from;
+    ranges[k].end_ = to;
+    from = to;
+  }
+  std::atomic<int> visit_count(0);
+  BfsStealRange *ranges1 = ranges.data();
+  std::unique_ptr<std::atomic<bool>[]> claimed(new std::atomic<bool>[thread_count]);
+  for (size_t k = 0; k < thread_count; k++)
+    claimed[k].store(false, std::memory_order_relaxed);
+  std::atomic<bool> *claimed1 = claimed.get();
+  for (size_t t = 0; t < thread_count; t++) {
+    dispatch_queue_->dispatch( [=, &level_vertices, &visitors, &visit_count](int thread) {
+      size_t k = claimThreadChunk(claimed1, thread_count, thread);
+      VertexVisitor *visitor = visitors[k];
+      int count = 0;
+      // Start with the thread's own range and then move on to victims.
+      for (size_t v = 0; v < thread_count; v++) {
+        BfsStealRange &range = ranges1[(k + v) % thread_count];
+        size_t end = range.end_;
+        while (range.next_.load(std::memory_order_relaxed) < end) {
+          size_t chunk_from = range.next_.fetch_add(bfs_steal_chunk_size);
+          if (chunk_from >= end)
+            break;
+          size_t chunk_to = std::min(chunk_from + bfs_steal_chunk_size, end);
+          for (size_t i = chunk_from; i < chunk_to; i++) {
+            prefetchLevelVertex(level_vertices, i, end);
+            Vertex *vertex = level_vertices[i];
+            if (vertex) {
+              vertex->setBfsInQueue(bfs_index_, false);
+              visitor->visit(vertex);
+              count++;
+            }
+          }
+        }
+      }
+      visit_count += count;
+    });
+  }
+  dispatch_queue_->finishTasks();
   return visit_count;
 }
 
+////////////////////////////////////////////////////////////////
+
+int
+BfsIterator::visitDependent(Level to_level,
+                            std::vector<VertexVisitor*> &visitors)
+{
+  VertexSeq cone;
+  findDependentCone(to_level, cone);
+
+  // Vertices with no unvisited predecessors.
+  VertexSeq ready;
+  for (Vertex *vertex : cone) {
+    if (dependent_counts_[graph_->id(vertex)] == 0)
+      ready.push_back(vertex);
+  }
+  std::mutex ready_lock;
+  std::atomic<size_t> ready_count(ready.size());
+  std::atomic<size_t> remaining(cone.size());
+  std::atomic<int> visit_count(0);
+  size_t thread_count = visitors.size();
+  for (size_t k = 0; k < thread_count; k++) {
+    dispatch_queue_->dispatch( [=, &visitors, &ready, &ready_lock,
+                                &ready_count, &remaining, &visit_count](int) {
+      VertexVisitor *visitor = visitors[k];
+      // Ready vertices released by this thread are visited depth first.
+      VertexSeq local;
+      VertexSeq dependents;
+      int count = 0;
+      while (remaining.load(std::memory_order_acquire) > 0) {
+        Vertex *vertex = nullptr;
+        if (!local.empty()) {
+          vertex = local.back();
+          local.pop_back();
+        }
+        else if (ready_count.load(std::memory_order_relaxed) > 0) {
+          UniqueLock lock(ready_lock);
+          if (!ready.empty()) {
+            vertex = ready.back();
+            ready.pop_back();
+            ready_count--;
+          }
+        }
+        if (vertex) {
+          // Cone vertices that are not queued only release dependents.
+          if (vertex->bfsInQueue(bfs_index_)) {
+            vertex->setBfsInQueue(bfs_index_, false);
+            visitor->visit(vertex);
+            count++;
+          }
+          findDependents(vertex, to_level, dependents);
+          for (Vertex *dependent : dependents) {
+            std::atomic<int> &dep_count = dependent_counts_[graph_->id(dependent)];
+            if (dep_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+              local.push_back(dependent);
+          }
+          // Share ready vertices with idle threads.
+          if (local.size() > 1
+              && ready_count.load(std::memory_order_relaxed) == 0) {
+            UniqueLock lock(ready_lock);
+            size_t share = local.size() / 2;
+            for (size_t i = 0; i < share; i++) {
+              ready.push_back(local.back());
+              local.pop_back();
+            }
+            ready_count += share;
+          }
+          remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        else
+          std::this_thread::yield();
+      }
+      visit_count += count;
+    });
+  }
+  dispatch_queue_->finishTasks();
+
+  for (Vertex *vertex : cone)
+    dependent_counts_[graph_->id(vertex)] = -1;
+  removeVisitedEntries(to_level);
+  return visit_count;
+}
+
+// Find the queued vertices and the vertices that depend on them and
+// count the predecessors of each vertex in the cone.
+void
+BfsIterator::findDependentCone(Level to_level,
+                               VertexSeq &cone)
+{
+  ensureDependentCounts();
+  Level level = first_level_;
+  while (levelLessOrEqual(level, last_level_)
+         && levelLessOrEqual(level, to_level)) {
+    for (Vertex *vertex : queue_[level]) {
+      if (vertex) {
+        std::atomic<int> &dep_count = dependent_counts_[graph_->id(vertex)];
+        if (dep_count < 0) {
+          dep_count = 0;
+          cone.push_back(vertex);
+        }
+      }
+    }
+    incrLevel(level);
+  }
+  VertexSeq dependents;
+  // The cone grows as it is scanned.
+  for (size_t i = 0; i < cone.size(); i++) {
+    findDependents(cone[i], to_level, dependents);
+    for (Vertex *dependent : dependents) {
+      std::atomic<int> &dep_count = dependent_counts_[graph_->id(dependent)];
+      if (dep_count < 0) {
+        dep_count = 1;
+        cone.push_back(dependent);
+      }
+      else
+        dep_count++;
+    }
+  }
+}
+
+void
+BfsIterator::ensureDependentCounts()
+{
+  size_t id_bound = graph_->vertexIdBound();
+  if (dependent_counts_size_ < id_bound) {
+    dependent_counts_.reset(new std::atomic<int>[id_bound]);
+    for (size_t i = 0; i < id_bound; i++)
+      dependent_counts_[i] = -1;
+    dependent_counts_size_ = id_bound;
+  }
+}
+
+// Remove queue entries for visited vertices, leaving the vertices
+// that were enqueued after they were passed in the cone.
+void
+BfsIterator::removeVisitedEntries(Level to_level)
+{
+  Level level = first_level_;
+  while (levelLessOrEqual(level, last_level_)
+         && levelLessOrEqual(level, to_level)) {
+    VertexSeq &level_vertices = queue_[level];
+    size_t keep = 0;
+    for (Vertex *vertex : level_vertices) {
+      // Clear the in queue flag to skip duplicate entries.
+      if (vertex && vertex->bfsInQueue(bfs_index_)) {
+        vertex->setBfsInQueue(bfs_index_, false);
+        level_vertices[keep++] = vertex;
+      }
+    }
+    level_vertices.resize(keep);
+    for (Vertex *vertex : level_vertices)
+      vertex->setBfsInQueue(bfs_index_, true);
+    incrLevel(level);
+  }
+}
+
 bool
 BfsIterator::hasNext()
 {
@@ -354,22 +710,31 @@ BfsFwdIterator::levelLess(Level level1,
   return level1 < level2;
 }
 
+void
+BfsFwdIterator::findDependents(Vertex *vertex,
+                               Level to_level,
+                               VertexSeq &dependents)
+{
+  dependents.clear();
+  Level level = vertex->level();
+  VertexOutEdgeIterator edge_iter(vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *edge = edge_iter.next();
+    Vertex *to_vertex = edge->to(graph_);
+    Level to_vertex_level = to_vertex->level();
+    // Edges that do not increase the level are disabled loop edges.
+    if (to_vertex_level > level
+        && to_vertex_level <= to_level)
+      dependents.push_back(to_vertex);
+  }
+}
+
 void
 BfsFwdIterator::enqueueAdjacentVertices(Vertex *vertex,
 					SearchPred *search_pred,
 					Level to_level)
 {
-  if (search_pred->searchFrom(vertex)) {
-    VertexOutEdgeIterator edge_iter(vertex, graph_);
-    while (edge_iter.hasNext()) {
-      Edge *edge = edge_iter.next();
-      Vertex *to_vertex = edge->to(graph_);
-      if (to_vertex->level() <= to_level
-	  && search_pred->searchThru(edge)
-	  && search_pred->searchTo(to_vertex))
-	enqueue(to_vertex);
-    }
-  }
+  enqueueAdjacent(vertex, *search_pred, to_level);
 }
 
 ////////////////////////////////////////////////////////////////
@@ -408,22 +773,30 @@ BfsBkwdIterator::levelLess(Level level1,
   return level1 > level2;
 }
 
+void
+BfsBkwdIterator::findDependents(Vertex *vertex,
+                                Level to_level,
+                                VertexSeq &dependents)
+{
+  dependents.clear();
+  Level level = vertex->level();
+  VertexInEdgeIterator edge_iter(vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *edge = edge_iter.next();
+    Vertex *from_vertex = edge->from(graph_);
+    Level from_vertex_level = from_vertex->level();
+    if (from_vertex_level < level
+        && from_vertex_level >= to_level)
+      dependents.push_back(from_vertex);
+  }
+}
+
 void
 BfsBkwdIterator::enqueueAdjacentVertices(Vertex *vertex,
 					 SearchPred *search_pred,
 					 Level to_level)
 {
-  if (search_pred->searchTo(vertex)) {
-    VertexInEdgeIterator edge_iter(vertex, graph_);
-    while (edge_iter.hasNext()) {
-      Edge *edge = edge_iter.next();
-      Vertex *from_vertex = edge->from(graph_);
-      if (from_vertex->level() >= to_level
-	  && search_pred->searchFrom(from_vertex)
-	  && search_pred->searchThru(edge))
-	enqueue(from_vertex);
-    }
-  }
+  enqueueAdjacent(vertex, *search_pred, to_level);
 }
 
 } // namespace
@@ -16,7 +16,10 @@
 
 #include "CheckCapacitanceLimits.hh"
 
+#include <algorithm>
+
 #include "Fuzzy.hh"
+#include "ArcDelayCalc.hh"
 #include "Liberty.hh"
 #include "Network.hh"
 #include "Sdc.hh"
@@ -84,14 +87,49 @@ PinCapacitanceLimitSlackLess::operator()(const Pin *pin1,
 ////////////////////////////////////////////////////////////////
 
 CheckCapacitanceLimits::CheckCapacitanceLimits(const Sta *sta) :
-  sta_(sta)
+  sta_(sta),
+  violators_(sta)
+{
+}
+
+void
+CheckCapacitanceLimits::clear()
+{
+  violators_.clear();
+}
+
+void
+CheckCapacitanceLimits::pinChanged(const Pin *pin)
+{
+  violators_.pinChanged(pin);
+}
+
+void
+CheckCapacitanceLimits::deletePinBefore(const Pin *pin)
+{
+  violators_.deletePinBefore(pin);
+}
+
+void
+CheckCapacitanceLimits::checkCapacitance(const Pin *pin,
+					 const Corner *corner,
+					 const MinMax *min_max,
+					 // Return values.
+					 const Corner *&corner1,
+					 const RiseFall *&rf1,
+					 float &capacitance1,
+					 float &limit1,
+					 float &slack1) const
 {
+  checkCapacitance(pin, corner, min_max, sta_->arcDelayCalc(),
+                   corner1, rf1, capacitance1, limit1, slack1);
 }
 
 void
 CheckCapacitanceLimits::checkCapacitance(const Pin *pin,
 					 const Corner *corner,
 					 const MinMax *min_max,
+					 ArcDelayCalc *arc_delay_calc,
 					 // Return values.
 					 const Corner *&corner1,
 					 const RiseFall *&rf1,
@@ -105,11 +143,11 @@ CheckCapacitanceLimits::checkCapacitance(const Pin *pin,
   limit1 = 0.0;
   slack1 = MinMax::min()->initValue();
   if (corner)
-    checkCapacitance1(pin, corner, min_max,
+    checkCapacitance1(pin, corner, min_max, arc_delay_calc,
 		      corner1, rf1, capacitance1, limit1, slack1);
   else {
     for (auto corner : *sta_->corners()) {
-      checkCapacitance1(pin, corner, min_max,
+      checkCapacitance1(pin, corner, min_max, arc_delay_calc,
                         corner1, rf1, capacitance1, limit1, slack1);
     }
   }
@@ -119,6 +157,7 @@ void
 CheckCapacitanceLimits::checkCapacitance1(const Pin *pin,
 					  const Corner *corner,
 					  const MinMax *min_max,
+					  ArcDelayCalc *arc_delay_calc,
 					  // Return values.
 					  const Corner *&corner1,
 					  const RiseFall *&rf1,
@@ -131,7 +170,7 @@ CheckCapacitanceLimits::checkCapacitance1(const Pin *pin,
   findLimit(pin, corner, min_max, limit, limit_exists);
   if (limit_exists) {
     for (auto rf : RiseFall::range()) {
-      checkCapacitance(pin, corner, min_max, rf, limit,
+      checkCapacitance(pin, corner, min_max, arc_delay_calc, rf, limit,
 		       corner1, rf1, capacitance1, slack1, limit1);
     }
   }
@@ -221,6 +260,7 @@ void
 CheckCapacitanceLimits::checkCapacitance(const Pin *pin,
 					 const Corner *corner,
 					 const MinMax *min_max,
+					 ArcDelayCalc *arc_delay_calc,
 					 const RiseFall *rf,
 					 float limit,
 					 // Return values.
@@ -232,7 +272,7 @@ CheckCapacitanceLimits::checkCapacitance(const Pin *pin,
 {
   const DcalcAnalysisPt *dcalc_ap = corner->findDcalcAnalysisPt(min_max);
   GraphDelayCalc *dcalc = sta_->graphDelayCalc();
-  float cap = dcalc->loadCap(pin, dcalc_ap);
+  float cap = dcalc->loadCap(pin, dcalc_ap, arc_delay_calc);
 
   float slack = (min_max == MinMax::max())
     ? limit - cap : cap - limit;
@@ -257,26 +297,41 @@ CheckCapacitanceLimits::checkCapacitanceLimits(const Net *net,
                                                const MinMax *min_max)
 {
   const Network *network = sta_->network();
+  ArcDelayCalc *arc_delay_calc = sta_->arcDelayCalc();
   PinSeq cap_pins;
   float min_slack = MinMax::min()->initValue();
   if (net) {
     NetPinIterator *pin_iter = network->pinIterator(net);
     while (pin_iter->hasNext()) {
       const Pin *pin = pin_iter->next();
-      checkCapLimits(pin, violators, corner, min_max, cap_pins, min_slack);
+      checkCapLimits(pin, slack(pin, corner, min_max, arc_delay_calc),
+                     violators, cap_pins, min_slack);
     }
     delete pin_iter;
   }
   else {
-    LeafInstanceIterator *inst_iter = network->leafInstanceIterator();
-    while (inst_iter->hasNext()) {
-      Instance *inst = inst_iter->next();
-      checkCapLimits(inst, violators, corner, min_max, cap_pins, min_slack);
+    // The delay calculator keeps state for the driver pin so each
+    // thread needs its own.
+    std::vector<ArcDelayCalc*> arc_delay_calcs(std::max(sta_->threadCount(),
+                                                        1U));
+    arc_delay_calcs[0] = arc_delay_calc;
+    for (size_t i = 1; i < arc_delay_calcs.size(); i++)
+      arc_delay_calcs[i] = arc_delay_calc->copy();
+    LimitSlackFunc slack_func = [&] (const Pin *pin,
+                                     int thread) {
+      return slack(pin, corner, min_max, arc_delay_calcs[thread]);
+    };
+    if (violators)
+      cap_pins = violators_.violators(corner, min_max, slack_func);
+    else {
+      PinSeq pins = limitCheckPins(network);
+      std::vector<float> slacks;
+      limitCheckSlacks(pins, slack_func, sta_, slacks);
+      for (size_t i = 0; i < pins.size(); i++)
+        checkCapLimits(pins[i], slacks[i], violators, cap_pins, min_slack);
     }
-    delete inst_iter;
-    // Check top level ports.
-    checkCapLimits(network->topInstance(), violators, corner, min_max,
-                   cap_pins, min_slack);
+    for (size_t i = 1; i < arc_delay_calcs.size(); i++)
+      delete arc_delay_calcs[i];
   }
   sort(cap_pins, PinCapacitanceLimitSlackLess(corner, min_max, this, sta_));
   // Keep the min slack pin unless all violators or net pins.
@@ -285,47 +340,38 @@ CheckCapacitanceLimits::checkCapacitanceLimits(const Net *net,
   return cap_pins;
 }
 
-void
-CheckCapacitanceLimits::checkCapLimits(const Instance *inst,
-                                       bool violators,
-                                       const Corner *corner,
-                                       const MinMax *min_max,
-                                       PinSeq &cap_pins,
-                                       float &min_slack)
+float
+CheckCapacitanceLimits::slack(const Pin *pin,
+                              const Corner *corner,
+                              const MinMax *min_max,
+                              ArcDelayCalc *arc_delay_calc)
 {
-  const Network *network = sta_->network();
-  InstancePinIterator *pin_iter = network->pinIterator(inst);
-  while (pin_iter->hasNext()) {
-    Pin *pin = pin_iter->next();
-    checkCapLimits(pin, violators, corner, min_max, cap_pins, min_slack);
-  }
-  delete pin_iter;
+  const Corner *corner1;
+  const RiseFall *rf;
+  float capacitance, limit, slack = INF;
+  if (checkPin(pin))
+    checkCapacitance(pin, corner, min_max, arc_delay_calc,
+                     corner1, rf, capacitance, limit, slack);
+  return slack;
 }
 
 void
 CheckCapacitanceLimits::checkCapLimits(const Pin *pin,
+                                       float slack,
                                        bool violators,
-                                       const Corner *corner,
-                                       const MinMax *min_max,
                                        PinSeq &cap_pins,
                                        float &min_slack)
 {
-  if (checkPin(pin)) {
-    const Corner *corner1;
-    const RiseFall *rf;
-    float capacitance, limit, slack;
-    checkCapacitance(pin, corner, min_max, corner1, rf, capacitance, limit, slack);
-    if (!fuzzyInf(slack)) {
-      if (violators) {
-        if (slack < 0.0)
-          cap_pins.push_back(pin);
-      }
-      else {
-        if (cap_pins.empty()
-            || slack < min_slack) {
-          cap_pins.push_back(pin);
-          min_slack = slack;
-        }
+  if (!fuzzyInf(slack)) {
+    if (violators) {
+      if (slack < 0.0)
+        cap_pins.push_back(pin);
+    }
+    else {
+      if (cap_pins.empty()
+          || slack < min_slack) {
+        cap_pins.push_back(pin);
+        min_slack = slack;
       }
     }
   }
@@ -20,6 +20,7 @@
 #include "Transition.hh"
 #include "NetworkClass.hh"
 #include "SdcClass.hh"
+#include "LimitViolators.hh"
 #include "Sta.hh"
 
 namespace sta {
@@ -27,6 +28,8 @@ namespace sta {
 class StaState;
 class Corner;
 
+class ArcDelayCalc;
+
 class CheckCapacitanceLimits
 {
 public:
@@ -49,11 +52,26 @@ public:
                                 bool violators,
                                 const Corner *corner,
                                 const MinMax *min_max);
+  void clear();
+  // Pin load capacitance changed by delay calculation or a netlist edit.
+  void pinChanged(const Pin *pin);
+  void deletePinBefore(const Pin *pin);
 
 protected:
   void checkCapacitance(const Pin *pin,
 			const Corner *corner,
 			const MinMax *min_max,
+			ArcDelayCalc *arc_delay_calc,
+			// Return values.
+			const Corner *&corner1,
+			const RiseFall *&rf1,
+			float &capacitance1,
+			float &limit1,
+			float &slack1) const;
+  void checkCapacitance(const Pin *pin,
+			const Corner *corner,
+			const MinMax *min_max,
+			ArcDelayCalc *arc_delay_calc,
 			const RiseFall *rf,
 			float limit,
 			// Return values.
@@ -65,6 +83,7 @@ protected:
   void checkCapacitance1(const Pin *pin,
                          const Corner *corner,
                          const MinMax *min_max,
+                         ArcDelayCalc *arc_delay_calc,
                          // Return values.
                          const Corner *&corner1,
                          const RiseFall *&rf1,
@@ -77,21 +96,19 @@ protected:
 		 // Return values.
 		 float &limit,
 		 bool &limit_exists) const;
-  void checkCapLimits(const Instance *inst,
-                      bool violators,
-                      const Corner *corner,
-                      const MinMax *min_max,
-                      PinSeq &cap_pins,
-                      float &min_slack);
+  float slack(const Pin *pin,
+              const Corner *corner,
+              const MinMax *min_max,
+              ArcDelayCalc *arc_delay_calc);
   void checkCapLimits(const Pin *pin,
+                      float slack,
                       bool violators,
-                      const Corner *corner,
-                      const MinMax *min_max,
                       PinSeq &cap_pins,
                       float &min_slack);
   bool checkPin(const Pin *pin);
 
   const Sta *sta_;
+  LimitViolators violators_;
 };
 
 } // namespace
@@ -72,8 +72,27 @@ PinFanoutLimitSlackLess::operator()(const Pin *pin1,
 ////////////////////////////////////////////////////////////////
 
 CheckFanoutLimits::CheckFanoutLimits(const Sta *sta) :
-  sta_(sta)
+  sta_(sta),
+  violators_(sta)
+{
+}
+
+void
+CheckFanoutLimits::clear()
+{
+  violators_.clear();
+}
+
+void
+CheckFanoutLimits::pinChanged(const Pin *pin)
 {
+  violators_.pinChanged(pin);
+}
+
+void
+CheckFanoutLimits::deletePinBefore(const Pin *pin)
+{
+  violators_.deletePinBefore(pin);
 }
 
 void
@@ -236,26 +255,29 @@ CheckFanoutLimits::checkFanoutLimits(const Net *net,
                                      const MinMax *min_max)
 {
   const Network *network = sta_->network();
+  LimitSlackFunc slack_func = [=] (const Pin *pin,
+                                   int) {
+    return slack(pin, min_max);
+  };
   PinSeq fanout_pins;
   float min_slack = MinMax::min()->initValue();
   if (net) {
     NetPinIterator *pin_iter = network->pinIterator(net);
     while (pin_iter->hasNext()) {
       const Pin *pin = pin_iter->next();
-      checkFanoutLimits(pin, violators, min_max, fanout_pins, min_slack);
+      checkFanoutLimits(pin, slack(pin, min_max), violators,
+                        fanout_pins, min_slack);
     }
     delete pin_iter;
   }
+  else if (violators)
+    fanout_pins = violators_.violators(nullptr, min_max, slack_func);
   else {
-    LeafInstanceIterator *inst_iter = network->leafInstanceIterator();
-    while (inst_iter->hasNext()) {
-      const Instance *inst = inst_iter->next();
-      checkFanoutLimits(inst, violators, min_max, fanout_pins, min_slack);
-    }
-    delete inst_iter;
-    // Check top level ports.
-    checkFanoutLimits(network->topInstance(), violators, min_max,
-                    fanout_pins, min_slack);
+    PinSeq pins = limitCheckPins(network);
+    std::vector<float> slacks;
+    limitCheckSlacks(pins, slack_func, sta_, slacks);
+    for (size_t i = 0; i < pins.size(); i++)
+      checkFanoutLimits(pins[i], slacks[i], violators, fanout_pins, min_slack);
   }
   sort(fanout_pins, PinFanoutLimitSlackLess(min_max, this, sta_));
   // Keep the min slack pin unless all violators or net pins.
@@ -264,44 +286,33 @@ CheckFanoutLimits::checkFanoutLimits(const Net *net,
   return fanout_pins;
 }
 
-void
-CheckFanoutLimits::checkFanoutLimits(const Instance *inst,
-                                     bool violators,
-                                     const MinMax *min_max,
-                                     PinSeq &fanout_pins,
-                                     float &min_slack)
+float
+CheckFanoutLimits::slack(const Pin *pin,
+                         const MinMax *min_max)
 {
-  const Network *network = sta_->network();
-  InstancePinIterator *pin_iter = network->pinIterator(inst);
-  while (pin_iter->hasNext()) {
-    const Pin *pin = pin_iter->next();
-    checkFanoutLimits(pin, violators, min_max, fanout_pins, min_slack);
-  }
-  delete pin_iter;
+  float fanout, limit, slack = INF;
+  if (checkPin(pin))
+    checkFanout(pin, min_max, fanout, limit, slack);
+  return slack;
 }
 
 void
 CheckFanoutLimits::checkFanoutLimits(const Pin *pin,
+                                     float slack,
                                      bool violators,
-                                     const MinMax *min_max,
                                      PinSeq &fanout_pins,
                                      float &min_slack)
 {
-  if (checkPin(pin)) {
-    float fanout;
-    float limit, slack;
-    checkFanout(pin, min_max, fanout, limit, slack);
-    if (!fuzzyInf(slack)) {
-      if (violators) {
-        if (slack < 0.0)
-          fanout_pins.push_back(pin);
-      }
-      else {
-        if (fanout_pins.empty()
-            || slack < min_slack) {
-          fanout_pins.push_back(pin);
-          min_slack = slack;
-        }
+  if (!fuzzyInf(slack)) {
+    if (violators) {
+      if (slack < 0.0)
+        fanout_pins.push_back(pin);
+    }
+    else {
+      if (fanout_pins.empty()
+          || slack < min_slack) {
+        fanout_pins.push_back(pin);
+        min_slack = slack;
       }
     }
   }
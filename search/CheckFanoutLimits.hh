@@ -20,6 +20,7 @@
 #include "NetworkClass.hh"
 #include "SdcClass.hh"
 #include "Sta.hh"
+#include "LimitViolators.hh"
 
 namespace sta {
 
@@ -41,6 +42,10 @@ public:
   PinSeq checkFanoutLimits(const Net *net,
                            bool violators,
                            const MinMax *min_max);
+  void clear();
+  // Pin fanout changed by a netlist edit.
+  void pinChanged(const Pin *pin);
+  void deletePinBefore(const Pin *pin);
 
 protected:
   void checkFanout(const Pin *pin,
@@ -56,19 +61,17 @@ protected:
 		 float &limit,
 		 bool &limit_exists) const;
   float fanoutLoad(const Pin *pin) const;
-  void checkFanoutLimits(const Instance *inst,
-                         bool violators,
-                         const MinMax *min_max,
-                         PinSeq &fanout_pins,
-                         float &min_slack);
+  float slack(const Pin *pin,
+              const MinMax *min_max);
   void checkFanoutLimits(const Pin *pin,
+                         float slack,
                          bool violators,
-                         const MinMax *min_max,
                          PinSeq &fanout_pins,
                          float &min_slack);
   bool checkPin(const Pin *pin);
 
   const Sta *sta_;
+  LimitViolators violators_;
 };
 
 } // namespace
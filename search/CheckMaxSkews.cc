@@ -25,6 +25,7 @@
 #include "PathVertex.hh"
 #include "PathAnalysisPt.hh"
 #include "Search.hh"
+#include "ParallelChecks.hh"
 
 namespace sta {
 
@@ -36,6 +37,10 @@ public:
   virtual ~MaxSkewCheckVisitor() {}
   virtual void visit(MaxSkewCheck &check,
 		     const StaState *sta) = 0;
+  // Visitor for the checks of a subset of the vertices.
+  virtual MaxSkewCheckVisitor *copy() const = 0;
+  // Add the checks of a visitor made by copy.
+  virtual void merge(MaxSkewCheckVisitor *visitor) = 0;
 };
 
 CheckMaxSkews::CheckMaxSkews(StaState *sta) :
@@ -57,20 +62,17 @@ CheckMaxSkews::clear()
 class MaxSkewChecksVisitor : public MaxSkewCheckVisitor
 {
 public:
-  explicit MaxSkewChecksVisitor(MaxSkewCheckSeq &checks);
+  MaxSkewChecksVisitor() {}
   virtual void visit(MaxSkewCheck &check,
 		     const StaState *sta);
+  virtual MaxSkewCheckVisitor *copy() const;
+  virtual void merge(MaxSkewCheckVisitor *visitor);
+  MaxSkewCheckSeq &checks() { return checks_; }
 
-private:
-  MaxSkewCheckSeq &checks_;
+protected:
+  MaxSkewCheckSeq checks_;
 };
 
-MaxSkewChecksVisitor::MaxSkewChecksVisitor(MaxSkewCheckSeq &checks) :
-  MaxSkewCheckVisitor(),
-  checks_(checks)
-{
-}
-
 void
 MaxSkewChecksVisitor::visit(MaxSkewCheck &check,
 			    const StaState *)
@@ -78,24 +80,30 @@ MaxSkewChecksVisitor::visit(MaxSkewCheck &check,
   checks_.push_back(new MaxSkewCheck(check));
 }
 
-class MaxSkewViolatorsVisititor : public MaxSkewCheckVisitor
+MaxSkewCheckVisitor *
+MaxSkewChecksVisitor::copy() const
+{
+  return new MaxSkewChecksVisitor;
+}
+
+void
+MaxSkewChecksVisitor::merge(MaxSkewCheckVisitor *visitor)
+{
+  MaxSkewCheckSeq &checks =
+    static_cast<MaxSkewChecksVisitor*>(visitor)->checks_;
+  checks_.insert(checks_.end(), checks.begin(), checks.end());
+  checks.clear();
+}
+
+class MaxSkewViolatorsVisititor : public MaxSkewChecksVisitor
 {
 public:
-  explicit MaxSkewViolatorsVisititor(MaxSkewCheckSeq &checks);
+  MaxSkewViolatorsVisititor() {}
   virtual void visit(MaxSkewCheck &check,
 		     const StaState *sta);
-
-private:
-  MaxSkewCheckSeq &checks_;
+  virtual MaxSkewCheckVisitor *copy() const;
 };
 
-MaxSkewViolatorsVisititor::
-MaxSkewViolatorsVisititor(MaxSkewCheckSeq &checks) :
-  MaxSkewCheckVisitor(),
-  checks_(checks)
-{
-}
-
 void
 MaxSkewViolatorsVisititor::visit(MaxSkewCheck &check,
 				 const StaState *sta)
@@ -104,12 +112,19 @@ MaxSkewViolatorsVisititor::visit(MaxSkewCheck &check,
     checks_.push_back(new MaxSkewCheck(check));
 }
 
+MaxSkewCheckVisitor *
+MaxSkewViolatorsVisititor::copy() const
+{
+  return new MaxSkewViolatorsVisititor;
+}
+
 MaxSkewCheckSeq &
 CheckMaxSkews::violations()
 {
   clear();
-  MaxSkewViolatorsVisititor visitor(checks_);
+  MaxSkewViolatorsVisititor visitor;
   visitMaxSkewChecks(&visitor);
+  checks_.swap(visitor.checks());
   sort(checks_, MaxSkewSlackLess(sta_));
   return checks_;
 }
@@ -117,21 +132,32 @@ CheckMaxSkews::violations()
 class MaxSkewSlackVisitor : public MaxSkewCheckVisitor
 {
 public:
-  MaxSkewSlackVisitor();
+  explicit MaxSkewSlackVisitor(const StaState *sta);
+  virtual ~MaxSkewSlackVisitor();
   virtual void visit(MaxSkewCheck &check,
 		     const StaState *sta);
+  virtual MaxSkewCheckVisitor *copy() const;
+  virtual void merge(MaxSkewCheckVisitor *visitor);
+  // Caller owns the check.
   MaxSkewCheck *minSlackCheck();
 
 private:
+  const StaState *sta_;
   MaxSkewCheck *min_slack_check_;
 };
 
-MaxSkewSlackVisitor::MaxSkewSlackVisitor() :
+MaxSkewSlackVisitor::MaxSkewSlackVisitor(const StaState *sta) :
   MaxSkewCheckVisitor(),
+  sta_(sta),
   min_slack_check_(nullptr)
 {
 }
 
+MaxSkewSlackVisitor::~MaxSkewSlackVisitor()
+{
+  delete min_slack_check_;
+}
+
 void
 MaxSkewSlackVisitor::visit(MaxSkewCheck &check,
 			   const StaState *sta)
@@ -144,17 +170,43 @@ MaxSkewSlackVisitor::visit(MaxSkewCheck &check,
   }
 }
 
+MaxSkewCheckVisitor *
+MaxSkewSlackVisitor::copy() const
+{
+  return new MaxSkewSlackVisitor(sta_);
+}
+
+void
+MaxSkewSlackVisitor::merge(MaxSkewCheckVisitor *visitor)
+{
+  MaxSkewSlackVisitor *slack_visitor =
+    static_cast<MaxSkewSlackVisitor*>(visitor);
+  MaxSkewCheck *check = slack_visitor->minSlackCheck();
+  if (check) {
+    MaxSkewSlackLess slack_less(sta_);
+    if (min_slack_check_ == nullptr
+        || slack_less(check, min_slack_check_)) {
+      delete min_slack_check_;
+      min_slack_check_ = check;
+    }
+    else
+      delete check;
+  }
+}
+
 MaxSkewCheck *
 MaxSkewSlackVisitor::minSlackCheck()
 {
-  return min_slack_check_;
+  MaxSkewCheck *check = min_slack_check_;
+  min_slack_check_ = nullptr;
+  return check;
 }
 
 MaxSkewCheck *
 CheckMaxSkews::minSlackCheck()
 {
   clear();
-  MaxSkewSlackVisitor visitor;
+  MaxSkewSlackVisitor visitor(sta_);
   visitMaxSkewChecks(&visitor);
   MaxSkewCheck *check = visitor.minSlackCheck();
   // Save check for cleanup.
@@ -166,11 +218,20 @@ void
 CheckMaxSkews::visitMaxSkewChecks(MaxSkewCheckVisitor *visitor)
 {
   Graph *graph = sta_->graph();
+  // Skew checks are timing check edges.
+  VertexSeq check_vertices;
   VertexIterator vertex_iter(graph);
   while (vertex_iter.hasNext()) {
     Vertex *vertex = vertex_iter.next();
-    visitMaxSkewChecks(vertex, visitor);
+    if (vertex->hasChecks())
+      check_vertices.push_back(vertex);
   }
+  visitChecksParallel(check_vertices, visitor,
+                      [this] (Vertex *vertex,
+                              MaxSkewCheckVisitor *visitor1) {
+                        visitMaxSkewChecks(vertex, visitor1);
+                      },
+                      sta_);
 }
 
 void
@@ -24,6 +24,7 @@
 #include "DcalcAnalysisPt.hh"
 #include "GraphDelayCalc.hh"
 #include "Search.hh"
+#include "ParallelChecks.hh"
 
 namespace sta {
 
@@ -35,6 +36,10 @@ public:
   virtual ~MinPeriodCheckVisitor() {}
   virtual void visit(MinPeriodCheck &check,
 		     StaState *sta) = 0;
+  // Visitor for the checks of a subset of the vertices.
+  virtual MinPeriodCheckVisitor *copy() const = 0;
+  // Add the checks of a visitor made by copy.
+  virtual void merge(MinPeriodCheckVisitor *visitor) = 0;
 };
 
 CheckMinPeriods::CheckMinPeriods(StaState *sta) :
@@ -56,19 +61,17 @@ CheckMinPeriods::clear()
 class MinPeriodViolatorsVisitor : public MinPeriodCheckVisitor
 {
 public:
-  MinPeriodViolatorsVisitor(MinPeriodCheckSeq &checks);
+  MinPeriodViolatorsVisitor() {}
   virtual void visit(MinPeriodCheck &check,
 		     StaState *sta);
+  virtual MinPeriodCheckVisitor *copy() const;
+  virtual void merge(MinPeriodCheckVisitor *visitor);
+  MinPeriodCheckSeq &checks() { return checks_; }
 
 private:
-  MinPeriodCheckSeq &checks_;
+  MinPeriodCheckSeq checks_;
 };
 
-MinPeriodViolatorsVisitor::MinPeriodViolatorsVisitor(MinPeriodCheckSeq &checks):
-  checks_(checks)
-{
-}
-
 void
 MinPeriodViolatorsVisitor::visit(MinPeriodCheck &check,
 				 StaState *sta)
@@ -77,12 +80,28 @@ MinPeriodViolatorsVisitor::visit(MinPeriodCheck &check,
     checks_.push_back(check.copy());
 }
 
+MinPeriodCheckVisitor *
+MinPeriodViolatorsVisitor::copy() const
+{
+  return new MinPeriodViolatorsVisitor;
+}
+
+void
+MinPeriodViolatorsVisitor::merge(MinPeriodCheckVisitor *visitor)
+{
+  MinPeriodCheckSeq &checks =
+    static_cast<MinPeriodViolatorsVisitor*>(visitor)->checks_;
+  checks_.insert(checks_.end(), checks.begin(), checks.end());
+  checks.clear();
+}
+
 MinPeriodCheckSeq &
 CheckMinPeriods::violations()
 {
   clear();
-  MinPeriodViolatorsVisitor visitor(checks_);
+  MinPeriodViolatorsVisitor visitor;
   visitMinPeriodChecks(&visitor);
+  checks_.swap(visitor.checks());
   sort(checks_, MinPeriodSlackLess(sta_));
   return checks_;
 }
@@ -91,12 +110,19 @@ void
 CheckMinPeriods::visitMinPeriodChecks(MinPeriodCheckVisitor *visitor)
 {
   Graph *graph = sta_->graph();
+  VertexSeq clk_ends;
   VertexIterator vertex_iter(graph);
   while (vertex_iter.hasNext()) {
     Vertex *vertex = vertex_iter.next();
     if (isClkEnd(vertex, graph))
-      visitMinPeriodChecks(vertex, visitor);
+      clk_ends.push_back(vertex);
   }
+  visitChecksParallel(clk_ends, visitor,
+                      [this] (Vertex *vertex,
+                              MinPeriodCheckVisitor *visitor1) {
+                        visitMinPeriodChecks(vertex, visitor1);
+                      },
+                      sta_);
 }
 
 void
@@ -125,20 +151,31 @@ CheckMinPeriods::visitMinPeriodChecks(Vertex *vertex,
 class MinPeriodSlackVisitor : public MinPeriodCheckVisitor
 {
 public:
-  MinPeriodSlackVisitor();
+  explicit MinPeriodSlackVisitor(StaState *sta);
+  virtual ~MinPeriodSlackVisitor();
   virtual void visit(MinPeriodCheck &check,
 		     StaState *sta);
+  virtual MinPeriodCheckVisitor *copy() const;
+  virtual void merge(MinPeriodCheckVisitor *visitor);
+  // Caller owns the check.
   MinPeriodCheck *minSlackCheck();
 
 private:
+  StaState *sta_;
   MinPeriodCheck *min_slack_check_;
 };
 
-MinPeriodSlackVisitor::MinPeriodSlackVisitor() :
+MinPeriodSlackVisitor::MinPeriodSlackVisitor(StaState *sta) :
+  sta_(sta),
   min_slack_check_(nullptr)
 {
 }
 
+MinPeriodSlackVisitor::~MinPeriodSlackVisitor()
+{
+  delete min_slack_check_;
+}
+
 void
 MinPeriodSlackVisitor::visit(MinPeriodCheck &check,
 			     StaState *sta)
@@ -152,17 +189,43 @@ MinPeriodSlackVisitor::visit(MinPeriodCheck &check,
   }
 }
 
+MinPeriodCheckVisitor *
+MinPeriodSlackVisitor::copy() const
+{
+  return new MinPeriodSlackVisitor(sta_);
+}
+
+void
+MinPeriodSlackVisitor::merge(MinPeriodCheckVisitor *visitor)
+{
+  MinPeriodSlackVisitor *slack_visitor =
+    static_cast<MinPeriodSlackVisitor*>(visitor);
+  MinPeriodCheck *check = slack_visitor->minSlackCheck();
+  if (check) {
+    MinPeriodSlackLess slack_less(sta_);
+    if (min_slack_check_ == nullptr
+        || slack_less(check, min_slack_check_)) {
+      delete min_slack_check_;
+      min_slack_check_ = check;
+    }
+    else
+      delete check;
+  }
+}
+
 MinPeriodCheck *
 MinPeriodSlackVisitor::minSlackCheck()
 {
-  return min_slack_check_;
+  MinPeriodCheck *check = min_slack_check_;
+  min_slack_check_ = nullptr;
+  return check;
 }
 
 MinPeriodCheck *
 CheckMinPeriods::minSlackCheck()
 {
   clear();
-  MinPeriodSlackVisitor visitor;
+  MinPeriodSlackVisitor visitor(sta_);
   visitMinPeriodChecks(&visitor);
   MinPeriodCheck *check = visitor.minSlackCheck();
   // Save check for cleanup.
@@ -35,6 +35,7 @@
 #include "PathEnd.hh"
 #include "Search.hh"
 #include "search/Crpr.hh"
+#include "ParallelChecks.hh"
 
 namespace sta {
 
@@ -53,6 +54,10 @@ public:
   virtual ~MinPulseWidthCheckVisitor() {}
   virtual void visit(MinPulseWidthCheck &check,
 		     const StaState *sta) = 0;
+  // Visitor for the checks of a subset of the vertices.
+  virtual MinPulseWidthCheckVisitor *copy() const = 0;
+  // Add the checks of a visitor made by copy.
+  virtual void merge(MinPulseWidthCheckVisitor *visitor) = 0;
 };
 
 CheckMinPulseWidths::CheckMinPulseWidths(StaState *sta) :
@@ -76,21 +81,21 @@ CheckMinPulseWidths::clear()
 class MinPulseWidthChecksVisitor : public MinPulseWidthCheckVisitor
 {
 public:
-  explicit MinPulseWidthChecksVisitor(const Corner *corner,
-				      MinPulseWidthCheckSeq &checks);
+  explicit MinPulseWidthChecksVisitor(const Corner *corner);
   virtual void visit(MinPulseWidthCheck &check,
 		     const StaState *sta);
+  virtual MinPulseWidthCheckVisitor *copy() const;
+  virtual void merge(MinPulseWidthCheckVisitor *visitor);
+  MinPulseWidthCheckSeq &checks() { return checks_; }
 
-private:
+protected:
   const Corner *corner_;
-  MinPulseWidthCheckSeq &checks_;
+  MinPulseWidthCheckSeq checks_;
 };
 
 MinPulseWidthChecksVisitor::
-MinPulseWidthChecksVisitor(const Corner *corner,
-			   MinPulseWidthCheckSeq &checks) :
-  corner_(corner),
-  checks_(checks)
+MinPulseWidthChecksVisitor(const Corner *corner) :
+  corner_(corner)
 {
 }
 
@@ -105,12 +110,28 @@ MinPulseWidthChecksVisitor::visit(MinPulseWidthCheck &check,
   }
 }
 
+MinPulseWidthCheckVisitor *
+MinPulseWidthChecksVisitor::copy() const
+{
+  return new MinPulseWidthChecksVisitor(corner_);
+}
+
+void
+MinPulseWidthChecksVisitor::merge(MinPulseWidthCheckVisitor *visitor)
+{
+  MinPulseWidthCheckSeq &checks =
+    static_cast<MinPulseWidthChecksVisitor*>(visitor)->checks_;
+  checks_.insert(checks_.end(), checks.begin(), checks.end());
+  checks.clear();
+}
+
 MinPulseWidthCheckSeq &
 CheckMinPulseWidths::check(const Corner *corner)
 {
   clear();
-  MinPulseWidthChecksVisitor visitor(corner, checks_);
+  MinPulseWidthChecksVisitor visitor(corner);
   visitMinPulseWidthChecks(&visitor);
+  checks_.swap(visitor.checks());
   sort(checks_, MinPulseWidthSlackLess(sta_));
   return checks_;
 }
@@ -121,37 +142,32 @@ CheckMinPulseWidths::check(PinSeq *pins,
 {
   clear();
   Graph *graph = sta_->graph();
-  MinPulseWidthChecksVisitor visitor(corner, checks_);
+  MinPulseWidthChecksVisitor visitor(corner);
   PinSeq::Iterator pin_iter(pins);
   while (pin_iter.hasNext()) {
     const Pin *pin = pin_iter.next();
     Vertex *vertex = graph->pinLoadVertex(pin);
     visitMinPulseWidthChecks(vertex, &visitor);
   }
+  checks_.swap(visitor.checks());
   sort(checks_, MinPulseWidthSlackLess(sta_));
   return checks_;
 }
 
 ////////////////////////////////////////////////////////////////
 
-class MinPulseWidthViolatorsVisitor : public MinPulseWidthCheckVisitor
+class MinPulseWidthViolatorsVisitor : public MinPulseWidthChecksVisitor
 {
 public:
-  explicit MinPulseWidthViolatorsVisitor(const Corner *corner,
-					 MinPulseWidthCheckSeq &checks);
+  explicit MinPulseWidthViolatorsVisitor(const Corner *corner);
   virtual void visit(MinPulseWidthCheck &check,
 		     const StaState *sta);
-
-private:
-  const Corner *corner_;
-  MinPulseWidthCheckSeq &checks_;
+  virtual MinPulseWidthCheckVisitor *copy() const;
 };
 
 MinPulseWidthViolatorsVisitor::
-MinPulseWidthViolatorsVisitor(const Corner *corner,
-			      MinPulseWidthCheckSeq &checks) :
-  corner_(corner),
-  checks_(checks)
+MinPulseWidthViolatorsVisitor(const Corner *corner) :
+  MinPulseWidthChecksVisitor(corner)
 {
 }
 
@@ -167,12 +183,19 @@ MinPulseWidthViolatorsVisitor::visit(MinPulseWidthCheck &check,
   }
 }
 
+MinPulseWidthCheckVisitor *
+MinPulseWidthViolatorsVisitor::copy() const
+{
+  return new MinPulseWidthViolatorsVisitor(corner_);
+}
+
 MinPulseWidthCheckSeq &
 CheckMinPulseWidths::violations(const Corner *corner)
 {
   clear();
-  MinPulseWidthViolatorsVisitor visitor(corner, checks_);
+  MinPulseWidthViolatorsVisitor visitor(corner);
   visitMinPulseWidthChecks(&visitor);
+  checks_.swap(visitor.checks());
   sort(checks_, MinPulseWidthSlackLess(sta_));
   return checks_;
 }
@@ -182,22 +205,35 @@ CheckMinPulseWidths::violations(const Corner *corner)
 class MinPulseWidthSlackVisitor : public MinPulseWidthCheckVisitor
 {
 public:
-  MinPulseWidthSlackVisitor(const Corner *corner);
+  MinPulseWidthSlackVisitor(const Corner *corner,
+                            const StaState *sta);
+  virtual ~MinPulseWidthSlackVisitor();
   virtual void visit(MinPulseWidthCheck &check,
 		     const StaState *sta);
+  virtual MinPulseWidthCheckVisitor *copy() const;
+  virtual void merge(MinPulseWidthCheckVisitor *visitor);
+  // Caller owns the check.
   MinPulseWidthCheck *minSlackCheck();
 
 private:
   const Corner *corner_;
+  const StaState *sta_;
   MinPulseWidthCheck *min_slack_check_;
 };
 
-MinPulseWidthSlackVisitor::MinPulseWidthSlackVisitor(const Corner *corner) :
+MinPulseWidthSlackVisitor::MinPulseWidthSlackVisitor(const Corner *corner,
+                                                     const StaState *sta) :
   corner_(corner),
+  sta_(sta),
   min_slack_check_(nullptr)
 {
 }
 
+MinPulseWidthSlackVisitor::~MinPulseWidthSlackVisitor()
+{
+  delete min_slack_check_;
+}
+
 void
 MinPulseWidthSlackVisitor::visit(MinPulseWidthCheck &check,
 				 const StaState *sta)
@@ -214,17 +250,43 @@ MinPulseWidthSlackVisitor::visit(MinPulseWidthCheck &check,
   }
 }
 
+MinPulseWidthCheckVisitor *
+MinPulseWidthSlackVisitor::copy() const
+{
+  return new MinPulseWidthSlackVisitor(corner_, sta_);
+}
+
+void
+MinPulseWidthSlackVisitor::merge(MinPulseWidthCheckVisitor *visitor)
+{
+  MinPulseWidthSlackVisitor *slack_visitor =
+    static_cast<MinPulseWidthSlackVisitor*>(visitor);
+  MinPulseWidthCheck *check = slack_visitor->minSlackCheck();
+  if (check) {
+    MinPulseWidthSlackLess slack_less(sta_);
+    if (min_slack_check_ == nullptr
+        || slack_less(check, min_slack_check_)) {
+      delete min_slack_check_;
+      min_slack_check_ = check;
+    }
+    else
+      delete check;
+  }
+}
+
 MinPulseWidthCheck *
 MinPulseWidthSlackVisitor::minSlackCheck()
 {
-  return min_slack_check_;
+  MinPulseWidthCheck *check = min_slack_check_;
+  min_slack_check_ = nullptr;
+  return check;
 }
 
 MinPulseWidthCheck *
 CheckMinPulseWidths::minSlackCheck(const Corner *corner)
 {
   clear();
-  MinPulseWidthSlackVisitor visitor(corner);
+  MinPulseWidthSlackVisitor visitor(corner, sta_);
   visitMinPulseWidthChecks(&visitor);
   MinPulseWidthCheck *check = visitor.minSlackCheck();
   // Save check for cleanup.
@@ -239,14 +301,21 @@ visitMinPulseWidthChecks(MinPulseWidthCheckVisitor *visitor)
   Graph *graph = sta_->graph();
   Debug *debug = sta_->debug();
   Network *sdc_network = sta_->network();
+  VertexSeq clk_ends;
   VertexIterator vertex_iter(graph);
   while (vertex_iter.hasNext()) {
     Vertex *vertex = vertex_iter.next();
     if (isClkEnd(vertex, graph)) {
       debugPrint(debug, "mpw", 1, "check mpw %s", vertex->name(sdc_network));
-      visitMinPulseWidthChecks(vertex, visitor);
+      clk_ends.push_back(vertex);
     }
   }
+  visitChecksParallel(clk_ends, visitor,
+                      [this] (Vertex *vertex,
+                              MinPulseWidthCheckVisitor *visitor1) {
+                        visitMinPulseWidthChecks(vertex, visitor1);
+                      },
+                      sta_);
 }
 
 void
@@ -337,7 +406,7 @@ MinPulseWidthCheck::closePath(const StaState *sta,
 		open_tag->inputDelay(),
 		open_tag->isSegmentStart(),
 		open_tag->states(),
-		false, sta);
+		sta);
   debugPrint(sta->debug(), "mpw", 3, " open  %s",
              open_tag->asString(sta));
   debugPrint(sta->debug(), "mpw", 3, " close %s",
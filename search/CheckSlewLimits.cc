@@ -83,8 +83,27 @@ PinSlewLimitSlackLess::operator()(const Pin *pin1,
 ////////////////////////////////////////////////////////////////
 
 CheckSlewLimits::CheckSlewLimits(const StaState *sta) :
-  sta_(sta)
+  sta_(sta),
+  violators_(sta)
+{
+}
+
+void
+CheckSlewLimits::clear()
+{
+  violators_.clear();
+}
+
+void
+CheckSlewLimits::pinChanged(const Pin *pin)
+{
+  violators_.pinChanged(pin);
+}
+
+void
+CheckSlewLimits::deletePinBefore(const Pin *pin)
 {
+  violators_.deletePinBefore(pin);
 }
 
 void
@@ -338,26 +357,31 @@ CheckSlewLimits::checkSlewLimits(const Net *net,
                                  const MinMax *min_max)
 {
   const Network *network = sta_->network();
+  LimitSlackFunc slack_func = [=] (const Pin *pin,
+                                   int) {
+    return slack(pin, corner, min_max);
+  };
   PinSeq slew_pins;
   float min_slack = MinMax::min()->initValue();
   if (net) {
     NetPinIterator *pin_iter = network->pinIterator(net);
     while (pin_iter->hasNext()) {
       const Pin *pin = pin_iter->next();
-      checkSlewLimits(pin, violators, corner, min_max, slew_pins, min_slack);
+      checkSlewLimits(pin, slack(pin, corner, min_max), violators,
+                      slew_pins, min_slack);
     }
     delete pin_iter;
   }
+  else if (violators
+           // Clock slew limits depend on the clocks in the arrivals.
+           && !sta_->sdc()->haveClkSlewLimits())
+    slew_pins = violators_.violators(corner, min_max, slack_func);
   else {
-    LeafInstanceIterator *inst_iter = network->leafInstanceIterator();
-    while (inst_iter->hasNext()) {
-      const Instance *inst = inst_iter->next();
-      checkSlewLimits(inst, violators,corner, min_max, slew_pins, min_slack);
-    }
-    delete inst_iter;
-    // Check top level ports.
-    checkSlewLimits(network->topInstance(), violators, corner, min_max,
-                    slew_pins, min_slack);
+    PinSeq pins = limitCheckPins(network);
+    std::vector<float> slacks;
+    limitCheckSlacks(pins, slack_func, sta_, slacks);
+    for (size_t i = 0; i < pins.size(); i++)
+      checkSlewLimits(pins[i], slacks[i], violators, slew_pins, min_slack);
   }
   sort(slew_pins, PinSlewLimitSlackLess(corner, min_max, this, sta_));
   // Keep the min slack pin unless all violators or net pins.
@@ -366,36 +390,26 @@ CheckSlewLimits::checkSlewLimits(const Net *net,
   return slew_pins;
 }
 
-void
-CheckSlewLimits::checkSlewLimits(const Instance *inst,
-                                 bool violators,
-                                 const Corner *corner,
-                                 const MinMax *min_max,
-                                 PinSeq &slew_pins,
-                                 float &min_slack)
+float
+CheckSlewLimits::slack(const Pin *pin,
+                       const Corner *corner,
+                       const MinMax *min_max) const
 {
-  const Network *network = sta_->network();
-  InstancePinIterator *pin_iter = network->pinIterator(inst);
-  while (pin_iter->hasNext()) {
-    Pin *pin = pin_iter->next();
-    checkSlewLimits(pin, violators, corner, min_max, slew_pins, min_slack);
-  }
-  delete pin_iter;
+  const Corner *corner1;
+  const RiseFall *rf;
+  Slew slew;
+  float limit, slack;
+  checkSlew(pin, corner, min_max, true, corner1, rf, slew, limit, slack);
+  return slack;
 }
 
 void
 CheckSlewLimits::checkSlewLimits(const Pin *pin,
+                                 float slack,
                                  bool violators,
-                                 const Corner *corner,
-                                 const MinMax *min_max,
                                  PinSeq &slew_pins,
                                  float &min_slack)
 {
-  const Corner *corner1;
-  const RiseFall *rf;
-  Slew slew;
-  float limit, slack;
-  checkSlew(pin, corner, min_max, true, corner1, rf, slew, limit, slack);
   if (!fuzzyInf(slack)) {
     if (violators) {
       if (slack < 0.0)
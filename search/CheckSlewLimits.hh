@@ -22,6 +22,7 @@
 #include "GraphClass.hh"
 #include "Delay.hh"
 #include "SdcClass.hh"
+#include "LimitViolators.hh"
 
 namespace sta {
 
@@ -58,6 +59,10 @@ public:
                  // Return values.
                  float &limit,
                  bool &exists) const;
+  void clear();
+  // Pin slew changed by delay calculation or a netlist edit.
+  void pinChanged(const Pin *pin);
+  void deletePinBefore(const Pin *pin);
 
 protected:
   void checkSlews1(const Pin *pin,
@@ -100,16 +105,12 @@ protected:
 		 // Return values.
 		 float &limit,
 		 bool &limit_exists) const;
-  void checkSlewLimits(const Instance *inst,
-                       bool violators,
-                       const Corner *corner,
-                       const MinMax *min_max,
-                       PinSeq &slew_pins,
-                       float &min_slack);
+  float slack(const Pin *pin,
+              const Corner *corner,
+              const MinMax *min_max) const;
   void checkSlewLimits(const Pin *pin,
+                       float slack,
                        bool violators,
-                       const Corner *corner,
-                       const MinMax *min_max,
                        PinSeq &slew_pins,
                        float &min_slack);
   void clockDomains(const Vertex *vertex,
@@ -117,6 +118,7 @@ protected:
 		    ClockSet &clks) const;
 
   const StaState *sta_;
+  LimitViolators violators_;
 };
 
 } // namespace
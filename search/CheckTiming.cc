@@ -16,6 +16,10 @@
 
 #include "CheckTiming.hh"
 
+#include <algorithm>
+#include <vector>
+
+#include "DispatchQueue.hh"
 #include "Error.hh"
 #include "TimingRole.hh"
 #include "Network.hh"
@@ -37,6 +41,46 @@ namespace sta {
 
 using std::string;
 
+static const size_t check_chunk_size = 4096;
+
+// Call func(from, to, pins) on chunks of [0, count) with the dispatch
+// queue threads. The pins found by each chunk are inserted into pins in
+// chunk order.
+template <class FUNC>
+static void
+checkParallelFor(size_t count,
+                 int thread_count,
+                 DispatchQueue *dispatch_queue,
+                 PinSet &pins,
+                 FUNC func)
+{
+  if (thread_count == 1
+      || dispatch_queue == nullptr
+      || count < check_chunk_size * 2) {
+    PinSeq chunk_pins;
+    func(0, count, chunk_pins);
+    for (const Pin *pin : chunk_pins)
+      pins.insert(pin);
+  }
+  else {
+    size_t chunk_size = std::max(check_chunk_size, count / thread_count + 1);
+    size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+    std::vector<PinSeq> chunk_pins(chunk_count);
+    for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+      size_t from = chunk * chunk_size;
+      size_t to = std::min(from + chunk_size, count);
+      dispatch_queue->dispatch([=, &func, &chunk_pins](int) {
+        func(from, to, chunk_pins[chunk]);
+      });
+    }
+    dispatch_queue->finishTasks();
+    for (PinSeq &pins1 : chunk_pins) {
+      for (const Pin *pin : pins1)
+        pins.insert(pin);
+    }
+  }
+}
+
 CheckTiming::CheckTiming(StaState *sta) :
   StaState(sta)
 {
@@ -157,12 +201,27 @@ CheckTiming::checkRegClks(bool reg_multiple_clks,
 {
   PinSet no_clk_pins(network_);
   PinSet multiple_clk_pins(network_);
-  for (Vertex *vertex : *graph_->regClkVertices()) {
-    const Pin *pin = vertex->pin();
-    ClockSet clks = search_->clocks(vertex);
-    if (reg_no_clks && clks.empty())
+  VertexSeq reg_clk_vertices;
+  for (Vertex *vertex : *graph_->regClkVertices())
+    reg_clk_vertices.push_back(vertex);
+  // Clock counts are 0 for no clocks, 1 and 2 for multiple clocks.
+  std::vector<char> clk_counts(reg_clk_vertices.size());
+  PinSet found_pins(network_);
+  checkParallelFor(reg_clk_vertices.size(), thread_count_, dispatch_queue_,
+                   found_pins,
+                   [&] (size_t from,
+                        size_t to,
+                        PinSeq &) {
+    for (size_t i = from; i < to; i++) {
+      ClockSet clks = search_->clocks(reg_clk_vertices[i]);
+      clk_counts[i] = std::min(clks.size(), size_t(2));
+    }
+  });
+  for (size_t i = 0; i < reg_clk_vertices.size(); i++) {
+    const Pin *pin = reg_clk_vertices[i]->pin();
+    if (reg_no_clks && clk_counts[i] == 0)
       no_clk_pins.insert(pin);
-    if (reg_multiple_clks && clks.size() > 1)
+    if (reg_multiple_clks && clk_counts[i] > 1)
       multiple_clk_pins.insert(pin);
   }
   pushPinErrors("Warning: There %is %d unclocked register/latch pin%s.",
@@ -233,6 +292,8 @@ CheckTiming::checkUnconstrainedEndpoints()
 void
 CheckTiming::checkUnconstraintedOutputs(PinSet &unconstrained_ends)
 {
+  PinSet max_delay_pins(network_);
+  findMaxDelayPins(max_delay_pins);
   Instance *top_inst = network_->topInstance();
   InstancePinIterator *pin_iter = network_->pinIterator(top_inst);
   while (pin_iter->hasNext()) {
@@ -241,7 +302,7 @@ CheckTiming::checkUnconstraintedOutputs(PinSet &unconstrained_ends)
     if (dir->isAnyOutput()
 	&& !((hasClkedDepature(pin)
 	      && hasClkedArrival(graph_->pinLoadVertex(pin)))
-	     || hasMaxDelay(pin)))
+	     || max_delay_pins.hasKey(pin)))
       unconstrained_ends.insert(pin);
   }
   delete pin_iter;
@@ -261,9 +322,9 @@ CheckTiming::hasClkedDepature(Pin *pin)
   return false;
 }
 
-// Check for max delay exception that ends at pin.
-bool
-CheckTiming::hasMaxDelay(Pin *pin)
+// Pins that max delay exceptions end at.
+void
+CheckTiming::findMaxDelayPins(PinSet &pins)
 {
   ExceptionPathSet *exceptions = sdc_->exceptions();
   ExceptionPathSet::Iterator exception_iter(exceptions);
@@ -273,30 +334,42 @@ CheckTiming::hasMaxDelay(Pin *pin)
     if (exception->isPathDelay()
 	&& exception->minMax() == MinMaxAll::max()
 	&& to
-	&& to->hasPins()
-	&& to->pins()->hasKey(pin))
-      return true;
+	&& to->hasPins()) {
+      for (const Pin *pin : *to->pins())
+        pins.insert(pin);
+    }
   }
-  return false;
 }
 
 void
 CheckTiming::checkUnconstrainedSetups(PinSet &unconstrained_ends)
 {
   VertexIterator vertex_iter(graph_);
+  VertexSeq vertices;
   while (vertex_iter.hasNext()) {
     Vertex *vertex = vertex_iter.next();
-    VertexInEdgeIterator edge_iter(vertex, graph_);
-    while (edge_iter.hasNext()) {
-      Edge *edge = edge_iter.next();
-      if (edge->role() == TimingRole::setup()
-	  && (!search_->isClock(edge->from(graph_))
-	       || !hasClkedArrival(edge->to(graph_)))) {
-	unconstrained_ends.insert(vertex->pin());
-	break;
+    if (vertex->hasChecks())
+      vertices.push_back(vertex);
+  }
+  checkParallelFor(vertices.size(), thread_count_, dispatch_queue_,
+                   unconstrained_ends,
+                   [&] (size_t from,
+                        size_t to,
+                        PinSeq &pins) {
+    for (size_t i = from; i < to; i++) {
+      Vertex *vertex = vertices[i];
+      VertexInEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        if (edge->role() == TimingRole::setup()
+            && (!search_->isClock(edge->from(graph_))
+                || !hasClkedArrival(edge->to(graph_)))) {
+          pins.push_back(vertex->pin());
+          break;
+        }
       }
     }
-  }
+  });
 }
 
 bool
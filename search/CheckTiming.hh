@@ -56,7 +56,7 @@ protected:
   void checkLoops();
   bool hasClkedDepature(Pin *pin);
   bool hasClkedCheck(Vertex *vertex);
-  bool hasMaxDelay(Pin *pin);
+  void findMaxDelayPins(PinSet &pins);
   void checkGeneratedClocks();
   void pushPinErrors(const char *msg,
 		     PinSet &pins);
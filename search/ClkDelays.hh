@@ -53,6 +53,8 @@ public:
                   StaState *sta);
 
 private:
+  friend class ClkLatencyIndex;
+
   static float insertionDelay(PathVertex *clk_path,
                               StaState *sta);
   static float delay(PathVertex *clk_path,
@@ -19,6 +19,7 @@
 #include "Transition.hh"
 #include "SearchClass.hh"
 #include "PathVertexRep.hh"
+#include "ObjectPool.hh"
 
 namespace sta {
 
@@ -40,6 +41,9 @@ public:
 	  PathVertexRep &crpr_clk_path,
 	  const StaState *sta);
   ~ClkInfo();
+  static void *operator new(size_t size) { return objectPoolAlloc(size); }
+  static void operator delete(void *clk_info,
+                              size_t size) { objectPoolFree(clk_info, size); }
   const char *asString(const StaState *sta) const;
   const ClockEdge *clkEdge() const { return clk_edge_; }
   const Clock *clock() const;
@@ -133,6 +133,52 @@ ClkLatency::reportClkLatency(const Clock *clk,
   }
 }
 
+void
+ClkLatency::reportClkLatencyHistogram(ConstClockSeq clks,
+                                      const Corner *corner,
+                                      bool include_internal_latency,
+                                      int bucket_count,
+                                      int digits)
+{
+  Unit *time_unit = units_->timeUnit();
+  ClkLatencyIndex *latency_index = search_->clkLatencyIndex();
+  ConstClockSeq sorted_clks;
+  for (const Clock *clk : clks)
+    sorted_clks.push_back(clk);
+  std::sort(sorted_clks.begin(), sorted_clks.end(), ClkNameLess());
+
+  for (const Clock *clk : sorted_clks) {
+    report_->reportLine("Clock %s", clk->name());
+    for (const MinMax *min_max : MinMax::range()) {
+      ClkLatencyStats stats = latency_index->latencyStats(clk, corner, min_max,
+                                                          include_internal_latency,
+                                                          bucket_count);
+      if (stats.sink_count_ > 0) {
+        report_->reportLine("%s latency %zu sinks",
+                            min_max->asString(),
+                            stats.sink_count_);
+        report_->reportLine("%7s min %7s mean %7s max %7s skew",
+                            time_unit->asString(stats.min_latency_, digits),
+                            time_unit->asString(stats.mean_latency_, digits),
+                            time_unit->asString(stats.max_latency_, digits),
+                            time_unit->asString(stats.max_latency_
+                                                - stats.min_latency_, digits));
+        float bucket_width = (stats.max_latency_ - stats.min_latency_)
+          / stats.buckets_.size();
+        for (size_t i = 0; i < stats.buckets_.size(); i++) {
+          float bucket_min = stats.min_latency_ + i * bucket_width;
+          report_->reportLine("%7s %10zu",
+                              time_unit->asString(bucket_min, digits),
+                              stats.buckets_[i]);
+        }
+      }
+      else
+        report_->reportLine("%s latency no sinks", min_max->asString());
+    }
+    report_->reportBlankLine();
+  }
+}
+
 ClkDelayMap
 ClkLatency::findClkDelays(ConstClockSeq clks,
                           const Corner *corner,
@@ -174,6 +220,208 @@ ClkLatency::findClkDelays(ConstClockSeq clks,
 
 ////////////////////////////////////////////////////////////////
 
+ClkLatencyStats::ClkLatencyStats() :
+  sink_count_(0),
+  min_latency_(0.0),
+  max_latency_(0.0),
+  mean_latency_(0.0)
+{
+}
+
+ClkLatencyIndex::SinkLatency::SinkLatency(const Clock *clk,
+                                          const Corner *corner) :
+  clk_(clk),
+  corner_(corner)
+{
+  for (auto mm_index : MinMax::rangeIndex()) {
+    latency_[0][mm_index] = 0.0;
+    latency_[1][mm_index] = 0.0;
+    exists_[mm_index] = false;
+  }
+}
+
+ClkLatencyIndex::ClkLatencyIndex(StaState *sta) :
+  StaState(sta),
+  valid_(false)
+{
+}
+
+void
+ClkLatencyIndex::clear()
+{
+  valid_ = false;
+  sink_latencies_.clear();
+  invalid_sinks_.clear();
+}
+
+void
+ClkLatencyIndex::sinkInvalid(Vertex *sink)
+{
+  if (valid_)
+    invalid_sinks_.insert(graph_->id(sink));
+}
+
+void
+ClkLatencyIndex::deleteVertexBefore(Vertex *vertex)
+{
+  VertexId vertex_id = graph_->id(vertex);
+  invalid_sinks_.erase(vertex_id);
+  sink_latencies_.erase(vertex_id);
+}
+
+void
+ClkLatencyIndex::ensureLatencies()
+{
+  if (!valid_) {
+    sink_latencies_.clear();
+    for (Vertex *sink : *graph_->regClkVertices())
+      findSinkLatencies(sink, sink_latencies_[graph_->id(sink)]);
+    invalid_sinks_.clear();
+    valid_ = true;
+  }
+  else if (!invalid_sinks_.empty()) {
+    debugPrint(debug_, "clk_latency", 1, "update %zu sinks",
+               invalid_sinks_.size());
+    invalid_sinks_.visit([this] (ObjectId vertex_id) {
+      Vertex *sink = graph_->vertex(vertex_id);
+      if (sink->isRegClk())
+        findSinkLatencies(sink, sink_latencies_[vertex_id]);
+      else
+        sink_latencies_.erase(vertex_id);
+    });
+    invalid_sinks_.clear();
+  }
+}
+
+// Same latencies as ClkLatency::findClkDelays, worst of the
+// clock and sink transitions.
+void
+ClkLatencyIndex::findSinkLatencies(Vertex *sink,
+                                   SinkLatencySeq &latencies)
+{
+  latencies.clear();
+  VertexPathIterator path_iter(sink, this);
+  while (path_iter.hasNext()) {
+    PathVertex *path = path_iter.next();
+    const ClockEdge *path_clk_edge = path->clkEdge(this);
+    if (path_clk_edge) {
+      const Clock *clk = path_clk_edge->clock();
+      const Corner *corner = path->pathAnalysisPt(this)->corner();
+      SinkLatency *sink_latency = nullptr;
+      for (SinkLatency &latency : latencies) {
+        if (latency.clk_ == clk
+            && latency.corner_ == corner) {
+          sink_latency = &latency;
+          break;
+        }
+      }
+      if (sink_latency == nullptr) {
+        latencies.push_back(SinkLatency(clk, corner));
+        sink_latency = &latencies.back();
+      }
+      const MinMax *min_max = path->minMax(this);
+      int mm_index = min_max->index();
+      float latency = ClkDelays::insertionDelay(path, this)
+        + ClkDelays::delay(path, this);
+      float internal_latency = latency + ClkDelays::clkTreeDelay(path, this);
+      if (!sink_latency->exists_[mm_index]) {
+        sink_latency->latency_[0][mm_index] = latency;
+        sink_latency->latency_[1][mm_index] = internal_latency;
+        sink_latency->exists_[mm_index] = true;
+      }
+      else {
+        float &latency0 = sink_latency->latency_[0][mm_index];
+        if (min_max->compare(latency, latency0))
+          latency0 = latency;
+        float &latency1 = sink_latency->latency_[1][mm_index];
+        if (min_max->compare(internal_latency, latency1))
+          latency1 = internal_latency;
+      }
+    }
+  }
+}
+
+void
+ClkLatencyIndex::sinkLatency(Vertex *sink,
+                             const Clock *clk,
+                             const Corner *corner,
+                             const MinMax *min_max,
+                             bool include_internal_latency,
+                             // Return values.
+                             float &latency,
+                             bool &exists)
+{
+  ensureLatencies();
+  latency = 0.0;
+  exists = false;
+  auto latencies_itr = sink_latencies_.find(graph_->id(sink));
+  if (latencies_itr != sink_latencies_.end()) {
+    int mm_index = min_max->index();
+    for (SinkLatency &sink_latency : latencies_itr->second) {
+      if (sink_latency.clk_ == clk
+          && (corner == nullptr
+              || sink_latency.corner_ == corner)
+          && sink_latency.exists_[mm_index]) {
+        float latency1 = sink_latency.latency_[include_internal_latency][mm_index];
+        if (!exists
+            || min_max->compare(latency1, latency))
+          latency = latency1;
+        exists = true;
+      }
+    }
+  }
+}
+
+ClkLatencyStats
+ClkLatencyIndex::latencyStats(const Clock *clk,
+                              const Corner *corner,
+                              const MinMax *min_max,
+                              bool include_internal_latency,
+                              int bucket_count)
+{
+  ensureLatencies();
+  FloatSeq latencies;
+  for (auto &vertex_latencies : sink_latencies_) {
+    Vertex *sink = graph_->vertex(vertex_latencies.first);
+    float latency;
+    bool exists;
+    sinkLatency(sink, clk, corner, min_max, include_internal_latency,
+                latency, exists);
+    if (exists)
+      latencies.push_back(latency);
+  }
+
+  ClkLatencyStats stats;
+  stats.sink_count_ = latencies.size();
+  if (!latencies.empty()) {
+    double sum = 0.0;
+    stats.min_latency_ = latencies[0];
+    stats.max_latency_ = latencies[0];
+    for (float latency : latencies) {
+      stats.min_latency_ = std::min(stats.min_latency_, latency);
+      stats.max_latency_ = std::max(stats.max_latency_, latency);
+      sum += latency;
+    }
+    stats.mean_latency_ = sum / latencies.size();
+    if (bucket_count > 0) {
+      stats.buckets_.resize(bucket_count, 0);
+      float bucket_width = (stats.max_latency_ - stats.min_latency_)
+        / bucket_count;
+      for (float latency : latencies) {
+        int bucket = 0;
+        if (bucket_width > 0.0)
+          bucket = std::min(static_cast<int>((latency - stats.min_latency_)
+                                             / bucket_width),
+                            bucket_count - 1);
+        stats.buckets_[bucket]++;
+      }
+    }
+  }
+  return stats;
+}
+
+////////////////////////////////////////////////////////////////
+
 ClkDelays::ClkDelays()
 {
   for (auto src_rf_index : RiseFall::rangeIndex()) {
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "SdcClass.hh"
 #include "StaState.hh"
@@ -24,6 +26,7 @@
 #include "SearchClass.hh"
 #include "PathVertex.hh"
 #include "ClkDelays.hh"
+#include "ConcurrentIdSet.hh"
 
 namespace sta {
 
@@ -42,6 +45,12 @@ public:
   ClkDelays findClkDelays(const Clock *clk,
                           const Corner *corner,
                           bool include_internal_latency);
+  // Report sink latency histograms from the search ClkLatencyIndex.
+  void reportClkLatencyHistogram(ConstClockSeq clks,
+                                 const Corner *corner,
+                                 bool include_internal_latency,
+                                 int bucket_count,
+                                 int digits);
   
 protected:
   ClkDelayMap findClkDelays(ConstClockSeq clks,
@@ -51,5 +60,70 @@ protected:
                         ClkDelays &clk_delays,
                         int digits);
 };
+
+class ClkLatencyStats
+{
+public:
+  ClkLatencyStats();
+
+  size_t sink_count_;
+  float min_latency_;
+  float max_latency_;
+  float mean_latency_;
+  // Sink counts in equal width buckets from min_latency_ to max_latency_.
+  std::vector<size_t> buckets_;
+};
+
+// Min/max latencies of the register clock pins (sinks) by clock and
+// corner that are kept between queries. Sinks with clock arrivals that
+// change are updated by the next query.
+class ClkLatencyIndex : public StaState
+{
+public:
+  ClkLatencyIndex(StaState *sta);
+  // Forget all latencies.
+  void clear();
+  // Thread safe.
+  void sinkInvalid(Vertex *sink);
+  void deleteVertexBefore(Vertex *vertex);
+  // Queries require clock arrivals.
+  // Use corner nullptr for all corners.
+  ClkLatencyStats latencyStats(const Clock *clk,
+                               const Corner *corner,
+                               const MinMax *min_max,
+                               bool include_internal_latency,
+                               int bucket_count);
+  void sinkLatency(Vertex *sink,
+                   const Clock *clk,
+                   const Corner *corner,
+                   const MinMax *min_max,
+                   bool include_internal_latency,
+                   // Return values.
+                   float &latency,
+                   bool &exists);
+
+private:
+  class SinkLatency
+  {
+  public:
+    SinkLatency(const Clock *clk,
+                const Corner *corner);
+
+    const Clock *clk_;
+    const Corner *corner_;
+    // Indexed by include_internal_latency, min_max.
+    float latency_[2][MinMax::index_count];
+    bool exists_[MinMax::index_count];
+  };
+  typedef std::vector<SinkLatency> SinkLatencySeq;
+
+  void ensureLatencies();
+  void findSinkLatencies(Vertex *sink,
+                         SinkLatencySeq &latencies);
+
+  bool valid_;
+  ConcurrentIdSet invalid_sinks_;
+  std::unordered_map<VertexId, SinkLatencySeq> sink_latencies_;
+};
     
 } // namespace
@@ -30,11 +30,16 @@ ClkNetwork::ClkNetwork(StaState *sta) :
   StaState(sta),
   clk_pins_valid_(false)
 {
+  // Empty clock set.
+  clk_set_bits_.push_back(ClkBits());
+  clk_sets_.push_back(nullptr);
 }
 
 ClkNetwork::~ClkNetwork()
 {
   clk_pins_map_.deleteContentsClear();
+  for (ClockSet *clks : clk_sets_)
+    delete clks;
 }
 
 void
@@ -48,9 +53,15 @@ void
 ClkNetwork::clear()
 {
   clk_pins_valid_ = false;
-  pin_clks_map_.clear();
+  pin_clk_sets_.clear();
+  pin_ideal_clk_sets_.clear();
   clk_pins_map_.deleteContentsClear();
-  pin_ideal_clks_map_.clear();
+  for (ClockSet *clks : clk_sets_)
+    delete clks;
+  clk_sets_.resize(1);
+  clk_set_bits_.resize(1);
+  clk_bits_set_ids_.clear();
+  clk_set_adds_.clear();
 }
 
 void
@@ -74,12 +85,6 @@ ClkNetwork::disconnectPinBefore(const Pin *pin)
     clkPinsInvalid();
 }
 
-void
-ClkNetwork::connectPinAfter(const Pin *pin)
-{
-  if (isClock(pin))
-    clkPinsInvalid();
-}
 
 class ClkSearchPred : public ClkTreeSearchPred
 {
@@ -100,19 +105,107 @@ ClkSearchPred::searchTo(const Vertex *to)
   return !sdc->isLeafPinClock(to->pin());
 }
 
+// Clock sets only grow when a pin is connected, so the clocks of the
+// pin fanin are added to the pin and its fanout incrementally instead
+// of finding the clock network again.
+void
+ClkNetwork::connectPinAfter(const Pin *pin)
+{
+  if (clk_pins_valid_) {
+    ClkSearchPred pred(this);
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    if (vertex)
+      findFaninClks(vertex, &pred);
+    if (bidirect_drvr_vertex)
+      findFaninClks(bidirect_drvr_vertex, &pred);
+  }
+}
+
+void
+ClkNetwork::findFaninClks(Vertex *vertex,
+                          SearchPred *pred)
+{
+  VertexSeq queue;
+  queue.push_back(vertex);
+  while (!queue.empty()) {
+    Vertex *to_vertex = queue.back();
+    queue.pop_back();
+    const Pin *to_pin = to_vertex->pin();
+    ClkSetId clks = pinClkSet(pin_clk_sets_, to_pin);
+    ClkSetId ideal_clks = pinClkSet(pin_ideal_clk_sets_, to_pin);
+    ClkSetId clks1 = clks;
+    ClkSetId ideal_clks1 = ideal_clks;
+    if (pred->searchTo(to_vertex)) {
+      bool propagated = sdc_->isPropagatedClock(to_pin);
+      VertexInEdgeIterator edge_iter(to_vertex, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        Vertex *from_vertex = edge->from(graph_);
+        if (pred->searchFrom(from_vertex)
+            && pred->searchThru(edge)) {
+          const Pin *from_pin = from_vertex->pin();
+          clks1 = unionClkSets(clks1, pinClkSet(pin_clk_sets_, from_pin));
+          if (!propagated)
+            ideal_clks1 = unionClkSets(ideal_clks1,
+                                       pinClkSet(pin_ideal_clk_sets_,
+                                                 from_pin));
+        }
+      }
+    }
+    bool changed = (clks1 != clks || ideal_clks1 != ideal_clks);
+    if (changed) {
+      setPinClkSet(pin_clk_sets_, to_pin, clks1);
+      setPinClkSet(pin_ideal_clk_sets_, to_pin, ideal_clks1);
+      addPinClks(to_pin, clks1);
+    }
+    if (changed
+        || (to_vertex == vertex
+            && clks1 != 0)) {
+      if (pred->searchFrom(to_vertex)) {
+        VertexOutEdgeIterator edge_iter(to_vertex, graph_);
+        while (edge_iter.hasNext()) {
+          Edge *edge = edge_iter.next();
+          Vertex *fanout = edge->to(graph_);
+          if (pred->searchThru(edge)
+              && pred->searchTo(fanout))
+            queue.push_back(fanout);
+        }
+      }
+    }
+  }
+}
+
+void
+ClkNetwork::addPinClks(const Pin *pin,
+                       ClkSetId clk_set)
+{
+  const ClockSet *clks = clk_sets_[clk_set];
+  if (clks) {
+    for (Clock *clk : *clks) {
+      PinSet *clk_pins = clk_pins_map_.findKey(clk);
+      if (clk_pins == nullptr) {
+        clk_pins = new PinSet(network_);
+        clk_pins_map_[clk] = clk_pins;
+      }
+      clk_pins->insert(pin);
+    }
+  }
+}
+
 void
 ClkNetwork::findClkPins()
 {
   debugPrint(debug_, "clk_network", 1, "find clk network");
   clear();
-  findClkPins(false, pin_clks_map_);
-  findClkPins(true, pin_ideal_clks_map_);
+  findClkPins(false, pin_clk_sets_);
+  findClkPins(true, pin_ideal_clk_sets_);
   clk_pins_valid_ = true;
 }
 
 void
 ClkNetwork::findClkPins(bool ideal_only,
-			PinClksMap &pin_clks_map)
+			ClkSetIdSeq &pin_clk_sets)
 {
   ClkSearchPred srch_pred(this);
   BfsFwdIterator bfs(BfsIndex::other, &srch_pred, this);
@@ -140,8 +233,8 @@ ClkNetwork::findClkPins(bool ideal_only,
 	if (!ideal_only
 	    || !sdc_->isPropagatedClock(pin)) {
 	  clk_pins->insert(pin);
-	  ClockSet &pin_clks = pin_clks_map[pin];
-          pin_clks.insert(clk);
+          ClkSetId pin_clks = pinClkSet(pin_clk_sets, pin);
+          setPinClkSet(pin_clk_sets, pin, addClk(pin_clks, clk));
 	  bfs.enqueueAdjacentVertices(vertex);
 	}
       }
@@ -149,11 +242,97 @@ ClkNetwork::findClkPins(bool ideal_only,
   }
 }
 
+ClkSetId
+ClkNetwork::pinClkSet(const ClkSetIdSeq &pin_clk_sets,
+                      const Pin *pin) const
+{
+  VertexId vertex_id = network_->vertexId(pin);
+  if (vertex_id < pin_clk_sets.size())
+    return pin_clk_sets[vertex_id];
+  else
+    return 0;
+}
+
+void
+ClkNetwork::setPinClkSet(ClkSetIdSeq &pin_clk_sets,
+                         const Pin *pin,
+                         ClkSetId clk_set)
+{
+  VertexId vertex_id = network_->vertexId(pin);
+  if (vertex_id >= pin_clk_sets.size()) {
+    if (clk_set == 0)
+      return;
+    pin_clk_sets.resize(vertex_id + 1, 0);
+  }
+  pin_clk_sets[vertex_id] = clk_set;
+}
+
+ClkSetId
+ClkNetwork::addClk(ClkSetId clk_set,
+                   const Clock *clk)
+{
+  // Pins in the clock network of a clock mostly have the same clocks,
+  // so the set with the clock added is remembered.
+  std::pair<ClkSetId, int> add(clk_set, clk->index());
+  auto add_itr = clk_set_adds_.find(add);
+  if (add_itr != clk_set_adds_.end())
+    return add_itr->second;
+  ClkBits bits = clk_set_bits_[clk_set];
+  size_t word = clk->index() / 64;
+  if (word >= bits.size())
+    bits.resize(word + 1, 0);
+  bits[word] |= uint64_t(1) << (clk->index() % 64);
+  ClkSetId clk_set1 = findClkSet(bits);
+  clk_set_adds_[add] = clk_set1;
+  return clk_set1;
+}
+
+ClkSetId
+ClkNetwork::unionClkSets(ClkSetId clk_set1,
+                         ClkSetId clk_set2)
+{
+  if (clk_set1 == clk_set2 || clk_set2 == 0)
+    return clk_set1;
+  else if (clk_set1 == 0)
+    return clk_set2;
+  else {
+    ClkBits bits = clk_set_bits_[clk_set1];
+    const ClkBits &bits2 = clk_set_bits_[clk_set2];
+    if (bits2.size() > bits.size())
+      bits.resize(bits2.size(), 0);
+    for (size_t i = 0; i < bits2.size(); i++)
+      bits[i] |= bits2[i];
+    return findClkSet(bits);
+  }
+}
+
+ClkSetId
+ClkNetwork::findClkSet(const ClkBits &bits)
+{
+  auto set_itr = clk_bits_set_ids_.find(bits);
+  if (set_itr != clk_bits_set_ids_.end())
+    return set_itr->second;
+  ClkSetId clk_set = clk_sets_.size();
+  ClockSet *clks = new ClockSet;
+  for (Clock *clk : sdc_->clks()) {
+    size_t word = clk->index() / 64;
+    if (word < bits.size()
+        && (bits[word] & (uint64_t(1) << (clk->index() % 64))))
+      clks->insert(clk);
+  }
+  clk_set_bits_.push_back(bits);
+  clk_sets_.push_back(clks);
+  clk_bits_set_ids_[bits] = clk_set;
+  debugPrint(debug_, "clk_network", 2, "clk set %u %zu clks",
+             clk_set, clks->size());
+  return clk_set;
+}
+
 bool
 ClkNetwork::isClock(const Pin *pin) const
 {
   return network_->isRegClkPin(pin)
-    || pin_clks_map_.hasKey(pin);
+    || pinClkSet(pin_clk_sets_, pin) != 0;
 }
 
 bool
@@ -175,32 +354,26 @@ ClkNetwork::isClock(const Net *net) const
 bool
 ClkNetwork::isIdealClock(const Pin *pin) const
 {
-  return pin_ideal_clks_map_.hasKey(pin);
+  return pinClkSet(pin_ideal_clk_sets_, pin) != 0;
 }
 
 bool
 ClkNetwork::isPropagatedClock(const Pin *pin) const
 {
-  return pin_clks_map_.hasKey(pin)
-    && !pin_ideal_clks_map_.hasKey(pin);
+  return pinClkSet(pin_clk_sets_, pin) != 0
+    && pinClkSet(pin_ideal_clk_sets_, pin) == 0;
 }
 
 const ClockSet *
 ClkNetwork::clocks(const Pin *pin)
 {
-  if (pin_clks_map_.hasKey(pin))
-    return &pin_clks_map_[pin];
-  else
-    return nullptr;
+  return clk_sets_[pinClkSet(pin_clk_sets_, pin)];
 }
 
 const ClockSet *
 ClkNetwork::idealClocks(const Pin *pin)
 {
-  if (pin_ideal_clks_map_.hasKey(pin))
-    return &pin_ideal_clks_map_[pin];
-  else
-    return nullptr;
+  return clk_sets_[pinClkSet(pin_ideal_clk_sets_, pin)];
 }
 
 const PinSet *
@@ -18,7 +18,9 @@
 
 #include <cmath> // abs
 #include <algorithm>
+#include <vector>
 
+#include "DispatchQueue.hh"
 #include "Report.hh"
 #include "Debug.hh"
 #include "Units.hh"
@@ -279,21 +281,43 @@ ClkSkews::findClkSkew(ConstClockSeq &clks,
   for (const Clock *clk : clks)
     clk_set.insert(clk);
 
-  for (Vertex *src_vertex : *graph_->regClkVertices()) {
-    if (hasClkPaths(src_vertex, clk_set)) {
-      VertexOutEdgeIterator edge_iter(src_vertex, graph_);
-      while (edge_iter.hasNext()) {
-	Edge *edge = edge_iter.next();
-	if (edge->role()->genericRole() == TimingRole::regClkToQ()) {
-	  Vertex *q_vertex = edge->to(graph_);
-	  const RiseFall *rf = edge->timingArcSet()->isRisingFallingEdge();
-	  const RiseFallBoth *src_rf = rf
-	    ? rf->asRiseFallBoth()
-	    : RiseFallBoth::riseFall();
-	  findClkSkewFrom(src_vertex, q_vertex, src_rf, clk_set,
-			  corner, setup_hold, include_internal_latency,
-                          skews);
-	}
+  if (thread_count_ == 1) {
+    for (Vertex *src_vertex : *graph_->regClkVertices()) {
+      if (hasClkPaths(src_vertex, clk_set))
+        findClkSkewFrom(src_vertex, clk_set, corner, setup_hold,
+                        include_internal_latency, skews);
+    }
+  }
+  else {
+    // Each thread finds the worst skews of the source registers it
+    // visits, then the thread skews are merged.
+    std::vector<ClkSkewMap> thread_skews(thread_count_);
+    for (Vertex *src_vertex : *graph_->regClkVertices()) {
+      if (hasClkPaths(src_vertex, clk_set))
+        dispatch_queue_->dispatch( [=, &clk_set, &thread_skews](int i) {
+          findClkSkewFrom(src_vertex, clk_set, corner, setup_hold,
+                          include_internal_latency, thread_skews[i]);
+        });
+    }
+    dispatch_queue_->finishTasks();
+    for (ClkSkewMap &skews1 : thread_skews) {
+      for (auto &clk_skew1 : skews1) {
+        ClkSkew &clk_skew2 = clk_skew1.second;
+        auto skew_itr = skews.find(clk_skew1.first);
+        if (skew_itr == skews.end())
+          skews[clk_skew1.first] = clk_skew2;
+        else {
+          ClkSkew &clk_skew = skew_itr->second;
+          float abs_skew2 = abs(clk_skew2.skew());
+          float abs_skew = abs(clk_skew.skew());
+          // Break ties with the source register order of the
+          // serial search.
+          if (abs_skew2 > abs_skew
+              || (abs_skew2 == abs_skew
+                  && graph_->id(clk_skew2.srcPath()->vertex(this))
+                  < graph_->id(clk_skew.srcPath()->vertex(this))))
+            clk_skew = clk_skew2;
+        }
       }
     }
   }
@@ -314,6 +338,30 @@ ClkSkews::hasClkPaths(Vertex *vertex,
   return false;
 }
 
+void
+ClkSkews::findClkSkewFrom(Vertex *src_vertex,
+                          ConstClockSet &clk_set,
+                          const Corner *corner,
+                          const SetupHold *setup_hold,
+                          bool include_internal_latency,
+                          ClkSkewMap &skews)
+{
+  VertexOutEdgeIterator edge_iter(src_vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *edge = edge_iter.next();
+    if (edge->role()->genericRole() == TimingRole::regClkToQ()) {
+      Vertex *q_vertex = edge->to(graph_);
+      const RiseFall *rf = edge->timingArcSet()->isRisingFallingEdge();
+      const RiseFallBoth *src_rf = rf
+        ? rf->asRiseFallBoth()
+        : RiseFallBoth::riseFall();
+      findClkSkewFrom(src_vertex, q_vertex, src_rf, clk_set,
+                      corner, setup_hold, include_internal_latency,
+                      skews);
+    }
+  }
+}
+
 void
 ClkSkews::findClkSkewFrom(Vertex *src_vertex,
 			  Vertex *q_vertex,
@@ -425,23 +473,40 @@ FanOutSrchPred::searchThru(Edge *edge)
         || role == TimingRole::tristateDisable());
 }
 
+// The fanout search does not use a BfsIterator so that the fanout of
+// different registers can be found by multiple threads.
 VertexSet
 ClkSkews::findFanout(Vertex *from)
 {
   debugPrint(debug_, "fanout", 1, "%s",
              from->name(sdc_network_));
   VertexSet endpoints(graph_);
+  VertexSet visited(graph_);
+  VertexSeq queue;
   FanOutSrchPred pred(this);
-  BfsFwdIterator fanout_iter(BfsIndex::other, &pred, this);
-  fanout_iter.enqueue(from);
-  while (fanout_iter.hasNext()) {
-    Vertex *fanout = fanout_iter.next();
+  visited.insert(from);
+  queue.push_back(from);
+  while (!queue.empty()) {
+    Vertex *fanout = queue.back();
+    queue.pop_back();
     if (fanout->hasChecks()) {
       debugPrint(debug_, "fanout", 1, " endpoint %s",
                  fanout->name(sdc_network_));
       endpoints.insert(fanout);
     }
-    fanout_iter.enqueueAdjacentVertices(fanout);
+    if (pred.searchFrom(fanout)) {
+      VertexOutEdgeIterator edge_iter(fanout, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        Vertex *to_vertex = edge->to(graph_);
+        if (pred.searchThru(edge)
+            && pred.searchTo(to_vertex)
+            && !visited.hasKey(to_vertex)) {
+          visited.insert(to_vertex);
+          queue.push_back(to_vertex);
+        }
+      }
+    }
   }
   return endpoints;
 }
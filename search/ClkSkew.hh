@@ -53,6 +53,12 @@ protected:
                          bool include_internal_latency);
   bool hasClkPaths(Vertex *vertex,
 		   ConstClockSet &clks);
+  void findClkSkewFrom(Vertex *src_vertex,
+                       ConstClockSet &clk_set,
+                       const Corner *corner,
+                       const SetupHold *setup_hold,
+                       bool include_internal_latency,
+                       ClkSkewMap &skews);
   void findClkSkewFrom(Vertex *src_vertex,
 		       Vertex *q_vertex,
 		       const RiseFallBoth *src_rf,
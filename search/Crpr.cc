@@ -20,6 +20,8 @@
 #include <stdio.h>
 
 #include "Debug.hh"
+#include "Hash.hh"
+#include "Mutex.hh"
 #include "Vector.hh"
 #include "Network.hh"
 #include "Graph.hh"
@@ -42,10 +44,17 @@ using std::min;
 using std::abs;
 
 CheckCrpr::CheckCrpr(StaState *sta) :
-  StaState(sta)
+  StaState(sta),
+  cache_epoch_(0)
 {
 }
 
+void
+CheckCrpr::clearCache()
+{
+  cache_epoch_++;
+}
+
 PathVertex *
 CheckCrpr::clkPathPrev(const PathVertex *path,
 		       PathVertex &tmp)
@@ -212,6 +221,40 @@ CheckCrpr::findCrpr(const PathVertex *src_clk_path,
 		    // Return values.
 		    Crpr &crpr,
 		    Pin *&crpr_pin)
+{
+  CrprKey key{src_clk_path->vertexId(this), src_clk_path->tagIndex(this),
+	      tgt_clk_path->vertexId(this), tgt_clk_path->tagIndex(this),
+	      same_pin};
+  CrprCacheShard &shard = cache_[CrprKeyHash()(key) % cache_shard_count_];
+  unsigned epoch = cache_epoch_;
+  {
+    UniqueLock lock(shard.lock_);
+    if (shard.epoch_ == epoch) {
+      auto itr = shard.results_.find(key);
+      if (itr != shard.results_.end()) {
+	crpr = itr->second.crpr_;
+	crpr_pin = itr->second.crpr_pin_;
+	return;
+      }
+    }
+  }
+  findCommonCrpr(src_clk_path, tgt_clk_path, same_pin, crpr, crpr_pin);
+  UniqueLock lock(shard.lock_);
+  if (shard.epoch_ != epoch
+      || shard.results_.size() >= cache_shard_size_max_) {
+    shard.results_.clear();
+    shard.epoch_ = epoch;
+  }
+  shard.results_[key] = CrprResult{crpr, crpr_pin};
+}
+
+void
+CheckCrpr::findCommonCrpr(const PathVertex *src_clk_path,
+			  const PathVertex *tgt_clk_path,
+			  bool same_pin,
+			  // Return values.
+			  Crpr &crpr,
+			  Pin *&crpr_pin)
 {
   crpr = 0.0;
   crpr_pin = nullptr;
@@ -390,6 +433,38 @@ CheckCrpr::outputDelayCrpr1(const Path *src_path,
   }
 }
 
+////////////////////////////////////////////////////////////////
+
+CrprCacheShard::CrprCacheShard() :
+  epoch_(0)
+{
+}
+
+size_t
+CrprKeyHash::operator()(const CrprKey &key) const
+{
+  size_t hash = hash_init_value;
+  hashIncr(hash, key.src_vertex_id_);
+  hashIncr(hash, key.src_tag_index_);
+  hashIncr(hash, key.tgt_vertex_id_);
+  hashIncr(hash, key.tgt_tag_index_);
+  hashIncr(hash, key.same_pin_);
+  return hash;
+}
+
+bool
+CrprKeyEqual::operator()(const CrprKey &key1,
+			 const CrprKey &key2) const
+{
+  return key1.src_vertex_id_ == key2.src_vertex_id_
+    && key1.src_tag_index_ == key2.src_tag_index_
+    && key1.tgt_vertex_id_ == key2.tgt_vertex_id_
+    && key1.tgt_tag_index_ == key2.tgt_tag_index_
+    && key1.same_pin_ == key2.same_pin_;
+}
+
+////////////////////////////////////////////////////////////////
+
 bool
 CheckCrpr::crprPossible(const Clock *clk1,
 			const Clock *clk2)
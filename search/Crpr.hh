@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
+#include "UnorderedMap.hh"
 #include "SdcClass.hh"
 #include "StaState.hh"
 #include "SearchClass.hh"
@@ -24,6 +28,50 @@ namespace sta {
 
 class CrprPaths;
 
+// Source/target clock paths (vertex, tag) of a crpr common path search.
+class CrprKey
+{
+public:
+  VertexId src_vertex_id_;
+  TagIndex src_tag_index_;
+  VertexId tgt_vertex_id_;
+  TagIndex tgt_tag_index_;
+  bool same_pin_;
+};
+
+class CrprKeyHash
+{
+public:
+  size_t operator()(const CrprKey &key) const;
+};
+
+class CrprKeyEqual
+{
+public:
+  bool operator()(const CrprKey &key1,
+		  const CrprKey &key2) const;
+};
+
+class CrprResult
+{
+public:
+  Crpr crpr_;
+  Pin *crpr_pin_;
+};
+
+typedef UnorderedMap<CrprKey, CrprResult, CrprKeyHash, CrprKeyEqual> CrprMap;
+
+class CrprCacheShard
+{
+public:
+  CrprCacheShard();
+
+  std::mutex lock_;
+  CrprMap results_;
+  // CheckCrpr::cache_epoch_ of results_.
+  unsigned epoch_;
+};
+
 // Clock Reconvergence Pessimism Removal.
 class CheckCrpr : public StaState
 {
@@ -54,6 +102,8 @@ public:
   // For Search::reportArrivals.
   PathVertex clkPathPrev(Vertex *vertex,
 			 int arrival_index);
+  // Forget the crpr of clock paths found before clock arrivals changed.
+  void clearCache();
 
 private:
   PathVertex *clkPathPrev(const PathVertex *path,
@@ -82,6 +132,12 @@ private:
 		// Return values.
 		Crpr &crpr,
 		Pin *&common_pin);
+  void findCommonCrpr(const PathVertex *src_clk_path,
+		      const PathVertex *tgt_clk_path,
+		      bool same_pin,
+		      // Return values.
+		      Crpr &crpr,
+		      Pin *&common_pin);
   void portClkPath(const ClockEdge *clk_edge,
 		   const Pin *clk_src_pin,
 		   const PathAnalysisPt *path_ap,
@@ -90,6 +146,15 @@ private:
   Crpr findCrpr1(const PathVertex *src_clk_path,
 		 const PathVertex *tgt_clk_path);
   float crprArrivalDiff(const PathVertex *path);
+
+  // Crpr of clock path pairs. Every check with the same launch and
+  // capture clock paths (including the paths made by path enumeration)
+  // has the same crpr, so it is only found once. Sharded to keep
+  // threads finding path end slacks from waiting on each other.
+  static constexpr int cache_shard_count_ = 16;
+  static constexpr size_t cache_shard_size_max_ = 1 << 16;
+  CrprCacheShard cache_[cache_shard_count_];
+  std::atomic<unsigned> cache_epoch_;
 };
 
 } // namespace
@@ -0,0 +1,150 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "DerateIndex.hh"
+
+#include <map>
+#include <tuple>
+
+#include "Network.hh"
+#include "Graph.hh"
+#include "DeratingFactors.hh"
+#include "Sdc.hh"
+
+namespace sta {
+
+DerateIndex::DerateIndex(StaState *sta) :
+  StaState(sta),
+  network_valid_(false),
+  built_sdc_(nullptr),
+  built_version_(0)
+{
+}
+
+void
+DerateIndex::clear()
+{
+  network_valid_ = false;
+}
+
+bool
+DerateIndex::isValid() const
+{
+  return network_valid_
+    && built_sdc_ == sdc_
+    && built_version_ == sdc_->deratingFactorsVersion();
+}
+
+void
+DerateIndex::ensure()
+{
+  if (!isValid()) {
+    tables_.clear();
+    vertex_tables_.clear();
+    // Table 0 has the global factors.
+    makeTable(nullptr);
+    if (sdc_->hasLocalDeratingFactors()) {
+      typedef std::tuple<const DeratingFactorsCell*,
+                         const DeratingFactorsCell*,
+                         const DeratingFactorsNet*> FactorsKey;
+      std::map<FactorsKey, uint32_t> key_tables;
+      key_tables[FactorsKey(nullptr, nullptr, nullptr)] = 0;
+      vertex_tables_.resize(graph_->vertexIdBound(), 0);
+      VertexIterator vertex_iter(graph_);
+      while (vertex_iter.hasNext()) {
+        Vertex *vertex = vertex_iter.next();
+        const Pin *pin = vertex->pin();
+        const DeratingFactorsCell *inst_factors, *cell_factors;
+        const DeratingFactorsNet *net_factors;
+        sdc_->pinDeratingFactors(pin, inst_factors, cell_factors, net_factors);
+        FactorsKey key(inst_factors, cell_factors, net_factors);
+        auto itr = key_tables.find(key);
+        uint32_t table_index;
+        if (itr == key_tables.end()) {
+          table_index = tables_.size();
+          makeTable(pin);
+          key_tables[key] = table_index;
+        }
+        else
+          table_index = itr->second;
+        vertex_tables_[graph_->id(vertex)] = table_index;
+      }
+    }
+    network_valid_ = true;
+    built_sdc_ = sdc_;
+    built_version_ = sdc_->deratingFactorsVersion();
+  }
+}
+
+// Resolve the factors with the sdc lookups for pin, or the global
+// factors if pin is null.
+void
+DerateIndex::makeTable(const Pin *pin)
+{
+  tables_.emplace_back();
+  DerateTable &table = tables_.back();
+  const DeratingFactorsGlobal *global_factors = sdc_->deratingFactors();
+  for (int clk_data = 0; clk_data < path_clk_or_data_count; clk_data++) {
+    PathClkOrData clk_data1 = static_cast<PathClkOrData>(clk_data);
+    for (const RiseFall *rf : RiseFall::range()) {
+      int rf_index = rf->index();
+      for (const EarlyLate *early_late : EarlyLate::range()) {
+        int el_index = early_late->index();
+        for (int type = 0; type < timing_derate_cell_type_count; type++) {
+          TimingDerateCellType type1 = static_cast<TimingDerateCellType>(type);
+          float derate = 1.0;
+          if (pin)
+            derate = sdc_->timingDerateInstance(pin, type1, clk_data1,
+                                                rf, early_late);
+          else if (global_factors) {
+            bool exists;
+            global_factors->factor(type1, clk_data1, rf, early_late,
+                                   derate, exists);
+            if (!exists)
+              derate = 1.0;
+          }
+          table.cell_[type][clk_data][rf_index][el_index] = derate;
+        }
+        float derate = 1.0;
+        if (pin)
+          derate = sdc_->timingDerateNet(pin, clk_data1, rf, early_late);
+        else if (global_factors) {
+          bool exists;
+          global_factors->factor(TimingDerateType::net_delay, clk_data1, rf,
+                                 early_late, derate, exists);
+          if (!exists)
+            derate = 1.0;
+        }
+        table.net_[clk_data][rf_index][el_index] = derate;
+      }
+    }
+  }
+}
+
+const DerateTable *
+DerateIndex::table(const Vertex *vertex) const
+{
+  if (isValid()) {
+    if (vertex_tables_.empty())
+      return &tables_[0];
+    VertexId vertex_id = graph_->id(vertex);
+    if (vertex_id < vertex_tables_.size())
+      return &tables_[vertex_tables_[vertex_id]];
+  }
+  return nullptr;
+}
+
+} // namespace
@@ -0,0 +1,84 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MinMax.hh"
+#include "Transition.hh"
+#include "SdcClass.hh"
+#include "GraphClass.hh"
+#include "StaState.hh"
+
+namespace sta {
+
+// Derating factors that apply to the arcs from one pin with the
+// instance, cell, net and global factors resolved.
+class DerateTable
+{
+public:
+  float cellDerate(TimingDerateCellType type,
+                   PathClkOrData clk_data,
+                   const RiseFall *rf,
+                   const EarlyLate *early_late) const
+  {
+    return cell_[int(type)][int(clk_data)][rf->index()][early_late->index()];
+  }
+  float netDerate(PathClkOrData clk_data,
+                  const RiseFall *rf,
+                  const EarlyLate *early_late) const
+  {
+    return net_[int(clk_data)][rf->index()][early_late->index()];
+  }
+
+  float cell_[timing_derate_cell_type_count][path_clk_or_data_count]
+             [RiseFall::index_count][EarlyLate::index_count];
+  float net_[path_clk_or_data_count][RiseFall::index_count]
+            [EarlyLate::index_count];
+};
+
+// Dense index from vertex id to the resolved derating factors of the
+// vertex pin so the search does not look up the instance, cell and net
+// derating maps for every arc. Pins with the same instance, cell and net
+// factors share a table. The index is rebuilt by ensure after the
+// derating factors or the network change.
+class DerateIndex : public StaState
+{
+public:
+  DerateIndex(StaState *sta);
+  // Network changed.
+  void clear();
+  // Not thread safe.
+  void ensure();
+  // Return nullptr if vertex is not in the index.
+  const DerateTable *table(const Vertex *vertex) const;
+
+private:
+  bool isValid() const;
+  void makeTable(const Pin *pin);
+
+  std::vector<DerateTable> tables_;
+  // Indexed by vertex id. Empty if all vertices use tables_[0].
+  std::vector<uint32_t> vertex_tables_;
+  bool network_valid_;
+  // Sdc and derating factors version the index was built with.
+  const Sdc *built_sdc_;
+  int built_version_;
+};
+
+} // namespace
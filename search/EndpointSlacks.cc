@@ -0,0 +1,197 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "EndpointSlacks.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "DispatchQueue.hh"
+#include "Error.hh"
+#include "Network.hh"
+#include "Graph.hh"
+#include "Corner.hh"
+#include "PathAnalysisPt.hh"
+#include "PathEnd.hh"
+#include "PathGroup.hh"
+#include "VisitPathEnds.hh"
+#include "Search.hh"
+
+namespace sta {
+
+// Keep the worst path end of each path analysis point at a vertex.
+class EndpointSlackVisitor : public PathEndVisitor
+{
+public:
+  EndpointSlackVisitor(EndpointSlackSeq &slacks,
+                       const StaState *sta);
+  virtual PathEndVisitor *copy() const;
+  virtual void vertexBegin(Vertex *vertex);
+  virtual void visit(PathEnd *path_end);
+  virtual void vertexEnd(Vertex *vertex);
+
+private:
+  EndpointSlackSeq &slacks_;
+  // Indexed by path analysis point; path_ap_ is null if there is no
+  // path end.
+  EndpointSlackSeq worst_;
+  Vertex *vertex_;
+  const StaState *sta_;
+};
+
+EndpointSlackVisitor::EndpointSlackVisitor(EndpointSlackSeq &slacks,
+                                           const StaState *sta) :
+  slacks_(slacks),
+  worst_(sta->corners()->pathAnalysisPtCount()),
+  vertex_(nullptr),
+  sta_(sta)
+{
+}
+
+PathEndVisitor *
+EndpointSlackVisitor::copy() const
+{
+  return new EndpointSlackVisitor(slacks_, sta_);
+}
+
+void
+EndpointSlackVisitor::vertexBegin(Vertex *vertex)
+{
+  vertex_ = vertex;
+  for (EndpointSlack &worst : worst_)
+    worst.path_ap_ = nullptr;
+}
+
+void
+EndpointSlackVisitor::visit(PathEnd *path_end)
+{
+  if (!path_end->isUnconstrained()) {
+    const PathAnalysisPt *path_ap = path_end->pathAnalysisPt(sta_);
+    EndpointSlack &worst = worst_[path_ap->index()];
+    Slack slack = path_end->slack(sta_);
+    if (worst.path_ap_ == nullptr
+        || delayLess(slack, worst.slack_, sta_)) {
+      worst.vertex_ = vertex_;
+      worst.path_ap_ = path_ap;
+      worst.slack_ = slack;
+      worst.arrival_ = path_end->dataArrivalTimeOffset(sta_);
+      worst.required_ = path_end->requiredTimeOffset(sta_);
+      worst.group_ = PathGroups::pathGroupName(path_end, sta_);
+    }
+  }
+}
+
+void
+EndpointSlackVisitor::vertexEnd(Vertex *)
+{
+  for (const EndpointSlack &worst : worst_) {
+    if (worst.path_ap_)
+      slacks_.push_back(worst);
+  }
+}
+
+void
+findEndpointSlacks(const Corner *corner,
+                   const MinMaxAll *min_max,
+                   const StaState *sta,
+                   // Return value.
+                   EndpointSlackSeq &slacks)
+{
+  const VertexSeq &endpoints = sta->search()->endpointSeq();
+  size_t endpoint_count = endpoints.size();
+  // Contiguous runs of endpoints per task amortize the task overhead.
+  // The runs are appended in endpoint order.
+  size_t chunk_size = 64;
+  size_t chunk_count = (endpoint_count + chunk_size - 1) / chunk_size;
+  std::vector<EndpointSlackSeq> chunk_slacks(chunk_count);
+  auto find_chunk = [=, &endpoints, &chunk_slacks] (size_t chunk) {
+    VisitPathEnds visit_ends(sta);
+    EndpointSlackVisitor visitor(chunk_slacks[chunk], sta);
+    size_t end = std::min((chunk + 1) * chunk_size, endpoint_count);
+    for (size_t i = chunk * chunk_size; i < end; i++)
+      visit_ends.visitPathEnds(endpoints[i], corner, min_max, false, &visitor);
+  };
+  DispatchQueue *dispatch_queue = sta->dispatchQueue();
+  if (sta->threadCount() == 1 || dispatch_queue == nullptr) {
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+      find_chunk(chunk);
+  }
+  else {
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+      dispatch_queue->dispatch([=, &find_chunk] (int) { find_chunk(chunk); });
+    dispatch_queue->finishTasks();
+  }
+
+  size_t slack_count = 0;
+  for (const EndpointSlackSeq &chunk : chunk_slacks)
+    slack_count += chunk.size();
+  slacks.clear();
+  slacks.reserve(slack_count);
+  for (const EndpointSlackSeq &chunk : chunk_slacks)
+    slacks.insert(slacks.end(), chunk.begin(), chunk.end());
+}
+
+////////////////////////////////////////////////////////////////
+
+// Quote fields with separators or quotes.
+static void
+writeCsvField(FILE *stream,
+              const char *field)
+{
+  if (strpbrk(field, ",\"\n")) {
+    fputc('"', stream);
+    for (const char *s = field; *s; s++) {
+      if (*s == '"')
+        fputc('"', stream);
+      fputc(*s, stream);
+    }
+    fputc('"', stream);
+  }
+  else
+    fputs(field, stream);
+}
+
+void
+writeEndpointSlacks(const EndpointSlackSeq &slacks,
+                    const char *filename,
+                    const StaState *sta)
+{
+  FILE *stream = fopen(filename, "w");
+  if (stream == nullptr)
+    throw FileNotWritable(filename);
+  const Network *network = sta->sdcNetwork();
+  fprintf(stream, "endpoint,corner,min_max,group,slack,arrival,required\n");
+  for (const EndpointSlack &slack : slacks) {
+    const PathAnalysisPt *path_ap = slack.path_ap_;
+    writeCsvField(stream, network->pathName(slack.vertex_->pin()));
+    fputc(',', stream);
+    writeCsvField(stream, path_ap->corner()->name());
+    fprintf(stream, ",%s,", path_ap->pathMinMax()->asString());
+    writeCsvField(stream, slack.group_);
+    fprintf(stream, ",%.9g,%.9g,%.9g\n",
+            delayAsFloat(slack.slack_),
+            delayAsFloat(slack.arrival_),
+            delayAsFloat(slack.required_));
+  }
+  bool failed = ferror(stream);
+  fclose(stream);
+  if (failed)
+    throw FileNotWritable(filename);
+}
+
+} // namespace
@@ -0,0 +1,48 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "MinMax.hh"
+#include "EndpointSlack.hh"
+
+namespace sta {
+
+class StaState;
+class Corner;
+
+// Find the worst slack of every endpoint for each path analysis point
+// of corner/min_max with the dispatch queue threads. The path ends at
+// each endpoint are only visited, so no path groups are made.
+// Arrivals and requireds must be up to date.
+// Use corner nullptr for all corners.
+void
+findEndpointSlacks(const Corner *corner,
+                   const MinMaxAll *min_max,
+                   const StaState *sta,
+                   // Return value.
+                   EndpointSlackSeq &slacks);
+
+// Write slacks to a csv file with one line per endpoint and path
+// analysis point. Times are in seconds.
+// Throws FileNotWritable.
+void
+writeEndpointSlacks(const EndpointSlackSeq &slacks,
+                    const char *filename,
+                    const StaState *sta);
+
+} // namespace
@@ -16,6 +16,8 @@
 
 #include "FindRegister.hh"
 
+#include "DispatchQueue.hh"
+#include "Debug.hh"
 #include "TimingRole.hh"
 #include "FuncExpr.hh"
 #include "TimingArc.hh"
@@ -74,12 +76,115 @@ FindRegClkPred::searchThru(Edge *edge)
     && SearchPred1::searchThru(edge);
 }
 
+////////////////////////////////////////////////////////////////
+
+RegClkPinCache::RegClkPinCache(StaState *sta) :
+  StaState(sta),
+  arrivals_invalid_count_(0)
+{
+}
+
+void
+RegClkPinCache::clear()
+{
+  clk_reg_clk_pins_.clear();
+}
+
+void
+RegClkPinCache::ensureRegClkPins(ClockSet *clks)
+{
+  if (arrivals_invalid_count_ != search_->arrivalsInvalidCount()) {
+    // Clock, disable and clock sense changes invalidate arrivals.
+    clk_reg_clk_pins_.clear();
+    arrivals_invalid_count_ = search_->arrivalsInvalidCount();
+  }
+  std::vector<Clock*> find_clks;
+  for (Clock *clk : *clks) {
+    if (clk_reg_clk_pins_.find(clk) == clk_reg_clk_pins_.end()) {
+      // Make the entries before the threads fill them in.
+      clk_reg_clk_pins_[clk];
+      find_clks.push_back(clk);
+    }
+  }
+  if (thread_count_ > 1
+      && dispatch_queue_
+      && find_clks.size() > 1) {
+    for (Clock *clk : find_clks) {
+      RegClkPinSenseSeq &reg_clk_pins = clk_reg_clk_pins_[clk];
+      dispatch_queue_->dispatch([this, clk, &reg_clk_pins](int) {
+        findRegClkPins(clk, reg_clk_pins);
+      });
+    }
+    dispatch_queue_->finishTasks();
+  }
+  else {
+    for (Clock *clk : find_clks)
+      findRegClkPins(clk, clk_reg_clk_pins_[clk]);
+  }
+}
+
+const RegClkPinSenseSeq &
+RegClkPinCache::regClkPins(const Clock *clk)
+{
+  return clk_reg_clk_pins_[clk];
+}
+
+// Use DFS search to find all registers downstream of the clock.
+void
+RegClkPinCache::findRegClkPins(Clock *clk,
+                               RegClkPinSenseSeq &reg_clk_pins)
+{
+  debugPrint(debug_, "find_reg", 1, "find clock %s registers", clk->name());
+  FindRegClkPred clk_pred(clk, this);
+  VertexSet visited_vertices(graph_);
+  for (const Pin *pin : clk->leafPins()) {
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    findFanoutRegClkPins(vertex, TimingSense::positive_unate,
+                         clk_pred, visited_vertices, reg_clk_pins);
+    // Clocks defined on bidirect pins blow it out both ends.
+    if (bidirect_drvr_vertex)
+      findFanoutRegClkPins(bidirect_drvr_vertex,
+                           TimingSense::positive_unate,
+                           clk_pred, visited_vertices, reg_clk_pins);
+  }
+}
+
+void
+RegClkPinCache::findFanoutRegClkPins(Vertex *from_vertex,
+                                     TimingSense from_sense,
+                                     SearchPred &clk_pred,
+                                     VertexSet &visited_vertices,
+                                     RegClkPinSenseSeq &reg_clk_pins)
+{
+  if (!visited_vertices.hasKey(from_vertex)
+      && clk_pred.searchFrom(from_vertex)) {
+    visited_vertices.insert(from_vertex);
+    VertexOutEdgeIterator edge_iter(from_vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *to_vertex = edge->to(graph_);
+      TimingSense to_sense = pathSenseThru(from_sense, edge->sense());
+      if (to_vertex->isRegClk())
+        reg_clk_pins.push_back(RegClkPinSense(to_vertex->pin(), to_sense));
+      // Even register clock pins can have combinational fanout arcs.
+      if (clk_pred.searchThru(edge)
+          && clk_pred.searchTo(to_vertex))
+        findFanoutRegClkPins(to_vertex, to_sense, clk_pred,
+                             visited_vertices, reg_clk_pins);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
 // Helper for "all_registers".
 // Visit all register instances.
 class FindRegVisitor : public StaState
 {
 public:
-  FindRegVisitor(StaState *sta);
+  FindRegVisitor(RegClkPinCache *reg_clk_pins,
+                 StaState *sta);
   virtual ~FindRegVisitor() {}
   void visitRegs(ClockSet *clks,
 		 const RiseFallBoth *clk_rf,
@@ -95,13 +200,6 @@ private:
   virtual void visitReg(Instance *inst) = 0;
   virtual void visitSequential(Instance *inst,
 			       Sequential *seq) = 0;
-  void visitFanoutRegs(Vertex *from_vertex,
-		       TimingSense from_sense,
-		       const RiseFallBoth *clk_rf,
-		       bool edge_triggered,
-		       bool latches,
-		       SearchPred &clk_pred,
-		       VertexSet &visited_vertices);
   void findSequential(const Pin *clk_pin,
 		      Instance *inst,
 		      LibertyCell *cell,
@@ -120,10 +218,13 @@ private:
 		      LibertyPort *clk,
 		      LibertyPort *d);
 
+  RegClkPinCache *reg_clk_pins_;
 };
 
-FindRegVisitor::FindRegVisitor(StaState *sta) :
-  StaState(sta)
+FindRegVisitor::FindRegVisitor(RegClkPinCache *reg_clk_pins,
+                               StaState *sta) :
+  StaState(sta),
+  reg_clk_pins_(reg_clk_pins)
 {
 }
 
@@ -134,27 +235,11 @@ FindRegVisitor::visitRegs(ClockSet *clks,
 			  bool latches)
 {
   if (clks && !clks->empty()) {
-    // Use DFS search to find all registers downstream of the clocks.
-    ClockSet::Iterator clk_iter(clks);
-    while (clk_iter.hasNext()) {
-      Clock *clk = clk_iter.next();
-      FindRegClkPred clk_pred(clk, this);
-      VertexSet visited_vertices(graph_);
-      for (const Pin *pin : clk->leafPins()) {
-	Vertex *vertex, *bidirect_drvr_vertex;
-	graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
-	visitFanoutRegs(vertex, TimingSense::positive_unate,
-			clk_rf, edge_triggered,
-			latches, clk_pred,
-			visited_vertices);
-	// Clocks defined on bidirect pins blow it out both ends.
-	if (bidirect_drvr_vertex)
-	  visitFanoutRegs(bidirect_drvr_vertex,
-			  TimingSense::positive_unate,
-			  clk_rf, edge_triggered,
-			  latches, clk_pred,
-			  visited_vertices);
-      }
+    reg_clk_pins_->ensureRegClkPins(clks);
+    for (Clock *clk : *clks) {
+      for (const RegClkPinSense &pin_sense : reg_clk_pins_->regClkPins(clk))
+        visitRegs(pin_sense.first, pin_sense.second, clk_rf,
+                  edge_triggered, latches);
     }
   }
   else {
@@ -166,35 +251,6 @@ FindRegVisitor::visitRegs(ClockSet *clks,
   }
 }
 
-void
-FindRegVisitor::visitFanoutRegs(Vertex *from_vertex,
-				TimingSense from_sense,
-				const RiseFallBoth *clk_rf,
-				bool edge_triggered,
-				bool latches,
-				SearchPred &clk_pred,
-				VertexSet &visited_vertices)
-{
-  if (!visited_vertices.hasKey(from_vertex)
-      && clk_pred.searchFrom(from_vertex)) {
-    visited_vertices.insert(from_vertex);
-    VertexOutEdgeIterator edge_iter(from_vertex, graph_);
-    while (edge_iter.hasNext()) {
-      Edge *edge = edge_iter.next();
-      Vertex *to_vertex = edge->to(graph_);
-      const Pin *to_pin = to_vertex->pin();
-      TimingSense to_sense = pathSenseThru(from_sense, edge->sense());
-      if (to_vertex->isRegClk())
-	visitRegs(to_pin, to_sense, clk_rf, edge_triggered, latches);
-      // Even register clock pins can have combinational fanout arcs.
-      if (clk_pred.searchThru(edge)
-          && clk_pred.searchTo(to_vertex))
-	visitFanoutRegs(to_vertex, to_sense, clk_rf, edge_triggered, latches,
-			clk_pred, visited_vertices);
-    }
-  }
-}
-
 void
 FindRegVisitor::visitRegs(const Pin *clk_pin,
 			  TimingSense clk_sense,
@@ -308,7 +364,8 @@ FindRegVisitor::hasTimingCheck(LibertyCell *cell,
 class FindRegInstances : public FindRegVisitor
 {
 public:
-  explicit FindRegInstances(StaState *sta);
+  FindRegInstances(RegClkPinCache *reg_clk_pins,
+                   StaState *sta);
   InstanceSet findRegs(ClockSet *clks,
                        const RiseFallBoth *clk_rf,
                        bool edge_triggered,
@@ -322,8 +379,9 @@ private:
   InstanceSet regs_;
 };
 
-FindRegInstances::FindRegInstances(StaState *sta) :
-  FindRegVisitor(sta),
+FindRegInstances::FindRegInstances(RegClkPinCache *reg_clk_pins,
+                                   StaState *sta) :
+  FindRegVisitor(reg_clk_pins, sta),
   regs_(network_)
 {
 }
@@ -355,9 +413,10 @@ findRegInstances(ClockSet *clks,
 		 const RiseFallBoth *clk_rf,
 		 bool edge_triggered,
 		 bool latches,
+		 RegClkPinCache *reg_clk_pins,
 		 StaState *sta)
 {
-  FindRegInstances find_regs(sta);
+  FindRegInstances find_regs(reg_clk_pins, sta);
   return find_regs.findRegs(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -366,7 +425,8 @@ findRegInstances(ClockSet *clks,
 class FindRegPins : public FindRegVisitor
 {
 public:
-  FindRegPins(StaState *sta);
+  FindRegPins(RegClkPinCache *reg_clk_pins,
+              StaState *sta);
   PinSet findPins(ClockSet *clks,
                   const RiseFallBoth *clk_rf,
                   bool edge_triggered,
@@ -387,8 +447,9 @@ protected:
   PinSet pins_;
 };
 
-FindRegPins::FindRegPins(StaState *sta) :
-  FindRegVisitor(sta),
+FindRegPins::FindRegPins(RegClkPinCache *reg_clk_pins,
+                         StaState *sta) :
+  FindRegVisitor(reg_clk_pins, sta),
   pins_(network_)
 {
 }
@@ -448,7 +509,8 @@ FindRegPins::matchPin(Pin *)
 class FindRegDataPins : public FindRegPins
 {
 public:
-  explicit FindRegDataPins(StaState *sta);
+  FindRegDataPins(RegClkPinCache *reg_clk_pins,
+                  StaState *sta);
 
 private:
   virtual bool matchPin(Pin *pin);
@@ -456,8 +518,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq);
 };
 
-FindRegDataPins::FindRegDataPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegDataPins::FindRegDataPins(RegClkPinCache *reg_clk_pins,
+                                 StaState *sta) :
+  FindRegPins(reg_clk_pins, sta)
 {
 }
 
@@ -503,9 +566,10 @@ findRegDataPins(ClockSet *clks,
 		const RiseFallBoth *clk_rf,
 		bool edge_triggered,
 		bool latches,
+		RegClkPinCache *reg_clk_pins,
 		StaState *sta)
 {
-  FindRegDataPins find_regs(sta);
+  FindRegDataPins find_regs(reg_clk_pins, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -514,7 +578,8 @@ findRegDataPins(ClockSet *clks,
 class FindRegClkPins : public FindRegPins
 {
 public:
-  explicit FindRegClkPins(StaState *sta);
+  FindRegClkPins(RegClkPinCache *reg_clk_pins,
+                 StaState *sta);
 
 private:
   virtual bool matchPin(Pin *pin);
@@ -522,8 +587,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq);
 };
 
-FindRegClkPins::FindRegClkPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegClkPins::FindRegClkPins(RegClkPinCache *reg_clk_pins,
+                               StaState *sta) :
+  FindRegPins(reg_clk_pins, sta)
 {
 }
 
@@ -560,9 +626,10 @@ findRegClkPins(ClockSet *clks,
 	       const RiseFallBoth *clk_rf,
 	       bool edge_triggered,
 	       bool latches,
+	       RegClkPinCache *reg_clk_pins,
 	       StaState *sta)
 {
-  FindRegClkPins find_regs(sta);
+  FindRegClkPins find_regs(reg_clk_pins, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -571,7 +638,8 @@ findRegClkPins(ClockSet *clks,
 class FindRegAsyncPins : public FindRegPins
 {
 public:
-  explicit FindRegAsyncPins(StaState *sta);
+  FindRegAsyncPins(RegClkPinCache *reg_clk_pins,
+                   StaState *sta);
 
 private:
   virtual bool matchPin(Pin *pin);
@@ -579,8 +647,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq) { return seq->preset(); }
 };
 
-FindRegAsyncPins::FindRegAsyncPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegAsyncPins::FindRegAsyncPins(RegClkPinCache *reg_clk_pins,
+                                   StaState *sta) :
+  FindRegPins(reg_clk_pins, sta)
 {
 }
 
@@ -602,9 +671,10 @@ findRegAsyncPins(ClockSet *clks,
 		 const RiseFallBoth *clk_rf,
 		 bool edge_triggered,
 		 bool latches,
+		 RegClkPinCache *reg_clk_pins,
 		 StaState *sta)
 {
-  FindRegAsyncPins find_regs(sta);
+  FindRegAsyncPins find_regs(reg_clk_pins, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -613,7 +683,8 @@ findRegAsyncPins(ClockSet *clks,
 class FindRegOutputPins : public FindRegPins
 {
 public:
-  explicit FindRegOutputPins(StaState *sta);
+  FindRegOutputPins(RegClkPinCache *reg_clk_pins,
+                    StaState *sta);
 
 private:
   virtual bool matchPin(Pin *pin);
@@ -626,8 +697,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq);
 };
 
-FindRegOutputPins::FindRegOutputPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegOutputPins::FindRegOutputPins(RegClkPinCache *reg_clk_pins,
+                                     StaState *sta) :
+  FindRegPins(reg_clk_pins, sta)
 {
 }
 
@@ -693,9 +765,10 @@ findRegOutputPins(ClockSet *clks,
 		  const RiseFallBoth *clk_rf,
 		  bool edge_triggered,
 		  bool latches,
+		  RegClkPinCache *reg_clk_pins,
 		  StaState *sta)
 {
-  FindRegOutputPins find_regs(sta);
+  FindRegOutputPins find_regs(reg_clk_pins, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -16,28 +16,70 @@
 
 #pragma once
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "LibertyClass.hh"
 #include "NetworkClass.hh"
+#include "GraphClass.hh"
 #include "SdcClass.hh"
+#include "SearchClass.hh"
 #include "StaState.hh"
 
 namespace sta {
 
+// Register clock pin and the clock sense at the pin.
+typedef std::pair<const Pin*, TimingSense> RegClkPinSense;
+typedef std::vector<RegClkPinSense> RegClkPinSenseSeq;
+
+// Register clock pins in the clock network fanout of each clock that
+// are kept between all_registers queries. The pins are forgotten when
+// the search arrivals are invalidated and by clear(), which the Sta
+// calls when the netlist or constant pins change.
+class RegClkPinCache : public StaState
+{
+public:
+  RegClkPinCache(StaState *sta);
+  void clear();
+  // Find the register clock pins of the clocks that are not cached,
+  // in parallel.
+  void ensureRegClkPins(ClockSet *clks);
+  const RegClkPinSenseSeq &regClkPins(const Clock *clk);
+
+private:
+  void findRegClkPins(Clock *clk,
+                      RegClkPinSenseSeq &reg_clk_pins);
+  void findFanoutRegClkPins(Vertex *from_vertex,
+                            TimingSense from_sense,
+                            SearchPred &clk_pred,
+                            VertexSet &visited_vertices,
+                            RegClkPinSenseSeq &reg_clk_pins);
+
+  std::map<const Clock*, RegClkPinSenseSeq> clk_reg_clk_pins_;
+  int arrivals_invalid_count_;
+};
+
 InstanceSet
 findRegInstances(ClockSet *clks, const RiseFallBoth *clk_rf,
-		 bool edge_triggered, bool latches, StaState *sta);
+		 bool edge_triggered, bool latches,
+                 RegClkPinCache *reg_clk_pins, StaState *sta);
 PinSet
 findRegDataPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-		bool edge_triggered, bool latches, StaState *sta);
+		bool edge_triggered, bool latches,
+                RegClkPinCache *reg_clk_pins, StaState *sta);
 PinSet
 findRegClkPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-	       bool edge_triggered, bool latches, StaState *sta);
+	       bool edge_triggered, bool latches,
+               RegClkPinCache *reg_clk_pins, StaState *sta);
 PinSet
 findRegAsyncPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-		 bool edge_triggered, bool latches, StaState *sta);
+		 bool edge_triggered, bool latches,
+                 RegClkPinCache *reg_clk_pins, StaState *sta);
 PinSet
 findRegOutputPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-		  bool edge_triggered, bool latches, StaState *sta);
+		  bool edge_triggered, bool latches,
+                  RegClkPinCache *reg_clk_pins, StaState *sta);
 
 void
 initPathSenseThru();
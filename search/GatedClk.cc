@@ -16,6 +16,8 @@
 
 #include "GatedClk.hh"
 
+#include "Hash.hh"
+#include "Mutex.hh"
 #include "FuncExpr.hh"
 #include "Liberty.hh"
 #include "PortDirection.hh"
@@ -27,10 +29,61 @@
 namespace sta {
 
 GatedClk::GatedClk(const StaState *sta) :
-  StaState(sta)
+  StaState(sta),
+  funcs_(127)
 {
 }
 
+GatedClk::~GatedClk()
+{
+  funcs_.deleteContentsClear();
+}
+
+void
+GatedClk::clear()
+{
+  funcs_.deleteContentsClear();
+}
+
+const GatedClkFunc *
+GatedClk::gatedClkFunc(FuncExpr *func) const
+{
+  GatedClkFunc probe(func);
+  GatedClkFunc *gated_func = funcs_.findKey(&probe);
+  if (gated_func == nullptr) {
+    UniqueLock lock(funcs_lock_);
+    gated_func = funcs_.findKey(&probe);
+    if (gated_func == nullptr) {
+      gated_func = new GatedClkFunc(func);
+      FuncExprPortIterator clk_port_iter(func);
+      LibertyPortSet clk_ports;
+      while (clk_port_iter.hasNext()) {
+        LibertyPort *clk_port = clk_port_iter.next();
+        if (!clk_ports.hasKey(clk_port)) {
+          clk_ports.insert(clk_port);
+          FuncExprPortIterator enable_port_iter(func);
+          LibertyPortSet enable_ports;
+          while (enable_port_iter.hasNext()) {
+            LibertyPort *enable_port = enable_port_iter.next();
+            if (enable_port != clk_port
+                && !enable_ports.hasKey(enable_port)) {
+              enable_ports.insert(enable_port);
+              bool is_clk_gate = false;
+              LogicValue logic_value;
+              isClkGatingFunc(func, enable_port, clk_port,
+                              is_clk_gate, logic_value);
+              if (is_clk_gate)
+                gated_func->addGate(enable_port, clk_port, logic_value);
+            }
+          }
+        }
+      }
+      funcs_.insert(gated_func);
+    }
+  }
+  return gated_func;
+}
+
 bool
 GatedClk::isGatedClkEnable(Vertex *vertex) const
 {
@@ -79,21 +132,15 @@ GatedClk::isGatedClkEnable(Vertex *enable_vertex,
     if (func
 	&& search_->isClock(gclk_vertex)
 	&& !search_->isClock(enable_vertex)) {
-      FuncExprPortIterator clk_port_iter(func);
-      while (clk_port_iter.hasNext()) {
-	LibertyPort *clk_port = clk_port_iter.next();
-	if (clk_port != enable_port)  {
-	  bool is_clk_gate = false;
-	  isClkGatingFunc(func, enable_port, clk_port,
-			  is_clk_gate, logic_active_value);
-	  if (is_clk_gate) {
-	    clk_pin = network_->findPin(inst, clk_port);
-	    if (clk_pin
-		&& !sdc_->isDisableClockGatingCheck(clk_pin)
-		&& search_->isClock(graph_->pinLoadVertex(clk_pin))) {
-	      is_gated_clk_enable = true;
-	      break;
-	    }
+      for (const GatedClkFunc::Gate &gate : gatedClkFunc(func)->gates()) {
+	if (gate.enable_port_ == enable_port) {
+	  clk_pin = network_->findPin(inst, gate.clk_port_);
+	  if (clk_pin
+	      && !sdc_->isDisableClockGatingCheck(clk_pin)
+	      && search_->isClock(graph_->pinLoadVertex(clk_pin))) {
+	    logic_active_value = gate.logic_active_value_;
+	    is_gated_clk_enable = true;
+	    break;
 	  }
 	}
       }
@@ -129,22 +176,13 @@ GatedClk::gatedClkEnables(Vertex *clk_vertex,
 	  func = gclk_port->function();
 	  if (func) {
 	    if (search_->isClock(gclk_vertex)) {
-	      FuncExprPortIterator enable_port_iter(func);
-	      while (enable_port_iter.hasNext()) {
-		LibertyPort *enable_port = enable_port_iter.next();
-		if (enable_port != clk_port)  {
-		  bool is_clk_gate;
-		  LogicValue logic_value;
-		  isClkGatingFunc(func, enable_port, clk_port,
-				  is_clk_gate, logic_value);
-		  if (is_clk_gate) {
-		    Pin *enable_pin = network_->findPin(inst, enable_port);
-		    if (enable_pin
-			&& !sdc_->isDisableClockGatingCheck(enable_pin)
-			&& !search_->isClock(graph_->pinLoadVertex(enable_pin))) {
-		      enable_pins.insert(enable_pin);
-		    }
-		  }
+	      for (const GatedClkFunc::Gate &gate : gatedClkFunc(func)->gates()) {
+		if (gate.clk_port_ == clk_port) {
+		  Pin *enable_pin = network_->findPin(inst, gate.enable_port_);
+		  if (enable_pin
+		      && !sdc_->isDisableClockGatingCheck(enable_pin)
+		      && !search_->isClock(graph_->pinLoadVertex(enable_pin)))
+		    enable_pins.insert(enable_pin);
 		}
 	      }
 	    }
@@ -230,6 +268,31 @@ GatedClk::functionClkOperands(FuncExpr *root_expr,
   }
 }
 
+////////////////////////////////////////////////////////////////
+
+void
+GatedClkFunc::addGate(LibertyPort *enable_port,
+                      LibertyPort *clk_port,
+                      LogicValue logic_active_value)
+{
+  gates_.push_back({enable_port, clk_port, logic_active_value});
+}
+
+size_t
+GatedClkFuncHash::operator()(const GatedClkFunc *func) const
+{
+  return hashPtr(func->func());
+}
+
+bool
+GatedClkFuncEqual::operator()(const GatedClkFunc *func1,
+                              const GatedClkFunc *func2) const
+{
+  return func1->func() == func2->func();
+}
+
+////////////////////////////////////////////////////////////////
+
 RiseFall *
 GatedClk::gatedClkActiveTrans(LogicValue active_value,
 			      const MinMax *min_max) const
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <mutex>
+#include <vector>
+
+#include "ConcurrentHashSet.hh"
 #include "SdcClass.hh"
 #include "GraphClass.hh"
 #include "SearchClass.hh"
@@ -25,10 +29,53 @@ namespace sta {
 
 typedef Set<FuncExpr*> FuncExprSet;
 
+// Enable/clock port pairs of a clock gating cell function.
+class GatedClkFunc
+{
+public:
+  class Gate
+  {
+  public:
+    LibertyPort *enable_port_;
+    LibertyPort *clk_port_;
+    LogicValue logic_active_value_;
+  };
+
+  explicit GatedClkFunc(FuncExpr *func) : func_(func) {}
+  FuncExpr *func() const { return func_; }
+  const std::vector<Gate> &gates() const { return gates_; }
+  void addGate(LibertyPort *enable_port,
+               LibertyPort *clk_port,
+               LogicValue logic_active_value);
+
+private:
+  FuncExpr *func_;
+  std::vector<Gate> gates_;
+};
+
+class GatedClkFuncHash
+{
+public:
+  size_t operator()(const GatedClkFunc *func) const;
+};
+
+class GatedClkFuncEqual
+{
+public:
+  bool operator()(const GatedClkFunc *func1,
+                  const GatedClkFunc *func2) const;
+};
+
+typedef ConcurrentHashSet<GatedClkFunc, GatedClkFuncHash,
+                          GatedClkFuncEqual> GatedClkFuncSet;
+
 class GatedClk : public StaState
 {
 public:
   GatedClk(const StaState *sta);
+  ~GatedClk();
+  // Forget the cell function gates when libraries change.
+  void clear();
 
   bool isGatedClkEnable(Vertex *vertex) const;
   void isGatedClkEnable(Vertex *enable_vertex,
@@ -42,6 +89,8 @@ public:
 				     const MinMax *min_max) const;
 
 protected:
+  // Gates of a cell function are inferred once and found without locking.
+  const GatedClkFunc *gatedClkFunc(FuncExpr *func) const;
   void isClkGatingFunc(FuncExpr *func,
 		       LibertyPort *enable_port,
 		       LibertyPort *clk_port,
@@ -50,6 +99,9 @@ protected:
   void functionClkOperands(FuncExpr *root_expr,
 			   FuncExpr *curr_expr,
 			   FuncExprSet &funcs) const;
+
+  mutable GatedClkFuncSet funcs_;
+  mutable std::mutex funcs_lock_;
 };
 
 } // namespace
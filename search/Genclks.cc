@@ -18,6 +18,7 @@
 
 #include "Stats.hh"
 #include "Debug.hh"
+#include "DispatchQueue.hh"
 #include "Report.hh"
 #include "Network.hh"
 #include "PortDirection.hh"
@@ -201,11 +202,15 @@ Genclks::ensureInsertionDelays()
     // insertion delay, so sort the clocks by source pin level.
     sort(gclks, ClockPinMaxLevelLess(this));
 
-    ClockSeq::Iterator gclk_iter(gclks);
-    while (gclk_iter.hasNext()) {
-      Clock *gclk = gclk_iter.next();
+    // The fanin searches are independent so find them up front
+    // (in parallel). The insertion searches that follow share the
+    // vertex arrivals and source paths of earlier generated clocks.
+    VertexSetSeq fanins;
+    findFanins(gclks, fanins);
+    for (size_t i = 0; i < gclks.size(); i++) {
+      Clock *gclk = gclks[i];
       if (gclk->masterClk()) {
-	findInsertionDelays(gclk);
+	findInsertionDelays(gclk, fanins[i]);
 	recordSrcPaths(gclk);
       }
     }
@@ -397,39 +402,81 @@ GenClkFaninSrchPred::searchTo(const Vertex *)
   return true;
 }
 
+void
+Genclks::findFanins(ClockSeq &gclks,
+                    // Return value.
+                    VertexSetSeq &fanins)
+{
+  fanins.resize(gclks.size(), nullptr);
+  for (size_t i = 0; i < gclks.size(); i++) {
+    if (gclks[i]->masterClk())
+      fanins[i] = new VertexSet(graph_);
+  }
+  if (thread_count_ > 1) {
+    for (size_t i = 0; i < gclks.size(); i++) {
+      if (fanins[i]) {
+        Clock *gclk = gclks[i];
+        VertexSet *gclk_fanins = fanins[i];
+        dispatch_queue_->dispatch( [this, gclk, gclk_fanins](int)
+        { findFanin(gclk, gclk_fanins); } );
+      }
+    }
+    dispatch_queue_->finishTasks();
+  }
+  else {
+    for (size_t i = 0; i < gclks.size(); i++) {
+      if (fanins[i])
+        findFanin(gclks[i], fanins[i]);
+    }
+  }
+}
+
+// Search backward from generated clock source pin to a clock pin.
+// The search only reads the graph and uses the fanin set rather
+// than BfsIndex queue flags to mark visited vertices so searches for
+// different clocks can run concurrently.
 void
 Genclks::findFanin(Clock *gclk,
 		   // Return value.
 		   VertexSet *fanins)
 {
-  // Search backward from generated clock source pin to a clock pin.
   GenClkFaninSrchPred srch_pred(gclk, this);
-  BfsBkwdIterator iter(BfsIndex::other, &srch_pred, this);
-  seedClkVertices(gclk, iter, fanins);
-  while (iter.hasNext()) {
-    Vertex *vertex = iter.next();
+  VertexSeq queue;
+  for (const Pin *pin : gclk->leafPins()) {
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    fanins->insert(vertex);
+    enqueueFaninVertices(vertex, &srch_pred, queue);
+    if (bidirect_drvr_vertex) {
+      fanins->insert(bidirect_drvr_vertex);
+      enqueueFaninVertices(bidirect_drvr_vertex, &srch_pred, queue);
+    }
+  }
+  while (!queue.empty()) {
+    Vertex *vertex = queue.back();
+    queue.pop_back();
     if (!fanins->hasKey(vertex)) {
       fanins->insert(vertex);
       debugPrint(debug_, "genclk", 2, "gen clk %s fanin %s",
                  gclk->name(), vertex->name(sdc_network_));
-      iter.enqueueAdjacentVertices(vertex);
+      enqueueFaninVertices(vertex, &srch_pred, queue);
     }
   }
 }
 
 void
-Genclks::seedClkVertices(Clock *clk,
-			 BfsBkwdIterator &iter,
-			 VertexSet *fanins)
+Genclks::enqueueFaninVertices(Vertex *vertex,
+                              SearchPred *srch_pred,
+                              VertexSeq &queue)
 {
-  for (const Pin *pin : clk->leafPins()) {
-    Vertex *vertex, *bidirect_drvr_vertex;
-    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
-    fanins->insert(vertex);
-    iter.enqueueAdjacentVertices(vertex);
-    if (bidirect_drvr_vertex) {
-      fanins->insert(bidirect_drvr_vertex);
-      iter.enqueueAdjacentVertices(bidirect_drvr_vertex);
+  if (srch_pred->searchTo(vertex)) {
+    VertexInEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *from_vertex = edge->from(graph_);
+      if (srch_pred->searchFrom(from_vertex)
+          && srch_pred->searchThru(edge))
+        queue.push_back(from_vertex);
     }
   }
 }
@@ -512,11 +559,12 @@ GenClkInsertionSearchPred::isNonGeneratedClkPin(const Pin *pin) const
 ////////////////////////////////////////////////////////////////
 
 void
-Genclks::findInsertionDelays(Clock *gclk)
+Genclks::findInsertionDelays(Clock *gclk,
+                             VertexSet *fanins)
 {
   debugPrint(debug_, "genclk", 2, "find gen clk %s insertion",
              gclk->name());
-  GenclkInfo *genclk_info = makeGenclkInfo(gclk);
+  GenclkInfo *genclk_info = makeGenclkInfo(gclk, fanins);
   FilterPath *src_filter = genclk_info->srcFilter();
   GenClkInsertionSearchPred srch_pred(gclk, nullptr, genclk_info, this);
   BfsFwdIterator insert_iter(BfsIndex::other, &srch_pred, this);
@@ -530,12 +578,11 @@ Genclks::findInsertionDelays(Clock *gclk)
 }
 
 GenclkInfo *
-Genclks::makeGenclkInfo(Clock *gclk)
+Genclks::makeGenclkInfo(Clock *gclk,
+                        VertexSet *fanins)
 {
   FilterPath *src_filter = makeSrcFilter(gclk);
   Level gclk_level = clkPinMaxLevel(gclk);
-  VertexSet *fanins = new VertexSet(graph_);
-  findFanin(gclk, fanins);
   GenclkInfo *genclk_info = new GenclkInfo(gclk, gclk_level, fanins,
 					    src_filter);
   genclk_info_map_.insert(gclk, genclk_info);
@@ -761,6 +808,7 @@ public:
 			  const StaState *sta);
   virtual VertexVisitor *copy() const;
   virtual void visit(Vertex *vertex);
+  virtual void visitNarrow(Vertex *vertex) { visit(vertex); }
 
 protected:
   GenclkSrcArrivalVisitor(Clock *gclk,
@@ -850,11 +898,10 @@ Genclks::copyGenClkSrcPaths(Vertex *vertex,
     PathVertexRep *prev_paths = graph_->prevPaths(vertex);
     TagGroup *tag_group = search_->tagGroup(vertex);
     if (tag_group) {
-      ArrivalMap::Iterator arrival_iter(tag_group->arrivalMap());
-      while (arrival_iter.hasNext()) {
-        Tag *tag;
-        int arrival_index;
-        arrival_iter.next(tag, arrival_index);
+      for (int arrival_index = 0;
+           arrival_index < tag_group->arrivalCount();
+           arrival_index++) {
+        Tag *tag = tag_group->arrivalTag(arrival_index);
         if (tag->isGenClkSrcPath()) {
           Arrival arrival = arrivals[arrival_index];
           PathVertexRep *prev_path = prev_paths
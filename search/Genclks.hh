@@ -17,6 +17,7 @@
 #pragma once
 
 #include "Map.hh"
+#include "Vector.hh"
 #include "Transition.hh"
 #include "NetworkClass.hh"
 #include "GraphClass.hh"
@@ -42,6 +43,7 @@ public:
 };
 
 typedef Map<Clock*, GenclkInfo*> GenclkInfoMap;
+typedef Vector<VertexSet*> VertexSetSeq;
 typedef Map<ClockPinPair, PathVertexRep*, ClockPinPairLess> GenclkSrcPathMap;
 
 class Genclks : public StaState
@@ -88,10 +90,8 @@ private:
   GenclkInfo *genclkInfo(const Clock *gclk) const;
   void clearSrcPaths();
   void recordSrcPaths(Clock *gclk);
-  void findInsertionDelays(Clock *gclk);
-  void seedClkVertices(Clock *clk,
-		       BfsBkwdIterator &iter,
-		       VertexSet *fanins);
+  void findInsertionDelays(Clock *gclk,
+                           VertexSet *fanins);
   int srcPathIndex(const RiseFall *clk_rf,
 		   const PathAnalysisPt *path_ap) const;
   bool matchesSrcFilter(Path *path,
@@ -113,11 +113,18 @@ private:
   void seedSrcPins(Clock *clk,
 		   BfsBkwdIterator &iter);
   void findInsertionDelay(Clock *gclk);
-  GenclkInfo *makeGenclkInfo(Clock *gclk);
+  GenclkInfo *makeGenclkInfo(Clock *gclk,
+                             VertexSet *fanins);
   FilterPath *srcFilter(Clock *gclk);
+  void findFanins(ClockSeq &gclks,
+                  // Return value.
+                  VertexSetSeq &fanins);
   void findFanin(Clock *gclk,
 		 // Return value.
 		 VertexSet *fanins);
+  void enqueueFaninVertices(Vertex *vertex,
+                            SearchPred *srch_pred,
+                            VertexSeq &queue);
   void findLatchFdbkEdges(const Clock *clk,
 			  GenclkInfo *genclk_info);
   void findLatchFdbkEdges(Vertex *vertex,
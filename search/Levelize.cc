@@ -17,6 +17,10 @@
 #include "Levelize.hh"
 
 #include <algorithm>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
 
 #include "Report.hh"
 #include "Debug.hh"
@@ -28,6 +32,7 @@
 #include "Graph.hh"
 #include "GraphCmp.hh"
 #include "SearchPred.hh"
+#include "DispatchQueue.hh"
 
 namespace sta {
 
@@ -43,7 +48,9 @@ Levelize::Levelize(StaState *sta) :
   roots_(new VertexSet(graph_)),
   relevelize_from_(new VertexSet(graph_)),
   loops_(nullptr),
-  observer_(nullptr)
+  observer_(nullptr),
+  relevelize_visit_count_(0),
+  relevelize_change_count_(0)
 {
 }
 
@@ -120,19 +127,27 @@ Levelize::levelize()
 {
   Stats stats(debug_, report_);
   debugPrint(debug_, "levelize", 1, "levelize");
+  relevelize_visit_count_ = 0;
+  relevelize_change_count_ = 0;
   max_level_ = 0;
   clearLoopEdges();
   deleteLoops();
   loops_ = new GraphLoopSeq;
+  if (levelize_scc_)
+    breakLoopsScc();
   findRoots();
   VertexSeq roots;
   // Sort the roots so that loop breaking is stable in regressions.
   // In situations where port directions are broken pins may
   // be treated as bidirects, leading to a plethora of degenerate
   // roots that take forever to sort.
-  if (roots.size() < 100)
-    sortRoots(roots);
-  levelizeFrom(roots);
+  if (levelize_parallel_ && thread_count_ > 1)
+    levelizeParallel();
+  else {
+    if (roots.size() < 100)
+      sortRoots(roots);
+    levelizeFrom(roots);
+  }
   ensureLatchLevels();
   // Find vertices in cycles that are were not accessible from roots.
   levelizeCycles();
@@ -212,12 +227,12 @@ Levelize::visit(Vertex *vertex,
   Pin *from_pin = vertex->pin();
   debugPrint(debug_, "levelize", 3, "level %d %s",
              level, vertex->name(sdc_network_));
+  relevelize_visit_count_++;
   vertex->setColor(LevelColor::gray);
   setLevel(vertex, level);
   max_level_ = max(level, max_level_);
   level += level_space;
-  if (level >= Graph::vertex_level_max)
-    criticalError(616, "maximum logic level exceeded");
+  checkLevel(level);
 
   if (search_pred_->searchFrom(vertex)) {
     VertexOutEdgeIterator edge_iter(vertex, graph_);
@@ -253,6 +268,599 @@ Levelize::visit(Vertex *vertex,
   vertex->setColor(LevelColor::black);
 }
 
+void
+Levelize::checkLevel(Level level)
+{
+  if (level >= Graph::vertex_level_max)
+    criticalError(616, "maximum logic level exceeded");
+}
+
+void
+Levelize::levelFanouts(Vertex *vertex,
+                       VertexSeq &fanouts,
+                       EdgeSeq *latch_edges)
+{
+  if (search_pred_->searchFrom(vertex)) {
+    VertexOutEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *to_vertex = edge->to(graph_);
+      if (search_pred_->searchThru(edge)
+	  && search_pred_->searchTo(to_vertex))
+        fanouts.push_back(to_vertex);
+      if (latch_edges && edge->role() == TimingRole::latchDtoQ())
+        latch_edges->push_back(edge);
+    }
+    // Bidirect driver is levelized as a fanout of the bidirect load.
+    const Pin *from_pin = vertex->pin();
+    if (sdc_->bidirectDrvrSlewFromLoad(from_pin)
+	&& !vertex->isBidirectDriver()) {
+      Vertex *to_vertex = graph_->pinDrvrVertex(from_pin);
+      if (search_pred_->searchTo(to_vertex))
+        fanouts.push_back(to_vertex);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+// Vertices visited per thread at a time.
+static const size_t levelize_chunk_size = 256;
+
+// Call func(from, to, chunk) on chunks of [0, count) in parallel.
+// There are at most count / levelize_chunk_size + 1 chunks.
+template <class FUNC>
+static void
+levelizeParallelFor(size_t count,
+                    int thread_count,
+                    DispatchQueue *dispatch_queue,
+                    FUNC func)
+{
+  if (count < levelize_chunk_size * 2)
+    func(0, count, 0);
+  else {
+    size_t chunk_size = max(levelize_chunk_size, count / thread_count + 1);
+    size_t from = 0;
+    int chunk = 0;
+    while (from < count) {
+      size_t to = std::min(from + chunk_size, count);
+      dispatch_queue->dispatch([=, &func](int) { func(from, to, chunk); });
+      from = to;
+      chunk++;
+    }
+    dispatch_queue->finishTasks();
+  }
+}
+
+// Parallel levelization.
+// Fanin counts of every vertex are found in parallel and vertices are
+// levelized one frontier at a time, where a vertex joins the frontier
+// when its last fanin is levelized (Kahn's topological sort). Loops
+// never release their vertices, so vertices in or downstream of loops
+// are levelized by the depth first search that finds and breaks loops.
+void
+Levelize::levelizeParallel()
+{
+  VertexSeq vertices;
+  VertexIterator vertex_iter(graph_);
+  while (vertex_iter.hasNext())
+    vertices.push_back(vertex_iter.next());
+  size_t id_bound = graph_->vertexIdBound();
+  std::unique_ptr<std::atomic<int>[]> pred_counts(new std::atomic<int>[id_bound]);
+  // Level of vertices that have been reached, -1 otherwise.
+  std::unique_ptr<std::atomic<Level>[]> levels(new std::atomic<Level>[id_bound]);
+  for (Vertex *vertex : vertices) {
+    VertexId vertex_id = graph_->id(vertex);
+    pred_counts[vertex_id].store(0, std::memory_order_relaxed);
+    levels[vertex_id].store(-1, std::memory_order_relaxed);
+  }
+  countPredecessors(vertices, pred_counts.get());
+  VertexSeq frontier;
+  seedParallel(vertices, pred_counts.get(), levels.get(), frontier);
+  levelizeFrontiers(frontier, pred_counts.get(), levels.get());
+
+  for (Vertex *vertex : vertices) {
+    VertexId vertex_id = graph_->id(vertex);
+    Level level = levels[vertex_id];
+    if (level >= 0 && pred_counts[vertex_id] == 0) {
+      checkLevel(level);
+      setLevel(vertex, level);
+      max_level_ = max(level, max_level_);
+      vertex->setColor(LevelColor::black);
+    }
+  }
+  levelizeLoopFanouts(vertices, pred_counts.get(), levels.get());
+}
+
+void
+Levelize::countPredecessors(VertexSeq &vertices,
+                            std::atomic<int> *pred_counts)
+{
+  levelizeParallelFor(vertices.size(), thread_count_, dispatch_queue_,
+                      [&](size_t from, size_t to, int) {
+    VertexSeq fanouts;
+    for (size_t i = from; i < to; i++) {
+      fanouts.clear();
+      levelFanouts(vertices[i], fanouts, nullptr);
+      for (Vertex *fanout : fanouts)
+        pred_counts[graph_->id(fanout)].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+}
+
+// Vertices with no fanin start at level zero. Vertices with no fanin
+// that are not roots are searched from as roots the same way
+// levelizeCycles() treats them.
+void
+Levelize::seedParallel(VertexSeq &vertices,
+                       std::atomic<int> *pred_counts,
+                       std::atomic<Level> *levels,
+                       VertexSeq &seeds)
+{
+  for (Vertex *vertex : vertices) {
+    VertexId vertex_id = graph_->id(vertex);
+    if (pred_counts[vertex_id] == 0) {
+      if (roots_->hasKey(vertex))
+        seeds.push_back(vertex);
+      else if (search_pred_->searchFrom(vertex)) {
+        roots_->insert(vertex);
+        seeds.push_back(vertex);
+      }
+      else
+        continue;
+      levels[vertex_id] = 0;
+    }
+  }
+}
+
+void
+Levelize::levelizeFrontiers(VertexSeq &frontier,
+                            std::atomic<int> *pred_counts,
+                            std::atomic<Level> *levels)
+{
+  std::vector<VertexSeq> nexts;
+  std::vector<EdgeSeq> latch_edges;
+  while (!frontier.empty()) {
+    size_t chunk_count = frontier.size() / levelize_chunk_size + 1;
+    if (nexts.size() < chunk_count) {
+      nexts.resize(chunk_count);
+      latch_edges.resize(chunk_count);
+    }
+    levelizeParallelFor(frontier.size(), thread_count_, dispatch_queue_,
+                        [&](size_t from, size_t to, int chunk) {
+      levelizeFrontier(frontier, from, to, pred_counts, levels,
+                       nexts[chunk], latch_edges[chunk]);
+    });
+    frontier.clear();
+    for (VertexSeq &next : nexts) {
+      frontier.insert(frontier.end(), next.begin(), next.end());
+      next.clear();
+    }
+  }
+  for (EdgeSeq &edges : latch_edges) {
+    for (Edge *edge : edges)
+      latch_d_to_q_edges_.insert(edge);
+  }
+}
+
+void
+Levelize::levelizeFrontier(VertexSeq &frontier,
+                           size_t from,
+                           size_t to,
+                           std::atomic<int> *pred_counts,
+                           std::atomic<Level> *levels,
+                           VertexSeq &next,
+                           EdgeSeq &latch_edges)
+{
+  VertexSeq fanouts;
+  for (size_t i = from; i < to; i++) {
+    Vertex *vertex = frontier[i];
+    Level fanout_level = levels[graph_->id(vertex)] + level_space_;
+    fanouts.clear();
+    levelFanouts(vertex, fanouts, &latch_edges);
+    for (Vertex *fanout : fanouts) {
+      VertexId fanout_id = graph_->id(fanout);
+      std::atomic<Level> &level = levels[fanout_id];
+      Level prev_level = level.load(std::memory_order_relaxed);
+      while (prev_level < fanout_level
+             && !level.compare_exchange_weak(prev_level, fanout_level,
+                                             std::memory_order_relaxed))
+        ;
+      if (pred_counts[fanout_id].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        next.push_back(fanout);
+    }
+  }
+}
+
+// Vertices reached by the frontiers that still have fanins that were
+// not levelized are in or downstream of loops. Depth first search
+// from them in name order so loop breaking is stable.
+void
+Levelize::levelizeLoopFanouts(VertexSeq &vertices,
+                              std::atomic<int> *pred_counts,
+                              std::atomic<Level> *levels)
+{
+  VertexSeq loop_fanouts;
+  for (Vertex *vertex : vertices) {
+    VertexId vertex_id = graph_->id(vertex);
+    if (pred_counts[vertex_id] > 0 && levels[vertex_id] >= 0)
+      loop_fanouts.push_back(vertex);
+  }
+  sort(loop_fanouts, VertexNameLess(network_));
+  for (Vertex *vertex : loop_fanouts) {
+    Level level = levels[graph_->id(vertex)];
+    if (vertex->color() == LevelColor::white
+        || vertex->level() < level) {
+      EdgeSeq path;
+      visit(vertex, level, level_space_, path);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+// Per vertex state of the strongly connected component search,
+// indexed by vertex id.
+class LevelizeScc
+{
+public:
+  explicit LevelizeScc(size_t id_bound);
+
+  // Tarjan discovery index, -1 until the vertex is visited.
+  std::vector<int> index_;
+  std::vector<int> low_;
+  std::vector<bool> on_stack_;
+  // Component of the vertices popped off the stack, -1 otherwise.
+  std::vector<int> component_;
+  // Feedback order of the component vertices, -1 until placed.
+  std::vector<int> position_;
+  std::vector<int> member_index_;
+  std::vector<int> in_degree_;
+  std::vector<int> out_degree_;
+  // Breadth first search for the loop of a feedback edge.
+  std::vector<Edge*> from_edge_;
+  std::vector<int> search_mark_;
+  int search_count_;
+  int component_count_;
+  // Components with loops.
+  int loop_component_count_;
+  size_t largest_component_;
+  int feedback_edge_count_;
+};
+
+LevelizeScc::LevelizeScc(size_t id_bound) :
+  index_(id_bound, -1),
+  low_(id_bound, 0),
+  on_stack_(id_bound, false),
+  component_(id_bound, -1),
+  position_(id_bound, -1),
+  member_index_(id_bound, 0),
+  in_degree_(id_bound, 0),
+  out_degree_(id_bound, 0),
+  from_edge_(id_bound, nullptr),
+  search_mark_(id_bound, 0),
+  search_count_(0),
+  component_count_(0),
+  loop_component_count_(0),
+  largest_component_(0),
+  feedback_edge_count_(0)
+{
+}
+
+class LevelizeSccFrame
+{
+public:
+  LevelizeSccFrame(Vertex *vertex,
+                   const Graph *graph) :
+    vertex_(vertex),
+    edge_iter_(vertex, graph)
+  {
+  }
+
+  Vertex *vertex_;
+  VertexOutEdgeIterator edge_iter_;
+};
+
+// Find all loops with Tarjan's strongly connected component search
+// (without recursion so long loops do not overflow the stack) and
+// break each component with the feedback edges of the Eades, Lin and
+// Smyth vertex order. Levelization then finds no loops.
+// Loops through the bidirect driver to load hop are not edges, so they
+// are ignored the same way visit() ignores them.
+void
+Levelize::breakLoopsScc()
+{
+  LevelizeScc scc(graph_->vertexIdBound());
+  VertexSeq stack;
+  std::vector<LevelizeSccFrame> frames;
+  int next_index = 0;
+  auto push = [&](Vertex *vertex) {
+    VertexId vertex_id = graph_->id(vertex);
+    scc.index_[vertex_id] = next_index;
+    scc.low_[vertex_id] = next_index;
+    next_index++;
+    scc.on_stack_[vertex_id] = true;
+    stack.push_back(vertex);
+    frames.emplace_back(vertex, graph_);
+  };
+
+  VertexIterator vertex_iter(graph_);
+  while (vertex_iter.hasNext()) {
+    Vertex *root = vertex_iter.next();
+    if (scc.index_[graph_->id(root)] < 0
+        && search_pred_->searchFrom(root)) {
+      push(root);
+      while (!frames.empty()) {
+        LevelizeSccFrame &frame = frames.back();
+        Vertex *vertex = frame.vertex_;
+        VertexId vertex_id = graph_->id(vertex);
+        if (frame.edge_iter_.hasNext()) {
+          Edge *edge = frame.edge_iter_.next();
+          Vertex *to_vertex = edge->to(graph_);
+          if (sccEdge(edge, vertex, to_vertex)) {
+            VertexId to_id = graph_->id(to_vertex);
+            if (scc.index_[to_id] < 0)
+              push(to_vertex);
+            else if (scc.on_stack_[to_id])
+              scc.low_[vertex_id] = std::min(scc.low_[vertex_id],
+                                             scc.index_[to_id]);
+          }
+        }
+        else {
+          frames.pop_back();
+          if (!frames.empty()) {
+            VertexId parent_id = graph_->id(frames.back().vertex_);
+            scc.low_[parent_id] = std::min(scc.low_[parent_id],
+                                           scc.low_[vertex_id]);
+          }
+          if (scc.low_[vertex_id] == scc.index_[vertex_id]) {
+            VertexSeq members;
+            Vertex *member;
+            do {
+              member = stack.back();
+              stack.pop_back();
+              VertexId member_id = graph_->id(member);
+              scc.on_stack_[member_id] = false;
+              scc.component_[member_id] = scc.component_count_;
+              members.push_back(member);
+            } while (member != vertex);
+            breakScc(scc, members);
+            scc.component_count_++;
+          }
+        }
+      }
+    }
+  }
+  debugPrint(debug_, "levelize", 1,
+             "broke %d loops in %d components, largest %zu vertices",
+             scc.feedback_edge_count_,
+             scc.loop_component_count_,
+             scc.largest_component_);
+}
+
+void
+Levelize::breakScc(LevelizeScc &scc,
+                   VertexSeq &members)
+{
+  int component = scc.component_count_;
+  EdgeSeq feedback_edges;
+  if (members.size() == 1) {
+    Vertex *vertex = members[0];
+    VertexOutEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      if (edge->to(graph_) == vertex
+          && sccEdge(edge, vertex, vertex))
+        feedback_edges.push_back(edge);
+    }
+  }
+  else {
+    sccFeedbackOrder(scc, members);
+    // Edges that go backward in the order break every loop.
+    for (Vertex *vertex : members) {
+      int position = scc.position_[graph_->id(vertex)];
+      VertexOutEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        Vertex *to_vertex = edge->to(graph_);
+        VertexId to_id = graph_->id(to_vertex);
+        if (scc.component_[to_id] == component
+            && sccEdge(edge, vertex, to_vertex)
+            && position >= scc.position_[to_id])
+          feedback_edges.push_back(edge);
+      }
+    }
+  }
+
+  if (!feedback_edges.empty()) {
+    debugPrint(debug_, "levelize", 2, "component %zu vertices %zu loops",
+               members.size(),
+               feedback_edges.size());
+    scc.loop_component_count_++;
+    scc.largest_component_ = max(scc.largest_component_, members.size());
+    scc.feedback_edge_count_ += feedback_edges.size();
+    // Find the loops before disabling any edges so each loop can
+    // go thru the other feedback edges.
+    std::vector<EdgeSeq*> loops;
+    for (Edge *edge : feedback_edges)
+      loops.push_back(sccLoopEdges(scc, edge));
+    for (size_t i = 0; i < feedback_edges.size(); i++) {
+      Edge *edge = feedback_edges[i];
+      debugPrint(debug_, "levelize", 2, "Loop edge %s -> %s (%s)",
+                 edge->from(graph_)->name(sdc_network_),
+                 edge->to(graph_)->name(sdc_network_),
+                 edge->role()->asString());
+      breakLoop(edge, loops[i]);
+    }
+  }
+}
+
+// Order the component vertices so few edges go backward.
+// Sinks are placed at the end of the order and sources at the start.
+// With neither, the vertex with the most fanouts over fanins goes next.
+void
+Levelize::sccFeedbackOrder(LevelizeScc &scc,
+                           VertexSeq &members)
+{
+  int component = scc.component_count_;
+  for (size_t i = 0; i < members.size(); i++)
+    scc.member_index_[graph_->id(members[i])] = i;
+  for (Vertex *vertex : members) {
+    VertexOutEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *to_vertex = edge->to(graph_);
+      VertexId to_id = graph_->id(to_vertex);
+      if (to_vertex != vertex
+          && scc.component_[to_id] == component
+          && sccEdge(edge, vertex, to_vertex)) {
+        scc.out_degree_[graph_->id(vertex)]++;
+        scc.in_degree_[to_id]++;
+      }
+    }
+  }
+
+  // Out degree - in degree, then member order for stable results.
+  typedef std::pair<int, int> DeltaIndex;
+  std::priority_queue<DeltaIndex> deltas;
+  VertexSeq sinks;
+  VertexSeq sources;
+  auto enqueue = [&](Vertex *vertex) {
+    VertexId vertex_id = graph_->id(vertex);
+    int out_degree = scc.out_degree_[vertex_id];
+    int in_degree = scc.in_degree_[vertex_id];
+    if (out_degree == 0)
+      sinks.push_back(vertex);
+    else if (in_degree == 0)
+      sources.push_back(vertex);
+    else
+      deltas.push(DeltaIndex(out_degree - in_degree,
+                             -scc.member_index_[vertex_id]));
+  };
+  for (Vertex *vertex : members)
+    enqueue(vertex);
+
+  int front = 0;
+  int back = members.size() - 1;
+  for (size_t placed = 0; placed < members.size(); placed++) {
+    Vertex *vertex = nullptr;
+    while (vertex == nullptr && !sinks.empty()) {
+      Vertex *sink = sinks.back();
+      sinks.pop_back();
+      if (scc.position_[graph_->id(sink)] < 0) {
+        vertex = sink;
+        scc.position_[graph_->id(sink)] = back--;
+      }
+    }
+    while (vertex == nullptr && !sources.empty()) {
+      Vertex *source = sources.back();
+      sources.pop_back();
+      if (scc.position_[graph_->id(source)] < 0) {
+        vertex = source;
+        scc.position_[graph_->id(source)] = front++;
+      }
+    }
+    while (vertex == nullptr && !deltas.empty()) {
+      DeltaIndex delta_index = deltas.top();
+      deltas.pop();
+      Vertex *next = members[-delta_index.second];
+      VertexId next_id = graph_->id(next);
+      // Skip entries left behind by degree changes.
+      if (scc.position_[next_id] < 0
+          && scc.out_degree_[next_id] - scc.in_degree_[next_id]
+          == delta_index.first) {
+        vertex = next;
+        scc.position_[next_id] = front++;
+      }
+    }
+
+    // Remove the vertex from the degrees of its unplaced neighbors.
+    VertexOutEdgeIterator out_iter(vertex, graph_);
+    while (out_iter.hasNext()) {
+      Edge *edge = out_iter.next();
+      Vertex *to_vertex = edge->to(graph_);
+      VertexId to_id = graph_->id(to_vertex);
+      if (scc.component_[to_id] == component
+          && scc.position_[to_id] < 0
+          && sccEdge(edge, vertex, to_vertex)) {
+        scc.in_degree_[to_id]--;
+        enqueue(to_vertex);
+      }
+    }
+    VertexInEdgeIterator in_iter(vertex, graph_);
+    while (in_iter.hasNext()) {
+      Edge *edge = in_iter.next();
+      Vertex *from_vertex = edge->from(graph_);
+      VertexId from_id = graph_->id(from_vertex);
+      if (scc.component_[from_id] == component
+          && scc.position_[from_id] < 0
+          && sccEdge(edge, from_vertex, vertex)) {
+        scc.out_degree_[from_id]--;
+        enqueue(from_vertex);
+      }
+    }
+  }
+}
+
+// Shortest loop thru feedback_edge in its component.
+EdgeSeq *
+Levelize::sccLoopEdges(LevelizeScc &scc,
+                       Edge *feedback_edge)
+{
+  Vertex *from_vertex = feedback_edge->from(graph_);
+  Vertex *to_vertex = feedback_edge->to(graph_);
+  int component = scc.component_[graph_->id(from_vertex)];
+  EdgeSeq *loop_edges = new EdgeSeq;
+  if (to_vertex != from_vertex) {
+    int mark = ++scc.search_count_;
+    scc.search_mark_[graph_->id(to_vertex)] = mark;
+    VertexSeq queue;
+    queue.push_back(to_vertex);
+    bool found = false;
+    for (size_t i = 0; !found && i < queue.size(); i++) {
+      Vertex *vertex = queue[i];
+      VertexOutEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        Vertex *fanout = edge->to(graph_);
+        VertexId fanout_id = graph_->id(fanout);
+        if (scc.component_[fanout_id] == component
+            && scc.search_mark_[fanout_id] != mark
+            && sccEdge(edge, vertex, fanout)) {
+          scc.search_mark_[fanout_id] = mark;
+          scc.from_edge_[fanout_id] = edge;
+          if (fanout == from_vertex) {
+            found = true;
+            break;
+          }
+          queue.push_back(fanout);
+        }
+      }
+    }
+    for (Vertex *vertex = from_vertex; vertex != to_vertex; ) {
+      Edge *edge = scc.from_edge_[graph_->id(vertex)];
+      loop_edges->push_back(edge);
+      vertex = edge->from(graph_);
+    }
+    std::reverse(loop_edges->begin(), loop_edges->end());
+  }
+  loop_edges->push_back(feedback_edge);
+  for (Edge *edge : *loop_edges)
+    loop_edges_.insert(edge);
+  return loop_edges;
+}
+
+// Edges followed by visit().
+bool
+Levelize::sccEdge(Edge *edge,
+                  Vertex *from_vertex,
+                  Vertex *to_vertex)
+{
+  return search_pred_->searchFrom(from_vertex)
+    && search_pred_->searchThru(edge)
+    && search_pred_->searchTo(to_vertex);
+}
+
 void
 Levelize::reportPath(EdgeSeq &path) const
 {
@@ -275,14 +883,22 @@ Levelize::recordLoop(Edge *edge,
              edge->from(graph_)->name(sdc_network_),
              edge->to(graph_)->name(sdc_network_),
              edge->role()->asString());
+  breakLoop(edge, loops_ ? loopEdges(path, edge) : nullptr);
+}
+
+void
+Levelize::breakLoop(Edge *edge,
+                    EdgeSeq *loop_edges)
+{
   // Do not record loops if they have been invalidated.
   if (loops_) {
-    EdgeSeq *loop_edges = loopEdges(path, edge);
     GraphLoop *loop = new GraphLoop(loop_edges);
     loops_->push_back(loop);
     if (sdc_->dynamicLoopBreaking())
       sdc_->makeLoopExceptions(loop);
   }
+  else
+    delete loop_edges;
   // Record disabled loop edges so they can be cleared without
   // traversing the entire graph to find them.
   disabled_loop_edges_.insert(edge);
@@ -427,9 +1043,16 @@ Levelize::deleteEdgeBefore(Edge *edge)
 // This is acceptable because the BFS search that depends on the
 // levels only requires that a vertex level be greater than that of
 // its predecessors.
+// Levels that are higher than their fanins require are lowered first
+// and levels are then raised by searching forward, so only vertices
+// in the forward cone of the changed vertices whose levels change are
+// visited.
 void
 Levelize::relevelize()
 {
+  relevelize_visit_count_ = 0;
+  relevelize_change_count_ = 0;
+  lowerLevels();
   for (Vertex *vertex : *relevelize_from_) {
     debugPrint(debug_, "levelize", 1, "relevelize from %s",
                vertex->name(sdc_network_));
@@ -445,6 +1068,67 @@ Levelize::relevelize()
   ensureLatchLevels();
   levels_valid_ = true;
   relevelize_from_->clear();
+  debugPrint(debug_, "levelize", 1, "relevelize visited %d changed %d",
+             relevelize_visit_count_,
+             relevelize_change_count_);
+}
+
+// Lower levels of vertices left higher than necessary by deleted
+// fanin edges and propagate the lower levels forward.
+void
+Levelize::lowerLevels()
+{
+  VertexSeq lower;
+  for (Vertex *vertex : *relevelize_from_)
+    lower.push_back(vertex);
+  VertexSeq fanouts;
+  while (!lower.empty()) {
+    Vertex *vertex = lower.back();
+    lower.pop_back();
+    relevelize_visit_count_++;
+    Level level = faninLevel(vertex);
+    if (level < vertex->level()) {
+      debugPrint(debug_, "levelize", 3, "lower level %d %s",
+                 level, vertex->name(sdc_network_));
+      setLevel(vertex, level);
+      fanouts.clear();
+      EdgeSeq latch_edges;
+      levelFanouts(vertex, fanouts, &latch_edges);
+      for (Vertex *fanout : fanouts) {
+        if (fanout->level() > level + 1)
+          lower.push_back(fanout);
+      }
+      for (Edge *edge : latch_edges)
+        latch_d_to_q_edges_.insert(edge);
+    }
+  }
+}
+
+Level
+Levelize::faninLevel(Vertex *vertex)
+{
+  Level level = 0;
+  if (search_pred_->searchTo(vertex)) {
+    VertexInEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *from_vertex = edge->from(graph_);
+      if (search_pred_->searchFrom(from_vertex)
+          && search_pred_->searchThru(edge))
+        level = max(level, from_vertex->level() + 1);
+      // Levels of latch D and Q must stay different.
+      if (edge->role() == TimingRole::latchDtoQ())
+        latch_d_to_q_edges_.insert(edge);
+    }
+    const Pin *pin = vertex->pin();
+    if (vertex->isBidirectDriver()
+        && sdc_->bidirectDrvrSlewFromLoad(pin)) {
+      Vertex *load_vertex = graph_->pinLoadVertex(pin);
+      if (search_pred_->searchFrom(load_vertex))
+        level = max(level, load_vertex->level() + 1);
+    }
+  }
+  return level;
 }
 
 bool
@@ -461,6 +1145,7 @@ Levelize::setLevel(Vertex  *vertex,
     if (observer_)
       observer_->levelChangedBefore(vertex);
     vertex->setLevel(level);
+    relevelize_change_count_++;
   }
 }
 
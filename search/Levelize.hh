@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "NetworkClass.hh"
 #include "SdcClass.hh"
 #include "GraphClass.hh"
@@ -25,6 +27,7 @@ namespace sta {
 
 class SearchPred;
 class LevelizeObserver;
+class LevelizeScc;
 
 class Levelize : public StaState
 {
@@ -54,18 +57,62 @@ public:
   GraphLoopSeq *loops() { return loops_; }
   // Set the observer for level changes.
   void setObserver(LevelizeObserver *observer);
+  // Vertices visited by the last levelize or incremental relevelize.
+  int relevelizeVisitCount() const { return relevelize_visit_count_; }
+  // Vertex levels changed by the last levelize or incremental relevelize.
+  int relevelizeChangeCount() const { return relevelize_change_count_; }
 
 protected:
   void levelize();
   void findRoots();
   void sortRoots(VertexSeq &roots);
   void levelizeFrom(VertexSeq &roots);
+  void levelizeParallel();
+  void countPredecessors(VertexSeq &vertices,
+                         std::atomic<int> *pred_counts);
+  void seedParallel(VertexSeq &vertices,
+                    std::atomic<int> *pred_counts,
+                    std::atomic<Level> *levels,
+                    VertexSeq &seeds);
+  void levelizeFrontiers(VertexSeq &frontier,
+                         std::atomic<int> *pred_counts,
+                         std::atomic<Level> *levels);
+  void levelizeFrontier(VertexSeq &frontier,
+                        size_t from,
+                        size_t to,
+                        std::atomic<int> *pred_counts,
+                        std::atomic<Level> *levels,
+                        VertexSeq &next,
+                        EdgeSeq &latch_edges);
+  void levelizeLoopFanouts(VertexSeq &vertices,
+                           std::atomic<int> *pred_counts,
+                           std::atomic<Level> *levels);
+  void breakLoopsScc();
+  void breakScc(LevelizeScc &scc,
+                VertexSeq &members);
+  void sccFeedbackOrder(LevelizeScc &scc,
+                        VertexSeq &members);
+  EdgeSeq *sccLoopEdges(LevelizeScc &scc,
+                        Edge *feedback_edge);
+  bool sccEdge(Edge *edge,
+               Vertex *from_vertex,
+               Vertex *to_vertex);
+  // Fanouts that visit() levelizes after vertex.
+  void levelFanouts(Vertex *vertex,
+                    VertexSeq &fanouts,
+                    EdgeSeq *latch_edges);
+  void checkLevel(Level level);
   void visit(Vertex *vertex, Level level, Level level_space, EdgeSeq &path);
   void levelizeCycles();
   void relevelize();
+  void lowerLevels();
+  // Lowest level allowed by the fanins of vertex.
+  Level faninLevel(Vertex *vertex);
   void clearLoopEdges();
   void deleteLoops();
   void recordLoop(Edge *edge, EdgeSeq &path);
+  void breakLoop(Edge *edge,
+                 EdgeSeq *loop_edges);
   EdgeSeq *loopEdges(EdgeSeq &path, Edge *closing_edge);
   void ensureLatchLevels();
   void setLevel(Vertex  *vertex,
@@ -84,6 +131,8 @@ protected:
   EdgeSet disabled_loop_edges_;
   EdgeSet latch_d_to_q_edges_;
   LevelizeObserver *observer_;
+  int relevelize_visit_count_;
+  int relevelize_change_count_;
 };
 
 // Loops broken by levelization may not necessarily be combinational.
@@ -0,0 +1,175 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "LimitViolators.hh"
+
+#include <algorithm>
+
+#include "Fuzzy.hh"
+#include "Network.hh"
+#include "Search.hh"
+#include "DispatchQueue.hh"
+#include "Mutex.hh"
+#include "StaState.hh"
+
+namespace sta {
+
+// Pins checked per thread at a time.
+static const size_t limit_check_chunk_size = 1024;
+
+PinSeq
+limitCheckPins(const Network *network)
+{
+  PinSeq pins;
+  LeafInstanceIterator *inst_iter = network->leafInstanceIterator();
+  while (inst_iter->hasNext()) {
+    const Instance *inst = inst_iter->next();
+    InstancePinIterator *pin_iter = network->pinIterator(inst);
+    while (pin_iter->hasNext())
+      pins.push_back(pin_iter->next());
+    delete pin_iter;
+  }
+  delete inst_iter;
+  // Top level ports.
+  InstancePinIterator *pin_iter = network->pinIterator(network->topInstance());
+  while (pin_iter->hasNext())
+    pins.push_back(pin_iter->next());
+  delete pin_iter;
+  return pins;
+}
+
+void
+limitCheckSlacks(const PinSeq &pins,
+                 const LimitSlackFunc &slack_func,
+                 const StaState *sta,
+                 // Return value.
+                 std::vector<float> &slacks)
+{
+  size_t count = pins.size();
+  slacks.resize(count);
+  DispatchQueue *dispatch_queue = sta->dispatchQueue();
+  size_t thread_count = sta->threadCount();
+  if (dispatch_queue == nullptr
+      || thread_count <= 1
+      || count < limit_check_chunk_size * 2) {
+    for (size_t i = 0; i < count; i++)
+      slacks[i] = slack_func(pins[i], 0);
+  }
+  else {
+    size_t chunk_size = std::max(limit_check_chunk_size,
+                                 count / (thread_count * 4) + 1);
+    for (size_t from = 0; from < count; from += chunk_size) {
+      size_t to = std::min(from + chunk_size, count);
+      dispatch_queue->dispatch([=, &pins, &slack_func, &slacks] (int thread) {
+        for (size_t i = from; i < to; i++)
+          slacks[i] = slack_func(pins[i], thread);
+      });
+    }
+    dispatch_queue->finishTasks();
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+LimitViolators::LimitViolators(const StaState *sta) :
+  sta_(sta),
+  valid_(false),
+  corner_(nullptr),
+  min_max_(nullptr),
+  arrivals_invalid_count_(0),
+  violators_(sta->network()),
+  changed_pins_(sta->network())
+{
+}
+
+bool
+LimitViolators::isValid(const Corner *corner,
+                        const MinMax *min_max) const
+{
+  return valid_
+    && corner == corner_
+    && min_max == min_max_
+    && arrivals_invalid_count_ == sta_->search()->arrivalsInvalidCount();
+}
+
+PinSeq
+LimitViolators::violators(const Corner *corner,
+                          const MinMax *min_max,
+                          const LimitSlackFunc &slack_func)
+{
+  if (isValid(corner, min_max)) {
+    PinSeq changed_pins;
+    for (const Pin *pin : changed_pins_)
+      changed_pins.push_back(pin);
+    changed_pins_.clear();
+    updateViolators(changed_pins, slack_func);
+  }
+  else {
+    violators_.clear();
+    changed_pins_.clear();
+    updateViolators(limitCheckPins(sta_->network()), slack_func);
+    corner_ = corner;
+    min_max_ = min_max;
+    arrivals_invalid_count_ = sta_->search()->arrivalsInvalidCount();
+    valid_ = true;
+  }
+  PinSeq violators;
+  for (const Pin *pin : violators_)
+    violators.push_back(pin);
+  return violators;
+}
+
+void
+LimitViolators::updateViolators(const PinSeq &pins,
+                                const LimitSlackFunc &slack_func)
+{
+  std::vector<float> slacks;
+  limitCheckSlacks(pins, slack_func, sta_, slacks);
+  for (size_t i = 0; i < pins.size(); i++) {
+    const Pin *pin = pins[i];
+    float slack = slacks[i];
+    if (!fuzzyInf(slack) && slack < 0.0)
+      violators_.insert(pin);
+    else
+      violators_.erase(pin);
+  }
+}
+
+void
+LimitViolators::clear()
+{
+  valid_ = false;
+  violators_.clear();
+  changed_pins_.clear();
+}
+
+void
+LimitViolators::pinChanged(const Pin *pin)
+{
+  if (valid_) {
+    UniqueLock lock(changed_pins_lock_);
+    changed_pins_.insert(pin);
+  }
+}
+
+void
+LimitViolators::deletePinBefore(const Pin *pin)
+{
+  violators_.erase(pin);
+  changed_pins_.erase(pin);
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "NetworkClass.hh"
+
+namespace sta {
+
+class StaState;
+class Corner;
+class MinMax;
+
+// Return the slack of pin checked on thread.
+typedef std::function<float (const Pin *pin,
+                             int thread)> LimitSlackFunc;
+
+// Leaf instance pins and top level port pins in the order the
+// limit checks report them.
+PinSeq
+limitCheckPins(const Network *network);
+
+// Find the slacks of pins using the dispatch queue threads.
+void
+limitCheckSlacks(const PinSeq &pins,
+                 const LimitSlackFunc &slack_func,
+                 const StaState *sta,
+                 // Return value.
+                 std::vector<float> &slacks);
+
+// Pins violating a limit check for one corner/min_max are kept between
+// checks. Delay calculation and netlist edits report the pins that
+// change so the next check only finds the slacks of those pins.
+// Constraint changes (Search::arrivalsInvalid) make the next check
+// start over with every pin.
+class LimitViolators
+{
+public:
+  explicit LimitViolators(const StaState *sta);
+  // Return the violating pins.
+  // corner=nullptr checks all corners.
+  PinSeq violators(const Corner *corner,
+                   const MinMax *min_max,
+                   const LimitSlackFunc &slack_func);
+  void clear();
+  // Thread safe.
+  void pinChanged(const Pin *pin);
+  void deletePinBefore(const Pin *pin);
+
+protected:
+  bool isValid(const Corner *corner,
+               const MinMax *min_max) const;
+  void updateViolators(const PinSeq &pins,
+                       const LimitSlackFunc &slack_func);
+
+  const StaState *sta_;
+  bool valid_;
+  const Corner *corner_;
+  const MinMax *min_max_;
+  int arrivals_invalid_count_;
+  PinSet violators_;
+  PinSet changed_pins_;
+  std::mutex changed_pins_lock_;
+};
+
+} // namespace
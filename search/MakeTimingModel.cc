@@ -41,6 +41,8 @@
 #include "VisitPathEnds.hh"
 #include "ArcDelayCalc.hh"
 #include "ClkLatency.hh"
+#include "ExceptionPath.hh"
+#include "Tag.hh"
 
 namespace sta {
 
@@ -53,9 +55,10 @@ makeTimingModel(const char *lib_name,
                 const char *cell_name,
                 const char *filename,
                 const Corner *corner,
+                bool one_pass,
                 Sta *sta)
 {
-  MakeTimingModel maker(lib_name, cell_name, filename, corner, sta);
+  MakeTimingModel maker(lib_name, cell_name, filename, corner, one_pass, sta);
   return maker.makeTimingModel();
 }
 
@@ -63,12 +66,14 @@ MakeTimingModel::MakeTimingModel(const char *lib_name,
                                  const char *cell_name,
                                  const char *filename,
                                  const Corner *corner,
+                                 bool one_pass,
                                  Sta *sta) :
   StaState(sta),
   lib_name_(lib_name),
   cell_name_(cell_name),
   filename_(filename),
   corner_(corner),
+  one_pass_(one_pass),
   cell_(nullptr),
   min_max_(MinMax::max()),
   lib_builder_(new LibertyBuilder),
@@ -96,7 +101,10 @@ MakeTimingModel::makeTimingModel()
   sta_->searchPreamble();
   graph_ = sta_->graph();
 
-  findTimingFromInputs();
+  if (one_pass_)
+    findTimingFromInputsOnePass();
+  else
+    findTimingFromInputs();
   findClkedOutputPaths();
   findClkInsertionDelays();
 
@@ -232,6 +240,16 @@ MakeTimingModel::checkClock(Clock *clk)
 
 ////////////////////////////////////////////////////////////////
 
+static void
+mergeEndMargin(PathEnd *path_end,
+               const RiseFall *input_rf,
+               ClockEdgeDelays &margins,
+               Sta *sta);
+static const FilterInput *
+findFilterInput(const Path *path,
+                const FilterInputMap &filter_inputs,
+                const StaState *sta);
+
 class MakeEndTimingArcs : public PathEndVisitor
 {
 public:
@@ -269,40 +287,115 @@ MakeEndTimingArcs::setInputRf(const RiseFall *input_rf)
 
 void
 MakeEndTimingArcs::visit(PathEnd *path_end)
+{
+  mergeEndMargin(path_end, input_rf_, margins_, sta_);
+}
+
+// Merge the margin of a path from an input with the default arrival
+// clock to a register check into margins.
+static void
+mergeEndMargin(PathEnd *path_end,
+               const RiseFall *input_rf,
+               ClockEdgeDelays &margins,
+               Sta *sta)
 {
   Path *src_path = path_end->path();
-  const Clock *src_clk = src_path->clock(sta_);
-  const ClockEdge *tgt_clk_edge = path_end->targetClkEdge(sta_);
-  if (src_clk == sta_->sdc()->defaultArrivalClock()
+  const Clock *src_clk = src_path->clock(sta);
+  const ClockEdge *tgt_clk_edge = path_end->targetClkEdge(sta);
+  if (src_clk == sta->sdc()->defaultArrivalClock()
       && tgt_clk_edge) {
-    Network *network = sta_->network();
-    Debug *debug = sta_->debug();
-    const MinMax *min_max = path_end->minMax(sta_);
-    Arrival data_delay = src_path->arrival(sta_);
-    Delay clk_latency = path_end->targetClkDelay(sta_);
-    ArcDelay check_margin = path_end->margin(sta_);
+    Network *network = sta->network();
+    Debug *debug = sta->debug();
+    const MinMax *min_max = path_end->minMax(sta);
+    Arrival data_delay = src_path->arrival(sta);
+    Delay clk_latency = path_end->targetClkDelay(sta);
+    ArcDelay check_margin = path_end->margin(sta);
     Delay margin = min_max == MinMax::max()
       ? data_delay - clk_latency + check_margin
       : clk_latency - data_delay + check_margin;
-    float delay1 = delayAsFloat(margin, MinMax::max(), sta_);
+    float delay1 = delayAsFloat(margin, MinMax::max(), sta);
     debugPrint(debug, "make_timing_model", 2, "%s -> %s clock %s %s %s %s",
-               input_rf_->shortName(),
-               network->pathName(src_path->pin(sta_)),
+               input_rf->shortName(),
+               network->pathName(src_path->pin(sta)),
                tgt_clk_edge->name(),
                path_end->typeName(),
                min_max->asString(),
-               delayAsString(margin, sta_));
+               delayAsString(margin, sta));
     if (debug->check("make_timing_model", 3))
-      sta_->reportPathEnd(path_end);
+      sta->reportPathEnd(path_end);
 
-    RiseFallMinMax &margins = margins_[tgt_clk_edge];
+    RiseFallMinMax &edge_margins = margins[tgt_clk_edge];
     float max_margin;
     bool max_exists;
-    margins.value(input_rf_, min_max, max_margin, max_exists);
+    edge_margins.value(input_rf, min_max, max_margin, max_exists);
     // Always max margin, even for min/hold checks.
-    margins.setValue(input_rf_, min_max,
-                     max_exists ? max(max_margin, delay1) : delay1);
+    edge_margins.setValue(input_rf, min_max,
+                          max_exists ? max(max_margin, delay1) : delay1);
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+// Path ends from any of the inputs searched in one pass.
+// The filter exception in the path tag identifies the input.
+class MakeEndTimingArcsOnePass : public PathEndVisitor
+{
+public:
+  MakeEndTimingArcsOnePass(const FilterInputMap &filter_inputs,
+                           std::vector<ClockEdgeDelays> &input_margins,
+                           Sta *sta);
+  virtual PathEndVisitor *copy() const;
+  virtual void visit(PathEnd *path_end);
+
+private:
+  const FilterInputMap &filter_inputs_;
+  std::vector<ClockEdgeDelays> &input_margins_;
+  Sta *sta_;
+};
+
+MakeEndTimingArcsOnePass::
+MakeEndTimingArcsOnePass(const FilterInputMap &filter_inputs,
+                         std::vector<ClockEdgeDelays> &input_margins,
+                         Sta *sta) :
+  filter_inputs_(filter_inputs),
+  input_margins_(input_margins),
+  sta_(sta)
+{
+}
+
+PathEndVisitor *
+MakeEndTimingArcsOnePass::copy() const
+{
+  return new MakeEndTimingArcsOnePass(*this);
+}
+
+void
+MakeEndTimingArcsOnePass::visit(PathEnd *path_end)
+{
+  const FilterInput *input = findFilterInput(path_end->path(),
+                                             filter_inputs_, sta_);
+  if (input)
+    mergeEndMargin(path_end, input->input_rf,
+                   input_margins_[input->input_index], sta_);
+}
+
+static const FilterInput *
+findFilterInput(const Path *path,
+                const FilterInputMap &filter_inputs,
+                const StaState *sta)
+{
+  ExceptionStateSet *states = path->tag(sta)->states();
+  if (states) {
+    for (ExceptionState *state : *states) {
+      ExceptionPath *except = state->exception();
+      if (except->isFilter()) {
+        auto itr = filter_inputs.find(except);
+        if (itr != filter_inputs.end())
+          return &itr->second;
+      }
+    }
   }
+  return nullptr;
 }
 
 // input -> register setup/hold
@@ -364,6 +457,101 @@ MakeTimingModel::findTimingFromInput(Port *input_port)
   }
 }
 
+// Same as findTimingFromInputs but the paths from all of the inputs
+// are found with one search. Each input edge gets a separate filter
+// exception so its paths are tagged apart from the paths of the other
+// inputs. This trades the tags (memory) for the paths of every input
+// for one parallel search instead of two serial searches per input.
+void
+MakeTimingModel::findTimingFromInputsOnePass()
+{
+  search_->deleteFilteredArrivals();
+
+  Instance *top_inst = network_->topInstance();
+  Cell *top_cell = network_->cell(top_inst);
+  PinSeq input_pins;
+  ExceptionFromSeq froms;
+  CellPortBitIterator *port_iter = network_->portBitIterator(top_cell);
+  while (port_iter->hasNext()) {
+    Port *input_port = port_iter->next();
+    if (network_->direction(input_port)->isInput()) {
+      Pin *input_pin = network_->findPin(top_inst, input_port);
+      if (!sta_->isClockSrc(input_pin)) {
+        input_pins.push_back(input_pin);
+        sta_->setInputDelay(input_pin, RiseFallBoth::riseFall(),
+                            sdc_->defaultArrivalClock(),
+                            sdc_->defaultArrivalClockEdge()->transition(),
+                            nullptr, false, false, MinMaxAll::all(), true, 0.0);
+        for (RiseFall *input_rf : RiseFall::range()) {
+          PinSet *from_pins = new PinSet(network_);
+          from_pins->insert(input_pin);
+          froms.push_back(sta_->makeExceptionFrom(from_pins, nullptr, nullptr,
+                                                  input_rf->asRiseFallBoth()));
+        }
+      }
+    }
+  }
+  delete port_iter;
+
+  const FilterPathSeq &filters = search_->findFilteredArrivals(froms, false);
+  FilterInputMap filter_inputs;
+  for (size_t i = 0; i < filters.size(); i++) {
+    FilterInput &input = filter_inputs[filters[i]];
+    input.input_index = i / RiseFall::index_count;
+    input.input_rf = RiseFall::find(i % RiseFall::index_count);
+  }
+
+  std::vector<ClockEdgeDelays> input_margins(input_pins.size());
+  MakeEndTimingArcsOnePass end_visitor(filter_inputs, input_margins, sta_);
+  VertexSeq endpoints = search_->filteredEndpoints();
+  VisitPathEnds visit_ends(sta_);
+  for (Vertex *end : endpoints)
+    visit_ends.visitPathEnds(end, corner_, MinMaxAll::all(), true, &end_visitor);
+  std::vector<OutputPinDelays> input_output_delays(input_pins.size());
+  findOutputDelays(filter_inputs, input_output_delays);
+  search_->deleteFilteredArrivals();
+
+  for (size_t i = 0; i < input_pins.size(); i++) {
+    const Pin *input_pin = input_pins[i];
+    sta_->removeInputDelay(input_pin, RiseFallBoth::riseFall(),
+                           sdc_->defaultArrivalClock(),
+                           sdc_->defaultArrivalClockEdge()->transition(),
+                           MinMaxAll::all());
+    makeSetupHoldTimingArcs(input_pin, input_margins[i]);
+    makeInputOutputTimingArcs(input_pin, input_output_delays[i]);
+  }
+}
+
+void
+MakeTimingModel::findOutputDelays(const FilterInputMap &filter_inputs,
+                                  std::vector<OutputPinDelays> &input_output_delays)
+{
+  InstancePinIterator *output_iter = network_->pinIterator(network_->topInstance());
+  while (output_iter->hasNext()) {
+    Pin *output_pin = output_iter->next();
+    if (network_->direction(output_pin)->isOutput()) {
+      Vertex *output_vertex = graph_->pinLoadVertex(output_pin);
+      VertexPathIterator path_iter(output_vertex, this);
+      while (path_iter.hasNext()) {
+        PathVertex *path = path_iter.next();
+        const FilterInput *input = findFilterInput(path, filter_inputs, this);
+        if (input) {
+          const RiseFall *output_rf = path->transition(sta_);
+          const MinMax *min_max = path->minMax(sta_);
+          Arrival delay = path->arrival(sta_);
+          OutputPinDelays &output_pin_delays =
+            input_output_delays[input->input_index];
+          OutputDelays &delays = output_pin_delays[output_pin];
+          delays.delays.mergeValue(output_rf, min_max,
+                                   delayAsFloat(delay, min_max, sta_));
+          delays.rf_path_exists[input->input_rf->index()][output_rf->index()] = true;
+        }
+      }
+    }
+  }
+  delete output_iter;
+}
+
 void
 MakeTimingModel::findOutputDelays(const RiseFall *input_rf,
                                   OutputPinDelays &output_pin_delays)
@@ -27,6 +27,8 @@ makeTimingModel(const char *lib_name,
                 const char *cell_name,
                 const char *filename,
                 const Corner *corner,
+                // Search the paths from all inputs at once.
+                bool one_pass,
                 Sta *sta);
 
 } // namespace
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 #include "LibertyClass.hh"
 #include "SdcClass.hh"
@@ -43,6 +44,16 @@ public:
 typedef std::map<const ClockEdge*, RiseFallMinMax> ClockEdgeDelays;
 typedef std::map<const Pin *, OutputDelays> OutputPinDelays;
 
+// Input edge searched with a filter exception by the one pass search.
+class FilterInput
+{
+public:
+  size_t input_index;
+  const RiseFall *input_rf;
+};
+
+typedef std::map<const ExceptionPath*, FilterInput> FilterInputMap;
+
 class MakeTimingModel : public StaState
 {
 public:
@@ -50,6 +61,7 @@ public:
                   const char *cell_name,
                   const char *filename,
                   const Corner *corner,
+                  bool one_pass,
                   Sta *sta);
   ~MakeTimingModel();
   LibertyLibrary *makeTimingModel();
@@ -62,6 +74,7 @@ private:
   void checkClock(Clock *clk);
   void findTimingFromInputs();
   void findTimingFromInput(Port *input_port);
+  void findTimingFromInputsOnePass();
   void findClkedOutputPaths();
   void findClkInsertionDelays();
   void makeClkTreePaths(LibertyPort *lib_port,
@@ -70,6 +83,8 @@ private:
                         const ClkDelays &delays);
   void findOutputDelays(const RiseFall *input_rf,
                         OutputPinDelays &output_pin_delays);
+  void findOutputDelays(const FilterInputMap &filter_inputs,
+                        std::vector<OutputPinDelays> &input_output_delays);
   void makeSetupHoldTimingArcs(const Pin *input_pin,
                                const ClockEdgeDelays &clk_margins);
   void makeInputOutputTimingArcs(const Pin *input_pin,
@@ -98,6 +113,7 @@ private:
   const char *cell_name_;
   const char *filename_;
   const Corner *corner_;
+  bool one_pass_;
   LibertyLibrary *library_;
   LibertyCell *cell_;
   MinMax *min_max_;
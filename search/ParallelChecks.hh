@@ -0,0 +1,74 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "GraphClass.hh"
+#include "DispatchQueue.hh"
+#include "StaState.hh"
+
+namespace sta {
+
+// Vertices checked per thread at a time.
+static const size_t parallel_check_chunk_size = 1024;
+
+// Call visit_vertex(vertex, visitor) for each vertex using the dispatch
+// queue threads. Each chunk of vertices is visited with visitor->copy()
+// and the copies are merged into visitor with visitor->merge(copy) in
+// vertex order, so the results do not depend on the thread count.
+template <class VISITOR, class VISIT_VERTEX>
+void
+visitChecksParallel(const VertexSeq &vertices,
+                    VISITOR *visitor,
+                    const VISIT_VERTEX &visit_vertex,
+                    const StaState *sta)
+{
+  size_t count = vertices.size();
+  DispatchQueue *dispatch_queue = sta->dispatchQueue();
+  size_t thread_count = sta->threadCount();
+  if (dispatch_queue == nullptr
+      || thread_count <= 1
+      || count < parallel_check_chunk_size * 2) {
+    for (Vertex *vertex : vertices)
+      visit_vertex(vertex, visitor);
+  }
+  else {
+    size_t chunk_size = std::max(parallel_check_chunk_size,
+                                 count / (thread_count * 4) + 1);
+    size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+    std::vector<VISITOR*> visitors(chunk_count);
+    for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+      VISITOR *visitor1 = visitor->copy();
+      visitors[chunk] = visitor1;
+      size_t from = chunk * chunk_size;
+      size_t to = std::min(from + chunk_size, count);
+      dispatch_queue->dispatch([=, &vertices, &visit_vertex] (int) {
+        for (size_t i = from; i < to; i++)
+          visit_vertex(vertices[i], visitor1);
+      });
+    }
+    dispatch_queue->finishTasks();
+    for (VISITOR *visitor1 : visitors) {
+      visitor->merge(visitor1);
+      delete visitor1;
+    }
+  }
+}
+
+} // namespace
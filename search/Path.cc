@@ -293,6 +293,12 @@ Path::cmp(const Path *path1,
       TagIndex tag_index2 = path2->tagIndex(sta);
       if (tag_index1 == tag_index2)
 	return 0;
+      // Tag indices depend on the order the search threads make the
+      // tags, so order by the tag contents so that comparisons are the
+      // same for any thread count.
+      int tag_cmp = tagCmp(path1->tag(sta), path2->tag(sta), true);
+      if (tag_cmp != 0)
+        return tag_cmp;
       else if (tag_index1 < tag_index2)
 	return -1;
       else
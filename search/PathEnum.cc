@@ -87,6 +87,17 @@ DiversionGreater::operator()(Diversion *div1,
   return PathEnd::cmp(path_end1, path_end2, sta_) > 0;
 }
 
+// 64 bit FNV-1a step. Dropped paths are the cost of a hash collision,
+// so this mixes better than hashIncr.
+static size_t
+pathHashIncr(size_t hash,
+	     VertexId vertex_id)
+{
+  return (hash ^ vertex_id) * 0x100000001b3ull;
+}
+
+static const size_t path_hash_init = 0xcbf29ce484222325ull;
+
 static void
 deleteDiversionPathEnd(Diversion *div)
 {
@@ -123,6 +134,9 @@ PathEnum::insert(PathEnd *path_end)
              cmp_slack_ ? "slack" : "delay",
              delayAsString(cmp_slack_ ? path_end->slack(this) :
                            path_end->dataArrivalTime(this), this));
+  if (unique_pins_)
+    insertUniquePath(pathVertexHash(path_end->path(), nullptr,
+				    path_hash_init));
   Diversion *div = new Diversion(path_end, path_end->path());
   div_queue_.push(div);
   div_count_++;
@@ -218,6 +232,41 @@ PathEnum::reportDiversionPath(Diversion *div)
   }
 }
 
+// Hash the vertices of path back to before (inclusive) or to the
+// start of the path continuing from hash.
+size_t
+PathEnum::pathVertexHash(Path *path,
+			 Path *before,
+			 size_t hash)
+{
+  PathRef p(path);
+  while (!p.isNull()) {
+    hash = pathHashIncr(hash, p.vertexId(this));
+    if (before && Path::equal(&p, before, this))
+      break;
+    PathRef prev;
+    TimingArc *prev_arc;
+    p.prevPath(this, prev, prev_arc);
+    // Latch loops.
+    if (prev_arc && prev_arc->role() == TimingRole::latchDtoQ())
+      break;
+    p.init(prev);
+  }
+  return hash;
+}
+
+bool
+PathEnum::uniquePathSeen(size_t hash) const
+{
+  return unique_path_hashes_.hasKey(hash);
+}
+
+void
+PathEnum::insertUniquePath(size_t hash)
+{
+  unique_path_hashes_.insert(hash);
+}
+
 ////////////////////////////////////////////////////////////////
 
 class PathEnumFaninVisitor : public PathVisitor
@@ -231,7 +280,8 @@ public:
   virtual void visit(Vertex *) {}  // Not used.
   void visitFaninPathsThru(Vertex *vertex,
 			   Vertex *prev_vertex,
-			   TimingArc *prev_arc);
+			   TimingArc *prev_arc,
+			   size_t before_div_hash);
   virtual bool visitFromToPath(const Pin *from_pin,
 			       Vertex *from_vertex,
 			       const RiseFall *from_rf,
@@ -248,13 +298,15 @@ public:
 			       const PathAnalysisPt *path_ap);
 
 private:
-  void makeDivertedPathEnd(Path *after_div,
+  void makeDivertedPathEnd(PathVertex *after_div,
 			   TimingArc *div_arc,
 			   // Return values.
 			   PathEnd *&div_end,
 			   PathEnumed *&after_div_copy);
   void reportDiversion(TimingArc *div_arc,
 		       Path *after_div);
+  bool divPathIsDuplicate(PathVertex *after_div,
+			  size_t &div_hash);
 
   PathEnd *path_end_;
   Slack path_end_slack_;
@@ -266,6 +318,8 @@ private:
   Arrival before_div_arrival_;
   TimingArc *prev_arc_;
   Vertex *prev_vertex_;
+  // Hash of the path vertices from the end to before_div_.
+  size_t before_div_hash_;
   PathEnum *path_enum_;
   bool crpr_active_;
 };
@@ -283,6 +337,7 @@ PathEnumFaninVisitor::PathEnumFaninVisitor(PathEnd *path_end,
   before_div_tag_(before_div_.tag(this)),
   before_div_ap_index_(before_div_.pathAnalysisPtIndex(this)),
   before_div_arrival_(before_div_.arrival(this)),
+  before_div_hash_(0),
   path_enum_(path_enum),
   crpr_active_(sdc_->crprActive())
 {
@@ -291,7 +346,8 @@ PathEnumFaninVisitor::PathEnumFaninVisitor(PathEnd *path_end,
 void
 PathEnumFaninVisitor::visitFaninPathsThru(Vertex *vertex,
 					  Vertex *prev_vertex,
-					  TimingArc *prev_arc)
+					  TimingArc *prev_arc,
+					  size_t before_div_hash)
 {
   before_div_rf_index_ = before_div_.rfIndex(this);
   before_div_tag_ = before_div_.tag(this);
@@ -299,6 +355,7 @@ PathEnumFaninVisitor::visitFaninPathsThru(Vertex *vertex,
   before_div_arrival_ = before_div_.arrival(this);
   prev_arc_ = prev_arc;
   prev_vertex_ = prev_vertex;
+  before_div_hash_ = before_div_hash;
   visitFaninPaths(vertex);
 }
 
@@ -337,33 +394,59 @@ PathEnumFaninVisitor::visitFromToPath(const Pin *,
       && arc != prev_arc_
       && (!unique_pins_ || from_vertex != prev_vertex_)
       && tagMatchNoCrpr(to_tag, before_div_tag_)) {
+    size_t div_hash;
     if (crpr_active_) {
-      PathEnd *div_end;
-      PathEnumed *after_div_copy;
-      // Make the diverted path end to check slack with from_path crpr.
-      makeDivertedPathEnd(from_path, arc, div_end, after_div_copy);
-      // Only enumerate paths with greater slack.
-      if (delayGreaterEqual(div_end->slack(this), path_end_slack_, this)) {
-	reportDiversion(arc, from_path);
-	path_enum_->makeDiversion(div_end, after_div_copy);
+      if (!divPathIsDuplicate(from_path, div_hash)) {
+	PathEnd *div_end;
+	PathEnumed *after_div_copy;
+	// Make the diverted path end to check slack with from_path crpr.
+	makeDivertedPathEnd(from_path, arc, div_end, after_div_copy);
+	// Only enumerate paths with greater slack.
+	if (delayGreaterEqual(div_end->slack(this), path_end_slack_, this)) {
+	  reportDiversion(arc, from_path);
+	  if (unique_pins_)
+	    path_enum_->insertUniquePath(div_hash);
+	  path_enum_->makeDiversion(div_end, after_div_copy);
+	}
+	else
+	  delete div_end;
       }
-      else
-	delete div_end;
     }
     // Only enumerate slower/faster paths.
-    else if (delayLessEqual(to_arrival, before_div_arrival_, min_max, this)) {
+    else if (delayLessEqual(to_arrival, before_div_arrival_, min_max, this)
+	     && !divPathIsDuplicate(from_path, div_hash)) {
       PathEnd *div_end;
       PathEnumed *after_div_copy;
       makeDivertedPathEnd(from_path, arc, div_end, after_div_copy);
       reportDiversion(arc, from_path);
+      if (unique_pins_)
+	path_enum_->insertUniquePath(div_hash);
       path_enum_->makeDiversion(div_end, after_div_copy);
     }
   }
   return true;
 }
 
+// With unique_pins_ check the pins of the diverted path against the
+// paths already enumerated before copying it.
+bool
+PathEnumFaninVisitor::divPathIsDuplicate(PathVertex *after_div,
+					 size_t &div_hash)
+{
+  if (unique_pins_) {
+    div_hash = path_enum_->pathVertexHash(after_div, nullptr,
+					  before_div_hash_);
+    if (path_enum_->uniquePathSeen(div_hash)) {
+      debugPrint(debug_, "path_enum", 3, "duplicate diversion %s",
+		 after_div->name(this));
+      return true;
+    }
+  }
+  return false;
+}
+
 void
-PathEnumFaninVisitor::makeDivertedPathEnd(Path *after_div,
+PathEnumFaninVisitor::makeDivertedPathEnd(PathVertex *after_div,
 					  TimingArc *div_arc,
 					  // Return values.
 					  PathEnd *&div_end,
@@ -501,6 +584,10 @@ PathEnum::makeDiversions(PathEnd *path_end,
   TimingArc *prev_arc;
   path.prevPath(this, prev_path, prev_arc);
   PathEnumFaninVisitor fanin_visitor(path_end, path, unique_pins_, this);
+  // Hash of the path vertices from the end to before.
+  size_t before_hash = unique_pins_
+    ? pathVertexHash(path_end->path(), before, path_hash_init)
+    : 0;
   while (prev_arc
          // Do not enumerate beyond latch D to Q edges.
          // This breaks latch loop paths.
@@ -511,16 +598,19 @@ PathEnum::makeDiversions(PathEnd *path_end,
     // While visiting the fanins the fanin_visitor finds the
     // previous path and arc as well as diversions.
     fanin_visitor.visitFaninPathsThru(path.vertex(this),
-                                      prev_path.vertex(this), prev_arc);
+                                      prev_path.vertex(this), prev_arc,
+                                      before_hash);
     path.init(prev_path);
     path.prevPath(this, prev_path, prev_arc);
+    if (unique_pins_)
+      before_hash = pathHashIncr(before_hash, path.vertexId(this));
   }
 }
 
 void
 PathEnum::makeDivertedPath(Path *path,
 			   Path *before_div,
-			   Path *after_div,
+			   PathVertex *after_div,
 			   TimingArc *div_arc,
 			   // Returned values.
 			   PathEnumed *&div_path,
@@ -551,17 +641,18 @@ PathEnum::makeDivertedPath(Path *path,
 
     if (first)
       div_path = copy;
-    if (Path::equal(&p, after_div, this))
-      after_div_copy = copy;
     if (Path::equal(&p, before_div, this)) {
       copy->setPrevArc(div_arc);
+      // The paths from after_div to the start of the path are search
+      // paths, so share them instead of copying them.
+      after_div_copy = new PathEnumedVertex(after_div, this);
+      copy->setPrevPath(after_div_copy);
       // Update the delays forward from before_div to the end of the path.
       updatePathHeadDelays(copies, after_div);
-      p.init(after_div);
       found_div = true;
+      break;
     }
-    else
-      p.init(prev);
+    p.init(prev);
     prev_copy = copy;
     first = false;
   }
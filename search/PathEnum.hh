@@ -20,6 +20,7 @@
 
 #include "Iterator.hh"
 #include "Vector.hh"
+#include "UnorderedSet.hh"
 #include "StaState.hh"
 #include "SearchClass.hh"
 #include "Path.hh"
@@ -33,6 +34,7 @@ class DiversionGreater;
 
 typedef Vector<Diversion*> DiversionSeq;
 typedef Vector<PathEnumed*> PathEnumedSeq;
+typedef UnorderedSet<size_t> PathHashSet;
 typedef std::priority_queue<Diversion*,DiversionSeq,
 			    DiversionGreater> DiversionQueue;
 
@@ -70,7 +72,7 @@ private:
 		     PathEnumed *after_div_copy);
   void makeDivertedPath(Path *path,
 			Path *before_div,
-			Path *after_div,
+			PathVertex *after_div,
 			TimingArc *div_arc,
 			// Returned values.
 			PathEnumed *&div_path,
@@ -86,11 +88,20 @@ private:
   Edge *divEdge(Path *before_div,
 		TimingArc *div_arc);
   void findNext();
+  size_t pathVertexHash(Path *path,
+			Path *before,
+			size_t hash);
+  bool uniquePathSeen(size_t hash) const;
+  void insertUniquePath(size_t hash);
 
   bool cmp_slack_;
   int group_count_;
   int endpoint_count_;
   bool unique_pins_;
+  // Hashes of the vertex sequences of the paths in the queue or
+  // returned when unique_pins_ is true, so diversions that repeat
+  // the pins of another path are not made.
+  PathHashSet unique_path_hashes_;
   DiversionQueue div_queue_;
   int div_count_;
   // Number of paths returned for each endpoint (limited to endpoint_count).
@@ -181,4 +181,32 @@ PathEnumed::setPrevArc(TimingArc *arc)
   prev_arc_ = arc;
 }
 
+////////////////////////////////////////////////////////////////
+
+PathEnumedVertex::PathEnumedVertex(const PathVertex *path,
+				   const StaState *sta) :
+  PathEnumed(path->vertexId(sta),
+	     path->tagIndex(sta),
+	     path->arrival(sta),
+	     nullptr,
+	     nullptr),
+  path_vertex_(path)
+{
+}
+
+void
+PathEnumedVertex::prevPath(const StaState *sta,
+			   // Return values.
+			   PathRef &prev_path,
+			   TimingArc *&prev_arc) const
+{
+  path_vertex_.prevPath(sta, prev_path, prev_arc);
+}
+
+TimingArc *
+PathEnumedVertex::prevArc(const StaState *sta) const
+{
+  return path_vertex_.prevArc(sta);
+}
+
 } // namespace
@@ -17,6 +17,8 @@
 #pragma once
 
 #include "Path.hh"
+#include "PathVertex.hh"
+#include "ObjectPool.hh"
 
 namespace sta {
 
@@ -29,6 +31,9 @@ public:
 	     Arrival arrival,
 	     PathEnumed *prev_path,
 	     TimingArc *prev_arc);
+  static void *operator new(size_t size) { return objectPoolAlloc(size); }
+  static void operator delete(void *path,
+                              size_t size) { objectPoolFree(path, size); }
   virtual void setRef(PathRef *ref) const;
   virtual bool isNull() const { return vertex_id_ == 0; }
   virtual Vertex *vertex(const StaState *sta) const;
@@ -67,6 +72,26 @@ protected:
   TagIndex tag_index_;
 };
 
+// First path of the copied part of an enumerated path.
+// The paths before it are the search paths of the vertex path it
+// was copied from, so they are shared instead of copied.
+class PathEnumedVertex : public PathEnumed
+{
+public:
+  PathEnumedVertex(const PathVertex *path,
+		   const StaState *sta);
+  virtual void prevPath(const StaState *sta,
+			// Return values.
+			PathRef &prev_path,
+			TimingArc *&prev_arc) const;
+  virtual TimingArc *prevArc(const StaState *sta) const;
+
+  using PathEnumed::prevPath;
+
+protected:
+  PathVertex path_vertex_;
+};
+
 void deletePathEnumed(PathEnumed *path);
 
 } // namespace
@@ -16,6 +16,7 @@
 
 #include "PathExpanded.hh"
 
+#include "Mutex.hh"
 #include "TimingRole.hh"
 #include "PortDirection.hh"
 #include "Network.hh"
@@ -53,12 +54,27 @@ PathExpanded::expand(const Path *path,
 		     bool expand_genclks)
 {
   const Latches *latches = sta_->latches();
+  ClkPathExpansions *clk_expansions = sta_->search()->clkPathExpansions();
   // Push the paths from the end into an array of PathRefs.
   PathRef p(path);
   PathRef last_path;
   size_t i = 0;
   bool found_start = false;
+  // Clock path to the startpoint that is being expanded.
+  PathRef clk_path;
+  size_t clk_begin = 0;
   while (!p.isNull()) {
+    if (found_start
+	&& clk_path.isNull()
+	&& !p.isEnum()
+	&& p.isClock(sta_)) {
+      if (clk_expansions->find(p, sta_, paths_, prev_arcs_)) {
+	last_path.init(paths_.back());
+	break;
+      }
+      clk_path.init(p);
+      clk_begin = paths_.size();
+    }
     PathRef prev_path;
     TimingArc *prev_arc;
     p.prevPath(sta_, prev_path, prev_arc);
@@ -96,6 +112,8 @@ PathExpanded::expand(const Path *path,
   }
   if (!found_start)
     start_index_ = i - 1;
+  if (!clk_path.isNull())
+    clk_expansions->insert(clk_path, paths_, prev_arcs_, clk_begin, sta_);
 
   if (expand_genclks)
     expandGenclk(&last_path);
@@ -241,4 +259,81 @@ PathExpanded::latchPaths(// Return values.
   }
 }
 
+////////////////////////////////////////////////////////////////
+
+ClkPathExpansionShard::ClkPathExpansionShard() :
+  epoch_(0)
+{
+}
+
+ClkPathExpansions::ClkPathExpansions() :
+  epoch_(0)
+{
+}
+
+void
+ClkPathExpansions::clear()
+{
+  epoch_++;
+}
+
+uint64_t
+ClkPathExpansions::expansionKey(const PathRef &clk_path,
+				const StaState *sta)
+{
+  return (static_cast<uint64_t>(clk_path.vertexId(sta)) << 32)
+    | clk_path.tagIndex(sta);
+}
+
+ClkPathExpansionShard &
+ClkPathExpansions::shard(uint64_t key)
+{
+  return shards_[std::hash<uint64_t>()(key) % shard_count_];
+}
+
+bool
+ClkPathExpansions::find(const PathRef &clk_path,
+			const StaState *sta,
+			// Return values.
+			PathRefSeq &paths,
+			TimingArcSeq &prev_arcs)
+{
+  uint64_t key = expansionKey(clk_path, sta);
+  ClkPathExpansionShard &shard1 = shard(key);
+  UniqueLock lock(shard1.lock_);
+  if (shard1.epoch_ == epoch_) {
+    auto itr = shard1.expansions_.find(key);
+    if (itr != shard1.expansions_.end()) {
+      const ClkPathExpansion &expansion = itr->second;
+      paths.insert(paths.end(), expansion.paths_.begin(),
+		   expansion.paths_.end());
+      prev_arcs.insert(prev_arcs.end(), expansion.prev_arcs_.begin(),
+		       expansion.prev_arcs_.end());
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+ClkPathExpansions::insert(const PathRef &clk_path,
+			  const PathRefSeq &paths,
+			  const TimingArcSeq &prev_arcs,
+			  size_t begin,
+			  const StaState *sta)
+{
+  uint64_t key = expansionKey(clk_path, sta);
+  ClkPathExpansionShard &shard1 = shard(key);
+  unsigned epoch = epoch_;
+  UniqueLock lock(shard1.lock_);
+  if (shard1.epoch_ != epoch
+      || shard1.expansions_.size() >= shard_size_max_) {
+    shard1.expansions_.clear();
+    shard1.epoch_ = epoch;
+  }
+  ClkPathExpansion &expansion = shard1.expansions_[key];
+  expansion.paths_.assign(paths.begin() + begin, paths.end());
+  expansion.prev_arcs_.assign(prev_arcs.begin() + begin, prev_arcs.end());
+}
+
 } // namespace
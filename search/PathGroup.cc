@@ -83,6 +83,9 @@ PathGroup::PathGroup(const char *name,
   min_max_(min_max),
   compare_slack_(cmp_slack),
   threshold_(min_max->initValue()),
+  parent_(nullptr),
+  shared_threshold_(min_max->initValue()),
+  sorted_(false),
   sta_(sta)
 {
 }
@@ -96,16 +99,17 @@ bool
 PathGroup::savable(PathEnd *path_end)
 {
   bool savable = false;
+  float threshold = this->threshold();
   if (compare_slack_) {
     // Crpr increases the slack, so check the slack
     // without crpr first because it is expensive to find.
     Slack slack = path_end->slackNoCrpr(sta_);
     if (!delayIsInitValue(slack, min_max_)
- 	&& delayLessEqual(slack, threshold_, sta_)
+ 	&& delayLessEqual(slack, threshold, sta_)
  	&& delayLessEqual(slack, slack_max_, sta_)) {
       // Now check with crpr.
       slack = path_end->slack(sta_);
-      savable = delayLessEqual(slack, threshold_, sta_)
+      savable = delayLessEqual(slack, threshold, sta_)
  	&& delayLessEqual(slack, slack_max_, sta_)
  	&& delayGreaterEqual(slack, slack_min_, sta_);
     }
@@ -113,7 +117,7 @@ PathGroup::savable(PathEnd *path_end)
   else {
     const Arrival &arrival = path_end->dataArrivalTime(sta_);
     savable = !delayIsInitValue(arrival, min_max_)
-      && delayGreaterEqual(arrival, threshold_, min_max_, sta_);
+      && delayGreaterEqual(arrival, threshold, min_max_, sta_);
   }
   return savable;
 }
@@ -122,45 +126,144 @@ void
 PathGroup::insert(PathEnd *path_end)
 {
   UniqueLock lock(lock_);
-  path_ends_.push_back(path_end);
-  if (group_count_ != group_count_max
-      && static_cast<int>(path_ends_.size()) > group_count_ * 2)
-    prune();
+  insert1(path_end);
 }
 
+// path_ends_ is a heap with the least critical path end on top, so
+// a full group only compares a new path end to the top of the heap
+// and never holds more than group_count path ends.
 void
-PathGroup::prune()
+PathGroup::insert1(PathEnd *path_end)
 {
-  sort();
-  VertexPathCountMap path_counts;
-  int end_count = 0;
-  for (unsigned i = 0; i < path_ends_.size(); i++) {
-    PathEnd *path_end = path_ends_[i];
-    Vertex *vertex = path_end->vertex(sta_);
-    // Squish up to endpoint_count path ends per vertex up to the front of path_ends_.
-    if (end_count < group_count_
-	&& path_counts[vertex] < endpoint_count_) {
-      path_ends_[end_count++] = path_end;
-      path_counts[vertex]++;
-    }
-    else
-      delete path_end;
+  if (group_count_ == group_count_max) {
+    path_ends_.push_back(path_end);
+    sorted_ = false;
+    return;
+  }
+  PathEndLess less(sta_);
+  if (sorted_) {
+    std::make_heap(path_ends_.begin(), path_ends_.end(), less);
+    sorted_ = false;
+  }
+  bool limit_vertex_ends = endpoint_count_ < group_count_;
+  Vertex *vertex = path_end->vertex(sta_);
+  if (limit_vertex_ends
+      && path_counts_[vertex] >= endpoint_count_)
+    replaceVertexEnd(path_end, vertex);
+  else if (static_cast<int>(path_ends_.size()) < group_count_) {
+    path_ends_.push_back(path_end);
+    std::push_heap(path_ends_.begin(), path_ends_.end(), less);
+    if (limit_vertex_ends)
+      path_counts_[vertex]++;
+  }
+  else if (!path_ends_.empty()
+           && less(path_end, path_ends_[0])) {
+    std::pop_heap(path_ends_.begin(), path_ends_.end(), less);
+    PathEnd *prune_end = path_ends_.back();
+    if (limit_vertex_ends)
+      path_counts_[prune_end->vertex(sta_)]--;
+    delete prune_end;
+    path_ends_.back() = path_end;
+    std::push_heap(path_ends_.begin(), path_ends_.end(), less);
+    if (limit_vertex_ends)
+      path_counts_[vertex]++;
+  }
+  else {
+    delete path_end;
+    return;
+  }
+  if (!path_ends_.empty()
+      && static_cast<int>(path_ends_.size()) == group_count_)
+    setThreshold(path_ends_[0]);
+}
+
+// The vertex already has endpoint_count path ends in the group, so
+// path_end can only replace the least critical of them. The path end
+// visitors limit the path ends per vertex before inserting them, so
+// this is rare.
+void
+PathGroup::replaceVertexEnd(PathEnd *path_end,
+                            Vertex *vertex)
+{
+  PathEndLess less(sta_);
+  PathEnd **prune_end = nullptr;
+  for (PathEnd *&end : path_ends_) {
+    if (end->vertex(sta_) == vertex
+        && (prune_end == nullptr
+            || less(*prune_end, end)))
+      prune_end = &end;
   }
-  path_ends_.resize(end_count);
+  if (prune_end
+      && less(path_end, *prune_end)) {
+    delete *prune_end;
+    *prune_end = path_end;
+    std::make_heap(path_ends_.begin(), path_ends_.end(), less);
+  }
+  else
+    delete path_end;
+}
 
-  // Set a threshold to the bottom of the sorted list that future
-  // inserts need to beat.
-  PathEnd *last_end = path_ends_[end_count - 1];
+// Set a threshold to the least critical path end in a full group
+// that future inserts need to beat.
+void
+PathGroup::setThreshold(PathEnd *path_end)
+{
   if (compare_slack_)
-    threshold_ = delayAsFloat(last_end->slack(sta_));
+    threshold_ = delayAsFloat(path_end->slack(sta_));
   else
-    threshold_ = delayAsFloat(last_end->dataArrivalTime(sta_));
+    threshold_ = delayAsFloat(path_end->dataArrivalTime(sta_));
+  (parent_ ? parent_ : this)->shareThreshold(threshold_);
+}
+
+// A thread group's full heap holds group_count path ends at least as
+// critical as its threshold, so the merged group never keeps a path
+// end less critical than the most critical thread threshold.
+float
+PathGroup::threshold() const
+{
+  if (parent_) {
+    float shared = parent_->shared_threshold_.load(std::memory_order_relaxed);
+    if (min_max_->compare(shared, threshold_))
+      return shared;
+  }
+  return threshold_;
+}
+
+void
+PathGroup::shareThreshold(float threshold) const
+{
+  float shared = shared_threshold_.load(std::memory_order_relaxed);
+  while (min_max_->compare(threshold, shared)
+         && !shared_threshold_.compare_exchange_weak(shared, threshold,
+                                                     std::memory_order_relaxed)) {
+  }
+}
+
+PathGroup *
+PathGroup::makeThreadGroup() const
+{
+  PathGroup *group = new PathGroup(name_, group_count_, endpoint_count_,
+                                   unique_pins_, slack_min_, slack_max_,
+                                   compare_slack_, min_max_, sta_);
+  group->threshold_ = threshold_;
+  group->parent_ = this;
+  return group;
+}
+
+void
+PathGroup::mergeThreadGroup(PathGroup *thread_group)
+{
+  UniqueLock lock(lock_);
+  for (PathEnd *path_end : thread_group->path_ends_)
+    insert1(path_end);
+  thread_group->path_ends_.clear();
+  thread_group->path_counts_.clear();
 }
 
 void
 PathGroup::pushEnds(PathEndSeq &path_ends)
 {
-  ensureSortedMaxPaths();
+  sort();
   for (PathEnd *path_end : path_ends_)
     path_ends.push_back(path_end);
 }
@@ -168,23 +271,17 @@ PathGroup::pushEnds(PathEndSeq &path_ends)
 PathGroupIterator *
 PathGroup::iterator()
 {
-  ensureSortedMaxPaths();
+  sort();
   return new PathGroupIterator(path_ends_);
 }
 
-void
-PathGroup::ensureSortedMaxPaths()
-{
-  if (static_cast<int>(path_ends_.size()) > group_count_)
-    prune();
-  else
-    sort();
-}
-
 void
 PathGroup::sort()
 {
-  sta::sort(path_ends_, PathEndLess(sta_));
+  if (!sorted_) {
+    sta::sort(path_ends_, PathEndLess(sta_));
+    sorted_ = true;
+  }
 }
 
 void
@@ -192,7 +289,10 @@ PathGroup::clear()
 {
   UniqueLock lock(lock_);
   threshold_ = min_max_->initValue();
+  shared_threshold_.store(threshold_, std::memory_order_relaxed);
   path_ends_.clear();
+  path_counts_.clear();
+  sorted_ = false;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -230,7 +330,8 @@ PathGroups::PathGroups(int group_count,
   endpoint_count_(endpoint_count),
   unique_pins_(unique_pins),
   slack_min_(slack_min),
-  slack_max_(slack_max)
+  slack_max_(slack_max),
+  have_constrained_ends_(false)
 {
   makeGroups(group_count, endpoint_count, unique_pins, slack_min, slack_max, group_names,
 	     setup, recovery, clk_gating_setup, unconstrained,
@@ -359,7 +460,7 @@ PathGroups::pathGroup(const PathEnd *path_end) const
   const MinMax *min_max = path_end->minMax(this);
   int mm_index =  min_max->index();
   // GroupPaths have precedence.
-  GroupPath *group_path = groupPathTo(path_end);
+  GroupPath *group_path = groupPathTo(path_end, this);
  if (group_path) {
    if (group_path->isDefault())
      return path_delay_[mm_index];
@@ -401,16 +502,49 @@ PathGroups::pathGroup(const PathEnd *path_end) const
   }
 }
 
+const char *
+PathGroups::pathGroupName(const PathEnd *path_end,
+                          const StaState *sta)
+{
+  GroupPath *group_path = groupPathTo(path_end, sta);
+  if (group_path) {
+    if (group_path->isDefault())
+      return path_delay_group_name_;
+    else
+      return group_path->name();
+  }
+  else if (path_end->isCheck() || path_end->isLatchCheck()) {
+    const TimingRole *check_role = path_end->checkRole(sta);
+    if (check_role == TimingRole::removal()
+	|| check_role == TimingRole::recovery())
+      return async_group_name_;
+  }
+  else if (path_end->isGatedClock())
+    return gated_clk_group_name_;
+  else if (path_end->isPathDelay()) {
+    PathDelay *path_delay = path_end->pathDelay();
+    if (path_end->targetClk(sta) == nullptr
+	|| path_delay->ignoreClkLatency())
+      return path_delay_group_name_;
+  }
+  else if (path_end->isUnconstrained())
+    return unconstrained_group_name_;
+  // Clock groups.
+  const Clock *tgt_clk = path_end->targetClk(sta);
+  return tgt_clk ? tgt_clk->name() : "";
+}
+
 GroupPath *
-PathGroups::groupPathTo(const PathEnd *path_end) const
+PathGroups::groupPathTo(const PathEnd *path_end,
+                        const StaState *sta)
 {
   const Path *path = path_end->path();
-  const Pin *pin = path->pin(this);
+  const Pin *pin = path->pin(sta);
   ExceptionPath *exception = 
-    search_->exceptionTo(ExceptionPathType::group_path, path,
-			 pin, path->transition(this),
-			 path_end->targetClkEdge(this),
-			 path->minMax(this), false, false);
+    sta->search()->exceptionTo(ExceptionPathType::group_path, path,
+			       pin, path->transition(sta),
+			       path_end->targetClkEdge(sta),
+			       path->minMax(sta), false, false);
   return dynamic_cast<GroupPath*>(exception);
 }
 
@@ -472,6 +606,7 @@ PathGroups::pushUnconstrainedPathEnds(PathEndSeq &path_ends,
 
 typedef Map<PathGroup*, PathEnd*> PathGroupEndMap;
 typedef Map<PathGroup*, PathEndSeq*> PathGroupEndsMap;
+typedef Map<PathGroup*, PathGroup*> PathGroupThreadGroupMap;
 typedef Set<PathEnd*, PathEndNoCrprLess> PathEndNoCrprSet;
 
 static bool
@@ -485,6 +620,7 @@ PathGroups::makePathEnds(ExceptionTo *to,
 			 bool sort_by_slack)
 {
   Stats stats(debug_, report_);
+  have_constrained_ends_ = false;
   makeGroupPathEnds(to, group_count_, endpoint_count_, unique_pins_,
 		    corner, min_max);
 
@@ -507,9 +643,93 @@ PathGroups::makePathEnds(ExceptionTo *to,
 
 ////////////////////////////////////////////////////////////////
 
+// Path end visitor that saves path ends in thread local copies of
+// the path groups. Each thread visits with its own copy of the visitor
+// and the thread groups are merged into the path groups after the
+// endpoints are visited.
+class PathGroupsEndVisitor : public PathEndVisitor
+{
+public:
+  PathGroupsEndVisitor(PathGroups *path_groups);
+  // Copies start with no thread groups.
+  PathGroupsEndVisitor(const PathGroupsEndVisitor &visitor);
+  virtual ~PathGroupsEndVisitor();
+  virtual bool unconstrainedSavable(PathEnd *path_end);
+  void mergeThreadGroups();
+
+protected:
+  PathGroup *threadGroup(PathGroup *group);
+  void insert(PathGroup *group,
+              PathEnd *path_end);
+
+  PathGroups *path_groups_;
+  PathGroupThreadGroupMap thread_groups_;
+};
+
+PathGroupsEndVisitor::PathGroupsEndVisitor(PathGroups *path_groups) :
+  path_groups_(path_groups)
+{
+}
+
+PathGroupsEndVisitor::PathGroupsEndVisitor(const PathGroupsEndVisitor &visitor) :
+  PathEndVisitor(visitor),
+  path_groups_(visitor.path_groups_)
+{
+}
+
+PathGroupsEndVisitor::~PathGroupsEndVisitor()
+{
+  thread_groups_.deleteContents();
+}
+
+// Unconstrained path ends can only be in the unconstrained groups
+// (group_path groups compare slacks, which they do not have).
+bool
+PathGroupsEndVisitor::unconstrainedSavable(PathEnd *path_end)
+{
+  if (path_groups_->haveConstrainedEnds())
+    return false;
+  PathGroup *group =
+    path_groups_->unconstrainedGroup(path_end->minMax(path_groups_));
+  return group
+    && threadGroup(group)->savable(path_end);
+}
+
+void
+PathGroupsEndVisitor::insert(PathGroup *group,
+                             PathEnd *path_end)
+{
+  if (!path_end->isUnconstrained())
+    path_groups_->setHaveConstrainedEnds();
+  group->insert(path_end);
+}
+
+PathGroup *
+PathGroupsEndVisitor::threadGroup(PathGroup *group)
+{
+  PathGroup *thread_group = thread_groups_.findKey(group);
+  if (thread_group == nullptr) {
+    thread_group = group->makeThreadGroup();
+    thread_groups_[group] = thread_group;
+  }
+  return thread_group;
+}
+
+void
+PathGroupsEndVisitor::mergeThreadGroups()
+{
+  for (auto group_thread_group : thread_groups_) {
+    PathGroup *group = group_thread_group.first;
+    PathGroup *thread_group = group_thread_group.second;
+    group->mergeThreadGroup(thread_group);
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
 // Visit each path end for a vertex and add the worst one in each
 // path group to the group.
-class MakePathEnds1 : public PathEndVisitor
+class MakePathEnds1 : public PathGroupsEndVisitor
 {
 public:
   MakePathEnds1(PathGroups *path_groups);
@@ -522,13 +742,12 @@ private:
   void visitPathEnd(PathEnd *path_end,
 		    PathGroup *group);
 
-  PathGroups *path_groups_;
   PathGroupEndMap ends_;
   PathEndLess cmp_;
 };
 
 MakePathEnds1::MakePathEnds1(PathGroups *path_groups) :
-  path_groups_(path_groups),
+  PathGroupsEndVisitor(path_groups),
   cmp_(path_groups)
 {
 }
@@ -544,7 +763,7 @@ MakePathEnds1::visit(PathEnd *path_end)
 {
   PathGroup *group = path_groups_->pathGroup(path_end);
   if (group)
-    visitPathEnd(path_end, group);
+    visitPathEnd(path_end, threadGroup(group));
 }
 
 void
@@ -576,7 +795,7 @@ MakePathEnds1::vertexEnd(Vertex *)
     group_iter.next(group, end);
     // visitPathEnd already confirmed slack is savable.
     if (end) {
-      group->insert(end);
+      insert(group, end);
       // Clear ends_ for next vertex.
       ends_[group] = nullptr;
     }
@@ -588,7 +807,7 @@ MakePathEnds1::vertexEnd(Vertex *)
 // Visit each path end and add it to the corresponding path group.
 // After collecting the ends do parallel path enumeration to find the
 // path ends for the group.
-class MakePathEndsAll : public PathEndVisitor
+class MakePathEndsAll : public PathGroupsEndVisitor
 {
 public:
   MakePathEndsAll(int endpoint_count,
@@ -604,17 +823,18 @@ private:
 		    PathGroup *group);
 
   int endpoint_count_;
-  PathGroups *path_groups_;
   const StaState *sta_;
   PathGroupEndsMap ends_;
-  PathEndSlackLess slack_cmp_;
+  // Slack order with ties broken by the paths so the path ends kept
+  // do not depend on the order the threads visit them.
+  PathEndLess slack_cmp_;
   PathEndNoCrprLess path_no_crpr_cmp_;
 };
 
 MakePathEndsAll::MakePathEndsAll(int endpoint_count,
 				 PathGroups *path_groups) :
+  PathGroupsEndVisitor(path_groups),
   endpoint_count_(endpoint_count),
-  path_groups_(path_groups),
   sta_(path_groups),
   slack_cmp_(path_groups),
   path_no_crpr_cmp_(path_groups)
@@ -644,19 +864,23 @@ MakePathEndsAll::visit(PathEnd *path_end)
 {
   PathGroup *group = path_groups_->pathGroup(path_end);
   if (group)
-    visitPathEnd(path_end, group);
+    visitPathEnd(path_end, threadGroup(group));
 }
 
 void
 MakePathEndsAll::visitPathEnd(PathEnd *path_end,
 			      PathGroup *group)
 {
-  PathEndSeq *ends = ends_.findKey(group);
-  if (ends == nullptr) {
-    ends = new PathEndSeq;
-    ends_[group] = ends;
+  // The group threshold only gets more critical, so a path end that is
+  // not savable now is not savable in vertexEnd.
+  if (group->savable(path_end)) {
+    PathEndSeq *ends = ends_.findKey(group);
+    if (ends == nullptr) {
+      ends = new PathEndSeq;
+      ends_[group] = ends;
+    }
+    ends->push_back(path_end->copy());
   }
-  ends->push_back(path_end->copy());
 }
 
 void
@@ -688,7 +912,7 @@ MakePathEndsAll::vertexEnd(Vertex *)
 	  // Give the group a copy of the path end because
 	  // it may delete it during pruning.
 	  if (group->savable(path_end)) {
-	    group->insert(path_end->copy());
+	    insert(group, path_end->copy());
 	    unique_ends.insert(path_end);
 	    n++;
 	  }
@@ -790,13 +1014,13 @@ void
 PathGroups::makeGroupPathEnds(ExceptionTo *to,
 			      const Corner *corner,
 			      const MinMaxAll *min_max,
-			      PathEndVisitor *visitor)
+			      PathGroupsEndVisitor *visitor)
 {
   Network *network = this->network();
   Graph *graph = this->graph();
   Search *search = this->search();
   if (exceptionToEmpty(to))
-    makeGroupPathEnds(search->endpoints(), corner, min_max, visitor);
+    makeGroupPathEnds(search->endpointSeq(), corner, min_max, visitor);
   else {
     // Only visit -to filter pins.
     VertexSet endpoints(graph_);
@@ -813,7 +1037,10 @@ PathGroups::makeGroupPathEnds(ExceptionTo *to,
 	  && search->isEndpoint(bidirect_drvr_vertex))
 	endpoints.insert(bidirect_drvr_vertex);
     }
-    makeGroupPathEnds(&endpoints, corner, min_max, visitor);
+    VertexSeq endpoint_seq;
+    for (Vertex *vertex : endpoints)
+      endpoint_seq.push_back(vertex);
+    makeGroupPathEnds(endpoint_seq, corner, min_max, visitor);
   }
 }
 
@@ -830,7 +1057,7 @@ exceptionToEmpty(ExceptionTo *to)
 class MakeEndpointPathEnds : public VertexVisitor
 {
 public:
-  MakeEndpointPathEnds(PathEndVisitor *path_end_visitor,
+  MakeEndpointPathEnds(PathGroupsEndVisitor *path_end_visitor,
 		       const Corner *corner,
 		       const MinMaxAll *min_max,
 		       const StaState *sta);
@@ -838,21 +1065,22 @@ public:
   ~MakeEndpointPathEnds();
   virtual VertexVisitor *copy() const;
   virtual void visit(Vertex *vertex);
+  void mergeThreadGroups();
 
 private:
   VisitPathEnds *visit_path_ends_;
-  PathEndVisitor *path_end_visitor_;
+  PathGroupsEndVisitor *path_end_visitor_;
   const Corner *corner_;
   const MinMaxAll *min_max_;
   const StaState *sta_;
 };
 
-MakeEndpointPathEnds::MakeEndpointPathEnds(PathEndVisitor *path_end_visitor,
+MakeEndpointPathEnds::MakeEndpointPathEnds(PathGroupsEndVisitor *path_end_visitor,
 					   const Corner *corner,
 					   const MinMaxAll *min_max,
 					   const StaState *sta) :
   visit_path_ends_(new VisitPathEnds(sta)),
-  path_end_visitor_(path_end_visitor->copy()),
+  path_end_visitor_(static_cast<PathGroupsEndVisitor*>(path_end_visitor->copy())),
   corner_(corner),
   min_max_(min_max),
   sta_(sta)
@@ -861,7 +1089,7 @@ MakeEndpointPathEnds::MakeEndpointPathEnds(PathEndVisitor *path_end_visitor,
 
 MakeEndpointPathEnds::MakeEndpointPathEnds(const MakeEndpointPathEnds &make_path_ends) :
   visit_path_ends_(new VisitPathEnds(make_path_ends.sta_)),
-  path_end_visitor_(make_path_ends.path_end_visitor_->copy()),
+  path_end_visitor_(static_cast<PathGroupsEndVisitor*>(make_path_ends.path_end_visitor_->copy())),
   corner_(make_path_ends.corner_),
   min_max_(make_path_ends.min_max_),
   sta_(make_path_ends.sta_)
@@ -887,28 +1115,44 @@ MakeEndpointPathEnds::visit(Vertex *vertex)
 				  path_end_visitor_);
 }
 
+void
+MakeEndpointPathEnds::mergeThreadGroups()
+{
+  path_end_visitor_->mergeThreadGroups();
+}
+
 ////////////////////////////////////////////////////////////////
 
 void
-PathGroups::makeGroupPathEnds(VertexSet *endpoints,
+PathGroups::makeGroupPathEnds(const VertexSeq &endpoints,
 			      const Corner *corner,
 			      const MinMaxAll *min_max,
-			      PathEndVisitor *visitor)
+			      PathGroupsEndVisitor *visitor)
 {
   if (thread_count_ == 1) {
     MakeEndpointPathEnds end_visitor(visitor, corner, min_max, this);
-    for (auto endpoint : *endpoints)
+    for (auto endpoint : endpoints)
       end_visitor.visit(endpoint);
+    end_visitor.mergeThreadGroups();
   }
   else {
     Vector<MakeEndpointPathEnds> visitors(thread_count_,
                                           MakeEndpointPathEnds(visitor, corner,
                                                                min_max, this));
-    for (auto endpoint : *endpoints) {
-      dispatch_queue_->dispatch( [endpoint, &visitors](int i)
-      { visitors[i].visit(endpoint); } );
+    // Dispatch contiguous runs of endpoints to amortize the task overhead.
+    size_t endpoint_count = endpoints.size();
+    size_t chunk_size = 64;
+    for (size_t begin = 0; begin < endpoint_count; begin += chunk_size) {
+      size_t end = std::min(begin + chunk_size, endpoint_count);
+      dispatch_queue_->dispatch( [begin, end, &endpoints, &visitors](int i)
+      { for (size_t k = begin; k < end; k++)
+          visitors[i].visit(endpoints[k]); } );
     }
     dispatch_queue_->finishTasks();
+    // Each endpoint is visited by one thread, so the per-vertex
+    // endpoint_count limit is already applied by the thread groups.
+    for (MakeEndpointPathEnds &end_visitor : visitors)
+      end_visitor.mergeThreadGroups();
   }
 }
 
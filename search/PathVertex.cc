@@ -486,13 +486,11 @@ VertexPathIterator::VertexPathIterator(Vertex *vertex,
   vertex_(vertex),
   rf_(nullptr),
   path_ap_(nullptr),
-  min_max_(nullptr)
+  min_max_(nullptr),
+  tag_group_(search_->tagGroup(vertex)),
+  arrival_index_(0)
 {
-  TagGroup *tag_group = search_->tagGroup(vertex);
-  if (tag_group) {
-    arrival_iter_.init(tag_group->arrivalMap());
-    findNext();
-  }
+  findNext();
 }
 
 // Iterate over vertex paths with the same transition and
@@ -505,13 +503,11 @@ VertexPathIterator::VertexPathIterator(Vertex *vertex,
   vertex_(vertex),
   rf_(rf),
   path_ap_(path_ap),
-  min_max_(nullptr)
+  min_max_(nullptr),
+  tag_group_(search_->tagGroup(vertex)),
+  arrival_index_(0)
 {
-  TagGroup *tag_group = search_->tagGroup(vertex);
-  if (tag_group) {
-    arrival_iter_.init(tag_group->arrivalMap());
-    findNext();
-  }
+  findNext();
 }
 
 VertexPathIterator::VertexPathIterator(Vertex *vertex,
@@ -522,13 +518,11 @@ VertexPathIterator::VertexPathIterator(Vertex *vertex,
   vertex_(vertex),
   rf_(rf),
   path_ap_(nullptr),
-  min_max_(min_max)
+  min_max_(min_max),
+  tag_group_(search_->tagGroup(vertex)),
+  arrival_index_(0)
 {
-  TagGroup *tag_group = search_->tagGroup(vertex);
-  if (tag_group) {
-    arrival_iter_.init(tag_group->arrivalMap());
-    findNext();
-  }
+  findNext();
 }
 
 VertexPathIterator::VertexPathIterator(Vertex *vertex,
@@ -540,13 +534,11 @@ VertexPathIterator::VertexPathIterator(Vertex *vertex,
   vertex_(vertex),
   rf_(rf),
   path_ap_(path_ap),
-  min_max_(min_max)
+  min_max_(min_max),
+  tag_group_(search_->tagGroup(vertex)),
+  arrival_index_(0)
 {
-  TagGroup *tag_group = search_->tagGroup(vertex);
-  if (tag_group) {
-    arrival_iter_.init(tag_group->arrivalMap());
-    findNext();
-  }
+  findNext();
 }
 
 VertexPathIterator::~VertexPathIterator()
@@ -562,10 +554,10 @@ VertexPathIterator::hasNext()
 void
 VertexPathIterator::findNext()
 {
-  while (arrival_iter_.hasNext()) {
-    Tag *tag;
-    int arrival_index;
-    arrival_iter_.next(tag, arrival_index);
+  while (tag_group_
+         && arrival_index_ < tag_group_->arrivalCount()) {
+    int arrival_index = arrival_index_++;
+    Tag *tag = tag_group_->arrivalTag(arrival_index);
     if ((rf_ == nullptr
 	 || tag->rfIndex() == rf_->index())
 	&& (path_ap_ == nullptr
@@ -53,11 +53,9 @@ PathVertexRep::PathVertexRep(const PathVertex &path,
 }
 
 PathVertexRep::PathVertexRep(VertexId vertex_id,
-			     TagIndex tag_index,
-			     bool is_enum) :
+			     TagIndex tag_index) :
   vertex_id_(vertex_id),
-  tag_index_(tag_index),
-  is_enum_(is_enum)
+  tag_index_(tag_index)
 {
 }
 
@@ -66,7 +64,6 @@ PathVertexRep::init()
 {
   vertex_id_ = 0;
   tag_index_ = tag_index_null;
-  is_enum_ = false;
 }
 
 void
@@ -75,7 +72,6 @@ PathVertexRep::init(const PathVertexRep *path)
   if (path) {
     vertex_id_ = path->vertex_id_;
     tag_index_ = path->tag_index_;
-    is_enum_ = false;
   }
   else
     init();
@@ -86,7 +82,6 @@ PathVertexRep::init(const PathVertexRep &path)
 {
   vertex_id_ = path.vertex_id_;
   tag_index_ = path.tag_index_;
-  is_enum_ = false;
 }
 
 void
@@ -98,7 +93,6 @@ PathVertexRep::init(const PathVertex *path,
   else {
     vertex_id_ = sta->graph()->id(path->vertex(sta));
     tag_index_ = path->tag(sta)->index();
-    is_enum_ = false;
   }
 }
 
@@ -111,7 +105,6 @@ PathVertexRep::init(const PathVertex &path,
   else {
     vertex_id_ = sta->graph()->id(path.vertex(sta));
     tag_index_ = path.tag(sta)->index();
-    is_enum_ = false;
   }
 }
 
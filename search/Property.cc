@@ -930,6 +930,40 @@ getProperty(const Pin *pin,
     throw PropertyUnknown("pin", property);
 }
 
+// Properties are <arrival|slack|slew>_<min|max>[_<rise|fall>].
+FloatSeq
+getPropertyFloats(const PinSeq &pins,
+                  const char *property,
+                  Sta *sta)
+{
+  StringVector tokens;
+  split(property, "_", tokens);
+  if (tokens.size() == 2 || tokens.size() == 3) {
+    const MinMax *min_max = MinMax::find(tokens[1].c_str());
+    const RiseFall *rf = nullptr;
+    if (tokens.size() == 3)
+      rf = RiseFall::find(tokens[2].c_str());
+    if (min_max
+        && (rf || tokens.size() == 2)) {
+      FloatSeq values;
+      const string &type = tokens[0];
+      if (type == "slack")
+        values = sta->pinSlacks(pins, rf, min_max);
+      else if (type == "arrival" && rf)
+        values = sta->pinArrivals(pins, rf, min_max);
+      else if (type == "slew")
+        values = sta->pinSlews(pins, rf, min_max);
+      else
+        throw PropertyUnknown("pin", property);
+      Unit *time_unit = sta->units()->timeUnit();
+      for (float &value : values)
+        value = time_unit->staToUser(value);
+      return values;
+    }
+  }
+  throw PropertyUnknown("pin", property);
+}
+
 static PropertyValue
 pinArrivalProperty(const Pin *pin,
                    const RiseFall *rf,
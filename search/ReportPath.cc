@@ -50,6 +50,7 @@
 #include "Latches.hh"
 #include "Corner.hh"
 #include "Genclks.hh"
+#include "DispatchQueue.hh"
 
 namespace sta {
 
@@ -367,6 +368,89 @@ ReportPath::reportPathEnds(PathEndSeq *ends)
   reportPathEndFooter();
 }
 
+// Path ends formatted by a thread between reports.
+static const size_t report_path_chunk_size = 32;
+
+void
+ReportPath::reportPathEndSeq(PathEndSeq *ends)
+{
+  reportPathEndHeader();
+  size_t count = ends->size();
+  if (dispatch_queue_ == nullptr
+      || thread_count_ <= 1
+      || count < report_path_chunk_size * 2) {
+    PathEnd *prev_end = nullptr;
+    for (PathEnd *end : *ends) {
+      reportPathEnd(end, prev_end);
+      prev_end = end;
+    }
+  }
+  else {
+    // Reports are made here because Report() sets the default report.
+    size_t chunk_count = thread_count_ * 2;
+    Report *default_report = Report::defaultReport();
+    std::vector<ReportLines*> reports(chunk_count);
+    std::vector<ReportPath*> report_paths(chunk_count);
+    for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+      ReportLines *report = new ReportLines(default_report);
+      ReportPath *report_path = new ReportPath(this);
+      report_path->report_ = report;
+      report_path->copyFormat(this);
+      reports[chunk] = report;
+      report_paths[chunk] = report_path;
+    }
+    // Format windows of chunk_count chunks so the formatted text
+    // does not grow with the number of path ends.
+    size_t window_size = chunk_count * report_path_chunk_size;
+    for (size_t window = 0; window < count; window += window_size) {
+      for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+        size_t from = window + chunk * report_path_chunk_size;
+        size_t to = std::min(from + report_path_chunk_size, count);
+        if (from >= to)
+          break;
+        ReportPath *report_path = report_paths[chunk];
+        dispatch_queue_->dispatch([=] (int) {
+          for (size_t i = from; i < to; i++)
+            report_path->reportPathEnd((*ends)[i],
+                                       (i > 0) ? (*ends)[i - 1] : nullptr);
+        });
+      }
+      dispatch_queue_->finishTasks();
+      for (ReportLines *report : reports) {
+        string &lines = report->lines();
+        report_->printString(lines.c_str(), lines.size());
+        lines.clear();
+      }
+    }
+    for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+      delete report_paths[chunk];
+      delete reports[chunk];
+    }
+  }
+  reportPathEndFooter();
+}
+
+void
+ReportPath::copyFormat(const ReportPath *report_path)
+{
+  format_ = report_path->format_;
+  report_input_pin_ = report_path->report_input_pin_;
+  report_net_ = report_path->report_net_;
+  no_split_ = report_path->no_split_;
+  setDigits(report_path->digits_);
+  report_sigmas_ = report_path->report_sigmas_;
+  start_end_pt_width_ = report_path->start_end_pt_width_;
+  ReportFieldSeq fields;
+  for (const ReportField *field : report_path->fields_) {
+    ReportField *field1 = findField(field->name());
+    field1->setProperties(field->title(), field->width(),
+                          field->leftJustify());
+    field1->setEnabled(field->enabled());
+    fields.push_back(field1);
+  }
+  fields_ = fields;
+}
+
 void
 ReportPath::reportEndpointHeader(PathEnd *end,
 				 PathEnd *prev_end)
@@ -63,6 +63,12 @@ public:
   void reportPathEnd(PathEnd *end,
 		     PathEnd *prev_end);
   void reportPathEnds(PathEndSeq *ends);
+  // Header, reportPathEnd of each end and footer.
+  // Path ends are formatted on the dispatch queue threads and
+  // reported in order.
+  void reportPathEndSeq(PathEndSeq *ends);
+  // Copy the format, field order and field properties of report_path.
+  void copyFormat(const ReportPath *report_path);
   void reportPath(const Path *path);
 
   void reportShort(const PathEndUnconstrained *end);
@@ -18,8 +18,13 @@
 
 #include <algorithm>
 #include <cmath> // abs
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Mutex.hh"
+#include "DispatchQueue.hh"
 #include "Report.hh"
 #include "Debug.hh"
 #include "Stats.hh"
@@ -60,7 +65,12 @@
 #include "WorstSlack.hh"
 #include "Latches.hh"
 #include "Crpr.hh"
+#include "ClkLatency.hh"
+#include "DerateIndex.hh"
+#include "PathExpanded.hh"
 #include "Genclks.hh"
+#include "SearchStats.hh"
+#include "MemoryStats.hh"
 
 namespace sta {
 
@@ -187,6 +197,44 @@ SearchThru::searchThru(Edge *edge)
     && loopEnabled(edge, sdc, graph, search);
 }
 
+// SearchThru unless
+//  outside the -to fanin cone of a filtered search
+class ArrivalSearchThru : public SearchThru
+{
+public:
+  ArrivalSearchThru(TagGroupBldr *tag_bldr,
+                    const StaState *sta);
+  virtual bool searchTo(const Vertex *to_vertex);
+};
+
+ArrivalSearchThru::ArrivalSearchThru(TagGroupBldr *tag_bldr,
+                                     const StaState *sta) :
+  SearchThru(tag_bldr, sta)
+{
+}
+
+bool
+ArrivalSearchThru::searchTo(const Vertex *to_vertex)
+{
+  return SearchThru::searchTo(to_vertex)
+    && sta_->search()->inFilterToCone(to_vertex);
+}
+
+// Search::search_adj_ is a SearchThru predicate; bind its calls for
+// the BFS enqueue edge loops.
+static BoundSearchPred<SearchThru>
+boundSearchThru(SearchPred *pred)
+{
+  return BoundSearchPred<SearchThru>(static_cast<SearchThru*>(pred));
+}
+
+// ArrivalVisitor::adj_pred_ is an ArrivalSearchThru predicate.
+static BoundSearchPred<ArrivalSearchThru>
+boundArrivalSearchThru(SearchPred *pred)
+{
+  return BoundSearchPred<ArrivalSearchThru>(static_cast<ArrivalSearchThru*>(pred));
+}
+
 ClkArrivalSearchPred::ClkArrivalSearchPred(const StaState *sta) :
   EvalPred(sta)
 {
@@ -217,16 +265,21 @@ Search::init(StaState *sta)
   search_adj_ = new SearchThru(nullptr, sta);
   eval_pred_ = new EvalPred(sta);
   check_crpr_ = new CheckCrpr(sta);
+  clk_latency_index_ = new ClkLatencyIndex(sta);
+  derate_index_ = new DerateIndex(sta);
+  clk_path_expansions_ = new ClkPathExpansions;
   genclks_ = new Genclks(sta);
   arrival_visitor_ = new ArrivalVisitor(sta);
   clk_arrivals_valid_ = false;
   arrivals_exist_ = false;
+  arrivals_invalid_count_ = 0;
+  invalid_count_ = 0;
   arrivals_at_endpoints_exist_ = false;
   arrivals_seeded_ = false;
   requireds_exist_ = false;
   requireds_seeded_ = false;
-  invalid_arrivals_ = new VertexSet(graph_);
-  invalid_requireds_ = new VertexSet(graph_);
+  invalid_arrivals_ = new ConcurrentIdSet;
+  invalid_requireds_ = new VertexUnorderedSet(graph_);
   invalid_tns_ = new VertexSet(graph_);
   tns_exists_ = false;
   worst_slacks_ = nullptr;
@@ -234,23 +287,28 @@ Search::init(StaState *sta)
   required_iter_ = new BfsBkwdIterator(BfsIndex::required, search_adj_, sta);
   tag_capacity_ = 127;
   tag_set_ = new TagSet(tag_capacity_);
-  clk_info_set_ = new ClkInfoSet(ClkInfoLess(sta));
+  for (int i = 0; i < clk_info_shard_count_; i++)
+    clk_info_sets_[i] = new ClkInfoSet(ClkInfoLess(sta));
   tag_next_ = 0;
   tags_ = new Tag*[tag_capacity_];
   tag_group_capacity_ = 127;
   tag_groups_ = new TagGroup*[tag_group_capacity_];
   tag_group_next_ = 0;
   tag_group_set_ = new TagGroupSet(tag_group_capacity_);
-  pending_latch_outputs_ = new VertexSet(graph_);
+  pending_latch_outputs_ = new ConcurrentIdSet;
   visit_path_ends_ = new VisitPathEnds(this);
   gated_clk_ = new GatedClk(this);
   path_groups_ = nullptr;
   endpoints_ = nullptr;
   invalid_endpoints_ = nullptr;
+  endpoint_seq_valid_ = false;
   filter_ = nullptr;
   filter_from_ = nullptr;
   filter_to_ = nullptr;
-  filtered_arrivals_ = new VertexSet(graph_);
+  filtered_arrivals_ = new VertexUnorderedSet(graph_);
+  filter_to_cone_ = new ConcurrentIdSet;
+  filter_bounded_ = false;
+  filter_repeated_ = false;
   found_downstream_clk_pins_ = false;
 }
 
@@ -261,6 +319,8 @@ Search::initVars()
   unconstrained_paths_ = false;
   crpr_path_pruning_enabled_ = true;
   crpr_approx_missing_requireds_ = true;
+  crpr_prune_margin_ = 0.0;
+  required_tolerance_ = 0.0;
 }
 
 Search::~Search()
@@ -268,7 +328,8 @@ Search::~Search()
   deletePaths();
   deleteTags();
   delete tag_set_;
-  delete clk_info_set_;
+  for (int i = 0; i < clk_info_shard_count_; i++)
+    delete clk_info_sets_[i];
   delete [] tags_;
   delete [] tag_groups_;
   delete tag_group_set_;
@@ -287,8 +348,12 @@ Search::~Search()
   delete gated_clk_;
   delete worst_slacks_;
   delete check_crpr_;
+  delete clk_latency_index_;
+  delete derate_index_;
+  delete clk_path_expansions_;
   delete genclks_;
   delete filtered_arrivals_;
+  delete filter_to_cone_;
   deleteFilter();
   deletePathGroups();
 }
@@ -297,6 +362,7 @@ void
 Search::clear()
 {
   initVars();
+  invalid_count_++;
 
   clk_arrivals_valid_ = false;
   arrivals_at_endpoints_exist_ = false;
@@ -317,6 +383,8 @@ Search::clear()
   clearPendingLatchOutputs();
   deleteFilter();
   genclks_->clear();
+  gated_clk_->clear();
+  derate_index_->clear();
   found_downstream_clk_pins_ = false;
 }
 
@@ -344,6 +412,46 @@ Search::setCrprApproxMissingRequireds(bool enabled)
   crpr_approx_missing_requireds_ = enabled;
 }
 
+void
+Search::setCrprPruneMargin(float margin)
+{
+  crpr_prune_margin_ = margin;
+}
+
+void
+Search::setRequiredTolerance(float tolerance)
+{
+  required_tolerance_ = tolerance;
+}
+
+void
+Search::copyOptions(const Search *search)
+{
+  if (search->crpr_path_pruning_enabled_ != crpr_path_pruning_enabled_
+      || search->crpr_approx_missing_requireds_ != crpr_approx_missing_requireds_
+      || search->crpr_prune_margin_ != crpr_prune_margin_)
+    arrivalsInvalid();
+  crpr_path_pruning_enabled_ = search->crpr_path_pruning_enabled_;
+  crpr_approx_missing_requireds_ = search->crpr_approx_missing_requireds_;
+  crpr_prune_margin_ = search->crpr_prune_margin_;
+  required_tolerance_ = search->required_tolerance_;
+}
+
+bool
+Search::isIdle() const
+{
+  return arrival_iter_->empty()
+    && required_iter_->empty()
+    && filter_ == nullptr
+    && filters_.empty();
+}
+
+void
+Search::pathsReleased()
+{
+  arrivals_exist_ = false;
+}
+
 void
 Search::deleteTags()
 {
@@ -358,13 +466,18 @@ Search::deleteTags()
   tag_next_ = 0;
   tag_set_->deleteContentsClear();
   tag_free_indices_.clear();
+  tag_states_.deleteContentsClear();
 
-  clk_info_set_->deleteContentsClear();
+  for (int i = 0; i < clk_info_shard_count_; i++)
+    clk_info_sets_[i]->deleteContentsClear();
 }
 
 void
 Search::deleteFilter()
 {
+  for (FilterPath *filter : filters_)
+    sdc_->deleteException(filter);
+  filters_.clear();
   if (filter_) {
     sdc_->deleteException(filter_);
     filter_ = nullptr;
@@ -377,6 +490,7 @@ Search::deleteFilter()
   }
   delete filter_to_;
   filter_to_ = nullptr;
+  filter_to_cone_->clear();
 }
 
 void
@@ -390,6 +504,8 @@ Search::copyState(const StaState *sta)
   visit_path_ends_->copyState(sta);
   gated_clk_->copyState(sta);
   check_crpr_->copyState(sta);
+  clk_latency_index_->copyState(sta);
+  derate_index_->copyState(sta);
   genclks_->copyState(sta);
 }
 
@@ -409,6 +525,9 @@ Search::deletePaths()
     graph_->clearArrivals();
     graph_->clearPrevPaths();
     arrivals_exist_ = false;
+    check_crpr_->clearCache();
+    clk_path_expansions_->clear();
+    clk_latency_index_->clear();
   }
 }
 
@@ -418,7 +537,31 @@ Search::deletePaths(Vertex *vertex)
   tnsNotifyBefore(vertex);
   if (worst_slacks_)
     worst_slacks_->worstSlackNotifyBefore(vertex);
-  vertex->deletePaths();
+  deleteVertexPaths(vertex);
+  check_crpr_->clearCache();
+  clk_path_expansions_->clear();
+  if (vertex->isRegClk())
+    clk_latency_index_->sinkInvalid(vertex);
+}
+
+// Return the vertex path arrays to the graph array table free lists.
+void
+Search::deleteVertexPaths(Vertex *vertex)
+{
+  TagGroup *tag_group = tagGroup(vertex);
+  if (tag_group)
+    graph_->deletePaths(vertex, tag_group->arrivalCount());
+  else
+    vertex->deletePaths();
+}
+
+void
+Search::compactPaths()
+{
+  graph_->compactPaths([this] (Vertex *vertex) {
+    TagGroup *tag_group = tagGroup(vertex);
+    return tag_group ? tag_group->arrivalCount() : 0;
+  });
 }
 
 ////////////////////////////////////////////////////////////////
@@ -472,11 +615,24 @@ Search::findFilteredArrivals(ExceptionFrom *from,
                              bool unconstrained,
                              bool thru_latches)
 {
-  unconstrained_paths_ = unconstrained;
   // Delete results from last findPathEnds.
   // Filtered arrivals are deleted by Sta::searchPreamble.
   deletePathGroups();
   checkFromThrusTo(from, thrus, to);
+  if (filter_
+      && filterMatches(from, thrus, unconstrained)) {
+    debugPrint(debug_, "search", 1, "reuse filtered arrivals");
+    // filter_ has equivalent from/thrus.
+    delete from;
+    if (thrus) {
+      thrus->deleteContents();
+      delete thrus;
+    }
+    delete filter_to_;
+    filter_to_ = to;
+    return;
+  }
+  unconstrained_paths_ = unconstrained;
   filter_from_ = from;
   filter_to_ = to;
   if ((from
@@ -493,6 +649,56 @@ Search::findFilteredArrivals(ExceptionFrom *from,
     findAllArrivals(thru_latches);
 }
 
+const FilterPathSeq &
+Search::findFilteredArrivals(const ExceptionFromSeq &froms,
+                             bool thru_latches)
+{
+  unconstrained_paths_ = false;
+  deletePathGroups();
+  for (ExceptionFrom *from : froms)
+    filters_.push_back(sdc_->makeFilterPath(from, nullptr, nullptr));
+  findFilteredArrivals(thru_latches);
+  return filters_;
+}
+
+void
+Search::deleteFilteredArrivals(ExceptionFrom *from,
+                               ExceptionThruSeq *thrus,
+                               bool unconstrained)
+{
+  if (filter_
+      && filterMatches(from, thrus, unconstrained)) {
+    if (!filter_bounded_
+        && arrivalsValid())
+      return;
+    filter_repeated_ = true;
+  }
+  else
+    filter_repeated_ = false;
+  deleteFilteredArrivals();
+}
+
+bool
+Search::filterMatches(ExceptionFrom *from,
+                      ExceptionThruSeq *thrus,
+                      bool unconstrained) const
+{
+  ExceptionFrom *filter_from = filter_->from();
+  ExceptionThruSeq *filter_thrus = filter_->thrus();
+  size_t thru_count = thrus ? thrus->size() : 0;
+  size_t filter_thru_count = filter_thrus ? filter_thrus->size() : 0;
+  if (unconstrained != unconstrained_paths_
+      || (from == nullptr) != (filter_from == nullptr)
+      || (from && !from->equal(filter_from))
+      || thru_count != filter_thru_count)
+    return false;
+  for (size_t i = 0; i < thru_count; i++) {
+    if (!(*thrus)[i]->equal((*filter_thrus)[i]))
+      return false;
+  }
+  return true;
+}
+
 // From/thrus/to are used to make a filter exception.  If the last
 // search used a filter arrival/required times were only found for a
 // subset of the paths.  Delete the paths that have a filter
@@ -500,12 +706,13 @@ Search::findFilteredArrivals(ExceptionFrom *from,
 void
 Search::deleteFilteredArrivals()
 {
-  if (filter_) {
-    ExceptionFrom *from = filter_->from();
-    ExceptionThruSeq *thrus = filter_->thrus();
-    if ((from
-	 && (from->pins()
-	     || from->instances()))
+  if (filter_ || !filters_.empty()) {
+    ExceptionFrom *from = filter_ ? filter_->from() : nullptr;
+    ExceptionThruSeq *thrus = filter_ ? filter_->thrus() : nullptr;
+    if (!filters_.empty()
+        || (from
+            && (from->pins()
+                || from->instances()))
 	|| thrus) {
       for (Vertex *vertex : *filtered_arrivals_) {
         if (isClock(vertex))
@@ -557,27 +764,38 @@ Search::deleteFilterTagGroups()
 void
 Search::deleteFilterTags()
 {
+  // Filter state sets are only used by filter tags.
+  std::set<ExceptionStateSet*> filter_states;
   for (TagIndex i = 0; i < tag_next_; i++) {
     Tag *tag = tags_[i];
     if (tag
 	&& tag->isFilter()) {
       tags_[i] = nullptr;
       tag_set_->erase(tag);
+      filter_states.insert(tag->states());
       delete tag;
       tag_free_indices_.push_back(i);
     }
   }
+  // Erase before the filter exception states are deleted.
+  for (ExceptionStateSet *states : filter_states) {
+    tag_states_.erase(states);
+    delete states;
+  }
 }
 
 void
 Search::deleteFilterClkInfos()
 {
-  ClkInfoSet::Iterator clk_info_iter(clk_info_set_);
-  while (clk_info_iter.hasNext()) {
-    ClkInfo *clk_info = clk_info_iter.next();
-    if (clk_info->refsFilter(this)) {
-      clk_info_set_->erase(clk_info);
-      delete clk_info;
+  for (int i = 0; i < clk_info_shard_count_; i++) {
+    ClkInfoSet *clk_info_set = clk_info_sets_[i];
+    ClkInfoSet::Iterator clk_info_iter(clk_info_set);
+    while (clk_info_iter.hasNext()) {
+      ClkInfo *clk_info = clk_info_iter.next();
+      if (clk_info->refsFilter(this)) {
+        clk_info_set->erase(clk_info);
+        delete clk_info;
+      }
     }
   }
 }
@@ -587,6 +805,12 @@ Search::findFilteredArrivals(bool thru_latches)
 {
   filtered_arrivals_->clear();
   findArrivalsSeed();
+  // Unfiltered arrivals outside of the -to cone are only up to date
+  // if there are no invalid arrivals to search.
+  filter_bounded_ = false;
+  if (arrival_iter_->empty()
+      && !filter_repeated_)
+    findFilterToCone();
   seedFilterStarts();
   Level max_level = levelize_->maxLevel();
   // Search always_to_endpoint to search from exisiting arrivals at
@@ -599,11 +823,67 @@ Search::findFilteredArrivals(bool thru_latches)
     debugPrint(debug_, "search", 1, "find arrivals pass %d", pass);
     int arrival_count = arrival_iter_->visitParallel(max_level,
 						     arrival_visitor_);
+    if (arrival_count > 0) {
+      check_crpr_->clearCache();
+      clk_path_expansions_->clear();
+    }
     debugPrint(debug_, "search", 1, "found %d arrivals", arrival_count);
   }
+  filter_to_cone_->clear();
   arrivals_exist_ = true;
 }
 
+// Find the fanin cone of the -to pins so the filtered search does not
+// propagate filter tags to vertices that cannot reach them.
+void
+Search::findFilterToCone()
+{
+  filter_to_cone_->clear();
+  if (filter_to_
+      && !filter_to_->hasClocks()
+      && (filter_to_->hasPins()
+          || filter_to_->hasInstances())) {
+    VertexSeq queue;
+    for (const Pin *pin : filter_to_->allPins(network_)) {
+      Vertex *vertex, *bidirect_drvr_vertex;
+      graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+      if (vertex == nullptr) {
+        // Hierarchical pin.
+        filter_to_cone_->clear();
+        return;
+      }
+      if (filter_to_cone_->insert(graph_->id(vertex)))
+        queue.push_back(vertex);
+      if (bidirect_drvr_vertex
+          && filter_to_cone_->insert(graph_->id(bidirect_drvr_vertex)))
+        queue.push_back(bidirect_drvr_vertex);
+    }
+    while (!queue.empty()) {
+      Vertex *vertex = queue.back();
+      queue.pop_back();
+      VertexInEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        if (!edge->role()->isTimingCheck()) {
+          Vertex *from_vertex = edge->from(graph_);
+          if (filter_to_cone_->insert(graph_->id(from_vertex)))
+            queue.push_back(from_vertex);
+        }
+      }
+    }
+    filter_bounded_ = !filter_to_cone_->empty();
+    debugPrint(debug_, "search", 1, "filter -to cone %zu vertices",
+               filter_to_cone_->size());
+  }
+}
+
+bool
+Search::inFilterToCone(const Vertex *vertex) const
+{
+  return filter_to_cone_->empty()
+    || filter_to_cone_->hasKey(graph_->id(vertex));
+}
+
 VertexSeq
 Search::filteredEndpoints()
 {
@@ -612,6 +892,7 @@ Search::filteredEndpoints()
     if (isEndpoint(vertex))
       ends.push_back(vertex);
   }
+  sort(ends, VertexIdLess(graph_));
   return ends;
 }
 
@@ -651,7 +932,16 @@ SeedFaninsThruHierPin::visit(const Pin *drvr,
 void
 Search::seedFilterStarts()
 {
-  ExceptionPt *first_pt = filter_->firstPt();
+  if (filter_)
+    seedFilterStarts(filter_);
+  for (FilterPath *filter : filters_)
+    seedFilterStarts(filter);
+}
+
+void
+Search::seedFilterStarts(FilterPath *filter)
+{
+  ExceptionPt *first_pt = filter->firstPt();
   if (first_pt) {
     PinSet first_pins = first_pt->allPins(network_);
     for (const Pin *pin : first_pins) {
@@ -679,16 +969,19 @@ Search::deleteVertexBefore(Vertex *vertex)
   if (arrivals_exist_) {
     deletePaths(vertex);
     arrival_iter_->deleteVertexBefore(vertex);
-    invalid_arrivals_->erase(vertex);
+    invalid_arrivals_->erase(graph_->id(vertex));
+    pending_latch_outputs_->erase(graph_->id(vertex));
     filtered_arrivals_->erase(vertex);
+    clk_latency_index_->deleteVertexBefore(vertex);
   }
   if (requireds_exist_) {
     required_iter_->deleteVertexBefore(vertex);
     invalid_requireds_->erase(vertex);
     invalid_tns_->erase(vertex);
   }
-  if (endpoints_)
-    endpoints_->erase(vertex);
+  if (endpoints_
+      && endpoints_->erase(vertex))
+    endpoint_seq_valid_ = false;
   if (invalid_endpoints_)
     invalid_endpoints_->erase(vertex);
 }
@@ -703,6 +996,8 @@ Search::arrivalsValid()
 void
 Search::arrivalsInvalid()
 {
+  arrivals_invalid_count_++;
+  invalid_count_++;
   if (arrivals_exist_) {
     debugPrint(debug_, "search", 1, "arrivals invalid");
     // Delete paths to make sure no state is left over.
@@ -732,6 +1027,7 @@ void
 Search::requiredsInvalid()
 {
   debugPrint(debug_, "search", 1, "requireds invalid");
+  invalid_count_++;
   requireds_exist_ = false;
   requireds_seeded_ = false;
   invalid_requireds_->clear();
@@ -746,11 +1042,9 @@ Search::arrivalInvalid(Vertex *vertex)
   if (arrivals_exist_) {
     debugPrint(debug_, "search", 2, "arrival invalid %s",
                vertex->name(sdc_network_));
-    if (!arrival_iter_->inQueue(vertex)) {
-      // Lock for StaDelayCalcObserver called by delay calc threads.
-      UniqueLock lock(invalid_arrivals_lock_);
-      invalid_arrivals_->insert(vertex);
-    }
+    invalid_count_.fetch_add(1, std::memory_order_relaxed);
+    if (!arrival_iter_->inQueue(vertex))
+      invalid_arrivals_->insert(graph_->id(vertex));
     tnsInvalid(vertex);
   }
 }
@@ -759,7 +1053,7 @@ void
 Search::arrivalInvalidDelete(Vertex *vertex)
 {
   arrivalInvalid(vertex);
-  vertex->deletePaths();
+  deleteVertexPaths(vertex);
 }
 
 void
@@ -816,6 +1110,7 @@ Search::requiredInvalid(Vertex *vertex)
   if (requireds_exist_) {
     debugPrint(debug_, "search", 2, "required invalid %s",
                vertex->name(sdc_network_));
+    invalid_count_.fetch_add(1, std::memory_order_relaxed);
     if (!required_iter_->inQueue(vertex)) {
       // Lock for StaDelayCalcObserver called by delay calc threads.
       UniqueLock lock(invalid_arrivals_lock_);
@@ -839,6 +1134,8 @@ Search::findClkArrivals()
     ClkArrivalSearchPred search_clk(this);
     arrival_visitor_->init(false, &search_clk);
     arrival_iter_->visitParallel(levelize_->maxLevel(), arrival_visitor_);
+    check_crpr_->clearCache();
+    clk_path_expansions_->clear();
     arrivals_exist_ = true;
     stats.report("Find clk arrivals");
   }
@@ -941,7 +1238,7 @@ Search::visitStartpoints(VertexVisitor *visitor)
 void
 Search::visitEndpoints(VertexVisitor *visitor)
 {
-  for (Vertex *end : *endpoints()) {
+  for (Vertex *end : endpointSeq()) {
     Pin *pin = end->pin();
     // Filter register clock pins (fails on set_max_delay -from clk_src).
     if (!network_->isRegClkPin(pin)
@@ -963,7 +1260,12 @@ Search::findAllArrivals(bool thru_latches)
 {
   arrival_visitor_->init(false);
   // Iterate until data arrivals at all latches stop changing.
-  for (int pass = 1; pass == 1 || (thru_latches && havePendingLatchOutputs()); pass++) {
+  // Pending latch outputs of a canceled update stay pending.
+  for (int pass = 1;
+       pass == 1 || (thru_latches
+                     && havePendingLatchOutputs()
+                     && !arrival_iter_->canceled());
+       pass++) {
     enqueuePendingLatchOutputs();
     debugPrint(debug_, "search", 1, "find arrivals pass %d", pass);
     findArrivals1(levelize_->maxLevel());
@@ -982,12 +1284,22 @@ Search::clearPendingLatchOutputs()
   pending_latch_outputs_->clear();
 }
 
+// Only latches with data arrivals that changed on the previous pass
+// are pending, so latch loops that have converged drop out of the
+// passes while the others are searched together.
 void
 Search::enqueuePendingLatchOutputs()
 {
-  for (Vertex *latch_vertex : *pending_latch_outputs_)
-    arrival_iter_->enqueue(latch_vertex);
-  clearPendingLatchOutputs();
+  if (!pending_latch_outputs_->empty()) {
+    SearchStats *stats = debug_->searchStats();
+    stats->incr(SearchStats::latch_passes);
+    stats->incr(SearchStats::latch_outputs_pending,
+                pending_latch_outputs_->size());
+    pending_latch_outputs_->visit([this] (VertexId vertex_id) {
+      arrival_iter_->enqueue(graph_->vertex(vertex_id));
+    });
+    clearPendingLatchOutputs();
+  }
 }
 
 void
@@ -1010,6 +1322,10 @@ Search::findArrivals1(Level level)
   findArrivalsSeed();
   Stats stats(debug_, report_);
   int arrival_count = arrival_iter_->visitParallel(level, arrival_visitor_);
+  if (arrival_count > 0) {
+    check_crpr_->clearCache();
+    clk_path_expansions_->clear();
+  }
   stats.report("Find arrivals");
   if (arrival_iter_->empty()
       && invalid_arrivals_->empty()) {
@@ -1023,6 +1339,7 @@ Search::findArrivals1(Level level)
 void
 Search::findArrivalsSeed()
 {
+  derate_index_->ensure();
   if (!arrivals_seeded_) {
     genclks_->ensureInsertionDelays();
     arrival_iter_->clear();
@@ -1059,9 +1376,10 @@ ArrivalVisitor::ArrivalVisitor(bool always_to_endpoints,
 void
 ArrivalVisitor::init0()
 {
+  path_ap_index_ = -1;
   tag_bldr_ = new TagGroupBldr(true, this);
   tag_bldr_no_crpr_ = new TagGroupBldr(false, this);
-  adj_pred_ = new SearchThru(tag_bldr_, this);
+  adj_pred_ = new ArrivalSearchThru(tag_bldr_, this);
 }
 
 void
@@ -1091,6 +1409,8 @@ ArrivalVisitor::~ArrivalVisitor()
   delete tag_bldr_;
   delete tag_bldr_no_crpr_;
   delete adj_pred_;
+  for (ArrivalVisitor *visitor : path_ap_visitors_)
+    delete visitor;
 }
 
 void
@@ -1102,22 +1422,109 @@ ArrivalVisitor::setAlwaysToEndpoints(bool to_endpoints)
 void
 ArrivalVisitor::visit(Vertex *vertex)
 {
-  debugPrint(debug_, "search", 2, "find arrivals %s",
-             vertex->name(sdc_network_));
-  Pin *pin = vertex->pin();
+  debugPrintHot(debug_, "search", 2, "find arrivals %s",
+                vertex->name(sdc_network_));
+  findFaninArrivals(vertex);
+  saveArrivals(vertex);
+}
+
+// Narrow levels leave threads idle, so split the vertex visit by path
+// analysis point. Tags of different path analysis points never match,
+// so the arrivals found for each one are simply combined.
+void
+ArrivalVisitor::visitNarrow(Vertex *vertex)
+{
+  if (search_path_ap_parallel_
+      && thread_count_ > 1
+      && dispatch_queue_
+      && corners_->pathAnalysisPtCount() > 1) {
+    debugPrintHot(debug_, "search", 2, "find arrivals %s",
+                  vertex->name(sdc_network_));
+    findFaninArrivalsParallel(vertex);
+    saveArrivals(vertex);
+  }
+  else
+    visit(vertex);
+}
+
+void
+ArrivalVisitor::findFaninArrivals(Vertex *vertex)
+{
   tag_bldr_->init(vertex);
   has_fanin_one_ = graph_->hasFaninOne(vertex);
   if (crpr_active_
       && !has_fanin_one_)
     tag_bldr_no_crpr_->init(vertex);
 
-  visitFaninPaths(vertex);
+  EvalPred *eval_pred = search_->evalPred();
+  if (pred_ == eval_pred) {
+    BoundSearchPred<EvalPred> bound_pred(eval_pred);
+    visitFaninEdges(vertex, bound_pred);
+  }
+  else
+    visitFaninPaths(vertex);
   if (crpr_active_
       && search_->crprPathPruningEnabled()
       && !vertex->crprPathPruningDisabled()
       && !has_fanin_one_)
     pruneCrprArrivals();
+}
+
+void
+ArrivalVisitor::findFaninArrivalsParallel(Vertex *vertex)
+{
+  size_t path_ap_count = corners_->pathAnalysisPtCount();
+  if (path_ap_visitors_.size() != path_ap_count) {
+    for (ArrivalVisitor *visitor : path_ap_visitors_)
+      delete visitor;
+    path_ap_visitors_.clear();
+    for (size_t i = 0; i < path_ap_count; i++) {
+      ArrivalVisitor *visitor = new ArrivalVisitor(always_to_endpoints_,
+                                                   pred_, this);
+      visitor->path_ap_index_ = i;
+      path_ap_visitors_.push_back(visitor);
+    }
+  }
+  for (ArrivalVisitor *visitor : path_ap_visitors_) {
+    // Pick up changes to the state and init since the last visit.
+    visitor->copyState(this);
+    visitor->init(always_to_endpoints_, pred_);
+    dispatch_queue_->dispatch([visitor, vertex] (int) {
+      visitor->findFaninArrivals(vertex);
+    });
+  }
+  dispatch_queue_->finishTasks();
+
+  tag_bldr_->init(vertex);
+  for (ArrivalVisitor *visitor : path_ap_visitors_)
+    tag_bldr_->addArrivals(visitor->tag_bldr_);
+}
 
+bool
+ArrivalVisitor::visitFromPath(const Pin *from_pin,
+                              Vertex *from_vertex,
+                              const RiseFall *from_rf,
+                              PathVertex *from_path,
+                              Edge *edge,
+                              TimingArc *arc,
+                              const Pin *to_pin,
+                              Vertex *to_vertex,
+                              const RiseFall *to_rf,
+                              const MinMax *min_max,
+                              const PathAnalysisPt *path_ap)
+{
+  if (path_ap_index_ >= 0
+      && path_ap->index() != path_ap_index_)
+    return true;
+  return PathVisitor::visitFromPath(from_pin, from_vertex, from_rf, from_path,
+                                    edge, arc, to_pin, to_vertex, to_rf,
+                                    min_max, path_ap);
+}
+
+void
+ArrivalVisitor::saveArrivals(Vertex *vertex)
+{
+  Pin *pin = vertex->pin();
   // Insert paths that originate here.
   if (!network_->isTopLevelPort(pin)
       && sdc_->hasInputDelay(pin))
@@ -1137,12 +1544,16 @@ ArrivalVisitor::visit(Vertex *vertex)
   // For example, "set_max_delay -to" from an unclocked source register.
   bool is_clk = tag_bldr_->hasClkTag();
   if (vertex->isRegClk() && !is_clk) {
-    debugPrint(debug_, "search", 2, "arrival seed unclked reg clk %s",
-               network_->pathName(pin));
+    debugPrintHot(debug_, "search", 2, "arrival seed unclked reg clk %s",
+                  network_->pathName(pin));
     search_->makeUnclkedPaths(vertex, true, false, tag_bldr_);
   }
 
   bool arrivals_changed = search_->arrivalsChanged(vertex, tag_bldr_);
+  SearchStats *stats = debug_->searchStats();
+  stats->incr(SearchStats::arrival_visits);
+  if (arrivals_changed)
+    stats->incr(SearchStats::arrivals_changed);
   // If vertex is a latch data input arrival that changed from the
   // previous eval pass enqueue the latch outputs to be re-evaled on the
   // next pass.
@@ -1154,14 +1565,17 @@ ArrivalVisitor::visit(Vertex *vertex)
   if (!search_->arrivalsAtEndpointsExist()
       || always_to_endpoints_
       || arrivals_changed)
-    search_->arrivalIterator()->enqueueAdjacentVertices(vertex, adj_pred_);
+    search_->arrivalIterator()->enqueueAdjacentVertices(vertex,
+                                                        boundArrivalSearchThru(adj_pred_));
   if (arrivals_changed) {
-    debugPrint(debug_, "search", 4, "arrival changed");
+    debugPrintHot(debug_, "search", 4, "arrival changed");
     // Only update arrivals when delays change by more than
     // fuzzyEqual can distinguish.
     search_->setVertexArrivals(vertex, tag_bldr_);
     search_->tnsInvalid(vertex);
     constrainedRequiredsInvalid(vertex, is_clk);
+    if (vertex->isRegClk())
+      search_->clkLatencyIndex()->sinkInvalid(vertex);
   }
   enqueueRefPinInputDelays(pin);
 }
@@ -1212,13 +1626,13 @@ Search::arrivalsChanged(Vertex *vertex,
   if (arrivals1) {
     TagGroup *tag_group = tagGroup(vertex);
     if (tag_group == nullptr
-        || tag_group->arrivalMap()->size() != tag_bldr->arrivalMap()->size())
+        || static_cast<size_t>(tag_group->arrivalCount())
+           != tag_bldr->arrivalMap()->size())
       return true;
-    ArrivalMap::Iterator arrival_iter1(tag_group->arrivalMap());
-    while (arrival_iter1.hasNext()) {
-      Tag *tag1;
-      int arrival_index1;
-      arrival_iter1.next(tag1, arrival_index1);
+    for (int arrival_index1 = 0;
+         arrival_index1 < tag_group->arrivalCount();
+         arrival_index1++) {
+      Tag *tag1 = tag_group->arrivalTag(arrival_index1);
       Arrival &arrival1 = arrivals1[arrival_index1];
       Tag *tag2;
       Arrival arrival2;
@@ -1250,16 +1664,16 @@ ArrivalVisitor::visitFromToPath(const Pin *,
 				const MinMax *min_max,
 				const PathAnalysisPt *)
 {
-  debugPrint(debug_, "search", 3, " %s",
-             from_vertex->name(sdc_network_));
-  debugPrint(debug_, "search", 3, "  %s -> %s %s",
-             from_rf->asString(),
-             to_rf->asString(),
-             min_max->asString());
-  debugPrint(debug_, "search", 3, "  from tag: %s",
-             from_tag->asString(this));
-  debugPrint(debug_, "search", 3, "  to tag  : %s",
-             to_tag->asString(this));
+  debugPrintHot(debug_, "search", 3, " %s",
+                from_vertex->name(sdc_network_));
+  debugPrintHot(debug_, "search", 3, "  %s -> %s %s",
+                from_rf->asString(),
+                to_rf->asString(),
+                min_max->asString());
+  debugPrintHot(debug_, "search", 3, "  from tag: %s",
+                from_tag->asString(this));
+  debugPrintHot(debug_, "search", 3, "  to tag  : %s",
+                to_tag->asString(this));
   ClkInfo *to_clk_info = to_tag->clkInfo();
   bool to_is_clk = to_tag->isClock();
   Arrival arrival;
@@ -1268,12 +1682,12 @@ ArrivalVisitor::visitFromToPath(const Pin *,
   tag_bldr_->tagMatchArrival(to_tag, tag_match, arrival, arrival_index);
   if (tag_match == nullptr
       || delayGreater(to_arrival, arrival, min_max, this)) {
-    debugPrint(debug_, "search", 3, "   %s + %s = %s %s %s",
-               delayAsString(from_path->arrival(this), this),
-               delayAsString(arc_delay, this),
-               delayAsString(to_arrival, this),
-               min_max == MinMax::max() ? ">" : "<",
-               tag_match ? delayAsString(arrival, this) : "MIA");
+    debugPrintHot(debug_, "search", 3, "   %s + %s = %s %s %s",
+                  delayAsString(from_path->arrival(this), this),
+                  delayAsString(arc_delay, this),
+                  delayAsString(to_arrival, this),
+                  min_max == MinMax::max() ? ">" : "<",
+                  tag_match ? delayAsString(arrival, this) : "MIA");
     PathVertexRep prev_path;
     if (to_tag->isClock() || to_tag->isGenClkSrcPath())
       prev_path.init(from_path, this);
@@ -1319,18 +1733,23 @@ ArrivalVisitor::pruneCrprArrivals()
       if (tag_no_crpr) {
 	ClkInfo *clk_info_no_crpr = tag_no_crpr->clkInfo();
 	Arrival max_crpr = crpr->maxCrpr(clk_info_no_crpr);
+	// The prune margin also prunes arrivals that are within margin of
+	// being dominated, so slacks are optimistic by at most margin.
+	// The margin is limited to max_crpr so the worst arrival is kept.
+	float margin = min(search_->crprPruneMargin(),
+			   delayAsFloat(max_crpr));
 	Arrival max_arrival_max_crpr = (min_max == MinMax::max())
-	  ? max_arrival - max_crpr
-	  : max_arrival + max_crpr;
-	debugPrint(debug_, "search", 4, "  cmp %s %s - %s = %s",
-                   tag->asString(this),
-                   delayAsString(max_arrival, this),
-                   delayAsString(max_crpr, this),
-                   delayAsString(max_arrival_max_crpr, this));
+	  ? max_arrival - max_crpr + margin
+	  : max_arrival + max_crpr - margin;
+	debugPrintHot(debug_, "search", 4, "  cmp %s %s - %s = %s",
+                      tag->asString(this),
+                      delayAsString(max_arrival, this),
+                      delayAsString(max_crpr, this),
+                      delayAsString(max_arrival_max_crpr, this));
 	Arrival arrival = tag_bldr_->arrival(arrival_index);
 	if (delayGreater(max_arrival_max_crpr, arrival, min_max, this)) {
-	  debugPrint(debug_, "search", 3, "  pruned %s",
-                     tag->asString(this));
+	  debugPrintHot(debug_, "search", 3, "  pruned %s",
+                        tag->asString(this));
 	  tag_bldr_->deleteArrival(tag);
 	}
       }
@@ -1379,8 +1798,7 @@ Search::enqueueLatchDataOutputs(Vertex *vertex)
     Edge *out_edge = out_edge_iter.next();
     if (latches_->isLatchDtoQ(out_edge)) {
       Vertex *out_vertex = out_edge->to(graph_);
-      UniqueLock lock(pending_latch_outputs_lock_);
-      pending_latch_outputs_->insert(out_vertex);
+      pending_latch_outputs_->insert(graph_->id(out_vertex));
     }
   }
 }
@@ -1414,8 +1832,9 @@ Search::findClockVertices(VertexSet &vertices)
 void
 Search::seedInvalidArrivals()
 {
-  for (Vertex *vertex : *invalid_arrivals_)
-    seedArrival(vertex);
+  invalid_arrivals_->visit([this] (VertexId vertex_id) {
+    seedArrival(graph_->vertex(vertex_id));
+  });
   invalid_arrivals_->clear();
 }
 
@@ -1984,14 +2403,28 @@ PathVisitor::PathVisitor(SearchPred *pred,
 void
 PathVisitor::visitFaninPaths(Vertex *to_vertex)
 {
-  if (pred_->searchTo(to_vertex)) {
+  visitFaninEdges(to_vertex, *pred_);
+}
+
+template <class PRED>
+void
+PathVisitor::visitFaninEdges(Vertex *to_vertex,
+                             PRED &pred)
+{
+  if (pred.searchTo(to_vertex)) {
+    if (bfs_prefetch_distance_ > 0) {
+      // Start loading the fanin paths before they are visited.
+      VertexInEdgeIterator prefetch_iter(to_vertex, graph_);
+      while (prefetch_iter.hasNext())
+        graph_->prefetchVertexData(prefetch_iter.next()->from(graph_));
+    }
     VertexInEdgeIterator edge_iter(to_vertex, graph_);
     while (edge_iter.hasNext()) {
       Edge *edge = edge_iter.next();
       Vertex *from_vertex = edge->from(graph_);
       const Pin *from_pin = from_vertex->pin();
-      if (pred_->searchFrom(from_vertex)
-	  && pred_->searchThru(edge)) {
+      if (pred.searchFrom(from_vertex)
+	  && pred.searchThru(edge)) {
 	const Pin *to_pin = to_vertex->pin();
 	if (!visitEdge(from_pin, from_vertex, edge, to_pin, to_vertex))
 	  break;
@@ -2002,18 +2435,31 @@ PathVisitor::visitFaninPaths(Vertex *to_vertex)
 
 void
 PathVisitor::visitFanoutPaths(Vertex *from_vertex)
+{
+  visitFanoutEdges(from_vertex, *pred_);
+}
+
+template <class PRED>
+void
+PathVisitor::visitFanoutEdges(Vertex *from_vertex,
+                              PRED &pred)
 {
   const Pin *from_pin = from_vertex->pin();
-  if (pred_->searchFrom(from_vertex)) {
+  if (pred.searchFrom(from_vertex)) {
+    if (bfs_prefetch_distance_ > 0) {
+      VertexOutEdgeIterator prefetch_iter(from_vertex, graph_);
+      while (prefetch_iter.hasNext())
+        graph_->prefetchVertexData(prefetch_iter.next()->to(graph_));
+    }
     VertexOutEdgeIterator edge_iter(from_vertex, graph_);
     while (edge_iter.hasNext()) {
       Edge *edge = edge_iter.next();
       Vertex *to_vertex = edge->to(graph_);
       const Pin *to_pin = to_vertex->pin();
-      if (pred_->searchTo(to_vertex)
-	  && pred_->searchThru(edge)) {
-	debugPrint(debug_, "search", 3, " %s",
-                   to_vertex->name(network_));
+      if (pred.searchTo(to_vertex)
+	  && pred.searchThru(edge)) {
+	debugPrintHot(debug_, "search", 3, " %s",
+                      to_vertex->name(network_));
 	if (!visitEdge(from_pin, from_vertex, edge, to_pin, to_vertex))
 	  break;
       }
@@ -2623,8 +3069,13 @@ TagGroup *
 Search::findTagGroup(TagGroupBldr *tag_bldr)
 {
   TagGroup probe(tag_bldr);
-  UniqueLock lock(tag_group_lock_);
+  debug_->searchStats()->incr(SearchStats::tag_group_lookups);
+  // Lock free lookup for existing tag groups.
   TagGroup *tag_group = tag_group_set_->findKey(&probe);
+  if (tag_group)
+    return tag_group;
+  UniqueLock lock(tag_group_lock_);
+  tag_group = tag_group_set_->findKey(&probe);
   if (tag_group == nullptr) {
     TagGroupIndex tag_group_index;
     if (tag_group_free_indices_.empty())
@@ -2634,6 +3085,7 @@ Search::findTagGroup(TagGroupBldr *tag_bldr)
       tag_group_free_indices_.pop_back();
     }
     tag_group = tag_bldr->makeTagGroup(tag_group_index, this);
+    debug_->searchStats()->incr(SearchStats::tag_groups_made);
     tag_groups_[tag_group_index] = tag_group;
     tag_group_set_->insert(tag_group);
     // If tag_groups_ needs to grow make the new array and copy the
@@ -2672,17 +3124,22 @@ Search::setVertexArrivals(Vertex *vertex,
     TagGroup *tag_group = findTagGroup(tag_bldr);
     int arrival_count = tag_group->arrivalCount();
     bool has_requireds = vertex->hasRequireds();
+    // Data path prevs are found from the fanin arrivals and delays when
+    // paths are reported. Clock path prevs are only saved for crpr, which
+    // walks back the clock paths, and generated clock source paths.
+    bool save_prev_paths = tag_bldr->hasGenClkSrcTag()
+      || (tag_bldr->hasClkTag() && sdc_->crprActive());
     // Reuse arrival array if it is the same size.
     if (prev_tag_group
 	&& arrival_count == prev_tag_group->arrivalCount()) {
-      if  (tag_bldr->hasClkTag() || tag_bldr->hasGenClkSrcTag()) {
+      if (save_prev_paths) {
 	if (prev_paths == nullptr)
 	  prev_paths = graph_->makePrevPaths(vertex, arrival_count);
       }
       else {
 	// Prev paths not required.
 	prev_paths = nullptr;
-	vertex->setPrevPaths(prev_path_null);
+	graph_->deletePrevPaths(vertex, arrival_count);
       }
       tag_bldr->copyArrivals(tag_group, prev_arrivals, prev_paths);
       vertex->setTagGroupIndex(tag_group->index());
@@ -2700,6 +3157,7 @@ Search::setVertexArrivals(Vertex *vertex,
       if (prev_tag_group) {
         uint32_t prev_arrival_count = prev_tag_group->arrivalCount();
         graph_->deleteArrivals(vertex, prev_arrival_count);
+        graph_->deletePrevPaths(vertex, prev_arrival_count);
         if (has_requireds) {
           requiredInvalid(vertex);
           graph_->deleteRequireds(vertex, prev_arrival_count);
@@ -2707,7 +3165,7 @@ Search::setVertexArrivals(Vertex *vertex,
       }
       Arrival *arrivals = graph_->makeArrivals(vertex, arrival_count);
       prev_paths = nullptr;
-      if  (tag_bldr->hasClkTag() || tag_bldr->hasGenClkSrcTag())
+      if (save_prev_paths)
 	prev_paths = graph_->makePrevPaths(vertex, arrival_count);
       tag_bldr->copyArrivals(tag_group, arrivals, prev_paths);
 
@@ -2727,11 +3185,10 @@ Search::reportArrivals(Vertex *vertex) const
   Required *requireds = graph_->requireds(vertex);
   if (tag_group) {
     report_->reportLine("Group %u", tag_group->index());
-    ArrivalMap::Iterator arrival_iter(tag_group->arrivalMap());
-    while (arrival_iter.hasNext()) {
-      Tag *tag;
-      int arrival_index;
-      arrival_iter.next(tag, arrival_index);
+    for (int arrival_index = 0;
+         arrival_index < tag_group->arrivalCount();
+         arrival_index++) {
+      Tag *tag = tag_group->arrivalTag(arrival_index);
       PathAnalysisPt *path_ap = tag->pathAnalysisPt(this);
       const RiseFall *rf = tag->transition();
       const char *req = "?";
@@ -2787,21 +3244,14 @@ Search::reportTagGroups() const
   for (TagGroupIndex i = 0; i < tag_group_next_; i++) {
     TagGroup *tag_group = tag_groups_[i];
     if (tag_group) {
-      report_->reportLine("Group %4u hash = %4lu (%4lu)",
+      report_->reportLine("Group %4u hash = %4lu",
                           i,
-                          tag_group->hash(),
-                          tag_group->hash() % tag_group_set_->bucket_count());
+                          tag_group->hash());
       tag_group->reportArrivalMap(this);
     }
   }
-  size_t long_hash = 0;
-  for (size_t i = 0; i < tag_group_set_->bucket_count(); i++) {
-    if (tag_group_set_->bucket_size(i) > long_hash)
-      long_hash = i;
-  }
-  report_->reportLine("Longest hash bucket length %zu hash=%zu",
-                      tag_group_set_->bucket_size(long_hash),
-                      long_hash);
+  report_->reportLine("Longest hash probe length %zu",
+                      tag_group_set_->maxProbeLength());
 }
 
 void
@@ -2852,12 +3302,22 @@ Search::findTag(const RiseFall *rf,
 		bool own_states)
 {
   Tag probe(0, rf->index(), path_ap->index(), clk_info, is_clk, input_delay,
-	    is_segment_start, states, false, this);
-  UniqueLock lock(tag_lock_);
+	    is_segment_start, states, this);
+  debug_->searchStats()->incr(SearchStats::tag_lookups);
+  // Lock free lookup for existing tags.
   Tag *tag = tag_set_->findKey(&probe);
+  if (tag) {
+    if (own_states)
+      delete states;
+    return tag;
+  }
+  UniqueLock lock(tag_lock_);
+  tag = tag_set_->findKey(&probe);
   if (tag == nullptr) {
-    ExceptionStateSet *new_states = !own_states && states
-      ? new ExceptionStateSet(*states) : states;
+    ExceptionStateSet *new_states = states
+      ? internStates(states, own_states)
+      : nullptr;
+    own_states = false;
     TagIndex tag_index;
     if (tag_free_indices_.empty())
       tag_index = tag_next_++;
@@ -2867,8 +3327,8 @@ Search::findTag(const RiseFall *rf,
     }
     tag = new Tag(tag_index, rf->index(), path_ap->index(),
                   clk_info, is_clk, input_delay, is_segment_start,
-                  new_states, true, this);
-    own_states = false;
+                  new_states, this);
+    debug_->searchStats()->incr(SearchStats::tags_made);
     // Make sure tag can be indexed in tags_ before it is visible to
     // other threads via tag_set_.
     tags_[tag_index] = tag;
@@ -2896,6 +3356,48 @@ Search::findTag(const RiseFall *rf,
   return tag;
 }
 
+// Return the shared state set equal to states.
+// Caller holds tag_lock_.
+ExceptionStateSet *
+Search::internStates(ExceptionStateSet *states,
+                     bool own_states)
+{
+  ExceptionStateSet *shared = tag_states_.findKey(states);
+  if (shared) {
+    if (own_states)
+      delete states;
+    return shared;
+  }
+  shared = own_states ? states : new ExceptionStateSet(*states);
+  tag_states_.insert(shared);
+  return shared;
+}
+
+size_t
+ExceptionStateSetHash::operator()(const ExceptionStateSet *states) const
+{
+  size_t hash = hash_init_value;
+  for (ExceptionState *state : *states)
+    hashIncr(hash, state->hash());
+  return hash;
+}
+
+// State sets are ordered, so equal sets have the same sequence of states.
+bool
+ExceptionStateSetEqual::operator()(const ExceptionStateSet *states1,
+                                   const ExceptionStateSet *states2) const
+{
+  if (states1->size() != states2->size())
+    return false;
+  auto iter2 = states2->begin();
+  for (ExceptionState *state1 : *states1) {
+    if (state1 != *iter2)
+      return false;
+    iter2++;
+  }
+  return true;
+}
+
 void
 Search::reportTags() const
 {
@@ -2904,14 +3406,102 @@ Search::reportTags() const
     if (tag)
       report_->reportLine("%s", tag->asString(this)) ;
   }
-  size_t long_hash = 0;
-  for (size_t i = 0; i < tag_set_->bucket_count(); i++) {
-    if (tag_set_->bucket_size(i) > long_hash)
-      long_hash = i;
+  report_->reportLine("Longest hash probe length %zu",
+                      tag_set_->maxProbeLength());
+}
+
+typedef std::vector<std::pair<std::string, size_t>> TagCauseCounts;
+
+static void
+reportTagCauses(const char *title,
+		TagCauseCounts &counts,
+		size_t max_count,
+		Report *report)
+{
+  if (!counts.empty()) {
+    sort(counts.begin(), counts.end(),
+	 [] (const std::pair<std::string, size_t> &count1,
+	     const std::pair<std::string, size_t> &count2) {
+	   return count1.second > count2.second
+	     || (count1.second == count2.second
+		 && count1.first < count2.first);
+	 });
+    report->reportLine("%s", title);
+    size_t report_count = min(counts.size(), max_count);
+    for (size_t i = 0; i < report_count; i++)
+      report->reportLine(" %10zu %s", counts[i].second, counts[i].first.c_str());
+    if (counts.size() > report_count)
+      report->reportLine(" %10s %zu more", "...", counts.size() - report_count);
+  }
+}
+
+// Attribute the tags to the clock edges, exceptions, crpr clock pins
+// and input delay reference pins that distinguish them to find the
+// causes of tag explosions.
+void
+Search::reportTagSummary(size_t max_count) const
+{
+  std::unordered_map<const ClockEdge*, size_t> clk_edge_counts;
+  std::unordered_map<const ExceptionPath*, size_t> exception_counts;
+  std::unordered_map<VertexId, size_t> crpr_pin_counts;
+  std::unordered_map<const Pin*, size_t> ref_pin_counts;
+  size_t tag_count = 0;
+  size_t crpr_tag_count = 0;
+  size_t exception_tag_count = 0;
+  for (TagIndex i = 0; i < tag_next_; i++) {
+    Tag *tag = tags_[i];
+    if (tag) {
+      tag_count++;
+      clk_edge_counts[tag->clkEdge()]++;
+      ExceptionStateSet *states = tag->states();
+      if (states && !states->empty()) {
+	exception_tag_count++;
+	for (ExceptionState *state : *states)
+	  exception_counts[state->exception()]++;
+      }
+      ClkInfo *clk_info = tag->clkInfo();
+      if (clk_info->hasCrprClkPin()) {
+	crpr_tag_count++;
+	crpr_pin_counts[clk_info->crprClkVertexId()]++;
+      }
+      InputDelay *input_delay = tag->inputDelay();
+      if (input_delay && input_delay->refPin())
+	ref_pin_counts[input_delay->refPin()]++;
+    }
+  }
+  report_->reportLine("Tags %zu clk infos %d tag groups %d",
+		      tag_count, clkInfoCount(), tagGroupCount());
+
+  TagCauseCounts counts;
+  for (auto clk_edge_count : clk_edge_counts) {
+    const ClockEdge *clk_edge = clk_edge_count.first;
+    counts.push_back({clk_edge ? clk_edge->name() : "unclocked",
+		      clk_edge_count.second});
+  }
+  reportTagCauses("Tags by clock edge", counts, max_count, report_);
+
+  counts.clear();
+  for (auto exception_count : exception_counts)
+    counts.push_back({exception_count.first->asString(sdc_network_),
+		      exception_count.second});
+  report_->reportLine("Tags with exception states %zu", exception_tag_count);
+  reportTagCauses("Tags by exception", counts, max_count, report_);
+
+  counts.clear();
+  for (auto crpr_pin_count : crpr_pin_counts) {
+    Vertex *vertex = graph_->vertex(crpr_pin_count.first);
+    counts.push_back({vertex->name(sdc_network_), crpr_pin_count.second});
   }
-  report_->reportLine("Longest hash bucket length %zu hash=%zu",
-                      tag_set_->bucket_size(long_hash),
-                      long_hash);
+  report_->reportLine("Tags with crpr clock pins %zu (%zu pins)",
+		      crpr_tag_count, crpr_pin_counts.size());
+  reportTagCauses("Tags by crpr clock pin", counts, max_count, report_);
+
+  counts.clear();
+  for (auto ref_pin_count : ref_pin_counts)
+    counts.push_back({sdc_network_->pathName(ref_pin_count.first),
+		      ref_pin_count.second});
+  reportTagCauses("Tags by input delay reference pin", counts, max_count,
+		  report_);
 }
 
 void
@@ -2919,12 +3509,14 @@ Search::reportClkInfos() const
 {
   Vector<ClkInfo*> clk_infos;
   // set -> vector for sorting.
-  for (ClkInfo *clk_info : *clk_info_set_)
-    clk_infos.push_back(clk_info);
+  for (int i = 0; i < clk_info_shard_count_; i++) {
+    for (ClkInfo *clk_info : *clk_info_sets_[i])
+      clk_infos.push_back(clk_info);
+  }
   sort(clk_infos, ClkInfoLess(this));
   for (ClkInfo *clk_info : clk_infos)
     report_->reportLine("ClkInfo %s", clk_info->asString(this));
-  report_->reportLine("%lu clk infos", clk_info_set_->size());
+  report_->reportLine("%lu clk infos", clk_infos.size());
 }
 
 ClkInfo *
@@ -2944,14 +3536,18 @@ Search::findClkInfo(const ClockEdge *clk_edge,
   ClkInfo probe(clk_edge, clk_src, is_propagated, gen_clk_src, gen_clk_src_path,
 		pulse_clk_sense, insertion, latency, uncertainties,
 		path_ap->index(), crpr_clk_path_rep, this);
-  UniqueLock lock(clk_info_lock_);
-  ClkInfo *clk_info = clk_info_set_->findKey(&probe);
+  int shard = clkInfoShard(clk_edge, clk_src, path_ap);
+  ClkInfoSet *clk_info_set = clk_info_sets_[shard];
+  debug_->searchStats()->incr(SearchStats::clk_info_lookups);
+  UniqueLock lock(clk_info_locks_[shard]);
+  ClkInfo *clk_info = clk_info_set->findKey(&probe);
   if (clk_info == nullptr) {
     clk_info = new ClkInfo(clk_edge, clk_src,
 			   is_propagated, gen_clk_src, gen_clk_src_path,
 			   pulse_clk_sense, insertion, latency, uncertainties,
 			   path_ap->index(), crpr_clk_path_rep, this);
-    clk_info_set_->insert(clk_info);
+    debug_->searchStats()->incr(SearchStats::clk_infos_made);
+    clk_info_set->insert(clk_info);
   }
   return clk_info;
 }
@@ -2967,10 +3563,59 @@ Search::findClkInfo(const ClockEdge *clk_edge,
 		     insertion, 0.0, nullptr, path_ap, nullptr);
 }
 
+// Clk infos that compare equal always have the same clock edge,
+// path analysis point and clock source, so they are in the same shard.
+int
+Search::clkInfoShard(const ClockEdge *clk_edge,
+                     const Pin *clk_src,
+                     const PathAnalysisPt *path_ap) const
+{
+  size_t hash = hash_init_value;
+  if (clk_edge)
+    hashIncr(hash, clk_edge->index());
+  if (clk_src)
+    hashIncr(hash, network_->vertexId(clk_src));
+  hashIncr(hash, path_ap->index());
+  return hash % clk_info_shard_count_;
+}
+
 int
 Search::clkInfoCount() const
 {
-  return clk_info_set_->size();
+  size_t count = 0;
+  for (int i = 0; i < clk_info_shard_count_; i++)
+    count += clk_info_sets_[i]->size();
+  return count;
+}
+
+void
+Search::memoryStats(MemoryStats &stats) const
+{
+  size_t tag_count = tag_set_->size();
+  stats.add("search", "tags", tag_count,
+            tag_count * sizeof(Tag)
+            + tag_set_->capacity() * sizeof(Tag*)
+            + tag_capacity_ * sizeof(Tag*));
+  // Set nodes are about 4 words each.
+  size_t states_bytes = tag_states_.bucket_count() * sizeof(void*);
+  for (const ExceptionStateSet *states : tag_states_)
+    states_bytes += sizeof(ExceptionStateSet) + states->size() * 4 * sizeof(void*);
+  stats.add("search", "tag states", tag_states_.size(), states_bytes);
+  size_t group_count = 0;
+  size_t group_bytes = tag_group_set_->capacity() * sizeof(TagGroup*)
+    + tag_group_capacity_ * sizeof(TagGroup*);
+  for (TagGroupIndex i = 0; i < tag_group_next_; i++) {
+    TagGroup *tag_group = tag_groups_[i];
+    if (tag_group) {
+      group_count++;
+      group_bytes += sizeof(TagGroup);
+      group_bytes += tag_group->bytes() - sizeof(TagGroup);
+    }
+  }
+  stats.add("search", "tag groups", group_count, group_bytes);
+  size_t clk_info_count = clkInfoCount();
+  stats.add("search", "clk infos", clk_info_count,
+            clk_info_count * (sizeof(ClkInfo) + MemoryStats::tree_node_bytes));
 }
 
 ArcDelay
@@ -2998,8 +3643,12 @@ Search::timingDerate(Vertex *from_vertex,
     is_clk ? PathClkOrData::clk : PathClkOrData::data;
   TimingRole *role = edge->role();
   const Pin *pin = from_vertex->pin();
+  const DerateTable *derate_table = derate_index_->table(from_vertex);
   if (role->isWire()) {
     const RiseFall *rf = arc->toEdge()->asRiseFall();
+    if (derate_table)
+      return derate_table->netDerate(derate_clk_data, rf,
+                                     path_ap->pathMinMax());
     return sdc_->timingDerateNet(pin, derate_clk_data, rf,
 				 path_ap->pathMinMax());
   }
@@ -3014,11 +3663,20 @@ Search::timingDerate(Vertex *from_vertex,
        derate_type = TimingDerateCellType::cell_delay;
        rf = arc->fromEdge()->asRiseFall();
     }
+    if (derate_table)
+      return derate_table->cellDerate(derate_type, derate_clk_data, rf,
+                                      path_ap->pathMinMax());
     return sdc_->timingDerateInstance(pin, derate_type, derate_clk_data, rf,
 				      path_ap->pathMinMax());
   }
 }
 
+void
+Search::deratesInvalid()
+{
+  derate_index_->clear();
+}
+
 ClockSet
 Search::clockDomains(const Vertex *vertex) const
 {
@@ -3137,7 +3795,7 @@ void
 Search::seedRequireds()
 {
   ensureDownstreamClkPins();
-  for (Vertex *vertex : *endpoints())
+  for (Vertex *vertex : endpointSeq())
     seedRequired(vertex);
   requireds_seeded_ = true;
   requireds_exist_ = true;
@@ -3158,20 +3816,23 @@ Search::endpoints()
 	endpoints_->insert(vertex);
       }
     }
+    endpoint_seq_valid_ = false;
   }
   if (invalid_endpoints_) {
     for (Vertex *vertex : *invalid_endpoints_) {
       if (isEndpoint(vertex)) {
 	debugPrint(debug_, "endpoint", 2, "insert %s",
                    vertex->name(sdc_network_));
-	endpoints_->insert(vertex);
+	if (endpoints_->insert(vertex).second)
+          endpoint_seq_valid_ = false;
       }
       else {
 	if (debug_->check("endpoint", 2)
 	    && endpoints_->hasKey(vertex))
 	  report_->reportLine("endpoint: remove %s",
                               vertex->name(sdc_network_));
-	endpoints_->erase(vertex);
+	if (endpoints_->erase(vertex))
+          endpoint_seq_valid_ = false;
       }
     }
     invalid_endpoints_->clear();
@@ -3179,12 +3840,28 @@ Search::endpoints()
   return endpoints_;
 }
 
+const VertexSeq &
+Search::endpointSeq()
+{
+  endpoints();
+  if (!endpoint_seq_valid_) {
+    // VertexSet is ordered by vertex id.
+    endpoint_seq_.clear();
+    endpoint_seq_.reserve(endpoints_->size());
+    for (Vertex *vertex : *endpoints_)
+      endpoint_seq_.push_back(vertex);
+    endpoint_seq_valid_ = true;
+  }
+  return endpoint_seq_;
+}
+
 void
 Search::endpointInvalid(Vertex *vertex)
 {
   if (invalid_endpoints_) {
     debugPrint(debug_, "endpoint", 2, "invalid %s",
                vertex->name(sdc_network_));
+    invalid_count_.fetch_add(1, std::memory_order_relaxed);
     invalid_endpoints_->insert(vertex);
   }
 }
@@ -3228,10 +3905,13 @@ Search::hasEnabledChecks(Vertex *vertex) const
 void
 Search::endpointsInvalid()
 {
+  invalid_count_++;
   delete endpoints_;
   delete invalid_endpoints_;
   endpoints_ = nullptr;
   invalid_endpoints_ = nullptr;
+  endpoint_seq_.clear();
+  endpoint_seq_valid_ = false;
 }
 
 void
@@ -3344,12 +4024,10 @@ RequiredCmp::requiredsInit(Vertex *vertex,
   TagGroup *tag_group = search->tagGroup(vertex);
   if (tag_group) {
     requireds_.resize(tag_group->arrivalCount());
-    ArrivalMap *arrival_entries = tag_group->arrivalMap();
-    ArrivalMap::Iterator arrival_iter(arrival_entries);
-    while (arrival_iter.hasNext()) {
-      Tag *tag;
-      int arrival_index;
-      arrival_iter.next(tag, arrival_index);
+    for (int arrival_index = 0;
+         arrival_index < tag_group->arrivalCount();
+         arrival_index++) {
+      Tag *tag = tag_group->arrivalTag(arrival_index);
       PathAnalysisPt *path_ap = tag->pathAnalysisPt(sta);
       const MinMax *min_max = path_ap->pathMinMax();
       requireds_[arrival_index] = delayInitValue(min_max->opposite());
@@ -3372,6 +4050,19 @@ RequiredCmp::requiredSet(int arrival_index,
   }
 }
 
+static bool
+requiredWithinTolerance(const Required &prev_req,
+			const Required &req,
+			float tolerance)
+{
+  if (tolerance > 0.0) {
+    float diff = std::abs(delayAsFloat(req) - delayAsFloat(prev_req));
+    return diff <= tolerance;
+  }
+  else
+    return false;
+}
+
 bool
 RequiredCmp::requiredsSave(Vertex *vertex,
 			   const StaState *sta)
@@ -3382,6 +4073,7 @@ RequiredCmp::requiredsSave(Vertex *vertex,
     if (!prev_reqs)
       requireds_changed = true;
     Debug *debug = sta->debug();
+    float tolerance = sta->search()->requiredTolerance();
     VertexPathIterator path_iter(vertex, sta);
     while (path_iter.hasNext()) {
       PathVertex *path = path_iter.next();
@@ -3391,17 +4083,18 @@ RequiredCmp::requiredsSave(Vertex *vertex,
       Required req = requireds_[arrival_index];
       if (prev_reqs) {
 	Required prev_req = path->required(sta);
-	if (!delayEqual(prev_req, req)) {
-	  debugPrint(debug, "search", 3, "required save %s -> %s",
-                     delayAsString(prev_req, sta),
-                     delayAsString(req, sta));
+	if (!delayEqual(prev_req, req)
+	    && !requiredWithinTolerance(prev_req, req, tolerance)) {
+	  debugPrintHot(debug, "search", 3, "required save %s -> %s",
+                        delayAsString(prev_req, sta),
+                        delayAsString(req, sta));
 	  path->setRequired(req, sta);
 	  requireds_changed = true;
 	}
       }
       else {
-	debugPrint(debug, "search", 3, "required save MIA -> %s",
-                   delayAsString(req, sta));
+	debugPrintHot(debug, "search", 3, "required save MIA -> %s",
+                      delayAsString(req, sta));
 	path->setRequired(req, sta);
       }
     }
@@ -3451,12 +4144,18 @@ RequiredVisitor::copy() const
 void
 RequiredVisitor::visit(Vertex *vertex)
 {
-  debugPrint(debug_, "search", 2, "find required %s",
-             vertex->name(network_));
+  debugPrintHot(debug_, "search", 2, "find required %s",
+                vertex->name(network_));
   required_cmp_->requiredsInit(vertex, this);
   vertex->setRequiredsPruned(false);
   // Back propagate requireds from fanout.
-  visitFanoutPaths(vertex);
+  EvalPred *eval_pred = search_->evalPred();
+  if (pred_ == eval_pred) {
+    BoundSearchPred<EvalPred> bound_pred(eval_pred);
+    visitFanoutEdges(vertex, bound_pred);
+  }
+  else
+    visitFanoutPaths(vertex);
   // Check for constraints at endpoints that set required times.
   if (search_->isEndpoint(vertex)) {
     FindEndRequiredVisitor seeder(required_cmp_, this);
@@ -3465,8 +4164,11 @@ RequiredVisitor::visit(Vertex *vertex)
   bool changed = required_cmp_->requiredsSave(vertex, this);
   search_->tnsInvalid(vertex);
 
-  if (changed)
-    search_->requiredIterator()->enqueueAdjacentVertices(vertex);
+  if (changed) {
+    BfsBkwdIterator *required_iter = search_->requiredIterator();
+    required_iter->enqueueAdjacentVertices(vertex,
+                                           boundSearchThru(search_->searchAdj()));
+  }
 }
 
 bool
@@ -3487,13 +4189,13 @@ RequiredVisitor::visitFromToPath(const Pin *,
 {
   // Don't propagate required times through latch D->Q edges.
   if (edge->role() != TimingRole::latchDtoQ()) {
-    debugPrint(debug_, "search", 3, "  %s -> %s %s",
-               from_rf->asString(),
-               to_rf->asString(),
-               min_max->asString());
-    debugPrint(debug_, "search", 3, "  from tag %2u: %s",
-               from_tag->index(),
-               from_tag->asString(this));
+    debugPrintHot(debug_, "search", 3, "  %s -> %s %s",
+                  from_rf->asString(),
+                  to_rf->asString(),
+                  min_max->asString());
+    debugPrintHot(debug_, "search", 3, "  from tag %2u: %s",
+                  from_tag->index(),
+                  from_tag->asString(this));
     int arrival_index;
     bool arrival_exists;
     from_path->arrivalIndex(arrival_index, arrival_exists);
@@ -3504,15 +4206,15 @@ RequiredVisitor::visitFromToPath(const Pin *,
       PathVertex to_path(to_vertex, to_tag, this);
       Required to_required = to_path.required(this);
       Required from_required = to_required - arc_delay;
-      debugPrint(debug_, "search", 3, "  to tag   %2u: %s",
-                 to_tag->index(),
-                 to_tag->asString(this));
-      debugPrint(debug_, "search", 3, "  %s - %s = %s %s %s",
-                 delayAsString(to_required, this),
-                 delayAsString(arc_delay, this),
-                 delayAsString(from_required, this),
-                 min_max == MinMax::max() ? "<" : ">",
-                 delayAsString(required_cmp_->required(arrival_index), this));
+      debugPrintHot(debug_, "search", 3, "  to tag   %2u: %s",
+                    to_tag->index(),
+                    to_tag->asString(this));
+      debugPrintHot(debug_, "search", 3, "  %s - %s = %s %s %s",
+                    delayAsString(to_required, this),
+                    delayAsString(arc_delay, this),
+                    delayAsString(from_required, this),
+                    min_max == MinMax::max() ? "<" : ">",
+                    delayAsString(required_cmp_->required(arrival_index), this));
       required_cmp_->requiredSet(arrival_index, from_required, req_min, this);
     }
     else {
@@ -3527,16 +4229,16 @@ RequiredVisitor::visitFromToPath(const Pin *,
 	  if (tagMatchNoCrpr(to_path_tag, to_tag)) {
 	    Required to_required = to_path->required(this);
 	    Required from_required = to_required - arc_delay;
-	    debugPrint(debug_, "search", 3, "  to tag   %2u: %s",
-                       to_path_tag->index(),
-                       to_path_tag->asString(this));
-	    debugPrint(debug_, "search", 3, "  %s - %s = %s %s %s",
-                       delayAsString(to_required, this),
-                       delayAsString(arc_delay, this),
-                       delayAsString(from_required, this),
-                       min_max == MinMax::max() ? "<" : ">",
-                       delayAsString(required_cmp_->required(arrival_index),
-                                     this));
+	    debugPrintHot(debug_, "search", 3, "  to tag   %2u: %s",
+                          to_path_tag->index(),
+                          to_path_tag->asString(this));
+	    debugPrintHot(debug_, "search", 3, "  %s - %s = %s %s %s",
+                          delayAsString(to_required, this),
+                          delayAsString(arc_delay, this),
+                          delayAsString(from_required, this),
+                          min_max == MinMax::max() ? "<" : ">",
+                          delayAsString(required_cmp_->required(arrival_index),
+                                        this));
 	    required_cmp_->requiredSet(arrival_index, from_required, req_min, this);
 	    break;
 	  }
@@ -3580,6 +4282,7 @@ Search::matchesFilter(Path *path,
 		      const ClockEdge *to_clk_edge)
 {
   if (filter_ == nullptr
+      && filters_.empty()
       && filter_from_ == nullptr
       && filter_to_ == nullptr)
     return true;
@@ -3598,6 +4301,20 @@ Search::matchesFilter(Path *path,
     }
     return false;
   }
+  else if (!filters_.empty()) {
+    // Paths tagged by any of the filters searched in one pass.
+    // The only other filters are generated clock source path filters.
+    const Tag *tag = path->tag(this);
+    ExceptionStateSet *states = tag->states();
+    if (states && !tag->isGenClkSrcPath()) {
+      for (auto state : *states) {
+	if (state->exception()->isFilter()
+            && state->nextThru() == nullptr)
+	  return true;
+      }
+    }
+    return false;
+  }
   else if (filter_from_
 	   && filter_from_->pins() == nullptr
 	   && filter_from_->instances() == nullptr
@@ -3698,6 +4415,66 @@ Search::totalNegativeSlack(const Corner *corner,
   return tns_[path_ap_index];
 }
 
+int
+Search::negativeSlackEndpointCount(const Corner *corner,
+                                   const MinMax *min_max)
+{
+  tnsPreamble();
+  if (corner) {
+    PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+    return tns_slacks_[path_ap_index].size();
+  }
+  else if (corners_->count() == 1) {
+    PathAPIndex path_ap_index =
+      corners_->findCorner(0)->findPathAnalysisPt(min_max)->index();
+    return tns_slacks_[path_ap_index].size();
+  }
+  else {
+    // Endpoints can violate in more than one corner.
+    Set<VertexId> ends;
+    for (Corner *corner : *corners_) {
+      PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+      for (auto &slack_id : tns_slack_order_[path_ap_index])
+        ends.insert(slack_id.second);
+    }
+    return ends.size();
+  }
+}
+
+VertexSeq
+Search::worstNegativeSlackEndpoints(const Corner *corner,
+                                    const MinMax *min_max,
+                                    int count)
+{
+  tnsPreamble();
+  // Merge the worst count endpoints of each corner.
+  std::vector<std::pair<float, VertexId>> worst;
+  for (Corner *corner1 : *corners_) {
+    if (corner == nullptr || corner1 == corner) {
+      PathAPIndex path_ap_index = corner1->findPathAnalysisPt(min_max)->index();
+      int i = 0;
+      for (auto &slack_id : tns_slack_order_[path_ap_index]) {
+        if (i++ == count)
+          break;
+        worst.push_back(slack_id);
+      }
+    }
+  }
+  sort(worst.begin(), worst.end());
+  VertexSeq ends;
+  Set<VertexId> found;
+  for (auto &slack_id : worst) {
+    if (static_cast<int>(ends.size()) == count)
+      break;
+    VertexId vertex_id = slack_id.second;
+    if (found.find(vertex_id) == found.end()) {
+      found.insert(vertex_id);
+      ends.push_back(graph_->vertex(vertex_id));
+    }
+  }
+  return ends;
+}
+
 void
 Search::tnsPreamble()
 {
@@ -3705,6 +4482,7 @@ Search::tnsPreamble()
   PathAPIndex path_ap_count = corners_->pathAnalysisPtCount();
   tns_.resize(path_ap_count);
   tns_slacks_.resize(path_ap_count);
+  tns_slack_order_.resize(path_ap_count);
   if (tns_exists_)
     updateInvalidTns();
   else
@@ -3751,8 +4529,9 @@ Search::findTotalNegativeSlacks()
   for (PathAPIndex i = 0; i < path_ap_count; i++) {
     tns_[i] = 0.0;
     tns_slacks_[i].clear();
+    tns_slack_order_[i].clear();
   }
-  for (Vertex *vertex : *endpoints()) {
+  for (Vertex *vertex : endpointSeq()) {
     // No locking required.
     SlackSeq slacks(path_ap_count);
     wnsSlacks(vertex, slacks);
@@ -3786,6 +4565,8 @@ Search::tnsIncr(Vertex *vertex,
     if (tns_slacks_[path_ap_index].hasKey(vertex))
       report_->critical(1513, "tns incr existing vertex");
     tns_slacks_[path_ap_index][vertex] = slack;
+    tns_slack_order_[path_ap_index].insert({delayAsFloat(slack),
+                                            graph_->id(vertex)});
   }
 }
 
@@ -3803,6 +4584,8 @@ Search::tnsDecr(Vertex *vertex,
                vertex->name(sdc_network_));
     tns_[path_ap_index] -= slack;
     tns_slacks_[path_ap_index].erase(vertex);
+    tns_slack_order_[path_ap_index].erase({delayAsFloat(slack),
+                                           graph_->id(vertex)});
   }
 }
 
@@ -16,6 +16,10 @@
 
 #include "Sim.hh"
 
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+
 #include "StaConfig.hh"  // CUDD
 #include "Error.hh"
 #include "Mutex.hh"
@@ -23,6 +27,7 @@
 #include "Report.hh"
 #include "Stats.hh"
 #include "FuncExpr.hh"
+#include "FuncExprEval.hh"
 #include "TimingRole.hh"
 #include "TimingArc.hh"
 #include "Liberty.hh"
@@ -31,6 +36,7 @@
 #include "Network.hh"
 #include "Sdc.hh"
 #include "Graph.hh"
+#include "DispatchQueue.hh"
 
 #if CUDD
 // https://davidkebo.com/cudd
@@ -48,6 +54,8 @@ static const Pin *
 findDrvrPin(const Pin *pin,
 	    Network *network);
 
+////////////////////////////////////////////////////////////////
+
 Sim::Sim(StaState *sta) :
   StaState(sta),
   observer_(nullptr),
@@ -58,6 +66,7 @@ Sim::Sim(StaState *sta) :
   invalid_insts_(network_),
   invalid_drvr_pins_(network_),
   invalid_load_pins_(network_),
+  invalid_constraint_pins_(network_),
   instances_with_const_pins_(network_),
   instances_to_annotate_(network_),
   bdd_(sta)
@@ -92,7 +101,6 @@ Sim::functionSense(const FuncExpr *expr,
     decreasing = (Cudd_Decreasing(cudd_mgr, bdd, input_index)
 		  == Cudd_ReadOne(cudd_mgr));
     Cudd_RecursiveDeref(cudd_mgr, bdd);
-    bdd_.clearVarMap();
   }
   TimingSense sense;
   if (increasing && decreasing)
@@ -110,6 +118,17 @@ Sim::functionSense(const FuncExpr *expr,
 LogicValue
 Sim::evalExpr(const FuncExpr *expr,
 	      const Instance *inst)
+{
+  const FuncExprEval *eval = expr->eval();
+  if (eval->hasTruthTable())
+    return evalCompiled(eval, inst);
+  else
+    return evalBdd(expr, inst);
+}
+
+LogicValue
+Sim::evalBdd(const FuncExpr *expr,
+             const Instance *inst)
 {
   UniqueLock lock(bdd_lock_);
   DdNode *bdd = funcBddSim(expr, inst);
@@ -120,10 +139,8 @@ Sim::evalExpr(const FuncExpr *expr,
   else if (bdd == Cudd_ReadOne(cudd_mgr))
     value = LogicValue::one;
 
-  if (bdd) {
+  if (bdd)
     Cudd_RecursiveDeref(bdd_.cuddMgr(), bdd);
-    bdd_.clearVarMap();
-  }
   return value;
 }
 
@@ -142,52 +159,32 @@ Sim::funcBddSim(const FuncExpr *expr,
     if (port_node) {
       LogicValue value = logicValue(pin);
       int var_index = Cudd_NodeReadIndex(port_node);
+      DdNode *const_node = nullptr;
       switch (value) {
       case LogicValue::zero:
-        bdd = Cudd_bddCompose(cudd_mgr, bdd, Cudd_ReadLogicZero(cudd_mgr), var_index);
-        Cudd_Ref(bdd);
+        const_node = Cudd_ReadLogicZero(cudd_mgr);
         break;
       case LogicValue::one:
-        bdd = Cudd_bddCompose(cudd_mgr, bdd, Cudd_ReadOne(cudd_mgr), var_index);
-        Cudd_Ref(bdd);
+        const_node = Cudd_ReadOne(cudd_mgr);
         break;
       default:
         break;
       }
+      if (const_node) {
+        DdNode *compose = Cudd_bddCompose(cudd_mgr, bdd, const_node, var_index);
+        Cudd_Ref(compose);
+        Cudd_RecursiveDeref(cudd_mgr, bdd);
+        bdd = compose;
+      }
     }
   }
+  delete pin_iter;
   return bdd;
 }
 
 #else 
 // No CUDD.
 
-static LogicValue
-logicOr(LogicValue value1,
-	LogicValue value2)
-{
-  static LogicValue logic_or[5][5] =
-    {{LogicValue::zero,   LogicValue::one, LogicValue::unknown, LogicValue::unknown, LogicValue::unknown},
-     {LogicValue::one,    LogicValue::one, LogicValue::one,     LogicValue::one,     LogicValue::one},
-     {LogicValue::unknown,LogicValue::one, LogicValue::unknown, LogicValue::unknown, LogicValue::unknown},
-     {LogicValue::unknown,LogicValue::one, LogicValue::unknown, LogicValue::unknown, LogicValue::unknown},
-     {LogicValue::unknown,LogicValue::one, LogicValue::unknown, LogicValue::unknown, LogicValue::unknown}};
-  return logic_or[int(value1)][int(value2)];
-}
-
-static LogicValue
-logicAnd(LogicValue value1,
-	LogicValue value2)
-{
-  static LogicValue logic_and[5][5] =
-    {{LogicValue::zero,LogicValue::zero,   LogicValue::zero,   LogicValue::zero,    LogicValue::zero},
-     {LogicValue::zero,LogicValue::one,    LogicValue::unknown,LogicValue::unknown, LogicValue::unknown},
-     {LogicValue::zero,LogicValue::unknown,LogicValue::unknown,LogicValue::unknown, LogicValue::unknown},
-     {LogicValue::zero,LogicValue::unknown,LogicValue::unknown,LogicValue::unknown, LogicValue::unknown},
-     {LogicValue::zero,LogicValue::unknown,LogicValue::unknown,LogicValue::unknown, LogicValue::unknown}};
-  return logic_and[int(value1)][int(value2)];
-}
-
 static LogicValue
 logicXor(LogicValue value1,
 	 LogicValue value2)
@@ -399,35 +396,7 @@ LogicValue
 Sim::evalExpr(const FuncExpr *expr,
 	      const Instance *inst)
 {
-  switch (expr->op()) {
-  case FuncExpr::op_port: {
-    LibertyPort *port = expr->port();
-    if (port) {
-      Pin *pin = network_->findPin(inst, port->name());
-      if (pin)
-        return logicValue(pin);
-    }
-    // Internal ports don't have instance pins.
-    return LogicValue::unknown;
-  }
-  case FuncExpr::op_not:
-    return logicNot(evalExpr(expr->left(), inst));
-  case FuncExpr::op_or:
-    return logicOr(evalExpr(expr->left(),inst),
-		   evalExpr(expr->right(),inst));
-  case FuncExpr::op_and:
-    return logicAnd(evalExpr(expr->left(),inst),
-		    evalExpr(expr->right(),inst));
-  case FuncExpr::op_xor:
-    return  logicXor(evalExpr(expr->left(),inst),
-		     evalExpr(expr->right(),inst));
-  case FuncExpr::op_one:
-    return LogicValue::one;
-  case FuncExpr::op_zero:
-    return LogicValue::zero;
-  }
-  // Prevent warnings from lame compilers.
-  return LogicValue::zero;
+  return evalCompiled(expr->eval(), inst);
 }
 
 #endif // CUDD
@@ -453,6 +422,7 @@ Sim::clear()
   invalid_insts_.clear();
   invalid_drvr_pins_.clear();
   invalid_load_pins_.clear();
+  invalid_constraint_pins_.clear();
 }
 
 void
@@ -470,6 +440,7 @@ Sim::ensureConstantsPropagated()
     ensureConstantFuncPins();
     instances_to_annotate_.clear();
     if (incremental_) {
+      propagateInvalidConstraintPins();
       seedInvalidConstants();
       propagateToInvalidLoads();
       propagateFromInvalidDrvrsToLoads();
@@ -506,6 +477,37 @@ Sim::seedInvalidConstants()
     eval_queue_.push(inst);
 }
 
+// Set the new constraint values. Pins with removed constraints get
+// their values from the netlist again.
+void
+Sim::propagateInvalidConstraintPins()
+{
+  for (const Pin *pin : invalid_constraint_pins_) {
+    LogicValue value;
+    bool exists;
+    sdc_->caseLogicValue(pin, value, exists);
+    if (!exists)
+      sdc_->logicValue(pin, value, exists);
+    if (exists)
+      setPinValue(pin, value);
+    else {
+      if (network_->isLoad(pin))
+        invalid_load_pins_.insert(pin);
+      if (network_->isDriver(pin)) {
+        const Instance *inst = network_->instance(pin);
+        if (const_func_pins_.hasKey(pin))
+          setPinValue(pin, pinConstFuncValue(pin));
+        else if (network_->isLeaf(inst))
+          invalid_insts_.insert(inst);
+        else
+          // Top level input port.
+          setPinValue(pin, LogicValue::unknown);
+      }
+    }
+  }
+  invalid_constraint_pins_.clear();
+}
+
 void
 Sim::propagateToInvalidLoads()
 {
@@ -519,6 +521,8 @@ Sim::propagateToInvalidLoads()
       const Pin *drvr_pin = findDrvrPin(load_pin, network_);
       if (drvr_pin)
 	propagateDrvrToLoad(drvr_pin, load_pin);
+      else
+        setPinValue(load_pin, LogicValue::unknown);
     }
   }
   invalid_load_pins_.clear();
@@ -556,6 +560,7 @@ Sim::constantsInvalid()
 {
   valid_ = false;
   incremental_ = false;
+  invalid_constraint_pins_.clear();
 }
 
 void
@@ -613,6 +618,7 @@ Sim::deletePinBefore(const Pin *pin)
   const_func_pins_.erase(pin);
   invalid_load_pins_.erase(pin);
   invalid_drvr_pins_.erase(pin);
+  invalid_constraint_pins_.erase(pin);
   invalid_insts_.insert(network_->instance(pin));
 }
 
@@ -656,6 +662,22 @@ Sim::pinSetFuncAfter(const Pin *pin)
   recordConstPinFunc(pin);
 }
 
+bool
+Sim::constraintValueChanged(const Pin *pin)
+{
+  // Hierarchical pins do not have vertices to seed propagation.
+  if (incremental_
+      && !network_->isHierarchical(pin)) {
+    invalid_constraint_pins_.insert(pin);
+    valid_ = false;
+    return true;
+  }
+  else {
+    constantsInvalid();
+    return false;
+  }
+}
+
 void
 Sim::seedConstants()
 {
@@ -672,10 +694,72 @@ Sim::seedConstants()
 void
 Sim::propagateConstants(bool thru_sequentials)
 {
+  if (sim_parallel_
+      && thread_count_ > 1
+      && dispatch_queue_
+      // Instance evaluation debug prints would interleave.
+      && !debug_->check("sim", 2))
+    propagateConstantsParallel(thru_sequentials);
+  else {
+    while (!eval_queue_.empty()) {
+      const Instance *inst = eval_queue_.front();
+      eval_queue_.pop();
+      evalInstance(inst, thru_sequentials);
+    }
+  }
+}
+
+// Instances evaluated per thread at a time.
+static const size_t sim_chunk_size = 128;
+
+// Propagate constants one wave at a time. The queued instances are
+// evaluated in parallel and the changed output values are set in queue
+// order after all of them are evaluated, which queues the instances
+// in the next wave. Sim runs before levelization so the waves follow
+// the propagation front rather than graph levels.
+void
+Sim::propagateConstantsParallel(bool thru_sequentials)
+{
+  std::vector<const Instance*> insts;
+  std::unordered_set<const Instance*> queued;
+  std::vector<PinLogicValueSeq> chunk_changes;
   while (!eval_queue_.empty()) {
-    const Instance *inst = eval_queue_.front();
-    eval_queue_.pop();
-    evalInstance(inst, thru_sequentials);
+    insts.clear();
+    queued.clear();
+    while (!eval_queue_.empty()) {
+      const Instance *inst = eval_queue_.front();
+      eval_queue_.pop();
+      if (queued.insert(inst).second)
+        insts.push_back(inst);
+    }
+    size_t inst_count = insts.size();
+    if (inst_count < sim_chunk_size * 2) {
+      for (const Instance *inst : insts)
+        evalInstance(inst, thru_sequentials);
+    }
+    else {
+      size_t chunk_count = (inst_count + sim_chunk_size - 1) / sim_chunk_size;
+      chunk_changes.resize(chunk_count);
+      for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+        dispatch_queue_->dispatch([this, chunk, inst_count, thru_sequentials,
+                                   &insts, &chunk_changes] (int) {
+          PinLogicValueSeq &changes = chunk_changes[chunk];
+          changes.clear();
+          size_t to = std::min((chunk + 1) * sim_chunk_size, inst_count);
+          for (size_t i = chunk * sim_chunk_size; i < to; i++)
+            evalInstanceOutputs(insts[i], thru_sequentials, changes);
+        });
+      }
+      dispatch_queue_->finishTasks();
+      for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+        for (auto &pin_value : chunk_changes[chunk]) {
+          const Pin *pin = pin_value.first;
+          LogicValue value = pin_value.second;
+          if (value != logicValue(pin))
+            setPinValue(pin, value);
+        }
+      }
+    }
   }
 }
 
@@ -840,60 +924,111 @@ Sim::evalInstance(const Instance *inst,
   while (pin_iter->hasNext()) {
     Pin *pin = pin_iter->next();
     LibertyPort *port = network_->libertyPort(pin);
-    if (port) {
-      PortDirection *dir = port->direction();
-      if (dir->isAnyOutput()) {
-        LogicValue value = LogicValue::unknown;
-	FuncExpr *expr = port->function();
-        LibertyCell *cell = port->libertyCell();
-	if (expr) {
-          FuncExpr *tri_en_expr = port->tristateEnable();
-          if (tri_en_expr) {
-            if (evalExpr(tri_en_expr, inst) == LogicValue::one) {
-              value = evalExpr(expr, inst);
-              debugPrint(debug_, "sim", 2, " %s tri_en=1 %s = %c",
-                         port->name(),
-                         expr->asString(),
-                         logicValueString(value));
-            }
-          }
-          else {
-            LibertyPort *expr_port = expr->port();
-            Sequential *sequential = (thru_sequentials && expr_port) 
-              ? cell->outputPortSequential(expr_port)
-              : nullptr;
-            if (sequential) {
-              value = evalExpr(sequential->data(), inst);
-              if (expr_port == sequential->outputInv())
-                value = logicNot(value);
-              debugPrint(debug_, "sim", 2, " %s seq %s = %c",
-                         port->name(),
-                         expr->asString(),
-                         logicValueString(value));
-            }
-            else {
-              value = evalExpr(expr, inst);
-              debugPrint(debug_, "sim", 2, " %s %s = %c",
-                         port->name(),
-                         expr->asString(),
-                         logicValueString(value));
-            }
-          }
-        }
-        else if (port->isClockGateOut()) {
-          value = clockGateOutValue(inst);
-          debugPrint(debug_, "sim", 2, " %s gated_clk = %c",
-                     port->name(),
-                     logicValueString(value));
-        }
-        if (value != logicValue(pin))
-          setPinValue(pin, value);
-      }
+    if (port
+        && port->direction()->isAnyOutput()) {
+      LogicValue value = evalOutput(inst, port, thru_sequentials);
+      if (value != logicValue(pin))
+        setPinValue(pin, value);
     }
   }
   delete pin_iter;
 }
 
+// Thread safe.
+void
+Sim::evalInstanceOutputs(const Instance *inst,
+                         bool thru_sequentials,
+                         PinLogicValueSeq &changes)
+{
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    Pin *pin = pin_iter->next();
+    LibertyPort *port = network_->libertyPort(pin);
+    if (port
+        && port->direction()->isAnyOutput()) {
+      LogicValue value = evalOutput(inst, port, thru_sequentials);
+      if (value != logicValue(pin))
+        changes.push_back(std::make_pair(pin, value));
+    }
+  }
+  delete pin_iter;
+}
+
+LogicValue
+Sim::evalOutput(const Instance *inst,
+                const LibertyPort *port,
+                bool thru_sequentials)
+{
+  LogicValue value = LogicValue::unknown;
+  FuncExpr *expr = port->function();
+  LibertyCell *cell = port->libertyCell();
+  if (expr) {
+    FuncExpr *tri_en_expr = port->tristateEnable();
+    if (tri_en_expr) {
+      if (evalExpr(tri_en_expr, inst) == LogicValue::one) {
+        value = evalExpr(expr, inst);
+        debugPrint(debug_, "sim", 2, " %s tri_en=1 %s = %c",
+                   port->name(),
+                   expr->asString(),
+                   logicValueString(value));
+      }
+    }
+    else {
+      LibertyPort *expr_port = expr->port();
+      Sequential *sequential = (thru_sequentials && expr_port)
+        ? cell->outputPortSequential(expr_port)
+        : nullptr;
+      if (sequential) {
+        value = evalExpr(sequential->data(), inst);
+        if (expr_port == sequential->outputInv())
+          value = logicNot(value);
+        debugPrint(debug_, "sim", 2, " %s seq %s = %c",
+                   port->name(),
+                   expr->asString(),
+                   logicValueString(value));
+      }
+      else {
+        value = evalExpr(expr, inst);
+        debugPrint(debug_, "sim", 2, " %s %s = %c",
+                   port->name(),
+                   expr->asString(),
+                   logicValueString(value));
+      }
+    }
+  }
+  else if (port->isClockGateOut()) {
+    value = clockGateOutValue(inst);
+    debugPrint(debug_, "sim", 2, " %s gated_clk = %c",
+               port->name(),
+               logicValueString(value));
+  }
+  return value;
+}
+
+// Cell functions are compiled to truth tables when they are read, so
+// this avoids building and composing BDDs (and the BDD lock) for
+// almost every instance.
+LogicValue
+Sim::evalCompiled(const FuncExprEval *eval,
+                  const Instance *inst) const
+{
+  size_t port_count = eval->portCount();
+  LogicValue values_buffer[FuncExprEval::truth_table_port_max] = {};
+  std::vector<LogicValue> values_vector;
+  LogicValue *values = values_buffer;
+  if (port_count > FuncExprEval::truth_table_port_max) {
+    values_vector.resize(port_count);
+    values = values_vector.data();
+  }
+  for (size_t i = 0; i < port_count; i++) {
+    LibertyPort *port = eval->port(i);
+    // Internal ports don't have instance pins.
+    const Pin *pin = port ? network_->findPin(inst, port) : nullptr;
+    values[i] = pin ? logicValue(pin) : LogicValue::unknown;
+  }
+  return eval->eval(values);
+}
+
 LogicValue
 Sim::clockGateOutValue(const Instance *inst)
 {
@@ -18,6 +18,8 @@
 
 #include <queue>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "StaConfig.hh"  // CUDD
 #include "Map.hh"
@@ -30,9 +32,11 @@
 namespace sta {
 
 class SimObserver;
+class FuncExprEval;
 
 typedef Map<const Pin*, LogicValue> PinValueMap;
 typedef std::queue<const Instance*> EvalQueue;
+typedef std::vector<std::pair<const Pin*, LogicValue>> PinLogicValueSeq;
 
 // Propagate constants from constraints and netlist tie high/low
 // connections thru gates.
@@ -42,6 +46,8 @@ public:
   explicit Sim(StaState *sta);
   virtual ~Sim();
   void clear();
+  // BDDs for cell functions that are too big for truth tables.
+  Bdd *bdd() { return &bdd_; }
   // Set the observer for simulation value changes.
   void setObserver(SimObserver *observer);
   void ensureConstantsPropagated();
@@ -65,13 +71,19 @@ public:
   void connectPinAfter(const Pin *pin);
   void disconnectPinBefore(const Pin *pin);
   void pinSetFuncAfter(const Pin *pin);
+  // The set_case_analysis or set_logic_zero/one/dc value of pin changed.
+  // Only the constants in the fanout of pin are propagated again.
+  // Return false if all of the constants have to be propagated again.
+  bool constraintValueChanged(const Pin *pin);
 
 protected:
   void ensureConstantFuncPins();
   void recordConstPinFunc(const Pin *pin);
   virtual void seedConstants();
   void seedInvalidConstants();
+  void propagateInvalidConstraintPins();
   void propagateConstants(bool thru_sequentials);
+  void propagateConstantsParallel(bool thru_sequentials);
   void setConstraintConstPins(LogicValueMap &pin_value_map);
   void setConstFuncPins();
   LogicValue pinConstFuncValue(const Pin *pin);
@@ -81,6 +93,21 @@ protected:
   void enqueue(const Instance *inst);
   void evalInstance(const Instance *inst,
                     bool thru_sequentials);
+  // Append the output pins of inst with changed values.
+  void evalInstanceOutputs(const Instance *inst,
+                           bool thru_sequentials,
+                           // Return value.
+                           PinLogicValueSeq &changes);
+  LogicValue evalOutput(const Instance *inst,
+                        const LibertyPort *port,
+                        bool thru_sequentials);
+  // Evaluate the compiled function with the instance pin values.
+  LogicValue evalCompiled(const FuncExprEval *eval,
+                          const Instance *inst) const;
+#if CUDD
+  LogicValue evalBdd(const FuncExpr *expr,
+                     const Instance *inst);
+#endif
   LogicValue clockGateOutValue(const Instance *inst);
   TimingSense functionSense(const FuncExpr *expr,
 			    const Pin *input_pin,
@@ -123,10 +150,13 @@ protected:
   PinSet invalid_drvr_pins_;
   // Load pins that waiting for the driver constant to propagate.
   PinSet invalid_load_pins_;
+  // Pins with changed constraint values.
+  PinSet invalid_constraint_pins_;
   EvalQueue eval_queue_;
   // Instances with constant pin values for annotateVertexEdges.
   InstanceSet instances_with_const_pins_;
   InstanceSet instances_to_annotate_;
+  // Shared with Power so cell function BDDs are built once.
   Bdd bdd_;
   mutable std::mutex bdd_lock_;
 };
@@ -29,10 +29,13 @@
 #include "Liberty.hh"
 #include "liberty/LibertyReader.hh"
 #include "LibertyWriter.hh"
+#include "LibertyDb.hh"
 #include "SdcNetwork.hh"
 #include "MakeConcreteNetwork.hh"
 #include "PortDirection.hh"
 #include "VerilogReader.hh"
+#include "ConcreteNetwork.hh"
+#include "NetlistDb.hh"
 #include "Graph.hh"
 #include "GraphCmp.hh"
 #include "Sdc.hh"
@@ -42,6 +45,9 @@
 #include "Parasitics.hh"
 #include "parasitics/SpefReader.hh"
 #include "parasitics/ReportParasiticAnnotation.hh"
+#include "parasitics/ParasiticsCache.hh"
+#include "parasitics/EstimateParasitics.hh"
+#include "TimingSnapshot.hh"
 #include "DelayCalc.hh"
 #include "ArcDelayCalc.hh"
 #include "GraphDelayCalc.hh"
@@ -53,6 +59,7 @@
 #include "PathAnalysisPt.hh"
 #include "Corner.hh"
 #include "Search.hh"
+#include "Bfs.hh"
 #include "Latches.hh"
 #include "PathGroup.hh"
 #include "CheckTiming.hh"
@@ -62,10 +69,14 @@
 #include "CheckMinPulseWidths.hh"
 #include "CheckMinPeriods.hh"
 #include "CheckMaxSkews.hh"
+#include "LimitViolators.hh"
 #include "ClkSkew.hh"
 #include "ClkLatency.hh"
 #include "FindRegister.hh"
 #include "ReportPath.hh"
+#include "WritePathReport.hh"
+#include "EndpointSlacks.hh"
+#include "WriteTimingContext.hh"
 #include "VisitPathGroupVertices.hh"
 #include "Genclks.hh"
 #include "ClkNetwork.hh"
@@ -73,6 +84,11 @@
 #include "VisitPathEnds.hh"
 #include "PathExpanded.hh"
 #include "MakeTimingModel.hh"
+#include "MemoryStats.hh"
+#include "ObjectPool.hh"
+#include "TableBlockPool.hh"
+#include "Tracer.hh"
+#include "TimingProgress.hh"
 
 namespace sta {
 
@@ -104,18 +120,22 @@ pinInstances(PinSet &pins,
 class StaDelayCalcObserver : public DelayCalcObserver
 {
 public:
-  explicit StaDelayCalcObserver(Search *search);
+  StaDelayCalcObserver(Search *search,
+                       Sta *sta);
   virtual void delayChangedFrom(Vertex *vertex);
   virtual void delayChangedTo(Vertex *vertex);
   virtual void checkDelayChangedTo(Vertex *vertex);
 
 private:
   Search *search_;
+  Sta *sta_;
 };
 
-StaDelayCalcObserver::StaDelayCalcObserver(Search *search) :
+StaDelayCalcObserver::StaDelayCalcObserver(Search *search,
+                                           Sta *sta) :
   DelayCalcObserver(),
-  search_(search)
+  search_(search),
+  sta_(sta)
 {
 }
 
@@ -129,6 +149,7 @@ void
 StaDelayCalcObserver::delayChangedTo(Vertex *vertex)
 {
   search_->arrivalInvalid(vertex);
+  sta_->limitPinChanged(vertex->pin());
 }
 
 void
@@ -192,6 +213,8 @@ StaSimObserver::fanoutEdgesChangeAfter(Vertex *vertex)
 {
   search_->requiredInvalid(vertex);
   search_->endpointInvalid(vertex);
+  // Enabled fanout edges can raise the levels downstream.
+  levelize_->relevelizeFrom(vertex);
 }
 
 ////////////////////////////////////////////////////////////////
@@ -238,6 +261,7 @@ deleteAllMemory()
   // Verilog modules refer to the network in the sta so it has
   // to deleted before the sta.
   deleteVerilogReader();
+  deleteNetlistDbReader();
   Sta *sta = Sta::sta();
   if (sta) {
     delete sta;
@@ -255,6 +279,34 @@ deleteAllMemory()
 // Singleton used by TCL commands.
 Sta *Sta::sta_;
 
+// Network edit logged by a what-if session so it can be undone.
+class WhatIfEdit
+{
+public:
+  enum class Kind { make_instance, make_net, replace_cell,
+                    connect_pin, disconnect_pin };
+
+  Kind kind_;
+  Instance *inst_;
+  Port *port_;
+  Net *net_;
+  Cell *cell_;
+};
+
+class WhatIfEdits : public Vector<WhatIfEdit>
+{
+};
+
+// Search and graph timing of a mode that is not current.
+class ModeTiming
+{
+public:
+  Search *search_;
+  GraphModeTiming *graph_timing_;
+  // GraphDelayCalc::invalidCount after switching away from the mode.
+  size_t delay_invalid_count_;
+};
+
 Sta::Sta() :
   StaState(),
   current_instance_(nullptr),
@@ -266,14 +318,37 @@ Sta::Sta() :
   check_min_periods_(nullptr),
   check_max_skews_(nullptr),
   clk_skews_(nullptr),
+  reg_clk_pins_(nullptr),
   report_path_(nullptr),
   power_(nullptr),
   link_make_black_boxes_(true),
   update_genclks_(false),
   equiv_cells_(nullptr),
   graph_sdc_annotated_(false),
+  graph_adjacency_snapshot_(false),
+  graph_level_order_(false),
+  thread_pinning_(false),
+  spef_read_parallel_(false),
+  verilog_link_parallel_(false),
+  liberty_lazy_load_(false),
+  liberty_read_parallel_(false),
   // Default to same parasitics for all corners.
-  parasitics_per_corner_(false)
+  parasitics_per_corner_(false),
+  mode_name_(nullptr),
+  keep_mode_timing_(false),
+  what_if_edits_(nullptr),
+  sdc_batch_depth_(0),
+  sdc_batch_from_(new VertexSet(graph_)),
+  sdc_batch_fanin_(new VertexSet(graph_)),
+  netlist_edit_depth_(0),
+  netlist_edit_drvrs_(new VertexSet(graph_)),
+  netlist_edit_loads_(new VertexSet(graph_)),
+  timing_progress_(new TimingProgress),
+  timing_update_thread_(nullptr),
+  timing_update_completed_(true),
+  timing_frozen_(false),
+  frozen_delay_invalid_count_(0),
+  frozen_search_invalid_count_(0)
 {
 }
 
@@ -285,6 +360,7 @@ Sta::makeComponents()
   makeUnits();
   makeNetwork();
   makeSdc();
+  makeDefaultMode();
   makeLevelize();
   makeParasitics();
   makeCorners();
@@ -300,6 +376,8 @@ Sta::makeComponents()
   setCmdNamespace1(CmdNamespace::sdc);
   setThreadCount1(defaultThreadCount());
   updateComponentsState();
+  graph_delay_calc_->iterator()->setProgress(timing_progress_, false);
+  search_->arrivalIterator()->setProgress(timing_progress_, true);
 
   makeObservers();
   // This must follow updateComponentsState.
@@ -309,7 +387,7 @@ Sta::makeComponents()
 void
 Sta::makeObservers()
 {
-  graph_delay_calc_->setObserver(new StaDelayCalcObserver(search_));
+  graph_delay_calc_->setObserver(new StaDelayCalcObserver(search_, this));
   sim_->setObserver(new StaSimObserver(graph_delay_calc_, levelize_, search_));
   levelize_->setObserver(new StaLevelizeObserver(search_));
 }
@@ -333,8 +411,216 @@ Sta::setThreadCount1(int thread_count)
   thread_count_ = thread_count;
   if (dispatch_queue_)
     dispatch_queue_->setThreadCount(thread_count);
-  else if (thread_count > 1)
+  else if (thread_count > 1) {
     dispatch_queue_ = new DispatchQueue(thread_count);
+    dispatch_queue_->setTracer(debug_->tracer());
+    if (thread_pinning_)
+      dispatch_queue_->setThreadPinning(true);
+  }
+  debug_->tracer()->setThreadCount(thread_count);
+}
+
+bool
+Sta::threadPinning() const
+{
+  return thread_pinning_;
+}
+
+void
+Sta::setThreadPinning(bool enabled)
+{
+  thread_pinning_ = enabled;
+  if (dispatch_queue_)
+    dispatch_queue_->setThreadPinning(enabled);
+}
+
+bool
+Sta::bfsWorkStealing() const
+{
+  return bfs_work_stealing_;
+}
+
+void
+Sta::setBfsWorkStealing(bool enabled)
+{
+  bfs_work_stealing_ = enabled;
+  updateComponentsState();
+}
+
+bool
+Sta::bfsDependencyDriven() const
+{
+  return bfs_dependency_driven_;
+}
+
+void
+Sta::setBfsDependencyDriven(bool enabled)
+{
+  bfs_dependency_driven_ = enabled;
+  updateComponentsState();
+}
+
+int
+Sta::bfsPrefetchDistance() const
+{
+  return bfs_prefetch_distance_;
+}
+
+void
+Sta::setBfsPrefetchDistance(int distance)
+{
+  bfs_prefetch_distance_ = distance;
+  updateComponentsState();
+}
+
+bool
+Sta::levelizeParallel() const
+{
+  return levelize_parallel_;
+}
+
+void
+Sta::setLevelizeParallel(bool enabled)
+{
+  levelize_parallel_ = enabled;
+  updateComponentsState();
+}
+
+bool
+Sta::levelizeScc() const
+{
+  return levelize_scc_;
+}
+
+void
+Sta::setLevelizeScc(bool enabled)
+{
+  if (enabled != levelize_scc_) {
+    levelize_scc_ = enabled;
+    updateComponentsState();
+    // Loops are broken differently.
+    levelize_->invalid();
+    graph_delay_calc_->delaysInvalid();
+    search_->arrivalsInvalid();
+  }
+}
+
+bool
+Sta::simParallel() const
+{
+  return sim_parallel_;
+}
+
+void
+Sta::setSimParallel(bool enabled)
+{
+  sim_parallel_ = enabled;
+  updateComponentsState();
+}
+
+bool
+Sta::searchPathApParallel() const
+{
+  return search_path_ap_parallel_;
+}
+
+void
+Sta::setSearchPathApParallel(bool enabled)
+{
+  search_path_ap_parallel_ = enabled;
+  updateComponentsState();
+}
+
+bool
+Sta::graphAdjacencySnapshot() const
+{
+  return graph_adjacency_snapshot_;
+}
+
+void
+Sta::setGraphAdjacencySnapshot(bool enabled)
+{
+  graph_adjacency_snapshot_ = enabled;
+  if (graph_) {
+    if (enabled)
+      graph_->makeAdjacencySnapshot();
+    else
+      graph_->adjacencySnapshotInvalid();
+  }
+}
+
+bool
+Sta::graphLevelOrder() const
+{
+  return graph_level_order_;
+}
+
+void
+Sta::setGraphLevelOrder(bool enabled)
+{
+  graph_level_order_ = enabled;
+}
+
+bool
+Sta::keepModeTiming() const
+{
+  return keep_mode_timing_;
+}
+
+void
+Sta::setKeepModeTiming(bool keep)
+{
+  keep_mode_timing_ = keep;
+  if (!keep)
+    deleteModeTimings();
+}
+
+bool
+Sta::spefReadParallel() const
+{
+  return spef_read_parallel_;
+}
+
+void
+Sta::setSpefReadParallel(bool enabled)
+{
+  spef_read_parallel_ = enabled;
+}
+
+bool
+Sta::verilogLinkParallel() const
+{
+  return verilog_link_parallel_;
+}
+
+void
+Sta::setVerilogLinkParallel(bool enabled)
+{
+  verilog_link_parallel_ = enabled;
+}
+
+bool
+Sta::libertyLazyLoad() const
+{
+  return liberty_lazy_load_;
+}
+
+void
+Sta::setLibertyLazyLoad(bool enabled)
+{
+  liberty_lazy_load_ = enabled;
+}
+
+bool
+Sta::libertyReadParallel() const
+{
+  return liberty_read_parallel_;
+}
+
+void
+Sta::setLibertyReadParallel(bool enabled)
+{
+  liberty_read_parallel_ = enabled;
 }
 
 void
@@ -358,6 +644,10 @@ Sta::updateComponentsState()
   report_path_->copyState(this);
   if (check_timing_)
     check_timing_->copyState(this);
+  if (reg_clk_pins_)
+    reg_clk_pins_->copyState(this);
+  if (clk_skews_)
+    clk_skews_->copyState(this);
   clk_network_->copyState(this);
   if (power_)
     power_->copyState(this);
@@ -515,6 +805,8 @@ Sta::sta()
 
 Sta::~Sta()
 {
+  cancelTimingUpdate();
+  delete timing_progress_;
   // Delete "top down" to minimize chance of referencing deleted memory.
   delete check_slew_limits_;
   delete check_fanout_limits_;
@@ -523,8 +815,10 @@ Sta::~Sta()
   delete check_min_periods_;
   delete check_max_skews_;
   delete clk_skews_;
+  delete reg_clk_pins_;
   delete check_timing_;
   delete report_path_;
+  deleteModeTimings();
   // Constraints reference search filter, so delete search first.
   delete search_;
   delete latches_;
@@ -534,6 +828,7 @@ Sta::~Sta()
   delete graph_delay_calc_;
   delete sim_;
   delete levelize_;
+  deleteModes();
   delete sdc_;
   delete corners_;
   delete graph_;
@@ -546,14 +841,27 @@ Sta::~Sta()
   delete power_;
   delete equiv_cells_;
   delete dispatch_queue_;
+  delete what_if_edits_;
+  delete netlist_edit_drvrs_;
+  delete netlist_edit_loads_;
+  delete sdc_batch_from_;
+  delete sdc_batch_fanin_;
 }
 
 void
 Sta::clear()
 {
+  cancelTimingUpdate();
+  thawTiming();
+  regClkPinsInvalid();
   clkPinsInvalid();
+  deleteModeTimings();
   // Constraints reference search filter, so clear search first.
   search_->clear();
+  // Clear the other modes first so the current mode liberty
+  // annotations are removed last.
+  for (Sdc *sdc : otherModeSdcs())
+    sdc->clear();
   sdc_->clear();
   graph_sdc_annotated_ = false;
   // corners are NOT cleared because they are used to index liberty files.
@@ -562,13 +870,21 @@ Sta::clear()
     parasitics_->clear();
   graph_delay_calc_->clear();
   sim_->clear();
+  power_->activitiesInvalid();
   if (check_min_pulse_widths_)
     check_min_pulse_widths_->clear();
   if (check_min_periods_)
     check_min_periods_->clear();
+  limitViolatorsClear();
+  netlist_edit_drvrs_->clear();
+  netlist_edit_loads_->clear();
   delete graph_;
   graph_ = nullptr;
   current_instance_ = nullptr;
+  delete what_if_edits_;
+  what_if_edits_ = nullptr;
+  sdc_batch_from_->clear();
+  sdc_batch_fanin_->clear();
   // Notify components that graph is toast.
   updateComponentsState();
 }
@@ -576,6 +892,8 @@ Sta::clear()
 void
 Sta::networkChanged()
 {
+  regClkPinsInvalid();
+  deleteModeTimings();
   // Everything else from clear().
   search_->clear();
   levelize_->clear();
@@ -583,10 +901,16 @@ Sta::networkChanged()
     parasitics_->clear();
   graph_delay_calc_->clear();
   sim_->clear();
+  power_->activitiesInvalid();
   if (check_min_pulse_widths_)
     check_min_pulse_widths_->clear();
   if (check_min_periods_)
     check_min_periods_->clear();
+  limitViolatorsClear();
+  netlist_edit_drvrs_->clear();
+  netlist_edit_loads_->clear();
+  sdc_batch_from_->clear();
+  sdc_batch_fanin_->clear();
   delete graph_;
   graph_ = nullptr;
   graph_sdc_annotated_ = false;
@@ -679,26 +1003,98 @@ Sta::readLibertyFile(const char *filename,
 		     bool infer_latches)
 {
   LibertyLibrary *liberty = sta::readLibertyFile(filename, infer_latches,
-						 network_);
-  if (liberty) {
-    // Don't map liberty cells if they are redefined by reading another
-    // library with the same cell names.
-    if (min_max == MinMaxAll::all()) {
-      readLibertyAfter(liberty, corner, MinMax::min());
-      readLibertyAfter(liberty, corner, MinMax::max());
+						 liberty_lazy_load_, network_,
+                                                 libertyCellDispatchQueue());
+  if (liberty)
+    readLibertyAfter(liberty, corner, min_max);
+  return liberty;
+}
+
+LibertyLibrarySeq
+Sta::readLiberty(const StringSeq &filenames,
+		 Corner *corner,
+		 const MinMaxAll *min_max,
+		 bool infer_latches)
+{
+  Stats stats(debug_, report_);
+  LibertyLibrarySeq libraries = readLibertyFiles(filenames, infer_latches,
+                                                 liberty_lazy_load_,
+                                                 liberty_read_parallel_,
+                                                 network_,
+                                                 thread_count_,
+                                                 dispatch_queue_);
+  for (LibertyLibrary *library : libraries) {
+    if (library) {
+      readLibertyAfter(library, corner, min_max);
+      if (network_->defaultLibertyLibrary() == nullptr) {
+        network_->setDefaultLibertyLibrary(library);
+        *units_ = *library->units();
+      }
     }
-    else
-      readLibertyAfter(liberty, corner, min_max->asMinMax());
-    network_->readLibertyAfter(liberty);
   }
-  return liberty;
+  stats.report("Read liberty");
+  return libraries;
+}
+
+void
+Sta::writeLibertyDb(const char *liberty_filename,
+                    const char *filename)
+{
+  sta::writeLibertyDb(liberty_filename, filename, report_);
+}
+
+LibertyLibrary *
+Sta::readLibertyDb(const char *filename,
+                   Corner *corner,
+                   const MinMaxAll *min_max,
+                   bool infer_latches)
+{
+  Stats stats(debug_, report_);
+  LibertyLibrary *library = sta::readLibertyDb(filename, infer_latches,
+                                               network_);
+  if (library) {
+    readLibertyAfter(library, corner, min_max);
+    if (network_->defaultLibertyLibrary() == nullptr) {
+      network_->setDefaultLibertyLibrary(library);
+      *units_ = *library->units();
+    }
+  }
+  stats.report("Read liberty db");
+  return library;
+}
+
+void
+Sta::readLibertyAfter(LibertyLibrary *liberty,
+		      Corner *corner,
+		      const MinMaxAll *min_max)
+{
+  // Don't map liberty cells if they are redefined by reading another
+  // library with the same cell names.
+  if (min_max == MinMaxAll::all()) {
+    readLibertyAfter(liberty, corner, MinMax::min());
+    readLibertyAfter(liberty, corner, MinMax::max());
+  }
+  else
+    readLibertyAfter(liberty, corner, min_max->asMinMax());
+  network_->readLibertyAfter(liberty);
 }
 
 LibertyLibrary *
 Sta::readLibertyFile(const char *filename,
 		     bool infer_latches)
 {
-  return sta::readLibertyFile(filename, infer_latches, network_);
+  return sta::readLibertyFile(filename, infer_latches, liberty_lazy_load_,
+                              network_, libertyCellDispatchQueue());
+}
+
+// Dispatch queue to build liberty cells with.
+DispatchQueue *
+Sta::libertyCellDispatchQueue() const
+{
+  if (liberty_read_parallel_ && thread_count_ > 1)
+    return dispatch_queue_;
+  else
+    return nullptr;
 }
 
 void
@@ -739,6 +1135,9 @@ Sta::linkDesign(const char *top_cell_name)
 {
   clear();
   Stats stats(debug_, report_);
+  setVerilogLinkDispatchQueue((verilog_link_parallel_ && thread_count_ > 1)
+                              ? dispatch_queue_
+                              : nullptr);
   bool status = network_->linkNetwork(top_cell_name,
 				      link_make_black_boxes_,
 				      report_);
@@ -746,6 +1145,32 @@ Sta::linkDesign(const char *top_cell_name)
   return status;
 }
 
+void
+Sta::writeNetlistDb(const char *filename)
+{
+  ConcreteNetwork *network = dynamic_cast<ConcreteNetwork*>(network_);
+  if (network)
+    sta::writeNetlistDb(filename, network);
+}
+
+bool
+Sta::readNetlistDb(const char *filename)
+{
+  NetworkReader *network_reader = networkReader();
+  if (network_reader) {
+    readNetlistBefore();
+    const char *top_cell_name =
+      sta::readNetlistDb(filename, network_reader,
+                         (thread_count_ > 1) ? dispatch_queue_ : nullptr);
+    if (top_cell_name) {
+      // The name is in the file data that linking releases.
+      string top_name = top_cell_name;
+      return linkDesign(top_name.c_str());
+    }
+  }
+  return false;
+}
+
 bool
 Sta::linkMakeBlackBoxes() const
 {
@@ -777,9 +1202,13 @@ Sta::setAnalysisType(AnalysisType analysis_type)
     graph_delay_calc_->delaysInvalid();
     search_->arrivalsInvalid();
     search_->deletePathGroups();
+    // Saved tags reference the path analysis points.
+    deleteModeTimings();
     corners_->analysisTypeChanged();
-    if (graph_)
+    if (graph_) {
       graph_->setDelayCount(corners_->dcalcAnalysisPtCount());
+      shareGraphDelays();
+    }
   }
 }
 
@@ -1028,6 +1457,8 @@ Sta::setSlewLimit(Clock *clk,
 		  float slew)
 {
   sdc_->setSlewLimit(clk, rf, clk_data, min_max, slew);
+  if (check_slew_limits_)
+    check_slew_limits_->clear();
 }
 
 void
@@ -1036,6 +1467,8 @@ Sta::setSlewLimit(Port *port,
 		  float slew)
 {
   sdc_->setSlewLimit(port, min_max, slew);
+  if (check_slew_limits_)
+    check_slew_limits_->clear();
 }
 
 void
@@ -1044,6 +1477,8 @@ Sta::setSlewLimit(Cell *cell,
 		  float slew)
 {
   sdc_->setSlewLimit(cell, min_max, slew);
+  if (check_slew_limits_)
+    check_slew_limits_->clear();
 }
 
 void
@@ -1052,6 +1487,8 @@ Sta::setCapacitanceLimit(Cell *cell,
 			 float cap)
 {
   sdc_->setCapacitanceLimit(cell, min_max, cap);
+  if (check_capacitance_limits_)
+    check_capacitance_limits_->clear();
 }
 
 void
@@ -1060,6 +1497,8 @@ Sta::setCapacitanceLimit(Port *port,
 			 float cap)
 {
   sdc_->setCapacitanceLimit(port, min_max, cap);
+  if (check_capacitance_limits_)
+    check_capacitance_limits_->clear();
 }
 
 void
@@ -1068,6 +1507,8 @@ Sta::setCapacitanceLimit(Pin *pin,
 			 float cap)
 {
   sdc_->setCapacitanceLimit(pin, min_max, cap);
+  if (check_capacitance_limits_)
+    check_capacitance_limits_->clear();
 }
 
 void
@@ -1076,6 +1517,8 @@ Sta::setFanoutLimit(Cell *cell,
 		    float fanout)
 {
   sdc_->setFanoutLimit(cell, min_max, fanout);
+  if (check_fanout_limits_)
+    check_fanout_limits_->clear();
 }
 
 void
@@ -1084,6 +1527,8 @@ Sta::setFanoutLimit(Port *port,
 		    float fanout)
 {
   sdc_->setFanoutLimit(port, min_max, fanout);
+  if (check_fanout_limits_)
+    check_fanout_limits_->clear();
 }
 
 void
@@ -1232,6 +1677,56 @@ Sta::ensureGraphSdcAnnotated()
   }
 }
 
+////////////////////////////////////////////////////////////////
+
+void
+Sta::sdcBatchBegin()
+{
+  sdc_batch_depth_++;
+}
+
+void
+Sta::sdcBatchEnd()
+{
+  if (sdc_batch_depth_ > 0) {
+    sdc_batch_depth_--;
+    if (sdc_batch_depth_ == 0)
+      sdcBatchInvalidate();
+  }
+}
+
+bool
+Sta::sdcBatchDefer(Vertex *vertex,
+                   VertexSet *vertices)
+{
+  if (sdc_batch_depth_ > 0) {
+    vertices->insert(vertex);
+    return true;
+  }
+  else
+    return false;
+}
+
+// Invalidate the vertices recorded inside the batch.
+void
+Sta::sdcBatchInvalidate()
+{
+  for (Vertex *vertex : *sdc_batch_fanin_) {
+    VertexInEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      sdc_batch_from_->insert(edge->from(graph_));
+    }
+  }
+  for (Vertex *vertex : *sdc_batch_from_) {
+    search_->arrivalInvalid(vertex);
+    search_->requiredInvalid(vertex);
+    graph_delay_calc_->delayInvalid(vertex);
+  }
+  sdc_batch_fanin_->clear();
+  sdc_batch_from_->clear();
+}
+
 void
 Sta::removeClockLatency(const Clock *clk,
 			const Pin *pin)
@@ -1826,17 +2321,28 @@ Sta::setLogicValue(Pin *pin,
 		   LogicValue value)
 {
   sdc_->setLogicValue(pin, value);
-  // Levelization respects constant disabled edges.
-  levelize_->invalid();
-  sim_->constantsInvalid();
-  // Constants disable edges which isolate downstream vertices of the
-  // graph from the delay calculator's BFS search.  This means that
-  // simply invaldating the delays downstream from the constant pin
-  // fails.  This could be more incremental if the graph delay
-  // calculator searched thru disabled edges but ignored their
-  // results.
-  graph_delay_calc_->delaysInvalid();
-  search_->arrivalsInvalid();
+  constraintValueChanged(pin);
+}
+
+// When Sim can propagate the changed constants from pin incrementally
+// the sim observer invalidates the levels, delays and arrivals of the
+// vertices whose values or disabled edges change.
+void
+Sta::constraintValueChanged(const Pin *pin)
+{
+  regClkPinsInvalid();
+  bool incremental = graph_ && sim_->constraintValueChanged(pin);
+  if (!incremental) {
+    sim_->constantsInvalid();
+    // Levelization respects constant disabled edges.
+    levelize_->invalid();
+    // Constants disable edges which isolate downstream vertices of the
+    // graph from the delay calculator's BFS search.  This means that
+    // simply invaldating the delays downstream from the constant pin
+    // fails.
+    graph_delay_calc_->delaysInvalid();
+    search_->arrivalsInvalid();
+  }
 }
 
 void
@@ -1844,32 +2350,14 @@ Sta::setCaseAnalysis(Pin *pin,
 		     LogicValue value)
 {
   sdc_->setCaseAnalysis(pin, value);
-  // Levelization respects constant disabled edges.
-  levelize_->invalid();
-  sim_->constantsInvalid();
-  // Constants disable edges which isolate downstream vertices of the
-  // graph from the delay calculator's BFS search.  This means that
-  // simply invaldating the delays downstream from the constant pin
-  // fails.  This could be handled incrementally by invalidating delays
-  // on the output of gates one level downstream.
-  graph_delay_calc_->delaysInvalid();
-  search_->arrivalsInvalid();
+  constraintValueChanged(pin);
 }
 
 void
 Sta::removeCaseAnalysis(Pin *pin)
 {
   sdc_->removeCaseAnalysis(pin);
-  // Levelization respects constant disabled edges.
-  levelize_->invalid();
-  sim_->constantsInvalid();
-  // Constants disable edges which isolate downstream vertices of the
-  // graph from the delay calculator's BFS search.  This means that
-  // simply invaldating the delays downstream from the constant pin
-  // fails.  This could be handled incrementally by invalidating delays
-  // on the output of gates one level downstream.
-  graph_delay_calc_->delaysInvalid();
-  search_->arrivalsInvalid();
+  constraintValueChanged(pin);
 }
 
 void
@@ -2125,6 +2613,231 @@ Sta::removeConstraints()
   clk_network_->clear();
 }
 
+void
+Sta::makeDefaultMode()
+{
+  mode_name_ = stringCopy("default");
+  mode_sdcs_[mode_name_] = sdc_;
+}
+
+void
+Sta::deleteModes()
+{
+  for (auto name_sdc : mode_sdcs_) {
+    Sdc *sdc = name_sdc.second;
+    if (sdc != sdc_)
+      delete sdc;
+    stringDelete(name_sdc.first);
+  }
+  mode_sdcs_.clear();
+  mode_name_ = nullptr;
+}
+
+void
+Sta::makeMode(const char *mode_name)
+{
+  if (mode_sdcs_.hasKey(mode_name))
+    report_->error(1619, "mode %s already exists.", mode_name);
+  mode_sdcs_[stringCopy(mode_name)] = new Sdc(this);
+}
+
+void
+Sta::setCurrentMode(const char *mode_name)
+{
+  auto mode_itr = mode_sdcs_.find(mode_name);
+  if (mode_itr == mode_sdcs_.end())
+    report_->error(1658, "mode %s not found.", mode_name);
+  Sdc *sdc = mode_itr->second;
+  if (sdc != sdc_) {
+    size_t delay_invalid_count = graph_delay_calc_->invalidCount();
+    const Sdc *prev_sdc = sdc_;
+    bool analysis_type_changed = sdc->analysisType() != sdc_->analysisType();
+    if (analysis_type_changed)
+      // Saved tags reference the path analysis points.
+      deleteModeTimings();
+    ModeTiming *prev_timing = analysis_type_changed ? nullptr : saveModeTiming();
+    if (prev_timing == nullptr)
+      // Tags and path groups reference the clocks and exceptions of the
+      // current mode, so clear search before switching.
+      search_->clear();
+    levelize_->invalid();
+    graph_delay_calc_->delaysInvalid();
+    sim_->constantsInvalid();
+    clk_network_->clear();
+    regClkPinsInvalid();
+    if (check_min_pulse_widths_)
+      check_min_pulse_widths_->clear();
+    if (check_min_periods_)
+      check_min_periods_->clear();
+    limitViolatorsClear();
+    if (graph_sdc_annotated_)
+      sdc_->removeGraphAnnotations();
+    graph_sdc_annotated_ = false;
+    sdc_->removeLibertyAnnotations();
+    AnalysisType analysis_type = sdc_->analysisType();
+
+    sdc_ = sdc;
+    mode_name_ = mode_itr->first;
+    updateComponentsState();
+    sdc_->annotateLiberty();
+    if (sdc_->analysisType() != analysis_type) {
+      corners_->analysisTypeChanged();
+      if (graph_)
+        graph_->setDelayCount(corners_->dcalcAnalysisPtCount());
+    }
+    corners_->operatingConditionsChanged();
+    if (graph_)
+      shareGraphDelays();
+    if (keep_mode_timing_)
+      restoreModeTiming(prev_timing != nullptr, delay_invalid_count);
+    if (prev_timing) {
+      prev_timing->delay_invalid_count_ = graph_delay_calc_->invalidCount();
+      mode_timings_[prev_sdc] = prev_timing;
+    }
+  }
+}
+
+// Put the current search aside if it can be used again when the mode
+// is current again.
+ModeTiming *
+Sta::saveModeTiming()
+{
+  if (keep_mode_timing_
+      && graph_
+      && !timingFrozen()) {
+    waitTimingUpdate();
+    if (!search_->isIdle())
+      return nullptr;
+    ModeTiming *timing = new ModeTiming;
+    timing->search_ = search_;
+    timing->graph_timing_ = graph_->saveModeTiming();
+    timing->delay_invalid_count_ = 0;
+    return timing;
+  }
+  else
+    return nullptr;
+}
+
+// Install the saved search of the current mode, or a new search if
+// the previous one was saved.
+void
+Sta::restoreModeTiming(bool search_saved,
+                       size_t delay_invalid_count)
+{
+  ModeTiming *timing = mode_timings_.findKey(sdc_);
+  if (timing) {
+    if (graph_ && graph_->modeTimingValid(timing->graph_timing_))
+      mode_timings_.erase(sdc_);
+    else {
+      debugPrint(debug_, "mode", 1, "mode %s timing invalid", mode_name_);
+      deleteModeTiming(sdc_);
+      timing = nullptr;
+    }
+  }
+  Search *prev_search = search_;
+  if (timing)
+    search_ = timing->search_;
+  else if (search_saved)
+    makeSearch();
+  if (search_ != prev_search) {
+    updateComponentsState();
+    search_->arrivalIterator()->setProgress(timing_progress_, true);
+  }
+  if (graph_) {
+    // Find the constants and levels of the mode now without notifying
+    // delay calculation or the search, which has no arrivals or the
+    // arrivals for them. Invalidations made later while the mode is
+    // current are changes the saved timing of other modes has to see.
+    sim_->setObserver(nullptr);
+    levelize_->setObserver(nullptr);
+    ensureLevelized();
+  }
+  makeObservers();
+  if (timing) {
+    debugPrint(debug_, "mode", 1, "restore mode %s timing", mode_name_);
+    VertexSeq level_changes;
+    graph_->restoreModeTiming(timing->graph_timing_, level_changes);
+    for (Vertex *vertex : level_changes)
+      search_->levelChangedBefore(vertex);
+    graph_delay_calc_->delaysRestored();
+    if (timing->delay_invalid_count_ != delay_invalid_count) {
+      // Delays were invalidated while the mode was not current, so
+      // find them incrementally. Changed delays invalidate arrivals.
+      debugPrint(debug_, "mode", 1, "mode %s delays invalid", mode_name_);
+      VertexIterator vertex_iter(graph_);
+      while (vertex_iter.hasNext())
+        graph_delay_calc_->delayInvalid(vertex_iter.next());
+    }
+    delete timing;
+  }
+  if (search_ != prev_search) {
+    search_->copyOptions(prev_search);
+    if (!search_saved)
+      delete prev_search;
+  }
+}
+
+void
+Sta::deleteModeTiming(const Sdc *sdc)
+{
+  ModeTiming *timing = mode_timings_.findKey(sdc);
+  if (timing) {
+    // The graph does not have the saved search paths.
+    timing->search_->pathsReleased();
+    delete timing->search_;
+    delete timing->graph_timing_;
+    delete timing;
+    mode_timings_.erase(sdc);
+  }
+}
+
+void
+Sta::deleteModeTimings()
+{
+  while (!mode_timings_.empty())
+    deleteModeTiming(mode_timings_.begin()->first);
+}
+
+StringSeq
+Sta::modeNames() const
+{
+  StringSeq mode_names;
+  for (auto name_sdc : mode_sdcs_)
+    mode_names.push_back(name_sdc.first);
+  return mode_names;
+}
+
+void
+Sta::deleteMode(const char *mode_name)
+{
+  auto mode_itr = mode_sdcs_.find(mode_name);
+  if (mode_itr == mode_sdcs_.end())
+    report_->error(1689, "mode %s not found.", mode_name);
+  Sdc *sdc = mode_itr->second;
+  if (sdc == sdc_)
+    report_->error(1659, "the current mode %s cannot be deleted.", mode_name);
+  const char *name = mode_itr->first;
+  mode_sdcs_.erase(mode_itr);
+  deleteModeTiming(sdc);
+  sdc->copyState(this);
+  delete sdc;
+  stringDelete(name);
+}
+
+SdcSeq
+Sta::otherModeSdcs()
+{
+  SdcSeq sdcs;
+  for (auto name_sdc : mode_sdcs_) {
+    Sdc *sdc = name_sdc.second;
+    if (sdc != sdc_) {
+      sdc->copyState(this);
+      sdcs.push_back(sdc);
+    }
+  }
+  return sdcs;
+}
+
 void
 Sta::constraintsChanged()
 {
@@ -2204,6 +2917,33 @@ Sta::setCrprMode(CrprMode mode)
   sdc_->setCrprMode(mode);
 }
 
+float
+Sta::requiredTolerance() const
+{
+  return search_->requiredTolerance();
+}
+
+void
+Sta::setRequiredTolerance(float tolerance)
+{
+  search_->setRequiredTolerance(tolerance);
+}
+
+float
+Sta::crprPruneMargin() const
+{
+  return search_->crprPruneMargin();
+}
+
+void
+Sta::setCrprPruneMargin(float margin)
+{
+  if (margin != search_->crprPruneMargin()) {
+    search_->setCrprPruneMargin(margin);
+    search_->arrivalsInvalid();
+  }
+}
+
 bool
 Sta::pocvEnabled() const
 {
@@ -2213,12 +2953,17 @@ Sta::pocvEnabled() const
 void
 Sta::setPocvEnabled(bool enabled)
 {
-  if (enabled != pocv_enabled_) {
+  bool changed = (enabled != pocv_enabled_);
+  if (changed) {
     graph_delay_calc_->delaysInvalid();
     search_->arrivalsInvalid();
   }
   pocv_enabled_ = enabled;
   updateComponentsState();
+  if (changed && graph_) {
+    graph_->pocvEnabledChanged();
+    shareGraphDelays();
+  }
 }
 
 void
@@ -2429,13 +3174,20 @@ Sta::makeCorners(StringSet *corner_names)
 {
   if (corner_names->size() > corner_count_max)
     report_->error(1553, "maximum corner count exceeded");
+  // Tags of the other modes reference the path analysis points.
+  deleteModeTimings();
   sdc_->makeCornersBefore();
+  for (Sdc *sdc : otherModeSdcs())
+    sdc->makeCornersBefore();
   parasitics_->deleteParasitics();
   corners_->makeCorners(corner_names);
   makeParasiticAnalysisPts();
   cmd_corner_ = corners_->findCorner(0);
+  power_->powerInvalid();
   updateComponentsState();
   sdc_->makeCornersAfter(corners_);
+  for (Sdc *sdc : otherModeSdcs())
+    sdc->makeCornersAfter(corners_);
 }
 
 Corner *
@@ -2476,7 +3228,7 @@ Sta::findPathEnds(ExceptionFrom *from,
 		  bool clk_gating_setup,
 		  bool clk_gating_hold)
 {
-  searchPreamble();
+  searchPreamble(from, thrus, unconstrained);
   return search_->findPathEnds(from, thrus, to, unconstrained,
 			       corner, min_max, group_count, endpoint_count,
 			       unique_pins, slack_min, slack_max,
@@ -2499,10 +3251,23 @@ Sta::findPathEnds(ExceptionFrom *from,
 void
 Sta::searchPreamble()
 {
+  searchPreamble(nullptr, nullptr, false);
+}
+
+// Keep the filtered arrivals from the last search if they are for the
+// same from/thrus.
+void
+Sta::searchPreamble(ExceptionFrom *from,
+                    ExceptionThruSeq *thrus,
+                    bool unconstrained)
+{
+  if (timingFrozen())
+    return;
+  waitTimingUpdate();
   findDelays();
   updateGeneratedClks();
   sdc_->searchPreamble();
-  search_->deleteFilteredArrivals();
+  search_->deleteFilteredArrivals(from, thrus, unconstrained);
 }
 
 void
@@ -2555,9 +3320,57 @@ Sta::setReportPathSigmas(bool report_sigmas)
 void
 Sta::reportPathEnds(PathEndSeq *ends)
 {
+  ReportBuffer buffer(report_);
   report_path_->reportPathEnds(ends);
 }
 
+void
+Sta::reportPathEndSeq(PathEndSeq *ends)
+{
+  ReportBuffer buffer(report_);
+  report_path_->reportPathEndSeq(ends);
+}
+
+void
+Sta::writePathReport(PathEndSeq *ends,
+                     const char *filename)
+{
+  sta::writePathReport(ends, filename, this);
+}
+
+EndpointSlackSeq
+Sta::endpointSlacks(const Corner *corner,
+                    const MinMaxAll *min_max)
+{
+  ensureGraph();
+  if (!timingFrozen()) {
+    searchPreamble();
+    search_->findAllArrivals();
+  }
+  EndpointSlackSeq slacks;
+  findEndpointSlacks(corner, min_max, this, slacks);
+  return slacks;
+}
+
+void
+Sta::writeEndpointSlacks(const char *filename,
+                         const Corner *corner,
+                         const MinMaxAll *min_max)
+{
+  EndpointSlackSeq slacks = endpointSlacks(corner, min_max);
+  sta::writeEndpointSlacks(slacks, filename, this);
+}
+
+void
+Sta::writeTimingContext(const Instance *inst,
+                        const char *filename,
+                        int digits)
+{
+  ensureGraph();
+  findRequireds();
+  sta::writeTimingContext(inst, filename, digits, this);
+}
+
 void
 Sta::reportPathEndHeader()
 {
@@ -2592,10 +3405,126 @@ Sta::reportPath(Path *path)
 void
 Sta::updateTiming(bool full)
 {
+  thawTiming();
   searchPreamble();
   if (full)
     search_->arrivalsInvalid();
   search_->findAllArrivals();
+  // Incremental updates leave deleted path arrays behind.
+  if (graph_->pathsFragmented())
+    search_->compactPaths();
+}
+
+// True in the updateTimingAsync thread, which calls searchPreamble.
+static thread_local bool in_timing_update_thread = false;
+
+void
+Sta::updateTimingAsync(bool full)
+{
+  cancelTimingUpdate();
+  thawTiming();
+  timing_progress_->reset();
+  timing_progress_->setRunning(true);
+  timing_update_completed_ = false;
+  timing_update_thread_ = new std::thread([this, full] () {
+    in_timing_update_thread = true;
+    searchPreamble();
+    if (!timing_progress_->cancelRequested()) {
+      if (full)
+        search_->arrivalsInvalid();
+      search_->findAllArrivals();
+      if (graph_->pathsFragmented())
+        search_->compactPaths();
+    }
+    timing_update_completed_ = !timing_progress_->cancelRequested();
+    timing_progress_->setRunning(false);
+  });
+}
+
+void
+Sta::cancelTimingUpdate()
+{
+  if (timing_update_thread_ && !in_timing_update_thread) {
+    timing_progress_->setCancelRequested(true);
+    waitTimingUpdate();
+    timing_progress_->setCancelRequested(false);
+  }
+}
+
+bool
+Sta::waitTimingUpdate()
+{
+  if (timing_update_thread_ && !in_timing_update_thread) {
+    timing_update_thread_->join();
+    delete timing_update_thread_;
+    timing_update_thread_ = nullptr;
+  }
+  return timing_update_completed_;
+}
+
+bool
+Sta::timingUpdateRunning() const
+{
+  return timing_progress_->running();
+}
+
+void
+Sta::freezeTiming()
+{
+  thawTiming();
+  ensureGraph();
+  findRequireds();
+  resurrectPrunedRequireds();
+  for (const MinMax *min_max : MinMax::range()) {
+    int mm_index = min_max->index();
+    search_->worstSlack(min_max, frozen_worst_slacks_[mm_index],
+                        frozen_worst_vertices_[mm_index]);
+    frozen_tns_[mm_index] = search_->totalNegativeSlack(min_max);
+  }
+  frozen_delay_invalid_count_ = graph_delay_calc_->invalidCount();
+  frozen_search_invalid_count_ = search_->invalidCount();
+  timing_frozen_ = true;
+}
+
+void
+Sta::thawTiming()
+{
+  timing_frozen_ = false;
+}
+
+// Edits invalidate delays or arrivals, so frozen timing that has been
+// edited since it was frozen is thawed.
+bool
+Sta::timingFrozen() const
+{
+  return timing_frozen_
+    && graph_delay_calc_->invalidCount() == frozen_delay_invalid_count_
+    && search_->invalidCount() == frozen_search_invalid_count_;
+}
+
+// Same as findRequired for every vertex, with one search for all of
+// the resurrected fanouts.
+void
+Sta::resurrectPrunedRequireds()
+{
+  if (sdc_->crprEnabled()
+      && search_->crprPathPruningEnabled()
+      && !search_->crprApproxMissingRequireds()) {
+    int fanout = 0;
+    VertexIterator vertex_iter(graph_);
+    while (vertex_iter.hasNext()) {
+      Vertex *vertex = vertex_iter.next();
+      if (vertex->requiredsPruned()
+          && !search_->isClock(vertex))
+        disableFanoutCrprPruning(vertex, fanout);
+    }
+    if (fanout > 0) {
+      debugPrint(debug_, "search", 1, "resurrect pruned requireds fanout %d",
+                 fanout);
+      search_->findArrivals();
+      search_->findRequireds();
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////
@@ -2651,11 +3580,38 @@ Sta::findClkDelays(const Clock *clk,
   return clk_latency.findClkDelays(clk, nullptr, include_internal_latency);
 }
 
+ClkLatencyStats
+Sta::clkLatencyStats(const Clock *clk,
+                     const Corner *corner,
+                     const MinMax *min_max,
+                     bool include_internal_latency,
+                     int bucket_count)
+{
+  ensureClkArrivals();
+  return search_->clkLatencyIndex()->latencyStats(clk, corner, min_max,
+                                                  include_internal_latency,
+                                                  bucket_count);
+}
+
+void
+Sta::reportClkLatencyHistogram(ConstClockSeq clks,
+                               const Corner *corner,
+                               bool include_internal_latency,
+                               int bucket_count,
+                               int digits)
+{
+  ensureClkArrivals();
+  ClkLatency clk_latency(this);
+  clk_latency.reportClkLatencyHistogram(clks, corner, include_internal_latency,
+                                        bucket_count, digits);
+}
+
 ////////////////////////////////////////////////////////////////
 
 void
 Sta::delaysInvalid()
 {
+  cancelTimingUpdate();
   graph_delay_calc_->delaysInvalid();
   search_->arrivalsInvalid();
 }
@@ -2663,6 +3619,7 @@ Sta::delaysInvalid()
 void
 Sta::arrivalsInvalid()
 {
+  cancelTimingUpdate();
   search_->arrivalsInvalid();
 }
 
@@ -2706,7 +3663,7 @@ int
 Sta::endpointViolationCount(const MinMax *min_max)
 {
   int violations = 0;
-  for (Vertex *end : *search_->endpoints()) {
+  for (Vertex *end : search_->endpointSeq()) {
     if (delayLess(vertexSlack(end, min_max), 0.0, this))
       violations++;
   }
@@ -2893,8 +3850,20 @@ Sta::vertexArrival(Vertex *vertex,
 		   const PathAnalysisPt *path_ap,
                    const MinMax *min_max)
 {
-  searchPreamble();
-  search_->findArrivals(vertex->level());
+  if (!timingFrozen()) {
+    searchPreamble();
+    search_->findArrivals(vertex->level());
+  }
+  return vertexArrival1(vertex, rf, clk_edge, path_ap, min_max);
+}
+
+Arrival
+Sta::vertexArrival1(Vertex *vertex,
+                    const RiseFall *rf,
+                    const ClockEdge *clk_edge,
+                    const PathAnalysisPt *path_ap,
+                    const MinMax *min_max)
+{
   if (min_max == nullptr)
     min_max = path_ap->pathMinMax();
   Arrival arrival = min_max->initValue();
@@ -3024,23 +3993,108 @@ Sta::pinSlack(const Pin *pin,
   return slack;
 }
 
+FloatSeq
+Sta::pinSlacks(const PinSeq &pins,
+               const RiseFall *rf,
+               const MinMax *min_max)
+{
+  ensureGraph();
+  if (!timingFrozen()) {
+    searchPreamble();
+    search_->findAllArrivals();
+    search_->findRequireds();
+    // Resurrecting pruned requireds searches again, so do it before
+    // the threads read the slacks.
+    for (const Pin *pin : pins) {
+      Vertex *vertex, *bidirect_drvr_vertex;
+      graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+      if (vertex && vertex->requiredsPruned())
+        findRequired(vertex);
+      if (bidirect_drvr_vertex && bidirect_drvr_vertex->requiredsPruned())
+        findRequired(bidirect_drvr_vertex);
+    }
+  }
+  FloatSeq slacks;
+  limitCheckSlacks(pins, [=] (const Pin *pin,
+                              int) {
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    Slack slack = MinMax::min()->initValue();
+    if (vertex)
+      slack = vertexSlack1(vertex, rf, min_max);
+    if (bidirect_drvr_vertex) {
+      Slack slack1 = vertexSlack1(bidirect_drvr_vertex, rf, min_max);
+      if (delayLess(slack1, slack, this))
+        slack = slack1;
+    }
+    return delayAsFloat(slack);
+  }, this, slacks);
+  return slacks;
+}
+
+FloatSeq
+Sta::pinArrivals(const PinSeq &pins,
+                 const RiseFall *rf,
+                 const MinMax *min_max)
+{
+  ensureGraph();
+  if (!timingFrozen()) {
+    searchPreamble();
+    search_->findAllArrivals();
+  }
+  FloatSeq arrivals;
+  limitCheckSlacks(pins, [=] (const Pin *pin,
+                              int) {
+    Vertex *vertex, *bidirect_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_vertex);
+    Arrival arrival;
+    if (vertex)
+      arrival = vertexArrival1(vertex, rf, clk_edge_wildcard, nullptr, min_max);
+    if (bidirect_vertex) {
+      Arrival arrival1 = vertexArrival1(bidirect_vertex, rf, clk_edge_wildcard,
+                                        nullptr, min_max);
+      if (delayLess(arrival1, arrival, this))
+        arrival = arrival1;
+    }
+    return delayAsFloat(arrival);
+  }, this, arrivals);
+  return arrivals;
+}
+
+FloatSeq
+Sta::pinSlews(const PinSeq &pins,
+              const RiseFall *rf,
+              const MinMax *min_max)
+{
+  ensureGraph();
+  findDelays();
+  FloatSeq slews;
+  limitCheckSlacks(pins, [=] (const Pin *pin,
+                              int) {
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    Slew slew = min_max->initValue();
+    if (vertex) {
+      Slew vertex_slew = vertexSlew1(vertex, rf, min_max);
+      if (delayGreater(vertex_slew, slew, min_max, this))
+        slew = vertex_slew;
+    }
+    if (bidirect_drvr_vertex) {
+      Slew vertex_slew = vertexSlew1(bidirect_drvr_vertex, rf, min_max);
+      if (delayGreater(vertex_slew, slew, min_max, this))
+        slew = vertex_slew;
+    }
+    return delayAsFloat(slew);
+  }, this, slews);
+  return slews;
+}
+
 Slack
 Sta::vertexSlack(Vertex *vertex,
 		 const MinMax *min_max)
 {
   findRequired(vertex);
-  MinMax *min = MinMax::min();
-  Slack slack = min->initValue();
-  VertexPathIterator path_iter(vertex, this);
-  while (path_iter.hasNext()) {
-    Path *path = path_iter.next();
-    if (path->minMax(this) == min_max) {
-      Slack path_slack = path->slack(this);
-      if (delayLess(path_slack, slack, this))
-	slack = path_slack;
-    }
-  }
-  return slack;
+  return vertexSlack1(vertex, nullptr, min_max);
 }
 
 Slack
@@ -3049,6 +4103,14 @@ Sta::vertexSlack(Vertex *vertex,
 		 const MinMax *min_max)
 {
   findRequired(vertex);
+  return vertexSlack1(vertex, rf, min_max);
+}
+
+Slack
+Sta::vertexSlack1(Vertex *vertex,
+                  const RiseFall *rf,
+                  const MinMax *min_max)
+{
   Slack slack = MinMax::min()->initValue();
   VertexPathIterator path_iter(vertex, rf, min_max, this);
   while (path_iter.hasNext()) {
@@ -3202,7 +4264,7 @@ Sta::findClkMinPeriod(const Clock *clk,
   search_->findArrivals();
   VisitPathEnds visit_ends(this);
   MinPeriodEndVisitor min_period_visitor(clk, include_port_paths, this);
-  for (Vertex *vertex : *search_->endpoints()) {
+  for (Vertex *vertex : search_->endpointSeq()) {
     findRequired(vertex);
     visit_ends.visitPathEnds(vertex, &min_period_visitor);
   }
@@ -3214,6 +4276,8 @@ Sta::findClkMinPeriod(const Clock *clk,
 void
 Sta::findRequired(Vertex *vertex)
 {
+  if (timingFrozen())
+    return;
   searchPreamble();
   search_->findAllArrivals();
   search_->findRequireds(vertex->level());
@@ -3262,6 +4326,8 @@ Sta::disableFanoutCrprPruning(Vertex *vertex,
 Slack
 Sta::totalNegativeSlack(const MinMax *min_max)
 {
+  if (timingFrozen())
+    return frozen_tns_[min_max->index()];
   searchPreamble();
   return search_->totalNegativeSlack(min_max);
 }
@@ -3274,13 +4340,29 @@ Sta::totalNegativeSlack(const Corner *corner,
   return search_->totalNegativeSlack(corner, min_max);
 }
 
+int
+Sta::negativeSlackEndpointCount(const Corner *corner,
+                                const MinMax *min_max)
+{
+  searchPreamble();
+  return search_->negativeSlackEndpointCount(corner, min_max);
+}
+
+VertexSeq
+Sta::worstNegativeSlackEndpoints(const Corner *corner,
+                                 const MinMax *min_max,
+                                 int count)
+{
+  searchPreamble();
+  return search_->worstNegativeSlackEndpoints(corner, min_max, count);
+}
+
 Slack
 Sta::worstSlack(const MinMax *min_max)
 {
-  searchPreamble();
   Slack worst_slack;
   Vertex *worst_vertex;
-  search_->worstSlack(min_max, worst_slack, worst_vertex);
+  worstSlack(min_max, worst_slack, worst_vertex);
   return worst_slack;
 }
 
@@ -3290,8 +4372,14 @@ Sta::worstSlack(const MinMax *min_max,
 		Slack &worst_slack,
 		Vertex *&worst_vertex)
 {
-  searchPreamble();
-  search_->worstSlack(min_max, worst_slack, worst_vertex);
+  if (timingFrozen()) {
+    worst_slack = frozen_worst_slacks_[min_max->index()];
+    worst_vertex = frozen_worst_vertices_[min_max->index()];
+  }
+  else {
+    searchPreamble();
+    search_->worstSlack(min_max, worst_slack, worst_vertex);
+  }
 }
 
 void
@@ -3332,27 +4420,81 @@ Sta::setArcDelayCalc(const char *delay_calc_name)
 void
 Sta::findDelays(Vertex *to_vertex)
 {
-  delayCalcPreamble();
-  graph_delay_calc_->findDelays(to_vertex->level());
+  findDelays(to_vertex->level());
 }
 
 void
 Sta::findDelays()
 {
-  delayCalcPreamble();
-  graph_delay_calc_->findDelays(levelize_->maxLevel());
+  findDelays(levelize_->maxLevel());
 }
 
 void
 Sta::findDelays(Level level)
 {
+  if (timingFrozen())
+    return;
+  waitTimingUpdate();
   delayCalcPreamble();
   graph_delay_calc_->findDelays(level);
+  if (graph_->sharedDelaysMismatched()) {
+    // Analysis points expected to have the same delays do not,
+    // so give them their own delays and find all of them again.
+    graph_->unshareMismatchedDelays();
+    graph_delay_calc_->delaysInvalid();
+    search_->arrivalsInvalid();
+    graph_delay_calc_->findDelays(level);
+  }
+}
+
+// Corners with the same libraries and parasitics find the same delays,
+// so their analysis points share the graph slew and arc delay tables.
+// Graph compares the delays of shared analysis points and findDelays
+// unshares the ones that differ.
+void
+Sta::shareGraphDelays()
+{
+  const DcalcAnalysisPtSeq &dcalc_aps = corners_->dcalcAnalysisPts();
+  std::vector<DcalcAPIndex> table_aps(dcalc_aps.size());
+  for (const DcalcAnalysisPt *dcalc_ap : dcalc_aps) {
+    DcalcAPIndex ap_index = dcalc_ap->index();
+    table_aps[ap_index] = ap_index;
+    for (const DcalcAnalysisPt *dcalc_ap1 : dcalc_aps) {
+      if (dcalc_ap1->index() >= ap_index)
+        break;
+      if (delaysEquivalent(dcalc_ap, dcalc_ap1)) {
+        table_aps[ap_index] = dcalc_ap1->index();
+        break;
+      }
+    }
+  }
+  graph_->shareDelays(table_aps);
+}
+
+bool
+Sta::delaysEquivalent(const DcalcAnalysisPt *dcalc_ap1,
+                      const DcalcAnalysisPt *dcalc_ap2) const
+{
+  const Corner *corner1 = dcalc_ap1->corner();
+  const Corner *corner2 = dcalc_ap2->corner();
+  const MinMax *min_max = dcalc_ap1->delayMinMax();
+  if (min_max != dcalc_ap2->delayMinMax()
+      || dcalc_ap1->checkClkSlewMinMax() != dcalc_ap2->checkClkSlewMinMax()
+      || dcalc_ap1->operatingConditions() != dcalc_ap2->operatingConditions()
+      || dcalc_ap1->parasiticAnalysisPt() != dcalc_ap2->parasiticAnalysisPt())
+    return false;
+  // Timing checks use the clock slews of the other min/max.
+  for (const MinMax *min_max1 : MinMax::range()) {
+    if (corner1->libertyLibraries(min_max1) != corner2->libertyLibraries(min_max1))
+      return false;
+  }
+  return true;
 }
 
 void
 Sta::delayCalcPreamble()
 {
+  sdcBatchInvalidate();
   ensureClkNetwork();
 }
 
@@ -3385,6 +4527,7 @@ Sta::setArcDelayAnnotated(Edge *edge,
 			  DcalcAnalysisPt *dcalc_ap,
 			  bool annotated)
 {
+  graph_->unshareDelays();
   graph_->setArcDelayAnnotated(edge, arc, dcalc_ap->index(), annotated);
   Vertex *to = edge->to(graph_);
   search_->arrivalInvalid(to);
@@ -3419,13 +4562,7 @@ Sta::vertexSlew(Vertex *vertex,
 		const MinMax *min_max)
 {
   findDelays(vertex);
-  Slew mm_slew = min_max->initValue();
-  for (const DcalcAnalysisPt *dcalc_ap : corners_->dcalcAnalysisPts()) {
-    Slew slew = graph_->slew(vertex, rf, dcalc_ap->index());
-    if (delayGreater(slew, mm_slew, min_max, this))
-      mm_slew = slew;
-  }
-  return mm_slew;
+  return vertexSlew1(vertex, rf, min_max);
 }
 
 Slew
@@ -3433,12 +4570,22 @@ Sta::vertexSlew(Vertex *vertex,
                 const MinMax *min_max)
 {
   findDelays(vertex);
+  return vertexSlew1(vertex, nullptr, min_max);
+}
+
+Slew
+Sta::vertexSlew1(Vertex *vertex,
+                 const RiseFall *rf,
+                 const MinMax *min_max)
+{
   Slew mm_slew = min_max->initValue();
   for (const DcalcAnalysisPt *dcalc_ap : corners_->dcalcAnalysisPts()) {
-    for (const RiseFall *rf : RiseFall::range()) {
-      Slew slew = graph_->slew(vertex, rf, dcalc_ap->index());
-      if (delayGreater(slew, mm_slew, min_max, this))
-        mm_slew = slew;
+    for (const RiseFall *rf1 : RiseFall::range()) {
+      if (rf == nullptr || rf1 == rf) {
+        Slew slew = graph_->slew(vertex, rf1, dcalc_ap->index());
+        if (delayGreater(slew, mm_slew, min_max, this))
+          mm_slew = slew;
+      }
     }
   }
   return mm_slew;
@@ -3454,6 +4601,10 @@ Sta::ensureGraph()
     // Update pointers to graph.
     updateComponentsState();
   }
+  if (graph_adjacency_snapshot_
+      && graph_
+      && !graph_->adjacencySnapshotValid())
+    graph_->makeAdjacencySnapshot();
   return graph_;
 }
 
@@ -3462,12 +4613,21 @@ Sta::makeGraph()
 {
   graph_ = new Graph(this, 2, true, corners_->dcalcAnalysisPtCount());
   graph_->makeGraph();
+  if (graph_level_order_) {
+    // Remake the graph with the instances in level order.
+    InstanceSeq insts = graph_->levelOrderInstances();
+    delete graph_;
+    graph_ = new Graph(this, 2, true, corners_->dcalcAnalysisPtCount());
+    graph_->makeGraph(insts);
+  }
+  shareGraphDelays();
 }
 
 void
 Sta::ensureLevelized()
 {
   ensureGraph();
+  netlistEditFlush();
   ensureGraphSdcAnnotated();
   // Need constant propagation before levelization to know edges that
   // are disabled by constants.
@@ -3594,6 +4754,27 @@ Sta::clkInfoCount() const
   return search_->clkInfoCount();
 }
 
+void
+Sta::reportMemory() const
+{
+  MemoryStats stats;
+  network_->memoryStats(stats);
+  LibertyLibraryIterator *lib_iter = network_->libertyLibraryIterator();
+  while (lib_iter->hasNext()) {
+    LibertyLibrary *lib = lib_iter->next();
+    lib->memoryStats(stats);
+  }
+  delete lib_iter;
+  parasitics_->memoryStats(stats);
+  if (graph_)
+    graph_->memoryStats(stats);
+  search_->memoryStats(stats);
+  sdc_->memoryStats(stats);
+  objectPoolMemoryStats(stats);
+  tableBlockMemoryStats(stats);
+  stats.report(memoryUsage(), report_);
+}
+
 void
 Sta::setArcDelay(Edge *edge,
 		 TimingArc *arc,
@@ -3601,6 +4782,8 @@ Sta::setArcDelay(Edge *edge,
 		 const MinMaxAll *min_max,
 		 ArcDelay delay)
 {
+  // Annotations are per analysis point.
+  graph_->unshareDelays();
   for (MinMax *mm : min_max->range()) {
     const DcalcAnalysisPt *dcalc_ap = corner->findDcalcAnalysisPt(mm);
     DcalcAPIndex ap_index = dcalc_ap->index();
@@ -3608,6 +4791,19 @@ Sta::setArcDelay(Edge *edge,
     // Don't let delay calculation clobber the value.
     graph_->setArcDelayAnnotated(edge, arc, ap_index, true);
   }
+  delayAnnotated(edge);
+}
+
+void
+Sta::delaysAnnotated(const EdgeSet &edges)
+{
+  for (Edge *edge : edges)
+    delayAnnotated(edge);
+}
+
+void
+Sta::delayAnnotated(Edge *edge)
+{
   if (edge->role()->isTimingCheck())
     search_->requiredInvalid(edge->to(graph_));
   else {
@@ -3623,6 +4819,7 @@ Sta::setAnnotatedSlew(Vertex *vertex,
 		      const RiseFallBoth *rf,
 		      float slew)
 {
+  graph_->unshareDelays();
   for (MinMax *mm : min_max->range()) {
     const DcalcAnalysisPt *dcalc_ap = corner->findDcalcAnalysisPt(mm);
     DcalcAPIndex ap_index = dcalc_ap->index();
@@ -3906,7 +5103,9 @@ Sta::readSpef(const char *filename,
 	      bool pin_cap_included,
 	      bool keep_coupling_caps,
 	      float coupling_cap_factor,
-	      bool reduce)
+	      bool reduce,
+              const NetSet *keep_detailed_nets,
+              bool incremental)
 {
   setParasiticAnalysisPts(corner != nullptr);
   const MinMax *ap_min_max = (min_max == MinMaxAll::all())
@@ -3914,15 +5113,128 @@ Sta::readSpef(const char *filename,
     : min_max->asMinMax();
   const Corner *ap_corner = corner ? corner : corners_->corners()[0];
   ParasiticAnalysisPt *ap = ap_corner->findParasiticAnalysisPt(ap_min_max);
+  NetSet read_nets(network_);
   bool success = readSpefFile(filename, instance, ap,
 			      pin_cap_included, keep_coupling_caps,
-                              coupling_cap_factor, reduce,
-			      corner, min_max, this);
+                              coupling_cap_factor, reduce, keep_detailed_nets,
+			      corner, min_max, spef_read_parallel_,
+                              incremental ? &read_nets : nullptr, this);
+  if (incremental && graph_) {
+    // Only the drivers of the nets in the file see new parasitics.
+    for (const Net *net : read_nets)
+      delaysInvalidFromFanin(net);
+  }
+  else {
+    graph_delay_calc_->delaysInvalid();
+    search_->arrivalsInvalid();
+  }
+  return success;
+}
+
+void
+Sta::writeParasiticsCache(const char *filename)
+{
+  sta::writeParasiticsCache(filename, this);
+}
+
+bool
+Sta::readParasiticsCache(const char *filename)
+{
+  bool success = sta::readParasiticsCache(filename, this);
   graph_delay_calc_->delaysInvalid();
   search_->arrivalsInvalid();
   return success;
 }
 
+// Drivers reduced by a thread at a time.
+static const size_t reduce_parasitics_chunk_size = 64;
+
+void
+Sta::reduceParasitics(const Corner *corner,
+                      const MinMaxAll *min_max)
+{
+  ensureGraph();
+  DcalcAnalysisPtSeq dcalc_aps;
+  for (const Corner *corner1 : *corners_) {
+    if (corner == nullptr || corner1 == corner) {
+      for (const MinMax *min_max1 : min_max->range())
+        dcalc_aps.push_back(corner1->findDcalcAnalysisPt(min_max1));
+    }
+  }
+  // Driver pins with a parasitic network for dcalc_ap.
+  std::vector<std::pair<const Pin*, DcalcAnalysisPt*>> drvr_aps;
+  VertexIterator vertex_iter(graph_);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    const Pin *pin = vertex->pin();
+    if (vertex->isDriver(network_)
+        && !vertex->isBidirectDriver()
+        && !network_->direction(pin)->isInternal()) {
+      for (DcalcAnalysisPt *dcalc_ap : dcalc_aps) {
+        if (parasitics_->findParasiticNetwork(pin,
+                                              dcalc_ap->parasiticAnalysisPt()))
+          drvr_aps.push_back({pin, dcalc_ap});
+      }
+    }
+  }
+
+  auto reduce_drvr = [this] (const std::pair<const Pin*, DcalcAnalysisPt*> &drvr_ap,
+                             ArcDelayCalc *arc_delay_calc) {
+    const Pin *drvr_pin = drvr_ap.first;
+    DcalcAnalysisPt *dcalc_ap = drvr_ap.second;
+    Parasitic *parasitic_network =
+      parasitics_->findParasiticNetwork(drvr_pin,
+                                        dcalc_ap->parasiticAnalysisPt());
+    for (const RiseFall *rf : RiseFall::range())
+      arc_delay_calc->reduceParasitic(parasitic_network, drvr_pin, rf, dcalc_ap);
+  };
+  size_t count = drvr_aps.size();
+  if (dispatch_queue_ == nullptr
+      || thread_count_ <= 1
+      || count < reduce_parasitics_chunk_size * 2) {
+    for (auto &drvr_ap : drvr_aps)
+      reduce_drvr(drvr_ap, arc_delay_calc_);
+  }
+  else {
+    // Delay calculators keep state per call so each thread uses a copy.
+    std::vector<ArcDelayCalc*> arc_delay_calcs;
+    for (int i = 0; i < thread_count_; i++)
+      arc_delay_calcs.push_back(arc_delay_calc_->copy());
+    size_t chunk_size = max(reduce_parasitics_chunk_size,
+                                 count / (thread_count_ * 4) + 1);
+    for (size_t from = 0; from < count; from += chunk_size) {
+      size_t to = min(from + chunk_size, count);
+      dispatch_queue_->dispatch([=, &drvr_aps, &arc_delay_calcs] (int thread) {
+        for (size_t i = from; i < to; i++)
+          reduce_drvr(drvr_aps[i], arc_delay_calcs[thread]);
+      });
+    }
+    dispatch_queue_->finishTasks();
+    for (ArcDelayCalc *arc_delay_calc : arc_delay_calcs)
+      delete arc_delay_calc;
+  }
+}
+
+void
+Sta::writeTimingSnapshot(const char *filename)
+{
+  findDelays();
+  sta::writeTimingSnapshot(filename, this);
+}
+
+bool
+Sta::readTimingSnapshot(const char *filename)
+{
+  ensureGraph();
+  bool success = sta::readTimingSnapshot(filename, this);
+  if (success)
+    graph_delay_calc_->delaysRestored();
+  else
+    graph_delay_calc_->delaysInvalid();
+  search_->arrivalsInvalid();
+  return success;
+}
+
 void
 Sta::setParasiticAnalysisPts(bool per_corner)
 {
@@ -4035,6 +5347,55 @@ Sta::makeParasiticNetwork(const Net *net,
   return parasitic;
 }
 
+void
+Sta::setParasiticEstimator(ParasiticEstimator *estimator)
+{
+  parasitics_->setEstimator(estimator);
+  if (graph_) {
+    // Estimates (including wireload estimates) are pi elmore models
+    // of drivers without parasitic networks.
+    VertexIterator vertex_iter(graph_);
+    while (vertex_iter.hasNext()) {
+      Vertex *vertex = vertex_iter.next();
+      const Pin *pin = vertex->pin();
+      if (vertex->isDriver(network_)
+          && !vertex->isBidirectDriver()) {
+        bool has_network = false;
+        for (const ParasiticAnalysisPt *ap : corners_->parasiticAnalysisPts()) {
+          if (parasitics_->findParasiticNetwork(pin, ap)) {
+            has_network = true;
+            break;
+          }
+        }
+        if (!has_network)
+          parasitics_->deleteDrvrReducedParasitics(pin);
+      }
+    }
+  }
+  graph_delay_calc_->delaysInvalid();
+  search_->arrivalsInvalid();
+}
+
+void
+Sta::setWireRcEstimate(float res_per_distance,
+                       float cap_per_distance)
+{
+  setParasiticEstimator(new WireRcEstimator(res_per_distance,
+                                            cap_per_distance, this));
+}
+
+void
+Sta::parasiticEstimatesInvalid(const Net *net)
+{
+  PinSet *drvrs = network_->drivers(net);
+  if (drvrs) {
+    for (const Pin *drvr : *drvrs) {
+      parasitics_->deleteDrvrReducedParasitics(drvr);
+      delaysInvalidFrom(drvr);
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////
 //
 // Network edit commands.
@@ -4053,6 +5414,20 @@ Sta::networkCmdEdit()
   return dynamic_cast<NetworkEdit*>(cmd_network_);
 }
 
+// Net connected to pin, including the net of top level port terminals.
+static Net *
+editPinNet(const Pin *pin,
+           const Network *network)
+{
+  Net *net = network->net(pin);
+  if (net == nullptr) {
+    Term *term = network->term(pin);
+    if (term)
+      net = network->net(term);
+  }
+  return net;
+}
+
 Instance *
 Sta::makeInstance(const char *name,
 		  LibertyCell *cell,
@@ -4062,12 +5437,17 @@ Sta::makeInstance(const char *name,
   Instance *inst = network->makeInstance(cell, name, parent);
   network->makePins(inst);
   makeInstanceAfter(inst);
+  if (what_if_edits_)
+    what_if_edits_->push_back({WhatIfEdit::Kind::make_instance,
+                               inst, nullptr, nullptr, nullptr});
   return inst;
 }
 
 void
 Sta::deleteInstance(Instance *inst)
 {
+  if (what_if_edits_)
+    report_->error(1614, "delete_instance is not supported in a what-if session.");
   NetworkEdit *network = networkCmdEdit();
   deleteInstanceBefore(inst);
   network->deleteInstance(inst);
@@ -4095,6 +5475,9 @@ Sta::replaceCell(Instance *inst,
 		 LibertyCell *to_lib_cell)
 {
   NetworkEdit *network = networkCmdEdit();
+  if (what_if_edits_)
+    what_if_edits_->push_back({WhatIfEdit::Kind::replace_cell,
+                               inst, nullptr, nullptr, network->cell(inst)});
   LibertyCell *from_lib_cell = network->libertyCell(inst);
   if (sta::equivCells(from_lib_cell, to_lib_cell)) {
     replaceEquivCellBefore(inst, to_lib_cell);
@@ -4115,12 +5498,17 @@ Sta::makeNet(const char *name,
   NetworkEdit *network = networkCmdEdit();
   Net *net = network->makeNet(name, parent);
   // Sta notification unnecessary.
+  if (what_if_edits_)
+    what_if_edits_->push_back({WhatIfEdit::Kind::make_net,
+                               nullptr, nullptr, net, nullptr});
   return net;
 }
 
 void
 Sta::deleteNet(Net *net)
 {
+  if (what_if_edits_)
+    report_->error(1615, "delete_net is not supported in a what-if session.");
   NetworkEdit *network = networkCmdEdit();
   deleteNetBefore(net);
   network->deleteNet(net);
@@ -4132,8 +5520,13 @@ Sta::connectPin(Instance *inst,
 		Net *net)
 {
   NetworkEdit *network = networkCmdEdit();
+  const Pin *prev_pin = network->findPin(inst, port);
+  Net *prev_net = prev_pin ? editPinNet(prev_pin, network) : nullptr;
   Pin *pin = network->connect(inst, port, net);
   connectPinAfter(pin);
+  if (what_if_edits_)
+    what_if_edits_->push_back({WhatIfEdit::Kind::connect_pin,
+                               inst, port, prev_net, nullptr});
 }
 
 void
@@ -4142,14 +5535,23 @@ Sta::connectPin(Instance *inst,
 		Net *net)
 {
   NetworkEdit *network = networkCmdEdit();
+  const Pin *prev_pin = network->findPin(inst, port);
+  Net *prev_net = prev_pin ? editPinNet(prev_pin, network) : nullptr;
   Pin *pin = network->connect(inst, port, net);
   connectPinAfter(pin);
+  if (what_if_edits_)
+    what_if_edits_->push_back({WhatIfEdit::Kind::connect_pin,
+                               inst, network->port(pin), prev_net, nullptr});
 }
 
 void
 Sta::disconnectPin(Pin *pin)
 {
   NetworkEdit *network = networkCmdEdit();
+  if (what_if_edits_)
+    what_if_edits_->push_back({WhatIfEdit::Kind::disconnect_pin,
+                               network->instance(pin), network->port(pin),
+                               editPinNet(pin, network), nullptr});
   disconnectPinBefore(pin);
   network->disconnectPin(pin);
 }
@@ -4158,6 +5560,8 @@ void
 Sta::makePortPin(const char *port_name,
                  const char *direction)
 {
+  if (what_if_edits_)
+    report_->error(1616, "make_port is not supported in a what-if session.");
   NetworkReader *network = dynamic_cast<NetworkReader*>(network_);
   Instance *top_inst = network->topInstance();
   Cell *top_cell = network->cell(top_inst);
@@ -4169,6 +5573,109 @@ Sta::makePortPin(const char *port_name,
   makePortPinAfter(pin);
 }
 
+void
+Sta::whatIfBegin()
+{
+  if (what_if_edits_)
+    report_->error(1613, "a what-if session is already active.");
+  what_if_edits_ = new WhatIfEdits;
+}
+
+void
+Sta::whatIfCommit()
+{
+  if (what_if_edits_ == nullptr)
+    report_->warn(1617, "no what-if session is active.");
+  delete what_if_edits_;
+  what_if_edits_ = nullptr;
+}
+
+void
+Sta::whatIfDiscard()
+{
+  if (what_if_edits_ == nullptr)
+    report_->warn(1618, "no what-if session is active.");
+  else {
+    WhatIfEdits *edits = what_if_edits_;
+    // Undo edits are not logged.
+    what_if_edits_ = nullptr;
+    NetworkEdit *network = networkCmdEdit();
+    for (auto edit_itr = edits->rbegin();
+         edit_itr != edits->rend();
+         edit_itr++) {
+      WhatIfEdit &edit = *edit_itr;
+      switch (edit.kind_) {
+      case WhatIfEdit::Kind::make_instance:
+        deleteInstance(edit.inst_);
+        break;
+      case WhatIfEdit::Kind::make_net:
+        deleteNet(edit.net_);
+        break;
+      case WhatIfEdit::Kind::replace_cell:
+        replaceCell(edit.inst_, edit.cell_);
+        break;
+      case WhatIfEdit::Kind::connect_pin: {
+        Pin *pin = network->findPin(edit.inst_, edit.port_);
+        if (pin)
+          disconnectPin(pin);
+        if (edit.net_)
+          connectPin(edit.inst_, edit.port_, edit.net_);
+        break;
+      }
+      case WhatIfEdit::Kind::disconnect_pin:
+        if (edit.net_)
+          connectPin(edit.inst_, edit.port_, edit.net_);
+        break;
+      }
+    }
+    delete edits;
+  }
+}
+
+void
+Sta::netlistEditBegin()
+{
+  netlist_edit_depth_++;
+}
+
+void
+Sta::netlistEditEnd()
+{
+  if (netlist_edit_depth_ > 0) {
+    netlist_edit_depth_--;
+    if (netlist_edit_depth_ == 0)
+      netlistEditFlush();
+  }
+}
+
+// Invalidate from the vertices connected inside the transaction.
+void
+Sta::netlistEditFlush()
+{
+  if (!netlist_edit_drvrs_->empty()
+      || !netlist_edit_loads_->empty()) {
+    std::vector<Vertex*> drvrs(netlist_edit_drvrs_->begin(),
+                               netlist_edit_drvrs_->end());
+    std::vector<Vertex*> loads(netlist_edit_loads_->begin(),
+                               netlist_edit_loads_->end());
+    netlist_edit_drvrs_->clear();
+    netlist_edit_loads_->clear();
+    for (Vertex *vertex : drvrs)
+      connectDrvrPinAfter1(vertex);
+    for (Vertex *vertex : loads)
+      connectLoadPinAfter1(vertex);
+  }
+}
+
+void
+Sta::netlistEditDeleteVertexBefore(Vertex *vertex)
+{
+  netlist_edit_drvrs_->erase(vertex);
+  netlist_edit_loads_->erase(vertex);
+  sdc_batch_from_->erase(vertex);
+  sdc_batch_fanin_->erase(vertex);
+}
+
 ////////////////////////////////////////////////////////////////
 //
 // Network edit before/after methods.
@@ -4178,6 +5685,10 @@ Sta::makePortPin(const char *port_name,
 void
 Sta::makeInstanceAfter(const Instance *inst)
 {
+  cancelTimingUpdate();
+  regClkPinsInvalid();
+  search_->deratesInvalid();
+  limitInstPinsChanged(inst);
   if (graph_) {
     LibertyCell *lib_cell = network_->libertyCell(inst);
     if (lib_cell) {
@@ -4200,6 +5711,8 @@ Sta::makeInstanceAfter(const Instance *inst)
 void
 Sta::makePortPinAfter(Pin *pin)
 {
+  cancelTimingUpdate();
+  limitPinChanged(pin);
   if (graph_) {
     Vertex *vertex, *bidir_drvr_vertex;
     graph_->makePinVertices(pin, vertex, bidir_drvr_vertex);
@@ -4210,6 +5723,7 @@ void
 Sta::replaceEquivCellBefore(const Instance *inst,
 			    const LibertyCell *to_cell)
 {
+  cancelTimingUpdate();
   if (graph_) {
     InstancePinIterator *pin_iter = network_->pinIterator(inst);
     while (pin_iter->hasNext()) {
@@ -4250,6 +5764,9 @@ Sta::replaceEquivCellBefore(const Instance *inst,
 void
 Sta::replaceEquivCellAfter(const Instance *inst)
 {
+  regClkPinsInvalid();
+  search_->deratesInvalid();
+  limitInstPinsChanged(inst);
   if (graph_) {
     InstancePinIterator *pin_iter = network_->pinIterator(inst);
     while (pin_iter->hasNext()) {
@@ -4308,6 +5825,7 @@ void
 Sta::replaceCellBefore(const Instance *inst,
 		       const LibertyCell *to_cell)
 {
+  cancelTimingUpdate();
   if (graph_) {
     // Delete all graph edges between instance pins.
     InstancePinIterator *pin_iter = network_->pinIterator(inst);
@@ -4334,6 +5852,9 @@ Sta::replaceCellBefore(const Instance *inst,
 void
 Sta::replaceCellAfter(const Instance *inst)
 {
+  regClkPinsInvalid();
+  search_->deratesInvalid();
+  limitInstPinsChanged(inst);
   if (graph_) {
     graph_->makeInstanceEdges(inst);
     InstancePinIterator *pin_iter = network_->pinIterator(inst);
@@ -4344,12 +5865,14 @@ Sta::replaceCellAfter(const Instance *inst)
 	parasitics_->loadPinCapacitanceChanged(pin);
     }
     delete pin_iter;
+    power_->replaceCellAfter(inst);
   }
 }
 
 void
 Sta::connectPinAfter(const Pin *pin)
 {
+  cancelTimingUpdate();
   if (graph_) {
     if (network_->isHierarchical(pin)) {
       graph_->makeWireEdgesThruPin(pin);
@@ -4388,12 +5911,26 @@ Sta::connectPinAfter(const Pin *pin)
     }
   }
   sdc_->connectPinAfter(pin);
+  for (Sdc *sdc : otherModeSdcs())
+    sdc->connectPinAfter(pin);
   sim_->connectPinAfter(pin);
+  power_->connectPinAfter(pin);
 }
 
 void
 Sta::connectDrvrPinAfter(Vertex *vertex)
 {
+  if (netlist_edit_depth_ > 0)
+    netlist_edit_drvrs_->insert(vertex);
+  else
+    connectDrvrPinAfter1(vertex);
+}
+
+void
+Sta::connectDrvrPinAfter1(Vertex *vertex)
+{
+  regClkPinsInvalid();
+  search_->deratesInvalid();
   // Invalidate arrival at fanout vertices.
   VertexOutEdgeIterator edge_iter(vertex, graph_);
   while (edge_iter.hasNext()) {
@@ -4404,6 +5941,7 @@ Sta::connectDrvrPinAfter(Vertex *vertex)
     sdc_->clkHpinDisablesChanged(to_vertex->pin());
   }
   Pin *pin = vertex->pin();
+  limitPinChanged(pin);
   sdc_->clkHpinDisablesChanged(pin);
   graph_delay_calc_->delayInvalid(vertex);
   search_->requiredInvalid(vertex);
@@ -4415,6 +5953,17 @@ Sta::connectDrvrPinAfter(Vertex *vertex)
 void
 Sta::connectLoadPinAfter(Vertex *vertex)
 {
+  if (netlist_edit_depth_ > 0)
+    netlist_edit_loads_->insert(vertex);
+  else
+    connectLoadPinAfter1(vertex);
+}
+
+void
+Sta::connectLoadPinAfter1(Vertex *vertex)
+{
+  regClkPinsInvalid();
+  search_->deratesInvalid();
   // Invalidate delays and required at fanin vertices.
   VertexInEdgeIterator edge_iter(vertex, graph_);
   while (edge_iter.hasNext()) {
@@ -4423,8 +5972,10 @@ Sta::connectLoadPinAfter(Vertex *vertex)
     graph_delay_calc_->delayInvalid(from_vertex);
     search_->requiredInvalid(from_vertex);
     sdc_->clkHpinDisablesChanged(from_vertex->pin());
+    limitPinChanged(from_vertex->pin());
   }
   Pin *pin = vertex->pin();
+  limitPinChanged(pin);
   sdc_->clkHpinDisablesChanged(pin);
   graph_delay_calc_->delayInvalid(vertex);
   levelize_->invalidFrom(vertex);
@@ -4436,9 +5987,15 @@ Sta::connectLoadPinAfter(Vertex *vertex)
 void
 Sta::disconnectPinBefore(const Pin *pin)
 {
+  cancelTimingUpdate();
+  regClkPinsInvalid();
+  search_->deratesInvalid();
   parasitics_->disconnectPinBefore(pin, network_);
   sdc_->disconnectPinBefore(pin);
+  for (Sdc *sdc : otherModeSdcs())
+    sdc->disconnectPinBefore(pin);
   sim_->disconnectPinBefore(pin);
+  power_->disconnectPinBefore(pin);
   if (graph_) {
     if (network_->isDriver(pin)) {
       Vertex *vertex = graph_->pinDrvrVertex(pin);
@@ -4487,6 +6044,8 @@ Sta::deleteEdge(Edge *edge)
   Vertex *to = edge->to(graph_);
   search_->arrivalInvalid(to);
   search_->requiredInvalid(from);
+  limitPinChanged(from->pin());
+  limitPinChanged(to->pin());
   graph_delay_calc_->delayInvalid(to);
   levelize_->relevelizeFrom(to);
   levelize_->deleteEdgeBefore(edge);
@@ -4497,6 +6056,7 @@ Sta::deleteEdge(Edge *edge)
 void
 Sta::deleteNetBefore(const Net *net)
 {
+  cancelTimingUpdate();
   if (graph_) {
     NetConnectedPinIterator *pin_iter = network_->connectedPinIterator(net);
     while (pin_iter->hasNext()) {
@@ -4518,11 +6078,16 @@ Sta::deleteNetBefore(const Net *net)
     delete pin_iter;
   }
   sdc_->deleteNetBefore(net);
+  for (Sdc *sdc : otherModeSdcs())
+    sdc->deleteNetBefore(net);
 }
 
 void
 Sta::deleteInstanceBefore(const Instance *inst)
 {
+  cancelTimingUpdate();
+  regClkPinsInvalid();
+  search_->deratesInvalid();
   if (network_->isLeaf(inst)) {
     deleteInstancePinsBefore(inst);
     deleteLeafInstanceBefore(inst);
@@ -4542,6 +6107,7 @@ void
 Sta::deleteLeafInstanceBefore(const Instance *inst)
 {
   sim_->deleteInstanceBefore(inst);
+  power_->deleteInstanceBefore(inst);
 }
 
 void
@@ -4558,6 +6124,10 @@ Sta::deleteInstancePinsBefore(const Instance *inst)
 void
 Sta::deletePinBefore(const Pin *pin)
 {
+  cancelTimingUpdate();
+  regClkPinsInvalid();
+  search_->deratesInvalid();
+  power_->deletePinBefore(pin);
   if (graph_) {
     if (network_->isLoad(pin)) {
       Vertex *vertex = graph_->pinLoadVertex(pin);
@@ -4565,6 +6135,7 @@ Sta::deletePinBefore(const Pin *pin)
         levelize_->deleteVertexBefore(vertex);
         graph_delay_calc_->deleteVertexBefore(vertex);
         search_->deleteVertexBefore(vertex);
+        netlistEditDeleteVertexBefore(vertex);
 
         VertexInEdgeIterator in_edge_iter(vertex, graph_);
         while (in_edge_iter.hasNext()) {
@@ -4573,6 +6144,7 @@ Sta::deletePinBefore(const Pin *pin)
             Vertex *from = edge->from(graph_);
             // Only notify from vertex (to vertex will be deleted).
             search_->requiredInvalid(from);
+            limitPinChanged(from->pin());
           }
           levelize_->deleteEdgeBefore(edge);
         }
@@ -4585,6 +6157,7 @@ Sta::deletePinBefore(const Pin *pin)
         levelize_->deleteVertexBefore(vertex);
         graph_delay_calc_->deleteVertexBefore(vertex);
         search_->deleteVertexBefore(vertex);
+        netlistEditDeleteVertexBefore(vertex);
 
         VertexOutEdgeIterator edge_iter(vertex, graph_);
         while (edge_iter.hasNext()) {
@@ -4609,12 +6182,66 @@ Sta::deletePinBefore(const Pin *pin)
         levelize_->deleteVertexBefore(vertex);
         graph_delay_calc_->deleteVertexBefore(vertex);
         search_->deleteVertexBefore(vertex);
+        netlistEditDeleteVertexBefore(vertex);
         graph_->deleteVertex(vertex);
       }
     }
   }
   sim_->deletePinBefore(pin);
   clk_network_->deletePinBefore(pin);
+  limitPinDeleted(pin);
+}
+
+void
+Sta::limitPinChanged(const Pin *pin)
+{
+  if (check_slew_limits_)
+    check_slew_limits_->pinChanged(pin);
+  if (check_capacitance_limits_)
+    check_capacitance_limits_->pinChanged(pin);
+  if (check_fanout_limits_)
+    check_fanout_limits_->pinChanged(pin);
+}
+
+void
+Sta::limitInstPinsChanged(const Instance *inst)
+{
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    Pin *pin = pin_iter->next();
+    limitPinChanged(pin);
+    // Input pin caps and fanout loads are in the driver limits.
+    if (network_->direction(pin)->isAnyInput()) {
+      PinSet *drvrs = network_->drivers(pin);
+      if (drvrs) {
+        for (const Pin *drvr : *drvrs)
+          limitPinChanged(drvr);
+      }
+    }
+  }
+  delete pin_iter;
+}
+
+void
+Sta::limitPinDeleted(const Pin *pin)
+{
+  if (check_slew_limits_)
+    check_slew_limits_->deletePinBefore(pin);
+  if (check_capacitance_limits_)
+    check_capacitance_limits_->deletePinBefore(pin);
+  if (check_fanout_limits_)
+    check_fanout_limits_->deletePinBefore(pin);
+}
+
+void
+Sta::limitViolatorsClear()
+{
+  if (check_slew_limits_)
+    check_slew_limits_->clear();
+  if (check_capacitance_limits_)
+    check_capacitance_limits_->clear();
+  if (check_fanout_limits_)
+    check_fanout_limits_->clear();
 }
 
 void
@@ -4655,9 +6282,11 @@ Sta::delaysInvalidFrom(const Pin *pin)
 void
 Sta::delaysInvalidFrom(Vertex *vertex)
 {
-  search_->arrivalInvalid(vertex);
-  search_->requiredInvalid(vertex);
-  graph_delay_calc_->delayInvalid(vertex);
+  if (!sdcBatchDefer(vertex, sdc_batch_from_)) {
+    search_->arrivalInvalid(vertex);
+    search_->requiredInvalid(vertex);
+    graph_delay_calc_->delayInvalid(vertex);
+  }
 }
 
 void
@@ -4710,12 +6339,14 @@ Sta::delaysInvalidFromFanin(const Net *net)
 void
 Sta::delaysInvalidFromFanin(Vertex *vertex)
 {
-  VertexInEdgeIterator edge_iter(vertex, graph_);
-  while (edge_iter.hasNext()) {
-    Edge *edge = edge_iter.next();
-    Vertex *from_vertex = edge->from(graph_);
-    delaysInvalidFrom(from_vertex);
-    search_->requiredInvalid(from_vertex);
+  if (!sdcBatchDefer(vertex, sdc_batch_fanin_)) {
+    VertexInEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *from_vertex = edge->from(graph_);
+      delaysInvalidFrom(from_vertex);
+      search_->requiredInvalid(from_vertex);
+    }
   }
 }
 
@@ -4745,7 +6376,8 @@ Sta::findRegisterInstances(ClockSet *clks,
 			   bool latches)
 {
   findRegisterPreamble();
-  return findRegInstances(clks, clk_rf, edge_triggered, latches, this);
+  return findRegInstances(clks, clk_rf, edge_triggered, latches,
+                          reg_clk_pins_, this);
 }
 
 PinSet
@@ -4755,7 +6387,8 @@ Sta::findRegisterDataPins(ClockSet *clks,
 			  bool latches)
 {
   findRegisterPreamble();
-  return findRegDataPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegDataPins(clks, clk_rf, edge_triggered, latches,
+                         reg_clk_pins_, this);
 }
 
 PinSet
@@ -4765,7 +6398,8 @@ Sta::findRegisterClkPins(ClockSet *clks,
 			 bool latches)
 {
   findRegisterPreamble();
-  return findRegClkPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegClkPins(clks, clk_rf, edge_triggered, latches,
+                        reg_clk_pins_, this);
 }
 
 PinSet
@@ -4775,7 +6409,8 @@ Sta::findRegisterAsyncPins(ClockSet *clks,
 			   bool latches)
 {
   findRegisterPreamble();
-  return findRegAsyncPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegAsyncPins(clks, clk_rf, edge_triggered, latches,
+                          reg_clk_pins_, this);
 }
 
 PinSet
@@ -4785,7 +6420,8 @@ Sta::findRegisterOutputPins(ClockSet *clks,
 			    bool latches)
 {
   findRegisterPreamble();
-  return findRegOutputPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegOutputPins(clks, clk_rf, edge_triggered, latches,
+                           reg_clk_pins_, this);
 }
 
 void
@@ -4794,6 +6430,17 @@ Sta::findRegisterPreamble()
   ensureGraph();
   ensureGraphSdcAnnotated();
   sim_->ensureConstantsPropagated();
+  if (reg_clk_pins_ == nullptr)
+    reg_clk_pins_ = new RegClkPinCache(this);
+}
+
+// Netlist and constant changes invalidate the register clock pins
+// found by all_registers.
+void
+Sta::regClkPinsInvalid()
+{
+  if (reg_clk_pins_)
+    reg_clk_pins_->clear();
 }
 
 ////////////////////////////////////////////////////////////////
@@ -4923,6 +6570,7 @@ Sta::findFaninPins(PinSeq *to,
   ensureLevelized();
   PinSet fanin(network_);
   FaninSrchPred pred(thru_disabled, thru_constants, this);
+  VertexSeq roots;
   PinSeq::Iterator to_iter(to);
   while (to_iter.hasNext()) {
     const Pin *pin = to_iter.next();
@@ -4930,19 +6578,71 @@ Sta::findFaninPins(PinSeq *to,
       EdgesThruHierPinIterator edge_iter(pin, network_, graph_);
       while (edge_iter.hasNext()) {
 	Edge *edge = edge_iter.next();
-	findFaninPins(edge->from(graph_), flat, startpoints_only,
-		      inst_levels, pin_levels, fanin, pred);
+	roots.push_back(edge->from(graph_));
       }
     }
-    else {
-      Vertex *vertex = graph_->pinLoadVertex(pin);
-      findFaninPins(vertex, flat, startpoints_only,
-		    inst_levels, pin_levels, fanin, pred);
-    }
+    else
+      roots.push_back(graph_->pinLoadVertex(pin));
+  }
+  if (inst_levels <= 0 && pin_levels <= 0)
+    findFaninPins(roots, flat, startpoints_only, fanin, pred);
+  else {
+    for (Vertex *root : roots)
+      findFaninPins(root, flat, startpoints_only,
+                    inst_levels, pin_levels, fanin, pred);
   }
   return fanin;
 }
 
+// Without level limits the fanin of every root is found with one
+// search, so the vertices shared by the fanin cones are visited once.
+void
+Sta::findFaninPins(VertexSeq &roots,
+                   bool flat,
+                   bool startpoints_only,
+                   PinSet &fanin,
+                   SearchPred &pred)
+{
+  std::vector<bool> visited(graph_->vertexIdBound(), false);
+  VertexSeq stack;
+  for (Vertex *root : roots) {
+    VertexId root_id = graph_->id(root);
+    if (!visited[root_id]) {
+      visited[root_id] = true;
+      stack.push_back(root);
+    }
+  }
+  while (!stack.empty()) {
+    Vertex *to = stack.back();
+    stack.pop_back();
+    debugPrint(debug_, "fanin", 1, "%s",
+               to->name(sdc_network_));
+    Pin *to_pin = to->pin();
+    bool is_reg_clk_pin = network_->isRegClkPin(to_pin);
+    if (!startpoints_only
+        || is_reg_clk_pin
+        || !hasFanin(to, &pred, graph_))
+      fanin.insert(to_pin);
+    if (!is_reg_clk_pin
+        && pred.searchTo(to)) {
+      VertexInEdgeIterator edge_iter(to, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        Vertex *from_vertex = edge->from(graph_);
+        VertexId from_id = graph_->id(from_vertex);
+        if (!visited[from_id]
+            && pred.searchThru(edge)
+            && (flat
+                || !crossesHierarchy(edge))
+            && pred.searchFrom(from_vertex)) {
+          visited[from_id] = true;
+          stack.push_back(from_vertex);
+        }
+      }
+    }
+  }
+}
+
 void
 Sta::findFaninPins(Vertex *vertex,
 		   bool flat,
@@ -5033,6 +6733,7 @@ Sta::findFanoutPins(PinSeq *from,
   ensureLevelized();
   PinSet fanout(network_);
   FanInOutSrchPred pred(thru_disabled, thru_constants, this);
+  VertexSeq roots;
   PinSeq::Iterator from_iter(from);
   while (from_iter.hasNext()) {
     const Pin *pin = from_iter.next();
@@ -5040,19 +6741,69 @@ Sta::findFanoutPins(PinSeq *from,
       EdgesThruHierPinIterator edge_iter(pin, network_, graph_);
       while (edge_iter.hasNext()) {
 	Edge *edge = edge_iter.next();
-	findFanoutPins(edge->to(graph_), flat, endpoints_only,
-		       inst_levels, pin_levels, fanout, pred);
+	roots.push_back(edge->to(graph_));
       }
     }
-    else {
-      Vertex *vertex = graph_->pinDrvrVertex(pin);
-      findFanoutPins(vertex, flat, endpoints_only,
-		     inst_levels, pin_levels, fanout, pred);
-    }
+    else
+      roots.push_back(graph_->pinDrvrVertex(pin));
+  }
+  if (inst_levels <= 0 && pin_levels <= 0)
+    findFanoutPins(roots, flat, endpoints_only, fanout, pred);
+  else {
+    for (Vertex *root : roots)
+      findFanoutPins(root, flat, endpoints_only,
+                     inst_levels, pin_levels, fanout, pred);
   }
   return fanout;
 }
 
+// Without level limits the fanout of every root is found with one
+// search, so the vertices shared by the fanout cones are visited once.
+void
+Sta::findFanoutPins(VertexSeq &roots,
+                    bool flat,
+                    bool endpoints_only,
+                    PinSet &fanout,
+                    SearchPred &pred)
+{
+  std::vector<bool> visited(graph_->vertexIdBound(), false);
+  VertexSeq stack;
+  for (Vertex *root : roots) {
+    VertexId root_id = graph_->id(root);
+    if (!visited[root_id]) {
+      visited[root_id] = true;
+      stack.push_back(root);
+    }
+  }
+  while (!stack.empty()) {
+    Vertex *from = stack.back();
+    stack.pop_back();
+    debugPrint(debug_, "fanout", 1, "%s",
+               from->name(sdc_network_));
+    bool is_endpoint = search_->isEndpoint(from, &pred);
+    if (!endpoints_only
+        || is_endpoint)
+      fanout.insert(from->pin());
+    if (!is_endpoint
+        && pred.searchFrom(from)) {
+      VertexOutEdgeIterator edge_iter(from, graph_);
+      while (edge_iter.hasNext()) {
+        Edge *edge = edge_iter.next();
+        Vertex *to_vertex = edge->to(graph_);
+        VertexId to_id = graph_->id(to_vertex);
+        if (!visited[to_id]
+            && pred.searchThru(edge)
+            && (flat
+                || !crossesHierarchy(edge))
+            && pred.searchTo(to_vertex)) {
+          visited[to_id] = true;
+          stack.push_back(to_vertex);
+        }
+      }
+    }
+  }
+}
+
 void
 Sta::findFanoutPins(Vertex *vertex,
 		    bool flat,
@@ -5409,6 +7160,9 @@ Sta::checkCapacitanceLimits(Net *net,
                             const MinMax *min_max)
 {
   checkCapacitanceLimitPreamble();
+  if (net == nullptr && violators)
+    // Load cap changes reach the violators thru delay calculation.
+    findDelays();
   return check_capacitance_limits_->checkCapacitanceLimits(net, violators,
                                                            corner, min_max);
 }
@@ -5533,6 +7287,7 @@ void
 Sta::reportMpwChecks(MinPulseWidthCheckSeq *checks,
 		     bool verbose)
 {
+  ReportBuffer buffer(report_);
   report_path_->reportMpwChecks(checks, verbose);
 }
 
@@ -5572,6 +7327,7 @@ void
 Sta::reportChecks(MinPeriodCheckSeq *checks,
 		  bool verbose)
 {
+  ReportBuffer buffer(report_);
   report_path_->reportChecks(checks, verbose);
 }
 
@@ -5610,6 +7366,7 @@ void
 Sta::reportChecks(MaxSkewCheckSeq *checks,
 		  bool verbose)
 {
+  ReportBuffer buffer(report_);
   report_path_->reportChecks(checks, verbose);
 }
 
@@ -5627,7 +7384,8 @@ Sta::makeEquivCells(LibertyLibrarySeq *equiv_libs,
 		    LibertyLibrarySeq *map_libs)
 {
   delete equiv_cells_;
-  equiv_cells_ = new EquivCells(equiv_libs, map_libs);
+  equiv_cells_ = new EquivCells(equiv_libs, map_libs,
+                                corners_->count() * MinMax::index_count);
 }
 
 LibertyCellSeq *
@@ -5639,16 +7397,26 @@ Sta::equivCells(LibertyCell *cell)
     return nullptr;
 }
 
+const EquivCellKey *
+Sta::equivCellKey(const LibertyCell *cell)
+{
+  if (equiv_cells_)
+    return equiv_cells_->key(cell);
+  else
+    return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////
 
 void
 Sta::writeTimingModel(const char *lib_name,
                       const char *cell_name,
                       const char *filename,
-                      const Corner *corner)
+                      const Corner *corner,
+                      bool one_pass)
 {
   LibertyLibrary *library = makeTimingModel(lib_name, cell_name, filename,
-                                            corner, this);
+                                            corner, one_pass, this);
   writeLiberty(library, filename, this);
 }
 
@@ -5685,6 +7453,14 @@ Sta::power(const Instance *inst,
   return power_->power(inst, corner);
 }
 
+PowerResultSeq
+Sta::power(const InstanceSeq &insts,
+           const Corner *corner)
+{
+  powerPreamble();
+  return power_->power(insts, corner);
+}
+
 PwrActivity
 Sta::findClkedActivity(const Pin *pin)
 {
@@ -42,6 +42,13 @@ StaState::StaState() :
   clk_network_(nullptr),
   thread_count_(1),
   dispatch_queue_(nullptr),
+  bfs_work_stealing_(false),
+  bfs_dependency_driven_(false),
+  bfs_prefetch_distance_(0),
+  levelize_parallel_(false),
+  levelize_scc_(false),
+  sim_parallel_(false),
+  search_path_ap_parallel_(false),
   pocv_enabled_(false),
   sigma_factor_(1.0)
 {
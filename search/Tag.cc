@@ -48,7 +48,6 @@ Tag::Tag(TagIndex index,
 	 InputDelay *input_delay,
 	 bool is_segment_start,
 	 ExceptionStateSet *states,
-	 bool own_states,
 	 const StaState *sta) :
   clk_info_(clk_info),
   input_delay_(input_delay),
@@ -58,7 +57,6 @@ Tag::Tag(TagIndex index,
   is_filter_(false),
   is_loop_(false),
   is_segment_start_(is_segment_start),
-  own_states_(own_states),
   rf_index_(rf_index),
   path_ap_index_(path_ap_index)
 {
@@ -75,12 +73,6 @@ Tag::Tag(TagIndex index,
   }
 }
 
-Tag::~Tag()
-{
-  if (own_states_ && states_)
-    delete states_;
-}
-
 const char *
 Tag::asString(const StaState *sta) const
 {
@@ -246,27 +238,29 @@ void
 Tag::findHash()
 {
   // Common to hash_ and match_hash_.
-  hash_ = hash_init_value;
-  hashIncr(hash_, rf_index_);
-  hashIncr(hash_, path_ap_index_);
-  hashIncr(hash_, is_clk_);
-  hashIncr(hash_, is_segment_start_);
+  size_t hash = hash_init_value;
+  hashIncr(hash, rf_index_);
+  hashIncr(hash, path_ap_index_);
+  hashIncr(hash, is_clk_);
+  hashIncr(hash, is_segment_start_);
   if (states_) {
     for (ExceptionState *state : *states_)
-      hashIncr(hash_, state->hash());
+      hashIncr(hash, state->hash());
   }
-  match_hash_ = hash_;
+  size_t match_hash = hash;
 
   // Finish hash_.
-  hashIncr(hash_, clk_info_->hash());
+  hashIncr(hash, clk_info_->hash());
   if (input_delay_)
-    hashIncr(hash_, input_delay_->index());
+    hashIncr(hash, input_delay_->index());
+  hash_ = hash;
 
   // Finish match_hash_.
   const ClockEdge *clk_edge = clk_info_->clkEdge();
   if (clk_edge)
-    hashIncr(match_hash_, clk_edge->index());
-  hashIncr(match_hash_, clk_info_->isGenClkSrcPath());
+    hashIncr(match_hash, clk_edge->index());
+  hashIncr(match_hash, clk_info_->isGenClkSrcPath());
+  match_hash_ = match_hash;
 }
 
 size_t
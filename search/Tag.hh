@@ -22,6 +22,7 @@
 #include "SdcClass.hh"
 #include "SearchClass.hh"
 #include "PathRef.hh"
+#include "ObjectPool.hh"
 
 namespace sta {
 
@@ -39,6 +40,9 @@ namespace sta {
 // tag ClkInfo includes the last clock driver pin so that distinct
 // paths are used for paths from different sources of min/max clock
 // arrivals.
+//
+// Tag exception state sets are shared by the tags that have the same
+// states and are owned by Search.
 
 class Tag
 {
@@ -51,9 +55,10 @@ public:
       InputDelay *input_delay,
       bool is_segment_start,
       ExceptionStateSet *states,
-      bool own_states,
       const StaState *sta);
-  ~Tag();
+  static void *operator new(size_t size) { return objectPoolAlloc(size); }
+  static void operator delete(void *tag,
+                              size_t size) { objectPoolFree(tag, size); }
   const char *asString(const StaState *sta) const;
   const char *asString(bool report_index,
 		       bool report_rf_min_max,
@@ -87,15 +92,14 @@ private:
   ClkInfo *clk_info_;
   InputDelay *input_delay_;
   ExceptionStateSet *states_;
-  size_t hash_;
-  size_t match_hash_;
+  // 32 bit hashes keep the tag to 40 bytes.
+  uint32_t hash_;
+  uint32_t match_hash_;
   TagIndex index_;
   bool is_clk_:1;
   bool is_filter_:1;
   bool is_loop_:1;
   bool is_segment_start_:1;
-  // Indicates that states_ is owned by the tag.
-  bool own_states_:1;
   unsigned int rf_index_:RiseFall::index_bit_count;
   unsigned int path_ap_index_:path_ap_index_bit_count;
 };
@@ -29,61 +29,152 @@
 namespace sta {
 
 TagGroup::TagGroup(TagGroupIndex index,
-		   ArrivalMap *arrival_map,
+		   Tag **tags,
+		   int arrival_count,
 		   bool has_clk_tag,
 		   bool has_genclk_src_tag,
 		   bool has_filter_tag,
-		   bool has_loop_tag) :
-  arrival_map_(arrival_map),
-  hash_(arrivalMapHash(arrival_map_)),
+		   bool has_loop_tag,
+		   const StaState *sta) :
+  tags_(tags),
+  index_table_(nullptr),
+  bldr_arrival_map_(nullptr),
+  sta_(sta),
+  hash_(0),
+  arrival_count_(arrival_count),
+  index_table_mask_(0),
   index_(index),
   has_clk_tag_(has_clk_tag),
   has_genclk_src_tag_(has_genclk_src_tag),
   has_filter_tag_(has_filter_tag),
-  has_loop_tag_(has_loop_tag),
-  own_arrival_map_(true)
+  has_loop_tag_(has_loop_tag)
 {
+  for (uint32_t i = 0; i < arrival_count_; i++)
+    hash_ += tags_[i]->hash();
+  makeIndexTable();
 }
 
 TagGroup::TagGroup(TagGroupBldr *tag_bldr) :
-  arrival_map_(tag_bldr->arrivalMap()),
-  hash_(arrivalMapHash(arrival_map_)),
-  own_arrival_map_(false)
+  tags_(nullptr),
+  index_table_(nullptr),
+  bldr_arrival_map_(tag_bldr->arrivalMap()),
+  sta_(nullptr),
+  hash_(0),
+  arrival_count_(bldr_arrival_map_->size()),
+  index_table_mask_(0)
 {
+  ArrivalMap::Iterator arrival_iter(bldr_arrival_map_);
+  while (arrival_iter.hasNext()) {
+    Tag *tag;
+    int arrival_index;
+    arrival_iter.next(tag, arrival_index);
+    hash_ += tag->hash();
+  }
 }
 
 TagGroup::~TagGroup()
 {
-  if (own_arrival_map_)
-    delete arrival_map_;
+  delete [] tags_;
+  delete [] index_table_;
 }
 
-size_t
-TagGroup::arrivalMapHash(ArrivalMap *arrival_map)
+// The table is at least twice the arrival count so probes are short.
+void
+TagGroup::makeIndexTable()
 {
-  size_t hash = 0;
-  ArrivalMap::Iterator arrival_iter(arrival_map);
-  while (arrival_iter.hasNext()) {
-    Tag *tag;
-    int arrival_index;
-    arrival_iter.next(tag, arrival_index);
-    hash += tag->hash();
+  uint32_t table_size = 4;
+  while (table_size < arrival_count_ * 2)
+    table_size *= 2;
+  index_table_ = new uint32_t[table_size]();
+  index_table_mask_ = table_size - 1;
+  for (uint32_t i = 0; i < arrival_count_; i++) {
+    size_t entry = tags_[i]->matchHash(true) & index_table_mask_;
+    while (index_table_[entry] != 0)
+      entry = (entry + 1) & index_table_mask_;
+    index_table_[entry] = i + 1;
   }
-  return hash;
 }
 
-bool
-TagGroup::hasTag(Tag *tag) const
+size_t
+TagGroup::bytes() const
 {
-  return arrival_map_->hasKey(tag);
+  return sizeof(TagGroup)
+    + arrival_count_ * sizeof(Tag*)
+    + (index_table_ ? (index_table_mask_ + 1) * sizeof(uint32_t) : 0);
 }
 
+// Lookups use tagMatch like the builder ArrivalMap so a tag that
+// matches a group tag finds its arrival.
 void
 TagGroup::arrivalIndex(Tag *tag,
 		       int &arrival_index,
 		       bool &exists) const
 {
-  arrival_map_->findKey(tag, arrival_index, exists);
+  size_t entry = tag->matchHash(true) & index_table_mask_;
+  while (index_table_[entry] != 0) {
+    int index = index_table_[entry] - 1;
+    if (tagMatch(tags_[index], tag, true, sta_)) {
+      arrival_index = index;
+      exists = true;
+      return;
+    }
+    entry = (entry + 1) & index_table_mask_;
+  }
+  exists = false;
+}
+
+bool
+TagGroup::hasTag(Tag *tag) const
+{
+  return matchTag(tag) != nullptr;
+}
+
+Tag *
+TagGroup::matchTag(Tag *tag) const
+{
+  if (tags_) {
+    int arrival_index;
+    bool exists;
+    arrivalIndex(tag, arrival_index, exists);
+    return exists ? tags_[arrival_index] : nullptr;
+  }
+  else {
+    Tag *tag_match;
+    int arrival_index;
+    bool exists;
+    bldr_arrival_map_->findKey(tag, tag_match, arrival_index, exists);
+    return exists ? tag_match : nullptr;
+  }
+}
+
+// Groups are equal if they have exactly the same tags. Tag lookups use
+// tagMatch, so make sure the matching tag is the same tag.
+bool
+TagGroup::equal(const TagGroup *tag_group) const
+{
+  if (arrival_count_ != tag_group->arrival_count_)
+    return false;
+  // Look up the probe tags in the other group.
+  const TagGroup *group1 = tags_ ? tag_group : this;
+  const TagGroup *group2 = tags_ ? this : tag_group;
+  if (group1->tags_) {
+    for (uint32_t i = 0; i < group1->arrival_count_; i++) {
+      Tag *tag1 = group1->tags_[i];
+      if (group2->matchTag(tag1) != tag1)
+        return false;
+    }
+  }
+  else {
+    ArrivalMap::ConstIterator arrival_iter(group1->bldr_arrival_map_);
+    while (arrival_iter.hasNext()) {
+      Tag *tag1;
+      int arrival_index;
+      arrival_iter.next(tag1, arrival_index);
+      if (group2->matchTag(tag1) != tag1)
+        return false;
+    }
+  }
+  return true;
 }
 
 void
@@ -91,13 +182,16 @@ TagGroup::report(const StaState *sta) const
 {
   Report *report = sta->report();
   report->reportLine("Group %u hash = %lu", index_, hash_);
-  arrivalMapReport(arrival_map_, sta);
+  reportArrivalMap(sta);
 }
 
 void
 TagGroup::reportArrivalMap(const StaState *sta) const
 {
-  arrivalMapReport(arrival_map_, sta);
+  Report *report = sta->report();
+  for (uint32_t i = 0; i < arrival_count_; i++)
+    report->reportLine(" %2u %s", i, tags_[i]->asString(sta));
+  report->reportBlankLine();
 }
 
 void
@@ -240,6 +334,19 @@ TagGroupBldr::setMatchArrival(Tag *tag,
   }
 }
 
+void
+TagGroupBldr::addArrivals(const TagGroupBldr *tag_bldr)
+{
+  ArrivalMap::ConstIterator arrival_iter(tag_bldr->arrival_map_);
+  while (arrival_iter.hasNext()) {
+    Tag *tag;
+    int arrival_index;
+    arrival_iter.next(tag, arrival_index);
+    PathVertexRep prev_path = tag_bldr->prev_paths_[arrival_index];
+    setArrival(tag, tag_bldr->arrivals_[arrival_index], &prev_path);
+  }
+}
+
 void
 TagGroupBldr::deleteArrival(Tag *tag)
 {
@@ -250,28 +357,19 @@ TagGroup *
 TagGroupBldr::makeTagGroup(TagGroupIndex index,
 			   const StaState *sta)
 {
-  return new TagGroup(index, makeArrivalMap(sta),
-		      has_clk_tag_, has_genclk_src_tag_, has_filter_tag_,
-		      has_loop_tag_);
-
-}
-
-ArrivalMap *
-TagGroupBldr::makeArrivalMap(const StaState *sta)
-{
-  ArrivalMap *arrival_map = new ArrivalMap(arrival_map_.size(),
-					   TagMatchHash(true, sta),
-					   TagMatchEqual(true, sta));
+  int arrival_count = arrival_map_.size();
+  Tag **tags = new Tag*[arrival_count];
   int arrival_index = 0;
   ArrivalMap::Iterator arrival_iter(arrival_map_);
   while (arrival_iter.hasNext()) {
     Tag *tag;
     int arrival_index1;
     arrival_iter.next(tag, arrival_index1);
-    arrival_map->insert(tag, arrival_index);
-    arrival_index++;
+    tags[arrival_index++] = tag;
   }
-  return arrival_map;
+  return new TagGroup(index, tags, arrival_count,
+		      has_clk_tag_, has_genclk_src_tag_, has_filter_tag_,
+		      has_loop_tag_, sta);
 }
 
 void
@@ -306,40 +404,13 @@ TagGroupHash::operator()(const TagGroup *group) const
   return group->hash();
 }
 
-static bool
-arrivalMapEqual(const ArrivalMap *arrival_map1,
-		const ArrivalMap *arrival_map2)
-{
-  int arrival_count1 = arrival_map1->size();
-  int arrival_count2 = arrival_map2->size();
-  if (arrival_count1 == arrival_count2) {
-    ArrivalMap::ConstIterator arrival_iter1(arrival_map1);
-    while (arrival_iter1.hasNext()) {
-      Tag *tag1, *tag2;
-      int arrival_index1, arrival_index2;
-      arrival_iter1.next(tag1, arrival_index1);
-      bool exists2;
-      arrival_map2->findKey(tag1, tag2, arrival_index2, exists2);
-      if (!exists2 
-	  // ArrivalMap equal function is TagMatchEqual, so make sure
-	  // the tag is an exact match.
-	  || tag2 != tag1)
-	return false;
-    }
-    return true;
-  }
-  else
-    return false;
-}
-
 bool
 TagGroupEqual::operator()(const TagGroup *tag_group1,
 			  const TagGroup *tag_group2) const
 {
   return tag_group1 == tag_group2
     || (tag_group1->hash() == tag_group2->hash()
-	&& arrivalMapEqual(tag_group1->arrivalMap(),
-			   tag_group2->arrivalMap()));
+	&& tag_group1->equal(tag_group2));
 }
 
 } // namespace
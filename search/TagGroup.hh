@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "Vector.hh"
 #include "Map.hh"
 #include "Iterator.hh"
@@ -31,15 +33,21 @@ class TagGroupBldr;
 
 typedef Vector<PathVertexRep> PathVertexRepSeq;
 
+// Interned set of tags with arrivals at a vertex.
+// The tags are stored in arrival index order with an open addressed
+// table of arrival indices hashed by tag match for lookups.
 class TagGroup
 {
 public:
+  // Takes ownership of tags.
   TagGroup(TagGroupIndex index,
-	   ArrivalMap *arrival_map,
+	   Tag **tags,
+	   int arrival_count,
 	   bool has_clk_tag,
 	   bool has_genclk_src_tag,
 	   bool has_filter_tag,
-	   bool has_loop_tag);
+	   bool has_loop_tag,
+	   const StaState *sta);
   // For Search::findTagGroup to probe.
   TagGroup(TagGroupBldr *tag_bldr);
   ~TagGroup();
@@ -51,26 +59,36 @@ public:
   bool hasGenClkSrcTag() const { return has_genclk_src_tag_; }
   bool hasFilterTag() const { return has_filter_tag_; }
   bool hasLoopTag() const { return has_loop_tag_; }
-  bool ownArrivalMap() const { return own_arrival_map_; }
-  int arrivalCount() const { return arrival_map_->size(); }
+  int arrivalCount() const { return arrival_count_; }
+  // Tag of arrival_index (0 <= arrival_index < arrivalCount()).
+  Tag *arrivalTag(int arrival_index) const { return tags_[arrival_index]; }
   void arrivalIndex(Tag *tag,
 		    int &arrival_index,
 		    bool &exists) const;
-  ArrivalMap *arrivalMap() const { return arrival_map_; }
   bool hasTag(Tag *tag) const;
+  bool equal(const TagGroup *tag_group) const;
+  size_t bytes() const;
 
 protected:
-  size_t arrivalMapHash(ArrivalMap *arrival_map);
+  void makeIndexTable();
+  // Tag in the group that matches tag, or nullptr.
+  Tag *matchTag(Tag *tag) const;
 
-  // tag -> arrival index
-  ArrivalMap *arrival_map_;
+  // arrival index -> tag
+  Tag **tags_;
+  // Arrival index + 1, 0 for empty entries.
+  uint32_t *index_table_;
+  // Builder arrivals of probes (tags_ is null).
+  ArrivalMap *bldr_arrival_map_;
+  const StaState *sta_;
   size_t hash_;
+  uint32_t arrival_count_;
+  uint32_t index_table_mask_;
   unsigned int index_:tag_group_index_bits;
   bool has_clk_tag_:1;
   bool has_genclk_src_tag_:1;
   bool has_filter_tag_:1;
   bool has_loop_tag_:1;
-  bool own_arrival_map_:1;
 };
 
 class TagGroupHash
@@ -117,6 +135,9 @@ public:
 		       const Arrival &arrival,
 		       int arrival_index,
 		       PathVertexRep *prev_path);
+  // Add the arrivals of a builder for the same vertex with different
+  // path analysis points.
+  void addArrivals(const TagGroupBldr *tag_bldr);
   ArrivalMap *arrivalMap() { return &arrival_map_; }
   void copyArrivals(TagGroup *tag_group,
 		    Arrival *arrivals,
@@ -124,7 +145,6 @@ public:
 
 protected:
   int tagMatchIndex();
-  ArrivalMap *makeArrivalMap(const StaState *sta);
 
   Vertex *vertex_;
   int default_arrival_count_;
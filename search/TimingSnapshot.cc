@@ -0,0 +1,508 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "TimingSnapshot.hh"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "Error.hh"
+#include "Report.hh"
+#include "Hash.hh"
+#include "Transition.hh"
+#include "TimingArc.hh"
+#include "Liberty.hh"
+#include "Network.hh"
+#include "Graph.hh"
+#include "Clock.hh"
+#include "InputDrive.hh"
+#include "Sdc.hh"
+#include "Corner.hh"
+#include "DcalcAnalysisPt.hh"
+#include "ArcDelayCalc.hh"
+#include "Parasitics.hh"
+#include "CacheNetlist.hh"
+
+namespace sta {
+
+// File layout (host byte order):
+//  header    magic[8] version byte_order netlist_checksum
+//            inputs_checksum ap_count slew_size delay_size
+//  vertices  pin_id vertex_type slews[rf][ap]
+//            edge_count {to_pin_id arc_count {delays[ap] annotated[ap]}}
+//  end       pin_id 0
+// Vertices are written in netlist pin order and edges in graph order,
+// so the reader checks that each edge goes to the same pin with the
+// same number of arcs.
+// The inputs checksum covers the SDC and parasitics the delays were
+// found with.
+static const char snapshot_magic[8] = {'S', 'T', 'A', 'T', 'I', 'M', 'N', 'G'};
+static const uint32_t snapshot_version = 2;
+static const uint32_t snapshot_byte_order = 0x01020304;
+
+enum class SnapshotVertex : uint8_t {
+  end,
+  load,
+  bidirect_drvr
+};
+
+////////////////////////////////////////////////////////////////
+
+static void
+hashFloat(size_t &hash,
+          float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  hashIncr(hash, bits);
+}
+
+static void
+hashInputDrive(size_t &hash,
+               InputDrive *drive)
+{
+  for (const RiseFall *rf : RiseFall::range()) {
+    for (const MinMax *min_max : MinMax::range()) {
+      float slew, res;
+      bool exists;
+      drive->slew(rf, min_max, slew, exists);
+      if (exists)
+        hashFloat(hash, slew);
+      drive->driveResistance(rf, min_max, res, exists);
+      if (exists)
+        hashFloat(hash, res);
+      if (drive->hasDriveCell(rf, min_max)) {
+        const LibertyCell *cell;
+        const LibertyPort *from_port, *to_port;
+        float *from_slews;
+        drive->driveCell(rf, min_max, cell, from_port, from_slews, to_port);
+        hashIncr(hash, hashString(cell->name()));
+        if (from_slews) {
+          for (const RiseFall *from_rf : RiseFall::range())
+            hashFloat(hash, from_slews[from_rf->index()]);
+        }
+      }
+    }
+  }
+}
+
+// Checksum of the SDC and parasitics inputs to delay calculation:
+// driver pin/wire capacitances and fanouts, which include set_load and
+// wireloads, parasitic capacitances, port input drives, ideal clock
+// slews and constants.
+static uint64_t
+delayInputsChecksum(const CacheNetlist &netlist,
+                    const StaState *sta)
+{
+  const Network *network = sta->network();
+  Sdc *sdc = sta->sdc();
+  Parasitics *parasitics = sta->parasitics();
+  ArcDelayCalc *arc_delay_calc = sta->arcDelayCalc();
+  const DcalcAnalysisPtSeq &dcalc_aps = sta->corners()->dcalcAnalysisPts();
+  size_t checksum = hash_init_value;
+  for (const Pin *pin : netlist.pins()) {
+    if (network->isDriver(pin)) {
+      for (const DcalcAnalysisPt *dcalc_ap : dcalc_aps) {
+        for (const RiseFall *rf : RiseFall::range()) {
+          float pin_cap, wire_cap, fanout;
+          bool has_net_load;
+          sdc->connectedCap(pin, rf, dcalc_ap->corner(),
+                            dcalc_ap->constraintMinMax(),
+                            pin_cap, wire_cap, fanout, has_net_load);
+          hashFloat(checksum, pin_cap);
+          hashFloat(checksum, wire_cap);
+          hashFloat(checksum, fanout);
+          const Parasitic *parasitic =
+            arc_delay_calc->findParasitic(pin, rf, dcalc_ap);
+          if (parasitic)
+            hashFloat(checksum, parasitics->capacitance(parasitic));
+        }
+        arc_delay_calc->finishDrvrPin();
+      }
+    }
+    if (network->isTopLevelPort(pin)) {
+      InputDrive *drive = sdc->findInputDrive(network->port(pin));
+      if (drive)
+        hashInputDrive(checksum, drive);
+    }
+    LogicValue value;
+    bool exists;
+    sdc->logicValue(pin, value, exists);
+    if (exists)
+      hashIncr(checksum, static_cast<size_t>(value) + 1);
+    sdc->caseLogicValue(pin, value, exists);
+    if (exists)
+      hashIncr(checksum, static_cast<size_t>(value) + 5);
+  }
+  for (const Clock *clk : *sdc->clocks()) {
+    hashIncr(checksum, hashString(clk->name()));
+    for (const RiseFall *rf : RiseFall::range()) {
+      for (const MinMax *min_max : MinMax::range())
+        hashFloat(checksum, clk->slew(rf, min_max));
+    }
+  }
+  return checksum;
+}
+
+////////////////////////////////////////////////////////////////
+
+class TimingSnapshotWriter : public StaState
+{
+public:
+  TimingSnapshotWriter(const char *filename,
+                       StaState *sta);
+  ~TimingSnapshotWriter();
+  void write();
+
+private:
+  void writeHeader();
+  void writeVertex(const Pin *pin,
+                   Vertex *vertex,
+                   SnapshotVertex vertex_type);
+  template <class VALUE>
+  void writeValue(VALUE value);
+  void writeBytes(const void *bytes,
+                  size_t size);
+
+  const char *filename_;
+  FILE *stream_;
+  CacheNetlist netlist_;
+  DcalcAPIndex ap_count_;
+};
+
+void
+writeTimingSnapshot(const char *filename,
+                    StaState *sta)
+{
+  TimingSnapshotWriter writer(filename, sta);
+  writer.write();
+}
+
+TimingSnapshotWriter::TimingSnapshotWriter(const char *filename,
+                                           StaState *sta) :
+  StaState(sta),
+  filename_(filename),
+  stream_(nullptr),
+  netlist_(sta),
+  ap_count_(sta->corners()->dcalcAnalysisPtCount())
+{
+}
+
+TimingSnapshotWriter::~TimingSnapshotWriter()
+{
+  if (stream_)
+    fclose(stream_);
+}
+
+void
+TimingSnapshotWriter::write()
+{
+  stream_ = fopen(filename_, "wb");
+  if (stream_ == nullptr)
+    throw FileNotWritable(filename_);
+  writeHeader();
+  for (const Pin *pin : netlist_.pins()) {
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+    if (vertex)
+      writeVertex(pin, vertex, SnapshotVertex::load);
+    if (bidirect_drvr_vertex)
+      writeVertex(pin, bidirect_drvr_vertex, SnapshotVertex::bidirect_drvr);
+  }
+  writeValue(static_cast<ObjectId>(0));
+  writeValue(SnapshotVertex::end);
+  bool failed = ferror(stream_);
+  if (fclose(stream_) != 0)
+    failed = true;
+  stream_ = nullptr;
+  if (failed)
+    report_->error(1607, "write_timing_snapshot %s failed.", filename_);
+}
+
+void
+TimingSnapshotWriter::writeHeader()
+{
+  writeBytes(snapshot_magic, sizeof(snapshot_magic));
+  writeValue(snapshot_version);
+  writeValue(snapshot_byte_order);
+  writeValue(netlist_.checksum());
+  writeValue(delayInputsChecksum(netlist_, this));
+  writeValue(static_cast<uint32_t>(ap_count_));
+  writeValue(static_cast<uint32_t>(sizeof(Slew)));
+  writeValue(static_cast<uint32_t>(sizeof(ArcDelay)));
+}
+
+void
+TimingSnapshotWriter::writeVertex(const Pin *pin,
+                                  Vertex *vertex,
+                                  SnapshotVertex vertex_type)
+{
+  writeValue(network_->id(pin));
+  writeValue(vertex_type);
+  for (const RiseFall *rf : RiseFall::range()) {
+    for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++)
+      writeValue(graph_->slew(vertex, rf, ap_index));
+  }
+  uint32_t edge_count = 0;
+  VertexOutEdgeIterator edge_iter1(vertex, graph_);
+  while (edge_iter1.hasNext()) {
+    edge_iter1.next();
+    edge_count++;
+  }
+  writeValue(edge_count);
+  VertexOutEdgeIterator edge_iter(vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *edge = edge_iter.next();
+    const TimingArcSeq &arcs = edge->timingArcSet()->arcs();
+    writeValue(network_->id(edge->to(graph_)->pin()));
+    writeValue(static_cast<uint32_t>(arcs.size()));
+    for (const TimingArc *arc : arcs) {
+      for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
+        writeValue(graph_->arcDelay(edge, arc, ap_index));
+        writeValue(static_cast<uint8_t>(graph_->arcDelayAnnotated(edge, arc,
+                                                                  ap_index)));
+      }
+    }
+  }
+}
+
+template <class VALUE>
+void
+TimingSnapshotWriter::writeValue(VALUE value)
+{
+  writeBytes(&value, sizeof(VALUE));
+}
+
+void
+TimingSnapshotWriter::writeBytes(const void *bytes,
+                                 size_t size)
+{
+  fwrite(bytes, size, 1, stream_);
+}
+
+////////////////////////////////////////////////////////////////
+
+class TimingSnapshotReader : public StaState
+{
+public:
+  TimingSnapshotReader(const char *filename,
+                       StaState *sta);
+  bool read();
+
+private:
+  bool readFile();
+  bool readHeader();
+  bool readVertices();
+  bool readVertex(Vertex *vertex);
+  template <class VALUE>
+  VALUE readValue();
+  bool readBytes(void *bytes,
+                 size_t size);
+  bool corrupt();
+
+  const char *filename_;
+  std::vector<char> data_;
+  size_t pos_;
+  bool truncated_;
+  CacheNetlist netlist_;
+  DcalcAPIndex ap_count_;
+  std::unordered_map<ObjectId, const Pin*> pin_id_map_;
+};
+
+bool
+readTimingSnapshot(const char *filename,
+                   StaState *sta)
+{
+  TimingSnapshotReader reader(filename, sta);
+  return reader.read();
+}
+
+TimingSnapshotReader::TimingSnapshotReader(const char *filename,
+                                           StaState *sta) :
+  StaState(sta),
+  filename_(filename),
+  pos_(0),
+  truncated_(false),
+  netlist_(sta),
+  ap_count_(sta->corners()->dcalcAnalysisPtCount())
+{
+}
+
+bool
+TimingSnapshotReader::read()
+{
+  if (!readFile())
+    throw FileNotReadable(filename_);
+  if (!readHeader())
+    return false;
+  for (const Pin *pin : netlist_.pins())
+    pin_id_map_[network_->id(pin)] = pin;
+  return readVertices();
+}
+
+// The whole file is read with one fread and decoded from memory.
+bool
+TimingSnapshotReader::readFile()
+{
+  FILE *stream = fopen(filename_, "rb");
+  if (stream == nullptr)
+    return false;
+  bool success = false;
+  if (fseek(stream, 0, SEEK_END) == 0) {
+    long size = ftell(stream);
+    if (size >= 0
+        && fseek(stream, 0, SEEK_SET) == 0) {
+      data_.resize(size);
+      success = fread(data_.data(), 1, size, stream) == static_cast<size_t>(size);
+    }
+  }
+  fclose(stream);
+  return success;
+}
+
+bool
+TimingSnapshotReader::readHeader()
+{
+  char magic[sizeof(snapshot_magic)];
+  if (!readBytes(magic, sizeof(magic))
+      || memcmp(magic, snapshot_magic, sizeof(magic)) != 0) {
+    report_->warn(1608, "%s is not a timing snapshot file.", filename_);
+    return false;
+  }
+  uint32_t version = readValue<uint32_t>();
+  uint32_t byte_order = readValue<uint32_t>();
+  if (version != snapshot_version
+      || byte_order != snapshot_byte_order) {
+    report_->warn(1609, "timing snapshot %s version or byte order not supported.",
+                  filename_);
+    return false;
+  }
+  uint64_t checksum = readValue<uint64_t>();
+  if (checksum != netlist_.checksum()) {
+    report_->warn(1610, "timing snapshot %s was written for a different netlist.",
+                  filename_);
+    return false;
+  }
+  uint64_t inputs_checksum = readValue<uint64_t>();
+  if (inputs_checksum != delayInputsChecksum(netlist_, this)) {
+    report_->warn(1692, "timing snapshot %s was written with different SDC or parasitics.",
+                  filename_);
+    return false;
+  }
+  uint32_t ap_count = readValue<uint32_t>();
+  uint32_t slew_size = readValue<uint32_t>();
+  uint32_t delay_size = readValue<uint32_t>();
+  if (ap_count != static_cast<uint32_t>(ap_count_)
+      || slew_size != sizeof(Slew)
+      || delay_size != sizeof(ArcDelay)) {
+    report_->warn(1611, "timing snapshot %s analysis points or delay types do not match.",
+                  filename_);
+    return false;
+  }
+  return !truncated_ || corrupt();
+}
+
+bool
+TimingSnapshotReader::readVertices()
+{
+  // Snapshot delays are restored for every analysis point.
+  graph_->unshareDelays();
+  for (;;) {
+    ObjectId pin_id = readValue<ObjectId>();
+    SnapshotVertex vertex_type = readValue<SnapshotVertex>();
+    if (truncated_)
+      return corrupt();
+    if (vertex_type == SnapshotVertex::end)
+      return true;
+    auto id_pin = pin_id_map_.find(pin_id);
+    if (id_pin == pin_id_map_.end())
+      return corrupt();
+    Vertex *vertex, *bidirect_drvr_vertex;
+    graph_->pinVertices(id_pin->second, vertex, bidirect_drvr_vertex);
+    if (vertex_type == SnapshotVertex::bidirect_drvr)
+      vertex = bidirect_drvr_vertex;
+    if (vertex == nullptr
+        || !readVertex(vertex)
+        || truncated_)
+      return corrupt();
+  }
+}
+
+bool
+TimingSnapshotReader::readVertex(Vertex *vertex)
+{
+  for (const RiseFall *rf : RiseFall::range()) {
+    for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++)
+      graph_->setSlew(vertex, rf, ap_index, readValue<Slew>());
+  }
+  uint32_t edge_count = readValue<uint32_t>();
+  VertexOutEdgeIterator edge_iter(vertex, graph_);
+  for (uint32_t i = 0; i < edge_count && !truncated_; i++) {
+    if (!edge_iter.hasNext())
+      return false;
+    Edge *edge = edge_iter.next();
+    const TimingArcSeq &arcs = edge->timingArcSet()->arcs();
+    ObjectId to_pin_id = readValue<ObjectId>();
+    uint32_t arc_count = readValue<uint32_t>();
+    if (to_pin_id != network_->id(edge->to(graph_)->pin())
+        || arc_count != arcs.size())
+      return false;
+    for (const TimingArc *arc : arcs) {
+      for (DcalcAPIndex ap_index = 0; ap_index < ap_count_; ap_index++) {
+        graph_->setArcDelay(edge, arc, ap_index, readValue<ArcDelay>());
+        bool annotated = readValue<uint8_t>();
+        if (annotated || graph_->arcDelayAnnotated(edge, arc, ap_index))
+          graph_->setArcDelayAnnotated(edge, arc, ap_index, annotated);
+      }
+    }
+  }
+  return !edge_iter.hasNext();
+}
+
+template <class VALUE>
+VALUE
+TimingSnapshotReader::readValue()
+{
+  VALUE value{};
+  readBytes(&value, sizeof(VALUE));
+  return value;
+}
+
+bool
+TimingSnapshotReader::readBytes(void *bytes,
+                                size_t size)
+{
+  if (size > data_.size() - pos_) {
+    truncated_ = true;
+    pos_ = data_.size();
+    return false;
+  }
+  memcpy(bytes, data_.data() + pos_, size);
+  pos_ += size;
+  return true;
+}
+
+bool
+TimingSnapshotReader::corrupt()
+{
+  report_->warn(1612, "timing snapshot %s is corrupt.", filename_);
+  return false;
+}
+
+} // namespace
@@ -0,0 +1,40 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace sta {
+
+class StaState;
+
+// Write the slews and arc delays for every delay calculation analysis
+// point (including sdf annotation flags) to a binary file.
+// Vertices are keyed by network pin ids and the file carries
+// checksums of the netlist they refer to and of the SDC and
+// parasitics they were found with.
+void
+writeTimingSnapshot(const char *filename,
+                    StaState *sta);
+
+// Replace the graph slews and arc delays with the contents of a file
+// written by writeTimingSnapshot for the same netlist, corners, SDC
+// and parasitics.
+// Return true if successful.
+bool
+readTimingSnapshot(const char *filename,
+                   StaState *sta);
+
+} // namespace
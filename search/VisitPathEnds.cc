@@ -583,13 +583,15 @@ VisitPathEnds::visitUnconstrainedPathEnds(const Pin *pin,
 	 || path_ap->corner() == corner)
 	&& min_max->matches(path_min_max)
 	// Ignore generated clock source paths.
-	&& !path->clkInfo(this)->isGenClkSrcPath()
-	&& (!filtered
-	    || search_->matchesFilter(path, nullptr))
-	&& !falsePathTo(path, pin, path->transition(this),
-			path->minMax(this))) {
+	&& !path->clkInfo(this)->isGenClkSrcPath()) {
       PathEndUnconstrained path_end(path);
-      visitor->visit(&path_end);
+      // Check the arrival before the exceptions.
+      if (visitor->unconstrainedSavable(&path_end)
+	  && (!filtered
+	      || search_->matchesFilter(path, nullptr))
+	  && !falsePathTo(path, pin, path->transition(this),
+			  path->minMax(this)))
+	visitor->visit(&path_end);
     }
   }
 }
@@ -118,7 +118,7 @@ visitPathGroupVertices(PathGroup *path_group,
   VisitPathGroupEnds end_visitor(path_group, visitor, &matching_path_map,
 				 &bkwd_iter, sta);
   VisitPathEnds visit_path_ends(sta);
-  for(Vertex *vertex : *search->endpoints())
+  for(Vertex *vertex : search->endpointSeq())
     visit_path_ends.visitPathEnds(vertex, &end_visitor);
 
   // Search backward from the path ends thru vertices that have arrival tags
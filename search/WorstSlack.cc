@@ -159,7 +159,7 @@ WorstSlack::initQueue(PathAPIndex path_ap_index)
   worst_vertex_ = nullptr;
   worst_slack_ = slack_init_;
   slack_threshold_ = slack_init_;
-  for(Vertex *vertex : *search_->endpoints()) {
+  for(Vertex *vertex : search_->endpointSeq()) {
     Slack slack = search_->wnsSlack(vertex, path_ap_index);
     if (!delayEqual(slack, slack_init_)) {
       if (delayLess(slack, worst_slack_, this))
@@ -231,7 +231,7 @@ void
 WorstSlack::checkQueue(PathAPIndex path_ap_index)
 {
   VertexSeq ends;
-  for(Vertex *end : *search_->endpoints()) {
+  for(Vertex *end : search_->endpointSeq()) {
     if (delayLessEqual(search_->wnsSlack(end, path_ap_index),
 		       slack_threshold_, this))
       ends.push_back(end);
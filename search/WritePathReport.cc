@@ -0,0 +1,394 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "WritePathReport.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Error.hh"
+#include "Transition.hh"
+#include "MinMax.hh"
+#include "TimingRole.hh"
+#include "TimingArc.hh"
+#include "Network.hh"
+#include "Graph.hh"
+#include "Sdc.hh"
+#include "DcalcAnalysisPt.hh"
+#include "GraphDelayCalc.hh"
+#include "Corner.hh"
+#include "PathAnalysisPt.hh"
+#include "PathRef.hh"
+#include "PathEnd.hh"
+#include "PathExpanded.hh"
+#include "PathGroup.hh"
+#include "Search.hh"
+
+namespace sta {
+
+using std::string;
+
+// File layout (host byte order, times in seconds, caps in farads):
+//  header    magic[8] version byte_order
+//  records   type ...
+//   strings  count {length chars[length]}[count]
+//            Strings are numbered in file order starting at 0 = "".
+//   paths    path_count stage_count
+//            path columns, path_count entries each
+//              startpoint endpoint group type (string ids)
+//              min_max end_rf (0 min/rise, 1 max/fall)
+//              slack required arrival
+//              stage_begin (path_count + 1 entries)
+//            stage columns, stage_count entries each
+//              pin cell arc_role (string ids)
+//              rf is_clock
+//              incr arrival slew cap fanout
+//            cap and fanout are NaN for pins that are not drivers.
+//  end       record_end
+static const char path_report_magic[8] = {'S', 'T', 'A', 'P', 'A', 'T', 'H', 'S'};
+static const uint32_t path_report_version = 1;
+static const uint32_t path_report_byte_order = 0x01020304;
+
+enum class PathReportRecord : uint8_t {
+  end,
+  strings,
+  paths
+};
+
+// Flush a block when either count is reached.
+static const size_t path_report_block_paths = 4096;
+static const size_t path_report_block_stages = 1 << 16;
+
+class PathReportWriter : public StaState
+{
+public:
+  PathReportWriter(const char *filename,
+                   StaState *sta);
+  ~PathReportWriter();
+  void write(PathEndSeq *ends);
+
+private:
+  void writePathEnd(PathEnd *end);
+  void writeStage(PathExpanded &expanded,
+                  size_t index,
+                  const DcalcAnalysisPt *dcalc_ap,
+                  const MinMax *min_max,
+                  float prev_arrival);
+  float drvrFanout(Vertex *drvr,
+                   const Corner *corner,
+                   const MinMax *min_max);
+  uint32_t pinId(const Pin *pin);
+  uint32_t nameId(const char *name);
+  uint32_t addString(const char *str);
+  void writeBlock();
+  void clearBlock();
+  template <class VALUE>
+  void writeColumn(const std::vector<VALUE> &column);
+  template <class VALUE>
+  void writeValue(VALUE value);
+  void writeBytes(const void *bytes,
+                  size_t size);
+
+  const char *filename_;
+  FILE *stream_;
+  std::unordered_map<const Pin*, uint32_t> pin_ids_;
+  // Names are keyed by their (persistent) char pointers.
+  std::unordered_map<const char*, uint32_t> name_ids_;
+  uint32_t string_count_;
+  // Strings added since the last block was written.
+  std::vector<string> strings_;
+
+  // Path columns.
+  std::vector<uint32_t> startpoints_;
+  std::vector<uint32_t> endpoints_;
+  std::vector<uint32_t> groups_;
+  std::vector<uint32_t> types_;
+  std::vector<uint8_t> min_maxs_;
+  std::vector<uint8_t> end_rfs_;
+  std::vector<float> slacks_;
+  std::vector<float> requireds_;
+  std::vector<float> path_arrivals_;
+  std::vector<uint32_t> stage_begins_;
+
+  // Stage columns.
+  std::vector<uint32_t> pins_;
+  std::vector<uint32_t> cells_;
+  std::vector<uint32_t> arc_roles_;
+  std::vector<uint8_t> rfs_;
+  std::vector<uint8_t> is_clks_;
+  std::vector<float> incrs_;
+  std::vector<float> arrivals_;
+  std::vector<float> slews_;
+  std::vector<float> caps_;
+  std::vector<float> fanouts_;
+};
+
+void
+writePathReport(PathEndSeq *ends,
+                const char *filename,
+                StaState *sta)
+{
+  PathReportWriter writer(filename, sta);
+  writer.write(ends);
+}
+
+PathReportWriter::PathReportWriter(const char *filename,
+                                   StaState *sta) :
+  StaState(sta),
+  filename_(filename),
+  stream_(nullptr),
+  string_count_(0)
+{
+}
+
+PathReportWriter::~PathReportWriter()
+{
+  if (stream_)
+    fclose(stream_);
+}
+
+void
+PathReportWriter::write(PathEndSeq *ends)
+{
+  stream_ = fopen(filename_, "wb");
+  if (stream_ == nullptr)
+    throw FileNotWritable(filename_);
+  writeBytes(path_report_magic, sizeof(path_report_magic));
+  writeValue(path_report_version);
+  writeValue(path_report_byte_order);
+  addString("");
+  clearBlock();
+  for (PathEnd *end : *ends) {
+    writePathEnd(end);
+    if (startpoints_.size() >= path_report_block_paths
+        || pins_.size() >= path_report_block_stages) {
+      writeBlock();
+      clearBlock();
+    }
+  }
+  if (!startpoints_.empty())
+    writeBlock();
+  writeValue(PathReportRecord::end);
+}
+
+void
+PathReportWriter::writePathEnd(PathEnd *end)
+{
+  const MinMax *min_max = end->minMax(this);
+  PathExpanded expanded(end->path(), this);
+  const PathRef *start_path = expanded.startPath();
+  startpoints_.push_back(start_path
+                         ? pinId(start_path->pin(this))
+                         : 0);
+  endpoints_.push_back(pinId(end->vertex(this)->pin()));
+  PathGroup *group = search_->pathGroup(end);
+  groups_.push_back(group ? nameId(group->name()) : 0);
+  types_.push_back(nameId(end->typeName()));
+  min_maxs_.push_back(min_max->index());
+  end_rfs_.push_back(end->transition(this)->index());
+  slacks_.push_back(delayAsFloat(end->slack(this)));
+  requireds_.push_back(delayAsFloat(end->requiredTimeOffset(this)));
+  path_arrivals_.push_back(delayAsFloat(end->dataArrivalTimeOffset(this)));
+
+  const DcalcAnalysisPt *dcalc_ap =
+    end->pathAnalysisPt(this)->dcalcAnalysisPt();
+  float prev_arrival = 0.0;
+  for (size_t i = expanded.startIndex(); i < expanded.size(); i++) {
+    writeStage(expanded, i, dcalc_ap, min_max, prev_arrival);
+    prev_arrival = arrivals_.back();
+  }
+  stage_begins_.push_back(pins_.size());
+}
+
+void
+PathReportWriter::writeStage(PathExpanded &expanded,
+                             size_t index,
+                             const DcalcAnalysisPt *dcalc_ap,
+                             const MinMax *min_max,
+                             float prev_arrival)
+{
+  PathRef *path = expanded.path(index);
+  TimingArc *prev_arc = expanded.prevArc(index);
+  Vertex *vertex = path->vertex(this);
+  const Pin *pin = vertex->pin();
+  const RiseFall *rf = path->transition(this);
+  float arrival = delayAsFloat(path->arrival(this), min_max, this);
+
+  pins_.push_back(pinId(pin));
+  cells_.push_back(network_->isTopLevelPort(pin)
+                   ? 0
+                   : nameId(network_->cellName(network_->instance(pin))));
+  arc_roles_.push_back(prev_arc ? nameId(prev_arc->role()->asString()) : 0);
+  rfs_.push_back(rf->index());
+  is_clks_.push_back(path->isClock(search_));
+  incrs_.push_back(prev_arc ? arrival - prev_arrival : 0.0F);
+  arrivals_.push_back(arrival);
+  slews_.push_back(delayAsFloat(path->slew(this), min_max, this));
+  if (network_->isDriver(pin)) {
+    caps_.push_back(graph_delay_calc_->loadCap(pin, rf, dcalc_ap));
+    fanouts_.push_back(drvrFanout(vertex, dcalc_ap->corner(), min_max));
+  }
+  else {
+    caps_.push_back(NAN);
+    fanouts_.push_back(NAN);
+  }
+}
+
+// Same as ReportPath::drvrFanout.
+float
+PathReportWriter::drvrFanout(Vertex *drvr,
+                             const Corner *corner,
+                             const MinMax *min_max)
+{
+  float fanout = 0.0;
+  VertexOutEdgeIterator iter(drvr, graph_);
+  while (iter.hasNext()) {
+    Edge *edge = iter.next();
+    if (edge->isWire()) {
+      Pin *pin = edge->to(graph_)->pin();
+      if (network_->isTopLevelPort(pin)) {
+        // Output port counts as a fanout.
+        Port *port = network_->port(pin);
+        fanout += sdc_->portExtFanout(port, corner, min_max) + 1;
+      }
+      else
+        fanout++;
+    }
+  }
+  return fanout;
+}
+
+uint32_t
+PathReportWriter::pinId(const Pin *pin)
+{
+  auto itr = pin_ids_.find(pin);
+  if (itr != pin_ids_.end())
+    return itr->second;
+  uint32_t id = addString(cmd_network_->pathName(pin));
+  pin_ids_[pin] = id;
+  return id;
+}
+
+uint32_t
+PathReportWriter::nameId(const char *name)
+{
+  auto itr = name_ids_.find(name);
+  if (itr != name_ids_.end())
+    return itr->second;
+  uint32_t id = addString(name);
+  name_ids_[name] = id;
+  return id;
+}
+
+uint32_t
+PathReportWriter::addString(const char *str)
+{
+  strings_.push_back(str);
+  return string_count_++;
+}
+
+void
+PathReportWriter::writeBlock()
+{
+  if (!strings_.empty()) {
+    writeValue(PathReportRecord::strings);
+    writeValue(static_cast<uint32_t>(strings_.size()));
+    for (const string &str : strings_) {
+      writeValue(static_cast<uint32_t>(str.size()));
+      writeBytes(str.data(), str.size());
+    }
+    strings_.clear();
+  }
+  writeValue(PathReportRecord::paths);
+  writeValue(static_cast<uint32_t>(startpoints_.size()));
+  writeValue(static_cast<uint32_t>(pins_.size()));
+  writeColumn(startpoints_);
+  writeColumn(endpoints_);
+  writeColumn(groups_);
+  writeColumn(types_);
+  writeColumn(min_maxs_);
+  writeColumn(end_rfs_);
+  writeColumn(slacks_);
+  writeColumn(requireds_);
+  writeColumn(path_arrivals_);
+  writeColumn(stage_begins_);
+
+  writeColumn(pins_);
+  writeColumn(cells_);
+  writeColumn(arc_roles_);
+  writeColumn(rfs_);
+  writeColumn(is_clks_);
+  writeColumn(incrs_);
+  writeColumn(arrivals_);
+  writeColumn(slews_);
+  writeColumn(caps_);
+  writeColumn(fanouts_);
+}
+
+void
+PathReportWriter::clearBlock()
+{
+  startpoints_.clear();
+  endpoints_.clear();
+  groups_.clear();
+  types_.clear();
+  min_maxs_.clear();
+  end_rfs_.clear();
+  slacks_.clear();
+  requireds_.clear();
+  path_arrivals_.clear();
+  stage_begins_.clear();
+  stage_begins_.push_back(0);
+
+  pins_.clear();
+  cells_.clear();
+  arc_roles_.clear();
+  rfs_.clear();
+  is_clks_.clear();
+  incrs_.clear();
+  arrivals_.clear();
+  slews_.clear();
+  caps_.clear();
+  fanouts_.clear();
+}
+
+template <class VALUE>
+void
+PathReportWriter::writeColumn(const std::vector<VALUE> &column)
+{
+  writeBytes(column.data(), column.size() * sizeof(VALUE));
+}
+
+template <class VALUE>
+void
+PathReportWriter::writeValue(VALUE value)
+{
+  writeBytes(&value, sizeof(VALUE));
+}
+
+void
+PathReportWriter::writeBytes(const void *bytes,
+                             size_t size)
+{
+  if (size > 0)
+    fwrite(bytes, size, 1, stream_);
+}
+
+} // namespace
@@ -0,0 +1,34 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "SearchClass.hh"
+
+namespace sta {
+
+class StaState;
+
+// Write path ends and the stages of their expanded paths to a binary
+// file with a columnar layout. Paths are written in blocks so the
+// file is streamed rather than built in memory.
+// Throws FileNotWritable.
+void
+writePathReport(PathEndSeq *ends,
+                const char *filename,
+                StaState *sta);
+
+} // namespace
@@ -16,8 +16,10 @@
 
 #include "WritePathSpice.hh"
 
+#include <exception>
 #include <string>
 #include <fstream>
+#include <vector>
 
 #include "Debug.hh"
 #include "Error.hh"
@@ -39,6 +41,8 @@
 #include "Path.hh"
 #include "PathRef.hh"
 #include "PathExpanded.hh"
+#include "PathEnd.hh"
+#include "DispatchQueue.hh"
 #include "StaState.hh"
 #include "Sim.hh"
 #include "WriteSpice.hh"
@@ -64,6 +68,7 @@ public:
 		 const char *power_name,
 		 const char *gnd_name,
                  CircuitSim ckt_sim,
+                 const SpiceSubckts *subckts,
 		 const StaState *sta);
   void writeSpice();
 
@@ -163,10 +168,68 @@ writePathSpice(Path *path,
     sta->report()->error(1600, "No liberty libraries found,");
   WritePathSpice writer(path, spice_filename, subckt_filename,
                         lib_subckt_filename, model_filename,
-                        power_name, gnd_name, ckt_sim, sta);
+                        power_name, gnd_name, ckt_sim, nullptr, sta);
   writer.writeSpice();
 }
 
+void
+writePathSpices(PathEndSeq *path_ends,
+                const char *spice_directory,
+                const char *lib_subckt_filename,
+                const char *model_filename,
+                const char *power_name,
+                const char *gnd_name,
+                CircuitSim ckt_sim,
+                StaState *sta)
+{
+  if (sta->network()->defaultLibertyLibrary() == nullptr)
+    sta->report()->error(1660, "No liberty libraries found,");
+  SpiceSubckts subckts(lib_subckt_filename);
+  size_t path_count = path_ends->size();
+  std::vector<string> spice_filenames(path_count);
+  std::vector<string> subckt_filenames(path_count);
+  for (size_t i = 0; i < path_count; i++) {
+    string path_name = stdstrPrint("%s/path_%zu", spice_directory, i + 1);
+    spice_filenames[i] = path_name + ".sp";
+    subckt_filenames[i] = path_name + ".subckt";
+  }
+  auto write_path = [&] (size_t i) {
+    WritePathSpice writer((*path_ends)[i]->path(),
+                          spice_filenames[i].c_str(),
+                          subckt_filenames[i].c_str(),
+                          lib_subckt_filename, model_filename,
+                          power_name, gnd_name, ckt_sim, &subckts, sta);
+    writer.writeSpice();
+  };
+  DispatchQueue *dispatch_queue = sta->dispatchQueue();
+  if (dispatch_queue == nullptr
+      || sta->threadCount() <= 1
+      || path_count < 2) {
+    for (size_t i = 0; i < path_count; i++)
+      write_path(i);
+  }
+  else {
+    // Exceptions cannot leave the dispatch threads, so rethrow the
+    // first one after the decks are written.
+    std::vector<std::exception_ptr> exceptions(path_count);
+    for (size_t i = 0; i < path_count; i++) {
+      dispatch_queue->dispatch([&, i] (int) {
+        try {
+          write_path(i);
+        }
+        catch (...) {
+          exceptions[i] = std::current_exception();
+        }
+      });
+    }
+    dispatch_queue->finishTasks();
+    for (std::exception_ptr &exception : exceptions) {
+      if (exception)
+        std::rethrow_exception(exception);
+    }
+  }
+}
+
 WritePathSpice::WritePathSpice(Path *path,
                                const char *spice_filename,
 			       const char *subckt_filename,
@@ -175,9 +238,10 @@ WritePathSpice::WritePathSpice(Path *path,
 			       const char *power_name,
 			       const char *gnd_name,
                                CircuitSim ckt_sim,
+                               const SpiceSubckts *subckts,
 			       const StaState *sta) :
   WriteSpice(spice_filename, subckt_filename, lib_subckt_filename,
-             model_filename, power_name, gnd_name, ckt_sim, sta),
+             model_filename, power_name, gnd_name, ckt_sim, subckts, sta),
   path_(path),
   path_expanded_(sta),
   clk_cycle_count_(3)
@@ -16,6 +16,8 @@
 
 #include "WriteSpice.hh"
 
+#include <algorithm>
+
 #include "Debug.hh"
 #include "Units.hh"
 #include "TableModel.hh"
@@ -77,6 +79,7 @@ WriteSpice::WriteSpice(const char *spice_filename,
                        const char *power_name,
                        const char *gnd_name,
                        CircuitSim ckt_sim,
+                       const SpiceSubckts *subckts,
                        const StaState *sta) :
   StaState(sta),
   spice_filename_(spice_filename),
@@ -86,6 +89,7 @@ WriteSpice::WriteSpice(const char *spice_filename,
   power_name_(power_name),
   gnd_name_(gnd_name),
   ckt_sim_(ckt_sim),
+  subckts_(subckts),
   default_library_(network_->defaultLibertyLibrary()),
   short_ckt_resistance_(.0001),
   cap_index_(1),
@@ -193,6 +197,10 @@ WriteSpice::writeGnuplotFile(StdStringSeq &node_nanes)
 void
 WriteSpice::writeSubckts(StdStringSet &cell_names)
 {
+  if (subckts_) {
+    writeSharedSubckts(cell_names);
+    return;
+  }
   findCellSubckts(cell_names);
   ifstream lib_subckts_stream(lib_subckt_filename_);
   if (lib_subckts_stream.is_open()) {
@@ -226,17 +234,7 @@ WriteSpice::writeSubckts(StdStringSet &cell_names)
       }
       subckts_stream.close();
       lib_subckts_stream.close();
-
-      if (!cell_names.empty()) {
-	string missing_cells;
-        for (const string &cell_name : cell_names) {
-	  missing_cells += "\n";
-	  missing_cells += cell_name;
-        }
-	report_->error(1605, "The subkct file %s is missing definitions for %s",
-		       lib_subckt_filename_,
-                       missing_cells.c_str());
-      }
+      reportMissingSubckts(cell_names);
     }
     else {
       lib_subckts_stream.close();
@@ -247,9 +245,67 @@ WriteSpice::writeSubckts(StdStringSet &cell_names)
     throw FileNotReadable(lib_subckt_filename_);
 }
 
+// Write the subckts of cell_names from the shared library subckts
+// in library file order.
+void
+WriteSpice::writeSharedSubckts(StdStringSet &cell_names)
+{
+  // Subckts can call subckts (asap7).
+  std::vector<const SpiceSubckt*> subckts;
+  StdStringSeq pending(cell_names.begin(), cell_names.end());
+  while (!pending.empty()) {
+    string cell_name = pending.back();
+    pending.pop_back();
+    const SpiceSubckt *subckt = subckts_->findSubckt(cell_name);
+    if (subckt) {
+      subckts.push_back(subckt);
+      for (const string &subckt_cell : subckt->subckt_cells) {
+        if (cell_names.insert(subckt_cell).second)
+          pending.push_back(subckt_cell);
+      }
+    }
+  }
+  sort(subckts.begin(), subckts.end(),
+       [] (const SpiceSubckt *subckt1,
+           const SpiceSubckt *subckt2) {
+         return subckt1->index < subckt2->index;
+       });
+
+  ofstream subckts_stream(subckt_filename_);
+  if (subckts_stream.is_open()) {
+    for (const SpiceSubckt *subckt : subckts) {
+      const char *cell_name = subckt->tokens[1].c_str();
+      if (!subckt->has_ends)
+        throw SubcktEndsMissing(cell_name, lib_subckt_filename_);
+      subckts_stream << subckt->text;
+      recordSpicePortNames(cell_name, subckt->tokens);
+      cell_names.erase(subckt->tokens[1]);
+    }
+    subckts_stream.close();
+    reportMissingSubckts(cell_names);
+  }
+  else
+    throw FileNotWritable(subckt_filename_);
+}
+
+void
+WriteSpice::reportMissingSubckts(const StdStringSet &cell_names)
+{
+  if (!cell_names.empty()) {
+    string missing_cells;
+    for (const string &cell_name : cell_names) {
+      missing_cells += "\n";
+      missing_cells += cell_name;
+    }
+    report_->error(1605, "The subkct file %s is missing definitions for %s",
+                   lib_subckt_filename_,
+                   missing_cells.c_str());
+  }
+}
+
 void
 WriteSpice::recordSpicePortNames(const char *cell_name,
-                                 StringVector &tokens)
+                                 const StringVector &tokens)
 {
   LibertyCell *cell = network_->findLibertyCell(cell_name);
   if (cell) {
@@ -311,6 +367,71 @@ WriteSpice::findCellSubckts(StdStringSet &cell_names)
 
 ////////////////////////////////////////////////////////////////
 
+SpiceSubckts::SpiceSubckts(const char *lib_subckt_filename) :
+  filename_(lib_subckt_filename)
+{
+  ifstream lib_subckts_stream(lib_subckt_filename);
+  if (lib_subckts_stream.is_open()) {
+    size_t index = 0;
+    string line;
+    while (getline(lib_subckts_stream, line)) {
+      // .subckt <cell_name> [args..]
+      StringVector tokens;
+      split(line, " \t", tokens);
+      if (tokens.size() >= 2
+          && stringEqual(tokens[0].c_str(), ".subckt")) {
+        // The first definition of a cell is used.
+        auto insert = subckts_.emplace(tokens[1], SpiceSubckt());
+        SpiceSubckt *subckt = insert.second ? &insert.first->second : nullptr;
+        SpiceSubckt ignored;
+        if (subckt == nullptr)
+          subckt = &ignored;
+        subckt->index = index++;
+        subckt->tokens = tokens;
+        subckt->text = line + "\n";
+        subckt->has_ends = false;
+        // Scan the subckt definition for subckt calls.
+        string stmt;
+        while (getline(lib_subckts_stream, line)) {
+          subckt->text += line;
+          subckt->text += "\n";
+          if (line[0] == '+')
+            stmt += line.substr(1);
+          else {
+            // Process previous statement.
+            if (tolower(stmt[0]) == 'x') {
+              StringVector stmt_tokens;
+              split(stmt, " \t", stmt_tokens);
+              if (!stmt_tokens.empty())
+                subckt->subckt_cells.push_back(stmt_tokens.back());
+            }
+            stmt = line;
+          }
+          if (stringBeginEqual(line.c_str(), ".ends")) {
+            subckt->text += "\n";
+            subckt->has_ends = true;
+            break;
+          }
+        }
+      }
+    }
+  }
+  else
+    throw FileNotReadable(lib_subckt_filename);
+}
+
+const SpiceSubckt *
+SpiceSubckts::findSubckt(const string &cell_name) const
+{
+  auto itr = subckts_.find(cell_name);
+  if (itr == subckts_.end())
+    return nullptr;
+  else
+    return &itr->second;
+}
+
+////////////////////////////////////////////////////////////////
+
 void
 WriteSpice::writeSubcktInst(const Pin *input_pin)
 {
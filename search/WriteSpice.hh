@@ -39,6 +39,36 @@ typedef Map<string, StringVector> CellSpicePortNames;
 typedef Map<const LibertyPort*, LogicValue> LibertyPortLogicValues;
 typedef std::vector<string> StdStringSeq;
 
+// Cell subckt definition in a library subckt file.
+class SpiceSubckt
+{
+public:
+  // Definition order in the file.
+  size_t index;
+  // .subckt statement tokens.
+  StringVector tokens;
+  // Definition text from the .subckt statement through .ends.
+  string text;
+  bool has_ends;
+  // Cells of the subckts instanced by the definition.
+  StdStringSeq subckt_cells;
+};
+
+// Library subckt file definitions read once so the decks for many
+// paths can share them.
+class SpiceSubckts
+{
+public:
+  // Throws FileNotReadable.
+  SpiceSubckts(const char *lib_subckt_filename);
+  const char *filename() const { return filename_.c_str(); }
+  const SpiceSubckt *findSubckt(const string &cell_name) const;
+
+private:
+  string filename_;
+  std::map<string, SpiceSubckt> subckts_;
+};
+
 // Utilities for writing a spice deck.
 class WriteSpice : public StaState
 {
@@ -50,6 +80,8 @@ public:
              const char *power_name,
              const char *gnd_name,
              CircuitSim ckt_sim,
+             // Shared library subckts or nullptr to read lib_subckt_filename.
+             const SpiceSubckts *subckts,
              const StaState *sta);
 
 protected:
@@ -60,9 +92,11 @@ protected:
   void writePrintStmt(StdStringSeq &node_names);
   void writeGnuplotFile(StdStringSeq &node_nanes);
   void writeSubckts(StdStringSet &cell_names);
+  void writeSharedSubckts(StdStringSet &cell_names);
+  void reportMissingSubckts(const StdStringSet &cell_names);
   void findCellSubckts(StdStringSet &cell_names);
   void recordSpicePortNames(const char *cell_name,
-			    StringVector &tokens);
+			    const StringVector &tokens);
   void writeSubcktInst(const Pin *input_pin);
   void writeSubcktInstVoltSrcs(const Pin *input_pin,
 			       LibertyPortLogicValues &port_values,
@@ -164,6 +198,7 @@ protected:
   const char *power_name_;
   const char *gnd_name_;
   CircuitSim ckt_sim_;
+  const SpiceSubckts *subckts_;
 
   ofstream spice_stream_;
   LibertyLibrary *default_library_;
@@ -0,0 +1,387 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "WriteTimingContext.hh"
+
+#include <cstdio>
+#include <map>
+#include <set>
+#include <tuple>
+
+#include "Error.hh"
+#include "Units.hh"
+#include "Transition.hh"
+#include "MinMax.hh"
+#include "Liberty.hh"
+#include "PortDirection.hh"
+#include "Network.hh"
+#include "Graph.hh"
+#include "Clock.hh"
+#include "Sdc.hh"
+#include "Corner.hh"
+#include "DcalcAnalysisPt.hh"
+#include "PathVertex.hh"
+#include "Search.hh"
+
+namespace sta {
+
+// Boundary value for a clock edge, pin transition and min/max.
+class ContextValue
+{
+public:
+  const ClockEdge *clk_edge_;
+  float value_;
+};
+
+// Key is clock edge index, pin rise/fall index, min/max index so values
+// are written in a stable order.
+typedef std::tuple<int, int, int> ContextKey;
+typedef std::map<ContextKey, ContextValue> ContextValueMap;
+
+class TimingContextWriter : public StaState
+{
+public:
+  TimingContextWriter(const Instance *inst,
+                      const char *filename,
+                      int digits,
+                      StaState *sta);
+  ~TimingContextWriter();
+  void write();
+
+private:
+  void findBoundary();
+  void findInput(const Pin *hpin);
+  void findOutput(const Pin *hpin);
+  void writeClocks();
+  void writeInputs();
+  void writeOutputs();
+  void writeWaveform(const Clock *clk);
+  static void setWorst(ContextValueMap &values,
+                       const ClockEdge *clk_edge,
+                       const RiseFall *rf,
+                       const MinMax *min_max,
+                       float value);
+  const char *time(float value);
+  const char *portName(const Pin *hpin);
+
+  const Instance *inst_;
+  const char *filename_;
+  int digits_;
+  FILE *stream_;
+  char time_buffer_[64];
+
+  // Boundary pins in port order.
+  PinSeq clk_pins_;
+  PinSeq input_pins_;
+  PinSeq output_pins_;
+  std::map<const Pin*, ContextValueMap> clk_latencies_;
+  std::map<const Pin*, ContextValueMap> input_delays_;
+  std::map<const Pin*, ContextValueMap> output_delays_;
+  // Input transitions indexed by [pin][rf][min_max].
+  std::map<const Pin*, std::map<std::tuple<int, int>, float>> input_slews_;
+  std::map<const Pin*, float> output_loads_;
+  std::set<const Clock*> port_clks_;
+};
+
+void
+writeTimingContext(const Instance *inst,
+                   const char *filename,
+                   int digits,
+                   StaState *sta)
+{
+  TimingContextWriter writer(inst, filename, digits, sta);
+  writer.write();
+}
+
+TimingContextWriter::TimingContextWriter(const Instance *inst,
+                                         const char *filename,
+                                         int digits,
+                                         StaState *sta) :
+  StaState(sta),
+  inst_(inst),
+  filename_(filename),
+  digits_(digits),
+  stream_(nullptr)
+{
+}
+
+TimingContextWriter::~TimingContextWriter()
+{
+  if (stream_)
+    fclose(stream_);
+}
+
+void
+TimingContextWriter::write()
+{
+  findBoundary();
+  stream_ = fopen(filename_, "w");
+  if (stream_ == nullptr)
+    throw FileNotWritable(filename_);
+  fprintf(stream_, "# Timing context for %s\n",
+          network_->pathName(inst_));
+  writeClocks();
+  writeInputs();
+  writeOutputs();
+}
+
+void
+TimingContextWriter::findBoundary()
+{
+  InstancePinIterator *pin_iter = network_->pinIterator(inst_);
+  while (pin_iter->hasNext()) {
+    const Pin *hpin = pin_iter->next();
+    PortDirection *dir = network_->direction(hpin);
+    if (dir->isInput())
+      findInput(hpin);
+    else if (dir->isOutput() || dir->isTristate())
+      findOutput(hpin);
+  }
+  delete pin_iter;
+}
+
+// Arrivals and slews at the drivers outside of the instance.
+void
+TimingContextWriter::findInput(const Pin *hpin)
+{
+  PinSet *drvrs = network_->drivers(hpin);
+  if (drvrs == nullptr)
+    return;
+  bool is_clk = false;
+  ContextValueMap &delays = input_delays_[hpin];
+  ContextValueMap &latencies = clk_latencies_[hpin];
+  for (const Pin *drvr : *drvrs) {
+    if (network_->isInside(drvr, inst_))
+      continue;
+    Vertex *vertex = graph_->pinDrvrVertex(drvr);
+    if (vertex == nullptr)
+      continue;
+    VertexPathIterator path_iter(vertex, this);
+    while (path_iter.hasNext()) {
+      PathVertex *path = path_iter.next();
+      const ClockEdge *clk_edge = path->clkEdge(this);
+      if (clk_edge) {
+        const MinMax *min_max = path->minMax(this);
+        float arrival = delayAsFloat(path->arrival(this));
+        float delay = arrival - clk_edge->time();
+        if (path->isClock(this)) {
+          is_clk = true;
+          port_clks_.insert(clk_edge->clock());
+          setWorst(latencies, clk_edge, clk_edge->transition(), min_max, delay);
+        }
+        else
+          setWorst(delays, clk_edge, path->transition(this), min_max, delay);
+      }
+    }
+    for (const RiseFall *rf : RiseFall::range()) {
+      for (const DcalcAnalysisPt *dcalc_ap : corners_->dcalcAnalysisPts()) {
+        const MinMax *min_max = dcalc_ap->slewMinMax();
+        float slew = delayAsFloat(graph_->slew(vertex, rf, dcalc_ap->index()));
+        std::tuple<int, int> key(rf->index(), min_max->index());
+        auto &slews = input_slews_[hpin];
+        auto slew_itr = slews.find(key);
+        if (slew_itr == slews.end()
+            || min_max->compare(slew, slew_itr->second))
+          slews[key] = slew;
+      }
+    }
+  }
+  if (is_clk)
+    clk_pins_.push_back(hpin);
+  input_pins_.push_back(hpin);
+}
+
+// Required times and capacitance of the loads outside of the instance.
+void
+TimingContextWriter::findOutput(const Pin *hpin)
+{
+  ContextValueMap &delays = output_delays_[hpin];
+  float load_cap = 0.0;
+  PinConnectedPinIterator *pin_iter = network_->connectedPinIterator(hpin);
+  while (pin_iter->hasNext()) {
+    const Pin *load = pin_iter->next();
+    if (network_->isHierarchical(load)
+        || !network_->isLoad(load)
+        || network_->isInside(load, inst_))
+      continue;
+    LibertyPort *load_port = network_->libertyPort(load);
+    if (load_port)
+      load_cap += load_port->capacitance();
+    Vertex *vertex = graph_->pinLoadVertex(load);
+    if (vertex == nullptr)
+      continue;
+    VertexPathIterator path_iter(vertex, this);
+    while (path_iter.hasNext()) {
+      PathVertex *path = path_iter.next();
+      const ClockEdge *clk_edge = path->clkEdge(this);
+      if (clk_edge
+          && !path->isClock(this)
+          && !path->requiredIsInitValue(this)) {
+        const MinMax *min_max = path->minMax(this);
+        float required = delayAsFloat(path->required(this));
+        // Setup captures one period after the launch edge and hold
+        // captures at the launch edge.
+        float capture = clk_edge->time();
+        if (min_max == MinMax::max())
+          capture += clk_edge->clock()->period();
+        float delay = capture - required;
+        setWorst(delays, clk_edge, path->transition(this), min_max, delay);
+      }
+    }
+  }
+  delete pin_iter;
+  output_loads_[hpin] = load_cap;
+  output_pins_.push_back(hpin);
+}
+
+// Max values keep the largest and min values the smallest.
+void
+TimingContextWriter::setWorst(ContextValueMap &values,
+                              const ClockEdge *clk_edge,
+                              const RiseFall *rf,
+                              const MinMax *min_max,
+                              float value)
+{
+  ContextKey key(clk_edge->index(), rf->index(), min_max->index());
+  auto value_itr = values.find(key);
+  if (value_itr == values.end())
+    values[key] = ContextValue{clk_edge, value};
+  else if (min_max->compare(value, value_itr->second.value_))
+    value_itr->second.value_ = value;
+}
+
+void
+TimingContextWriter::writeClocks()
+{
+  std::set<const Clock*> written;
+  for (const Pin *hpin : clk_pins_) {
+    for (auto &key_value : clk_latencies_[hpin]) {
+      const Clock *clk = key_value.second.clk_edge_->clock();
+      if (written.find(clk) == written.end()) {
+        written.insert(clk);
+        fprintf(stream_, "create_clock -name {%s} -period %s",
+                clk->name(),
+                time(clk->period()));
+        writeWaveform(clk);
+        fprintf(stream_, " -add [get_ports {%s}]\n", portName(hpin));
+      }
+    }
+  }
+  // Clocks that do not enter the instance launch or capture at its
+  // ports from outside.
+  for (const Clock *clk : *sdc_->clocks()) {
+    if (port_clks_.find(clk) == port_clks_.end()) {
+      fprintf(stream_, "create_clock -name {%s} -period %s",
+              clk->name(),
+              time(clk->period()));
+      writeWaveform(clk);
+      fprintf(stream_, "\n");
+    }
+  }
+  for (const Pin *hpin : clk_pins_) {
+    for (auto &key_value : clk_latencies_[hpin]) {
+      const ClockEdge *clk_edge = key_value.second.clk_edge_;
+      int mm_index = std::get<2>(key_value.first);
+      fprintf(stream_, "set_clock_latency -source -%s -%s %s [get_clocks {%s}]\n",
+              clk_edge->transition()->name(),
+              MinMax::find(mm_index)->asString(),
+              time(key_value.second.value_),
+              clk_edge->clock()->name());
+    }
+  }
+}
+
+void
+TimingContextWriter::writeWaveform(const Clock *clk)
+{
+  fprintf(stream_, " -waveform {");
+  bool first = true;
+  for (float edge : *clk->waveform()) {
+    fprintf(stream_, "%s%s", first ? "" : " ", time(edge));
+    first = false;
+  }
+  fprintf(stream_, "}");
+}
+
+void
+TimingContextWriter::writeInputs()
+{
+  for (const Pin *hpin : input_pins_) {
+    for (auto &key_value : input_delays_[hpin]) {
+      const ClockEdge *clk_edge = key_value.second.clk_edge_;
+      const RiseFall *rf = RiseFall::find(std::get<1>(key_value.first));
+      const MinMax *min_max = MinMax::find(std::get<2>(key_value.first));
+      fprintf(stream_, "set_input_delay -clock {%s}%s -%s -%s -add_delay %s [get_ports {%s}]\n",
+              clk_edge->clock()->name(),
+              clk_edge->transition() == RiseFall::fall() ? " -clock_fall" : "",
+              rf->name(),
+              min_max->asString(),
+              time(key_value.second.value_),
+              portName(hpin));
+    }
+    for (auto &key_slew : input_slews_[hpin]) {
+      const RiseFall *rf = RiseFall::find(std::get<0>(key_slew.first));
+      const MinMax *min_max = MinMax::find(std::get<1>(key_slew.first));
+      fprintf(stream_, "set_input_transition -%s -%s %s [get_ports {%s}]\n",
+              rf->name(),
+              min_max->asString(),
+              time(key_slew.second),
+              portName(hpin));
+    }
+  }
+}
+
+void
+TimingContextWriter::writeOutputs()
+{
+  const Unit *cap_unit = units_->capacitanceUnit();
+  for (const Pin *hpin : output_pins_) {
+    for (auto &key_value : output_delays_[hpin]) {
+      const ClockEdge *clk_edge = key_value.second.clk_edge_;
+      const RiseFall *rf = RiseFall::find(std::get<1>(key_value.first));
+      const MinMax *min_max = MinMax::find(std::get<2>(key_value.first));
+      fprintf(stream_, "set_output_delay -clock {%s}%s -%s -%s -add_delay %s [get_ports {%s}]\n",
+              clk_edge->clock()->name(),
+              clk_edge->transition() == RiseFall::fall() ? " -clock_fall" : "",
+              rf->name(),
+              min_max->asString(),
+              time(key_value.second.value_),
+              portName(hpin));
+    }
+    float load_cap = output_loads_[hpin];
+    if (load_cap > 0.0)
+      fprintf(stream_, "set_load %.*f [get_ports {%s}]\n",
+              digits_,
+              load_cap / cap_unit->scale(),
+              portName(hpin));
+  }
+}
+
+const char *
+TimingContextWriter::time(float value)
+{
+  snprintf(time_buffer_, sizeof(time_buffer_), "%.*f",
+           digits_, value / units_->timeUnit()->scale());
+  return time_buffer_;
+}
+
+const char *
+TimingContextWriter::portName(const Pin *hpin)
+{
+  return network_->portName(hpin);
+}
+
+} // namespace
@@ -0,0 +1,41 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "NetworkClass.hh"
+
+namespace sta {
+
+class StaState;
+
+// Write SDC that times the hierarchical instance inst as a separate
+// design with the boundary conditions of the current timing: clocks
+// with the source latency at the clock ports, input delays and
+// transitions from the arrivals and slews of the drivers outside inst,
+// and output delays and loads from the required times and pins of the
+// loads outside inst. Output delays assume single cycle paths from
+// the launching clock edge.
+// Partitions timed in separate processes exchange the boundary
+// arrivals and requireds by rewriting their contexts and timing again.
+// Throws FileNotWritable.
+void
+writeTimingContext(const Instance *inst,
+                   const char *filename,
+                   int digits,
+                   StaState *sta);
+
+} // namespace
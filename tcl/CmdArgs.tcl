@@ -292,6 +292,12 @@ proc parse_cell_arg { objects } {
   return $cells
 }
 
+proc parse_net_arg { objects } {
+  set nets {}
+  get_object_args $objects {} {} {} {} {} {} {} nets {} {}
+  return $nets
+}
+
 proc parse_cell_port_args { objects cells_var ports_var } {
   upvar 1 $cells_var cells
   upvar 1 $ports_var ports
@@ -27,6 +27,8 @@ define_cmd_args "help" {[pattern]}
 proc_redirect help {
   variable cmd_args
 
+  # Define the args of the commands that have not been loaded yet.
+  load_lazy_tcl_inits
   set arg_count [llength $args]
   if { $arg_count == 0 } {
     set pattern "*"
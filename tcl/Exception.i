@@ -15,7 +15,10 @@
 // along with this program. If not, see <https://www.gnu.org/licenses/>.
 
 %exception {
-  try { $function }
+  try {
+    cmdCancelTimingUpdate("$symname");
+    $function
+  }
   catch (std::bad_alloc &) {
     fprintf(stderr, "Error: out of memory.\n");
     exit(1);
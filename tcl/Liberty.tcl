@@ -19,18 +19,49 @@
 namespace eval sta {
 
 define_cmd_args "read_liberty" \
-  {[-corner corner] [-min] [-max] [-infer_latches] filename}
+  {[-corner corner] [-min] [-max] [-infer_latches] filenames}
 
 proc_redirect read_liberty {
   parse_key_args "read_liberty" args keys {-corner} \
     flags {-min -max -infer_latches}
-  check_argc_eq1 "read_liberty" $args
+  check_argc_ge1 "read_liberty" $args
+
+  set filenames {}
+  foreach filename $args {
+    lappend filenames [file nativename $filename]
+  }
+  set corner [parse_corner keys]
+  set min_max [parse_min_max_all_flags flags]
+  set infer_latches [info exists flags(-infer_latches)]
+  if { [llength $filenames] == 1 } {
+    read_liberty_cmd [lindex $filenames 0] $corner $min_max $infer_latches
+  } else {
+    # Multiple files are read with worker threads.
+    read_liberty_files_cmd $filenames $corner $min_max $infer_latches
+  }
+}
+
+define_cmd_args "write_liberty_db" {liberty_filename filename}
+
+proc write_liberty_db { args } {
+  check_argc_eq2 "write_liberty_db" $args
+  write_liberty_db_cmd [file nativename [lindex $args 0]] \
+    [file nativename [lindex $args 1]]
+}
+
+define_cmd_args "read_liberty_db" \
+  {[-corner corner] [-min] [-max] [-infer_latches] filename}
+
+proc_redirect read_liberty_db {
+  parse_key_args "read_liberty_db" args keys {-corner} \
+    flags {-min -max -infer_latches}
+  check_argc_eq1 "read_liberty_db" $args
 
   set filename [file nativename [lindex $args 0]]
   set corner [parse_corner keys]
   set min_max [parse_min_max_all_flags flags]
   set infer_latches [info exists flags(-infer_latches)]
-  read_liberty_cmd $filename $corner $min_max $infer_latches
+  read_liberty_db_cmd $filename $corner $min_max $infer_latches
 }
 
 # for regression testing
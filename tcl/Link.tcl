@@ -40,5 +40,19 @@ proc_redirect link_design {
   link_design_cmd $top_cell_name
 }
 
+define_cmd_args "write_netlist_db" {filename}
+
+proc write_netlist_db { args } {
+  check_argc_eq1 "write_netlist_db" $args
+  write_netlist_db_cmd [file nativename [lindex $args 0]]
+}
+
+define_cmd_args "read_netlist_db" {filename}
+
+proc read_netlist_db { args } {
+  check_argc_eq1 "read_netlist_db" $args
+  return [read_netlist_db_cmd [file nativename [lindex $args 0]]]
+}
+
 # sta namespace end
 }
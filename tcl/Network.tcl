@@ -34,7 +34,7 @@ proc_redirect report_instance {
   set instance_path [lindex $args 0]
   set instance [find_instance $instance_path]
   if { $instance != "NULL" } {
-    report_instance1 $instance
+    report_buffered { report_instance1 $instance }
   } else {
     sta_error 230 "instance $instance_path not found."
   }
@@ -201,13 +201,13 @@ proc_redirect report_net {
   set net_path [lindex $args 0]
   set net [find_net $net_path]
   if { $net != "NULL" } {
-    report_net1 $net $corner $digits
+    report_buffered { report_net1 $net $corner $digits }
   } else {
     set pin [find_pin $net_path]
     if { $pin != "NULL" } {
       set net [$pin net]
       if { $net != "NULL" } {
-	report_net1 $net $corner $digits
+	report_buffered { report_net1 $net $corner $digits }
       } else {
 	sta_error 231 "net $net_path not found."
       }
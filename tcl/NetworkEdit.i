@@ -64,13 +64,39 @@ replace_cell_cmd(Instance *inst,
   Sta::sta()->replaceCell(inst, to_cell);
 }
 
+// Replace the cell of each instance with cells[i], or cells[0] if
+// there is one cell. Instances that are not liberty instances or
+// whose cell ports do not match are skipped.
+// Return the number of instances replaced.
+int
+replace_cells_cmd(InstanceSeq *insts,
+		  LibertyCellSeq *cells)
+{
+  int count = 0;
+  if (insts && cells) {
+    Sta *sta = Sta::sta();
+    Network *network = sta->network();
+    for (size_t i = 0; i < insts->size(); i++) {
+      Instance *inst = const_cast<Instance*>((*insts)[i]);
+      LibertyCell *to_cell = (cells->size() == 1) ? (*cells)[0] : (*cells)[i];
+      LibertyCell *inst_cell = network->libertyCell(inst);
+      if (inst_cell
+	  && equivCellPorts(inst_cell, to_cell)) {
+	sta->replaceCell(inst, to_cell);
+	count++;
+      }
+    }
+  }
+  delete insts;
+  delete cells;
+  return count;
+}
+
 Net *
 make_net_cmd(const char *name,
 	     Instance *parent)
 {
-  Net *net = cmdEditNetwork()->makeNet(name, parent);
-  // Sta notification unnecessary.
-  return net;
+  return Sta::sta()->makeNet(name, parent);
 }
 
 void
@@ -100,6 +126,48 @@ disconnect_pin_cmd(Pin *pin)
   Sta::sta()->disconnectPin(pin);
 }
 
+void
+what_if_begin()
+{
+  Sta::sta()->whatIfBegin();
+}
+
+void
+what_if_commit()
+{
+  Sta::sta()->whatIfCommit();
+}
+
+void
+what_if_discard()
+{
+  Sta::sta()->whatIfDiscard();
+}
+
+bool
+what_if_active()
+{
+  return Sta::sta()->whatIfActive();
+}
+
+void
+netlist_edit_begin()
+{
+  Sta::sta()->netlistEditBegin();
+}
+
+void
+netlist_edit_end()
+{
+  Sta::sta()->netlistEditEnd();
+}
+
+bool
+netlist_edit_active()
+{
+  return Sta::sta()->netlistEditActive();
+}
+
 // Notify STA of network change.
 void
 network_changed()
@@ -251,6 +251,62 @@ proc replace_cell { instance lib_cell } {
   }
 }
 
+define_cmd_args "replace_cell_batch" {instances lib_cells}
+
+# Replace the cells of a list of instances with one lib cell or one lib
+# cell per instance. Instances with cells that do not have equivalent
+# ports are skipped. Returns the number of instances replaced.
+proc replace_cell_batch { instances lib_cells } {
+  set insts [get_instances_error "instances" $instances]
+  set cells {}
+  foreach lib_cell $lib_cells {
+    set cell [get_lib_cell_warn "lib_cell" $lib_cell]
+    if { $cell == "NULL" } {
+      return 0
+    }
+    lappend cells $cell
+  }
+  check_batch_values "replace_cell_batch" "lib_cells" $cells [llength $insts]
+  return [replace_cells_cmd $insts $cells]
+}
+
+################################################################
+
+define_cmd_args "begin_what_if" {}
+
+proc begin_what_if { args } {
+  check_argc_eq0 "begin_what_if" $args
+  what_if_begin
+}
+
+define_cmd_args "end_what_if" {[-commit]}
+
+proc end_what_if { args } {
+  parse_key_args "end_what_if" args keys {} flags {-commit}
+  check_argc_eq0 "end_what_if" $args
+  if { [info exists flags(-commit)] } {
+    what_if_commit
+  } else {
+    what_if_discard
+  }
+}
+
+################################################################
+
+define_cmd_args "begin_netlist_edit" {}
+
+proc begin_netlist_edit { args } {
+  check_argc_eq0 "begin_netlist_edit" $args
+  netlist_edit_begin
+}
+
+define_cmd_args "end_netlist_edit" {}
+
+proc end_netlist_edit { args } {
+  check_argc_eq0 "end_netlist_edit" $args
+  netlist_edit_end
+}
+
 ################################################################
 
 proc path_regexp {} {
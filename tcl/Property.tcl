@@ -23,6 +23,17 @@ proc get_property { args } {
   return [get_property_cmd "get_property" "-object_type" $args]
 }
 
+define_cmd_args "get_property_batch" {objects property}
+
+# Timing properties (arrival_*, slack_*, slew_*) of a pin/port
+# collection as a list of floats in the same order as the objects.
+proc get_property_batch { args } {
+  check_argc_eq2 "get_property_batch" $args
+  set pins [get_port_pins_error "objects" [lindex $args 0]]
+  set prop [lindex $args 1]
+  return [pin_property_floats $pins $prop]
+}
+
 proc get_property_cmd { cmd type_key cmd_args } {
   parse_key_args $cmd cmd_args keys $type_key flags {-quiet}
   set quiet [info exists flags(-quiet)]
@@ -34,7 +34,50 @@ proc_redirect read_sdc {
   check_argc_eq1 "read_sdc" $args
   set echo [info exists flags(-echo)]
   set filename [file nativename [lindex $args 0]]
-  source_ $filename $echo 0
+  global sta_read_sdc_native
+  set native [expr {$sta_read_sdc_native && [sdc_native_cmds_defined]}]
+  sdc_batch_begin
+  set error_code [catch {source_ $filename $echo 0 $native} result]
+  sdc_batch_end
+  if { $error_code } {
+    return -code error -errorinfo $::errorInfo $result
+  }
+}
+
+# Commands evaluated by eval_sdc_cmd_native.
+variable sdc_native_cmds {create_clock set_input_delay set_output_delay \
+			    set_false_path set_multicycle_path set_load \
+			    set_max_transition get_ports get_pins get_cells \
+			    get_nets get_clocks all_inputs all_outputs \
+			    all_clocks}
+
+# The native commands are only used if none of them have been
+# redefined or wrapped.
+proc sdc_native_cmds_defined {} {
+  variable sdc_native_cmds
+  foreach cmd $sdc_native_cmds {
+    if { [catch {namespace origin ::$cmd} origin] \
+	   || $origin != "::sta::$cmd" } {
+      return 0
+    }
+  }
+  return 1
+}
+
+################################################################
+
+define_cmd_args "begin_sdc_batch" {}
+
+proc begin_sdc_batch { args } {
+  check_argc_eq0 "begin_sdc_batch" $args
+  sdc_batch_begin
+}
+
+define_cmd_args "end_sdc_batch" {}
+
+proc end_sdc_batch { args } {
+  check_argc_eq0 "end_sdc_batch" $args
+  sdc_batch_end
 }
 
 ################################################################
@@ -49,6 +92,8 @@ if { ![info exists renamed_source] } {
 }
 
 set ::sta_continue_on_error 0
+# read_sdc evaluates common commands without the Tcl interpreter.
+set ::sta_read_sdc_native 1
 
 define_cmd_args "source" \
   {[-echo] [-verbose] filename [> filename] [>> filename]}
@@ -65,7 +110,7 @@ proc_redirect source {
   source_ $filename $echo $verbose
 }
 
-proc source_ { filename echo verbose } {
+proc source_ { filename echo verbose {native 0} } {
   global sta_continue_on_error
   variable sdc_file
   variable sdc_line
@@ -95,7 +140,19 @@ proc source_ { filename echo verbose } {
       if { [string index $line end] != "\\" \
 	     && [info complete $cmd] } {
 	set error {}
-	set error_code [catch {uplevel \#0 $cmd} result]
+	if { $native } {
+	  set error_code [catch {eval_sdc_cmd_native $cmd $sdc_file $sdc_line} \
+			    result]
+	  if { $error_code == 0 } {
+	    if { $result } {
+	      set result ""
+	    } else {
+	      set error_code [catch {uplevel \#0 $cmd} result]
+	    }
+	  }
+	} else {
+	  set error_code [catch {uplevel \#0 $cmd} result]
+	}
 	# cmd consumed
 	set cmd ""
 	# Flush results printed outside tcl to stdout/stderr.
@@ -2741,9 +2798,7 @@ proc set_case_analysis { value pins } {
     sta_error 451 "value must be 0, zero, 1, one, rise, rising, fall, or falling."
   }
   set pins1 [get_port_pins_error "pins" $pins]
-  foreach pin $pins1 {
-    set_case_analysis_cmd $pin $value
-  }
+  set_case_analysis_pins_cmd $pins1 $value
 }
 
 ################################################################
@@ -2919,7 +2974,6 @@ proc set_input_transition { args } {
   
   set slew [lindex $args 0]
   check_positive_float "transition" $slew
-  set slew [time_ui_sta $slew]
   set ports [get_ports_error "ports" [lindex $args 1]]
   
   if [info exists keys(-clock)] {
@@ -2929,9 +2983,25 @@ proc set_input_transition { args } {
     sta_warn 463 "-clock_fall not supported."
   }
   
-  foreach port $ports {
-    set_input_slew_cmd $port $tr $min_max $slew
-  }
+  set_input_slews_cmd $ports $slew $tr $min_max
+}
+
+define_cmd_args "set_input_transition_batch" \
+  {[-rise] [-fall] [-max] [-min] transitions ports}
+
+# set_input_transition with one transition per port.
+proc set_input_transition_batch { args } {
+  parse_key_args "set_input_transition_batch" args keys {} \
+    flags {-rise -fall -max -min}
+  check_argc_eq2 "set_input_transition_batch" $args
+
+  set rf [parse_rise_fall_flags flags]
+  set min_max [parse_min_max_all_flags flags]
+  set slews [lindex $args 0]
+  set ports [get_ports_error "ports" [lindex $args 1]]
+  check_batch_values "set_input_transition_batch" "transitions" \
+    $slews [llength $ports]
+  set_input_slews_cmd $ports $slews $rf $min_max
 }
 
 ################################################################
@@ -2959,19 +3029,15 @@ proc set_load { args } {
   
   set cap [lindex $args 0]
   check_positive_float "capacitance" $cap
-  set cap [capacitance_ui_sta $cap]
   parse_port_net_args [lindex $args 1] ports nets
   
   if { $ports != {} } {
     # -pin_load is the default.
     if { $pin_load || (!$pin_load && !$wire_load) } {
-      foreach port $ports {
-	set_port_ext_pin_cap $port $rf $corner $min_max $cap
-      }
+      set_port_ext_pin_caps $ports $cap $rf $corner $min_max
     } elseif { $wire_load } {
-      foreach port $ports {
-	set_port_ext_wire_cap $port $subtract_pin_load $rf $corner $min_max $cap
-      }
+      set_port_ext_wire_caps $ports $cap $subtract_pin_load \
+	$rf $corner $min_max
     }
   }
   if { $nets != {} } {
@@ -2984,10 +3050,52 @@ proc set_load { args } {
     if { $rf != "rise_fall" } {
       sta_warn 466 "-rise/-fall not allowed for net objects."
     }
-    foreach net $nets {
-      set_net_wire_cap $net $subtract_pin_load $corner $min_max $cap
+    set_net_wire_caps $nets $cap $subtract_pin_load \
+      $corner $min_max
+  }
+}
+
+define_cmd_args "set_load_batch" \
+  {[-corner corner] [-rise] [-fall] [-max] [-min] [-subtract_pin_load]\
+     [-pin_load] [-wire_load] capacitances objects}
+
+# set_load with one capacitance per port or net.
+proc set_load_batch { args } {
+  parse_key_args "set_load_batch" args keys {-corner} \
+    flags {-rise -fall -min -max -subtract_pin_load -pin_load -wire_load}
+  check_argc_eq2 "set_load_batch" $args
+
+  set wire_load [info exists flags(-wire_load)]
+  set subtract_pin_load [info exists flags(-subtract_pin_load)]
+  set corner [parse_corner_or_all keys]
+  set min_max [parse_min_max_all_check_flags flags]
+  set rf [parse_rise_fall_flags flags]
+  set caps [lindex $args 0]
+  parse_port_net_args [lindex $args 1] ports nets
+  if { $ports != {} && $nets != {} } {
+    sta_error 483 "set_load_batch objects must be all ports or all nets."
+  }
+  if { $ports != {} } {
+    check_batch_values "set_load_batch" "capacitances" $caps [llength $ports]
+    if { $wire_load } {
+      set_port_ext_wire_caps $ports $caps $subtract_pin_load $rf $corner $min_max
+    } else {
+      set_port_ext_pin_caps $ports $caps $rf $corner $min_max
     }
   }
+  if { $nets != {} } {
+    check_batch_values "set_load_batch" "capacitances" $caps [llength $nets]
+    set_net_wire_caps $nets $caps $subtract_pin_load $corner $min_max
+  }
+}
+
+# Batch command values must be one value for every object or one
+# value per object.
+proc check_batch_values { cmd arg_name values object_count } {
+  set value_count [llength $values]
+  if { $value_count != 1 && $value_count != $object_count } {
+    sta_error 484 "$cmd $arg_name must be one value or one value per object."
+  }
 }
 
 ################################################################
@@ -3002,9 +3110,7 @@ proc set_logic_dc { port_list } {
 # OC only supports them on ports.
 proc set_logic_value { port_list value } {
   set pins [get_port_pins_error "pins" $port_list]
-  foreach pin $pins {
-    set_logic_value_cmd $pin $value
-  }
+  set_logic_values_cmd $pins $value
 }
 
 ################################################################
@@ -3674,6 +3780,34 @@ proc define_corners { args } {
 
 ################################################################
 
+define_cmd_args "define_mode" { mode_name }
+
+# Modes are sets of constraints that share the design, libraries and
+# parasitics. Constraint commands apply to the current mode.
+proc define_mode { mode_name } {
+  define_mode_cmd $mode_name
+}
+
+define_cmd_args "set_current_mode" { mode_name }
+
+proc set_current_mode { mode_name } {
+  set_current_mode_cmd $mode_name
+}
+
+define_cmd_args "get_modes" {}
+
+proc get_modes { } {
+  return [mode_names]
+}
+
+define_cmd_args "delete_mode" { mode_name }
+
+proc delete_mode { mode_name } {
+  delete_mode_cmd $mode_name
+}
+
+################################################################
+
 define_cmd_args "set_pvt"\
   {insts [-min] [-max] [-process process] [-voltage voltage]\
      [-temperature temperature]}
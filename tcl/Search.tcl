@@ -77,9 +77,45 @@ proc check_setup_cmd { cmd cmd_args } {
 
 # Not a command because users have no reason to ever call this.
 # It is only useful for debugging incremental timing updates.
+# With -async the update runs in the background; use
+# timing_update_progress, cancel_timing_update and wait_timing_update
+# to follow it. Other commands cancel the update.
 proc find_timing { args } {
-  parse_key_args "find_timing" args keys {} flags {-full_update}
-  find_timing_cmd [info exists flags(-full_update)]
+  parse_key_args "find_timing" args keys {} flags {-full_update -async}
+  set full [info exists flags(-full_update)]
+  if { [info exists flags(-async)] } {
+    find_timing_async_cmd $full
+  } else {
+    find_timing_cmd $full
+  }
+}
+
+# Return {running levels vertices} for the timing update.
+proc timing_update_progress {} {
+  return [list [timing_update_running] [timing_update_levels] \
+            [timing_update_vertices]]
+}
+
+# Update and freeze timing for concurrent read only queries from other
+# threads (see Sta::freezeTiming). Edits thaw the timing.
+proc freeze_timing {} {
+  freeze_timing_cmd
+}
+
+################################################################
+
+define_cmd_args "write_timing_snapshot" {filename}
+
+proc write_timing_snapshot { args } {
+  check_argc_eq1 "write_timing_snapshot" $args
+  write_timing_snapshot_cmd [file nativename [lindex $args 0]]
+}
+
+define_cmd_args "read_timing_snapshot" {filename}
+
+proc read_timing_snapshot { args } {
+  check_argc_eq1 "read_timing_snapshot" $args
+  return [read_timing_snapshot_cmd [file nativename [lindex $args 0]]]
 }
 
 ################################################################
@@ -356,14 +392,15 @@ proc_redirect report_clock_skew {
 
 define_cmd_args "report_clock_latency" {[-clock clocks]\
                                           [-corner corner]\
-                                          [-include_internal_latency]
+                                          [-include_internal_latency]\
+                                          [-histogram bucket_count]\
                                           [-digits digits]}
 
 proc_redirect report_clock_latency {
   global sta_report_default_digits
 
   parse_key_args "report_clock_" args \
-    keys {-clock -corner -digits} \
+    keys {-clock -corner -histogram -digits} \
     flags {-include_internal_latency}
   check_argc_eq0 "report_clock_latency" $args
 
@@ -381,7 +418,14 @@ proc_redirect report_clock_latency {
     set digits $sta_report_default_digits
   }
   if { $clks != {} } {
-    report_clk_latency $clks $corner $include_internal_latency $digits
+    if [info exists keys(-histogram)] {
+      set bucket_count $keys(-histogram)
+      check_positive_integer "-histogram" $bucket_count
+      report_clk_latency_histogram $clks $corner $include_internal_latency \
+        $bucket_count $digits
+    } else {
+      report_clk_latency $clks $corner $include_internal_latency $digits
+    }
   }
 }
 
@@ -963,6 +1007,39 @@ proc total_negative_slack { args } {
 
 ################################################################
 
+define_hidden_cmd_args "negative_slack_endpoint_count" \
+  {[-corner corner] [-min]|[-max]}
+
+proc negative_slack_endpoint_count { args } {
+  parse_key_args "negative_slack_endpoint_count" args \
+    keys {-corner} flags {-min -max}
+  check_argc_eq0 "negative_slack_endpoint_count" $args
+  set min_max [parse_min_max_flags flags]
+  set corner [parse_corner_or_all keys]
+  return [negative_slack_endpoint_count_cmd $corner $min_max]
+}
+
+################################################################
+
+define_hidden_cmd_args "worst_negative_slack_endpoints" \
+  {[-corner corner] [-min]|[-max] [-count count]}
+
+proc worst_negative_slack_endpoints { args } {
+  parse_key_args "worst_negative_slack_endpoints" args \
+    keys {-corner -count} flags {-min -max}
+  check_argc_eq0 "worst_negative_slack_endpoints" $args
+  set min_max [parse_min_max_flags flags]
+  set corner [parse_corner_or_all keys]
+  set count 1
+  if { [info exists keys(-count)] } {
+    set count $keys(-count)
+    check_positive_integer "-count" $count
+  }
+  return [worst_negative_slack_endpoints_cmd $corner $min_max $count]
+}
+
+################################################################
+
 define_hidden_cmd_args "worst_negative_slack" \
   {[-corner corner] [-min]|[-max]}
 
@@ -1025,11 +1102,12 @@ proc worst_clock_skew { args } {
 define_cmd_args "write_timing_model" {[-corner corner] \
                                         [-library_name lib_name]\
                                         [-cell_name cell_name]\
+                                        [-one_pass]\
                                         filename}
 
 proc write_timing_model { args } {
   parse_key_args "write_timing_model" args \
-    keys {-library_name -cell_name -corner} flags {}
+    keys {-library_name -cell_name -corner} flags {-one_pass}
   check_argc_eq1 "write_timing_model" $args
 
   set filename [file nativename [lindex $args 0]]
@@ -1044,10 +1122,91 @@ proc write_timing_model { args } {
     set lib_name $cell_name
   }
   set corner [parse_corner keys]
-  write_timing_model_cmd $lib_name $cell_name $filename $corner
+  set one_pass [info exists flags(-one_pass)]
+  write_timing_model_cmd $lib_name $cell_name $filename $corner $one_pass
     
 }
 
+################################################################
+
+# Block models are timing models of a block written once and cached by
+# the block name, corner and the contents of the files it was timed
+# from (netlist, parasitics, constraints). Repeated instances of the
+# block are then linked to the model cell instead of timing the block
+# netlist for each instance.
+
+define_cmd_args "write_block_model" {-cache_dir dir -key_files files\
+                                       [-corner corner] [-cell_name cell_name]\
+                                       [-one_pass]}
+
+# Write the timing model of the linked block to the cache if it is not
+# already there. Returns the model liberty file name.
+proc write_block_model { args } {
+  parse_key_args "write_block_model" args \
+    keys {-cache_dir -key_files -corner -cell_name} flags {-one_pass}
+  check_argc_eq0 "write_block_model" $args
+
+  if { [info exists keys(-cell_name)] } {
+    set cell_name $keys(-cell_name)
+  } else {
+    set cell_name [get_name [[top_instance] cell]]
+  }
+  set corner [parse_corner keys]
+  set one_pass [info exists flags(-one_pass)]
+  set filename [block_model_filename "write_block_model" keys $cell_name $corner]
+  if { ![file exists $filename] } {
+    file mkdir [file dirname $filename]
+    # Rename the finished model so jobs sharing the cache never read
+    # a partial file.
+    set tmp_filename "$filename.[pid]"
+    write_timing_model_cmd $cell_name $cell_name $tmp_filename $corner $one_pass
+    file rename -force $tmp_filename $filename
+  }
+  return $filename
+}
+
+define_cmd_args "read_block_model" {-cache_dir dir -key_files files\
+                                      -cell_name cell_name [-corner corner]}
+
+# Read the cached model of a block. Models must be read before
+# read_verilog so instances of the block link to the model cell.
+# Returns 1 if the model is in the cache.
+proc read_block_model { args } {
+  parse_key_args "read_block_model" args \
+    keys {-cache_dir -key_files -corner -cell_name} flags {}
+  check_argc_eq0 "read_block_model" $args
+
+  if { ![info exists keys(-cell_name)] } {
+    sta_error 490 "read_block_model missing -cell_name."
+  }
+  set cell_name $keys(-cell_name)
+  set corner [parse_corner keys]
+  set filename [block_model_filename "read_block_model" keys $cell_name $corner]
+  if { [file exists $filename] } {
+    read_liberty $filename
+    return 1
+  }
+  return 0
+}
+
+proc block_model_filename { cmd keys_var cell_name corner } {
+  upvar 1 $keys_var keys
+
+  if { ![info exists keys(-cache_dir)] } {
+    sta_error 491 "$cmd missing -cache_dir."
+  }
+  if { ![info exists keys(-key_files)] } {
+    sta_error 492 "$cmd missing -key_files."
+  }
+  set key_files {}
+  foreach key_file $keys(-key_files) {
+    lappend key_files [file nativename $key_file]
+  }
+  set corner_name [expr { $corner == "NULL" ? "" : [$corner name] }]
+  set hash [file_contents_hash "$cell_name $corner_name" $key_files]
+  return [file join [file nativename $keys(-cache_dir)] "${cell_name}_$hash.lib"]
+}
+
 ################################################################
 #
 # Helper functions
@@ -1066,14 +1225,70 @@ proc parse_path_group_arg { group_names } {
   return $names
 }
 
-proc report_path_ends { path_ends } {
-  report_path_end_header
-  set prev_end "NULL"
-  foreach path_end $path_ends {
-    report_path_end2 $path_end $prev_end
-    set prev_end $path_end
+define_cmd_args "write_path_report" \
+  {[-format binary] [-path_args path_args] filename}
+
+proc write_path_report { args } {
+  parse_key_args "write_path_report" args \
+    keys {-format -path_args} flags {}
+  check_argc_eq1 "write_path_report" $args
+  set filename [file nativename [lindex $args 0]]
+
+  if { [info exists keys(-format)] } {
+    set format $keys(-format)
+    if { $format != "binary" } {
+      sta_error 528 "-format $format not supported."
+    }
   }
-  report_path_end_footer
+  set path_args {}
+  if { [info exists keys(-path_args)] } {
+    set path_args $keys(-path_args)
+  }
+  set path_ends [eval [concat find_timing_paths $path_args]]
+  write_path_report_cmd $path_ends $filename
+}
+
+define_cmd_args "write_endpoint_slacks" \
+  {[-corner corner] [-min] [-max] filename}
+
+# Write the worst slack, arrival, required and path group of every
+# endpoint for each corner and min/max to a csv file.
+proc write_endpoint_slacks { args } {
+  parse_key_args "write_endpoint_slacks" args keys {-corner} flags {-min -max}
+  check_argc_eq1 "write_endpoint_slacks" $args
+  set filename [file nativename [lindex $args 0]]
+  set corner [parse_corner_or_all keys]
+  set min_max [parse_min_max_all_flags flags]
+  write_endpoint_slacks_cmd $filename $corner $min_max
+}
+
+define_cmd_args "write_timing_context" \
+  {-instance instance [-digits digits] filename}
+
+proc write_timing_context { args } {
+  global sta_report_default_digits
+
+  parse_key_args "write_timing_context" args \
+    keys {-instance -digits} flags {}
+  check_argc_eq1 "write_timing_context" $args
+  set filename [file nativename [lindex $args 0]]
+  if { ![info exists keys(-instance)] } {
+    sta_error 488 "write_timing_context missing -instance."
+  }
+  set inst [get_instance_error "-instance" $keys(-instance)]
+  if { [$inst is_leaf] } {
+    sta_error 489 "write_timing_context -instance must be hierarchical."
+  }
+  set digits $sta_report_default_digits
+  if { [info exists keys(-digits)] } {
+    set digits $keys(-digits)
+    check_positive_integer "-digits" $digits
+  }
+  write_timing_context_cmd $inst $filename $digits
+}
+
+proc report_path_ends { path_ends } {
+  report_path_end_seq $path_ends
 }
 
 ################################################################
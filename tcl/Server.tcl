@@ -0,0 +1,154 @@
+# OpenSTA, Static Timing Analyzer
+# Copyright (c) 2024, Parallax Software, Inc.
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+# Timing server.
+#
+# start_server keeps the design, graph and search in memory and
+# answers timing queries from clients over a socket. Netlist edits and
+# sdc commands from clients use the incremental timing update like
+# commands typed at the prompt, so only the timing they change is
+# updated by the next query.
+#
+# Requests and replies are binary frames (integers are big endian):
+#  request:  uint32 length, utf-8 tcl command
+#  reply:    uint8 status (0 ok, 1 error)
+#            uint32 length, utf-8 report output of the command
+#            uint32 length, utf-8 command result (error message on error)
+# Commands are evaluated at global level in request order, so any
+# client that can connect can run any command.
+# The stop_server command returns from start_server.
+
+namespace eval sta {
+
+define_cmd_args "start_server" {-port port [-host host] [-no_wait]}
+
+proc start_server { args } {
+  variable server_socket
+  variable server_done
+
+  parse_key_args "start_server" args keys {-port -host} flags {-no_wait}
+  check_argc_eq0 "start_server" $args
+  if { [info exists server_socket] } {
+    sta_error 117 "server already started."
+  }
+  if { ![info exists keys(-port)] } {
+    sta_error 118 "-port must be specified."
+  }
+  set port $keys(-port)
+  check_positive_integer "-port" $port
+  # Only accept local clients unless a host address is specified.
+  set host "localhost"
+  if { [info exists keys(-host)] } {
+    set host $keys(-host)
+  }
+  if { [catch {socket -server sta::server_accept -myaddr $host $port} socket] } {
+    sta_error 119 "start_server $socket."
+  }
+  set server_socket $socket
+  set server_done 0
+  if { ![info exists flags(-no_wait)] } {
+    vwait sta::server_done
+  }
+}
+
+define_cmd_args "stop_server" {}
+
+proc stop_server { args } {
+  variable server_socket
+  variable server_buffers
+  variable server_request_channel
+  variable server_done
+
+  check_argc_eq0 "stop_server" $args
+  if { [info exists server_socket] } {
+    close $server_socket
+    unset server_socket
+  }
+  set server_done 1
+  # A client that sends stop_server is closed after the reply is sent.
+  if { ![info exists server_request_channel] } {
+    foreach client [array names server_buffers] {
+      server_close $client
+    }
+  }
+}
+
+proc server_accept { channel addr port } {
+  variable server_buffers
+
+  fconfigure $channel -translation binary -blocking 0 -buffering full
+  set server_buffers($channel) ""
+  fileevent $channel readable [list sta::server_read $channel]
+}
+
+proc server_read { channel } {
+  variable server_buffers
+  variable server_done
+
+  if { [catch {read $channel} data] || [eof $channel] } {
+    server_close $channel
+    return
+  }
+  set buffer "$server_buffers($channel)$data"
+  # Reply to each complete request in the buffer.
+  while { [binary scan $buffer I length] == 1 } {
+    set length [expr $length & 0xffffffff]
+    if { [string length $buffer] < $length + 4 } {
+      break
+    }
+    set cmd [encoding convertfrom utf-8 \
+               [string range $buffer 4 [expr $length + 3]]]
+    set buffer [string range $buffer [expr $length + 4] end]
+    server_reply $channel $cmd
+  }
+  if { [info exists server_buffers($channel)] } {
+    set server_buffers($channel) $buffer
+  }
+  if { [info exists server_done] && $server_done } {
+    foreach client [array names server_buffers] {
+      server_close $client
+    }
+  }
+}
+
+proc server_reply { channel cmd } {
+  variable server_request_channel
+
+  set server_request_channel $channel
+  redirect_string_begin
+  set status [catch {uplevel #0 $cmd} result]
+  set output [encoding convertto utf-8 [redirect_string_end]]
+  unset server_request_channel
+  set result [encoding convertto utf-8 $result]
+  set status [expr $status == 1]
+  if { [catch {puts -nonewline $channel \
+                 [binary format cIa*Ia* $status \
+                    [string length $output] $output \
+                    [string length $result] $result]
+               flush $channel}] } {
+    server_close $channel
+  }
+}
+
+proc server_close { channel } {
+  variable server_buffers
+
+  catch {close $channel}
+  unset -nocomplain server_buffers($channel)
+}
+
+# sta namespace end.
+}
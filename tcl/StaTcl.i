@@ -36,9 +36,14 @@
 #include "Machine.hh"
 #include "StaConfig.hh"  // STA_VERSION
 #include "Stats.hh"
+#include "Profiler.hh"
+#include "Tracer.hh"
+#include "TimingProgress.hh"
+#include "SearchStats.hh"
 #include "Report.hh"
 #include "Error.hh"
 #include "StringUtil.hh"
+#include "Hash.hh"
 #include "PatternMatch.hh"
 #include "MinMax.hh"
 #include "Fuzzy.hh"
@@ -59,6 +64,7 @@
 #include "ExceptionPath.hh"
 #include "Sdc.hh"
 #include "Graph.hh"
+#include "TableBlockPool.hh"
 #include "DelayCalc.hh"
 #include "DcalcAnalysisPt.hh"
 #include "Corner.hh"
@@ -77,9 +83,14 @@
 #include "search/CheckMinPulseWidths.hh"
 #include "search/Levelize.hh"
 #include "search/ReportPath.hh"
+#include "sdc/SdcCmdParser.hh"
+#include "StaMain.hh"
 
 namespace sta {
 
+// Encoded TCL files that are evaluated on demand (TclEncode.tcl -lazy).
+extern const char **tcl_inits_lazy[];
+
 ////////////////////////////////////////////////////////////////
 //
 // C++ helper functions used by the interface functions.
@@ -125,6 +136,15 @@ cmdEditNetwork()
   }
 }
 
+// Value index of a batch command values list.
+// A single value applies to every object.
+float
+batchValue(const FloatSeq *values,
+           size_t index)
+{
+  return (values->size() == 1) ? (*values)[0] : (*values)[index];
+}
+
 // Get the graph for commands.
 // Throw to cmd level on failure.
 Graph *
@@ -134,6 +154,21 @@ cmdGraph()
   return Sta::sta()->ensureGraph();
 }
 
+// Commands other than the ones that follow a background timing update
+// cancel it so they do not race the update thread.
+void
+cmdCancelTimingUpdate(const char *cmd_name)
+{
+  Sta *sta = Sta::sta();
+  if (sta
+      && sta->timingUpdateRunning()
+      && !(stringEq(cmd_name, "timing_update_running")
+           || stringEq(cmd_name, "timing_update_levels")
+           || stringEq(cmd_name, "timing_update_vertices")
+           || stringEq(cmd_name, "wait_timing_update")))
+    sta->cancelTimingUpdate();
+}
+
 } // namespace
 
 using namespace sta;
@@ -546,6 +581,23 @@ report_line(const char *msg)
     printf("%s\n", msg);
 }
 
+// Buffer console output until report_buffer_end.
+void
+report_buffer_begin()
+{
+  Sta *sta = Sta::sta();
+  if (sta)
+    sta->report()->bufferBegin();
+}
+
+void
+report_buffer_end()
+{
+  Sta *sta = Sta::sta();
+  if (sta)
+    sta->report()->bufferEnd();
+}
+
 void
 fflush()
 {
@@ -719,6 +771,22 @@ read_liberty_cmd(char *filename,
   return (lib != nullptr);
 }
 
+bool
+read_liberty_files_cmd(StringSeq *filenames,
+		       Corner *corner,
+		       const MinMaxAll *min_max,
+		       bool infer_latches)
+{
+  LibertyLibrarySeq libs = Sta::sta()->readLiberty(*filenames, corner, min_max,
+						   infer_latches);
+  delete filenames;
+  for (LibertyLibrary *lib : libs) {
+    if (lib == nullptr)
+      return false;
+  }
+  return true;
+}
+
 bool
 set_min_library_cmd(char *min_filename,
 		    char *max_filename)
@@ -733,6 +801,24 @@ write_liberty_cmd(LibertyLibrary *library,
   writeLiberty(library, filename, Sta::sta());
 }
 
+void
+write_liberty_db_cmd(const char *liberty_filename,
+                     const char *filename)
+{
+  Sta::sta()->writeLibertyDb(liberty_filename, filename);
+}
+
+bool
+read_liberty_db_cmd(const char *filename,
+                    Corner *corner,
+                    const MinMaxAll *min_max,
+                    bool infer_latches)
+{
+  LibertyLibrary *lib = Sta::sta()->readLibertyDb(filename, corner, min_max,
+                                                  infer_latches);
+  return (lib != nullptr);
+}
+
 Library *
 find_library(const char *name)
 {
@@ -852,6 +938,19 @@ set_link_make_black_boxes(bool make)
   Sta::sta()->setLinkMakeBlackBoxes(make);
 }
 
+void
+write_netlist_db_cmd(const char *filename)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->writeNetlistDb(filename);
+}
+
+bool
+read_netlist_db_cmd(const char *filename)
+{
+  return Sta::sta()->readNetlistDb(filename);
+}
+
 Instance *
 top_instance()
 {
@@ -1195,6 +1294,16 @@ pin_property(const Pin *pin,
   return getProperty(pin, property, Sta::sta());
 }
 
+FloatSeq
+pin_property_floats(PinSeq *pins,
+                    const char *property)
+{
+  cmdLinkedNetwork();
+  FloatSeq values = getPropertyFloats(*pins, property, Sta::sta());
+  delete pins;
+  return values;
+}
+
 PropertyValue
 instance_property(const Instance *inst,
 		  const char *property)
@@ -1310,6 +1419,36 @@ define_corners_cmd(StringSet *corner_names)
   delete corner_names;
 }
 
+void
+define_mode_cmd(const char *mode_name)
+{
+  Sta::sta()->makeMode(mode_name);
+}
+
+void
+set_current_mode_cmd(const char *mode_name)
+{
+  Sta::sta()->setCurrentMode(mode_name);
+}
+
+const char *
+current_mode()
+{
+  return Sta::sta()->currentMode();
+}
+
+StringSeq
+mode_names()
+{
+  return Sta::sta()->modeNames();
+}
+
+void
+delete_mode_cmd(const char *mode_name)
+{
+  Sta::sta()->deleteMode(mode_name);
+}
+
 Corner *
 cmd_corner()
 {
@@ -1342,6 +1481,32 @@ multi_corner()
 
 ////////////////////////////////////////////////////////////////
 
+bool
+eval_sdc_cmd_native(const char *cmd,
+                    const char *filename,
+                    int line)
+{
+  return evalSdcCmdNative(cmd, filename, line, Sta::sta());
+}
+
+void
+sdc_batch_begin()
+{
+  Sta::sta()->sdcBatchBegin();
+}
+
+void
+sdc_batch_end()
+{
+  Sta::sta()->sdcBatchEnd();
+}
+
+bool
+sdc_batch_active()
+{
+  return Sta::sta()->sdcBatchActive();
+}
+
 void
 set_analysis_type_cmd(const char *analysis_type)
 {
@@ -1499,6 +1664,70 @@ set_net_wire_cap(const Net *net,
   Sta::sta()->setNetWireCap(net, subtract_pin_cap, corner, min_max, cap);
 }
 
+// Batch versions of set_port_ext_pin_cap, set_port_ext_wire_cap and
+// set_net_wire_cap. caps are in user units and have one value or one
+// value per object.
+void
+set_port_ext_pin_caps(PortSeq *ports,
+                      FloatSeq *caps,
+                      const RiseFallBoth *rf,
+                      const Corner *corner,
+                      const MinMaxAll *min_max)
+{
+  Sta *sta = Sta::sta();
+  if (ports && caps) {
+    const Unit *cap_unit = sta->units()->capacitanceUnit();
+    sta->sdcBatchBegin();
+    for (size_t i = 0; i < ports->size(); i++)
+      sta->setPortExtPinCap((*ports)[i], rf, corner, min_max,
+                            cap_unit->userToSta(batchValue(caps, i)));
+    sta->sdcBatchEnd();
+  }
+  delete ports;
+  delete caps;
+}
+
+void
+set_port_ext_wire_caps(PortSeq *ports,
+                       FloatSeq *caps,
+                       bool subtract_pin_cap,
+                       const RiseFallBoth *rf,
+                       const Corner *corner,
+                       const MinMaxAll *min_max)
+{
+  Sta *sta = Sta::sta();
+  if (ports && caps) {
+    const Unit *cap_unit = sta->units()->capacitanceUnit();
+    sta->sdcBatchBegin();
+    for (size_t i = 0; i < ports->size(); i++)
+      sta->setPortExtWireCap((*ports)[i], subtract_pin_cap, rf, corner, min_max,
+                             cap_unit->userToSta(batchValue(caps, i)));
+    sta->sdcBatchEnd();
+  }
+  delete ports;
+  delete caps;
+}
+
+void
+set_net_wire_caps(NetSeq *nets,
+                  FloatSeq *caps,
+                  bool subtract_pin_cap,
+                  const Corner *corner,
+                  const MinMaxAll *min_max)
+{
+  Sta *sta = Sta::sta();
+  if (nets && caps) {
+    const Unit *cap_unit = sta->units()->capacitanceUnit();
+    sta->sdcBatchBegin();
+    for (size_t i = 0; i < nets->size(); i++)
+      sta->setNetWireCap((*nets)[i], subtract_pin_cap, corner, min_max,
+                         cap_unit->userToSta(batchValue(caps, i)));
+    sta->sdcBatchEnd();
+  }
+  delete nets;
+  delete caps;
+}
+
 void
 set_wire_load_mode_cmd(const char *mode_name)
 {
@@ -2116,6 +2345,27 @@ set_input_slew_cmd(Port *port,
   Sta::sta()->setInputSlew(port, rf, min_max, slew);
 }
 
+// slews are in user units and have one value or one value per port.
+void
+set_input_slews_cmd(PortSeq *ports,
+                    FloatSeq *slews,
+                    const RiseFallBoth *rf,
+                    const MinMaxAll *min_max)
+{
+  cmdLinkedNetwork();
+  Sta *sta = Sta::sta();
+  if (ports && slews) {
+    const Unit *time_unit = sta->units()->timeUnit();
+    sta->sdcBatchBegin();
+    for (size_t i = 0; i < ports->size(); i++)
+      sta->setInputSlew((*ports)[i], rf, min_max,
+                        time_unit->userToSta(batchValue(slews, i)));
+    sta->sdcBatchEnd();
+  }
+  delete ports;
+  delete slews;
+}
+
 void
 set_drive_cell_cmd(LibertyLibrary *library,
 		   LibertyCell *cell,
@@ -2284,6 +2534,34 @@ set_case_analysis_cmd(Pin *pin,
   Sta::sta()->setCaseAnalysis(pin, value);
 }
 
+void
+set_logic_values_cmd(PinSeq *pins,
+                     LogicValue value)
+{
+  Sta *sta = Sta::sta();
+  if (pins) {
+    sta->sdcBatchBegin();
+    for (const Pin *pin : *pins)
+      sta->setLogicValue(const_cast<Pin*>(pin), value);
+    sta->sdcBatchEnd();
+  }
+  delete pins;
+}
+
+void
+set_case_analysis_pins_cmd(PinSeq *pins,
+                           LogicValue value)
+{
+  Sta *sta = Sta::sta();
+  if (pins) {
+    sta->sdcBatchBegin();
+    for (const Pin *pin : *pins)
+      sta->setCaseAnalysis(const_cast<Pin*>(pin), value);
+    sta->sdcBatchEnd();
+  }
+  delete pins;
+}
+
 void
 unset_case_analysis_cmd(Pin *pin)
 {
@@ -2734,6 +3012,46 @@ set_crpr_mode(const char *mode)
     sta->report()->critical(1573, "unknown common clk pessimism mode.");
 }
 
+const char *
+table_page_policy()
+{
+  return tablePagePolicyName(tablePagePolicy());
+}
+
+void
+set_table_page_policy(const char *name)
+{
+  TablePagePolicy policy;
+  if (findTablePagePolicy(name, policy))
+    setTablePagePolicy(policy);
+  else
+    Sta::sta()->report()->critical(1676, "unknown table page policy.");
+}
+
+float
+required_tolerance()
+{
+  return Sta::sta()->requiredTolerance();
+}
+
+void
+set_required_tolerance(float tolerance)
+{
+  Sta::sta()->setRequiredTolerance(tolerance);
+}
+
+float
+crpr_prune_margin()
+{
+  return Sta::sta()->crprPruneMargin();
+}
+
+void
+set_crpr_prune_margin(float margin)
+{
+  Sta::sta()->setCrprPruneMargin(margin);
+}
+
 bool
 pocv_enabled()
 {
@@ -2945,6 +3263,51 @@ report_path_end2(PathEnd *end,
   Sta::sta()->reportPathEnd(end, prev_end);
 }
 
+void
+report_path_end_seq(PathEndSeq *ends)
+{
+  if (ends) {
+    Sta::sta()->reportPathEndSeq(ends);
+    delete ends;
+  }
+  else {
+    PathEndSeq no_ends;
+    Sta::sta()->reportPathEndSeq(&no_ends);
+  }
+}
+
+void
+write_path_report_cmd(PathEndSeq *ends,
+                      const char *filename)
+{
+  if (ends) {
+    Sta::sta()->writePathReport(ends, filename);
+    delete ends;
+  }
+  else {
+    PathEndSeq no_ends;
+    Sta::sta()->writePathReport(&no_ends, filename);
+  }
+}
+
+void
+write_endpoint_slacks_cmd(const char *filename,
+                          const Corner *corner,
+                          const MinMaxAll *min_max)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->writeEndpointSlacks(filename, corner, min_max);
+}
+
+void
+write_timing_context_cmd(Instance *inst,
+                          const char *filename,
+                          int digits)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->writeTimingContext(inst, filename, digits);
+}
+
 void
 set_report_path_format(ReportPathFormat format)
 {
@@ -3058,6 +3421,18 @@ report_clk_latency(ConstClockSeq clks,
   Sta::sta()->reportClkLatency(clks, corner, include_internal_latency, digits);
 }
 
+void
+report_clk_latency_histogram(ConstClockSeq clks,
+                             const Corner *corner,
+                             bool include_internal_latency,
+                             int bucket_count,
+                             int digits)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->reportClkLatencyHistogram(clks, corner, include_internal_latency,
+                                        bucket_count, digits);
+}
+
 float
 worst_clk_skew_cmd(const SetupHold *setup_hold,
                    bool include_internal_latency)
@@ -3214,6 +3589,76 @@ find_timing_cmd(bool full)
   Sta::sta()->updateTiming(full);
 }
 
+void
+find_timing_async_cmd(bool full)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->updateTimingAsync(full);
+}
+
+void
+cancel_timing_update()
+{
+  Sta::sta()->cancelTimingUpdate();
+}
+
+bool
+wait_timing_update()
+{
+  return Sta::sta()->waitTimingUpdate();
+}
+
+bool
+timing_update_running()
+{
+  return Sta::sta()->timingUpdateRunning();
+}
+
+size_t
+timing_update_levels()
+{
+  return Sta::sta()->timingProgress()->levels();
+}
+
+size_t
+timing_update_vertices()
+{
+  return Sta::sta()->timingProgress()->vertices();
+}
+
+void
+freeze_timing_cmd()
+{
+  cmdLinkedNetwork();
+  Sta::sta()->freezeTiming();
+}
+
+void
+thaw_timing()
+{
+  Sta::sta()->thawTiming();
+}
+
+bool
+timing_frozen()
+{
+  return Sta::sta()->timingFrozen();
+}
+
+void
+write_timing_snapshot_cmd(const char *filename)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->writeTimingSnapshot(filename);
+}
+
+bool
+read_timing_snapshot_cmd(const char *filename)
+{
+  cmdLinkedNetwork();
+  return Sta::sta()->readTimingSnapshot(filename);
+}
+
 void
 find_requireds()
 {
@@ -3245,6 +3690,29 @@ total_negative_slack_corner_cmd(const Corner *corner,
   return sta->totalNegativeSlack(corner, min_max);
 }
 
+int
+negative_slack_endpoint_count_cmd(const Corner *corner,
+                                  const MinMax *min_max)
+{
+  cmdLinkedNetwork();
+  Sta *sta = Sta::sta();
+  return sta->negativeSlackEndpointCount(corner, min_max);
+}
+
+PinSeq
+worst_negative_slack_endpoints_cmd(const Corner *corner,
+                                   const MinMax *min_max,
+                                   int count)
+{
+  cmdLinkedNetwork();
+  Sta *sta = Sta::sta();
+  PinSeq pins;
+  for (Vertex *vertex : sta->worstNegativeSlackEndpoints(corner, min_max,
+                                                         count))
+    pins.push_back(vertex->pin());
+  return pins;
+}
+
 Slack
 worst_slack_cmd(const MinMax *min_max)
 {
@@ -3560,13 +4028,41 @@ write_path_spice_cmd(PathRef *path,
 		 power_name, gnd_name, ckt_sim, sta);
 }
 
+void
+write_path_spices_cmd(PathEndSeq *path_ends,
+                      const char *spice_directory,
+                      const char *lib_subckt_filename,
+                      const char *model_filename,
+                      const char *power_name,
+                      const char *gnd_name,
+                      CircuitSim ckt_sim)
+{
+  if (path_ends) {
+    Sta *sta = Sta::sta();
+    writePathSpices(path_ends, spice_directory, lib_subckt_filename,
+                    model_filename, power_name, gnd_name, ckt_sim, sta);
+    delete path_ends;
+  }
+}
+
 void
 write_timing_model_cmd(const char *lib_name,
                        const char *cell_name,
                        const char *filename,
-                       const Corner *corner)
+                       const Corner *corner,
+                       bool one_pass)
 {
-  Sta::sta()->writeTimingModel(lib_name, cell_name, filename, corner);
+  Sta::sta()->writeTimingModel(lib_name, cell_name, filename, corner,
+                               one_pass);
+}
+
+string
+file_contents_hash(const char *key,
+                   StringSeq *filenames)
+{
+  string hash = fileContentsHash(key, *filenames);
+  delete filenames;
+  return hash;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -3871,6 +4367,18 @@ graph_vertex_count()
   return cmdGraph()->vertexCount();
 }
 
+int
+relevelize_visit_count()
+{
+  return Sta::sta()->levelize()->relevelizeVisitCount();
+}
+
+int
+relevelize_change_count()
+{
+  return Sta::sta()->levelize()->relevelizeChangeCount();
+}
+
 int
 graph_edge_count()
 {
@@ -3919,6 +4427,12 @@ report_tags()
   Sta::sta()->search()->reportTags();
 }
 
+void
+report_tag_summary(int max_count)
+{
+  Sta::sta()->search()->reportTagSummary(max_count);
+}
+
 void
 report_clk_infos()
 {
@@ -3931,6 +4445,12 @@ clk_info_count()
   return Sta::sta()->clkInfoCount();
 }
 
+void
+report_memory()
+{
+  Sta::sta()->reportMemory();
+}
+
 int
 arrival_count()
 {
@@ -4030,6 +4550,107 @@ processor_count()
   return processorCount();
 }
 
+// Evaluate a lazily loaded TCL init file.
+// Called by sta::load_lazy_tcl_init.
+void
+eval_tcl_lazy_init(int index)
+{
+  for (int i = 0; tcl_inits_lazy[i]; i++) {
+    if (i == index) {
+      evalTclInit(Sta::sta()->tclInterp(), tcl_inits_lazy[i]);
+      return;
+    }
+  }
+  Sta::sta()->report()->error(1681, "unknown lazy TCL init %d.", index);
+}
+
+// True if the search and delay calc loop debug probes are compiled in.
+bool
+hot_debug_enabled()
+{
+  return STA_HOT_DEBUG;
+}
+
+bool
+profile_enabled()
+{
+  return Sta::sta()->debug()->profiler()->enabled();
+}
+
+void
+set_profile_enabled(bool enabled)
+{
+  Sta::sta()->debug()->profiler()->setEnabled(enabled);
+}
+
+void
+clear_profile()
+{
+  Sta::sta()->debug()->profiler()->clear();
+}
+
+void
+report_profile()
+{
+  Sta *sta = Sta::sta();
+  sta->debug()->profiler()->report(sta->report());
+}
+
+void
+write_profile_json(const char *filename)
+{
+  Sta::sta()->debug()->profiler()->writeJson(filename);
+}
+
+bool
+search_stats_enabled()
+{
+  return Sta::sta()->debug()->searchStats()->enabled();
+}
+
+void
+set_search_stats_enabled(bool enabled)
+{
+  Sta::sta()->debug()->searchStats()->setEnabled(enabled);
+}
+
+void
+clear_search_stats()
+{
+  Sta::sta()->debug()->searchStats()->clear();
+}
+
+void
+report_search_stats()
+{
+  Sta *sta = Sta::sta();
+  sta->debug()->searchStats()->report(sta->threadCount(), sta->report());
+}
+
+bool
+trace_enabled()
+{
+  return Sta::sta()->debug()->tracer()->enabled();
+}
+
+void
+set_trace_enabled(bool enabled)
+{
+  Sta::sta()->debug()->tracer()->setEnabled(enabled);
+}
+
+void
+clear_trace()
+{
+  Sta::sta()->debug()->tracer()->clear();
+}
+
+void
+write_trace_json(const char *filename)
+{
+  Sta::sta()->debug()->tracer()->writeJson(filename);
+}
+
 int
 thread_count()
 {
@@ -4042,6 +4663,186 @@ set_thread_count(int count)
   Sta::sta()->setThreadCount(count);
 }
 
+bool
+bfs_work_stealing()
+{
+  return Sta::sta()->bfsWorkStealing();
+}
+
+void
+set_bfs_work_stealing(bool enabled)
+{
+  Sta::sta()->setBfsWorkStealing(enabled);
+}
+
+bool
+bfs_dependency_driven()
+{
+  return Sta::sta()->bfsDependencyDriven();
+}
+
+void
+set_bfs_dependency_driven(bool enabled)
+{
+  Sta::sta()->setBfsDependencyDriven(enabled);
+}
+
+int
+bfs_prefetch_distance()
+{
+  return Sta::sta()->bfsPrefetchDistance();
+}
+
+void
+set_bfs_prefetch_distance(int distance)
+{
+  Sta::sta()->setBfsPrefetchDistance(distance);
+}
+
+bool
+thread_pinning()
+{
+  return Sta::sta()->threadPinning();
+}
+
+void
+set_thread_pinning(bool enabled)
+{
+  Sta::sta()->setThreadPinning(enabled);
+}
+
+bool
+levelize_parallel()
+{
+  return Sta::sta()->levelizeParallel();
+}
+
+void
+set_levelize_parallel(bool enabled)
+{
+  Sta::sta()->setLevelizeParallel(enabled);
+}
+
+bool
+levelize_scc()
+{
+  return Sta::sta()->levelizeScc();
+}
+
+void
+set_levelize_scc(bool enabled)
+{
+  Sta::sta()->setLevelizeScc(enabled);
+}
+
+bool
+sim_parallel()
+{
+  return Sta::sta()->simParallel();
+}
+
+void
+set_sim_parallel(bool enabled)
+{
+  Sta::sta()->setSimParallel(enabled);
+}
+
+bool
+search_path_ap_parallel()
+{
+  return Sta::sta()->searchPathApParallel();
+}
+
+void
+set_search_path_ap_parallel(bool enabled)
+{
+  Sta::sta()->setSearchPathApParallel(enabled);
+}
+
+bool
+graph_adjacency_snapshot()
+{
+  return Sta::sta()->graphAdjacencySnapshot();
+}
+
+void
+set_graph_adjacency_snapshot(bool enabled)
+{
+  Sta::sta()->setGraphAdjacencySnapshot(enabled);
+}
+
+bool
+graph_level_order()
+{
+  return Sta::sta()->graphLevelOrder();
+}
+
+void
+set_graph_level_order(bool enabled)
+{
+  Sta::sta()->setGraphLevelOrder(enabled);
+}
+
+bool
+keep_mode_timing()
+{
+  return Sta::sta()->keepModeTiming();
+}
+
+void
+set_keep_mode_timing(bool keep)
+{
+  Sta::sta()->setKeepModeTiming(keep);
+}
+
+bool
+spef_read_parallel()
+{
+  return Sta::sta()->spefReadParallel();
+}
+
+void
+set_spef_read_parallel(bool enabled)
+{
+  Sta::sta()->setSpefReadParallel(enabled);
+}
+
+bool
+verilog_link_parallel()
+{
+  return Sta::sta()->verilogLinkParallel();
+}
+
+void
+set_verilog_link_parallel(bool enabled)
+{
+  Sta::sta()->setVerilogLinkParallel(enabled);
+}
+
+bool
+liberty_lazy_load()
+{
+  return Sta::sta()->libertyLazyLoad();
+}
+
+void
+set_liberty_lazy_load(bool enabled)
+{
+  Sta::sta()->setLibertyLazyLoad(enabled);
+}
+
+bool
+liberty_read_parallel()
+{
+  return Sta::sta()->libertyReadParallel();
+}
+
+void
+set_liberty_read_parallel(bool enabled)
+{
+  Sta::sta()->setLibertyReadParallel(enabled);
+}
+
 void
 arrivals_invalid()
 {
@@ -415,6 +415,10 @@ using namespace sta;
   seqTclList<CellSeq, Cell>($1, SWIGTYPE_p_Cell, interp);
 }
 
+%typemap(in) LibertyCellSeq* {
+  $1 = tclListSeqPtr<LibertyCell*>($input, SWIGTYPE_p_LibertyCell, interp);
+}
+
 %typemap(out) LibertyCellSeq * {
   seqPtrTclList<LibertyCellSeq, LibertyCell>($1, SWIGTYPE_p_LibertyCell, interp);
 }
@@ -764,6 +768,10 @@ using namespace sta;
   setTclList<InstanceSet, Instance>($1, SWIGTYPE_p_Instance, interp);
 }
 
+%typemap(in) NetSeq* {
+  $1 = tclListSeqPtr<const Net*>($input, SWIGTYPE_p_Net, interp);
+}
+
 %typemap(in) NetSet* {
   Network *network = cmdNetwork();
   $1 = tclListNetworkSet<NetSet, Net>($input, SWIGTYPE_p_Net, interp, network);
@@ -778,13 +786,14 @@ using namespace sta;
     if (argc)
       floats = new FloatSeq;
     for (int i = 0; i < argc; i++) {
-      char *arg = Tcl_GetString(argv[i]);
       double value;
-      if (Tcl_GetDouble(interp, arg, &value) == TCL_OK)
+      // Numeric objects keep their double so this does not reparse them.
+      if (Tcl_GetDoubleFromObj(interp, argv[i], &value) == TCL_OK)
 	floats->push_back(static_cast<float>(value));
       else {
 	delete floats;
-	tclArgError(interp, "%s is not a floating point number.", arg);
+	tclArgError(interp, "%s is not a floating point number.",
+		    Tcl_GetString(argv[i]));
 	return TCL_ERROR;
       }
     }
@@ -823,13 +832,12 @@ using namespace sta;
     if (argc)
       ints = new IntSeq;
     for (int i = 0; i < argc; i++) {
-      char *arg = Tcl_GetString(argv[i]);
       int value;
-      if (Tcl_GetInt(interp, arg, &value) == TCL_OK)
+      if (Tcl_GetIntFromObj(interp, argv[i], &value) == TCL_OK)
 	ints->push_back(value);
       else {
 	delete ints;
-	tclArgError(interp, "%s is not an integer.", arg);
+	tclArgError(interp, "%s is not an integer.", Tcl_GetString(argv[i]));
 	return TCL_ERROR;
       }
     }
@@ -1143,6 +1151,10 @@ using namespace sta;
   Tcl_SetObjResult(interp, obj);
 }
 
+%typemap(in) PathEndSeq* {
+  $1 = tclListSeqPtr<PathEnd*>($input, SWIGTYPE_p_PathEnd, interp);
+}
+
 %typemap(out) PathEndSeq* {
   Tcl_Obj *list = Tcl_NewListObj(0, nullptr);
   const PathEndSeq *path_ends = $1;
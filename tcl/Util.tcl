@@ -124,6 +124,14 @@ proc proc_redirect { proc_name body } {
   eval $proc_body
 }
 
+# Evaluate script in the caller with its console output buffered.
+proc report_buffered { script } {
+  report_buffer_begin
+  catch { uplevel 1 $script } ret options
+  report_buffer_end
+  return -options $options $ret
+}
+
 proc parse_redirect_args { arg_var } {
   upvar 1 $arg_var args
   set argc [llength $args]
@@ -177,6 +185,77 @@ proc define_hidden_cmd_args { cmd arglist } {
   namespace export $cmd
 }
 
+# Lazily loaded TCL init files are evaluated the first time one of
+# their commands or procs is called (see sta_unknown).
+# cmds are the commands the file exports, procs are all of the procs
+# it defines in the sta namespace.
+proc define_lazy_tcl_init { index cmds procs } {
+  variable lazy_tcl_init_cmds
+  variable lazy_tcl_init_procs
+
+  set lazy_tcl_init_cmds($index) $cmds
+  set lazy_tcl_init_procs($index) $procs
+}
+
+proc load_lazy_tcl_init { index } {
+  variable lazy_tcl_init_cmds
+  variable lazy_tcl_init_procs
+
+  if { [info exists lazy_tcl_init_cmds($index)] } {
+    set cmds $lazy_tcl_init_cmds($index)
+    unset lazy_tcl_init_cmds($index)
+    unset lazy_tcl_init_procs($index)
+    eval_tcl_lazy_init $index
+    foreach cmd $cmds {
+      namespace eval :: [list namespace import ::sta::$cmd]
+    }
+  }
+}
+
+proc load_lazy_tcl_inits {} {
+  variable lazy_tcl_init_cmds
+
+  if { [info exists lazy_tcl_init_cmds] } {
+    foreach index [array names lazy_tcl_init_cmds] {
+      load_lazy_tcl_init $index
+    }
+  }
+}
+
+# Load the lazy TCL init files that define the proc name or commands
+# that name abbreviates.
+# Return 1 if any files were loaded.
+proc load_lazy_tcl_cmd { name } {
+  variable lazy_tcl_init_cmds
+  variable lazy_tcl_init_procs
+
+  set loaded 0
+  if { $name != "" && [info exists lazy_tcl_init_cmds] } {
+    regsub {^(::)?sta::} $name "" proc_name
+    foreach index [array names lazy_tcl_init_cmds] {
+      set found [expr [lsearch -exact $lazy_tcl_init_procs($index) $proc_name] != -1]
+      foreach cmd $lazy_tcl_init_cmds($index) {
+        if { [string first $name $cmd] == 0 } {
+          set found 1
+        }
+      }
+      if { $found } {
+        load_lazy_tcl_init $index
+        set loaded 1
+      }
+    }
+  }
+  return $loaded
+}
+
+# Unknown command handler for the sta namespace.
+proc sta_namespace_unknown { args } {
+  if { [load_lazy_tcl_cmd [lindex $args 0]] } {
+    return [uplevel 1 $args]
+  }
+  return [uplevel 1 [list ::unknown {*}$args]]
+}
+
 ################################################################
 
 proc sta_warn { msg_id msg } {
@@ -221,6 +300,35 @@ proc write_stats { filename } {
 
 ################################################################
 
+# Defined by StaTcl.i
+define_cmd_args "report_profile" {}
+define_cmd_args "clear_profile" {}
+define_cmd_args "report_search_stats" {}
+define_cmd_args "report_memory" {}
+define_cmd_args "clear_search_stats" {}
+define_cmd_args "clear_trace" {}
+
+define_cmd_args "write_profile" {[-json] filename}
+
+# Write the profile recorded with sta_profile_enabled.
+# JSON is the only format so -json is optional.
+proc write_profile { args } {
+  parse_key_args "write_profile" args keys {} flags {-json}
+  check_argc_eq1 "write_profile" $args
+  write_profile_json [file nativename [lindex $args 0]]
+}
+
+define_cmd_args "write_trace" {filename}
+
+# Write the thread timeline recorded with sta_trace_enabled in the
+# Chrome trace event format (chrome://tracing, ui.perfetto.dev).
+proc write_trace { args } {
+  check_argc_eq1 "write_trace" $args
+  write_trace_json [file nativename [lindex $args 0]]
+}
+
+################################################################
+
 # Begin/end logging all output to a file.
 define_cmd_args "log_begin" { filename }
 
@@ -280,6 +388,12 @@ proc check_argc_eq4 { cmd arglist } {
   }
 }
 
+proc check_argc_ge1 { cmd arglist } {
+  if { [llength $arglist] < 1 } {
+    sta_error 624 "$cmd requires one or more positional arguments."
+  }
+}
+
 ################################################################
 
 proc check_float { cmd_arg arg } {
@@ -334,6 +448,10 @@ proc sta_unknown { args } {
     return "\[$args\]"
   }
 
+  if { [sta::load_lazy_tcl_cmd $name] && [info commands $name] != "" } {
+    return [uplevel 1 $args]
+  }
+
   # Command name abbreviation support.
   set ret [catch {set cmds [info commands $name*]} msg]
   if {[string equal $name "::"]} {
@@ -365,3 +483,6 @@ proc is_bus_subscript { subscript } {
 }
 
 namespace unknown sta_unknown
+namespace eval sta {
+  namespace unknown ::sta::sta_namespace_unknown
+}
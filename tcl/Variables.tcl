@@ -72,6 +72,64 @@ proc trace_crpr_mode { name1 name2 op } {
   }
 }
 
+# Page policy for graph and search table blocks allocated after it is set.
+trace variable ::sta_table_page_policy "rw" \
+  sta::trace_table_page_policy
+
+proc trace_table_page_policy { name1 name2 op } {
+  global sta_table_page_policy
+
+  if { $op == "r" } {
+    set sta_table_page_policy [table_page_policy]
+  } elseif { $op == "w" } {
+    if { $sta_table_page_policy == "normal" \
+           || $sta_table_page_policy == "transparent" \
+           || $sta_table_page_policy == "explicit" } {
+      set_table_page_policy $sta_table_page_policy
+    } else {
+      sta_error 487 "sta_table_page_policy must be normal, transparent or explicit."
+    }
+  }
+}
+
+# Required time changes smaller than this (in user time units) are not
+# propagated by incremental required time updates.
+trace variable ::sta_required_tolerance "rw" \
+  sta::trace_required_tolerance
+
+proc trace_required_tolerance { name1 name2 op } {
+  global sta_required_tolerance
+
+  if { $op == "r" } {
+    set sta_required_tolerance [time_sta_ui [required_tolerance]]
+  } elseif { $op == "w" } {
+    if { [string is double $sta_required_tolerance] \
+	   && $sta_required_tolerance >= 0.0 } {
+      set_required_tolerance [time_ui_sta $sta_required_tolerance]
+    } else {
+      sta_error 593 "sta_required_tolerance must be a positive float."
+    }
+  }
+}
+
+trace variable ::sta_crpr_prune_margin "rw" \
+  sta::trace_crpr_prune_margin
+
+proc trace_crpr_prune_margin { name1 name2 op } {
+  global sta_crpr_prune_margin
+
+  if { $op == "r" } {
+    set sta_crpr_prune_margin [time_sta_ui [crpr_prune_margin]]
+  } elseif { $op == "w" } {
+    if { [string is double $sta_crpr_prune_margin] \
+	   && $sta_crpr_prune_margin >= 0.0 } {
+      set_crpr_prune_margin [time_ui_sta $sta_crpr_prune_margin]
+    } else {
+      sta_error 485 "sta_crpr_prune_margin must be a positive float."
+    }
+  }
+}
+
 trace variable ::sta_cond_default_arcs_enabled "rw" \
   sta::trace_cond_default_arcs_enabled
 
@@ -168,6 +226,163 @@ proc trace_pocv_enabled { name1 name2 op } {
     pocv_enabled set_pocv_enabled
 }
 
+trace variable ::sta_bfs_work_stealing "rw" \
+  sta::trace_bfs_work_stealing
+
+proc trace_bfs_work_stealing { name1 name2 op } {
+  trace_boolean_var $op ::sta_bfs_work_stealing \
+    bfs_work_stealing set_bfs_work_stealing
+}
+
+trace variable ::sta_bfs_dependency_driven "rw" \
+  sta::trace_bfs_dependency_driven
+
+proc trace_bfs_dependency_driven { name1 name2 op } {
+  trace_boolean_var $op ::sta_bfs_dependency_driven \
+    bfs_dependency_driven set_bfs_dependency_driven
+}
+
+trace variable ::sta_thread_pinning "rw" \
+  sta::trace_thread_pinning
+
+proc trace_thread_pinning { name1 name2 op } {
+  trace_boolean_var $op ::sta_thread_pinning \
+    thread_pinning set_thread_pinning
+}
+
+trace variable ::sta_bfs_prefetch_distance "rw" \
+  sta::trace_bfs_prefetch_distance
+
+proc trace_bfs_prefetch_distance { name1 name2 op } {
+  global sta_bfs_prefetch_distance
+
+  if { $op == "r" } {
+    set sta_bfs_prefetch_distance [bfs_prefetch_distance]
+  } elseif { $op == "w" } {
+    if { [string is integer $sta_bfs_prefetch_distance] \
+	   && $sta_bfs_prefetch_distance >= 0 } {
+      set_bfs_prefetch_distance $sta_bfs_prefetch_distance
+    } else {
+      sta_error 486 "sta_bfs_prefetch_distance must be a positive integer."
+    }
+  }
+}
+
+trace variable ::sta_levelize_parallel "rw" \
+  sta::trace_levelize_parallel
+
+proc trace_levelize_parallel { name1 name2 op } {
+  trace_boolean_var $op ::sta_levelize_parallel \
+    levelize_parallel set_levelize_parallel
+}
+
+trace variable ::sta_levelize_scc "rw" \
+  sta::trace_levelize_scc
+
+proc trace_levelize_scc { name1 name2 op } {
+  trace_boolean_var $op ::sta_levelize_scc \
+    levelize_scc set_levelize_scc
+}
+
+trace variable ::sta_sim_parallel "rw" \
+  sta::trace_sim_parallel
+
+proc trace_sim_parallel { name1 name2 op } {
+  trace_boolean_var $op ::sta_sim_parallel \
+    sim_parallel set_sim_parallel
+}
+
+trace variable ::sta_search_path_ap_parallel "rw" \
+  sta::trace_search_path_ap_parallel
+
+proc trace_search_path_ap_parallel { name1 name2 op } {
+  trace_boolean_var $op ::sta_search_path_ap_parallel \
+    search_path_ap_parallel set_search_path_ap_parallel
+}
+
+trace variable ::sta_graph_adjacency_snapshot "rw" \
+  sta::trace_graph_adjacency_snapshot
+
+proc trace_graph_adjacency_snapshot { name1 name2 op } {
+  trace_boolean_var $op ::sta_graph_adjacency_snapshot \
+    graph_adjacency_snapshot set_graph_adjacency_snapshot
+}
+
+trace variable ::sta_graph_level_order "rw" \
+  sta::trace_graph_level_order
+
+proc trace_graph_level_order { name1 name2 op } {
+  trace_boolean_var $op ::sta_graph_level_order \
+    graph_level_order set_graph_level_order
+}
+
+trace variable ::sta_keep_mode_timing "rw" \
+  sta::trace_keep_mode_timing
+
+proc trace_keep_mode_timing { name1 name2 op } {
+  trace_boolean_var $op ::sta_keep_mode_timing \
+    keep_mode_timing set_keep_mode_timing
+}
+
+trace variable ::sta_spef_read_parallel "rw" \
+  sta::trace_spef_read_parallel
+
+proc trace_spef_read_parallel { name1 name2 op } {
+  trace_boolean_var $op ::sta_spef_read_parallel \
+    spef_read_parallel set_spef_read_parallel
+}
+
+trace variable ::sta_verilog_link_parallel "rw" \
+  sta::trace_verilog_link_parallel
+
+proc trace_verilog_link_parallel { name1 name2 op } {
+  trace_boolean_var $op ::sta_verilog_link_parallel \
+    verilog_link_parallel set_verilog_link_parallel
+}
+
+trace variable ::sta_liberty_lazy_load "rw" \
+  sta::trace_liberty_lazy_load
+
+proc trace_liberty_lazy_load { name1 name2 op } {
+  trace_boolean_var $op ::sta_liberty_lazy_load \
+    liberty_lazy_load set_liberty_lazy_load
+}
+
+trace variable ::sta_liberty_read_parallel "rw" \
+  sta::trace_liberty_read_parallel
+
+proc trace_liberty_read_parallel { name1 name2 op } {
+  trace_boolean_var $op ::sta_liberty_read_parallel \
+    liberty_read_parallel set_liberty_read_parallel
+}
+
+# Record the run time and memory of analysis phases for report_profile.
+trace variable ::sta_profile_enabled "rw" \
+  sta::trace_profile_enabled
+
+proc trace_profile_enabled { name1 name2 op } {
+  trace_boolean_var $op ::sta_profile_enabled \
+    profile_enabled set_profile_enabled
+}
+
+# Count search and delay calculation work for report_search_stats.
+trace variable ::sta_search_stats_enabled "rw" \
+  sta::trace_search_stats_enabled
+
+proc trace_search_stats_enabled { name1 name2 op } {
+  trace_boolean_var $op ::sta_search_stats_enabled \
+    search_stats_enabled set_search_stats_enabled
+}
+
+# Record dispatch queue tasks and BFS levels per thread for write_trace.
+trace variable ::sta_trace_enabled "rw" \
+  sta::trace_trace_enabled
+
+proc trace_trace_enabled { name1 name2 op } {
+  trace_boolean_var $op ::sta_trace_enabled \
+    trace_enabled set_trace_enabled
+}
+
 # Report path numeric field width is digits + extra.
 set report_path_field_width_extra 5
 
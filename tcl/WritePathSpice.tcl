@@ -85,16 +85,9 @@ proc write_path_spice { args } {
   if { $path_ends == {} } {
     sta_error 611 "No paths found for -path_args $path_args."
   } else {
-    set path_index 1
-    foreach path_end $path_ends {
-      set path [$path_end path]
-      set path_name "path_$path_index"
-      set spice_file [file join $spice_dir "$path_name.sp"]
-      set subckt_file [file join $spice_dir "$path_name.subckt"]
-      write_path_spice_cmd $path $spice_file $subckt_file \
-	$lib_subckt_file $model_file $power $ground $ckt_sim
-      incr path_index
-    }
+    # Decks are written to spice_dir/path_<n>.sp and path_<n>.subckt.
+    write_path_spices_cmd $path_ends $spice_dir $lib_subckt_file \
+      $model_file $power $ground $ckt_sim
   }
 }
 
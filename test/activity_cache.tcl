@@ -0,0 +1,36 @@
+# read_power_activities -saif and write_activity_cache/read_activity_cache.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+
+set saif_file results/activity_cache.saif
+set stream [open $saif_file w]
+puts $stream {(SAIFILE
+(SAIFVERSION "2.0")
+(DIRECTION "backward")
+(DESIGN "top")
+(TIMESCALE 1 ns)
+(DURATION 1000)
+(INSTANCE top
+  (PORT
+    (in1 (T0 500) (T1 500) (TX 0) (TC 20))
+  )
+  (INSTANCE u1
+    (NET
+      (Z (T0 600) (T1 400) (TC 10))
+    )
+  )
+)
+)}
+close $stream
+
+read_power_activities -saif $saif_file
+with_output_to_variable saif_power { report_power }
+write_activity_cache results/activity_cache.acache
+set_power_activity -pins [get_pins u1/Z] -activity 0.9
+puts "read [read_activity_cache results/activity_cache.acache]"
+with_output_to_variable cache_power { report_power }
+puts "cache matches saif [expr {$cache_power == $saif_power}]"
+puts "read [read_activity_cache ../examples/example1.v]"
@@ -0,0 +1,174 @@
+# OpenSTA, Static Timing Analyzer
+# Copyright (c) 2024, Parallax Software, Inc.
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+# Benchmark driver.
+# Usage: sta -no_init -no_splash -exit bench.tcl
+#
+# Environment variables:
+#  STA_BENCH_SIZE     small|medium|large design (default small)
+#  STA_BENCH_DIR      directory for the design files (default ./bench)
+#  STA_BENCH_RESULTS  results json file (default $STA_BENCH_DIR/bench_<size>.json)
+#  STA_BENCH_THREADS  thread count (default all processors)
+#  STA_BENCH_ECO      incremental edit count (default 100)
+#  STA_BENCH_LEVEL_ORDER  1 to number the graph in level order (default 0)
+#  STA_BENCH_STARTUP  sta startup run count (default 10)
+#
+# Each step records the elapsed seconds and the memory in use after
+# the step. The results record whether the inner loop debug probes are
+# compiled in (cmake -DSTA_HOT_DEBUG=OFF removes them) so runs of the two
+# builds can be compared.
+
+set bench_src_dir [file dirname [file normalize [info script]]]
+source [file join $bench_src_dir bench_design.tcl]
+
+proc bench_env { name default } {
+  global env
+  if { [info exists env($name)] && $env($name) != "" } {
+    return $env($name)
+  }
+  return $default
+}
+
+set bench_size [bench_env STA_BENCH_SIZE small]
+set bench_dir [file normalize [bench_env STA_BENCH_DIR bench]]
+set bench_results [bench_env STA_BENCH_RESULTS \
+                     [file join $bench_dir "bench_$bench_size.json"]]
+set bench_threads [bench_env STA_BENCH_THREADS [sta::processor_count]]
+set bench_eco_count [bench_env STA_BENCH_ECO 100]
+set bench_params [bench::design_params $bench_size]
+set bench_steps {}
+set bench_liberty [file join $bench_src_dir .. .. examples nangate45_typ.lib]
+
+proc bench_step { name script } {
+  global bench_steps
+  set start [clock microseconds]
+  uplevel 1 $script
+  set seconds [expr ([clock microseconds] - $start) * 1e-6]
+  set memory [sta::memory_usage]
+  lappend bench_steps [list $name $seconds $memory]
+  puts [format "%-16s %10.3fs %10.1fMB" $name $seconds [expr $memory * 1e-6]]
+}
+
+# Run script discarding the report output.
+proc bench_quiet { script } {
+  sta::redirect_string_begin
+  catch { uplevel 1 $script } result options
+  sta::redirect_string_end
+  return -options $options $result
+}
+
+proc bench_write_results { filename } {
+  global bench_size bench_threads bench_params bench_eco_count bench_steps
+  set stream [open $filename w]
+  puts $stream "\{"
+  puts $stream "  \"size\": \"$bench_size\","
+  puts $stream "  \"threads\": $bench_threads,"
+  puts $stream "  \"hot_debug\": [expr {[sta::hot_debug_enabled] ? "true" : "false"}],"
+  puts $stream "  \"eco_edits\": $bench_eco_count,"
+  puts $stream "  \"design\": \{"
+  set fields {}
+  foreach {key value} $bench_params {
+    lappend fields "    \"$key\": $value"
+  }
+  puts $stream [join $fields ",\n"]
+  puts $stream "  \},"
+  puts $stream "  \"instances\": [llength [get_cells *]],"
+  puts $stream "  \"steps\": \["
+  set fields {}
+  foreach step $bench_steps {
+    lassign $step name seconds memory
+    lappend fields "    \{\"name\": \"$name\", \"seconds\": $seconds, \"memory\": $memory\}"
+  }
+  puts $stream [join $fields ",\n"]
+  puts $stream "  \]"
+  puts $stream "\}"
+  close $stream
+}
+
+# Average seconds to start sta and run an empty command file.
+proc bench_startup { count } {
+  global bench_dir
+  set cmd_file [file join $bench_dir startup.tcl]
+  set stream [open $cmd_file w]
+  close $stream
+  set sta_exe [info nameofexecutable]
+  set start [clock microseconds]
+  for { set i 0 } { $i < $count } { incr i } {
+    exec $sta_exe -no_init -no_splash -exit $cmd_file
+  }
+  return [expr ([clock microseconds] - $start) * 1e-6 / max($count, 1)]
+}
+
+# Swap the drive strength of the first gate in register cones
+# spread across the design and update timing after each edit.
+proc bench_eco { count } {
+  global bench_params
+  array set p $bench_params
+  set step [expr max($p(flops) / max($count, 1), 1)]
+  for { set e 0 } { $e < $count } { incr e } {
+    set inst [get_cells "g[expr ($e * $step) % $p(flops)]_0"]
+    if { [get_property $inst ref_name] == "NAND2_X1" } {
+      replace_cell $inst NAND2_X2
+    } else {
+      replace_cell $inst NAND2_X1
+    }
+    sta::find_timing_cmd 0
+  }
+}
+
+puts "Benchmark $bench_size threads $bench_threads hot_debug [sta::hot_debug_enabled]"
+sta::set_thread_count $bench_threads
+set sta_graph_level_order [bench_env STA_BENCH_LEVEL_ORDER 0]
+bench_step generate {
+  bench::write_design $bench_dir $bench_params
+}
+set startup_seconds [bench_startup [bench_env STA_BENCH_STARTUP 10]]
+lappend bench_steps [list startup $startup_seconds [sta::memory_usage]]
+puts [format "%-16s %10.3fs" startup $startup_seconds]
+bench_step read_liberty {
+  read_liberty $bench_liberty
+}
+bench_step read_verilog {
+  read_verilog [file join $bench_dir bench.v]
+}
+bench_step link_design {
+  link_design bench
+}
+bench_step read_sdc {
+  read_sdc [file join $bench_dir bench.sdc]
+}
+bench_step read_spef {
+  read_spef [file join $bench_dir bench.spef]
+}
+bench_step update_timing {
+  sta::find_timing_cmd 1
+}
+bench_step eco {
+  bench_eco $bench_eco_count
+}
+bench_step report_checks {
+  bench_quiet {
+    report_checks -group_count 1000 -endpoint_count 1
+  }
+}
+bench_step report_power {
+  set_power_activity -input -activity 0.1
+  bench_quiet {
+    report_power
+  }
+}
+bench_write_results $bench_results
+puts "Results $bench_results"
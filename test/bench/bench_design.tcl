@@ -0,0 +1,304 @@
+# OpenSTA, Static Timing Analyzer
+# Copyright (c) 2024, Parallax Software, Inc.
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+# Synthetic benchmark design generator.
+# Writes a verilog netlist, SPEF parasitics and SDC constraints for
+# the nangate45 library in examples/. The designs are deterministic
+# so timings are comparable between runs.
+#
+# Design parameters (bench_design_params keys):
+#  flops          register count
+#  depth          gates in the logic cone in front of each register
+#  clocks         clock domains; registers are assigned round robin
+#  clock_fanout   clock buffer tree fanout
+#  inputs         input ports feeding the first gate of register cones
+#  outputs        output ports buffered from register outputs
+#  exceptions     false path, multicycle and max delay exceptions
+#  spef_nodes     internal RC nodes per parasitic network
+
+namespace eval bench {
+
+variable design_sizes
+array set design_sizes {
+  small  {flops 2000 depth 8 clocks 2 clock_fanout 16 inputs 64 outputs 64 exceptions 200 spef_nodes 4}
+  medium {flops 20000 depth 10 clocks 4 clock_fanout 16 inputs 256 outputs 256 exceptions 2000 spef_nodes 6}
+  large  {flops 200000 depth 12 clocks 8 clock_fanout 24 inputs 1024 outputs 1024 exceptions 20000 spef_nodes 8}
+}
+
+proc design_params { size } {
+  variable design_sizes
+  if { ![info exists design_sizes($size)] } {
+    error "unknown benchmark size $size; use [lsort [array names design_sizes]]"
+  }
+  return $design_sizes($size)
+}
+
+# Write bench.v, bench.spef and bench.sdc to dir.
+proc write_design { dir params } {
+  variable drvrs
+  variable loads
+  variable spef_nodes
+  array unset drvrs
+  array unset loads
+  array set p $params
+  set spef_nodes $p(spef_nodes)
+
+  file mkdir $dir
+  write_verilog_design [file join $dir bench.v] p
+  write_spef_design [file join $dir bench.spef]
+  write_sdc_design [file join $dir bench.sdc] p
+  array unset drvrs
+  array unset loads
+}
+
+proc connect_drvr { net pin } {
+  variable drvrs
+  set drvrs($net) $pin
+}
+
+proc connect_load { net pin } {
+  variable loads
+  lappend loads($net) $pin
+}
+
+proc write_verilog_design { filename params_var } {
+  upvar 1 $params_var p
+  set flops $p(flops)
+  set depth $p(depth)
+  set clocks $p(clocks)
+  set fanout $p(clock_fanout)
+  set inputs $p(inputs)
+  set outputs $p(outputs)
+
+  set stream [open $filename w]
+  set ports {}
+  for { set c 0 } { $c < $clocks } { incr c } {
+    lappend ports "clk$c"
+  }
+  for { set i 0 } { $i < $inputs } { incr i } {
+    lappend ports "in$i"
+  }
+  for { set o 0 } { $o < $outputs } { incr o } {
+    lappend ports "out$o"
+  }
+  puts $stream "module bench ([join $ports {, }]);"
+  foreach port $ports {
+    if { [string match "out*" $port] } {
+      puts $stream " output $port;"
+      connect_load $port "P $port O"
+    } else {
+      puts $stream " input $port;"
+      connect_drvr $port "P $port I"
+    }
+  }
+
+  # Clock buffer trees, leaf level 0 drives the registers.
+  for { set c 0 } { $c < $clocks } { incr c } {
+    set sinks [expr ($flops - $c + $clocks - 1) / $clocks]
+    set level 0
+    set count [expr ($sinks + $fanout - 1) / $fanout]
+    set level_counts {}
+    while { 1 } {
+      lappend level_counts $count
+      if { $count == 1 } {
+        break
+      }
+      set count [expr ($count + $fanout - 1) / $fanout]
+      incr level
+    }
+    set top_level $level
+    for { set level 0 } { $level <= $top_level } { incr level } {
+      set count [lindex $level_counts $level]
+      for { set j 0 } { $j < $count } { incr j } {
+        set inst "cb${c}_${level}_$j"
+        set out "cn${c}_${level}_$j"
+        if { $level == $top_level } {
+          set in "clk$c"
+        } else {
+          set in "cn${c}_[expr $level + 1]_[expr $j / $fanout]"
+        }
+        puts $stream " wire $out;"
+        puts $stream " CLKBUF_X3 $inst (.A($in), .Z($out));"
+        connect_load $in "I $inst:A I"
+        connect_drvr $out "I $inst:Z O"
+      }
+    }
+  }
+
+  for { set i 0 } { $i < $flops } { incr i } {
+    puts $stream " wire q$i;"
+  }
+  for { set i 0 } { $i < $flops } { incr i } {
+    # Logic cone mixing the previous register and registers spread
+    # across the design.
+    set prev "q[expr ($i + $flops - 1) % $flops]"
+    for { set k 0 } { $k < $depth } { incr k } {
+      set inst "g${i}_$k"
+      if { $k == $depth - 1 } {
+        set out "d$i"
+      } else {
+        set out "n${i}_$k"
+      }
+      if { $k == 0 && $i < $inputs } {
+        set other "in$i"
+      } else {
+        set other "q[expr ($i * 31 + $k * 17 + 3) % $flops]"
+      }
+      if { $k % 2 == 0 } {
+        set cell NAND2_X1
+      } else {
+        set cell NOR2_X1
+      }
+      puts $stream " wire $out;"
+      puts $stream " $cell $inst (.A1($prev), .A2($other), .ZN($out));"
+      connect_load $prev "I $inst:A1 I"
+      connect_load $other "I $inst:A2 I"
+      connect_drvr $out "I $inst:ZN O"
+      set prev $out
+    }
+    set c [expr $i % $clocks]
+    set ck "cn${c}_0_[expr ($i / $clocks) / $fanout]"
+    puts $stream " DFF_X1 r$i (.D($prev), .CK($ck), .Q(q$i));"
+    connect_load $prev "I r$i:D I"
+    connect_load $ck "I r$i:CK I"
+    connect_drvr "q$i" "I r$i:Q O"
+  }
+  for { set o 0 } { $o < $outputs } { incr o } {
+    set q "q[expr $o % $flops]"
+    puts $stream " BUF_X1 ob$o (.A($q), .Z(out$o));"
+    connect_load $q "I ob$o:A I"
+    connect_drvr "out$o" "I ob$o:Z O"
+  }
+  puts $stream "endmodule"
+  close $stream
+}
+
+# Each net is an RC chain from the driver with loads spread along it.
+proc write_spef_design { filename } {
+  variable drvrs
+  variable loads
+  variable spef_nodes
+
+  set stream [open $filename w]
+  puts $stream {*SPEF "IEEE 1481-1998"}
+  puts $stream {*DESIGN "bench"}
+  puts $stream {*DATE "Thu Jan 1 00:00:00 1970"}
+  puts $stream {*VENDOR "Parallax Software, Inc"}
+  puts $stream {*PROGRAM "bench_design.tcl"}
+  puts $stream {*VERSION "1.0"}
+  puts $stream {*DESIGN_FLOW "PIN_CAP NONE"}
+  puts $stream {*DIVIDER /}
+  puts $stream {*DELIMITER :}
+  puts $stream {*BUS_DELIMITER [ ]}
+  puts $stream {*T_UNIT 1 NS}
+  puts $stream {*C_UNIT 1 FF}
+  puts $stream {*R_UNIT 1 OHM}
+  puts $stream {*L_UNIT 1 HENRY}
+  puts $stream ""
+
+  foreach net [lsort [array names drvrs]] {
+    if { ![info exists loads($net)] } {
+      continue
+    }
+    set net_loads $loads($net)
+    set load_count [llength $net_loads]
+    set node_count [expr max($spef_nodes, 1)]
+    set node_cap 0.5
+    set pin_cap 0.2
+    set total_cap [expr $node_count * $node_cap + ($load_count + 1) * $pin_cap]
+    puts $stream "*D_NET $net $total_cap"
+    puts $stream "*CONN"
+    set drvr_node [conn_node $drvrs($net)]
+    puts $stream "*$drvrs($net)"
+    foreach load $net_loads {
+      puts $stream "*$load"
+    }
+    set index 1
+    puts $stream "*CAP"
+    puts $stream "$index $drvr_node $pin_cap"
+    incr index
+    for { set n 1 } { $n <= $node_count } { incr n } {
+      puts $stream "$index $net:$n $node_cap"
+      incr index
+    }
+    foreach load $net_loads {
+      puts $stream "$index [conn_node $load] $pin_cap"
+      incr index
+    }
+    puts $stream "*RES"
+    set prev $drvr_node
+    for { set n 1 } { $n <= $node_count } { incr n } {
+      puts $stream "$index $prev $net:$n 5"
+      set prev "$net:$n"
+      incr index
+    }
+    set l 0
+    foreach load $net_loads {
+      # Spread the loads over the chain nodes.
+      set n [expr (($l + 1) * $node_count + $load_count - 1) / $load_count]
+      puts $stream "$index $net:$n [conn_node $load] 10"
+      incr index
+      incr l
+    }
+    puts $stream "*END"
+    puts $stream ""
+  }
+  close $stream
+}
+
+# "I inst:pin dir" or "P port dir" connection node name.
+proc conn_node { conn } {
+  return [lindex $conn 1]
+}
+
+proc write_sdc_design { filename params_var } {
+  upvar 1 $params_var p
+  set flops $p(flops)
+  set clocks $p(clocks)
+
+  set stream [open $filename w]
+  for { set c 0 } { $c < $clocks } { incr c } {
+    set period [expr 2.0 + $c * 0.5]
+    puts $stream "create_clock -name clk$c -period $period \[get_ports clk$c\]"
+    puts $stream "set_clock_uncertainty 0.05 \[get_clocks clk$c\]"
+  }
+  puts $stream "set_propagated_clock \[all_clocks\]"
+  puts $stream "set_input_delay -clock clk0 0.2 \[get_ports in*\]"
+  puts $stream "set_output_delay -clock clk0 0.2 \[get_ports out*\]"
+  puts $stream "set_input_transition 0.05 \[get_ports in*\]"
+  puts $stream "set_load 2.0 \[get_ports out*\]"
+  if { $clocks > 1 } {
+    puts $stream "set_clock_groups -asynchronous -group clk0 -group clk1"
+  }
+  for { set e 0 } { $e < $p(exceptions) } { incr e } {
+    set from [expr ($e * 7919) % $flops]
+    set to [expr ($e * 104729 + 1) % $flops]
+    switch [expr $e % 3] {
+      0 {
+        puts $stream "set_false_path -from \[get_cells r$from\] -to \[get_pins r$to/D\]"
+      }
+      1 {
+        puts $stream "set_multicycle_path 2 -setup -from \[get_cells r$from\] -to \[get_pins r$to/D\]"
+      }
+      2 {
+        puts $stream "set_max_delay 1.5 -from \[get_cells r$from\] -to \[get_pins r$to/D\]"
+      }
+    }
+  }
+  close $stream
+}
+
+}
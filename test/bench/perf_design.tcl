@@ -0,0 +1,30 @@
+# OpenSTA, Static Timing Analyzer
+# Copyright (c) 2024, Parallax Software, Inc.
+# 
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+# Regression perf tier flow.
+# The regression harness generates the benchmark design in
+# perf_design_dir before the test runs so generation is not timed.
+
+read_liberty [file join .. .. examples nangate45_typ.lib]
+read_verilog [file join $perf_design_dir bench.v]
+link_design bench
+read_sdc [file join $perf_design_dir bench.sdc]
+read_spef [file join $perf_design_dir bench.spef]
+report_checks -group_count 100 -format end
+report_checks -path_delay min -group_count 100 -format end
+report_tns
+report_wns
+report_power
@@ -0,0 +1,2 @@
+# Regression perf tier test for the large benchmark design.
+source perf_design.tcl
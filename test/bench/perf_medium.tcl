@@ -0,0 +1,2 @@
+# Regression perf tier test for the medium benchmark design.
+source perf_design.tcl
@@ -0,0 +1,16 @@
+# Edits thaw frozen timing.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+sta::freeze_timing
+puts "frozen [sta::timing_frozen]"
+set_input_delay -clock clk 1 {in1 in2}
+puts "frozen after set_input_delay [sta::timing_frozen]"
+sta::freeze_timing
+set_load 0.1 out
+puts "frozen after set_load [sta::timing_frozen]"
+sta::freeze_timing
+disconnect_pin r2q u1/A
+puts "frozen after disconnect_pin [sta::timing_frozen]"
@@ -0,0 +1,23 @@
+# Instance and net pattern matches found with the name index are in
+# name order, the same as the matches found without the index.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+for {set i 0} {$i < 70} {incr i} {
+  make_instance b$i BUF_X1
+  make_net n$i
+}
+
+proc report_names { objects } {
+  set names {}
+  foreach object $objects {
+    lappend names [get_full_name $object]
+  }
+  puts $names
+}
+
+report_names [get_cells b1*]
+report_names [get_cells -regexp {b1[0-9]?}]
+report_names [get_cells u*]
+report_names [get_nets n6*]
+report_names [get_nets -regexp -nocase {N6[0-9]?}]
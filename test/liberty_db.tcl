@@ -0,0 +1,16 @@
+# read_liberty_db reads the library written by write_liberty_db.
+write_liberty_db ../examples/nangate45_slow.lib results/nangate45_slow.ldb
+read_liberty_db results/nangate45_slow.ldb
+
+set stream [open ../examples/nangate45_slow.lib r]
+set lib_text [read $stream]
+close $stream
+set lib_cell_count [regexp -all -line {^\s*cell\s*\(} $lib_text]
+set db_cell_count [llength [get_lib_cells NangateOpenCellLibrary_slow/*]]
+puts "db cells match liberty [expr {$db_cell_count == $lib_cell_count}]"
+
+read_verilog ../examples/example1.v
+link_design top
+puts "instances [llength [get_cells *]]"
+puts "u1 [get_property [get_cells u1] ref_name]"
+read_liberty_db ../examples/example1.v
@@ -0,0 +1,24 @@
+# read_netlist_db links the netlist written by write_netlist_db.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+
+proc netlist_names {} {
+  set names {}
+  foreach inst [get_cells *] {
+    lappend names "[get_full_name $inst] [get_property $inst ref_name]"
+  }
+  foreach net [get_nets *] {
+    lappend names [get_full_name $net]
+  }
+  foreach port [get_ports *] {
+    lappend names "[get_full_name $port] [get_property $port direction]"
+  }
+  return $names
+}
+
+set verilog_names [netlist_names]
+write_netlist_db results/example1.ndb
+puts "read [read_netlist_db results/example1.ndb]"
+puts "db matches verilog [expr {[netlist_names] == $verilog_names}]"
+puts "read [read_netlist_db ../examples/example1.v]"
@@ -0,0 +1,13 @@
+# write_parasitics_cache/read_parasitics_cache restore the spef parasitics.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+read_spef ../examples/example1.dspef
+with_output_to_variable spef_checks { report_checks -fields {cap slew} }
+write_parasitics_cache results/example1.pcache
+puts "read [read_parasitics_cache results/example1.pcache]"
+with_output_to_variable cache_checks { report_checks -fields {cap slew} }
+puts "cache matches spef [expr {$cache_checks == $spef_checks}]"
+puts "read [read_parasitics_cache ../examples/example1.v]"
@@ -0,0 +1,69 @@
+# read_sdc with and without the native command reader makes the same
+# constraints and reports the same errors and warnings.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+
+proc write_text_file { filename text } {
+  set stream [open $filename w]
+  puts -nonewline $stream $text
+  close $stream
+}
+
+proc read_text_file { filename } {
+  set stream [open $filename r]
+  set text [read $stream]
+  close $stream
+  return $text
+}
+
+proc read_sdc_native { native filename } {
+  global sta_read_sdc_native
+  sta::remove_constraints
+  set sta_read_sdc_native $native
+  if { [catch {read_sdc $filename} msg] } {
+    puts $msg
+  }
+  set sta_read_sdc_native 1
+  set sdc_file [file join results read_sdc_native_out.sdc]
+  write_sdc -no_timestamp $sdc_file
+  return [read_text_file $sdc_file]
+}
+
+proc compare_read_sdc { name text } {
+  set filename [file join results $name.sdc]
+  write_text_file $filename $text
+  set sdc_tcl [read_sdc_native 0 $filename]
+  set sdc_native [read_sdc_native 1 $filename]
+  puts "$name [expr {$sdc_tcl == $sdc_native}]"
+}
+
+compare_read_sdc sdc_cmds {# Quoting, braces and nested queries.
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+create_clock -name "vclk" -period 5 -waveform {0 2.5}
+create_clock -name clk_add -period 20 -add [get_ports clk1]
+set_input_delay -clock clk 1.5 [get_ports {in1 in2}]
+set_input_delay -clock "clk" -max 2 -add_delay [get_ports "in1"]
+set_output_delay -clock vclk -min 0.5 [get_ports out]
+set_output_delay -clock [get_clocks clk] \
+  -max 1 [all_outputs]
+set_false_path -from [get_clocks {clk}] -to [get_clocks vclk]
+set_false_path -through [get_pins -of_objects [get_cells u1]]
+set_multicycle_path -setup 2 -from [get_pins r1/CK] -to [get_pins {r3/D}]
+set_load 0.05 [get_ports out]
+set_max_transition 0.4 [get_ports out]
+set delay 0.7
+set_input_delay -clock clk -min $delay [all_inputs]
+}
+
+compare_read_sdc sdc_warn {create_clock -name clk -period 10 clk1
+set_input_delay -clock clk 1 [get_ports {in1 nope}]
+}
+
+compare_read_sdc sdc_add_error {create_clock -period 10 -add clk1
+}
+
+compare_read_sdc sdc_period_error {create_clock -name clk -period 10 clk1
+create_clock -name clk2 [get_ports clk2]
+set_input_delay -clock clk 1 [get_ports in1]
+}
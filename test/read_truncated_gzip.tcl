@@ -0,0 +1,4 @@
+# Decompression errors are reported instead of ending the file early.
+read_liberty ../examples/nangate45_slow.lib
+catch {read_verilog truncated.v.gz} msg
+puts $msg
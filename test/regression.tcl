@@ -14,29 +14,35 @@
 # You should have received a copy of the GNU General Public License
 # along with this program. If not, see <https://www.gnu.org/licenses/>.
 
-#  regression -help | [-threads threads] [-valgrind] [-report_stats] test1 [test2...]
+#  regression -help | [-threads threads] [-valgrind] [-report_stats]
+#    [-save_perf] [-check_perf] test1 [test2...]
 
 proc regression_main {} {
   setup
   parse_args
+  read_perf_baseline
   run_tests
+  write_perf_baseline
   show_summary
   exit [found_errors]
 }
 
 proc setup {} {
-  global result_dir diff_file failure_file errors 
+  global result_dir diff_file failure_file perf_file errors 
   global use_valgrind valgrind_shared_lib_failure
-  global report_stats
+  global report_stats save_perf check_perf
 
   set use_valgrind 0
   set report_stats 0
+  set save_perf 0
+  set check_perf 0
 
   if { !([file exists $result_dir] && [file isdirectory $result_dir]) } {
     file mkdir $result_dir
   }
   file delete $diff_file
   file delete $failure_file
+  file delete $perf_file
 
   set errors(error) 0
   set errors(memory) 0
@@ -44,6 +50,7 @@ proc setup {} {
   set errors(fail) 0
   set errors(no_cmd) 0
   set errors(no_ok) 0
+  set errors(perf) 0
   set valgrind_shared_lib_failure 0
 }
 
@@ -51,17 +58,19 @@ proc parse_args {} {
   global argv app_options tests test_groups cmd_paths
   global use_valgrind
   global result_dir tests
-  global report_stats
+  global report_stats save_perf check_perf perf_baseline_file
 
   while { $argv != {} } {
     set arg [lindex $argv 0]
     if { $arg == "help" || $arg == "-help" } {
-      puts {Usage: regression [-help] [-threads threads] [-valgrind] [-report_stats] tests...}
+      puts {Usage: regression [-help] [-threads threads] [-valgrind] [-report_stats] [-save_perf] [-check_perf] tests...}
       puts "  -threads max|integer - number of threads to use"
       puts "  -valgrind - run valgrind (linux memory checker)"
       puts "  -report_stats - report run time and memory"
+      puts "  -save_perf - save run time and memory in $perf_baseline_file"
+      puts "  -check_perf - report run time and memory regressions from the baseline"
       puts "  Wildcarding for test names is supported (enclose in \"'s)"
-      puts "  Tests are: all, fast, med, slow, or a test group or test name"
+      puts "  Tests are: all, fast, med, slow, perf, or a test group or test name"
       puts ""
       puts "  If 'limit coredumpsize unlimited' corefiles are saved in $result_dir/test.core"
       exit
@@ -80,6 +89,14 @@ proc parse_args {} {
     } elseif { $arg == "-report_stats" } {
       set report_stats 1
       set argv [lrange $argv 1 end]
+    } elseif { $arg == "-save_perf" } {
+      set save_perf 1
+      set report_stats 1
+      set argv [lrange $argv 1 end]
+    } elseif { $arg == "-check_perf" } {
+      set check_perf 1
+      set report_stats 1
+      set argv [lrange $argv 1 end]
     } else {
       break
     }
@@ -102,12 +119,12 @@ proc expand_tests { argv } {
     } elseif { [string first "*" $arg] != -1 \
 	       || [string first "?" $arg] != -1 } {
       # Find wildcard matches.
-      foreach test [group_tests "all"] {
+      foreach test [recorded_tests] {
 	if [string match $arg $test] {
 	  lappend tests $test
 	}
       }
-    } elseif { [lsearch [group_tests "all"] $arg] != -1 } {
+    } elseif { [lsearch [recorded_tests] $arg] != -1 } {
       lappend tests $arg
     } else {
       puts "Error: test $arg not found."
@@ -129,6 +146,7 @@ proc run_tests {} {
 
 proc run_test { test } {
   global result_dir diff_file errors diff_options report_stats
+  global check_perf perf_design_sizes
   
   set cmd_file [test_cmd_file $test]
   if [file exists $cmd_file] {
@@ -172,8 +190,19 @@ proc run_test { test } {
       if { $report_stats } {
 	append error_msg " [test_stats_summary $test]"
       }
+      if { $check_perf } {
+	set regressions [test_perf_regressions $test]
+	if { $regressions != {} } {
+	  append error_msg " *PERF* [join $regressions {, }]"
+	  append_perf_regression $test $regressions
+	  incr errors(perf)
+	}
+      }
       
-      if [file exists $ok_file] {
+      if { [info exists perf_design_sizes($test)] } {
+	# Perf tests have no ok file.
+	puts " pass$error_msg"
+      } elseif [file exists $ok_file] {
 	# Filter dos '/r's from log file.
 	set tmp_file [file join $result_dir $test.tmp]
 	exec tr -d "\r" < $log_file > $tmp_file
@@ -231,6 +260,80 @@ proc test_stats_summary { test } {
   return "$elapsed $user $mem"
 }
 
+################################################################
+
+# Baseline stats by test from perf_baseline_file.
+proc read_perf_baseline {} {
+  global perf_baseline perf_baseline_file save_perf check_perf
+
+  array unset perf_baseline
+  if { ($save_perf || $check_perf)
+       && ![catch {open $perf_baseline_file r} stream] } {
+    while { [gets $stream line] >= 0 } {
+      if { [llength $line] == 4 && [string index $line 0] != "#" } {
+	set perf_baseline([lindex $line 0]) [lrange $line 1 end]
+      }
+    }
+    close $stream
+  }
+}
+
+# Merge the stats of the tests that ran into the baseline.
+proc write_perf_baseline {} {
+  global perf_baseline perf_baseline_file save_perf tests
+
+  if { $save_perf } {
+    foreach test $tests {
+      set stats [test_stats $test]
+      if { [llength $stats] == 3 } {
+	set perf_baseline($test) $stats
+      }
+    }
+    set stream [open $perf_baseline_file w]
+    puts $stream "# test elapsed_seconds user_seconds peak_memory_bytes"
+    foreach test [lsort [array names perf_baseline]] {
+      puts $stream "$test $perf_baseline($test)"
+    }
+    close $stream
+  }
+}
+
+# Return a list of the stats that exceed the baseline thresholds.
+proc test_perf_regressions { test } {
+  global perf_baseline perf_time_threshold perf_memory_threshold
+  global perf_min_time
+
+  set regressions {}
+  if { [info exists perf_baseline($test)] } {
+    set stats [test_stats $test]
+    foreach name {elapsed user memory} value $stats base $perf_baseline($test) {
+      if { [string is double -strict $value]
+	   && [string is double -strict $base]
+	   && $base > 0 } {
+	if { $name == "memory" } {
+	  set threshold $perf_memory_threshold
+	  set compare 1
+	} else {
+	  set threshold $perf_time_threshold
+	  set compare [expr max($value, $base) >= $perf_min_time]
+	}
+	set ratio [expr double($value) / $base]
+	if { $compare && $ratio > $threshold } {
+	  lappend regressions [format "%s %.2fx" $name $ratio]
+	}
+      }
+    }
+  }
+  return $regressions
+}
+
+proc append_perf_regression { test regressions } {
+  global perf_file perf_baseline
+  set perf_ch [open $perf_file "a"]
+  puts $perf_ch "$test [join $regressions {, }] (stats [test_stats $test] baseline $perf_baseline($test))"
+  close $perf_ch
+}
+
 proc append_failure { test } {
   global failure_file
   set fail_ch [open $failure_file "a"]
@@ -250,7 +353,7 @@ proc run_test_app { test cmd_file log_file } {
 
 proc run_test_plain { test cmd_file log_file } {
   global app_path app_options result_dir errorCode
-  global report_stats
+  global report_stats perf_design_sizes
   global test_expect_eror
 
   if { ![file exists $app_path] } {
@@ -258,8 +361,17 @@ proc run_test_plain { test cmd_file log_file } {
   } elseif { ![file executable $app_path] } {
     return "ERROR $app_path is not executable."
   } else {
+    if { [info exists perf_design_sizes($test)] } {
+      set design_dir [perf_design_dir $perf_design_sizes($test)]
+      if { [catch {make_perf_design $perf_design_sizes($test) $design_dir} error] } {
+	return "ERROR $error"
+      }
+    }
     set run_file [test_run_file $test]
     set run_stream [open $run_file "w"]
+    if { [info exists perf_design_sizes($test)] } {
+      puts $run_stream "set perf_design_dir [file normalize $design_dir]"
+    }
     puts $run_stream "cd [file dirname $cmd_file]"
     puts $run_stream "source [file tail $cmd_file]"
     if { $report_stats } {
@@ -290,6 +402,23 @@ proc run_test_plain { test cmd_file log_file } {
   }
 }
 
+# Generate the benchmark design for perf tests in a separate process
+# so the generation time is not included in the test stats.
+# The design is kept in result_dir for later runs.
+proc make_perf_design { size design_dir } {
+  global app_path app_options test_dir
+
+  if { ![file exists [file join $design_dir bench.spef]] } {
+    file mkdir $design_dir
+    set gen_file [file join $design_dir generate.tcl]
+    set gen_stream [open $gen_file "w"]
+    puts $gen_stream "source [file join $test_dir bench bench_design.tcl]"
+    puts $gen_stream "bench::write_design [file normalize $design_dir] \[bench::design_params $size\]"
+    close $gen_stream
+    exec $app_path -no_init -no_splash -exit $gen_file
+  }
+}
+
 proc run_test_valgrind { test cmd_file log_file } {
   global app_path app_options valgrind_options result_dir errorCode
   
@@ -388,7 +517,7 @@ proc cleanse_valgrind_logfile { test log_file } {
 
 proc show_summary {} {
   global errors tests diff_file result_dir valgrind_shared_lib_failure
-  global app_path app
+  global app_path app perf_file
   
   puts "------------------------------------------------------"
   set test_count [llength $tests]
@@ -411,9 +540,15 @@ proc show_summary {} {
     if { $errors(no_cmd) != 0 } {
       puts "No cmd tcl file for $errors(no_cmd)/$test_count"
     }
+    if { $errors(perf) != 0 } {
+      puts "Performance regressions in $errors(perf)/$test_count"
+    }
     if { $errors(fail) != 0 } {
       puts "See $diff_file for differences"
     }
+    if { $errors(perf) != 0 } {
+      puts "See $perf_file for run time and memory regressions"
+    }
   } else {
     puts "Passed $test_count"
   }
@@ -428,7 +563,8 @@ proc found_errors {} {
   
   return [expr $errors(error) != 0 || $errors(fail) != 0 \
 	    || $errors(no_cmd) != 0 || $errors(no_ok) != 0 \
-	    || $errors(memory) != 0 || $errors(leak) != 0]
+	    || $errors(memory) != 0 || $errors(leak) != 0 \
+	    || $errors(perf) != 0]
 }
 
 ################################################################
@@ -521,6 +657,11 @@ proc test_stats_file { test } {
   return [file join $result_dir "$test.stats"]
 }
 
+proc perf_design_dir { size } {
+  global result_dir
+  return [file join $result_dir "perf_design_$size"]
+}
+
 proc test_core_file { test } {
   global result_dir
   return [file join $result_dir $test.core]
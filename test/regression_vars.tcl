@@ -28,6 +28,18 @@ set result_dir [file join $test_dir "results"]
 set diff_file [file join $result_dir "diffs"]
 # File containing list of failed tests.
 set failure_file [file join $result_dir "failures"]
+# Performance regressions found by -check_perf.
+set perf_file [file join $result_dir "perf"]
+# Test run times and peak memory written by -save_perf and compared
+# by -check_perf.
+set perf_baseline_file [file join $test_dir "perf_baseline"]
+# A test regresses when its elapsed or user time exceeds the baseline
+# by perf_time_threshold or its peak memory exceeds the baseline by
+# perf_memory_threshold.
+set perf_time_threshold 1.25
+set perf_memory_threshold 1.15
+# Times shorter than perf_min_time seconds are too noisy to compare.
+set perf_min_time 1.0
 # Use the DIFF_OPTIONS envar to change the diff options
 # (Solaris diff doesn't support this envar)
 set diff_options "-c"
@@ -78,6 +90,18 @@ proc record_example_tests { tests } {
   }
 }
 
+# Record perf tier tests in the $STA/test/bench directory.
+# Each test runs the benchmark design of size (see bench/bench_design.tcl).
+# Perf tests are only run on demand with the perf test group and have
+# no ok files.
+proc record_perf_test { test size } {
+  global test_dir cmd_dirs test_groups perf_design_sizes
+  set cmd_dirs($test) [file join $test_dir bench]
+  set perf_design_sizes($test) $size
+  lappend test_groups(perf) $test
+  return $test
+}
+
 ################################################################
 
 proc define_test_group { name tests } {
@@ -90,6 +114,16 @@ proc group_tests { name } {
   return $test_groups($name)
 }
 
+# Tests that can be named on the command line.
+proc recorded_tests {} {
+  global test_groups
+  set tests [group_tests all]
+  if { [info exists test_groups(perf)] } {
+    set tests [concat $tests $test_groups(perf)]
+  }
+  return $tests
+}
+
 # Clear the test lists.
 proc clear_tests {} {
   global test_groups
@@ -124,6 +158,21 @@ record_example_tests {
 record_sta_tests {
   ccs_sim1
   verilog_attribute
+  share_delays_mode
+  freeze_timing_edit
+  get_cells_index
+  read_truncated_gzip
+  read_sdc_native
+  parasitics_cache
+  activity_cache
+  timing_server
+  timing_snapshot
+  what_if
+  netlist_db
+  liberty_db
 }
 
 define_test_group fast [group_tests all]
+
+record_perf_test perf_medium medium
+record_perf_test perf_large large
@@ -0,0 +1,20 @@
+# Annotated delays of a corner that shared its delays with an
+# equivalent corner survive a mode switch.
+define_corners c1 c2
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+sta::find_timing
+read_sdf -corner c2 ../examples/example1.sdf
+define_mode m2
+set_current_mode m2
+sta::find_timing
+
+set edge [lindex [get_timing_edges -from r1/CK -to r1/Q] 0]
+set corner [sta::find_corner c2]
+foreach arc [$edge timing_arcs] {
+  set delay [$edge arc_delay $arc $corner max]
+  set annotated [$edge delay_annotated $arc $corner max]
+  puts "c2 [$arc from_edge] -> [$arc to_edge] [sta::format_time $delay 2] annotated $annotated"
+}
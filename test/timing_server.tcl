@@ -0,0 +1,53 @@
+# start_server -no_wait answers requests from a client in the same
+# process while the event loop runs.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+
+set port 48721
+start_server -port $port -no_wait
+set client [socket localhost $port]
+fconfigure $client -translation binary -blocking 0 -buffering full
+
+proc read_reply { client } {
+  global reply reply_done
+  append reply [read $client]
+  if { [eof $client] } {
+    set reply_done 1
+  } elseif { [binary scan $reply cuI status output_length] == 2 } {
+    set result_start [expr 9 + $output_length]
+    if { [binary scan $reply @[expr 5 + $output_length]I result_length] == 1
+         && [string length $reply] >= $result_start + $result_length } {
+      set reply_done 1
+    }
+  }
+}
+
+proc server_request { client cmd } {
+  global reply reply_done
+  set cmd [encoding convertto utf-8 $cmd]
+  puts -nonewline $client [binary format Ia* [string length $cmd] $cmd]
+  flush $client
+  set reply ""
+  set reply_done 0
+  fileevent $client readable [list read_reply $client]
+  vwait reply_done
+  fileevent $client readable {}
+  binary scan $reply cuI status output_length
+  set output [string range $reply 5 [expr 4 + $output_length]]
+  binary scan $reply @[expr 5 + $output_length]I result_length
+  set result_start [expr 9 + $output_length]
+  set result [string range $reply $result_start \
+                [expr $result_start + $result_length - 1]]
+  puts "status $status result {$result}"
+}
+
+server_request $client {get_full_name [get_cells u1]}
+server_request $client {get_property [get_cells u2] ref_name}
+server_request $client {no_such_command}
+close $client
+stop_server
+puts "server stopped [expr ![info exists sta::server_socket]]"
+if { [catch {start_server} msg] } {
+  puts $msg
+}
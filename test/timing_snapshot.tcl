@@ -0,0 +1,16 @@
+# write_timing_snapshot/read_timing_snapshot restore the delay calculation
+# results and reject snapshots written with different constraints.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+read_spef ../examples/example1.dspef
+with_output_to_variable checks { report_checks -fields {cap slew} }
+write_timing_snapshot results/example1.snapshot
+puts "read [read_timing_snapshot results/example1.snapshot]"
+with_output_to_variable snapshot_checks { report_checks -fields {cap slew} }
+puts "snapshot matches [expr {$snapshot_checks == $checks}]"
+set_load 0.1 [get_ports out]
+puts "read [read_timing_snapshot results/example1.snapshot]"
+puts "read [read_timing_snapshot ../examples/example1.v]"
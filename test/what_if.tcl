@@ -0,0 +1,30 @@
+# end_what_if undoes the edits made since begin_what_if unless -commit.
+read_liberty ../examples/nangate45_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+
+proc report_edits { when } {
+  set cell [get_property [get_cells u1] ref_name]
+  set nets [llength [get_nets -quiet what_if_net]]
+  puts "$when u1 $cell what_if_net $nets"
+}
+
+begin_what_if
+replace_cell u1 BUF_X4
+make_net what_if_net
+report_edits "what-if"
+end_what_if
+report_edits "discard"
+
+begin_what_if
+replace_cell u1 BUF_X4
+make_net what_if_net
+end_what_if -commit
+report_edits "commit"
+
+end_what_if
+begin_what_if
+if { [catch {begin_what_if} msg] } {
+  puts $msg
+}
+end_what_if
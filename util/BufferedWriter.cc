@@ -0,0 +1,95 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "BufferedWriter.hh"
+
+#include <cstdio>
+
+namespace sta {
+
+BufferedWriter::BufferedWriter()
+{
+}
+
+BufferedWriter::BufferedWriter(WriteFunc write) :
+  write_(write)
+{
+}
+
+void
+BufferedWriter::setWriteFunc(WriteFunc write)
+{
+  write_ = write;
+}
+
+void
+BufferedWriter::print(const char *fmt,
+                      ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  vprint(fmt, args);
+  va_end(args);
+}
+
+// Format short text on the stack and long text directly into the
+// buffer.
+void
+BufferedWriter::vprint(const char *fmt,
+                       va_list args)
+{
+  char tmp[256];
+  va_list args2;
+  va_copy(args2, args);
+  int length = vsnprintf(tmp, sizeof(tmp), fmt, args);
+  if (length >= 0) {
+    if (static_cast<size_t>(length) < sizeof(tmp))
+      text_.append(tmp, length);
+    else {
+      size_t size = text_.size();
+      text_.resize(size + length + 1);
+      vsnprintf(&text_[size], length + 1, fmt, args2);
+      text_.resize(size + length);
+    }
+  }
+  va_end(args2);
+  flushIfFull();
+}
+
+void
+BufferedWriter::append(const std::string &text)
+{
+  text_ += text;
+  flushIfFull();
+}
+
+void
+BufferedWriter::flushIfFull()
+{
+  if (write_ && text_.size() > flush_size)
+    flush();
+}
+
+void
+BufferedWriter::flush()
+{
+  if (write_ && !text_.empty()) {
+    write_(text_);
+    text_.clear();
+  }
+}
+
+} // namespace
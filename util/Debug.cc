@@ -17,6 +17,9 @@
 #include "Debug.hh"
 
 #include "Report.hh"
+#include "Profiler.hh"
+#include "SearchStats.hh"
+#include "Tracer.hh"
 
 namespace sta {
 
@@ -26,12 +29,18 @@ Debug::Debug(Report *report) :
   report_(report),
   debug_on_(false),
   debug_map_(nullptr),
-  stats_level_(0)
+  stats_level_(0),
+  profiler_(new Profiler),
+  search_stats_(new SearchStats),
+  tracer_(new Tracer)
 {
 }
 
 Debug::~Debug()
 {
+  delete profiler_;
+  delete search_stats_;
+  delete tracer_;
   if (debug_map_) {
     DebugMap::Iterator debug_iter(debug_map_);
     // Delete the debug map keys.
@@ -46,11 +55,10 @@ Debug::~Debug()
 }
 
 bool
-Debug::check(const char *what,
-	     int level) const
+Debug::checkMap(const char *what,
+                int level) const
 {
-  if (debug_on_
-      && debug_map_) {
+  if (debug_map_) {
     int dbg_level;
     bool exists;
     debug_map_->findKey(what, dbg_level, exists);
@@ -110,6 +118,7 @@ Debug::reportLine(const char *what,
 {
   va_list args;
   va_start(args, fmt);
+  std::unique_lock<std::mutex> lock(report_->buffer_lock_);
   report_->printToBuffer("%s", what);
   report_->printToBufferAppend(": ");
   report_->printToBufferAppend(fmt, args);
@@ -5,19 +5,30 @@
 
 #include "DispatchQueue.hh"
 
+#include "Machine.hh"
+#include "Tracer.hh"
+
 namespace sta {
 
 DispatchQueue::DispatchQueue(size_t thread_count) :
-  threads_(thread_count),
-  pending_task_count_(0)
+  thread_pinning_(false),
+  tasks_(new DispatchTask[task_count_]),
+  enqueue_pos_(0),
+  dequeue_pos_(0),
+  pending_task_count_(0),
+  parked_count_(0),
+  quit_(false),
+  tracer_(nullptr)
 {
-  for(size_t i = 0; i < thread_count; i++)
-    threads_[i] = std::thread(&DispatchQueue::dispatch_thread_handler, this, i);
+  for (size_t i = 0; i < task_count_; i++)
+    tasks_[i].sequence_.store(i, std::memory_order_relaxed);
+  startThreads(thread_count);
 }
 
 DispatchQueue::~DispatchQueue()
 {
   terminateThreads();
+  delete [] tasks_;
 }
 
 void
@@ -41,11 +52,41 @@ void
 DispatchQueue::setThreadCount(size_t thread_count)
 {
   terminateThreads();
+  quit_ = false;
+  startThreads(thread_count);
+}
 
+void
+DispatchQueue::setThreadPinning(bool enabled)
+{
+  if (enabled != thread_pinning_) {
+    size_t thread_count = threads_.size();
+    terminateThreads();
+    quit_ = false;
+    thread_pinning_ = enabled;
+    // Unpinned workers inherit the affinity of the calling thread.
+    startThreads(thread_count);
+  }
+}
+
+void
+DispatchQueue::startThreads(size_t thread_count)
+{
+  thread_processors_.clear();
+  if (thread_pinning_) {
+    std::vector<std::vector<int>> nodes = numaNodeProcessors();
+    size_t node_count = nodes.size();
+    std::vector<size_t> node_thread_counts(node_count, 0);
+    for (size_t i = 0; i < thread_count; i++) {
+      size_t node = i * node_count / thread_count;
+      const std::vector<int> &processors = nodes[node];
+      size_t index = node_thread_counts[node]++;
+      thread_processors_.push_back(processors[index % processors.size()]);
+    }
+  }
   threads_.resize(thread_count);
-  for(size_t i = 0; i < thread_count; i++) {
+  for (size_t i = 0; i < thread_count; i++)
     threads_[i] = std::thread(&DispatchQueue::dispatch_thread_handler, this, i);
-  }
 }
 
 void
@@ -56,53 +97,125 @@ DispatchQueue::finishTasks()
 }
 
 void
-DispatchQueue::dispatch(const fp_t& op)
+DispatchQueue::setTracer(Tracer *tracer)
 {
-  std::unique_lock<std::mutex> lock(lock_);
-  q_.push(op);
-  pending_task_count_++;
+  tracer_ = tracer;
+}
 
-  // Manual unlocking is done before notifying, to avoid waking up
-  // the waiting thread only to block again (see notify_one for details)
-  lock.unlock();
-  cv_.notify_all();
+void
+DispatchQueue::dispatch(const fp_t& op)
+{
+  dispatch<const fp_t&>(op);
 }
 
 void
 DispatchQueue::dispatch(fp_t&& op)
 {
-  std::unique_lock<std::mutex> lock(lock_);
-  q_.push(std::move(op));
-  pending_task_count_++;
+  dispatch<fp_t>(std::move(op));
+}
 
-  // Manual unlocking is done before notifying, to avoid waking up
-  // the waiting thread only to block again (see notify_one for details)
-  lock.unlock();
-  cv_.notify_all();
+size_t
+DispatchQueue::claimTask()
+{
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    DispatchTask &task = tasks_[pos & task_mask_];
+    size_t seq = task.sequence_.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+        return pos;
+    }
+    else {
+      // The queue is full; wait for the workers to catch up.
+      if (diff < 0)
+        std::this_thread::yield();
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
 }
 
 void
-DispatchQueue::dispatch_thread_handler(size_t i)
+DispatchQueue::publishTask(size_t pos)
 {
-  std::unique_lock<std::mutex> lock(lock_);
-
-  do {
-    // Wait until we have data or a quit signal
-    cv_.wait(lock, [this] { return (q_.size() || quit_); } );
+  tasks_[pos & task_mask_].sequence_.store(pos + 1, std::memory_order_release);
+  if (parked_count_.load() > 0) {
+    // Taking the lock orders the notify after a parking worker starts
+    // waiting so the wakeup is not lost.
+    std::unique_lock<std::mutex> lock(lock_);
+    lock.unlock();
+    cv_.notify_one();
+  }
+}
 
-    //after wait, we own the lock
-    if(!quit_ && q_.size()) {
-      auto op = std::move(q_.front());
-      q_.pop();
+bool
+DispatchQueue::runTask(int thread)
+{
+  size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    DispatchTask &task = tasks_[pos & task_mask_];
+    size_t seq = task.sequence_.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        // The task runs in place, so the slot is not released for
+        // reuse until the task finishes.
+        runTask(task, thread);
+        task.sequence_.store(pos + task_mask_ + 1, std::memory_order_release);
+        pending_task_count_--;
+        return true;
+      }
+    }
+    else if (diff < 0)
+      return false;
+    else
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+  }
+}
 
-      lock.unlock();
+void
+DispatchQueue::runTask(DispatchTask &task,
+                       int thread)
+{
+  Tracer *tracer = tracer_;
+  if (tracer && tracer->enabled()) {
+    int64_t begin = tracer->now();
+    task.run_(task.storage_, thread);
+    tracer->record(thread + 1, "task", begin, tracer->now());
+  }
+  else
+    task.run_(task.storage_, thread);
+}
 
-      op(i);
+bool
+DispatchQueue::empty() const
+{
+  return dequeue_pos_.load() == enqueue_pos_.load();
+}
 
-      pending_task_count_--;
-      lock.lock();
+void
+DispatchQueue::dispatch_thread_handler(size_t i)
+{
+  if (i < thread_processors_.size())
+    bindThreadToProcessor(thread_processors_[i]);
+  while (!quit_) {
+    if (runTask(i))
+      continue;
+    bool found = false;
+    for (int spin = 0; spin < spin_count_ && !found && !quit_; spin++) {
+      std::this_thread::yield();
+      found = runTask(i);
+    }
+    if (!found) {
+      // Park until a task is dispatched or a quit signal.
+      std::unique_lock<std::mutex> lock(lock_);
+      parked_count_++;
+      cv_.wait(lock, [this] { return quit_ || !empty(); } );
+      parked_count_--;
     }
-  } while (!quit_);
+  }
 }
 
 } // namespace
@@ -16,8 +16,11 @@
 
 #include "Hash.hh"
 
+#include <cstdio>
 #include <cstring>
 
+#include "Error.hh"
+
 namespace sta {
 
 size_t
@@ -30,4 +33,42 @@ hashString(const char *str)
   return hash;
 }
 
+static const uint64_t fnv_offset_basis = 14695981039346656037ULL;
+static const uint64_t fnv_prime = 1099511628211ULL;
+
+static void
+fnvHash(uint64_t &hash,
+        const char *bytes,
+        size_t length)
+{
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<unsigned char>(bytes[i]);
+    hash *= fnv_prime;
+  }
+}
+
+std::string
+fileContentsHash(const char *key,
+                 const Vector<const char*> &filenames)
+{
+  uint64_t hash = fnv_offset_basis;
+  // Include the terminating nulls to separate the names.
+  fnvHash(hash, key, strlen(key) + 1);
+  char buffer[1 << 16];
+  for (const char *filename : filenames) {
+    FILE *stream = fopen(filename, "rb");
+    if (stream == nullptr)
+      throw FileNotReadable(filename);
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), stream)) > 0)
+      fnvHash(hash, buffer, length);
+    fclose(stream);
+    fnvHash(hash, "", 1);
+  }
+  char digest[17];
+  snprintf(digest, sizeof(digest), "%016llx",
+           static_cast<unsigned long long>(hash));
+  return digest;
+}
+
 } // namespace
@@ -0,0 +1,512 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "InputFile.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Mutex.hh"
+#include "Report.hh"
+
+#ifdef ZSTD_FOUND
+  #include <zstd.h>
+#endif
+
+#if !defined(_WIN32)
+  #define STA_HAVE_MMAP
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+namespace sta {
+
+static bool
+isZstdMagic(const unsigned char *magic)
+{
+  // 0xFD2FB528 little endian.
+  return magic[0] == 0x28
+    && magic[1] == 0xb5
+    && magic[2] == 0x2f
+    && magic[3] == 0xfd;
+}
+
+// Decompress a file into blocks on a separate thread so reading the
+// decompressed text overlaps decompressing the text that follows.
+// Block buffers are recycled between the threads so steady state
+// reading does not allocate.
+class InputFileReadAhead
+{
+public:
+  InputFileReadAhead();
+  ~InputFileReadAhead();
+  bool open(const char *filename);
+  // Return the next decompressed block.
+  // Return false at the end of the file.
+  bool nextBlock(const char *&block,
+                 size_t &size);
+  // Decompression error that ended the file early, or empty.
+  // Only valid after nextBlock returns false.
+  const std::string &error() const { return error_; }
+  const char *filename() const { return filename_.c_str(); }
+
+private:
+  void readBlocks();
+  // Return false at the end of the file.
+  bool readBlock(std::string &block);
+  bool readGzipBlock(std::string &block);
+
+  gzFile stream_;
+#ifdef ZSTD_FOUND
+  bool openZstd(const char *filename);
+  bool readZstdBlock(std::string &block);
+
+  FILE *zstd_file_;
+  ZSTD_DStream *zstd_stream_;
+  std::vector<char> zstd_in_;
+  ZSTD_inBuffer zstd_in_buffer_;
+#endif
+  std::thread thread_;
+  std::mutex lock_;
+  std::condition_variable cond_;
+  std::deque<std::string> blocks_;
+  // Blocks the reader is done with for the next reads to reuse.
+  std::vector<std::string> free_blocks_;
+  // Block returned by nextBlock.
+  std::string block_;
+  std::string filename_;
+  // Written by the read ahead thread before it sets eof_.
+  std::string error_;
+  bool eof_;
+  bool stop_;
+
+  static constexpr size_t block_size_ = 1 << 20;
+  static constexpr size_t max_blocks_ = 4;
+};
+
+InputFileReadAhead::InputFileReadAhead() :
+  stream_(nullptr),
+#ifdef ZSTD_FOUND
+  zstd_file_(nullptr),
+  zstd_stream_(nullptr),
+#endif
+  eof_(false),
+  stop_(false)
+{
+}
+
+InputFileReadAhead::~InputFileReadAhead()
+{
+  {
+    UniqueLock lock(lock_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+  if (stream_)
+    gzclose(stream_);
+#ifdef ZSTD_FOUND
+  if (zstd_stream_)
+    ZSTD_freeDStream(zstd_stream_);
+  if (zstd_file_)
+    fclose(zstd_file_);
+#endif
+}
+
+bool
+InputFileReadAhead::open(const char *filename)
+{
+  filename_ = filename;
+#ifdef ZSTD_FOUND
+  if (!openZstd(filename))
+#endif
+  {
+    // Use zlib to uncompress gzip'd files automagically.
+    stream_ = gzopen(filename, "rb");
+    if (stream_ == nullptr)
+      return false;
+  }
+  thread_ = std::thread(&InputFileReadAhead::readBlocks, this);
+  return true;
+}
+
+void
+InputFileReadAhead::readBlocks()
+{
+  bool more = true;
+  while (more) {
+    std::string block;
+    {
+      UniqueLock lock(lock_);
+      if (!free_blocks_.empty()) {
+        block.swap(free_blocks_.back());
+        free_blocks_.pop_back();
+      }
+    }
+    more = readBlock(block);
+    UniqueLock lock(lock_);
+    cond_.wait(lock, [this] () {
+      return stop_ || blocks_.size() < max_blocks_;
+    });
+    if (stop_)
+      return;
+    if (!block.empty())
+      blocks_.push_back(std::move(block));
+    if (!more)
+      eof_ = true;
+    lock.unlock();
+    cond_.notify_all();
+  }
+}
+
+bool
+InputFileReadAhead::nextBlock(const char *&block,
+                              size_t &size)
+{
+  UniqueLock lock(lock_);
+  cond_.wait(lock, [this] () {
+    return eof_ || !blocks_.empty();
+  });
+  if (blocks_.empty())
+    return false;
+  if (block_.capacity() > 0)
+    free_blocks_.push_back(std::move(block_));
+  block_ = std::move(blocks_.front());
+  blocks_.pop_front();
+  lock.unlock();
+  cond_.notify_all();
+  block = block_.data();
+  size = block_.size();
+  return true;
+}
+
+bool
+InputFileReadAhead::readBlock(std::string &block)
+{
+#ifdef ZSTD_FOUND
+  if (zstd_stream_)
+    return readZstdBlock(block);
+#endif
+  return readGzipBlock(block);
+}
+
+bool
+InputFileReadAhead::readGzipBlock(std::string &block)
+{
+  block.resize(block_size_);
+  size_t size = 0;
+  while (size < block_size_) {
+    int length = gzread(stream_, &block[size],
+                        static_cast<unsigned>(block_size_ - size));
+    if (length <= 0) {
+      // Truncated files return the data that could be decompressed
+      // before the error.
+      int errnum;
+      const char *error = gzerror(stream_, &errnum);
+      if (errnum != Z_OK) {
+        // gzerror prefixes the error with the file name.
+        size_t prefix_length = filename_.size() + 2;
+        if (strncmp(error, filename_.c_str(), filename_.size()) == 0
+            && strlen(error) > prefix_length)
+          error += prefix_length;
+        error_ = error;
+      }
+      break;
+    }
+    size += length;
+  }
+  block.resize(size);
+  return size == block_size_;
+}
+
+#ifdef ZSTD_FOUND
+
+// Regular files starting with the zstd magic number are read with
+// the zstd streaming decompressor.
+bool
+InputFileReadAhead::openZstd(const char *filename)
+{
+  FILE *file = fopen(filename, "rb");
+  if (file == nullptr)
+    return false;
+#ifdef STA_HAVE_MMAP
+  // Peeking at pipes would lose the text.
+  struct stat file_stat;
+  if (fstat(fileno(file), &file_stat) != 0
+      || !S_ISREG(file_stat.st_mode)) {
+    fclose(file);
+    return false;
+  }
+#endif
+  unsigned char magic[4];
+  if (fread(magic, 1, 4, file) != 4
+      || !isZstdMagic(magic)) {
+    fclose(file);
+    return false;
+  }
+  rewind(file);
+  zstd_file_ = file;
+  zstd_stream_ = ZSTD_createDStream();
+  ZSTD_initDStream(zstd_stream_);
+  zstd_in_.resize(ZSTD_DStreamInSize());
+  zstd_in_buffer_.src = zstd_in_.data();
+  zstd_in_buffer_.size = 0;
+  zstd_in_buffer_.pos = 0;
+  return true;
+}
+
+bool
+InputFileReadAhead::readZstdBlock(std::string &block)
+{
+  block.resize(block_size_);
+  ZSTD_outBuffer out = {&block[0], block_size_, 0};
+  while (out.pos < out.size) {
+    if (zstd_in_buffer_.pos == zstd_in_buffer_.size) {
+      size_t length = fread(zstd_in_.data(), 1, zstd_in_.size(), zstd_file_);
+      zstd_in_buffer_.size = length;
+      zstd_in_buffer_.pos = 0;
+      if (length == 0) {
+        // Flush output the decompressor is holding.
+        size_t pos = out.pos;
+        size_t result = ZSTD_decompressStream(zstd_stream_, &out,
+                                              &zstd_in_buffer_);
+        if (ZSTD_isError(result)) {
+          error_ = ZSTD_getErrorName(result);
+          break;
+        }
+        if (out.pos == pos) {
+          // The decompressor returns 0 when a frame is complete.
+          if (result != 0)
+            error_ = "truncated zstd frame";
+          break;
+        }
+        continue;
+      }
+    }
+    size_t result = ZSTD_decompressStream(zstd_stream_, &out,
+                                          &zstd_in_buffer_);
+    if (ZSTD_isError(result)) {
+      error_ = ZSTD_getErrorName(result);
+      break;
+    }
+  }
+  block.resize(out.pos);
+  return out.pos == block_size_;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////
+
+InputFile::InputFile() :
+  read_ahead_(nullptr),
+  block_(nullptr),
+  block_size_(0),
+  block_pos_(0),
+  map_(nullptr),
+  map_size_(0),
+  map_pos_(0),
+  is_buffer_(false),
+  empty_(false)
+{
+}
+
+InputFile::~InputFile()
+{
+  close();
+}
+
+bool
+InputFile::open(const char *filename)
+{
+  close();
+  if (openMapped(filename))
+    return true;
+  read_ahead_ = new InputFileReadAhead;
+  if (read_ahead_->open(filename))
+    return true;
+  delete read_ahead_;
+  read_ahead_ = nullptr;
+  return false;
+}
+
+void
+InputFile::openBuffer(const char *buffer,
+                      size_t size)
+{
+  close();
+  if (size == 0)
+    empty_ = true;
+  else {
+    map_ = buffer;
+    map_size_ = size;
+    is_buffer_ = true;
+  }
+}
+
+// Map the file if it is not gzip'd.
+bool
+InputFile::openMapped(const char *filename)
+{
+#ifdef STA_HAVE_MMAP
+  int fd = ::open(filename, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0
+      || !S_ISREG(file_stat.st_mode)) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = file_stat.st_size;
+  if (size == 0) {
+    ::close(fd);
+    empty_ = true;
+    return true;
+  }
+  unsigned char magic[4];
+  if ((size >= 2
+       && ::pread(fd, magic, 2, 0) == 2
+       // gzip magic number.
+       && magic[0] == 0x1f
+       && magic[1] == 0x8b)
+      || (size >= 4
+          && ::pread(fd, magic, 4, 0) == 4
+          && isZstdMagic(magic))) {
+    ::close(fd);
+    return false;
+  }
+  void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file open.
+  ::close(fd);
+  if (map == MAP_FAILED)
+    return false;
+  // The advice values are not flags, so they cannot be or'ed.
+  madvise(map, size, MADV_SEQUENTIAL);
+  madvise(map, size, MADV_WILLNEED);
+  map_ = static_cast<const char*>(map);
+  map_size_ = size;
+  map_pos_ = 0;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+InputFile::close()
+{
+#ifdef STA_HAVE_MMAP
+  if (map_ && !is_buffer_)
+    munmap(const_cast<char*>(map_), map_size_);
+#endif
+  map_ = nullptr;
+  map_size_ = 0;
+  map_pos_ = 0;
+  is_buffer_ = false;
+  empty_ = false;
+  delete read_ahead_;
+  read_ahead_ = nullptr;
+  block_ = nullptr;
+  block_size_ = 0;
+  block_pos_ = 0;
+}
+
+bool
+InputFile::isOpen() const
+{
+  return map_ || empty_ || read_ahead_;
+}
+
+size_t
+InputFile::read(char *buf,
+                size_t max_size)
+{
+  if (map_) {
+    size_t size = map_size_ - map_pos_;
+    if (size > max_size)
+      size = max_size;
+    memcpy(buf, map_ + map_pos_, size);
+    map_pos_ += size;
+    return size;
+  }
+  else {
+    // Read whole blocks rather than lines; the lexers do not need
+    // line at a time input.
+    size_t size = 0;
+    while (size < max_size
+           && (block_pos_ < block_size_ || nextBlock())) {
+      size_t length = std::min(block_size_ - block_pos_, max_size - size);
+      memcpy(buf + size, block_ + block_pos_, length);
+      block_pos_ += length;
+      size += length;
+    }
+    return size;
+  }
+}
+
+// Decompression errors are reported rather than treated as the end
+// of the file.
+bool
+InputFile::nextBlock()
+{
+  block_pos_ = 0;
+  block_size_ = 0;
+  if (read_ahead_) {
+    if (read_ahead_->nextBlock(block_, block_size_))
+      return true;
+    const std::string &error = read_ahead_->error();
+    if (!error.empty())
+      Report::defaultReport()->error(1683, "failed to decompress %s: %s.",
+                                     read_ahead_->filename(), error.c_str());
+  }
+  return false;
+}
+
+int
+InputFile::getcNextBlock()
+{
+  if (nextBlock())
+    return static_cast<unsigned char>(block_[block_pos_++]);
+  else
+    return EOF;
+}
+
+void
+InputFile::getChars(char *buf,
+                    size_t &result,
+                    size_t max_size)
+{
+  result = read(buf, max_size);
+}
+
+void
+InputFile::getChars(char *buf,
+                    int &result,
+                    size_t max_size)
+{
+  result = static_cast<int>(read(buf, max_size));
+}
+
+} // namespace
@@ -77,4 +77,35 @@ memoryUsage()
   return rusage.ru_maxrss;
 }
 
+size_t
+memoryPeakUsage()
+{
+  struct rusage rusage;
+  getrusage(RUSAGE_SELF, &rusage);
+  return rusage.ru_maxrss;
+}
+
+std::vector<std::vector<int>>
+numaNodeProcessors()
+{
+  std::vector<std::vector<int>> nodes(1);
+  int processor_count = processorCount();
+  for (int processor = 0; processor < processor_count; processor++)
+    nodes[0].push_back(processor);
+  return nodes;
+}
+
+bool
+bindThreadToProcessor(int)
+{
+  return false;
+}
+
+void *
+allocHugePages(size_t,
+               bool)
+{
+  return nullptr;
+}
+
 } // namespace
@@ -19,8 +19,12 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <cstdint>
 #include <thread>
 
 #include "StaConfig.hh"
@@ -69,9 +73,10 @@ systemRunTime()
   return rusage.ru_stime.tv_sec + rusage.ru_stime.tv_usec * 1e-6;
 }
 
-// rusage->ru_maxrss is not set in linux so read it from /proc.
-size_t
-memoryUsage()
+// rusage->ru_maxrss is not set in linux so read memory sizes from
+// the /proc/<pid>/status field_name line (in bytes).
+static size_t
+procStatusMemory(const char *field_name)
 {
   string proc_filename;
   stringPrint(proc_filename, "/proc/%d/status", getpid());
@@ -82,11 +87,11 @@ memoryUsage()
     char line[line_length];
     while (fgets(line, line_length, status) != nullptr) {
       char *field = strtok(line, " \t");
-      if (field && stringEq(field, "VmRSS:")) {
+      if (field && stringEq(field, field_name)) {
 	char *size = strtok(nullptr, " \t");
 	if (size) {
 	  char *ignore;
-	  // VmRSS is in kilobytes.
+	  // Sizes are in kilobytes.
 	  memory = strtol(size, &ignore, 10) * 1000;
 	  break;
 	}
@@ -97,4 +102,116 @@ memoryUsage()
   return memory;
 }
 
+size_t
+memoryUsage()
+{
+  return procStatusMemory("VmRSS:");
+}
+
+size_t
+memoryPeakUsage()
+{
+  return procStatusMemory("VmHWM:");
+}
+
+// Parse a sysfs cpu list such as "0-15,32-47".
+static void
+parseCpuList(const char *cpu_list,
+             std::vector<int> &processors)
+{
+  const char *ptr = cpu_list;
+  while (*ptr) {
+    char *end;
+    long first = strtol(ptr, &end, 10);
+    if (end == ptr)
+      break;
+    long last = first;
+    ptr = end;
+    if (*ptr == '-') {
+      last = strtol(ptr + 1, &end, 10);
+      ptr = end;
+    }
+    for (long processor = first; processor <= last; processor++)
+      processors.push_back(processor);
+    if (*ptr == ',')
+      ptr++;
+    else
+      break;
+  }
+}
+
+std::vector<std::vector<int>>
+numaNodeProcessors()
+{
+  std::vector<std::vector<int>> nodes;
+  for (int node = 0; ; node++) {
+    string filename;
+    stringPrint(filename, "/sys/devices/system/node/node%d/cpulist", node);
+    FILE *stream = fopen(filename.c_str(), "r");
+    if (stream == nullptr)
+      break;
+    const int line_length = 1024;
+    char line[line_length];
+    std::vector<int> processors;
+    if (fgets(line, line_length, stream) != nullptr)
+      parseCpuList(line, processors);
+    fclose(stream);
+    if (!processors.empty())
+      nodes.push_back(processors);
+  }
+  if (nodes.empty()) {
+    nodes.resize(1);
+    int processor_count = processorCount();
+    for (int processor = 0; processor < processor_count; processor++)
+      nodes[0].push_back(processor);
+  }
+  return nodes;
+}
+
+bool
+bindThreadToProcessor(int processor)
+{
+  if (processor < 0 || processor >= CPU_SETSIZE)
+    return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(processor, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+}
+
+void *
+allocHugePages(size_t size,
+               bool explicit_pages)
+{
+  if (explicit_pages) {
+#ifdef MAP_HUGETLB
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    return (memory == MAP_FAILED) ? nullptr : memory;
+#else
+    return nullptr;
+#endif
+  }
+  else {
+    // Map an extra huge page and trim the ends to align the memory.
+    const size_t align = 2 << 20;
+    size_t map_size = size + align;
+    void *memory = mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+      return nullptr;
+    uintptr_t begin = reinterpret_cast<uintptr_t>(memory);
+    uintptr_t aligned = (begin + align - 1) & ~(align - 1);
+    uintptr_t end = begin + map_size;
+    if (aligned > begin)
+      munmap(memory, aligned - begin);
+    if (end > aligned + size)
+      munmap(reinterpret_cast<void*>(aligned + size), end - aligned - size);
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void*>(aligned);
+  }
+}
+
 } // namespace
@@ -53,4 +53,33 @@ memoryUsage()
   return 0;
 }
 
+size_t
+memoryPeakUsage()
+{
+  return 0;
+}
+
+std::vector<std::vector<int>>
+numaNodeProcessors()
+{
+  std::vector<std::vector<int>> nodes(1);
+  int processor_count = processorCount();
+  for (int processor = 0; processor < processor_count; processor++)
+    nodes[0].push_back(processor);
+  return nodes;
+}
+
+bool
+bindThreadToProcessor(int)
+{
+  return false;
+}
+
+void *
+allocHugePages(size_t,
+               bool)
+{
+  return nullptr;
+}
+
 } // namespace
@@ -0,0 +1,98 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "MemoryStats.hh"
+
+#include "Report.hh"
+
+namespace sta {
+
+void
+MemoryStats::add(const char *subsystem,
+                 const char *category,
+                 size_t count,
+                 size_t bytes)
+{
+  // Merge categories added more than once (one per library, corner...).
+  for (Entry &entry : entries_) {
+    if (entry.subsystem_ == subsystem
+        && entry.category_ == category) {
+      entry.count_ += count;
+      entry.bytes_ += bytes;
+      return;
+    }
+  }
+  entries_.push_back({subsystem, category, count, bytes});
+}
+
+size_t
+MemoryStats::bytes() const
+{
+  size_t bytes = 0;
+  for (const Entry &entry : entries_)
+    bytes += entry.bytes_;
+  return bytes;
+}
+
+size_t
+MemoryStats::bytes(const char *subsystem) const
+{
+  size_t bytes = 0;
+  for (const Entry &entry : entries_) {
+    if (entry.subsystem_ == subsystem)
+      bytes += entry.bytes_;
+  }
+  return bytes;
+}
+
+static double
+megabytes(size_t bytes)
+{
+  return bytes * 1e-6;
+}
+
+void
+MemoryStats::report(size_t process_memory,
+                    Report *report) const
+{
+  report->reportLine("%-14s %-22s %14s %12s",
+                     "Subsystem", "Category", "Count", "MB");
+  const std::string *subsystem = nullptr;
+  for (const Entry &entry : entries_) {
+    if (subsystem == nullptr || *subsystem != entry.subsystem_) {
+      subsystem = &entry.subsystem_;
+      report->reportLine("%-14s %-22s %14s %12.1f",
+                         subsystem->c_str(), "total", "",
+                         megabytes(bytes(subsystem->c_str())));
+    }
+    report->reportLine("%-14s %-22s %14zu %12.1f",
+                       "", entry.category_.c_str(), entry.count_,
+                       megabytes(entry.bytes_));
+  }
+  size_t accounted = bytes();
+  report->reportLine("%-37s %14s %12.1f", "Accounted", "", megabytes(accounted));
+  if (process_memory > 0) {
+    report->reportLine("%-37s %14s %12.1f", "Process", "",
+                       megabytes(process_memory));
+    size_t unaccounted = (process_memory > accounted)
+      ? process_memory - accounted
+      : 0;
+    report->reportLine("%-37s %14s %12.1f", "Unaccounted", "",
+                       megabytes(unaccounted));
+  }
+}
+
+} // namespace
@@ -0,0 +1,378 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "ObjectPool.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "MemoryStats.hh"
+
+namespace sta {
+
+static constexpr size_t object_pool_align = 16;
+static constexpr size_t object_pool_class_count =
+  objectPoolSizeMax / object_pool_align;
+static constexpr size_t object_pool_block_size = 64 * 1024;
+// Free objects a thread keeps per size class before it moves a batch
+// of them to the shared free list.
+static constexpr size_t object_pool_cache_max = 256;
+static constexpr size_t object_pool_batch = object_pool_cache_max / 2;
+
+struct ObjectPoolFree
+{
+  ObjectPoolFree *next_;
+};
+
+class ObjectPoolCache;
+
+// Free lists shared by all threads. Threads move objects to and from
+// them in batches, so the locks are rarely contended.
+class ObjectPoolShared
+{
+public:
+  ObjectPoolShared();
+
+  std::mutex class_locks_[object_pool_class_count];
+  ObjectPoolFree *free_[object_pool_class_count];
+  size_t free_count_[object_pool_class_count];
+  // Objects carved by threads that have exited.
+  std::atomic<size_t> carved_count_[object_pool_class_count];
+  std::atomic<size_t> block_bytes_;
+  std::mutex caches_lock_;
+  std::vector<ObjectPoolCache*> caches_;
+};
+
+ObjectPoolShared::ObjectPoolShared() :
+  block_bytes_(0)
+{
+  for (size_t size_class = 0; size_class < object_pool_class_count; size_class++) {
+    free_[size_class] = nullptr;
+    free_count_[size_class] = 0;
+    carved_count_[size_class] = 0;
+  }
+}
+
+// Never deleted so threads that exit after static destruction can
+// still return their objects.
+static ObjectPoolShared *
+objectPoolShared()
+{
+  static ObjectPoolShared *shared = new ObjectPoolShared;
+  return shared;
+}
+
+// Free objects and the block being carved of one thread.
+// The counts are only written by the owning thread so the memory
+// report can read them without locks or contended atomics.
+class ObjectPoolCache
+{
+public:
+  ObjectPoolCache();
+  // Return the free objects to the shared lists.
+  ~ObjectPoolCache();
+  void *alloc(size_t size_class);
+  void free(ObjectPoolFree *object,
+            size_t size_class);
+  size_t freeCount(size_t size_class) const;
+  size_t carvedCount(size_t size_class) const;
+
+private:
+  void *carve(size_t size_class);
+  void moveToShared(size_t size_class,
+                    size_t count);
+  void moveFromShared(size_t size_class);
+  static void increment(std::atomic<size_t> &count);
+  static void decrement(std::atomic<size_t> &count);
+
+  ObjectPoolFree *free_[object_pool_class_count];
+  std::atomic<size_t> free_count_[object_pool_class_count];
+  std::atomic<size_t> carved_count_[object_pool_class_count];
+  char *block_;
+  size_t block_left_;
+};
+
+ObjectPoolCache::ObjectPoolCache() :
+  block_(nullptr),
+  block_left_(0)
+{
+  for (size_t size_class = 0; size_class < object_pool_class_count; size_class++) {
+    free_[size_class] = nullptr;
+    free_count_[size_class] = 0;
+    carved_count_[size_class] = 0;
+  }
+  ObjectPoolShared *shared = objectPoolShared();
+  std::lock_guard<std::mutex> lock(shared->caches_lock_);
+  shared->caches_.push_back(this);
+}
+
+// The rest of the block being carved is abandoned.
+ObjectPoolCache::~ObjectPoolCache()
+{
+  ObjectPoolShared *shared = objectPoolShared();
+  std::lock_guard<std::mutex> lock(shared->caches_lock_);
+  for (size_t size_class = 0; size_class < object_pool_class_count; size_class++) {
+    moveToShared(size_class, free_count_[size_class]);
+    shared->carved_count_[size_class] += carved_count_[size_class];
+  }
+  auto itr = std::find(shared->caches_.begin(), shared->caches_.end(), this);
+  shared->caches_.erase(itr);
+}
+
+// Only the owning thread writes the counts, so they do not need
+// atomic read-modify-writes.
+void
+ObjectPoolCache::increment(std::atomic<size_t> &count)
+{
+  count.store(count.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+}
+
+void
+ObjectPoolCache::decrement(std::atomic<size_t> &count)
+{
+  count.store(count.load(std::memory_order_relaxed) - 1,
+              std::memory_order_relaxed);
+}
+
+void *
+ObjectPoolCache::alloc(size_t size_class)
+{
+  if (free_[size_class] == nullptr)
+    moveFromShared(size_class);
+  ObjectPoolFree *object = free_[size_class];
+  if (object) {
+    free_[size_class] = object->next_;
+    decrement(free_count_[size_class]);
+    return object;
+  }
+  return carve(size_class);
+}
+
+void *
+ObjectPoolCache::carve(size_t size_class)
+{
+  size_t object_size = (size_class + 1) * object_pool_align;
+  if (block_left_ < object_size) {
+    block_ = static_cast<char*>(::operator new(object_pool_block_size));
+    block_left_ = object_pool_block_size;
+    objectPoolShared()->block_bytes_.fetch_add(object_pool_block_size,
+                                               std::memory_order_relaxed);
+  }
+  increment(carved_count_[size_class]);
+  void *object = block_;
+  block_ += object_size;
+  block_left_ -= object_size;
+  return object;
+}
+
+void
+ObjectPoolCache::free(ObjectPoolFree *object,
+                      size_t size_class)
+{
+  object->next_ = free_[size_class];
+  free_[size_class] = object;
+  increment(free_count_[size_class]);
+  if (free_count_[size_class].load(std::memory_order_relaxed)
+      > object_pool_cache_max)
+    moveToShared(size_class, object_pool_batch);
+}
+
+// Move count objects from the front of the free list to the shared list.
+void
+ObjectPoolCache::moveToShared(size_t size_class,
+                              size_t count)
+{
+  if (count > 0) {
+    ObjectPoolFree *head = free_[size_class];
+    ObjectPoolFree *tail = head;
+    for (size_t i = 1; i < count; i++)
+      tail = tail->next_;
+    free_[size_class] = tail->next_;
+    free_count_[size_class].store(free_count_[size_class] - count,
+                                  std::memory_order_relaxed);
+    ObjectPoolShared *shared = objectPoolShared();
+    std::lock_guard<std::mutex> lock(shared->class_locks_[size_class]);
+    tail->next_ = shared->free_[size_class];
+    shared->free_[size_class] = head;
+    shared->free_count_[size_class] += count;
+  }
+}
+
+void
+ObjectPoolCache::moveFromShared(size_t size_class)
+{
+  ObjectPoolShared *shared = objectPoolShared();
+  std::lock_guard<std::mutex> lock(shared->class_locks_[size_class]);
+  ObjectPoolFree *head = shared->free_[size_class];
+  if (head) {
+    size_t count = 1;
+    ObjectPoolFree *tail = head;
+    while (count < object_pool_batch && tail->next_) {
+      tail = tail->next_;
+      count++;
+    }
+    shared->free_[size_class] = tail->next_;
+    shared->free_count_[size_class] -= count;
+    tail->next_ = free_[size_class];
+    free_[size_class] = head;
+    free_count_[size_class].store(free_count_[size_class] + count,
+                                  std::memory_order_relaxed);
+  }
+}
+
+size_t
+ObjectPoolCache::freeCount(size_t size_class) const
+{
+  return free_count_[size_class].load(std::memory_order_relaxed);
+}
+
+size_t
+ObjectPoolCache::carvedCount(size_t size_class) const
+{
+  return carved_count_[size_class].load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////
+
+// Trivially destructible so it can be used while the thread exits.
+static thread_local ObjectPoolCache *object_pool_cache = nullptr;
+static thread_local bool object_pool_cache_deleted = false;
+
+// Deletes the thread's cache when the thread exits.
+class ObjectPoolCacheOwner
+{
+public:
+  ~ObjectPoolCacheOwner();
+
+  ObjectPoolCache *cache_;
+};
+
+ObjectPoolCacheOwner::~ObjectPoolCacheOwner()
+{
+  object_pool_cache = nullptr;
+  object_pool_cache_deleted = true;
+  delete cache_;
+}
+
+static thread_local ObjectPoolCacheOwner object_pool_cache_owner;
+
+// Objects made and deleted after the thread's cache is deleted go
+// straight to the shared lists.
+static ObjectPoolCache *
+objectPoolCache()
+{
+  if (object_pool_cache == nullptr && !object_pool_cache_deleted) {
+    object_pool_cache = new ObjectPoolCache;
+    object_pool_cache_owner.cache_ = object_pool_cache;
+  }
+  return object_pool_cache;
+}
+
+static size_t
+objectPoolClass(size_t size)
+{
+  return (size + object_pool_align - 1) / object_pool_align - 1;
+}
+
+void *
+objectPoolAlloc(size_t size)
+{
+  if (size == 0 || size > objectPoolSizeMax)
+    return ::operator new(size);
+  size_t size_class = objectPoolClass(size);
+  ObjectPoolCache *cache = objectPoolCache();
+  if (cache)
+    return cache->alloc(size_class);
+  else {
+    ObjectPoolShared *shared = objectPoolShared();
+    {
+      std::lock_guard<std::mutex> lock(shared->class_locks_[size_class]);
+      ObjectPoolFree *object = shared->free_[size_class];
+      if (object) {
+        shared->free_[size_class] = object->next_;
+        shared->free_count_[size_class]--;
+        return object;
+      }
+    }
+    return ::operator new((size_class + 1) * object_pool_align);
+  }
+}
+
+// Objects deleted on a different thread than they were made on go
+// to the deleting thread's free list, which returns them to the
+// shared list when it grows too long or the thread exits.
+void
+objectPoolFree(void *object,
+               size_t size)
+{
+  if (object) {
+    if (size == 0 || size > objectPoolSizeMax)
+      ::operator delete(object);
+    else {
+      size_t size_class = objectPoolClass(size);
+      ObjectPoolFree *free = static_cast<ObjectPoolFree*>(object);
+      ObjectPoolCache *cache = objectPoolCache();
+      if (cache)
+        cache->free(free, size_class);
+      else {
+        ObjectPoolShared *shared = objectPoolShared();
+        std::lock_guard<std::mutex> lock(shared->class_locks_[size_class]);
+        free->next_ = shared->free_[size_class];
+        shared->free_[size_class] = free;
+        shared->free_count_[size_class]++;
+      }
+    }
+  }
+}
+
+void
+objectPoolMemoryStats(MemoryStats &stats)
+{
+  ObjectPoolShared *shared = objectPoolShared();
+  size_t carved_bytes = 0;
+  std::lock_guard<std::mutex> lock(shared->caches_lock_);
+  for (size_t size_class = 0; size_class < object_pool_class_count; size_class++) {
+    size_t object_size = (size_class + 1) * object_pool_align;
+    size_t carved = shared->carved_count_[size_class].load();
+    size_t free_count;
+    {
+      std::lock_guard<std::mutex> class_lock(shared->class_locks_[size_class]);
+      free_count = shared->free_count_[size_class];
+    }
+    for (const ObjectPoolCache *cache : shared->caches_) {
+      carved += cache->carvedCount(size_class);
+      free_count += cache->freeCount(size_class);
+    }
+    carved_bytes += carved * object_size;
+    if (free_count > 0) {
+      std::string category = "free " + std::to_string(object_size)
+        + " byte objects";
+      stats.add("object pool", category.c_str(), free_count,
+                free_count * object_size);
+    }
+  }
+  size_t block_bytes = shared->block_bytes_.load();
+  size_t blocks = block_bytes / object_pool_block_size;
+  stats.add("object pool", "unused block space", blocks,
+            block_bytes - carved_bytes);
+}
+
+} // namespace
@@ -0,0 +1,256 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "Profiler.hh"
+
+#include <cstdio>
+
+#include "Machine.hh"
+#include "Error.hh"
+#include "Report.hh"
+
+namespace sta {
+
+ProfileScope::ProfileScope(const char *name) :
+  name_(name),
+  count_(0),
+  elapsed_(0.0),
+  user_(0.0),
+  system_(0.0),
+  memory_delta_(0.0),
+  memory_peak_(0)
+{
+}
+
+ProfileScope::~ProfileScope()
+{
+  for (ProfileScope *child : children_)
+    delete child;
+}
+
+ProfileScope *
+ProfileScope::findChild(const std::string &name) const
+{
+  for (ProfileScope *child : children_) {
+    if (child->name_ == name)
+      return child;
+  }
+  return nullptr;
+}
+
+void
+ProfileScope::merge(ProfileScope *scope)
+{
+  count_ += scope->count_;
+  elapsed_ += scope->elapsed_;
+  user_ += scope->user_;
+  system_ += scope->system_;
+  memory_delta_ += scope->memory_delta_;
+  if (scope->memory_peak_ > memory_peak_)
+    memory_peak_ = scope->memory_peak_;
+  for (ProfileScope *child : scope->children_) {
+    ProfileScope *child1 = findChild(child->name_);
+    if (child1)
+      child1->merge(child);
+    else
+      children_.push_back(child);
+  }
+  scope->children_.clear();
+  delete scope;
+}
+
+////////////////////////////////////////////////////////////////
+
+Profiler::Profiler() :
+  enabled_(false),
+  root_(new ProfileScope(""))
+{
+}
+
+Profiler::~Profiler()
+{
+  for (Frame &frame : frames_)
+    delete frame.scope_;
+  delete root_;
+}
+
+void
+Profiler::setEnabled(bool enabled)
+{
+  enabled_ = enabled;
+}
+
+void
+Profiler::clear()
+{
+  for (ProfileScope *child : root_->children_)
+    delete child;
+  root_->children_.clear();
+}
+
+void
+Profiler::begin()
+{
+  Frame frame;
+  frame.scope_ = new ProfileScope("");
+  frame.elapsed_begin_ = elapsedRunTime();
+  frame.user_begin_ = userRunTime();
+  frame.system_begin_ = systemRunTime();
+  frame.memory_begin_ = memoryUsage();
+  frames_.push_back(frame);
+}
+
+ProfileScope *
+Profiler::parentScope() const
+{
+  return frames_.empty() ? root_ : frames_.back().scope_;
+}
+
+void
+Profiler::end(const char *name)
+{
+  if (!frames_.empty()) {
+    Frame frame = frames_.back();
+    frames_.pop_back();
+    ProfileScope *scope = frame.scope_;
+    size_t memory_end = memoryUsage();
+    scope->name_ = name;
+    scope->count_ = 1;
+    scope->elapsed_ = elapsedRunTime() - frame.elapsed_begin_;
+    scope->user_ = userRunTime() - frame.user_begin_;
+    scope->system_ = systemRunTime() - frame.system_begin_;
+    scope->memory_delta_ = static_cast<double>(memory_end)
+      - static_cast<double>(frame.memory_begin_);
+    scope->memory_peak_ = memoryPeakUsage();
+    ProfileScope *parent = parentScope();
+    ProfileScope *scope1 = parent->findChild(scope->name_);
+    if (scope1)
+      scope1->merge(scope);
+    else
+      parent->children_.push_back(scope);
+  }
+}
+
+void
+Profiler::discard()
+{
+  if (!frames_.empty()) {
+    ProfileScope *scope = frames_.back().scope_;
+    frames_.pop_back();
+    ProfileScope *parent = parentScope();
+    for (ProfileScope *child : scope->children_) {
+      ProfileScope *child1 = parent->findChild(child->name_);
+      if (child1)
+        child1->merge(child);
+      else
+        parent->children_.push_back(child);
+    }
+    scope->children_.clear();
+    delete scope;
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+static void
+reportScope(const ProfileScope *scope,
+            int depth,
+            Report *report)
+{
+  std::string name(depth * 2, ' ');
+  name += scope->name();
+  report->reportLine("%-32s %6zu %9.2f %9.2f %9.2f %9.1f %9.1f",
+                     name.c_str(),
+                     scope->count(),
+                     scope->elapsed(),
+                     scope->user(),
+                     scope->system(),
+                     scope->memoryDelta() * 1e-6,
+                     scope->memoryPeak() * 1e-6);
+  for (const ProfileScope *child : scope->children())
+    reportScope(child, depth + 1, report);
+}
+
+void
+Profiler::report(Report *report) const
+{
+  report->reportLine("%-32s %6s %9s %9s %9s %9s %9s",
+                     "Scope", "Count", "Elapsed", "User", "System",
+                     "Delta MB", "Peak MB");
+  report->reportLine("%s", std::string(32 + 6 * 10 + 1, '-').c_str());
+  for (const ProfileScope *child : root_->children())
+    reportScope(child, 0, report);
+}
+
+static void
+writeJsonString(const std::string &str,
+                FILE *stream)
+{
+  fputc('"', stream);
+  for (char ch : str) {
+    if (ch == '"' || ch == '\\')
+      fputc('\\', stream);
+    fputc(ch, stream);
+  }
+  fputc('"', stream);
+}
+
+static void
+writeJsonScope(const ProfileScope *scope,
+               int depth,
+               FILE *stream)
+{
+  std::string indent(depth * 2, ' ');
+  fprintf(stream, "%s{\"name\": ", indent.c_str());
+  writeJsonString(scope->name(), stream);
+  fprintf(stream, ", \"count\": %zu, \"elapsed\": %.6f, \"user\": %.6f, "
+          "\"system\": %.6f, \"memory_delta\": %.0f, \"memory_peak\": %zu",
+          scope->count(),
+          scope->elapsed(),
+          scope->user(),
+          scope->system(),
+          scope->memoryDelta(),
+          scope->memoryPeak());
+  fprintf(stream, ", \"children\": [");
+  bool first = true;
+  for (const ProfileScope *child : scope->children()) {
+    fprintf(stream, first ? "\n" : ",\n");
+    writeJsonScope(child, depth + 1, stream);
+    first = false;
+  }
+  if (!first)
+    fprintf(stream, "\n%s", indent.c_str());
+  fprintf(stream, "]}");
+}
+
+void
+Profiler::writeJson(const char *filename) const
+{
+  FILE *stream = fopen(filename, "w");
+  if (stream == nullptr)
+    throw FileNotWritable(filename);
+  fprintf(stream, "{\"scopes\": [");
+  bool first = true;
+  for (const ProfileScope *child : root_->children()) {
+    fprintf(stream, first ? "\n" : ",\n");
+    writeJsonScope(child, 1, stream);
+    first = false;
+  }
+  fprintf(stream, "\n]}\n");
+  fclose(stream);
+}
+
+} // namespace
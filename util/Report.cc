@@ -29,19 +29,33 @@ using std::min;
 
 Report *Report::default_ = nullptr;
 
+// Console output between bufferBegin/bufferEnd is written in blocks
+// of this size.
+static const size_t console_buffer_size = 1 << 16;
+// stdio buffer size for redirect and log files.
+static const size_t report_file_buffer_size = 1 << 20;
+
+static void
+setFileBuffer(FILE *stream)
+{
+  setvbuf(stream, nullptr, _IOFBF, report_file_buffer_size);
+}
+
 Report::Report() :
   log_stream_(nullptr),
   redirect_stream_(nullptr),
   redirect_to_string_(false),
   buffer_size_(1000),
   buffer_(new char[buffer_size_]),
-  buffer_length_(0)
+  buffer_length_(0),
+  console_buffer_depth_(0)
 {
   default_ = this;
 }
 
 Report::~Report()
 {
+  flushConsoleBuffer();
   delete [] buffer_;
 }
 
@@ -57,13 +71,23 @@ void
 Report::printLine(const char *line,
                   size_t length)
 {
-  printString(line, length);
-  printString("\n", 1);
+  // Hold the lock so lines from different threads are not mixed.
+  std::unique_lock<std::mutex> lock(print_lock_);
+  printString1(line, length);
+  printString1("\n", 1);
 }
 
 size_t
 Report::printString(const char *buffer,
                     size_t length)
+{
+  std::unique_lock<std::mutex> lock(print_lock_);
+  return printString1(buffer, length);
+}
+
+size_t
+Report::printString1(const char *buffer,
+                     size_t length)
 {
   size_t ret = length;
   if (redirect_to_string_)
@@ -71,6 +95,11 @@ Report::printString(const char *buffer,
   else {
     if (redirect_stream_)
       ret = min(ret, fwrite(buffer, sizeof(char), length, redirect_stream_));
+    else if (console_buffer_depth_ > 0) {
+      console_buffer_.append(buffer, length);
+      if (console_buffer_.size() >= console_buffer_size)
+        flushConsoleBuffer();
+    }
     else
       ret = min(ret, printConsole(buffer, length));
     if (log_stream_)
@@ -79,6 +108,31 @@ Report::printString(const char *buffer,
   return ret;
 }
 
+void
+Report::flushConsoleBuffer()
+{
+  if (!console_buffer_.empty()) {
+    printConsole(console_buffer_.c_str(), console_buffer_.size());
+    console_buffer_.clear();
+  }
+}
+
+void
+Report::bufferBegin()
+{
+  std::unique_lock<std::mutex> lock(print_lock_);
+  console_buffer_depth_++;
+}
+
+void
+Report::bufferEnd()
+{
+  std::unique_lock<std::mutex> lock(print_lock_);
+  if (console_buffer_depth_ > 0
+      && --console_buffer_depth_ == 0)
+    flushConsoleBuffer();
+}
+
 void
 Report::reportLine(const char *fmt, ...)
 {
@@ -175,6 +229,7 @@ Report::warn(int /* id */,
 {
   va_list args;
   va_start(args, fmt);
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   printToBuffer("Warning: ");
   printToBufferAppend(fmt, args);
   printBufferLine();
@@ -186,6 +241,7 @@ Report::vwarn(int /* id */,
               const char *fmt,
               va_list args)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   printToBuffer("Warning: ");
   printToBufferAppend(fmt, args);
   printBufferLine();
@@ -198,6 +254,7 @@ Report::fileWarn(int /* id */,
                  const char *fmt,
                  ...)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   va_list args;
   va_start(args, fmt);
   printToBuffer("Warning: %s line %d, ", filename, line);
@@ -213,6 +270,7 @@ Report::vfileWarn(int /* id */,
                   const char *fmt,
                   va_list args)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   printToBuffer("Warning: %s line %d, ", filename, line);
   printToBufferAppend(fmt, args);
   printBufferLine();
@@ -224,6 +282,7 @@ void
 Report::error(int /* id */,
               const char *fmt, ...)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   va_list args;
   va_start(args, fmt);
   // No prefix msg, no \n.
@@ -237,6 +296,7 @@ Report::verror(int /* id */,
                const char *fmt,
                va_list args)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   // No prefix msg, no \n.
   printToBuffer(fmt, args);
   throw ExceptionMsg(buffer_);
@@ -249,6 +309,7 @@ Report::fileError(int /* id */,
                   const char *fmt,
                   ...)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   va_list args;
   va_start(args, fmt);
   // No prefix msg, no \n.
@@ -265,6 +326,7 @@ Report::vfileError(int /* id */,
                    const char *fmt,
                    va_list args)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   // No prefix msg, no \n.
   printToBuffer("%s line %d, ", filename, line);
   printToBufferAppend(fmt, args);
@@ -278,6 +340,7 @@ Report::critical(int /* id */,
                  const char *fmt,
                  ...)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   va_list args;
   va_start(args, fmt);
   printToBuffer("Critical: ");
@@ -293,6 +356,7 @@ Report::fileCritical(int /* id */,
                      const char *fmt,
                      ...)
 {
+  std::unique_lock<std::mutex> lock(buffer_lock_);
   va_list args;
   va_start(args, fmt);
   printToBuffer("Critical: %s line %d, ", filename, line);
@@ -310,6 +374,7 @@ Report::logBegin(const char *filename)
   log_stream_ = fopen(filename, "w");
   if (log_stream_ == nullptr)
     throw FileNotWritable(filename);
+  setFileBuffer(log_stream_);
 }
 
 void
@@ -323,17 +388,29 @@ Report::logEnd()
 void
 Report::redirectFileBegin(const char *filename)
 {
+  {
+    // Console output buffered before the redirect is printed first.
+    std::unique_lock<std::mutex> lock(print_lock_);
+    flushConsoleBuffer();
+  }
   redirect_stream_ = fopen(filename, "w");
   if (redirect_stream_ == nullptr)
     throw FileNotWritable(filename);
+  setFileBuffer(redirect_stream_);
 }
 
 void
 Report::redirectFileAppendBegin(const char *filename)
 {
+  {
+    // Console output buffered before the redirect is printed first.
+    std::unique_lock<std::mutex> lock(print_lock_);
+    flushConsoleBuffer();
+  }
   redirect_stream_ = fopen(filename, "a");
   if (redirect_stream_ == nullptr)
     throw FileNotWritable(filename);
+  setFileBuffer(redirect_stream_);
 }
 
 void
@@ -347,6 +424,10 @@ Report::redirectFileEnd()
 void
 Report::redirectStringBegin()
 {
+  {
+    std::unique_lock<std::mutex> lock(print_lock_);
+    flushConsoleBuffer();
+  }
   redirect_to_string_ = true;
   redirect_string_.clear();
 }
@@ -365,4 +446,24 @@ Report::redirectStringPrint(const char *buffer,
   redirect_string_.append(buffer, length);
 }
 
+////////////////////////////////////////////////////////////////
+
+ReportLines::ReportLines(Report *default_report)
+{
+  // Report() makes itself the default report.
+  default_ = default_report;
+  redirectStringBegin();
+}
+
+ReportBuffer::ReportBuffer(Report *report) :
+  report_(report)
+{
+  report_->bufferBegin();
+}
+
+ReportBuffer::~ReportBuffer()
+{
+  report_->bufferEnd();
+}
+
 } // namespace
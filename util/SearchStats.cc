@@ -0,0 +1,150 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "SearchStats.hh"
+
+#include "Report.hh"
+
+namespace sta {
+
+SearchStats::SearchStats() :
+  enabled_(false)
+{
+  clear();
+}
+
+void
+SearchStats::setEnabled(bool enabled)
+{
+  enabled_ = enabled;
+}
+
+void
+SearchStats::clear()
+{
+  for (int i = 0; i < counter_count; i++)
+    counts_[i].store(0, std::memory_order_relaxed);
+}
+
+uint64_t
+SearchStats::count(Counter counter) const
+{
+  return counts_[counter].load(std::memory_order_relaxed);
+}
+
+static double
+percent(uint64_t count,
+        uint64_t total)
+{
+  return total ? count * 100.0 / total : 0.0;
+}
+
+static double
+ratio(uint64_t count,
+      uint64_t total)
+{
+  return total ? static_cast<double>(count) / total : 0.0;
+}
+
+void
+SearchStats::report(int thread_count,
+                    Report *report) const
+{
+  if (!enabled_)
+    report->reportLine("Search stats are not enabled (sta_search_stats_enabled).");
+  uint64_t passes = count(bfs_passes);
+  uint64_t parallel_levels = count(bfs_parallel_levels);
+  uint64_t serial_levels = count(bfs_serial_levels);
+  report->reportLine("BFS passes              %12llu",
+                     static_cast<unsigned long long>(passes));
+  report->reportLine("BFS vertices visited    %12llu (%.1f per pass)",
+                     static_cast<unsigned long long>(count(bfs_vertices)),
+                     ratio(count(bfs_vertices), passes));
+  report->reportLine("Parallel levels         %12llu (%.1f vertices per level, %d threads)",
+                     static_cast<unsigned long long>(parallel_levels),
+                     ratio(count(bfs_parallel_level_vertices), parallel_levels),
+                     thread_count);
+  report->reportLine("Serial levels           %12llu (%.1f vertices per level)",
+                     static_cast<unsigned long long>(serial_levels),
+                     ratio(count(bfs_serial_level_vertices), serial_levels));
+  uint64_t arrival_visit_count = count(arrival_visits);
+  uint64_t changed = count(arrivals_changed);
+  report->reportLine("Arrival visits          %12llu",
+                     static_cast<unsigned long long>(arrival_visit_count));
+  report->reportLine("  arrivals changed      %12llu (%.1f%%)",
+                     static_cast<unsigned long long>(changed),
+                     percent(changed, arrival_visit_count));
+  report->reportLine("  arrivals unchanged    %12llu (%.1f%%)",
+                     static_cast<unsigned long long>(arrival_visit_count - changed),
+                     percent(arrival_visit_count - changed, arrival_visit_count));
+  report->reportLine("Latch passes            %12llu",
+                     static_cast<unsigned long long>(count(latch_passes)));
+  report->reportLine("  pending latch outputs %12llu",
+                     static_cast<unsigned long long>(count(latch_outputs_pending)));
+  struct Lookup {
+    const char *name;
+    Counter lookups;
+    Counter made;
+  };
+  const Lookup lookups[] = {
+    {"Tag", tag_lookups, tags_made},
+    {"Tag group", tag_group_lookups, tag_groups_made},
+    {"Clk info", clk_info_lookups, clk_infos_made}
+  };
+  for (const Lookup &lookup : lookups) {
+    uint64_t lookup_count = count(lookup.lookups);
+    uint64_t made = count(lookup.made);
+    report->reportLine("%-10s lookups      %12llu hits %12llu (%.1f%%) made %llu",
+                       lookup.name,
+                       static_cast<unsigned long long>(lookup_count),
+                       static_cast<unsigned long long>(lookup_count - made),
+                       percent(lookup_count - made, lookup_count),
+                       static_cast<unsigned long long>(made));
+  }
+  report->reportLine("Delay calculation");
+  report->reportLine("  driver vertices       %12llu",
+                     static_cast<unsigned long long>(count(dcalc_drvr_vertices)));
+  report->reportLine("  gate delay calls      %12llu",
+                     static_cast<unsigned long long>(count(dcalc_gate_delays)));
+  report->reportLine("  load delays           %12llu",
+                     static_cast<unsigned long long>(count(dcalc_load_delays)));
+  report->reportLine("  unchanged load slews  %12llu",
+                     static_cast<unsigned long long>(count(dcalc_loads_unchanged)));
+  report->reportLine("  drivers skipped       %12llu",
+                     static_cast<unsigned long long>(count(dcalc_drvrs_skipped)));
+  struct CacheLookup {
+    const char *name;
+    Counter lookups;
+    Counter reuses;
+  };
+  const CacheLookup caches[] = {
+    {"dmp ceff", dmp_ceff_cache_lookups, dmp_ceff_cache_reuses},
+    {"ccs sim LU", ccs_sim_factor_lookups, ccs_sim_factor_reuses}
+  };
+  for (const CacheLookup &cache : caches) {
+    uint64_t lookup_count = count(cache.lookups);
+    if (lookup_count > 0) {
+      uint64_t reuses = count(cache.reuses);
+      report->reportLine("  %-10s cache lookups %12llu reuses %12llu (%.1f%%)",
+                         cache.name,
+                         static_cast<unsigned long long>(lookup_count),
+                         static_cast<unsigned long long>(reuses),
+                         percent(reuses, lookup_count));
+    }
+  }
+}
+
+} // namespace
@@ -4,8 +4,16 @@
 
 #cmakedefine ZLIB_FOUND
 
+#cmakedefine ZSTD_FOUND
+
 #define CUDD ${CUDD}
 
 #define SSTA ${SSTA}
 
+#define STA_COMPACT_DELAYS ${STA_COMPACT_DELAYS}
+
+#define STA_ARRAY_TABLE_BITS ${STA_ARRAY_TABLE_BITS}
+
+#define STA_HOT_DEBUG ${STA_HOT_DEBUG}
+
 #define TCL_READLINE ${TCL_READLINE}
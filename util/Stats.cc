@@ -20,6 +20,7 @@
 #include "StringUtil.hh"
 #include "Report.hh"
 #include "Debug.hh"
+#include "Profiler.hh"
 
 namespace sta {
 
@@ -30,8 +31,14 @@ Stats::Stats(Debug *debug,
   system_begin_(0.0),
   memory_begin_(0),
   debug_(debug),
-  report_(report)
+  report_(report),
+  profiling_(false)
 {
+  Profiler *profiler = debug->profiler();
+  if (profiler->enabled()) {
+    profiler->begin();
+    profiling_ = true;
+  }
   if (debug->statsLevel() > 0) {
     elapsed_begin_ = elapsedRunTime();
     user_begin_ = userRunTime();
@@ -40,9 +47,20 @@ Stats::Stats(Debug *debug,
   }
 }
 
+Stats::~Stats()
+{
+  // Scopes that are not reported do not count.
+  if (profiling_)
+    debug_->profiler()->discard();
+}
+
 void
 Stats::report(const char *step)
 {
+  if (profiling_) {
+    debug_->profiler()->end(step);
+    profiling_ = false;
+  }
   if (debug_->statsLevel() > 0) {
     double elapsed_end = elapsedRunTime();
     double user_end = userRunTime();
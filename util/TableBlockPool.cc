@@ -0,0 +1,220 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "TableBlockPool.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Machine.hh"
+#include "StringUtil.hh"
+#include "MemoryStats.hh"
+
+namespace sta {
+
+static constexpr size_t table_block_align = 64;
+static constexpr size_t table_huge_page_size = 2 << 20;
+static constexpr size_t table_region_size = 32 * table_huge_page_size;
+
+class TableRegion
+{
+public:
+  char *begin_;
+  size_t size_;
+  TablePagePolicy policy_;
+};
+
+static std::atomic<TablePagePolicy> table_page_policy(TablePagePolicy::normal);
+static std::mutex table_pool_lock;
+// Sorted by begin_.
+static std::vector<TableRegion> table_regions;
+static std::atomic<bool> table_regions_exist(false);
+static char *table_region_next = nullptr;
+static size_t table_region_left = 0;
+// Deleted region blocks by size.
+static std::map<size_t, std::vector<void*>> table_free_blocks;
+static size_t table_live_bytes = 0;
+static size_t table_free_bytes = 0;
+
+static void
+makeTableRegion(size_t size,
+                TablePagePolicy policy)
+{
+  void *memory = allocHugePages(size, policy == TablePagePolicy::explicit_huge);
+  if (memory == nullptr && policy == TablePagePolicy::explicit_huge) {
+    policy = TablePagePolicy::transparent_huge;
+    memory = allocHugePages(size, false);
+  }
+  if (memory == nullptr) {
+    policy = TablePagePolicy::normal;
+    memory = ::operator new(size);
+  }
+  TableRegion region;
+  region.begin_ = static_cast<char*>(memory);
+  region.size_ = size;
+  region.policy_ = policy;
+  auto itr = std::upper_bound(table_regions.begin(), table_regions.end(),
+                              region.begin_,
+                              [] (const char *begin,
+                                  const TableRegion &region1) {
+                                return begin < region1.begin_;
+                              });
+  table_regions.insert(itr, region);
+  table_regions_exist = true;
+  // The rest of the old region is abandoned.
+  table_region_next = region.begin_;
+  table_region_left = size;
+}
+
+void *
+tableBlockAlloc(size_t size)
+{
+  TablePagePolicy policy = table_page_policy.load(std::memory_order_relaxed);
+  if (policy == TablePagePolicy::normal)
+    return ::operator new(size);
+  size = (size + table_block_align - 1) / table_block_align * table_block_align;
+  std::lock_guard<std::mutex> lock(table_pool_lock);
+  table_live_bytes += size;
+  auto free_itr = table_free_blocks.find(size);
+  if (free_itr != table_free_blocks.end() && !free_itr->second.empty()) {
+    void *block = free_itr->second.back();
+    free_itr->second.pop_back();
+    table_free_bytes -= size;
+    return block;
+  }
+  if (table_region_left < size) {
+    size_t region_size = std::max(table_region_size,
+                                  (size + table_huge_page_size - 1)
+                                  / table_huge_page_size * table_huge_page_size);
+    makeTableRegion(region_size, policy);
+  }
+  void *block = table_region_next;
+  table_region_next += size;
+  table_region_left -= size;
+  return block;
+}
+
+void
+tableBlockFree(void *block,
+               size_t size)
+{
+  if (block) {
+    if (table_regions_exist.load(std::memory_order_relaxed)) {
+      const char *ptr = static_cast<const char*>(block);
+      std::lock_guard<std::mutex> lock(table_pool_lock);
+      auto itr = std::upper_bound(table_regions.begin(), table_regions.end(),
+                                  ptr,
+                                  [] (const char *begin,
+                                      const TableRegion &region) {
+                                    return begin < region.begin_;
+                                  });
+      if (itr != table_regions.begin()) {
+        const TableRegion &region = *(itr - 1);
+        if (ptr < region.begin_ + region.size_) {
+          size = (size + table_block_align - 1)
+            / table_block_align * table_block_align;
+          table_free_blocks[size].push_back(block);
+          table_live_bytes -= size;
+          table_free_bytes += size;
+          return;
+        }
+      }
+    }
+    ::operator delete(block);
+  }
+}
+
+TablePagePolicy
+tablePagePolicy()
+{
+  return table_page_policy.load();
+}
+
+void
+setTablePagePolicy(TablePagePolicy policy)
+{
+  table_page_policy = policy;
+}
+
+const char *
+tablePagePolicyName(TablePagePolicy policy)
+{
+  switch (policy) {
+  case TablePagePolicy::normal:
+    return "normal";
+  case TablePagePolicy::transparent_huge:
+    return "transparent";
+  case TablePagePolicy::explicit_huge:
+    return "explicit";
+  }
+  return "";
+}
+
+bool
+findTablePagePolicy(const char *name,
+                    // Return value.
+                    TablePagePolicy &policy)
+{
+  for (TablePagePolicy policy1 : {TablePagePolicy::normal,
+                                  TablePagePolicy::transparent_huge,
+                                  TablePagePolicy::explicit_huge}) {
+    if (stringEq(name, tablePagePolicyName(policy1))) {
+      policy = policy1;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+tableBlockMemoryStats(MemoryStats &stats)
+{
+  std::string policy_category = std::string("policy ")
+    + tablePagePolicyName(tablePagePolicy());
+  stats.add("table pages", policy_category.c_str(), 0, 0);
+  std::lock_guard<std::mutex> lock(table_pool_lock);
+  if (!table_regions.empty()) {
+    size_t region_counts[3] = {0, 0, 0};
+    size_t region_bytes[3] = {0, 0, 0};
+    for (const TableRegion &region : table_regions) {
+      int index = static_cast<int>(region.policy_);
+      region_counts[index]++;
+      region_bytes[index] += region.size_;
+    }
+    size_t total_bytes = 0;
+    for (int index = 0; index < 3; index++) {
+      if (region_counts[index] > 0) {
+        TablePagePolicy policy = static_cast<TablePagePolicy>(index);
+        std::string category = std::string(tablePagePolicyName(policy))
+          + " page regions";
+        // Live blocks are accounted by the tables that own them.
+        stats.add("table pages", category.c_str(), region_counts[index], 0);
+        total_bytes += region_bytes[index];
+      }
+    }
+    stats.add("table pages", "free blocks", 0, table_free_bytes);
+    stats.add("table pages", "unused region space", 0,
+              total_bytes - table_live_bytes - table_free_bytes);
+  }
+}
+
+} // namespace
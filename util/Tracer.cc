@@ -0,0 +1,135 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2024, Parallax Software, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+#include "Tracer.hh"
+
+#include <cstdio>
+
+#include "Error.hh"
+
+namespace sta {
+
+Tracer::Tracer() :
+  enabled_(false),
+  start_(std::chrono::steady_clock::now()),
+  threads_(1)
+{
+}
+
+void
+Tracer::setEnabled(bool enabled)
+{
+  enabled_ = enabled;
+}
+
+void
+Tracer::setThreadCount(size_t thread_count)
+{
+  if (thread_count + 1 > threads_.size())
+    threads_.resize(thread_count + 1);
+}
+
+void
+Tracer::clear()
+{
+  for (ThreadEvents &thread : threads_)
+    thread.events_.clear();
+}
+
+int64_t
+Tracer::now() const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>
+    (std::chrono::steady_clock::now() - start_).count();
+}
+
+void
+Tracer::record(int thread,
+               const char *name,
+               int64_t begin,
+               int64_t end,
+               int64_t arg)
+{
+  if (thread >= 0
+      && static_cast<size_t>(thread) < threads_.size())
+    threads_[thread].events_.push_back({name, begin, end, arg});
+}
+
+size_t
+Tracer::eventCount() const
+{
+  size_t count = 0;
+  for (const ThreadEvents &thread : threads_)
+    count += thread.events_.size();
+  return count;
+}
+
+void
+Tracer::writeJson(const char *filename) const
+{
+  FILE *stream = fopen(filename, "w");
+  if (stream == nullptr)
+    throw FileNotWritable(filename);
+  fprintf(stream, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  bool first = true;
+  for (size_t tid = 0; tid < threads_.size(); tid++) {
+    const std::vector<Event> &events = threads_[tid].events_;
+    if (!events.empty()) {
+      fprintf(stream, "%s{\"name\": \"thread_name\", \"ph\": \"M\", "
+              "\"pid\": 1, \"tid\": %zu, \"args\": {\"name\": ",
+              first ? "" : ",\n", tid);
+      if (tid == 0)
+        fprintf(stream, "\"main\"}}");
+      else
+        fprintf(stream, "\"worker %zu\"}}", tid - 1);
+      first = false;
+      for (const Event &event : events) {
+        fprintf(stream, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, "
+                "\"tid\": %zu, \"ts\": %lld, \"dur\": %lld",
+                event.name_,
+                tid,
+                static_cast<long long>(event.begin_),
+                static_cast<long long>(event.end_ - event.begin_));
+        if (event.arg_ >= 0)
+          fprintf(stream, ", \"args\": {\"arg\": %lld}",
+                  static_cast<long long>(event.arg_));
+        fprintf(stream, "}");
+      }
+    }
+  }
+  fprintf(stream, "\n]}\n");
+  fclose(stream);
+}
+
+////////////////////////////////////////////////////////////////
+
+TraceScope::TraceScope(Tracer *tracer,
+                       const char *name,
+                       int64_t arg) :
+  tracer_(tracer->enabled() ? tracer : nullptr),
+  name_(name),
+  arg_(arg),
+  begin_(tracer_ ? tracer_->now() : 0)
+{
+}
+
+TraceScope::~TraceScope()
+{
+  if (tracer_)
+    tracer_->record(0, name_, begin_, tracer_->now(), arg_);
+}
+
+} // namespace
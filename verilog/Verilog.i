@@ -59,7 +59,8 @@ write_verilog_cmd(const char *filename,
   // to see the sta internal names.
   Sta *sta = Sta::sta();
   Network *network = sta->network();
-  writeVerilog(filename, sort, include_pwr_gnd, remove_cells, network);
+  writeVerilog(filename, sort, include_pwr_gnd, remove_cells, network,
+               sta->threadCount(), sta->dispatchQueue());
   delete remove_cells;
 }
 
@@ -16,6 +16,7 @@
 
 #include "VerilogReader.hh"
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "Debug.hh"
@@ -27,6 +28,7 @@
 #include "Network.hh"
 #include "VerilogNamespace.hh"
 #include "StringUtil.hh"
+#include "DispatchQueue.hh"
 #include "verilog/VerilogReaderPvt.hh"
 
 extern int
@@ -36,6 +38,9 @@ namespace sta {
 
 VerilogReader *verilog_reader;
 static const char *unconnected_net_name = reinterpret_cast<const char*>(1);
+static DispatchQueue *verilog_link_dispatch_queue = nullptr;
+// Max liberty instances linked as one batch.
+static const size_t liberty_inst_batch_size = 65536;
 
 static string
 verilogBusBitName(const char *bus_name,
@@ -56,6 +61,8 @@ readVerilogFile(const char *filename,
 {
   if (verilog_reader == nullptr)
     verilog_reader = new VerilogReader(network);
+  // Link the last netlist read.
+  network->setLinkFunc(linkVerilogNetwork);
   return verilog_reader->read(filename);
 }
 
@@ -169,13 +176,11 @@ VerilogReader::deleteModules()
 bool
 VerilogReader::read(const char *filename)
 {
-  // Use zlib to uncompress gzip'd files automagically.
-  stream_ = gzopen(filename, "rb");
-  if (stream_) {
+  if (stream_.open(filename)) {
     Stats stats(debug_, report_);
     init(filename);
     bool success = (::VerilogParse_parse() == 0);
-    gzclose(stream_);
+    stream_.close();
     reportStmtCounts();
     stats.report("Read verilog");
     return success;
@@ -225,11 +230,7 @@ VerilogReader::getChars(char *buf,
 			size_t &result,
 			size_t max_size)
 {
-  char *status = gzgets(stream_, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = strlen(buf);
+  stream_.getChars(buf, result, max_size);
 }
 
 void
@@ -237,11 +238,7 @@ VerilogReader::getChars(char *buf,
 			int &result,
 			size_t max_size)
 {
-  char *status = gzgets(stream_, buf, max_size);
-  if (status == Z_NULL)
-    result = 0;  // YY_nullptr
-  else
-    result = strlen(buf);
+  stream_.getChars(buf, result, max_size);
 }
 
 VerilogModule *
@@ -954,6 +951,21 @@ VerilogModule::declaration(const char *net_name)
   return dcl_map_.findKey(net_name);
 }
 
+void
+VerilogModule::deleteStmt(size_t index)
+{
+  delete (*stmts_)[index];
+  (*stmts_)[index] = nullptr;
+}
+
+void
+VerilogModule::deleteStmts()
+{
+  dcl_map_.clear();
+  stmts_->deleteContents();
+  stmts_->clear();
+}
+
 ////////////////////////////////////////////////////////////////
 
 VerilogStmt::VerilogStmt(int line) :
@@ -1796,6 +1808,12 @@ linkVerilogNetwork(const char *top_cell_name,
   return verilog_reader->linkNetwork(top_cell_name, make_black_boxes, report);
 }
 
+void
+setVerilogLinkDispatchQueue(DispatchQueue *dispatch_queue)
+{
+  verilog_link_dispatch_queue = dispatch_queue;
+}
+
 // Verilog net name to network net map.
 typedef Map<const char*, Net*, CharPtrLess> BindingMap;
 
@@ -1847,7 +1865,10 @@ VerilogReader::linkNetwork(const char *top_cell_name,
 	}
 	delete net_name_iter;
       }
+      module_elaborations_.clear();
+      countElaborations(module, 1);
       makeModuleInstBody(module, top_instance, &bindings, make_black_boxes);
+      module_elaborations_.clear();
       bool errors = reportLinkErrors(report);
       deleteModules();
       if (errors) {
@@ -1868,21 +1889,91 @@ VerilogReader::linkNetwork(const char *top_cell_name,
   }
 }
 
+// Count the module body elaborations made by linking module count
+// times. Module instances are resolved the same way as
+// makeModuleInstNetwork.
+void
+VerilogReader::countElaborations(VerilogModule *module,
+				 size_t count)
+{
+  module_elaborations_[module] += count;
+  VerilogModuleCountMap child_counts;
+  for (VerilogStmt *stmt : *module->stmts()) {
+    if (stmt->isModuleInst()) {
+      VerilogModuleInst *mod_inst = dynamic_cast<VerilogModuleInst*>(stmt);
+      Cell *cell = network_->findAnyCell(mod_inst->moduleName());
+      if (cell && !network_->isLeaf(cell)) {
+	VerilogModule *child = this->module(cell);
+	if (child)
+	  child_counts[child]++;
+      }
+    }
+  }
+  for (auto child_count : child_counts)
+    countElaborations(child_count.first, count * child_count.second);
+}
+
+// Decrement the module elaborations left and return true if this is
+// the last one.
+bool
+VerilogReader::isLastElaboration(VerilogModule *module)
+{
+  auto itr = module_elaborations_.find(module);
+  if (itr != module_elaborations_.end()
+      && itr->second > 0)
+    return --itr->second == 0;
+  else
+    return false;
+}
+
 void
 VerilogReader::makeModuleInstBody(VerilogModule *module,
 				  Instance *inst,
 				  VerilogBindingTbl *bindings,
 				  bool make_black_boxes)
 {
-  VerilogStmtSeq::Iterator stmt_iter(module->stmts());
-  while (stmt_iter.hasNext()) {
-    VerilogStmt *stmt = stmt_iter.next();
-    if (stmt->isModuleInst())
+  // Instance statements are deleted after they are linked by the
+  // last elaboration of the module so flat netlists do not hold the
+  // statements and the network at the same time.
+  bool delete_stmts = isLastElaboration(module);
+  // Consecutive liberty instances are made as a batch with the
+  // dispatch queue threads.
+  VerilogLibertyInstSeq lib_insts;
+  size_t lib_insts_begin = 0;
+  VerilogStmtSeq *stmts = module->stmts();
+  // The batch is the statements from lib_insts_begin.
+  auto makeLibInsts = [&] () {
+    size_t lib_inst_count = lib_insts.size();
+    makeLibertyInsts(lib_insts, inst, module, bindings);
+    if (delete_stmts) {
+      for (size_t i = 0; i < lib_inst_count; i++)
+	module->deleteStmt(lib_insts_begin + i);
+    }
+  };
+  for (size_t stmt_index = 0; stmt_index < stmts->size(); stmt_index++) {
+    VerilogStmt *stmt = (*stmts)[stmt_index];
+    if (stmt->isLibertyInst() && verilog_link_dispatch_queue) {
+      if (lib_insts.empty())
+	lib_insts_begin = stmt_index;
+      lib_insts.push_back(dynamic_cast<VerilogLibertyInst*>(stmt));
+      if (lib_insts.size() == liberty_inst_batch_size)
+	makeLibInsts();
+      continue;
+    }
+    if (!lib_insts.empty())
+      makeLibInsts();
+    if (stmt->isModuleInst()) {
       makeModuleInstNetwork(dynamic_cast<VerilogModuleInst*>(stmt),
 			    inst, module, bindings, make_black_boxes);
-    else if (stmt->isLibertyInst())
+      if (delete_stmts)
+	module->deleteStmt(stmt_index);
+    }
+    else if (stmt->isLibertyInst()) {
       makeLibertyInst(dynamic_cast<VerilogLibertyInst*>(stmt),
 		      inst, module, bindings);
+      if (delete_stmts)
+	module->deleteStmt(stmt_index);
+    }
     else if (stmt->isDeclaration()) {
       VerilogDcl *dcl = dynamic_cast<VerilogDcl*>(stmt);
       PortDirection *dir = dcl->direction();
@@ -1906,6 +1997,10 @@ VerilogReader::makeModuleInstBody(VerilogModule *module,
       mergeAssignNet(dynamic_cast<VerilogAssign*>(stmt), module, inst,
 		     bindings);
   }
+  if (!lib_insts.empty())
+    makeLibInsts();
+  if (delete_stmts)
+    module->deleteStmts();
 }
 
 void
@@ -2165,6 +2260,82 @@ VerilogReader::makeLibertyInst(VerilogLibertyInst *lib_inst,
   }
 }
 
+// Make liberty instances like makeLibertyInst.
+// Net names are resolved and the instances and pins are made with
+// the dispatch queue threads. Nets are bound serially in statement
+// order so the network matches the one made by makeLibertyInst.
+void
+VerilogReader::makeLibertyInsts(VerilogLibertyInstSeq &lib_insts,
+				Instance *parent,
+				VerilogModule *parent_module,
+				VerilogBindingTbl *parent_bindings)
+{
+  size_t inst_count = lib_insts.size();
+  std::vector<size_t> pin_offsets(inst_count + 1);
+  pin_offsets[0] = 0;
+  for (size_t i = 0; i < inst_count; i++)
+    pin_offsets[i + 1] = pin_offsets[i] + lib_insts[i]->cell()->portBitCount();
+  size_t pin_count = pin_offsets[inst_count];
+
+  // Resolve single bit bus references .A(BUS) -> .A(BUS[LSB]).
+  std::vector<const char*> net_names(pin_count, nullptr);
+  std::vector<string> bus_bit_names(pin_count);
+  size_t chunk_size = 1024;
+  for (size_t begin = 0; begin < inst_count; begin += chunk_size) {
+    size_t end = std::min(begin + chunk_size, inst_count);
+    verilog_link_dispatch_queue->dispatch([&, begin, end](int) {
+      for (size_t i = begin; i < end; i++) {
+	VerilogLibertyInst *lib_inst = lib_insts[i];
+	const char **inst_net_names = lib_inst->netNames();
+	size_t inst_pin_count = pin_offsets[i + 1] - pin_offsets[i];
+	for (size_t pin_index = 0; pin_index < inst_pin_count; pin_index++) {
+	  const char *net_name = inst_net_names[pin_index];
+	  size_t k = pin_offsets[i] + pin_index;
+	  // If the pin is unconnected (ie, .A()) make the pin but not the net.
+	  if (net_name && net_name != unconnected_net_name) {
+	    VerilogDcl *dcl = parent_module->declaration(net_name);
+	    if (dcl && dcl->isBus()) {
+	      VerilogDclBus *dcl_bus = dynamic_cast<VerilogDclBus *>(dcl);
+	      // Bus is only 1 bit wide.
+	      bus_bit_names[k] = verilogBusBitName(net_name, dcl_bus->fromIndex());
+	      net_names[k] = bus_bit_names[k].c_str();
+	    }
+	    else
+	      net_names[k] = net_name;
+	  }
+	}
+      }
+    });
+  }
+  verilog_link_dispatch_queue->finishTasks();
+
+  std::vector<Net*> nets(pin_count, nullptr);
+  for (size_t k = 0; k < pin_count; k++) {
+    const char *net_name = net_names[k];
+    if (net_name)
+      nets[k] = parent_bindings->ensureNetBinding(net_name, parent, network_);
+  }
+
+  LeafInstanceDefSeq defs;
+  defs.reserve(inst_count);
+  for (size_t i = 0; i < inst_count; i++) {
+    VerilogLibertyInst *lib_inst = lib_insts[i];
+    defs.emplace_back(lib_inst->cell(), lib_inst->instanceName(),
+		      &nets[pin_offsets[i]]);
+  }
+  network_->makeLeafInstances(defs, parent, verilog_link_dispatch_queue);
+
+  for (size_t i = 0; i < inst_count; i++) {
+    Instance *inst = defs[i].inst_;
+    VerilogAttributeStmtSeq *attribute_stmts = lib_insts[i]->attribute_stmts();
+    for (VerilogAttributeStmt *stmt : *attribute_stmts) {
+      for (VerilogAttributeEntry *entry : *stmt->attribute_sequence())
+	network_->setAttribute(inst, entry->key(), entry->value());
+    }
+  }
+  lib_insts.clear();
+}
+
 ////////////////////////////////////////////////////////////////
 
 Cell *
@@ -16,7 +16,7 @@
 
 #pragma once
 
-#include "Zlib.hh"
+#include "InputFile.hh"
 #include "Vector.hh"
 #include "Map.hh"
 #include "StringSeq.hh"
@@ -66,9 +66,11 @@ typedef Vector<VerilogAttributeStmt*> VerilogAttributeStmtSeq;
 typedef Vector<VerilogAttributeEntry*> VerilogAttributeEntrySeq;
 typedef Vector<VerilogNet*> VerilogNetSeq;
 typedef Vector<VerilogStmt*> VerilogStmtSeq;
+typedef Vector<VerilogLibertyInst*> VerilogLibertyInstSeq;
 typedef Map<const char*, VerilogDcl*, CharPtrLess> VerilogDclMap;
 typedef Vector<VerilogDclArg*> VerilogDclArgSeq;
 typedef Map<Cell*, VerilogModule*> VerilogModuleMap;
+typedef Map<VerilogModule*, size_t> VerilogModuleCountMap;
 typedef Vector<VerilogError*> VerilogErrorSeq;
 typedef Vector<bool> VerilogConstantValue;
 // Max base 10 constant net value (for strtoll).
@@ -196,6 +198,9 @@ protected:
 				 set<string> &port_names);
   void checkModuleDcls(VerilogModule *module,
 		       set<string> &port_names);
+  void countElaborations(VerilogModule *module,
+			 size_t count);
+  bool isLastElaboration(VerilogModule *module);
   void makeModuleInstBody(VerilogModule *module,
 			  Instance *inst,
 			  VerilogBindingTbl *bindings,
@@ -209,6 +214,10 @@ protected:
 		       Instance *parent,
 		       VerilogModule *parent_module,
 		       VerilogBindingTbl *parent_bindings);
+  void makeLibertyInsts(VerilogLibertyInstSeq &lib_insts,
+			Instance *parent,
+			VerilogModule *parent_module,
+			VerilogBindingTbl *parent_bindings);
   void bindGlobalNets(VerilogBindingTbl *bindings);
   void makeNamedInstPins1(Cell *cell,
 			  Instance *inst,
@@ -281,11 +290,14 @@ protected:
 
   const char *filename_;
   int line_;
-  gzFile stream_;
+  InputFile stream_;
 
   Library *library_;
   int black_box_index_;
   VerilogModuleMap module_map_;
+  // Module body elaborations left to link. Statements of a module
+  // are deleted as they are linked by its last elaboration.
+  VerilogModuleCountMap module_elaborations_;
   VerilogErrorSeq link_errors_;
   const char *zero_net_name_;
   const char *one_net_name_;
@@ -351,6 +363,11 @@ public:
   VerilogDcl *declaration(const char *net_name);
   VerilogStmtSeq *stmts() { return stmts_; }
   VerilogDclMap *declarationMap() { return &dcl_map_; }
+  // Delete stmts_[index] once it is linked for the last time.
+  void deleteStmt(size_t index);
+  // Delete the statements and declarations after the module is linked
+  // for the last time.
+  void deleteStmts();
   void parseDcl(VerilogDcl *dcl,
 		VerilogReader *reader);
 
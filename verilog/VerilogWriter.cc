@@ -17,6 +17,8 @@
 #include "VerilogWriter.hh"
 
 #include <cstdlib>
+#include <cstdarg>
+#include <cstdio>
 #include <algorithm>
 
 #include "Error.hh"
@@ -26,6 +28,8 @@
 #include "NetworkCmp.hh"
 #include "VerilogNamespace.hh"
 #include "ParseBus.hh"
+#include "DispatchQueue.hh"
+#include "BufferedWriter.hh"
 
 namespace sta {
 
@@ -40,8 +44,13 @@ public:
 		bool include_pwr_gnd_pins,
 		CellSeq *remove_cells,
 		FILE *stream,
-		Network *network);
+		Network *network,
+                int thread_count,
+                DispatchQueue *dispatch_queue);
+  // Copy the settings of writer for formatting on another thread.
+  VerilogWriter(const VerilogWriter *writer);
   void writeModule(Instance *inst);
+  void flushBuffer();
 
 protected:
   void writePorts(Cell *cell);
@@ -49,6 +58,7 @@ protected:
   void writeWireDcls(Instance *inst);
   const char *verilogPortDir(PortDirection *dir);
   void writeChildren(Instance *inst);
+  void writeChildrenParallel(const Vector<Instance*> &children);
   void writeChild(Instance *child);
   void writeInstPin(Instance *inst,
 		    Port *port,
@@ -60,6 +70,8 @@ protected:
 			  Port *port,
 			  bool &first_member);
   void writeAssigns(Instance *inst);
+  void print(const char *fmt,
+             ...);
 
   int findUnconnectedNetCount();
   int findNCcount(Instance *inst);
@@ -73,6 +85,11 @@ protected:
   CellSet remove_cells_;
   FILE *stream_;
   Network *network_;
+  int thread_count_;
+  DispatchQueue *dispatch_queue_;
+  // Formatted text waiting to be written to stream_.
+  // Writers on other threads only buffer.
+  BufferedWriter buffer_;
 
   CellSet written_cells_;
   Vector<Instance*> pending_children_;
@@ -84,14 +101,18 @@ writeVerilog(const char *filename,
 	     bool sort,
 	     bool include_pwr_gnd_pins,
 	     CellSeq *remove_cells,
-	     Network *network)
+	     Network *network,
+             int thread_count,
+             DispatchQueue *dispatch_queue)
 {
   if (network->topInstance()) {
     FILE *stream = fopen(filename, "w");
     if (stream) {
       VerilogWriter writer(filename, sort, include_pwr_gnd_pins,
-			   remove_cells, stream, network);
+			   remove_cells, stream, network,
+                           thread_count, dispatch_queue);
       writer.writeModule(network->topInstance());
+      writer.flushBuffer();
       fclose(stream);
     }
     else
@@ -104,13 +125,20 @@ VerilogWriter::VerilogWriter(const char *filename,
 			     bool include_pwr_gnd_pins,
 			     CellSeq *remove_cells,
 			     FILE *stream,
-			     Network *network) :
+			     Network *network,
+                             int thread_count,
+                             DispatchQueue *dispatch_queue) :
   filename_(filename),
   sort_(sort),
   include_pwr_gnd_(include_pwr_gnd_pins),
   remove_cells_(network),
   stream_(stream),
   network_(network),
+  thread_count_(dispatch_queue ? thread_count : 1),
+  dispatch_queue_(dispatch_queue),
+  buffer_([this] (const string &text) {
+    fwrite(text.data(), 1, text.size(), stream_);
+  }),
   written_cells_(network),
   unconnected_net_index_(1)
 {
@@ -120,20 +148,50 @@ VerilogWriter::VerilogWriter(const char *filename,
   }
 }
 
+VerilogWriter::VerilogWriter(const VerilogWriter *writer) :
+  filename_(writer->filename_),
+  sort_(writer->sort_),
+  include_pwr_gnd_(writer->include_pwr_gnd_),
+  remove_cells_(writer->remove_cells_),
+  stream_(nullptr),
+  network_(writer->network_),
+  thread_count_(1),
+  dispatch_queue_(nullptr),
+  written_cells_(writer->network_),
+  unconnected_net_index_(1)
+{
+}
+
+void
+VerilogWriter::print(const char *fmt,
+                     ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  buffer_.vprint(fmt, args);
+  va_end(args);
+}
+
+void
+VerilogWriter::flushBuffer()
+{
+  buffer_.flush();
+}
+
 void
 VerilogWriter::writeModule(Instance *inst)
 {
   Cell *cell = network_->cell(inst);
-  fprintf(stream_, "module %s (",
-	  network_->name(cell));
+  print("module %s (",
+        network_->name(cell));
   writePorts(cell);
   writePortDcls(cell);
-  fprintf(stream_, "\n");
+  print("\n");
   writeWireDcls(inst);
-  fprintf(stream_, "\n");
+  print("\n");
   writeChildren(inst);
   writeAssigns(inst);
-  fprintf(stream_, "endmodule\n");
+  print("endmodule\n");
   written_cells_.insert(cell);
 
   if (sort_)
@@ -158,15 +216,15 @@ VerilogWriter::writePorts(Cell *cell)
     if (include_pwr_gnd_
         || !network_->direction(port)->isPowerGround()) {
       if (!first)
-        fprintf(stream_, ",\n    ");
+        print(",\n    ");
       string verillg_name = portVerilogName(network_->name(port),
                                             network_->pathEscape());
-      fprintf(stream_, "%s", verillg_name.c_str());
+      print("%s", verillg_name.c_str());
       first = false;
     }
   }
   delete port_iter;
-  fprintf(stream_, ");\n");
+  print(");\n");
 }
 
 void
@@ -182,19 +240,19 @@ VerilogWriter::writePortDcls(Cell *cell)
                                           network_->pathEscape());
       const char *vtype = verilogPortDir(dir);
       if (vtype) {
-        fprintf(stream_, " %s", vtype);
+        print(" %s", vtype);
         if (network_->isBus(port))
-          fprintf(stream_, " [%d:%d]",
-                  network_->fromIndex(port),
-                  network_->toIndex(port));
-        fprintf(stream_, " %s;\n", port_vname.c_str());
+          print(" [%d:%d]",
+                network_->fromIndex(port),
+                network_->toIndex(port));
+        print(" %s;\n", port_vname.c_str());
         if (dir->isTristate()) {
-          fprintf(stream_, " tri");
+          print(" tri");
           if (network_->isBus(port))
-            fprintf(stream_, " [%d:%d]",
-                    network_->fromIndex(port),
-                    network_->toIndex(port));
-          fprintf(stream_, " %s;\n", port_vname.c_str());
+            print(" [%d:%d]",
+                  network_->fromIndex(port),
+                  network_->toIndex(port));
+          print(" %s;\n", port_vname.c_str());
         }
       }
     }
@@ -249,7 +307,7 @@ VerilogWriter::writeWireDcls(Instance *inst)
       }
       else {
         string net_vname = netVerilogName(net_name, network_->pathEscape());
-        fprintf(stream_, " wire %s;\n", net_vname.c_str());;
+        print(" wire %s;\n", net_vname.c_str());;
       }
     }
   }
@@ -259,16 +317,16 @@ VerilogWriter::writeWireDcls(Instance *inst)
     const char *bus_name = name_range.first.c_str();
     const BusIndexRange &range = name_range.second;
     string net_vname = netVerilogName(bus_name, network_->pathEscape());
-    fprintf(stream_, " wire [%d:%d] %s;\n",
-            range.first,
-            range.second,
-            net_vname.c_str());;
+    print(" wire [%d:%d] %s;\n",
+          range.first,
+          range.second,
+          net_vname.c_str());;
   }
 
   // Wire net dcls for writeInstBusPinBit.
   int nc_count = findUnconnectedNetCount();
   for (int i = 1; i < nc_count + 1; i++)
-    fprintf(stream_, " wire _NC%d;\n", i);
+    print(" wire _NC%d;\n", i);
 }
 
 void
@@ -291,8 +349,61 @@ VerilogWriter::writeChildren(Instance *inst)
       return stringLess(network_->name(inst1), network_->name(inst2));
     });
 
-  for (auto child : children)
-    writeChild(child);
+  if (thread_count_ > 1
+      && children.size() > 1024)
+    writeChildrenParallel(children);
+  else {
+    for (auto child : children)
+      writeChild(child);
+  }
+}
+
+// Format the child instances on the dispatch queue threads and write
+// them in order. Children that connect unconnected bus bits use the
+// _NC net sequence, so they are written again serially to number the
+// nets in order.
+void
+VerilogWriter::writeChildrenParallel(const Vector<Instance*> &children)
+{
+  flushBuffer();
+  Vector<VerilogWriter*> writers;
+  for (int i = 0; i < thread_count_; i++)
+    writers.push_back(new VerilogWriter(this));
+  constexpr size_t block_child_count = 256;
+  constexpr size_t wave_child_count = block_child_count * 256;
+  std::vector<string> texts(std::min(children.size(), wave_child_count));
+  std::vector<char> use_nc(texts.size());
+  for (size_t wave_start = 0;
+       wave_start < children.size();
+       wave_start += wave_child_count) {
+    size_t wave_end = std::min(wave_start + wave_child_count, children.size());
+    for (size_t block_start = wave_start;
+         block_start < wave_end;
+         block_start += block_child_count) {
+      size_t block_end = std::min(block_start + block_child_count, wave_end);
+      dispatch_queue_->dispatch([=, &children, &writers, &texts, &use_nc] (int i) {
+        VerilogWriter *writer = writers[i];
+        for (size_t k = block_start; k < block_end; k++) {
+          writer->unconnected_net_index_ = 1;
+          writer->writeChild(children[k]);
+          use_nc[k - wave_start] = (writer->unconnected_net_index_ != 1);
+          texts[k - wave_start].swap(writer->buffer_.text());
+          writer->buffer_.clear();
+        }
+      });
+    }
+    dispatch_queue_->finishTasks();
+    for (size_t k = wave_start; k < wave_end; k++) {
+      string &text = texts[k - wave_start];
+      if (use_nc[k - wave_start])
+        writeChild(children[k]);
+      else {
+        buffer_.append(text);
+      }
+      text.clear();
+    }
+  }
+  writers.deleteContentsClear();
 }
 
 void
@@ -302,9 +413,9 @@ VerilogWriter::writeChild(Instance *child)
   if (!remove_cells_.hasKey(child_cell)) {
     const char *child_name = network_->name(child);
     string child_vname = instanceVerilogName(child_name, network_->pathEscape());
-    fprintf(stream_, " %s %s (",
-	    network_->name(child_cell),
-	    child_vname.c_str());
+    print(" %s %s (",
+          network_->name(child_cell),
+          child_vname.c_str());
     bool first_port = true;
     CellPortIterator *port_iter = network_->portIterator(child_cell);
     while (port_iter->hasNext()) {
@@ -318,7 +429,7 @@ VerilogWriter::writeChild(Instance *child)
       }
     }
     delete port_iter;
-    fprintf(stream_, ");\n");
+    print(");\n");
   }
 }
 
@@ -334,12 +445,12 @@ VerilogWriter::writeInstPin(Instance *inst,
       const char *net_name = network_->name(net);
       string net_vname = netVerilogName(net_name, network_->pathEscape());
       if (!first_port)
-	fprintf(stream_, ",\n    ");
+	print(",\n    ");
       string port_vname = portVerilogName(network_->name(port),
                                           network_->pathEscape());
-      fprintf(stream_, ".%s(%s)",
-	      port_vname.c_str(),
-	      net_vname.c_str());
+      print(".%s(%s)",
+            port_vname.c_str(),
+            net_vname.c_str());
       first_port = false;
     }
   }
@@ -351,9 +462,9 @@ VerilogWriter::writeInstBusPin(Instance *inst,
 			       bool &first_port)
 {
   if (!first_port)
-    fprintf(stream_, ",\n    ");
+    print(",\n    ");
 
-  fprintf(stream_, ".%s({", network_->name(port));
+  print(".%s({", network_->name(port));
   first_port = false;
   bool first_member = true;
 
@@ -376,7 +487,7 @@ VerilogWriter::writeInstBusPin(Instance *inst,
     }
     delete member_iter;
   }
-  fprintf(stream_, "})");
+  print("})");
 }
 
 void
@@ -394,8 +505,8 @@ VerilogWriter::writeInstBusPinBit(Instance *inst,
     stringPrint(net_name, "_NC%d", unconnected_net_index_++);
   string net_vname = netVerilogName(net_name.c_str(), network_->pathEscape());
   if (!first_member)
-    fprintf(stream_, ",\n    ");
-  fprintf(stream_, "%s", net_vname.c_str());
+    print(",\n    ");
+  print("%s", net_vname.c_str());
   first_member = false;
 }
 
@@ -420,9 +531,9 @@ VerilogWriter::writeAssigns(Instance *inst)
                                          network_->pathEscape());
       string net_vname = netVerilogName(network_->name(net),
                                         network_->pathEscape());
-      fprintf(stream_, " assign %s = %s;\n",
-              port_vname.c_str(),
-              net_vname.c_str());
+      print(" assign %s = %s;\n",
+            port_vname.c_str(),
+            net_vname.c_str());
     }
   }
   delete pin_iter;